@@ -0,0 +1,72 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/block_view.hpp
+/// @brief @copybrief storages::clickhouse::BlockView
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/storages/clickhouse/impl/block_wrapper_fwd.hpp>
+#include <userver/storages/clickhouse/io/impl/validate.hpp>
+#include <userver/storages/clickhouse/io/result_mapper.hpp>
+#include <userver/utils/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+/// @brief One block of the result of storages::clickhouse::Cluster
+/// ExecuteStreaming methods.
+///
+/// The view and the data it gives access to are valid only within the
+/// callback it is passed to.
+class BlockView final {
+ public:
+  explicit BlockView(impl::BlockWrapper& block);
+
+  /// Returns number of columns in the block.
+  size_t GetColumnsCount() const;
+
+  /// Returns number of rows in the block.
+  size_t GetRowsCount() const;
+
+  /// @brief Returns the data of a numeric column without copying it.
+  ///
+  /// `T` is the `cpp_type` of the column: std::uint8_t ... std::uint64_t,
+  /// std::int8_t ... std::int64_t, float or double.
+  /// @throws std::runtime_error if the column is of another type
+  template <typename T>
+  USERVER_NAMESPACE::utils::span<const T> GetNumericColumn(size_t ind) const;
+
+  /// Converts the block to strongly-typed struct of vectors.
+  /// See @ref clickhouse_io for better understanding of `T`'s requirements.
+  template <typename T>
+  T As() const;
+
+ private:
+  impl::BlockWrapper& block_;
+};
+
+/// Callback of storages::clickhouse::Cluster ExecuteStreaming methods
+using BlockCallback = std::function<void(const BlockView&)>;
+
+template <typename T>
+T BlockView::As() const {
+  T result{};
+  io::impl::ValidateColumnsMapping(result);
+  io::impl::ValidateColumnsCount<T>(GetColumnsCount());
+
+  using MappedType = typename io::CppToClickhouse<T>::mapped_type;
+  io::ColumnsMapper<MappedType> mapper{block_};
+
+  boost::pfr::for_each_field(result, mapper);
+
+  return result;
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
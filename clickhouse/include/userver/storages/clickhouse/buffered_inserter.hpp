@@ -0,0 +1,249 @@
+#pragma once
+
+/// @file userver/storages/clickhouse/buffered_inserter.hpp
+/// @brief @copybrief storages::clickhouse::BufferedInserter
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/semaphore.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/periodic_task.hpp>
+
+#include <userver/storages/clickhouse/cluster.hpp>
+#include <userver/storages/clickhouse/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+/// Settings of storages::clickhouse::BufferedInserter
+struct BufferedInserterSettings final {
+  /// Rows are flushed as soon as that many of them are gathered
+  std::size_t max_block_rows{10000};
+
+  /// Rows gathered for longer are flushed regardless of their count
+  std::chrono::milliseconds flush_interval{1000};
+
+  /// Maximum number of blocks inserted concurrently, the successive blocks
+  /// go to different hosts of the cluster
+  std::size_t max_parallel_flushes{4};
+
+  /// Maximum number of rows gathered and being inserted, BufferedInserter::Add
+  /// waits for the flushes to finish when it is reached
+  std::size_t max_rows_in_memory{100000};
+
+  /// Number of attempts to insert a block, each one at the next available host
+  std::size_t insert_attempts{3};
+
+  /// Delay between the attempts
+  std::chrono::milliseconds retry_delay{100};
+
+  /// Command control of the inserts
+  OptionalCommandControl command_control{};
+};
+
+/// Statistics of storages::clickhouse::BufferedInserter
+struct BufferedInserterStatistics final {
+  std::size_t rows_in_memory{0};
+  std::size_t rows_inserted{0};
+  std::size_t rows_dropped{0};
+  std::size_t blocks_inserted{0};
+  std::size_t insert_errors{0};
+};
+
+/// @ingroup userver_clients
+///
+/// @brief Gathers rows from many coroutines into blocks and inserts them into
+/// a table of the ClickHouse cluster.
+///
+/// ClickHouse handles a lot of small inserts poorly, so the rows are buffered
+/// and flushed as one block once `max_block_rows` rows are gathered or once
+/// `flush_interval` passes. Blocks are inserted in background, up to
+/// `max_parallel_flushes` at once, with `insert_attempts` attempts each. The
+/// rows of a block that could not be inserted are dropped and logged.
+///
+/// When `max_rows_in_memory` are buffered or being inserted, Add() waits for
+/// the inserts to finish, which keeps the memory in use bounded under a slow
+/// or unavailable cluster.
+///
+/// `Row` is expected to be a clickhouse-mapped type, see Cluster::InsertRows
+/// and @ref clickhouse_io.
+///
+/// The remaining rows are flushed at Flush() and in the destructor.
+template <typename Row>
+class BufferedInserter final {
+ public:
+  BufferedInserter(std::shared_ptr<Cluster> cluster, std::string table_name,
+                   std::vector<std::string> column_names,
+                   const BufferedInserterSettings& settings);
+  ~BufferedInserter();
+
+  BufferedInserter(const BufferedInserter&) = delete;
+  BufferedInserter& operator=(const BufferedInserter&) = delete;
+
+  /// Adds a row to the current block, may wait for the memory to be freed
+  void Add(Row row);
+
+  /// Inserts all the gathered rows and waits for all the inserts to finish
+  void Flush();
+
+  BufferedInserterStatistics GetStatistics() const;
+
+ private:
+  void FlushBlock(std::vector<Row>&& block);
+  void Insert(const std::vector<Row>& block);
+
+  const std::shared_ptr<Cluster> cluster_;
+  const std::string table_name_;
+  const std::vector<std::string> column_names_;
+  const std::vector<std::string_view> column_name_views_;
+  const BufferedInserterSettings settings_;
+
+  engine::Semaphore rows_in_memory_;
+  engine::Semaphore parallel_flushes_;
+
+  engine::Mutex mutex_;
+  std::vector<Row> block_;
+
+  std::atomic<std::size_t> rows_inserted_{0};
+  std::atomic<std::size_t> rows_dropped_{0};
+  std::atomic<std::size_t> blocks_inserted_{0};
+  std::atomic<std::size_t> insert_errors_{0};
+
+  concurrent::BackgroundTaskStorage flushes_;
+  USERVER_NAMESPACE::utils::PeriodicTask periodic_flush_;
+};
+
+template <typename Row>
+BufferedInserter<Row>::BufferedInserter(
+    std::shared_ptr<Cluster> cluster, std::string table_name,
+    std::vector<std::string> column_names,
+    const BufferedInserterSettings& settings)
+    : cluster_(std::move(cluster)),
+      table_name_(std::move(table_name)),
+      column_names_(std::move(column_names)),
+      column_name_views_(column_names_.begin(), column_names_.end()),
+      settings_(settings),
+      rows_in_memory_(settings_.max_rows_in_memory),
+      parallel_flushes_(settings_.max_parallel_flushes) {
+  UASSERT(cluster_);
+  UINVARIANT(settings_.max_block_rows > 0, "max_block_rows is set to zero");
+  UINVARIANT(settings_.max_rows_in_memory >= settings_.max_block_rows,
+             "max_rows_in_memory is less than max_block_rows");
+  UINVARIANT(settings_.max_parallel_flushes > 0,
+             "max_parallel_flushes is set to zero");
+  UINVARIANT(settings_.insert_attempts > 0, "insert_attempts is set to zero");
+
+  block_.reserve(settings_.max_block_rows);
+  periodic_flush_.Start(
+      "clickhouse_buffered_insert_" + table_name_,
+      USERVER_NAMESPACE::utils::PeriodicTask::Settings{
+          settings_.flush_interval},
+      [this] {
+        std::vector<Row> block;
+        {
+          const std::lock_guard lock{mutex_};
+          block.swap(block_);
+        }
+        if (!block.empty()) FlushBlock(std::move(block));
+      });
+}
+
+template <typename Row>
+BufferedInserter<Row>::~BufferedInserter() {
+  periodic_flush_.Stop();
+  Flush();
+}
+
+template <typename Row>
+void BufferedInserter<Row>::Add(Row row) {
+  rows_in_memory_.lock_shared();
+
+  std::vector<Row> full_block;
+  {
+    const std::lock_guard lock{mutex_};
+    block_.push_back(std::move(row));
+    if (block_.size() < settings_.max_block_rows) return;
+    full_block.swap(block_);
+    block_.reserve(settings_.max_block_rows);
+  }
+  FlushBlock(std::move(full_block));
+}
+
+template <typename Row>
+void BufferedInserter<Row>::Flush() {
+  std::vector<Row> block;
+  {
+    const std::lock_guard lock{mutex_};
+    block.swap(block_);
+  }
+  if (!block.empty()) FlushBlock(std::move(block));
+
+  // All the units are free only when every insert is done
+  rows_in_memory_.lock_shared_count(settings_.max_rows_in_memory);
+  rows_in_memory_.unlock_shared_count(settings_.max_rows_in_memory);
+}
+
+template <typename Row>
+BufferedInserterStatistics BufferedInserter<Row>::GetStatistics() const {
+  BufferedInserterStatistics stats;
+  stats.rows_in_memory =
+      settings_.max_rows_in_memory - rows_in_memory_.RemainingApprox();
+  stats.rows_inserted = rows_inserted_.load();
+  stats.rows_dropped = rows_dropped_.load();
+  stats.blocks_inserted = blocks_inserted_.load();
+  stats.insert_errors = insert_errors_.load();
+  return stats;
+}
+
+template <typename Row>
+void BufferedInserter<Row>::FlushBlock(std::vector<Row>&& block) {
+  flushes_.AsyncDetach(
+      "clickhouse_buffered_insert", [this, block = std::move(block)] {
+        {
+          const std::shared_lock lock{parallel_flushes_};
+          Insert(block);
+        }
+        rows_in_memory_.unlock_shared_count(block.size());
+      });
+}
+
+template <typename Row>
+void BufferedInserter<Row>::Insert(const std::vector<Row>& block) {
+  for (std::size_t attempt = 1;; ++attempt) {
+    try {
+      cluster_->InsertRows(settings_.command_control, table_name_,
+                           column_name_views_, block);
+      rows_inserted_ += block.size();
+      ++blocks_inserted_;
+      return;
+    } catch (const std::exception& ex) {
+      ++insert_errors_;
+      if (attempt >= settings_.insert_attempts) {
+        LOG_ERROR() << "Failed to insert " << block.size() << " rows into '"
+                    << table_name_ << "', dropping them: " << ex;
+        rows_dropped_ += block.size();
+        return;
+      }
+      LOG_WARNING() << "Failed to insert " << block.size() << " rows into '"
+                    << table_name_ << "', retrying: " << ex;
+    }
+    engine::InterruptibleSleepFor(settings_.retry_delay);
+  }
+}
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
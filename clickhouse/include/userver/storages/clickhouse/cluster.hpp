@@ -11,6 +11,7 @@
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/components/component_fwd.hpp>
 
+#include <userver/storages/clickhouse/block_view.hpp>
 #include <userver/storages/clickhouse/fwd.hpp>
 #include <userver/storages/clickhouse/impl/insertion_request.hpp>
 #include <userver/storages/clickhouse/impl/pool.hpp>
@@ -60,6 +61,26 @@ class Cluster final {
   ExecutionResult Execute(OptionalCommandControl, const Query& query,
                           const Args&... args) const;
 
+  /// @brief Execute a statement at some host of the cluster
+  /// with args as query parameters, passing the result to `callback` block
+  /// by block as it is received.
+  ///
+  /// Unlike Execute, the result is never gathered in memory as a whole, so
+  /// the memory in use is bounded by the size of a block. Numeric columns
+  /// are accessible without copies via BlockView::GetNumericColumn.
+  /// An exception thrown by the callback cancels the query and is rethrown.
+  /// @note the execute timeout of the command control limits the whole query
+  template <typename... Args>
+  void ExecuteStreaming(const BlockCallback& callback, const Query& query,
+                        const Args&... args) const;
+
+  /// @brief Execute a statement with specified command control settings
+  /// at some host of the cluster with args as query parameters, passing the
+  /// result to `callback` block by block as it is received.
+  template <typename... Args>
+  void ExecuteStreaming(OptionalCommandControl, const BlockCallback& callback,
+                        const Query& query, const Args&... args) const;
+
   /// @brief Insert data at some host of the cluster;
   /// `T` is expected to be a struct of vectors of same length.
   /// @param table_name table to insert into
@@ -131,6 +152,9 @@ class Cluster final {
 
   ExecutionResult DoExecute(OptionalCommandControl, const Query& query) const;
 
+  void DoExecuteStreaming(OptionalCommandControl, const Query& query,
+                          const BlockCallback& callback) const;
+
   const impl::Pool& GetPool() const;
 
   std::vector<impl::Pool> pools_;
@@ -189,6 +213,20 @@ ExecutionResult Cluster::Execute(OptionalCommandControl optional_cc,
   return DoExecute(optional_cc, formatted_query);
 }
 
+template <typename... Args>
+void Cluster::ExecuteStreaming(const BlockCallback& callback,
+                               const Query& query, const Args&... args) const {
+  ExecuteStreaming(OptionalCommandControl{}, callback, query, args...);
+}
+
+template <typename... Args>
+void Cluster::ExecuteStreaming(OptionalCommandControl optional_cc,
+                               const BlockCallback& callback,
+                               const Query& query, const Args&... args) const {
+  const auto formatted_query = query.WithArgs(args...);
+  DoExecuteStreaming(optional_cc, formatted_query, callback);
+}
+
 }  // namespace storages::clickhouse
 
 USERVER_NAMESPACE_END
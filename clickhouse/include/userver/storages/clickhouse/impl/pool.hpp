@@ -2,6 +2,7 @@
 
 #include <memory>
 
+#include <userver/storages/clickhouse/block_view.hpp>
 #include <userver/storages/clickhouse/execution_result.hpp>
 #include <userver/storages/clickhouse/options.hpp>
 
@@ -29,6 +30,9 @@ class Pool final {
 
   ExecutionResult Execute(OptionalCommandControl, const Query& query) const;
 
+  void ExecuteStreaming(OptionalCommandControl, const Query& query,
+                        const BlockCallback& callback) const;
+
   void Insert(OptionalCommandControl, const InsertionRequest& request) const;
 
   void WriteStatistics(
@@ -0,0 +1,62 @@
+#include <userver/storages/clickhouse/block_view.hpp>
+
+#include <stdexcept>
+
+#include <clickhouse/columns/numeric.h>
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
+
+#include <storages/clickhouse/impl/block_wrapper.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::clickhouse {
+
+namespace {
+
+template <typename T>
+using ColumnSpan = USERVER_NAMESPACE::utils::span<const T>;
+
+}  // namespace
+
+BlockView::BlockView(impl::BlockWrapper& block) : block_{block} {}
+
+size_t BlockView::GetColumnsCount() const { return block_.GetColumnsCount(); }
+
+size_t BlockView::GetRowsCount() const { return block_.GetRowsCount(); }
+
+template <typename T>
+ColumnSpan<T> BlockView::GetNumericColumn(size_t ind) const {
+  UINVARIANT(ind < block_.GetColumnsCount(), "Column index out of range");
+
+  const auto column = block_.At(ind);
+  const auto typed_column =
+      column->As<impl::clickhouse_cpp::ColumnVector<T>>();
+  if (!typed_column) {
+    throw std::runtime_error{
+        fmt::format("Column {} of type '{}' is not of the requested type", ind,
+                    column->Type()->GetName())};
+  }
+
+  const auto size = typed_column->Size();
+  if (size == 0) return {};
+  // The values are stored contiguously and stay owned by the block
+  const T* data = &typed_column->At(0);
+  return {data, data + size};
+}
+
+template ColumnSpan<std::uint8_t> BlockView::GetNumericColumn(size_t) const;
+template ColumnSpan<std::uint16_t> BlockView::GetNumericColumn(size_t) const;
+template ColumnSpan<std::uint32_t> BlockView::GetNumericColumn(size_t) const;
+template ColumnSpan<std::uint64_t> BlockView::GetNumericColumn(size_t) const;
+template ColumnSpan<std::int8_t> BlockView::GetNumericColumn(size_t) const;
+template ColumnSpan<std::int16_t> BlockView::GetNumericColumn(size_t) const;
+template ColumnSpan<std::int32_t> BlockView::GetNumericColumn(size_t) const;
+template ColumnSpan<std::int64_t> BlockView::GetNumericColumn(size_t) const;
+template ColumnSpan<float> BlockView::GetNumericColumn(size_t) const;
+template ColumnSpan<double> BlockView::GetNumericColumn(size_t) const;
+
+}  // namespace storages::clickhouse
+
+USERVER_NAMESPACE_END
@@ -76,9 +76,10 @@ class Connection::ConnectionBrokenGuard final {
 Connection::Connection(clients::dns::Resolver& resolver,
                        const EndpointSettings& endpoint,
                        const AuthSettings& auth,
-                       const ConnectionSettings& connection_settings)
+                       const ConnectionSettings& connection_settings,
+                       stats::PoolTrafficStatistics& traffic)
     : client_{NativeClientFactory::Create(resolver, endpoint, auth,
-                                          connection_settings)} {}
+                                          connection_settings, traffic)} {}
 
 ExecutionResult Connection::Execute(OptionalCommandControl optional_cc,
                                     const Query& query) {
@@ -104,6 +105,39 @@ ExecutionResult Connection::Execute(OptionalCommandControl optional_cc,
   return ExecutionResult{BlockWrapperPtr{result_ptr.release()}};
 }
 
+void Connection::ExecuteStreaming(OptionalCommandControl optional_cc,
+                                  const Query& query,
+                                  const BlockCallback& callback) {
+  clickhouse_cpp::Query native_query{query.QueryText()};
+
+  auto& span = tracing::Span::CurrentSpan();
+  auto scope = span.CreateScopeTime(scopes::kExec);
+
+  // An exception must not be thrown through clickhouse-cpp, the query is
+  // cancelled instead and the connection stays usable
+  std::exception_ptr callback_error;
+  native_query.OnData([&callback, &callback_error,
+                       &scope](const NativeBlock& data) {
+    if (callback_error || data.GetRowCount() == 0) return;
+    scope.Reset(scopes::kExec);
+    try {
+      // Copies only the references to the columns
+      BlockWrapper block{NativeBlock{data}};
+      callback(BlockView{block});
+    } catch (const std::exception&) {
+      callback_error = std::current_exception();
+    }
+  });
+  native_query.OnDataCancelable(
+      [&callback_error]([[maybe_unused]] const auto& block) {
+        // we must return 'true' if we don't want to cancel query
+        return !callback_error && !engine::current_task::ShouldCancel();
+      });
+
+  DoExecute(optional_cc, native_query);
+  if (callback_error) std::rethrow_exception(callback_error);
+}
+
 void Connection::Insert(OptionalCommandControl optional_cc,
                         const InsertionRequest& request) {
   const auto& block = request.GetBlock();
@@ -3,6 +3,7 @@
 #include <storages/clickhouse/impl/wrap_clickhouse_cpp.hpp>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/storages/clickhouse/block_view.hpp>
 #include <userver/storages/clickhouse/execution_result.hpp>
 #include <userver/storages/clickhouse/options.hpp>
 
@@ -24,10 +25,14 @@ class InsertionRequest;
 class Connection final {
  public:
   Connection(clients::dns::Resolver&, const EndpointSettings&,
-             const AuthSettings&, const ConnectionSettings&);
+             const AuthSettings&, const ConnectionSettings&,
+             stats::PoolTrafficStatistics&);
 
   ExecutionResult Execute(OptionalCommandControl, const Query&);
 
+  void ExecuteStreaming(OptionalCommandControl, const Query&,
+                        const BlockCallback&);
+
   void Insert(OptionalCommandControl, const InsertionRequest&);
 
   void Ping();
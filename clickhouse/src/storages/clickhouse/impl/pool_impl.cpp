@@ -142,7 +142,8 @@ PoolImpl::ConnectionUniquePtr PoolImpl::DoCreateConnection(engine::Deadline) {
   try {
     return std::make_unique<Connection>(
         resolver_, pool_settings_.endpoint_settings,
-        pool_settings_.auth_settings, pool_settings_.connection_settings);
+        pool_settings_.auth_settings, pool_settings_.connection_settings,
+        statistics_.traffic);
   } catch (const std::exception&) {
     availability_monitor_.AccountFailure();
     throw;
@@ -46,7 +46,8 @@ static CompressionMethod Parse(const yaml_config::YamlConfig& value,
   static constexpr utils::TrivialBiMap kMap([](auto selector) {
     return selector()
         .Case(CompressionMethod::kNone, "none")
-        .Case(CompressionMethod::kLZ4, "lz4");
+        .Case(CompressionMethod::kLZ4, "lz4")
+        .Case(CompressionMethod::kZSTD, "zstd");
   });
 
   return utils::ParseFromValueString(value, kMap);
@@ -13,6 +13,7 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
   writer["connections"] = stats.connections;
   writer["queries"] = stats.queries;
   writer["inserts"] = stats.inserts;
+  writer["traffic"] = stats.traffic;
 }
 
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
@@ -31,6 +32,12 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
   writer["busy"] = stats.busy;
 }
 
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const PoolTrafficStatistics& stats) {
+  writer["sent_bytes"] = stats.sent_bytes;
+  writer["received_bytes"] = stats.received_bytes;
+}
+
 }  // namespace storages::clickhouse::stats
 
 USERVER_NAMESPACE_END
@@ -30,10 +30,17 @@ struct PoolQueryStatistics final {
   RecentPeriod timings{};
 };
 
+// Bytes on the wire, i.e. compressed if the compression is enabled
+struct PoolTrafficStatistics final {
+  Counter sent_bytes{};
+  Counter received_bytes{};
+};
+
 struct PoolStatistics final {
   PoolConnectionStatistics connections{};
   PoolQueryStatistics queries{};
   PoolQueryStatistics inserts{};
+  PoolTrafficStatistics traffic{};
 };
 
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
@@ -45,6 +52,9 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
                 const PoolConnectionStatistics& stats);
 
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const PoolTrafficStatistics& stats);
+
 }  // namespace storages::clickhouse::stats
 
 USERVER_NAMESPACE_END
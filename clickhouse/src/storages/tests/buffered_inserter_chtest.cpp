@@ -0,0 +1,120 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/engine/async.hpp>
+#include <userver/storages/clickhouse/buffered_inserter.hpp>
+
+#include "utils_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Event final {
+  uint64_t id{};
+  std::string name;
+};
+
+}  // namespace
+
+namespace storages::clickhouse::io {
+
+template <>
+struct CppToClickhouse<Event> {
+  using mapped_type = std::tuple<columns::UInt64Column, columns::StringColumn>;
+};
+
+}  // namespace storages::clickhouse::io
+
+namespace {
+
+std::shared_ptr<storages::clickhouse::Cluster> MakeNonOwning(
+    ClusterWrapper& cluster) {
+  return {std::shared_ptr<storages::clickhouse::Cluster>{}, &*cluster};
+}
+
+void CreateEventsTable(ClusterWrapper& cluster) {
+  // Not a temporary table, the inserts go through different connections
+  cluster->Execute("DROP TABLE IF EXISTS buffered_events");
+  cluster->Execute(
+      "CREATE TABLE buffered_events (id UInt64, name String) ENGINE = Memory");
+}
+
+}  // namespace
+
+UTEST_MT(BufferedInserter, GathersRowsFromManyTasks, 4) {
+  ClusterWrapper cluster{};
+  CreateEventsTable(cluster);
+
+  storages::clickhouse::BufferedInserterSettings settings;
+  settings.max_block_rows = 100;
+  settings.max_rows_in_memory = 200;
+  settings.flush_interval = std::chrono::milliseconds{10};
+
+  constexpr uint64_t kTasks = 10;
+  constexpr uint64_t kRowsPerTask = 95;
+  {
+    storages::clickhouse::BufferedInserter<Event> inserter{
+        MakeNonOwning(cluster), "buffered_events", {"id", "name"}, settings};
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (uint64_t task = 0; task < kTasks; ++task) {
+      tasks.push_back(engine::AsyncNoSpan([&inserter, task] {
+        for (uint64_t i = 0; i < kRowsPerTask; ++i) {
+          inserter.Add({task * kRowsPerTask + i, "event"});
+        }
+      }));
+    }
+    for (auto& task : tasks) task.Get();
+    inserter.Flush();
+
+    const auto stats = inserter.GetStatistics();
+    EXPECT_EQ(stats.rows_inserted, kTasks * kRowsPerTask);
+    EXPECT_EQ(stats.rows_dropped, 0);
+    EXPECT_EQ(stats.rows_in_memory, 0);
+    EXPECT_LT(stats.blocks_inserted, kTasks * kRowsPerTask);
+  }
+
+  const auto result =
+      cluster->Execute("SELECT id, name FROM buffered_events ORDER BY id")
+          .AsContainer<std::vector<Event>>();
+  ASSERT_EQ(result.size(), kTasks * kRowsPerTask);
+  for (uint64_t i = 0; i < result.size(); ++i) {
+    EXPECT_EQ(result[i].id, i);
+  }
+}
+
+UTEST(BufferedInserter, FlushesByTime) {
+  ClusterWrapper cluster{};
+  CreateEventsTable(cluster);
+
+  storages::clickhouse::BufferedInserterSettings settings;
+  settings.flush_interval = std::chrono::milliseconds{1};
+  storages::clickhouse::BufferedInserter<Event> inserter{
+      MakeNonOwning(cluster), "buffered_events", {"id", "name"}, settings};
+  inserter.Add({1, "event"});
+
+  while (inserter.GetStatistics().rows_inserted == 0) {
+    engine::SleepFor(std::chrono::milliseconds{1});
+  }
+  EXPECT_EQ(inserter.GetStatistics().blocks_inserted, 1);
+}
+
+UTEST(BufferedInserter, DropsRowsAfterAttempts) {
+  ClusterWrapper cluster{};
+  cluster->Execute("DROP TABLE IF EXISTS buffered_missing");
+
+  storages::clickhouse::BufferedInserterSettings settings;
+  settings.insert_attempts = 2;
+  settings.retry_delay = std::chrono::milliseconds{1};
+  storages::clickhouse::BufferedInserter<Event> inserter{
+      MakeNonOwning(cluster), "buffered_missing", {"id", "name"}, settings};
+  inserter.Add({1, "event"});
+  inserter.Flush();
+
+  const auto stats = inserter.GetStatistics();
+  EXPECT_EQ(stats.rows_inserted, 0);
+  EXPECT_EQ(stats.rows_dropped, 1);
+  EXPECT_EQ(stats.insert_errors, 2);
+}
+
+USERVER_NAMESPACE_END
@@ -121,4 +121,55 @@ UTEST(Execute, IterationMovesFromUnderlying) {
   }
 }
 
+UTEST(ExecuteStreaming, NumericColumnsWithoutCopies) {
+  ClusterWrapper cluster{};
+
+  // Small blocks to get the result in several of them
+  const storages::clickhouse::Query query{
+      "SELECT c.number, toFloat64(c.number) / 2 FROM numbers(0, 100000) c "
+      "SETTINGS max_block_size = 1000"};
+
+  size_t blocks = 0;
+  size_t rows = 0;
+  uint64_t sum = 0;
+  double halves_sum = 0;
+  cluster->ExecuteStreaming(
+      [&](const storages::clickhouse::BlockView& block) {
+        ++blocks;
+        rows += block.GetRowsCount();
+        const auto numbers = block.GetNumericColumn<uint64_t>(0);
+        ASSERT_EQ(numbers.size(), block.GetRowsCount());
+        for (const auto number : numbers) sum += number;
+        for (const auto half : block.GetNumericColumn<double>(1)) {
+          halves_sum += half;
+        }
+        EXPECT_ANY_THROW(block.GetNumericColumn<uint32_t>(0));
+      },
+      query);
+
+  EXPECT_GT(blocks, 1);
+  EXPECT_EQ(rows, 100000);
+  EXPECT_EQ(sum, 99999ull * 100000 / 2);
+  EXPECT_DOUBLE_EQ(halves_sum, sum / 2.0);
+}
+
+UTEST(ExecuteStreaming, CallbackErrorCancelsQuery) {
+  ClusterWrapper cluster{};
+
+  size_t blocks = 0;
+  EXPECT_THROW(cluster->ExecuteStreaming(
+                   [&blocks](const storages::clickhouse::BlockView& block) {
+                     ++blocks;
+                     EXPECT_EQ(block.As<Data>().numbers.size(),
+                               block.GetRowsCount());
+                     throw std::runtime_error{"stop"};
+                   },
+                   common_query),
+               std::runtime_error);
+  EXPECT_EQ(blocks, 1);
+
+  // The connection is still usable
+  EXPECT_EQ(cluster->Execute(common_query).GetRowsCount(), 10000);
+}
+
 USERVER_NAMESPACE_END
@@ -72,4 +72,14 @@ UTEST(Metrics, ActiveConnections) {
   EXPECT_EQ(pool->GetStatistics().connections.active, 3);
 }
 
+UTEST(Metrics, Traffic) {
+  ClusterWrapper cluster{};
+
+  cluster->Execute("SELECT 1");
+
+  const auto traffic_stats = cluster.GetStatistics("clickhouse.traffic");
+  EXPECT_GT(traffic_stats.SingleMetric("sent_bytes").AsInt(), 0);
+  EXPECT_GT(traffic_stats.SingleMetric("received_bytes").AsInt(), 0);
+}
+
 USERVER_NAMESPACE_END
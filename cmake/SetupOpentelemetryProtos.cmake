@@ -0,0 +1,46 @@
+set(USERVER_OPENTELEMETRY_PROTOS "" CACHE PATH "Path to the folder with opentelemetry proto files")
+
+if (USERVER_OPENTELEMETRY_PROTOS)
+  set(opentelemetry-proto_SOURCE_DIR ${USERVER_OPENTELEMETRY_PROTOS})
+endif()
+
+if (NOT EXISTS ${opentelemetry-proto_SOURCE_DIR})
+  include(DownloadUsingCPM)
+  CPMAddPackage(
+      NAME opentelemetry-proto
+      VERSION 1.0.0
+      GITHUB_REPOSITORY open-telemetry/opentelemetry-proto
+      GIT_TAG v1.0.0
+      DOWNLOAD_ONLY YES
+  )
+endif()
+
+if (NOT opentelemetry-proto_SOURCE_DIR)
+  message(FATAL_ERROR "Unable to get opentelemetry proto files. It is required for the OTLP exporter of userver-grpc.")
+endif()
+
+include(GrpcTargets)
+set(OTLP_PROTOS_DIR ${opentelemetry-proto_SOURCE_DIR}/opentelemetry/proto)
+set(SOURCES
+  ${OTLP_PROTOS_DIR}/common/v1/common.proto
+  ${OTLP_PROTOS_DIR}/resource/v1/resource.proto
+  ${OTLP_PROTOS_DIR}/trace/v1/trace.proto
+  ${OTLP_PROTOS_DIR}/collector/trace/v1/trace_service.proto
+)
+
+userver_generate_grpc_files(
+  PROTOS ${SOURCES}
+  INCLUDE_DIRECTORIES ${opentelemetry-proto_SOURCE_DIR}
+  SOURCE_PATH ${opentelemetry-proto_SOURCE_DIR}
+  GENERATED_INCLUDES include_paths
+  CPP_FILES generated_sources
+  CPP_USRV_FILES generated_usrv_sources
+)
+
+add_library(userver-opentelemetry-protos STATIC ${generated_sources})
+target_compile_options(userver-opentelemetry-protos PUBLIC -Wno-unused-parameter)
+target_include_directories(userver-opentelemetry-protos SYSTEM PUBLIC ${include_paths})
+target_link_libraries(userver-opentelemetry-protos PUBLIC userver-core userver-grpc-deps)
+
+set(opentelemetry-proto_LIBRARY userver-opentelemetry-protos)
+set(opentelemetry-proto_USRV_SOURCES ${generated_usrv_sources})
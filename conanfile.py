@@ -96,6 +96,8 @@ class UserverConan(ConanFile):
         self.requires('rapidjson/cci.20220822', transitive_headers=True)
         self.requires('yaml-cpp/0.7.0')
         self.requires('zlib/1.2.13')
+        self.requires('zstd/1.5.5')
+        self.requires('brotli/1.1.0')
 
         if self.options.with_jemalloc:
             self.requires('jemalloc/5.3.0')
@@ -380,6 +382,12 @@ class UserverConan(ConanFile):
         def zlib():
             return ['zlib::zlib']
 
+        def zstd():
+            return ['zstd::zstdlib']
+
+        def brotli():
+            return ['brotli::brotlienc', 'brotli::brotlidec']
+
         def jemalloc():
             return ['jemalloc::jemalloc'] if self.options.with_jemalloc else []
 
@@ -450,6 +458,8 @@ class UserverConan(ConanFile):
                     + ares()
                     + rapidjson()
                     + zlib()
+                    + zstd()
+                    + brotli()
                 ),
             },
         ]
@@ -91,10 +91,38 @@ class WebsocketsFullDuplexHandler final
   }
 };
 
+class WebsocketsDeflateHandler final
+    : public server::websocket::WebsocketHandlerBase {
+ public:
+  static constexpr std::string_view kName = "websocket-deflate-handler";
+
+  using WebsocketHandlerBase::WebsocketHandlerBase;
+
+  void Handle(server::websocket::WebSocketConnection& chat,
+              server::request::RequestContext&) const override {
+    server::websocket::Message message;
+    while (!engine::current_task::ShouldCancel()) {
+      chat.Recv(message);
+      if (message.close_status) break;
+
+      const server::websocket::PreparedMessage prepared{message.data,
+                                                        message.is_text};
+      server::websocket::WebSocketConnection* connections[] = {&chat};
+      if (message.data == "prepared") {
+        server::websocket::Broadcast(prepared, connections);
+      } else {
+        chat.Send(message);
+      }
+    }
+    if (message.close_status) chat.Close(*message.close_status);
+  }
+};
+
 int main(int argc, char* argv[]) {
   const auto component_list = components::MinimalServerComponentList()
                                   .Append<WebsocketsHandler>()
                                   .Append<WebsocketsFullDuplexHandler>()
+                                  .Append<WebsocketsDeflateHandler>()
                                   .Append<clients::dns::Component>()
                                   .Append<components::HttpClient>()
                                   .Append<components::TestsuiteSupport>()
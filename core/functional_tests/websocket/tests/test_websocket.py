@@ -91,3 +91,36 @@ async def test_two(websocket_client):
             for _ in range(10):
                 msg = await chat1.recv()
                 assert msg == b'A'
+
+
+async def test_deflate(service_client, service_port):
+    async with websockets.connect(
+            f'ws://localhost:{service_port}/chat-deflate',
+            compression='deflate',
+    ) as chat:
+        assert chat.response_headers['Sec-WebSocket-Extensions'].startswith(
+            'permessage-deflate',
+        )
+        for i in range(10):
+            msg = f'hello{i}' * 1000
+            await chat.send(msg)
+            response = await chat.recv()
+            assert response == msg
+
+
+async def test_deflate_not_offered(service_client, service_port):
+    async with websockets.connect(
+            f'ws://localhost:{service_port}/chat-deflate', compression=None,
+    ) as chat:
+        assert 'Sec-WebSocket-Extensions' not in chat.response_headers
+        msg = 'hello' * 1000
+        await chat.send(msg)
+        response = await chat.recv()
+        assert response == msg
+
+
+async def test_prepared(websocket_client):
+    async with websocket_client.get('chat-deflate') as chat:
+        await chat.send('prepared')
+        response = await chat.recv()
+        assert response == 'prepared'
@@ -92,7 +92,7 @@ class Baggage {
   Baggage(const Baggage&) noexcept;
   Baggage(Baggage&&) noexcept;
 
-  std::string ToString() const;
+  const std::string& ToString() const;
 
   /// @return vector of entries
   const std::vector<BaggageEntry>& GetEntries() const;
@@ -158,6 +158,12 @@ bool HasInvalidSymbols(const T& obj) {
 
 inline engine::TaskInheritedVariable<Baggage> kInheritedBaggage;
 
+/// @brief Parses the header right into the baggage::kInheritedBaggage of the
+/// current task, without moving the parsed baggage around
+/// @returns false if the header exceeds the length limit
+bool TrySetInheritedBaggage(std::string header,
+                            std::unordered_set<std::string> allowed_keys);
+
 }  // namespace baggage
 
 USERVER_NAMESPACE_END
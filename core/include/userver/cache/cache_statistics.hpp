@@ -3,6 +3,7 @@
 /// @file userver/cache/cache_statistics.hpp
 /// @brief Statistics collection for components::CachingComponentBase
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <cstddef>
@@ -15,8 +16,18 @@ USERVER_NAMESPACE_BEGIN
 
 namespace cache {
 
+/// Stages of an `Update`, see UpdateStatisticsScope::AddStageDuration
+enum class UpdateStage {
+  kCopy,   ///< copying of the current data for an incremental update
+  kFetch,  ///< fetching of the data from the data source
+  kParse,  ///< deserialization of the fetched data
+  kMerge,  ///< merging of the partial results of a parallel update
+};
+
 namespace impl {
 
+inline constexpr std::size_t kUpdateStagesCount = 4;
+
 struct UpdateStatistics final {
   std::atomic<std::size_t> update_attempt_count{0};
   std::atomic<std::size_t> update_no_changes_count{0};
@@ -29,6 +40,8 @@ struct UpdateStatistics final {
   std::atomic<std::chrono::steady_clock::time_point>
       last_successful_update_start_time{{}};
   std::atomic<std::chrono::milliseconds> last_update_duration{{}};
+  std::array<std::atomic<std::chrono::milliseconds>, kUpdateStagesCount>
+      last_update_stage_durations{};
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -83,6 +96,12 @@ class UpdateStatisticsScope final {
   /// @param add the number of non-valid items newly received
   void IncreaseDocumentsParseFailures(std::size_t add);
 
+  /// @brief Accounts the time spent in the `stage` of the `Update`. The sums
+  /// for the last finished update are reported in the statistics.
+  /// @note This method can be called multiple times per `Update`, including
+  /// concurrent calls from the tasks of a parallel update
+  void AddStageDuration(UpdateStage stage, std::chrono::milliseconds duration);
+
  private:
   void DoFinish(impl::UpdateState new_state);
 
@@ -90,6 +109,8 @@ class UpdateStatisticsScope final {
   impl::UpdateStatistics& update_stats_;
   impl::UpdateState state_{impl::UpdateState::kNotFinished};
   const std::chrono::steady_clock::time_point update_start_time_;
+  std::array<std::atomic<std::chrono::milliseconds>, impl::kUpdateStagesCount>
+      stage_durations_{};
 };
 
 }  // namespace cache
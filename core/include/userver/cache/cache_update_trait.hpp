@@ -131,6 +131,10 @@ class CacheUpdateTrait {
 
   virtual void ReadAndSet(dump::Reader& reader);
 
+  virtual bool GetAndWriteDelta(dump::Writer& writer) const;
+
+  virtual void ReadAndApplyDelta(dump::Reader& reader);
+
   class Impl;
   std::unique_ptr<Impl> impl_;
 };
@@ -3,9 +3,11 @@
 /// @file userver/cache/caching_component_base.hpp
 /// @brief @copybrief components::CachingComponentBase
 
+#include <iterator>
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -15,6 +17,7 @@
 #include <userver/components/component_fwd.hpp>
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/concurrent/async_event_channel.hpp>
+#include <userver/concurrent/variable.hpp>
 #include <userver/dump/helpers.hpp>
 #include <userver/dump/meta.hpp>
 #include <userver/dump/operations.hpp>
@@ -62,6 +65,7 @@ namespace components {
 /// full-update-jitter | max. amount of time by which full-update-interval may be adjusted for requests dispersal | 0
 /// updates-enabled | if false, cache updates are disabled (except for the first one if !first-update-fail-ok) | true
 /// first-update-fail-ok | whether first update failure is non-fatal | false
+/// first-update-in-background | whether to do the first update in the background right after the cache is created instead of doing it in the cache constructor. The components load does not wait for the update, and the cache is empty till the update finishes. Useful for the rarely used caches, e.g. together with the `load-mode: lazy` component option. Ignored if the periodic updates are disabled | false
 /// task-processor | the name of the TaskProcessor for running DoWork | main-task-processor
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
 /// exception-interval | Used instead of `update-interval` in case of exception | update_interval
@@ -112,6 +116,13 @@ namespace components {
 /// If both `update-interval` and `full-update-interval` are present,
 /// `full-and-incremental` types is assumed. Otherwise `only-full` is used.
 ///
+/// ### Delta dumps
+/// A map-like cache may report the keys of the entries changed by an
+/// incremental update with
+/// `Set(std::unique_ptr<const T>, const ChangedKeys&)`. With `dump.max-delta-count`
+/// set, the dumps then contain only the entries changed since the previous
+/// dump. A `Set` without the keys makes the next dump a full one.
+///
 /// @see `dump::Dumper` for more info on persistent cache dumps and
 /// corresponding config options.
 ///
@@ -155,6 +166,12 @@ class CachingComponentBase : public LoggableComponentBase,
   void Set(std::unique_ptr<const T> value_ptr);
   void Set(T&& value);
 
+  /// @brief Sets the new contents of a map-like cache after an incremental
+  /// update and remembers the keys of the inserted, modified and erased
+  /// entries for the delta dumps
+  template <typename ChangedKeys>
+  void Set(std::unique_ptr<const T> value_ptr, const ChangedKeys& changed_keys);
+
   template <typename... Args>
   void Emplace(Args&&... args);
 
@@ -181,6 +198,18 @@ class CachingComponentBase : public LoggableComponentBase,
 
   void GetAndWrite(dump::Writer& writer) const final;
   void ReadAndSet(dump::Reader& reader) final;
+  bool GetAndWriteDelta(dump::Writer& writer) const final;
+  void ReadAndApplyDelta(dump::Reader& reader) final;
+
+  struct DumpDelta final {
+    // Whether `changed_keys` are all the changes since the contents were last
+    // written to or read from a dump
+    bool is_complete{false};
+    std::vector<meta::MapKeyType<T>> changed_keys;
+  };
+
+  template <typename DeltaUpdater>
+  void DoSet(std::unique_ptr<const T> value_ptr, DeltaUpdater delta_updater);
 
   /// @brief If the option has-pre-assign-check is set true in static config,
   /// this function is called before assigning the new value to the cache
@@ -189,6 +218,8 @@ class CachingComponentBase : public LoggableComponentBase,
                               const T* new_value_ptr) const;
 
   rcu::Variable<std::shared_ptr<const T>> cache_;
+  // Protects the consistency of the contents and the changed keys
+  mutable concurrent::Variable<DumpDelta> dump_delta_;
   concurrent::AsyncEventChannel<const std::shared_ptr<const T>&> event_channel_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 };
@@ -248,6 +279,36 @@ utils::SharedReadablePtr<T> CachingComponentBase<T>::GetUnsafe() const {
 
 template <typename T>
 void CachingComponentBase<T>::Set(std::unique_ptr<const T> value_ptr) {
+  DoSet(std::move(value_ptr), [](DumpDelta& delta) {
+    delta.is_complete = false;
+    delta.changed_keys.clear();
+  });
+}
+
+template <typename T>
+template <typename ChangedKeys>
+void CachingComponentBase<T>::Set(std::unique_ptr<const T> value_ptr,
+                                  const ChangedKeys& changed_keys) {
+  static_assert(meta::kIsUniqueMap<T>,
+                "Changed keys can only be reported for map-like caches");
+  const auto size = value_ptr ? value_ptr->size() : 0;
+  DoSet(std::move(value_ptr), [&](DumpDelta& delta) {
+    if (!delta.is_complete) return;
+    delta.changed_keys.insert(delta.changed_keys.end(),
+                              std::begin(changed_keys),
+                              std::end(changed_keys));
+    // A full dump is smaller than such a delta
+    if (delta.changed_keys.size() > size) {
+      delta.is_complete = false;
+      delta.changed_keys.clear();
+    }
+  });
+}
+
+template <typename T>
+template <typename DeltaUpdater>
+void CachingComponentBase<T>::DoSet(std::unique_ptr<const T> value_ptr,
+                                    DeltaUpdater delta_updater) {
   auto deleter = [token = wait_token_storage_.GetToken(),
                   &cache_task_processor =
                       GetCacheTaskProcessor()](const T* raw_ptr) mutable {
@@ -270,7 +331,11 @@ void CachingComponentBase<T>::Set(std::unique_ptr<const T> value_ptr) {
     PreAssignCheck(old_value->get(), new_value.get());
   }
 
-  cache_.Assign(new_value);
+  {
+    auto delta = dump_delta_.Lock();
+    cache_.Assign(new_value);
+    delta_updater(*delta);
+  }
   event_channel_.SendEvent(new_value);
   OnCacheModified();
 }
@@ -288,7 +353,10 @@ void CachingComponentBase<T>::Emplace(Args&&... args) {
 
 template <typename T>
 void CachingComponentBase<T>::Clear() {
+  auto delta = dump_delta_.Lock();
   cache_.Assign(std::make_unique<const T>());
+  delta->is_complete = false;
+  delta->changed_keys.clear();
 }
 
 template <typename T>
@@ -298,14 +366,84 @@ bool CachingComponentBase<T>::MayReturnNull() const {
 
 template <typename T>
 void CachingComponentBase<T>::GetAndWrite(dump::Writer& writer) const {
-  const auto contents = GetUnsafe();
+  const auto contents = [&] {
+    auto delta = dump_delta_.Lock();
+    auto result = GetUnsafe();
+    delta->is_complete = true;
+    delta->changed_keys.clear();
+    return result;
+  }();
   if (!contents) throw cache::EmptyCacheError(Name());
   WriteContents(writer, *contents);
 }
 
 template <typename T>
 void CachingComponentBase<T>::ReadAndSet(dump::Reader& reader) {
-  Set(ReadContents(reader));
+  DoSet(ReadContents(reader), [](DumpDelta& delta) {
+    delta.is_complete = true;
+    delta.changed_keys.clear();
+  });
+}
+
+template <typename T>
+bool CachingComponentBase<T>::GetAndWriteDelta(dump::Writer& writer) const {
+  if constexpr (meta::kIsUniqueMap<T>) {
+    using Key = meta::MapKeyType<T>;
+    using Value = meta::MapValueType<T>;
+    if constexpr (dump::kIsDumpable<Key> && dump::kIsDumpable<Value>) {
+      std::vector<Key> changed_keys;
+      const auto contents = [&] {
+        auto delta = dump_delta_.Lock();
+        auto result = GetUnsafe();
+        if (delta->is_complete) std::swap(changed_keys, delta->changed_keys);
+        return delta->is_complete ? result : nullptr;
+      }();
+      if (!contents) return false;
+
+      // A key may be written several times, the delta application is
+      // idempotent
+      writer.Write(changed_keys.size());
+      for (const auto& key : changed_keys) {
+        writer.Write(key);
+        const auto it = contents->find(key);
+        writer.Write(it != contents->end());
+        if (it != contents->end()) writer.Write(it->second);
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename T>
+void CachingComponentBase<T>::ReadAndApplyDelta(dump::Reader& reader) {
+  if constexpr (meta::kIsUniqueMap<T>) {
+    using Key = meta::MapKeyType<T>;
+    using Value = meta::MapValueType<T>;
+    if constexpr (dump::kIsDumpable<Key> && dump::kIsDumpable<Value>) {
+      const auto contents = GetUnsafe();
+      if (!contents) throw cache::EmptyCacheError(Name());
+      auto new_contents = std::make_unique<T>(*contents);
+
+      const auto size = reader.Read<std::size_t>();
+      for (std::size_t i = 0; i < size; ++i) {
+        auto key = reader.Read<Key>();
+        if (reader.Read<bool>()) {
+          auto value = reader.Read<Value>();
+          new_contents->insert_or_assign(std::move(key), std::move(value));
+        } else {
+          new_contents->erase(key);
+        }
+      }
+
+      DoSet(std::move(new_contents), [](DumpDelta& delta) {
+        delta.is_complete = true;
+        delta.changed_keys.clear();
+      });
+      return;
+    }
+  }
+  dump::ThrowDumpUnimplemented(Name());
 }
 
 template <typename T>
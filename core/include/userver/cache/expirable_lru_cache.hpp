@@ -6,10 +6,12 @@
 #include <atomic>
 #include <chrono>
 #include <optional>
+#include <variant>
 
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/cache/lru_cache_statistics.hpp>
 #include <userver/cache/nway_lru_cache.hpp>
+#include <userver/cache/nway_tinylfu_cache.hpp>
 #include <userver/concurrent/mutex_set.hpp>
 #include <userver/dump/common.hpp>
 #include <userver/dump/dumper.hpp>
@@ -17,6 +19,7 @@
 #include <userver/utils/datetime.hpp>
 #include <userver/utils/impl/cached_time.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
+#include <userver/utils/statistics/hot_keys.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -53,10 +56,15 @@ impl::ExpirableValue<Value> Read(dump::Reader& reader,
 /// @brief Class for expirable LRU cache. Use cache::LruMap for not expirable
 /// LRU Cache.
 ///
+/// With EvictionPolicy::kTinyLfu the elements are stored in
+/// cache::NWayTinyLfu, that does not lock on reads and protects the hot keys
+/// from one-hit scans.
+///
 /// Example usage:
 ///
 /// @snippet cache/expirable_lru_cache_test.cpp Sample ExpirableLruCache
-template <typename Key, typename Value, typename Hash = std::hash<Key>,
+template <typename Key, typename Value,
+          typename Hash = utils::hash::Hash<Key>,
           typename Equal = std::equal_to<Key>>
 class ExpirableLruCache final {
  public:
@@ -69,7 +77,8 @@ class ExpirableLruCache final {
   };
 
   ExpirableLruCache(size_t ways, size_t way_size, const Hash& hash = Hash(),
-                    const Equal& equal = Equal());
+                    const Equal& equal = Equal(),
+                    EvictionPolicy eviction_policy = EvictionPolicy::kLru);
 
   ~ExpirableLruCache();
 
@@ -86,10 +95,27 @@ class ExpirableLruCache final {
    */
   void SetBackgroundUpdate(BackgroundUpdateMode background_update);
 
+  /**
+   * Sets how long an expired value is still returned by Get() and
+   * GetOptional() while it is being updated in background
+   * (stale-while-revalidate). 0 disables returning of expired values.
+   */
+  void SetStaleLifetime(std::chrono::milliseconds stale_lifetime);
+
+  /**
+   * Sets how long Get() waits for a concurrent update of the same key. After
+   * the timeout the value is got from "update_func" without waiting and is not
+   * stored in cache. 0 means waiting for the concurrent update indefinitely.
+   */
+  void SetCoalescingWaitTimeout(std::chrono::milliseconds timeout);
+
   /**
    * @returns GetOptional("key", update_func) if it is not std::nullopt.
    * Otherwise the result of update_func(key) is returned, and additionally
    * stored in cache if "read_mode" is kUseCache.
+   *
+   * Concurrent misses for the same key are coalesced: only one of them calls
+   * update_func, the others wait for it and return the value it has stored.
    */
   Value Get(const Key& key, const UpdateValueFunc& update_func,
             ReadMode read_mode = ReadMode::kUseCache);
@@ -148,6 +174,10 @@ class ExpirableLruCache final {
   /// thread-safe.
   void SetDumper(std::shared_ptr<dump::Dumper> dumper);
 
+  /// The lookups of the keys will be accounted in `hot_keys`. This method is
+  /// not thread-safe.
+  void SetHotKeys(std::shared_ptr<utils::statistics::HotKeys> hot_keys);
+
  private:
   bool IsExpired(std::chrono::steady_clock::time_point update_time,
                  std::chrono::steady_clock::time_point now) const;
@@ -155,20 +185,60 @@ class ExpirableLruCache final {
   bool ShouldUpdate(std::chrono::steady_clock::time_point update_time,
                     std::chrono::steady_clock::time_point now) const;
 
-  cache::NWayLRU<Key, impl::ExpirableValue<Value>, Hash, Equal> lru_;
+  bool CanServeStale(std::chrono::steady_clock::time_point update_time,
+                     std::chrono::steady_clock::time_point now) const;
+
+  template <typename Func>
+  decltype(auto) VisitLru(Func&& func) {
+    return std::visit(std::forward<Func>(func), lru_);
+  }
+
+  template <typename Func>
+  decltype(auto) VisitLru(Func&& func) const {
+    return std::visit(std::forward<Func>(func), lru_);
+  }
+
+  std::optional<impl::ExpirableValue<Value>> LruGet(const Key& key) {
+    return VisitLru([&key](auto& lru) { return lru.Get(key); });
+  }
+
+  void LruPut(const Key& key, impl::ExpirableValue<Value>&& value) {
+    VisitLru([&](auto& lru) { lru.Put(key, std::move(value)); });
+  }
+
+  void AccountHotKey(const Key& key) {
+    if constexpr (utils::statistics::kIsHotKeyTrackable<Key>) {
+      if (hot_keys_) hot_keys_->Account(key);
+    }
+  }
+
+  std::variant<cache::NWayLRU<Key, impl::ExpirableValue<Value>, Hash, Equal>,
+               cache::NWayTinyLfu<Key, impl::ExpirableValue<Value>, Hash,
+                                  Equal>>
+      lru_;
   std::atomic<std::chrono::milliseconds> max_lifetime_{
       std::chrono::milliseconds(0)};
   std::atomic<BackgroundUpdateMode> background_update_mode_{
       BackgroundUpdateMode::kDisabled};
+  std::atomic<std::chrono::milliseconds> stale_lifetime_{
+      std::chrono::milliseconds(0)};
+  std::atomic<std::chrono::milliseconds> coalescing_wait_timeout_{
+      std::chrono::milliseconds(0)};
   impl::ExpirableLruCacheStatistics stats_;
   concurrent::MutexSet<Key, Hash, Equal> mutex_set_;
   utils::impl::WaitTokenStorage wait_token_storage_;
+  std::shared_ptr<utils::statistics::HotKeys> hot_keys_;
 };
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
-    size_t ways, size_t way_size, const Hash& hash, const Equal& equal)
-    : lru_(ways, way_size, hash, equal),
+    size_t ways, size_t way_size, const Hash& hash, const Equal& equal,
+    EvictionPolicy eviction_policy)
+    : lru_(eviction_policy == EvictionPolicy::kTinyLfu
+               ? decltype(lru_){std::in_place_index<1>, ways, way_size, hash,
+                                equal}
+               : decltype(lru_){std::in_place_index<0>, ways, way_size, hash,
+                                equal}),
       mutex_set_{ways, way_size, hash, equal} {}
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -178,7 +248,7 @@ ExpirableLruCache<Key, Value, Hash, Equal>::~ExpirableLruCache() {
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::SetWaySize(size_t way_size) {
-  lru_.UpdateWaySize(way_size);
+  VisitLru([way_size](auto& lru) { lru.UpdateWaySize(way_size); });
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -199,6 +269,18 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::SetBackgroundUpdate(
   background_update_mode_ = background_update;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetStaleLifetime(
+    std::chrono::milliseconds stale_lifetime) {
+  stale_lifetime_ = stale_lifetime;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetCoalescingWaitTimeout(
+    std::chrono::milliseconds timeout) {
+  coalescing_wait_timeout_ = timeout;
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
     const Key& key, const UpdateValueFunc& update_func, ReadMode read_mode) {
@@ -209,17 +291,26 @@ Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
   }
 
   auto mutex = mutex_set_.GetMutexForKey(key);
-  std::lock_guard lock(mutex);
+  std::unique_lock lock(mutex, std::defer_lock);
+  const auto wait_timeout = coalescing_wait_timeout_.load();
+  if (wait_timeout.count() == 0) {
+    lock.lock();
+  } else if (!lock.try_lock_for(wait_timeout)) {
+    // the concurrent update takes too long, do not wait for it
+    return update_func(key);
+  }
+
   // Test one more time - concurrent ExpirableLruCache::Get()
   // might have put the value
-  auto old_value = lru_.Get(key);
+  auto old_value = LruGet(key);
   if (old_value && !IsExpired(old_value->update_time, now)) {
+    impl::CacheCoalesced(stats_);
     return std::move(old_value->value);
   }
 
   auto value = update_func(key);
   if (read_mode == ReadMode::kUseCache) {
-    lru_.Put(key, {value, now});
+    LruPut(key, {value, now});
   }
   return value;
 }
@@ -228,7 +319,8 @@ template <typename Key, typename Value, typename Hash, typename Equal>
 std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(
     const Key& key, const UpdateValueFunc& update_func) {
   auto now = utils::datetime::SteadyNow();
-  auto old_value = lru_.Get(key);
+  AccountHotKey(key);
+  auto old_value = LruGet(key);
 
   if (old_value) {
     if (!IsExpired(old_value->update_time, now)) {
@@ -241,6 +333,11 @@ std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(
       return std::move(old_value->value);
     } else {
       impl::CacheStale(stats_);
+
+      if (CanServeStale(old_value->update_time, now)) {
+        UpdateInBackground(key, update_func);
+        return std::move(old_value->value);
+      }
     }
   }
   impl::CacheMiss(stats_);
@@ -252,7 +349,8 @@ template <typename Key, typename Value, typename Hash, typename Equal>
 std::optional<Value>
 ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalUnexpirable(
     const Key& key) {
-  auto old_value = lru_.Get(key);
+  AccountHotKey(key);
+  auto old_value = LruGet(key);
 
   if (old_value) {
     impl::CacheHit(stats_);
@@ -268,7 +366,8 @@ std::optional<Value>
 ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalUnexpirableWithUpdate(
     const Key& key, const UpdateValueFunc& update_func) {
   auto now = utils::datetime::SteadyNow();
-  auto old_value = lru_.Get(key);
+  AccountHotKey(key);
+  auto old_value = LruGet(key);
 
   if (old_value) {
     impl::CacheHit(stats_);
@@ -289,7 +388,8 @@ std::optional<Value>
 ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalNoUpdate(
     const Key& key) {
   auto now = utils::datetime::SteadyNow();
-  auto old_value = lru_.Get(key);
+  AccountHotKey(key);
+  auto old_value = LruGet(key);
 
   if (old_value) {
     if (!IsExpired(old_value->update_time, now)) {
@@ -308,13 +408,13 @@ ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalNoUpdate(
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Put(const Key& key,
                                                      const Value& value) {
-  lru_.Put(key, {value, utils::datetime::SteadyNow()});
+  LruPut(key, {value, utils::datetime::SteadyNow()});
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Put(const Key& key,
                                                      Value&& value) {
-  lru_.Put(key, {std::move(value), utils::datetime::SteadyNow()});
+  LruPut(key, {std::move(value), utils::datetime::SteadyNow()});
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -325,18 +425,18 @@ ExpirableLruCache<Key, Value, Hash, Equal>::GetStatistics() const {
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetSizeApproximate() const {
-  return lru_.GetSize();
+  return VisitLru([](const auto& lru) { return lru.GetSize(); });
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Invalidate() {
-  lru_.Invalidate();
+  VisitLru([](auto& lru) { lru.Invalidate(); });
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::InvalidateByKey(
     const Key& key) {
-  lru_.InvalidateByKey(key);
+  VisitLru([&key](auto& lru) { lru.InvalidateByKey(key); });
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -357,7 +457,7 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::UpdateInBackground(
 
     auto now = utils::datetime::SteadyNow();
     auto value = update_func(key);
-    lru_.Put(key, {value, now});
+    LruPut(key, {value, now});
   }).Detach();
 }
 
@@ -378,7 +478,17 @@ bool ExpirableLruCache<Key, Value, Hash, Equal>::ShouldUpdate(
          max_lifetime.count() != 0 && update_time + max_lifetime / 2 < now;
 }
 
-template <typename Key, typename Value, typename Hash = std::hash<Key>,
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool ExpirableLruCache<Key, Value, Hash, Equal>::CanServeStale(
+    std::chrono::steady_clock::time_point update_time,
+    std::chrono::steady_clock::time_point now) const {
+  auto stale_lifetime = stale_lifetime_.load();
+  return stale_lifetime.count() != 0 &&
+         update_time + max_lifetime_.load() + stale_lifetime >= now;
+}
+
+template <typename Key, typename Value,
+          typename Hash = utils::hash::Hash<Key>,
           typename Equal = std::equal_to<Key>>
 class LruCacheWrapper final {
  public:
@@ -418,19 +528,27 @@ template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Write(
     dump::Writer& writer) const {
   utils::impl::UpdateGlobalTime();
-  lru_.Write(writer);
+  VisitLru([&writer](const auto& lru) { lru.Write(writer); });
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::Read(dump::Reader& reader) {
   utils::impl::UpdateGlobalTime();
-  lru_.Read(reader);
+  VisitLru([&reader](auto& lru) { lru.Read(reader); });
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 void ExpirableLruCache<Key, Value, Hash, Equal>::SetDumper(
     std::shared_ptr<dump::Dumper> dumper) {
-  lru_.SetDumper(std::move(dumper));
+  VisitLru([&dumper](auto& lru) { lru.SetDumper(std::move(dumper)); });
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::SetHotKeys(
+    std::shared_ptr<utils::statistics::HotKeys> hot_keys) {
+  static_assert(utils::statistics::kIsHotKeyTrackable<Key>,
+                "Hot keys are strings or are formattable with fmt");
+  hot_keys_ = std::move(hot_keys);
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -4,6 +4,7 @@
 /// @brief @copybrief cache::LruCacheComponent
 
 #include <functional>
+#include <stdexcept>
 
 #include <userver/cache/expirable_lru_cache.hpp>
 #include <userver/cache/lru_cache_config.hpp>
@@ -34,6 +35,9 @@ utils::statistics::Entry RegisterOnStatisticsStorage(
 dynamic_config::Source FindDynamicConfigSource(
     const components::ComponentContext& context);
 
+std::shared_ptr<utils::statistics::HotKeys> FindHotKeys(
+    const components::ComponentContext& context, const std::string& source);
+
 bool IsDumpSupportEnabled(const components::ComponentConfig& config);
 
 yaml_config::Schema GetLruCacheComponentBaseSchema();
@@ -48,6 +52,8 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 ///
 /// Provides facilities for creating LRU caches.
 /// You need to override LruCacheComponent::DoGetByKey to handle cache misses.
+/// Concurrent misses for the same key are coalesced: only one of them calls
+/// DoGetByKey, the others wait for it and get the stored value.
 ///
 /// Caching components must be configured in service config (see options below)
 /// and may be reconfigured dynamically via components::DynamicConfig.
@@ -61,7 +67,12 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// size | max amount of items to store in cache | --
 /// ways | number of ways for associative cache | --
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
+/// background-update | enables asynchronous updates for expiring values | false
+/// stale-lifetime | how long an expired entry is returned while it is being updated in background (0 disables stale-while-revalidate) | 0
+/// coalescing-wait-timeout | how long a cache miss waits for a concurrent DoGetByKey for the same key before calling DoGetByKey by itself (0 is unlimited) | 0
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
+/// eviction-policy | 'lru' or 'tiny-lfu' for lock-free reads with W-TinyLFU admission, see cache::NWayTinyLfu | lru
+/// hot-keys | enables detection of the hot keys in components::HotKeysStorage: the lookups are accounted as the source named as the component, the keys loaded by DoGetByKey as `<name>.loads` | false
 ///
 /// ## Example usage:
 ///
@@ -74,7 +85,8 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// @snippet cache/lru_cache_component_base_test.cpp  Sample lru cache component config
 
 // clang-format on
-template <typename Key, typename Value, typename Hash = std::hash<Key>,
+template <typename Key, typename Value,
+          typename Hash = utils::hash::Hash<Key>,
           typename Equal = std::equal_to<Key>>
 // NOLINTNEXTLINE(fuchsia-multiple-inheritance)
 class LruCacheComponent : public components::LoggableComponentBase,
@@ -121,6 +133,7 @@ class LruCacheComponent : public components::LoggableComponentBase,
   concurrent::AsyncEventSubscriberScope config_subscription_;
   utils::statistics::Entry statistics_holder_;
   std::optional<testsuite::ComponentInvalidatorHolder> invalidator_holder_;
+  std::shared_ptr<utils::statistics::HotKeys> loads_hot_keys_;
 };
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -130,8 +143,9 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
     : LoggableComponentBase(config, context),
       name_(components::GetCurrentComponentName(config)),
       static_config_(config),
-      cache_(std::make_shared<Cache>(static_config_.ways,
-                                     static_config_.GetWaySize())) {
+      cache_(std::make_shared<Cache>(
+          static_config_.ways, static_config_.GetWaySize(), Hash(), Equal(),
+          static_config_.eviction_policy)) {
   if (impl::IsDumpSupportEnabled(config)) {
     dumper_ = std::make_shared<dump::Dumper>(
         config, context, static_cast<dump::DumpableEntity&>(*this));
@@ -141,6 +155,19 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
 
   cache_->SetMaxLifetime(static_config_.config.lifetime);
   cache_->SetBackgroundUpdate(static_config_.config.background_update);
+  cache_->SetStaleLifetime(static_config_.config.stale_lifetime);
+  cache_->SetCoalescingWaitTimeout(
+      static_config_.config.coalescing_wait_timeout);
+
+  if constexpr (utils::statistics::kIsHotKeyTrackable<Key>) {
+    if (static_config_.hot_keys) {
+      cache_->SetHotKeys(impl::FindHotKeys(context, name_));
+      loads_hot_keys_ = impl::FindHotKeys(context, name_ + ".loads");
+    }
+  } else if (static_config_.hot_keys) {
+    throw std::runtime_error(
+        "hot-keys require string or fmt-formattable keys, cache=" + name_);
+  }
 
   if (static_config_.use_dynamic_config) {
     LOG_INFO() << "Dynamic LRU cache config is enabled, subscribing on "
@@ -188,6 +215,9 @@ void LruCacheComponent<Key, Value, Hash, Equal>::DropCache() {
 
 template <typename Key, typename Value, typename Hash, typename Equal>
 Value LruCacheComponent<Key, Value, Hash, Equal>::GetByKey(const Key& key) {
+  if constexpr (utils::statistics::kIsHotKeyTrackable<Key>) {
+    if (loads_hot_keys_) loads_hot_keys_->Account(key);
+  }
   return DoGetByKey(key);
 }
 
@@ -210,6 +240,8 @@ void LruCacheComponent<Key, Value, Hash, Equal>::UpdateConfig(
   cache_->SetWaySize(config.GetWaySize(static_config_.ways));
   cache_->SetMaxLifetime(config.lifetime);
   cache_->SetBackgroundUpdate(config.background_update);
+  cache_->SetStaleLifetime(config.stale_lifetime);
+  cache_->SetCoalescingWaitTimeout(config.coalescing_wait_timeout);
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -19,6 +19,12 @@ enum class BackgroundUpdateMode {
   kDisabled,
 };
 
+/// Eviction policy of cache::ExpirableLruCache
+enum class EvictionPolicy {
+  kLru,      ///< cache::NWayLRU, reads lock the way
+  kTinyLfu,  ///< cache::NWayTinyLfu, reads do not lock
+};
+
 struct LruCacheConfig final {
   explicit LruCacheConfig(const yaml_config::YamlConfig& config);
   explicit LruCacheConfig(const components::ComponentConfig& config);
@@ -30,6 +36,8 @@ struct LruCacheConfig final {
   std::size_t size;
   std::chrono::milliseconds lifetime;
   BackgroundUpdateMode background_update;
+  std::chrono::milliseconds stale_lifetime;
+  std::chrono::milliseconds coalescing_wait_timeout;
 };
 
 LruCacheConfig Parse(const formats::json::Value& value,
@@ -44,6 +52,8 @@ struct LruCacheConfigStatic final {
   LruCacheConfig config;
   std::size_t ways;
   bool use_dynamic_config;
+  EvictionPolicy eviction_policy;
+  bool hot_keys;
 };
 
 extern const dynamic_config::Key<
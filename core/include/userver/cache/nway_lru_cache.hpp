@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -14,7 +15,8 @@ USERVER_NAMESPACE_BEGIN
 namespace cache {
 
 /// @ingroup userver_containers
-template <typename T, typename U, typename Hash = std::hash<T>,
+template <typename T, typename U,
+          typename Hash = utils::hash::Hash<T>,
           typename Equal = std::equal_to<T>>
 class NWayLRU final {
  public:
@@ -165,12 +167,10 @@ template <typename T, typename U, typename Hash, typename Eq>
 typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(
     const T& key) {
   /// It is needed to twist hash because there is hash map in LruMap. Otherwise
-  /// nodes will fall into one bucket. According to
-  /// https://www.boost.org/doc/libs/1_83_0/libs/container_hash/doc/html/hash.html#notes_hash_combine
-  /// hash_combine can be treated as hash itself
-  auto seed = hash_fn_(key);
-  boost::hash_combine(seed, 0);
-  auto n = seed % caches_.size();
+  /// nodes will fall into one bucket. Same as in NWayTinyLfu, the middle bits
+  /// of the Fibonacci hashing product depend on all the low bits of the hash.
+  const std::uint64_t hash = hash_fn_(key);
+  const auto n = (hash * 0x9E3779B97F4A7C15ULL >> 32) % caches_.size();
   return caches_[n];
 }
 
@@ -0,0 +1,406 @@
+#pragma once
+
+/// @file userver/cache/nway_tinylfu_cache.hpp
+/// @brief @copybrief cache::NWayTinyLfu
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/persistent_hash_map.hpp>
+#include <userver/dump/dumper.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_containers
+///
+/// @brief Concurrent size-limited cache with the same interface as
+/// cache::NWayLRU, that does not lock on reads.
+///
+/// Each way is an rcu::Variable with a cache::PersistentHashMap, so Get()
+/// reads the current snapshot of the way without locks. Writers of a way are
+/// serialized, a write copies only the path to the changed element.
+///
+/// Eviction uses W-TinyLFU (https://arxiv.org/abs/1512.00727): new keys get
+/// into a small window (1% of the way), the keys evicted from the window are
+/// admitted to the main part of the way only if they are accessed more often
+/// than the key they would evict. Access frequencies are estimated by a
+/// count-min sketch, so one-hit scans do not flush the cache. Recency in both
+/// parts is approximated with CLOCK: a read only sets a flag of the element,
+/// and the writer skips the flagged elements when looking for a victim.
+template <typename T, typename U,
+          typename Hash = utils::hash::Hash<T>,
+          typename Equal = std::equal_to<T>>
+class NWayTinyLfu final {
+ public:
+  NWayTinyLfu(size_t ways, size_t way_size, const Hash& hash = Hash(),
+              const Equal& equal = Equal());
+
+  void Put(const T& key, U value);
+
+  template <typename Validator>
+  std::optional<U> Get(const T& key, Validator validator);
+
+  std::optional<U> Get(const T& key) {
+    return Get(key, [](const U&) { return true; });
+  }
+
+  U GetOr(const T& key, const U& default_value);
+
+  void Invalidate();
+
+  void InvalidateByKey(const T& key);
+
+  /// Iterates over all items. May be slow for big caches.
+  template <typename Function>
+  void VisitAll(Function func) const;
+
+  size_t GetSize() const;
+
+  void UpdateWaySize(size_t way_size);
+
+  void Write(dump::Writer& writer) const;
+  void Read(dump::Reader& reader);
+
+  /// The dump::Dumper will be notified of any cache updates. This method is not
+  /// thread-safe.
+  void SetDumper(std::shared_ptr<dump::Dumper> dumper);
+
+ private:
+  struct Entry final {
+    Entry(const T& key, U&& value) : key(key), value(std::move(value)) {}
+
+    const T key;
+    const U value;
+    std::atomic<bool> is_referenced{false};
+
+    // Modified by the writers of the way only
+    bool is_in_window{true};
+    std::size_t ring_index{0};
+  };
+
+  using EntryPtr = std::shared_ptr<Entry>;
+  using Map = PersistentHashMap<T, EntryPtr, Hash, Equal>;
+
+  // CLOCK list of the entries of the window or of the main part of the way
+  class Ring final {
+   public:
+    std::size_t GetSize() const noexcept { return size_; }
+
+    void Add(const EntryPtr& entry) {
+      if (free_indices_.empty()) {
+        entry->ring_index = entries_.size();
+        entries_.push_back(entry);
+      } else {
+        entry->ring_index = free_indices_.back();
+        free_indices_.pop_back();
+        entries_[entry->ring_index] = entry;
+      }
+      ++size_;
+    }
+
+    void Replace(const EntryPtr& old_entry, const EntryPtr& entry) {
+      entry->ring_index = old_entry->ring_index;
+      entries_[entry->ring_index] = entry;
+    }
+
+    void Remove(const Entry& entry) {
+      entries_[entry.ring_index].reset();
+      free_indices_.push_back(entry.ring_index);
+      --size_;
+    }
+
+    /// Returns the first not recently read entry after the hand
+    EntryPtr FindVictim() {
+      if (size_ == 0) return {};
+      // The readers may set the flags concurrently, two rounds are enough
+      // in practice, and the search stops anyway after that
+      for (std::size_t i = 0; i < 2 * entries_.size(); ++i) {
+        if (hand_ >= entries_.size()) hand_ = 0;
+        auto& entry = entries_[hand_++];
+        if (entry && !entry->is_referenced.exchange(false)) return entry;
+      }
+      for (const auto& entry : entries_) {
+        if (entry) return entry;
+      }
+      return {};
+    }
+
+    void Clear() noexcept {
+      entries_.clear();
+      free_indices_.clear();
+      hand_ = 0;
+      size_ = 0;
+    }
+
+   private:
+    std::vector<EntryPtr> entries_;
+    std::vector<std::size_t> free_indices_;
+    std::size_t hand_{0};
+    std::size_t size_{0};
+  };
+
+  struct Way final {
+    Way(const Hash& hash, const Equal& equal)
+        : map(rcu::DestructionType::kSync, hash, equal) {}
+
+    rcu::Variable<Map> map;
+
+    // Protected by the writer lock of the `map`
+    Ring window;
+    Ring main;
+    std::size_t window_size{1};
+    std::size_t main_size{0};
+  };
+
+  Way& GetWay(std::size_t hash);
+
+  void SetWaySize(Way& way, std::size_t way_size);
+
+  void Add(Way& way, Map& map, const T& key, U&& value);
+  void Remove(Way& way, Map& map, const Entry& entry);
+  void Evict(Way& way, Map& map);
+
+  void NotifyDumper();
+
+  std::vector<std::unique_ptr<Way>> ways_;
+  Hash hash_fn_;
+  impl::FrequencySketch sketch_;
+  std::shared_ptr<dump::Dumper> dumper_{nullptr};
+};
+
+template <typename T, typename U, typename Hash, typename Eq>
+NWayTinyLfu<T, U, Hash, Eq>::NWayTinyLfu(size_t ways, size_t way_size,
+                                         const Hash& hash, const Eq& equal)
+    : hash_fn_(hash), sketch_(ways * way_size) {
+  if (ways == 0) throw std::logic_error("Ways must be positive");
+
+  ways_.reserve(ways);
+  for (size_t i = 0; i < ways; ++i) {
+    ways_.push_back(std::make_unique<Way>(hash, equal));
+    SetWaySize(*ways_.back(), way_size);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayTinyLfu<T, U, Hash, Eq>::Put(const T& key, U value) {
+  auto& way = GetWay(hash_fn_(key));
+  {
+    auto map = way.map.StartWrite();
+    const auto it = map->find(key);
+    if (it != map->end()) {
+      const auto& old_entry = it->second;
+      auto entry = std::make_shared<Entry>(key, std::move(value));
+      entry->is_in_window = old_entry->is_in_window;
+      entry->is_referenced.store(true, std::memory_order_relaxed);
+      (entry->is_in_window ? way.window : way.main).Replace(old_entry, entry);
+      map->insert_or_assign(key, std::move(entry));
+    } else {
+      Add(way, *map, key, std::move(value));
+    }
+    map.Commit();
+  }
+  NotifyDumper();
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Validator>
+std::optional<U> NWayTinyLfu<T, U, Hash, Eq>::Get(const T& key,
+                                                  Validator validator) {
+  const auto hash = hash_fn_(key);
+  sketch_.Increment(hash);
+  auto& way = GetWay(hash);
+  {
+    const auto map = way.map.Read();
+    const auto it = map->find(key);
+    if (it == map->end()) return std::nullopt;
+
+    auto& entry = *it->second;
+    // Avoids writes to the shared cache line for the hot keys
+    if (!entry.is_referenced.load(std::memory_order_relaxed)) {
+      entry.is_referenced.store(true, std::memory_order_relaxed);
+    }
+    if (validator(entry.value)) return entry.value;
+  }
+
+  InvalidateByKey(key);
+  return std::nullopt;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+U NWayTinyLfu<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
+  auto value = Get(key);
+  if (value) return std::move(*value);
+  return default_value;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayTinyLfu<T, U, Hash, Eq>::Invalidate() {
+  for (auto& way : ways_) {
+    auto map = way->map.StartWrite();
+    map->clear();
+    way->window.Clear();
+    way->main.Clear();
+    map.Commit();
+  }
+  sketch_.Clear();
+  NotifyDumper();
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayTinyLfu<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
+  auto& way = GetWay(hash_fn_(key));
+  // Does not copy the snapshot if there is nothing to erase
+  if (const auto snapshot = way.map.Read(); !snapshot->contains(key)) return;
+  {
+    auto map = way.map.StartWrite();
+    const auto it = map->find(key);
+    if (it == map->end()) return;
+    Remove(way, *map, *it->second);
+    map.Commit();
+  }
+  NotifyDumper();
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+template <typename Function>
+void NWayTinyLfu<T, U, Hash, Eq>::VisitAll(Function func) const {
+  for (const auto& way : ways_) {
+    const auto map = way->map.Read();
+    for (const auto& [key, entry] : *map) func(key, entry->value);
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+size_t NWayTinyLfu<T, U, Hash, Eq>::GetSize() const {
+  size_t size{0};
+  for (const auto& way : ways_) {
+    const auto map = way->map.Read();
+    size += map->size();
+  }
+  return size;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayTinyLfu<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
+  for (auto& way : ways_) {
+    auto map = way->map.StartWrite();
+    SetWaySize(*way, way_size);
+    while (way->window.GetSize() > way->window_size) Evict(*way, *map);
+    while (way->main.GetSize() > way->main_size) {
+      Remove(*way, *map, *way->main.FindVictim());
+    }
+    map.Commit();
+  }
+  sketch_.SetCapacity(ways_.size() * way_size);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+typename NWayTinyLfu<T, U, Hash, Eq>::Way& NWayTinyLfu<T, U, Hash, Eq>::GetWay(
+    std::size_t hash) {
+  // Twisted, because the same hash is used by the maps of the ways
+  return *ways_[(hash * 0x9E3779B97F4A7C15ULL >> 32) % ways_.size()];
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayTinyLfu<T, U, Hash, Eq>::SetWaySize(Way& way, std::size_t way_size) {
+  way.window_size = std::max<std::size_t>(1, way_size / 100);
+  way.main_size = way_size > way.window_size ? way_size - way.window_size : 0;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayTinyLfu<T, U, Hash, Eq>::Add(Way& way, Map& map, const T& key,
+                                      U&& value) {
+  auto entry = std::make_shared<Entry>(key, std::move(value));
+  way.window.Add(entry);
+  map.insert_or_assign(key, std::move(entry));
+  if (way.window.GetSize() > way.window_size) Evict(way, map);
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayTinyLfu<T, U, Hash, Eq>::Remove(Way& way, Map& map,
+                                         const Entry& entry) {
+  (entry.is_in_window ? way.window : way.main).Remove(entry);
+  // `entry` is owned by the map and may be destroyed by the erase
+  const auto key = entry.key;
+  map.erase(key);
+}
+
+// Moves the window victim to the main part if there is room in it or if the
+// victim is accessed more often than the main victim
+template <typename T, typename U, typename Hash, typename Eq>
+void NWayTinyLfu<T, U, Hash, Eq>::Evict(Way& way, Map& map) {
+  auto candidate = way.window.FindVictim();
+  way.window.Remove(*candidate);
+
+  if (way.main.GetSize() >= way.main_size) {
+    auto victim = way.main.FindVictim();
+    if (!victim || sketch_.Estimate(hash_fn_(candidate->key)) <=
+                       sketch_.Estimate(hash_fn_(victim->key))) {
+      map.erase(candidate->key);
+      return;
+    }
+    Remove(way, map, *victim);
+  }
+
+  candidate->is_in_window = false;
+  way.main.Add(candidate);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void NWayTinyLfu<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
+  writer.Write(ways_.size());
+
+  for (const auto& way : ways_) {
+    const auto map = way->map.Read();
+    writer.Write(map->size());
+    for (const auto& [key, entry] : *map) {
+      writer.Write(key);
+      writer.Write(entry->value);
+    }
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void NWayTinyLfu<T, U, Hash, Equal>::Read(dump::Reader& reader) {
+  Invalidate();
+
+  const auto ways = reader.Read<std::size_t>();
+  for (std::size_t i = 0; i < ways; ++i) {
+    const auto elements_in_way = reader.Read<std::size_t>();
+    for (std::size_t j = 0; j < elements_in_way; ++j) {
+      auto key = reader.Read<T>();
+      auto value = reader.Read<U>();
+      Put(std::move(key), std::move(value));
+    }
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void NWayTinyLfu<T, U, Hash, Equal>::NotifyDumper() {
+  if (dumper_ != nullptr) {
+    dumper_->OnUpdateCompleted();
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void NWayTinyLfu<T, U, Hash, Equal>::SetDumper(
+    std::shared_ptr<dump::Dumper> dumper) {
+  dumper_ = std::move(dumper);
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -33,6 +33,7 @@ namespace clients::dns {
 /// cache-size-per-way | size of each way of network cache | 256
 /// cache-max-reply-ttl | TTL limit for network replies caching | 5m
 /// cache-failure-ttl | TTL for network failures caching | 5s
+/// cache-refresh-period | period of the background refresh of the network cache records that are about to expire, 0 to refresh only on queries | 0s
 ///
 /// ## Static configuration example:
 ///
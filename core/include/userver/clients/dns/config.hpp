@@ -39,6 +39,11 @@ struct ResolverConfig {
 
   /// Network cache failure TTL
   std::chrono::milliseconds cache_failure_ttl{std::chrono::seconds{5}};
+
+  /// Network cache refresh period, records expiring before the next refresh
+  /// are resolved again in background. Zero disables the refresh, the records
+  /// are then updated only by the queries close to the expiration.
+  std::chrono::milliseconds cache_refresh_period{0};
 };
 
 }  // namespace clients::dns
@@ -36,6 +36,7 @@ class HeadersPropagator;
 namespace curl {
 class easy;
 class multi;
+class share;
 class ConnectRateLimiter;
 }  // namespace curl
 
@@ -53,6 +54,8 @@ class Statistics;
 struct PoolStatistics;
 struct InstanceStatistics;
 class DestinationStatistics;
+class AddressBalancer;
+class DirectTransport;
 
 /// @ingroup userver_clients
 ///
@@ -133,6 +136,10 @@ class Client final {
  private:
   void ReinitEasy();
 
+  Request CreateRequestWithNewEasy(std::size_t multi_index);
+  Request SetupRequest(Request&& request);
+  void Preconnect();
+
   InstanceStatistics GetMultiStatistics(size_t n) const;
 
   size_t FindMultiIndex(const curl::multi*) const;
@@ -169,6 +176,10 @@ class Client final {
 
   utils::SwappingSmart<const curl::easy> easy_;
   utils::PeriodicTask easy_reinit_task_;
+  std::shared_ptr<curl::share> share_;
+
+  impl::PreconnectSettings preconnect_;
+  utils::PeriodicTask preconnect_task_;
 
   // Testsuite support
   std::shared_ptr<const TestsuiteConfig> testsuite_config_;
@@ -177,6 +188,8 @@ class Client final {
   std::shared_ptr<curl::ConnectRateLimiter> connect_rate_limiter_;
 
   clients::dns::Resolver* resolver_{nullptr};
+  std::unique_ptr<AddressBalancer> address_balancer_;
+  std::unique_ptr<DirectTransport> direct_transport_;
   utils::NotNull<const tracing::TracingManagerBase*> tracing_manager_;
   const server::http::HeadersPropagator* headers_propagator_{nullptr};
   impl::PluginPipeline plugin_pipeline_;
@@ -38,6 +38,22 @@ namespace components {
 /// thread-name-prefix | set OS thread name to this value | ''
 /// threads | number of threads to process low level HTTP related IO system calls | 8
 /// defer-events | whether to defer events execution to a periodic timer; might affect timings a bit, might boost performance, use with care | false
+/// multiplexing-enabled | whether to multiplex HTTP/2 requests to the same host over a single connection, see clients::http::HttpVersion | false
+/// max-host-connections | max number of connections to a single host per IO thread, 0 is unlimited | 0
+/// max-concurrent-streams | max number of HTTP/2 streams multiplexed over a single connection | 100
+/// preconnect.urls | URLs to request with HEAD to open and refresh the connections to the destinations | []
+/// preconnect.connections | number of warm connections to each destination per IO thread | 1
+/// preconnect.refresh-period | period of the requests, must be less than the keep-alive timeout of the destinations | 60s
+/// concurrency-limiter.enabled | limit the requests in flight to each destination metric, the requests over the limit fail at once with clients::http::NetworkProblemException | false
+/// concurrency-limiter.initial-limit | limit of a new destination | 20
+/// concurrency-limiter.min-limit | lower bound of the limit | 1
+/// concurrency-limiter.max-limit | upper bound of the limit | 1000
+/// concurrency-limiter.rtt-tolerance | ratio of the recent response time to the long-term one that does not shrink the limit | 1.5
+/// concurrency-limiter.smoothing | weight of a new sample in the limit, from (0, 1] | 0.2
+/// address-balancer.enabled | balance the requests over all the addresses of a hostname with power-of-two-choices least-outstanding-requests, works only with dns_resolver 'async' | false
+/// address-balancer.ejection-period | time to skip an address after a network error | 10s
+/// direct-transport.destinations | list of 'host:port' of the destinations to send plain HTTP/1.1 requests on the coroutine sockets instead of libcurl; requests with a proxy, connect_to, unix socket, form, cookies, auth, redirects, HTTP/2 or a streamed body still go through libcurl | []
+/// direct-transport.max-idle-connections | max number of the kept alive connections to each destination of the direct transport | 16
 /// fs-task-processor | task processor to run blocking HTTP related calls, like DNS resolving or hosts reading | -
 /// destination-metrics-auto-max-size | set max number of automatically created destination metrics | 100
 /// user-agent | User-Agent HTTP header to show on all requests, result of utils::GetUserverIdentifier() if empty | empty
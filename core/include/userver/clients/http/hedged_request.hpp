@@ -0,0 +1,64 @@
+#pragma once
+
+/// @file userver/clients/http/hedged_request.hpp
+/// @brief @copybrief clients::http::PerformHedged
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+#include <userver/clients/http/request.hpp>
+#include <userver/clients/http/response.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+/// Settings of clients::http::PerformHedged
+struct HedgingSettings final {
+  /// Max number of concurrent attempts including the first one
+  std::size_t max_attempts{2};
+
+  /// Percentile of the recent destination timings to wait for the response
+  /// before sending the next attempt
+  double delay_percentile{95};
+
+  /// Lower bound of the delay, also used while the destination has no timings
+  std::chrono::milliseconds min_delay{10};
+
+  /// Retry budget, see
+  /// https://github.com/grpc/proposal/blob/master/A6-client-retries.md#throttling-configuration
+  /// Each hedged request adds `budget_token_ratio` tokens, each extra attempt
+  /// takes one token. Extra attempts are sent while more than a half of
+  /// `budget_max_tokens` is left.
+  float budget_max_tokens{100.0f};
+  float budget_token_ratio{0.1f};
+};
+
+/// @brief Performs the request with hedging (speculative retries) to cut the
+/// tail latency.
+///
+/// The first attempt is built by `factory` and started at once. If it has not
+/// finished after the HedgingSettings::delay_percentile of the destination
+/// recent timings, one more attempt is built and started, and so on up to
+/// HedgingSettings::max_attempts. The first response to arrive wins, the other
+/// attempts are cancelled. A failed attempt does not end the hedged request
+/// while other attempts are in flight.
+///
+/// Every call of `factory` must return an identical request to the same
+/// destination. Extra attempts are limited by a per-destination retry budget
+/// and reported in the `hedging` metrics of the destination. Set the
+/// destination via Request::SetDestinationMetricName() to get both for URLs
+/// not accounted automatically.
+///
+/// Use only for idempotent requests.
+///
+/// @throws clients::http::BaseException of the last failed attempt if all the
+/// attempts failed
+std::shared_ptr<Response> PerformHedged(const std::function<Request()>& factory,
+                                        const HedgingSettings& settings = {});
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <string>
+#include <vector>
 
 #include <userver/dynamic_config/fwd.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -23,12 +24,45 @@ struct DeadlinePropagationConfig {
   bool update_header{true};
 };
 
+struct PreconnectSettings {
+  std::vector<std::string> urls;
+  std::size_t connections{1};
+  std::chrono::milliseconds refresh_period{std::chrono::seconds{60}};
+};
+
+struct ConcurrencyLimiterSettings {
+  bool enabled{false};
+  std::size_t initial_limit{20};
+  std::size_t min_limit{1};
+  std::size_t max_limit{1000};
+  double rtt_tolerance{1.5};
+  double smoothing{0.2};
+};
+
+struct AddressBalancerSettings {
+  bool enabled{false};
+  std::chrono::milliseconds ejection_period{std::chrono::seconds{10}};
+};
+
+struct DirectTransportSettings {
+  /// `host:port` of the plain HTTP destinations
+  std::vector<std::string> destinations;
+  std::size_t max_idle_connections{16};
+};
+
 // Static config
 struct ClientSettings final {
   std::string thread_name_prefix{};
   size_t io_threads{8};
   bool defer_events{false};
+  bool multiplexing_enabled{false};
+  std::size_t max_host_connections{0};
+  std::size_t max_concurrent_streams{100};
   DeadlinePropagationConfig deadline_propagation{};
+  PreconnectSettings preconnect{};
+  ConcurrencyLimiterSettings concurrency_limiter{};
+  AddressBalancerSettings address_balancer{};
+  DirectTransportSettings direct_transport{};
   const tracing::TracingManagerBase* tracing_manager{nullptr};
   const server::http::HeadersPropagator* headers_propagator{nullptr};
 };
@@ -11,6 +11,7 @@
 #include <userver/clients/http/error.hpp>
 #include <userver/clients/http/plugin.hpp>
 #include <userver/clients/http/response.hpp>
+#include <userver/clients/http/response_body_sink.hpp>
 #include <userver/clients/http/response_future.hpp>
 #include <userver/concurrent/queue.hpp>
 #include <userver/crypto/certificate.hpp>
@@ -36,6 +37,9 @@ class ConnectTo;
 class Form;
 class RequestStats;
 class DestinationStatistics;
+class AddressBalancer;
+class DirectTransport;
+class RequestBatch;
 struct TestsuiteConfig;
 
 namespace impl {
@@ -294,6 +298,13 @@ class Request final {
       const impl::DeadlinePropagationConfig& deadline_propagation_config) &;
 
   void SetHeadersPropagator(const server::http::HeadersPropagator*) &;
+
+  // Set the balancer of the resolved addresses. For internal use only.
+  void SetAddressBalancer(AddressBalancer* balancer) &;
+
+  // Set the transport performing the plain HTTP requests to the configured
+  // destinations without libcurl. For internal use only.
+  void SetDirectTransport(DirectTransport* transport) &;
   /// @endcond
 
   /// Disable auto-decoding of received replies.
@@ -329,6 +340,17 @@ class Request final {
       utils::impl::SourceLocation location =
           utils::impl::SourceLocation::Current());
 
+  /// @brief Perform a request passing the response body to `sink` as it is
+  /// received instead of storing it in the Response.
+  ///
+  /// The body of the resulting Response is empty. The request is performed
+  /// without retries, as the sink may have consumed a part of the body of a
+  /// failed attempt.
+  [[nodiscard]] ResponseFuture async_perform_sink(
+      std::shared_ptr<ResponseBodySink> sink,
+      utils::impl::SourceLocation location =
+          utils::impl::SourceLocation::Current());
+
   /// Calls async_perform and wait for timeout_ms on a future. Default time
   /// for waiting will be timeout value if it was set. If error occurred it
   /// will be thrown as exception.
@@ -351,7 +373,15 @@ class Request final {
   /// Returns HTTP body of a request, leaving it empty
   std::string ExtractData();
 
+  /// @cond
+  // For internal use only. Returns nullptr if the destination is not
+  // accounted.
+  std::shared_ptr<RequestStats> GetDestinationRequestStats();
+  /// @endcond
+
  private:
+  friend class RequestBatch;
+
   std::shared_ptr<RequestState> pimpl_;
 };
 
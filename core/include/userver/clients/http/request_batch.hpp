@@ -0,0 +1,71 @@
+#pragma once
+
+/// @file userver/clients/http/request_batch.hpp
+/// @brief @copybrief clients::http::RequestBatch
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <userver/clients/http/request.hpp>
+#include <userver/clients/http/response.hpp>
+#include <userver/clients/http/response_future.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/utils/impl/source_location.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+/// @brief Starts many requests at once for the fan-out to several
+/// destinations.
+///
+/// The first attempts of the requests are handed over to each IO thread of
+/// the client in one go instead of a hop per request, and the requests share
+/// a parent `http_batch` span. Requests that resolve the address with the
+/// client DNS resolver are started on their own after the resolution.
+///
+/// Requests are kept alive by the batch, the responses are retrieved by the
+/// index of Add() call.
+class RequestBatch final {
+ public:
+  RequestBatch() = default;
+  RequestBatch(RequestBatch&&) noexcept = default;
+  RequestBatch& operator=(RequestBatch&&) noexcept = default;
+  ~RequestBatch();
+
+  /// Adds the request to the batch, returns its index
+  std::size_t Add(Request request);
+
+  /// Returns the number of the requests in the batch
+  std::size_t GetSize() const noexcept;
+
+  /// Starts all the added requests, may be called only once
+  void Perform(utils::impl::SourceLocation location =
+                   utils::impl::SourceLocation::Current());
+
+  /// @brief Waits for all the requests to finish
+  /// @returns false on deadline expiration or task cancellation
+  [[nodiscard]] bool WaitAll(engine::Deadline deadline = {});
+
+  /// @brief Waits for `count` requests (or all of them if there are fewer)
+  /// to finish, successfully or not.
+  /// @returns indexes of the finished requests in the order of finish,
+  /// fewer of them on deadline expiration or task cancellation
+  std::vector<std::size_t> WaitFirstN(std::size_t count,
+                                      engine::Deadline deadline = {});
+
+  /// @brief Returns the response of a finished request
+  /// @throws clients::http::BaseException if the request failed
+  std::shared_ptr<Response> Get(std::size_t index);
+
+ private:
+  std::vector<Request> requests_;
+  std::vector<ResponseFuture> futures_;
+  std::vector<bool> is_finished_;
+  std::size_t finished_count_{0};
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -5,6 +5,8 @@
 
 #include <string_view>
 
+#include <userver/utils/internal_tag_fwd.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace curl {
@@ -22,6 +24,12 @@ class RequestTracingEditor final {
   /// sets header
   void SetHeader(std::string_view, std::string_view);
 
+  /// @cond
+  // For internal use only, sets the header from its "name: value" form
+  void SetSerializedHeader(std::string_view name, std::string_view header,
+                           utils::InternalTag);
+  /// @endcond
+
  private:
   friend class RequestState;
 
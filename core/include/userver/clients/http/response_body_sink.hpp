@@ -0,0 +1,33 @@
+#pragma once
+
+/// @file userver/clients/http/response_body_sink.hpp
+/// @brief @copybrief clients::http::ResponseBodySink
+
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+/// @brief Consumer of the response body chunks for
+/// clients::http::Request::async_perform_sink().
+///
+/// The chunks are passed as they are received from the network, without
+/// copying them into a buffer, so a body of any size is processed in constant
+/// memory.
+///
+/// @warning Write() is called from an HTTP client IO thread. It must not block
+/// or suspend, and it should be fast: the other requests of the thread wait for
+/// it to return.
+class ResponseBodySink {
+ public:
+  virtual ~ResponseBodySink() = default;
+
+  /// Consumes the next chunk of the (decoded) response body. An exception
+  /// aborts the request and is rethrown from ResponseFuture::Get().
+  virtual void Write(std::string_view chunk) = 0;
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
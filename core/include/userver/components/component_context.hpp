@@ -3,6 +3,7 @@
 /// @file userver/components/component_context.hpp
 /// @brief @copybrief components::ComponentContext
 
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <stdexcept>
@@ -28,6 +29,7 @@ namespace impl {
 
 enum class ComponentLifetimeStage;
 class ComponentInfo;
+class StartupProfile;
 
 template <class T>
 constexpr auto NameFromComponentType() -> decltype(std::string_view{T::kName}) {
@@ -163,7 +165,8 @@ class ComponentContext final {
   ComponentContext() noexcept;
 
   void Emplace(const Manager& manager,
-               std::vector<std::string>&& loading_component_names);
+               std::vector<std::string>&& loading_component_names,
+               const std::vector<std::string>& lazy_component_names);
 
   void Reset() noexcept;
 
@@ -184,6 +187,9 @@ class ComponentContext final {
 
   void CancelComponentsLoad();
 
+  impl::StartupProfile MakeStartupProfile(
+      std::chrono::steady_clock::time_point start) const;
+
   [[noreturn]] void ThrowNonRegisteredComponent(std::string_view name,
                                                 std::string_view type) const;
   [[noreturn]] void ThrowComponentTypeMismatch(
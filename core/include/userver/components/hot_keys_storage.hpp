@@ -0,0 +1,90 @@
+#pragma once
+
+/// @file userver/components/hot_keys_storage.hpp
+/// @brief @copybrief components::HotKeysStorage
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/entry.hpp>
+#include <userver/utils/statistics/hot_keys.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Component that keeps a utils::statistics::HotKeys detector for
+/// each source of the key accesses, e.g. for each cache or redis database.
+///
+/// The detectors are created on the first request of a source and live for
+/// a lifetime of the component. The counts are halved every
+/// `decay-interval`, so the top keys reflect the recent accesses. The top
+/// keys are served by server::handlers::HotKeys, the accesses and the share
+/// of the hottest key are reported in the `hot-keys` metrics.
+///
+/// ## Static options:
+/// Name           | Description                                               | Default value
+/// -------------- | --------------------------------------------------------- | -------------
+/// capacity       | max keys tracked per source on each of the thread shards  | 64
+/// sample-rate    | one of this many accesses is accounted                    | 16
+/// decay-interval | period of halving the counts                              | 10s
+///
+/// ## Static configuration example:
+///
+/// @code
+///   hot-keys-storage:
+///     capacity: 128
+///     sample-rate: 8
+/// @endcode
+
+// clang-format on
+class HotKeysStorage final : public LoggableComponentBase {
+ public:
+  /// @ingroup userver_component_names
+  /// @brief The default name of components::HotKeysStorage
+  static constexpr std::string_view kName = "hot-keys-storage";
+
+  using Sources =
+      std::map<std::string, std::shared_ptr<utils::statistics::HotKeys>,
+               std::less<>>;
+
+  HotKeysStorage(const ComponentConfig& config,
+                 const ComponentContext& context);
+  ~HotKeysStorage() override;
+
+  /// @returns the detector of the source, creating it if needed
+  std::shared_ptr<utils::statistics::HotKeys> GetHotKeys(
+      std::string_view source);
+
+  /// @returns the detectors of all the sources
+  Sources GetSources() const;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  const utils::statistics::HotKeysSettings settings_;
+  concurrent::Variable<Sources> sources_;
+  utils::PeriodicTask decay_task_;
+  utils::statistics::Entry statistics_holder_;
+};
+
+template <>
+inline constexpr bool kHasValidate<HotKeysStorage> = true;
+
+template <>
+inline constexpr auto kConfigFileMode<HotKeysStorage> =
+    ConfigFileMode::kNotRequired;
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
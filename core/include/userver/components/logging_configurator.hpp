@@ -28,7 +28,9 @@ namespace components {
 ///
 /// ## Dynamic config
 /// * @ref USERVER_LOG_DYNAMIC_DEBUG
+/// * @ref USERVER_LOG_SAMPLING
 /// * @ref USERVER_NO_LOG_SPANS
+/// * @ref USERVER_TRACING_TAIL_SAMPLING
 ///
 /// ## Static options:
 /// Name | Description | Default value
@@ -33,22 +33,38 @@ class Manager;
 /// coro_pool.initial_size | amount of coroutines to preallocate on startup | 1000
 /// coro_pool.max_size | max amount of coroutines to keep preallocated | 4000
 /// coro_pool.stack_size | size of a single coroutine | 256 * 1024
+/// coro_pool.local_cache_size | max amount of idle coroutines to keep in a per-thread cache of each task processor worker, the caches are not limited by coro_pool.max_size | 16
+/// coro_pool.trim_watermark | amount of idle coroutines with used stacks to keep, the rest is destroyed by periodic trimming to return the memory to the OS | 1000
+/// coro_pool.trim_interval | interval of idle coroutines trimming, 0 disables trimming | 0
+/// coro_pool.stack_huge_pages | 'none', 'transparent' or 'explicit', the latter two allocate the stacks from slabs of the transparent or the reserved (vm.nr_hugepages) huge pages to reduce the TLB misses; such stacks have no guard pages, a stack overflow corrupts the neighbouring stack | none
+/// coro_pool.stack_usage_sample_period | each N-th allocated stack is painted and its used size is measured when it is freed (by trimming or on coro_pool.max_size overflow) and accounted in the `engine.coro-pool.stack-usage-kb` histogram; 0 disables the sampling | 0
 /// event_thread_pool.threads | number of threads to process low level IO system calls (number of ev loops to start in libev) | 2
 /// event_thread_pool.thread_name | set OS thread name to this value | 'event-worker'
+/// event_thread_pool.numa-node | NUMA node to pin the ev threads to | -
+/// event_thread_pool.cpu-set | list of CPUs to pin the ev threads to, for example '0-3,8' | -
+/// event_thread_pool.io_uring_entries | size of the io_uring submission queue for fs:: file operations (sockets do not use it), falls back to fs-task-processor if io_uring is not available; 0 disables io_uring | 0
 /// components | dictionary of "component name": "options" | -
 /// default_task_processor | name of the default task processor to use in components | -
 /// task_processors.*NAME*.*OPTIONS* | dictionary of task processors to create and their options. See description below | -
 /// mlock_debug_info | whether to mlock(2) process debug info to prevent major page faults on unwinding | true
 /// disable_phdr_cache | whether to disable caching of phdr_info objects. Usable if rebuilding with cmake variable USERVER_DISABLE_PHDR_CACHE is off limits, and has the same effect | false
+/// coarse_clock_update_interval | interval of caching the time of utils::datetime::SteadyCoarseClock and utils::datetime::WallCoarseClock in a dedicated thread, that makes their now() a single load; 0 disables the caching | 1ms
+/// startup_trace_file | path to write the Chrome Trace Event Format JSON with the construction times of the components to, for chrome://tracing or ui.perfetto.dev. The critical path of the components load and the constructors that block the task processor threads are also logged at startup and reported in `engine.startup` metrics | -
 ///
 /// ## Static task_processor options:
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// guess-cpu-limit | guess optimal threads count | false
+/// autoscale-to-cpu-quota | keep about as many worker threads active as the cgroup v2 CPU quota allows and park the rest, fewer threads are used while the cgroup is throttled; worker_threads is the max count of the active threads. Active threads are reported in `engine.task-processors.active-worker-threads`. Only for 'global-task-queue' | false
 /// thread_name | set OS thread name to this value | Part of the task_processor name before the first '-' symbol with '-worker' appended; for example 'fs-worker' or 'main-worker'
 /// worker_threads | threads count for the task processor | -
 /// os-scheduling | OS scheduling mode for the task processor threads. 'idle' sets the lowest priority. 'low-priority' sets the priority below 'normal' but higher than 'idle'. | normal
 /// spinning-iterations | tunes the number of spin-wait iterations in case of an empty task queue before threads go to sleep | 10000
+/// task-processor-queue | task queue implementation. 'global-task-queue' is a single queue shared by all the workers, it starts the tasks with higher engine::Task::Priority first. 'work-stealing-task-queue' gives each worker a local queue and lets idle workers steal tasks from each other, which reduces contention with many worker threads; task priorities are ignored. | global-task-queue
+/// numa-node | NUMA node to pin the worker threads to; coroutine stacks are reused only by the threads of the same node | -
+/// cpu-set | list of CPUs to pin the worker threads to, for example '0-3,8'; should be a subset of numa-node CPUs if both options are set | -
+/// jemalloc-arenas | number of own jemalloc arenas for the worker threads, the workers are bound to them round-robin, so that the allocations of the task processor (for example, background cache updates) do not contend with and fragment the memory of the other task processors. The memory of the arenas is reported in `engine.task-processors.jemalloc`. 0 keeps the default shared arenas | 0
+/// cpu-sampling-every | attribute CPU time of each Nth started task to the name of its root tracing::Span, reported in `engine.task-processors.scheduler.sampled-cpu-us`; 0 disables sampling | 0
 /// task-trace | optional dictionary of tracing options | empty (disabled)
 /// task-trace.every | set N to trace each Nth task | 1000
 /// task-trace.max-context-switch-count | set upper limit of context switches to trace for a single task | 1000
@@ -6,6 +6,7 @@
 #include <userver/components/loggable_component_base.hpp>
 
 #include <userver/engine/subprocess/process_starter.hpp>
+#include <userver/utils/statistics/entry.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -19,6 +20,10 @@ namespace components {
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// task_processor | the name of the TaskProcessor for process starting | -
+/// use-zygote | start the processes from a helper process that is forked on the component construction, see engine::subprocess::ProcessStarterSettings::use_zygote | false
+///
+/// The `engine.process-starter` metrics contain the count of the started
+/// processes, of the failures and the starting timings.
 class ProcessStarter : public LoggableComponentBase {
  public:
   ProcessStarter(const ComponentConfig& config,
@@ -34,6 +39,7 @@ class ProcessStarter : public LoggableComponentBase {
 
  private:
   engine::subprocess::ProcessStarter process_starter_;
+  utils::statistics::Entry statistics_holder_;
 };
 
 template <>
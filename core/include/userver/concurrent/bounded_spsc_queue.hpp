@@ -0,0 +1,351 @@
+#pragma once
+
+/// @file userver/concurrent/bounded_spsc_queue.hpp
+/// @brief @copybrief concurrent::BoundedSpscQueue
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+#include <userver/concurrent/queue_helpers.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+/// @ingroup userver_concurrency
+///
+/// @brief Single producer single consumer queue on top of a fixed-size ring
+/// buffer.
+///
+/// Unlike concurrent::SpscQueue, the elements are stored in a preallocated
+/// ring buffer, so a Push or a Pop is a couple of loads and stores into the
+/// memory owned by the producer or by the consumer, without allocations and
+/// read-modify-write atomics. Each Push and Pop still issues a full memory
+/// fence, so that the other side is never left waiting for an element or
+/// for room that is already there. PushMany and PopMany pay for it once per
+/// batch. The waiting side, if any, is woken up via
+/// engine::SingleConsumerEvent.
+///
+/// The queue never holds more than the max size passed to Create. The size
+/// may be lowered (and restored) later with SetSoftMaxSize.
+///
+/// Prefer it for one-producer one-consumer stages with a known bound on the
+/// in-flight elements.
+///
+/// @see @ref scripts/docs/en/userver/synchronization.md
+template <typename T>
+class BoundedSpscQueue final
+    : public std::enable_shared_from_this<BoundedSpscQueue<T>> {
+  struct EmplaceEnabler final {
+    // Disable {}-initialization in Queue's constructor
+    explicit EmplaceEnabler() = default;
+  };
+
+  using Token = impl::NoToken;
+
+  friend class Producer<BoundedSpscQueue, Token, EmplaceEnabler>;
+  friend class Consumer<BoundedSpscQueue, Token, EmplaceEnabler>;
+
+ public:
+  using ValueType = T;
+
+  using Producer =
+      concurrent::Producer<BoundedSpscQueue, Token, EmplaceEnabler>;
+  using Consumer =
+      concurrent::Consumer<BoundedSpscQueue, Token, EmplaceEnabler>;
+
+  static constexpr std::size_t kDefaultMaxSize = 1024;
+
+  /// @cond
+  // For internal use only
+  BoundedSpscQueue(std::size_t max_size, EmplaceEnabler /*unused*/)
+      : queue_(std::make_unique<Slot[]>(RoundUpToPowerOfTwo(max_size))),
+        index_mask_(RoundUpToPowerOfTwo(max_size) - 1),
+        max_size_(max_size),
+        soft_max_size_(max_size) {
+    UINVARIANT(max_size > 0, "BoundedSpscQueue max size is set to zero");
+  }
+
+  ~BoundedSpscQueue() {
+    UASSERT(consumer_state_ != State::kAlive);
+    UASSERT(producer_state_ != State::kAlive);
+
+    // Clear remaining items in queue
+    const auto tail = tail_.load();
+    for (auto head = head_.load(); head != tail; ++head) {
+      GetItem(head).~T();
+    }
+  }
+
+  BoundedSpscQueue(BoundedSpscQueue&&) = delete;
+  BoundedSpscQueue(const BoundedSpscQueue&) = delete;
+  BoundedSpscQueue& operator=(BoundedSpscQueue&&) = delete;
+  BoundedSpscQueue& operator=(const BoundedSpscQueue&) = delete;
+  /// @endcond
+
+  /// Create a new queue that holds at most `max_size` elements
+  static std::shared_ptr<BoundedSpscQueue> Create(
+      std::size_t max_size = kDefaultMaxSize) {
+    return std::make_shared<BoundedSpscQueue>(max_size, EmplaceEnabler{});
+  }
+
+  /// Get a `Producer` which makes it possible to push items into the queue.
+  /// There may be at most one alive `Producer` at a time.
+  ///
+  /// @note `Producer` may outlive the queue and the consumer.
+  Producer GetProducer() {
+    [[maybe_unused]] const auto old_state =
+        producer_state_.exchange(State::kAlive);
+    UASSERT(old_state != State::kAlive);
+    return Producer(this->shared_from_this(), EmplaceEnabler{});
+  }
+
+  /// Get a `Consumer` which makes it possible to read items from the queue.
+  /// There may be at most one alive `Consumer` at a time.
+  ///
+  /// @note `Consumer` may outlive the queue and the producer.
+  Consumer GetConsumer() {
+    [[maybe_unused]] const auto old_state =
+        consumer_state_.exchange(State::kAlive);
+    UASSERT(old_state != State::kAlive);
+    return Consumer(this->shared_from_this(), EmplaceEnabler{});
+  }
+
+  /// @brief Sets the limit on the queue size, pushes over this limit will
+  /// block. The limit is capped by the max size passed to Create.
+  void SetSoftMaxSize(std::size_t max_size) {
+    const auto new_size = std::min(max_size, max_size_);
+    const auto old_size = soft_max_size_.exchange(new_size);
+    if (new_size > old_size) non_full_event_.Send();
+  }
+
+  /// @brief Gets the limit on the queue size
+  std::size_t GetSoftMaxSize() const noexcept { return soft_max_size_.load(); }
+
+  /// @brief Gets the approximate size of queue
+  std::size_t GetSizeApproximate() const noexcept {
+    // 'head_' is loaded first, so that the size never underflows
+    const auto head = head_.load();
+    return tail_.load() - head;
+  }
+
+  /// @returns true if the consumer is gone and the pushes fail, for the
+  /// producer side
+  bool NoMoreConsumers() const { return consumer_state_ == State::kDead; }
+
+  /// @returns true if the producer is gone and no new elements will appear,
+  /// for the consumer side
+  bool NoMoreProducers() const { return producer_state_ == State::kDead; }
+
+ private:
+  enum class State { kNotCreated, kAlive, kDead };
+
+  struct Slot final {
+    alignas(T) std::byte storage[sizeof(T)];
+  };
+
+  // Typical cache line size, keeps the producer and the consumer data apart
+  static constexpr std::size_t kCacheLineSize = 64;
+
+  static std::size_t RoundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) result *= 2;
+    return result;
+  }
+
+  T& GetItem(std::size_t index) noexcept {
+    return *std::launder(
+        reinterpret_cast<T*>(queue_[index & index_mask_].storage));
+  }
+
+  [[nodiscard]] bool Push(Token& /*unused*/, T&& value,
+                          engine::Deadline deadline) {
+    if (!WaitForRoom(1, deadline)) return false;
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    new (queue_[tail & index_mask_].storage) T(std::move(value));
+    PublishTail(tail + 1);
+    return true;
+  }
+
+  [[nodiscard]] bool PushNoblock(Token& /*unused*/, T&& value) {
+    if (NoMoreConsumers() || !HasRoom(1)) return false;
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    new (queue_[tail & index_mask_].storage) T(std::move(value));
+    PublishTail(tail + 1);
+    return true;
+  }
+
+  [[nodiscard]] bool PushMany(Token& /*unused*/, std::vector<T>&& values,
+                              engine::Deadline deadline) {
+    if (values.empty()) return true;
+    if (!WaitForRoom(values.size(), deadline)) return false;
+    auto tail = tail_.load(std::memory_order_relaxed);
+    for (auto& value : values) {
+      new (queue_[tail++ & index_mask_].storage) T(std::move(value));
+    }
+    values.clear();
+    PublishTail(tail);
+    return true;
+  }
+
+  [[nodiscard]] bool Pop(Token& /*unused*/, T& value,
+                         engine::Deadline deadline) {
+    if (!WaitForElements(deadline)) return false;
+    const auto head = head_.load(std::memory_order_relaxed);
+    auto& item = GetItem(head);
+    value = std::move(item);
+    item.~T();
+    PublishHead(head + 1);
+    return true;
+  }
+
+  [[nodiscard]] bool PopNoblock(Token& /*unused*/, T& value) {
+    if (!HasElements()) return false;
+    const auto head = head_.load(std::memory_order_relaxed);
+    auto& item = GetItem(head);
+    value = std::move(item);
+    item.~T();
+    PublishHead(head + 1);
+    return true;
+  }
+
+  [[nodiscard]] std::size_t PopMany(Token& /*unused*/, std::vector<T>& values,
+                                    std::size_t max_count,
+                                    engine::Deadline deadline) {
+    UASSERT(max_count > 0);
+    if (!WaitForElements(deadline)) return 0;
+    const auto head = head_.load(std::memory_order_relaxed);
+    const auto count = std::min(max_count, cached_tail_ - head);
+    for (auto index = head; index != head + count; ++index) {
+      auto& item = GetItem(index);
+      values.push_back(std::move(item));
+      item.~T();
+    }
+    PublishHead(head + count);
+    return count;
+  }
+
+  void MarkConsumerIsDead() {
+    consumer_state_ = State::kDead;
+    non_full_event_.Send();
+  }
+
+  void MarkProducerIsDead() {
+    producer_state_ = State::kDead;
+    nonempty_event_.Send();
+  }
+
+  // Producer side. 'cached_head_' spares loads of the consumer-owned 'head_'
+  bool HasRoom(std::size_t count) {
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto max_size = soft_max_size_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ + count <= max_size) return true;
+    cached_head_ = head_.load(std::memory_order_acquire);
+    return tail - cached_head_ + count <= max_size;
+  }
+
+  bool WaitForRoom(std::size_t count, engine::Deadline deadline) {
+    while (!NoMoreConsumers() && count <= max_size_) {
+      if (HasRoom(count)) return true;
+
+      // The consumer checks the flag after publishing 'head_', the fences
+      // guarantee that either it sees the flag or we see the new 'head_'
+      producer_waiting_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (HasRoom(count) || NoMoreConsumers()) {
+        producer_waiting_.store(false, std::memory_order_relaxed);
+        continue;
+      }
+
+      const bool woken_up = non_full_event_.WaitForEventUntil(deadline);
+      producer_waiting_.store(false, std::memory_order_relaxed);
+      if (!woken_up) return !NoMoreConsumers() && HasRoom(count);
+    }
+    return false;
+  }
+
+  // The fence orders the store of 'tail_' before the load of the flag. It
+  // cannot be skipped when the flag is unset: without it the load may be
+  // satisfied before the store becomes visible, and a consumer that has just
+  // set the flag and seen the old 'tail_' would sleep until the deadline.
+  void PublishTail(std::size_t tail) {
+    tail_.store(tail, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (consumer_waiting_.load(std::memory_order_relaxed)) {
+      nonempty_event_.Send();
+    }
+  }
+
+  // Consumer side. 'cached_tail_' spares loads of the producer-owned 'tail_'
+  bool HasElements() {
+    const auto head = head_.load(std::memory_order_relaxed);
+    if (cached_tail_ != head) return true;
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    return cached_tail_ != head;
+  }
+
+  bool WaitForElements(engine::Deadline deadline) {
+    while (true) {
+      if (HasElements()) return true;
+      // Producer might have pushed something in queue between HasElements()
+      // and NoMoreProducers() check. Check twice to avoid TOCTOU.
+      if (NoMoreProducers()) return HasElements();
+
+      // The producer checks the flag after publishing 'tail_', the fences
+      // guarantee that either it sees the flag or we see the new 'tail_'
+      consumer_waiting_.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (HasElements() || NoMoreProducers()) {
+        consumer_waiting_.store(false, std::memory_order_relaxed);
+        continue;
+      }
+
+      const bool woken_up = nonempty_event_.WaitForEventUntil(deadline);
+      consumer_waiting_.store(false, std::memory_order_relaxed);
+      if (!woken_up) return HasElements();
+    }
+  }
+
+  // Same as PublishTail, for the producer waiting for room
+  void PublishHead(std::size_t head) {
+    head_.store(head, std::memory_order_release);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (producer_waiting_.load(std::memory_order_relaxed)) {
+      non_full_event_.Send();
+    }
+  }
+
+  // Named so for concurrent::Producer and concurrent::Consumer tokens
+  const std::unique_ptr<Slot[]> queue_;
+  const std::size_t index_mask_;
+  const std::size_t max_size_;
+  std::atomic<std::size_t> soft_max_size_;
+
+  // Written by the producer only
+  alignas(kCacheLineSize) std::atomic<std::size_t> tail_{0};
+  std::size_t cached_head_{0};
+
+  // Written by the consumer only
+  alignas(kCacheLineSize) std::atomic<std::size_t> head_{0};
+  std::size_t cached_tail_{0};
+
+  // Written only by the waiting side, rarely
+  alignas(kCacheLineSize) std::atomic<bool> producer_waiting_{false};
+  std::atomic<bool> consumer_waiting_{false};
+  std::atomic<State> producer_state_{State::kNotCreated};
+  std::atomic<State> consumer_state_{State::kNotCreated};
+
+  alignas(kCacheLineSize) engine::SingleConsumerEvent non_full_event_;
+  engine::SingleConsumerEvent nonempty_event_;
+};
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,341 @@
+#pragma once
+
+/// @file userver/concurrent/hash_map.hpp
+/// @brief @copybrief concurrent::HashMap
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief Hash map with lock-free reads and fine-grained locking of writers,
+/// for the state that is both read and written often.
+///
+/// Readers traverse the immutable nodes of a bucket without any locks,
+/// writers lock one of the stripes of the buckets, so the writers of
+/// different keys rarely contend. The replaced and the erased nodes are
+/// destroyed once the readers that could have seen them are gone, with the
+/// epoch-based reclamation of rcu::EpochRcuTraits. The number of buckets is
+/// doubled when the number of elements exceeds it, which locks all the
+/// stripes for the time of rehashing.
+///
+/// Unlike rcu::RcuMap, a write does not copy the whole map, and unlike
+/// concurrent::Variable<std::unordered_map>, the readers are not blocked by
+/// the writers.
+///
+/// The elements are returned by copy, so `Value` should be cheap to copy,
+/// e.g. a small struct or a `std::shared_ptr`.
+///
+/// ## Example usage:
+///
+/// @snippet concurrent/hash_map_test.cpp  Sample concurrent::HashMap usage
+///
+/// @see @ref scripts/docs/en/userver/synchronization.md
+template <typename Key, typename Value,
+          typename Hash = utils::hash::Hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class HashMap final {
+ public:
+  HashMap() : table_(new Table(kStripes)) {}
+
+  explicit HashMap(Hash hash, Equal equal = Equal())
+      : hash_(std::move(hash)),
+        equal_(std::move(equal)),
+        table_(new Table(kStripes)) {}
+
+  HashMap(const HashMap&) = delete;
+  HashMap(HashMap&&) = delete;
+  HashMap& operator=(const HashMap&) = delete;
+  HashMap& operator=(HashMap&&) = delete;
+
+  ~HashMap() {
+    UASSERT_MSG(!domain_.HasReaders(), "HashMap is destroyed while being used");
+    delete table_.load();
+  }
+
+  /// Returns a copy of the value for the `key`, if any
+  std::optional<Value> Get(const Key& key) const {
+    const ReadLock lock{domain_};
+    const auto* node = Find(*table_.load(), hash_(key), key);
+    if (!node) return std::nullopt;
+    return node->value;
+  }
+
+  /// Checks whether there is a value for the `key`
+  bool Contains(const Key& key) const {
+    const ReadLock lock{domain_};
+    return Find(*table_.load(), hash_(key), key) != nullptr;
+  }
+
+  /// @brief Inserts the value if there is no value for the `key`
+  /// @returns whether the value was inserted
+  bool Insert(const Key& key, Value value) {
+    const auto hash = hash_(key);
+    {
+      const std::lock_guard lock{GetStripe(hash)};
+      auto& table = *table_.load();
+      if (Find(table, hash, key)) return false;
+      PushFront(table, new Node{hash, key, std::move(value)});
+    }
+    OnInserted();
+    return true;
+  }
+
+  /// Inserts the value or replaces the existing value for the `key`
+  void InsertOrAssign(const Key& key, Value value) {
+    Update(key, [&value](std::optional<Value>& current) {
+      current = std::move(value);
+    });
+  }
+
+  /// @brief Atomically updates the value for the `key`.
+  ///
+  /// `func` is called with a copy of the current value, or with an empty
+  /// optional if there is none, under the lock of the key stripe. If `func`
+  /// leaves the optional empty, the key is erased.
+  template <typename Func>
+  void Update(const Key& key, Func&& func) {
+    const auto hash = hash_(key);
+    bool inserted = false;
+    {
+      const std::lock_guard lock{GetStripe(hash)};
+      auto& table = *table_.load();
+      auto* link = FindLink(table, hash, key);
+      auto* old_node = link->load(std::memory_order_relaxed);
+
+      std::optional<Value> value;
+      if (old_node) value.emplace(old_node->value);
+      std::forward<Func>(func)(value);
+
+      if (!old_node) {
+        if (!value) return;
+        PushFront(table, new Node{hash, key, std::move(*value)});
+        inserted = true;
+      } else if (value) {
+        auto* new_node = new Node{hash, key, std::move(*value)};
+        new_node->next.store(old_node->next.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+        link->store(new_node, std::memory_order_release);
+        Retire(old_node);
+      } else {
+        Unlink(link, old_node);
+      }
+    }
+    if (inserted) OnInserted();
+  }
+
+  /// @brief Erases the value for the `key`
+  /// @returns whether there was a value
+  bool Erase(const Key& key) {
+    const auto hash = hash_(key);
+    const std::lock_guard lock{GetStripe(hash)};
+    auto& table = *table_.load();
+    auto* link = FindLink(table, hash, key);
+    auto* node = link->load(std::memory_order_relaxed);
+    if (!node) return false;
+    Unlink(link, node);
+    return true;
+  }
+
+  /// @brief Calls `func(key, value)` for all the elements.
+  ///
+  /// The elements inserted, updated or erased concurrently may or may not be
+  /// visited. Delays the destruction of the erased elements of the whole map
+  /// until the end of the iteration.
+  template <typename Func>
+  void VisitAll(Func&& func) const {
+    const ReadLock lock{domain_};
+    const auto& table = *table_.load();
+    for (const auto& bucket : table.buckets) {
+      for (const auto* node = bucket.load(); node; node = node->next.load()) {
+        func(std::as_const(node->key), std::as_const(node->value));
+      }
+    }
+  }
+
+  /// Returns the approximate number of elements
+  std::size_t GetSizeApproximate() const noexcept { return size_.load(); }
+
+  /// Destroys the erased elements that can no longer be read
+  void Cleanup() {
+    const std::lock_guard lock{retire_mutex_};
+    ReclaimEpochs();
+  }
+
+ private:
+  // The maximum number of concurrent writers of different keys, the number of
+  // buckets is always a multiple of it
+  static constexpr std::size_t kStripes = 64;
+
+  struct Node final {
+    Node(std::size_t hash, const Key& key, Value&& value)
+        : hash(hash), key(key), value(std::move(value)) {}
+
+    const std::size_t hash;
+    const Key key;
+    const Value value;
+    std::atomic<Node*> next{nullptr};
+  };
+
+  struct Table final {
+    explicit Table(std::size_t bucket_count)
+        : buckets(bucket_count, nullptr), mask(bucket_count - 1) {}
+
+    ~Table() {
+      for (auto& bucket : buckets) {
+        auto* node = bucket.load();
+        while (node) delete std::exchange(node, node->next.load());
+      }
+    }
+
+    utils::FixedArray<std::atomic<Node*>> buckets;
+    const std::size_t mask;
+  };
+
+  struct Retired final {
+    std::vector<std::unique_ptr<Node>> nodes;
+    std::vector<std::unique_ptr<Table>> tables;
+  };
+
+  class ReadLock final {
+   public:
+    explicit ReadLock(rcu::impl::EpochDomain& domain)
+        : domain_(domain), lock_(domain.LockRead()) {}
+    ~ReadLock() { domain_.UnlockRead(lock_); }
+
+    ReadLock(const ReadLock&) = delete;
+    ReadLock& operator=(const ReadLock&) = delete;
+
+   private:
+    rcu::impl::EpochDomain& domain_;
+    const rcu::impl::EpochDomain::ReadLock lock_;
+  };
+
+  engine::Mutex& GetStripe(std::size_t hash) {
+    // The same stripe for all the keys of a bucket with any number of buckets
+    return stripes_[hash % kStripes];
+  }
+
+  const Node* Find(const Table& table, std::size_t hash,
+                   const Key& key) const {
+    const auto* node = table.buckets[hash & table.mask].load();
+    for (; node; node = node->next.load()) {
+      if (node->hash == hash && equal_(node->key, key)) return node;
+    }
+    return nullptr;
+  }
+
+  // Returns the link that points to the node of the key or the null link at
+  // the end of the bucket. Must be called under the key stripe lock.
+  std::atomic<Node*>* FindLink(Table& table, std::size_t hash,
+                               const Key& key) {
+    auto* link = &table.buckets[hash & table.mask];
+    for (auto* node = link->load(); node; node = link->load()) {
+      if (node->hash == hash && equal_(node->key, key)) break;
+      link = &node->next;
+    }
+    return link;
+  }
+
+  static void PushFront(Table& table, Node* node) {
+    auto& bucket = table.buckets[node->hash & table.mask];
+    node->next.store(bucket.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+    bucket.store(node, std::memory_order_release);
+  }
+
+  void Unlink(std::atomic<Node*>* link, Node* node) {
+    link->store(node->next.load(std::memory_order_relaxed),
+                std::memory_order_release);
+    --size_;
+    Retire(node);
+  }
+
+  void OnInserted() {
+    const auto size = ++size_;
+    const auto bucket_count = table_.load()->buckets.size();
+    if (size > bucket_count) Rehash(bucket_count * 2);
+  }
+
+  void Rehash(std::size_t bucket_count) {
+    std::vector<std::unique_lock<engine::Mutex>> locks;
+    locks.reserve(kStripes);
+    for (auto& stripe : stripes_) locks.emplace_back(stripe);
+
+    auto* old_table = table_.load();
+    // Someone has already rehashed the map
+    if (old_table->buckets.size() >= bucket_count) return;
+
+    // The nodes are copied, the old ones may still be read
+    auto new_table = std::make_unique<Table>(bucket_count);
+    for (const auto& bucket : old_table->buckets) {
+      for (auto* node = bucket.load(); node; node = node->next.load()) {
+        auto value = node->value;
+        PushFront(*new_table,
+                  new Node{node->hash, node->key, std::move(value)});
+      }
+    }
+    table_.store(new_table.release());
+
+    const std::lock_guard lock{retire_mutex_};
+    retired_.tables.emplace_back(old_table);
+    ReclaimEpochs();
+  }
+
+  void Retire(Node* node) {
+    const std::lock_guard lock{retire_mutex_};
+    retired_.nodes.emplace_back(node);
+    ReclaimEpochs();
+  }
+
+  // Same as rcu::Variable::ReclaimEpochs, must be called under 'retire_mutex_'
+  void ReclaimEpochs() {
+    if (!waiting_.nodes.empty() || !waiting_.tables.empty()) {
+      if (!domain_.IsPreviousEpochDrained()) return;
+      waiting_ = {};
+    }
+    if (retired_.nodes.empty() && retired_.tables.empty()) return;
+
+    // The readers, that could have obtained the retired nodes, are counted
+    // in the current epoch, that becomes the previous one
+    domain_.StartNewEpoch();
+    waiting_ = std::exchange(retired_, {});
+
+    if (domain_.IsPreviousEpochDrained()) waiting_ = {};
+  }
+
+  const Hash hash_{};
+  const Equal equal_{};
+
+  std::atomic<Table*> table_;
+  std::atomic<std::size_t> size_{0};
+  std::array<engine::Mutex, kStripes> stripes_;
+
+  mutable rcu::impl::EpochDomain domain_;
+  engine::Mutex retire_mutex_;
+  // retired in the current epoch
+  Retired retired_;
+  // retired before the current epoch, wait for the previous epoch to drain
+  Retired waiting_;
+};
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent::impl {
+
+/// Sequential number of the current thread, assigned on the first call
+std::size_t GetCurrentThreadIndex() noexcept;
+
+}  // namespace concurrent::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,179 @@
+#pragma once
+
+/// @file userver/concurrent/object_pool.hpp
+/// @brief @copybrief concurrent::ObjectPool
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/concurrent/impl/intrusive_hooks.hpp>
+#include <userver/concurrent/impl/intrusive_stack.hpp>
+#include <userver/concurrent/impl/thread_index.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief Lock-free pool of reusable objects, e.g. buffers or request
+/// contexts, that are expensive to create.
+///
+/// Acquire() returns a free object or creates a new one, the object returns
+/// to the pool on destruction of the returned pointer. A reused object keeps
+/// its state from the previous use, reset it if needed, e.g. `clear()` the
+/// buffer to keep its capacity.
+///
+/// The free objects are kept in several lock-free stacks, the tasks of a
+/// thread put and take the objects from the stack of the thread and only
+/// look into the other stacks if their own one is empty. At most `max_idle`
+/// free objects are kept, the excess ones are destroyed on return.
+/// Trim() destroys the free objects beyond a limit, e.g. call it from
+/// a utils::PeriodicTask to drop the objects left after a load spike.
+///
+/// The pool must outlive all the acquired objects.
+///
+/// ## Example usage:
+///
+/// @snippet concurrent/object_pool_test.cpp  Sample concurrent::ObjectPool usage
+///
+/// @see @ref scripts/docs/en/userver/synchronization.md
+template <typename T>
+class ObjectPool final {
+  struct Node;
+
+ public:
+  static constexpr std::size_t kUnlimited =
+      std::numeric_limits<std::size_t>::max();
+
+  /// Returns the object to the pool
+  class Releaser final {
+   public:
+    Releaser() noexcept = default;
+
+    void operator()(T* /*object*/) const noexcept { pool_->Release(*node_); }
+
+   private:
+    friend class ObjectPool;
+
+    Releaser(ObjectPool& pool, Node& node) noexcept
+        : pool_(&pool), node_(&node) {}
+
+    ObjectPool* pool_{nullptr};
+    Node* node_{nullptr};
+  };
+
+  using Ptr = std::unique_ptr<T, Releaser>;
+
+  explicit ObjectPool(std::size_t max_idle = kUnlimited)
+      : max_idle_(max_idle) {}
+
+  ObjectPool(ObjectPool&&) = delete;
+  ObjectPool& operator=(ObjectPool&&) = delete;
+
+  ~ObjectPool() {
+    std::size_t disposed = 0;
+    const auto dispose = [&disposed](Node& node) {
+      delete &node;
+      ++disposed;
+    };
+    for (auto& stack : free_) stack->DisposeUnsafe(dispose);
+    empty_.DisposeUnsafe(dispose);
+    UASSERT_MSG(disposed == nodes_.load(),
+                "Some acquired objects are still being held at ObjectPool "
+                "destruction");
+  }
+
+  /// Takes a free object, if any, or default-constructs one
+  Ptr Acquire() {
+    return Acquire([] { return T(); });
+  }
+
+  /// Takes a free object, if any, or creates one using `factory`
+  template <typename Factory>
+  Ptr Acquire(const Factory& factory) {
+    Node* node = TryPopFree(impl::GetCurrentThreadIndex() % kStacks);
+    if (!node) {
+      node = empty_.TryPop();
+      if (!node) {
+        node = new Node();
+        ++nodes_;
+      }
+      try {
+        node->value.emplace(factory());
+      } catch (...) {
+        empty_.Push(*node);
+        throw;
+      }
+    }
+    return Ptr{&*node->value, Releaser{*this, *node}};
+  }
+
+  /// Destroys the free objects until at most `max_idle` of them are left
+  void Trim(std::size_t max_idle) noexcept {
+    std::size_t stack_index = 0;
+    while (idle_.load() > max_idle) {
+      auto* node = TryPopFree(stack_index++ % kStacks);
+      if (!node) break;
+      Dispose(*node);
+    }
+  }
+
+  /// Returns the approximate number of free objects
+  std::size_t GetIdleCountApproximate() const noexcept { return idle_.load(); }
+
+ private:
+  // The number of stacks the free objects are spread over
+  static constexpr std::size_t kStacks = 16;
+
+  struct Node final {
+    std::optional<T> value;
+    impl::SinglyLinkedHook<Node> hook;
+  };
+
+  // Nodes are never deleted until the pool is destroyed, so that
+  // IntrusiveStack::TryPop may safely read the nodes popped concurrently
+  using Stack = impl::IntrusiveStack<Node, impl::MemberHook<&Node::hook>>;
+
+  Node* TryPopFree(std::size_t first_stack) noexcept {
+    for (std::size_t i = 0; i < kStacks; ++i) {
+      if (auto* node = free_[(first_stack + i) % kStacks]->TryPop()) {
+        --idle_;
+        return node;
+      }
+    }
+    return nullptr;
+  }
+
+  void Release(Node& node) noexcept {
+    if (idle_.load(std::memory_order_relaxed) >= max_idle_) {
+      Dispose(node);
+      return;
+    }
+    // Counted before the push, so that TryPopFree never makes it negative
+    ++idle_;
+    free_[impl::GetCurrentThreadIndex() % kStacks]->Push(node);
+  }
+
+  void Dispose(Node& node) noexcept {
+    node.value.reset();
+    empty_.Push(node);
+  }
+
+  const std::size_t max_idle_;
+  std::array<impl::InterferenceShield<Stack>, kStacks> free_;
+  // Nodes without objects, reused for the new objects
+  Stack empty_;
+  std::atomic<std::size_t> idle_{0};
+  std::atomic<std::size_t> nodes_{0};
+};
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
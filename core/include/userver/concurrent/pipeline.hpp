@@ -0,0 +1,316 @@
+#pragma once
+
+/// @file userver/concurrent/pipeline.hpp
+/// @brief @copybrief concurrent::Pipeline
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/concurrent/background_task_storage.hpp>
+#include <userver/concurrent/queue.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+/// Settings of a concurrent::Pipeline stage
+struct PipelineStageSettings final {
+  /// Number of tasks processing the elements of the stage concurrently
+  std::size_t parallelism{1};
+
+  /// Maximum number of the elements produced by the stage and not yet taken
+  /// by the next one, the stage waits for the next one when it is reached
+  std::size_t buffer_size{64};
+};
+
+/// Statistics of a concurrent::Pipeline stage
+struct PipelineStageStatistics final {
+  std::string name;
+  /// Number of the elements produced by the stage, or consumed by the
+  /// Pipeline::Consume stage
+  std::uint64_t processed{0};
+  /// Total time spent by the tasks of the stage in the user function
+  std::chrono::microseconds busy_time{0};
+};
+
+namespace impl {
+
+struct PipelineStage final {
+  explicit PipelineStage(std::string name) : name(std::move(name)) {}
+
+  const std::string name;
+  std::atomic<std::uint64_t> processed{0};
+  std::atomic<std::int64_t> busy_time_ns{0};
+  std::atomic<std::size_t> unfinished_tasks{0};
+};
+
+// Measures the time spent in the user function
+class PipelineStageTimer final {
+ public:
+  explicit PipelineStageTimer(PipelineStage& stage) noexcept
+      : stage_(stage), start_(std::chrono::steady_clock::now()) {}
+
+  ~PipelineStageTimer() {
+    stage_.busy_time_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now() - start_)
+                               .count();
+  }
+
+ private:
+  PipelineStage& stage_;
+  const std::chrono::steady_clock::time_point start_;
+};
+
+class PipelineState final {
+ public:
+  PipelineState() = default;
+
+  PipelineState(PipelineState&&) = delete;
+  PipelineState& operator=(PipelineState&&) = delete;
+
+  PipelineStage& AddStage(std::string name);
+
+  void SetException(std::exception_ptr exception) noexcept;
+
+  // Waits for the stage tasks, rethrows the first error of the stages
+  void Finish();
+
+  std::vector<PipelineStageStatistics> GetStatistics() const;
+
+  BackgroundTaskStorage& GetTasks() noexcept { return tasks_; }
+
+ private:
+  std::deque<PipelineStage> stages_;
+  std::atomic<bool> has_exception_{false};
+  std::exception_ptr exception_;
+  // Must be the last, the tasks use the stages
+  BackgroundTaskStorage tasks_;
+};
+
+}  // namespace impl
+
+template <typename T>
+class Pipeline;
+
+/// Pushes the elements of a concurrent::Pipeline stage to the next stage
+template <typename T>
+class PipelineProducer final {
+ public:
+  /// @brief Waits for the space in the buffer of the next stage and pushes
+  /// the element there
+  /// @returns false if the next stages have stopped or if the current task has
+  /// been cancelled, the stage should stop too
+  [[nodiscard]] bool Push(T value) {
+    if (!producer_.Push(std::move(value))) return false;
+    ++stage_.processed;
+    return true;
+  }
+
+ private:
+  template <typename U>
+  friend class Pipeline;
+
+  PipelineProducer(typename NonFifoMpmcQueue<T>::Producer producer,
+                   impl::PipelineStage& stage)
+      : producer_(std::move(producer)), stage_(stage) {}
+
+  typename NonFifoMpmcQueue<T>::Producer producer_;
+  impl::PipelineStage& stage_;
+};
+
+/// @ingroup userver_concurrency
+///
+/// @brief Streaming pipeline of stages connected with bounded buffers.
+///
+/// A pipeline starts with a source stage, FromSource(), continues with
+/// Transform() and Batch() stages and ends with Consume() in the current task.
+/// Each stage runs in its own tasks, `parallelism` of them, and pushes the
+/// elements into a buffer of `buffer_size` elements, that the next stage takes
+/// them from. A stage waits when the buffer of the next stage is full, so a
+/// slow stage slows down the previous ones instead of piling up the elements.
+///
+/// The end of the stream is propagated to the next stages when all the tasks
+/// of a stage finish. An exception of a stage stops the stage, so the stream
+/// ends early, and is rethrown from Consume(). If Consume() throws, or the
+/// pipeline is destroyed without Consume(), the previous stages stop and the
+/// tasks are cancelled.
+///
+/// The order of the elements is kept only if all the stages have
+/// `parallelism` of 1. The elements must be default constructible.
+///
+/// ## Example usage:
+///
+/// @snippet concurrent/pipeline_test.cpp  Sample concurrent::Pipeline usage
+///
+/// @see @ref scripts/docs/en/userver/synchronization.md
+template <typename T>
+class Pipeline final {
+ public:
+  using ValueType = T;
+
+  /// @brief Starts a pipeline with a stage that calls
+  /// `source(PipelineProducer<T>&)` and ends the stream when it returns
+  template <typename Source>
+  static Pipeline FromSource(std::string name, Source source,
+                             const PipelineStageSettings& settings = {}) {
+    auto state = std::make_shared<impl::PipelineState>();
+    auto queue = MakeQueue(settings);
+    auto& stage = AddStage(*state, std::move(name), settings);
+    for (std::size_t i = 0; i < settings.parallelism; ++i) {
+      StartTask(*state, stage,
+                [source, producer = PipelineProducer<T>(queue->GetProducer(),
+                                                        stage)]() mutable {
+                  source(producer);
+                });
+    }
+    return Pipeline{std::move(state), std::move(queue)};
+  }
+
+  Pipeline(Pipeline&&) noexcept = default;
+  Pipeline& operator=(Pipeline&&) noexcept = default;
+
+  /// @brief Adds a stage that pushes `func(element)` for each element
+  template <typename Func>
+  auto Transform(std::string name, Func func,
+                 const PipelineStageSettings& settings = {}) && {
+    using Result = std::decay_t<std::invoke_result_t<Func&, T&&>>;
+    return std::move(*this).template AddStage<Result>(
+        std::move(name), settings,
+        [func](auto& consumer, PipelineProducer<Result>& producer,
+               impl::PipelineStage& stage) mutable {
+          T value;
+          while (consumer.Pop(value)) {
+            std::optional<Result> result;
+            {
+              const impl::PipelineStageTimer timer{stage};
+              result.emplace(func(std::move(value)));
+            }
+            if (!producer.Push(std::move(*result))) return;
+          }
+        });
+  }
+
+  /// @brief Adds a stage that coalesces the elements available at once into
+  /// batches of up to `max_batch_size` elements.
+  ///
+  /// A batch is pushed as soon as there are no more elements available, so
+  /// the batches are small under a low load and large under a high one.
+  Pipeline<std::vector<T>> Batch(
+      std::string name, std::size_t max_batch_size,
+      const PipelineStageSettings& settings = {}) && {
+    UINVARIANT(max_batch_size > 0, "max_batch_size must be positive");
+    return std::move(*this).template AddStage<std::vector<T>>(
+        std::move(name), settings,
+        [max_batch_size](auto& consumer,
+                         PipelineProducer<std::vector<T>>& producer,
+                         impl::PipelineStage& /*stage*/) {
+          std::vector<T> batch;
+          while (consumer.PopMany(batch, max_batch_size) != 0) {
+            if (!producer.Push(std::exchange(batch, {}))) return;
+          }
+        });
+  }
+
+  /// @brief Calls `func(element)` in the current task for each element
+  /// produced by the last stage and waits for all the stages to finish.
+  /// @throws the first exception of the stages or of `func`
+  /// @throws engine::WaitInterruptedException if the current task is
+  /// cancelled
+  template <typename Func>
+  void Consume(std::string name, Func func) {
+    UASSERT_MSG(queue_, "Consume() has already been called");
+    auto& stage = state_->AddStage(std::move(name));
+    {
+      auto consumer = std::exchange(queue_, nullptr)->GetConsumer();
+      T value;
+      while (consumer.Pop(value)) {
+        const impl::PipelineStageTimer timer{stage};
+        func(std::move(value));
+        ++stage.processed;
+      }
+    }
+    state_->Finish();
+  }
+
+  /// Returns the statistics of the stages started so far
+  std::vector<PipelineStageStatistics> GetStatistics() const {
+    return state_->GetStatistics();
+  }
+
+ private:
+  using Queue = NonFifoMpmcQueue<T>;
+
+  template <typename U>
+  friend class Pipeline;
+
+  Pipeline(std::shared_ptr<impl::PipelineState> state,
+           std::shared_ptr<Queue> queue)
+      : state_(std::move(state)), queue_(std::move(queue)) {}
+
+  static std::shared_ptr<Queue> MakeQueue(
+      const PipelineStageSettings& settings) {
+    return Queue::Create(settings.buffer_size);
+  }
+
+  static impl::PipelineStage& AddStage(impl::PipelineState& state,
+                                       std::string name,
+                                       const PipelineStageSettings& settings) {
+    UINVARIANT(settings.parallelism > 0, "parallelism must be positive");
+    auto& stage = state.AddStage(std::move(name));
+    stage.unfinished_tasks = settings.parallelism;
+    return stage;
+  }
+
+  template <typename Func>
+  static void StartTask(impl::PipelineState& state, impl::PipelineStage& stage,
+                        Func&& func) {
+    state.GetTasks().AsyncDetach(
+        stage.name,
+        [&state, &stage, func = std::forward<Func>(func)]() mutable {
+          try {
+            func();
+          } catch (const std::exception&) {
+            state.SetException(std::current_exception());
+          }
+          --stage.unfinished_tasks;
+        });
+  }
+
+  // `stage_func(consumer, producer, stage)` processes the elements of a task
+  template <typename U, typename StageFunc>
+  Pipeline<U> AddStage(std::string name, const PipelineStageSettings& settings,
+                       StageFunc stage_func) && {
+    UASSERT_MSG(queue_, "Consume() has already been called");
+    auto queue = Pipeline<U>::MakeQueue(settings);
+    auto& stage = AddStage(*state_, std::move(name), settings);
+    for (std::size_t i = 0; i < settings.parallelism; ++i) {
+      StartTask(*state_, stage,
+                [stage_func, &stage, consumer = queue_->GetConsumer(),
+                 producer = PipelineProducer<U>(queue->GetProducer(),
+                                                stage)]() mutable {
+                  stage_func(consumer, producer, stage);
+                });
+    }
+    // The previous stage ends when all the tasks of this one stop consuming
+    queue_.reset();
+    return Pipeline<U>{std::move(state_), std::move(queue)};
+  }
+
+  std::shared_ptr<impl::PipelineState> state_;
+  std::shared_ptr<Queue> queue_;
+};
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
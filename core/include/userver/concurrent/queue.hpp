@@ -1,8 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <iterator>
 #include <limits>
 #include <memory>
+#include <vector>
 
 #include <moodycamel/concurrentqueue.h>
 
@@ -223,16 +225,46 @@ class GenericQueue final
     return producer_side_.PushNoblock(token, std::move(value));
   }
 
+  template <typename Token>
+  [[nodiscard]] bool PushMany(Token& token, std::vector<T>&& values,
+                              engine::Deadline deadline) {
+    if (values.empty()) return true;
+
+    // The batch would never fit, both producer sides fail it at once instead
+    // of waiting for the deadline
+    const std::size_t values_size = GetTotalSize(values);
+    if (values_size > producer_side_.GetSoftMaxSize()) return false;
+
+    return producer_side_.PushMany(token, std::move(values), values_size,
+                                   deadline);
+  }
+
   template <typename Token>
   [[nodiscard]] bool Pop(Token& token, T& value, engine::Deadline deadline) {
     return consumer_side_.Pop(token, value, deadline);
   }
 
+  template <typename Token>
+  [[nodiscard]] std::size_t PopMany(Token& token, std::vector<T>& values,
+                                    std::size_t max_count,
+                                    engine::Deadline deadline) {
+    UASSERT(max_count > 0);
+    return consumer_side_.PopMany(token, values, max_count, deadline);
+  }
+
   template <typename Token>
   [[nodiscard]] bool PopNoblock(Token& token, T& value) {
     return consumer_side_.PopNoblock(token, value);
   }
 
+  static std::size_t GetTotalSize(const std::vector<T>& values) {
+    std::size_t total_size = 0;
+    for (const auto& value : values) {
+      total_size += QueuePolicy::GetElementSize(value);
+    }
+    return total_size;
+  }
+
   void PrepareProducer() {
     std::size_t old_producers_count{};
     utils::AtomicUpdate(producers_count_, [&](auto old_value) {
@@ -304,6 +336,26 @@ class GenericQueue final
     consumer_side_.OnElementPushed();
   }
 
+  template <typename Token>
+  void DoPushMany(Token& token, std::vector<T>&& values) {
+    const auto count = values.size();
+    auto first = std::make_move_iterator(values.begin());
+    if constexpr (std::is_same_v<Token, moodycamel::ProducerToken>) {
+      static_assert(QueuePolicy::kIsMultipleProducer);
+      queue_.enqueue_bulk(token, first, count);
+    } else if constexpr (std::is_same_v<Token, MultiProducerToken>) {
+      static_assert(QueuePolicy::kIsMultipleProducer);
+      queue_.enqueue_bulk(first, count);
+    } else {
+      static_assert(std::is_same_v<Token, impl::NoToken>);
+      static_assert(!QueuePolicy::kIsMultipleProducer);
+      queue_.enqueue_bulk(single_producer_token_, first, count);
+    }
+    values.clear();
+
+    consumer_side_.OnElementsPushed(count);
+  }
+
   template <typename Token>
   [[nodiscard]] bool DoPop(Token& token, T& value) {
     bool success{};
@@ -328,6 +380,37 @@ class GenericQueue final
     return false;
   }
 
+  // Appends at most `max_count` elements to `values`
+  template <typename Token>
+  std::size_t DoPopMany(Token& token, std::vector<T>& values,
+                        std::size_t max_count) {
+    const auto old_size = values.size();
+    auto out = std::back_inserter(values);
+    std::size_t popped{};
+
+    if constexpr (std::is_same_v<Token, moodycamel::ConsumerToken>) {
+      static_assert(QueuePolicy::kIsMultipleProducer);
+      popped = queue_.try_dequeue_bulk(token, out, max_count);
+    } else if constexpr (std::is_same_v<Token, impl::MultiToken>) {
+      static_assert(QueuePolicy::kIsMultipleProducer);
+      popped = queue_.try_dequeue_bulk(out, max_count);
+    } else {
+      static_assert(std::is_same_v<Token, impl::NoToken>);
+      static_assert(!QueuePolicy::kIsMultipleProducer);
+      popped = queue_.try_dequeue_bulk_from_producer(single_producer_token_,
+                                                     out, max_count);
+    }
+
+    if (popped != 0) {
+      std::size_t released_capacity = 0;
+      for (auto it = values.begin() + old_size; it != values.end(); ++it) {
+        released_capacity += QueuePolicy::GetElementSize(*it);
+      }
+      producer_side_.OnElementPopped(released_capacity);
+    }
+    return popped;
+  }
+
   moodycamel::ConcurrentQueue<T> queue_{1};
   std::atomic<std::size_t> consumers_count_{0};
   std::atomic<std::size_t> producers_count_{0};
@@ -368,6 +451,19 @@ class GenericQueue<T, QueuePolicy>::SingleProducerSide final {
     return DoPush(token, std::move(value));
   }
 
+  template <typename Token>
+  [[nodiscard]] bool PushMany(Token& token, std::vector<T>&& values,
+                              std::size_t values_size,
+                              engine::Deadline deadline) {
+    while (!DoPushMany(token, std::move(values), values_size)) {
+      if (queue_.NoMoreConsumers() || values_size > total_capacity_.load() ||
+          !non_full_event_.WaitForEventUntil(deadline)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   void OnElementPopped(std::size_t released_capacity) {
     used_capacity_.fetch_sub(released_capacity);
     non_full_event_.Send();
@@ -406,6 +502,20 @@ class GenericQueue<T, QueuePolicy>::SingleProducerSide final {
     return true;
   }
 
+  template <typename Token>
+  [[nodiscard]] bool DoPushMany(Token& token, std::vector<T>&& values,
+                                std::size_t values_size) {
+    if (queue_.NoMoreConsumers() ||
+        used_capacity_.load() + values_size > total_capacity_.load()) {
+      return false;
+    }
+
+    used_capacity_.fetch_add(values_size);
+    queue_.DoPushMany(token, std::move(values));
+    non_full_event_.Reset();
+    return true;
+  }
+
   GenericQueue& queue_;
   engine::SingleConsumerEvent non_full_event_;
   std::atomic<std::size_t> used_capacity_;
@@ -438,6 +548,24 @@ class GenericQueue<T, QueuePolicy>::MultiProducerSide final {
            DoPush(token, std::move(value));
   }
 
+  template <typename Token>
+  [[nodiscard]] bool PushMany(Token& token, std::vector<T>&& values,
+                              std::size_t values_size,
+                              engine::Deadline deadline) {
+    // Fails without waiting if the capacity gets less than values_size
+    if (!remaining_capacity_.try_lock_shared_until_count(deadline,
+                                                         values_size)) {
+      return false;
+    }
+    if (queue_.NoMoreConsumers()) {
+      remaining_capacity_.unlock_shared_count(values_size);
+      return false;
+    }
+
+    queue_.DoPushMany(token, std::move(values));
+    return true;
+  }
+
   void OnElementPopped(std::size_t value_size) {
     remaining_capacity_.unlock_shared_count(value_size);
   }
@@ -508,11 +636,32 @@ class GenericQueue<T, QueuePolicy>::SingleConsumerSide final {
     return DoPop(token, value);
   }
 
+  // Blocks only if queue is empty
+  template <typename Token>
+  [[nodiscard]] std::size_t PopMany(Token& token, std::vector<T>& values,
+                                    std::size_t max_count,
+                                    engine::Deadline deadline) {
+    while (true) {
+      const auto popped = DoPopMany(token, values, max_count);
+      if (popped != 0) return popped;
+      if (queue_.NoMoreProducers() ||
+          !nonempty_event_.WaitForEventUntil(deadline)) {
+        // See Pop
+        return DoPopMany(token, values, max_count);
+      }
+    }
+  }
+
   void OnElementPushed() {
     ++element_count_;
     nonempty_event_.Send();
   }
 
+  void OnElementsPushed(std::size_t count) {
+    element_count_ += count;
+    nonempty_event_.Send();
+  }
+
   void StopBlockingOnPop() { nonempty_event_.Send(); }
 
   void ResumeBlockingOnPop() {}
@@ -530,6 +679,17 @@ class GenericQueue<T, QueuePolicy>::SingleConsumerSide final {
     return false;
   }
 
+  template <typename Token>
+  [[nodiscard]] std::size_t DoPopMany(Token& token, std::vector<T>& values,
+                                      std::size_t max_count) {
+    const auto popped = queue_.DoPopMany(token, values, max_count);
+    if (popped != 0) {
+      element_count_ -= popped;
+      nonempty_event_.Reset();
+    }
+    return popped;
+  }
+
   GenericQueue& queue_;
   engine::SingleConsumerEvent nonempty_event_;
   std::atomic<std::size_t> element_count_;
@@ -561,8 +721,40 @@ class GenericQueue<T, QueuePolicy>::MultiConsumerSide final {
     return element_count_.try_lock_shared() && DoPop(token, value);
   }
 
+  // Blocks only if queue is empty
+  template <typename Token>
+  [[nodiscard]] std::size_t PopMany(Token& token, std::vector<T>& values,
+                                    std::size_t max_count,
+                                    engine::Deadline deadline) {
+    if (!element_count_.try_lock_shared_until(deadline)) return 0;
+
+    // Take the rest of the available elements with a single semaphore
+    // operation, fall back to the one already taken under contention
+    std::size_t count = 1;
+    const auto extra_count =
+        std::min(max_count - 1, element_count_.RemainingApprox());
+    if (extra_count != 0 && element_count_.try_lock_shared_count(extra_count)) {
+      count += extra_count;
+    }
+
+    std::size_t popped = 0;
+    while (popped < count) {
+      popped += queue_.DoPopMany(token, values, count - popped);
+      if (popped < count && queue_.NoMoreProducers()) {
+        element_count_.unlock_shared_count(count - popped);
+        break;
+      }
+      // See DoPop
+    }
+    return popped;
+  }
+
   void OnElementPushed() { element_count_.unlock_shared(); }
 
+  void OnElementsPushed(std::size_t count) {
+    element_count_.unlock_shared_count(count);
+  }
+
   void StopBlockingOnPop() {
     element_count_control_.SetCapacityOverride(kUnbounded +
                                                kSemaphoreUnlockValue);
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 #include <userver/engine/deadline.hpp>
 
@@ -63,6 +65,21 @@ class Producer final {
     return queue_->PushNoblock(token_, std::move(value));
   }
 
+  /// Push all the elements into queue at once. May wait asynchronously until
+  /// the queue has room for all of them. On success the `values` are cleared,
+  /// otherwise they are left unmodified.
+  ///
+  /// Unlike a series of Push calls, the capacity of the queue is taken and the
+  /// consumers are notified once per batch.
+  /// @returns whether push succeeded before the deadline and before the task
+  /// was canceled, always `false` without waiting for a batch larger than the
+  /// max size of the queue.
+  [[nodiscard]] bool PushMany(std::vector<ValueType>&& values,
+                              engine::Deadline deadline = {}) const {
+    UASSERT(queue_);
+    return queue_->PushMany(token_, std::move(values), deadline);
+  }
+
   void Reset() && {
     if (queue_) queue_->MarkProducerIsDead();
     queue_.reset();
@@ -124,6 +141,19 @@ class Consumer final {
     return queue_->PopNoblock(token_, value);
   }
 
+  /// Pop up to `max_count` elements from queue at once and append them to
+  /// `values`. May wait asynchronously if the queue is empty, but the producer
+  /// is alive, and does not wait for more elements once some are available.
+  /// @returns the number of the popped elements, 0 if nothing was popped
+  /// before the deadline.
+  /// @note 0 can be returned before the deadline when the producer is no longer
+  /// alive.
+  [[nodiscard]] std::size_t PopMany(std::vector<ValueType>& values,
+                                    std::size_t max_count,
+                                    engine::Deadline deadline = {}) const {
+    return queue_->PopMany(token_, values, max_count, deadline);
+  }
+
   /// Const access to source queue.
   [[nodiscard]] std::shared_ptr<const QueueType> Queue() const {
     return {queue_};
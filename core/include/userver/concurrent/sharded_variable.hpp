@@ -0,0 +1,85 @@
+#pragma once
+
+/// @file userver/concurrent/sharded_variable.hpp
+/// @brief @copybrief concurrent::ShardedVariable
+
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/concurrent/impl/thread_index.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief Several instances of the data, each protected with its own mutex,
+/// for the state that is updated by lots of tasks at once.
+///
+/// Lock() returns the shard of the thread the current task runs on, so the
+/// tasks of different threads rarely contend for the same mutex or cache
+/// line. Readers visit all the shards with VisitAll() and combine them, e.g.
+/// sum up the counters. To keep the reads cheap, the shards may be merged
+/// into a single instance periodically, e.g. by draining them with VisitAll()
+/// from a utils::PeriodicTask.
+///
+/// Prefer concurrent::Variable if the data is not updated on the hot path.
+///
+/// ## Example usage:
+///
+/// @snippet concurrent/sharded_variable_test.cpp  Sample concurrent::ShardedVariable usage
+///
+/// @see @ref scripts/docs/en/userver/synchronization.md
+template <typename Data, std::size_t Shards = 16,
+          typename Mutex = engine::Mutex>
+class ShardedVariable final {
+  static_assert(Shards > 0, "ShardedVariable must have at least one shard");
+
+ public:
+  /// Constructs each of the shards from a copy of the `args`
+  template <typename... Args>
+  explicit ShardedVariable(const Args&... args) : shards_(Shards, args...) {}
+
+  /// Locks the shard of the current thread. The task may migrate to another
+  /// thread while the lock is held, it still unlocks the same shard.
+  LockedPtr<std::lock_guard<Mutex>, Data> Lock() {
+    return shards_[impl::GetCurrentThreadIndex() % Shards]->Lock();
+  }
+
+  /// @brief Calls `func(data)` for each of the shards in turn, under the lock
+  /// of the shard.
+  ///
+  /// The shards are not locked all at once, so the aggregate may include the
+  /// updates that have happened after the visiting started.
+  template <typename Func>
+  void VisitAll(Func&& func) {
+    for (auto& shard : shards_) {
+      auto data = shard->Lock();
+      func(*data);
+    }
+  }
+
+  /// @overload
+  template <typename Func>
+  void VisitAll(Func&& func) const {
+    for (const auto& shard : shards_) {
+      const auto data = shard->Lock();
+      func(*data);
+    }
+  }
+
+  static constexpr std::size_t GetShardCount() noexcept { return Shards; }
+
+ private:
+  utils::FixedArray<impl::InterferenceShield<Variable<Data, Mutex>>> shards_;
+};
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
@@ -19,6 +19,10 @@ namespace congestion_control {
 ///
 /// @brief Component to limit too active requests, also known as CC.
 ///
+/// The RPS limit is measured in request costs: a request takes
+/// `throttling_cost` tokens of its handler, see server::handlers::HandlerBase,
+/// so expensive handlers are throttled before the cheap ones.
+///
 /// ## Dynamic config
 /// * @ref USERVER_RPS_CCONTROL
 /// * @ref USERVER_RPS_CCONTROL_ENABLED
@@ -30,6 +34,14 @@ namespace congestion_control {
 /// min-cpu | force fake-mode if the current cpu number is less than the specified value | 1
 /// only-rtc | if set to true and hostinfo::IsInRtc() returns false then forces the fake-mode | true
 /// status-code | HTTP status code for ratelimited responses | 429
+/// controller | the algorithm of the RPS limit, `linear` by the counts of the overloaded tasks (see @ref USERVER_RPS_CCONTROL) or `gradient` by the queue wait time and the CPU usage with the shedding of the request priority classes (see @ref USERVER_RPS_CCONTROL_GRADIENT) | linear
+///
+/// The `gradient` controller lowers the limit proportionally to the growth of
+/// the 99th percentile of the task queue wait time over its no-load baseline,
+/// as TCP Vegas does with the RTT, and to the CPU usage above the threshold.
+/// If the limit does not keep up, the requests to the handlers with the lowest
+/// `throttling_priority` are rejected entirely, see
+/// server::handlers::HandlerBase.
 ///
 /// ## Static configuration example:
 ///
@@ -62,7 +74,7 @@ class Component final : public components::LoggableComponentBase {
   void ExtendWriter(utils::statistics::Writer& writer);
 
   struct Impl;
-  utils::FastPimpl<Impl, 560, 8> pimpl_;
+  utils::FastPimpl<Impl, 640, 8> pimpl_;
 };
 
 }  // namespace congestion_control
@@ -3,6 +3,7 @@
 /// @file userver/congestion_control/config.hpp
 /// @brief Congestion Control config structures
 
+#include <chrono>
 #include <cstddef>
 
 #include <userver/dynamic_config/snapshot.hpp>
@@ -32,12 +33,48 @@ struct Policy {
 
 Policy Parse(const formats::json::Value& policy, formats::parse::To<Policy>);
 
+/// Policy of the gradient congestion controller, see
+/// @ref USERVER_RPS_CCONTROL_GRADIENT
+struct GradientPolicy {
+  size_t min_limit{10};
+
+  /// Lower bound of the queue wait baseline
+  std::chrono::microseconds min_queue_wait{1000};
+  /// The limit shrinks if the queue wait exceeds the baseline this many times
+  double queue_wait_tolerance{2};
+  /// The limit shrinks if the CPU usage exceeds this percent of the CPU limit
+  double cpu_limit_percent{90};
+  /// The limit shrinks if some of the tasks are stalled on memory for more
+  /// than this percent of the time
+  double memory_pressure_percent{20};
+
+  /// Share of the gradient applied to the limit every second
+  double smoothing_percent{20};
+  /// Lower bound of the gradient, the fastest decrease of the limit per second
+  double min_gradient_percent{50};
+
+  /// The lowest request priority class is shed after this many seconds with
+  /// the gradient below `shed_gradient_percent`
+  double shed_gradient_percent{70};
+  size_t shed_on_seconds{5};
+  size_t shed_off_seconds{10};
+  /// A next request priority class is shed every second while all of the
+  /// tasks are stalled on memory for more than this percent of the time
+  double memory_shed_percent{10};
+
+  size_t no_limit_seconds{60};
+};
+
+GradientPolicy Parse(const formats::json::Value& policy,
+                     formats::parse::To<GradientPolicy>);
+
 namespace impl {
 
 struct RpsCcConfig {
   Policy policy;
   bool is_enabled{};
   int activate_factor{0};
+  GradientPolicy gradient_policy;
 };
 
 extern const dynamic_config::Key<RpsCcConfig> kRpsCcConfig;
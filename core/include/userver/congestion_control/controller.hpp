@@ -27,6 +27,17 @@ struct PolicyState {
   size_t max_up_delta{1};
 };
 
+struct GradientState {
+  /// Smoothed queue wait when not overloaded, a Vegas-like "base RTT"
+  double queue_wait_baseline_us{0};
+  double gradient{1};
+
+  size_t times_wo_overload{0};
+  size_t times_under_shed_gradient{0};
+  size_t times_wo_shed_pressure{0};
+  size_t shed_level{0};
+};
+
 struct Stats final {
   std::atomic<size_t> no_limit{0};
   std::atomic<size_t> not_overload_no_pressure{0};
@@ -35,6 +46,7 @@ struct Stats final {
   std::atomic<size_t> overload_pressure{0};
 
   std::atomic<size_t> current_state{0};
+  std::atomic<size_t> shed_level{0};
   std::atomic<std::chrono::seconds> last_overload_pressure{
       std::chrono::duration_cast<std::chrono::seconds>(
           std::chrono::steady_clock::now().time_since_epoch()) -
@@ -43,7 +55,22 @@ struct Stats final {
 
 class Controller final {
  public:
-  Controller(std::string name, dynamic_config::Source config_source);
+  enum class Algorithm {
+    /// Linear increase and multiplicative decrease of the limit by the counts
+    /// of the overloaded tasks, see @ref USERVER_RPS_CCONTROL
+    kLinear,
+    /// Vegas-like gradient of the limit by the queue wait time and the CPU
+    /// usage with the shedding of the request priority classes, see
+    /// @ref USERVER_RPS_CCONTROL_GRADIENT
+    kGradient,
+  };
+
+  /// Shed level at which all the requests except for the highest priority
+  /// class are rejected
+  static constexpr std::size_t kMaxShedLevel = 2;
+
+  Controller(std::string name, dynamic_config::Source config_source,
+             Algorithm algorithm = Algorithm::kLinear);
 
   void Feed(const Sensor::Data&);
 
@@ -62,12 +89,20 @@ class Controller final {
 
   size_t CalcNewLimit(const Sensor::Data& data, const Policy& policy) const;
 
+  void FeedLinear(const Sensor::Data& data, const Policy& policy);
+
+  void FeedGradient(const Sensor::Data& data, const GradientPolicy& policy);
+
+  void UpdateShedLevel(const Sensor::Data& data, const GradientPolicy& policy);
+
   static bool IsThresholdReached(const Sensor::Data& data, int percent);
 
   const std::string name_;
+  const Algorithm algorithm_;
   Limit limit_;
   dynamic_config::Source config_source_;
   PolicyState state_;
+  GradientState gradient_state_;
   std::atomic<bool> is_enabled_;
 
   Stats stats_;
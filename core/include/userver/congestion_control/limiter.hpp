@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <optional>
 #include <string>
 
@@ -10,10 +11,14 @@ namespace congestion_control {
 struct Limit {
   std::optional<size_t> load_limit;
   size_t current_load{0};
+  /// Count of the lowest request priority classes that are rejected entirely
+  std::size_t shed_level{0};
 
   std::string ToLogString() {
     return "limit=" +
-           (load_limit ? std::to_string(*load_limit) : std::string("(none)"));
+           (load_limit ? std::to_string(*load_limit) : std::string("(none)")) +
+           (shed_level ? " shed_level=" + std::to_string(shed_level)
+                       : std::string{});
   }
 };
 
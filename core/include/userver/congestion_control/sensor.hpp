@@ -17,6 +17,17 @@ class Sensor {
     std::uint64_t overload_events_count{0};
     std::uint64_t no_overload_events_count{0};
     std::chrono::steady_clock::time_point tp;
+    /// Tasks queue wait time percentile over the period, 0 if unknown
+    std::chrono::microseconds queue_wait{0};
+    /// CPU time used over the period in fraction of the CPU limit, 0 if
+    /// unknown
+    double cpu_usage{0};
+    /// Share of the time some of the tasks of the cgroup were stalled on
+    /// memory over the last 10 seconds (PSI), 0 if unknown
+    double memory_pressure{0};
+    /// Share of the time all of the tasks of the cgroup were stalled on
+    /// memory over the last 10 seconds (PSI), 0 if unknown
+    double memory_full_pressure{0};
 
     double GetLoadPercent() const;
   };
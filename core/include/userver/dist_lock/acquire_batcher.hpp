@@ -0,0 +1,122 @@
+#pragma once
+
+/// @file userver/dist_lock/acquire_batcher.hpp
+/// @brief @copybrief dist_lock::AcquireBatcher
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/dist_lock/dist_lock_strategy.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+class Writer;
+}  // namespace utils::statistics
+
+namespace dist_lock {
+
+/// AcquireBatcher settings
+struct AcquireBatcherSettings {
+  /// For how long the first request of a batch waits for the others.
+  std::chrono::milliseconds max_delay{2};
+
+  /// How many requests may be sent in a single batch, the rest of the
+  /// requests wait for the next batch.
+  std::size_t max_size{100};
+};
+
+/// @ingroup userver_concurrency
+///
+/// @brief Combines the concurrent lock acquisitions of the distributed lock
+/// strategies into batches
+///
+/// Strategies of a single backend may share the batcher to acquire and
+/// prolong hundreds of locks in a single round trip instead of issuing a
+/// query per lock. The first request waits for
+/// AcquireBatcherSettings::max_delay and then sends a batch with all the
+/// requests received by that time.
+/// Requests that arrive while the batch is in flight are sent with the next
+/// batch right after it.
+///
+/// The prolongations of the locks with the same prolong interval are aligned
+/// by dist_lock::DistLockedWorker, so they usually get into a single batch.
+class AcquireBatcher final {
+ public:
+  struct Request {
+    /// Name of the lock, a batch never contains two requests of the same lock
+    std::string key;
+    /// Globally unique ID of the locking entity
+    std::string owner;
+    /// The duration for which the lock must be held
+    std::chrono::milliseconds lock_ttl;
+  };
+
+  struct Result {
+    /// `false` if the lock is acquired by another host
+    bool is_acquired{false};
+    std::optional<FencingToken> fencing_token;
+  };
+
+  /// @brief Acquires the locks in a single round trip to the backend
+  /// @returns the results for each of the requests in the same order
+  /// @throws anything to fail all the requests of the batch
+  using BatchFunc =
+      std::function<std::vector<Result>(const std::vector<Request>&)>;
+
+  struct Statistics {
+    utils::statistics::RelaxedCounter<std::size_t> batches{0};
+    utils::statistics::RelaxedCounter<std::size_t> requests{0};
+    utils::statistics::RelaxedCounter<std::size_t> failed_batches{0};
+  };
+
+  AcquireBatcher(BatchFunc batch_func, const AcquireBatcherSettings& settings);
+
+  ~AcquireBatcher();
+
+  AcquireBatcher(const AcquireBatcher&) = delete;
+  AcquireBatcher& operator=(const AcquireBatcher&) = delete;
+
+  /// @brief Acquires the lock with the next batch
+  /// @returns the fencing token of the lock if it was provided by the backend
+  /// @throws LockIsAcquiredByAnotherHostException when the lock is busy
+  /// @throws anything else the BatchFunc has thrown
+  /// @note The batch is awaited even if the current task is cancelled, so the
+  /// lock can not be acquired after the cancelled caller releases it.
+  std::optional<FencingToken> Acquire(Request request);
+
+  const Statistics& GetStatistics() const;
+
+ private:
+  struct Pending {
+    Request request;
+    engine::Promise<Result> promise;
+  };
+
+  void RunBatches();
+  std::vector<Pending> TakeBatch();
+  void SendBatch(std::vector<Pending>& batch);
+
+  const BatchFunc batch_func_;
+  const AcquireBatcherSettings settings_;
+
+  engine::Mutex mutex_;
+  std::vector<Pending> pending_;
+  bool has_leader_{false};
+
+  Statistics stats_;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const AcquireBatcher& batcher);
+
+}  // namespace dist_lock
+
+USERVER_NAMESPACE_END
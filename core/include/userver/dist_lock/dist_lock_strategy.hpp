@@ -4,7 +4,9 @@
 /// @brief @copybrief dist_lock::DistLockStrategyBase
 
 #include <chrono>
+#include <cstdint>
 #include <exception>
+#include <optional>
 #include <string>
 
 USERVER_NAMESPACE_BEGIN
@@ -14,6 +16,13 @@ namespace dist_lock {
 /// Indicates that lock cannot be acquired because it's busy.
 class LockIsAcquiredByAnotherHostException : public std::exception {};
 
+/// @brief Monotonic token of the lock ownership
+///
+/// The token is increased each time the lock passes to another holder, so
+/// the storages that receive the writes of the lock holders may reject the
+/// writes of the stale holders by comparing their tokens to the last seen one.
+using FencingToken = std::int64_t;
+
 /// @ingroup userver_base_classes userver_concurrency
 ///
 /// @brief Interface for distributed lock strategies
@@ -35,6 +44,17 @@ class DistLockStrategyBase {
   virtual void Acquire(std::chrono::milliseconds lock_ttl,
                        const std::string& locker_id) = 0;
 
+  /// Acquires the distributed lock and returns its fencing token.
+  ///
+  /// Same as Acquire(), the strategies that support the fencing tokens
+  /// override this method.
+  /// @returns std::nullopt if the fencing tokens are not supported
+  virtual std::optional<FencingToken> AcquireWithFencingToken(
+      std::chrono::milliseconds lock_ttl, const std::string& locker_id) {
+    Acquire(lock_ttl, locker_id);
+    return std::nullopt;
+  }
+
   /// Releases the lock.
   ///
   /// @param locker_id Globally unique ID of the locking entity, must be the
@@ -75,6 +75,11 @@ class DistLockedWorker final {
   /// may be less than the real duration.
   std::optional<std::chrono::steady_clock::duration> GetLockedDuration() const;
 
+  /// Returns the fencing token of the held lock if the lock is held and the
+  /// strategy supports the fencing tokens.
+  /// @see dist_lock::FencingToken
+  std::optional<FencingToken> GetFencingToken() const;
+
   /// Returns lock acquisition statistics.
   const Statistics& GetStatistics() const;
 
@@ -14,6 +14,10 @@ struct Statistics {
   utils::statistics::RelaxedCounter<size_t> watchdog_triggers{0};
   utils::statistics::RelaxedCounter<size_t> brain_splits{0};
   utils::statistics::RelaxedCounter<size_t> task_failures{0};
+  /// Failed attempts because the lock is held by another host
+  utils::statistics::RelaxedCounter<size_t> lock_contentions{0};
+  /// Acquisitions of the lock that was not held before
+  utils::statistics::RelaxedCounter<size_t> lock_acquisitions{0};
 };
 
 }  // namespace dist_lock
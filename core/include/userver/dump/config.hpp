@@ -5,6 +5,7 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/formats/json/value.hpp>
@@ -32,6 +33,21 @@ struct ConfigPatch final {
 ConfigPatch Parse(const formats::json::Value& value,
                   formats::parse::To<ConfigPatch>);
 
+/// Settings of the block-based dump compression
+struct CompressionConfig final {
+  int level{1};
+  uint64_t block_size{1024 * 1024};
+  uint64_t parallelism{4};
+  std::string task_processor;
+};
+
+/// Settings of the loading of the data from already running instances, see
+/// dump::Dumper::WriteSnapshot
+struct PeerWarmupConfig final {
+  std::vector<std::string> urls;
+  std::chrono::milliseconds timeout{std::chrono::minutes{1}};
+};
+
 struct Config final {
   Config(std::string name, const yaml_config::YamlConfig& config,
          std::string_view dump_root);
@@ -42,9 +58,13 @@ struct Config final {
   std::string dump_directory;
   std::string fs_task_processor;
   uint64_t max_dump_count;
+  uint64_t max_delta_count;
   std::optional<std::chrono::milliseconds> max_dump_age;
   bool max_dump_age_set;
   bool dump_is_encrypted;
+  bool read_with_mmap;
+  std::optional<CompressionConfig> compression;
+  std::optional<PeerWarmupConfig> peer_warmup;
 
   bool static_dumps_enabled;
   std::chrono::milliseconds static_min_dump_interval;
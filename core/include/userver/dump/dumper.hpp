@@ -43,6 +43,16 @@ class DumpableEntity {
   virtual void GetAndWrite(dump::Writer& writer) const = 0;
 
   virtual void ReadAndSet(dump::Reader& reader) = 0;
+
+  /// @brief Writes the changes since the data was last written or read
+  /// @returns `false` if the changes are unknown, e.g. after a full update.
+  /// A full dump is written instead.
+  /// @note Only called if `max-delta-count` is set, returns `false` by default
+  virtual bool GetAndWriteDelta(dump::Writer& writer) const;
+
+  /// @brief Applies the changes written by `GetAndWriteDelta` to the data
+  /// @throws dump::Error by default
+  virtual void ReadAndApplyDelta(dump::Reader& reader);
 };
 
 enum class UpdateType {
@@ -82,9 +92,19 @@ enum class UpdateType {
 /// `format-version` | `integer` | Allows to ignore dumps written with an obsolete `format-version` | (required)
 /// `max-age` | optional `string` (duration) | Overdue dumps are ignored | null
 /// `max-count` | optional `integer` | Old dumps over the limit are removed from disk | `1`
+/// `max-delta-count` | `integer` | Number of delta dumps written on top of a full dump before the next full dump, 0 disables delta dumps, see dump::DumpableEntity::GetAndWriteDelta | `0`
 /// `min-interval` | `string` (duration) | `WriteDumpAsync` calls performed in a fast succession are ignored | `0s`
 /// `fs-task-processor` | `string` | `TaskProcessor` for blocking disk IO | `fs-task-processor`
 /// `encrypted` | `boolean` | Whether to encrypt the dump | `false`
+/// `read-with-mmap` | `boolean` | Whether to read not encrypted dumps through a memory mapping of the file, see dump::FileMmapReader | `false`
+/// `compression` | `object` | Enables the block-based zstd compression of the dump, see dump::CompressedWriter | -
+/// `compression.level` | `integer` | zstd compression level from 1 to 22 | `1`
+/// `compression.block-size` | `integer` | Size in bytes of the uncompressed data blocks, that are compressed independently | `1048576`
+/// `compression.parallelism` | `integer` | Number of blocks that are compressed or decompressed simultaneously | `4`
+/// `compression.task-processor` | `string` | `TaskProcessor` for the (de)compression | value of `fs-task-processor`
+/// `peer-warmup` | `object` | Enables loading the data from an already running instance if there is no suitable dump, see server::handlers::DumpSnapshot | -
+/// `peer-warmup.urls` | `array` of `string` | URLs of server::handlers::DumpSnapshot of the instances to try, in order | (required)
+/// `peer-warmup.timeout` | `string` (duration) | Timeout of the whole transfer of a snapshot from an instance | `1m`
 ///
 /// ## Sample usage
 /// @snippet core/src/dump/dumper_test.cpp  Sample Dumper usage
@@ -112,11 +132,26 @@ class Dumper final {
 
   const std::string& Name() const;
 
-  /// @brief Read data from a dump, if any
+  /// @brief Read data from a dump, if any, otherwise from a snapshot of a
+  /// `peer-warmup` instance
   /// @note Catches and logs any exceptions related to read operation failure
   /// @returns `update_time` of the loaded dump on success, `null` otherwise
   std::optional<TimePoint> ReadDump();
 
+  /// @brief Writes the current data as a snapshot, that can be loaded by
+  /// `ReadSnapshot` of the same `Dumper` in another instance
+  ///
+  /// Writes of the dumps wait for the snapshot to be written. The next dump is
+  /// a full one, not a delta dump.
+  /// @throws std::exception if the data is not ready or on write failure
+  void WriteSnapshot(Writer& writer);
+
+  /// @brief Loads the data from a snapshot written by `WriteSnapshot`
+  /// @returns `update_time` of the loaded snapshot
+  /// @throws std::exception on read failure, e.g. if the snapshot was written
+  /// with another `format-version`
+  TimePoint ReadSnapshot(Reader& reader);
+
   /// @brief Forces the `Dumper` to write a dump synchronously
   /// @throws std::exception if the `Dumper` failed to write a dump
   void WriteDumpSyncDebug();
@@ -166,7 +201,7 @@ class Dumper final {
          const components::ComponentContext& context, DumpableEntity& dumpable);
 
   class Impl;
-  utils::FastPimpl<Impl, 1056, 16> impl_;
+  utils::FastPimpl<Impl, 1328, 16> impl_;
 };
 
 }  // namespace dump
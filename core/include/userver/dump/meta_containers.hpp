@@ -13,6 +13,13 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace cache {
+template <typename Key, typename Value, typename Hash, typename Equal>
+class PersistentHashMap;
+template <typename Key, typename Value, typename Hash, typename Equal>
+class FlatHashMap;
+}  // namespace cache
+
 namespace dump {
 
 /// @{
@@ -33,6 +40,17 @@ void Insert(std::unordered_map<K, V, Hash, Eq, Alloc>& cont,
   cont.insert(std::move(elem));
 }
 
+template <typename K, typename V, typename Hash, typename Eq>
+void Insert(cache::PersistentHashMap<K, V, Hash, Eq>& cont,
+            std::pair<const K, V>&& elem) {
+  cont.insert(std::move(elem));
+}
+
+template <typename K, typename V, typename Hash, typename Eq>
+void Insert(cache::FlatHashMap<K, V, Hash, Eq>& cont, std::pair<K, V>&& elem) {
+  cont.insert(std::move(elem));
+}
+
 template <typename T, typename Comp, typename Alloc>
 void Insert(std::set<T, Comp, Alloc>& cont, T&& elem) {
   cont.insert(std::forward<T>(elem));
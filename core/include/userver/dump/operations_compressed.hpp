@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
+#include <userver/dump/config.hpp>
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// @brief Compresses the data with zstd and writes it to another `Writer`.
+///
+/// The data is split into blocks of `CompressionConfig::block_size` bytes,
+/// that are compressed independently on the `task_processor`. Up to
+/// `CompressionConfig::parallelism` blocks are compressed simultaneously.
+class CompressedWriter final : public Writer {
+ public:
+  /// @throws `Error` on a write operation failure of the underlying writer
+  CompressedWriter(std::unique_ptr<Writer> writer,
+                   const CompressionConfig& config,
+                   engine::TaskProcessor& task_processor);
+
+  ~CompressedWriter() override;
+
+  void Finish() override;
+
+ private:
+  void WriteRaw(std::string_view data) override;
+
+  struct PendingBlock final {
+    std::uint64_t size;
+    engine::TaskWithResult<std::string> compressed;
+  };
+
+  void StartBlockCompression();
+  void WriteCompressedBlock();
+
+  std::unique_ptr<Writer> writer_;
+  const CompressionConfig config_;
+  engine::TaskProcessor& task_processor_;
+  std::string block_;
+  std::deque<PendingBlock> pending_blocks_;
+};
+
+/// @brief Reads the data written by `CompressedWriter` from another `Reader`.
+///
+/// Up to `CompressionConfig::parallelism` blocks ahead of the current one are
+/// decompressed simultaneously on the `task_processor`. The block size is
+/// taken from the dump, so the dumps remain readable after
+/// `CompressionConfig::block_size` changes.
+class CompressedReader final : public Reader {
+ public:
+  /// @throws `Error` if the data is not a compressed dump
+  CompressedReader(std::unique_ptr<Reader> reader,
+                   const CompressionConfig& config,
+                   engine::TaskProcessor& task_processor);
+
+  ~CompressedReader() override;
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  void StartBlockDecompressions();
+  bool NextBlock();
+
+  std::unique_ptr<Reader> reader_;
+  const CompressionConfig config_;
+  engine::TaskProcessor& task_processor_;
+  std::uint64_t max_block_size_{0};
+  bool blocks_ended_{false};
+  std::string block_;
+  std::size_t block_position_{0};
+  std::string curr_chunk_;
+  std::deque<engine::TaskWithResult<std::string>> pending_blocks_;
+};
+
+/// Wraps the readers and writers of another factory into `CompressedReader`
+/// and `CompressedWriter`
+class CompressedOperationsFactory final : public OperationsFactory {
+ public:
+  CompressedOperationsFactory(std::unique_ptr<OperationsFactory> factory,
+                              const CompressionConfig& config,
+                              engine::TaskProcessor& task_processor);
+
+  std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+  std::unique_ptr<Writer> CreateWriter(std::string full_path,
+                                       tracing::ScopeTime& scope) override;
+
+ private:
+  const std::unique_ptr<OperationsFactory> factory_;
+  const CompressionConfig config_;
+  engine::TaskProcessor& task_processor_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
+#include <string>
 
 #include <boost/filesystem/operations.hpp>
 
-#include <userver/fs/blocking/c_file.hpp>
+#include <userver/engine/io/file.hpp>
 #include <userver/utils/cpu_relax.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 
@@ -15,7 +17,10 @@ USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
-/// A handle to a dump file. File operations block the thread.
+/// @brief A handle to a dump file.
+///
+/// The data is buffered and is written through engine::io::File, which does
+/// not block the thread if io_uring is enabled.
 class FileWriter final : public Writer {
  public:
   /// @brief Creates a new dump file and opens it
@@ -28,14 +33,21 @@ class FileWriter final : public Writer {
  private:
   void WriteRaw(std::string_view data) override;
 
-  fs::blocking::CFile file_;
+  void FlushBuffer();
+
   std::string final_path_;
   std::string path_;
   boost::filesystem::perms perms_;
+  engine::io::File file_;
+  std::string buffer_;
+  std::uint64_t offset_{0};
   utils::StreamingCpuRelax cpu_relax_;
 };
 
-/// A handle to a dump file. File operations block the thread.
+/// @brief A handle to a dump file.
+///
+/// The data is read ahead in big chunks through engine::io::File, which does
+/// not block the thread if io_uring is enabled.
 class FileReader final : public Reader {
  public:
   /// @brief Opens an existing dump file
@@ -47,14 +59,50 @@ class FileReader final : public Reader {
  private:
   std::string_view ReadRaw(std::size_t max_size) override;
 
-  fs::blocking::CFile file_;
+  std::size_t GetBufferedSize() const noexcept;
+
+  std::string path_;
+  engine::io::File file_;
+  // buffer_[buffer_begin_, buffer_end_) is the data that has been read from
+  // the file, but has not been returned yet
+  std::string buffer_;
+  std::size_t buffer_begin_{0};
+  std::size_t buffer_end_{0};
+  std::uint64_t offset_{0};
+};
+
+/// @brief A handle to a dump file, that is memory-mapped for reading.
+///
+/// Reads do not copy the data into an intermediate buffer and do not perform
+/// a syscall, the file is paged in by the kernel on demand. The memory
+/// returned by `ReadRaw` stays valid until the reader is destroyed.
+class FileMmapReader final : public Reader {
+ public:
+  /// @brief Opens and maps an existing dump file
+  /// @throws `Error` on a filesystem error
+  explicit FileMmapReader(std::string path);
+
+  FileMmapReader(FileMmapReader&&) = delete;
+  FileMmapReader& operator=(FileMmapReader&&) = delete;
+  ~FileMmapReader() override;
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
   std::string path_;
-  std::string curr_chunk_;
+  const char* data_{nullptr};
+  std::size_t size_{0};
+  std::size_t position_{0};
 };
 
 class FileOperationsFactory final : public OperationsFactory {
  public:
-  explicit FileOperationsFactory(boost::filesystem::perms perms);
+  /// @param use_mmap_reader read dumps with FileMmapReader instead of
+  /// FileReader
+  explicit FileOperationsFactory(boost::filesystem::perms perms,
+                                 bool use_mmap_reader = false);
 
   std::unique_ptr<Reader> CreateReader(std::string full_path) override;
 
@@ -63,6 +111,7 @@ class FileOperationsFactory final : public OperationsFactory {
 
  private:
   const boost::filesystem::perms perms_;
+  const bool use_mmap_reader_;
 };
 
 }  // namespace dump
@@ -0,0 +1,62 @@
+#pragma once
+
+/// @file userver/dump/probabilistic_filters.hpp
+/// @brief Dump support for utils::BlockedBloomFilter and utils::CuckooFilter
+///
+/// The filters are restored with a default constructed hash, that should
+/// hash the elements the same way after a restart.
+///
+/// @ingroup userver_dump_read_write
+
+#include <stdexcept>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/utils/blocked_bloom_filter.hpp>
+#include <userver/utils/cuckoo_filter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// @brief utils::BlockedBloomFilter serialization support
+template <typename T, typename Hash>
+void Write(Writer& writer, const utils::BlockedBloomFilter<T, Hash>& filter) {
+  writer.Write(filter.GetSize());
+  writer.Write(filter.GetRawData());
+}
+
+/// @brief utils::BlockedBloomFilter deserialization support
+template <typename T, typename Hash>
+utils::BlockedBloomFilter<T, Hash> Read(
+    Reader& reader, To<utils::BlockedBloomFilter<T, Hash>>) {
+  const auto size = reader.Read<std::size_t>();
+  try {
+    return utils::BlockedBloomFilter<T, Hash>::FromRawData(
+        ReadStringViewUnsafe(reader), size);
+  } catch (const std::invalid_argument& ex) {
+    throw Error(ex.what());
+  }
+}
+
+/// @brief utils::CuckooFilter serialization support
+template <typename T, typename Hash>
+void Write(Writer& writer, const utils::CuckooFilter<T, Hash>& filter) {
+  writer.Write(filter.GetRawData());
+}
+
+/// @brief utils::CuckooFilter deserialization support
+template <typename T, typename Hash>
+utils::CuckooFilter<T, Hash> Read(Reader& reader,
+                                  To<utils::CuckooFilter<T, Hash>>) {
+  try {
+    return utils::CuckooFilter<T, Hash>::FromRawData(
+        ReadStringViewUnsafe(reader));
+  } catch (const std::invalid_argument& ex) {
+    throw Error(ex.what());
+  }
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
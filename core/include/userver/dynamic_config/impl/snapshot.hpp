@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <exception>
 #include <functional>
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <typeindex>
@@ -56,6 +57,11 @@ class SnapshotData final {
   SnapshotData(const SnapshotData& defaults,
                const std::vector<KeyValue>& overrides);
 
+  // Parses the configs of `docs_map`, the configs with the same docs in
+  // `previous_docs_map` are shared with `previous` instead of being reparsed
+  SnapshotData(const DocsMap& docs_map, const SnapshotData& previous,
+               const DocsMap& previous_docs_map);
+
   SnapshotData(SnapshotData&&) noexcept = default;
   SnapshotData& operator=(SnapshotData&&) noexcept = default;
 
@@ -68,12 +74,15 @@ class SnapshotData final {
     }
   }
 
+  // The value is shared with the other snapshots while the config is the same
+  const std::shared_ptr<const std::any>& GetShared(ConfigId id) const;
+
   bool IsEmpty() const noexcept;
 
  private:
   const std::any& DoGet(ConfigId id) const;
 
-  std::vector<std::any> user_configs_;
+  std::vector<std::shared_ptr<const std::any>> user_configs_;
 };
 
 class StorageData;
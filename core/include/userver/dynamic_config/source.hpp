@@ -3,6 +3,7 @@
 /// @file userver/dynamic_config/source.hpp
 /// @brief @copybrief dynamic_config::Source
 
+#include <any>
 #include <optional>
 #include <string_view>
 #include <tuple>
@@ -11,6 +12,7 @@
 #include <userver/concurrent/async_event_source.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/function_ref.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -97,10 +99,23 @@ class Source final {
     return VariableSnapshotPtr{GetSnapshot(), key};
   }
 
+  /// @brief Returns a copy of the current value of the config variable.
+  ///
+  /// Faster than GetSnapshot() for reading a single variable: the value is
+  /// cached per thread and is revalidated with a single atomic load, while the
+  /// config is not updated.
   template <typename VariableType>
   VariableType GetCopy(const Key<VariableType>& key) const {
-    const auto snapshot = GetSnapshot();
-    return snapshot[key];
+    std::optional<VariableType> result;
+    try {
+      ReadCached(impl::ConfigIdGetter::Get(key),
+                 [&result](const std::any& value) {
+                   result.emplace(std::any_cast<const VariableType&>(value));
+                 });
+    } catch (const std::exception& ex) {
+      impl::WrapGetError(ex, typeid(VariableType));
+    }
+    return std::move(*result);
   }
 
   /// Subscribes to dynamic-config updates using a member function. Also
@@ -213,6 +228,10 @@ class Source final {
   SnapshotEventSource& GetEventChannel();
 
  private:
+  // Calls `visitor` with the cached value, the value must not escape it
+  void ReadCached(impl::ConfigId id,
+                  utils::function_ref<void(const std::any&)> visitor) const;
+
   template <typename... Keys>
   static bool HasChanged(const Diff& diff, const Keys&... keys) {
     if (!diff.previous) return true;
@@ -223,7 +242,11 @@ class Source final {
     UASSERT(!current.GetData().IsEmpty());
     UASSERT(!previous.GetData().IsEmpty());
 
-    const bool is_equal = (true && ... && (previous[keys] == current[keys]));
+    // The unchanged configs are shared between the snapshots
+    const bool is_equal =
+        (true && ... &&
+         (&previous[keys] == &current[keys] ||
+          previous[keys] == current[keys]));
     return !is_equal;
   }
 
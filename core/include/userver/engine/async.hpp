@@ -20,6 +20,7 @@ template <template <typename> typename TaskType, typename Function,
           typename... Args>
 [[nodiscard]] auto MakeTaskWithResult(TaskProcessor& task_processor,
                                       Task::Importance importance,
+                                      Task::Priority priority,
                                       Deadline deadline, Function&& f,
                                       Args&&... args) {
   using ResultType =
@@ -27,7 +28,7 @@ template <template <typename> typename TaskType, typename Function,
   constexpr auto kWaitMode = TaskType<ResultType>::kWaitMode;
 
   return TaskType<ResultType>{
-      MakeTask({task_processor, importance, kWaitMode, deadline},
+      MakeTask({task_processor, importance, kWaitMode, deadline, priority},
                std::forward<Function>(f), std::forward<Args>(args)...)};
 }
 
@@ -38,8 +39,8 @@ template <typename Function, typename... Args>
 [[nodiscard]] auto AsyncNoSpan(TaskProcessor& task_processor, Function&& f,
                                Args&&... args) {
   return impl::MakeTaskWithResult<TaskWithResult>(
-      task_processor, Task::Importance::kNormal, {}, std::forward<Function>(f),
-      std::forward<Args>(args)...);
+      task_processor, Task::Importance::kNormal, Task::Priority::kNormal, {},
+      std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
 /// Runs an asynchronous function call using specified task processor
@@ -47,8 +48,8 @@ template <typename Function, typename... Args>
 [[nodiscard]] auto SharedAsyncNoSpan(TaskProcessor& task_processor,
                                      Function&& f, Args&&... args) {
   return impl::MakeTaskWithResult<SharedTaskWithResult>(
-      task_processor, Task::Importance::kNormal, {}, std::forward<Function>(f),
-      std::forward<Args>(args)...);
+      task_processor, Task::Importance::kNormal, Task::Priority::kNormal, {},
+      std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
 /// Runs an asynchronous function call with deadline using specified task
@@ -57,8 +58,8 @@ template <typename Function, typename... Args>
 [[nodiscard]] auto AsyncNoSpan(TaskProcessor& task_processor, Deadline deadline,
                                Function&& f, Args&&... args) {
   return impl::MakeTaskWithResult<TaskWithResult>(
-      task_processor, Task::Importance::kNormal, deadline,
-      std::forward<Function>(f), std::forward<Args>(args)...);
+      task_processor, Task::Importance::kNormal, Task::Priority::kNormal,
+      deadline, std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
 /// Runs an asynchronous function call with deadline using specified task
@@ -68,7 +69,18 @@ template <typename Function, typename... Args>
                                      Deadline deadline, Function&& f,
                                      Args&&... args) {
   return impl::MakeTaskWithResult<SharedTaskWithResult>(
-      task_processor, Task::Importance::kNormal, deadline,
+      task_processor, Task::Importance::kNormal, Task::Priority::kNormal,
+      deadline, std::forward<Function>(f), std::forward<Args>(args)...);
+}
+
+/// Runs an asynchronous function call with the specified priority using
+/// specified task processor
+template <typename Function, typename... Args>
+[[nodiscard]] auto AsyncNoSpan(TaskProcessor& task_processor,
+                               Task::Priority priority, Function&& f,
+                               Args&&... args) {
+  return impl::MakeTaskWithResult<TaskWithResult>(
+      task_processor, Task::Importance::kNormal, priority, {},
       std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
@@ -96,6 +108,15 @@ template <typename Function, typename... Args>
                      std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
+/// Runs an asynchronous function call with the specified priority using task
+/// processor of the caller
+template <typename Function, typename... Args>
+[[nodiscard]] auto AsyncNoSpan(Task::Priority priority, Function&& f,
+                               Args&&... args) {
+  return AsyncNoSpan(current_task::GetTaskProcessor(), priority,
+                     std::forward<Function>(f), std::forward<Args>(args)...);
+}
+
 /// Runs an asynchronous function call with deadline using task processor of the
 /// caller
 template <typename Function, typename... Args>
@@ -113,7 +134,7 @@ template <typename Function, typename... Args>
 [[nodiscard]] auto CriticalAsyncNoSpan(TaskProcessor& task_processor,
                                        Function&& f, Args&&... args) {
   return impl::MakeTaskWithResult<TaskWithResult>(
-      task_processor, Task::Importance::kCritical, {},
+      task_processor, Task::Importance::kCritical, Task::Priority::kNormal, {},
       std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
@@ -124,7 +145,7 @@ template <typename Function, typename... Args>
 [[nodiscard]] auto SharedCriticalAsyncNoSpan(TaskProcessor& task_processor,
                                              Function&& f, Args&&... args) {
   return impl::MakeTaskWithResult<SharedTaskWithResult>(
-      task_processor, Task::Importance::kCritical, {},
+      task_processor, Task::Importance::kCritical, Task::Priority::kNormal, {},
       std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
@@ -155,8 +176,9 @@ template <typename Function, typename... Args>
 [[nodiscard]] auto CriticalAsyncNoSpan(Deadline deadline, Function&& f,
                                        Args&&... args) {
   return impl::MakeTaskWithResult<TaskWithResult>(
-      current_task::GetTaskProcessor(), Task::Importance::kCritical, deadline,
-      std::forward<Function>(f), std::forward<Args>(args)...);
+      current_task::GetTaskProcessor(), Task::Importance::kCritical,
+      Task::Priority::kNormal, deadline, std::forward<Function>(f),
+      std::forward<Args>(args)...);
 }
 
 }  // namespace engine
@@ -0,0 +1,95 @@
+#pragma once
+
+/// @file userver/engine/io/buffered_socket.hpp
+/// @brief @copybrief engine::io::BufferedSocket
+
+#include <cstddef>
+#include <string_view>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/io/common.hpp>
+#include <userver/utils/fast_pimpl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+namespace impl {
+
+class ReadBuffer;
+
+}  // namespace impl
+
+/// @brief Buffered reads for the protocol parsers that work in place
+///
+/// The received data stays in the buffer until it is consumed, so a parser
+/// may take any prefix of it and leave the rest for the next read. The
+/// unconsumed data is always contiguous: it is moved to the beginning of the
+/// buffer when the free space runs out, and the buffer grows if it is full.
+///
+/// The backing buffer is borrowed from a thread-local pool and is returned
+/// to it while the socket is waited for with no unconsumed data, so idle
+/// connections do not hold one.
+///
+/// @note Does not own the source, the source must outlive the BufferedSocket
+/// @note Not thread safe
+class BufferedSocket final {
+ public:
+  static constexpr std::size_t kDefaultBufferSize = 32 * 1024;
+
+  explicit BufferedSocket(ReadableBase& source,
+                          std::size_t buffer_size = kDefaultBufferSize);
+  ~BufferedSocket();
+
+  BufferedSocket(BufferedSocket&&) noexcept;
+  BufferedSocket& operator=(BufferedSocket&&) noexcept;
+
+  /// Whether the underlying source is valid.
+  bool IsValid() const;
+
+  /// @brief The received data that was not consumed yet
+  /// @note The view is invalidated by the reads and by Consume
+  std::string_view GetReadable() const noexcept;
+
+  /// Marks `size` leading bytes of GetReadable() as processed
+  void Consume(std::size_t size) noexcept;
+
+  /// Returns the buffer to the pool if all the received data is consumed,
+  /// the next read borrows a new one
+  void ReleaseBuffer() noexcept;
+
+  /// @returns the size of the currently held buffer, 0 if it is released
+  std::size_t GetBufferSize() const noexcept;
+
+  /// @brief Suspends current task until the source has data available
+  ///
+  /// If the previous read filled the whole free space of the buffer, there is
+  /// most probably more data to read, and true is returned right away. A read
+  /// would otherwise hit EWOULDBLOCK and wait for the source anyway, so the
+  /// wait saves a syscall.
+  [[nodiscard]] bool WaitReadable(Deadline deadline);
+
+  /// @brief Receives at least one byte from the source into the buffer
+  /// @returns the number of bytes received, 0 if the source is closed
+  [[nodiscard]] std::size_t ReadSome(Deadline deadline);
+
+  /// @brief Receives data until at least `size` bytes are unconsumed, the
+  /// buffer grows to hold them
+  /// @returns the size of GetReadable(), which is less than `size` only if
+  /// the source is closed
+  [[nodiscard]] std::size_t ReadAtLeast(std::size_t size, Deadline deadline);
+
+ private:
+  void PrepareWrite(std::size_t min_free_size);
+
+  ReadableBase* source_;
+  std::size_t buffer_size_;
+  std::size_t begin_{0};
+  std::size_t end_{0};
+  bool is_last_read_full_{false};
+  utils::FastPimpl<impl::ReadBuffer, 24, alignof(void*), utils::kStrictMatch>
+      buffer_;
+};
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
@@ -67,6 +67,19 @@ class WritableBase {
     }
     return result;
   }
+
+  /// @brief Sends exactly list_size IoData, with a single vectored write if
+  /// the stream supports it.
+  /// @note Can return less than the total size if stream is closed by peer.
+  [[nodiscard]] virtual size_t WriteAll(const IoData* list,
+                                        std::size_t list_size,
+                                        Deadline deadline) {
+    size_t result{0};
+    for (std::size_t i = 0; i < list_size; ++i) {
+      result += WriteAll(list[i].data, list[i].len, deadline);
+    }
+    return result;
+  }
 };
 
 /// @ingroup userver_base_classes
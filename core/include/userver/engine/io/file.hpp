@@ -0,0 +1,118 @@
+#pragma once
+
+/// @file userver/engine/io/file.hpp
+/// @brief @copybrief engine::io::File
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/fs/blocking/open_mode.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+
+class File;
+
+/// @brief Opens the files, with a single io_uring submission or a single
+/// `fs_task_processor` round trip for all of them
+/// @throws std::system_error on the first failure, the files opened by then
+/// are closed
+std::vector<File> OpenFiles(
+    engine::TaskProcessor* fs_task_processor,
+    const std::vector<std::string>& paths, fs::blocking::OpenMode flags,
+    boost::filesystem::perms perms = boost::filesystem::perms::owner_read |
+                                     boost::filesystem::perms::owner_write);
+
+/// @brief A regular file with positional reads and writes that do not block
+/// the task processor threads
+///
+/// The operations go through the io_uring of the coroutine engine if it is
+/// enabled and is available. Otherwise they are performed in the
+/// `fs_task_processor`. The operations block the current thread if
+/// `fs_task_processor` is nullptr, if the current task is already running in
+/// it, or outside of the coroutines.
+///
+/// The operations are not cancellable.
+/// @note The operations on the file are not thread-safe
+class File final {
+ public:
+  /// @brief Opens the file
+  /// @throws std::system_error
+  static File Open(
+      engine::TaskProcessor* fs_task_processor, const std::string& path,
+      fs::blocking::OpenMode flags,
+      boost::filesystem::perms perms = boost::filesystem::perms::owner_read |
+                                       boost::filesystem::perms::owner_write);
+
+  /// @brief Checks if the file is open
+  bool IsOpen() const;
+
+  /// Returns the native file handle
+  int GetNative() const;
+
+  /// @brief Reads the data starting at `offset`
+  /// @returns The amount of bytes actually read, which is equal to `max_size`,
+  /// or less on end-of-file
+  /// @throws std::system_error
+  std::size_t ReadAt(char* buffer, std::size_t max_size, std::uint64_t offset);
+
+  /// @brief Writes all the data starting at `offset`
+  /// @warning Unless `Fsync` is called, there is no guarantee the data
+  /// is stored on disk safely.
+  /// @throws std::system_error
+  void WriteAt(std::string_view data, std::uint64_t offset);
+
+  /// @brief Makes sure the written data is actually stored on disk
+  /// @throws std::system_error
+  void Fsync();
+
+  /// @brief Fetches the file size
+  /// @throws std::system_error
+  std::uint64_t GetSize() const;
+
+  /// @brief Closes the file manually, otherwise it is closed in the destructor
+  /// with a blocking call
+  /// @throws std::system_error
+  void Close() &&;
+
+ private:
+  File(engine::TaskProcessor* fs_task_processor,
+       fs::blocking::FileDescriptor fd) noexcept;
+
+  friend std::vector<File> OpenFiles(engine::TaskProcessor*,
+                                     const std::vector<std::string>&,
+                                     fs::blocking::OpenMode,
+                                     boost::filesystem::perms);
+
+  engine::TaskProcessor* fs_task_processor_;
+  fs::blocking::FileDescriptor fd_;
+};
+
+struct FileStatus final {
+  bool exists{false};
+  bool is_regular_file{false};
+  std::uint64_t size{0};
+};
+
+/// @brief Fetches the status of the files, the symlinks are followed. Batched
+/// in the same way as OpenFiles.
+/// @throws std::system_error on a failure other than a missing file
+std::vector<FileStatus> StatFiles(engine::TaskProcessor* fs_task_processor,
+                                  const std::vector<std::string>& paths);
+
+/// @brief Reads the whole files, the files are opened with OpenFiles
+/// @throws std::system_error
+std::vector<std::string> ReadFilesContents(
+    engine::TaskProcessor* fs_task_processor,
+    const std::vector<std::string>& paths);
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
@@ -79,6 +79,13 @@ class [[nodiscard]] Socket final : public RwBase {
   /// received any more, received bytes count otherwise.
   [[nodiscard]] size_t RecvSome(void* buf, size_t len, Deadline deadline);
 
+  /// @brief Receives at least one byte from the socket into a buffer vector,
+  /// filling the buffers in order.
+  /// @returns 0 if connection is closed on one side and no data could be
+  /// received any more, received bytes count otherwise.
+  [[nodiscard]] size_t RecvSome(struct iovec* list, std::size_t list_size,
+                                Deadline deadline);
+
   /// @brief Receives exactly len bytes from the socket.
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t RecvAll(void* buf, size_t len, Deadline deadline);
@@ -99,6 +106,11 @@ class [[nodiscard]] Socket final : public RwBase {
   [[nodiscard]] size_t SendAll(const IoData* list, std::size_t list_size,
                                Deadline deadline);
 
+  [[nodiscard]] size_t WriteAll(const IoData* list, std::size_t list_size,
+                                Deadline deadline) override {
+    return SendAll(list, list_size, deadline);
+  }
+
   /// @brief Sends exactly list_size iovec to the socket.
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t SendAll(const struct iovec* list, std::size_t list_size,
@@ -17,6 +17,29 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
 
+/// Options of the TLS connections of TlsWrapper
+struct TlsSettings final {
+  /// @brief Hand the symmetric encryption of the established connection over
+  /// to the kernel (kTLS)
+  ///
+  /// The records are then encrypted by the kernel, the data is sent and
+  /// received without copies between the OpenSSL buffers. The connection
+  /// stays in userspace TLS if the OpenSSL (3.0+), the kernel (`tls` module)
+  /// or the negotiated cipher do not support it.
+  ///
+  /// @warning The writes to the socket may raise SIGPIPE, it is ignored by
+  /// components::Run.
+  bool enable_ktls{false};
+
+  /// @brief Resume the TLS sessions to skip the key exchange on reconnects
+  ///
+  /// The server issues session tickets, the keys of the tickets are shared by
+  /// all the servers of the process and are rotated hourly. The client reuses
+  /// the session of the previous connection to the same server name and
+  /// address.
+  bool enable_session_resumption{true};
+};
+
 /// Class for TLS communications over a Socket.
 ///
 /// Not thread safe.
@@ -28,13 +51,15 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
   /// Starts a TLS client on an opened socket
   static TlsWrapper StartTlsClient(Socket&& socket,
                                    const std::string& server_name,
-                                   Deadline deadline);
+                                   Deadline deadline,
+                                   const TlsSettings& settings = {});
 
   /// Starts a TLS server on an opened socket
   static TlsWrapper StartTlsServer(
       Socket&& socket, const crypto::Certificate& cert,
       const crypto::PrivateKey& key, Deadline deadline,
-      const std::vector<crypto::Certificate>& cert_authorities = {});
+      const std::vector<crypto::Certificate>& cert_authorities = {},
+      const TlsSettings& settings = {});
 
   ~TlsWrapper() override;
 
@@ -47,6 +72,12 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
   /// Whether the socket is valid.
   bool IsValid() const override;
 
+  /// Whether the records are encrypted and decrypted by the kernel.
+  bool IsKernelTlsEnabled() const;
+
+  /// Whether the handshake has resumed a previous session.
+  bool IsSessionReused() const;
+
   /// Suspends current task until the socket has data available.
   [[nodiscard]] bool WaitReadable(Deadline) override;
 
@@ -69,6 +100,8 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
   /// @brief Finishes TLS session and returns the socket.
   /// @warning Wrapper becomes invalid on entry and can only be used to retry
   ///   socket extraction if interrupted.
+  /// @note The returned socket is closed if IsKernelTlsEnabled(), the kernel
+  ///   does not switch the socket back to plaintext.
   [[nodiscard]] Socket StopTls(Deadline deadline);
 
   /// @brief Receives at least one byte from the socket.
@@ -99,7 +132,7 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
   explicit TlsWrapper(Socket&&);
 
   class Impl;
-  constexpr static size_t kSize = 296;
+  constexpr static size_t kSize = 320;
   constexpr static size_t kAlignment = 8;
   utils::FastPimpl<Impl, kSize, kAlignment> impl_;
 };
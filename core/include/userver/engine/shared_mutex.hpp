@@ -6,11 +6,16 @@
 #include <userver/engine/condition_variable.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/semaphore.hpp>
+#include <userver/utils/fast_pimpl.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine {
 
+namespace impl {
+class AdaptiveSpin;
+}  // namespace impl
+
 /// @ingroup userver_concurrency
 ///
 /// @brief std::shared_mutex replacement for asynchronous tasks.
@@ -21,6 +26,9 @@ namespace engine {
 /// thus new shared lock waits for the pending writes to finish, which in turn
 /// waits for existing existing shared locks to unlock first.
 ///
+/// Short contention is waited out by a bounded self-tuning spin-wait before
+/// putting the current coroutine to sleep.
+///
 /// ## Example usage:
 ///
 /// @snippet engine/shared_mutex_test.cpp  Sample engine::SharedMutex usage
@@ -29,7 +37,7 @@ namespace engine {
 class SharedMutex final {
  public:
   SharedMutex();
-  ~SharedMutex() = default;
+  ~SharedMutex();
 
   SharedMutex(const SharedMutex&) = delete;
   SharedMutex(SharedMutex&&) = delete;
@@ -136,6 +144,9 @@ class SharedMutex final {
   std::atomic_size_t waiting_writers_count_;
   Mutex waiting_writers_count_mutex_;
   ConditionVariable waiting_writers_count_cv_;
+
+  utils::FastPimpl<impl::AdaptiveSpin, 4, 4> writers_spin_;
+  utils::FastPimpl<impl::AdaptiveSpin, 4, 4> readers_spin_;
 };
 
 template <typename Rep, typename Period>
@@ -15,6 +15,17 @@ namespace engine {
 /// other tasks to execute
 void Yield();
 
+/// Default time budget of engine::CooperativeYieldPoint
+inline constexpr std::chrono::milliseconds kCooperativeYieldBudget{1};
+
+/// @brief Calls engine::Yield if the current task has been running without a
+/// context switch for longer than `budget`, otherwise does nothing.
+///
+/// Is cheap enough to be called on each iteration of a CPU-bound loop, so that
+/// the loop does not hold a worker thread of the task processor for too long.
+void CooperativeYieldPoint(
+    std::chrono::microseconds budget = kCooperativeYieldBudget);
+
 /// @cond
 /// Recursion stoppers/specializations
 void InterruptibleSleepUntil(Deadline);
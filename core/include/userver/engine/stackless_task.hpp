@@ -0,0 +1,432 @@
+#pragma once
+
+/// @file userver/engine/stackless_task.hpp
+/// @brief @copybrief engine::stackless::Task
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && \
+    __has_include(<coroutine>)
+#define USERVER_IMPL_HAS_STACKLESS_TASKS 1
+#endif
+
+#if defined(USERVER_IMPL_HAS_STACKLESS_TASKS) || defined(DOXYGEN)
+
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/future_status.hpp>
+#include <userver/engine/impl/context_accessor.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// @brief Lightweight C++20 stackless coroutines that run inside a regular
+/// (stackful) engine task.
+///
+/// A stackless::Task costs a heap-allocated coroutine frame instead of a
+/// coroutine stack from the pool, which makes it suitable for massive
+/// fan-outs of short-lived subtasks.
+///
+/// Only available when compiled with C++20 coroutines support.
+namespace engine::stackless {
+
+template <typename T = void>
+class Task;
+
+namespace impl {
+
+enum class WaitResult { kReady, kTimeout, kCancelled };
+
+/// Runs the stackless coroutines of a single stackful task. Suspended
+/// coroutines are resumed once the awaited futures or tasks become ready,
+/// their deadlines are reached or the stackful task is cancelled.
+class Scheduler final {
+ public:
+  Scheduler() = default;
+  Scheduler(const Scheduler&) = delete;
+  Scheduler& operator=(const Scheduler&) = delete;
+
+  void Schedule(std::coroutine_handle<> handle);
+
+  /// `target` may be nullptr for a plain sleep until `deadline`
+  void Wait(engine::impl::ContextAccessor* target, Deadline deadline,
+            std::coroutine_handle<> handle, WaitResult& result);
+
+  /// Runs until `roots_count` root coroutines complete
+  void Run(std::size_t roots_count);
+
+  void OnRootFinished() noexcept;
+
+ private:
+  struct Waiter {
+    engine::impl::ContextAccessor* target;
+    Deadline deadline;
+    std::coroutine_handle<> handle;
+    WaitResult* result;
+  };
+
+  void WaitForAny();
+
+  std::deque<std::coroutine_handle<>> ready_;
+  std::vector<Waiter> waiters_;
+  std::vector<engine::impl::ContextAccessor*> targets_;
+  std::size_t unfinished_roots_{0};
+};
+
+[[noreturn]] void ThrowWaitInterrupted();
+
+struct FutureGetter {
+  template <typename Future>
+  static decltype(auto) Get(Future& future) {
+    return future.get();
+  }
+};
+
+struct TaskGetter {
+  template <typename Task>
+  static decltype(auto) Get(Task& task) {
+    return task.Get();
+  }
+};
+
+template <typename Awaitable, typename Getter>
+class GetAwaiter final {
+ public:
+  GetAwaiter(Scheduler& scheduler, Awaitable& awaitable) noexcept
+      : scheduler_(scheduler), awaitable_(awaitable) {}
+
+  bool await_ready() {
+    auto* target = awaitable_.TryGetContextAccessor();
+    UINVARIANT(target, "Awaiting an invalid future or task");
+    return target->IsReady();
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    scheduler_.Wait(awaitable_.TryGetContextAccessor(), Deadline{}, handle,
+                    result_);
+  }
+
+  decltype(auto) await_resume() {
+    if (result_ == WaitResult::kCancelled) ThrowWaitInterrupted();
+    return Getter::Get(awaitable_);
+  }
+
+ private:
+  Scheduler& scheduler_;
+  Awaitable& awaitable_;
+  WaitResult result_{WaitResult::kReady};
+};
+
+template <typename Awaitable>
+struct WaitUntilAwaitable {
+  Awaitable& awaitable;
+  Deadline deadline;
+};
+
+struct SleepAwaitable {
+  Deadline deadline;
+};
+
+class WaitAwaiter final {
+ public:
+  WaitAwaiter(Scheduler& scheduler, engine::impl::ContextAccessor* target,
+              Deadline deadline) noexcept
+      : scheduler_(scheduler), target_(target), deadline_(deadline) {}
+
+  bool await_ready() const noexcept {
+    return (target_ && target_->IsReady()) || deadline_.IsReached();
+  }
+
+  void await_suspend(std::coroutine_handle<> handle) {
+    scheduler_.Wait(target_, deadline_, handle, result_);
+  }
+
+  FutureStatus await_resume() const noexcept {
+    if (target_ && target_->IsReady()) return FutureStatus::kReady;
+    if (result_ == WaitResult::kCancelled) return FutureStatus::kCancelled;
+    return FutureStatus::kTimeout;
+  }
+
+ private:
+  Scheduler& scheduler_;
+  engine::impl::ContextAccessor* const target_;
+  const Deadline deadline_;
+  WaitResult result_{WaitResult::kTimeout};
+};
+
+class PromiseBase {
+ private:
+  struct FinalAwaiter {
+    bool await_ready() const noexcept { return false; }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(
+        std::coroutine_handle<Promise> handle) noexcept {
+      PromiseBase& promise = handle.promise();
+      if (promise.continuation_) return promise.continuation_;
+      promise.GetScheduler().OnRootFinished();
+      return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+ public:
+  std::suspend_always initial_suspend() noexcept { return {}; }
+
+  auto final_suspend() noexcept { return FinalAwaiter{}; }
+
+  void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+  template <typename T>
+  auto await_transform(engine::Future<T>& future) {
+    return GetAwaiter<engine::Future<T>, FutureGetter>{GetScheduler(), future};
+  }
+
+  template <typename T>
+  auto await_transform(engine::TaskWithResult<T>& task) {
+    return GetAwaiter<engine::TaskWithResult<T>, TaskGetter>{GetScheduler(),
+                                                             task};
+  }
+
+  template <typename Awaitable>
+  WaitAwaiter await_transform(WaitUntilAwaitable<Awaitable> wait) {
+    return {GetScheduler(), wait.awaitable.TryGetContextAccessor(),
+            wait.deadline};
+  }
+
+  WaitAwaiter await_transform(SleepAwaitable sleep) {
+    return {GetScheduler(), nullptr, sleep.deadline};
+  }
+
+  template <typename T>
+  auto await_transform(Task<T>&& task) noexcept;
+
+  void SetScheduler(Scheduler& scheduler) noexcept { scheduler_ = &scheduler; }
+
+  Scheduler& GetScheduler() const noexcept {
+    UASSERT(scheduler_);
+    return *scheduler_;
+  }
+
+  void SetContinuation(std::coroutine_handle<> continuation) noexcept {
+    continuation_ = continuation;
+  }
+
+ protected:
+  void RethrowIfFailed() const {
+    if (exception_) std::rethrow_exception(exception_);
+  }
+
+ private:
+  Scheduler* scheduler_{nullptr};
+  std::coroutine_handle<> continuation_;
+  std::exception_ptr exception_;
+};
+
+template <typename T>
+class Promise final : public PromiseBase {
+ public:
+  Task<T> get_return_object() noexcept;
+
+  template <typename U = T>
+  void return_value(U&& value) {
+    value_.emplace(std::forward<U>(value));
+  }
+
+  T GetResult() {
+    RethrowIfFailed();
+    UASSERT(value_);
+    return std::move(*value_);
+  }
+
+ private:
+  std::optional<T> value_;
+};
+
+template <>
+class Promise<void> final : public PromiseBase {
+ public:
+  Task<void> get_return_object() noexcept;
+
+  void return_void() noexcept {}
+
+  void GetResult() { RethrowIfFailed(); }
+};
+
+struct TaskAccessor {
+  template <typename T>
+  static std::coroutine_handle<Promise<T>> GetHandle(Task<T>& task) noexcept {
+    UASSERT_MSG(task.handle_, "Using an invalid stackless::Task");
+    return task.handle_;
+  }
+};
+
+template <typename T>
+class ChildAwaiter final {
+ public:
+  explicit ChildAwaiter(Task<T>&& task) noexcept : task_(std::move(task)) {}
+
+  bool await_ready() const noexcept { return false; }
+
+  template <typename ParentPromise>
+  std::coroutine_handle<> await_suspend(
+      std::coroutine_handle<ParentPromise> parent) noexcept {
+    auto handle = TaskAccessor::GetHandle(task_);
+    handle.promise().SetScheduler(parent.promise().GetScheduler());
+    handle.promise().SetContinuation(parent);
+    return handle;
+  }
+
+  T await_resume() { return TaskAccessor::GetHandle(task_).promise().GetResult(); }
+
+ private:
+  Task<T> task_;
+};
+
+template <typename T>
+auto PromiseBase::await_transform(Task<T>&& task) noexcept {
+  return ChildAwaiter<T>{std::move(task)};
+}
+
+}  // namespace impl
+
+/// @ingroup userver_concurrency
+///
+/// @brief A lazily started C++20 coroutine that runs inside a stackful
+/// engine task, see stackless::Run and stackless::RunAll.
+///
+/// Inside the coroutine the following may be `co_await`-ed:
+/// * engine::Future<T>& and engine::TaskWithResult<T>& - returns the result
+///   of `get()`/`Get()`, throws engine::WaitInterruptedException if the
+///   stackful task is cancelled before the result is ready;
+/// * another stackless::Task<U> - runs it inline and returns its result;
+/// * stackless::WaitUntil - returns engine::FutureStatus;
+/// * stackless::SleepUntil and stackless::SleepFor - return early on
+///   cancellation, same as engine::InterruptibleSleepUntil.
+///
+/// Suspension points are cooperative: a coroutine that does not `co_await`
+/// blocks the other stackless coroutines of the same stackful task.
+template <typename T>
+class [[nodiscard]] Task final {
+ public:
+  using promise_type = impl::Promise<T>;
+
+  Task() noexcept = default;
+
+  Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+
+  Task& operator=(Task&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      handle_ = std::exchange(other.handle_, {});
+    }
+    return *this;
+  }
+
+  ~Task() { Reset(); }
+
+  bool IsValid() const noexcept { return static_cast<bool>(handle_); }
+
+ private:
+  friend class impl::Promise<T>;
+  friend struct impl::TaskAccessor;
+
+  explicit Task(std::coroutine_handle<promise_type> handle) noexcept
+      : handle_(handle) {}
+
+  void Reset() noexcept {
+    if (handle_) std::exchange(handle_, {}).destroy();
+  }
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+/// @brief Waits for `awaitable` (engine::Future or engine::TaskWithResult)
+/// without retrieving its result: `co_await stackless::WaitUntil(f, d)`
+template <typename Awaitable>
+impl::WaitUntilAwaitable<Awaitable> WaitUntil(Awaitable& awaitable,
+                                              Deadline deadline) noexcept {
+  return {awaitable, deadline};
+}
+
+/// @brief Suspends the coroutine: `co_await stackless::SleepUntil(d)`
+inline impl::SleepAwaitable SleepUntil(Deadline deadline) noexcept {
+  return {deadline};
+}
+
+/// @brief Suspends the coroutine: `co_await stackless::SleepFor(10ms)`
+template <typename Rep, typename Period>
+impl::SleepAwaitable SleepFor(
+    const std::chrono::duration<Rep, Period>& duration) noexcept {
+  return {Deadline::FromDuration(duration)};
+}
+
+/// @brief Runs all the `tasks` concurrently inside the current stackful task
+/// and waits for their completion.
+///
+/// @returns `std::vector<T>` of results in the order of `tasks` or `void`
+/// @throws std::exception rethrows the exception of the first failed task in
+/// the order of `tasks`, after all the tasks complete
+template <typename T>
+auto RunAll(std::vector<Task<T>> tasks) {
+  impl::Scheduler scheduler;
+  for (auto& task : tasks) {
+    auto handle = impl::TaskAccessor::GetHandle(task);
+    handle.promise().SetScheduler(scheduler);
+    scheduler.Schedule(handle);
+  }
+  scheduler.Run(tasks.size());
+
+  if constexpr (std::is_void_v<T>) {
+    for (auto& task : tasks) {
+      impl::TaskAccessor::GetHandle(task).promise().GetResult();
+    }
+  } else {
+    std::vector<T> results;
+    results.reserve(tasks.size());
+    for (auto& task : tasks) {
+      results.push_back(impl::TaskAccessor::GetHandle(task).promise().GetResult());
+    }
+    return results;
+  }
+}
+
+/// @brief Runs the `task` inside the current stackful task and returns its
+/// result.
+template <typename T>
+T Run(Task<T> task) {
+  std::vector<Task<T>> tasks;
+  tasks.push_back(std::move(task));
+  if constexpr (std::is_void_v<T>) {
+    stackless::RunAll(std::move(tasks));
+  } else {
+    return std::move(stackless::RunAll(std::move(tasks)).front());
+  }
+}
+
+namespace impl {
+
+template <typename T>
+Task<T> Promise<T>::get_return_object() noexcept {
+  return Task<T>{std::coroutine_handle<Promise<T>>::from_promise(*this)};
+}
+
+inline Task<void> Promise<void>::get_return_object() noexcept {
+  return Task<void>{std::coroutine_handle<Promise<void>>::from_promise(*this)};
+}
+
+}  // namespace impl
+
+}  // namespace engine::stackless
+
+USERVER_NAMESPACE_END
+
+#endif
@@ -3,6 +3,7 @@
 /// @file userver/engine/subprocess/process_starter.hpp
 /// @brief @copybrief engine::subprocess::ProcessStarter
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -11,6 +12,7 @@
 #include <userver/engine/subprocess/child_process.hpp>
 #include <userver/engine/subprocess/environment_variables.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -22,13 +24,41 @@ class ThreadControl;
 
 namespace subprocess {
 
+namespace impl {
+class Zygote;
+struct ProcessStarterStatistics;
+}  // namespace impl
+
+/// Settings of engine::subprocess::ProcessStarter
+struct ProcessStarterSettings final {
+  /// @brief Start the processes from a small helper process (zygote) that is
+  /// forked on the ProcessStarter construction, while the current process is
+  /// small
+  ///
+  /// By default the processes are started with posix_spawn(), which does not
+  /// copy the page tables of the current process either. The zygote is for
+  /// the services that start many processes: the memory mappings of the
+  /// current process are not touched at all, and the started processes
+  /// inherit only the standard streams instead of all the non-CLOEXEC
+  /// descriptors. The started processes are reparented to the current
+  /// process, which becomes a child subreaper. Linux only, ignored on other
+  /// platforms.
+  bool use_zygote{false};
+};
+
 /// @ingroup userver_clients
 ///
 /// @brief Creates a new OS subprocess and executes a command in it.
+///
+/// Exec() throws std::system_error if the process could not be started, for
+/// example if the command does not exist.
 class ProcessStarter {
  public:
   explicit ProcessStarter(TaskProcessor& task_processor);
 
+  ProcessStarter(TaskProcessor& task_processor,
+                 const ProcessStarterSettings& settings);
+
   /// `env` redefines all environment variables.
   ChildProcess Exec(
       const std::string& command, const std::vector<std::string>& args,
@@ -54,9 +84,19 @@ class ProcessStarter {
       const std::optional<std::string>& stderr_file = std::nullopt);
 
  private:
+  friend void DumpMetric(utils::statistics::Writer& writer,
+                         const ProcessStarter& process_starter);
+
   ev::ThreadControl& thread_control_;
+  std::shared_ptr<impl::Zygote> zygote_;
+  std::shared_ptr<impl::ProcessStarterStatistics> stats_;
 };
 
+/// Writes the count of the started processes, of the failures and the
+/// starting timings in microseconds
+void DumpMetric(utils::statistics::Writer& writer,
+                const ProcessStarter& process_starter);
+
 }  // namespace subprocess
 }  // namespace engine
 
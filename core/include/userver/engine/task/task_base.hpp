@@ -28,6 +28,7 @@ namespace impl {
 class TaskContextHolder;
 class TaskContext;
 class DetachedTasksSyncBlock;
+class TaskSetImpl;
 class ContextAccessor;
 }  // namespace impl
 
@@ -48,6 +49,20 @@ class [[nodiscard]] TaskBase {
     kCritical,
   };
 
+  /// Task priority. Task processors with the 'global-task-queue' start the
+  /// queued tasks with higher priority first, lower priorities are slowed down
+  /// but never starved.
+  enum class Priority {
+    /// Latency critical task, e.g. a health check handler
+    kHigh,
+
+    /// Normal task
+    kNormal,
+
+    /// Background task, e.g. a cache update
+    kLow,
+  };
+
   /// Task state
   enum class State {
     kInvalid,    ///< Unusable
@@ -162,6 +177,7 @@ class [[nodiscard]] TaskBase {
 
  private:
   friend class impl::DetachedTasksSyncBlock;
+  friend class impl::TaskSetImpl;
   friend class TaskCancellationToken;
 
   boost::intrusive_ptr<impl::TaskContext> context_;
@@ -0,0 +1,118 @@
+#pragma once
+
+/// @file userver/engine/task_set.hpp
+/// @brief @copybrief engine::TaskSet
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <optional>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+
+class TaskSetImpl final {
+ public:
+  TaskSetImpl();
+
+  TaskSetImpl(TaskSetImpl&&) = delete;
+  TaskSetImpl& operator=(TaskSetImpl&&) = delete;
+
+  ~TaskSetImpl();
+
+  std::size_t Add(TaskBase& task);
+
+  std::optional<std::size_t> NextReady(Deadline deadline);
+
+  std::size_t GetPendingCount() const noexcept;
+
+ private:
+  struct Impl;
+
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace impl
+
+/// @ingroup userver_concurrency
+///
+/// @brief A set of tasks that are retrieved in the order of their completion.
+///
+/// engine::WaitAny registers the waiter in each of the remaining tasks every
+/// time it is called, so waiting for N tasks one by one takes O(N^2). The
+/// tasks of a TaskSet put themselves onto a ready list when they finish,
+/// and each NextReady() call takes O(1) regardless of the amount of tasks.
+/// Prefer TaskSet for a scatter-gather over hundreds of tasks.
+///
+/// @snippet engine/task_set_test.cpp  Sample engine::TaskSet
+///
+/// The set is not thread-safe, it should be used by a single task. The tasks
+/// of the set are cancelled and waited for on its destruction, and must not be
+/// moved out of the set before NextReady() returns their indices.
+template <typename T>
+class TaskSet final {
+ public:
+  TaskSet() = default;
+
+  TaskSet(TaskSet&&) = delete;
+  TaskSet& operator=(TaskSet&&) = delete;
+
+  /// @brief Adds a valid task to the set
+  /// @returns the index of the task, indices are given in the order of
+  /// addition starting from 0
+  std::size_t Add(TaskWithResult<T>&& task);
+
+  /// @brief Waits for a finished task that was not returned yet.
+  ///
+  /// The task may still be finishing for a moment, so its `Get()` may
+  /// context switch.
+  ///
+  /// @returns the index of the finished task, or `std::nullopt` if all the
+  /// tasks are already returned, the deadline expired or the current task
+  /// is cancelled.
+  [[nodiscard]] std::optional<std::size_t> NextReady(Deadline deadline = {});
+
+  /// @returns the task with the index returned by Add()
+  TaskWithResult<T>& GetTask(std::size_t index);
+
+  /// @returns the amount of tasks in the set
+  std::size_t GetSize() const noexcept { return tasks_.size(); }
+
+  /// @returns the amount of tasks that were not returned by NextReady() yet
+  std::size_t GetPendingCount() const noexcept {
+    return impl_.GetPendingCount();
+  }
+
+ private:
+  // Must outlive the tasks, they notify it on finish
+  impl::TaskSetImpl impl_;
+  std::deque<TaskWithResult<T>> tasks_;
+};
+
+template <typename T>
+std::size_t TaskSet<T>::Add(TaskWithResult<T>&& task) {
+  tasks_.push_back(std::move(task));
+  return impl_.Add(tasks_.back());
+}
+
+template <typename T>
+std::optional<std::size_t> TaskSet<T>::NextReady(Deadline deadline) {
+  return impl_.NextReady(deadline);
+}
+
+template <typename T>
+TaskWithResult<T>& TaskSet<T>::GetTask(std::size_t index) {
+  UASSERT(index < tasks_.size());
+  return tasks_[index];
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
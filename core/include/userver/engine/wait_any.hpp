@@ -26,6 +26,9 @@ namespace engine {
 /// Works with different types of tasks and futures:
 /// @snippet src/engine/wait_any_test.cpp sample waitany
 ///
+/// @note Each call registers the caller in all of the tasks, so waiting for
+/// N tasks one by one takes O(N^2). Prefer engine::TaskSet for many tasks.
+///
 /// @param tasks either a single container, or a pack of future-like elements.
 /// @returns the index of the completed task, or `std::nullopt` if there are no
 /// completed tasks (possible if current task was cancelled).
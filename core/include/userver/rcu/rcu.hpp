@@ -3,10 +3,14 @@
 /// @file userver/rcu/rcu.hpp
 /// @brief Implementation of hazard pointer
 
+#include <array>
 #include <atomic>
 #include <cstdlib>
 #include <list>
+#include <memory>
+#include <type_traits>
 #include <unordered_set>
+#include <vector>
 
 #include <userver/compiler/thread_local.hpp>
 #include <userver/engine/async.hpp>
@@ -69,6 +73,71 @@ inline compiler::ThreadLocal local_cached_data =
 
 uint64_t GetNextEpoch() noexcept;
 
+// Counts the readers of an rcu::Variable with epoch-based reclamation. The
+// readers are counted in the current epoch, which is one of two alternating
+// ones. Once a new epoch is started, the values retired before it may only be
+// used by the readers of the previous epoch.
+//
+// The counters are striped by the threads, so the readers of different
+// threads do not contend. A reader may continue on another thread, it is
+// uncounted from the stripe it was counted in.
+class EpochDomain final {
+ public:
+  struct ReadLock final {
+    std::size_t stripe;
+    std::size_t epoch_index;
+  };
+
+  ReadLock LockRead() noexcept;
+
+  void UnlockRead(ReadLock lock) noexcept;
+
+  void StartNewEpoch() noexcept;
+
+  bool IsPreviousEpochDrained() const noexcept;
+
+  bool HasReaders() const noexcept;
+
+ private:
+  static constexpr std::size_t kStripes = 16;
+
+  struct alignas(64) Stripe final {
+    std::atomic<std::uint64_t> readers[2]{};
+  };
+
+  std::atomic<std::uint64_t> epoch_{0};
+  std::array<Stripe, kStripes> stripes_{};
+};
+
+template <typename RcuTraits, typename = void>
+inline constexpr bool kIsEpochBased = false;
+
+template <typename RcuTraits>
+inline constexpr bool kIsEpochBased<
+    RcuTraits, std::void_t<decltype(RcuTraits::kEpochBasedReclamation)>> =
+    RcuTraits::kEpochBasedReclamation;
+
+template <typename T>
+struct EpochReclamationState final {
+  EpochDomain domain;
+  // retired in the current epoch
+  std::vector<std::unique_ptr<T>> retired;
+  // retired before the current epoch, wait for the previous epoch to drain
+  std::vector<std::unique_ptr<T>> waiting;
+};
+
+struct NoEpochReclamationState final {};
+
+template <typename T, typename RcuTraits, typename = void>
+struct EpochReaderBase {};
+
+template <typename T, typename RcuTraits>
+struct EpochReaderBase<T, RcuTraits,
+                       std::enable_if_t<kIsEpochBased<RcuTraits>>> {
+  const Variable<T, RcuTraits>* epoch_owner_{nullptr};
+  EpochDomain::ReadLock epoch_lock_{};
+};
+
 }  // namespace impl
 
 /// Default Rcu traits.
@@ -79,30 +148,57 @@ struct DefaultRcuTraits {
   using MutexType = engine::Mutex;
 };
 
+/// Rcu traits for the epoch-based reclamation of the old values.
+///
+/// A reader increments a counter of the current epoch in a thread-striped
+/// slot instead of searching for a free hazard pointer, and the writer does
+/// not collect the hazard pointers of all the readers. The old values are
+/// destroyed in batches, once all the readers of the epoch in which they were
+/// retired are gone, on the next write or `Cleanup()`.
+///
+/// @warning A ReadablePtr that is kept for a long time delays the destruction
+/// of all the values retired since it was obtained, not only of its one.
+template <typename T>
+struct EpochRcuTraits {
+  using MutexType = engine::Mutex;
+  static constexpr bool kEpochBasedReclamation = true;
+};
+
 /// Reader smart pointer for rcu::Variable<T>. You may use operator*() or
 /// operator->() to do something with the stored value. Once created,
 /// ReadablePtr references the same immutable value: if Variable's value is
 /// changed during ReadablePtr lifetime, it will not affect value referenced by
 /// ReadablePtr.
 template <typename T, typename RcuTraits>
-class [[nodiscard]] ReadablePtr final {
+class [[nodiscard]] ReadablePtr final
+    : private impl::EpochReaderBase<T, RcuTraits> {
  public:
-  explicit ReadablePtr(const Variable<T, RcuTraits>& ptr)
-      : hp_record_(&ptr.MakeHazardPointer()) {
-    // This cycle guarantees that at the end of it both t_ptr_ and
-    // hp_record_->ptr will both be set to
-    // 1. something meaningful
-    // 2. and that this meaningful value was not removed between assigning to
-    //    t_ptr_ and storing  it in a hazard pointer
-    do {
+  explicit ReadablePtr(const Variable<T, RcuTraits>& ptr) {
+    if constexpr (impl::kIsEpochBased<RcuTraits>) {
+      // The writer does not destroy the values that the readers of the epoch
+      // could have obtained
+      this->epoch_owner_ = &ptr;
+      this->epoch_lock_ = ptr.epoch_state_.domain.LockRead();
       t_ptr_ = ptr.GetCurrent();
-
-      hp_record_->ptr.store(t_ptr_);
-    } while (t_ptr_ != ptr.GetCurrent());
+    } else {
+      hp_record_ = &ptr.MakeHazardPointer();
+      // This cycle guarantees that at the end of it both t_ptr_ and
+      // hp_record_->ptr will both be set to
+      // 1. something meaningful
+      // 2. and that this meaningful value was not removed between assigning
+      //    to t_ptr_ and storing  it in a hazard pointer
+      do {
+        t_ptr_ = ptr.GetCurrent();
+
+        hp_record_->ptr.store(t_ptr_);
+      } while (t_ptr_ != ptr.GetCurrent());
+    }
   }
 
   ReadablePtr(ReadablePtr<T, RcuTraits>&& other) noexcept
-      : t_ptr_(other.t_ptr_), hp_record_(other.hp_record_) {
+      : impl::EpochReaderBase<T, RcuTraits>(other),
+        t_ptr_(other.t_ptr_),
+        hp_record_(other.hp_record_) {
     other.t_ptr_ = nullptr;
   }
 
@@ -130,7 +226,7 @@ class [[nodiscard]] ReadablePtr final {
 
     // Get rid of our current hp_record_
     if (t_ptr_) {
-      hp_record_->Release();
+      Release();
     }
     // After that moment, the content of our hp_record_ can't be used -
     // no more hp_record_->xyz calls, because it is probably already reused in
@@ -138,6 +234,7 @@ class [[nodiscard]] ReadablePtr final {
     // freed. Just take values from 'other'.
     hp_record_ = other.hp_record_;
     t_ptr_ = other.t_ptr_;
+    static_cast<impl::EpochReaderBase<T, RcuTraits>&>(*this) = other;
 
     // Now, it won't do us any good if there were two glorified things having
     // pointer to same hp_record_. Kill the other one.
@@ -150,7 +247,7 @@ class [[nodiscard]] ReadablePtr final {
   }
 
   ReadablePtr(const ReadablePtr<T, RcuTraits>& other)
-      : ReadablePtr(other.hp_record_->owner) {}
+      : ReadablePtr(other.GetOwner()) {}
 
   ReadablePtr& operator=(const ReadablePtr<T, RcuTraits>& other) {
     if (this != &other) *this = ReadablePtr<T, RcuTraits>{other};
@@ -159,8 +256,7 @@ class [[nodiscard]] ReadablePtr final {
 
   ~ReadablePtr() {
     if (!t_ptr_) return;
-    UASSERT(hp_record_ != nullptr);
-    hp_record_->Release();
+    Release();
   }
 
   const T* Get() const& {
@@ -183,6 +279,23 @@ class [[nodiscard]] ReadablePtr final {
     std::abort();
   }
 
+  const Variable<T, RcuTraits>& GetOwner() const {
+    if constexpr (impl::kIsEpochBased<RcuTraits>) {
+      return *this->epoch_owner_;
+    } else {
+      return hp_record_->owner;
+    }
+  }
+
+  void Release() {
+    if constexpr (impl::kIsEpochBased<RcuTraits>) {
+      this->epoch_owner_->epoch_state_.domain.UnlockRead(this->epoch_lock_);
+    } else {
+      UASSERT(hp_record_ != nullptr);
+      hp_record_->Release();
+    }
+  }
+
   // This is a pointer to actual data. If it is null, then we treat it as
   // an indicator that this ReadablePtr is cleared and won't call
   // any logic associated with hp_record_
@@ -191,7 +304,8 @@ class [[nodiscard]] ReadablePtr final {
   // Invariant is this: if t_ptr_ is not nullptr, then hp_record_ is also
   // not nullptr and points to hazard pointer containing same T*.
   // Thus, if t_ptr_ is nullptr, then hp_record_ is undefined.
-  impl::HazardPointerRecord<T, RcuTraits>* hp_record_;
+  // Not used with the epoch-based reclamation.
+  impl::HazardPointerRecord<T, RcuTraits>* hp_record_{nullptr};
 };
 
 /// Smart pointer for rcu::Variable<T> for changing RCU value. It stores a
@@ -297,6 +411,10 @@ enum class DestructionType { kSync, kAsync };
 /// be eventually freed when a subsequent writer identifies that nobody works
 /// with this version.
 ///
+/// By default the readers are tracked with hazard pointers. Pass
+/// rcu::EpochRcuTraits for the epoch-based reclamation, that makes reads
+/// cheaper for the variables with many concurrent readers.
+///
 /// @note There is no way to create a "null" `Variable`.
 ///
 /// ## Example usage:
@@ -342,6 +460,13 @@ class Variable final {
   ~Variable() {
     delete current_.load();
 
+    if constexpr (impl::kIsEpochBased<RcuTraits>) {
+      UASSERT_MSG(!epoch_state_.domain.HasReaders(),
+                  "RCU variable is destroyed while being used");
+      epoch_state_.retired.clear();
+      epoch_state_.waiting.clear();
+    }
+
     auto* hp = hp_record_head_.load();
     while (hp) {
       auto* next = hp->next.load();
@@ -404,7 +529,11 @@ class Variable final {
       return;
     }
 
-    ScanRetiredList(CollectHazardPtrs(lock));
+    if constexpr (impl::kIsEpochBased<RcuTraits>) {
+      ReclaimEpochs(lock);
+    } else {
+      ScanRetiredList(CollectHazardPtrs(lock));
+    }
   }
 
  private:
@@ -471,6 +600,12 @@ class Variable final {
 
   void Retire(std::unique_ptr<T> old_ptr, std::unique_lock<MutexType>& lock) {
     LOG_TRACE() << "Retiring ptr=" << old_ptr.get();
+    if constexpr (impl::kIsEpochBased<RcuTraits>) {
+      epoch_state_.retired.push_back(std::move(old_ptr));
+      ReclaimEpochs(lock);
+      return;
+    }
+
     auto hazard_ptrs = CollectHazardPtrs(lock);
 
     if (hazard_ptrs.count(old_ptr.get()) > 0) {
@@ -511,6 +646,46 @@ class Variable final {
     return hazard_ptrs;
   }
 
+  // Destroys the values, that can no longer be used by the readers, and starts
+  // a new epoch for the values retired in the current one
+  void ReclaimEpochs(std::unique_lock<MutexType>&) {
+    auto& state = epoch_state_;
+    if (!state.waiting.empty()) {
+      if (!state.domain.IsPreviousEpochDrained()) return;
+      DeleteBatchAsync(std::move(state.waiting));
+      state.waiting.clear();
+    }
+    if (state.retired.empty()) return;
+
+    // The readers, that could have obtained the retired values, are counted
+    // in the current epoch, that becomes the previous one
+    state.domain.StartNewEpoch();
+    state.waiting = std::move(state.retired);
+    state.retired.clear();
+
+    if (state.domain.IsPreviousEpochDrained()) {
+      DeleteBatchAsync(std::move(state.waiting));
+      state.waiting.clear();
+    }
+  }
+
+  void DeleteBatchAsync(std::vector<std::unique_ptr<T>> batch) {
+    LOG_TRACE() << "Retire, not used " << batch.size() << " values";
+    switch (destruction_type_) {
+      case DestructionType::kSync:
+        batch.clear();
+        break;
+      case DestructionType::kAsync:
+        engine::CriticalAsyncNoSpan([batch = std::move(batch),
+                                     token = wait_token_storage_
+                                                 .GetToken()]() mutable {
+          // Make sure the values are deleted before token is destroyed
+          batch.clear();
+        }).Detach();
+        break;
+    }
+  }
+
   void DeleteAsync(std::unique_ptr<T> ptr) {
     switch (destruction_type_) {
       case DestructionType::kSync:
@@ -537,6 +712,10 @@ class Variable final {
   // may be read without mutex_ locked, but must be changed with held mutex_
   std::atomic<T*> current_;
   std::list<std::unique_ptr<T>> retire_list_head_;
+  mutable std::conditional_t<impl::kIsEpochBased<RcuTraits>,
+                             impl::EpochReclamationState<T>,
+                             impl::NoEpochReclamationState>
+      epoch_state_;
   utils::impl::WaitTokenStorage wait_token_storage_;
 
   friend class ReadablePtr<T, RcuTraits>;
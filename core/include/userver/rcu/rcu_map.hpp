@@ -11,6 +11,7 @@
 #include <utility>
 
 #include <userver/rcu/rcu.hpp>
+#include <userver/utils/hash.hpp>
 #include <userver/utils/traceful_exception.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -39,7 +40,7 @@ class MissingKeyException : public utils::TracefulException {
 /// structure on update
 template <typename Key, typename Value>
 struct DefaultRcuMapTraits {
-  using Hash = std::hash<Key>;
+  using Hash = utils::hash::Hash<Key>;
   using KeyEqual = std::equal_to<Key>;
   using MutexType = engine::Mutex;
 };
@@ -211,6 +212,18 @@ class RcuMap final {
   /// Replace current data by data from `new_map`.
   void Assign(RawMap new_map);
 
+  /// Replace current data by data from `new_map` with another hash, e.g. with
+  /// `std::hash`.
+  template <typename OtherHash, typename OtherKeyEqual,
+            typename = std::enable_if_t<
+                !std::is_same_v<OtherHash, Hash> ||
+                !std::is_same_v<OtherKeyEqual, KeyEqual>>>
+  void Assign(
+      std::unordered_map<Key, ValuePtr, OtherHash, OtherKeyEqual> new_map) {
+    Assign(RawMap(std::make_move_iterator(new_map.begin()),
+                  std::make_move_iterator(new_map.end()), new_map.size()));
+  }
+
   /// @brief Starts a transaction, used to perform a series of arbitrary changes
   /// to the map.
   /// @details The map is copied. Don't forget to `Commit` to apply the changes.
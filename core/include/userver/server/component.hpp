@@ -65,6 +65,8 @@ namespace components {
 /// tls.cert | path to TLS server certificate | -
 /// tls.private-key | path to TLS server certificate private key | -
 /// tls.private-key-passphrase-name | passphrase name located in secdist's "passphrases" section | -
+/// tls.ktls | hand the established connections over to the kernel TLS (kTLS) if the kernel, OpenSSL and the negotiated cipher support it | false
+/// tls.session-resumption | issue TLS session tickets for the resumption of the sessions on reconnects | true
 /// handler-defaults.max_url_size | max path/URL size or empty to not limit | 8192
 /// handler-defaults.max_request_size | max size of the whole request | 1024 * 1024
 /// handler-defaults.max_headers_size | max request headers size | 65536
@@ -75,7 +77,15 @@ namespace components {
 /// connection.in_buffer_size | size of the buffer to preallocate for request receive: bigger values use more RAM and less CPU | 32 * 1024
 /// connection.requests_queue_size_threshold | drop requests from handlers that allow throttling if there's more pending requests than allowed by this value | 100
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
-/// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
+/// connection.max_requests | close the connection after about that many requests (up to 10% less to spread the reconnects in time); 0 to not limit | 0
+/// connection.max_age | close the connection with the first request after about that many seconds since the connection was accepted (up to 10% less); 0 to not limit | 0
+/// connection.overload_close_fraction | fraction of the requests that get a `Connection: close` response while the task processor of the listener is overloaded by wait_queue_overload of USERVER_TASK_PROCESSOR_QOS | 0
+/// connection.http2.enabled | accept HTTP/2 connections with prior knowledge (h2c or h2 over TLS) along with HTTP/1.1 | false
+/// connection.http2.max_concurrent_streams | max number of requests that are processed concurrently within a single connection | 100
+/// connection.http2.initial_window_size | initial flow control window size in bytes for each stream | 65535
+/// connection.http2.max_frame_size | max size of a frame payload in bytes that the server accepts | 16384
+/// shards | how many SO_REUSEPORT sockets accept the connections, each one is served by its own ev thread; must not be greater than 1 for unix-socket | <number of ev threads of task_processor>
+/// reuseport_cpu_steering | pass a new connection to the shard with the index of the CPU that received it instead of the connection hash (Linux only) | false
 ///
 /// @see @ref scripts/docs/en/userver/http_server.md
 
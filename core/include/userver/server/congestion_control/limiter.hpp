@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <optional>
 #include <vector>
 
@@ -14,6 +15,10 @@ namespace server::congestion_control {
 class Limitee {
  public:
   virtual void SetLimit(std::optional<size_t> new_limit) = 0;
+
+  /// Rejects the requests of the `shed_level` lowest priority classes, see
+  /// server::handlers::ThrottlingPriority. Ignored by default.
+  virtual void SetShedLevel(std::size_t /*shed_level*/) {}
 };
 
 class Limiter final : public USERVER_NAMESPACE::congestion_control::Limiter {
@@ -0,0 +1,88 @@
+#pragma once
+
+/// @file userver/server/handlers/cpu_profiler.hpp
+/// @brief @copybrief server::handlers::CpuProfiler
+
+#include <chrono>
+
+#include <userver/server/handlers/http_handler_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief Handler that samples the CPU usage of the whole process and responds
+/// with a profile in the pprof format.
+///
+/// Samples are taken on SIGPROF of the process CPU timer. Each sample
+/// remembers the stack of the interrupted code, the name of the root span and
+/// the task processor of the current task and the name of the thread, the
+/// latter are reported as the `span`, `task_processor` and `thread` labels.
+/// Only one profile is collected at a time.
+///
+/// ## Static options:
+/// Inherits all the options from server::handlers::HttpHandlerBase and adds the
+/// following ones:
+///
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// max-duration | the longest profile that may be requested | 5m
+/// max-samples | samples above that are dropped | 100000
+///
+/// ## Static configuration example:
+///
+/// @code
+/// handler-cpu-profiler:
+///     path: /service/cpu-profile
+///     method: GET
+///     task_processor: monitor-task-processor
+/// @endcode
+///
+/// ## Scheme
+/// * `seconds` - profiling duration, 30 by default
+/// * `frequency` - samples per second of the process CPU time, 100 by default
+///
+/// Responds with 409 if another profile is being collected.
+///
+/// ## Usage example:
+///
+/// @code
+/// $ go tool pprof -http=:8080 'localhost:1188/service/cpu-profile?seconds=10'
+/// @endcode
+
+// clang-format on
+
+class CpuProfiler final : public HttpHandlerBase {
+ public:
+  CpuProfiler(const components::ComponentConfig&,
+              const components::ComponentContext&);
+
+  /// @ingroup userver_component_names
+  /// @brief The default name of server::handlers::CpuProfiler
+  static constexpr std::string_view kName = "handler-cpu-profiler";
+
+  std::string HandleRequestThrow(const http::HttpRequest&,
+                                 request::RequestContext&) const override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::string GetResponseDataForLogging(
+      const http::HttpRequest& request, request::RequestContext& context,
+      const std::string& response_data) const override;
+
+  const std::chrono::seconds max_duration_;
+  const std::size_t max_samples_;
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool components::kHasValidate<server::handlers::CpuProfiler> =
+    true;
+
+USERVER_NAMESPACE_END
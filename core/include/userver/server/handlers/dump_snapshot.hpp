@@ -0,0 +1,72 @@
+#pragma once
+
+/// @file userver/server/handlers/dump_snapshot.hpp
+/// @brief @copybrief server::handlers::DumpSnapshot
+
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/testsuite/dump_control.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief Handler that streams the current data of a dump::Dumper to another
+/// instance of the service, that loads it on start instead of performing a
+/// full update.
+///
+/// The component has no service configuration except the
+/// @ref userver_http_handlers "common handler options".
+///
+/// ## Static configuration example:
+///
+/// @code
+/// handler-dump-snapshot:
+///     path: /service/dump-snapshot
+///     method: GET
+///     task_processor: monitor-task-processor
+/// @endcode
+///
+/// ## Scheme
+///
+/// `GET` request with a `name` argument responds with a snapshot of the dumper
+/// of the component with this name, see dump::Dumper::WriteSnapshot. The
+/// snapshot is streamed as it is being written. Responds with 404 if there is
+/// no such dumper.
+///
+/// The snapshots are requested by the dumpers with the `dump.peer-warmup`
+/// static option, see dump::Dumper.
+///
+/// @see @ref scripts/docs/en/userver/cache_dumps.md
+
+// clang-format on
+class DumpSnapshot final : public HttpHandlerBase {
+ public:
+  DumpSnapshot(const components::ComponentConfig& config,
+               const components::ComponentContext& component_context);
+
+  /// @ingroup userver_component_names
+  /// @brief The default name of server::handlers::DumpSnapshot
+  static constexpr std::string_view kName = "handler-dump-snapshot";
+
+  void HandleStreamRequest(const http::HttpRequest& request,
+                           request::RequestContext& context,
+                           http::ResponseBodyStream& response) const override;
+
+  bool IsStreamed() const override { return true; }
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  testsuite::DumpControl& dump_control_;
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool
+    components::kHasValidate<server::handlers::DumpSnapshot> = true;
+
+USERVER_NAMESPACE_END
@@ -36,13 +36,32 @@ namespace server::handlers {
 /// request_body_size_log_limit | trim request to this size before logging | 512
 /// response_data_size_log_limit | trim responses to this size before logging | 512
 /// max_requests_per_second | integer to limit RPS to this handler | <no limit>
+/// ratelimit_per_client | limit RPS of each client to this handler separately, the client is identified by the `header` option value; `max_requests_per_second` and `burst` options set the limit of each client, see utils::KeyedRateLimiter | <no limit>
 /// decompress_request | allow decompression of the requests | true
+/// request_zstd_dictionary | path to a zstd dictionary file, the `zstd` encoded requests are decompressed with it; the clients should compress the requests with the same dictionary, e.g. the one trained by `zstd --train` on the typical request bodies | <no dictionary>
+/// response_compression | compress the responses with the content codings accepted by the client, see the options below | <no compression>
 /// throttling_enabled | allow throttling of the requests by components::Server , for more info see its `max_response_size_in_flight` and `requests_queue_size_threshold` options | true
+/// throttling_cost | number of congestion control tokens a request to this handler takes, more expensive handlers are throttled first when the RPS limit is set | 1
+/// throttling_body_bytes_per_cost | add one congestion control token to the request cost for each full chunk of this many request body bytes | <body size does not affect the cost>
+/// throttling_priority | request priority class for the congestion control shedding, one of `low`, `normal` and `high`; the lower classes are rejected entirely first when the server is heavily overloaded | normal
 /// set-response-server-hostname | set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header | <takes the value from components::Server config>
 /// monitor-handler | Overrides the in-code `is_monitor` flag that makes the handler run either on `server.listener` or on `server.listener-monitor` | --
 /// set_tracing_headers | whether to set http tracing headers (X-YaTraceId, X-YaSpanId, X-RequestId) | true
 /// deadline_propagation_enabled | when `false`, disables HTTP handler @ref scripts/docs/en/userver/deadline_propagation.md "deadline propagation" | true
 /// deadline_expired_status_code | the HTTP status code to return if the request @ref scripts/docs/en/userver/deadline_propagation.md "deadline expires" | 498
+///
+/// ## Options of response_compression:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// encodings | content codings in the order of preference, from `gzip`, `zstd` and `br` | [zstd, br, gzip]
+/// min_size | responses smaller than this are not compressed, streamed responses are always compressed | 1024
+/// gzip_level | gzip compression level from 1 to 9 | 6
+/// zstd_level | zstd compression level from 1 to 22 | 3
+/// brotli_level | brotli quality from 0 to 11 | 5
+///
+/// The coding is negotiated by the `Accept-Encoding` request header. Responses
+/// that already have `Content-Encoding` or `Content-Range` headers are sent as
+/// is.
 
 // clang-format on
 class HandlerBase : public components::LoggableComponentBase {
@@ -26,6 +26,62 @@ enum class UrlTrailingSlashOption {
   kDefault = kBoth,
 };
 
+/// Request priority classes for the congestion control shedding, the lower
+/// classes are rejected entirely first when the server is heavily overloaded
+enum class ThrottlingPriority {
+  kLow,     ///< "low"
+  kNormal,  ///< "normal"
+  kHigh,    ///< "high", never shed by the class, only by the RPS limit
+};
+
+/// Content codings of the responses
+enum class ResponseEncoding {
+  kGzip,    ///< "gzip"
+  kZstd,    ///< "zstd"
+  kBrotli,  ///< "br"
+};
+
+/// Negotiated compression of the responses, see `response_compression` static
+/// option of server::handlers::HandlerBase
+struct ResponseCompressionConfig {
+  /// In the order of preference, used if the client accepts several of them
+  /// with the same q-value
+  std::vector<ResponseEncoding> encodings{
+      ResponseEncoding::kZstd, ResponseEncoding::kBrotli,
+      ResponseEncoding::kGzip};
+  /// Smaller responses are sent as is. Streamed responses are always
+  /// compressed.
+  std::size_t min_size{1024};
+  int gzip_level{6};
+  int zstd_level{3};
+  int brotli_level{5};
+};
+
+/// Caching of the serialized responses, see `response_cache` static option of
+/// server::handlers::HandlerBase and
+/// server::handlers::HttpHandlerBase::GetResponseCacheVersion()
+struct ResponseCacheConfig {
+  /// Request headers the response depends on, their values are a part of the
+  /// cache key along with the path and the args
+  std::vector<std::string> headers;
+  /// Approximate limit of the cached responses count
+  std::size_t max_entries{1000};
+  /// Number of the independently locked parts of the cache
+  std::size_t ways{16};
+};
+
+/// Separate rate limit of each client, see `ratelimit_per_client` static
+/// option of server::handlers::HandlerBase
+struct PerClientRatelimitConfig {
+  /// Request header identifying the client, the requests without it share
+  /// a single limit
+  std::string header;
+  /// Requests per second of each client
+  std::size_t max_requests_per_second{0};
+  /// Requests a client may send at once after being idle
+  std::size_t burst{0};
+};
+
 struct HandlerConfig {
   std::variant<std::string, FallbackHandler> path;
   std::string task_processor;
@@ -37,9 +93,17 @@ struct HandlerConfig {
   UrlTrailingSlashOption url_trailing_slash{UrlTrailingSlashOption::kDefault};
   std::optional<size_t> max_requests_in_flight;
   std::optional<size_t> max_requests_per_second;
+  std::optional<PerClientRatelimitConfig> ratelimit_per_client;
   bool decompress_request{true};
+  std::optional<std::string> request_zstd_dictionary;
+  std::optional<ResponseCompressionConfig> response_compression;
+  std::optional<ResponseCacheConfig> response_cache;
   bool throttling_enabled{true};
+  size_t throttling_cost{1};
+  std::optional<size_t> throttling_body_bytes_per_cost;
+  ThrottlingPriority throttling_priority{ThrottlingPriority::kNormal};
   bool response_body_stream{false};
+  bool request_body_stream{false};
   std::optional<bool> set_response_server_hostname;
   bool set_tracing_headers{true};
   bool deadline_propagation_enabled{true};
@@ -0,0 +1,69 @@
+#pragma once
+
+/// @file userver/server/handlers/hot_keys.hpp
+/// @brief @copybrief server::handlers::HotKeys
+
+#include <userver/server/handlers/http_handler_json_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+class HotKeysStorage;
+}  // namespace components
+
+namespace server::handlers {
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief Handler that returns the most frequently accessed keys of the
+/// sources of components::HotKeysStorage.
+///
+/// The component has no service configuration except the
+/// @ref userver_http_handlers "common handler options".
+///
+/// ## Static configuration example:
+///
+/// @code
+///   handler-hot-keys:
+///     path: /service/hot-keys
+///     method: GET
+///     task_processor: monitor-task-processor
+/// @endcode
+///
+/// ## Scheme
+/// Provide an optional query parameter `source` to get the keys of a single
+/// source, and `limit` to change the number of the keys per source (10 by
+/// default). The response maps the source names to their estimated
+/// `accesses` and to the `keys` with the `key`, the estimated `count` and its
+/// max overestimation `error`.
+
+// clang-format on
+class HotKeys final : public HttpHandlerJsonBase {
+ public:
+  /// @ingroup userver_component_names
+  /// @brief The default name of server::handlers::HotKeys
+  static constexpr std::string_view kName = "handler-hot-keys";
+
+  HotKeys(const components::ComponentConfig& config,
+          const components::ComponentContext& context);
+
+  formats::json::Value HandleRequestJsonThrow(
+      const http::HttpRequest& request,
+      const formats::json::Value& request_json,
+      request::RequestContext& context) const override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  components::HotKeysStorage& storage_;
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool components::kHasValidate<server::handlers::HotKeys> =
+    true;
+
+USERVER_NAMESPACE_END
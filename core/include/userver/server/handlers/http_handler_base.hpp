@@ -3,6 +3,7 @@
 /// @file userver/server/handlers/http_handler_base.hpp
 /// @brief @copybrief server::handlers::HttpHandlerBase
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <unordered_set>
@@ -29,6 +30,18 @@ namespace tracing {
 class TracingManagerBase;
 }  // namespace tracing
 
+namespace server::http {
+class HeadersPropagator;
+}  // namespace server::http
+
+namespace compression::zstd {
+class Dictionary;
+}  // namespace compression::zstd
+
+namespace utils {
+class KeyedRateLimiter;
+}  // namespace utils
+
 /// @brief Most common \ref userver_http_handlers "userver HTTP handlers"
 namespace server::handlers {
 
@@ -37,6 +50,10 @@ class HttpRequestStatistics;
 class HttpHandlerMethodStatistics;
 class HttpHandlerStatisticsScope;
 
+namespace impl {
+class ResponseCache;
+}  // namespace impl
+
 // clang-format off
 
 /// @ingroup userver_components userver_http_handlers userver_base_classes
@@ -105,6 +122,8 @@ class HttpHandlerBase : public HandlerBase {
   /// The core method for HTTP request handling.
   /// `request` arg contains HTTP headers, full body, etc.
   /// The method should return response body.
+  /// utils::GetCurrentArena() returns the arena of the request, that is freed
+  /// once the request is handled.
   /// @note It is used only if IsStreamed() returned `false`.
   virtual std::string HandleRequestThrow(
       const http::HttpRequest& request, request::RequestContext& context) const;
@@ -136,6 +155,18 @@ class HttpHandlerBase : public HandlerBase {
   /// "response-body-streamed" value from static config.
   virtual bool IsStreamed() const { return is_body_streamed_; }
 
+  /// Override it to enable the `response_cache` static option. The cached
+  /// response is used only if it was built for the same version of the data,
+  /// see server::handlers::ResponseCacheVersion.
+  /// Return std::nullopt to not use the cache for the request.
+  /// @note Only the body, the Content-Type and the ETag headers of the
+  /// responses with 200 status are cached.
+  virtual std::optional<std::uint64_t> GetResponseCacheVersion(
+      const http::HttpRequest& /*request*/,
+      request::RequestContext& /*context*/) const {
+    return std::nullopt;
+  }
+
   /// Override it to show per HTTP-method statistics besides statistics for all
   /// methods
   virtual bool IsMethodStatisticIncluded() const { return false; }
@@ -165,6 +196,12 @@ class HttpHandlerBase : public HandlerBase {
   void HandleRequestStream(const http::HttpRequest& http_request,
                            request::RequestContext& context) const;
 
+  void HandleRequestNonStream(const http::HttpRequest& http_request,
+                              request::RequestContext& context) const;
+
+  void HandleRequestCached(const http::HttpRequest& http_request,
+                           request::RequestContext& context) const;
+
   std::string GetRequestBodyForLoggingChecked(
       const http::HttpRequest& request, request::RequestContext& context,
       const std::string& request_body) const;
@@ -191,15 +228,19 @@ class HttpHandlerBase : public HandlerBase {
   const std::string handler_name_;
   utils::statistics::Entry statistics_holder_;
   const tracing::TracingManagerBase& tracing_manager_;
+  const http::HeadersPropagator* headers_propagator_;
   std::unordered_map<int, logging::Level> log_level_for_status_codes_;
 
   std::unique_ptr<HttpHandlerStatistics> handler_statistics_;
   std::unique_ptr<HttpRequestStatistics> request_statistics_;
   std::vector<auth::AuthCheckerBasePtr> auth_checkers_;
+  std::unique_ptr<impl::ResponseCache> response_cache_;
+  std::unique_ptr<compression::zstd::Dictionary> request_zstd_dictionary_;
 
   std::optional<logging::Level> log_level_;
   bool set_response_server_hostname_;
   mutable utils::TokenBucket rate_limit_;
+  std::unique_ptr<utils::KeyedRateLimiter> per_client_rate_limit_;
   bool is_body_streamed_;
 };
 
@@ -8,6 +8,7 @@
 #include <flatbuffers/flatbuffers.h>
 
 #include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/handlers/impl/flatbuf_builder.hpp>
 #include <userver/server/http/http_error.hpp>
 #include <userver/utils/log.hpp>
 #include <userver/yaml_config/schema.hpp>
@@ -30,6 +31,10 @@ inline const std::string kFlatbufResponseDataName = "__response_flatbuf";
 /// @brief Convenient base for handlers that accept requests with body in
 /// Flatbuffer format and respond with body in Flatbuffer format.
 ///
+/// The request is unpacked into the object API types. See
+/// server::handlers::HttpHandlerFlatbufViewBase for a handler that reads
+/// the request in place and builds the response by itself.
+///
 /// ## Example usage:
 ///
 /// @snippet samples/flatbuf_service/flatbuf_service.cpp Flatbuf service sample - component
@@ -80,6 +85,9 @@ class HttpHandlerFlatbufBase : public HttpHandlerBase {
 
   void ParseRequestData(const http::HttpRequest& request,
                         request::RequestContext& context) const final;
+
+ private:
+  mutable impl::FlatbufBuilderPool builders_;
 };
 
 template <typename InputType, typename ReturnType>
@@ -99,10 +107,9 @@ std::string HttpHandlerFlatbufBase<InputType, ReturnType>::HandleRequestThrow(
       impl::kFlatbufResponseDataName,
       HandleRequestFlatbufThrow(request, input, context));
 
-  flatbuffers::FlatBufferBuilder fbb;
-  auto ret_fbb = ReturnType::Pack(fbb, &ret);
-  fbb.Finish(ret_fbb);
-  return {reinterpret_cast<const char*>(fbb.GetBufferPointer()), fbb.GetSize()};
+  const auto builder = builders_.Acquire();
+  auto& fbb = builder->Prepare();
+  return builder->Finish(ReturnType::Pack(fbb, &ret));
 }
 
 template <typename InputType, typename ReturnType>
@@ -142,17 +149,10 @@ HttpHandlerFlatbufBase<InputType, ReturnType>::GetResponseDataForLogging(
 template <typename InputType, typename ReturnType>
 void HttpHandlerFlatbufBase<InputType, ReturnType>::ParseRequestData(
     const http::HttpRequest& request, request::RequestContext& context) const {
-  const auto& body = request.RequestBody();
-  const auto* input_fbb = flatbuffers::GetRoot<InputType>(body.data());
-  flatbuffers::Verifier verifier(reinterpret_cast<const uint8_t*>(body.data()),
-                                 body.size());
-  if (!input_fbb->Verify(verifier)) {
-    throw ClientError(
-        InternalMessage{"Invalid FlatBuffers format in request body"});
-  }
+  const auto& input_fbb = impl::GetVerifiedFlatbufRoot<InputType>(request);
 
   typename InputType::NativeTableType input;
-  input_fbb->UnPackTo(&input);
+  input_fbb.UnPackTo(&input);
 
   context.SetData(impl::kFlatbufRequestDataName, std::move(input));
 }
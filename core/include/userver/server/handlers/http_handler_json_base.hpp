@@ -3,6 +3,9 @@
 /// @file userver/server/handlers/http_handler_json_base.hpp
 /// @brief @copybrief server::handlers::HttpHandlerJsonBase
 
+#include <userver/formats/json/lazy_value.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/json/validate.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,6 +22,48 @@ namespace server::handlers {
 /// ## Example usage:
 ///
 /// @snippet samples/config_service/config_service.cpp Config service sample - component
+///
+/// ## Lazy request parsing
+///
+/// Handlers that read only a few fields of big request bodies may override
+/// IsRequestJsonLazy() to return `true` and HandleRequestLazyJsonThrow()
+/// instead of HandleRequestJsonThrow(). The request body is then validated
+/// and indexed by formats::json::LazyDocument without building a
+/// formats::json::Value, and the fields are decoded only when they are read.
+///
+/// ## Arena request parsing
+///
+/// Handlers may override IsRequestJsonArenaAllocated() to return `true`, so
+/// that all the nodes of the request JSON are allocated from a single arena
+/// and released at once, see formats::json::FromStringWithArena.
+///
+/// ## Request validation
+///
+/// Handlers may compile a formats::json::Schema once in the constructor and
+/// return it from GetRequestJsonSchema(). The request JSON is then validated
+/// while it is being parsed by formats::json::FromStringValidated, and the
+/// requests that do not match the schema get a `400 Bad Request` response.
+///
+/// ## MessagePack
+///
+/// Handlers may override IsMsgpackAllowed() to return `true`, so that
+/// the requests with `Content-Type: application/msgpack` are parsed by
+/// formats::msgpack::FromString, and the responses are serialized by
+/// formats::msgpack::ToString if the `Accept` header of the request prefers
+/// `application/msgpack` to `application/json`. The handler code works with
+/// formats::json::Value in both cases. Error responses are always JSON.
+///
+/// ## Streamed responses
+///
+/// Handlers with big responses may override IsResponseJsonStreamed() to
+/// return `true` and HandleRequestJsonStreamThrow() instead of
+/// HandleRequestJsonThrow(). The response JSON is then written into a
+/// formats::json::StringBuilder instead of being built as a
+/// formats::json::Value. With `response-body-stream: true` in the static
+/// config the builder sends the JSON to the client in chunks as it is written,
+/// so the memory per request stays bounded. The status code and headers are
+/// sent with the first chunk: exceptions thrown after that can only abort the
+/// response. Streamed responses are always JSON.
 
 // clang-format on
 
@@ -31,16 +76,65 @@ class HttpHandlerJsonBase : public HttpHandlerBase {
   std::string HandleRequestThrow(const http::HttpRequest& request,
                                  request::RequestContext& context) const final;
 
+  /// @note It is used only if IsRequestJsonLazy() returned `false`.
   virtual formats::json::Value HandleRequestJsonThrow(
       const http::HttpRequest& request,
       const formats::json::Value& request_json,
-      request::RequestContext& context) const = 0;
+      request::RequestContext& context) const;
+
+  /// The request body is parsed on demand, `request_json` refers to the body
+  /// of the `request` and is valid until the end of the request handling.
+  /// @note It is used only if IsRequestJsonLazy() returned `true`.
+  virtual formats::json::Value HandleRequestLazyJsonThrow(
+      const http::HttpRequest& request,
+      const formats::json::LazyValue& request_json,
+      request::RequestContext& context) const;
+
+  /// The response JSON is written into `response_json`, see the class
+  /// description.
+  /// @note It is used only if IsResponseJsonStreamed() returned `true`.
+  virtual void HandleRequestJsonStreamThrow(
+      const http::HttpRequest& request,
+      const formats::json::Value& request_json,
+      request::RequestContext& context,
+      formats::json::StringBuilder& response_json) const;
+
+  /// If IsRequestJsonLazy() returns `true`, the request body is parsed into a
+  /// formats::json::LazyDocument and HandleRequestLazyJsonThrow() is called,
+  /// otherwise HandleRequestJsonThrow() is called with a formats::json::Value.
+  virtual bool IsRequestJsonLazy() const { return false; }
+
+  /// If IsRequestJsonArenaAllocated() returns `true`, the request body is
+  /// parsed by formats::json::FromStringWithArena.
+  /// @note It is used only if IsRequestJsonLazy() returned `false`.
+  virtual bool IsRequestJsonArenaAllocated() const { return false; }
+
+  /// If GetRequestJsonSchema() returns a schema, the request body is
+  /// validated against it while being parsed.
+  /// @note It is used only if IsRequestJsonLazy() returned `false`, the arena
+  /// allocation is not used for the validated requests.
+  virtual const formats::json::Schema* GetRequestJsonSchema() const {
+    return nullptr;
+  }
+
+  /// If IsMsgpackAllowed() returns `true`, the MessagePack request and
+  /// response bodies are negotiated via `Content-Type` and `Accept` headers.
+  /// @note Request bodies are parsed from MessagePack only if
+  /// IsRequestJsonLazy() returned `false`.
+  virtual bool IsMsgpackAllowed() const { return false; }
+
+  /// If IsResponseJsonStreamed() returns `true`,
+  /// HandleRequestJsonStreamThrow() is called instead of
+  /// HandleRequestJsonThrow().
+  /// @note IsRequestJsonLazy() must return `false` for such handlers.
+  virtual bool IsResponseJsonStreamed() const { return false; }
 
   static yaml_config::Schema GetStaticConfigSchema();
 
  protected:
   /// @returns A pointer to json request if it was parsed successfully or
-  /// nullptr otherwise.
+  /// nullptr otherwise. Always returns nullptr if IsRequestJsonLazy() returned
+  /// `true`.
   static const formats::json::Value* GetRequestJson(
       const request::RequestContext& context);
 
@@ -52,7 +146,14 @@ class HttpHandlerJsonBase : public HttpHandlerBase {
   void ParseRequestData(const http::HttpRequest& request,
                         request::RequestContext& context) const override;
 
+  void HandleStreamRequest(const http::HttpRequest& request,
+                           request::RequestContext& context,
+                           http::ResponseBodyStream& response) const override;
+
  private:
+  void ParseRequestLazyData(const http::HttpRequest& request,
+                            request::RequestContext& context) const;
+
   FormattedErrorData GetFormattedExternalErrorBody(
       const CustomHandlerException& exc) const final;
 };
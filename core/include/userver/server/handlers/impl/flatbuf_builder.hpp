@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include <flatbuffers/flatbuffers.h>
+
+#include <userver/concurrent/object_pool.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers::impl {
+
+/// Keeps the buffer of a flatbuffers::FlatBufferBuilder in a std::string, so
+/// that the finished buffer may become the response body without a copy
+class FlatbufStringAllocator final : public flatbuffers::Allocator {
+ public:
+  std::uint8_t* allocate(std::size_t size) override {
+    UASSERT_MSG(!data_, "Only one buffer may be allocated at a time");
+    buffer_.resize(size);
+    data_ = reinterpret_cast<std::uint8_t*>(buffer_.data());
+    return data_;
+  }
+
+  void deallocate(std::uint8_t* p, std::size_t /*size*/) override {
+    // The buffer was already extracted
+    if (p != data_) return;
+    buffer_ = std::string{};
+    data_ = nullptr;
+  }
+
+  std::uint8_t* reallocate_downward(std::uint8_t* old_p, std::size_t old_size,
+                                    std::size_t new_size,
+                                    std::size_t in_use_back,
+                                    std::size_t in_use_front) override {
+    UASSERT(old_p == data_);
+    std::string new_buffer(new_size, '\0');
+    auto* new_p = reinterpret_cast<std::uint8_t*>(new_buffer.data());
+    std::memcpy(new_p + new_size - in_use_back, old_p + old_size - in_use_back,
+                in_use_back);
+    std::memcpy(new_p, old_p, in_use_front);
+    buffer_ = std::move(new_buffer);
+    data_ = new_p;
+    return data_;
+  }
+
+  std::size_t GetCapacity() const noexcept {
+    return data_ ? buffer_.size() : 0;
+  }
+
+  /// Takes the buffer, the finished flatbuffer occupies its last `size` bytes
+  std::string Extract(std::size_t size) {
+    UASSERT(data_ && size <= buffer_.size());
+    // Moves the data to the front in place, no allocation happens
+    buffer_.erase(0, buffer_.size() - size);
+    data_ = nullptr;
+    return std::move(buffer_);
+  }
+
+ private:
+  std::string buffer_;
+  std::uint8_t* data_{nullptr};
+};
+
+/// flatbuffers::FlatBufferBuilder that is reused between the requests
+class FlatbufBuilder final {
+ public:
+  FlatbufBuilder()
+      : allocator_(std::make_unique<FlatbufStringAllocator>()),
+        builder_(kInitialSize, allocator_.get()) {}
+
+  FlatbufBuilder(FlatbufBuilder&&) = default;
+  FlatbufBuilder& operator=(FlatbufBuilder&&) = default;
+
+  /// Returns the builder ready for a new flatbuffer
+  flatbuffers::FlatBufferBuilder& Prepare() {
+    // Leftovers of a handler that has thrown
+    builder_.Clear();
+    return builder_;
+  }
+
+  /// Finishes the flatbuffer and returns its bytes
+  template <typename T>
+  std::string Finish(flatbuffers::Offset<T> root) {
+    builder_.Finish(root);
+    const auto size = builder_.GetSize();
+    const auto capacity = allocator_->GetCapacity();
+
+    if (size * 2 >= capacity) {
+      // The buffer is mostly filled, hand it over to the response. The builder
+      // allocates a new one on the next use.
+      // Deallocation of the released buffer is a noop after the extraction
+      const auto released = builder_.Release();
+      return allocator_->Extract(size);
+    }
+
+    // A small response in a large buffer, keep the buffer for the next
+    // requests unless it is too large to keep idle
+    std::string result(
+        reinterpret_cast<const char*>(builder_.GetBufferPointer()), size);
+    if (capacity > kMaxIdleCapacity) {
+      builder_.Release();
+    } else {
+      builder_.Clear();
+    }
+    return result;
+  }
+
+ private:
+  static constexpr std::size_t kInitialSize = 1024;
+  static constexpr std::size_t kMaxIdleCapacity = 64 * 1024;
+
+  // Declared before builder_, as the builder deallocates on destruction
+  std::unique_ptr<FlatbufStringAllocator> allocator_;
+  flatbuffers::FlatBufferBuilder builder_;
+};
+
+using FlatbufBuilderPool = concurrent::ObjectPool<FlatbufBuilder>;
+
+/// Verifies the request body and returns the root table that points into it
+template <typename InputType>
+const InputType& GetVerifiedFlatbufRoot(const http::HttpRequest& request) {
+  const auto& body = request.RequestBody();
+  flatbuffers::Verifier verifier(
+      reinterpret_cast<const std::uint8_t*>(body.data()), body.size());
+  if (!verifier.VerifyBuffer<InputType>(nullptr)) {
+    throw ClientError(
+        InternalMessage{"Invalid FlatBuffers format in request body"});
+  }
+  return *flatbuffers::GetRoot<InputType>(body.data());
+}
+
+}  // namespace server::handlers::impl
+
+USERVER_NAMESPACE_END
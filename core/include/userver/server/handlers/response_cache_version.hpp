@@ -0,0 +1,65 @@
+#pragma once
+
+/// @file userver/server/handlers/response_cache_version.hpp
+/// @brief @copybrief server::handlers::ResponseCacheVersion
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include <userver/cache/caching_component_base.hpp>
+#include <userver/concurrent/async_event_source.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+/// @brief Version of the data of a cache component that invalidates the
+/// cached responses of a handler on each cache update.
+///
+/// @code
+/// MyHandler::MyHandler(const components::ComponentConfig& config,
+///                      const components::ComponentContext& context)
+///     : HttpHandlerBase(config, context),
+///       cache_(context.FindComponent<MyCache>()),
+///       cache_version_(cache_) {}
+///
+/// std::optional<std::uint64_t> MyHandler::GetResponseCacheVersion(
+///     const server::http::HttpRequest&,
+///     server::request::RequestContext&) const {
+///   return cache_version_.Get();
+/// }
+/// @endcode
+///
+/// @see `response_cache` static option of server::handlers::HandlerBase
+class ResponseCacheVersion final {
+ public:
+  template <typename T>
+  explicit ResponseCacheVersion(components::CachingComponentBase<T>& cache)
+      : subscription_(cache.UpdateAndListen(
+            this, "response-cache-version",
+            &ResponseCacheVersion::OnCacheUpdate<T>)) {}
+
+  ResponseCacheVersion(const ResponseCacheVersion&) = delete;
+  ResponseCacheVersion& operator=(const ResponseCacheVersion&) = delete;
+
+  ~ResponseCacheVersion() { subscription_.Unsubscribe(); }
+
+  /// @returns the number of the cache updates so far
+  std::uint64_t Get() const noexcept {
+    return version_.load(std::memory_order_acquire);
+  }
+
+ private:
+  template <typename T>
+  void OnCacheUpdate(const std::shared_ptr<const T>&) {
+    version_.fetch_add(1, std::memory_order_release);
+  }
+
+  std::atomic<std::uint64_t> version_{0};
+  concurrent::AsyncEventSubscriberScope subscription_;
+};
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
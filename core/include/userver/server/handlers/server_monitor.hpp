@@ -3,6 +3,8 @@
 /// @file userver/server/handlers/server_monitor.hpp
 /// @brief @copybrief server::handlers::ServerMonitor
 
+#include <memory>
+
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 
@@ -39,12 +41,22 @@ namespace server::handlers {
 ///   be a JSON dictionary in the form '{"label1":"value1", "label2":"value2"}'.
 /// * path - return metrics on for the following path
 /// * prefix - return metrics whose path starts from the specified prefix.
+/// * delta - an identifier of the metrics consumer. Only the metrics that
+///   changed since the previous request with the same 'delta' are returned,
+///   see utils::statistics::MetricsDelta. Not supported by the internal
+///   format. At most 'max-delta-consumers' (16 by default) identifiers are
+///   remembered.
+///
+/// With the `response-body-stream: true` option the Prometheus formats are
+/// sent by parts as they are serialized, the whole response is never kept in
+/// memory. Use the `response_compression` option to compress the stream.
 
 // clang-format on
 class ServerMonitor final : public HttpHandlerBase {
  public:
   ServerMonitor(const components::ComponentConfig& config,
                 const components::ComponentContext& component_context);
+  ~ServerMonitor() override;
 
   /// @ingroup userver_component_names
   /// @brief The default name of server::handlers::ServerMonitor
@@ -53,6 +65,10 @@ class ServerMonitor final : public HttpHandlerBase {
   std::string HandleRequestThrow(const http::HttpRequest& request,
                                  request::RequestContext&) const override;
 
+  void HandleStreamRequest(const http::HttpRequest& request,
+                           request::RequestContext&,
+                           http::ResponseBodyStream& stream) const override;
+
   static yaml_config::Schema GetStaticConfigSchema();
 
  private:
@@ -60,10 +76,20 @@ class ServerMonitor final : public HttpHandlerBase {
       const http::HttpRequest& request, request::RequestContext& context,
       const std::string& response_data) const override;
 
+  struct ParsedRequest;
+  ParsedRequest ParseRequest(const http::HttpRequest& request) const;
+  std::string Serialize(const ParsedRequest& request) const;
+
   utils::statistics::Storage& statistics_storage_;
 
   using CommonLabels = std::unordered_map<std::string, std::string>;
   const CommonLabels common_labels_;
+
+  struct DeltaConsumers;
+  std::unique_ptr<DeltaConsumers> delta_consumers_;
+
+  // Names of the metrics are the same for the most of the scrapes
+  std::unique_ptr<utils::statistics::PrometheusNamesCache> prometheus_names_;
 };
 
 }  // namespace server::handlers
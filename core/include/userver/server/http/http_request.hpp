@@ -28,6 +28,7 @@ class Sockaddr;
 namespace server::http {
 
 class HttpRequestImpl;
+class RequestBodyStream;
 
 /// @brief HTTP Request data
 class HttpRequest final {
@@ -188,8 +189,17 @@ class HttpRequest final {
   CookiesMapKeys GetCookieNames() const;
 
   /// @return HTTP body.
+  /// @note Is empty if the body is streamed, see IsBodyStreamed().
   const std::string& RequestBody() const;
 
+  /// @return true if the body is delivered with GetBodyStream() instead of
+  /// RequestBody(), see the `request-body-stream` option of the handler.
+  bool IsBodyStreamed() const;
+
+  /// @return The stream to read the body while it is being received. For
+  /// the requests that are not streamed, returns a stream over RequestBody().
+  RequestBodyStream& GetBodyStream() const;
+
   /// @return HTTP headers.
   const HeadersMap& RequestHeaders() const;
 
@@ -0,0 +1,87 @@
+#pragma once
+
+/// @file userver/server/http/http_request_body_stream.hpp
+/// @brief @copybrief server::http::RequestBodyStream
+
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// @brief Thrown by server::http::RequestBodyStream if the body can not be
+/// read: the client has closed the connection before sending the whole body,
+/// the deadline has expired or the task was cancelled.
+class RequestBodyStreamException : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+/// @brief Body of an HTTP request that is read by the handler while it is
+/// being received.
+///
+/// Enabled by the `request-body-stream: true` static option of the handler.
+/// The handler starts right after the request headers are received, the body
+/// is not buffered and is not limited by `max_request_size`. If the handler
+/// reads the body slower than the client sends it, the server stops reading
+/// the connection until there is room for the next chunk.
+///
+/// The body is delivered as it was sent by the client, without the request
+/// decompression and without parsing the args or the multipart/form-data from
+/// it; see server::http::MultipartFormDataStream for the latter.
+///
+/// If the handler does not read the body to the end, the rest of it is
+/// skipped after the response is sent.
+///
+/// For the requests that are not streamed, e.g. received over HTTP/2, the
+/// stream returns the whole already received body as a single chunk.
+///
+/// @see server::http::HttpRequest::GetBodyStream
+class RequestBodyStream final {
+ public:
+  /// @cond
+  using Queue = concurrent::StringStreamQueue;
+
+  // For internal use only
+  explicit RequestBodyStream(Queue::Consumer&& consumer);
+  explicit RequestBodyStream(std::string_view buffered_body);
+  /// @endcond
+
+  RequestBodyStream(RequestBodyStream&&) noexcept;
+  ~RequestBodyStream();
+
+  /// @brief Reads the next part of the body into `chunk`, any previous data
+  /// in `chunk` is dropped.
+  /// @returns false if the whole body has been read
+  /// @throws RequestBodyStreamException if the body can not be read
+  /// @note The chunks do not match the chunks of the chunked transfer encoding
+  /// or the reads from the socket.
+  bool ReadChunk(std::string& chunk, engine::Deadline deadline = {});
+
+  /// @brief Reads the rest of the body.
+  /// @throws RequestBodyStreamException if the body can not be read
+  std::string ReadAll(engine::Deadline deadline = {});
+
+  /// @returns true if the whole body has been read
+  bool IsFinished() const noexcept { return is_finished_; }
+
+  /// @returns the number of body bytes read so far
+  std::size_t GetReadBytes() const noexcept { return read_bytes_; }
+
+ private:
+  std::optional<Queue::Consumer> consumer_;
+  std::string_view buffered_body_;
+  std::size_t read_bytes_{0};
+  bool is_finished_{false};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -27,6 +27,8 @@ namespace impl {
 void OutputHeader(USERVER_NAMESPACE::http::headers::HeadersString& header,
                   std::string_view key, std::string_view val);
 
+class Http2ResponseWriter;
+
 }  // namespace impl
 
 class HttpRequestImpl;
@@ -138,6 +140,8 @@ class HttpResponse final : public request::ResponseBase {
   Queue::Producer GetBodyProducer();
 
  private:
+  friend class impl::Http2ResponseWriter;
+
   // Returns total size of the response
   std::size_t SetBodyStreamed(
       engine::io::RwBase& socket,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <string>
 
 #include <userver/server/http/http_response.hpp>
@@ -13,9 +14,14 @@ class HttpHandlerBase;
 
 namespace server::http {
 
+namespace impl {
+class ResponseStreamCompressor;
+}  // namespace impl
+
 class ResponseBodyStream final {
  public:
-  ResponseBodyStream(ResponseBodyStream&&) = default;
+  ResponseBodyStream(ResponseBodyStream&&) noexcept;
+  ~ResponseBodyStream();
 
   // Send a chunk of response data. It may NOT generate
   // exactly one HTTP chunk per call to PushBodyChunk().
@@ -36,11 +42,13 @@ class ResponseBodyStream final {
 
   ResponseBodyStream(
       server::http::HttpResponse::Queue::Producer&& queue_producer,
-      server::http::HttpResponse& http_response);
+      server::http::HttpResponse& http_response,
+      std::unique_ptr<impl::ResponseStreamCompressor> compressor);
 
   bool headers_ended_{false};
   HttpResponse::Queue::Producer queue_producer_;
   server::http::HttpResponse& http_response_;
+  std::unique_ptr<impl::ResponseStreamCompressor> compressor_;
 };
 
 }  // namespace server::http
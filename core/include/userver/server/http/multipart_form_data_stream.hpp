@@ -0,0 +1,122 @@
+#pragma once
+
+/// @file userver/server/http/multipart_form_data_stream.hpp
+/// @brief @copybrief server::http::MultipartFormDataStream
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/server/http/http_request_body_stream.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// @brief Reads the parts of a streamed multipart/form-data request body one
+/// by one, without buffering the values of the parts.
+///
+/// @code
+/// MultipartFormDataStream form{
+///     request.GetHeader(http::headers::kContentType),
+///     request.GetBodyStream()};
+/// std::string chunk;
+/// while (auto part = form.NextPart()) {
+///   while (form.ReadPartChunk(chunk)) {
+///     // write the chunk of part->filename somewhere
+///   }
+/// }
+/// @endcode
+///
+/// ReadPartPiece() gives the value without copying it out of the internal
+/// buffer, and ReadPartToFile() writes the value to a file. Use either of them
+/// for large uploads, e.g. to write a file into a fs::TempFile:
+///
+/// @code
+/// auto file = fs::TempFile::Create(fs_task_processor);
+/// const auto size = form.ReadPartToFile(fs_task_processor, file.GetPath());
+/// @endcode
+///
+/// Unlike the parsing of the buffered bodies, only the "\r\n" line breaks are
+/// accepted.
+///
+/// @see server::http::RequestBodyStream
+class MultipartFormDataStream final {
+ public:
+  /// @brief Headers of the multipart/form-data part
+  struct Part {
+    std::string name;
+    std::string content_disposition;
+    std::optional<std::string> filename;
+    std::optional<std::string> content_type;
+  };
+
+  /// @throws RequestBodyStreamException if the `content_type` is not a
+  /// multipart/form-data one with a boundary
+  MultipartFormDataStream(std::string_view content_type,
+                          RequestBodyStream& body);
+
+  /// @brief Skips the rest of the current part and reads the headers of the
+  /// next part.
+  /// @returns std::nullopt after the last part
+  /// @throws RequestBodyStreamException if the body is malformed or can not be
+  /// read
+  std::optional<Part> NextPart(engine::Deadline deadline = {});
+
+  /// @brief Reads the next piece of the value of the current part into
+  /// `chunk`, any previous data in `chunk` is dropped.
+  /// @returns false at the end of the part value
+  /// @throws RequestBodyStreamException if the body is malformed or can not be
+  /// read
+  bool ReadPartChunk(std::string& chunk, engine::Deadline deadline = {});
+
+  /// @brief Same as ReadPartChunk(), but the `piece` points into the internal
+  /// buffer and is valid until the next call to any of the methods.
+  /// @returns false at the end of the part value
+  /// @throws RequestBodyStreamException if the body is malformed or can not be
+  /// read
+  bool ReadPartPiece(std::string_view& piece, engine::Deadline deadline = {});
+
+  /// @brief Writes the rest of the value of the current part to the end of
+  /// the file at `path`, creating the file if needed. The file is written
+  /// in `fs_task_processor`.
+  /// @returns the number of bytes written
+  /// @throws RequestBodyStreamException if the body is malformed or can not be
+  /// read
+  /// @throws std::runtime_error if the file can not be written
+  std::size_t ReadPartToFile(engine::TaskProcessor& fs_task_processor,
+                             const std::string& path,
+                             engine::Deadline deadline = {});
+
+ private:
+  enum class State {
+    kPreamble,
+    kAfterDelimiter,
+    kValue,
+    kFinished,
+  };
+
+  // Returns false at the end of the body
+  bool ReadMore(engine::Deadline deadline);
+  // Drops the piece returned by ReadPartPiece from the buffer
+  void ConsumePiece();
+  std::size_t FindDelimiter() const noexcept;
+  void ReadAtLeast(std::size_t size, engine::Deadline deadline);
+  void SkipBeforeDelimiter(engine::Deadline deadline);
+  bool ParseAfterDelimiter(engine::Deadline deadline);
+  Part ParseHeaders(engine::Deadline deadline);
+
+  RequestBodyStream& body_;
+  const std::string delimiter_;
+  std::string buffer_;
+  std::string body_chunk_;
+  std::size_t piece_size_{0};
+  State state_{State::kPreamble};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
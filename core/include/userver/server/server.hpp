@@ -57,6 +57,8 @@ class Server final : public congestion_control::Limitee {
 
   void SetLimit(std::optional<size_t> new_limit) override;
 
+  void SetShedLevel(std::size_t shed_level) override;
+
   void SetRpsRatelimit(std::optional<size_t> rps);
 
   void SetRpsRatelimitStatusCode(http::HttpStatus status_code);
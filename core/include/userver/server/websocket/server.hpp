@@ -5,6 +5,8 @@
 
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
 
 #include <userver/engine/io/socket.hpp>
 #include <userver/server/http/http_request.hpp>
@@ -48,6 +50,7 @@ class WebSocketConnectionImpl;
 struct Config final {
   unsigned max_remote_payload = 65536;
   unsigned fragment_size = 65536;  // 0 - do not fragment
+  bool permessage_deflate = false;
 };
 
 Config Parse(const yaml_config::YamlConfig&, formats::parse::To<Config>);
@@ -59,6 +62,25 @@ struct Statistics final {
   std::atomic<int64_t> bytes_recv{0};
 };
 
+/// @brief Data message serialized into a WebSocket frame once, to be sent to
+/// many connections without copying it for each of them.
+///
+/// The frame is never compressed or fragmented, even if the connection
+/// negotiated permessage-deflate or has `fragment-size` set.
+class PreparedMessage final {
+ public:
+  PreparedMessage(std::string_view data, bool is_text);
+
+  /// Size of the message data
+  std::size_t PayloadSize() const noexcept { return payload_size_; }
+
+ private:
+  friend class WebSocketConnectionImpl;
+
+  std::string frame_;
+  std::size_t payload_size_;
+};
+
 /// @brief Main class for Websocket connection
 class WebSocketConnection {
  public:
@@ -91,6 +113,11 @@ class WebSocketConnection {
   virtual void Send(const Message& message) = 0;
   virtual void SendText(std::string_view message) = 0;
 
+  /// @brief Send a message serialized beforehand.
+  /// @throws engine::io::IoException in case of socket errors
+  /// @note The same thread-safety rules as for Send() apply.
+  virtual void SendPrepared(const PreparedMessage& message) = 0;
+
   template <typename ContiguousContainer>
   void SendBinary(const ContiguousContainer& message) {
     static_assert(sizeof(typename ContiguousContainer::value_type) == 1,
@@ -111,6 +138,15 @@ class WebSocketConnection {
   virtual void DoSendBinary(utils::span<const std::byte> message) = 0;
 };
 
+/// @brief Send the message to each of the connections, one after another.
+///
+/// Socket errors of a connection are logged and do not prevent sending the
+/// message to the rest of them. The caller must not Send() to these
+/// connections concurrently.
+/// @returns the number of connections the message was sent to
+std::size_t Broadcast(const PreparedMessage& message,
+                      utils::span<WebSocketConnection* const> connections);
+
 std::shared_ptr<WebSocketConnection> MakeWebSocket(
     std::unique_ptr<engine::io::RwBase>&& socket,
     engine::io::Sockaddr&& peer_name, const Config& config);
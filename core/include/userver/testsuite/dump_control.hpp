@@ -30,6 +30,10 @@ class DumpControl final {
 
   void ReadCacheDumps(const std::vector<std::string>& dumper_names);
 
+  /// @brief Writes a snapshot of the dumper, see dump::Dumper::WriteSnapshot
+  /// @returns `false` if there is no such dumper
+  bool WriteSnapshot(const std::string& dumper_name, dump::Writer& writer);
+
  private:
   friend class DumperRegistrationHolder;
 
@@ -39,6 +43,8 @@ class DumpControl final {
 
   dump::Dumper& FindDumper(const std::string& name) const;
 
+  dump::Dumper* FindDumperOptional(const std::string& name) const;
+
   PeriodicsMode periodics_mode_;
   concurrent::Variable<
       std::unordered_map<std::string, utils::NotNull<dump::Dumper*>>>
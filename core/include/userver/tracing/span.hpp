@@ -177,6 +177,9 @@ class Span final {
   const std::string& GetSpanId() const;
   const std::string& GetParentId() const;
 
+  /// Name of the span, as passed on construction
+  const std::string& GetName() const;
+
   /// @returns true if this span would be logged with the current local and
   /// global log levels to the default logger.
   bool ShouldLogDefault() const noexcept;
@@ -0,0 +1,31 @@
+#pragma once
+
+/// @file userver/tracing/span_exporter.hpp
+/// @brief @copybrief tracing::SpanExporter
+
+#include <string>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+/// @brief Base class for the exporters that receive finished tracing::Span
+/// directly, without going through the text logs.
+///
+/// Every finished span that is written to the logs is also handed over to
+/// the exporter set by tracing::Tracer::SetSpanExporter, encoded as an
+/// OpenTelemetry `opentelemetry.proto.trace.v1.Span` protobuf message.
+///
+/// Export() is called from the tracing::Span destructor, possibly from
+/// multiple threads at once and outside of coroutines, so it must be
+/// thread-safe and must not block.
+class SpanExporter {
+ public:
+  virtual ~SpanExporter();
+
+  virtual void Export(std::string&& otlp_span) noexcept = 0;
+};
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -16,12 +16,17 @@ class TagWriter;
 namespace tracing {
 
 struct NoLogSpans;
+class SpanExporter;
 
 class Tracer : public std::enable_shared_from_this<Tracer> {
  public:
   static void SetNoLogSpans(NoLogSpans&& spans);
   static bool IsNoLogSpan(const std::string& name);
 
+  /// Sets the exporter for all the finished spans, nullptr disables export
+  static void SetSpanExporter(std::shared_ptr<SpanExporter> exporter);
+  static std::shared_ptr<SpanExporter> GetSpanExporter();
+
   static void SetTracer(TracerPtr tracer);
 
   static TracerPtr GetTracer();
@@ -41,7 +41,7 @@ struct SpanWrapCall {
 
   struct Impl;
 
-  static constexpr std::size_t kImplSize = 4264;
+  static constexpr std::size_t kImplSize = 4304;
   static constexpr std::size_t kImplAlign = 8;
   utils::FastPimpl<Impl, kImplSize, kImplAlign> pimpl_;
 };
@@ -433,6 +433,46 @@ template <typename Function, typename... Args>
       std::forward<Function>(f), std::forward<Args>(args)...);
 }
 
+/// @overload
+/// @ingroup userver_concurrency
+///
+/// Tasks with higher `priority` are started first when the task processor is
+/// busy.
+///
+/// @param tasks_processor Task processor to run on
+/// @param name Name of the task to show in logs
+/// @param priority Priority of the task in the task processor queue
+/// @param f Function to execute asynchronously
+/// @param args Arguments to pass to the function
+/// @returns engine::TaskWithResult
+template <typename Function, typename... Args>
+[[nodiscard]] auto Async(engine::TaskProcessor& task_processor,
+                         std::string name, engine::Task::Priority priority,
+                         Function&& f, Args&&... args) {
+  return engine::AsyncNoSpan(
+      task_processor, priority, impl::SpanLazyPrvalue(std::move(name)),
+      std::forward<Function>(f), std::forward<Args>(args)...);
+}
+
+/// @overload
+/// @ingroup userver_concurrency
+///
+/// Tasks with higher `priority` are started first when the task processor is
+/// busy.
+///
+/// @param name Name of the task to show in logs
+/// @param priority Priority of the task in the task processor queue
+/// @param f Function to execute asynchronously
+/// @param args Arguments to pass to the function
+/// @returns engine::TaskWithResult
+template <typename Function, typename... Args>
+[[nodiscard]] auto Async(std::string name, engine::Task::Priority priority,
+                         Function&& f, Args&&... args) {
+  return utils::Async(engine::current_task::GetTaskProcessor(), std::move(name),
+                      priority, std::forward<Function>(f),
+                      std::forward<Args>(args)...);
+}
+
 /// @ingroup userver_concurrency
 ///
 /// Starts an asynchronous task without propagating
@@ -0,0 +1,61 @@
+#pragma once
+
+/// @file userver/utils/current_arena.hpp
+/// @brief @copybrief utils::CurrentArenaScope
+
+#include <userver/utils/arena.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// @ingroup userver_concurrency
+///
+/// @brief Makes the utils::Arena current for the current task for the
+/// lifetime of the scope.
+///
+/// The code that allocates a lot of short living objects may use
+/// utils::GetCurrentArena() or utils::GetCurrentMemoryResource() to allocate
+/// them from the arena of the caller, e.g. from the arena of the request,
+/// see server::handlers::HttpHandlerBase. The scopes may be nested, the
+/// previous arena becomes current again at the end of the scope. The arena is
+/// not inherited by the subtasks.
+///
+/// @snippet utils/current_arena_test.cpp  Sample utils::CurrentArenaScope usage
+class CurrentArenaScope final {
+ public:
+  /// @note Must be called from a coroutine
+  explicit CurrentArenaScope(Arena& arena);
+  ~CurrentArenaScope();
+
+  CurrentArenaScope(CurrentArenaScope&&) = delete;
+  CurrentArenaScope& operator=(CurrentArenaScope&&) = delete;
+
+ private:
+  friend Arena* GetCurrentArena() noexcept;
+#ifdef USERVER_IMPL_HAS_MEMORY_RESOURCE
+  friend std::pmr::memory_resource* GetCurrentMemoryResource() noexcept;
+#endif
+
+  Arena& arena_;
+#ifdef USERVER_IMPL_HAS_MEMORY_RESOURCE
+  ArenaMemoryResource resource_;
+#endif
+  CurrentArenaScope* const previous_;
+};
+
+/// @brief Returns the arena of the innermost utils::CurrentArenaScope of the
+/// current task, or `nullptr` if there is none or if called outside of a
+/// coroutine
+Arena* GetCurrentArena() noexcept;
+
+#ifdef USERVER_IMPL_HAS_MEMORY_RESOURCE
+/// @brief Returns the memory resource of the innermost
+/// utils::CurrentArenaScope of the current task, or
+/// `std::pmr::get_default_resource()` if there is none
+std::pmr::memory_resource* GetCurrentMemoryResource() noexcept;
+#endif
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,75 @@
+#pragma once
+
+/// @file userver/utils/keyed_rate_limiter.hpp
+/// @brief @copybrief utils::KeyedRateLimiter
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// @ingroup userver_concurrency
+///
+/// @brief Thread safe ratelimiter with a separate token bucket for each key,
+/// e.g. for each client.
+///
+/// A bucket is a single atomic that is refilled lazily on access, so the
+/// idle keys cost nothing but memory. The keys are spread over independently
+/// locked shards, the new keys do not copy the already known ones. Obtaining
+/// a token of a known key takes a shared lock of its shard and a single
+/// compare-and-swap.
+///
+/// The buckets that have refilled completely are indistinguishable from the
+/// new ones, they are removed from time to time as the new keys are added and
+/// on EvictIdle() calls.
+///
+/// Must be used from coroutines.
+class KeyedRateLimiter final {
+ public:
+  using Duration = std::chrono::steady_clock::duration;
+
+  struct Config {
+    /// Tokens added to each bucket per second, must be positive
+    double tokens_per_second{1};
+    /// Bucket size, maximum number of tokens a key may obtain at once after
+    /// being idle
+    std::size_t max_size{1};
+    /// Number of the independently locked parts of the keys
+    std::size_t shards{64};
+  };
+
+  explicit KeyedRateLimiter(const Config& config);
+  ~KeyedRateLimiter();
+
+  KeyedRateLimiter(const KeyedRateLimiter&) = delete;
+  KeyedRateLimiter& operator=(const KeyedRateLimiter&) = delete;
+
+  /// @returns true if `count` tokens were obtained from the bucket of `key`
+  [[nodiscard]] bool Obtain(std::string_view key, std::size_t count = 1);
+
+  /// Removes the buckets that have refilled completely
+  /// @returns the number of the removed keys
+  std::size_t EvictIdle();
+
+  /// @returns the number of the keys with buckets, might be inaccurate as the
+  /// result is stale
+  std::size_t GetKeysCountApprox() const;
+
+ private:
+  struct Shard;
+
+  Shard& GetShard(std::string_view key) const noexcept;
+
+  const Duration refill_interval_;
+  const std::size_t max_size_;
+  const std::size_t shards_count_;
+  const std::unique_ptr<Shard[]> shards_;
+};
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
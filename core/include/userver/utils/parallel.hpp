@@ -0,0 +1,237 @@
+#pragma once
+
+/// @file userver/utils/parallel.hpp
+/// @brief Data-parallel algorithms over random-access ranges:
+/// utils::ParallelFor, utils::ParallelTransformReduce, utils::ParallelSort
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// Settings of utils::ParallelFor and friends
+struct ParallelSettings final {
+  /// Task processor to start the helper tasks on, the current one if not set
+  engine::TaskProcessor* task_processor{nullptr};
+
+  /// Maximum number of tasks processing the range at once, including the
+  /// caller. 0 means the number of worker threads of the task processor.
+  std::size_t max_concurrency{0};
+
+  /// Minimum number of elements processed by a task at once. Increase it if
+  /// the processing of an element is cheap.
+  std::size_t min_chunk_size{1};
+
+  /// The processing of the range is interrupted when the deadline expires
+  engine::Deadline deadline{};
+};
+
+namespace impl {
+
+// Number of the tasks to process `size` elements with, including the caller
+std::size_t GetParallelism(std::size_t size, const ParallelSettings& settings);
+
+// Splits [0, size) into chunks claimed by the tasks dynamically: a chunk is
+// a fraction of the remaining elements, so the chunks are large at the
+// start and small at the end to balance the tasks.
+class ParallelScheduler final {
+ public:
+  ParallelScheduler(std::size_t size, const ParallelSettings& settings);
+
+  ParallelScheduler(ParallelScheduler&&) = delete;
+  ParallelScheduler& operator=(ParallelScheduler&&) = delete;
+
+  std::size_t GetWorkerCount() const noexcept { return worker_count_; }
+
+  // Calls `func(begin, end, worker)` for the chunks of the range, in the
+  // current task (worker 0) and in GetWorkerCount() - 1 helper tasks.
+  // The chunks of a worker are processed sequentially.
+  template <typename ChunkFunc>
+  void Run(const ChunkFunc& func);
+
+ private:
+  struct Chunk final {
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  std::optional<Chunk> NextChunk(std::size_t worker) noexcept;
+  void SetException(std::exception_ptr exception) noexcept;
+  void Interrupt(engine::TaskCancellationReason reason) noexcept;
+  void Join(std::vector<engine::TaskWithResult<void>>& helpers);
+
+  engine::TaskProcessor& task_processor_;
+  const std::size_t size_;
+  const std::size_t min_chunk_size_;
+  const std::size_t worker_count_;
+  const engine::Deadline deadline_;
+
+  std::atomic<std::size_t> next_{0};
+  std::atomic<bool> stopped_{false};
+  std::atomic<bool> has_exception_{false};
+  std::exception_ptr exception_;
+  std::atomic<engine::TaskCancellationReason> interrupt_reason_{
+      engine::TaskCancellationReason::kNone};
+};
+
+template <typename ChunkFunc>
+void ParallelScheduler::Run(const ChunkFunc& func) {
+  const auto work = [this, &func](std::size_t worker) {
+    try {
+      while (const auto chunk = NextChunk(worker)) {
+        func(chunk->begin, chunk->end, worker);
+      }
+    } catch (const std::exception&) {
+      SetException(std::current_exception());
+    }
+  };
+
+  std::vector<engine::TaskWithResult<void>> helpers;
+  helpers.reserve(worker_count_ - 1);
+  for (std::size_t worker = 1; worker < worker_count_; ++worker) {
+    helpers.push_back(utils::Async(task_processor_, "parallel",
+                                   [&work, worker] { work(worker); }));
+  }
+
+  // The caller processes the chunks too, instead of just waiting
+  work(0);
+  Join(helpers);
+}
+
+}  // namespace impl
+
+/// @ingroup userver_concurrency
+///
+/// @brief Calls `func(element)` for each element of [first, last) in several
+/// tasks at once.
+///
+/// The current task takes part in the processing, and up to
+/// ParallelSettings::max_concurrency - 1 helper tasks are started on
+/// ParallelSettings::task_processor, so `func` must be safe to call
+/// concurrently for different elements. The elements are claimed by the tasks
+/// in chunks of decreasing size, so that the tasks finish at about the same
+/// time even if the cost of the elements varies.
+///
+/// @throws the first exception thrown by `func`, the rest of the elements
+/// may or may not be processed
+/// @throws engine::WaitInterruptedException if the current task is cancelled
+/// or ParallelSettings::deadline expires, the rest of the elements is not
+/// processed
+template <typename RandomIt, typename Func>
+void ParallelFor(RandomIt first, RandomIt last, const Func& func,
+                 const ParallelSettings& settings = {}) {
+  impl::ParallelScheduler scheduler(std::distance(first, last), settings);
+  scheduler.Run(
+      [first, &func](std::size_t begin, std::size_t end, std::size_t) {
+        for (auto it = first + begin; it != first + end; ++it) {
+          func(*it);
+        }
+      });
+}
+
+/// @ingroup userver_concurrency
+///
+/// @brief Reduces `init` and the results of `transform(element)` for the
+/// elements of [first, last) with `reduce`, in several tasks at once.
+///
+/// `reduce` must be associative and commutative, the elements are reduced in
+/// no particular order. See utils::ParallelFor for the details of the
+/// parallel processing and the exceptions.
+template <typename RandomIt, typename T, typename Reduce, typename Transform>
+T ParallelTransformReduce(RandomIt first, RandomIt last, T init,
+                          const Reduce& reduce, const Transform& transform,
+                          const ParallelSettings& settings = {}) {
+  impl::ParallelScheduler scheduler(std::distance(first, last), settings);
+  std::vector<std::optional<T>> partial(scheduler.GetWorkerCount());
+  scheduler.Run([first, &reduce, &transform, &partial](
+                    std::size_t begin, std::size_t end, std::size_t worker) {
+    auto& accumulator = partial[worker];
+    for (auto it = first + begin; it != first + end; ++it) {
+      if (accumulator) {
+        *accumulator = reduce(std::move(*accumulator), transform(*it));
+      } else {
+        accumulator.emplace(transform(*it));
+      }
+    }
+  });
+
+  for (auto& accumulator : partial) {
+    if (accumulator) init = reduce(std::move(init), std::move(*accumulator));
+  }
+  return init;
+}
+
+/// @ingroup userver_concurrency
+///
+/// @brief Sorts [first, last) with `comp` in several tasks at once.
+///
+/// The range is split into ParallelSettings::max_concurrency parts that are
+/// sorted concurrently and then merged pairwise, also concurrently. The sort
+/// is not stable. See utils::ParallelFor for the details of the parallel
+/// processing and the exceptions, the range is left in an unspecified order
+/// on an exception.
+template <typename RandomIt, typename Compare = std::less<>>
+void ParallelSort(RandomIt first, RandomIt last, Compare comp = {},
+                  const ParallelSettings& settings = {}) {
+  // Sorting a smaller part is faster than starting a task for it
+  constexpr std::size_t kMinPartSize = 1024;
+
+  const std::size_t size = std::distance(first, last);
+  auto part_settings = settings;
+  part_settings.min_chunk_size = 1;
+
+  const std::size_t parts = impl::GetParallelism(
+      size / std::max(settings.min_chunk_size, kMinPartSize), part_settings);
+  if (parts <= 1) {
+    std::sort(first, last, comp);
+    return;
+  }
+
+  const auto bound = [first, size, parts](std::size_t part) {
+    return first + size * std::min(part, parts) / parts;
+  };
+
+  std::vector<std::size_t> part_indices(parts);
+  for (std::size_t part = 0; part < parts; ++part) part_indices[part] = part;
+
+  ParallelFor(
+      part_indices.begin(), part_indices.end(),
+      [&bound, &comp](std::size_t part) {
+        std::sort(bound(part), bound(part + 1), comp);
+      },
+      part_settings);
+
+  for (std::size_t width = 1; width < parts; width *= 2) {
+    std::vector<std::size_t> merges;
+    for (std::size_t part = 0; part + width < parts; part += 2 * width) {
+      merges.push_back(part);
+    }
+    ParallelFor(
+        merges.begin(), merges.end(),
+        [&bound, &comp, width](std::size_t part) {
+          std::inplace_merge(bound(part), bound(part + width),
+                             bound(part + 2 * width), comp);
+        },
+        part_settings);
+  }
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 /// @brief @copybrief utils::PeriodicTask
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <random>
@@ -18,6 +19,8 @@
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/flags.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/relaxed_counter.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -53,6 +56,10 @@ class PeriodicTask final {
     /// Subtasks that may be spawned in the callback
     /// are not critical by default and may be cancelled as usual.
     kCritical = 1 << 4,
+    /// Delay the first wait by a random part of the period, so that the tasks
+    /// of the service instances started at the same time are spread over the
+    /// period instead of loading the downstream services at the same moments
+    kRandomStart = 1 << 5,
   };
 
   /// Configuration parameters for PeriodicTask.
@@ -119,6 +126,19 @@ class PeriodicTask final {
   /// Signature of the task to be executed each period.
   using Callback = std::function<void()>;
 
+  /// Statistics of the callback executions, see also DumpMetric
+  struct Statistics final {
+    /// Number of the callback executions
+    utils::statistics::RelaxedCounter<std::uint64_t> runs{0};
+    /// Number of the callback executions that ended with an exception
+    utils::statistics::RelaxedCounter<std::uint64_t> failures{0};
+    /// Total time spent in the callback
+    utils::statistics::RelaxedCounter<std::uint64_t> run_time_us{0};
+    /// Delay of the last scheduled execution past the planned time, grows
+    /// when the task processor is overloaded
+    utils::statistics::RelaxedCounter<std::uint64_t> last_lag_us{0};
+  };
+
   /// Default constructor that does nothing.
   PeriodicTask();
 
@@ -194,6 +214,9 @@ class PeriodicTask final {
   /// Get current settings. Note that they might become stale very quickly.
   Settings GetCurrentSettings() const;
 
+  /// Get the statistics of the callback executions since the construction
+  const Statistics& GetStatistics() const noexcept { return statistics_; }
+
  private:
   enum class SuspendState { kRunning, kSuspended };
 
@@ -208,6 +231,8 @@ class PeriodicTask final {
   bool DoStep();
 
   std::chrono::milliseconds MutatePeriod(std::chrono::milliseconds period);
+  static std::chrono::milliseconds MakeRandomStartDelay(
+      std::chrono::milliseconds period);
 
   rcu::Variable<std::string> name_;
   Callback callback_;
@@ -222,8 +247,12 @@ class PeriodicTask final {
   std::atomic<SuspendState> suspend_state_;
 
   std::optional<testsuite::PeriodicTaskRegistrationHolder> registration_holder_;
+  Statistics statistics_;
 };
 
+void DumpMetric(utils::statistics::Writer& writer,
+                const PeriodicTask::Statistics& stats);
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
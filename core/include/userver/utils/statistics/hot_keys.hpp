@@ -0,0 +1,139 @@
+#pragma once
+
+/// @file userver/utils/statistics/hot_keys.hpp
+/// @brief @copybrief utils::statistics::HotKeys
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/concurrent/sharded_variable.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// Settings of utils::statistics::HotKeys
+struct HotKeysSettings {
+  /// Max keys tracked by each of the shards, the keys that are rarer than
+  /// 1/capacity of the accesses may be missed
+  std::size_t capacity{64};
+
+  /// One of this many accesses is accounted
+  std::size_t sample_rate{16};
+};
+
+/// A frequently accessed key with its estimated access count
+struct HotKey {
+  std::string key;
+  /// Upper estimate of the accesses
+  std::uint64_t count{0};
+  /// Max overestimation of the count, the key has at least
+  /// `count - error` accesses
+  std::uint64_t error{0};
+};
+
+/// Keys of these types may be passed to HotKeys::Account
+template <typename Key>
+inline constexpr bool kIsHotKeyTrackable =
+    std::is_convertible_v<const Key&, std::string_view> ||
+    fmt::is_formattable<Key>::value;
+
+namespace impl {
+
+/// Space-Saving heavy hitters summary of a fixed capacity
+class SpaceSaving final {
+ public:
+  explicit SpaceSaving(std::size_t capacity);
+
+  void Account(std::string_view key);
+
+  /// Halves all the counts
+  void Decay();
+
+  std::uint64_t GetTotal() const noexcept { return total_; }
+
+  /// Adds the counts to `keys`, the summaries of the shards are merged by
+  /// summing them up
+  void MergeInto(std::unordered_map<std::string, HotKey>& keys) const;
+
+ private:
+  struct Counter {
+    std::uint64_t count{0};
+    std::uint64_t error{0};
+  };
+
+  std::size_t capacity_;
+  std::uint64_t total_{0};
+  std::unordered_map<std::string, Counter> counters_;
+};
+
+}  // namespace impl
+
+/// @ingroup userver_concurrency
+///
+/// @brief Detector of the most frequently accessed keys with a cheap hot
+/// path.
+///
+/// A sampled share of the accesses is accounted into Space-Saving summaries,
+/// one per thread shard, so the hot path rarely contends. The summaries are
+/// merged on GetTop(). The counts are estimated for all the accesses, i.e.
+/// scaled by the sample rate.
+///
+/// The counts keep growing unless Decay() is called,
+/// components::HotKeysStorage calls it periodically for the detectors it
+/// holds.
+class HotKeys final {
+ public:
+  explicit HotKeys(HotKeysSettings settings = {});
+
+  /// @brief Accounts an access to the key. The key is formatted only if the
+  /// access is sampled.
+  template <typename Key>
+  void Account(const Key& key);
+
+  /// @returns up to `limit` most frequently accessed keys, the most frequent
+  /// first
+  std::vector<HotKey> GetTop(std::size_t limit) const;
+
+  /// @returns the estimated count of the accesses, halved on each Decay()
+  std::uint64_t GetTotal() const;
+
+  /// Halves the counts, so that the top reflects the recent accesses
+  void Decay();
+
+  const HotKeysSettings& GetSettings() const noexcept { return settings_; }
+
+ private:
+  bool ShouldSample() const;
+
+  void DoAccount(std::string_view key);
+
+  const HotKeysSettings settings_;
+  concurrent::ShardedVariable<impl::SpaceSaving> shards_;
+};
+
+template <typename Key>
+void HotKeys::Account(const Key& key) {
+  static_assert(kIsHotKeyTrackable<Key>,
+                "Hot keys are strings or are formattable with fmt");
+  if (!ShouldSample()) return;
+  if constexpr (std::is_convertible_v<const Key&, std::string_view>) {
+    DoAccount(key);
+  } else {
+    DoAccount(fmt::to_string(key));
+  }
+}
+
+void DumpMetric(Writer& writer, const HotKeys& hot_keys);
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,113 @@
+#pragma once
+
+/// @file userver/utils/statistics/log_histogram.hpp
+/// @brief @copybrief utils::statistics::LogHistogram
+
+#include <cstdint>
+#include <memory>
+
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/histogram_view.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/// Bucket layout of utils::statistics::LogHistogram
+struct LogHistogramSettings final {
+  /// Values not greater than this fall into the first bucket
+  double min_value{1};
+
+  /// Values greater than this (rounded up to a bucket bound) fall into the
+  /// "infinity" bucket
+  double max_value{100'000};
+
+  /// Bound for the relative error of GetQuantile, in (0, 1)
+  double relative_error{0.05};
+};
+
+/// @brief A histogram with exponentially growing buckets that estimates
+/// quantiles with a bounded relative error.
+///
+/// Bucket bounds are `min_value * gamma^i`, where
+/// `gamma = (1 + relative_error) / (1 - relative_error)`, so any value within
+/// `[min_value, max_value]` is estimated by GetQuantile with at most
+/// `relative_error` relative error (the DDSketch scheme). For example,
+/// the default settings give 117 buckets for values from 1 to 100'000 with 5%
+/// error.
+///
+/// Account finds the bucket in O(1) with a single logarithm and is lock-free,
+/// so the histogram is suitable for timings that are recorded very often.
+///
+/// ## LogHistogram vs utils::statistics::Percentile
+///
+/// Unlike `Percentile`, LogHistogram takes memory proportional to the
+/// logarithm of the value range, is summed across instances and hosts
+/// by adding up the buckets, and is written as a regular histogram metric
+/// (see utils::statistics::Histogram for the details of the metric
+/// semantics). It can be used as both the counter and the result type of
+/// utils::statistics::RecentPeriod with the default settings.
+///
+/// @warning Solomon accepts at most 50 histogram buckets, choose the settings
+/// accordingly, e.g. `relative_error` of 0.1 for values from 1 to 10'000.
+class LogHistogram final {
+ public:
+  explicit LogHistogram(LogHistogramSettings settings = {});
+
+  LogHistogram(LogHistogram&&) noexcept;
+  LogHistogram(const LogHistogram&);
+  LogHistogram& operator=(LogHistogram&&) noexcept;
+  LogHistogram& operator=(const LogHistogram&);
+  ~LogHistogram();
+
+  /// Atomically increment the bucket corresponding to the given value.
+  void Account(double value, std::uint64_t count = 1) noexcept;
+
+  /// @brief Atomically add the counters of another histogram.
+  /// @throws std::exception if the histograms have different settings
+  void Add(const LogHistogram& other);
+
+  /// @overload
+  LogHistogram& operator+=(const LogHistogram& other);
+
+  /// @brief Estimates the value at `quantile` (from 0 to 1) of the accounted
+  /// values, returns 0 for an empty histogram.
+  ///
+  /// Values below `min_value` are estimated as `min_value` and values above
+  /// the largest bucket bound as that bound.
+  double GetQuantile(double quantile) const noexcept;
+
+  /// Returns the count of all the accounted values
+  std::uint64_t GetTotalCount() const noexcept;
+
+  /// Atomically reset all counters to zero.
+  void Reset() noexcept;
+
+  /// Atomically reset all counters to zero.
+  friend void ResetMetric(LogHistogram& histogram) noexcept;
+
+  /// Allows reading the histogram.
+  HistogramView GetView() const& noexcept;
+
+  /// @cond
+  // Store LogHistogram in a variable before taking a view on it.
+  HistogramView GetView() && noexcept = delete;
+  /// @endcond
+
+ private:
+  std::size_t GetBucketIndex(double value) const noexcept;
+  double GetBound(std::size_t bound_index) const noexcept;
+
+  std::unique_ptr<impl::histogram::Bucket[]> buckets_;
+  std::size_t bucket_count_;
+  double min_value_;
+  double gamma_;
+  double inv_log_gamma_;
+};
+
+/// Metric serialization support for LogHistogram.
+void DumpMetric(Writer& writer, const LogHistogram& histogram);
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
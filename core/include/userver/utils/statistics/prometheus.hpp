@@ -3,6 +3,9 @@
 /// @file userver/utils/statistics/prometheus.hpp
 /// @brief Statistics output in Prometheus format.
 
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <string>
 
 #include <userver/utils/statistics/storage.hpp>
@@ -24,9 +27,36 @@ std::string ToPrometheusName(std::string_view data);
 // Label names beginning with __ are reserved for internal use.
 std::string ToPrometheusLabel(std::string_view name);
 
+struct PrometheusNamesCacheAccess;
+
 }  // namespace impl
 
+/// @brief Metric and label names converted to the Prometheus format, kept
+/// between the outputs of the same metrics. Thread safe.
+///
+/// The names of the metrics rarely change, so the repeated outputs of them
+/// do not convert the names again.
+class PrometheusNamesCache final {
+ public:
+  PrometheusNamesCache();
+  ~PrometheusNamesCache();
+
+  PrometheusNamesCache(const PrometheusNamesCache&) = delete;
+  PrometheusNamesCache& operator=(const PrometheusNamesCache&) = delete;
+
+ private:
+  friend struct impl::PrometheusNamesCacheAccess;
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/// Consumes the consecutive parts of the output
+using ChunkConsumer = std::function<void(std::string&& chunk)>;
+
 /// Output `statistics` in Prometheus format, each metric has `gauge` type.
+/// Histogram metrics are written as classic Prometheus histograms with
+/// cumulative `le` buckets and a `_count`.
 std::string ToPrometheusFormat(const utils::statistics::Storage& statistics,
                                const utils::statistics::Request& request = {});
 
@@ -35,6 +65,31 @@ std::string ToPrometheusFormatUntyped(
     const utils::statistics::Storage& statistics,
     const utils::statistics::Request& request = {});
 
+/// @brief Output `statistics` in Prometheus format to `consumer` by the parts
+/// of about `chunk_size` bytes, without building a single string of the
+/// whole output. Names converted by the previous calls with the same `cache`
+/// are reused.
+///
+/// @warning `consumer` is called with `statistics` locked, it must not block
+/// for long, e.g. it may push into an unbounded queue, but must not wait for
+/// a network peer.
+///
+/// @see ToPrometheusFormat
+void ToPrometheusFormat(const utils::statistics::Storage& statistics,
+                        const utils::statistics::Request& request,
+                        PrometheusNamesCache& cache, std::size_t chunk_size,
+                        const ChunkConsumer& consumer);
+
+/// @brief Output `statistics` in Prometheus format without metric types to
+/// `consumer` by the parts of about `chunk_size` bytes.
+///
+/// @see ToPrometheusFormatUntyped
+void ToPrometheusFormatUntyped(const utils::statistics::Storage& statistics,
+                               const utils::statistics::Request& request,
+                               PrometheusNamesCache& cache,
+                               std::size_t chunk_size,
+                               const ChunkConsumer& consumer);
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
@@ -7,6 +7,7 @@
 #include <functional>
 #include <initializer_list>
 #include <list>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <variant>
@@ -26,6 +27,8 @@ namespace utils::statistics {
 /// @brief Used in legacy statistics extenders
 struct StatisticsRequest final {};
 
+class MetricsDelta;
+
 /// @brief Class describing the request for metrics data.
 ///
 /// Metric path and metric name are the same thing. For example for code like
@@ -76,9 +79,44 @@ class Request final {
   /// Add those labels to each returned metric
   const AddLabels add_labels{};
 
+  /// If set, return only the metrics that changed since the previous request
+  /// with the same `delta`, see utils::statistics::MetricsDelta
+  MetricsDelta* const delta{nullptr};
+
+  /// Makes a copy of this request that returns only the changed metrics
+  Request WithDelta(MetricsDelta& delta) const;
+
  private:
   Request(std::string prefix_in, PrefixMatch path_match_type_in,
-          std::vector<Label> require_labels_in, AddLabels add_labels_in);
+          std::vector<Label> require_labels_in, AddLabels add_labels_in,
+          MetricsDelta* delta_in = nullptr);
+};
+
+/// @brief Remembers the metric values reported to a single metrics consumer,
+/// to report only the changed values on the next utils::statistics::Request.
+///
+/// The first request with a fresh MetricsDelta returns all the metrics.
+/// Metrics are identified by the hash of their path and labels, so the
+/// consumer should always use the same request parameters. Histograms are
+/// always returned. Metrics that are no longer written are forgotten, their
+/// removal is not reported.
+///
+/// Concurrent requests with the same MetricsDelta are serialized.
+class MetricsDelta final {
+ public:
+  MetricsDelta();
+  MetricsDelta(MetricsDelta&&) = delete;
+  MetricsDelta& operator=(MetricsDelta&&) = delete;
+  ~MetricsDelta();
+
+  /// Forget the reported values, the next request returns all the metrics
+  void Reset();
+
+ private:
+  friend class Storage;
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
 };
 
 using ExtenderFunc =
@@ -95,6 +133,8 @@ struct MetricsSource final {
 
   WriterFunc writer;
   std::vector<Label> writer_labels;
+  // Views of writer_labels, built once at registration
+  std::vector<LabelView> writer_label_views;
 };
 
 using StorageData = std::list<MetricsSource>;
@@ -151,6 +191,7 @@ class Storage final {
 
  private:
   Entry DoRegisterExtender(impl::MetricsSource&& source);
+  void DoVisitMetrics(BaseFormatBuilder& out, const Request& request) const;
 
   std::atomic<bool> may_register_extenders_;
   impl::StorageData metrics_sources_;
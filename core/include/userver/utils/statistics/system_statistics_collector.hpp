@@ -20,6 +20,10 @@ namespace components {
 ///
 /// Periodically queries resource usage info and reports is as a set of metrics.
 ///
+/// On Linux with cgroup v2 the pressure stall information of the cgroup
+/// (`cpu.pressure`, `memory.pressure`, `io.pressure`) and its `memory.events`
+/// are reported as the `cgroup.pressure` and `cgroup.memory_events` metrics.
+///
 /// ## Static options:
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
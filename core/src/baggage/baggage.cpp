@@ -18,6 +18,15 @@ namespace {
 const int kEntitiesLimit = 64;
 const int kHeaderLengthLimit = 8192;
 
+bool CheckHeaderLength(const std::string& header) {
+  if (header.size() > kHeaderLengthLimit) {
+    LOG_LIMITED_WARNING() << fmt::format(
+        "Exceeded the limit of header length: {}", kHeaderLengthLimit);
+    return false;
+  }
+  return true;
+}
+
 }  // namespace
 
 BaggageEntryProperty::BaggageEntryProperty(
@@ -91,7 +100,7 @@ const BaggageEntryProperty& BaggageEntry::GetProperty(
   throw BaggageException("Entry doesn't contain selected property");
 }
 
-std::string Baggage::ToString() const {
+const std::string& Baggage::ToString() const {
   if (is_valid_header_) {
     return header_value_;
   }
@@ -382,16 +391,21 @@ std::optional<BaggageEntryProperty> Baggage::TryMakeBaggageEntryProperty(
 
 std::optional<Baggage> TryMakeBaggage(
     std::string header, std::unordered_set<std::string> allowed_keys) {
-  if (header.size() > kHeaderLengthLimit) {
-    LOG_LIMITED_WARNING() << fmt::format(
-        "Exceeded the limit of header length: {}", kHeaderLengthLimit);
-    return std::nullopt;
-  }
+  if (!CheckHeaderLength(header)) return std::nullopt;
 
   return std::make_optional<Baggage>(
       {std::move(header), std::move(allowed_keys)});
 }
 
+bool TrySetInheritedBaggage(std::string header,
+                            std::unordered_set<std::string> allowed_keys) {
+  if (!CheckHeaderLength(header)) return false;
+
+  // Move constructor of Baggage parses the header once again
+  kInheritedBaggage.Emplace(std::move(header), std::move(allowed_keys));
+  return true;
+}
+
 }  // namespace baggage
 
 USERVER_NAMESPACE_END
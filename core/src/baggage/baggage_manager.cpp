@@ -82,11 +82,7 @@ void BaggageManager::SetBaggage(std::string header) const {
   auto current_allowed_keys =
       ChooseCurrentAllowedKeys(current_baggage, config_source_);
 
-  auto baggage =
-      TryMakeBaggage(std::move(header), std::move(current_allowed_keys));
-  if (baggage) {
-    kInheritedBaggage.Set(std::move(*baggage));
-  }
+  TrySetInheritedBaggage(std::move(header), std::move(current_allowed_keys));
 }
 
 void BaggageManager::ResetBaggage() { kInheritedBaggage.Erase(); }
@@ -336,6 +336,20 @@ class UTestBaggage : public baggage::Baggage {
   }
 };
 
+UTEST(Baggage, TrySetInheritedBaggage) {
+  ASSERT_TRUE(baggage::TrySetInheritedBaggage("key1=value1, key2=value2",
+                                              kAllowedKeys));
+  const auto* inherited = baggage::kInheritedBaggage.GetOptional();
+  ASSERT_NE(inherited, nullptr);
+  EXPECT_EQ(inherited->ToString(), "key1=value1,key2=value2");
+
+  EXPECT_FALSE(
+      baggage::TrySetInheritedBaggage(std::string(10000, 'a'), kAllowedKeys));
+  inherited = baggage::kInheritedBaggage.GetOptional();
+  ASSERT_NE(inherited, nullptr);
+  EXPECT_EQ(inherited->ToString(), "key1=value1,key2=value2");
+}
+
 UTEST(Baggage, Parsers) {
   UTestBaggage tester(kAllowedKeys);
   tester.UTestTryMakeBaggageEntry();
@@ -38,6 +38,8 @@ constexpr std::string_view kIsStrongPeriod = "is-strong-period";
 constexpr std::string_view kHasPreAssignCheck = "has-pre-assign-check";
 
 constexpr std::string_view kFirstUpdateFailOk = "first-update-fail-ok";
+constexpr std::string_view kFirstUpdateInBackground =
+    "first-update-in-background";
 constexpr std::string_view kUpdateTypes = "update-types";
 constexpr std::string_view kForcePeriodicUpdates =
     "testsuite-force-periodic-update";
@@ -141,6 +143,8 @@ Config::Config(const yaml_config::YamlConfig& config,
                const std::optional<dump::Config>& dump_config)
     : allowed_update_types(ParseUpdateMode(config)),
       allow_first_update_failure(config[kFirstUpdateFailOk].As<bool>(false)),
+      first_update_in_background(
+          config[kFirstUpdateInBackground].As<bool>(false)),
       force_periodic_update(
           config[kForcePeriodicUpdates].As<std::optional<bool>>()),
       config_updates_enabled(config[kConfigSettings].As<bool>(true)),
@@ -17,6 +17,9 @@ constexpr const char* kStatisticsNameAny = "any";
 constexpr const char* kStatisticsNameCurrentDocumentsCount =
     "current-documents-count";
 
+constexpr std::array<const char*, impl::kUpdateStagesCount> kUpdateStageNames{
+    "copy", "fetch", "parse", "merge"};
+
 template <typename Clock, typename Duration>
 std::int64_t TimeStampToMillisecondsFromNow(
     std::chrono::time_point<Clock, Duration> time) {
@@ -46,6 +49,11 @@ void CombineStatistics(const impl::UpdateStatistics& a,
                b.last_successful_update_start_time.load());
   result.last_update_duration =
       std::max(a.last_update_duration.load(), b.last_update_duration.load());
+  for (std::size_t i = 0; i < impl::kUpdateStagesCount; ++i) {
+    result.last_update_stage_durations[i] =
+        std::max(a.last_update_stage_durations[i].load(),
+                 b.last_update_stage_durations[i].load());
+  }
 }
 
 }  // namespace
@@ -74,6 +82,12 @@ void DumpMetric(utils::statistics::Writer& writer,
         std::chrono::duration_cast<std::chrono::milliseconds>(
             stats.last_update_duration.load())
             .count();
+
+    auto stages = age["last-update-stage-duration-ms"];
+    for (std::size_t i = 0; i < impl::kUpdateStagesCount; ++i) {
+      stages[kUpdateStageNames[i]] =
+          stats.last_update_stage_durations[i].load().count();
+    }
   }
 }
 
@@ -137,6 +151,16 @@ void UpdateStatisticsScope::IncreaseDocumentsParseFailures(std::size_t add) {
   update_stats_.documents_parse_failures += add;
 }
 
+void UpdateStatisticsScope::AddStageDuration(
+    UpdateStage stage, std::chrono::milliseconds duration) {
+  const auto index = static_cast<std::size_t>(stage);
+  UASSERT(index < impl::kUpdateStagesCount);
+  auto& total = stage_durations_[index];
+  auto current = total.load();
+  while (!total.compare_exchange_weak(current, current + duration)) {
+  }
+}
+
 void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
   UASSERT(new_state != impl::UpdateState::kNotFinished);
   // TODO Some production caches call Finish multiple times. We should fix those
@@ -150,6 +174,9 @@ void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
   update_stats_.last_update_duration =
       std::chrono::duration_cast<std::chrono::milliseconds>(update_stop_time -
                                                             update_start_time_);
+  for (std::size_t i = 0; i < impl::kUpdateStagesCount; ++i) {
+    update_stats_.last_update_stage_durations[i] = stage_durations_[i].load();
+  }
 
   state_ = new_state;
 }
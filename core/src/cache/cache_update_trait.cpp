@@ -67,6 +67,12 @@ void CacheUpdateTrait::ReadAndSet(dump::Reader&) {
   dump::ThrowDumpUnimplemented(Name());
 }
 
+bool CacheUpdateTrait::GetAndWriteDelta(dump::Writer&) const { return false; }
+
+void CacheUpdateTrait::ReadAndApplyDelta(dump::Reader&) {
+  dump::ThrowDumpUnimplemented(Name());
+}
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
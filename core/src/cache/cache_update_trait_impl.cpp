@@ -169,10 +169,17 @@ void CacheUpdateTrait::Impl::StartPeriodicUpdates(
               : UpdateType::kIncremental;
     }
 
-    if ((last_update_ == std::chrono::system_clock::time_point{} ||
-         config->first_update_mode != FirstUpdateMode::kSkip) &&
-        (!(flags & CacheUpdateTrait::Flag::kNoFirstUpdate) ||
-         !periodic_update_enabled_)) {
+    const bool is_first_update_needed =
+        last_update_ == std::chrono::system_clock::time_point{} ||
+        config->first_update_mode != FirstUpdateMode::kSkip;
+    if (is_first_update_needed && static_config_.first_update_in_background &&
+        periodic_update_enabled_ &&
+        !(flags & CacheUpdateTrait::Flag::kNoFirstUpdate)) {
+      // The periodic task does the first update right after its start
+      periodic_task_flags_ |= utils::PeriodicTask::Flags::kNow;
+    } else if (is_first_update_needed &&
+               (!(flags & CacheUpdateTrait::Flag::kNoFirstUpdate) ||
+                !periodic_update_enabled_)) {
       // ignore kNoFirstUpdate if !periodic_update_enabled_
       // because some components require caches to be updated at least once
 
@@ -463,6 +470,16 @@ void CacheUpdateTrait::Impl::DumpableEntityProxy::ReadAndSet(
   cache_.ReadAndSet(reader);
 }
 
+bool CacheUpdateTrait::Impl::DumpableEntityProxy::GetAndWriteDelta(
+    dump::Writer& writer) const {
+  return cache_.GetAndWriteDelta(writer);
+}
+
+void CacheUpdateTrait::Impl::DumpableEntityProxy::ReadAndApplyDelta(
+    dump::Reader& reader) {
+  cache_.ReadAndApplyDelta(reader);
+}
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
@@ -69,6 +69,10 @@ class CacheUpdateTrait::Impl final {
 
     void ReadAndSet(dump::Reader& reader) override;
 
+    bool GetAndWriteDelta(dump::Writer& writer) const override;
+
+    void ReadAndApplyDelta(dump::Reader& reader) override;
+
    private:
     CacheUpdateTrait& cache_;
   };
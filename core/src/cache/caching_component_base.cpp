@@ -45,6 +45,12 @@ properties:
         type: boolean
         description: whether first update failure is non-fatal
         defaultDescription: false
+    first-update-in-background:
+        type: boolean
+        description: >
+            whether to do the first update in the background right after the
+            cache is created instead of doing it in the cache constructor
+        defaultDescription: false
     task-processor:
         type: string
         description: the name of the TaskProcessor for running DoWork
@@ -1,10 +1,14 @@
+#include <atomic>
 #include <string>
+#include <vector>
 
 #include <userver/utest/utest.hpp>
 
 #include <userver/cache/expirable_lru_cache.hpp>
 #include <userver/dump/operations_mock.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/mock_now.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -295,6 +299,33 @@ UTEST(ExpirableLruCache, InvalidateByKey) {
   EXPECT_EQ(Counter::One(), *counter);
 }
 
+UTEST(ExpirableLruCache, TinyLfuEvictionPolicy) {
+  auto counter = std::make_shared<Counter>();
+
+  SimpleCache cache(1, 1, {}, {}, cache::EvictionPolicy::kTinyLfu);
+  cache.SetMaxLifetime(std::chrono::seconds(2));
+  SimpleCacheKey key = "my-key";
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+
+  counter->Flush();
+  EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 1)));
+  EXPECT_EQ(Counter::One(), *counter);
+
+  WriteAndReadFromDump(cache);
+
+  EXPECT_EQ(1, cache.Get(key, UpdateNever()));
+
+  utils::datetime::MockSleep(std::chrono::seconds(3));
+
+  counter->Flush();
+  EXPECT_EQ(2, cache.Get(key, UpdateValue(counter, 2)));
+  EXPECT_EQ(Counter::One(), *counter);
+
+  cache.InvalidateByKey(key);
+  EXPECT_EQ(std::nullopt, cache.GetOptionalNoUpdate(key));
+}
+
 UTEST(ExpirableLruCache, BackgroundUpdate) {
   auto counter = std::make_shared<Counter>();
 
@@ -330,6 +361,88 @@ UTEST(ExpirableLruCache, BackgroundUpdate) {
   EXPECT_EQ(2, cache.Get(key, UpdateNever()));
 }
 
+UTEST(ExpirableLruCache, StaleWhileRevalidate) {
+  auto counter = std::make_shared<Counter>();
+
+  auto cache = CreateSimpleCache();
+  cache.SetMaxLifetime(std::chrono::seconds(2));
+  cache.SetStaleLifetime(std::chrono::seconds(5));
+  SimpleCacheKey key = "my-key";
+
+  utils::datetime::MockNowSet(std::chrono::system_clock::now());
+
+  counter->Flush();
+  EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 1)));
+  EXPECT_EQ(Counter::One(), *counter);
+
+  utils::datetime::MockSleep(std::chrono::seconds(3));
+
+  counter->Flush();
+  EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 2)));
+  EngineYield();
+  EXPECT_EQ(Counter::One(), *counter);
+  EXPECT_EQ(2, cache.Get(key, UpdateNever()));
+
+  utils::datetime::MockSleep(std::chrono::seconds(10));
+
+  counter->Flush();
+  EXPECT_EQ(std::nullopt, cache.GetOptionalNoUpdate(key));
+  EXPECT_EQ(3, cache.Get(key, UpdateValue(counter, 3)));
+  EXPECT_EQ(Counter::One(), *counter);
+}
+
+UTEST(ExpirableLruCache, CoalescedMisses) {
+  auto cache = CreateSimpleCache();
+  SimpleCacheKey key = "my-key";
+
+  engine::SingleConsumerEvent update_allowed;
+  std::atomic<int> updates{0};
+  const auto update = [&](const SimpleCacheKey&) {
+    ++updates;
+    [[maybe_unused]] const bool allowed = update_allowed.WaitForEvent();
+    return 1;
+  };
+
+  std::vector<engine::TaskWithResult<SimpleCacheValue>> tasks;
+  for (int i = 0; i < 4; ++i) {
+    tasks.push_back(utils::Async("get", [&] { return cache.Get(key, update); }));
+  }
+  EngineYield();
+
+  update_allowed.Send();
+  for (auto& task : tasks) EXPECT_EQ(1, task.Get());
+
+  EXPECT_EQ(1, updates);
+  EXPECT_EQ(3, cache.GetStatistics().total.coalesced);
+}
+
+UTEST(ExpirableLruCache, CoalescingWaitTimeout) {
+  auto counter = std::make_shared<Counter>();
+
+  auto cache = CreateSimpleCache();
+  cache.SetCoalescingWaitTimeout(std::chrono::milliseconds(10));
+  SimpleCacheKey key = "my-key";
+
+  engine::SingleConsumerEvent update_allowed;
+  auto slow_get = utils::Async("slow-get", [&] {
+    return cache.Get(key, [&](const SimpleCacheKey&) {
+      [[maybe_unused]] const bool allowed = update_allowed.WaitForEvent();
+      return 1;
+    });
+  });
+  EngineYield();
+
+  // Does not wait for the slow update and does not store the value
+  counter->Flush();
+  EXPECT_EQ(2, cache.Get(key, UpdateValue(counter, 2)));
+  EXPECT_EQ(Counter::One(), *counter);
+
+  update_allowed.Send();
+  EXPECT_EQ(1, slow_get.Get());
+  EXPECT_EQ(1, cache.Get(key, UpdateNever()));
+  EXPECT_EQ(0, cache.GetStatistics().total.coalesced);
+}
+
 UTEST(ExpirableLruCache, Example) {
   /// [Sample ExpirableLruCache]
   using Key = std::string;
@@ -2,6 +2,7 @@
 
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/components/hot_keys_storage.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/dump/config.hpp>
 #include <userver/dump/dumper.hpp>
@@ -33,6 +34,12 @@ dynamic_config::Source FindDynamicConfigSource(
   return context.FindComponent<components::DynamicConfig>().GetSource();
 }
 
+std::shared_ptr<utils::statistics::HotKeys> FindHotKeys(
+    const components::ComponentContext& context, const std::string& source) {
+  return context.FindComponent<components::HotKeysStorage>().GetHotKeys(
+      source);
+}
+
 bool IsDumpSupportEnabled(const components::ComponentConfig& config) {
   const bool dump_support_enabled = config.HasMember(dump::kDump);
   if (dump_support_enabled) {
@@ -68,10 +75,36 @@ properties:
         type: boolean
         description: enables asynchronous updates for expring values
         defaultDescription: false
+    stale-lifetime:
+        type: string
+        description: |
+            how long an expired entry is returned while it is being updated
+            in background (0 disables stale-while-revalidate)
+        defaultDescription: 0
+    coalescing-wait-timeout:
+        type: string
+        description: |
+            how long a cache miss waits for a concurrent update of the same
+            key before calling DoGetByKey by itself (0 is unlimited)
+        defaultDescription: 0
     config-settings:
         type: boolean
         description: enables dynamic reconfiguration with CacheConfigSet
         defaultDescription: true
+    eviction-policy:
+        type: string
+        description: |
+            'lru' or 'tiny-lfu' for lock-free reads with W-TinyLFU admission
+        defaultDescription: lru
+        enum:
+          - lru
+          - tiny-lfu
+    hot-keys:
+        type: boolean
+        description: |
+            enables detection of the most frequently looked up and loaded
+            keys in components::HotKeysStorage
+        defaultDescription: false
 )");
 }
 
@@ -18,6 +18,20 @@ constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kStaleLifetime = "stale-lifetime";
+constexpr std::string_view kStaleLifetimeMs = "stale-lifetime-ms";
+constexpr std::string_view kCoalescingWaitTimeout = "coalescing-wait-timeout";
+constexpr std::string_view kCoalescingWaitTimeoutMs =
+    "coalescing-wait-timeout-ms";
+constexpr std::string_view kEvictionPolicy = "eviction-policy";
+
+EvictionPolicy ParseEvictionPolicy(const yaml_config::YamlConfig& value) {
+  const auto policy = value.As<std::string>("lru");
+  if (policy == "lru") return EvictionPolicy::kLru;
+  if (policy == "tiny-lfu") return EvictionPolicy::kTinyLfu;
+  throw std::runtime_error("Unknown eviction-policy '" + policy +
+                           "', expected 'lru' or 'tiny-lfu'");
+}
 
 }  // namespace
 
@@ -28,7 +42,10 @@ LruCacheConfig::LruCacheConfig(const yaml_config::YamlConfig& config)
       lifetime(config[kLifetime].As<std::chrono::milliseconds>(0)),
       background_update(config[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      stale_lifetime(config[kStaleLifetime].As<std::chrono::milliseconds>(0)),
+      coalescing_wait_timeout(
+          config[kCoalescingWaitTimeout].As<std::chrono::milliseconds>(0)) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -40,7 +57,11 @@ LruCacheConfig::LruCacheConfig(const formats::json::Value& value)
       lifetime(ParseMs(value[kLifetimeMs])),
       background_update(value[kBackgroundUpdate].As<bool>(false)
                             ? BackgroundUpdateMode::kEnabled
-                            : BackgroundUpdateMode::kDisabled) {
+                            : BackgroundUpdateMode::kDisabled),
+      stale_lifetime(
+          ParseMs(value[kStaleLifetimeMs], std::chrono::milliseconds::zero())),
+      coalescing_wait_timeout(ParseMs(value[kCoalescingWaitTimeoutMs],
+                                      std::chrono::milliseconds::zero())) {
   if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -58,7 +79,9 @@ LruCacheConfigStatic::LruCacheConfigStatic(
     const yaml_config::YamlConfig& config)
     : config(config),
       ways(config[kWays].As<std::size_t>()),
-      use_dynamic_config(config["config-settings"].As<bool>(true)) {
+      use_dynamic_config(config["config-settings"].As<bool>(true)),
+      eviction_policy(ParseEvictionPolicy(config[kEvictionPolicy])),
+      hot_keys(config["hot-keys"].As<bool>(false)) {
   if (ways <= 0) throw std::runtime_error("cache-ways is non-positive");
 }
 
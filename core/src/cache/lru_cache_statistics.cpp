@@ -13,13 +13,15 @@ ExpirableLruCacheStatisticsBase::ExpirableLruCacheStatisticsBase(
     : hits(other.hits.load()),
       misses(other.misses.load()),
       stale(other.stale.load()),
-      background_updates(other.background_updates.load()) {}
+      background_updates(other.background_updates.load()),
+      coalesced(other.coalesced.load()) {}
 
 void ExpirableLruCacheStatisticsBase::Reset() {
   hits = 0;
   misses = 0;
   stale = 0;
   background_updates = 0;
+  coalesced = 0;
 }
 
 ExpirableLruCacheStatisticsBase& ExpirableLruCacheStatisticsBase::operator+=(
@@ -28,6 +30,7 @@ ExpirableLruCacheStatisticsBase& ExpirableLruCacheStatisticsBase::operator+=(
   misses += other.misses.load();
   stale += other.stale.load();
   background_updates += other.background_updates.load();
+  coalesced += other.coalesced.load();
   return *this;
 }
 
@@ -49,12 +52,19 @@ void CacheStale(ExpirableLruCacheStatistics& stats) {
   LOG_TRACE() << "stale cache";
 }
 
+void CacheCoalesced(ExpirableLruCacheStatistics& stats) {
+  ++stats.total.coalesced;
+  ++stats.recent.GetCurrentCounter().coalesced;
+  LOG_TRACE() << "coalesced cache miss";
+}
+
 void DumpMetric(utils::statistics::Writer& writer,
                 const ExpirableLruCacheStatistics& stats) {
   writer["hits"] = stats.total.hits.load();
   writer["misses"] = stats.total.misses.load();
   writer["stale"] = stats.total.stale.load();
   writer["background-updates"] = stats.total.background_updates.load();
+  writer["coalesced-misses"] = stats.total.coalesced.load();
 
   auto s1min = stats.recent.GetStatsForPeriod();
   double s1min_hits = s1min.hits.load();
@@ -0,0 +1,87 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/cache/nway_tinylfu_cache.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWays = 16;
+constexpr std::size_t kWaySize = 1024;
+// Most of the reads hit a few hot keys
+constexpr unsigned kHotKeys = 16;
+
+template <typename Cache>
+void HotKeysRead(benchmark::State& state) {
+  const std::size_t readers_count = state.range(0);
+  engine::RunStandalone(readers_count, [&] {
+    Cache cache(kWays, kWaySize);
+    for (unsigned i = 0; i < kWays * kWaySize; ++i) cache.Put(i, i);
+
+    std::atomic<bool> is_running{true};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(readers_count - 1);
+    for (std::size_t i = 0; i < readers_count - 1; ++i) {
+      tasks.push_back(utils::Async("reader", [&] {
+        unsigned key = 0;
+        while (is_running) {
+          benchmark::DoNotOptimize(cache.Get(key++ % kHotKeys));
+          if (key % 1024 == 0) engine::Yield();
+        }
+      }));
+    }
+
+    unsigned key = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(cache.Get(key++ % kHotKeys));
+    }
+
+    is_running = false;
+    for (auto& task : tasks) task.Get();
+  });
+}
+
+}  // namespace
+
+void NWayLruHotKeysRead(benchmark::State& state) {
+  HotKeysRead<cache::NWayLRU<unsigned, unsigned>>(state);
+}
+BENCHMARK(NWayLruHotKeysRead)->RangeMultiplier(2)->Range(1, 8);
+
+void NWayTinyLfuHotKeysRead(benchmark::State& state) {
+  HotKeysRead<cache::NWayTinyLfu<unsigned, unsigned>>(state);
+}
+BENCHMARK(NWayTinyLfuHotKeysRead)->RangeMultiplier(2)->Range(1, 8);
+
+template <typename Cache>
+void MissAndPut(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    Cache cache(kWays, kWaySize);
+    unsigned key = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      if (!cache.Get(key)) cache.Put(key, key);
+      ++key;
+    }
+  });
+}
+
+void NWayLruMissAndPut(benchmark::State& state) {
+  MissAndPut<cache::NWayLRU<unsigned, unsigned>>(state);
+}
+BENCHMARK(NWayLruMissAndPut);
+
+void NWayTinyLfuMissAndPut(benchmark::State& state) {
+  MissAndPut<cache::NWayTinyLfu<unsigned, unsigned>>(state);
+}
+BENCHMARK(NWayTinyLfuMissAndPut);
+
+USERVER_NAMESPACE_END
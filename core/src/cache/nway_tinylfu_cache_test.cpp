@@ -0,0 +1,145 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <vector>
+
+#include <userver/cache/nway_tinylfu_cache.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using Cache = cache::NWayTinyLfu<int, int>;
+
+UTEST(NWayTinyLfu, Ctr) {
+  UEXPECT_NO_THROW(Cache(1, 10));
+  UEXPECT_NO_THROW(Cache(10, 10));
+  UEXPECT_THROW(Cache(0, 10), std::logic_error);
+}
+
+UTEST(NWayTinyLfu, Set) {
+  Cache cache(1, 1);
+  EXPECT_EQ(0, cache.GetSize());
+
+  cache.Put(1, 1);
+  EXPECT_EQ(1, cache.GetSize());
+
+  cache.Put(2, 2);
+
+  EXPECT_EQ(2, cache.Get(2));
+  EXPECT_EQ(1, cache.GetSize());
+  EXPECT_FALSE(cache.Get(1).has_value());
+
+  cache.Put(2, 3);
+  EXPECT_EQ(3, cache.Get(2));
+  EXPECT_EQ(1, cache.GetSize());
+  EXPECT_EQ(4, cache.GetOr(1, 4));
+}
+
+UTEST(NWayTinyLfu, GetExpired) {
+  Cache cache(1, 2);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(2, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(1, [](int) { return false; }).has_value());
+  EXPECT_EQ(1, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(2, [](int) { return false; }).has_value());
+  EXPECT_EQ(0, cache.GetSize());
+
+  EXPECT_FALSE(cache.Get(1).has_value());
+  EXPECT_EQ(0, cache.GetSize());
+}
+
+UTEST(NWayTinyLfu, SetMultipleWays) {
+  Cache cache(2, 1);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+
+  EXPECT_LE(cache.GetSize(), 2);
+  EXPECT_EQ(2, cache.Get(2));
+}
+
+UTEST(NWayTinyLfu, SizeLimit) {
+  Cache cache(1, 100);
+  for (int i = 0; i < 1000; ++i) {
+    cache.Put(i, i);
+    EXPECT_LE(cache.GetSize(), 100);
+  }
+  EXPECT_EQ(cache.GetSize(), 100);
+
+  cache.UpdateWaySize(10);
+  EXPECT_EQ(cache.GetSize(), 10);
+
+  cache.Invalidate();
+  EXPECT_EQ(cache.GetSize(), 0);
+}
+
+UTEST(NWayTinyLfu, ScanResistance) {
+  constexpr int kHotKeys = 50;
+  constexpr int kScanKeysPerRound = 200;
+  Cache cache(1, 100);
+
+  const auto get_or_put = [&cache](int key) {
+    if (cache.Get(key)) return true;
+    cache.Put(key, key);
+    return false;
+  };
+
+  // With LRU each scan would flush all the hot keys out of the cache
+  int hot_hits = 0;
+  int scan_key = 1000;
+  for (int round = 0; round < 10; ++round) {
+    for (int key = 0; key < kHotKeys; ++key) {
+      if (get_or_put(key) && round > 0) ++hot_hits;
+    }
+    for (int i = 0; i < kScanKeysPerRound; ++i) get_or_put(scan_key++);
+  }
+  EXPECT_GE(hot_hits, kHotKeys * 9 * 8 / 10);
+}
+
+UTEST(NWayTinyLfu, VisitAll) {
+  Cache cache(4, 10);
+  for (int i = 0; i < 10; ++i) cache.Put(i, i * 2);
+
+  std::size_t visited = 0;
+  cache.VisitAll([&visited](int key, int value) {
+    EXPECT_EQ(key * 2, value);
+    ++visited;
+  });
+  EXPECT_EQ(visited, cache.GetSize());
+}
+
+UTEST_MT(NWayTinyLfu, ConcurrentAccess, 4) {
+  constexpr int kKeys = 200;
+  Cache cache(4, 50);
+  std::atomic<bool> is_running{true};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int i = 0; i < 4; ++i) {
+    tasks.push_back(utils::Async("worker", [&, i] {
+      int key = i;
+      while (is_running) {
+        const auto value = cache.Get(key);
+        if (value) {
+          EXPECT_EQ(*value, key);
+        } else {
+          cache.Put(key, key);
+        }
+        if (key % 17 == 0) cache.InvalidateByKey(key);
+        key = (key + 7) % kKeys;
+      }
+    }));
+  }
+
+  engine::SleepFor(std::chrono::milliseconds{100});
+  is_running = false;
+  for (auto& task : tasks) task.Get();
+  EXPECT_LE(cache.GetSize(), 200);
+}
+
+USERVER_NAMESPACE_END
@@ -31,14 +31,17 @@ ResolverConfig ParseResolverConfig(
           config.network_custom_servers);
   config.cache_ways =
       component_config["cache-ways"].As<size_t>(config.cache_ways);
-  config.cache_size_per_way = component_config["cache_size_per_way"].As<size_t>(
+  config.cache_size_per_way = component_config["cache-size-per-way"].As<size_t>(
       config.cache_size_per_way);
   config.cache_max_reply_ttl =
-      component_config["cache_max_reply_ttl"].As<std::chrono::milliseconds>(
+      component_config["cache-max-reply-ttl"].As<std::chrono::milliseconds>(
           config.cache_max_reply_ttl);
   config.cache_failure_ttl =
-      component_config["cache_failure_ttl"].As<std::chrono::milliseconds>(
+      component_config["cache-failure-ttl"].As<std::chrono::milliseconds>(
           config.cache_failure_ttl);
+  config.cache_refresh_period =
+      component_config["cache-refresh-period"].As<std::chrono::milliseconds>(
+          config.cache_refresh_period);
   return config;
 }
 
@@ -119,6 +122,10 @@ properties:
         type: string
         description: TTL for network failures caching
         defaultDescription: 5s
+    cache-refresh-period:
+        type: string
+        description: period of the background refresh of the network cache records that are about to expire, 0 to refresh only on queries
+        defaultDescription: 0s
 )");
 }
 
@@ -5,6 +5,7 @@
 #include <cctype>
 #include <chrono>
 #include <string_view>
+#include <vector>
 
 #include <clients/dns/file_resolver.hpp>
 #include <clients/dns/helpers.hpp>
@@ -18,6 +19,7 @@
 #include <userver/utils/from_string.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
 #include <userver/utils/mock_now.hpp>
+#include <userver/utils/periodic_task.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -150,6 +152,7 @@ class Resolver::Impl {
   void ReloadHosts();
   void FlushNetworkCache();
   void FlushNetworkCache(const std::string& name);
+  void RefreshNetworkCache();
 
   AddrVector QueryFileCache(const std::string& name);
   NetCacheResult QueryNetCache(const std::string& name);
@@ -190,9 +193,11 @@ class Resolver::Impl {
   const std::chrono::milliseconds net_cache_update_margin_;
   const std::chrono::milliseconds net_cache_max_reply_ttl_;
   const std::chrono::milliseconds net_cache_failure_ttl_;
+  const std::chrono::milliseconds net_cache_refresh_period_;
   cache::NWayLRU<std::string, NetCacheEntry> net_cache_;
   concurrent::MutexSet<std::string> net_cache_update_mutexes_;
   utils::impl::WaitTokenStorage wait_token_storage_;
+  utils::PeriodicTask net_cache_refresh_task_;
 };
 
 Resolver::Impl::Impl(engine::TaskProcessor& fs_task_processor,
@@ -204,10 +209,21 @@ Resolver::Impl::Impl(engine::TaskProcessor& fs_task_processor,
       net_cache_update_margin_{config.network_timeout},
       net_cache_max_reply_ttl_{config.cache_max_reply_ttl},
       net_cache_failure_ttl_{config.cache_failure_ttl},
+      net_cache_refresh_period_{config.cache_refresh_period},
       net_cache_{config.cache_ways, config.cache_size_per_way},
-      net_cache_update_mutexes_(config.cache_ways) {}
+      net_cache_update_mutexes_(config.cache_ways) {
+  if (net_cache_refresh_period_.count() > 0) {
+    net_cache_refresh_task_.Start(
+        "dns_cache_refresh",
+        utils::PeriodicTask::Settings(net_cache_refresh_period_),
+        [this] { RefreshNetworkCache(); });
+  }
+}
 
-Resolver::Impl::~Impl() { wait_token_storage_.WaitForAllTokens(); }
+Resolver::Impl::~Impl() {
+  net_cache_refresh_task_.Stop();
+  wait_token_storage_.WaitForAllTokens();
+}
 
 const Resolver::LookupSourceCounters& Resolver::Impl::GetLookupSourceCounters()
     const {
@@ -311,6 +327,29 @@ void Resolver::Impl::StartBackgroundQuery(std::unique_lock<Mutex>& lock,
                         name, FailureMode::kIgnore);
 }
 
+void Resolver::Impl::RefreshNetworkCache() {
+  const auto refresh_deadline = utils::datetime::MockSteadyNow() +
+                                net_cache_refresh_period_ +
+                                net_cache_update_margin_;
+
+  // Not resolving under the cache way locks
+  std::vector<std::string> names;
+  net_cache_.VisitAll(
+      [&names, refresh_deadline](const std::string& name,
+                                 const NetCacheEntry& entry) {
+        // Failures are cached to stop the queries, not to retry them
+        if (!entry.is_failure && entry.expiration < refresh_deadline) {
+          names.push_back(name);
+        }
+      });
+
+  for (const auto& name : names) {
+    auto mutex = GetUpdateMutex(name);
+    std::unique_lock lock{mutex, std::defer_lock};
+    StartBackgroundQuery(lock, std::move(mutex), name);
+  }
+}
+
 template <typename Mutex>
 void Resolver::Impl::MoveQueryToBackground(
     std::unique_lock<Mutex>& lock, Mutex&& mutex,
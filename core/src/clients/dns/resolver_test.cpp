@@ -58,7 +58,8 @@ constexpr auto kNetV6String{"2a02:6b8:a::a"};
 struct MockedResolver {
   using ServerMock = utest::DnsServerMock;
 
-  MockedResolver(size_t cache_max_ttl, size_t cache_size_per_way)
+  MockedResolver(size_t cache_max_ttl, size_t cache_size_per_way,
+                 std::chrono::milliseconds cache_refresh_period = {})
       : hosts_file{[] {
           auto file = fs::blocking::TempFile::Create();
           fs::blocking::RewriteFileContents(file.GetPath(), kTestHosts);
@@ -87,6 +88,7 @@ struct MockedResolver {
               config.cache_failure_ttl = std::chrono::seconds{cache_max_ttl},
               config.cache_ways = 1;
               config.cache_size_per_way = cache_size_per_way;
+              config.cache_refresh_period = cache_refresh_period;
               config.network_custom_servers = {server_mock.GetServerAddress()};
               return config;
             }()} {}
@@ -426,6 +428,33 @@ UTEST(Resolver, CacheFailures) {
   EXPECT_EQ(counters.network_failure, 2);
 }
 
+UTEST(Resolver, CacheRefresh) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  MockedResolver resolver{1, 1, std::chrono::milliseconds{10}};
+
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+
+  // The update margin (network timeout) exceeds the TTL, so each refresh
+  // resolves the record again
+  const auto& counters = resolver->GetLookupSourceCounters();
+  while (counters.network < 3 && !test_deadline.IsReached()) {
+    engine::SleepFor(std::chrono::milliseconds{1});
+  }
+
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("first", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+
+  EXPECT_EQ(counters.file, 0);
+  EXPECT_EQ(counters.cached, 1);
+  EXPECT_EQ(counters.cached_stale, 0);
+  EXPECT_EQ(counters.cached_failure, 0);
+  EXPECT_GE(counters.network, 3);
+  EXPECT_EQ(counters.network_failure, 0);
+}
+
 UTEST(Resolver, FileDoesNotCache) {
   const auto test_deadline =
       engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
@@ -0,0 +1,117 @@
+#include <clients/http/address_balancer.hpp>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+namespace {
+
+constexpr std::size_t kCacheWays = 16;
+constexpr std::size_t kCacheSizePerWay = 256;
+
+std::int64_t ToMilliseconds(std::chrono::steady_clock::time_point time) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             time.time_since_epoch())
+      .count();
+}
+
+std::string FormatAddress(const engine::io::Sockaddr& addr) {
+  auto result = addr.PrimaryAddressString();
+  if (addr.Domain() == engine::io::AddrDomain::kInet6) {
+    return "[" + result + "]";
+  }
+  return result;
+}
+
+}  // namespace
+
+AddressBalancer::Endpoint::Endpoint(std::string address)
+    : address_(std::move(address)) {}
+
+std::size_t AddressBalancer::Endpoint::GetOutstanding() const noexcept {
+  return outstanding_.load(std::memory_order_relaxed);
+}
+
+bool AddressBalancer::Endpoint::IsEjected(
+    std::chrono::steady_clock::time_point now) const noexcept {
+  return ejected_until_ms_.load(std::memory_order_relaxed) > ToMilliseconds(now);
+}
+
+void AddressBalancer::Endpoint::Acquire() noexcept {
+  outstanding_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AddressBalancer::Endpoint::Release(
+    bool is_failed, std::chrono::milliseconds ejection_period) noexcept {
+  outstanding_.fetch_sub(1, std::memory_order_relaxed);
+  if (is_failed) {
+    ejected_until_ms_.store(
+        ToMilliseconds(std::chrono::steady_clock::now() + ejection_period),
+        std::memory_order_relaxed);
+  }
+}
+
+AddressBalancer::AddressBalancer(const impl::AddressBalancerSettings& settings)
+    : ejection_period_(settings.ejection_period),
+      endpoints_(kCacheWays, kCacheSizePerWay) {}
+
+std::vector<AddressBalancer::EndpointPtr> AddressBalancer::GetEndpoints(
+    const dns::AddrVector& addrs) {
+  std::vector<EndpointPtr> result;
+  result.reserve(addrs.size());
+  for (const auto& addr : addrs) {
+    auto address = FormatAddress(addr);
+    auto endpoint = endpoints_.Get(address);
+    if (!endpoint) {
+      // Concurrent misses may create two endpoints, one of them is forgotten
+      endpoint = std::make_shared<Endpoint>(address);
+      endpoints_.Put(address, *endpoint);
+    }
+    result.push_back(std::move(*endpoint));
+  }
+  return result;
+}
+
+AddressBalancer::EndpointPtr AddressBalancer::Pick(
+    const std::vector<EndpointPtr>& endpoints) const {
+  UASSERT(!endpoints.empty());
+
+  const auto now = std::chrono::steady_clock::now();
+  std::vector<const EndpointPtr*> candidates;
+  candidates.reserve(endpoints.size());
+  for (const auto& endpoint : endpoints) {
+    if (!endpoint->IsEjected(now)) candidates.push_back(&endpoint);
+  }
+  // All of the endpoints failed, do not fail the request locally
+  if (candidates.empty()) {
+    for (const auto& endpoint : endpoints) candidates.push_back(&endpoint);
+  }
+
+  const auto* result = candidates.front();
+  if (candidates.size() > 1) {
+    const auto first = utils::RandRange(candidates.size());
+    auto second = utils::RandRange(candidates.size() - 1);
+    if (second >= first) ++second;
+
+    result = candidates[first];
+    if ((*candidates[second])->GetOutstanding() <
+        (*result)->GetOutstanding()) {
+      result = candidates[second];
+    }
+  }
+
+  (*result)->Acquire();
+  return *result;
+}
+
+void AddressBalancer::Release(Endpoint& endpoint,
+                              bool is_failed) const noexcept {
+  endpoint.Release(is_failed, ejection_period_);
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/clients/dns/common.hpp>
+#include <userver/clients/http/impl/config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+/// Balances the requests to a hostname over all of its resolved addresses
+/// with power-of-two-choices least-outstanding-requests. Addresses failing to
+/// respond are ejected for a while.
+class AddressBalancer final {
+ public:
+  class Endpoint final {
+   public:
+    explicit Endpoint(std::string address);
+
+    /// Address in the CURLOPT_CONNECT_TO format, IPv6 in brackets
+    const std::string& GetAddress() const noexcept { return address_; }
+
+    std::size_t GetOutstanding() const noexcept;
+    bool IsEjected(std::chrono::steady_clock::time_point now) const noexcept;
+
+    void Acquire() noexcept;
+    void Release(bool is_failed,
+                 std::chrono::milliseconds ejection_period) noexcept;
+
+   private:
+    const std::string address_;
+    std::atomic<std::size_t> outstanding_{0};
+    std::atomic<std::int64_t> ejected_until_ms_{0};
+  };
+
+  using EndpointPtr = std::shared_ptr<Endpoint>;
+
+  explicit AddressBalancer(const impl::AddressBalancerSettings& settings);
+
+  /// Must be called from a coroutine
+  std::vector<EndpointPtr> GetEndpoints(const dns::AddrVector& addrs);
+
+  /// Picks and acquires an endpoint, may be called from any thread
+  EndpointPtr Pick(const std::vector<EndpointPtr>& endpoints) const;
+
+  void Release(Endpoint& endpoint, bool is_failed) const noexcept;
+
+ private:
+  const std::chrono::milliseconds ejection_period_;
+  // Endpoints are shared by the hostnames resolved to the same address
+  cache::NWayLRU<std::string, EndpointPtr> endpoints_;
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,102 @@
+#include <clients/http/address_balancer.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using clients::http::AddressBalancer;
+
+engine::io::Sockaddr MakeV4Addr(std::uint32_t addr) {
+  engine::io::Sockaddr sockaddr;
+  auto* sa = sockaddr.As<sockaddr_in>();
+  sa->sin_family = AF_INET;
+  // NOLINTNEXTLINE(hicpp-no-assembler,readability-isolate-declaration)
+  sa->sin_addr.s_addr = htonl(addr);
+  return sockaddr;
+}
+
+engine::io::Sockaddr MakeV6LoopbackAddr() {
+  engine::io::Sockaddr sockaddr;
+  auto* sa = sockaddr.As<sockaddr_in6>();
+  sa->sin6_family = AF_INET6;
+  sa->sin6_addr = in6addr_loopback;
+  return sockaddr;
+}
+
+clients::dns::AddrVector MakeAddrs() {
+  return {MakeV4Addr(0x7F000001), MakeV4Addr(0x7F000002),
+          MakeV6LoopbackAddr()};
+}
+
+clients::http::impl::AddressBalancerSettings MakeSettings() {
+  clients::http::impl::AddressBalancerSettings settings;
+  settings.enabled = true;
+  settings.ejection_period = std::chrono::minutes{1};
+  return settings;
+}
+
+}  // namespace
+
+UTEST(HttpAddressBalancer, Endpoints) {
+  AddressBalancer balancer{MakeSettings()};
+
+  const auto endpoints = balancer.GetEndpoints(MakeAddrs());
+  ASSERT_EQ(endpoints.size(), 3);
+  EXPECT_EQ(endpoints[0]->GetAddress(), "127.0.0.1");
+  EXPECT_EQ(endpoints[1]->GetAddress(), "127.0.0.2");
+  EXPECT_EQ(endpoints[2]->GetAddress(), "[::1]");
+
+  // Shared by the hostnames with the same addresses
+  const auto other_endpoints = balancer.GetEndpoints(MakeAddrs());
+  EXPECT_EQ(endpoints, other_endpoints);
+}
+
+UTEST(HttpAddressBalancer, LeastOutstanding) {
+  AddressBalancer balancer{MakeSettings()};
+  const auto endpoints = balancer.GetEndpoints(MakeAddrs());
+
+  std::vector<AddressBalancer::EndpointPtr> picked;
+  for (int i = 0; i < 300; ++i) picked.push_back(balancer.Pick(endpoints));
+
+  // Each pick takes the least loaded of two, the load stays even
+  for (const auto& endpoint : endpoints) {
+    EXPECT_GE(endpoint->GetOutstanding(), 90);
+    EXPECT_LE(endpoint->GetOutstanding(), 110);
+  }
+
+  for (const auto& endpoint : picked) balancer.Release(*endpoint, false);
+  for (const auto& endpoint : endpoints) {
+    EXPECT_EQ(endpoint->GetOutstanding(), 0);
+  }
+}
+
+UTEST(HttpAddressBalancer, Ejection) {
+  AddressBalancer balancer{MakeSettings()};
+  const auto endpoints = balancer.GetEndpoints(MakeAddrs());
+
+  endpoints[0]->Acquire();
+  balancer.Release(*endpoints[0], true);
+  EXPECT_TRUE(endpoints[0]->IsEjected(std::chrono::steady_clock::now()));
+
+  for (int i = 0; i < 100; ++i) {
+    const auto endpoint = balancer.Pick(endpoints);
+    EXPECT_NE(endpoint, endpoints[0]);
+    balancer.Release(*endpoint, false);
+  }
+
+  // All of the endpoints are used if all of them are ejected
+  for (const auto& endpoint : endpoints) {
+    endpoint->Acquire();
+    balancer.Release(*endpoint, true);
+  }
+  const auto endpoint = balancer.Pick(endpoints);
+  EXPECT_TRUE(endpoint);
+  balancer.Release(*endpoint, false);
+}
+
+USERVER_NAMESPACE_END
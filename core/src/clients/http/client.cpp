@@ -13,6 +13,8 @@
 #include <userver/utils/rand.hpp>
 #include <userver/utils/userver_info.hpp>
 
+#include <clients/http/address_balancer.hpp>
+#include <clients/http/direct_transport.hpp>
 #include <clients/http/destination_statistics.hpp>
 #include <clients/http/easy_wrapper.hpp>
 #include <clients/http/statistics.hpp>
@@ -20,6 +22,7 @@
 #include <crypto/openssl.hpp>
 #include <curl-ev/multi.hpp>
 #include <curl-ev/ratelimit.hpp>
+#include <curl-ev/share.hpp>
 #include <engine/ev/thread_pool.hpp>
 #include <server/http/headers_propagator.hpp>
 
@@ -30,6 +33,7 @@ namespace {
 
 const std::string kIoThreadName = "curl";
 const auto kEasyReinitPeriod = std::chrono::minutes{1};
+const auto kPreconnectTimeout = std::chrono::seconds{5};
 
 // cURL accepts options as long, but we use size_t to avoid writing checks.
 // Clamp too high values to LONG_MAX, it shouldn't matter for these magnitudes.
@@ -80,6 +84,11 @@ Client::Client(impl::ClientSettings settings,
       multis_.push_back(std::make_unique<curl::multi>(*thread_control_ptr,
                                                       connect_rate_limiter_));
     }
+
+    // TLS sessions are resumed by any IO thread, not only by the one that
+    // did the full handshake
+    share_ = std::make_shared<curl::share>();
+    share_->set_share_ssl_session(true);
   }).Get();
 
   easy_reinit_task_.Start("http_easy_reinit",
@@ -87,9 +96,44 @@ Client::Client(impl::ClientSettings settings,
                           [this] { ReinitEasy(); });
 
   SetConfig({});
+
+  destination_statistics_->SetConcurrencyLimiterSettings(
+      settings.concurrency_limiter);
+  if (settings.address_balancer.enabled) {
+    address_balancer_ =
+        std::make_unique<AddressBalancer>(settings.address_balancer);
+  }
+  if (!settings.direct_transport.destinations.empty()) {
+    direct_transport_ =
+        std::make_unique<DirectTransport>(settings.direct_transport);
+  }
+
+  if (settings.multiplexing_enabled) {
+    SetMultiplexingEnabled(true);
+    for (auto& multi : multis_) {
+      multi->SetMaxConcurrentStreams(
+          ClampToLong(settings.max_concurrent_streams));
+    }
+  }
+  if (settings.max_host_connections != 0) {
+    SetMaxHostConnections(settings.max_host_connections);
+  }
+
+  if (!settings.preconnect.urls.empty() &&
+      settings.preconnect.connections != 0) {
+    preconnect_ = std::move(settings.preconnect);
+    preconnect_task_.Start(
+        "http_preconnect",
+        utils::PeriodicTask::Settings(
+            preconnect_.refresh_period,
+            {utils::PeriodicTask::Flags::kNow,
+             utils::PeriodicTask::Flags::kCritical}),
+        [this] { Preconnect(); });
+  }
 }
 
 Client::~Client() {
+  preconnect_task_.Stop();
   easy_reinit_task_.Stop();
 
   // We have to destroy *this only when all the requests are finished, because
@@ -114,37 +158,43 @@ Client::~Client() {
 }
 
 Request Client::CreateRequest() {
-  auto request = [this] {
-    auto easy = TryDequeueIdle();
-    if (easy) {
-      auto idx = FindMultiIndex(easy->GetMulti());
-      auto wrapper =
-          std::make_shared<impl::EasyWrapper>(std::move(easy), *this);
-      return Request{
-          std::move(wrapper),      statistics_[idx].CreateRequestStats(),
-          destination_statistics_, resolver_,
-          plugin_pipeline_,        *tracing_manager_.GetBase()};
-    } else {
-      auto i = utils::RandRange(multis_.size());
-      auto& multi = multis_[i];
-
-      try {
-        auto wrapper = engine::AsyncNoSpan(fs_task_processor_, [this, &multi] {
-                         return std::make_shared<impl::EasyWrapper>(
-                             easy_.Get()->GetBoundBlocking(*multi), *this);
-                       }).Get();
-        return Request{
-            std::move(wrapper),      statistics_[i].CreateRequestStats(),
-            destination_statistics_, resolver_,
-            plugin_pipeline_,        *tracing_manager_.GetBase()};
-      } catch (engine::WaitInterruptedException&) {
-        throw clients::http::CancelException();
-      } catch (engine::TaskCancelledException&) {
-        throw clients::http::CancelException();
-      }
-    }
-  }();
+  auto easy = TryDequeueIdle();
+  if (!easy) {
+    return CreateRequestWithNewEasy(utils::RandRange(multis_.size()));
+  }
+
+  auto idx = FindMultiIndex(easy->GetMulti());
+  easy->set_share(share_);
+  auto wrapper = std::make_shared<impl::EasyWrapper>(std::move(easy), *this);
+  return SetupRequest(Request{
+      std::move(wrapper),      statistics_[idx].CreateRequestStats(),
+      destination_statistics_, resolver_,
+      plugin_pipeline_,        *tracing_manager_.GetBase()});
+}
+
+Request Client::CreateRequestWithNewEasy(std::size_t multi_index) {
+  UASSERT(multi_index < multis_.size());
+  auto& multi = multis_[multi_index];
 
+  try {
+    auto wrapper = engine::AsyncNoSpan(fs_task_processor_, [this, &multi] {
+                     auto easy = easy_.Get()->GetBoundBlocking(*multi);
+                     easy->set_share(share_);
+                     return std::make_shared<impl::EasyWrapper>(
+                         std::move(easy), *this);
+                   }).Get();
+    return SetupRequest(Request{std::move(wrapper),
+                                statistics_[multi_index].CreateRequestStats(),
+                                destination_statistics_, resolver_,
+                                plugin_pipeline_, *tracing_manager_.GetBase()});
+  } catch (engine::WaitInterruptedException&) {
+    throw clients::http::CancelException();
+  } catch (engine::TaskCancelledException&) {
+    throw clients::http::CancelException();
+  }
+}
+
+Request Client::SetupRequest(Request&& request) {
   if (testsuite_config_) {
     request.SetTestsuiteConfig(testsuite_config_);
   }
@@ -164,8 +214,37 @@ Request Client::CreateRequest() {
     request.proxy(*proxy_value);
   }
   request.SetDeadlinePropagationConfig(deadline_propagation_config_);
+  if (address_balancer_) request.SetAddressBalancer(address_balancer_.get());
+  if (direct_transport_) request.SetDirectTransport(direct_transport_.get());
+
+  return std::move(request);
+}
 
-  return request;
+void Client::Preconnect() {
+  // Concurrent requests to a host open the missing connections in each IO
+  // thread, the following ones reuse them and reset their idle time
+  std::vector<ResponseFuture> futures;
+  futures.reserve(preconnect_.urls.size() * multis_.size() *
+                  preconnect_.connections);
+  for (const auto& url : preconnect_.urls) {
+    for (std::size_t i = 0; i < multis_.size(); ++i) {
+      for (std::size_t j = 0; j < preconnect_.connections; ++j) {
+        futures.push_back(CreateRequestWithNewEasy(i)
+                              .head(url)
+                              .retry(1)
+                              .timeout(kPreconnectTimeout)
+                              .async_perform());
+      }
+    }
+  }
+
+  for (auto& future : futures) {
+    try {
+      [[maybe_unused]] const auto response = future.Get();
+    } catch (const std::exception& e) {
+      LOG_LIMITED_WARNING() << "Failed to preconnect: " << e.what();
+    }
+  }
 }
 
 void Client::SetMultiplexingEnabled(bool enabled) {
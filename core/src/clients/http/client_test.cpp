@@ -11,6 +11,7 @@
 #include <engine/task/task_processor.hpp>
 #include <userver/clients/dns/resolver.hpp>
 #include <userver/clients/http/connect_to.hpp>
+#include <userver/clients/http/impl/config.hpp>
 #include <userver/clients/http/request_tracing_editor.hpp>
 #include <userver/clients/http/streamed_response.hpp>
 #include <userver/concurrent/queue.hpp>
@@ -23,6 +24,7 @@
 #include <userver/fs/blocking/write.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/tracing/manager.hpp>
 #include <userver/tracing/tracing.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/userver_info.hpp>
@@ -877,6 +879,90 @@ UTEST(HttpClient, PutShutdownWithHugeResponse) {
         .Detach();  // Do not do like this in production code!
 }
 
+class CountingSink final : public clients::http::ResponseBodySink {
+ public:
+  void Write(std::string_view chunk) override {
+    ++chunks;
+    size += chunk.size();
+    if (chunk.find_first_not_of('@') != std::string_view::npos) {
+      has_unexpected_data = true;
+    }
+  }
+
+  std::size_t chunks{0};
+  std::size_t size{0};
+  bool has_unexpected_data{false};
+};
+
+class ThrowingSink final : public clients::http::ResponseBodySink {
+ public:
+  void Write(std::string_view) override {
+    throw std::runtime_error("sink failure");
+  }
+};
+
+UTEST(HttpClient, ResponseBodySink) {
+  const utest::SimpleServer http_server{&huge_data_callback};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  auto sink = std::make_shared<CountingSink>();
+  const auto response = http_client_ptr->CreateRequest()
+                            .get(http_server.GetBaseUrl())
+                            .timeout(kTimeout)
+                            .async_perform_sink(sink)
+                            .Get();
+
+  EXPECT_TRUE(response->IsOk());
+  EXPECT_TRUE(response->body_view().empty());
+  EXPECT_EQ(sink->size, 100000);
+  EXPECT_GE(sink->chunks, 1);
+  EXPECT_FALSE(sink->has_unexpected_data);
+}
+
+UTEST(HttpClient, ResponseBodySinkException) {
+  const utest::SimpleServer http_server{&huge_data_callback};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  auto request = http_client_ptr->CreateRequest()
+                     .get(http_server.GetBaseUrl())
+                     .timeout(kTimeout);
+  UEXPECT_THROW_MSG(
+      request.async_perform_sink(std::make_shared<ThrowingSink>()).Get(),
+      std::runtime_error, "sink failure");
+
+  // The request is usable without the sink
+  const auto response = request.perform();
+  EXPECT_EQ(response->body_view().size(), 100000);
+}
+
+UTEST(HttpClient, Preconnect) {
+  std::atomic<int> head_requests{0};
+  const utest::SimpleServer http_server{[&head_requests](
+                                            const HttpRequest& request) {
+    if (request.rfind("HEAD ", 0) == 0) ++head_requests;
+    return HttpResponse{"HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n",
+                        HttpResponse::kWriteAndContinue};
+  }};
+
+  const tracing::GenericTracingManager tracing_manager{
+      tracing::Format::kYandexTaxi, tracing::Format::kYandexTaxi};
+  clients::http::impl::ClientSettings settings;
+  settings.io_threads = 2;
+  settings.tracing_manager = &tracing_manager;
+  settings.preconnect.urls = {http_server.GetBaseUrl()};
+  settings.preconnect.connections = 2;
+
+  const clients::http::Client client{
+      std::move(settings), engine::current_task::GetTaskProcessor(),
+      std::vector<utils::NotNull<clients::http::Plugin*>>{}};
+
+  const auto deadline = engine::Deadline::FromDuration(kTimeout);
+  while (head_requests < 4 && !deadline.IsReached()) {
+    engine::SleepFor(std::chrono::milliseconds{10});
+  }
+  EXPECT_EQ(head_requests.load(), 4);
+}
+
 UTEST(HttpClient, MethodsMix) {
   using clients::http::Request;
 
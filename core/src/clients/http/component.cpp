@@ -203,6 +203,95 @@ properties:
         type: boolean
         description: whether to defer events execution to a periodic timer; might affect timings a bit, might boost performance, use with care
         defaultDescription: false
+    multiplexing-enabled:
+        type: boolean
+        description: whether to multiplex HTTP/2 requests to the same host over a single connection
+        defaultDescription: false
+    max-host-connections:
+        type: integer
+        description: max number of connections to a single host per IO thread, 0 is unlimited
+        defaultDescription: 0
+    max-concurrent-streams:
+        type: integer
+        description: max number of HTTP/2 streams multiplexed over a single connection
+        defaultDescription: 100
+    preconnect:
+        type: object
+        description: keep warm connections to the destinations
+        additionalProperties: false
+        properties:
+            urls:
+                type: array
+                description: URLs to request with HEAD to open and refresh the connections
+                defaultDescription: '[]'
+                items:
+                    type: string
+                    description: URL
+            connections:
+                type: integer
+                description: number of connections to each destination per IO thread
+                defaultDescription: 1
+            refresh-period:
+                type: string
+                description: period of the requests, must be less than the keep-alive timeout of the destinations
+                defaultDescription: 60s
+    concurrency-limiter:
+        type: object
+        description: adaptive limit of the requests in flight to each destination metric, the requests over the limit fail at once
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: whether to limit the requests in flight
+                defaultDescription: false
+            initial-limit:
+                type: integer
+                description: limit of a new destination
+                defaultDescription: 20
+            min-limit:
+                type: integer
+                description: lower bound of the limit
+                defaultDescription: 1
+            max-limit:
+                type: integer
+                description: upper bound of the limit
+                defaultDescription: 1000
+            rtt-tolerance:
+                type: number
+                description: ratio of the recent response time to the long-term one that does not shrink the limit
+                defaultDescription: 1.5
+            smoothing:
+                type: number
+                description: weight of a new sample in the limit, from (0, 1]
+                defaultDescription: 0.2
+    address-balancer:
+        type: object
+        description: balance the requests over all the addresses of a hostname, works only with dns_resolver 'async'
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: whether to send each request to the least loaded of two random addresses
+                defaultDescription: false
+            ejection-period:
+                type: string
+                description: time to skip an address after a network error
+                defaultDescription: 10s
+    direct-transport:
+        type: object
+        description: send the plain HTTP requests to the listed destinations on the coroutine sockets instead of libcurl
+        additionalProperties: false
+        properties:
+            destinations:
+                type: array
+                description: list of 'host:port' of the destinations, the host exactly as in the request URLs
+                items:
+                    type: string
+                    description: destination 'host:port'
+            max-idle-connections:
+                type: integer
+                description: max number of the kept alive connections to each destination
+                defaultDescription: 16
     fs-task-processor:
         type: string
         description: task processor to run blocking HTTP related calls, like DNS resolving or hosts reading
@@ -0,0 +1,102 @@
+#include <clients/http/concurrency_limiter.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <userver/clients/http/impl/config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+namespace {
+
+// Number of samples the long-term RTT is averaged over
+constexpr std::size_t kLongWindow = 600;
+constexpr double kMinGradient = 0.5;
+constexpr double kBackoffRatio = 0.9;
+// Long-term RTT drifts to the recent one if the latter is much lower
+constexpr double kLongRttDecayThreshold = 2.0;
+constexpr double kLongRttDecay = 0.95;
+
+}  // namespace
+
+bool ConcurrencyLimiter::TryAcquire(
+    const impl::ConcurrencyLimiterSettings& settings) noexcept {
+  auto limit = limit_.load(std::memory_order_relaxed);
+  if (limit == 0) {
+    limit_.compare_exchange_strong(limit, settings.initial_limit,
+                                   std::memory_order_relaxed);
+    limit = limit_.load(std::memory_order_relaxed);
+  }
+
+  auto in_flight = in_flight_.load(std::memory_order_relaxed);
+  do {
+    if (in_flight >= limit) return false;
+  } while (!in_flight_.compare_exchange_weak(in_flight, in_flight + 1,
+                                             std::memory_order_relaxed,
+                                             std::memory_order_relaxed));
+  return true;
+}
+
+void ConcurrencyLimiter::Release() noexcept {
+  in_flight_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void ConcurrencyLimiter::Release(
+    const impl::ConcurrencyLimiterSettings& settings,
+    std::chrono::microseconds rtt, bool is_dropped) noexcept {
+  const auto in_flight = in_flight_.fetch_sub(1, std::memory_order_relaxed);
+  Update(settings, in_flight, rtt, is_dropped);
+}
+
+std::size_t ConcurrencyLimiter::GetLimit() const noexcept {
+  return limit_.load(std::memory_order_relaxed);
+}
+
+std::size_t ConcurrencyLimiter::GetInFlight() const noexcept {
+  return in_flight_.load(std::memory_order_relaxed);
+}
+
+void ConcurrencyLimiter::Update(
+    const impl::ConcurrencyLimiterSettings& settings, std::size_t in_flight,
+    std::chrono::microseconds rtt, bool is_dropped) noexcept {
+  std::unique_lock lock(mutex_, std::try_to_lock);
+  if (!lock) return;
+
+  if (estimated_limit_ == 0) {
+    estimated_limit_ = static_cast<double>(limit_.load());
+  }
+
+  double new_limit = estimated_limit_ * kBackoffRatio;
+  if (!is_dropped) {
+    const auto sample =
+        static_cast<double>(std::max<std::int64_t>(rtt.count(), 1));
+    if (long_rtt_samples_ < kLongWindow) ++long_rtt_samples_;
+    long_rtt_us_ +=
+        (sample - long_rtt_us_) / static_cast<double>(long_rtt_samples_);
+    if (long_rtt_us_ / sample > kLongRttDecayThreshold) {
+      long_rtt_us_ *= kLongRttDecay;
+    }
+
+    // Do not grow the limit that is not used
+    if (static_cast<double>(in_flight) * 2 < estimated_limit_) return;
+
+    const auto gradient = std::clamp(
+        settings.rtt_tolerance * long_rtt_us_ / sample, kMinGradient, 1.0);
+    const auto queue_size = std::sqrt(estimated_limit_);
+    new_limit = estimated_limit_ * (1 - settings.smoothing) +
+                (estimated_limit_ * gradient + queue_size) * settings.smoothing;
+  }
+
+  estimated_limit_ =
+      std::clamp(new_limit, static_cast<double>(settings.min_limit),
+                 static_cast<double>(settings.max_limit));
+  limit_.store(static_cast<std::size_t>(estimated_limit_),
+               std::memory_order_relaxed);
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
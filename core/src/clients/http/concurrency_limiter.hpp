@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+namespace impl {
+struct ConcurrencyLimiterSettings;
+}  // namespace impl
+
+/// Adaptive limit of the requests in flight to a destination, implements the
+/// gradient algorithm of https://github.com/Netflix/concurrency-limits
+/// (Gradient2Limit) with multiplicative decrease on dropped requests.
+///
+/// The limit grows while the recent RTT stays close to the long-term one and
+/// shrinks when the recent RTT grows, so the requests to a degraded
+/// destination fail fast instead of waiting for their timeouts. The settings
+/// are taken on each call as the limiter is created along with the destination
+/// statistics.
+class ConcurrencyLimiter final {
+ public:
+  /// Takes a slot for a new request if the current limit allows it
+  bool TryAcquire(const impl::ConcurrencyLimiterSettings& settings) noexcept;
+
+  /// Returns the slot of a request that has no meaningful RTT, e.g. cancelled
+  void Release() noexcept;
+
+  /// Returns the slot and updates the limit with the request RTT. Dropped
+  /// requests (timeouts, network errors) decrease the limit at once.
+  void Release(const impl::ConcurrencyLimiterSettings& settings,
+               std::chrono::microseconds rtt, bool is_dropped) noexcept;
+
+  /// Zero until the first request
+  std::size_t GetLimit() const noexcept;
+  std::size_t GetInFlight() const noexcept;
+
+ private:
+  void Update(const impl::ConcurrencyLimiterSettings& settings,
+              std::size_t in_flight, std::chrono::microseconds rtt,
+              bool is_dropped) noexcept;
+
+  std::atomic<std::size_t> in_flight_{0};
+  std::atomic<std::size_t> limit_{0};
+
+  // Samples are lossy by nature, an update is skipped if the mutex is taken
+  std::mutex mutex_;
+  double estimated_limit_{0};
+  double long_rtt_us_{0};
+  std::size_t long_rtt_samples_{0};
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
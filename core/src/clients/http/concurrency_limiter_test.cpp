@@ -0,0 +1,105 @@
+#include <clients/http/concurrency_limiter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <userver/clients/http/impl/config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using clients::http::ConcurrencyLimiter;
+
+constexpr std::chrono::microseconds kRtt{10'000};
+
+clients::http::impl::ConcurrencyLimiterSettings MakeSettings() {
+  clients::http::impl::ConcurrencyLimiterSettings settings;
+  settings.enabled = true;
+  settings.initial_limit = 10;
+  settings.min_limit = 2;
+  settings.max_limit = 100;
+  return settings;
+}
+
+std::size_t AcquireAll(ConcurrencyLimiter& limiter,
+                       const clients::http::impl::ConcurrencyLimiterSettings&
+                           settings) {
+  std::size_t acquired = 0;
+  while (limiter.TryAcquire(settings)) ++acquired;
+  return acquired;
+}
+
+}  // namespace
+
+TEST(HttpConcurrencyLimiter, InitialLimit) {
+  const auto settings = MakeSettings();
+  ConcurrencyLimiter limiter;
+  EXPECT_EQ(limiter.GetLimit(), 0);
+
+  EXPECT_EQ(AcquireAll(limiter, settings), settings.initial_limit);
+  EXPECT_EQ(limiter.GetLimit(), settings.initial_limit);
+  EXPECT_EQ(limiter.GetInFlight(), settings.initial_limit);
+
+  limiter.Release();
+  EXPECT_TRUE(limiter.TryAcquire(settings));
+  EXPECT_FALSE(limiter.TryAcquire(settings));
+}
+
+TEST(HttpConcurrencyLimiter, GrowsWhileRttIsStable) {
+  const auto settings = MakeSettings();
+  ConcurrencyLimiter limiter;
+
+  for (int i = 0; i < 100; ++i) {
+    const auto acquired = AcquireAll(limiter, settings);
+    for (std::size_t j = 0; j < acquired; ++j) {
+      limiter.Release(settings, kRtt, false);
+    }
+  }
+  EXPECT_EQ(limiter.GetLimit(), settings.max_limit);
+  EXPECT_EQ(limiter.GetInFlight(), 0);
+}
+
+TEST(HttpConcurrencyLimiter, ShrinksWhenRttGrows) {
+  const auto settings = MakeSettings();
+  ConcurrencyLimiter limiter;
+
+  for (int i = 0; i < 10; ++i) {
+    const auto acquired = AcquireAll(limiter, settings);
+    for (std::size_t j = 0; j < acquired; ++j) {
+      limiter.Release(settings, kRtt, false);
+    }
+  }
+  const auto stable_limit = limiter.GetLimit();
+
+  for (int i = 0; i < 10; ++i) {
+    const auto acquired = AcquireAll(limiter, settings);
+    for (std::size_t j = 0; j < acquired; ++j) {
+      limiter.Release(settings, kRtt * 10, false);
+    }
+  }
+  EXPECT_LT(limiter.GetLimit(), stable_limit);
+}
+
+TEST(HttpConcurrencyLimiter, BacksOffOnDrops) {
+  const auto settings = MakeSettings();
+  ConcurrencyLimiter limiter;
+
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(limiter.TryAcquire(settings));
+    limiter.Release(settings, kRtt, true);
+  }
+  EXPECT_EQ(limiter.GetLimit(), settings.min_limit);
+}
+
+TEST(HttpConcurrencyLimiter, IdleLimitDoesNotGrow) {
+  const auto settings = MakeSettings();
+  ConcurrencyLimiter limiter;
+
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(limiter.TryAcquire(settings));
+    limiter.Release(settings, kRtt, false);
+  }
+  EXPECT_EQ(limiter.GetLimit(), settings.initial_limit);
+}
+
+USERVER_NAMESPACE_END
@@ -66,6 +66,16 @@ void DestinationStatistics::SetAutoMaxSize(size_t max_auto_destinations) {
   max_auto_destinations_ = max_auto_destinations;
 }
 
+void DestinationStatistics::SetConcurrencyLimiterSettings(
+    const impl::ConcurrencyLimiterSettings& settings) {
+  concurrency_limiter_settings_ = settings;
+}
+
+const impl::ConcurrencyLimiterSettings&
+DestinationStatistics::GetConcurrencyLimiterSettings() const {
+  return concurrency_limiter_settings_;
+}
+
 DestinationStatistics::DestinationsMap::ConstIterator
 DestinationStatistics::begin() const {
   return rcu_map_.begin();
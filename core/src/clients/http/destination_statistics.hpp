@@ -3,6 +3,7 @@
 #include <memory>
 #include <unordered_map>
 
+#include <userver/clients/http/impl/config.hpp>
 #include <userver/rcu/rcu_map.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 
@@ -25,6 +26,11 @@ class DestinationStatistics final {
 
   void SetAutoMaxSize(size_t max_auto_destinations);
 
+  // Must be set before the first request
+  void SetConcurrencyLimiterSettings(
+      const impl::ConcurrencyLimiterSettings& settings);
+  const impl::ConcurrencyLimiterSettings& GetConcurrencyLimiterSettings() const;
+
   using DestinationsMap = rcu::RcuMap<std::string, Statistics>;
 
   DestinationsMap::ConstIterator begin() const;
@@ -39,6 +45,7 @@ class DestinationStatistics final {
 
   rcu::RcuMap<std::string, Statistics> rcu_map_;
   size_t max_auto_destinations_{0};
+  impl::ConcurrencyLimiterSettings concurrency_limiter_settings_;
   std::atomic<size_t> current_auto_destinations_{0};
 };
 
@@ -0,0 +1,348 @@
+#include <clients/http/direct_transport.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+#include <array>
+#include <optional>
+
+#include <fmt/format.h>
+#include <http_parser.h>
+
+#include <curl-ev/error_code.hpp>
+#include <userver/clients/dns/exception.hpp>
+#include <userver/clients/dns/resolver.hpp>
+#include <userver/clients/http/response.hpp>
+#include <userver/engine/io/exception.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_response_cookie.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+namespace {
+
+constexpr std::size_t kReadBufferSize = 16 * 1024;
+
+std::string MakeDestination(std::string_view host, std::uint16_t port) {
+  return fmt::format("{}:{}", host, port);
+}
+
+std::optional<engine::io::Sockaddr> ParseNumericAddress(std::string_view host,
+                                                        std::uint16_t port) {
+  engine::io::Sockaddr addr;
+  // IPv6 addresses are in brackets in the URLs
+  if (host.size() > 2 && host.front() == '[' && host.back() == ']') {
+    const std::string ip{host.substr(1, host.size() - 2)};
+    auto* sa = addr.As<sockaddr_in6>();
+    sa->sin6_family = AF_INET6;
+    if (inet_pton(AF_INET6, ip.c_str(), &sa->sin6_addr) != 1) {
+      return std::nullopt;
+    }
+  } else {
+    const std::string ip{host};
+    auto* sa = addr.As<sockaddr_in>();
+    sa->sin_family = AF_INET;
+    if (inet_pton(AF_INET, ip.c_str(), &sa->sin_addr) != 1) {
+      return std::nullopt;
+    }
+  }
+  addr.SetPort(port);
+  return addr;
+}
+
+engine::io::Socket Connect(const DirectTransport::Request& request,
+                           clients::dns::Resolver* resolver,
+                           engine::Deadline deadline) {
+  clients::dns::AddrVector addrs;
+  if (auto addr = ParseNumericAddress(request.host, request.port)) {
+    addrs.push_back(*addr);
+  } else if (resolver) {
+    addrs = resolver->Resolve(std::string{request.host}, deadline);
+    for (auto& addr : addrs) addr.SetPort(request.port);
+  } else {
+    throw clients::dns::NotResolvedException(fmt::format(
+        "Hostname '{}' requires a DNS resolver for the direct transport",
+        request.host));
+  }
+
+  for (std::size_t i = 0; i < addrs.size(); ++i) {
+    try {
+      engine::io::Socket socket{addrs[i].Domain(),
+                                engine::io::SocketType::kStream};
+      socket.SetOption(IPPROTO_TCP, TCP_NODELAY, 1);
+      socket.Connect(addrs[i], deadline);
+      return socket;
+    } catch (const engine::io::IoSystemError& ex) {
+      LOG_DEBUG() << "Failed to connect to " << addrs[i] << ": " << ex;
+    }
+  }
+  throw std::system_error{curl::errc::EasyErrorCode::kCouldNotConnect};
+}
+
+std::string SerializeHead(const DirectTransport::Request& request) {
+  std::string head;
+  head.reserve(request.method.size() + request.target.size() +
+               request.host.size() + request.header_fields.size() + 64);
+  head.append(request.method);
+  head.push_back(' ');
+  head.append(request.target);
+  head.append(" HTTP/1.1\r\nHost: ");
+  head.append(request.host);
+  head.append(fmt::format(":{}\r\n", request.port));
+  head.append(request.header_fields);
+  if (!request.body.empty() || request.method == "POST" ||
+      request.method == "PUT" || request.method == "PATCH") {
+    head.append(fmt::format("Content-Length: {}\r\n", request.body.size()));
+  }
+  head.append("\r\n");
+  return head;
+}
+
+// Collects the response from http_parser callbacks
+class ResponseParser final {
+ public:
+  ResponseParser(Response& response, bool is_head)
+      : response_(response), is_head_(is_head) {
+    http_parser_init(&parser_, HTTP_RESPONSE);
+    parser_.data = this;
+  }
+
+  /// Returns false for a malformed response
+  bool Feed(const char* data, std::size_t size) {
+    if (size) has_data_ = true;
+    const auto parsed = http_parser_execute(&parser_, &kSettings, data, size);
+    return parsed == size && HTTP_PARSER_ERRNO(&parser_) == HPE_OK;
+  }
+
+  /// The end of the body may be marked by the connection close
+  bool FeedEof() { return Feed(nullptr, 0); }
+
+  bool HasData() const noexcept { return has_data_; }
+  bool IsComplete() const noexcept { return is_complete_; }
+  bool IsKeepAlive() const noexcept { return is_keep_alive_; }
+
+ private:
+  static ResponseParser& Self(http_parser* p) {
+    return *static_cast<ResponseParser*>(p->data);
+  }
+
+  static int OnHeaderField(http_parser* p, const char* data, size_t size) {
+    auto& self = Self(p);
+    if (self.is_in_value_) self.FlushHeader();
+    self.header_name_.append(data, size);
+    return 0;
+  }
+
+  static int OnHeaderValue(http_parser* p, const char* data, size_t size) {
+    auto& self = Self(p);
+    self.is_in_value_ = true;
+    self.header_value_.append(data, size);
+    return 0;
+  }
+
+  static int OnHeadersComplete(http_parser* p) {
+    auto& self = Self(p);
+    if (self.is_in_value_) self.FlushHeader();
+    self.response_.SetStatusCode(static_cast<Status>(p->status_code));
+    // Tells the parser that the response to HEAD has no body
+    return self.is_head_ ? 1 : 0;
+  }
+
+  static int OnBody(http_parser* p, const char* data, size_t size) {
+    Self(p).response_.sink_string().append(data, size);
+    return 0;
+  }
+
+  static int OnMessageComplete(http_parser* p) {
+    auto& self = Self(p);
+    self.is_complete_ = true;
+    self.is_keep_alive_ = http_should_keep_alive(p);
+    return 0;
+  }
+
+  void FlushHeader() {
+    if (utils::StrIcaseEqual{}(header_name_,
+                               USERVER_NAMESPACE::http::headers::kSetCookie)) {
+      if (auto cookie = server::http::Cookie::FromString(header_value_)) {
+        auto name = cookie->Name();
+        response_.cookies().emplace(std::move(name), std::move(*cookie));
+      }
+    } else {
+      response_.headers().emplace(std::move(header_name_),
+                                  std::move(header_value_));
+    }
+    header_name_.clear();
+    header_value_.clear();
+    is_in_value_ = false;
+  }
+
+  static const http_parser_settings kSettings;
+
+  Response& response_;
+  const bool is_head_;
+  http_parser parser_{};
+  std::string header_name_;
+  std::string header_value_;
+  bool is_in_value_{false};
+  bool has_data_{false};
+  bool is_complete_{false};
+  bool is_keep_alive_{false};
+};
+
+const http_parser_settings ResponseParser::kSettings = []() {
+  http_parser_settings settings{};
+  settings.on_header_field = ResponseParser::OnHeaderField;
+  settings.on_header_value = ResponseParser::OnHeaderValue;
+  settings.on_headers_complete = ResponseParser::OnHeadersComplete;
+  settings.on_body = ResponseParser::OnBody;
+  settings.on_message_complete = ResponseParser::OnMessageComplete;
+  return settings;
+}();
+
+enum class ExchangeResult {
+  kKeepAlive,
+  kClose,
+  // A kept alive connection may be closed by the server at any moment, the
+  // request is repeated on a new one if nothing was received
+  kStaleConnection,
+};
+
+ExchangeResult Exchange(engine::io::Socket& socket, std::string_view head,
+                        std::string_view body, bool is_reused,
+                        ResponseParser& parser, engine::Deadline deadline) {
+  try {
+    const engine::io::IoData request_data[]{{head.data(), head.size()},
+                                            {body.data(), body.size()}};
+    [[maybe_unused]] const auto sent =
+        socket.SendAll(request_data, std::size(request_data), deadline);
+  } catch (const engine::io::IoSystemError&) {
+    if (is_reused) return ExchangeResult::kStaleConnection;
+    throw std::system_error{curl::errc::EasyErrorCode::kSendError};
+  }
+
+  std::array<char, kReadBufferSize> buffer{};
+  while (!parser.IsComplete()) {
+    std::size_t size = 0;
+    try {
+      size = socket.RecvSome(buffer.data(), buffer.size(), deadline);
+    } catch (const engine::io::IoSystemError&) {
+      if (is_reused && !parser.HasData()) {
+        return ExchangeResult::kStaleConnection;
+      }
+      throw std::system_error{curl::errc::EasyErrorCode::kRecvError};
+    }
+
+    if (size == 0) {
+      if (is_reused && !parser.HasData()) {
+        return ExchangeResult::kStaleConnection;
+      }
+      if (!parser.FeedEof() || !parser.IsComplete()) {
+        throw std::system_error{curl::errc::EasyErrorCode::kGotNothing};
+      }
+      return ExchangeResult::kClose;
+    }
+    if (!parser.Feed(buffer.data(), size)) {
+      // CURLE_WEIRD_SERVER_REPLY has the old FTP-specific name in the headers
+      throw std::system_error{curl::errc::EasyErrorCode::kFtpWeirdServerReply};
+    }
+  }
+  return parser.IsKeepAlive() ? ExchangeResult::kKeepAlive
+                              : ExchangeResult::kClose;
+}
+
+}  // namespace
+
+DirectTransport::DirectTransport(const impl::DirectTransportSettings& settings)
+    : max_idle_connections_(settings.max_idle_connections),
+      destinations_(settings.destinations.begin(),
+                    settings.destinations.end()) {}
+
+DirectTransport::~DirectTransport() = default;
+
+bool DirectTransport::IsEnabledFor(std::string_view host,
+                                   std::uint16_t port) const {
+  return destinations_.count(MakeDestination(host, port)) != 0;
+}
+
+DirectTransport::Result DirectTransport::Perform(
+    const Request& request, clients::dns::Resolver* resolver,
+    Response& response, engine::Deadline deadline) {
+  const auto destination = MakeDestination(request.host, request.port);
+  const auto head = SerializeHead(request);
+
+  Result result;
+  try {
+    auto socket = TryTakeIdleConnection(destination);
+    bool is_reused = socket.IsValid();
+    while (true) {
+      if (!is_reused) {
+        const auto connect_start = std::chrono::steady_clock::now();
+        socket = Connect(request, resolver, deadline);
+        result.time_to_connect = std::chrono::steady_clock::now() -
+                                 connect_start;
+        ++result.connects;
+      }
+
+      ResponseParser parser{response, request.method == "HEAD"};
+      const auto exchange_result =
+          Exchange(socket, head, request.body, is_reused, parser, deadline);
+      if (exchange_result == ExchangeResult::kStaleConnection) {
+        LOG_DEBUG() << "Kept alive connection to " << destination
+                    << " was closed, reconnecting";
+        socket.Close();
+        is_reused = false;
+        continue;
+      }
+
+      if (exchange_result == ExchangeResult::kKeepAlive) {
+        ReturnIdleConnection(destination, std::move(socket));
+      }
+      return result;
+    }
+  } catch (const clients::dns::ResolverException& ex) {
+    LOG_DEBUG() << "Failed to resolve " << destination << ": " << ex;
+    result.error = curl::errc::EasyErrorCode::kCouldNotResolveHost;
+  } catch (const engine::io::IoTimeout&) {
+    result.error = curl::errc::EasyErrorCode::kOperationTimedout;
+  } catch (const engine::io::IoCancelled&) {
+    result.error = curl::errc::EasyErrorCode::kAbortedByCallback;
+  } catch (const engine::io::IoException& ex) {
+    LOG_DEBUG() << "Direct request to " << destination << " failed: " << ex;
+    result.error = curl::errc::EasyErrorCode::kRecvError;
+  } catch (const std::system_error& ex) {
+    LOG_DEBUG() << "Direct request to " << destination
+                << " failed: " << ex.code().message();
+    result.error = ex.code();
+  }
+  return result;
+}
+
+engine::io::Socket DirectTransport::TryTakeIdleConnection(
+    const std::string& destination) {
+  auto idle_connections = idle_connections_.Lock();
+  const auto it = idle_connections->find(destination);
+  if (it == idle_connections->end() || it->second.empty()) return {};
+
+  auto socket = std::move(it->second.back());
+  it->second.pop_back();
+  return socket;
+}
+
+void DirectTransport::ReturnIdleConnection(const std::string& destination,
+                                           engine::io::Socket&& socket) {
+  auto idle_connections = idle_connections_.Lock();
+  auto& connections = (*idle_connections)[destination];
+  // The extra connection is closed by the socket destructor
+  if (connections.size() < max_idle_connections_) {
+    connections.push_back(std::move(socket));
+  }
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <userver/clients/dns/resolver_fwd.hpp>
+#include <userver/clients/http/impl/config.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/io/socket.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+class Response;
+
+/// Performs plain HTTP/1.1 requests to the configured destinations on
+/// engine::io::Socket in the calling coroutine, without libcurl and the ev
+/// thread hops. Connections are kept alive in a per-destination pool.
+class DirectTransport final {
+ public:
+  struct Request final {
+    std::string_view method;
+    std::string_view host;
+    std::uint16_t port{0};
+    /// path with the query
+    std::string_view target;
+    /// serialized header fields, each one ends with CRLF
+    std::string_view header_fields;
+    std::string_view body;
+  };
+
+  struct Result final {
+    std::error_code error;
+    std::size_t connects{0};
+    std::chrono::steady_clock::duration time_to_connect{};
+  };
+
+  explicit DirectTransport(const impl::DirectTransportSettings& settings);
+  ~DirectTransport();
+
+  /// Whether the requests to `host`:`port` go through the transport
+  bool IsEnabledFor(std::string_view host, std::uint16_t port) const;
+
+  /// Fills the status code, headers, cookies and body of the `response`.
+  /// The hostname is resolved with `resolver`, only the numeric addresses are
+  /// accepted without it. Must be called from a coroutine.
+  Result Perform(const Request& request, clients::dns::Resolver* resolver,
+                 Response& response, engine::Deadline deadline);
+
+ private:
+  using IdleConnections =
+      std::unordered_map<std::string, std::vector<engine::io::Socket>>;
+
+  engine::io::Socket TryTakeIdleConnection(const std::string& destination);
+  void ReturnIdleConnection(const std::string& destination,
+                            engine::io::Socket&& socket);
+
+  const std::size_t max_idle_connections_;
+  std::unordered_set<std::string> destinations_;
+  concurrent::Variable<IdleConnections> idle_connections_;
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
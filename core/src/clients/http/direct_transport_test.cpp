@@ -0,0 +1,132 @@
+#include <clients/http/direct_transport.hpp>
+
+#include <fmt/format.h>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/clients/http/impl/config.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/http/predefined_header.hpp>
+#include <userver/tracing/manager.hpp>
+#include <userver/utest/simple_server.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using HttpResponse = utest::SimpleServer::Response;
+using HttpRequest = utest::SimpleServer::Request;
+
+constexpr http::headers::PredefinedHeader kTestHeader{"X-Test"};
+
+constexpr char kKeepAliveResponse[] =
+    "HTTP/1.1 200 OK\r\nContent-Length: 2\r\nX-Test: value\r\n\r\nok";
+
+std::shared_ptr<clients::http::Client> CreateDirectHttpClient(
+    const utest::SimpleServer& server) {
+  static const tracing::GenericTracingManager kTracingManager{
+      tracing::Format::kYandexTaxi, tracing::Format::kYandexTaxi};
+
+  clients::http::impl::ClientSettings static_config;
+  static_config.io_threads = 1;
+  static_config.tracing_manager = &kTracingManager;
+  static_config.direct_transport.destinations = {
+      fmt::format("127.0.0.1:{}", server.GetPort())};
+
+  return std::make_shared<clients::http::Client>(
+      std::move(static_config), engine::current_task::GetTaskProcessor(),
+      std::vector<utils::NotNull<clients::http::Plugin*>>{});
+}
+
+}  // namespace
+
+UTEST(HttpClientDirectTransport, KeepAlive) {
+  std::vector<std::string> requests;
+  const utest::SimpleServer http_server{[&requests](const HttpRequest& request) {
+    requests.push_back(request);
+    return HttpResponse{kKeepAliveResponse, HttpResponse::kWriteAndContinue};
+  }};
+  auto http_client_ptr = CreateDirectHttpClient(http_server);
+
+  for (int i = 0; i < 3; ++i) {
+    const auto response = http_client_ptr->CreateRequest()
+                              .get(http_server.GetBaseUrl() + "/path?arg=1")
+                              .headers({{"X-Request", "value"}})
+                              .timeout(utest::kMaxTestWaitTime)
+                              .perform();
+    EXPECT_TRUE(response->IsOk());
+    EXPECT_EQ(response->body_view(), "ok");
+    EXPECT_EQ(response->headers()[kTestHeader], "value");
+  }
+
+  EXPECT_EQ(http_server.GetConnectionsOpenedCount(), 1);
+  ASSERT_EQ(requests.size(), 3);
+  EXPECT_EQ(requests[0].rfind("GET /path?arg=1 HTTP/1.1\r\n", 0), 0)
+      << requests[0];
+  EXPECT_NE(requests[0].find("\r\nX-Request: value\r\n"), std::string::npos)
+      << requests[0];
+}
+
+UTEST(HttpClientDirectTransport, PostChunkedResponse) {
+  std::string received;
+  const utest::SimpleServer http_server{[&received](const HttpRequest& request) {
+    received = request;
+    return HttpResponse{
+        "HTTP/1.1 201 Created\r\nTransfer-Encoding: chunked\r\n\r\n"
+        "2\r\nok\r\n0\r\n\r\n",
+        HttpResponse::kWriteAndContinue};
+  }};
+  auto http_client_ptr = CreateDirectHttpClient(http_server);
+
+  const auto response = http_client_ptr->CreateRequest()
+                            .post(http_server.GetBaseUrl(), "data")
+                            .timeout(utest::kMaxTestWaitTime)
+                            .perform();
+  EXPECT_EQ(response->status_code(), clients::http::Status::Created);
+  EXPECT_EQ(response->body_view(), "ok");
+
+  EXPECT_EQ(received.rfind("POST / HTTP/1.1\r\n", 0), 0) << received;
+  EXPECT_NE(received.find("\r\nContent-Length: 4\r\n"), std::string::npos)
+      << received;
+  EXPECT_EQ(received.substr(received.size() - 8), "\r\n\r\ndata") << received;
+}
+
+UTEST(HttpClientDirectTransport, ConnectionClose) {
+  const utest::SimpleServer http_server{[](const HttpRequest&) {
+    return HttpResponse{
+        "HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: 2\r\n\r\nok",
+        HttpResponse::kWriteAndClose};
+  }};
+  auto http_client_ptr = CreateDirectHttpClient(http_server);
+
+  for (int i = 0; i < 2; ++i) {
+    const auto response = http_client_ptr->CreateRequest()
+                              .get(http_server.GetBaseUrl())
+                              .timeout(utest::kMaxTestWaitTime)
+                              .perform();
+    EXPECT_EQ(response->body_view(), "ok");
+  }
+  EXPECT_EQ(http_server.GetConnectionsOpenedCount(), 2);
+}
+
+UTEST(HttpClientDirectTransport, StaleConnectionIsReopened) {
+  int requests = 0;
+  const utest::SimpleServer http_server{[&requests](const HttpRequest&) {
+    // Keeps the connection alive in the response, but closes it
+    ++requests;
+    return HttpResponse{kKeepAliveResponse, HttpResponse::kWriteAndClose};
+  }};
+  auto http_client_ptr = CreateDirectHttpClient(http_server);
+
+  for (int i = 0; i < 2; ++i) {
+    const auto response = http_client_ptr->CreateRequest()
+                              .get(http_server.GetBaseUrl())
+                              .timeout(utest::kMaxTestWaitTime)
+                              .perform();
+    EXPECT_EQ(response->body_view(), "ok");
+  }
+  EXPECT_EQ(requests, 2);
+  EXPECT_EQ(http_server.GetConnectionsOpenedCount(), 2);
+}
+
+USERVER_NAMESPACE_END
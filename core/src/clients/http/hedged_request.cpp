@@ -0,0 +1,86 @@
+#include <userver/clients/http/hedged_request.hpp>
+
+#include <exception>
+#include <optional>
+#include <vector>
+
+#include <userver/clients/http/error.hpp>
+#include <userver/clients/http/response_future.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/wait_any.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <clients/http/statistics.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+std::shared_ptr<Response> PerformHedged(const std::function<Request()>& factory,
+                                        const HedgingSettings& settings) {
+  UINVARIANT(settings.max_attempts > 0, "max_attempts must be positive");
+
+  // Requests are kept alive until the response to reuse their easy handles
+  std::vector<Request> requests;
+  std::vector<ResponseFuture> futures;
+  requests.reserve(settings.max_attempts);
+  futures.reserve(settings.max_attempts);
+
+  requests.push_back(factory());
+  const auto stats = requests.front().GetDestinationRequestStats();
+  const auto delay =
+      stats ? stats->GetHedgingDelay(settings) : settings.min_delay;
+  if (stats) stats->AccountHedgedRequest(settings);
+  futures.push_back(requests.front().async_perform());
+
+  std::size_t in_flight = 1;
+  bool is_budget_exhausted = false;
+  const auto can_start_attempt = [&] {
+    return !is_budget_exhausted && futures.size() < settings.max_attempts;
+  };
+  const auto try_start_attempt = [&] {
+    if (stats && !stats->TryAccountHedgedAttempt(settings)) {
+      is_budget_exhausted = true;
+      return false;
+    }
+    requests.push_back(factory());
+    futures.push_back(requests.back().async_perform());
+    ++in_flight;
+    return true;
+  };
+
+  std::exception_ptr last_error;
+  while (true) {
+    const auto index = can_start_attempt()
+                           ? engine::WaitAnyFor(delay, futures)
+                           : engine::WaitAny(futures);
+    if (!index) {
+      if (engine::current_task::ShouldCancel()) {
+        // ResponseFuture destructors cancel the attempts
+        throw CancelException(
+            "HTTP hedged response wait was aborted due to task cancellation",
+            {});
+      }
+      try_start_attempt();
+      continue;
+    }
+
+    --in_flight;
+    try {
+      auto response = futures[*index].Get();
+      if (*index != 0 && stats) stats->AccountHedgedAttemptWon();
+      return response;
+    } catch (const BaseException&) {
+      last_error = std::current_exception();
+    }
+
+    // Failed attempts have no use for hedging delay, the next one starts now
+    if (in_flight == 0 && !(can_start_attempt() && try_start_attempt())) {
+      std::rethrow_exception(last_error);
+    }
+  }
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
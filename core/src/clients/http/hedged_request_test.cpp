@@ -0,0 +1,96 @@
+#include <userver/clients/http/hedged_request.hpp>
+
+#include <atomic>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/simple_server.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using HttpResponse = utest::SimpleServer::Response;
+using HttpRequest = utest::SimpleServer::Request;
+
+constexpr char kOkResponse[] =
+    "HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: 2\r\n\r\nok";
+
+// Answers the first request after the test timeout, others at once
+utest::SimpleServer::OnRequest MakeSlowFirstCallback(
+    std::atomic<int>& requests) {
+  return [&requests](const HttpRequest&) {
+    if (requests.fetch_add(1) == 0) {
+      engine::InterruptibleSleepFor(utest::kMaxTestWaitTime);
+    }
+    return HttpResponse{kOkResponse, HttpResponse::kWriteAndClose};
+  };
+}
+
+}  // namespace
+
+UTEST(HttpClientHedging, SingleAttempt) {
+  auto http_client_ptr = utest::CreateHttpClient();
+  std::atomic<int> requests{0};
+  const utest::SimpleServer http_server{[&requests](const HttpRequest&) {
+    ++requests;
+    return HttpResponse{kOkResponse, HttpResponse::kWriteAndClose};
+  }};
+
+  clients::http::HedgingSettings settings;
+  settings.min_delay = utest::kMaxTestWaitTime;
+  const auto response = clients::http::PerformHedged(
+      [&] {
+        return http_client_ptr->CreateRequest()
+            .get(http_server.GetBaseUrl())
+            .timeout(utest::kMaxTestWaitTime);
+      },
+      settings);
+
+  EXPECT_TRUE(response->IsOk());
+  EXPECT_EQ(response->body_view(), "ok");
+  EXPECT_EQ(requests.load(), 1);
+}
+
+UTEST(HttpClientHedging, HedgedAttemptWins) {
+  auto http_client_ptr = utest::CreateHttpClient();
+  std::atomic<int> requests{0};
+  const utest::SimpleServer http_server{MakeSlowFirstCallback(requests)};
+
+  clients::http::HedgingSettings settings;
+  settings.min_delay = std::chrono::milliseconds{50};
+  const auto response = clients::http::PerformHedged(
+      [&] {
+        return http_client_ptr->CreateRequest()
+            .get(http_server.GetBaseUrl())
+            .timeout(utest::kMaxTestWaitTime);
+      },
+      settings);
+
+  EXPECT_TRUE(response->IsOk());
+  EXPECT_EQ(response->body_view(), "ok");
+  EXPECT_EQ(requests.load(), 2);
+}
+
+UTEST(HttpClientHedging, AllAttemptsFail) {
+  auto http_client_ptr = utest::CreateHttpClient();
+  std::atomic<int> requests{0};
+  const utest::SimpleServer http_server{MakeSlowFirstCallback(requests)};
+
+  clients::http::HedgingSettings settings;
+  settings.max_attempts = 1;
+  settings.min_delay = std::chrono::milliseconds{10};
+  EXPECT_THROW(clients::http::PerformHedged(
+                   [&] {
+                     return http_client_ptr->CreateRequest()
+                         .get(http_server.GetBaseUrl())
+                         .retry(1)
+                         .timeout(std::chrono::milliseconds{100});
+                   },
+                   settings),
+               clients::http::TimeoutException);
+}
+
+USERVER_NAMESPACE_END
@@ -1,9 +1,12 @@
 #include <userver/clients/http/impl/config.hpp>
 
+#include <stdexcept>
 #include <string_view>
+#include <vector>
 
 #include <userver/dynamic_config/value.hpp>
 #include <userver/formats/json/value.hpp>
+#include <userver/formats/parse/common_containers.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -37,6 +40,85 @@ DeadlinePropagationConfig ParseDeadlinePropagationConfig(
   return result;
 }
 
+PreconnectSettings ParsePreconnectSettings(
+    const yaml_config::YamlConfig& value) {
+  PreconnectSettings result;
+  result.urls = value["urls"].As<std::vector<std::string>>(result.urls);
+  result.connections = value["connections"].As<size_t>(result.connections);
+  result.refresh_period = value["refresh-period"].As<std::chrono::milliseconds>(
+      result.refresh_period);
+  if (result.refresh_period <= std::chrono::milliseconds::zero()) {
+    throw std::runtime_error("preconnect.refresh-period must be positive");
+  }
+  return result;
+}
+
+ConcurrencyLimiterSettings ParseConcurrencyLimiterSettings(
+    const yaml_config::YamlConfig& value) {
+  ConcurrencyLimiterSettings result;
+  result.enabled = value["enabled"].As<bool>(result.enabled);
+  result.min_limit = value["min-limit"].As<size_t>(result.min_limit);
+  result.max_limit = value["max-limit"].As<size_t>(result.max_limit);
+  result.initial_limit =
+      value["initial-limit"].As<size_t>(result.initial_limit);
+  result.rtt_tolerance =
+      value["rtt-tolerance"].As<double>(result.rtt_tolerance);
+  result.smoothing = value["smoothing"].As<double>(result.smoothing);
+
+  if (result.min_limit == 0) {
+    throw std::runtime_error("concurrency-limiter.min-limit must be positive");
+  }
+  if (result.max_limit < result.min_limit) {
+    throw std::runtime_error(
+        "concurrency-limiter.max-limit must not be less than min-limit");
+  }
+  if (result.initial_limit < result.min_limit ||
+      result.initial_limit > result.max_limit) {
+    throw std::runtime_error(
+        "concurrency-limiter.initial-limit must be within [min-limit, "
+        "max-limit]");
+  }
+  if (result.rtt_tolerance < 1.0) {
+    throw std::runtime_error(
+        "concurrency-limiter.rtt-tolerance must not be less than 1");
+  }
+  if (result.smoothing <= 0.0 || result.smoothing > 1.0) {
+    throw std::runtime_error("concurrency-limiter.smoothing must be in (0, 1]");
+  }
+  return result;
+}
+
+AddressBalancerSettings ParseAddressBalancerSettings(
+    const yaml_config::YamlConfig& value) {
+  AddressBalancerSettings result;
+  result.enabled = value["enabled"].As<bool>(result.enabled);
+  result.ejection_period =
+      value["ejection-period"].As<std::chrono::milliseconds>(
+          result.ejection_period);
+  return result;
+}
+
+DirectTransportSettings ParseDirectTransportSettings(
+    const yaml_config::YamlConfig& value) {
+  DirectTransportSettings result;
+  result.destinations =
+      value["destinations"].As<std::vector<std::string>>(result.destinations);
+  for (const auto& destination : result.destinations) {
+    const auto pos = destination.rfind(':');
+    if (pos == 0 || pos == std::string::npos ||
+        pos + 1 == destination.size() ||
+        destination.find_first_not_of("0123456789", pos + 1) !=
+            std::string::npos) {
+      throw std::runtime_error(
+          "direct-transport.destinations must be in 'host:port' format, got '" +
+          destination + "'");
+    }
+  }
+  result.max_idle_connections = value["max-idle-connections"].As<std::size_t>(
+      result.max_idle_connections);
+  return result;
+}
+
 }  // namespace
 
 ClientSettings Parse(const yaml_config::YamlConfig& value,
@@ -46,7 +128,23 @@ ClientSettings Parse(const yaml_config::YamlConfig& value,
       value["thread-name-prefix"].As<std::string>(result.thread_name_prefix);
   result.io_threads = value["threads"].As<size_t>(result.io_threads);
   result.defer_events = value["defer-events"].As<bool>(result.defer_events);
+  result.multiplexing_enabled = value["multiplexing-enabled"].As<bool>(
+      result.multiplexing_enabled);
+  result.max_host_connections = value["max-host-connections"].As<size_t>(
+      result.max_host_connections);
+  result.max_concurrent_streams = value["max-concurrent-streams"].As<size_t>(
+      result.max_concurrent_streams);
+  if (result.max_concurrent_streams == 0) {
+    throw std::runtime_error("max-concurrent-streams must be positive");
+  }
   result.deadline_propagation = ParseDeadlinePropagationConfig(value);
+  result.preconnect = ParsePreconnectSettings(value["preconnect"]);
+  result.concurrency_limiter =
+      ParseConcurrencyLimiterSettings(value["concurrency-limiter"]);
+  result.address_balancer =
+      ParseAddressBalancerSettings(value["address-balancer"]);
+  result.direct_transport =
+      ParseDirectTransportSettings(value["direct-transport"]);
   return result;
 }
 
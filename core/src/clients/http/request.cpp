@@ -230,6 +230,14 @@ ResponseFuture Request::async_perform(utils::impl::SourceLocation location) {
   return ResponseFuture{pimpl_->async_perform(location), pimpl_};
 }
 
+ResponseFuture Request::async_perform_sink(
+    std::shared_ptr<ResponseBodySink> sink,
+    utils::impl::SourceLocation location) {
+  UINVARIANT(sink, "Response body sink must not be null");
+  return ResponseFuture{pimpl_->async_perform_sink(std::move(sink), location),
+                        pimpl_};
+}
+
 StreamedResponse Request::async_perform_stream_body(
     const std::shared_ptr<concurrent::StringStreamQueue>& queue,
     utils::impl::SourceLocation location) {
@@ -378,6 +386,7 @@ Request Request::data(std::string data) && {
 
 Request& Request::form(const Form& form) & {
   pimpl_->easy().set_http_post(form.GetNative());
+  pimpl_->DisableDirectTransport();
   pimpl_->easy().add_header(kHeaderExpect, "",
                             curl::easy::EmptyHeaderAction::kDoNotSend);
   return *this;
@@ -441,6 +450,7 @@ Request Request::proxy_headers(
 
 Request& Request::user_agent(const std::string& value) & {
   pimpl_->easy().set_user_agent(value.c_str());
+  pimpl_->SetDirectUserAgent(value);
   return *this;
 }
 Request Request::user_agent(const std::string& value) && {
@@ -465,6 +475,7 @@ Request Request::proxy_auth_type(ProxyAuthType value) && {
 
 Request& Request::cookies(const Cookies& cookies) & {
   SetCookies(pimpl_->easy(), cookies);
+  pimpl_->DisableDirectTransport();
   return *this;
 }
 Request Request::cookies(const Cookies& cookies) && {
@@ -474,6 +485,7 @@ Request Request::cookies(const Cookies& cookies) && {
 Request& Request::cookies(
     const std::unordered_map<std::string, std::string>& cookies) & {
   SetCookies(pimpl_->easy(), cookies);
+  pimpl_->DisableDirectTransport();
   return *this;
 }
 Request Request::cookies(
@@ -504,6 +516,7 @@ Request& Request::method(HttpMethod method) & {
       if (!pimpl_->easy().has_post_data()) data({});
       break;
   };
+  pimpl_->SetDirectMethod(ToString(method));
   return *this;
 }
 
@@ -535,6 +548,7 @@ Request& Request::set_custom_http_request_method(std::string method) & {
          "changing of request type. Use it only if you need to make "
          "GET-request with body.";
   pimpl_->easy().set_custom_request(method);
+  pimpl_->SetDirectMethod(std::move(method));
   return *this;
 }
 Request Request::set_custom_http_request_method(std::string method) && {
@@ -623,6 +637,14 @@ void Request::SetDeadlinePropagationConfig(
   pimpl_->SetDeadlinePropagationConfig(deadline_propagation_config);
 }
 
+void Request::SetDirectTransport(DirectTransport* transport) & {
+  pimpl_->SetDirectTransport(transport);
+}
+
+void Request::SetAddressBalancer(AddressBalancer* balancer) & {
+  pimpl_->SetAddressBalancer(balancer);
+}
+
 Request& Request::DisableReplyDecoding() & {
   pimpl_->DisableReplyDecoding();
   return *this;
@@ -658,6 +680,10 @@ std::string Request::ExtractData() {
   return pimpl_->easy().extract_post_data();
 }
 
+std::shared_ptr<RequestStats> Request::GetDestinationRequestStats() {
+  return pimpl_->GetDestinationRequestStats();
+}
+
 }  // namespace clients::http
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,99 @@
+#include <userver/clients/http/request_batch.hpp>
+
+#include <exception>
+
+#include <userver/clients/http/error.hpp>
+#include <userver/engine/wait_any.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <clients/http/request_state.hpp>
+#include <curl-ev/easy.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+namespace {
+
+// Finished requests are left out of engine::WaitAny
+struct PendingFuture final {
+  engine::impl::ContextAccessor* TryGetContextAccessor() noexcept {
+    return future ? future->TryGetContextAccessor() : nullptr;
+  }
+
+  ResponseFuture* future;
+};
+
+}  // namespace
+
+RequestBatch::~RequestBatch() = default;
+
+std::size_t RequestBatch::Add(Request request) {
+  UINVARIANT(futures_.empty(), "Requests may not be added after Perform()");
+  requests_.push_back(std::move(request));
+  return requests_.size() - 1;
+}
+
+std::size_t RequestBatch::GetSize() const noexcept { return requests_.size(); }
+
+void RequestBatch::Perform(utils::impl::SourceLocation location) {
+  UINVARIANT(futures_.empty(), "RequestBatch may be performed only once");
+
+  tracing::Span span{"http_batch"};
+  span.AddTag("batch_size", requests_.size());
+
+  curl::perform_batch batch;
+  futures_.reserve(requests_.size());
+  try {
+    for (auto& request : requests_) {
+      futures_.emplace_back(request.pimpl_->async_perform(batch, location),
+                            request.pimpl_);
+    }
+  } catch (const std::exception&) {
+    // The requests that are already set up still have to be started to let
+    // their futures complete
+    is_finished_.assign(futures_.size(), false);
+    batch.async_perform();
+    throw;
+  }
+  is_finished_.assign(futures_.size(), false);
+  batch.async_perform();
+}
+
+bool RequestBatch::WaitAll(engine::Deadline deadline) {
+  WaitFirstN(futures_.size(), deadline);
+  return finished_count_ == futures_.size();
+}
+
+std::vector<std::size_t> RequestBatch::WaitFirstN(std::size_t count,
+                                                  engine::Deadline deadline) {
+  UINVARIANT(!futures_.empty() || requests_.empty(),
+             "RequestBatch must be performed before waiting");
+
+  std::vector<PendingFuture> pending;
+  pending.reserve(futures_.size());
+  for (std::size_t i = 0; i < futures_.size(); ++i) {
+    pending.push_back({is_finished_[i] ? nullptr : &futures_[i]});
+  }
+
+  std::vector<std::size_t> result;
+  while (result.size() < count && finished_count_ < futures_.size()) {
+    const auto index = engine::WaitAnyUntil(deadline, pending);
+    if (!index) break;
+    pending[*index].future = nullptr;
+    is_finished_[*index] = true;
+    ++finished_count_;
+    result.push_back(*index);
+  }
+  return result;
+}
+
+std::shared_ptr<Response> RequestBatch::Get(std::size_t index) {
+  UINVARIANT(index < futures_.size(), "No such request in the RequestBatch");
+  return futures_[index].Get();
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
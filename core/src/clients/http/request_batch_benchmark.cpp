@@ -0,0 +1,74 @@
+#include <userver/clients/http/request_batch.hpp>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/clients/http/impl/config.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/tracing/manager.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Nothing listens there, the requests fail at once without a network
+// round-trip leaving the cost of the submission and the completion
+constexpr char kUrl[] = "http://127.0.0.1:1/";
+
+std::shared_ptr<clients::http::Client> MakeClient() {
+  static const tracing::GenericTracingManager kTracingManager{
+      tracing::Format::kYandexTaxi, tracing::Format::kYandexTaxi};
+
+  clients::http::impl::ClientSettings static_config;
+  static_config.io_threads = 2;
+  static_config.tracing_manager = &kTracingManager;
+  return std::make_shared<clients::http::Client>(
+      std::move(static_config), engine::current_task::GetTaskProcessor(),
+      std::vector<utils::NotNull<clients::http::Plugin*>>{});
+}
+
+clients::http::Request MakeRequest(clients::http::Client& client) {
+  return client.CreateRequest().get(kUrl).retry(1).timeout(1000);
+}
+
+}  // namespace
+
+void http_client_fan_out_separate(benchmark::State& state) {
+  engine::RunStandalone(2, [&] {
+    auto client = MakeClient();
+    const auto count = static_cast<std::size_t>(state.range(0));
+    std::vector<clients::http::Request> requests;
+    std::vector<clients::http::ResponseFuture> futures;
+
+    for ([[maybe_unused]] auto _ : state) {
+      requests.clear();
+      futures.clear();
+      for (std::size_t i = 0; i < count; ++i) {
+        requests.push_back(MakeRequest(*client));
+        futures.push_back(requests.back().async_perform());
+      }
+      for (auto& future : futures) future.Wait();
+    }
+  });
+}
+BENCHMARK(http_client_fan_out_separate)->RangeMultiplier(4)->Range(4, 256);
+
+void http_client_fan_out_batch(benchmark::State& state) {
+  engine::RunStandalone(2, [&] {
+    auto client = MakeClient();
+    const auto count = static_cast<std::size_t>(state.range(0));
+
+    for ([[maybe_unused]] auto _ : state) {
+      clients::http::RequestBatch batch;
+      for (std::size_t i = 0; i < count; ++i) batch.Add(MakeRequest(*client));
+      batch.Perform();
+      benchmark::DoNotOptimize(batch.WaitAll());
+    }
+  });
+}
+BENCHMARK(http_client_fan_out_batch)->RangeMultiplier(4)->Range(4, 256);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,92 @@
+#include <userver/clients/http/request_batch.hpp>
+
+#include <algorithm>
+#include <atomic>
+
+#include <userver/clients/http/client.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/http_client.hpp>
+#include <userver/utest/simple_server.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using HttpResponse = utest::SimpleServer::Response;
+using HttpRequest = utest::SimpleServer::Request;
+
+constexpr char kOkResponse[] =
+    "HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: 2\r\n\r\nok";
+
+constexpr std::size_t kRequestsCount = 8;
+
+}  // namespace
+
+UTEST(HttpClientRequestBatch, WaitAll) {
+  auto http_client_ptr = utest::CreateHttpClient();
+  std::atomic<int> requests{0};
+  const utest::SimpleServer http_server{[&requests](const HttpRequest&) {
+    ++requests;
+    return HttpResponse{kOkResponse, HttpResponse::kWriteAndClose};
+  }};
+
+  clients::http::RequestBatch batch;
+  for (std::size_t i = 0; i < kRequestsCount; ++i) {
+    EXPECT_EQ(batch.Add(http_client_ptr->CreateRequest()
+                            .get(http_server.GetBaseUrl())
+                            .timeout(utest::kMaxTestWaitTime)),
+              i);
+  }
+  EXPECT_EQ(batch.GetSize(), kRequestsCount);
+
+  batch.Perform();
+  ASSERT_TRUE(batch.WaitAll());
+  for (std::size_t i = 0; i < kRequestsCount; ++i) {
+    const auto response = batch.Get(i);
+    EXPECT_TRUE(response->IsOk());
+    EXPECT_EQ(response->body_view(), "ok");
+  }
+  EXPECT_EQ(requests.load(), static_cast<int>(kRequestsCount));
+}
+
+UTEST(HttpClientRequestBatch, WaitFirstN) {
+  auto http_client_ptr = utest::CreateHttpClient();
+  const utest::SimpleServer fast_server{[](const HttpRequest&) {
+    return HttpResponse{kOkResponse, HttpResponse::kWriteAndClose};
+  }};
+  const utest::SimpleServer slow_server{[](const HttpRequest&) {
+    engine::InterruptibleSleepFor(utest::kMaxTestWaitTime);
+    return HttpResponse{kOkResponse, HttpResponse::kWriteAndClose};
+  }};
+
+  clients::http::RequestBatch batch;
+  batch.Add(http_client_ptr->CreateRequest()
+                .get(slow_server.GetBaseUrl())
+                .timeout(utest::kMaxTestWaitTime));
+  batch.Add(http_client_ptr->CreateRequest()
+                .get(fast_server.GetBaseUrl())
+                .timeout(utest::kMaxTestWaitTime));
+  batch.Add(http_client_ptr->CreateRequest()
+                .get(fast_server.GetBaseUrl())
+                .timeout(utest::kMaxTestWaitTime));
+
+  batch.Perform();
+  auto finished = batch.WaitFirstN(2);
+  ASSERT_EQ(finished.size(), 2);
+  std::sort(finished.begin(), finished.end());
+  EXPECT_EQ(finished, (std::vector<std::size_t>{1, 2}));
+  EXPECT_EQ(batch.Get(1)->body_view(), "ok");
+
+  EXPECT_FALSE(batch.WaitAll(
+      engine::Deadline::FromDuration(std::chrono::milliseconds{10})));
+}
+
+UTEST(HttpClientRequestBatch, Empty) {
+  clients::http::RequestBatch batch;
+  batch.Perform();
+  EXPECT_TRUE(batch.WaitAll());
+  EXPECT_TRUE(batch.WaitFirstN(1).empty());
+}
+
+USERVER_NAMESPACE_END
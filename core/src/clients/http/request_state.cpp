@@ -1,6 +1,7 @@
 #include <clients/http/request_state.hpp>
 
 #include <algorithm>
+#include <charconv>
 #include <chrono>
 #include <map>
 #include <string_view>
@@ -18,6 +19,8 @@
 #include <userver/baggage/baggage.hpp>
 #include <userver/clients/dns/resolver.hpp>
 #include <userver/clients/http/connect_to.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/server/request/task_inherited_data.hpp>
 #include <userver/utils/algo.hpp>
 #include <userver/utils/assert.hpp>
@@ -25,6 +28,7 @@
 #include <userver/utils/encoding/hex.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/rand.hpp>
+#include <userver/utils/str_icase.hpp>
 #include <utils/impl/assert_extra.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -47,6 +51,11 @@ constexpr int kEBMaxPower = 5;
 constexpr auto kEBBaseTime = std::chrono::milliseconds{25};
 /// Least http code that we treat as bad for exponential backoff algorithm
 constexpr Status kLeastBadHttpCodeForEB{500};
+
+std::chrono::milliseconds GetRetryBackoff(short attempt) {
+  const auto eb_power = std::clamp(attempt - 1, 0, kEBMaxPower);
+  return kEBBaseTime * (utils::RandRange(1 << eb_power) + 1);
+}
 /// Least http code the the downstream service can use to report propagated
 /// deadline expiration
 constexpr Status kLeastHttpCodeForDeadlineExpired{400};
@@ -239,12 +248,16 @@ RequestState::RequestState(
 }
 
 RequestState::~RequestState() {
+  if (concurrency_slot_stats_) concurrency_slot_stats_->ReleaseConcurrencySlot();
+  ReleaseBalancedAddress({});
+
   std::error_code ec;
   easy().set_error_buffer(nullptr, ec);
   UASSERT(!ec);
 }
 
 void RequestState::follow_redirects(bool follow) {
+  if (follow) DisableDirectTransport();
   easy().set_follow_location(follow);
   easy().set_post_redir(static_cast<long>(follow));
   if (follow) easy().set_max_redirs(kMaxRedirectCount);
@@ -323,7 +336,17 @@ void RequestState::client_key_cert(crypto::PrivateKey pkey,
 }
 
 void RequestState::http_version(curl::easy::http_version_t version) {
+  if (version != curl::easy::http_version_t::http_version_none &&
+      version != curl::easy::http_version_t::http_version_1_1) {
+    DisableDirectTransport();
+  }
   easy().set_http_version(version);
+  // Wait for a pending connection to the host instead of opening a new one,
+  // the request may be multiplexed over it
+  easy().set_pipewait(
+      version == curl::easy::http_version_t::http_version_2_0 ||
+      version == curl::easy::http_version_t::http_vertion_2tls ||
+      version == curl::easy::http_version_t::http_version_2_prior_knowledge);
 }
 
 void RequestState::set_timeout(long timeout_ms) {
@@ -338,6 +361,7 @@ void RequestState::retry(short retries, bool on_fails) {
 }
 
 void RequestState::unix_socket_path(const std::string& path) {
+  DisableDirectTransport();
   easy().set_unix_socket_path(path);
 }
 
@@ -345,6 +369,7 @@ void RequestState::connect_to(const ConnectTo& connect_to) {
   curl::native::curl_slist* ptr = connect_to.GetUnderlying();
   if (ptr) {
     easy().set_connect_to(ptr);
+    has_connect_to_ = true;
   }
 }
 
@@ -354,12 +379,14 @@ void RequestState::proxy(const std::string& value) {
 }
 
 void RequestState::proxy_auth_type(curl::easy::proxyauth_t value) {
+  DisableDirectTransport();
   easy().set_proxy_auth(value);
 }
 
 void RequestState::http_auth_type(curl::easy::httpauth_t value, bool auth_only,
                                   std::string_view user,
                                   std::string_view password) {
+  DisableDirectTransport();
   easy().set_http_auth(value, auth_only);
   easy().set_user(std::string{user}.c_str());
   easy().set_password(std::string{password}.c_str());
@@ -368,6 +395,9 @@ void RequestState::http_auth_type(curl::easy::httpauth_t value, bool auth_only,
 void RequestState::Cancel() {
   // We can not call `retry_.timer.reset();` here because of data race
   is_cancelled_ = true;
+  if (direct_.cancellation_token.IsValid()) {
+    direct_.cancellation_token.RequestCancel();
+  }
   easy().cancel();
 }
 
@@ -379,6 +409,32 @@ void RequestState::SetDestinationMetricName(const std::string& destination) {
   dest_req_stats_ = dest_stats_->GetStatisticsForDestination(destination);
 }
 
+std::shared_ptr<RequestStats> RequestState::GetDestinationRequestStats() {
+  if (!dest_req_stats_) {
+    dest_req_stats_ =
+        dest_stats_->GetStatisticsForDestinationAuto(destination_metric_name_);
+  }
+  return dest_req_stats_;
+}
+
+void RequestState::SetAddressBalancer(AddressBalancer* balancer) {
+  address_balancer_ = balancer;
+}
+
+void RequestState::SetDirectTransport(DirectTransport* transport) {
+  direct_transport_ = transport;
+}
+
+void RequestState::SetDirectMethod(std::string method) {
+  direct_.method = std::move(method);
+}
+
+void RequestState::SetDirectUserAgent(std::string user_agent) {
+  direct_.user_agent = std::move(user_agent);
+}
+
+void RequestState::DisableDirectTransport() { direct_.is_disabled = true; }
+
 void RequestState::SetTestsuiteConfig(
     const std::shared_ptr<const TestsuiteConfig>& config) {
   testsuite_config_ = config;
@@ -456,7 +512,7 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
     LOG_DEBUG() << "Stream API, status code is set (with body)";
   }
 
-  const auto status_code = static_cast<Status>(easy.get_response_code());
+  const auto status_code = holder->GetResponseStatusCode();
 
   holder->CheckResponseDeadline(err, status_code);
 
@@ -466,9 +522,19 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
   }
 
   holder->AccountResponse(err);
-  const auto sockets = easy.get_num_connects();
-  holder->WithRequestStats(
-      [sockets](RequestStats& stats) { stats.AccountOpenSockets(sockets); });
+  holder->ReleaseConcurrencySlot(err);
+  holder->ReleaseBalancedAddress(err);
+  const auto is_direct = holder->direct_.is_active;
+  const auto sockets =
+      is_direct ? static_cast<long>(holder->direct_.connects)
+                : easy.get_num_connects();
+  const auto is_http2 = !err && !is_direct &&
+                        easy.get_http_version() ==
+                            curl::native::CURL_HTTP_VERSION_2_0;
+  holder->WithRequestStats([sockets, is_http2](RequestStats& stats) {
+    stats.AccountOpenSockets(sockets);
+    if (is_http2) stats.AccountHttp2Request();
+  });
 
   span.AddTag(tracing::kAttempts, holder->retry_.current);
   if (holder->deadline_propagation_config_.update_header) {
@@ -476,7 +542,7 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
   }
 
   if (err) {
-    if (easy.rate_limit_error()) {
+    if (!is_direct && easy.rate_limit_error()) {
       // The most probable cause, takes precedence
       err = easy.rate_limit_error();
     }
@@ -495,8 +561,12 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
         [&holder, &err](FullBufferedData& buffered_data) {
           { [[maybe_unused]] const auto cleanup = holder->response_move(); }
           auto promise = std::move(buffered_data.promise_);
+          auto exception = buffered_data.sink_exception
+                               ? std::move(buffered_data.sink_exception)
+                               : holder->PrepareException(err);
+          buffered_data.sink.reset();
           // The task will wake up and may reuse RequestState.
-          promise.set_exception(holder->PrepareException(err));
+          promise.set_exception(std::move(exception));
         },
         [](StreamData& stream_data) {
           auto producer = std::move(stream_data.queue_producer);
@@ -507,7 +577,7 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
   } else {
     span.AddTag(tracing::kHttpStatusCode, status_code);
     holder->response()->SetStatusCode(status_code);
-    holder->response()->SetStats(easy.get_local_stats());
+    holder->response()->SetStats(holder->GetLocalStats());
 
     if (!holder->response()->IsOk()) span.AddTag(tracing::kErrorFlag, true);
 
@@ -518,6 +588,7 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
     const utils::Overloaded visitor{
         [&holder](FullBufferedData& buffered_data) {
           auto promise = std::move(buffered_data.promise_);
+          buffered_data.sink.reset();
           // The task will wake up and may reuse RequestState.
           promise.set_value(holder->response_move());
         },
@@ -539,24 +610,12 @@ void RequestState::on_retry(std::shared_ptr<RequestState> holder,
               << tracing::impl::LogSpanAsLastNonCoro{
                      holder->span_storage_->Get()};
 
-  // We do not need to retry:
-  // - if we got result and HTTP code is good
-  // - if we used all attempts
-  // - if failed to reach server, and we should not retry on fails
-  // - if this request was cancelled
-  const bool not_need_retry =
-      (!err && !holder->ShouldRetryResponse()) ||
-      (holder->retry_.current >= holder->retry_.retries) ||
-      (err && !holder->retry_.on_fails) || holder->is_cancelled_.load();
-
-  if (not_need_retry) {
+  if (!holder->ShouldRetry(err)) {
     // finish if no need to retry
     RequestState::on_completed(std::move(holder), err);
   } else {
     // calculate backoff before retry
-    const auto eb_power =
-        std::clamp(holder->retry_.current - 1, 0, kEBMaxPower);
-    const auto backoff = kEBBaseTime * (utils::RandRange(1 << eb_power) + 1);
+    const auto backoff = GetRetryBackoff(holder->retry_.current);
 
     holder->UpdateTimeoutFromDeadline(backoff);
     if (holder->remote_timeout_ <= std::chrono::milliseconds::zero()) {
@@ -566,6 +625,7 @@ void RequestState::on_retry(std::shared_ptr<RequestState> holder,
     }
 
     holder->AccountResponse(err);
+    holder->ReleaseBalancedAddress(err);
 
     // increase try
     ++holder->retry_.current;
@@ -671,7 +731,7 @@ engine::Future<std::shared_ptr<Response>> RequestState::async_perform(
 
   auto future = std::get_if<FullBufferedData>(&data_)->promise_.get_future();
 
-  if (UpdateTimeoutFromDeadlineAndCheck()) {
+  if (UpdateTimeoutFromDeadlineAndCheck() && TryAcquireConcurrencySlot()) {
     perform_request([holder = shared_from_this()](std::error_code err) mutable {
       RequestState::on_retry(std::move(holder), err);
     });
@@ -680,6 +740,43 @@ engine::Future<std::shared_ptr<Response>> RequestState::async_perform(
   return future;
 }
 
+engine::Future<std::shared_ptr<Response>> RequestState::async_perform(
+    curl::perform_batch& batch, utils::impl::SourceLocation location) {
+  perform_batch_ = &batch;
+  auto future = async_perform(location);
+  // Not used if the request failed before the start or resolves the address
+  perform_batch_ = nullptr;
+  return future;
+}
+
+engine::Future<std::shared_ptr<Response>> RequestState::async_perform_sink(
+    std::shared_ptr<ResponseBodySink> sink,
+    utils::impl::SourceLocation location) {
+  auto& buffered_data = data_.emplace<FullBufferedData>();
+  buffered_data.sink = std::move(sink);
+
+  StartNewSpan(location);
+  ResetDataForNewRequest();
+
+  auto& span = span_storage_->Get();
+  span.AddTag("stream_api", 0);
+
+  easy().set_write_function(&RequestState::SinkWriteFunction);
+  easy().set_write_data(this);
+  // Force no retries
+  retry_.retries = 1;
+
+  auto future = buffered_data.promise_.get_future();
+
+  if (UpdateTimeoutFromDeadlineAndCheck() && TryAcquireConcurrencySlot()) {
+    perform_request([holder = shared_from_this()](std::error_code err) mutable {
+      RequestState::on_completed(std::move(holder), err);
+    });
+  }
+
+  return future;
+}
+
 engine::Future<void> RequestState::async_perform_stream(
     const std::shared_ptr<Queue>& queue, utils::impl::SourceLocation location) {
   data_.emplace<StreamData>(queue->GetProducer());
@@ -697,7 +794,7 @@ engine::Future<void> RequestState::async_perform_stream(
 
   auto future = std::get_if<StreamData>(&data_)->headers_promise.get_future();
 
-  if (UpdateTimeoutFromDeadlineAndCheck()) {
+  if (UpdateTimeoutFromDeadlineAndCheck() && TryAcquireConcurrencySlot()) {
     perform_request([holder = shared_from_this()](std::error_code err) mutable {
       RequestState::on_completed(std::move(holder), err);
     });
@@ -718,7 +815,16 @@ void RequestState::perform_request(curl::easy::handler_type handler) {
 
   plugin_pipeline_.HookPerformRequest(*this);
 
-  if (resolver_ && retry_.current == 1) {
+  // Retries go to the other endpoints once the failed one is ejected
+  if (retry_.current > 1 && !balanced_endpoints_.empty()) {
+    PickBalancedAddress();
+  }
+
+  if (retry_.current == 1 && PrepareDirectRequest()) {
+    // The direct transport handles the retries itself
+    perform_batch_ = nullptr;
+    StartDirectRequest();
+  } else if (resolver_ && retry_.current == 1) {
     engine::AsyncNoSpan([this, holder = shared_from_this(),
                          handler = std::move(handler)]() mutable {
       try {
@@ -737,6 +843,9 @@ void RequestState::perform_request(curl::easy::handler_type handler) {
         }
       }
     }).Detach();
+  } else if (perform_batch_) {
+    perform_batch_->add(easy(), std::move(handler));
+    perform_batch_ = nullptr;
   } else {
     easy().async_perform(std::move(handler));
   }
@@ -804,6 +913,7 @@ void RequestState::HandleDeadlineAlreadyPassed() {
 
   WithRequestStats(
       [](RequestStats& stats) { stats.AccountCancelledByDeadline(); });
+  ReleaseConcurrencySlot({});
 
   auto exc = PrepareDeadlinePassedException(GetLoggedOriginalUrl(),
                                             easy().get_local_stats());
@@ -824,9 +934,78 @@ void RequestState::HandleDeadlineAlreadyPassed() {
   std::visit(visitor, data_);
 }
 
+bool RequestState::TryAcquireConcurrencySlot() {
+  // The slot of a previous request that has not completed, e.g. failed to
+  // resolve the host
+  if (concurrency_slot_stats_) {
+    concurrency_slot_stats_->ReleaseConcurrencySlot();
+    concurrency_slot_stats_.reset();
+  }
+
+  const auto& settings = dest_stats_->GetConcurrencyLimiterSettings();
+  if (!settings.enabled || !dest_req_stats_) return true;
+
+  if (!dest_req_stats_->TryAcquireConcurrencySlot(settings)) {
+    HandleConcurrencyLimitReached();
+    return false;
+  }
+  concurrency_slot_stats_ = dest_req_stats_;
+  return true;
+}
+
+void RequestState::ReleaseConcurrencySlot(std::error_code err) {
+  if (!concurrency_slot_stats_) return;
+  const auto stats = std::move(concurrency_slot_stats_);
+
+  const auto error_group = Statistics::ErrorCodeToGroup(err);
+  if (error_group == Statistics::ErrorGroup::kCancelled ||
+      deadline_expired_) {
+    // Says nothing about the destination
+    stats->ReleaseConcurrencySlot();
+    return;
+  }
+
+  const auto is_dropped = error_group == Statistics::ErrorGroup::kTimeout ||
+                          error_group == Statistics::ErrorGroup::kSocketError;
+  stats->ReleaseConcurrencySlot(
+      dest_stats_->GetConcurrencyLimiterSettings(),
+      std::chrono::microseconds{easy().get_total_time_usec()}, is_dropped);
+}
+
+void RequestState::HandleConcurrencyLimitReached() {
+  auto& span = span_storage_->Get();
+  span.AddTag(tracing::kAttempts, 0);
+  span.AddTag(tracing::kErrorFlag, true);
+  span.AddTag("concurrency_limited", 1);
+
+  auto exc = http::PrepareException(
+      curl::errc::RateLimitErrorCode::kConcurrencyLimit,
+      GetLoggedOriginalUrl(), LocalStats{});
+
+  const utils::Overloaded visitor{
+      [&exc](FullBufferedData& buffered_data) {
+        auto promise = std::move(buffered_data.promise_);
+        buffered_data.sink.reset();
+        // The task will wake up and may reuse RequestState.
+        promise.set_exception(std::move(exc));
+      },
+      [&exc](StreamData& stream_data) {
+        if (!stream_data.headers_promise_set.exchange(true)) {
+          auto promise = std::move(stream_data.headers_promise);
+          // The task will wake up and may reuse RequestState.
+          promise.set_exception(std::move(exc));
+        }
+      }};
+  std::visit(visitor, data_);
+}
+
 void RequestState::CheckResponseDeadline(std::error_code& err,
                                          Status status_code) {
-  const std::chrono::microseconds attempt_time{easy().get_total_time_usec()};
+  const auto attempt_time =
+      direct_.is_active
+          ? std::chrono::duration_cast<std::chrono::microseconds>(
+                direct_.attempt_time)
+          : std::chrono::microseconds{easy().get_total_time_usec()};
 
   if (!deadline_expired_ && timeout_updated_by_deadline_ &&
       (attempt_time >= remote_timeout_ ||
@@ -866,7 +1045,7 @@ bool RequestState::IsDeadlineExpiredResponse(Status status_code) {
 }
 
 bool RequestState::ShouldRetryResponse() {
-  const auto status_code = static_cast<Status>(easy().get_response_code());
+  const auto status_code = GetResponseStatusCode();
 
   if (IsDeadlineExpiredResponse(status_code)) {
     // See IsDeadlineExpiredResponse, case (2).
@@ -876,30 +1055,63 @@ bool RequestState::ShouldRetryResponse() {
   return status_code >= kLeastBadHttpCodeForEB;
 }
 
+bool RequestState::ShouldRetry(std::error_code err) {
+  // We do not need to retry:
+  // - if we got result and HTTP code is good
+  // - if we used all attempts
+  // - if failed to reach server, and we should not retry on fails
+  // - if this request was cancelled
+  return !((!err && !ShouldRetryResponse()) ||
+           (retry_.current >= retry_.retries) || (err && !retry_.on_fails) ||
+           is_cancelled_.load());
+}
+
+Status RequestState::GetResponseStatusCode() {
+  if (direct_.is_active) return response_->status_code();
+  return static_cast<Status>(easy().get_response_code());
+}
+
+LocalStats RequestState::GetLocalStats() {
+  if (!direct_.is_active) return easy().get_local_stats();
+
+  LocalStats stats;
+  stats.time_to_connect = direct_.time_to_connect;
+  stats.time_to_process = direct_.attempt_time;
+  stats.open_socket_count = direct_.connects;
+  stats.retries_count = retry_.current - 1;
+  return stats;
+}
+
 void RequestState::AccountResponse(std::error_code err) {
   const auto attempts = retry_.current;
 
+  // The direct transport starts the attempts at once
   const auto time_to_start =
-      std::chrono::duration_cast<std::chrono::microseconds>(
-          easy().time_to_start());
-
-  WithRequestStats([this, err, attempts, time_to_start](RequestStats& stats) {
-    stats.StoreTimeToStart(time_to_start);
-    if (err)
-      stats.FinishEc(err, attempts);
-    else
-      stats.FinishOk(static_cast<int>(easy().get_response_code()), attempts);
-  });
+      direct_.is_active
+          ? std::chrono::microseconds::zero()
+          : std::chrono::duration_cast<std::chrono::microseconds>(
+                easy().time_to_start());
+  const auto status_code = static_cast<int>(GetResponseStatusCode());
+
+  WithRequestStats(
+      [err, attempts, time_to_start, status_code](RequestStats& stats) {
+        stats.StoreTimeToStart(time_to_start);
+        if (err)
+          stats.FinishEc(err, attempts);
+        else
+          stats.FinishOk(status_code, attempts);
+      });
 }
 
 std::exception_ptr RequestState::PrepareException(std::error_code err) {
+  const std::string_view url = direct_.is_active
+                                   ? std::string_view{easy().get_original_url()}
+                                   : easy().get_effective_url();
   if (deadline_expired_) {
-    return PrepareDeadlinePassedException(easy().get_effective_url(),
-                                          easy().get_local_stats());
+    return PrepareDeadlinePassedException(url, GetLocalStats());
   }
 
-  return http::PrepareException(err, easy().get_effective_url(),
-                                easy().get_local_stats());
+  return http::PrepareException(err, url, GetLocalStats());
 }
 
 void RequestState::ThrowDeadlineExpiredException() {
@@ -921,6 +1133,13 @@ void RequestState::ResetDataForNewRequest() {
   deadline_ = server::request::GetTaskInheritedDeadline();
   deadline_expired_ = false;
   timeout_updated_by_deadline_ = false;
+  ReleaseBalancedAddress({});
+  balanced_endpoints_.clear();
+  direct_.is_active = false;
+  direct_.connects = 0;
+  direct_.time_to_connect = {};
+  direct_.attempt_time = {};
+  direct_.cancellation_token = {};
 
   ApplyTestsuiteConfig();
 
@@ -973,6 +1192,25 @@ size_t RequestState::StreamWriteFunction(char* ptr, size_t size, size_t nmemb,
   return CURL_WRITEFUNC_PAUSE;
 }
 
+size_t RequestState::SinkWriteFunction(char* ptr, size_t size, size_t nmemb,
+                                       void* userdata) {
+  const size_t actual_size = size * nmemb;
+  RequestState& rs = *static_cast<RequestState*>(userdata);
+  auto* buffered_data = std::get_if<FullBufferedData>(&rs.data_);
+  UASSERT(buffered_data && buffered_data->sink);
+
+  try {
+    buffered_data->sink->Write(std::string_view{ptr, actual_size});
+    return actual_size;
+  } catch (const std::exception& e) {
+    LOG_DEBUG() << "Response body sink has failed: " << e.what()
+                << tracing::impl::LogSpanAsLastNonCoro{rs.span_storage_->Get()};
+    buffered_data->sink_exception = std::current_exception();
+    // Anything but actual_size aborts the transfer with CURLE_WRITE_ERROR
+    return 0;
+  }
+}
+
 void RequestState::ApplyTestsuiteConfig() {
   if (!testsuite_config_) {
     return;
@@ -1022,10 +1260,7 @@ void RequestState::StartNewSpan(utils::impl::SourceLocation location) {
 }
 
 void RequestState::StartStats() {
-  if (!dest_req_stats_) {
-    dest_req_stats_ =
-        dest_stats_->GetStatisticsForDestinationAuto(destination_metric_name_);
-  }
+  GetDestinationRequestStats();
 
   WithRequestStats([](RequestStats& stats) { stats.Start(); });
 }
@@ -1051,8 +1286,187 @@ void RequestState::ResolveTargetAddress(clients::dns::Resolver& resolver) {
       addrs | boost::adaptors::transformed(
                   [](const auto& addr) { return addr.PrimaryAddressString(); });
 
-  easy().add_resolve(hostname, target.Get().GetPortPtr().get(),
+  std::string port = target.Get().GetPortPtr().get();
+  easy().add_resolve(hostname, port,
                      fmt::to_string(fmt::join(addr_strings, ",")));
+
+  // CURLOPT_CONNECT_TO does not apply to the proxy
+  if (address_balancer_ && addrs.size() > 1 && proxy_url_.empty() &&
+      !has_connect_to_) {
+    balanced_endpoints_ = address_balancer_->GetEndpoints(addrs);
+    balanced_host_ = hostname;
+    balanced_port_ = std::move(port);
+    PickBalancedAddress();
+  }
+}
+
+void RequestState::PickBalancedAddress() {
+  UASSERT(address_balancer_);
+  UASSERT(!balanced_endpoint_);
+  balanced_endpoint_ = address_balancer_->Pick(balanced_endpoints_);
+  // Connections are reused only for the same connect-to address, so each
+  // endpoint gets its own ones
+  easy().set_connect_to_address(balanced_host_, balanced_port_,
+                                balanced_endpoint_->GetAddress());
+}
+
+void RequestState::ReleaseBalancedAddress(std::error_code err) {
+  if (!balanced_endpoint_) return;
+  const auto endpoint = std::move(balanced_endpoint_);
+
+  const auto is_failed = Statistics::ErrorCodeToGroup(err) ==
+                         Statistics::ErrorGroup::kSocketError;
+  address_balancer_->Release(*endpoint, is_failed);
+}
+
+bool RequestState::PrepareDirectRequest() {
+  if (!direct_transport_ || direct_.is_disabled || !proxy_url_.empty() ||
+      has_connect_to_) {
+    return false;
+  }
+  const auto* buffered_data = std::get_if<FullBufferedData>(&data_);
+  if (!buffered_data || buffered_data->sink) return false;
+
+  std::error_code ec;
+  const auto& url = easy().get_easy_url();
+  const auto scheme = url.GetSchemePtr(ec);
+  if (ec || !utils::StrIcaseEqual{}(scheme.get(), "http")) return false;
+  const auto host = url.GetHostPtr(ec);
+  if (ec) return false;
+  const std::string_view port_str{url.GetPortPtr(ec).get()};
+  if (ec) return false;
+
+  std::uint16_t port = 0;
+  const auto [ptr, errc] = std::from_chars(
+      port_str.data(), port_str.data() + port_str.size(), port);
+  if (errc != std::errc{} || ptr != port_str.data() + port_str.size()) {
+    return false;
+  }
+  if (!direct_transport_->IsEnabledFor(host.get(), port)) return false;
+
+  direct_.host = host.get();
+  direct_.port = port;
+  direct_.target = url.GetPathPtr().get();
+  if (const auto query = url.GetQueryPtr(ec); !ec) {
+    direct_.target += '?';
+    direct_.target += query.get();
+  }
+  return true;
+}
+
+void RequestState::StartDirectRequest() {
+  direct_.is_active = true;
+  auto task = engine::CriticalAsyncNoSpan(
+      [holder = shared_from_this()] { holder->PerformDirectRequest(); });
+  direct_.cancellation_token = engine::TaskCancellationToken{task};
+  std::move(task).Detach();
+}
+
+void RequestState::PerformDirectRequest() {
+  auto err = PerformDirectAttempt();
+  while (ShouldRetry(err) && !engine::current_task::ShouldCancel()) {
+    const auto backoff = GetRetryBackoff(retry_.current);
+    UpdateTimeoutFromDeadline(backoff);
+    if (remote_timeout_ <= std::chrono::milliseconds::zero()) {
+      deadline_expired_ = true;
+      break;
+    }
+
+    AccountResponse(err);
+    ++retry_.current;
+    engine::InterruptibleSleepFor(backoff);
+    if (engine::current_task::ShouldCancel()) {
+      err = curl::errc::EasyErrorCode::kAbortedByCallback;
+      break;
+    }
+
+    // Same as perform_request() does for each attempt
+    UpdateTimeoutHeader();
+    plugin_pipeline_.HookPerformRequest(*this);
+    err = PerformDirectAttempt();
+  }
+  on_completed(shared_from_this(), err);
+}
+
+std::error_code RequestState::PerformDirectAttempt() {
+  response_->sink_string().clear();
+  response_->headers().clear();
+  response_->cookies().clear();
+  response_->SetStatusCode(Status::Invalid);
+
+  const auto header_fields = MakeDirectHeaderFields();
+  DirectTransport::Request request;
+  if (!direct_.method.empty()) {
+    request.method = direct_.method;
+  } else {
+    request.method = easy().has_post_data() ? "POST" : "GET";
+  }
+  request.host = direct_.host;
+  request.port = direct_.port;
+  request.target = direct_.target;
+  request.header_fields = header_fields;
+  if (easy().has_post_data()) request.body = easy().get_post_data();
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto result = direct_transport_->Perform(
+      request, resolver_, *response_,
+      engine::Deadline::FromDuration(remote_timeout_));
+  direct_.attempt_time = std::chrono::steady_clock::now() - start;
+  direct_.connects += result.connects;
+  if (result.connects) direct_.time_to_connect = result.time_to_connect;
+  return result.error;
+}
+
+std::string RequestState::MakeDirectHeaderFields() {
+  const utils::StrIcaseEqual equal;
+  bool has_host = false;
+  bool has_accept = false;
+  bool has_user_agent = false;
+  bool has_content_type = false;
+
+  std::string result;
+  // The headers are in the CURLOPT_HTTPHEADER format: "Name: value" is sent,
+  // "Name:" removes the header curl adds itself, "Name;" is sent empty
+  easy().ForEachHeader([&](std::string_view header) {
+    std::string_view name;
+    std::string_view value;
+    const auto colon_pos = header.find(':');
+    if (colon_pos != std::string_view::npos) {
+      name = header.substr(0, colon_pos);
+      value = header.substr(colon_pos + 1);
+      while (!value.empty() && value.front() == ' ') value.remove_prefix(1);
+    } else if (!header.empty() && header.back() == ';') {
+      name = header.substr(0, header.size() - 1);
+    } else {
+      return;
+    }
+
+    using USERVER_NAMESPACE::http::headers::kAccept;
+    using USERVER_NAMESPACE::http::headers::kContentType;
+    using USERVER_NAMESPACE::http::headers::kHost;
+    using USERVER_NAMESPACE::http::headers::kUserAgent;
+    has_host = has_host || equal(name, kHost);
+    has_accept = has_accept || equal(name, kAccept);
+    has_user_agent = has_user_agent || equal(name, kUserAgent);
+    has_content_type = has_content_type || equal(name, kContentType);
+
+    if (colon_pos != std::string_view::npos && value.empty()) return;
+    result.append(name).append(": ").append(value).append("\r\n");
+  });
+
+  if (!has_host) {
+    result.append("Host: ").append(direct_.host);
+    if (direct_.port != 80) result.append(":").append(std::to_string(direct_.port));
+    result.append("\r\n");
+  }
+  if (!has_user_agent && !direct_.user_agent.empty()) {
+    result.append("User-Agent: ").append(direct_.user_agent).append("\r\n");
+  }
+  if (!has_accept) result.append("Accept: */*\r\n");
+  if (!has_content_type && easy().has_post_data()) {
+    result.append("Content-Type: application/x-www-form-urlencoded\r\n");
+  }
+  return result;
 }
 
 void RequestState::SetTracingManager(const tracing::TracingManagerBase& m) {
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <cstdlib>
+#include <exception>
 #include <memory>
 #include <optional>
 #include <string>
@@ -12,12 +13,14 @@
 #include <userver/clients/http/form.hpp>
 #include <userver/clients/http/plugin.hpp>
 #include <userver/clients/http/request_tracing_editor.hpp>
+#include <userver/clients/http/response_body_sink.hpp>
 #include <userver/clients/http/response_future.hpp>
 #include <userver/concurrent/queue.hpp>
 #include <userver/crypto/certificate.hpp>
 #include <userver/crypto/private_key.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/future.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/http/url.hpp>
 #include <userver/tracing/in_place_span.hpp>
@@ -26,7 +29,9 @@
 #include <userver/tracing/tags.hpp>
 #include <userver/utils/not_null.hpp>
 
+#include <clients/http/address_balancer.hpp>
 #include <clients/http/destination_statistics.hpp>
+#include <clients/http/direct_transport.hpp>
 #include <clients/http/easy_wrapper.hpp>
 #include <clients/http/testsuite.hpp>
 #include <crypto/helpers.hpp>
@@ -58,6 +63,16 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
       utils::impl::SourceLocation location =
           utils::impl::SourceLocation::Current());
 
+  /// Perform async http request, the first attempt is started by the `batch`
+  engine::Future<std::shared_ptr<Response>> async_perform(
+      curl::perform_batch& batch, utils::impl::SourceLocation location);
+
+  /// Perform async http request passing the response body to `sink`
+  engine::Future<std::shared_ptr<Response>> async_perform_sink(
+      std::shared_ptr<ResponseBodySink> sink,
+      utils::impl::SourceLocation location =
+          utils::impl::SourceLocation::Current());
+
   /// Perform streaming http request, returns headers future
   engine::Future<void> async_perform_stream(
       const std::shared_ptr<Queue>& queue,
@@ -112,6 +127,9 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
 
   void SetDestinationMetricName(const std::string& destination);
 
+  /// Returns nullptr if the destination is not accounted
+  std::shared_ptr<RequestStats> GetDestinationRequestStats();
+
   void SetTestsuiteConfig(const std::shared_ptr<const TestsuiteConfig>& config);
 
   void SetAllowedUrlsExtra(const std::vector<std::string>& urls);
@@ -121,6 +139,16 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   void SetDeadlinePropagationConfig(
       const impl::DeadlinePropagationConfig& deadline_propagation_config);
 
+  void SetAddressBalancer(AddressBalancer* balancer);
+
+  void SetDirectTransport(DirectTransport* transport);
+  /// method and user agent to send by the direct transport, set along with
+  /// the corresponding curl options
+  void SetDirectMethod(std::string method);
+  void SetDirectUserAgent(std::string user_agent);
+  /// an option not supported by the direct transport was set
+  void DisableDirectTransport();
+
   curl::easy& easy() { return easy_->Easy(); }
   const curl::easy& easy() const { return easy_->Easy(); }
   std::shared_ptr<Response> response() const { return response_; }
@@ -159,14 +187,23 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
       std::chrono::milliseconds backoff = {});
   void UpdateTimeoutHeader();
   void HandleDeadlineAlreadyPassed();
+  [[nodiscard]] bool TryAcquireConcurrencySlot();
+  void ReleaseConcurrencySlot(std::error_code err);
+  void HandleConcurrencyLimitReached();
   void CheckResponseDeadline(std::error_code& err, Status status_code);
   bool IsDeadlineExpiredResponse(Status status_code);
   bool ShouldRetryResponse();
+  bool ShouldRetry(std::error_code err);
+
+  Status GetResponseStatusCode();
+  LocalStats GetLocalStats();
 
   const std::string& GetLoggedOriginalUrl() const noexcept;
 
   static size_t StreamWriteFunction(char* ptr, size_t size, size_t nmemb,
                                     void* userdata);
+  static size_t SinkWriteFunction(char* ptr, size_t size, size_t nmemb,
+                                  void* userdata);
 
   void AccountResponse(std::error_code err);
   std::exception_ptr PrepareException(std::error_code err);
@@ -180,6 +217,15 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   void WithRequestStats(const Func& func);
 
   void ResolveTargetAddress(clients::dns::Resolver& resolver);
+  void PickBalancedAddress();
+  void ReleaseBalancedAddress(std::error_code err);
+
+  /// checks the request and prepares the destination for the direct transport
+  [[nodiscard]] bool PrepareDirectRequest();
+  void StartDirectRequest();
+  void PerformDirectRequest();
+  std::error_code PerformDirectAttempt();
+  std::string MakeDirectHeaderFields();
 
   /// curl handler wrapper
   std::shared_ptr<impl::EasyWrapper> easy_;
@@ -188,6 +234,8 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
 
   std::shared_ptr<DestinationStatistics> dest_stats_;
   std::string destination_metric_name_;
+  /// destination stats holding the concurrency limiter slot of the request
+  std::shared_ptr<RequestStats> concurrency_slot_stats_;
 
   std::shared_ptr<const TestsuiteConfig> testsuite_config_;
   std::vector<std::string> allowed_urls_extra_;
@@ -232,6 +280,37 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
 
   clients::dns::Resolver* resolver_{nullptr};
   std::string proxy_url_;
+  bool has_connect_to_{false};
+
+  /// starts the first attempt instead of curl::easy::async_perform, if set
+  curl::perform_batch* perform_batch_{nullptr};
+
+  AddressBalancer* address_balancer_{nullptr};
+  /// endpoints of the resolved addresses if there are several of them
+  std::vector<AddressBalancer::EndpointPtr> balanced_endpoints_;
+  /// endpoint of the current attempt
+  AddressBalancer::EndpointPtr balanced_endpoint_;
+  std::string balanced_host_;
+  std::string balanced_port_;
+
+  DirectTransport* direct_transport_{nullptr};
+  struct {
+    /// empty for GET or POST depending on the body, as curl does
+    std::string method;
+    std::string user_agent;
+    bool is_disabled{false};
+
+    /// the request is performed by the direct transport
+    bool is_active{false};
+    std::string host;
+    std::uint16_t port{0};
+    std::string target;
+    std::size_t connects{0};
+    std::chrono::steady_clock::duration time_to_connect{};
+    std::chrono::steady_clock::duration attempt_time{};
+    engine::TaskCancellationToken cancellation_token;
+  } direct_;
+
   impl::PluginPipeline& plugin_pipeline_;
 
   struct StreamData {
@@ -245,6 +324,9 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
 
   struct FullBufferedData {
     engine::Promise<std::shared_ptr<Response>> promise_;
+    /// receives the body instead of the Response, if set
+    std::shared_ptr<ResponseBodySink> sink;
+    std::exception_ptr sink_exception;
   };
 
   std::variant<FullBufferedData, StreamData> data_;
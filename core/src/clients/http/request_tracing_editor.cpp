@@ -1,6 +1,7 @@
 #include <userver/clients/http/request_tracing_editor.hpp>
 
 #include <curl-ev/easy.hpp>
+#include <utils/internal_tag.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -14,6 +15,13 @@ void RequestTracingEditor::SetHeader(std::string_view name,
                    curl::easy::DuplicateHeaderAction::kReplace);
 }
 
+void RequestTracingEditor::SetSerializedHeader(std::string_view name,
+                                               std::string_view header,
+                                               utils::InternalTag) {
+  easy_.add_serialized_header(name, header,
+                              curl::easy::DuplicateHeaderAction::kReplace);
+}
+
 }  // namespace clients::http
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,42 @@
+#include <clients/http/retry_budget.hpp>
+
+#include <algorithm>
+
+#include <userver/clients/http/hedged_request.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+namespace {
+constexpr std::int32_t kMillis = 1000;
+}
+
+void RetryBudget::AccountRequest(const HedgingSettings& settings) noexcept {
+  const auto token_ratio =
+      static_cast<std::int32_t>(settings.budget_token_ratio * kMillis);
+
+  auto expected = spent_tokens_.load(std::memory_order_relaxed);
+  while (!spent_tokens_.compare_exchange_weak(
+      expected, std::max(0, expected - token_ratio),
+      std::memory_order_relaxed, std::memory_order_relaxed))
+    ;
+}
+
+bool RetryBudget::TryAccountRetry(const HedgingSettings& settings) noexcept {
+  const auto max_tokens =
+      static_cast<std::int32_t>(settings.budget_max_tokens * kMillis);
+
+  auto expected = spent_tokens_.load(std::memory_order_relaxed);
+  do {
+    // More than a half of the tokens must be left
+    if (max_tokens - expected <= max_tokens / 2) return false;
+  } while (!spent_tokens_.compare_exchange_weak(expected, expected + kMillis,
+                                                std::memory_order_relaxed,
+                                                std::memory_order_relaxed));
+  return true;
+}
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace clients::http {
+
+struct HedgingSettings;
+
+/// Token bucket limiting the share of extra attempts, implements the same
+/// logic as redis::RetryBudget, but takes the settings on each call as they
+/// are provided per request
+class RetryBudget final {
+ public:
+  /// Refills the bucket on a new request
+  void AccountRequest(const HedgingSettings& settings) noexcept;
+
+  /// Takes a token for an extra attempt if the budget allows it
+  bool TryAccountRetry(const HedgingSettings& settings) noexcept;
+
+ private:
+  // Tokens are stored in thousandths, the bucket is full when nothing is spent
+  std::atomic<std::int32_t> spent_tokens_{0};
+};
+
+}  // namespace clients::http
+
+USERVER_NAMESPACE_END
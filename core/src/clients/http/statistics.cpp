@@ -2,6 +2,7 @@
 
 #include <curl-ev/error_code.hpp>
 
+#include <userver/clients/http/hedged_request.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/enumerate.hpp>
 #include <userver/utils/statistics/common.hpp>
@@ -60,8 +61,11 @@ void RequestStats::StoreTimeToStart(
 
 void RequestStats::AccountOpenSockets(size_t sockets) noexcept {
   stats_.socket_open_ += utils::statistics::Rate{sockets};
+  if (sockets == 0) ++stats_.socket_reused_;
 }
 
+void RequestStats::AccountHttp2Request() noexcept { ++stats_.http2_requests_; }
+
 void RequestStats::AccountTimeoutUpdatedByDeadline() noexcept {
   ++stats_.timeout_updated_by_deadline_;
 }
@@ -70,6 +74,69 @@ void RequestStats::AccountCancelledByDeadline() noexcept {
   ++stats_.cancelled_by_deadline_;
 }
 
+std::chrono::milliseconds RequestStats::GetHedgingDelay(
+    const HedgingSettings& settings) {
+  constexpr std::int64_t kUpdatePeriodMs = 1000;
+
+  const auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+  auto delay_ms = stats_.hedging_delay_ms_.load(std::memory_order_relaxed);
+  if (now_ms - stats_.hedging_delay_updated_ms_.load(
+                   std::memory_order_relaxed) >= kUpdatePeriodMs ||
+      stats_.hedging_delay_percentile_.load(std::memory_order_relaxed) !=
+          settings.delay_percentile) {
+    // Races are harmless, any of the concurrently computed values is fine
+    delay_ms = static_cast<std::int64_t>(
+        stats_.timings_percentile_.GetStatsForPeriod().GetPercentile(
+            settings.delay_percentile));
+    stats_.hedging_delay_ms_.store(delay_ms, std::memory_order_relaxed);
+    stats_.hedging_delay_percentile_.store(settings.delay_percentile,
+                                           std::memory_order_relaxed);
+    stats_.hedging_delay_updated_ms_.store(now_ms, std::memory_order_relaxed);
+  }
+  return std::max(std::chrono::milliseconds{delay_ms}, settings.min_delay);
+}
+
+void RequestStats::AccountHedgedRequest(
+    const HedgingSettings& settings) noexcept {
+  ++stats_.hedged_requests_;
+  stats_.hedging_budget_.AccountRequest(settings);
+}
+
+bool RequestStats::TryAccountHedgedAttempt(
+    const HedgingSettings& settings) noexcept {
+  if (!stats_.hedging_budget_.TryAccountRetry(settings)) {
+    ++stats_.hedging_budget_exhausted_;
+    return false;
+  }
+  ++stats_.hedged_attempts_;
+  return true;
+}
+
+void RequestStats::AccountHedgedAttemptWon() noexcept {
+  ++stats_.hedged_attempts_won_;
+}
+
+bool RequestStats::TryAcquireConcurrencySlot(
+    const impl::ConcurrencyLimiterSettings& settings) noexcept {
+  if (!stats_.concurrency_limiter_.TryAcquire(settings)) {
+    ++stats_.concurrency_limited_;
+    return false;
+  }
+  return true;
+}
+
+void RequestStats::ReleaseConcurrencySlot() noexcept {
+  stats_.concurrency_limiter_.Release();
+}
+
+void RequestStats::ReleaseConcurrencySlot(
+    const impl::ConcurrencyLimiterSettings& settings,
+    std::chrono::microseconds rtt, bool is_dropped) noexcept {
+  stats_.concurrency_limiter_.Release(settings, rtt, is_dropped);
+}
+
 Statistics::ErrorGroup Statistics::ErrorCodeToGroup(std::error_code ec) {
   using ErrorCode = curl::errc::EasyErrorCode;
 
@@ -161,6 +228,24 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
 
   writer["sockets"]["open"] = stats.multi.socket_open;
+  // Requests sent over an already established connection
+  writer["sockets"]["reused"] = stats.socket_reused;
+  writer["http2-requests"] = stats.http2_requests;
+
+  if (stats.hedged_requests) {
+    auto hedging = writer["hedging"];
+    hedging["requests"] = stats.hedged_requests;
+    hedging["attempts"] = stats.hedged_attempts;
+    hedging["attempts-won"] = stats.hedged_attempts_won;
+    hedging["budget-exhausted"] = stats.hedging_budget_exhausted;
+  }
+
+  if (stats.concurrency_limit) {
+    auto limiter = writer["concurrency-limiter"];
+    limiter["limit"] = stats.concurrency_limit;
+    limiter["in-flight"] = stats.concurrency_in_flight;
+    limiter["rejected"] = stats.concurrency_limited;
+  }
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -197,9 +282,18 @@ InstanceStatistics::InstanceStatistics(const Statistics& other)
       last_time_to_start_us(other.last_time_to_start_us_.load()),
       timings_percentile(other.timings_percentile_.GetStatsForPeriod()),
       retries(other.retries_.Load()),
+      socket_reused(other.socket_reused_.Load()),
+      http2_requests(other.http2_requests_.Load()),
       timeout_updated_by_deadline(other.timeout_updated_by_deadline_.Load()),
       cancelled_by_deadline(other.cancelled_by_deadline_.Load()),
-      reply_status(other.reply_status_) {
+      reply_status(other.reply_status_),
+      hedged_requests(other.hedged_requests_.Load()),
+      hedged_attempts(other.hedged_attempts_.Load()),
+      hedged_attempts_won(other.hedged_attempts_won_.Load()),
+      hedging_budget_exhausted(other.hedging_budget_exhausted_.Load()),
+      concurrency_limit(other.concurrency_limiter_.GetLimit()),
+      concurrency_in_flight(other.concurrency_limiter_.GetInFlight()),
+      concurrency_limited(other.concurrency_limited_.Load()) {
   for (size_t i = 0; i < error_count.size(); i++)
     error_count[i] = other.error_count_[i].Load();
   multi.socket_open = other.socket_open_.Load();
@@ -230,11 +324,22 @@ InstanceStatistics& InstanceStatistics::operator+=(
     error_count[i] += stat.error_count[i];
   }
   retries += stat.retries;
+  socket_reused += stat.socket_reused;
+  http2_requests += stat.http2_requests;
 
   timeout_updated_by_deadline += stat.timeout_updated_by_deadline;
   cancelled_by_deadline += stat.cancelled_by_deadline;
   reply_status += stat.reply_status;
 
+  hedged_requests += stat.hedged_requests;
+  hedged_attempts += stat.hedged_attempts;
+  hedged_attempts_won += stat.hedged_attempts_won;
+  hedging_budget_exhausted += stat.hedging_budget_exhausted;
+
+  concurrency_limit += stat.concurrency_limit;
+  concurrency_in_flight += stat.concurrency_in_flight;
+  concurrency_limited += stat.concurrency_limited;
+
   multi += stat.multi;
   return *this;
 }
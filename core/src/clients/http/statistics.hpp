@@ -11,6 +11,8 @@
 #include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
 #include <userver/utils/statistics/writer.hpp>
+#include <clients/http/concurrency_limiter.hpp>
+#include <clients/http/retry_budget.hpp>
 #include <utils/statistics/http_codes.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -18,6 +20,7 @@ USERVER_NAMESPACE_BEGIN
 namespace clients::http {
 
 class Statistics;
+struct HedgingSettings;
 
 class RequestStats final {
  public:
@@ -31,10 +34,26 @@ class RequestStats final {
   void StoreTimeToStart(std::chrono::microseconds micro_seconds) noexcept;
 
   void AccountOpenSockets(size_t sockets) noexcept;
+  void AccountHttp2Request() noexcept;
 
   void AccountTimeoutUpdatedByDeadline() noexcept;
   void AccountCancelledByDeadline() noexcept;
 
+  /// Delay before an extra attempt of a hedged request
+  std::chrono::milliseconds GetHedgingDelay(const HedgingSettings& settings);
+  void AccountHedgedRequest(const HedgingSettings& settings) noexcept;
+  /// Returns false if the retry budget is exhausted
+  bool TryAccountHedgedAttempt(const HedgingSettings& settings) noexcept;
+  void AccountHedgedAttemptWon() noexcept;
+
+  /// Returns false if the destination concurrency limit is reached
+  bool TryAcquireConcurrencySlot(
+      const impl::ConcurrencyLimiterSettings& settings) noexcept;
+  void ReleaseConcurrencySlot() noexcept;
+  void ReleaseConcurrencySlot(const impl::ConcurrencyLimiterSettings& settings,
+                              std::chrono::microseconds rtt,
+                              bool is_dropped) noexcept;
+
  private:
   void StoreTiming() noexcept;
 
@@ -101,10 +120,25 @@ class Statistics {
   std::array<utils::statistics::RateCounter, kErrorGroupCount> error_count_;
   utils::statistics::RateCounter retries_;
   utils::statistics::RateCounter socket_open_{0};
+  utils::statistics::RateCounter socket_reused_{0};
+  utils::statistics::RateCounter http2_requests_{0};
   utils::statistics::RateCounter timeout_updated_by_deadline_;
   utils::statistics::RateCounter cancelled_by_deadline_;
   utils::statistics::HttpCodes reply_status_;
 
+  RetryBudget hedging_budget_;
+  // Timings percentile is costly to compute, it is cached for a second
+  std::atomic<std::int64_t> hedging_delay_ms_{0};
+  std::atomic<double> hedging_delay_percentile_{0};
+  std::atomic<std::int64_t> hedging_delay_updated_ms_{0};
+  utils::statistics::RateCounter hedged_requests_;
+  utils::statistics::RateCounter hedged_attempts_;
+  utils::statistics::RateCounter hedged_attempts_won_;
+  utils::statistics::RateCounter hedging_budget_exhausted_;
+
+  ConcurrencyLimiter concurrency_limiter_;
+  utils::statistics::RateCounter concurrency_limited_;
+
   friend struct InstanceStatistics;
   friend class RequestStats;
 };
@@ -127,11 +161,22 @@ struct InstanceStatistics {
   Percentile timings_percentile;
   std::array<utils::statistics::Rate, Statistics::kErrorGroupCount> error_count;
   utils::statistics::Rate retries{0};
+  utils::statistics::Rate socket_reused{0};
+  utils::statistics::Rate http2_requests{0};
 
   utils::statistics::Rate timeout_updated_by_deadline;
   utils::statistics::Rate cancelled_by_deadline;
   utils::statistics::HttpCodes::Snapshot reply_status;
 
+  utils::statistics::Rate hedged_requests;
+  utils::statistics::Rate hedged_attempts;
+  utils::statistics::Rate hedged_attempts_won;
+  utils::statistics::Rate hedging_budget_exhausted;
+
+  std::size_t concurrency_limit{0};
+  std::size_t concurrency_in_flight{0};
+  utils::statistics::Rate concurrency_limited;
+
   MultiStats multi;
 };
 
@@ -16,9 +16,10 @@ ComponentsLoadCancelledException::ComponentsLoadCancelledException(
 ComponentContext::ComponentContext() noexcept = default;
 
 void ComponentContext::Emplace(
-    const Manager& manager,
-    std::vector<std::string>&& loading_component_names) {
-  impl_ = std::make_unique<Impl>(manager, std::move(loading_component_names));
+    const Manager& manager, std::vector<std::string>&& loading_component_names,
+    const std::vector<std::string>& lazy_component_names) {
+  impl_ = std::make_unique<Impl>(manager, std::move(loading_component_names),
+                                 lazy_component_names);
 }
 
 void ComponentContext::Reset() noexcept { impl_.reset(); }
@@ -51,6 +52,11 @@ const Manager& ComponentContext::GetManager() const {
 
 void ComponentContext::CancelComponentsLoad() { impl_->CancelComponentsLoad(); }
 
+impl::StartupProfile ComponentContext::MakeStartupProfile(
+    std::chrono::steady_clock::time_point start) const {
+  return impl_->MakeStartupProfile(start);
+}
+
 bool ComponentContext::IsAnyComponentInFatalState() const {
   return impl_->IsAnyComponentInFatalState();
 }
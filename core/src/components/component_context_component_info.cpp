@@ -3,6 +3,7 @@
 #include <userver/components/component_context.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/tracer.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -79,6 +80,47 @@ bool ComponentInfo::CheckDependsOnIt(ComponentNameFromInfo component) const {
   return depends_on_it_.find(component) != depends_on_it_.end();
 }
 
+void ComponentInfo::SetLazy() {
+  std::lock_guard<engine::Mutex> lock(mutex_);
+  is_lazy_ = true;
+}
+
+bool ComponentInfo::IsLazy() const {
+  std::lock_guard<engine::Mutex> lock(mutex_);
+  return is_lazy_;
+}
+
+bool ComponentInfo::RequestLazy() {
+  {
+    std::lock_guard<engine::Mutex> lock(mutex_);
+    if (!is_lazy_ || is_lazy_requested_) return false;
+    UASSERT(!are_lazy_requests_stopped_);
+    is_lazy_requested_ = true;
+  }
+  cv_.NotifyAll();
+  return true;
+}
+
+void ComponentInfo::StopLazyRequests() {
+  {
+    std::lock_guard<engine::Mutex> lock(mutex_);
+    are_lazy_requests_stopped_ = true;
+  }
+  cv_.NotifyAll();
+}
+
+bool ComponentInfo::WaitForLazyRequest() const {
+  std::unique_lock<engine::Mutex> lock(mutex_);
+  if (!is_lazy_) return true;
+  auto ok = cv_.Wait(lock, [this]() {
+    return stage_switching_cancelled_ || is_lazy_requested_ ||
+           are_lazy_requests_stopped_;
+  });
+  if (!ok || stage_switching_cancelled_)
+    throw ComponentsLoadCancelledException();
+  return is_lazy_requested_;
+}
+
 void ComponentInfo::SetStageSwitchingCancelled(bool cancelled) {
   {
     std::lock_guard<engine::Mutex> lock(mutex_);
@@ -60,6 +60,17 @@ class ComponentInfo final {
     }
   }
 
+  // A lazy component is created only if another component requests it
+  void SetLazy();
+  bool IsLazy() const;
+  // Returns true on the first request of a lazy component
+  bool RequestLazy();
+  // Called when no more components may request the lazy one
+  void StopLazyRequests();
+  // Returns false if the component is not requested and should not be
+  // created, throws ComponentsLoadCancelledException on load cancellation
+  bool WaitForLazyRequest() const;
+
   void SetStageSwitchingCancelled(bool cancelled);
 
   void OnLoadingCancelled();
@@ -91,6 +102,9 @@ class ComponentInfo final {
   std::set<ComponentNameFromInfo> depends_on_it_;
   ComponentLifetimeStage stage_ = ComponentLifetimeStage::kNull;
   bool stage_switching_cancelled_{false};
+  bool is_lazy_{false};
+  bool is_lazy_requested_{false};
+  bool are_lazy_requests_stopped_{false};
   std::atomic<bool> on_loading_cancelled_called_{false};
 };
 
@@ -78,8 +78,9 @@ ComponentContext::Impl::SearchingComponentScope::~SearchingComponentScope() {
   data->searching_components.erase(component_name_);
 }
 
-ComponentContext::Impl::Impl(const Manager& manager,
-                             std::vector<std::string>&& loading_component_names)
+ComponentContext::Impl::Impl(
+    const Manager& manager, std::vector<std::string>&& loading_component_names,
+    const std::vector<std::string>& lazy_component_names)
     : manager_(manager) {
   UASSERT(std::is_sorted(loading_component_names.begin(),
                          loading_component_names.end()));
@@ -103,6 +104,21 @@ ComponentContext::Impl::Impl(const Manager& manager,
     components_.insert(std::move(node));
   }
 
+  std::size_t lazy_components = 0;
+  for (const auto& name : lazy_component_names) {
+    const auto it = components_.find(impl::ComponentNameFromInfo{name});
+    if (it == components_.end()) continue;
+    it->second.SetLazy();
+    ++lazy_components;
+  }
+  pending_constructions_ = components_.size() - lazy_components;
+  if (pending_constructions_ == 0) StopLazyRequests();
+
+  startups_.reserve(components_.size());
+  for (const auto& [name, info] : components_) {
+    startups_[name].name = std::string{name.StringViewName()};
+  }
+
   StartPrintAddingComponentsTask();
 }
 
@@ -110,6 +126,12 @@ impl::ComponentBase* ComponentContext::Impl::AddComponent(
     std::string_view name, const ComponentFactory& factory,
     ComponentContext& context) {
   auto& component_info = components_.at(impl::ComponentNameFromInfo{name});
+  if (!component_info.WaitForLazyRequest()) {
+    LOG_INFO() << "Lazy component " << name
+               << " is not requested by other components, skipping it";
+    component_info.SetComponent(nullptr);
+    return nullptr;
+  }
   TaskToComponentMapScope task_to_component_map_scope(*this,
                                                       component_info.Name());
 
@@ -117,7 +139,19 @@ impl::ComponentBase* ComponentContext::Impl::AddComponent(
     throw std::runtime_error("trying to add component " + std::string{name} +
                              " multiple times");
 
+  auto& startup = startups_.at(component_info.Name());
+  auto& task_context = engine::current_task::GetCurrentTaskContext();
+  task_context.EnableThreadCpuAccounting();
+  const auto times_before = task_context.GetThreadTimes();
+  startup.start = impl::StartupClock::now();
+
   component_info.SetComponent(factory(context));
+
+  startup.finish = impl::StartupClock::now();
+  const auto times_after = task_context.GetThreadTimes();
+  startup.on_thread = times_after.on_thread - times_before.on_thread;
+  startup.thread_cpu = times_after.thread_cpu - times_before.thread_cpu;
+  OnComponentConstructed();
   auto* component = component_info.GetComponent();
   if (component) {
     // Call the following command on logs to get the component dependencies:
@@ -184,7 +218,10 @@ void ComponentContext::Impl::CancelComponentsLoad() {
 
 bool ComponentContext::Impl::IsAnyComponentInFatalState() const {
   for (const auto& [name, comp] : components_) {
-    switch (comp.GetComponent()->GetComponentHealth()) {
+    const auto* component = comp.GetComponent();
+    // Not created lazy components
+    if (!component) continue;
+    switch (component->GetComponentHealth()) {
       case ComponentHealth::kFatal:
         LOG_ERROR() << "Component '" << name << "' is in kFatal state";
         return true;
@@ -201,6 +238,18 @@ bool ComponentContext::Impl::IsAnyComponentInFatalState() const {
   return false;
 }
 
+impl::StartupProfile ComponentContext::Impl::MakeStartupProfile(
+    impl::StartupClock::time_point start) const {
+  std::vector<impl::ComponentStartup> startups;
+  startups.reserve(startups_.size());
+  for (const auto& [name, startup] : startups_) {
+    // Skip the components that are not created, e.g. the disabled ones
+    if (startup.finish == impl::StartupClock::time_point{}) continue;
+    startups.push_back(startup);
+  }
+  return impl::StartupProfile{start, std::move(startups)};
+}
+
 bool ComponentContext::Impl::Contains(std::string_view name) const noexcept {
   return components_.count(impl::ComponentNameFromInfo{name}) != 0;
 }
@@ -328,6 +377,9 @@ impl::ComponentBase* ComponentContext::Impl::DoFindComponent(
     std::string_view name) {
   auto& component_info = components_.at(impl::ComponentNameFromInfo{name});
   AddDependency(component_info.Name());
+  // The requesting component is pending till it is created, so the counter
+  // can not reach 0 before the lazy component is counted
+  if (component_info.RequestLazy()) ++pending_constructions_;
 
   auto* component = component_info.GetComponent();
   if (component) return component;
@@ -343,7 +395,12 @@ impl::ComponentBase* ComponentContext::Impl::DoFindComponent(
   }
   SearchingComponentScope finder(*this, this_component_name);
 
-  return component_info.WaitAndGetComponent();
+  const auto wait_start = impl::StartupClock::now();
+  component = component_info.WaitAndGetComponent();
+  startups_.at(this_component_name)
+      .waits.push_back({std::string{name}, wait_start,
+                        impl::StartupClock::now()});
+  return component;
 }
 
 void ComponentContext::Impl::AddDependency(impl::ComponentNameFromInfo name) {
@@ -360,6 +417,17 @@ void ComponentContext::Impl::AddDependency(impl::ComponentNameFromInfo name) {
   components_.at(name).AddDependsOnIt(current_component_name);
 }
 
+void ComponentContext::Impl::OnComponentConstructed() {
+  UASSERT(pending_constructions_ > 0);
+  if (--pending_constructions_ == 0) StopLazyRequests();
+}
+
+void ComponentContext::Impl::StopLazyRequests() {
+  for (auto& [name, component_info] : components_) {
+    if (component_info.IsLazy()) component_info.StopLazyRequests();
+  }
+}
+
 bool ComponentContext::Impl::FindDependencyPathDfs(
     impl::ComponentNameFromInfo current, impl::ComponentNameFromInfo target,
     std::set<impl::ComponentNameFromInfo>& handled,
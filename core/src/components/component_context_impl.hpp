@@ -18,6 +18,7 @@
 
 #include <components/component_context_component_info.hpp>
 #include <components/impl/component_name_from_info.hpp>
+#include <components/impl/startup_profile.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -25,7 +26,8 @@ namespace components {
 
 struct ComponentContext::Impl {
   Impl(const Manager& manager,
-       std::vector<std::string>&& loading_component_names);
+       std::vector<std::string>&& loading_component_names,
+       const std::vector<std::string>& lazy_component_names);
 
   impl::ComponentBase* AddComponent(std::string_view name,
                                     const ComponentFactory& factory,
@@ -45,6 +47,10 @@ struct ComponentContext::Impl {
 
   bool IsAnyComponentInFatalState() const;
 
+  // Should be called after all the component constructors have finished
+  impl::StartupProfile MakeStartupProfile(
+      impl::StartupClock::time_point start) const;
+
   bool Contains(std::string_view name) const noexcept;
 
   [[noreturn]] void ThrowNonRegisteredComponent(std::string_view name,
@@ -120,6 +126,9 @@ struct ComponentContext::Impl {
 
   void AddDependency(impl::ComponentNameFromInfo name);
 
+  void OnComponentConstructed();
+  void StopLazyRequests();
+
   bool FindDependencyPathDfs(
       impl::ComponentNameFromInfo current, impl::ComponentNameFromInfo target,
       std::set<impl::ComponentNameFromInfo>& handled,
@@ -142,7 +151,14 @@ struct ComponentContext::Impl {
   const Manager& manager_;
 
   ComponentMap components_;
+  // Each value is changed only by the task that creates the component
+  std::unordered_map<impl::ComponentNameFromInfo, impl::ComponentStartup>
+      startups_;
   std::atomic_flag components_load_cancelled_ ATOMIC_FLAG_INIT;
+  // Components that are being created or are going to be created, the lazy
+  // components that are not requested yet are not counted. No more lazy
+  // components may be requested when it reaches 0.
+  std::atomic<std::size_t> pending_constructions_{0};
 
   engine::ConditionVariable print_adding_components_cv_;
   concurrent::Variable<ProtectedData> shared_data_;
@@ -0,0 +1,99 @@
+#include <userver/components/hot_keys_storage.hpp>
+
+#include <chrono>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components {
+
+namespace {
+
+constexpr std::chrono::seconds kDefaultDecayInterval{10};
+
+utils::statistics::HotKeysSettings ParseSettings(
+    const ComponentConfig& config) {
+  utils::statistics::HotKeysSettings settings;
+  settings.capacity = config["capacity"].As<std::size_t>(settings.capacity);
+  settings.sample_rate =
+      config["sample-rate"].As<std::size_t>(settings.sample_rate);
+  return settings;
+}
+
+}  // namespace
+
+HotKeysStorage::HotKeysStorage(const ComponentConfig& config,
+                               const ComponentContext& context)
+    : LoggableComponentBase(config, context),
+      settings_(ParseSettings(config)) {
+  decay_task_.Start(
+      "hot-keys-decay",
+      config["decay-interval"].As<std::chrono::milliseconds>(
+          kDefaultDecayInterval),
+      [this] {
+        for (const auto& [name, hot_keys] : GetSources()) {
+          hot_keys->Decay();
+        }
+      });
+
+  statistics_holder_ =
+      context.FindComponent<StatisticsStorage>().GetStorage().RegisterWriter(
+          "hot-keys", [this](utils::statistics::Writer& writer) {
+            for (const auto& [name, hot_keys] : GetSources()) {
+              writer.ValueWithLabels(*hot_keys, {"source", name});
+            }
+          });
+}
+
+HotKeysStorage::~HotKeysStorage() {
+  statistics_holder_.Unregister();
+  decay_task_.Stop();
+}
+
+std::shared_ptr<utils::statistics::HotKeys> HotKeysStorage::GetHotKeys(
+    std::string_view source) {
+  auto sources = sources_.Lock();
+  const auto it = sources->find(source);
+  if (it != sources->end()) return it->second;
+  return sources
+      ->emplace(std::string{source},
+                std::make_shared<utils::statistics::HotKeys>(settings_))
+      .first->second;
+}
+
+HotKeysStorage::Sources HotKeysStorage::GetSources() const {
+  const auto sources = sources_.Lock();
+  return *sources;
+}
+
+yaml_config::Schema HotKeysStorage::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<LoggableComponentBase>(R"(
+type: object
+description: Keeps the detectors of the most frequently accessed keys
+additionalProperties: false
+properties:
+    capacity:
+        type: integer
+        description: max keys tracked per source on each of the thread shards
+        defaultDescription: 64
+        minimum: 1
+    sample-rate:
+        type: integer
+        description: one of this many accesses is accounted
+        defaultDescription: 16
+        minimum: 1
+    decay-interval:
+        type: string
+        description: period of halving the counts
+        defaultDescription: 10s
+)");
+}
+
+}  // namespace components
+
+USERVER_NAMESPACE_END
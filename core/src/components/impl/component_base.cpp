@@ -21,6 +21,15 @@ properties:
         type: boolean
         description: set to `false` to disable loading of the component
         defaultDescription: true
+    load-mode:
+        type: string
+        description: >
+            `lazy` creates the component only if another component requests
+            it during the components load
+        defaultDescription: eager
+        enum:
+          - eager
+          - lazy
 )");
 }
 
@@ -0,0 +1,189 @@
+#include <components/impl/startup_profile.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+
+#include <fmt/format.h>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components::impl {
+
+namespace {
+
+constexpr std::uint64_t kTracePid = 1;
+
+double ToMilliseconds(StartupClock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+std::int64_t ToMicroseconds(StartupClock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+      .count();
+}
+
+formats::json::ValueBuilder MakeTraceEvent(std::string name,
+                                           const char* category,
+                                           std::uint64_t tid,
+                                           StartupClock::duration start,
+                                           StartupClock::duration duration) {
+  formats::json::ValueBuilder event;
+  event["name"] = std::move(name);
+  event["cat"] = category;
+  event["ph"] = "X";
+  event["pid"] = kTracePid;
+  event["tid"] = tid;
+  event["ts"] = ToMicroseconds(start);
+  event["dur"] = ToMicroseconds(duration);
+  return event;
+}
+
+}  // namespace
+
+StartupClock::duration ComponentStartup::GetDuration() const {
+  return finish - start;
+}
+
+StartupClock::duration ComponentStartup::GetDependencyWaitTime() const {
+  StartupClock::duration result{};
+  for (const auto& wait : waits) result += wait.finish - wait.start;
+  return result;
+}
+
+StartupClock::duration ComponentStartup::GetThreadBlockedTime() const {
+  return std::max(on_thread - thread_cpu, StartupClock::duration::zero());
+}
+
+StartupProfile::StartupProfile(StartupClock::time_point start,
+                               std::vector<ComponentStartup>&& components)
+    : start_(start), components_(std::move(components)) {
+  std::sort(components_.begin(), components_.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return lhs.start < rhs.start;
+            });
+  if (components_.empty()) return;
+
+  std::unordered_map<std::string_view, std::size_t> indices;
+  indices.reserve(components_.size());
+  for (std::size_t i = 0; i < components_.size(); ++i) {
+    indices.emplace(components_[i].name, i);
+  }
+
+  const auto by_finish = [](const auto& lhs, const auto& rhs) {
+    return lhs.finish < rhs.finish;
+  };
+  const auto last =
+      std::max_element(components_.begin(), components_.end(), by_finish);
+  auto current = static_cast<std::size_t>(last - components_.begin());
+  critical_path_.push_back(current);
+
+  // The component could not finish before the dependency it has waited for
+  // last, that dependency could not finish before its own last one, and so on
+  for (;;) {
+    const auto& waits = components_[current].waits;
+    const auto wait = std::max_element(waits.begin(), waits.end(), by_finish);
+    if (wait == waits.end()) break;
+
+    const auto it = indices.find(wait->dependency);
+    if (it == indices.end()) break;
+    current = it->second;
+    critical_path_.push_back(current);
+  }
+  std::reverse(critical_path_.begin(), critical_path_.end());
+}
+
+StartupClock::duration StartupProfile::GetDuration() const {
+  StartupClock::duration result{};
+  for (const auto& component : components_) {
+    result = std::max(result, component.finish - start_);
+  }
+  return result;
+}
+
+std::vector<const ComponentStartup*> StartupProfile::GetCriticalPath() const {
+  std::vector<const ComponentStartup*> result;
+  result.reserve(critical_path_.size());
+  for (const auto index : critical_path_) {
+    result.push_back(&components_[index]);
+  }
+  return result;
+}
+
+std::vector<const ComponentStartup*>
+StartupProfile::GetThreadBlockingComponents() const {
+  std::vector<const ComponentStartup*> result;
+  for (const auto& component : components_) {
+    if (component.GetThreadBlockedTime() >= kThreadBlockedThreshold) {
+      result.push_back(&component);
+    }
+  }
+  std::sort(result.begin(), result.end(), [](const auto* lhs, const auto* rhs) {
+    return lhs->GetThreadBlockedTime() > rhs->GetThreadBlockedTime();
+  });
+  return result;
+}
+
+std::string StartupProfile::ToChromeTrace() const {
+  formats::json::ValueBuilder events{formats::json::Type::kArray};
+
+  for (std::size_t i = 0; i < components_.size(); ++i) {
+    const auto& component = components_[i];
+    // A track per component, in the order of the construction start
+    const auto tid = static_cast<std::uint64_t>(i + 1);
+
+    formats::json::ValueBuilder thread_name;
+    thread_name["name"] = "thread_name";
+    thread_name["ph"] = "M";
+    thread_name["pid"] = kTracePid;
+    thread_name["tid"] = tid;
+    thread_name["args"]["name"] = component.name;
+    events.PushBack(std::move(thread_name));
+
+    auto event = MakeTraceEvent(component.name, "component", tid,
+                                component.start - start_,
+                                component.GetDuration());
+    event["args"]["dependency_wait_ms"] =
+        ToMilliseconds(component.GetDependencyWaitTime());
+    event["args"]["on_thread_ms"] = ToMilliseconds(component.on_thread);
+    event["args"]["thread_cpu_ms"] = ToMilliseconds(component.thread_cpu);
+    event["args"]["thread_blocked_ms"] =
+        ToMilliseconds(component.GetThreadBlockedTime());
+    event["args"]["critical_path"] =
+        std::find(critical_path_.begin(), critical_path_.end(), i) !=
+        critical_path_.end();
+    events.PushBack(std::move(event));
+
+    for (const auto& wait : component.waits) {
+      events.PushBack(MakeTraceEvent("wait " + wait.dependency, "wait", tid,
+                                     wait.start - start_,
+                                     wait.finish - wait.start));
+    }
+  }
+
+  formats::json::ValueBuilder trace;
+  trace["traceEvents"] = std::move(events);
+  trace["displayTimeUnit"] = "ms";
+  return formats::json::ToString(trace.ExtractValue());
+}
+
+std::string StartupProfile::CriticalPathToString() const {
+  std::string result;
+  for (const auto index : critical_path_) {
+    const auto& component = components_[index];
+    if (!result.empty()) result += " -> ";
+    result += fmt::format(
+        "{} ({:.0f}ms)", component.name,
+        ToMilliseconds(component.GetDuration() -
+                       component.GetDependencyWaitTime()));
+  }
+  return result;
+}
+
+}  // namespace components::impl
+
+USERVER_NAMESPACE_END
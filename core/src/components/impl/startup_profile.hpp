@@ -0,0 +1,80 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components::impl {
+
+using StartupClock = std::chrono::steady_clock;
+
+// Time a component constructor has waited for another component to be created
+struct DependencyWait {
+  std::string dependency;
+  StartupClock::time_point start;
+  StartupClock::time_point finish;
+};
+
+struct ComponentStartup {
+  std::string name;
+  StartupClock::time_point start;
+  StartupClock::time_point finish;
+  std::vector<DependencyWait> waits;
+  // Time the constructor has been running on the task processor threads
+  StartupClock::duration on_thread{};
+  // CPU time of the threads while they were running the constructor
+  StartupClock::duration thread_cpu{};
+
+  StartupClock::duration GetDuration() const;
+  StartupClock::duration GetDependencyWaitTime() const;
+  // Time the constructor has held a thread without using its CPU, e.g. in
+  // blocking I/O or sleeps
+  StartupClock::duration GetThreadBlockedTime() const;
+};
+
+// Construction times of the components and the chain of the dependencies that
+// has determined the time of the components load
+class StartupProfile final {
+ public:
+  // The constructors that have blocked a thread for longer are reported
+  static constexpr std::chrono::milliseconds kThreadBlockedThreshold{20};
+
+  StartupProfile() = default;
+  StartupProfile(StartupClock::time_point start,
+                 std::vector<ComponentStartup>&& components);
+
+  bool IsEmpty() const noexcept { return components_.empty(); }
+
+  StartupClock::time_point GetStart() const noexcept { return start_; }
+
+  // From the start of the load till the last constructor has finished
+  StartupClock::duration GetDuration() const;
+
+  // In the order of the construction start
+  const std::vector<ComponentStartup>& GetComponents() const noexcept {
+    return components_;
+  }
+
+  // Each component of the path has waited for the previous one last, the
+  // last component is the one that has finished last
+  std::vector<const ComponentStartup*> GetCriticalPath() const;
+
+  std::vector<const ComponentStartup*> GetThreadBlockingComponents() const;
+
+  // Trace Event Format JSON for chrome://tracing and ui.perfetto.dev
+  std::string ToChromeTrace() const;
+
+  std::string CriticalPathToString() const;
+
+ private:
+  StartupClock::time_point start_;
+  std::vector<ComponentStartup> components_;
+  std::vector<std::size_t> critical_path_;
+};
+
+}  // namespace components::impl
+
+USERVER_NAMESPACE_END
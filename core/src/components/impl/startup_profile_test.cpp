@@ -0,0 +1,124 @@
+#include <components/impl/startup_profile.hpp>
+
+#include <gtest/gtest.h>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using components::impl::ComponentStartup;
+using components::impl::StartupClock;
+using components::impl::StartupProfile;
+using std::chrono::milliseconds;
+
+const auto kStart = StartupClock::time_point{} + std::chrono::hours{1};
+
+ComponentStartup MakeStartup(std::string name, milliseconds start,
+                             milliseconds finish) {
+  ComponentStartup result;
+  result.name = std::move(name);
+  result.start = kStart + start;
+  result.finish = kStart + finish;
+  return result;
+}
+
+void AddWait(ComponentStartup& startup, std::string dependency,
+             milliseconds start, milliseconds finish) {
+  startup.waits.push_back(
+      {std::move(dependency), kStart + start, kStart + finish});
+}
+
+std::vector<std::string> GetNames(
+    const std::vector<const ComponentStartup*>& components) {
+  std::vector<std::string> result;
+  for (const auto* component : components) result.push_back(component->name);
+  return result;
+}
+
+// config <- logging <- server, config <- database <- handler <- server
+StartupProfile MakeProfile() {
+  auto config = MakeStartup("config", milliseconds{0}, milliseconds{10});
+  auto logging = MakeStartup("logging", milliseconds{0}, milliseconds{15});
+  AddWait(logging, "config", milliseconds{0}, milliseconds{10});
+  auto database = MakeStartup("database", milliseconds{1}, milliseconds{80});
+  AddWait(database, "config", milliseconds{1}, milliseconds{10});
+  database.on_thread = milliseconds{60};
+  database.thread_cpu = milliseconds{5};
+  auto handler = MakeStartup("handler", milliseconds{1}, milliseconds{90});
+  AddWait(handler, "database", milliseconds{2}, milliseconds{80});
+  auto server = MakeStartup("server", milliseconds{2}, milliseconds{100});
+  AddWait(server, "logging", milliseconds{2}, milliseconds{15});
+  AddWait(server, "handler", milliseconds{15}, milliseconds{90});
+
+  std::vector<ComponentStartup> components;
+  components.push_back(std::move(server));
+  components.push_back(std::move(handler));
+  components.push_back(std::move(config));
+  components.push_back(std::move(logging));
+  components.push_back(std::move(database));
+  return StartupProfile{kStart, std::move(components)};
+}
+
+}  // namespace
+
+TEST(StartupProfile, CriticalPath) {
+  const auto profile = MakeProfile();
+  EXPECT_EQ(profile.GetDuration(), milliseconds{100});
+  EXPECT_EQ(GetNames(profile.GetCriticalPath()),
+            (std::vector<std::string>{"config", "database", "handler",
+                                      "server"}));
+  EXPECT_EQ(profile.CriticalPathToString(),
+            "config (10ms) -> database (70ms) -> handler (11ms) -> "
+            "server (10ms)");
+}
+
+TEST(StartupProfile, ThreadBlocking) {
+  const auto profile = MakeProfile();
+  const auto blocking = profile.GetThreadBlockingComponents();
+  ASSERT_EQ(GetNames(blocking), std::vector<std::string>{"database"});
+  EXPECT_EQ(blocking[0]->GetThreadBlockedTime(), milliseconds{55});
+  EXPECT_EQ(blocking[0]->GetDependencyWaitTime(), milliseconds{9});
+}
+
+TEST(StartupProfile, ChromeTrace) {
+  const auto profile = MakeProfile();
+  const auto trace = formats::json::FromString(profile.ToChromeTrace());
+  const auto events = trace["traceEvents"];
+
+  std::size_t components = 0;
+  std::size_t waits = 0;
+  for (const auto& event : events) {
+    const auto phase = event["ph"].As<std::string>();
+    if (phase == "M") continue;
+    ASSERT_EQ(phase, "X");
+    if (event["cat"].As<std::string>() == "wait") {
+      ++waits;
+      continue;
+    }
+
+    ++components;
+    if (event["name"].As<std::string>() == "database") {
+      EXPECT_EQ(event["ts"].As<std::int64_t>(), 1000);
+      EXPECT_EQ(event["dur"].As<std::int64_t>(), 79000);
+      EXPECT_TRUE(event["args"]["critical_path"].As<bool>());
+      EXPECT_DOUBLE_EQ(event["args"]["thread_blocked_ms"].As<double>(), 55);
+    } else if (event["name"].As<std::string>() == "logging") {
+      EXPECT_FALSE(event["args"]["critical_path"].As<bool>());
+    }
+  }
+  EXPECT_EQ(components, 5);
+  EXPECT_EQ(waits, 5);
+}
+
+TEST(StartupProfile, Empty) {
+  const StartupProfile profile{kStart, {}};
+  EXPECT_TRUE(profile.IsEmpty());
+  EXPECT_TRUE(profile.GetCriticalPath().empty());
+  EXPECT_EQ(profile.GetDuration(), StartupClock::duration::zero());
+  EXPECT_EQ(profile.CriticalPathToString(), "");
+}
+
+USERVER_NAMESPACE_END
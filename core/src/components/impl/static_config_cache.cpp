@@ -0,0 +1,370 @@
+#include <components/impl/static_config_cache.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#ifdef __linux__
+#include <elf.h>
+#include <link.h>
+#endif
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/crypto/hash.hpp>
+#include <userver/formats/yaml/value_builder.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components::impl {
+
+namespace {
+
+// Bump on any change of the format below
+constexpr std::string_view kMagic = "userver static config cache v1\n";
+constexpr std::size_t kChecksumSize = 32;
+
+enum class NodeType : char { kNull, kScalar, kArray, kObject };
+
+class BinaryWriter final {
+ public:
+  void WriteByte(char value) { data_.push_back(value); }
+
+  void WriteSize(std::size_t size) {
+    const std::uint64_t value = size;
+    data_.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void WriteString(std::string_view str) {
+    WriteSize(str.size());
+    data_.append(str);
+  }
+
+  std::string Extract() && { return std::move(data_); }
+
+ private:
+  std::string data_;
+};
+
+class BinaryReader final {
+ public:
+  explicit BinaryReader(std::string_view data) : data_(data) {}
+
+  char ReadByte() { return Take(1).front(); }
+
+  std::size_t ReadSize() {
+    std::uint64_t value = 0;
+    std::memcpy(&value, Take(sizeof(value)).data(), sizeof(value));
+    return value;
+  }
+
+  std::string_view ReadString() { return Take(ReadSize()); }
+
+  bool IsEnd() const noexcept { return data_.empty(); }
+
+ private:
+  std::string_view Take(std::size_t size) {
+    if (size > data_.size()) {
+      throw std::runtime_error("Unexpected end of data");
+    }
+    const auto result = data_.substr(0, size);
+    data_.remove_prefix(size);
+    return result;
+  }
+
+  std::string_view data_;
+};
+
+// The resolved config has no missing nodes, all the scalars are kept as
+// strings and are converted on access just like the parsed ones
+void WriteNode(BinaryWriter& writer, const formats::yaml::Value& value) {
+  if (value.IsNull()) {
+    writer.WriteByte(static_cast<char>(NodeType::kNull));
+  } else if (value.IsArray()) {
+    writer.WriteByte(static_cast<char>(NodeType::kArray));
+    writer.WriteSize(value.GetSize());
+    for (const auto& item : value) WriteNode(writer, item);
+  } else if (value.IsObject()) {
+    writer.WriteByte(static_cast<char>(NodeType::kObject));
+    writer.WriteSize(value.GetSize());
+    for (auto it = value.begin(); it != value.end(); ++it) {
+      writer.WriteString(it.GetName());
+      WriteNode(writer, *it);
+    }
+  } else {
+    writer.WriteByte(static_cast<char>(NodeType::kScalar));
+    writer.WriteString(value.As<std::string>());
+  }
+}
+
+formats::yaml::ValueBuilder ReadNode(BinaryReader& reader) {
+  switch (static_cast<NodeType>(reader.ReadByte())) {
+    case NodeType::kNull:
+      return formats::yaml::ValueBuilder{formats::common::Type::kNull};
+    case NodeType::kScalar:
+      return formats::yaml::ValueBuilder{std::string{reader.ReadString()}};
+    case NodeType::kArray: {
+      formats::yaml::ValueBuilder builder{formats::common::Type::kArray};
+      const auto size = reader.ReadSize();
+      for (std::size_t i = 0; i < size; ++i) {
+        builder.PushBack(ReadNode(reader));
+      }
+      return builder;
+    }
+    case NodeType::kObject: {
+      formats::yaml::ValueBuilder builder{formats::common::Type::kObject};
+      const auto size = reader.ReadSize();
+      for (std::size_t i = 0; i < size; ++i) {
+        const std::string name{reader.ReadString()};
+        builder[name] = ReadNode(reader);
+      }
+      return builder;
+    }
+  }
+  throw std::runtime_error("Unknown node type");
+}
+
+void CollectEnvNames(const formats::yaml::Value& yaml,
+                     std::vector<std::string>& names) {
+  if (yaml.IsObject()) {
+    for (auto it = yaml.begin(); it != yaml.end(); ++it) {
+      if (boost::algorithm::ends_with(it.GetName(), "#env") &&
+          it->IsString()) {
+        names.push_back(it->As<std::string>());
+      }
+      CollectEnvNames(*it, names);
+    }
+  } else if (yaml.IsArray()) {
+    for (const auto& item : yaml) CollectEnvNames(item, names);
+  }
+}
+
+std::optional<std::string> GetEnv(const std::string& name) {
+  // NOLINTNEXTLINE(concurrency-mt-unsafe)
+  const auto* value = std::getenv(name.c_str());
+  if (!value) return std::nullopt;
+  return std::string{value};
+}
+
+std::optional<std::string> HashFile(const std::string& path) {
+  if (!fs::blocking::FileExists(path)) return std::nullopt;
+  return crypto::hash::Sha256(fs::blocking::ReadFileContents(path));
+}
+
+void AppendKeyPart(std::string& key, std::string_view part) {
+  key += std::to_string(part.size());
+  key += ':';
+  key += part;
+}
+
+#ifdef __linux__
+struct BuildIdsCollector {
+  std::string build_ids;
+  bool is_executable{true};
+  bool has_executable_id{false};
+};
+
+std::size_t AlignNote(std::size_t size) {
+  return (size + 3) & ~std::size_t{3};
+}
+
+int CollectBuildId(dl_phdr_info* info, std::size_t /*size*/, void* data) {
+  auto& collector = *static_cast<BuildIdsCollector*>(data);
+  const bool is_executable = std::exchange(collector.is_executable, false);
+
+  for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i) {
+    const auto& header = info->dlpi_phdr[i];
+    if (header.p_type != PT_NOTE) continue;
+
+    const auto* note =
+        reinterpret_cast<const char*>(info->dlpi_addr + header.p_vaddr);
+    const auto* const end = note + header.p_memsz;
+    while (note + sizeof(ElfW(Nhdr)) <= end) {
+      ElfW(Nhdr) note_header;
+      std::memcpy(&note_header, note, sizeof(note_header));
+      const auto* name = note + sizeof(note_header);
+      const auto* desc = name + AlignNote(note_header.n_namesz);
+      if (desc + note_header.n_descsz > end) break;
+
+      if (note_header.n_type == NT_GNU_BUILD_ID &&
+          note_header.n_namesz == sizeof("GNU") &&
+          std::memcmp(name, "GNU", sizeof("GNU")) == 0) {
+        collector.build_ids.append(desc, note_header.n_descsz);
+        if (is_executable) collector.has_executable_id = true;
+      }
+      note = desc + AlignNote(note_header.n_descsz);
+    }
+  }
+  return 0;
+}
+#endif
+
+}  // namespace
+
+std::string GetLoadedBuildIds() {
+#ifdef __linux__
+  BuildIdsCollector collector;
+  dl_iterate_phdr(&CollectBuildId, &collector);
+  if (!collector.has_executable_id) return {};
+  return std::move(collector.build_ids);
+#else
+  return {};
+#endif
+}
+
+std::unique_ptr<StaticConfigCache> StaticConfigCache::MakeFromEnv(
+    std::string_view config, const std::optional<std::string>& config_vars_path,
+    const std::optional<std::string>& config_vars_override_path) {
+  auto directory = GetEnv(std::string{kDirectoryEnv});
+  if (!directory || directory->empty()) return nullptr;
+
+  // Schemas and the parsing of the configs are in the binary
+  const auto build_ids = GetLoadedBuildIds();
+  if (build_ids.empty()) return nullptr;
+
+  std::string key;
+  AppendKeyPart(key, build_ids);
+  AppendKeyPart(key, config);
+  AppendKeyPart(key, config_vars_path.value_or(""));
+  AppendKeyPart(key, config_vars_override_path.value_or(""));
+  return std::make_unique<StaticConfigCache>(std::move(*directory), key);
+}
+
+StaticConfigCache::StaticConfigCache(std::string directory,
+                                     std::string_view key)
+    : directory_(std::move(directory)),
+      path_(directory_ + "/static_config_" +
+            crypto::hash::Sha256(key).substr(0, 32) + ".bin") {}
+
+std::optional<formats::yaml::Value> StaticConfigCache::Load() {
+  try {
+    if (!fs::blocking::FileExists(path_)) return std::nullopt;
+
+    const auto contents = fs::blocking::ReadFileContents(path_);
+    std::string_view data = contents;
+    if (!boost::algorithm::starts_with(data, kMagic)) {
+      throw std::runtime_error("Unknown format");
+    }
+    data.remove_prefix(kMagic.size());
+    if (data.size() < kChecksumSize) {
+      throw std::runtime_error("Unexpected end of data");
+    }
+    const auto checksum = data.substr(0, kChecksumSize);
+    data.remove_prefix(kChecksumSize);
+    if (crypto::hash::Sha256(data, crypto::hash::OutputEncoding::kBinary) !=
+        checksum) {
+      throw std::runtime_error("Checksum mismatch");
+    }
+
+    BinaryReader reader{data};
+    const auto files_count = reader.ReadSize();
+    for (std::size_t i = 0; i < files_count; ++i) {
+      const std::string path{reader.ReadString()};
+      const auto hash = reader.ReadString();
+      if (HashFile(path) != hash) {
+        LOG_INFO() << "Static config cache is outdated, '" << path
+                   << "' has changed";
+        return std::nullopt;
+      }
+    }
+
+    const auto envs_count = reader.ReadSize();
+    for (std::size_t i = 0; i < envs_count; ++i) {
+      const std::string name{reader.ReadString()};
+      std::optional<std::string> value;
+      if (reader.ReadByte()) value.emplace(reader.ReadString());
+      if (GetEnv(name) != value) {
+        LOG_INFO() << "Static config cache is outdated, environment variable '"
+                   << name << "' has changed";
+        return std::nullopt;
+      }
+    }
+
+    auto config = ReadNode(reader).ExtractValue();
+    if (!reader.IsEnd()) throw std::runtime_error("Unexpected trailing data");
+
+    is_loaded_ = true;
+    return config;
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to load the static config cache '" << path_
+                  << "': " << ex;
+    return std::nullopt;
+  }
+}
+
+void StaticConfigCache::AddFileDependency(std::string path) {
+  auto hash = HashFile(path);
+  if (!hash) {
+    throw std::runtime_error("Cannot read file '" + path + '\'');
+  }
+  files_.push_back({std::move(path), std::move(*hash)});
+}
+
+void StaticConfigCache::AddEnvDependencies(const formats::yaml::Value& yaml) {
+  std::vector<std::string> names;
+  CollectEnvNames(yaml, names);
+  for (auto& name : names) {
+    const bool is_known =
+        std::any_of(envs_.begin(), envs_.end(),
+                    [&name](const auto& env) { return env.name == name; });
+    if (is_known) continue;
+    auto value = GetEnv(name);
+    envs_.push_back({std::move(name), std::move(value)});
+  }
+}
+
+void StaticConfigCache::SetConfig(formats::yaml::Value resolved_config) {
+  config_ = std::move(resolved_config);
+}
+
+void StaticConfigCache::Store() const noexcept {
+  try {
+    fs::blocking::CreateDirectories(directory_);
+    // The config may contain the secrets from the environment variables
+    fs::blocking::RewriteFileContentsAtomically(
+        path_, Serialize(),
+        boost::filesystem::perms::owner_read |
+            boost::filesystem::perms::owner_write);
+    LOG_INFO() << "Stored the validated static config to the cache '"
+               << path_ << '\'';
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to store the static config cache '" << path_
+                  << "': " << ex;
+  }
+}
+
+std::string StaticConfigCache::Serialize() const {
+  BinaryWriter writer;
+  writer.WriteSize(files_.size());
+  for (const auto& file : files_) {
+    writer.WriteString(file.path);
+    writer.WriteString(file.hash);
+  }
+
+  writer.WriteSize(envs_.size());
+  for (const auto& env : envs_) {
+    writer.WriteString(env.name);
+    writer.WriteByte(env.value ? 1 : 0);
+    if (env.value) writer.WriteString(*env.value);
+  }
+
+  WriteNode(writer, config_);
+
+  const auto payload = std::move(writer).Extract();
+  std::string result{kMagic};
+  result += crypto::hash::Sha256(payload,
+                                 crypto::hash::OutputEncoding::kBinary);
+  result += payload;
+  return result;
+}
+
+}  // namespace components::impl
+
+USERVER_NAMESPACE_END
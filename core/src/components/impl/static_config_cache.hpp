@@ -0,0 +1,79 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/formats/yaml/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace components::impl {
+
+// Keeps the validated static config with the substitutions resolved on the
+// disk in a binary form. The restarts of the same binary with the same config
+// load it instead of parsing, resolving and validating the config again.
+class StaticConfigCache final {
+ public:
+  // Directory of the cache, the cache is disabled if the variable is not set
+  static constexpr std::string_view kDirectoryEnv =
+      "USERVER_STATIC_CONFIG_CACHE_DIR";
+
+  // Returns nullptr if the cache is disabled or the build ID of the
+  // executable is unknown
+  static std::unique_ptr<StaticConfigCache> MakeFromEnv(
+      std::string_view config,
+      const std::optional<std::string>& config_vars_path,
+      const std::optional<std::string>& config_vars_override_path);
+
+  // `key` identifies the config and the binary
+  StaticConfigCache(std::string directory, std::string_view key);
+
+  // Returns the cached config if the files and the environment variables it
+  // was made of have not changed. Errors are logged and treated as a miss.
+  std::optional<formats::yaml::Value> Load();
+
+  bool IsLoaded() const noexcept { return is_loaded_; }
+
+  const std::string& GetPath() const noexcept { return path_; }
+
+  // The following remember the config and its sources for Store()
+  void AddFileDependency(std::string path);
+  // Remembers the values of the `#env` variables of the unresolved YAML
+  void AddEnvDependencies(const formats::yaml::Value& yaml);
+  void SetConfig(formats::yaml::Value resolved_config);
+
+  // Writes the config to the cache, should be called after the config
+  // validation. Errors are logged.
+  void Store() const noexcept;
+
+ private:
+  struct FileDependency {
+    std::string path;
+    std::string hash;
+  };
+
+  struct EnvDependency {
+    std::string name;
+    std::optional<std::string> value;
+  };
+
+  std::string Serialize() const;
+
+  std::string directory_;
+  std::string path_;
+  std::vector<FileDependency> files_;
+  std::vector<EnvDependency> envs_;
+  formats::yaml::Value config_;
+  bool is_loaded_{false};
+};
+
+// Build IDs of the executable and of the loaded shared libraries, empty if the
+// executable has no build ID
+std::string GetLoadedBuildIds();
+
+}  // namespace components::impl
+
+USERVER_NAMESPACE_END
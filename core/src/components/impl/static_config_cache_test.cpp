@@ -0,0 +1,137 @@
+#include <components/impl/static_config_cache.hpp>
+
+#include <cstdlib>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include <userver/formats/yaml/serialize.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using components::impl::StaticConfigCache;
+
+constexpr std::string_view kConfig = R"(
+components_manager:
+    task_processors:
+        main-task-processor:
+            worker_threads: 4
+    default_task_processor: main-task-processor
+    components:
+        logging:
+            loggers: {}
+        server:
+            listener:
+                port: 8080
+            enabled: true
+            handlers: []
+            comment: ~
+)";
+
+}  // namespace
+
+TEST(StaticConfigCache, StoreAndLoad) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto vars_path = dir.GetPath() + "/config_vars.yaml";
+  fs::blocking::RewriteFileContents(vars_path, "port: 8080");
+
+  {
+    StaticConfigCache cache{dir.GetPath() + "/cache", "key"};
+    EXPECT_FALSE(cache.Load());
+    EXPECT_FALSE(cache.IsLoaded());
+
+    cache.AddFileDependency(vars_path);
+    cache.SetConfig(formats::yaml::FromString(std::string{kConfig}));
+    cache.Store();
+  }
+
+  StaticConfigCache cache{dir.GetPath() + "/cache", "key"};
+  const auto loaded = cache.Load();
+  ASSERT_TRUE(loaded);
+  EXPECT_TRUE(cache.IsLoaded());
+
+  const auto& manager = (*loaded)["components_manager"];
+  EXPECT_EQ(manager["task_processors"]["main-task-processor"]["worker_threads"]
+                .As<int>(),
+            4);
+  EXPECT_EQ(manager["default_task_processor"].As<std::string>(),
+            "main-task-processor");
+
+  const auto& components = manager["components"];
+  ASSERT_TRUE(components.IsObject());
+  EXPECT_EQ(components.GetSize(), 2UL);
+  EXPECT_TRUE(components["logging"]["loggers"].IsObject());
+  EXPECT_EQ(components["server"]["listener"]["port"].As<int>(), 8080);
+  EXPECT_TRUE(components["server"]["enabled"].As<bool>());
+  EXPECT_TRUE(components["server"]["handlers"].IsArray());
+  EXPECT_TRUE(components["server"]["comment"].IsNull());
+}
+
+TEST(StaticConfigCache, ChangedFile) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto vars_path = dir.GetPath() + "/config_vars.yaml";
+  fs::blocking::RewriteFileContents(vars_path, "port: 8080");
+
+  {
+    StaticConfigCache cache{dir.GetPath(), "key"};
+    cache.AddFileDependency(vars_path);
+    cache.SetConfig(formats::yaml::FromString(std::string{kConfig}));
+    cache.Store();
+  }
+
+  fs::blocking::RewriteFileContents(vars_path, "port: 8081");
+  StaticConfigCache cache{dir.GetPath(), "key"};
+  EXPECT_FALSE(cache.Load());
+  EXPECT_FALSE(cache.IsLoaded());
+}
+
+TEST(StaticConfigCache, ChangedEnv) {
+  constexpr auto kEnv = "USERVER_STATIC_CONFIG_CACHE_TEST_PORT";
+  const auto dir = fs::blocking::TempDirectory::Create();
+  // NOLINTNEXTLINE(concurrency-mt-unsafe)
+  ::setenv(kEnv, "8080", 1);
+
+  {
+    StaticConfigCache cache{dir.GetPath(), "key"};
+    cache.AddEnvDependencies(
+        formats::yaml::FromString(fmt::format("port#env: {}", kEnv)));
+    cache.SetConfig(formats::yaml::FromString(std::string{kConfig}));
+    cache.Store();
+  }
+
+  EXPECT_TRUE(StaticConfigCache(dir.GetPath(), "key").Load());
+
+  // NOLINTNEXTLINE(concurrency-mt-unsafe)
+  ::unsetenv(kEnv);
+  EXPECT_FALSE(StaticConfigCache(dir.GetPath(), "key").Load());
+}
+
+TEST(StaticConfigCache, DifferentKey) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+
+  {
+    StaticConfigCache cache{dir.GetPath(), "key"};
+    cache.SetConfig(formats::yaml::FromString(std::string{kConfig}));
+    cache.Store();
+  }
+
+  StaticConfigCache cache{dir.GetPath(), "other key"};
+  EXPECT_FALSE(cache.Load());
+}
+
+TEST(StaticConfigCache, Corrupted) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+
+  StaticConfigCache cache{dir.GetPath(), "key"};
+  cache.SetConfig(formats::yaml::FromString(std::string{kConfig}));
+  cache.Store();
+
+  fs::blocking::RewriteFileContents(cache.GetPath(), "garbage");
+  EXPECT_FALSE(cache.Load());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,147 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+
+#include <components/component_list_test.hpp>
+#include <userver/alerts/component.hpp>
+#include <userver/components/component.hpp>
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/components/run.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/logging/component.hpp>
+#include <userver/os_signals/component.hpp>
+#include <userver/tracing/component.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::atomic<int> client_constructions{0};
+std::atomic<int> unused_client_constructions{0};
+std::atomic<int> client_dependency_constructions{0};
+
+class LazyClientDependency final : public components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "lazy-client-dependency";
+
+  LazyClientDependency(const components::ComponentConfig& config,
+                       const components::ComponentContext& context)
+      : components::LoggableComponentBase(config, context) {
+    ++client_dependency_constructions;
+  }
+};
+
+class LazyClient final : public components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "lazy-client";
+
+  LazyClient(const components::ComponentConfig& config,
+             const components::ComponentContext& context)
+      : components::LoggableComponentBase(config, context) {
+    context.FindComponent<LazyClientDependency>();
+    ++client_constructions;
+  }
+};
+
+class UnusedLazyClient final : public components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "unused-lazy-client";
+
+  UnusedLazyClient(const components::ComponentConfig& config,
+                   const components::ComponentContext& context)
+      : components::LoggableComponentBase(config, context) {
+    ++unused_client_constructions;
+  }
+};
+
+class Handler final : public components::LoggableComponentBase {
+ public:
+  static constexpr std::string_view kName = "handler";
+
+  Handler(const components::ComponentConfig& config,
+          const components::ComponentContext& context)
+      : components::LoggableComponentBase(config, context) {
+    context.FindComponent<LazyClient>();
+    EXPECT_TRUE(context.FindComponentOptional<LazyClient>());
+  }
+};
+
+constexpr std::string_view kStaticConfig = R"(
+components_manager:
+  event_thread_pool:
+    threads: 1
+  default_task_processor: main-task-processor
+  task_processors:
+    main-task-processor:
+      worker_threads: 1
+  components:
+    logging:
+      fs-task-processor: main-task-processor
+      loggers:
+        default:
+          file_path: '@null'
+    lazy-client-dependency:
+      load-mode: lazy
+    lazy-client:
+      load-mode: lazy
+    unused-lazy-client:
+      load-mode: lazy
+    handler:
+      load-mode: eager
+)";
+
+components::ComponentList MakeComponentList() {
+  return components::ComponentList()
+      .Append<os_signals::ProcessorComponent>()
+      .Append<components::StatisticsStorage>()
+      .Append<components::Logging>()
+      .Append<components::Tracer>()
+      .Append<alerts::StorageComponent>()
+      .Append<LazyClientDependency>()
+      .Append<LazyClient>()
+      .Append<UnusedLazyClient>()
+      .Append<Handler>();
+}
+
+}  // namespace
+
+TEST_F(ComponentList, LazyComponents) {
+  client_constructions = 0;
+  unused_client_constructions = 0;
+  client_dependency_constructions = 0;
+
+  components::RunOnce(components::InMemoryConfig{std::string{kStaticConfig}},
+                      MakeComponentList());
+
+  EXPECT_EQ(client_constructions, 1);
+  EXPECT_EQ(client_dependency_constructions, 1);
+  EXPECT_EQ(unused_client_constructions, 0);
+}
+
+TEST_F(ComponentList, LazyComponentsNotRequested) {
+  client_constructions = 0;
+  unused_client_constructions = 0;
+  client_dependency_constructions = 0;
+
+  auto component_list = components::ComponentList()
+                            .Append<os_signals::ProcessorComponent>()
+                            .Append<components::StatisticsStorage>()
+                            .Append<components::Logging>()
+                            .Append<components::Tracer>()
+                            .Append<alerts::StorageComponent>()
+                            .Append<LazyClientDependency>()
+                            .Append<LazyClient>()
+                            .Append<UnusedLazyClient>();
+  constexpr std::string_view kHandlerConfig =
+      "    handler:\n      load-mode: eager\n";
+  auto config = std::string{kStaticConfig};
+  config.erase(config.find(kHandlerConfig), kHandlerConfig.size());
+
+  components::RunOnce(components::InMemoryConfig{config}, component_list);
+
+  EXPECT_EQ(client_constructions, 0);
+  EXPECT_EQ(client_dependency_constructions, 0);
+  EXPECT_EQ(unused_client_constructions, 0);
+}
+
+USERVER_NAMESPACE_END
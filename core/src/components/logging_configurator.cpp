@@ -2,7 +2,9 @@
 
 #include <logging/dynamic_debug.hpp>
 #include <logging/dynamic_debug_config.hpp>
+#include <logging/log_sampling_config.hpp>
 #include <tracing/no_log_spans.hpp>
+#include <tracing/tail_sampling.hpp>
 #include <userver/components/component.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/value.hpp>
@@ -36,6 +38,29 @@ const dynamic_config::Key<logging::DynamicDebugConfig> kDynamicDebugConfig{
   }
 )"}};
 
+const dynamic_config::Key<logging::impl::LogSamplingSettings>
+    kLogSamplingConfig{"USERVER_LOG_SAMPLING",
+                       dynamic_config::DefaultAsJsonString{R"(
+  {
+    "site-rate-limit": {
+      "records-per-second": 0,
+      "burst": 0
+    },
+    "level-probability": {}
+  }
+)"}};
+
+const dynamic_config::Key<tracing::impl::TailSamplingSettings>
+    kTailSamplingConfig{"USERVER_TRACING_TAIL_SAMPLING",
+                        dynamic_config::DefaultAsJsonString{R"(
+  {
+    "enabled": false,
+    "max-spans-per-trace": 256,
+    "latency-threshold-ms": 0,
+    "probability": 0
+  }
+)"}};
+
 }  // namespace
 
 LoggingConfigurator::LoggingConfigurator(const ComponentConfig& config,
@@ -59,6 +84,8 @@ void LoggingConfigurator::OnConfigUpdate(
     const dynamic_config::Snapshot& config) {
   (void)this;  // silence clang-tidy
   tracing::Tracer::SetNoLogSpans(tracing::NoLogSpans{config[kNoLogSpans]});
+  logging::impl::SetLogSampling(config[kLogSamplingConfig]);
+  tracing::impl::SetTailSampling(config[kTailSamplingConfig]);
 
   try {
     const auto& dd = config[kDynamicDebugConfig];
@@ -9,12 +9,14 @@
 
 #include <fmt/core.h>
 
+#include <components/impl/static_config_cache.hpp>
 #include <components/manager_config.hpp>
 #include <engine/task/exception_hacks.hpp>
 #include <engine/task/task_processor.hpp>
 #include <engine/task/task_processor_pools.hpp>
 #include <userver/components/component_list.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/hostinfo/cpu_limit.hpp>
 #include <userver/logging/component.hpp>
 #include <userver/logging/log.hpp>
@@ -95,6 +97,18 @@ void ValidateConfigs(const components::ComponentList& component_list,
   }
 }
 
+bool IsLazy(const components::ComponentConfig& component_config) {
+  const auto load_mode = component_config["load-mode"].As<std::string>("eager");
+  if (load_mode == "lazy") return true;
+  if (load_mode != "eager") {
+    throw std::runtime_error(
+        fmt::format("Invalid load-mode '{}' of component '{}', expected "
+                    "'eager' or 'lazy'",
+                    load_mode, component_config.Name()));
+  }
+  return false;
+}
+
 }  // namespace
 
 namespace components {
@@ -139,6 +153,12 @@ Manager::Manager(std::unique_ptr<ManagerConfig>&& config,
       start_time_(std::chrono::steady_clock::now()) {
   LOG_INFO() << "Starting components manager";
 
+  if (config_->coarse_clock_update_interval.count() > 0) {
+    coarse_clock_ticker_.emplace(config_->coarse_clock_update_interval);
+  }
+
+  std::vector<engine::TaskProcessor*> all_task_processors;
+  std::vector<engine::TaskProcessor*> autoscaled_task_processors;
   for (auto processor_config : config_->task_processors) {
     if (processor_config.should_guess_cpu_limit) {
       if (config_->default_task_processor == processor_config.name) {
@@ -151,11 +171,25 @@ Manager::Manager(std::unique_ptr<ManagerConfig>&& config,
                     << processor_config.name << "), ignoring it";
       }
     }
-    task_processors_storage_.Add(
-        processor_config.name,
-        std::make_unique<engine::TaskProcessor>(
-            processor_config,
-            task_processors_storage_.GetTaskProcessorPools()));
+    auto task_processor = std::make_unique<engine::TaskProcessor>(
+        processor_config, task_processors_storage_.GetTaskProcessorPools());
+    if (processor_config.should_autoscale_to_cpu_quota) {
+      if (processor_config.task_queue ==
+          engine::TaskQueueType::kGlobalTaskQueue) {
+        autoscaled_task_processors.push_back(task_processor.get());
+      } else {
+        LOG_ERROR() << "autoscale-to-cpu-quota is set for task processor "
+                    << processor_config.name
+                    << " without global-task-queue, ignoring it";
+      }
+    }
+    all_task_processors.push_back(task_processor.get());
+    task_processors_storage_.Add(processor_config.name,
+                                 std::move(task_processor));
+  }
+  task_watchdog_.emplace(std::move(all_task_processors));
+  if (!autoscaled_task_processors.empty()) {
+    cpu_quota_scaler_.emplace(std::move(autoscaled_task_processors));
   }
   const auto& task_processors_map = task_processors_storage_.GetMap();
   const auto default_task_processor_it =
@@ -200,6 +234,8 @@ Manager::~Manager() {
   }
   component_context_.Reset();
   LOG_TRACE() << "Stopped component context";
+  cpu_quota_scaler_.reset();
+  task_watchdog_.reset();
   task_processors_storage_.Reset();
 
   LOG_INFO() << "Stopped components manager";
@@ -232,6 +268,12 @@ std::chrono::milliseconds Manager::GetLoadDuration() const {
   return load_duration_;
 }
 
+std::shared_ptr<const impl::StartupProfile> Manager::GetStartupProfile()
+    const {
+  std::shared_lock<std::shared_timed_mutex> lock(context_mutex_);
+  return startup_profile_;
+}
+
 void Manager::CreateComponentContext(const ComponentList& component_list) {
   std::set<std::string> loading_component_names;
   for (const auto& adder : component_list) {
@@ -245,6 +287,7 @@ void Manager::CreateComponentContext(const ComponentList& component_list) {
     }
   }
 
+  std::vector<std::string> lazy_components;
   for (const auto& component_config : config_->components) {
     const auto& name = component_config.Name();
     const auto it = loading_component_names.find(name);
@@ -259,6 +302,8 @@ void Manager::CreateComponentContext(const ComponentList& component_list) {
     // Delete component from context to make FindComponentOptional() work
     if (!component_config["load-enabled"].As<bool>(true)) {
       loading_component_names.erase(it);
+    } else if (IsLazy(component_config)) {
+      lazy_components.push_back(name);
     }
   }
 
@@ -270,7 +315,8 @@ void Manager::CreateComponentContext(const ComponentList& component_list) {
     loading_components.push_back(std::move(node.value()));
   }
 
-  component_context_.Emplace(*this, std::move(loading_components));
+  component_context_.Emplace(*this, std::move(loading_components),
+                             lazy_components);
 
   AddComponents(component_list);
 }
@@ -306,8 +352,15 @@ void Manager::AddComponents(const ComponentList& component_list) {
   std::vector<engine::TaskWithResult<void>> tasks;
   bool is_load_cancelled = false;
   try {
-    ValidateConfigs(component_list, component_config_map,
-                    config_->validate_components_configs);
+    const auto& cache = config_->static_config_cache;
+    if (cache && cache->IsLoaded()) {
+      LOG_INFO() << "Skipping the static config validation, the config was "
+                    "validated before being cached";
+    } else {
+      ValidateConfigs(component_list, component_config_map,
+                      config_->validate_components_configs);
+      if (cache) cache->Store();
+    }
 
     for (const auto& adder : component_list) {
       auto task_name = "boot/" + adder->GetComponentName();
@@ -362,6 +415,7 @@ void Manager::AddComponents(const ComponentList& component_list) {
   LOG_INFO() << "All components created. Constructors for all the components "
                 "have completed. Preparing to run OnAllComponentsLoaded "
                 "for each component.";
+  ReportStartupProfile(start_time);
 
   try {
     component_context_.OnAllComponentsLoaded();
@@ -377,6 +431,46 @@ void Manager::AddComponents(const ComponentList& component_list) {
   LOG_INFO() << "All components loaded";
 }
 
+void Manager::ReportStartupProfile(
+    std::chrono::steady_clock::time_point start_time) {
+  auto profile = std::make_shared<const impl::StartupProfile>(
+      component_context_.MakeStartupProfile(start_time));
+  if (profile->IsEmpty()) return;
+
+  LOG_INFO() << "Components constructors took "
+             << std::chrono::duration_cast<std::chrono::milliseconds>(
+                    profile->GetDuration())
+                    .count()
+             << "ms, the critical path of the components load with the "
+                "constructors time without the dependencies waiting: "
+             << profile->CriticalPathToString();
+
+  for (const auto* component : profile->GetThreadBlockingComponents()) {
+    LOG_WARNING() << "Constructor of component " << component->name
+                  << " has blocked a task processor thread for "
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(
+                         component->GetThreadBlockedTime())
+                         .count()
+                  << "ms, e.g. in a synchronous I/O or a sleep. Consider "
+                     "doing that asynchronously";
+  }
+
+  if (config_->startup_trace_file) {
+    try {
+      fs::blocking::RewriteFileContents(*config_->startup_trace_file,
+                                        profile->ToChromeTrace());
+      LOG_INFO() << "Startup trace is written to "
+                 << *config_->startup_trace_file;
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Failed to write the startup trace to "
+                  << *config_->startup_trace_file << ": " << ex;
+    }
+  }
+
+  std::unique_lock<std::shared_timed_mutex> lock(context_mutex_);
+  startup_profile_ = std::move(profile);
+}
+
 void Manager::AddComponentImpl(
     const components::ComponentConfigMap& config_map, const std::string& name,
     std::function<std::unique_ptr<components::impl::ComponentBase>(
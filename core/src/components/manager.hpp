@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <shared_mutex>
 #include <string>
 #include <type_traits>
@@ -13,6 +14,11 @@
 #include <userver/components/component_list.hpp>
 #include <userver/components/impl/component_base.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/utils/datetime/coarse_clock_ticker.hpp>
+
+#include <components/impl/startup_profile.hpp>
+#include <engine/task/cpu_quota_scaler.hpp>
+#include <engine/task/task_watchdog.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -52,6 +58,9 @@ class Manager final {
 
   std::chrono::milliseconds GetLoadDuration() const;
 
+  // nullptr until all the component constructors have finished
+  std::shared_ptr<const impl::StartupProfile> GetStartupProfile() const;
+
  private:
   class TaskProcessorsStorage {
    public:
@@ -79,6 +88,7 @@ class Manager final {
 
   void CreateComponentContext(const ComponentList& component_list);
   void AddComponents(const ComponentList& component_list);
+  void ReportStartupProfile(std::chrono::steady_clock::time_point start_time);
 
   friend void impl::AddComponentImpl(
       Manager& manager, const components::ComponentConfigMap& config_map,
@@ -95,8 +105,13 @@ class Manager final {
       const ComponentList& component_list);
 
   std::unique_ptr<const ManagerConfig> config_;
+  // Must outlive the components and the task processors
+  std::optional<utils::datetime::CoarseClockTicker> coarse_clock_ticker_;
   std::vector<ComponentConfig> empty_configs_;
   TaskProcessorsStorage task_processors_storage_;
+  // Must be destroyed before the task processors
+  std::optional<engine::impl::CpuQuotaWorkersScaler> cpu_quota_scaler_;
+  std::optional<engine::impl::TaskWatchdog> task_watchdog_;
 
   mutable std::shared_timed_mutex context_mutex_;
   components::ComponentContext component_context_;
@@ -105,6 +120,8 @@ class Manager final {
   engine::TaskProcessor* default_task_processor_{nullptr};
   const std::chrono::steady_clock::time_point start_time_;
   std::chrono::milliseconds load_duration_{0};
+  // Protected by context_mutex_
+  std::shared_ptr<const impl::StartupProfile> startup_profile_;
 
   os_signals::ProcessorComponent* signal_processor_{nullptr};
 };
@@ -1,6 +1,7 @@
 #include <components/manager_config.hpp>
 
 #include <fstream>
+#include <iterator>
 
 #include <userver/components/static_config_validator.hpp>
 #include <userver/formats/parse/common_containers.hpp>
@@ -11,34 +12,28 @@
 #include <userver/yaml_config/map_to_array.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include <components/impl/static_config_cache.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace components {
 
 namespace {
 
-formats::yaml::Value ParseYaml(const std::string& doc) {
-  return formats::yaml::FromString(doc);
-}
-
-formats::yaml::Value ParseYaml(std::istream& is) {
-  return formats::yaml::FromStream(is);
-}
+constexpr std::string_view kConfigVarsField = "config_vars";
+constexpr std::string_view kManagerConfigField = "components_manager";
+constexpr std::string_view kUserverExperimentsField = "userver_experiments";
+constexpr std::string_view kUserverExperimentsForceEnabledField =
+    "userver_experiments_force_enabled";
 
-template <typename T>
-ManagerConfig ParseFromAny(
-    T&& source, const std::string& source_desc,
+yaml_config::YamlConfig ParseAndResolve(
+    const std::string& doc, const std::string& source_desc,
     const std::optional<std::string>& user_config_vars_path,
-    const std::optional<std::string>& user_config_vars_override_path) {
-  constexpr std::string_view kConfigVarsField = "config_vars";
-  constexpr std::string_view kManagerConfigField = "components_manager";
-  constexpr std::string_view kUserverExperimentsField = "userver_experiments";
-  constexpr std::string_view kUserverExperimentsForceEnabledField =
-      "userver_experiments_force_enabled";
-
+    const std::optional<std::string>& user_config_vars_override_path,
+    impl::StaticConfigCache* cache) {
   formats::yaml::Value config_yaml;
   try {
-    config_yaml = ParseYaml(source);
+    config_yaml = formats::yaml::FromString(doc);
   } catch (const formats::yaml::Exception& e) {
     throw std::runtime_error("Cannot parse config from '" + source_desc +
                              "': " + e.what());
@@ -52,6 +47,7 @@ ManagerConfig ParseFromAny(
   formats::yaml::Value config_vars;
   if (config_vars_path) {
     config_vars = formats::yaml::blocking::FromFile(*config_vars_path);
+    if (cache) cache->AddFileDependency(*config_vars_path);
   }
 
   if (user_config_vars_override_path) {
@@ -63,17 +59,49 @@ ManagerConfig ParseFromAny(
       builder[name] = value;
     }
     config_vars = builder.ExtractValue();
+    if (cache) cache->AddFileDependency(*user_config_vars_override_path);
   }
 
+  if (cache) {
+    cache->AddEnvDependencies(config_yaml);
+    cache->AddEnvDependencies(config_vars);
+  }
+
+  // Components read their configs many times on startup, resolve the
+  // substitutions once instead of on every access
   auto config =
       yaml_config::YamlConfig(config_yaml, std::move(config_vars),
-                              yaml_config::YamlConfig::Mode::kEnvAllowed);
+                              yaml_config::YamlConfig::Mode::kEnvAllowed)
+          .ResolveSubstitutions();
+  if (cache) cache->SetConfig(config.Yaml());
+  return config;
+}
+
+ManagerConfig ParseFromString(
+    const std::string& doc, const std::string& source_desc,
+    const std::optional<std::string>& user_config_vars_path,
+    const std::optional<std::string>& user_config_vars_override_path) {
+  // Restarts with the same binary and configs skip the parsing, resolving
+  // and validation of the config
+  std::shared_ptr<impl::StaticConfigCache> cache =
+      impl::StaticConfigCache::MakeFromEnv(doc, user_config_vars_path,
+                                           user_config_vars_override_path);
+  std::optional<formats::yaml::Value> cached_config;
+  if (cache) cached_config = cache->Load();
+
+  const auto config =
+      cached_config
+          ? yaml_config::YamlConfig::MakeResolved(std::move(*cached_config))
+          : ParseAndResolve(doc, source_desc, user_config_vars_path,
+                            user_config_vars_override_path, cache.get());
+
   auto result = config[kManagerConfigField].As<ManagerConfig>();
   result.enabled_experiments =
       config[kUserverExperimentsField].As<utils::impl::UserverExperimentSet>(
           {});
   result.experiments_force_enabled =
       config[kUserverExperimentsForceEnabledField].As<bool>(false);
+  result.static_config_cache = std::move(cache);
 
   return result;
 }
@@ -103,6 +131,39 @@ properties:
                 type: integer
                 description: size of a single coroutine, bytes
                 defaultDescription: 256 * 1024
+            local_cache_size:
+                type: integer
+                description: >
+                    max amount of idle coroutines to keep in a per-thread
+                    cache of each task processor worker
+                defaultDescription: 16
+            trim_watermark:
+                type: integer
+                description: >
+                    amount of idle coroutines with used stacks to keep, the
+                    rest is destroyed by the periodic trimming
+                defaultDescription: 1000
+            trim_interval:
+                type: string
+                description: >
+                    interval of idle coroutines trimming, 0 disables trimming
+                defaultDescription: 0
+            stack_huge_pages:
+                type: string
+                description: >
+                    allocate the stacks from the huge page slabs, such stacks
+                    have no guard pages
+                defaultDescription: none
+                enum:
+                  - none
+                  - transparent
+                  - explicit
+            stack_usage_sample_period:
+                type: integer
+                description: >
+                    each N-th stack is painted to measure its usage when it is
+                    freed, 0 disables the sampling
+                defaultDescription: 0
     event_thread_pool:
         type: object
         description: event thread pool options
@@ -125,6 +186,21 @@ properties:
                 description: >
                     Whether to defer timer events to a per-thread periodic timer
                     or notify ev-loop right away
+            numa-node:
+                type: integer
+                description: >
+                    NUMA node to pin the ev threads to
+            cpu-set:
+                type: string
+                description: >
+                    list of CPUs to pin the ev threads to, e.g. '0-3,8'
+            io_uring_entries:
+                type: integer
+                description: >
+                    size of the io_uring submission queue used for the fs::
+                    file operations (sockets do not use it), 0 disables
+                    io_uring
+                defaultDescription: 0
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -148,6 +224,23 @@ properties:
                     type: boolean
                     description: .
                     defaultDescription: false
+                jemalloc-arenas:
+                    type: integer
+                    description: |
+                        number of own jemalloc arenas for the worker threads,
+                        so that the allocations of the task processor do not
+                        contend with and fragment the memory of the others.
+                        0 keeps the default shared arenas.
+                    defaultDescription: 0
+                autoscale-to-cpu-quota:
+                    type: boolean
+                    description: |
+                        keep about as many worker threads active as the
+                        cgroup v2 CPU quota allows and park the rest; fewer
+                        threads are used while the cgroup is throttled.
+                        worker_threads is the max count of the active threads.
+                        Only for global-task-queue.
+                    defaultDescription: false
                 os-scheduling:
                     type: string
                     description: |
@@ -166,6 +259,35 @@ properties:
                         tunes the number of spin-wait iterations in case of
                         an empty task queue before threads go to sleep
                     defaultDescription: 10000
+                task-processor-queue:
+                    type: string
+                    description: |
+                        task queue implementation. `global-task-queue` is a
+                        single queue shared by all the workers.
+                        `work-stealing-task-queue` gives each worker a local
+                        queue and lets idle workers steal tasks from others,
+                        which reduces contention on many-core machines.
+                    defaultDescription: global-task-queue
+                    enum:
+                      - global-task-queue
+                      - work-stealing-task-queue
+                numa-node:
+                    type: integer
+                    description: |
+                        NUMA node to pin the worker threads to. Coroutine
+                        stacks are reused only by the threads of the same node.
+                cpu-set:
+                    type: string
+                    description: |
+                        list of CPUs to pin the worker threads to, e.g.
+                        '0-3,8'. Should be a subset of numa-node CPUs if both
+                        options are set.
+                cpu-sampling-every:
+                    type: integer
+                    description: |
+                        attribute CPU time of each Nth started task to the
+                        name of its root tracing span; 0 disables sampling
+                    defaultDescription: 0
                 task-trace:
                     type: object
                     description: .
@@ -194,6 +316,18 @@ properties:
         type: boolean
         description: whether to disable caching of phdr_info objects
         defaultDescription: false
+    coarse_clock_update_interval:
+        type: string
+        description: >
+            interval of caching the time of the coarse clocks in a dedicated
+            thread, 0 disables the caching
+        defaultDescription: 1ms
+    startup_trace_file:
+        type: string
+        description: >
+            path to write the chrome://tracing JSON with the construction
+            times of the components to
+        defaultDescription: the trace is not written
     static_config_validation:
         type: object
         description: settings for basic syntax validation in config.yaml
@@ -234,14 +368,19 @@ ManagerConfig Parse(const yaml_config::YamlConfig& value,
       value["mlock_debug_info"].As<bool>(config.mlock_debug_info);
   config.disable_phdr_cache =
       value["disable_phdr_cache"].As<bool>(config.disable_phdr_cache);
+  config.coarse_clock_update_interval =
+      value["coarse_clock_update_interval"].As<std::chrono::milliseconds>(
+          config.coarse_clock_update_interval);
+  config.startup_trace_file =
+      value["startup_trace_file"].As<std::optional<std::string>>();
   return config;
 }
 
 ManagerConfig ManagerConfig::FromString(
     const std::string& str, const std::optional<std::string>& config_vars_path,
     const std::optional<std::string>& config_vars_override_path) {
-  return ParseFromAny(str, "<std::string>", config_vars_path,
-                      config_vars_override_path);
+  return ParseFromString(str, "<std::string>", config_vars_path,
+                         config_vars_override_path);
 }
 
 ManagerConfig ManagerConfig::FromFile(
@@ -251,8 +390,9 @@ ManagerConfig ManagerConfig::FromFile(
   if (!input_stream) {
     throw std::runtime_error("Cannot open config file '" + path + '\'');
   }
-  return ParseFromAny(input_stream, path, config_vars_path,
-                      config_vars_override_path);
+  const std::string doc{std::istreambuf_iterator<char>{input_stream}, {}};
+  return ParseFromString(doc, path, config_vars_path,
+                         config_vars_override_path);
 }
 
 }  // namespace components
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <chrono>
+#include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -17,6 +20,10 @@ namespace components {
 
 enum class ValidationMode;
 
+namespace impl {
+class StaticConfigCache;
+}  // namespace impl
+
 struct ManagerConfig {
   engine::coro::PoolConfig coro_pool;
   engine::ev::ThreadPoolConfig event_thread_pool;
@@ -28,6 +35,10 @@ struct ManagerConfig {
   bool experiments_force_enabled{false};
   bool mlock_debug_info{true};
   bool disable_phdr_cache{false};
+  std::chrono::milliseconds coarse_clock_update_interval{1};
+  std::optional<std::string> startup_trace_file;
+  // Set if the static config cache is enabled, see StaticConfigCache
+  std::shared_ptr<impl::StaticConfigCache> static_config_cache;
 
   static ManagerConfig FromString(
       const std::string&, const std::optional<std::string>& config_vars_path,
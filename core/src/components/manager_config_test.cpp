@@ -33,6 +33,7 @@ components_manager:
       worker_threads: $bg_worker_threads
       worker_threads#fallback: 2
       os-scheduling: low-priority
+      jemalloc-arenas: 2
     fs-task-processor:
       thread_name: fs-worker
       worker_threads: $fs_worker_threads
@@ -225,6 +226,20 @@ TEST(ManagerConfig, Basic) {
       [](const auto& conf) { return conf.Name() == "logging-configurator"; }));
 }
 
+TEST(ManagerConfig, TaskProcessorJemallocArenas) {
+  const auto mc = MakeManagerConfig();
+
+  const auto find = [&mc](std::string_view name) {
+    const auto it = std::find_if(
+        mc.task_processors.begin(), mc.task_processors.end(),
+        [name](const auto& config) { return config.name == name; });
+    EXPECT_NE(it, mc.task_processors.end()) << name;
+    return it == mc.task_processors.end() ? 0 : it->jemalloc_arenas;
+  };
+  EXPECT_EQ(find("bg-task-processor"), 2U);
+  EXPECT_EQ(find("main-task-processor"), 0U) << "default is not 0";
+}
+
 TEST(ManagerConfig, HandlerConfig) {
   const auto mc = MakeManagerConfig();
 
@@ -243,4 +258,31 @@ TEST(ManagerConfig, HandlerConfig) {
   EXPECT_EQ(conf.task_processor, "main-task-processor");
 }
 
+TEST(ManagerConfig, HandlerThrottlingCost) {
+  const auto parse = [](const std::string& extra) {
+    const yaml_config::YamlConfig yaml{
+        formats::yaml::FromString("path: /ping\n"
+                                  "method: GET\n"
+                                  "task_processor: main-task-processor\n" +
+                                  extra),
+        {}};
+    return server::handlers::ParseHandlerConfigsWithDefaults(
+        yaml, server::ServerConfig{});
+  };
+
+  const auto defaults = parse("");
+  EXPECT_EQ(defaults.throttling_cost, 1);
+  EXPECT_FALSE(defaults.throttling_body_bytes_per_cost);
+
+  const auto conf = parse(
+      "throttling_cost: 5\n"
+      "throttling_body_bytes_per_cost: 4096\n");
+  EXPECT_EQ(conf.throttling_cost, 5);
+  EXPECT_EQ(conf.throttling_body_bytes_per_cost, 4096);
+
+  UEXPECT_THROW(parse("throttling_cost: 0\n"), std::runtime_error);
+  UEXPECT_THROW(parse("throttling_body_bytes_per_cost: 0\n"),
+                std::runtime_error);
+}
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <userver/components/manager_controller_component.hpp>
 
+#include <algorithm>
+
 #include <components/manager_config.hpp>
 #include <components/manager_controller_component_config.hpp>
 #include <engine/task/task_processor.hpp>
@@ -8,6 +10,8 @@
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/value.hpp>
 #include <userver/logging/component.hpp>
+#include <userver/logging/log.hpp>
+#include <utils/jemalloc.hpp>
 
 #include <components/manager.hpp>
 
@@ -30,6 +34,10 @@ void DumpMetric(utils::statistics::Writer& writer,
     tasks["alive"] = created.value - std::min(destroyed, created).value;
     tasks["running"] = started.value - std::min(stopped, started).value;
     tasks["queued"] = task_processor.GetTaskQueueSize();
+    if (task_processor.GetTaskQueueType() ==
+        engine::TaskQueueType::kWorkStealingTaskQueue) {
+      tasks["stolen"] = task_processor.GetTaskQueueStolenCount();
+    }
     tasks["finished"] = stopped.value;
     tasks["cancelled"] = counter.GetCancelledTasks().value;
     tasks["cancelled_overload"] = counter.GetCancelledTasksOverload().value;
@@ -48,7 +56,17 @@ void DumpMetric(utils::statistics::Writer& writer,
     context_switch["no_overloaded"] = counter.GetTasksNoOverloadSensor().value;
   }
 
+  writer["scheduler"] = task_processor.GetSchedulerStatistics();
+
   writer["worker-threads"] = task_processor.GetWorkerCount();
+  writer["active-worker-threads"] = task_processor.GetActiveWorkerCount();
+
+  if (const auto arena_stats = task_processor.GetJemallocArenaStats()) {
+    auto jemalloc = writer["jemalloc"];
+    jemalloc["allocated-bytes"] = arena_stats->allocated_bytes;
+    jemalloc["resident-bytes"] = arena_stats->resident_bytes;
+    jemalloc["mapped-bytes"] = arena_stats->mapped_bytes;
+  }
 }
 
 }  // namespace engine
@@ -89,9 +107,22 @@ ManagerControllerComponent::~ManagerControllerComponent() {
 
 void ManagerControllerComponent::WriteStatistics(
     utils::statistics::Writer& writer) {
+  const auto& task_processors = components_manager_.GetTaskProcessorsMap();
+
+  // 'epoch' merges the statistics of all the jemalloc arenas, so it is
+  // refreshed once for all the task processors
+  if (std::any_of(task_processors.begin(), task_processors.end(),
+                  [](const auto& item) {
+                    return item.second->HasJemallocArenas();
+                  })) {
+    if (const auto ec = utils::jemalloc::RefreshStats()) {
+      LOG_LIMITED_WARNING() << "Failed to refresh jemalloc statistics: "
+                            << ec.message();
+    }
+  }
+
   // task processors
-  for (const auto& [name, task_processor] :
-       components_manager_.GetTaskProcessorsMap()) {
+  for (const auto& [name, task_processor] : task_processors) {
     writer["task-processors"].ValueWithLabels(*task_processor,
                                               {{"task_processor", name}});
   }
@@ -107,11 +138,17 @@ void ManagerControllerComponent::WriteStatistics(
 
   // coroutines
   if (auto coro_pool = writer["coro-pool"]) {
+    const auto& pool =
+        components_manager_.GetTaskProcessorPools()->GetCoroPool();
     if (auto coro_stats = coro_pool["coroutines"]) {
-      auto stats =
-          components_manager_.GetTaskProcessorPools()->GetCoroPool().GetStats();
+      auto stats = pool.GetStats();
       coro_stats["active"] = stats.active_coroutines;
       coro_stats["total"] = stats.total_coroutines;
+      coro_stats["cached"] = stats.cached_coroutines;
+      coro_stats["trimmed"] = stats.trimmed_coroutines;
+    }
+    if (const auto* stack_usage = pool.GetStackUsage()) {
+      coro_pool["stack-usage-kb"] = *stack_usage;
     }
   }
 
@@ -123,6 +160,34 @@ void ManagerControllerComponent::WriteStatistics(
   writer["load-ms"] = std::chrono::duration_cast<std::chrono::milliseconds>(
                           components_manager_.GetLoadDuration())
                           .count();
+
+  // startup
+  if (const auto profile = components_manager_.GetStartupProfile()) {
+    if (auto startup = writer["startup"]) {
+      const auto to_ms = [](auto duration) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(duration)
+            .count();
+      };
+      startup["constructors-ms"] = to_ms(profile->GetDuration());
+
+      const auto critical_path = profile->GetCriticalPath();
+      for (const auto& component : profile->GetComponents()) {
+        const utils::statistics::LabelView label{"component_name",
+                                                 component.name};
+        const bool is_critical =
+            std::find(critical_path.begin(), critical_path.end(),
+                      &component) != critical_path.end();
+        startup["component"]["constructor-ms"].ValueWithLabels(
+            to_ms(component.GetDuration()), label);
+        startup["component"]["dependencies-wait-ms"].ValueWithLabels(
+            to_ms(component.GetDependencyWaitTime()), label);
+        startup["component"]["thread-blocked-ms"].ValueWithLabels(
+            to_ms(component.GetThreadBlockedTime()), label);
+        startup["component"]["critical-path"].ValueWithLabels(
+            is_critical ? 1 : 0, label);
+      }
+    }
+  }
 }
 
 void ManagerControllerComponent::OnConfigUpdate(
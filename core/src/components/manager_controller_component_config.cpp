@@ -51,18 +51,23 @@ ManagerControllerDynamicConfig ManagerControllerDynamicConfig::Parse(
       docs_map.Get("USERVER_TASK_PROCESSOR_PROFILER_DEBUG");
   for (const auto& [name, value] : Items(profiler_doc)) {
     auto profiler_enabled = value["enabled"].As<bool>();
-    if (profiler_enabled) {
-      // If the key is missing, make a copy of default settings and fill the
-      // profiler part.
-      auto it = result.settings.emplace(name, result.default_settings).first;
-      auto& tp_settings = it->second;
+    const std::chrono::microseconds watchdog_threshold{
+        value["watchdog-threshold-us"].As<int>(0)};
+    if (!profiler_enabled && watchdog_threshold.count() == 0) continue;
+
+    // If the key is missing, make a copy of default settings and fill the
+    // profiler part.
+    auto it = result.settings.emplace(name, result.default_settings).first;
+    auto& tp_settings = it->second;
 
+    if (profiler_enabled) {
       tp_settings.profiler_execution_slice_threshold =
           std::chrono::microseconds{
               value["execution-slice-threshold-us"].As<int>()};
       tp_settings.profiler_force_stacktrace =
           value["profiler-force-stacktrace"].As<bool>(false);
     }
+    tp_settings.watchdog_slice_threshold = watchdog_threshold;
   }
 
   return result;
@@ -1,6 +1,7 @@
 #include <userver/components/process_starter.hpp>
 
 #include <userver/components/component.hpp>
+#include <userver/components/statistics_storage.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -10,8 +11,16 @@ namespace components {
 ProcessStarter::ProcessStarter(const ComponentConfig& config,
                                const ComponentContext& context)
     : LoggableComponentBase(config, context),
-      process_starter_(context.GetTaskProcessor(
-          config["task_processor"].As<std::string>())) {}
+      process_starter_(
+          context.GetTaskProcessor(config["task_processor"].As<std::string>()),
+          engine::subprocess::ProcessStarterSettings{
+              config["use-zygote"].As<bool>(false)}) {
+  auto& storage =
+      context.FindComponent<components::StatisticsStorage>().GetStorage();
+  statistics_holder_ = storage.RegisterWriter(
+      "engine.process-starter",
+      [this](utils::statistics::Writer& writer) { writer = process_starter_; });
+}
 
 yaml_config::Schema ProcessStarter::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<LoggableComponentBase>(R"(
@@ -22,6 +31,12 @@ properties:
     task_processor:
         type: string
         description: the name of the TaskProcessor for process starting
+    use-zygote:
+        type: boolean
+        description: |
+            start the processes from a helper process that is forked on the
+            component construction
+        defaultDescription: false
 )");
 }
 
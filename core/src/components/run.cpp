@@ -11,6 +11,7 @@
 #include <boost/exception/diagnostic_information.hpp>
 #include <boost/stacktrace/stacktrace.hpp>
 
+#include <components/impl/static_config_cache.hpp>
 #include <components/manager.hpp>
 #include <components/manager_config.hpp>
 #include <crypto/openssl.hpp>
@@ -158,6 +159,12 @@ ManagerConfig ParseManagerConfigAndSetupLogging(
     // because it would typically go straight to a NullLogger.
     log_scope.SetLogger(std::move(default_logger));
 
+    const auto& cache = manager_config.static_config_cache;
+    if (cache && cache->IsLoaded()) {
+      details += fmt::format(
+          ", the validated config is loaded from the cache '{}'",
+          cache->GetPath());
+    }
     LOG_INFO() << "Parsed " << details;
     return manager_config;
   } catch (const std::exception& ex) {
@@ -0,0 +1,91 @@
+#include <compression/brotli.hpp>
+
+#include <cstdint>
+#include <new>
+
+#include <brotli/encode.h>
+#include <fmt/format.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression::brotli {
+
+namespace {
+
+constexpr std::size_t kMinCompressBufferSize = 16 * 1024;
+
+class BrotliStreamCompressor final : public StreamCompressor {
+ public:
+  explicit BrotliStreamCompressor(int quality)
+      : state_(BrotliEncoderCreateInstance(nullptr, nullptr, nullptr)) {
+    if (!state_) throw std::bad_alloc{};
+
+    if (quality < BROTLI_MIN_QUALITY || quality > BROTLI_MAX_QUALITY) {
+      throw CompressionError(
+          fmt::format("brotli quality {} is out of range [{}, {}]", quality,
+                      BROTLI_MIN_QUALITY, BROTLI_MAX_QUALITY));
+    }
+    BrotliEncoderSetParameter(state_.get(), BROTLI_PARAM_QUALITY,
+                              static_cast<std::uint32_t>(quality));
+  }
+
+  void Compress(std::string_view data, std::string& out) override {
+    CompressStream(data, BROTLI_OPERATION_FLUSH, out);
+  }
+
+  void Finish(std::string_view data, std::string& out) override {
+    CompressStream(data, BROTLI_OPERATION_FINISH, out);
+  }
+
+ private:
+  struct StateDeleter final {
+    void operator()(BrotliEncoderState* state) const noexcept {
+      BrotliEncoderDestroyInstance(state);
+    }
+  };
+
+  void CompressStream(std::string_view data, BrotliEncoderOperation operation,
+                      std::string& out) {
+    std::size_t available_in = data.size();
+    const auto* next_in = reinterpret_cast<const std::uint8_t*>(data.data());
+
+    while (true) {
+      const auto old_size = out.size();
+      const auto buffer_size = kMinCompressBufferSize + available_in;
+      out.resize(old_size + buffer_size);
+      std::size_t available_out = buffer_size;
+      auto* next_out = reinterpret_cast<std::uint8_t*>(out.data() + old_size);
+
+      const auto ok =
+          BrotliEncoderCompressStream(state_.get(), operation, &available_in,
+                                      &next_in, &available_out, &next_out,
+                                      nullptr);
+      out.resize(out.size() - available_out);
+
+      if (!ok) throw CompressionError("failed to compress brotli data");
+      if (available_in == 0 && !BrotliEncoderHasMoreOutput(state_.get()) &&
+          (operation != BROTLI_OPERATION_FINISH ||
+           BrotliEncoderIsFinished(state_.get()))) {
+        return;
+      }
+    }
+  }
+
+  std::unique_ptr<BrotliEncoderState, StateDeleter> state_;
+};
+
+}  // namespace
+
+std::string Compress(std::string_view data, int quality) {
+  std::string compressed;
+  MakeStreamCompressor(quality)->Finish(data, compressed);
+  return compressed;
+}
+
+std::unique_ptr<StreamCompressor> MakeStreamCompressor(int quality) {
+  return std::make_unique<BrotliStreamCompressor>(quality);
+}
+
+}  // namespace compression::brotli
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <compression/error.hpp>
+#include <compression/stream_compressor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression::brotli {
+
+/// Compresses the string, quality is from 0 (fastest) to 11 (best
+/// compression).
+/// @throws CompressionError
+std::string Compress(std::string_view data, int quality);
+
+/// @throws CompressionError
+std::unique_ptr<StreamCompressor> MakeStreamCompressor(int quality);
+
+}  // namespace compression::brotli
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,159 @@
+#include <compression/brotli.hpp>
+#include <compression/gzip.hpp>
+#include <compression/zstd.hpp>
+
+#include <string>
+
+#include <brotli/decode.h>
+#include <gtest/gtest.h>
+#include <zstd.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kMaxSize = 1024 * 1024;
+
+std::string MakeData() {
+  std::string data;
+  for (int i = 0; i < 1000; ++i) {
+    data += R"({"id":)" + std::to_string(i) + R"(,"name":"some name"},)";
+  }
+  return data;
+}
+
+std::string DecompressZstd(std::string_view compressed) {
+  std::string result;
+  auto* context = ZSTD_createDCtx();
+  ZSTD_inBuffer input{compressed.data(), compressed.size(), 0};
+  while (input.pos < input.size) {
+    char buffer[4096];
+    ZSTD_outBuffer output{buffer, sizeof(buffer), 0};
+    const auto ret = ZSTD_decompressStream(context, &output, &input);
+    EXPECT_FALSE(ZSTD_isError(ret)) << ZSTD_getErrorName(ret);
+    if (ZSTD_isError(ret)) break;
+    result.append(buffer, output.pos);
+  }
+  ZSTD_freeDCtx(context);
+  return result;
+}
+
+std::string DecompressBrotli(std::string_view compressed) {
+  std::string result(kMaxSize, '\0');
+  std::size_t size = result.size();
+  const auto ret = BrotliDecoderDecompress(
+      compressed.size(), reinterpret_cast<const std::uint8_t*>(compressed.data()),
+      &size, reinterpret_cast<std::uint8_t*>(result.data()));
+  EXPECT_EQ(ret, BROTLI_DECODER_RESULT_SUCCESS);
+  result.resize(size);
+  return result;
+}
+
+std::string CompressStream(compression::StreamCompressor& compressor,
+                           const std::string& data) {
+  constexpr std::size_t kChunkSize = 1000;
+  std::string compressed;
+  std::size_t pos = 0;
+  for (; pos + kChunkSize < data.size(); pos += kChunkSize) {
+    compressor.Compress(std::string_view{data}.substr(pos, kChunkSize),
+                        compressed);
+  }
+  compressor.Finish(std::string_view{data}.substr(pos), compressed);
+  return compressed;
+}
+
+}  // namespace
+
+TEST(Compression, Gzip) {
+  const auto data = MakeData();
+  const auto compressed = compression::gzip::Compress(data, 6);
+  EXPECT_LT(compressed.size(), data.size() / 4);
+  EXPECT_EQ(compression::gzip::Decompress(compressed, kMaxSize), data);
+
+  const auto compressor = compression::gzip::MakeStreamCompressor(1);
+  EXPECT_EQ(
+      compression::gzip::Decompress(CompressStream(*compressor, data), kMaxSize),
+      data);
+
+  EXPECT_EQ(
+      compression::gzip::Decompress(compression::gzip::Compress("", 6), 1), "");
+  EXPECT_THROW(compression::gzip::MakeStreamCompressor(42),
+               compression::CompressionError);
+}
+
+TEST(Compression, Zstd) {
+  const auto data = MakeData();
+  const auto compressed = compression::zstd::Compress(data, 3);
+  EXPECT_LT(compressed.size(), data.size() / 4);
+  EXPECT_EQ(DecompressZstd(compressed), data);
+
+  const auto compressor = compression::zstd::MakeStreamCompressor(1);
+  EXPECT_EQ(DecompressZstd(CompressStream(*compressor, data)), data);
+
+  EXPECT_EQ(compression::zstd::Decompress(compressed, kMaxSize), data);
+  EXPECT_EQ(compression::zstd::Decompress(CompressStream(*compressor, data),
+                                          kMaxSize),
+            data);
+  EXPECT_EQ(compression::zstd::Decompress(compression::zstd::Compress("", 1), 0),
+            "");
+  EXPECT_THROW(compression::zstd::Decompress(compressed, data.size() - 1),
+               compression::TooBigError);
+  EXPECT_THROW(compression::zstd::Decompress(
+                   std::string_view{compressed}.substr(0, compressed.size() / 2),
+                   kMaxSize),
+               compression::DecompressionError);
+  EXPECT_THROW(compression::zstd::Decompress("not zstd", kMaxSize),
+               compression::DecompressionError);
+
+  EXPECT_THROW(compression::zstd::MakeStreamCompressor(100),
+               compression::CompressionError);
+}
+
+TEST(Compression, ZstdDictionary) {
+  const std::string message =
+      R"({"id":12345,"status":"delivered","courier":{"name":"John"}})";
+  const compression::zstd::Dictionary dictionary{
+      R"({"id":0,"status":"pending","courier":{"name":""}})"
+      R"({"id":1,"status":"delivered","courier":{"name":"Jane"}})"};
+
+  const auto compressed = compression::zstd::Compress(message, dictionary);
+  EXPECT_LT(compressed.size(),
+            compression::zstd::Compress(message, 3).size());
+  EXPECT_EQ(compression::zstd::Decompress(compressed, kMaxSize, &dictionary),
+            message);
+  EXPECT_THROW(compression::zstd::Decompress(compressed, kMaxSize),
+               compression::DecompressionError);
+
+  // The contexts are reused without the dictionary afterwards
+  EXPECT_EQ(compression::zstd::Decompress(
+                compression::zstd::Compress(message, 1), kMaxSize),
+            message);
+
+  EXPECT_THROW(compression::zstd::Dictionary("dictionary", 100),
+               compression::CompressionError);
+}
+
+TEST(Compression, Brotli) {
+  const auto data = MakeData();
+  const auto compressed = compression::brotli::Compress(data, 5);
+  EXPECT_LT(compressed.size(), data.size() / 4);
+  EXPECT_EQ(DecompressBrotli(compressed), data);
+
+  const auto compressor = compression::brotli::MakeStreamCompressor(1);
+  EXPECT_EQ(DecompressBrotli(CompressStream(*compressor, data)), data);
+
+  EXPECT_THROW(compression::brotli::MakeStreamCompressor(12),
+               compression::CompressionError);
+}
+
+TEST(Compression, StreamChunksAreFlushed) {
+  const std::string chunk = "some data that is sent to the client right away";
+
+  std::string compressed;
+  const auto compressor = compression::zstd::MakeStreamCompressor(3);
+  compressor->Compress(chunk, compressed);
+  // The chunk can be decoded before the stream end
+  EXPECT_EQ(DecompressZstd(compressed), chunk);
+}
+
+USERVER_NAMESPACE_END
@@ -1,7 +1,13 @@
 #include <compression/gzip.hpp>
 
+#include <algorithm>
+#include <limits>
+
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
+#include <zlib.h>
+
+#include <fmt/format.h>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -9,7 +15,69 @@ namespace compression::gzip {
 
 namespace {
 constexpr auto kDecompressBufferSize = 1024;
-}
+constexpr std::size_t kMinCompressBufferSize = 256;
+
+// 15 bits of the window size + 16 to write the gzip header and trailer
+constexpr int kGzipWindowBits = 15 + 16;
+constexpr int kMemLevel = 8;
+
+class GzipStreamCompressor final : public StreamCompressor {
+ public:
+  explicit GzipStreamCompressor(int level) {
+    const auto ret = deflateInit2(&stream_, level, Z_DEFLATED, kGzipWindowBits,
+                                  kMemLevel, Z_DEFAULT_STRATEGY);
+    if (ret != Z_OK) {
+      throw CompressionError(
+          fmt::format("failed to initialize gzip compression with level {}, "
+                      "zlib error {}",
+                      level, ret));
+    }
+  }
+
+  ~GzipStreamCompressor() override { deflateEnd(&stream_); }
+
+  void Compress(std::string_view data, std::string& out) override {
+    Deflate(data, Z_SYNC_FLUSH, out);
+  }
+
+  void Finish(std::string_view data, std::string& out) override {
+    Deflate(data, Z_FINISH, out);
+  }
+
+ private:
+  void Deflate(std::string_view data, int flush, std::string& out) {
+    if (data.size() > std::numeric_limits<uInt>::max()) {
+      throw CompressionError("too large chunk for gzip compression");
+    }
+    // zlib does not modify the input
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream_.avail_in = static_cast<uInt>(data.size());
+
+    while (true) {
+      const auto old_size = out.size();
+      const auto buffer_size = std::max<std::size_t>(
+          deflateBound(&stream_, stream_.avail_in), kMinCompressBufferSize);
+      out.resize(old_size + buffer_size);
+      stream_.next_out = reinterpret_cast<Bytef*>(out.data() + old_size);
+      stream_.avail_out = static_cast<uInt>(buffer_size);
+
+      const auto ret = deflate(&stream_, flush);
+      out.resize(out.size() - stream_.avail_out);
+
+      if (ret == Z_STREAM_END) return;
+      if (ret != Z_OK && ret != Z_BUF_ERROR) {
+        throw CompressionError(
+            fmt::format("failed to compress gzip data, zlib error {}", ret));
+      }
+      if (stream_.avail_out != 0 && flush != Z_FINISH) return;
+    }
+  }
+
+  z_stream stream_{};
+};
+
+}  // namespace
 
 std::string Decompress(std::string_view compressed, size_t max_size) {
   std::string decompressed;
@@ -38,6 +106,16 @@ std::string Decompress(std::string_view compressed, size_t max_size) {
   return decompressed;
 }
 
+std::string Compress(std::string_view data, int level) {
+  std::string compressed;
+  MakeStreamCompressor(level)->Finish(data, compressed);
+  return compressed;
+}
+
+std::unique_ptr<StreamCompressor> MakeStreamCompressor(int level) {
+  return std::make_unique<GzipStreamCompressor>(level);
+}
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <memory>
+#include <string>
 #include <string_view>
 
 #include <compression/error.hpp>
+#include <compression/stream_compressor.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -12,6 +15,13 @@ namespace compression::gzip {
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
 
+/// Compresses the string, level is from 1 (fastest) to 9 (best compression).
+/// @throws CompressionError
+std::string Compress(std::string_view data, int level);
+
+/// @throws CompressionError
+std::unique_ptr<StreamCompressor> MakeStreamCompressor(int level);
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
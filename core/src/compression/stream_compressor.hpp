@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression {
+
+/// @brief Compresses a stream of data chunks into a single compressed stream.
+///
+/// Every chunk is flushed, so the peer can decode all the data compressed so
+/// far without waiting for the end of the stream.
+class StreamCompressor {
+ public:
+  virtual ~StreamCompressor() = default;
+
+  /// Appends compressed and flushed `data` to `out`.
+  /// @throws CompressionError
+  virtual void Compress(std::string_view data, std::string& out) = 0;
+
+  /// Appends compressed `data` and the end of the stream to `out`. No more
+  /// data can be compressed after that.
+  /// @throws CompressionError
+  virtual void Finish(std::string_view data, std::string& out) = 0;
+};
+
+}  // namespace compression
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,250 @@
+#include <compression/zstd.hpp>
+
+#include <algorithm>
+#include <new>
+
+#include <fmt/format.h>
+#include <zstd.h>
+
+#include <userver/compiler/thread_local.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression::zstd {
+
+namespace {
+
+struct CompressionContextDeleter final {
+  void operator()(ZSTD_CCtx* context) const noexcept { ZSTD_freeCCtx(context); }
+};
+
+struct DecompressionContextDeleter final {
+  void operator()(ZSTD_DCtx* context) const noexcept { ZSTD_freeDCtx(context); }
+};
+
+using CompressionContext =
+    std::unique_ptr<ZSTD_CCtx, CompressionContextDeleter>;
+using DecompressionContext =
+    std::unique_ptr<ZSTD_DCtx, DecompressionContextDeleter>;
+
+// The one-shot calls of a thread reuse the contexts, which saves the
+// allocation and the initialization of the tables on each call
+struct LocalContexts final {
+  CompressionContext compression;
+  DecompressionContext decompression;
+};
+
+compiler::ThreadLocal local_contexts = [] { return LocalContexts{}; };
+
+void CheckLevel(int level) {
+  if (level < ZSTD_minCLevel() || level > ZSTD_maxCLevel()) {
+    throw CompressionError(
+        fmt::format("zstd compression level {} is out of range [{}, {}]",
+                    level, ZSTD_minCLevel(), ZSTD_maxCLevel()));
+  }
+}
+
+void SetLevel(ZSTD_CCtx* context, int level) {
+  CheckLevel(level);
+  const auto ret =
+      ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, level);
+  if (ZSTD_isError(ret)) {
+    throw CompressionError(
+        fmt::format("failed to set zstd compression level {}: {}", level,
+                    ZSTD_getErrorName(ret)));
+  }
+}
+
+// Resets the per-thread context to the default parameters
+ZSTD_CCtx& GetLocalCompressionContext(LocalContexts& contexts) {
+  if (!contexts.compression) {
+    contexts.compression.reset(ZSTD_createCCtx());
+    if (!contexts.compression) throw std::bad_alloc{};
+  } else {
+    ZSTD_CCtx_reset(contexts.compression.get(),
+                    ZSTD_reset_session_and_parameters);
+  }
+  return *contexts.compression;
+}
+
+ZSTD_DCtx& GetLocalDecompressionContext(LocalContexts& contexts) {
+  if (!contexts.decompression) {
+    contexts.decompression.reset(ZSTD_createDCtx());
+    if (!contexts.decompression) throw std::bad_alloc{};
+  } else {
+    ZSTD_DCtx_reset(contexts.decompression.get(),
+                    ZSTD_reset_session_and_parameters);
+  }
+  return *contexts.decompression;
+}
+
+std::string CompressWith(ZSTD_CCtx& context, std::string_view data) {
+  std::string compressed(ZSTD_compressBound(data.size()), '\0');
+  const auto size = ZSTD_compress2(&context, compressed.data(),
+                                   compressed.size(), data.data(), data.size());
+  if (ZSTD_isError(size)) {
+    throw CompressionError(fmt::format("failed to compress zstd data: {}",
+                                       ZSTD_getErrorName(size)));
+  }
+  compressed.resize(size);
+  return compressed;
+}
+
+class ZstdStreamCompressor final : public StreamCompressor {
+ public:
+  explicit ZstdStreamCompressor(int level) : context_(ZSTD_createCCtx()) {
+    if (!context_) throw std::bad_alloc{};
+    SetLevel(context_.get(), level);
+  }
+
+  void Compress(std::string_view data, std::string& out) override {
+    CompressStream(data, ZSTD_e_flush, out);
+  }
+
+  void Finish(std::string_view data, std::string& out) override {
+    CompressStream(data, ZSTD_e_end, out);
+  }
+
+ private:
+  void CompressStream(std::string_view data, ZSTD_EndDirective mode,
+                      std::string& out) {
+    ZSTD_inBuffer input{data.data(), data.size(), 0};
+    while (true) {
+      const auto old_size = out.size();
+      const auto buffer_size =
+          std::max(ZSTD_compressBound(input.size - input.pos),
+                   ZSTD_CStreamOutSize());
+      out.resize(old_size + buffer_size);
+      ZSTD_outBuffer output{out.data() + old_size, buffer_size, 0};
+
+      const auto remaining =
+          ZSTD_compressStream2(context_.get(), &output, &input, mode);
+      out.resize(old_size + output.pos);
+
+      if (ZSTD_isError(remaining)) {
+        throw CompressionError(fmt::format("failed to compress zstd data: {}",
+                                           ZSTD_getErrorName(remaining)));
+      }
+      // Everything is flushed
+      if (remaining == 0) return;
+    }
+  }
+
+  CompressionContext context_;
+};
+
+}  // namespace
+
+struct Dictionary::Impl final {
+  struct CompressionDictionaryDeleter final {
+    void operator()(ZSTD_CDict* dictionary) const noexcept {
+      ZSTD_freeCDict(dictionary);
+    }
+  };
+
+  struct DecompressionDictionaryDeleter final {
+    void operator()(ZSTD_DDict* dictionary) const noexcept {
+      ZSTD_freeDDict(dictionary);
+    }
+  };
+
+  std::unique_ptr<ZSTD_CDict, CompressionDictionaryDeleter> compression;
+  std::unique_ptr<ZSTD_DDict, DecompressionDictionaryDeleter> decompression;
+};
+
+Dictionary::Dictionary(std::string_view content, int level)
+    : impl_(std::make_unique<Impl>()) {
+  CheckLevel(level);
+  impl_->compression.reset(
+      ZSTD_createCDict(content.data(), content.size(), level));
+  impl_->decompression.reset(ZSTD_createDDict(content.data(), content.size()));
+  if (!impl_->compression || !impl_->decompression) throw std::bad_alloc{};
+}
+
+Dictionary::Dictionary(Dictionary&&) noexcept = default;
+
+Dictionary& Dictionary::operator=(Dictionary&&) noexcept = default;
+
+Dictionary::~Dictionary() = default;
+
+unsigned Dictionary::GetId() const noexcept {
+  return ZSTD_getDictID_fromDDict(impl_->decompression.get());
+}
+
+std::string Decompress(std::string_view compressed, size_t max_size,
+                       const Dictionary* dictionary) {
+  auto contexts = local_contexts.Use();
+  auto* const context = &GetLocalDecompressionContext(*contexts);
+  if (dictionary) {
+    const auto ret =
+        ZSTD_DCtx_refDDict(context, dictionary->impl_->decompression.get());
+    if (ZSTD_isError(ret)) {
+      throw DecompressionError(
+          fmt::format("failed to use a zstd dictionary for decompression: {}",
+                      ZSTD_getErrorName(ret)));
+    }
+  }
+
+  std::string decompressed;
+  // The size is known in advance for the data compressed by `Compress`
+  const auto content_size =
+      ZSTD_getFrameContentSize(compressed.data(), compressed.size());
+  if (content_size != ZSTD_CONTENTSIZE_UNKNOWN &&
+      content_size != ZSTD_CONTENTSIZE_ERROR) {
+    if (content_size > max_size) throw TooBigError();
+    decompressed.reserve(content_size);
+  }
+
+  ZSTD_inBuffer input{compressed.data(), compressed.size(), 0};
+  std::size_t remaining = 0;
+  while (input.pos < input.size || remaining != 0) {
+    const auto old_size = decompressed.size();
+    const auto buffer_size = ZSTD_DStreamOutSize();
+    decompressed.resize(old_size + buffer_size);
+    ZSTD_outBuffer output{decompressed.data() + old_size, buffer_size, 0};
+
+    remaining = ZSTD_decompressStream(context, &output, &input);
+    decompressed.resize(old_size + output.pos);
+
+    if (ZSTD_isError(remaining)) {
+      throw DecompressionError(
+          fmt::format("failed to decompress zstd data: {}",
+                      ZSTD_getErrorName(remaining)));
+    }
+    if (decompressed.size() > max_size) throw TooBigError();
+    // The frame is truncated
+    if (remaining != 0 && output.pos == 0 && input.pos == input.size) {
+      throw DecompressionError("failed to decompress zstd data: truncated");
+    }
+  }
+
+  return decompressed;
+}
+
+std::string Compress(std::string_view data, int level) {
+  auto contexts = local_contexts.Use();
+  auto& context = GetLocalCompressionContext(*contexts);
+  SetLevel(&context, level);
+  return CompressWith(context, data);
+}
+
+std::string Compress(std::string_view data, const Dictionary& dictionary) {
+  auto contexts = local_contexts.Use();
+  auto& context = GetLocalCompressionContext(*contexts);
+  const auto ret =
+      ZSTD_CCtx_refCDict(&context, dictionary.impl_->compression.get());
+  if (ZSTD_isError(ret)) {
+    throw CompressionError(
+        fmt::format("failed to use a zstd dictionary for compression: {}",
+                    ZSTD_getErrorName(ret)));
+  }
+  return CompressWith(context, data);
+}
+
+std::unique_ptr<StreamCompressor> MakeStreamCompressor(int level) {
+  return std::make_unique<ZstdStreamCompressor>(level);
+}
+
+}  // namespace compression::zstd
+
+USERVER_NAMESPACE_END
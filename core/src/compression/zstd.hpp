@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <compression/error.hpp>
+#include <compression/stream_compressor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression::zstd {
+
+inline constexpr int kDefaultLevel = 3;
+
+class Dictionary;
+
+/// Decompresses the string, the dictionary is required if the data was
+/// compressed with one. The per-thread decompression context is reused.
+/// @throws DecompressionError
+std::string Decompress(std::string_view compressed, size_t max_size,
+                       const Dictionary* dictionary = nullptr);
+
+/// Compresses the string, level is from 1 (fastest) to 22 (best compression).
+/// The per-thread compression context is reused.
+/// @throws CompressionError
+std::string Compress(std::string_view data, int level);
+
+/// Compresses the string at the level of the dictionary.
+/// @throws CompressionError
+std::string Compress(std::string_view data, const Dictionary& dictionary);
+
+/// @brief A pre-trained dictionary, e.g. made by `zstd --train` from samples
+/// of small payloads that have much in common, like JSON objects of the same
+/// schema. Such payloads compress far better with a shared dictionary.
+///
+/// The dictionary is prepared once for the compression at the given level and
+/// for the decompression, and can be used by several threads at once.
+class Dictionary final {
+ public:
+  /// @throws CompressionError on invalid level
+  explicit Dictionary(std::string_view content, int level = kDefaultLevel);
+
+  Dictionary(Dictionary&&) noexcept;
+  Dictionary& operator=(Dictionary&&) noexcept;
+  ~Dictionary();
+
+  /// The id written to the compressed frames, 0 for a raw content dictionary
+  unsigned GetId() const noexcept;
+
+ private:
+  friend std::string Compress(std::string_view, const Dictionary&);
+  friend std::string Decompress(std::string_view, size_t, const Dictionary*);
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/// @throws CompressionError
+std::unique_ptr<StreamCompressor> MakeStreamCompressor(int level);
+
+}  // namespace compression::zstd
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,131 @@
+#include <userver/concurrent/bounded_spsc_queue.hpp>
+
+#include <algorithm>
+#include <optional>
+
+#include <concurrent/mp_queue_test.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using TestTypes = testing::Types<
+    concurrent::BoundedSpscQueue<int>,
+    concurrent::BoundedSpscQueue<std::unique_ptr<int>>,
+    concurrent::BoundedSpscQueue<std::unique_ptr<RefCountData>>>;
+
+constexpr std::size_t kMaxSize = 16;
+constexpr std::size_t kMessageCount = 10000;
+
+}  // namespace
+
+INSTANTIATE_TYPED_UTEST_SUITE_P(BoundedSpscQueue, TypedQueueFixture,
+                                TestTypes);
+
+UTEST(BoundedSpscQueue, ConsumerIsDead) {
+  auto queue = concurrent::BoundedSpscQueue<int>::Create();
+  auto producer = queue->GetProducer();
+
+  (void)(queue->GetConsumer());
+  EXPECT_FALSE(producer.Push(0));
+  EXPECT_FALSE(producer.PushNoblock(0));
+}
+
+UTEST(BoundedSpscQueue, MaxSize) {
+  auto queue = concurrent::BoundedSpscQueue<int>::Create(3);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  EXPECT_EQ(queue->GetSoftMaxSize(), 3);
+  queue->SetSoftMaxSize(100);
+  EXPECT_EQ(queue->GetSoftMaxSize(), 3);
+
+  for (int i = 0; i < 3; ++i) EXPECT_TRUE(producer.PushNoblock(int{i}));
+  EXPECT_FALSE(producer.PushNoblock(3));
+  EXPECT_FALSE(producer.Push(3, engine::Deadline::Passed()));
+  EXPECT_EQ(queue->GetSizeApproximate(), 3);
+
+  // Wraps around the ring buffer
+  int value{};
+  for (int i = 3; i < 10; ++i) {
+    EXPECT_TRUE(consumer.PopNoblock(value));
+    EXPECT_EQ(value, i - 3);
+    EXPECT_TRUE(producer.PushNoblock(int{i}));
+  }
+  EXPECT_EQ(queue->GetSizeApproximate(), 3);
+}
+
+UTEST(BoundedSpscQueue, PushPopMany) {
+  auto queue = concurrent::BoundedSpscQueue<int>::Create(4);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  EXPECT_FALSE(producer.PushMany({0, 1, 2, 3, 4}));
+  EXPECT_TRUE(producer.PushMany({0, 1, 2}));
+  EXPECT_FALSE(producer.PushMany({3, 4}, engine::Deadline::Passed()));
+
+  std::vector<int> values;
+  EXPECT_EQ(consumer.PopMany(values, 2), 2);
+  EXPECT_TRUE(producer.PushMany({3, 4}));
+  EXPECT_EQ(consumer.PopMany(values, 10), 3);
+  EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3, 4}));
+  EXPECT_EQ(consumer.PopMany(values, 10, engine::Deadline::Passed()), 0);
+}
+
+UTEST_MT(BoundedSpscQueue, Spsc, 1 + 1) {
+  auto queue = concurrent::BoundedSpscQueue<std::size_t>::Create(kMaxSize);
+
+  std::optional producer(queue->GetProducer());
+  auto producer_task = utils::Async("producer", [&producer = *producer] {
+    for (std::size_t message = 0; message < kMessageCount; ++message) {
+      ASSERT_TRUE(producer.Push(std::size_t{message}));
+    }
+  });
+
+  auto consumer = queue->GetConsumer();
+  auto consumer_task = utils::Async("consumer", [&] {
+    std::size_t expected = 0;
+    std::size_t value{};
+    while (consumer.Pop(value)) {
+      EXPECT_EQ(value, expected++);
+    }
+    EXPECT_EQ(expected, kMessageCount);
+  });
+
+  producer_task.Get();
+  producer.reset();
+  consumer_task.Get();
+}
+
+UTEST_MT(BoundedSpscQueue, SpscBatches, 1 + 1) {
+  constexpr std::size_t kBatchSize = 5;
+  auto queue = concurrent::BoundedSpscQueue<std::size_t>::Create(kMaxSize);
+
+  std::optional producer(queue->GetProducer());
+  auto producer_task = utils::Async("producer", [&producer = *producer] {
+    std::vector<std::size_t> batch;
+    for (std::size_t message = 0; message < kMessageCount; ++message) {
+      batch.push_back(message);
+      if (batch.size() == kBatchSize) {
+        ASSERT_TRUE(producer.PushMany(std::move(batch)));
+      }
+    }
+  });
+
+  auto consumer = queue->GetConsumer();
+  auto consumer_task = utils::Async("consumer", [&] {
+    std::vector<std::size_t> values;
+    while (consumer.PopMany(values, kMaxSize)) {
+    }
+    ASSERT_EQ(values.size(), kMessageCount);
+    for (std::size_t i = 0; i < kMessageCount; ++i) EXPECT_EQ(values[i], i);
+  });
+
+  producer_task.Get();
+  producer.reset();
+  consumer_task.Get();
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/concurrent/hash_map.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::uint64_t kKeysCount = 1024;
+
+class HashMapAdapter final {
+ public:
+  std::uint64_t Get(std::uint64_t key) const {
+    return map_.Get(key).value_or(0);
+  }
+
+  void Set(std::uint64_t key, std::uint64_t value) {
+    map_.InsertOrAssign(key, value);
+  }
+
+ private:
+  concurrent::HashMap<std::uint64_t, std::uint64_t> map_;
+};
+
+class RcuMapAdapter final {
+ public:
+  std::uint64_t Get(std::uint64_t key) const {
+    const auto value = map_.Get(key);
+    return value ? *value : 0;
+  }
+
+  void Set(std::uint64_t key, std::uint64_t value) {
+    map_.InsertOrAssign(key, std::make_shared<std::uint64_t>(value));
+  }
+
+ private:
+  rcu::RcuMap<std::uint64_t, std::uint64_t> map_;
+};
+
+class VariableAdapter final {
+ public:
+  std::uint64_t Get(std::uint64_t key) const {
+    const auto map = map_.Lock();
+    const auto it = map->find(key);
+    return it == map->end() ? 0 : it->second;
+  }
+
+  void Set(std::uint64_t key, std::uint64_t value) {
+    auto map = map_.Lock();
+    (*map)[key] = value;
+  }
+
+ private:
+  mutable concurrent::Variable<std::unordered_map<std::uint64_t, std::uint64_t>>
+      map_;
+};
+
+}  // namespace
+
+// Readers in the current thread and state.range(0) - 1 other threads,
+// state.range(1) writers, each writes a random key of the map
+template <typename Map>
+void hash_map_contention(benchmark::State& state) {
+  const std::size_t readers_count = state.range(0);
+  const std::size_t writers_count = state.range(1);
+
+  engine::RunStandalone(readers_count + writers_count, [&] {
+    std::atomic<bool> run{true};
+    Map map;
+    for (std::uint64_t key = 0; key < kKeysCount; ++key) map.Set(key, key);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(readers_count - 1 + writers_count);
+
+    for (std::size_t i = 0; i < readers_count - 1; ++i) {
+      tasks.push_back(utils::Async("reader", [&] {
+        std::uint64_t key = 0;
+        while (run) {
+          benchmark::DoNotOptimize(map.Get(key++ % kKeysCount));
+        }
+      }));
+    }
+
+    for (std::size_t i = 0; i < writers_count; ++i) {
+      tasks.push_back(utils::Async("writer", [&, i] {
+        std::uint64_t key = i * 7919;
+        while (run) {
+          key = key * 6364136223846793005 + 1442695040888963407;
+          map.Set(key % kKeysCount, key);
+        }
+      }));
+    }
+
+    std::uint64_t key = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(map.Get(key++ % kKeysCount));
+    }
+
+    run = false;
+    for (auto& task : tasks) {
+      task.Get();
+    }
+  });
+}
+BENCHMARK_TEMPLATE(hash_map_contention, HashMapAdapter)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 4}, {0, 4}});
+BENCHMARK_TEMPLATE(hash_map_contention, RcuMapAdapter)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 4}, {0, 4}});
+BENCHMARK_TEMPLATE(hash_map_contention, VariableAdapter)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 4}, {0, 4}});
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,114 @@
+#include <userver/concurrent/hash_map.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWritersCount = 4;
+constexpr std::size_t kKeysCount = 1000;
+
+}  // namespace
+
+UTEST(HashMap, Sample) {
+  /// [Sample concurrent::HashMap usage]
+  concurrent::HashMap<std::string, int> requests_per_user;
+
+  requests_per_user.Update("alice", [](std::optional<int>& requests) {
+    requests = requests.value_or(0) + 1;
+  });
+  EXPECT_EQ(requests_per_user.Get("alice"), 1);
+  EXPECT_EQ(requests_per_user.Get("bob"), std::nullopt);
+  /// [Sample concurrent::HashMap usage]
+}
+
+UTEST(HashMap, InsertEraseAssign) {
+  concurrent::HashMap<int, std::string> map;
+
+  EXPECT_TRUE(map.Insert(1, "one"));
+  EXPECT_FALSE(map.Insert(1, "uno"));
+  EXPECT_EQ(map.Get(1), "one");
+  EXPECT_TRUE(map.Contains(1));
+  EXPECT_FALSE(map.Contains(2));
+
+  map.InsertOrAssign(1, "uno");
+  map.InsertOrAssign(2, "dos");
+  EXPECT_EQ(map.Get(1), "uno");
+  EXPECT_EQ(map.Get(2), "dos");
+  EXPECT_EQ(map.GetSizeApproximate(), 2);
+
+  EXPECT_TRUE(map.Erase(1));
+  EXPECT_FALSE(map.Erase(1));
+  EXPECT_EQ(map.Get(1), std::nullopt);
+  EXPECT_EQ(map.GetSizeApproximate(), 1);
+
+  // Erasing from Update
+  map.Update(2, [](std::optional<std::string>& value) {
+    EXPECT_EQ(value, "dos");
+    value.reset();
+  });
+  EXPECT_FALSE(map.Contains(2));
+  EXPECT_EQ(map.GetSizeApproximate(), 0);
+  map.Cleanup();
+}
+
+UTEST(HashMap, Rehash) {
+  concurrent::HashMap<std::size_t, std::size_t> map;
+  for (std::size_t i = 0; i < kKeysCount; ++i) {
+    EXPECT_TRUE(map.Insert(i, i * 2));
+  }
+  EXPECT_EQ(map.GetSizeApproximate(), kKeysCount);
+
+  std::vector<int> visited(kKeysCount, 0);
+  map.VisitAll([&visited](std::size_t key, std::size_t value) {
+    EXPECT_EQ(value, key * 2);
+    ++visited[key];
+  });
+  for (std::size_t i = 0; i < kKeysCount; ++i) {
+    EXPECT_EQ(visited[i], 1);
+    EXPECT_EQ(map.Get(i), i * 2);
+  }
+}
+
+UTEST_MT(HashMap, ConcurrentUpdates, kWritersCount + 1) {
+  concurrent::HashMap<std::size_t, std::size_t> map;
+  std::atomic<bool> run{true};
+
+  auto reader = utils::Async("reader", [&] {
+    while (run) {
+      for (std::size_t key = 0; key < kKeysCount; ++key) {
+        const auto value = map.Get(key);
+        if (value) {
+          EXPECT_LE(*value, kWritersCount);
+        }
+      }
+    }
+  });
+
+  std::vector<engine::TaskWithResult<void>> writers;
+  for (std::size_t i = 0; i < kWritersCount; ++i) {
+    writers.push_back(utils::Async("writer", [&] {
+      for (std::size_t key = 0; key < kKeysCount; ++key) {
+        map.Update(key, [](std::optional<std::size_t>& value) {
+          value = value.value_or(0) + 1;
+        });
+      }
+    }));
+  }
+  for (auto& writer : writers) writer.Get();
+  run = false;
+  reader.Get();
+
+  EXPECT_EQ(map.GetSizeApproximate(), kKeysCount);
+  for (std::size_t key = 0; key < kKeysCount; ++key) {
+    EXPECT_EQ(map.Get(key), kWritersCount);
+  }
+}
+
+USERVER_NAMESPACE_END
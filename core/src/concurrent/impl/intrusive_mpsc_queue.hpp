@@ -2,8 +2,8 @@
 
 #include <atomic>
 
-#include <concurrent/impl/interference_shield.hpp>
-#include <concurrent/impl/intrusive_hooks.hpp>
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/concurrent/impl/intrusive_hooks.hpp>
 #include <userver/utils/not_null.hpp>
 
 USERVER_NAMESPACE_BEGIN
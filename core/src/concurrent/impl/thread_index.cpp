@@ -0,0 +1,20 @@
+#include <userver/concurrent/impl/thread_index.hpp>
+
+#include <atomic>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent::impl {
+
+std::size_t GetCurrentThreadIndex() noexcept {
+  static std::atomic<std::size_t> next_index{0};
+  // OS threads are started one after another, so the consecutive indices
+  // spread the worker threads of a task processor evenly over the shards
+  thread_local const std::size_t index =
+      next_index.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+}  // namespace concurrent::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,82 @@
+#include <userver/concurrent/object_pool.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Buffer final {
+  std::vector<char> data = std::vector<char>(4096);
+};
+
+template <typename Work>
+void RunContended(benchmark::State& state, const Work& work) {
+  std::atomic<bool> keep_running{true};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::int64_t i = 0; i < state.range(0) - 1; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&work, &keep_running] {
+      while (keep_running) {
+        work();
+      }
+    }));
+  }
+
+  for ([[maybe_unused]] auto _ : state) {
+    work();
+  }
+
+  keep_running = false;
+  for (auto& task : tasks) task.Get();
+}
+
+}  // namespace
+
+void object_pool(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    concurrent::ObjectPool<Buffer> pool;
+    RunContended(state, [&pool] {
+      auto buffer = pool.Acquire();
+      benchmark::DoNotOptimize(buffer->data.data());
+    });
+  });
+}
+BENCHMARK(object_pool)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(6)
+    ->Arg(8)
+    ->Arg(12)
+    ->Arg(16)
+    ->Arg(32);
+
+void object_pool_new_delete(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    RunContended(state, [] {
+      auto buffer = std::make_unique<Buffer>();
+      benchmark::DoNotOptimize(buffer->data.data());
+    });
+  });
+}
+BENCHMARK(object_pool_new_delete)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(6)
+    ->Arg(8)
+    ->Arg(12)
+    ->Arg(16)
+    ->Arg(32);
+
+USERVER_NAMESPACE_END
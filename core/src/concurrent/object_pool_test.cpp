@@ -0,0 +1,134 @@
+#include <userver/concurrent/object_pool.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct CountedObject final {
+  explicit CountedObject(std::atomic<int>& alive) : alive(alive) { ++alive; }
+  CountedObject(CountedObject&& other) noexcept : alive(other.alive) {
+    ++alive;
+  }
+  ~CountedObject() { --alive; }
+
+  std::atomic<int>& alive;
+};
+
+}  // namespace
+
+UTEST(ObjectPool, Sample) {
+  /// [Sample concurrent::ObjectPool usage]
+  concurrent::ObjectPool<std::string> buffers;
+
+  {
+    auto buffer = buffers.Acquire();
+    buffer->clear();
+    buffer->append("some data");
+    // The buffer returns to the pool here, with its capacity
+  }
+
+  const auto buffer = buffers.Acquire();
+  EXPECT_EQ(*buffer, "some data");
+  /// [Sample concurrent::ObjectPool usage]
+}
+
+UTEST(ObjectPool, Reuse) {
+  concurrent::ObjectPool<int> pool;
+  const int* first_address = nullptr;
+  {
+    auto object = pool.Acquire([] { return 42; });
+    first_address = object.get();
+  }
+  EXPECT_EQ(pool.GetIdleCountApproximate(), 1);
+
+  auto object = pool.Acquire([] { return 0; });
+  EXPECT_EQ(object.get(), first_address);
+  EXPECT_EQ(*object, 42);
+  EXPECT_EQ(pool.GetIdleCountApproximate(), 0);
+
+  auto other = pool.Acquire([] { return 1; });
+  EXPECT_NE(other.get(), first_address);
+  EXPECT_EQ(*other, 1);
+}
+
+UTEST(ObjectPool, MaxIdle) {
+  std::atomic<int> alive{0};
+  {
+    concurrent::ObjectPool<CountedObject> pool{1};
+    const auto factory = [&alive] { return CountedObject{alive}; };
+    {
+      auto first = pool.Acquire(factory);
+      auto second = pool.Acquire(factory);
+      EXPECT_EQ(alive, 2);
+    }
+    EXPECT_EQ(pool.GetIdleCountApproximate(), 1);
+    EXPECT_EQ(alive, 1);
+  }
+  EXPECT_EQ(alive, 0);
+}
+
+UTEST(ObjectPool, Trim) {
+  std::atomic<int> alive{0};
+  concurrent::ObjectPool<CountedObject> pool;
+  const auto factory = [&alive] { return CountedObject{alive}; };
+  {
+    std::vector<concurrent::ObjectPool<CountedObject>::Ptr> objects;
+    for (int i = 0; i < 10; ++i) objects.push_back(pool.Acquire(factory));
+  }
+  EXPECT_EQ(pool.GetIdleCountApproximate(), 10);
+  EXPECT_EQ(alive, 10);
+
+  pool.Trim(3);
+  EXPECT_EQ(pool.GetIdleCountApproximate(), 3);
+  EXPECT_EQ(alive, 3);
+
+  pool.Trim(0);
+  EXPECT_EQ(alive, 0);
+
+  // The trimmed nodes are reused for the new objects
+  auto object = pool.Acquire(factory);
+  EXPECT_EQ(alive, 1);
+}
+
+UTEST(ObjectPool, FactoryThrows) {
+  concurrent::ObjectPool<int> pool;
+  EXPECT_THROW(pool.Acquire([]() -> int { throw std::runtime_error("test"); }),
+               std::runtime_error);
+  EXPECT_EQ(pool.GetIdleCountApproximate(), 0);
+  EXPECT_EQ(*pool.Acquire([] { return 1; }), 1);
+}
+
+UTEST_MT(ObjectPool, TortureTest, 8) {
+  constexpr std::size_t kTasks = 16;
+  constexpr std::size_t kIterations = 1000;
+  concurrent::ObjectPool<std::atomic<bool>> pool;
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasks);
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(utils::Async("user", [&pool] {
+      for (std::size_t j = 0; j < kIterations; ++j) {
+        auto object = pool.Acquire([] { return false; });
+        // Nobody else must be using the object
+        ASSERT_FALSE(object->exchange(true));
+        object->store(false);
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_LE(pool.GetIdleCountApproximate(), kTasks);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,56 @@
+#include <userver/concurrent/pipeline.hpp>
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/engine/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent::impl {
+
+PipelineStage& PipelineState::AddStage(std::string name) {
+  return stages_.emplace_back(std::move(name));
+}
+
+void PipelineState::SetException(std::exception_ptr exception) noexcept {
+  if (!has_exception_.exchange(true)) exception_ = std::move(exception);
+}
+
+void PipelineState::Finish() {
+  const bool cancelled = engine::current_task::ShouldCancel();
+  // All the stages have already stopped producing, let them exit
+  tasks_.CancelAndWait();
+
+  if (has_exception_) std::rethrow_exception(exception_);
+  if (cancelled) {
+    throw engine::WaitInterruptedException(
+        engine::current_task::CancellationReason());
+  }
+  for (const auto& stage : stages_) {
+    if (stage.unfinished_tasks != 0) {
+      throw std::runtime_error(fmt::format(
+          "Pipeline stage '{}' has been cancelled before finishing, e.g. due "
+          "to the task processor overload",
+          stage.name));
+    }
+  }
+}
+
+std::vector<PipelineStageStatistics> PipelineState::GetStatistics() const {
+  std::vector<PipelineStageStatistics> result;
+  result.reserve(stages_.size());
+  for (const auto& stage : stages_) {
+    const std::chrono::nanoseconds busy_time{stage.busy_time_ns.load()};
+    result.push_back(
+        {stage.name, stage.processed.load(),
+         std::chrono::duration_cast<std::chrono::microseconds>(busy_time)});
+  }
+  return result;
+}
+
+}  // namespace concurrent::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,137 @@
+#include <userver/concurrent/pipeline.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+auto MakeNumbers(int count) {
+  return [count](concurrent::PipelineProducer<int>& producer) {
+    for (int i = 0; i < count; ++i) {
+      if (!producer.Push(i)) return;
+    }
+  };
+}
+
+}  // namespace
+
+UTEST_MT(Pipeline, Sample, 4) {
+  /// [Sample concurrent::Pipeline usage]
+  auto pipeline =
+      concurrent::Pipeline<int>::FromSource(
+          "read",
+          [](concurrent::PipelineProducer<int>& producer) {
+            for (int row = 0; row < 100; ++row) {
+              // Stop if the next stages have failed
+              if (!producer.Push(row)) return;
+            }
+          })
+          .Transform(
+              "format", [](int row) { return std::to_string(row); },
+              {/*parallelism=*/4, /*buffer_size=*/16})
+          .Batch("batch", /*max_batch_size=*/10);
+
+  std::size_t rows = 0;
+  pipeline.Consume("write", [&rows](std::vector<std::string> batch) {
+    EXPECT_LE(batch.size(), 10);
+    rows += batch.size();
+  });
+  EXPECT_EQ(rows, 100);
+  /// [Sample concurrent::Pipeline usage]
+
+  const auto statistics = pipeline.GetStatistics();
+  ASSERT_EQ(statistics.size(), 4);
+  EXPECT_EQ(statistics[0].name, "read");
+  EXPECT_EQ(statistics[0].processed, 100);
+  EXPECT_EQ(statistics[1].name, "format");
+  EXPECT_EQ(statistics[1].processed, 100);
+  EXPECT_EQ(statistics[2].name, "batch");
+  EXPECT_EQ(statistics[3].name, "write");
+  EXPECT_EQ(statistics[3].processed, statistics[2].processed);
+}
+
+UTEST(Pipeline, KeepsOrder) {
+  auto pipeline =
+      concurrent::Pipeline<int>::FromSource("source", MakeNumbers(1000))
+          .Transform("square", [](int x) { return x * x; });
+
+  std::vector<int> result;
+  pipeline.Consume("sink", [&result](int x) { result.push_back(x); });
+
+  ASSERT_EQ(result.size(), 1000);
+  for (int i = 0; i < 1000; ++i) EXPECT_EQ(result[i], i * i);
+}
+
+UTEST_MT(Pipeline, Parallel, 4) {
+  auto pipeline =
+      concurrent::Pipeline<int>::FromSource("source", MakeNumbers(1000))
+          .Transform(
+              "negate", [](int x) { return -x; },
+              {/*parallelism=*/3, /*buffer_size=*/8});
+
+  std::vector<int> result;
+  pipeline.Consume("sink", [&result](int x) { result.push_back(-x); });
+
+  std::sort(result.begin(), result.end());
+  std::vector<int> expected(1000);
+  std::iota(expected.begin(), expected.end(), 0);
+  EXPECT_EQ(result, expected);
+}
+
+UTEST_MT(Pipeline, StageThrows, 2) {
+  auto pipeline =
+      concurrent::Pipeline<int>::FromSource("source", MakeNumbers(1000000))
+          .Transform("fail", [](int x) {
+            if (x == 100) throw std::runtime_error("test");
+            return x;
+          });
+
+  int consumed = 0;
+  UEXPECT_THROW(pipeline.Consume("sink", [&consumed](int) { ++consumed; }),
+                std::runtime_error);
+  EXPECT_EQ(consumed, 100);
+}
+
+UTEST_MT(Pipeline, ConsumerThrows, 2) {
+  auto pipeline =
+      concurrent::Pipeline<int>::FromSource("source", MakeNumbers(1000000));
+
+  const auto sink = [](int x) {
+    if (x == 10) throw std::runtime_error("test");
+  };
+  UEXPECT_THROW(pipeline.Consume("sink", sink), std::runtime_error);
+}
+
+UTEST_MT(Pipeline, DestroyedWithoutConsume, 2) {
+  auto pipeline = concurrent::Pipeline<int>::FromSource(
+      "source", [](concurrent::PipelineProducer<int>& producer) {
+        while (producer.Push(0)) {
+        }
+      });
+  engine::SleepFor(std::chrono::milliseconds{10});
+  // Must not hang, the source stops on cancellation
+}
+
+UTEST_MT(Pipeline, Cancelled, 2) {
+  auto pipeline = concurrent::Pipeline<int>::FromSource(
+      "source", [](concurrent::PipelineProducer<int>& producer) {
+        while (producer.Push(0)) {
+        }
+      });
+  engine::current_task::GetCancellationToken().RequestCancel();
+
+  UEXPECT_THROW(pipeline.Consume("sink", [](int) {}),
+                engine::WaitInterruptedException);
+}
+
+USERVER_NAMESPACE_END
@@ -31,6 +31,9 @@ auto GetProducerTask(const Producer& producer, std::size_t i) {
 template <typename T>
 class NonCoroutineTest : public ::testing::Test {};
 
+template <typename T>
+class BatchQueueTest : public ::testing::Test {};
+
 using TestMpmcTypes =
     testing::Types<concurrent::NonFifoMpmcQueue<int>,
                    concurrent::NonFifoMpmcQueue<std::unique_ptr<int>>,
@@ -83,6 +86,157 @@ TYPED_TEST(NonCoroutineTest, PushPopNoblock) {
   EXPECT_EQ(value, 2);
 }
 
+TYPED_UTEST_SUITE(BatchQueueTest, TestQueueTypes);
+
+TYPED_UTEST(BatchQueueTest, PushPopMany) {
+  auto queue = TypeParam::Create();
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  std::vector<std::size_t> values{0, 1, 2};
+  EXPECT_TRUE(producer.PushMany(std::move(values)));
+  EXPECT_TRUE(values.empty());
+  EXPECT_EQ(queue->GetSizeApproximate(), 3);
+
+  EXPECT_EQ(consumer.PopMany(values, 2), 2);
+  EXPECT_EQ(values, (std::vector<std::size_t>{0, 1}));
+  EXPECT_EQ(consumer.PopMany(values, 10), 1);
+  EXPECT_EQ(values, (std::vector<std::size_t>{0, 1, 2}));
+  EXPECT_EQ(queue->GetSizeApproximate(), 0);
+
+  EXPECT_EQ(consumer.PopMany(values, 10, engine::Deadline::Passed()), 0);
+  EXPECT_EQ(values.size(), 3);
+}
+
+TYPED_UTEST(BatchQueueTest, PushManyOverCapacity) {
+  auto queue = TypeParam::Create(2);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  std::vector<std::size_t> values{0, 1, 2};
+  EXPECT_FALSE(producer.PushMany(std::move(values)));
+  // NOLINTNEXTLINE(bugprone-use-after-move)
+  EXPECT_EQ(values.size(), 3);
+
+  values.pop_back();
+  EXPECT_TRUE(producer.PushMany(std::move(values)));
+  values = {2};
+  EXPECT_FALSE(
+      producer.PushMany(std::move(values), engine::Deadline::Passed()));
+  // NOLINTNEXTLINE(bugprone-use-after-move)
+  EXPECT_EQ(values.size(), 1);
+
+  std::size_t value{};
+  EXPECT_TRUE(consumer.Pop(value));
+  EXPECT_TRUE(producer.PushMany(std::move(values)));
+  EXPECT_EQ(queue->GetSizeApproximate(), 2);
+}
+
+// TestQueueTypes cover both the multi producer and the single producer sides
+TYPED_UTEST(BatchQueueTest, PushManyOversized) {
+  auto queue = TypeParam::Create(3);
+  auto producer = queue->GetProducer();
+
+  EXPECT_TRUE(producer.Push(0));
+
+  // Fails at once, though the deadline is not limited
+  std::vector<std::size_t> values{1, 2, 3, 4};
+  bool pushed = true;
+  UEXPECT_NO_THROW(pushed = producer.PushMany(std::move(values)));
+  EXPECT_FALSE(pushed);
+  // NOLINTNEXTLINE(bugprone-use-after-move)
+  EXPECT_EQ(values.size(), 4);
+
+  queue->SetSoftMaxSize(2);
+  values = {1, 2, 3};
+  UEXPECT_NO_THROW(pushed = producer.PushMany(std::move(values)));
+  EXPECT_FALSE(pushed);
+  // NOLINTNEXTLINE(bugprone-use-after-move)
+  EXPECT_EQ(values.size(), 3);
+  EXPECT_EQ(queue->GetSizeApproximate(), 1);
+
+  values.pop_back();
+  values.pop_back();
+  EXPECT_TRUE(producer.PushMany(std::move(values)));
+  EXPECT_EQ(queue->GetSizeApproximate(), 2);
+}
+
+TYPED_UTEST(BatchQueueTest, PopManyProducerIsDead) {
+  auto queue = TypeParam::Create();
+  auto consumer = queue->GetConsumer();
+  {
+    auto producer = queue->GetProducer();
+    EXPECT_TRUE(producer.PushMany({0, 1, 2}));
+  }
+
+  std::vector<std::size_t> values;
+  EXPECT_EQ(consumer.PopMany(values, 10), 3);
+  EXPECT_EQ(consumer.PopMany(values, 10), 0);
+  EXPECT_EQ(values.size(), 3);
+}
+
+UTEST_MT(NonFifoMpmcQueue, MpmcBatches, kProducersCount + kConsumersCount) {
+  constexpr std::size_t kBatchSize = 10;
+  auto queue = concurrent::NonFifoMpmcQueue<std::size_t>::Create(kMessageCount);
+
+  std::vector<concurrent::NonFifoMpmcQueue<std::size_t>::Producer> producers;
+  producers.reserve(kProducersCount);
+  for (std::size_t i = 0; i < kProducersCount; ++i) {
+    producers.emplace_back(queue->GetProducer());
+  }
+
+  std::vector<engine::TaskWithResult<void>> producers_tasks;
+  producers_tasks.reserve(kProducersCount);
+  for (std::size_t i = 0; i < kProducersCount; ++i) {
+    producers_tasks.push_back(
+        utils::Async("producer", [&producer = producers[i], i] {
+          std::vector<std::size_t> batch;
+          for (std::size_t message = i * kMessageCount;
+               message < (i + 1) * kMessageCount; ++message) {
+            batch.push_back(message);
+            if (batch.size() == kBatchSize) {
+              ASSERT_TRUE(producer.PushMany(std::move(batch)));
+            }
+          }
+          ASSERT_TRUE(producer.PushMany(std::move(batch)));
+        }));
+  }
+
+  std::vector<concurrent::NonFifoMpmcQueue<std::size_t>::Consumer> consumers;
+  consumers.reserve(kConsumersCount);
+  for (std::size_t i = 0; i < kConsumersCount; ++i) {
+    consumers.emplace_back(queue->GetConsumer());
+  }
+
+  std::vector<std::atomic<int>> consumed_messages(kMessageCount *
+                                                  kProducersCount);
+
+  std::vector<engine::TaskWithResult<void>> consumers_tasks;
+  consumers_tasks.reserve(kConsumersCount);
+  for (std::size_t i = 0; i < kConsumersCount; ++i) {
+    consumers_tasks.push_back(utils::Async(
+        "consumer", [&consumer = consumers[i], &consumed_messages] {
+          std::vector<std::size_t> values;
+          while (consumer.PopMany(values, kBatchSize) != 0) {
+            for (const auto value : values) ++consumed_messages[value];
+            values.clear();
+          }
+        }));
+  }
+
+  for (auto& task : producers_tasks) {
+    task.Get();
+  }
+  producers.clear();
+
+  for (auto& task : consumers_tasks) {
+    task.Get();
+  }
+
+  EXPECT_TRUE(std::all_of(consumed_messages.begin(), consumed_messages.end(),
+                          [](const auto& item) { return item == 1; }));
+}
+
 UTEST(NonFifoMpmcQueue, ConsumerIsDead) {
   auto queue = concurrent::NonFifoMpmcQueue<int>::Create();
   auto producer = queue->GetProducer();
@@ -0,0 +1,55 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <userver/concurrent/sharded_variable.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+// The current thread and state.range(0) - 1 other threads increment a counter
+template <typename Counter>
+void sharded_variable_contention(benchmark::State& state) {
+  const std::size_t threads_count = state.range(0);
+
+  engine::RunStandalone(threads_count, [&] {
+    std::atomic<bool> run{true};
+    Counter counter{std::uint64_t{0}};
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(threads_count - 1);
+    for (std::size_t i = 0; i < threads_count - 1; ++i) {
+      tasks.push_back(utils::Async("writer", [&] {
+        while (run) {
+          auto value = counter.Lock();
+          ++*value;
+        }
+      }));
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+      auto value = counter.Lock();
+      ++*value;
+    }
+
+    run = false;
+    for (auto& task : tasks) {
+      task.Get();
+    }
+  });
+}
+BENCHMARK_TEMPLATE(sharded_variable_contention,
+                   concurrent::Variable<std::uint64_t>)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+BENCHMARK_TEMPLATE(sharded_variable_contention,
+                   concurrent::ShardedVariable<std::uint64_t>)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+
+USERVER_NAMESPACE_END
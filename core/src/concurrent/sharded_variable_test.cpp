@@ -0,0 +1,83 @@
+#include <userver/concurrent/sharded_variable.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(ShardedVariable, Sample) {
+  /// [Sample concurrent::ShardedVariable usage]
+  concurrent::ShardedVariable<std::unordered_map<std::string, std::int64_t>>
+      hits;
+
+  // Hot path, the tasks of different threads update different shards
+  {
+    auto shard = hits.Lock();
+    ++(*shard)["/ping"];
+  }
+
+  // Cold path, e.g. the statistics dump
+  std::int64_t total = 0;
+  hits.VisitAll([&total](const auto& shard) {
+    for (const auto& [path, count] : shard) total += count;
+  });
+  EXPECT_EQ(total, 1);
+  /// [Sample concurrent::ShardedVariable usage]
+}
+
+UTEST(ShardedVariable, ConstructsAllShards) {
+  const concurrent::ShardedVariable<int, 4> variable{42};
+  static_assert(decltype(variable)::GetShardCount() == 4);
+
+  std::vector<int> shards;
+  variable.VisitAll([&shards](int shard) { shards.push_back(shard); });
+  EXPECT_EQ(shards, std::vector<int>(4, 42));
+}
+
+UTEST(ShardedVariable, Merge) {
+  concurrent::ShardedVariable<std::int64_t> counter{0};
+  {
+    auto value = counter.Lock();
+    *value += 5;
+  }
+
+  std::int64_t merged = 0;
+  counter.VisitAll([&merged](std::int64_t& shard) {
+    merged += std::exchange(shard, 0);
+  });
+  EXPECT_EQ(merged, 5);
+
+  counter.VisitAll([](std::int64_t shard) { EXPECT_EQ(shard, 0); });
+}
+
+UTEST_MT(ShardedVariable, ConcurrentUpdates, 4) {
+  constexpr std::int64_t kTasks = 8;
+  constexpr std::int64_t kIterations = 1000;
+  concurrent::ShardedVariable<std::int64_t, 4> counter{0};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasks);
+  for (std::int64_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(utils::Async("updater", [&counter] {
+      for (std::int64_t j = 0; j < kIterations; ++j) {
+        auto value = counter.Lock();
+        ++*value;
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  std::int64_t total = 0;
+  counter.VisitAll([&total](std::int64_t shard) { total += shard; });
+  EXPECT_EQ(total, kTasks * kIterations);
+}
+
+USERVER_NAMESPACE_END
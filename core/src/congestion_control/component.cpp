@@ -54,6 +54,15 @@ void FormatStats(const Controller& c, size_t activated_factor,
   writer["time-from-last-overloaded-under-pressure-secs"] =
       std::chrono::duration_cast<std::chrono::seconds>(diff).count();
   writer["current-state"] = stats.current_state;
+  writer["shed-level"] = stats.shed_level;
+}
+
+Controller::Algorithm ParseAlgorithm(const yaml_config::YamlConfig& value) {
+  const auto name = value.As<std::string>("linear");
+  if (name == "linear") return Controller::Algorithm::kLinear;
+  if (name == "gradient") return Controller::Algorithm::kGradient;
+  throw std::runtime_error("can't parse congestion controller from '" + name +
+                           "' at " + value.GetPath());
 }
 
 }  // namespace
@@ -75,11 +84,12 @@ struct Component::Impl {
   std::atomic<size_t> last_activate_factor{1};
 
   Impl(dynamic_config::Source dynamic_config, server::Server& server,
-       engine::TaskProcessor& tp, bool fake_mode)
+       engine::TaskProcessor& tp, bool fake_mode,
+       Controller::Algorithm algorithm)
       : dynamic_config(dynamic_config),
         server(server),
         server_sensor(server, tp),
-        server_controller(kServerControllerName, dynamic_config),
+        server_controller(kServerControllerName, dynamic_config, algorithm),
         fake_mode(fake_mode) {
     server_limiter.RegisterLimitee(server);
   }
@@ -91,7 +101,8 @@ Component::Component(const components::ComponentConfig& config,
       pimpl_(context.FindComponent<components::DynamicConfig>().GetSource(),
              context.FindComponent<components::Server>().GetServer(),
              engine::current_task::GetTaskProcessor(),
-             config["fake-mode"].As<bool>(false)) {
+             config["fake-mode"].As<bool>(false),
+             ParseAlgorithm(config["controller"])) {
   auto min_threads = config["min-cpu"].As<size_t>(1);
   auto only_rtc = config["only-rtc"].As<bool>(true);
 
@@ -197,6 +208,13 @@ properties:
         type: integer
         description: HTTP status code for ratelimited responses
         defaultDescription: 429
+    controller:
+        type: string
+        description: the algorithm of the RPS limit, 'linear' by the counts of the overloaded tasks or 'gradient' by the queue wait time and the CPU usage with the shedding of the request priority classes
+        defaultDescription: linear
+        enum:
+          - linear
+          - gradient
 )");
 }
 
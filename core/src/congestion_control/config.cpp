@@ -1,5 +1,7 @@
 #include <userver/congestion_control/config.hpp>
 
+#include <cstdint>
+
 #include <userver/dynamic_config/value.hpp>
 #include <userver/formats/json/value.hpp>
 
@@ -48,6 +50,37 @@ Policy Parse(const formats::json::Value& policy, formats::parse::To<Policy>) {
   return p;
 }
 
+GradientPolicy Parse(const formats::json::Value& policy,
+                     formats::parse::To<GradientPolicy>) {
+  GradientPolicy p;
+  p.min_limit = ParseNonNegative<int>(policy["min-limit"]);
+  p.min_queue_wait = std::chrono::microseconds{
+      ParseNonNegative<std::int64_t>(policy["min-queue-wait-us"])};
+  p.queue_wait_tolerance = policy["queue-wait-tolerance"].As<double>();
+  if (p.queue_wait_tolerance < 1) {
+    throw std::runtime_error(fmt::format(
+        "Validation 1 <= x failed for '{}' (got: {})",
+        policy["queue-wait-tolerance"].GetPath(), p.queue_wait_tolerance));
+  }
+  p.cpu_limit_percent = ParsePercent<double>(policy["cpu-limit-percent"]);
+  if (!policy["memory-pressure-percent"].IsMissing()) {
+    p.memory_pressure_percent =
+        ParsePercent<double>(policy["memory-pressure-percent"]);
+  }
+  p.smoothing_percent = ParsePercent<double>(policy["smoothing-percent"]);
+  p.min_gradient_percent =
+      ParsePercent<double>(policy["min-gradient-percent"]);
+  p.shed_gradient_percent =
+      ParsePercent<double>(policy["shed-gradient-percent"]);
+  p.shed_on_seconds = ParseNonNegative<int>(policy["shed-on-seconds"]);
+  p.shed_off_seconds = ParseNonNegative<int>(policy["shed-off-seconds"]);
+  if (!policy["memory-shed-percent"].IsMissing()) {
+    p.memory_shed_percent = ParsePercent<double>(policy["memory-shed-percent"]);
+  }
+  p.no_limit_seconds = ParseNonNegative<int>(policy["no-limit-seconds"]);
+  return p;
+}
+
 namespace impl {
 namespace {
 
@@ -55,7 +88,8 @@ RpsCcConfig ParseRpsCcConfig(const dynamic_config::DocsMap& docs_map) {
   return {
       docs_map.Get("USERVER_RPS_CCONTROL").As<Policy>(),
       docs_map.Get("USERVER_RPS_CCONTROL_ENABLED").As<bool>(),
-      docs_map.Get("USERVER_RPS_CCONTROL_ACTIVATED_FACTOR_METRIC").As<int>()};
+      docs_map.Get("USERVER_RPS_CCONTROL_ACTIVATED_FACTOR_METRIC").As<int>(),
+      docs_map.Get("USERVER_RPS_CCONTROL_GRADIENT").As<GradientPolicy>()};
 }
 
 constexpr dynamic_config::DefaultAsJsonString kRpsControlDefaults{R"(
@@ -71,6 +105,23 @@ constexpr dynamic_config::DefaultAsJsonString kRpsControlDefaults{R"(
 }
 )"};
 
+constexpr dynamic_config::DefaultAsJsonString kGradientControlDefaults{R"(
+{
+  "min-limit": 10,
+  "min-queue-wait-us": 1000,
+  "queue-wait-tolerance": 2,
+  "cpu-limit-percent": 90,
+  "memory-pressure-percent": 20,
+  "smoothing-percent": 20,
+  "min-gradient-percent": 50,
+  "shed-gradient-percent": 70,
+  "shed-on-seconds": 5,
+  "shed-off-seconds": 10,
+  "memory-shed-percent": 10,
+  "no-limit-seconds": 60
+}
+)"};
+
 }  // namespace
 
 const dynamic_config::Key<RpsCcConfig> kRpsCcConfig{
@@ -79,6 +130,7 @@ const dynamic_config::Key<RpsCcConfig> kRpsCcConfig{
         {"USERVER_RPS_CCONTROL", kRpsControlDefaults},
         {"USERVER_RPS_CCONTROL_ENABLED", false},
         {"USERVER_RPS_CCONTROL_ACTIVATED_FACTOR_METRIC", 5},
+        {"USERVER_RPS_CCONTROL_GRADIENT", kGradientControlDefaults},
     },
 };
 
@@ -38,4 +38,41 @@ TEST(CongestionControlConfig, Parsing) {
   EXPECT_DOUBLE_EQ(policy.start_limit_factor, 13.5);
 }
 
+TEST(CongestionControlConfig, GradientParsing) {
+  constexpr std::string_view kPolicyJson = R"(
+    {
+      "min-limit": 1,
+      "min-queue-wait-us": 2000,
+      "queue-wait-tolerance": 1.5,
+      "cpu-limit-percent": 80,
+      "memory-pressure-percent": 15,
+      "smoothing-percent": 30,
+      "min-gradient-percent": 40,
+      "shed-gradient-percent": 60,
+      "shed-on-seconds": 3,
+      "shed-off-seconds": 4,
+      "memory-shed-percent": 5,
+      "no-limit-seconds": 5
+    }
+  )";
+  const auto policy = formats::json::FromString(kPolicyJson)
+                          .As<congestion_control::GradientPolicy>();
+
+  EXPECT_EQ(policy.min_limit, 1);
+  EXPECT_EQ(policy.min_queue_wait, std::chrono::microseconds{2000});
+  EXPECT_DOUBLE_EQ(policy.queue_wait_tolerance, 1.5);
+  EXPECT_DOUBLE_EQ(policy.cpu_limit_percent, 80);
+  EXPECT_DOUBLE_EQ(policy.memory_pressure_percent, 15);
+  EXPECT_DOUBLE_EQ(policy.smoothing_percent, 30);
+  EXPECT_DOUBLE_EQ(policy.min_gradient_percent, 40);
+  EXPECT_DOUBLE_EQ(policy.shed_gradient_percent, 60);
+  EXPECT_EQ(policy.shed_on_seconds, 3);
+  EXPECT_EQ(policy.shed_off_seconds, 4);
+  EXPECT_DOUBLE_EQ(policy.memory_shed_percent, 5);
+  EXPECT_EQ(policy.no_limit_seconds, 5);
+
+  EXPECT_ANY_THROW(formats::json::FromString(R"({"queue-wait-tolerance": 0.5})")
+                       .As<congestion_control::GradientPolicy>());
+}
+
 USERVER_NAMESPACE_END
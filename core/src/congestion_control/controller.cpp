@@ -1,5 +1,8 @@
 #include <userver/congestion_control/controller.hpp>
 
+#include <algorithm>
+#include <cmath>
+
 #include <fmt/format.h>
 
 #include <userver/logging/log.hpp>
@@ -10,8 +13,17 @@ USERVER_NAMESPACE_BEGIN
 
 namespace congestion_control {
 
-Controller::Controller(std::string name, dynamic_config::Source config_source)
+namespace {
+
+// The queue wait baseline follows the not overloaded timings slowly
+constexpr double kBaselineSmoothing = 0.05;
+
+}  // namespace
+
+Controller::Controller(std::string name, dynamic_config::Source config_source,
+                       Algorithm algorithm)
     : name_(std::move(name)),
+      algorithm_(algorithm),
       config_source_(config_source),
       is_enabled_(true) {}
 
@@ -86,8 +98,18 @@ size_t Controller::CalcNewLimit(const Sensor::Data& data,
 
 void Controller::Feed(const Sensor::Data& data) {
   const auto config = config_source_.GetSnapshot();
-  const auto& policy = config[impl::kRpsCcConfig].policy;
+  const auto& cc_config = config[impl::kRpsCcConfig];
+  switch (algorithm_) {
+    case Algorithm::kLinear:
+      FeedLinear(data, cc_config.policy);
+      break;
+    case Algorithm::kGradient:
+      FeedGradient(data, cc_config.gradient_policy);
+      break;
+  }
+}
 
+void Controller::FeedLinear(const Sensor::Data& data, const Policy& policy) {
   const auto is_overloaded_pressure = IsOverloadedNow(data, policy);
   const auto old_overloaded = state_.is_overloaded;
 
@@ -192,6 +214,163 @@ void Controller::Feed(const Sensor::Data& data) {
   limit_.current_load = data.current_load;
 }
 
+void Controller::FeedGradient(const Sensor::Data& data,
+                              const GradientPolicy& policy) {
+  auto& state = gradient_state_;
+  const auto queue_wait_us = static_cast<double>(data.queue_wait.count());
+  const auto baseline_us =
+      std::max(state.queue_wait_baseline_us,
+               static_cast<double>(policy.min_queue_wait.count()));
+
+  // As in TCP Vegas, the queueing delay over the no-load baseline means that
+  // the load is above the capacity, the limit shrinks proportionally
+  double gradient = 1;
+  const auto tolerated_us = baseline_us * policy.queue_wait_tolerance;
+  if (queue_wait_us > tolerated_us) gradient = tolerated_us / queue_wait_us;
+  const auto cpu_usage_percent = data.cpu_usage * 100;
+  if (policy.cpu_limit_percent > 0 &&
+      cpu_usage_percent > policy.cpu_limit_percent) {
+    gradient = std::min(gradient, policy.cpu_limit_percent / cpu_usage_percent);
+  }
+  const auto memory_pressure_percent = data.memory_pressure * 100;
+  if (policy.memory_pressure_percent > 0 &&
+      memory_pressure_percent > policy.memory_pressure_percent) {
+    gradient = std::min(gradient, policy.memory_pressure_percent /
+                                      memory_pressure_percent);
+  }
+  gradient = std::max(gradient, policy.min_gradient_percent / 100);
+  state.gradient = gradient;
+
+  const auto old_limited = state_.current_limit.has_value();
+  if (gradient < 1) {
+    state.times_wo_overload = 0;
+
+    // Use current_limit instead of sensor's current load as the limiter
+    // might fail to immediately affect sensor's levels
+    const auto current_load = state_.current_limit.value_or(data.current_load);
+    const auto smoothing = policy.smoothing_percent / 100;
+    auto new_limit = static_cast<std::size_t>(
+        std::lround(current_load * (1 - smoothing * (1 - gradient))));
+    if (current_load > 0) new_limit = std::min(new_limit, current_load - 1);
+    state_.current_limit = std::max(new_limit, policy.min_limit);
+
+    stats_.overload_pressure++;
+    stats_.last_overload_pressure =
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch());
+    stats_.current_state = 4;
+  } else {
+    state.times_wo_overload++;
+    // The baseline is sticky to the "good" timings
+    state.queue_wait_baseline_us +=
+        (queue_wait_us - state.queue_wait_baseline_us) * kBaselineSmoothing;
+
+    if (state_.current_limit &&
+        state.times_wo_overload > policy.no_limit_seconds) {
+      state_.current_limit.reset();
+    }
+    if (state_.current_limit) {
+      // Additive increase by the Vegas queue size estimate
+      const auto current_load = *state_.current_limit;
+      state_.current_limit =
+          current_load + std::max<std::size_t>(
+                             1, std::lround(std::sqrt(current_load)));
+
+      stats_.not_overload_no_pressure++;
+      stats_.current_state = 1;
+    } else {
+      stats_.no_limit++;
+      stats_.current_state = 0;
+    }
+  }
+  UpdateShedLevel(data, policy);
+
+  auto log_level = gradient < 1
+                       ? logging::Level::kError
+                       : (state_.current_limit ? logging::Level::kWarning
+                                               : logging::Level::kInfo);
+  std::string log_suffix;
+  if (!is_enabled_) {
+    log_level = logging::Level::kInfo;
+    log_suffix = " (running in fake mode, RPS limit is not forced)";
+  }
+
+  if (old_limited != state_.current_limit.has_value()) {
+    LOG(log_level) << "congestion_control '" << name_ << "' is "
+                   << (old_limited ? "deactivated" : "activated");
+  }
+  if (log_level > logging::Level::kInfo) {
+    LOG(log_level) << "congestion control '" << name_
+                   << "' state: input load=" << data.current_load
+                   << " queue_wait_us=" << data.queue_wait.count()
+                   << fmt::format(" cpu_usage={:.2f}%", cpu_usage_percent)
+                   << fmt::format(" memory_pressure={:.2f}%",
+                                  memory_pressure_percent)
+                   << " baseline_us=" << baseline_us
+                   << fmt::format(" => gradient={:.3f}", gradient)
+                   << " current_limit=" << state_.current_limit
+                   << " shed_level=" << state.shed_level << log_suffix;
+  }
+
+  limit_.load_limit = state_.current_limit;
+  limit_.current_load = data.current_load;
+  limit_.shed_level = state.shed_level;
+  stats_.shed_level = state.shed_level;
+}
+
+void Controller::UpdateShedLevel(const Sensor::Data& data,
+                                 const GradientPolicy& policy) {
+  auto& state = gradient_state_;
+  if (policy.memory_shed_percent > 0 &&
+      data.memory_full_pressure * 100 > policy.memory_shed_percent) {
+    // The OOM killer is close, there is no time to wait for the limit
+    state.times_under_shed_gradient = 0;
+    state.times_wo_shed_pressure = 0;
+    if (state.shed_level < kMaxShedLevel) {
+      ++state.shed_level;
+      LOG_ERROR() << "congestion_control '" << name_
+                  << "' sheds the lowest request priority classes on the "
+                     "memory pressure, shed_level="
+                  << state.shed_level;
+    }
+    return;
+  }
+
+  if (!state_.current_limit) {
+    state.shed_level = 0;
+    state.times_under_shed_gradient = 0;
+    state.times_wo_shed_pressure = 0;
+    return;
+  }
+
+  if (state.gradient * 100 <= policy.shed_gradient_percent) {
+    state.times_wo_shed_pressure = 0;
+    // The RPS limit does not keep up, the lowest class is rejected entirely
+    if (++state.times_under_shed_gradient >= policy.shed_on_seconds &&
+        state.shed_level < kMaxShedLevel) {
+      state.times_under_shed_gradient = 0;
+      ++state.shed_level;
+      LOG_ERROR() << "congestion_control '" << name_
+                  << "' sheds the lowest request priority classes, "
+                     "shed_level="
+                  << state.shed_level;
+    }
+    return;
+  }
+
+  state.times_under_shed_gradient = 0;
+  if (state.gradient < 1) {
+    state.times_wo_shed_pressure = 0;
+  } else if (state.shed_level > 0 &&
+             ++state.times_wo_shed_pressure >= policy.shed_off_seconds) {
+    state.times_wo_shed_pressure = 0;
+    --state.shed_level;
+    LOG_WARNING() << "congestion_control '" << name_
+                  << "' lowers the shed level, shed_level="
+                  << state.shed_level;
+  }
+}
+
 Limit Controller::GetLimit() const {
   if (is_enabled_.load())
     return GetLimitRaw();
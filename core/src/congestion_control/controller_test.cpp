@@ -0,0 +1,140 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/congestion_control/controller.hpp>
+#include <userver/dynamic_config/test_helpers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Controller = congestion_control::Controller;
+
+congestion_control::Sensor::Data MakeData(std::size_t load,
+                                          std::chrono::microseconds queue_wait,
+                                          double cpu_usage = 0.5) {
+  congestion_control::Sensor::Data data;
+  data.current_load = load;
+  data.queue_wait = queue_wait;
+  data.cpu_usage = cpu_usage;
+  return data;
+}
+
+Controller MakeGradientController() {
+  return Controller{"test", dynamic_config::GetDefaultSource(),
+                    Controller::Algorithm::kGradient};
+}
+
+}  // namespace
+
+TEST(CCGradient, NoOverload) {
+  auto controller = MakeGradientController();
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    controller.Feed(MakeData(1000, std::chrono::microseconds{500}));
+    const auto limit = controller.GetLimit();
+    EXPECT_EQ(limit.load_limit, std::nullopt) << i;
+    EXPECT_EQ(limit.shed_level, 0) << i;
+  }
+}
+
+TEST(CCGradient, QueueWaitShrinksLimit) {
+  auto controller = MakeGradientController();
+
+  // The queue wait is twice the tolerated 2ms
+  controller.Feed(MakeData(1000, std::chrono::microseconds{4000}));
+  auto limit = controller.GetLimit();
+  ASSERT_TRUE(limit.load_limit);
+  EXPECT_LT(*limit.load_limit, 1000);
+  EXPECT_GT(*limit.load_limit, 500);
+
+  auto previous = *limit.load_limit;
+  for (std::size_t i = 0; i < 4; ++i) {
+    controller.Feed(MakeData(1000, std::chrono::microseconds{4000}));
+    limit = controller.GetLimit();
+    ASSERT_TRUE(limit.load_limit);
+    EXPECT_LT(*limit.load_limit, previous);
+    previous = *limit.load_limit;
+  }
+  // The gradient of 0.5 is below the shedding threshold for 5 seconds
+  EXPECT_EQ(limit.shed_level, 1);
+
+  for (std::size_t i = 0; i < 50; ++i) {
+    controller.Feed(MakeData(1000, std::chrono::microseconds{4000}));
+  }
+  EXPECT_EQ(controller.GetLimit().shed_level, Controller::kMaxShedLevel);
+  // min-limit
+  EXPECT_EQ(controller.GetLimit().load_limit, 10);
+}
+
+TEST(CCGradient, Recovery) {
+  auto controller = MakeGradientController();
+  for (std::size_t i = 0; i < 5; ++i) {
+    controller.Feed(MakeData(1000, std::chrono::microseconds{4000}));
+  }
+  auto limit = controller.GetLimit();
+  ASSERT_TRUE(limit.load_limit);
+  ASSERT_EQ(limit.shed_level, 1);
+
+  auto previous = *limit.load_limit;
+  for (std::size_t i = 0; i < 10; ++i) {
+    controller.Feed(MakeData(1000, std::chrono::microseconds{500}));
+    limit = controller.GetLimit();
+    ASSERT_TRUE(limit.load_limit);
+    EXPECT_GT(*limit.load_limit, previous);
+    previous = *limit.load_limit;
+  }
+  EXPECT_EQ(limit.shed_level, 0);
+
+  // no-limit-seconds
+  for (std::size_t i = 0; i < 51; ++i) {
+    controller.Feed(MakeData(1000, std::chrono::microseconds{500}));
+  }
+  EXPECT_EQ(controller.GetLimit().load_limit, std::nullopt);
+}
+
+TEST(CCGradient, CpuUsage) {
+  auto controller = MakeGradientController();
+
+  controller.Feed(MakeData(1000, std::chrono::microseconds{500}, 0.85));
+  EXPECT_EQ(controller.GetLimit().load_limit, std::nullopt);
+
+  controller.Feed(MakeData(1000, std::chrono::microseconds{500}, 1.0));
+  const auto limit = controller.GetLimit();
+  ASSERT_TRUE(limit.load_limit);
+  EXPECT_LT(*limit.load_limit, 1000);
+  EXPECT_EQ(limit.shed_level, 0);
+}
+
+TEST(CCGradient, MemoryPressure) {
+  auto controller = MakeGradientController();
+
+  auto data = MakeData(1000, std::chrono::microseconds{500});
+  data.memory_pressure = 0.1;
+  controller.Feed(data);
+  EXPECT_EQ(controller.GetLimit().load_limit, std::nullopt);
+
+  data.memory_pressure = 0.4;
+  controller.Feed(data);
+  auto limit = controller.GetLimit();
+  ASSERT_TRUE(limit.load_limit);
+  EXPECT_LT(*limit.load_limit, 1000);
+  EXPECT_EQ(limit.shed_level, 0);
+
+  // Classes are shed right away when close to the OOM
+  data.memory_full_pressure = 0.3;
+  controller.Feed(data);
+  EXPECT_EQ(controller.GetLimit().shed_level, 1);
+  controller.Feed(data);
+  EXPECT_EQ(controller.GetLimit().shed_level, 2);
+}
+
+TEST(CCGradient, Disabled) {
+  auto controller = MakeGradientController();
+  controller.SetEnabled(false);
+
+  controller.Feed(MakeData(1000, std::chrono::microseconds{4000}));
+  EXPECT_EQ(controller.GetLimit().load_limit, std::nullopt);
+  EXPECT_TRUE(controller.GetLimitRaw().load_limit);
+}
+
+USERVER_NAMESPACE_END
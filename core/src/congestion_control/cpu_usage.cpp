@@ -0,0 +1,113 @@
+#include <congestion_control/cpu_usage.hpp>
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+#include <userver/hostinfo/cpu_limit.hpp>
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control::impl {
+
+namespace {
+
+constexpr std::string_view kCgroupV2CpuStat = "/sys/fs/cgroup/cpu.stat";
+constexpr std::string_view kCgroupV2CpuMax = "/sys/fs/cgroup/cpu.max";
+constexpr std::string_view kCgroupV1CpuUsage =
+    "/sys/fs/cgroup/cpuacct/cpuacct.usage";
+
+bool IsReadable(std::string_view path) {
+  return std::ifstream{std::string{path}}.good();
+}
+
+// "max 100000" means no limit
+std::optional<double> ReadCgroupV2CpuLimit() {
+  std::ifstream file{std::string{kCgroupV2CpuMax}};
+  std::string quota;
+  double period = 0;
+  if (!(file >> quota >> period) || quota == "max" || period <= 0) {
+    return std::nullopt;
+  }
+  try {
+    return std::stod(quota) / period;
+  } catch (const std::exception&) {
+    return std::nullopt;
+  }
+}
+
+std::chrono::microseconds ToMicroseconds(const timeval& value) {
+  return std::chrono::seconds{value.tv_sec} +
+         std::chrono::microseconds{value.tv_usec};
+}
+
+}  // namespace
+
+CpuUsage::CpuUsage() {
+  if (IsReadable(kCgroupV2CpuStat)) {
+    source_ = Source::kCgroupV2;
+    path_ = kCgroupV2CpuStat;
+  } else if (IsReadable(kCgroupV1CpuUsage)) {
+    source_ = Source::kCgroupV1;
+    path_ = kCgroupV1CpuUsage;
+  }
+
+  auto cpu_limit = hostinfo::CpuLimit();
+  if (!cpu_limit && source_ == Source::kCgroupV2) {
+    cpu_limit = ReadCgroupV2CpuLimit();
+  }
+  cpu_limit_ = std::max(
+      cpu_limit.value_or(std::thread::hardware_concurrency()), 0.01);
+
+  LOG_INFO() << "Congestion control reads the CPU usage from "
+             << (path_.empty() ? "getrusage()" : path_)
+             << ", cpu_limit=" << cpu_limit_;
+}
+
+double CpuUsage::Fetch(std::chrono::steady_clock::time_point now) {
+  const auto cpu_time = ReadCpuTime();
+  const auto last_cpu_time = std::exchange(last_cpu_time_, cpu_time);
+  const auto last_fetch_tp = std::exchange(last_fetch_tp_, now);
+  if (!cpu_time || !last_cpu_time || now <= last_fetch_tp) return 0;
+
+  const auto used = std::chrono::duration<double>(*cpu_time - *last_cpu_time);
+  const auto passed = std::chrono::duration<double>(now - last_fetch_tp);
+  return std::max(used / passed, 0.0) / cpu_limit_;
+}
+
+std::optional<std::chrono::microseconds> CpuUsage::ReadCpuTime() const {
+  switch (source_) {
+    case Source::kCgroupV2: {
+      std::ifstream file{path_};
+      std::string key;
+      std::int64_t value = 0;
+      while (file >> key >> value) {
+        if (key == "usage_usec") return std::chrono::microseconds{value};
+      }
+      return std::nullopt;
+    }
+    case Source::kCgroupV1: {
+      std::ifstream file{path_};
+      std::int64_t value_ns = 0;
+      if (!(file >> value_ns)) return std::nullopt;
+      return std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::nanoseconds{value_ns});
+    }
+    case Source::kProcess: {
+      rusage usage{};
+      if (::getrusage(RUSAGE_SELF, &usage) != 0) return std::nullopt;
+      return ToMicroseconds(usage.ru_utime) + ToMicroseconds(usage.ru_stime);
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace congestion_control::impl
+
+USERVER_NAMESPACE_END
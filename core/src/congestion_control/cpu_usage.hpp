@@ -0,0 +1,43 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace congestion_control::impl {
+
+/// @brief CPU utilization of the current container
+///
+/// Reads the CPU time of the cgroup (v2 `cpu.stat`, v1 `cpuacct.usage`),
+/// falls back to the CPU time of the current process if cgroups are not
+/// available. The CPU limit is taken from hostinfo::CpuLimit(), cgroup v2
+/// `cpu.max` or the number of the hardware threads.
+///
+/// @note Uses blocking file reads
+class CpuUsage final {
+ public:
+  CpuUsage();
+
+  /// @returns the CPU time used since the previous call in fraction of the
+  /// CPU limit, 0 on the first call
+  double Fetch(std::chrono::steady_clock::time_point now);
+
+  double GetCpuLimit() const noexcept { return cpu_limit_; }
+
+ private:
+  enum class Source { kCgroupV2, kCgroupV1, kProcess };
+
+  std::optional<std::chrono::microseconds> ReadCpuTime() const;
+
+  Source source_{Source::kProcess};
+  std::string path_;
+  double cpu_limit_{1};
+  std::optional<std::chrono::microseconds> last_cpu_time_;
+  std::chrono::steady_clock::time_point last_fetch_tp_;
+};
+
+}  // namespace congestion_control::impl
+
+USERVER_NAMESPACE_END
@@ -9,6 +9,7 @@
 #include <sys/socket.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <utility>
 
 #include <curl-ev/easy.hpp>
@@ -165,6 +166,37 @@ void easy::async_perform(handler_type handler) {
   LOG_TRACE() << "easy::async_perform finished " << this;
 }
 
+void perform_batch::add(easy& handle, easy::handler_type handler) {
+  if (!handle.multi_) throw std::runtime_error("no multi!");
+  items_.push_back(
+      {handle.shared_from_this(), std::move(handler), ++handle.request_counter_});
+}
+
+void perform_batch::async_perform() {
+  // There are as many multis as the IO threads, linear search is fine
+  std::vector<std::pair<multi*, std::vector<item>>> groups;
+  for (auto& it : items_) {
+    auto* multi = it.handle->multi_;
+    auto group = std::find_if(groups.begin(), groups.end(),
+                              [multi](const auto& g) { return g.first == multi; });
+    if (group == groups.end()) {
+      group = groups.insert(groups.end(), {multi, {}});
+    }
+    group->second.push_back(std::move(it));
+  }
+  items_.clear();
+
+  for (auto& [multi, items] : groups) {
+    multi->GetThreadControl().RunInEvLoopDeferred(
+        [items = std::move(items)]() mutable {
+          for (auto& it : items) {
+            it.handle->do_ev_async_perform(std::move(it.handler),
+                                           it.request_num);
+          }
+        });
+  }
+}
+
 void easy::do_ev_async_perform(handler_type handler, size_t request_num) {
   if (request_num <= cancelled_request_max_) {
     LOG_DEBUG() << "already cancelled";
@@ -239,6 +271,7 @@ void easy::reset() {
   if (proxy_headers_) proxy_headers_->clear();
   if (http200_aliases_) http200_aliases_->clear();
   if (resolved_hosts_) resolved_hosts_->clear();
+  if (connect_to_) connect_to_->clear();
   share_.reset();
   retries_count_ = 0;
   sockets_opened_ = 0;
@@ -414,11 +447,46 @@ void easy::add_header(std::string_view name, std::string_view value,
              duplicate_header_action);
 }
 
+void easy::add_serialized_header(
+    std::string_view name, std::string_view header,
+    DuplicateHeaderAction duplicate_header_action) {
+  if (AddHeaderDoSkip(headers_, name, duplicate_header_action)) {
+    return;
+  }
+
+  if (duplicate_header_action == DuplicateHeaderAction::kReplace && headers_ &&
+      headers_->ReplaceFirstIf(
+          [name](std::string_view existing) {
+            return IsHeaderMatchingName(existing, name);
+          },
+          header)) {
+    return;
+  }
+
+  if (!headers_) {
+    headers_ = std::make_shared<string_list>();
+  }
+  headers_->add(header);
+  throw_error(
+      std::error_code{static_cast<errc::EasyErrorCode>(native::curl_easy_setopt(
+          handle_, native::CURLOPT_HTTPHEADER, headers_->native_handle()))},
+      "add_serialized_header");
+}
+
 std::optional<std::string_view> easy::FindHeaderByName(
     std::string_view name) const {
   return FindHeaderByNameImpl(headers_, name);
 }
 
+void easy::ForEachHeader(
+    utils::function_ref<void(std::string_view)> func) const {
+  if (!headers_) return;
+  headers_->FindIf([&func](std::string_view header) {
+    func(header);
+    return false;
+  });
+}
+
 void easy::add_header(const char* header) {
   std::error_code ec;
   add_header(header, ec);
@@ -574,6 +642,30 @@ void easy::add_resolve(const std::string& host, const std::string& port,
           handle_, native::CURLOPT_RESOLVE, resolved_hosts_->native_handle()))};
 }
 
+void easy::set_connect_to_address(const std::string& host,
+                                  const std::string& port,
+                                  const std::string& addr) {
+  std::error_code ec;
+  set_connect_to_address(host, port, addr, ec);
+  throw_error(ec, "set_connect_to_address");
+}
+
+void easy::set_connect_to_address(const std::string& host,
+                                  const std::string& port,
+                                  const std::string& addr,
+                                  std::error_code& ec) {
+  if (!connect_to_) {
+    connect_to_ = std::make_shared<string_list>();
+  } else {
+    connect_to_->clear();
+  }
+  connect_to_->add(utils::StrCat(host, ":", port, ":", addr, ":", port));
+
+  ec =
+      std::error_code{static_cast<errc::EasyErrorCode>(native::curl_easy_setopt(
+          handle_, native::CURLOPT_CONNECT_TO, connect_to_->native_handle()))};
+}
+
 void easy::set_resolves(std::shared_ptr<string_list> resolved_hosts) {
   std::error_code ec;
   set_resolves(std::move(resolved_hosts), ec);
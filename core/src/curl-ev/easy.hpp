@@ -23,6 +23,7 @@
 #include <curl-ev/url.hpp>
 
 #include <userver/clients/http/local_stats.hpp>
+#include <userver/utils/function_ref.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -193,6 +194,8 @@ class multi;
 class share;
 class string_list;
 
+class perform_batch;
+
 class easy final : public std::enable_shared_from_this<easy> {
  public:
   using handler_type = std::function<void(std::error_code err)>;
@@ -362,6 +365,7 @@ class easy final : public std::enable_shared_from_this<easy> {
   IMPLEMENT_CURL_OPTION(set_tcp_keep_idle, native::CURLOPT_TCP_KEEPIDLE, long);
   IMPLEMENT_CURL_OPTION(set_tcp_keep_intvl, native::CURLOPT_TCP_KEEPINTVL,
                         long);
+  IMPLEMENT_CURL_OPTION_BOOLEAN(set_pipewait, native::CURLOPT_PIPEWAIT);
   IMPLEMENT_CURL_OPTION_STRING(set_unix_socket_path,
                                native::CURLOPT_UNIX_SOCKET_PATH);
   IMPLEMENT_CURL_OPTION(set_connect_to, native::CURLOPT_CONNECT_TO,
@@ -465,6 +469,9 @@ class easy final : public std::enable_shared_from_this<easy> {
   void add_header(std::string_view name, std::string_view value,
                   std::error_code& ec,
                   DuplicateHeaderAction duplicate_header_action);
+  // Adds the header pre-serialized in the CURLOPT_HTTPHEADER format
+  void add_serialized_header(std::string_view name, std::string_view header,
+                             DuplicateHeaderAction duplicate_header_action);
   void add_header(const char* header);
   void add_header(const char* header, std::error_code& ec);
   void add_header(const std::string& header);
@@ -472,6 +479,8 @@ class easy final : public std::enable_shared_from_this<easy> {
   void set_headers(std::shared_ptr<string_list> headers);
   void set_headers(std::shared_ptr<string_list> headers, std::error_code& ec);
   std::optional<std::string_view> FindHeaderByName(std::string_view name) const;
+  // Calls `func` for each added header in the CURLOPT_HTTPHEADER format
+  void ForEachHeader(utils::function_ref<void(std::string_view)> func) const;
   void add_proxy_header(
       std::string_view name, std::string_view value,
       EmptyHeaderAction empty_header_action = EmptyHeaderAction::kSend,
@@ -585,6 +594,11 @@ class easy final : public std::enable_shared_from_this<easy> {
                    const std::string& addr);
   void add_resolve(const std::string& host, const std::string& port,
                    const std::string& addr, std::error_code& ec);
+  // Replaces the list set by set_connect_to()
+  void set_connect_to_address(const std::string& host, const std::string& port,
+                              const std::string& addr);
+  void set_connect_to_address(const std::string& host, const std::string& port,
+                              const std::string& addr, std::error_code& ec);
   void set_resolves(std::shared_ptr<string_list> resolved_hosts);
   void set_resolves(std::shared_ptr<string_list> resolved_hosts,
                     std::error_code& ec);
@@ -820,6 +834,8 @@ class easy final : public std::enable_shared_from_this<easy> {
       struct native::curl_sockaddr* address) noexcept;
   static int closesocket(void* clientp, native::curl_socket_t item) noexcept;
 
+  friend class perform_batch;
+
   // do_ev_* methods run in libev thread
   void do_ev_async_perform(handler_type handler, size_t request_num);
   void do_ev_cancel(size_t request_num);
@@ -843,6 +859,7 @@ class easy final : public std::enable_shared_from_this<easy> {
   std::shared_ptr<string_list> proxy_headers_;
   std::shared_ptr<string_list> http200_aliases_;
   std::shared_ptr<string_list> resolved_hosts_;
+  std::shared_ptr<string_list> connect_to_;
   std::shared_ptr<share> share_;
   progress_callback_t progress_callback_;
   std::size_t retries_count_{0};
@@ -852,6 +869,25 @@ class easy final : public std::enable_shared_from_this<easy> {
   time_point start_performing_ts_{};
   const time_point construct_ts_;
 };
+
+// Starts many easy handles with a single ev loop call for each of their multis
+// instead of a call per handle
+class perform_batch final {
+ public:
+  // Same as easy::async_perform(), but the handle starts at async_perform()
+  void add(easy& handle, easy::handler_type handler);
+
+  void async_perform();
+
+ private:
+  struct item {
+    std::shared_ptr<easy> handle;
+    easy::handler_type handler;
+    size_t request_num;
+  };
+
+  std::vector<item> items_;
+};
 }  // namespace curl
 
 #undef IMPLEMENT_CURL_OPTION
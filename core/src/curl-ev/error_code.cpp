@@ -153,6 +153,8 @@ class RateLimitErrorCategory final : public std::error_category {
         return "hit global opensocket rate limit";
       case RateLimitErrorCode::kPerHostSocketLimit:
         return "hit per-host opensocket rate limit";
+      case RateLimitErrorCode::kConcurrencyLimit:
+        return "hit per-destination adaptive concurrency limit";
     }
 
     return "Unknown rate-limit error";
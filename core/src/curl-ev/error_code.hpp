@@ -164,6 +164,7 @@ enum class RateLimitErrorCode {
   kSuccess,
   kGlobalSocketLimit,
   kPerHostSocketLimit,
+  kConcurrencyLimit,
 };
 
 const std::error_category& GetEasyCategory() noexcept;
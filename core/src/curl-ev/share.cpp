@@ -6,6 +6,8 @@
         C++ wrapper for libcurl's share interface
 */
 
+#include <algorithm>
+
 #include <curl-ev/error_code.hpp>
 #include <curl-ev/share.hpp>
 #include <curl-ev/wrappers.hpp>
@@ -83,15 +85,21 @@ void share::set_user_data(void* user_data) {
   throw_error(ec, __func__);
 }
 
-void share::lock(native::CURL*, native::curl_lock_data,
+void share::lock(native::CURL*, native::curl_lock_data data,
                  native::curl_lock_access, void* userptr) {
   auto* self = static_cast<share*>(userptr);
-  self->mutex_.lock();
+  self->GetMutex(data).lock();
 }
 
-void share::unlock(native::CURL*, native::curl_lock_data, void* userptr) {
+void share::unlock(native::CURL*, native::curl_lock_data data, void* userptr) {
   auto* self = static_cast<share*>(userptr);
-  self->mutex_.unlock();
+  self->GetMutex(data).unlock();
+}
+
+std::mutex& share::GetMutex(native::curl_lock_data data) {
+  const auto index = static_cast<std::size_t>(data);
+  // Unknown kinds of data from newer curl versions share the last lock
+  return mutexes_[std::min(index, mutexes_.size() - 1)];
 }
 
 }  // namespace curl
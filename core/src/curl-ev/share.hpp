@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <mutex>
 
@@ -46,8 +47,12 @@ class share final : public std::enable_shared_from_this<share> {
   static void unlock(native::CURL* handle, native::curl_lock_data data,
                      void* userptr);
 
+  std::mutex& GetMutex(native::curl_lock_data data);
+
   native::CURLSH* handle_;
-  std::mutex mutex_;
+  // Separate locks for the shared data kinds, so TLS session lookups do not
+  // wait for DNS cache updates and vice versa
+  std::array<std::mutex, native::CURL_LOCK_DATA_LAST> mutexes_;
 };
 }  // namespace curl
 
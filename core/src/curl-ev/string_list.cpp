@@ -17,14 +17,33 @@ string_list::Elem::Elem(std::string new_value) : value(std::move(new_value)) {
   list_node.next = nullptr;
 }
 
-void string_list::add(std::string str) {
+namespace {
+// A list of a rare request with lots of headers is not kept forever
+constexpr std::size_t kMaxRetainedElements = 64;
+}  // namespace
+
+void string_list::add(std::string_view str) {
   native::curl_slist* prev =
-      list_elements_.empty() ? nullptr : &list_elements_.back().list_node;
-  auto& last = list_elements_.emplace_back(std::move(str));
-  if (prev) prev->next = &last.list_node;
+      size_ == 0 ? nullptr : &list_elements_[size_ - 1].list_node;
+
+  Elem* last = nullptr;
+  if (size_ < list_elements_.size()) {
+    last = &list_elements_[size_];
+    last->value.assign(str);
+    last->list_node.data = last->value.data();
+    last->list_node.next = nullptr;
+  } else {
+    last = &list_elements_.emplace_back(std::string{str});
+  }
+  ++size_;
+
+  if (prev) prev->next = &last->list_node;
 }
 
-void string_list::clear() noexcept { list_elements_.clear(); }
+void string_list::clear() noexcept {
+  size_ = 0;
+  if (list_elements_.size() > kMaxRetainedElements) list_elements_.clear();
+}
 
 void string_list::ReplaceValue(Elem& list_elem, std::string&& new_value) {
   list_elem.value = std::move(new_value);
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <deque>
 #include <optional>
 #include <string>
@@ -28,20 +29,22 @@ class string_list {
   string_list& operator=(string_list&&) = delete;
 
   inline native::curl_slist* native_handle() {
-    return list_elements_.empty() ? nullptr : &list_elements_.front().list_node;
+    return size_ == 0 ? nullptr : &list_elements_.front().list_node;
   }
 
   inline const native::curl_slist* native_handle() const {
-    return list_elements_.empty() ? nullptr : &list_elements_.front().list_node;
+    return size_ == 0 ? nullptr : &list_elements_.front().list_node;
   }
 
-  void add(std::string str);
+  /// Reuses the storage of the elements removed by clear(), so a list of the
+  /// same shape is refilled without allocations
+  void add(std::string_view str);
   void clear() noexcept;
 
   template <typename Pred>
   std::optional<std::string_view> FindIf(const Pred& pred) const {
-    for (const auto& list_elem : list_elements_) {
-      const auto& value = list_elem.value;
+    for (std::size_t i = 0; i < size_; ++i) {
+      const auto& value = list_elements_[i].value;
       if (pred(value)) return value;
     }
     return std::nullopt;
@@ -49,9 +52,9 @@ class string_list {
 
   template <typename Pred>
   bool ReplaceFirstIf(const Pred& pred, std::string&& new_value) {
-    for (auto& list_elem : list_elements_) {
-      const auto& value = list_elem.value;
-      if (pred(value)) {
+    for (std::size_t i = 0; i < size_; ++i) {
+      auto& list_elem = list_elements_[i];
+      if (pred(list_elem.value)) {
         ReplaceValue(list_elem, std::move(new_value));
         return true;
       }
@@ -59,12 +62,26 @@ class string_list {
     return false;
   }
 
+  template <typename Pred>
+  bool ReplaceFirstIf(const Pred& pred, std::string_view new_value) {
+    for (std::size_t i = 0; i < size_; ++i) {
+      auto& list_elem = list_elements_[i];
+      if (pred(list_elem.value)) {
+        list_elem.value.assign(new_value);
+        list_elem.list_node.data = list_elem.value.data();
+        return true;
+      }
+    }
+    return false;
+  }
+
   template <typename Pred>
   bool ReplaceFirstIf(const Pred& pred, const char* new_value) {
-    for (auto& list_elem : list_elements_) {
-      const auto& value = list_elem.value;
-      if (pred(value)) {
-        ReplaceValue(list_elem, std::string{new_value});
+    for (std::size_t i = 0; i < size_; ++i) {
+      auto& list_elem = list_elements_[i];
+      if (pred(list_elem.value)) {
+        list_elem.value.assign(new_value);
+        list_elem.list_node.data = list_elem.value.data();
         return true;
       }
     }
@@ -81,7 +98,9 @@ class string_list {
 
   static void ReplaceValue(Elem& list_elem, std::string&& new_value);
 
+  // Elements past size_ are not in the list, they keep the storage for reuse
   std::deque<Elem> list_elements_;
+  std::size_t size_{0};
 };
 
 }  // namespace curl
@@ -0,0 +1,45 @@
+#include <curl-ev/string_list.hpp>
+
+#include <array>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Typical headers of an outgoing request
+constexpr std::array<std::string_view, 8> kHeaders{
+    "Content-Type: application/json",
+    "Accept-Encoding: gzip, identity",
+    "User-Agent: userver/2.0 (20230101000000; rv:unknown)",
+    "X-YaRequestId: 5a1e7b0cd6a84a29b5c2dcd4a2e0f0c1",
+    "X-YaSpanId: 8f1c6b2a9d3e4f50",
+    "X-YaTraceId: 1a2b3c4d5e6f708192a3b4c5d6e7f809",
+    "X-YaTaxi-Client-TimeoutMs: 250",
+    "Baggage: key1=value1,key2=value2",
+};
+
+}  // namespace
+
+void CurlStringListRefill(benchmark::State& state) {
+  curl::string_list list;
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto header : kHeaders) list.add(header);
+    benchmark::DoNotOptimize(list.native_handle());
+    list.clear();
+  }
+}
+BENCHMARK(CurlStringListRefill);
+
+void CurlStringListNew(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    curl::string_list list;
+    for (const auto header : kHeaders) list.add(header);
+    benchmark::DoNotOptimize(list.native_handle());
+  }
+}
+BENCHMARK(CurlStringListNew);
+
+USERVER_NAMESPACE_END
@@ -45,6 +45,32 @@ TEST(CurlStringList, Clear) {
   EXPECT_EQ(ToVector(list), expected);
 }
 
+TEST(CurlStringList, ReusesStorageAfterClear) {
+  curl::string_list list;
+
+  // 100 just to avoid SSO
+  list.add(std::string(100, 'a'));
+  list.add(std::string(100, 'b'));
+  const auto* const first_data = list.native_handle()->data;
+  const auto* const second_data = list.native_handle()->next->data;
+
+  list.clear();
+  list.add(std::string(50, 'c'));
+  EXPECT_EQ(list.native_handle()->data, first_data);
+  EXPECT_EQ(list.native_handle()->next, nullptr);
+  std::vector<std::string> expected1{std::string(50, 'c')};
+  EXPECT_EQ(ToVector(list), expected1);
+  EXPECT_FALSE(
+      list.FindIf([](std::string_view value) { return value[0] == 'b'; }));
+
+  list.add(std::string(100, 'd'));
+  EXPECT_EQ(list.native_handle()->next->data, second_data);
+  list.add("eee");
+  std::vector<std::string> expected2{std::string(50, 'c'),
+                                     std::string(100, 'd'), "eee"};
+  EXPECT_EQ(ToVector(list), expected2);
+}
+
 TEST(CurlStringList, FindIf) {
   curl::string_list list;
 
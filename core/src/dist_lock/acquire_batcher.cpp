@@ -0,0 +1,119 @@
+#include <userver/dist_lock/acquire_batcher.hpp>
+
+#include <stdexcept>
+#include <unordered_set>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dist_lock {
+
+AcquireBatcher::AcquireBatcher(BatchFunc batch_func,
+                               const AcquireBatcherSettings& settings)
+    : batch_func_(std::move(batch_func)), settings_(settings) {
+  UASSERT(batch_func_);
+  UINVARIANT(settings_.max_size > 0, "max_size must be positive");
+}
+
+AcquireBatcher::~AcquireBatcher() {
+  UASSERT_MSG(pending_.empty(), "AcquireBatcher destroyed with pending locks");
+}
+
+std::optional<FencingToken> AcquireBatcher::Acquire(Request request) {
+  engine::TaskCancellationBlocker cancel_blocker;
+
+  engine::Promise<Result> promise;
+  auto future = promise.get_future();
+  bool is_leader = false;
+  {
+    std::lock_guard<engine::Mutex> lock(mutex_);
+    pending_.push_back({std::move(request), std::move(promise)});
+    is_leader = !has_leader_;
+    has_leader_ = true;
+  }
+
+  if (is_leader) RunBatches();
+
+  const auto result = future.get();
+  if (!result.is_acquired) throw LockIsAcquiredByAnotherHostException();
+  return result.fencing_token;
+}
+
+const AcquireBatcher::Statistics& AcquireBatcher::GetStatistics() const {
+  return stats_;
+}
+
+void AcquireBatcher::RunBatches() {
+  // Gives the concurrent requests time to join the batch
+  engine::SleepFor(settings_.max_delay);
+
+  while (true) {
+    auto batch = TakeBatch();
+    if (batch.empty()) return;
+    SendBatch(batch);
+  }
+}
+
+std::vector<AcquireBatcher::Pending> AcquireBatcher::TakeBatch() {
+  std::lock_guard<engine::Mutex> lock(mutex_);
+
+  std::vector<Pending> batch;
+  std::vector<Pending> rest;
+  std::unordered_set<std::string> keys;
+  for (auto& pending : pending_) {
+    if (batch.size() < settings_.max_size &&
+        keys.insert(pending.request.key).second) {
+      batch.push_back(std::move(pending));
+    } else {
+      rest.push_back(std::move(pending));
+    }
+  }
+  pending_ = std::move(rest);
+  if (batch.empty()) has_leader_ = false;
+  return batch;
+}
+
+void AcquireBatcher::SendBatch(std::vector<Pending>& batch) {
+  std::vector<Request> requests;
+  requests.reserve(batch.size());
+  for (const auto& pending : batch) requests.push_back(pending.request);
+
+  ++stats_.batches;
+  stats_.requests += batch.size();
+
+  try {
+    auto results = batch_func_(requests);
+    if (results.size() != batch.size()) {
+      throw std::logic_error("Batch of the distributed locks returned " +
+                             std::to_string(results.size()) +
+                             " results for " + std::to_string(batch.size()) +
+                             " requests");
+    }
+    for (std::size_t i = 0; i < batch.size(); ++i) {
+      batch[i].promise.set_value(results[i]);
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to acquire a batch of " << batch.size()
+                  << " distributed locks: " << ex;
+    ++stats_.failed_batches;
+    const auto exception = std::current_exception();
+    for (auto& pending : batch) pending.promise.set_exception(exception);
+  }
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const AcquireBatcher& batcher) {
+  const auto& stats = batcher.GetStatistics();
+  writer["batches"] = stats.batches.Load();
+  writer["requests"] = stats.requests.Load();
+  writer["failed-batches"] = stats.failed_batches.Load();
+}
+
+}  // namespace dist_lock
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,126 @@
+#include <userver/utest/utest.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <userver/dist_lock/acquire_batcher.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Batcher = dist_lock::AcquireBatcher;
+
+constexpr std::chrono::milliseconds kLockTtl{100};
+
+class BatchRecorder final {
+ public:
+  std::vector<Batcher::Result> operator()(
+      const std::vector<Batcher::Request>& requests) {
+    std::lock_guard<engine::Mutex> lock(mutex_);
+    batch_sizes_.push_back(requests.size());
+
+    std::vector<Batcher::Result> results;
+    for (const auto& request : requests) {
+      EXPECT_EQ(request.lock_ttl, kLockTtl);
+      if (request.key == "busy") {
+        results.push_back({false, std::nullopt});
+      } else {
+        results.push_back({true, std::stoll(request.owner)});
+      }
+    }
+    return results;
+  }
+
+  std::vector<std::size_t> GetBatchSizes() {
+    std::lock_guard<engine::Mutex> lock(mutex_);
+    return batch_sizes_;
+  }
+
+ private:
+  engine::Mutex mutex_;
+  std::vector<std::size_t> batch_sizes_;
+};
+
+dist_lock::AcquireBatcherSettings MakeSettings(std::size_t max_size = 100) {
+  // Large delay, so all the test requests get into the first batch
+  return {std::chrono::milliseconds{50}, max_size};
+}
+
+auto StartAcquire(Batcher& batcher, std::string key, std::size_t owner) {
+  return utils::Async("acquire", [&batcher, key = std::move(key), owner] {
+    return batcher.Acquire({key, std::to_string(owner), kLockTtl});
+  });
+}
+
+}  // namespace
+
+UTEST_MT(DistLockAcquireBatcher, SingleBatch, 4) {
+  BatchRecorder recorder;
+  Batcher batcher{std::ref(recorder), MakeSettings()};
+
+  std::vector<engine::TaskWithResult<std::optional<dist_lock::FencingToken>>>
+      tasks;
+  for (std::size_t i = 0; i < 10; ++i) {
+    tasks.push_back(StartAcquire(batcher, "key" + std::to_string(i), i));
+  }
+  for (std::size_t i = 0; i < tasks.size(); ++i) {
+    EXPECT_EQ(tasks[i].Get(), static_cast<dist_lock::FencingToken>(i));
+  }
+
+  EXPECT_EQ(recorder.GetBatchSizes(), std::vector<std::size_t>{10});
+  EXPECT_EQ(batcher.GetStatistics().batches.Load(), 1);
+  EXPECT_EQ(batcher.GetStatistics().requests.Load(), 10);
+}
+
+UTEST_MT(DistLockAcquireBatcher, Busy, 2) {
+  BatchRecorder recorder;
+  Batcher batcher{std::ref(recorder), MakeSettings()};
+
+  auto busy = StartAcquire(batcher, "busy", 1);
+  auto free = StartAcquire(batcher, "free", 2);
+  UEXPECT_THROW(busy.Get(), dist_lock::LockIsAcquiredByAnotherHostException);
+  EXPECT_EQ(free.Get(), 2);
+}
+
+UTEST_MT(DistLockAcquireBatcher, SplitsBatches, 4) {
+  BatchRecorder recorder;
+  Batcher batcher{std::ref(recorder), MakeSettings(3)};
+
+  std::vector<engine::TaskWithResult<std::optional<dist_lock::FencingToken>>>
+      tasks;
+  for (std::size_t i = 0; i < 4; ++i) {
+    tasks.push_back(StartAcquire(batcher, "key" + std::to_string(i), i));
+  }
+  // The same lock is never acquired twice within a batch
+  tasks.push_back(StartAcquire(batcher, "key0", 4));
+  for (auto& task : tasks) task.Get();
+
+  const auto batch_sizes = recorder.GetBatchSizes();
+  EXPECT_GE(batch_sizes.size(), 2);
+  EXPECT_EQ(std::accumulate(batch_sizes.begin(), batch_sizes.end(),
+                            std::size_t{0}),
+            5);
+  EXPECT_LE(*std::max_element(batch_sizes.begin(), batch_sizes.end()), 3);
+}
+
+UTEST_MT(DistLockAcquireBatcher, Failure, 2) {
+  const auto failing_batch = [](const std::vector<Batcher::Request>&)
+      -> std::vector<Batcher::Result> {
+    throw std::runtime_error("db is down");
+  };
+  Batcher batcher{failing_batch, MakeSettings()};
+
+  auto first = StartAcquire(batcher, "key0", 0);
+  auto second = StartAcquire(batcher, "key1", 1);
+  UEXPECT_THROW_MSG(first.Get(), std::runtime_error, "db is down");
+  UEXPECT_THROW_MSG(second.Get(), std::runtime_error, "db is down");
+  EXPECT_EQ(batcher.GetStatistics().failed_batches.Load(), 1);
+}
+
+USERVER_NAMESPACE_END
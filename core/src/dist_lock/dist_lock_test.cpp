@@ -8,6 +8,7 @@
 #include <userver/dist_lock/dist_locked_task.hpp>
 #include <userver/dist_lock/dist_locked_worker.hpp>
 #include <userver/engine/condition_variable.hpp>
+#include <userver/engine/deadline.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
@@ -75,6 +76,26 @@ class MockDistLockStrategy final : public dist_lock::DistLockStrategyBase {
 
 auto MakeMockStrategy() { return std::make_shared<MockDistLockStrategy>(); }
 
+class FencedDistLockStrategy final : public dist_lock::DistLockStrategyBase {
+ public:
+  void Acquire(std::chrono::milliseconds lock_ttl,
+               const std::string& locker_id) override {
+    AcquireWithFencingToken(lock_ttl, locker_id);
+  }
+
+  std::optional<dist_lock::FencingToken> AcquireWithFencingToken(
+      std::chrono::milliseconds, const std::string&) override {
+    return token_.load();
+  }
+
+  void Release(const std::string&) override {}
+
+  void SetToken(dist_lock::FencingToken token) { token_ = token; }
+
+ private:
+  std::atomic<dist_lock::FencingToken> token_{1};
+};
+
 class DistLockWorkload {
  public:
   explicit DistLockWorkload(bool abort_on_cancel = false)
@@ -244,6 +265,49 @@ UTEST_MT(LockedWorker, LockedByOther, 3) {
   locked_worker.Stop();
 }
 
+UTEST_MT(LockedWorker, FencingToken, 3) {
+  auto strategy = std::make_shared<FencedDistLockStrategy>();
+  DistLockWorkload work;
+  dist_lock::DistLockedWorker locked_worker(
+      kWorkerName, [&] { work.Work(); }, strategy, MakeSettings());
+  EXPECT_EQ(locked_worker.GetFencingToken(), std::nullopt);
+
+  locked_worker.Start();
+  EXPECT_TRUE(work.WaitForLocked(true, utest::kMaxTestWaitTime));
+  EXPECT_EQ(locked_worker.GetFencingToken(), 1);
+
+  strategy->SetToken(2);
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  while (locked_worker.GetFencingToken() != 2 && !deadline.IsReached()) {
+    engine::SleepFor(kAttemptInterval);
+  }
+  EXPECT_EQ(locked_worker.GetFencingToken(), 2);
+  EXPECT_EQ(locked_worker.GetStatistics().lock_acquisitions.Load(), 1);
+
+  locked_worker.Stop();
+  EXPECT_EQ(locked_worker.GetFencingToken(), std::nullopt);
+}
+
+UTEST_MT(LockedWorker, Contention, 3) {
+  auto strategy = MakeMockStrategy();
+  strategy->Allow(true);
+  strategy->SetLockedBy("me");
+  DistLockWorkload work;
+  dist_lock::DistLockedWorker locked_worker(
+      kWorkerName, [&] { work.Work(); }, strategy, MakeSettings());
+
+  locked_worker.Start();
+  EXPECT_FALSE(work.WaitForLocked(true, kAttemptTimeout));
+  EXPECT_LT(0, locked_worker.GetStatistics().lock_contentions.Load());
+  EXPECT_EQ(locked_worker.GetFencingToken(), std::nullopt);
+
+  strategy->Release("me");
+  EXPECT_TRUE(work.WaitForLocked(true, utest::kMaxTestWaitTime));
+  EXPECT_EQ(locked_worker.GetStatistics().lock_acquisitions.Load(), 1);
+
+  locked_worker.Stop();
+}
+
 UTEST_MT(LockedTask, Smoke, 3) {
   auto strategy = MakeMockStrategy();
   DistLockWorkload work;
@@ -86,6 +86,10 @@ DistLockedWorker::GetLockedDuration() const {
   return locker_ptr_->GetLockedDuration();
 }
 
+std::optional<FencingToken> DistLockedWorker::GetFencingToken() const {
+  return locker_ptr_->GetFencingToken();
+}
+
 const Statistics& DistLockedWorker::GetStatistics() const {
   return locker_ptr_->GetStatistics();
 }
@@ -108,6 +112,8 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["watchdog-triggers"] = stats.watchdog_triggers.Load();
   writer["brain-splits"] = stats.brain_splits.Load();
   writer["task-failures"] = stats.task_failures.Load();
+  writer["contentions"] = stats.lock_contentions.Load();
+  writer["acquisitions"] = stats.lock_acquisitions.Load();
 }
 
 }  // namespace dist_lock
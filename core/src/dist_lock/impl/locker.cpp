@@ -33,6 +33,16 @@ std::string MakeLockerId(const std::string& name) {
   return fmt::format(FMT_COMPILE("{}-{:x}"), name, idx++);
 }
 
+// Prolongations are aligned to the steady clock, so the locks with the same
+// prolong interval are renewed together and may be batched by the strategy
+std::chrono::steady_clock::duration TimeToProlong(
+    std::chrono::milliseconds prolong_interval) {
+  const std::chrono::steady_clock::duration interval = prolong_interval;
+  if (interval <= std::chrono::steady_clock::duration::zero()) return interval;
+  return interval -
+         utils::datetime::SteadyNow().time_since_epoch() % interval;
+}
+
 }  // namespace
 
 class Locker::LockGuard {
@@ -88,6 +98,13 @@ std::optional<std::chrono::steady_clock::duration> Locker::GetLockedDuration()
          lock_acquire_since_epoch_.load();
 }
 
+std::optional<FencingToken> Locker::GetFencingToken() const {
+  if (!is_locked_ || !has_fencing_token_.load(std::memory_order_acquire)) {
+    return {};
+  }
+  return fencing_token_.load(std::memory_order_relaxed);
+}
+
 const Statistics& Locker::GetStatistics() const { return stats_; }
 
 void Locker::Run(LockerMode mode, dist_lock::DistLockWaitingMode waiting_mode,
@@ -103,8 +120,11 @@ void Locker::Run(LockerMode mode, dist_lock::DistLockWaitingMode waiting_mode,
     const auto attempt_start = utils::datetime::SteadyNow();
 
     try {
-      strategy_->Acquire(settings.lock_ttl, Id());
+      const auto token =
+          strategy_->AcquireWithFencingToken(settings.lock_ttl, Id());
       stats_.lock_successes++;
+      if (token) fencing_token_.store(*token, std::memory_order_relaxed);
+      has_fencing_token_.store(token.has_value(), std::memory_order_release);
       if (!ExchangeLockState(true, attempt_start)) {
         LOG_DEBUG() << "Starting watchdog task";
         GetTask(watchdog_task, WatchdogName(name_));
@@ -115,6 +135,7 @@ void Locker::Run(LockerMode mode, dist_lock::DistLockWaitingMode waiting_mode,
     } catch (const LockIsAcquiredByAnotherHostException&) {
       LOG_INFO() << "Fail to acquire lock. It was acquired by another host";
       stats_.lock_failures++;
+      stats_.lock_contentions++;
       if (is_locked_) {
         LOG_ERROR()
             << "DistLockedTask brain split detected! Someone else acquired the "
@@ -136,8 +157,9 @@ void Locker::Run(LockerMode mode, dist_lock::DistLockWaitingMode waiting_mode,
 
     if (engine::current_task::ShouldCancel()) break;
 
-    auto delay =
-        is_locked_ ? settings.prolong_interval : settings.acquire_interval;
+    const std::chrono::steady_clock::duration delay =
+        is_locked_ ? TimeToProlong(settings.prolong_interval)
+                   : settings.acquire_interval;
     if (watchdog_task.IsValid()) {
       try {
         watchdog_task.WaitFor(delay);
@@ -194,6 +216,7 @@ bool Locker::ExchangeLockState(bool is_locked,
   if (is_locked != was_locked) {
     if (!was_locked) {
       LOG_INFO() << "Acquired the lock";
+      stats_.lock_acquisitions++;
       lock_acquire_since_epoch_ = when.time_since_epoch();
     } else {
       LOG_INFO() << "Released (or lost) the lock";
@@ -35,6 +35,8 @@ class Locker final {
 
   std::optional<std::chrono::steady_clock::duration> GetLockedDuration() const;
 
+  std::optional<FencingToken> GetFencingToken() const;
+
   const Statistics& GetStatistics() const;
 
   engine::TaskWithResult<void> RunAsync(engine::TaskProcessor& task_processor,
@@ -63,6 +65,8 @@ class Locker final {
   std::atomic<bool> is_locked_{false};
   std::atomic<std::chrono::steady_clock::duration> lock_refresh_since_epoch_{};
   std::atomic<std::chrono::steady_clock::duration> lock_acquire_since_epoch_{};
+  std::atomic<bool> has_fencing_token_{false};
+  std::atomic<FencingToken> fencing_token_{0};
 
   Statistics stats_;
 };
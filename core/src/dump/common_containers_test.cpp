@@ -7,6 +7,8 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 
+#include <userver/cache/flat_hash_map.hpp>
+#include <userver/cache/persistent_hash_map.hpp>
 #include <userver/dump/test_helpers.hpp>
 #include <userver/utest/utest.hpp>
 
@@ -96,6 +98,22 @@ TEST(DumpCommonContainers, UnorderedMap) {
   TestWriteReadCycle(std::unordered_map<bool, bool>{});
 }
 
+TEST(DumpCommonContainers, PersistentHashMap) {
+  cache::PersistentHashMap<int, std::string> map;
+  map.insert_or_assign(1, "a");
+  map.insert_or_assign(2, "b");
+  TestWriteReadCycle(map);
+  TestWriteReadCycle(cache::PersistentHashMap<std::string, int>{});
+}
+
+TEST(DumpCommonContainers, FlatHashMap) {
+  cache::FlatHashMap<int, std::string> map;
+  map.insert_or_assign(1, "a");
+  map.insert_or_assign(2, "b");
+  TestWriteReadCycle(map);
+  TestWriteReadCycle(cache::FlatHashMap<std::string, int>{});
+}
+
 TEST(DumpCommonContainers, Set) {
   TestWriteReadCycle(std::set<int>{1, 2, 5});
   TestWriteReadCycle(std::set<std::string>{"a", "b", "bb"});
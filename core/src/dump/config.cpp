@@ -16,12 +16,40 @@ constexpr std::string_view kDumpsEnabled = "enable";
 constexpr std::string_view kFsTaskProcessor = "fs-task-processor";
 constexpr std::string_view kDumpFormatVersion = "format-version";
 constexpr std::string_view kMaxDumpCount = "max-count";
+constexpr std::string_view kMaxDeltaCount = "max-delta-count";
 constexpr std::string_view kWorldReadable = "world-readable";
 constexpr std::string_view kEncrypted = "encrypted";
+constexpr std::string_view kReadWithMmap = "read-with-mmap";
+constexpr std::string_view kCompression = "compression";
+constexpr std::string_view kPeerWarmup = "peer-warmup";
 
 constexpr auto kDefaultFsTaskProcessor = std::string_view{"fs-task-processor"};
 constexpr auto kDefaultMaxDumpCount = uint64_t{1};
 
+std::optional<CompressionConfig> ParseCompressionConfig(
+    const yaml_config::YamlConfig& config, const std::string& fs_task_processor) {
+  if (config.IsMissing()) return std::nullopt;
+
+  CompressionConfig result;
+  result.level = config["level"].As<int>(result.level);
+  result.block_size = config["block-size"].As<uint64_t>(result.block_size);
+  result.parallelism = config["parallelism"].As<uint64_t>(result.parallelism);
+  result.task_processor =
+      config["task-processor"].As<std::string>(fs_task_processor);
+  return result;
+}
+
+std::optional<PeerWarmupConfig> ParsePeerWarmupConfig(
+    const yaml_config::YamlConfig& config) {
+  if (config.IsMissing()) return std::nullopt;
+
+  PeerWarmupConfig result;
+  result.urls = config["urls"].As<std::vector<std::string>>();
+  result.timeout =
+      config["timeout"].As<std::chrono::milliseconds>(result.timeout);
+  return result;
+}
+
 }  // namespace
 
 namespace impl {
@@ -63,10 +91,15 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
       fs_task_processor(
           config[kFsTaskProcessor].As<std::string>(kDefaultFsTaskProcessor)),
       max_dump_count(config[kMaxDumpCount].As<uint64_t>(kDefaultMaxDumpCount)),
+      max_delta_count(config[kMaxDeltaCount].As<uint64_t>(0)),
       max_dump_age(
           config[kMaxDumpAge].As<std::optional<std::chrono::milliseconds>>()),
       max_dump_age_set(config.HasMember(kMaxDumpAge)),
       dump_is_encrypted(config[kEncrypted].As<bool>(false)),
+      read_with_mmap(config[kReadWithMmap].As<bool>(false)),
+      compression(
+          ParseCompressionConfig(config[kCompression], fs_task_processor)),
+      peer_warmup(ParsePeerWarmupConfig(config[kPeerWarmup])),
       static_dumps_enabled(config[kDumpsEnabled].As<bool>()),
       static_min_dump_interval(
           config[kMinDumpInterval].As<std::chrono::milliseconds>(0)) {
@@ -74,6 +107,18 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config,
     throw std::logic_error(
         fmt::format("{}: {} must be positive", this->name, kMaxDumpAge));
   }
+  if (compression && compression->block_size == 0) {
+    throw std::logic_error(fmt::format("{}: {}.block-size must not be 0",
+                                       this->name, kCompression));
+  }
+  if (compression && compression->parallelism == 0) {
+    throw std::logic_error(fmt::format("{}: {}.parallelism must not be 0",
+                                       this->name, kCompression));
+  }
+  if (peer_warmup && peer_warmup->urls.empty()) {
+    throw std::logic_error(fmt::format("{}: {}.urls must not be empty",
+                                       this->name, kPeerWarmup));
+  }
   if (max_dump_count == 0) {
     throw std::logic_error(
         fmt::format("{}: {} must not be 0", this->name, kMaxDumpCount));
@@ -26,7 +26,8 @@ const std::string kTimeZone = "UTC";
 DumpLocator::DumpLocator(Config static_config)
     : config_(static_config),
       filename_regex_(GenerateFilenameRegex(FileFormatType::kNormal)),
-      tmp_filename_regex_(GenerateFilenameRegex(FileFormatType::kTmp)) {}
+      tmp_filename_regex_(GenerateFilenameRegex(FileFormatType::kTmp)),
+      deltas_filename_regex_(GenerateFilenameRegex(FileFormatType::kDeltas)) {}
 
 DumpFileStats DumpLocator::RegisterNewDump(TimePoint update_time) {
   std::string dump_path = GenerateDumpPath(update_time);
@@ -48,6 +49,31 @@ DumpFileStats DumpLocator::RegisterNewDump(TimePoint update_time) {
   return {update_time, std::move(dump_path), config_.dump_format_version};
 }
 
+DumpFileStats DumpLocator::RegisterNewDelta(TimePoint base_update_time,
+                                            TimePoint update_time) {
+  const auto deltas_path = GenerateDeltasPath(base_update_time);
+  std::string delta_path = fmt::format(
+      FMT_COMPILE("{}/{}-v{}"), deltas_path,
+      utils::datetime::Timestring(update_time, kTimeZone, kFilenameDateFormat),
+      config_.dump_format_version);
+
+  if (boost::filesystem::exists(delta_path)) {
+    throw std::runtime_error(fmt::format(
+        "{}: could not dump to \"{}\", because the file already exists",
+        config_.name, delta_path));
+  }
+
+  try {
+    fs::blocking::CreateDirectories(deltas_path);
+  } catch (const std::exception& ex) {
+    throw std::runtime_error(
+        fmt::format("{}: error while creating delta dump at \"{}\". Cause: {}",
+                    config_.name, delta_path, ex.what()));
+  }
+
+  return {update_time, std::move(delta_path), config_.dump_format_version};
+}
+
 std::optional<DumpFileStats> DumpLocator::GetLatestDump() const {
   try {
     std::optional<DumpFileStats> stats = GetLatestDumpImpl();
@@ -68,6 +94,30 @@ std::optional<DumpFileStats> DumpLocator::GetLatestDump() const {
   }
 }
 
+std::vector<DumpFileStats> DumpLocator::GetDeltas(
+    TimePoint base_update_time) const {
+  const auto deltas_path = GenerateDeltasPath(base_update_time);
+  std::vector<DumpFileStats> deltas;
+  if (!boost::filesystem::exists(deltas_path)) return deltas;
+
+  for (const auto& file : boost::filesystem::directory_iterator{deltas_path}) {
+    if (!boost::filesystem::is_regular_file(file.status())) continue;
+
+    auto delta = ParseDumpName(file.path().string());
+    if (!delta || delta->format_version != config_.dump_format_version ||
+        delta->update_time < base_update_time) {
+      continue;
+    }
+    deltas.push_back(std::move(*delta));
+  }
+
+  std::sort(deltas.begin(), deltas.end(),
+            [](const DumpFileStats& a, const DumpFileStats& b) {
+              return a.update_time < b.update_time;
+            });
+  return deltas;
+}
+
 bool DumpLocator::BumpDumpTime(TimePoint old_update_time,
                                TimePoint new_update_time) {
   if (new_update_time < old_update_time) {
@@ -103,6 +153,7 @@ bool DumpLocator::BumpDumpTime(TimePoint old_update_time,
 void DumpLocator::Cleanup() {
   const auto min_update_time = MinAcceptableUpdateTime();
   std::vector<DumpFileStats> dumps;
+  std::vector<std::string> deltas_paths;
 
   try {
     if (!boost::filesystem::exists(config_.dump_directory)) {
@@ -113,11 +164,17 @@ void DumpLocator::Cleanup() {
 
     for (const auto& file :
          boost::filesystem::directory_iterator{config_.dump_directory}) {
-      if (!boost::filesystem::is_regular_file(file.status())) {
+      std::string filename = file.path().filename().string();
+
+      if (boost::filesystem::is_directory(file.status()) &&
+          boost::regex_match(filename, deltas_filename_regex_)) {
+        deltas_paths.push_back(file.path().string());
         continue;
       }
 
-      std::string filename = file.path().filename().string();
+      if (!boost::filesystem::is_regular_file(file.status())) {
+        continue;
+      }
 
       if (boost::regex_match(filename, tmp_filename_regex_)) {
         LOG_DEBUG() << "Removing a leftover tmp file \"" << file.path().string()
@@ -157,12 +214,35 @@ void DumpLocator::Cleanup() {
                   << dumps[i].full_path << "\"";
       boost::filesystem::remove(dumps[i].full_path);
     }
+
+    for (const auto& deltas_path : deltas_paths) CleanupDeltas(deltas_path);
   } catch (const std::exception& ex) {
     LOG_ERROR() << config_.name
                 << ": error while cleaning up old dumps. Cause: " << ex;
   }
 }
 
+void DumpLocator::CleanupDeltas(const std::string& deltas_path) {
+  constexpr std::string_view kDeltasSuffix = ".deltas";
+  const auto base_path =
+      deltas_path.substr(0, deltas_path.size() - kDeltasSuffix.size());
+  if (!boost::filesystem::exists(base_path)) {
+    LOG_DEBUG() << config_.name << ": removing the deltas of a removed dump \""
+                << base_path << "\"";
+    boost::filesystem::remove_all(deltas_path);
+    return;
+  }
+
+  for (const auto& file : boost::filesystem::directory_iterator{deltas_path}) {
+    if (boost::regex_match(file.path().filename().string(),
+                           tmp_filename_regex_)) {
+      LOG_DEBUG() << "Removing a leftover tmp file \"" << file.path().string()
+                  << "\"";
+      boost::filesystem::remove(file);
+    }
+  }
+}
+
 std::optional<DumpFileStats> DumpLocator::ParseDumpName(
     std::string full_path) const {
   const auto filename = boost::filesystem::path{full_path}.filename().string();
@@ -257,6 +337,10 @@ std::string DumpLocator::GenerateDumpPath(TimePoint update_time) const {
       config_.dump_format_version);
 }
 
+std::string DumpLocator::GenerateDeltasPath(TimePoint base_update_time) const {
+  return GenerateDumpPath(base_update_time) + ".deltas";
+}
+
 TimePoint DumpLocator::MinAcceptableUpdateTime() const {
   return config_.max_dump_age
              ? Round(utils::datetime::Now()) - *config_.max_dump_age
@@ -264,9 +348,20 @@ TimePoint DumpLocator::MinAcceptableUpdateTime() const {
 }
 
 std::string DumpLocator::GenerateFilenameRegex(FileFormatType type) {
+  std::string_view suffix = "$";
+  switch (type) {
+    case FileFormatType::kNormal:
+      break;
+    case FileFormatType::kTmp:
+      suffix = "\\.tmp$";
+      break;
+    case FileFormatType::kDeltas:
+      suffix = "\\.deltas$";
+      break;
+  }
   return std::string{
              R"(^(\d{4}-\d{2}-\d{2}T\d{2}:?\d{2}:?\d{2}\.\d{6}Z?)-v(\d+))"} +
-         (type == FileFormatType::kTmp ? "\\.tmp$" : "$");
+         std::string{suffix};
 }
 
 TimePoint DumpLocator::Round(std::chrono::system_clock::time_point time) {
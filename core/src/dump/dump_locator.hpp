@@ -4,6 +4,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <boost/regex.hpp>
 
@@ -36,24 +37,37 @@ class DumpLocator final {
   /// @throws On a filesystem error
   DumpFileStats RegisterNewDump(TimePoint update_time);
 
+  /// @brief Prepare the place for a new delta dump, that is written on top of
+  /// the dump with `base_update_time` or its previous deltas
+  /// @note The operation is blocking, and should run in FS TaskProcessor
+  /// @note The actual creation of the file is a caller's responsibility
+  /// @throws On a filesystem error
+  DumpFileStats RegisterNewDelta(TimePoint base_update_time,
+                                 TimePoint update_time);
+
   /// @brief Finds the latest suitable dump
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @returns The full path of the dump if available and fresh enough,
   /// or `nullopt` otherwise
   std::optional<DumpFileStats> GetLatestDump() const;
 
+  /// @brief Finds the delta dumps of the dump with `base_update_time`
+  /// @note The operation is blocking, and should run in FS TaskProcessor
+  /// @returns The deltas ordered by their update time
+  std::vector<DumpFileStats> GetDeltas(TimePoint base_update_time) const;
+
   /// @brief Modifies the update time for a dump
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @return `true` on success, `false` if the dump is not available
   bool BumpDumpTime(TimePoint old_update_time, TimePoint new_update_time);
 
-  /// @brief Removes old dumps and tmp files
+  /// @brief Removes old dumps, their deltas and tmp files
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @warning Must not be called concurrently with `RegisterNewDump`
   void Cleanup();
 
  private:
-  enum class FileFormatType { kNormal, kTmp };
+  enum class FileFormatType { kNormal, kTmp, kDeltas };
 
   std::optional<DumpFileStats> ParseDumpName(std::string full_path) const;
 
@@ -61,6 +75,10 @@ class DumpLocator final {
 
   std::string GenerateDumpPath(TimePoint update_time) const;
 
+  std::string GenerateDeltasPath(TimePoint base_update_time) const;
+
+  void CleanupDeltas(const std::string& deltas_path);
+
   TimePoint MinAcceptableUpdateTime() const;
 
   static std::string GenerateFilenameRegex(FileFormatType type);
@@ -70,6 +88,7 @@ class DumpLocator final {
   const Config config_;
   const boost::regex filename_regex_;
   const boost::regex tmp_filename_regex_;
+  const boost::regex deltas_filename_regex_;
 };
 
 }  // namespace dump
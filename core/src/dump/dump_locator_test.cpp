@@ -221,6 +221,65 @@ max-age: null
   EXPECT_EQ(dump::FilenamesInDirectory(dir, kDumperName), expected_files);
 }
 
+UTEST(DumpLocator, Deltas) {
+  const std::string kConfig = R"(
+enable: true
+world-readable: false
+format-version: 5
+max-count: 1
+max-age: null
+max-delta-count: 10
+)";
+  const auto dir = fs::blocking::TempDirectory::Create();
+
+  using namespace std::chrono_literals;
+
+  const dump::Config config{dump::ConfigFromYaml(kConfig, dir, kDumperName)};
+  dump::DumpLocator locator{config};
+
+  const auto base_stats = locator.RegisterNewDump(BaseTime());
+  fs::blocking::RewriteFileContents(base_stats.full_path, "base");
+  EXPECT_TRUE(locator.GetDeltas(BaseTime()).empty());
+
+  for (const auto delay : {2s, 1s}) {
+    const auto delta_stats =
+        locator.RegisterNewDelta(BaseTime(), BaseTime() + delay);
+    fs::blocking::RewriteFileContents(delta_stats.full_path, "delta");
+  }
+  fs::blocking::RewriteFileContents(
+      locator.RegisterNewDelta(BaseTime(), BaseTime() + 3s).full_path + ".tmp",
+      "tmp");
+
+  // Deltas do not affect the choice of the dump
+  const auto dump_info = locator.GetLatestDump();
+  ASSERT_TRUE(dump_info);
+  EXPECT_EQ(dump_info->update_time, BaseTime());
+
+  const auto deltas = locator.GetDeltas(BaseTime());
+  ASSERT_EQ(deltas.size(), 2);
+  EXPECT_EQ(deltas[0].update_time, BaseTime() + 1s);
+  EXPECT_EQ(deltas[1].update_time, BaseTime() + 2s);
+  EXPECT_EQ(fs::blocking::ReadFileContents(deltas[0].full_path), "delta");
+
+  const std::string deltas_dir = "2015-03-22T090000.000000Z-v5.deltas";
+  EXPECT_EQ(dump::FilenamesInDirectory(dir, kDumperName),
+            (std::set<std::string>{"2015-03-22T090000.000000Z-v5", deltas_dir}));
+
+  // Cleanup removes the tmp files of the deltas
+  locator.Cleanup();
+  EXPECT_EQ(dump::FilenamesInDirectory(dir, std::string{kDumperName} + "/" +
+                                                deltas_dir)
+                .size(),
+            2);
+
+  // Cleanup removes the deltas along with their dump
+  const auto new_base_stats = locator.RegisterNewDump(BaseTime() + 10s);
+  fs::blocking::RewriteFileContents(new_base_stats.full_path, "base");
+  locator.Cleanup();
+  EXPECT_EQ(dump::FilenamesInDirectory(dir, kDumperName),
+            (std::set<std::string>{"2015-03-22T090010.000000Z-v5"}));
+}
+
 UTEST(DumpLocator, LegacyFilenames) {
   using namespace std::chrono_literals;
   using namespace std::string_literals;
@@ -3,6 +3,8 @@
 #include <fmt/format.h>
 #include <boost/filesystem/operations.hpp>
 
+#include <userver/clients/http/client.hpp>
+#include <userver/clients/http/component.hpp>
 #include <userver/components/component.hpp>
 #include <userver/components/loggable_component_base.hpp>
 #include <userver/components/statistics_storage.hpp>
@@ -15,6 +17,7 @@
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/task_with_result.hpp>
 #include <userver/formats/json/value.hpp>
+#include <userver/http/url.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/rcu/rcu.hpp>
@@ -30,8 +33,10 @@
 #include <userver/yaml_config/schema.hpp>
 
 #include <dump/dump_locator.hpp>
+#include <dump/http_snapshot_reader.hpp>
 #include <dump/statistics.hpp>
 #include <userver/components/dump_configurator.hpp>
+#include <userver/dump/common.hpp>
 #include <userver/dump/config.hpp>
 #include <userver/dump/factory.hpp>
 #include <userver/testsuite/dump_control.hpp>
@@ -48,8 +53,17 @@ void ThrowDumpUnimplemented(const std::string& name) {
 
 DumpableEntity::~DumpableEntity() = default;
 
+bool DumpableEntity::GetAndWriteDelta(dump::Writer&) const { return false; }
+
+void DumpableEntity::ReadAndApplyDelta(dump::Reader&) {
+  throw Error("Delta dumps are not supported");
+}
+
 namespace {
 
+// Detects the snapshots truncated by a network failure
+constexpr uint64_t kSnapshotEndMarker = 0x736e617073686f74;
+
 struct UpdateTime final {
   TimePoint last_update;
   TimePoint last_modifying_update;
@@ -69,6 +83,9 @@ struct DumpData {
   DumpableEntity& dumpable;
   DumpLocator locator;
   std::optional<UpdateTime> dumped_update_time;
+  // The full dump that the next delta dump may be written on top of
+  std::optional<TimePoint> delta_base_update_time;
+  uint64_t delta_count{0};
 };
 
 struct UpdateData {
@@ -111,7 +128,7 @@ class Dumper::Impl {
        dynamic_config::Source config_source,
        utils::statistics::Storage& statistics_storage,
        testsuite::DumpControl& dump_control, DumpableEntity& dumpable,
-       Dumper& self);
+       clients::http::Client* http_client, Dumper& self);
 
   ~Impl();
 
@@ -119,6 +136,10 @@ class Dumper::Impl {
 
   std::optional<TimePoint> ReadDump();
 
+  void WriteSnapshot(Writer& writer);
+
+  TimePoint ReadSnapshot(Reader& reader);
+
   void WriteDumpSyncDebug();
 
   void ReadDumpDebug();
@@ -141,12 +162,35 @@ class Dumper::Impl {
   void DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
                    DumpData& dump_data);
 
+  /// @returns `false` if a full dump should be written instead
+  /// @throws std::exception on failure
+  bool TryWriteDelta(TimePoint update_time, tracing::ScopeTime& scope,
+                     DumpData& dump_data);
+
+  /// @returns `update_time` of the last applied delta, if any
+  std::optional<TimePoint> LoadDeltas(DumpData& dump_data,
+                                      const DumpFileStats& base_stats);
+
   enum class DumpOperation { kNewDump, kBumpTime };
 
   /// @returns `update_time` of the loaded dump on success, `null` otherwise
   std::optional<TimePoint> LoadFromDump(DumpData& dump_data,
                                         const DynamicConfig& config);
 
+  /// @returns `update_time` of the loaded snapshot on success, `null`
+  /// otherwise
+  std::optional<TimePoint> LoadFromPeers(DumpData& dump_data);
+
+  /// @returns `update_time` of the snapshot
+  /// @throws std::exception on failure
+  TimePoint DoReadSnapshot(DumpData& dump_data, Reader& reader);
+
+  enum class LoadSource { kDump, kSnapshot };
+
+  void OnDataLoaded(DumpData& dump_data, TimePoint update_time,
+                    LoadSource source,
+                    std::chrono::steady_clock::time_point load_start);
+
   rcu::ReadablePtr<DynamicConfig> ReadConfigForPeriodicTask();
 
   void OnConfigUpdate(const dynamic_config::Snapshot& config);
@@ -156,6 +200,7 @@ class Dumper::Impl {
   const std::string read_span_name_;
   rcu::Variable<DynamicConfig> dynamic_config_;
   engine::TaskProcessor& fs_task_processor_;
+  clients::http::Client* const http_client_;
   Statistics statistics_;
   std::atomic<bool> tried_to_read_dump_{false};
 
@@ -181,12 +226,14 @@ Dumper::Impl::Impl(const Config& initial_config,
                    dynamic_config::Source config_source,
                    utils::statistics::Storage& statistics_storage,
                    testsuite::DumpControl& dump_control,
-                   DumpableEntity& dumpable, Dumper& self)
+                   DumpableEntity& dumpable, clients::http::Client* http_client,
+                   Dumper& self)
     : static_config_(initial_config),
       write_span_name_("write-dump/" + Name()),
       read_span_name_("read-dump/" + Name()),
       dynamic_config_(static_config_, ConfigPatch{}),
       fs_task_processor_(fs_task_processor),
+      http_client_(initial_config.peer_warmup ? http_client : nullptr),
       dump_data_(static_config_, std::move(rw_factory), dumpable),
       update_data_(statistics_),
       testsuite_registration_(std::in_place, dump_control, self) {
@@ -218,6 +265,33 @@ std::optional<TimePoint> Dumper::Impl::ReadDump() {
   return LoadFromDump(*dump_data, *config);
 }
 
+void Dumper::Impl::WriteSnapshot(Writer& writer) {
+  auto dump_data = dump_data_.Lock();
+  const auto update_time = [&] {
+    auto update_data = update_data_.Lock();
+    return RetrieveUpdateTime(*update_data);
+  }();
+
+  writer.Write(static_config_.dump_format_version);
+  writer.Write(update_time.last_update);
+  // The entity forgets the changes since the previous dump, the deltas chain
+  // is broken
+  dump_data->delta_base_update_time.reset();
+  dump_data->dumpable.GetAndWrite(writer);
+  writer.Write(kSnapshotEndMarker);
+  writer.Finish();
+}
+
+TimePoint Dumper::Impl::ReadSnapshot(Reader& reader) {
+  tried_to_read_dump_.store(true);
+  auto dump_data = dump_data_.Lock();
+  const auto load_start = std::chrono::steady_clock::now();
+
+  const auto update_time = DoReadSnapshot(*dump_data, reader);
+  OnDataLoaded(*dump_data, update_time, LoadSource::kSnapshot, load_start);
+  return update_time;
+}
+
 void Dumper::Impl::WriteDumpSyncDebug() {
   if (!tried_to_read_dump_.load()) {
     throw Error(fmt::format(
@@ -353,14 +427,28 @@ void Dumper::Impl::WriteDump(DumpData& dump_data) {
 
   switch (operation_type) {
     case DumpOperation::kNewDump: {
-      dump_data.locator.Cleanup();
-      DoWriteDump(update_time.last_update, scope_time, dump_data);
+      if (!TryWriteDelta(update_time.last_update, scope_time, dump_data)) {
+        dump_data.locator.Cleanup();
+        DoWriteDump(update_time.last_update, scope_time, dump_data);
+      }
       break;
     }
     case DumpOperation::kBumpTime: {
       UASSERT(dumped_update_time);
-      if (!dump_data.locator.BumpDumpTime(dumped_update_time->last_update,
-                                          update_time.last_update)) {
+      if (dump_data.delta_count != 0) {
+        // Renaming the full dump would detach its deltas, an empty delta dump
+        // bumps the time instead
+        if (!TryWriteDelta(update_time.last_update, scope_time, dump_data)) {
+          dump_data.locator.Cleanup();
+          DoWriteDump(update_time.last_update, scope_time, dump_data);
+        }
+      } else if (dump_data.locator.BumpDumpTime(
+                     dumped_update_time->last_update,
+                     update_time.last_update)) {
+        if (dump_data.delta_base_update_time) {
+          dump_data.delta_base_update_time = update_time.last_update;
+        }
+      } else {
         DoWriteDump(update_time.last_update, scope_time, dump_data);
       }
       break;
@@ -421,6 +509,9 @@ void Dumper::Impl::CancelWriteTaskAndWait() noexcept {
 void Dumper::Impl::DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
                                DumpData& dump_data) {
   const auto dump_start = std::chrono::steady_clock::now();
+  // The entity forgets the previous changes, the old deltas chain is broken
+  dump_data.delta_base_update_time.reset();
+  dump_data.delta_count = 0;
 
   const auto dump_stats = dump_data.locator.RegisterNewDump(update_time);
   const auto& dump_path = dump_stats.full_path;
@@ -432,11 +523,89 @@ void Dumper::Impl::DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
   LOG_INFO() << Name() << ": a new dump has been written at \"" << dump_path
              << '"';
 
+  if (static_config_.max_delta_count != 0) {
+    dump_data.delta_base_update_time = update_time;
+  }
+
+  statistics_.last_written_size = dump_size;
+  statistics_.last_nontrivial_write_duration =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - dump_start);
+  statistics_.last_nontrivial_write_start_time = dump_start;
+}
+
+bool Dumper::Impl::TryWriteDelta(TimePoint update_time,
+                                 tracing::ScopeTime& scope,
+                                 DumpData& dump_data) {
+  if (!dump_data.delta_base_update_time ||
+      dump_data.delta_count >= static_config_.max_delta_count) {
+    return false;
+  }
+  const auto base_update_time = *dump_data.delta_base_update_time;
+  // On failure the changes since the previous dump are lost, so the next dump
+  // must be a full one
+  dump_data.delta_base_update_time.reset();
+
+  const auto dump_start = std::chrono::steady_clock::now();
+
+  const auto delta_stats =
+      dump_data.locator.RegisterNewDelta(base_update_time, update_time);
+  const auto& delta_path = delta_stats.full_path;
+  auto writer = dump_data.rw_factory->CreateWriter(delta_path, scope);
+  if (!dump_data.dumpable.GetAndWriteDelta(*writer)) {
+    LOG_INFO() << Name()
+               << ": the changes since the previous dump are unknown, writing "
+                  "a full dump";
+    return false;
+  }
+  writer->Finish();
+  const auto dump_size = boost::filesystem::file_size(delta_path);
+
+  LOG_INFO() << Name() << ": a new delta dump has been written at \""
+             << delta_path << '"';
+
+  dump_data.delta_base_update_time = base_update_time;
+  ++dump_data.delta_count;
+
   statistics_.last_written_size = dump_size;
   statistics_.last_nontrivial_write_duration =
       std::chrono::duration_cast<std::chrono::milliseconds>(
           std::chrono::steady_clock::now() - dump_start);
   statistics_.last_nontrivial_write_start_time = dump_start;
+  return true;
+}
+
+std::optional<TimePoint> Dumper::Impl::LoadDeltas(
+    DumpData& dump_data, const DumpFileStats& base_stats) {
+  std::optional<TimePoint> update_time;
+  uint64_t delta_count = 0;
+  dump_data.delta_base_update_time.reset();
+  dump_data.delta_count = 0;
+
+  try {
+    for (const auto& delta : dump_data.locator.GetDeltas(base_stats.update_time)) {
+      auto reader = dump_data.rw_factory->CreateReader(delta.full_path);
+      dump_data.dumpable.ReadAndApplyDelta(*reader);
+      reader->Finish();
+      update_time = delta.update_time;
+      ++delta_count;
+    }
+  } catch (const std::exception& ex) {
+    // The data of the previously applied deltas is consistent, keep it
+    LOG_ERROR() << Name() << ": error while reading a delta dump. Reason: "
+                << ex;
+    return update_time;
+  }
+
+  if (delta_count != 0) {
+    LOG_INFO() << Name() << ": " << delta_count
+               << " delta dumps have been applied";
+  }
+  if (static_config_.max_delta_count != 0) {
+    dump_data.delta_base_update_time = base_stats.update_time;
+    dump_data.delta_count = delta_count;
+  }
+  return update_time;
 }
 
 std::optional<TimePoint> Dumper::Impl::LoadFromDump(
@@ -451,7 +620,7 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(
 
   const auto load_start = std::chrono::steady_clock::now();
 
-  const std::optional<TimePoint> update_time =
+  std::optional<TimePoint> update_time =
       utils::CriticalAsync(fs_task_processor_, read_span_name_, [&] {
         auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime();
 
@@ -465,7 +634,9 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(
           reader->Finish();
 
           LOG_INFO() << Name() << ": a dump has been loaded successfully";
-          return std::optional{dump_stats->update_time};
+          const auto delta_update_time = LoadDeltas(dump_data, *dump_stats);
+          return std::optional{
+              delta_update_time.value_or(dump_stats->update_time)};
         } catch (const std::exception& ex) {
           LOG_ERROR() << Name()
                       << ": error while reading a dump. Reason: " << ex;
@@ -473,22 +644,91 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(
         }
       }).Get();
 
+  auto source = LoadSource::kDump;
+  if (!update_time && http_client_) {
+    update_time = LoadFromPeers(dump_data);
+    source = LoadSource::kSnapshot;
+  }
+
   if (!update_time) return {};
-  const UpdateTime update_times{*update_time, *update_time};
+  OnDataLoaded(dump_data, *update_time, source, load_start);
+  return update_time;
+}
+
+std::optional<TimePoint> Dumper::Impl::LoadFromPeers(DumpData& dump_data) {
+  UASSERT(http_client_ && static_config_.peer_warmup);
+  const auto& peer_warmup = *static_config_.peer_warmup;
+
+  for (const auto& url : peer_warmup.urls) {
+    try {
+      const auto deadline = engine::Deadline::FromDuration(peer_warmup.timeout);
+      auto response =
+          http_client_->CreateRequest()
+              .get(http::MakeUrl(url, {{"name", Name()}}))
+              .timeout(peer_warmup.timeout)
+              .async_perform_stream_body(
+                  concurrent::StringStreamQueue::Create());
+      const auto status_code = response.StatusCode();
+      if (status_code != clients::http::Status::OK) {
+        throw Error(fmt::format("Unexpected status code {}",
+                                static_cast<int>(status_code)));
+      }
+
+      HttpSnapshotReader reader{std::move(response), deadline};
+      const auto update_time = DoReadSnapshot(dump_data, reader);
+      LOG_INFO() << Name() << ": a snapshot has been loaded from " << url;
+      return update_time;
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << Name() << ": failed to load a snapshot from " << url
+                    << ". Reason: " << ex;
+    }
+  }
+  return {};
+}
+
+TimePoint Dumper::Impl::DoReadSnapshot(DumpData& dump_data, Reader& reader) {
+  const auto format_version = reader.Read<uint64_t>();
+  if (format_version != static_config_.dump_format_version) {
+    throw Error(fmt::format(
+        "{}: the snapshot has format-version {} instead of {}", Name(),
+        format_version, static_config_.dump_format_version));
+  }
+  const auto update_time = reader.Read<TimePoint>();
+
+  // The entity forgets the previous changes, the old deltas chain is broken
+  dump_data.delta_base_update_time.reset();
+  dump_data.delta_count = 0;
+
+  dump_data.dumpable.ReadAndSet(reader);
+  if (reader.Read<uint64_t>() != kSnapshotEndMarker) {
+    throw Error(fmt::format("{}: the snapshot is corrupted", Name()));
+  }
+  reader.Finish();
+  return update_time;
+}
+
+void Dumper::Impl::OnDataLoaded(
+    DumpData& dump_data, TimePoint update_time, LoadSource source,
+    std::chrono::steady_clock::time_point load_start) {
+  const UpdateTime update_times{update_time, update_time};
 
   {
     auto update_data = update_data_.Lock();
     update_data->update_time = update_times;
     update_data->is_current_from_dump = true;
   }
-  // So that we don't attempt to write the dump we've just read
-  dump_data.dumped_update_time = update_times;
+  if (source == LoadSource::kDump) {
+    // So that we don't attempt to write the dump we've just read
+    dump_data.dumped_update_time = update_times;
+  } else {
+    // The snapshot is stored as a local dump by the next write
+    dump_data.dumped_update_time.reset();
+  }
 
   statistics_.is_loaded = true;
   statistics_.load_duration =
       std::chrono::duration_cast<std::chrono::milliseconds>(
           std::chrono::steady_clock::now() - load_start);
-  return update_time;
 }
 
 Dumper::Dumper(const Config& initial_config,
@@ -498,7 +738,8 @@ Dumper::Dumper(const Config& initial_config,
                utils::statistics::Storage& statistics_storage,
                testsuite::DumpControl& dump_control, DumpableEntity& dumpable)
     : impl_(initial_config, std::move(rw_factory), fs_task_processor,
-            config_source, statistics_storage, dump_control, dumpable, *this) {}
+            config_source, statistics_storage, dump_control, dumpable,
+            /*http_client=*/nullptr, *this) {}
 
 Dumper::Dumper(const components::ComponentConfig& config,
                const components::ComponentContext& context,
@@ -514,7 +755,12 @@ Dumper::Dumper(const Config& initial_config,
             context.FindComponent<components::StatisticsStorage>().GetStorage(),
             context.FindComponent<components::TestsuiteSupport>()
                 .GetDumpControl(),
-            dumpable, *this) {}
+            dumpable,
+            initial_config.peer_warmup
+                ? &context.FindComponent<components::HttpClient>()
+                       .GetHttpClient()
+                : nullptr,
+            *this) {}
 
 Dumper::~Dumper() = default;
 
@@ -522,6 +768,12 @@ const std::string& Dumper::Name() const { return impl_->Name(); }
 
 std::optional<TimePoint> Dumper::ReadDump() { return impl_->ReadDump(); }
 
+void Dumper::WriteSnapshot(Writer& writer) { impl_->WriteSnapshot(writer); }
+
+TimePoint Dumper::ReadSnapshot(Reader& reader) {
+  return impl_->ReadSnapshot(reader);
+}
+
 void Dumper::WriteDumpSyncDebug() { impl_->WriteDumpSyncDebug(); }
 
 void Dumper::ReadDumpDebug() { impl_->ReadDumpDebug(); }
@@ -562,6 +814,10 @@ properties:
                 type: integer
                 description: Old dumps over the limit are removed from disk
                 defaultDescription: 1
+            max-delta-count:
+                type: integer
+                description: Number of delta dumps written on top of a full dump before the next full dump, 0 disables delta dumps
+                defaultDescription: 0
             min-interval:
                 type: string
                 description: "`WriteDumpAsync` calls performed in a fast succession are ignored"
@@ -574,6 +830,46 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            read-with-mmap:
+                type: boolean
+                description: Whether to read not encrypted dumps through a memory mapping of the file
+                defaultDescription: false
+            compression:
+                type: object
+                description: Enables the block-based zstd compression of the dump
+                additionalProperties: false
+                properties:
+                    level:
+                        type: integer
+                        description: zstd compression level from 1 to 22
+                        defaultDescription: 1
+                    block-size:
+                        type: integer
+                        description: Size in bytes of the uncompressed data blocks, that are compressed independently
+                        defaultDescription: 1048576
+                    parallelism:
+                        type: integer
+                        description: Number of blocks that are compressed or decompressed simultaneously
+                        defaultDescription: 4
+                    task-processor:
+                        type: string
+                        description: "`TaskProcessor` for the (de)compression"
+                        defaultDescription: value of fs-task-processor
+            peer-warmup:
+                type: object
+                description: Enables loading the data from an already running instance if there is no suitable dump
+                additionalProperties: false
+                properties:
+                    urls:
+                        type: array
+                        description: URLs of handler-dump-snapshot of the instances to try, in order
+                        items:
+                            type: string
+                            description: URL of handler-dump-snapshot
+                    timeout:
+                        type: string
+                        description: Timeout of the whole transfer of a snapshot from an instance
+                        defaultDescription: 1m
 )");
 }
 
@@ -2,6 +2,9 @@
 
 #include <atomic>
 #include <chrono>
+#include <map>
+#include <optional>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
@@ -10,6 +13,7 @@
 #include <userver/dump/common.hpp>
 #include <userver/dump/common_containers.hpp>
 #include <userver/dump/factory.hpp>
+#include <userver/dump/operations_mock.hpp>
 #include <userver/dump/test_helpers.hpp>
 #include <userver/dynamic_config/storage_mock.hpp>
 #include <userver/engine/get_all.hpp>
@@ -20,6 +24,7 @@
 #include <userver/testsuite/dump_control.hpp>
 #include <userver/utest/assert_macros.hpp>
 #include <userver/utest/utest.hpp>
+#include <userver/utils/algo.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/atomic.hpp>
 #include <userver/utils/mock_now.hpp>
@@ -349,6 +354,241 @@ UTEST_F(DumperFixtureNonPeriodic, ForcedReadsEnabled) {
   EXPECT_EQ(GetDumpable().write_count, 0);
 }
 
+UTEST_F(DumperFixtureNonPeriodic, Snapshot) {
+  auto dumper = MakeDumper();
+  const auto update_time = Now();
+  GetDumpable().value = 42;
+  dumper.OnUpdateCompleted(update_time, dump::UpdateType::kModified);
+
+  dump::MockWriter writer;
+  EXPECT_TRUE(GetDumpControl().WriteSnapshot(dumper.Name(), writer));
+  const auto snapshot = std::move(writer).Extract();
+  EXPECT_EQ(GetDumpable().write_count, 1);
+
+  dump::MockWriter unknown_writer;
+  EXPECT_FALSE(GetDumpControl().WriteSnapshot("unknown", unknown_writer));
+
+  GetDumpable().value = 0;
+  dump::MockReader reader{snapshot};
+  EXPECT_EQ(dumper.ReadSnapshot(reader), update_time);
+  EXPECT_EQ(GetDumpable().value, 42);
+
+  dump::MockReader truncated_reader{snapshot.substr(0, snapshot.size() - 1)};
+  EXPECT_THROW(dumper.ReadSnapshot(truncated_reader), dump::Error);
+
+  // Snapshots are not written as dumps
+  EXPECT_EQ(dump::FilenamesInDirectory(GetRoot(), dumper.Name()),
+            std::set<std::string>{});
+}
+
+UTEST_F(DumperFixtureNonPeriodic, SnapshotFormatVersion) {
+  auto dumper = MakeDumper();
+  dump::MockWriter writer;
+  writer.Write(uint64_t{1});
+  writer.Write(Now());
+  writer.Write(42);
+  dump::MockReader reader{std::move(writer).Extract()};
+  UEXPECT_THROW_MSG(dumper.ReadSnapshot(reader), dump::Error,
+                    "the snapshot has format-version 1 instead of 0");
+  EXPECT_EQ(GetDumpable().read_count, 0);
+}
+
+namespace {
+
+struct DeltaEntity final : public dump::DumpableEntity {
+  void GetAndWrite(dump::Writer& writer) const override {
+    writer.Write(data);
+    changed_keys.clear();
+    changes_known = true;
+    ++write_count;
+  }
+
+  void ReadAndSet(dump::Reader& reader) override {
+    data = reader.Read<std::map<int, int>>();
+    changes_known = true;
+    ++read_count;
+  }
+
+  bool GetAndWriteDelta(dump::Writer& writer) const override {
+    if (!changes_known) return false;
+    writer.Write(changed_keys.size());
+    for (const auto key : changed_keys) {
+      writer.Write(key);
+      writer.Write(utils::FindOptional(data, key));
+    }
+    changed_keys.clear();
+    ++delta_write_count;
+    return true;
+  }
+
+  void ReadAndApplyDelta(dump::Reader& reader) override {
+    const auto size = reader.Read<std::size_t>();
+    for (std::size_t i = 0; i < size; ++i) {
+      const auto key = reader.Read<int>();
+      if (auto value = reader.Read<std::optional<int>>()) {
+        data[key] = *value;
+      } else {
+        data.erase(key);
+      }
+    }
+    ++delta_read_count;
+  }
+
+  void Change(int key, std::optional<int> value) {
+    if (value) {
+      data[key] = *value;
+    } else {
+      data.erase(key);
+    }
+    changed_keys.push_back(key);
+  }
+
+  std::map<int, int> data;
+  mutable std::vector<int> changed_keys;
+  mutable bool changes_known{false};
+  mutable int write_count{0};
+  mutable int delta_write_count{0};
+  int read_count{0};
+  int delta_read_count{0};
+};
+
+const std::string kDeltaConfig = R"(
+enable: true
+world-readable: true
+format-version: 0
+max-age:  # unlimited
+max-count: 1
+max-delta-count: 2
+)";
+
+class DumperDeltaFixture : public ::testing::Test {
+ protected:
+  DumperDeltaFixture()
+      : root_(fs::blocking::TempDirectory::Create()),
+        config_(dump::ConfigFromYaml(kDeltaConfig, root_, "delta")) {}
+
+  dump::Dumper MakeDumper(DeltaEntity& dumpable) {
+    return dump::Dumper{
+        config_,
+        dump::CreateDefaultOperationsFactory(config_),
+        engine::current_task::GetTaskProcessor(),
+        config_storage_.GetSource(),
+        statistics_storage_,
+        control_,
+        dumpable,
+    };
+  }
+
+  void WriteDump(dump::Dumper& dumper, dump::TimePoint update_time) {
+    dumper.OnUpdateCompleted(update_time, dump::UpdateType::kModified);
+    dumper.WriteDumpSyncDebug();
+  }
+
+ private:
+  fs::blocking::TempDirectory root_;
+  dump::Config config_;
+  testsuite::DumpControl control_{
+      testsuite::DumpControl::PeriodicsMode::kDisabled};
+  utils::statistics::Storage statistics_storage_;
+  dynamic_config::StorageMock config_storage_{{dump::kConfigSet, {}}};
+};
+
+}  // namespace
+
+UTEST_F(DumperDeltaFixture, WriteAndReadDeltas) {
+  const auto base_time = Now();
+  DeltaEntity entity;
+  auto dumper = MakeDumper(entity);
+  EXPECT_EQ(dumper.ReadDump(), std::nullopt);
+
+  entity.Change(1, 1);
+  entity.Change(2, 2);
+  WriteDump(dumper, base_time);
+  EXPECT_EQ(entity.write_count, 1);
+
+  entity.Change(3, 3);
+  WriteDump(dumper, base_time + 1s);
+  entity.Change(1, std::nullopt);
+  entity.Change(2, 20);
+  WriteDump(dumper, base_time + 2s);
+  EXPECT_EQ(entity.write_count, 1);
+  EXPECT_EQ(entity.delta_write_count, 2);
+
+  {
+    DeltaEntity restored;
+    auto restored_dumper = MakeDumper(restored);
+    EXPECT_EQ(restored_dumper.ReadDump(), base_time + 2s);
+    EXPECT_EQ(restored.read_count, 1);
+    EXPECT_EQ(restored.delta_read_count, 2);
+    EXPECT_EQ(restored.data, (std::map<int, int>{{2, 20}, {3, 3}}));
+  }
+
+  // max-delta-count is reached, the deltas are compacted into a full dump
+  entity.Change(4, 4);
+  WriteDump(dumper, base_time + 3s);
+  EXPECT_EQ(entity.write_count, 2);
+  EXPECT_EQ(entity.delta_write_count, 2);
+
+  entity.Change(3, std::nullopt);
+  WriteDump(dumper, base_time + 4s);
+  EXPECT_EQ(entity.delta_write_count, 3);
+
+  DeltaEntity restored;
+  auto restored_dumper = MakeDumper(restored);
+  EXPECT_EQ(restored_dumper.ReadDump(), base_time + 4s);
+  EXPECT_EQ(restored.delta_read_count, 1);
+  EXPECT_EQ(restored.data, (std::map<int, int>{{2, 20}, {4, 4}}));
+}
+
+UTEST_F(DumperDeltaFixture, UnknownChanges) {
+  const auto base_time = Now();
+  DeltaEntity entity;
+  auto dumper = MakeDumper(entity);
+  dumper.ReadDump();
+
+  entity.Change(1, 1);
+  WriteDump(dumper, base_time);
+  entity.Change(2, 2);
+  WriteDump(dumper, base_time + 1s);
+  EXPECT_EQ(entity.delta_write_count, 1);
+
+  // E.g. a full update has happened
+  entity.changes_known = false;
+  entity.Change(3, 3);
+  WriteDump(dumper, base_time + 2s);
+  EXPECT_EQ(entity.write_count, 2);
+  EXPECT_EQ(entity.delta_write_count, 1);
+
+  DeltaEntity restored;
+  auto restored_dumper = MakeDumper(restored);
+  EXPECT_EQ(restored_dumper.ReadDump(), base_time + 2s);
+  EXPECT_EQ(restored.delta_read_count, 0);
+  EXPECT_EQ(restored.data, entity.data);
+}
+
+UTEST_F(DumperDeltaFixture, BumpTimeWithDeltas) {
+  const auto base_time = Now();
+  DeltaEntity entity;
+  auto dumper = MakeDumper(entity);
+  dumper.ReadDump();
+
+  entity.Change(1, 1);
+  WriteDump(dumper, base_time);
+  entity.Change(2, 2);
+  WriteDump(dumper, base_time + 1s);
+
+  // The data is up-to-date, an empty delta is written
+  dumper.OnUpdateCompleted(base_time + 2s, dump::UpdateType::kAlreadyUpToDate);
+  dumper.WriteDumpSyncDebug();
+  EXPECT_EQ(entity.write_count, 1);
+  EXPECT_EQ(entity.delta_write_count, 2);
+
+  DeltaEntity restored;
+  auto restored_dumper = MakeDumper(restored);
+  EXPECT_EQ(restored_dumper.ReadDump(), base_time + 2s);
+  EXPECT_EQ(restored.data, entity.data);
+}
+
 namespace {
 
 /// [Sample Dumper usage]
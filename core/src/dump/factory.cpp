@@ -1,8 +1,10 @@
 #include <userver/dump/factory.hpp>
 
 #include <dump/secdist.hpp>
+#include <userver/dump/operations_compressed.hpp>
 #include <userver/dump/operations_encrypted.hpp>
 #include <userver/dump/operations_file.hpp>
+#include <userver/engine/task/task_base.hpp>
 #include <userver/storages/secdist/component.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,9 +21,7 @@ boost::filesystem::perms GetPerms(const Config& config) {
     return perms::owner_read;
 }
 
-}  // namespace
-
-std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
+std::unique_ptr<dump::OperationsFactory> MakeFileOperationsFactory(
     const Config& config, const components::ComponentContext& context) {
   auto dump_perms = GetPerms(config);
 
@@ -31,14 +31,35 @@ std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
     return std::make_unique<dump::EncryptedOperationsFactory>(
         std::move(secret_key), dump_perms);
   } else {
-    return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+    return std::make_unique<dump::FileOperationsFactory>(
+        dump_perms, config.read_with_mmap);
   }
 }
 
+}  // namespace
+
+std::unique_ptr<dump::OperationsFactory> CreateOperationsFactory(
+    const Config& config, const components::ComponentContext& context) {
+  auto factory = MakeFileOperationsFactory(config, context);
+  if (!config.compression) return factory;
+
+  return std::make_unique<dump::CompressedOperationsFactory>(
+      std::move(factory), *config.compression,
+      context.GetTaskProcessor(config.compression->task_processor));
+}
+
 std::unique_ptr<dump::OperationsFactory> CreateDefaultOperationsFactory(
     const Config& config) {
   auto dump_perms = GetPerms(config);
-  return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+  std::unique_ptr<dump::OperationsFactory> factory =
+      std::make_unique<dump::FileOperationsFactory>(dump_perms,
+                                                    config.read_with_mmap);
+  if (!config.compression) return factory;
+
+  // Compresses on the current TaskProcessor, for tests
+  return std::make_unique<dump::CompressedOperationsFactory>(
+      std::move(factory), *config.compression,
+      engine::current_task::GetTaskProcessor());
 }
 
 }  // namespace dump
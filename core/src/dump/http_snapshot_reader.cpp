@@ -0,0 +1,57 @@
+#include <dump/http_snapshot_reader.hpp>
+
+#include <algorithm>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+HttpSnapshotReader::HttpSnapshotReader(
+    clients::http::StreamedResponse&& response, engine::Deadline deadline)
+    : response_(std::move(response)), deadline_(deadline) {}
+
+void HttpSnapshotReader::Finish() {
+  if (buffer_pos_ != buffer_.size()) {
+    throw Error("Unexpected extra data at the end of the snapshot");
+  }
+  while (ReadChunk()) {
+    if (!chunk_.empty()) {
+      throw Error("Unexpected extra data at the end of the snapshot");
+    }
+  }
+}
+
+std::string_view HttpSnapshotReader::ReadRaw(std::size_t max_size) {
+  if (buffer_.size() - buffer_pos_ < max_size) {
+    // Only the unread data is kept, the previously returned memory may be
+    // invalidated
+    buffer_.erase(0, buffer_pos_);
+    buffer_pos_ = 0;
+    while (buffer_.size() < max_size && ReadChunk()) {
+      buffer_.append(chunk_);
+    }
+  }
+
+  const auto size = std::min(max_size, buffer_.size() - buffer_pos_);
+  const std::string_view result{buffer_.data() + buffer_pos_, size};
+  buffer_pos_ += size;
+  return result;
+}
+
+bool HttpSnapshotReader::ReadChunk() {
+  if (is_body_finished_) return false;
+
+  if (!response_.ReadChunk(chunk_, deadline_)) {
+    if (deadline_.IsReached()) {
+      throw Error("Timed out while receiving the snapshot");
+    }
+    is_body_finished_ = true;
+    return false;
+  }
+  return true;
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
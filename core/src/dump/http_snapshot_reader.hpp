@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <userver/clients/http/streamed_response.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// Reads a snapshot from the body of a HTTP response, as it is received
+class HttpSnapshotReader final : public Reader {
+ public:
+  HttpSnapshotReader(clients::http::StreamedResponse&& response,
+                     engine::Deadline deadline);
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  /// @returns `false` at the end of the body
+  bool ReadChunk();
+
+  clients::http::StreamedResponse response_;
+  engine::Deadline deadline_;
+  std::string buffer_;
+  std::size_t buffer_pos_{0};
+  std::string chunk_;
+  bool is_body_finished_{false};
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
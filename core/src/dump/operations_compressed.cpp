@@ -0,0 +1,194 @@
+#include <userver/dump/operations_compressed.hpp>
+
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <compression/zstd.hpp>
+#include <userver/dump/common.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+// Format: kFormatMarker, the maximum block size, then the blocks, each is its
+// uncompressed size and the size-prefixed compressed data, then 0 as the end
+// marker.
+namespace {
+constexpr std::uint64_t kFormatMarker = 0x7a737464756d7001;  // "zstdump" 1
+}
+
+CompressedWriter::CompressedWriter(std::unique_ptr<Writer> writer,
+                                   const CompressionConfig& config,
+                                   engine::TaskProcessor& task_processor)
+    : writer_(std::move(writer)),
+      config_(config),
+      task_processor_(task_processor) {
+  UASSERT(writer_);
+  UASSERT(config_.block_size != 0 && config_.parallelism != 0);
+  block_.reserve(config_.block_size);
+  writer_->Write(kFormatMarker);
+  writer_->Write(config_.block_size);
+}
+
+CompressedWriter::~CompressedWriter() = default;
+
+void CompressedWriter::WriteRaw(std::string_view data) {
+  while (!data.empty()) {
+    const auto size = std::min(data.size(), config_.block_size - block_.size());
+    block_.append(data.data(), size);
+    data.remove_prefix(size);
+    if (block_.size() == config_.block_size) StartBlockCompression();
+  }
+}
+
+void CompressedWriter::Finish() {
+  if (!block_.empty()) StartBlockCompression();
+  while (!pending_blocks_.empty()) WriteCompressedBlock();
+  writer_->Write(std::uint64_t{0});
+  writer_->Finish();
+}
+
+void CompressedWriter::StartBlockCompression() {
+  if (pending_blocks_.size() == config_.parallelism) WriteCompressedBlock();
+
+  const std::uint64_t size = block_.size();
+  pending_blocks_.push_back(
+      {size, utils::Async(task_processor_, "dump_compress_block",
+                          [block = std::exchange(block_, {}),
+                           level = config_.level] {
+                            return compression::zstd::Compress(block, level);
+                          })});
+  block_.reserve(config_.block_size);
+}
+
+void CompressedWriter::WriteCompressedBlock() {
+  UASSERT(!pending_blocks_.empty());
+  auto block = std::move(pending_blocks_.front());
+  pending_blocks_.pop_front();
+
+  std::string compressed;
+  try {
+    compressed = block.compressed.Get();
+  } catch (const compression::CompressionError& ex) {
+    throw Error(fmt::format("Failed to compress a dump block: {}", ex.what()));
+  }
+  writer_->Write(block.size);
+  writer_->Write(compressed);
+}
+
+CompressedReader::CompressedReader(std::unique_ptr<Reader> reader,
+                                   const CompressionConfig& config,
+                                   engine::TaskProcessor& task_processor)
+    : reader_(std::move(reader)),
+      config_(config),
+      task_processor_(task_processor) {
+  UASSERT(reader_);
+  UASSERT(config_.parallelism != 0);
+  const auto marker = reader_->Read<std::uint64_t>();
+  if (marker != kFormatMarker) {
+    throw Error(
+        "The dump is not compressed, or it is compressed in an unknown format");
+  }
+  max_block_size_ = reader_->Read<std::uint64_t>();
+  StartBlockDecompressions();
+}
+
+CompressedReader::~CompressedReader() = default;
+
+std::string_view CompressedReader::ReadRaw(std::size_t max_size) {
+  if (block_.size() - block_position_ >= max_size) {
+    const std::string_view result{block_.data() + block_position_, max_size};
+    block_position_ += max_size;
+    return result;
+  }
+
+  // The data spans several blocks, collect it into a separate buffer
+  curr_chunk_.assign(block_, block_position_);
+  block_position_ = block_.size();
+  while (curr_chunk_.size() < max_size && NextBlock()) {
+    const auto size = std::min(max_size - curr_chunk_.size(), block_.size());
+    curr_chunk_.append(block_.data(), size);
+    block_position_ = size;
+  }
+  return curr_chunk_;
+}
+
+void CompressedReader::Finish() {
+  if (block_position_ != block_.size() || NextBlock()) {
+    throw Error("Unexpected extra data at the end of the compressed dump");
+  }
+  reader_->Finish();
+}
+
+void CompressedReader::StartBlockDecompressions() {
+  while (!blocks_ended_ && pending_blocks_.size() < config_.parallelism) {
+    const auto size = reader_->Read<std::uint64_t>();
+    if (size == 0) {
+      blocks_ended_ = true;
+      return;
+    }
+    if (size > max_block_size_) {
+      throw Error(fmt::format(
+          "Compressed dump block size {} exceeds the block-size {} of the dump",
+          size, max_block_size_));
+    }
+
+    pending_blocks_.push_back(utils::Async(
+        task_processor_, "dump_decompress_block",
+        [compressed = reader_->Read<std::string>(), size] {
+          auto block = compression::zstd::Decompress(compressed, size);
+          if (block.size() != size) {
+            throw Error(fmt::format(
+                "Unexpected compressed dump block size: expected={}, actual={}",
+                size, block.size()));
+          }
+          return block;
+        }));
+  }
+}
+
+bool CompressedReader::NextBlock() {
+  if (pending_blocks_.empty()) return false;
+  auto task = std::move(pending_blocks_.front());
+  pending_blocks_.pop_front();
+  StartBlockDecompressions();
+
+  try {
+    block_ = task.Get();
+  } catch (const compression::DecompressionError& ex) {
+    throw Error(
+        fmt::format("Failed to decompress a dump block: {}", ex.what()));
+  }
+  block_position_ = 0;
+  return true;
+}
+
+CompressedOperationsFactory::CompressedOperationsFactory(
+    std::unique_ptr<OperationsFactory> factory, const CompressionConfig& config,
+    engine::TaskProcessor& task_processor)
+    : factory_(std::move(factory)),
+      config_(config),
+      task_processor_(task_processor) {
+  UASSERT(factory_);
+}
+
+std::unique_ptr<Reader> CompressedOperationsFactory::CreateReader(
+    std::string full_path) {
+  return std::make_unique<CompressedReader>(
+      factory_->CreateReader(std::move(full_path)), config_, task_processor_);
+}
+
+std::unique_ptr<Writer> CompressedOperationsFactory::CreateWriter(
+    std::string full_path, tracing::ScopeTime& scope) {
+  return std::make_unique<CompressedWriter>(
+      factory_->CreateWriter(std::move(full_path), scope), config_,
+      task_processor_);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
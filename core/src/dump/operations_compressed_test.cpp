@@ -0,0 +1,122 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations_compressed.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/engine/task/task_base.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+dump::CompressionConfig MakeConfig(std::uint64_t block_size,
+                                   std::uint64_t parallelism) {
+  dump::CompressionConfig config;
+  config.block_size = block_size;
+  config.parallelism = parallelism;
+  return config;
+}
+
+void WriteCompressed(const std::string& path,
+                     const dump::CompressionConfig& config,
+                     const std::vector<std::string>& values) {
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::CompressedWriter writer(
+      std::make_unique<dump::FileWriter>(
+          path, boost::filesystem::perms::owner_read, scope_time),
+      config, engine::current_task::GetTaskProcessor());
+  for (const auto& value : values) writer.Write(value);
+  writer.Finish();
+}
+
+dump::CompressedReader MakeReader(const std::string& path,
+                                  const dump::CompressionConfig& config) {
+  return dump::CompressedReader(std::make_unique<dump::FileReader>(path),
+                                config,
+                                engine::current_task::GetTaskProcessor());
+}
+
+std::vector<std::string> MakeValues() {
+  std::vector<std::string> values;
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(std::string(i % 100, static_cast<char>('a' + i % 26)) +
+                     std::to_string(i));
+  }
+  return values;
+}
+
+}  // namespace
+
+UTEST(DumpCompressed, Smoke) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+  const auto config = MakeConfig(1024 * 1024, 4);
+
+  WriteCompressed(path, config, {"abc", std::string(10000, 'x')});
+  EXPECT_LT(boost::filesystem::file_size(path), 1000);
+
+  auto reader = MakeReader(path, config);
+  EXPECT_EQ(reader.Read<std::string>(), "abc");
+  EXPECT_EQ(reader.Read<std::string>(), std::string(10000, 'x'));
+  UEXPECT_THROW(reader.Read<std::string>(), dump::Error);
+  UEXPECT_NO_THROW(reader.Finish());
+}
+
+UTEST(DumpCompressed, Empty) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+  const auto config = MakeConfig(1024, 4);
+
+  WriteCompressed(path, config, {});
+  auto reader = MakeReader(path, config);
+  UEXPECT_NO_THROW(reader.Finish());
+}
+
+UTEST_MT(DumpCompressed, ManyBlocks, 4) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+  const auto values = MakeValues();
+
+  // Values span several small blocks
+  WriteCompressed(path, MakeConfig(64, 3), values);
+
+  // The block size is taken from the dump
+  auto reader = MakeReader(path, MakeConfig(1024 * 1024, 2));
+  for (const auto& value : values) {
+    EXPECT_EQ(reader.Read<std::string>(), value);
+  }
+  UEXPECT_NO_THROW(reader.Finish());
+}
+
+UTEST(DumpCompressed, UnreadData) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+  const auto config = MakeConfig(16, 2);
+
+  WriteCompressed(path, config, MakeValues());
+  auto reader = MakeReader(path, config);
+  EXPECT_EQ(reader.Read<std::string>(), MakeValues().front());
+  UEXPECT_THROW(reader.Finish(), dump::Error);
+}
+
+UTEST(DumpCompressed, NotCompressed) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  writer.Write(std::string{"abc"});
+  writer.Finish();
+
+  UEXPECT_THROW(MakeReader(path, MakeConfig(1024, 4)), dump::Error);
+}
+
+USERVER_NAMESPACE_END
@@ -1,42 +1,77 @@
 #include <userver/dump/operations_file.hpp>
 
+#include <sys/mman.h>
+
 #include <algorithm>
 #include <stdexcept>
+#include <string>
 #include <utility>
 
 #include <fmt/format.h>
 
+#include <userver/fs/blocking/file_descriptor.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/utils/assert.hpp>
+#include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace dump {
 
 namespace {
+
 constexpr std::size_t kCheckTimeAfterBytes{1 << 15};
-}
+// Small writes and reads are gathered into operations of this size
+constexpr std::size_t kBufferSize{256 * 1024};
 
-FileWriter::FileWriter(std::string path, boost::filesystem::perms perms,
-                       tracing::ScopeTime& scope)
-    : final_path_(std::move(path)),
-      path_(final_path_ + ".tmp"),
-      perms_(perms),
-      cpu_relax_(kCheckTimeAfterBytes, &scope) {
+engine::io::File OpenForWrite(const std::string& path,
+                              boost::filesystem::perms perms) {
   constexpr fs::blocking::OpenMode mode{
       fs::blocking::OpenFlag::kWrite, fs::blocking::OpenFlag::kExclusiveCreate};
-  const auto tmp_perms = perms_ | boost::filesystem::perms::owner_write;
+  const auto tmp_perms = perms | boost::filesystem::perms::owner_write;
 
   try {
-    file_ = fs::blocking::CFile{path_, mode, tmp_perms};
+    return engine::io::File::Open(nullptr, path, mode, tmp_perms);
   } catch (const std::exception& ex) {
     throw Error(fmt::format("Failed to open the dump file for write \"{}\": {}",
-                            path_, ex.what()));
+                            path, ex.what()));
+  }
+}
+
+engine::io::File OpenForRead(const std::string& path) {
+  try {
+    return engine::io::File::Open(nullptr, path,
+                                  fs::blocking::OpenFlag::kRead);
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format(
+        "Failed to open the dump file for reading \"{}\". Reason: {}", path,
+        ex.what()));
   }
 }
 
+}  // namespace
+
+// The dumps are written and read in fs-task-processor, the file operations
+// are not moved to another task processor
+FileWriter::FileWriter(std::string path, boost::filesystem::perms perms,
+                       tracing::ScopeTime& scope)
+    : final_path_(std::move(path)),
+      path_(final_path_ + ".tmp"),
+      perms_(perms),
+      file_(OpenForWrite(path_, perms_)),
+      cpu_relax_(kCheckTimeAfterBytes, &scope) {
+  buffer_.reserve(kBufferSize);
+}
+
 void FileWriter::WriteRaw(std::string_view data) {
   try {
-    file_.Write(data);
+    if (buffer_.size() + data.size() > kBufferSize) FlushBuffer();
+    if (data.size() >= kBufferSize) {
+      file_.WriteAt(data, offset_);
+      offset_ += data.size();
+    } else {
+      buffer_.append(data);
+    }
   } catch (const std::exception& ex) {
     throw Error(fmt::format("Failed to write to the dump file \"{}\": {}",
                             path_, ex.what()));
@@ -44,12 +79,20 @@ void FileWriter::WriteRaw(std::string_view data) {
   cpu_relax_.Relax(data.size());
 }
 
+void FileWriter::FlushBuffer() {
+  if (buffer_.empty()) return;
+  file_.WriteAt(buffer_, offset_);
+  offset_ += buffer_.size();
+  buffer_.clear();
+}
+
 void FileWriter::Finish() {
   try {
-    // Flush must be performed at some point before Rename, otherwise after a
+    // Fsync must be performed at some point before Rename, otherwise after a
     // system's hard reset the file might end up in a state where it is renamed,
     // but truncated.
-    file_.Flush();
+    FlushBuffer();
+    file_.Fsync();
     std::move(file_).Close();
     fs::blocking::Chmod(path_, perms_);  // drop perms::owner_write
     fs::blocking::Rename(path_, final_path_);
@@ -59,49 +102,60 @@ void FileWriter::Finish() {
   }
 }
 
-FileReader::FileReader(std::string path) : path_(std::move(path)) {
-  try {
-    file_ = fs::blocking::CFile(path_, fs::blocking::OpenFlag::kRead);
-  } catch (const std::exception& ex) {
-    throw Error(fmt::format(
-        "Failed to open the dump file for reading \"{}\". Reason: {}", path_,
-        ex.what()));
-  }
+FileReader::FileReader(std::string path)
+    : path_(std::move(path)), file_(OpenForRead(path_)) {}
+
+std::size_t FileReader::GetBufferedSize() const noexcept {
+  return buffer_end_ - buffer_begin_;
 }
 
 std::string_view FileReader::ReadRaw(std::size_t max_size) {
-  // the storage of curr_chunk_ is reused between ReadRaw calls. It acts
-  // as a buffer, with its size being the capacity of the buffer.
-  if (curr_chunk_.size() < max_size) {
-    curr_chunk_.resize(
-        std::max(max_size, static_cast<std::size_t>(curr_chunk_.size() * 1.5)));
-  }
-
-  std::size_t bytes_read = 0;
-  try {
-    bytes_read = file_.Read(curr_chunk_.data(), max_size);
-  } catch (const std::exception& ex) {
-    throw Error(fmt::format("Failed to read from the dump file \"{}\": {}",
-                            path_, ex.what()));
+  // The storage of buffer_ is reused between ReadRaw calls. The data is read
+  // ahead, so that small reads do not result in separate file operations.
+  if (GetBufferedSize() < max_size) {
+    const auto buffered = GetBufferedSize();
+    std::char_traits<char>::move(buffer_.data(), buffer_.data() + buffer_begin_,
+                                 buffered);
+    buffer_begin_ = 0;
+    buffer_end_ = buffered;
+    if (buffer_.size() < max_size) {
+      buffer_.resize(std::max(max_size, kBufferSize));
+    }
+
+    try {
+      const auto bytes_read = file_.ReadAt(
+          buffer_.data() + buffer_end_, buffer_.size() - buffer_end_, offset_);
+      buffer_end_ += bytes_read;
+      offset_ += bytes_read;
+    } catch (const std::exception& ex) {
+      throw Error(fmt::format("Failed to read from the dump file \"{}\": {}",
+                              path_, ex.what()));
+    }
   }
 
-  return {curr_chunk_.data(), bytes_read};
+  const auto size = std::min(max_size, GetBufferedSize());
+  const std::string_view result{buffer_.data() + buffer_begin_, size};
+  buffer_begin_ += size;
+  return result;
 }
 
 void FileReader::Finish() {
-  std::size_t bytes_read = 0;
-
-  try {
-    char extra_byte = 0;
-    bytes_read = file_.Read(&extra_byte, 1);
-  } catch (const std::exception& ex) {
-    throw Error(fmt::format("Failed to read from the dump file \"{}\": {}",
-                            path_, ex.what()));
+  std::size_t bytes_read = GetBufferedSize();
+
+  if (bytes_read == 0) {
+    try {
+      char extra_byte = 0;
+      bytes_read = file_.ReadAt(&extra_byte, 1, offset_);
+      offset_ += bytes_read;
+    } catch (const std::exception& ex) {
+      throw Error(fmt::format("Failed to read from the dump file \"{}\": {}",
+                              path_, ex.what()));
+    }
   }
 
   if (bytes_read != 0) {
     const auto file_size = file_.GetSize();
-    const auto position = file_.GetPosition() - bytes_read;
+    const auto position = offset_ - bytes_read;
     throw Error(
         fmt::format("Unexpected extra data at the end of the dump file \"{}\": "
                     "file-size={}, position={}, unread-size={}",
@@ -116,11 +170,62 @@ void FileReader::Finish() {
   }
 }
 
-FileOperationsFactory::FileOperationsFactory(boost::filesystem::perms perms)
-    : perms_(perms) {}
+FileMmapReader::FileMmapReader(std::string path) : path_(std::move(path)) {
+  try {
+    auto fd = fs::blocking::FileDescriptor::Open(
+        path_, fs::blocking::OpenFlag::kRead);
+    size_ = fd.GetSize();
+    // mmap of an empty file fails with EINVAL
+    if (size_ != 0) {
+      void* mapping = utils::CheckSyscallNotEquals(
+          ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd.GetNative(), 0),
+          MAP_FAILED, "mapping the file");
+      data_ = static_cast<const char*>(mapping);
+      // The mapping stays valid after the file is closed
+      ::madvise(mapping, size_, MADV_SEQUENTIAL);
+    }
+    std::move(fd).Close();
+  } catch (const std::exception& ex) {
+    if (data_) ::munmap(const_cast<char*>(data_), size_);
+    throw Error(fmt::format(
+        "Failed to open the dump file for reading \"{}\". Reason: {}", path_,
+        ex.what()));
+  }
+}
+
+FileMmapReader::~FileMmapReader() {
+  if (data_) {
+    [[maybe_unused]] const int result =
+        ::munmap(const_cast<char*>(data_), size_);
+    UASSERT(result == 0);
+  }
+}
+
+std::string_view FileMmapReader::ReadRaw(std::size_t max_size) {
+  const auto size = std::min(max_size, size_ - position_);
+  const std::string_view result{data_ + position_, size};
+  position_ += size;
+  return result;
+}
+
+void FileMmapReader::Finish() {
+  if (position_ != size_) {
+    throw Error(
+        fmt::format("Unexpected extra data at the end of the dump file \"{}\": "
+                    "file-size={}, position={}, unread-size={}",
+                    path_, size_, position_, size_ - position_));
+  }
+}
+
+FileOperationsFactory::FileOperationsFactory(boost::filesystem::perms perms,
+                                             bool use_mmap_reader)
+    : perms_(perms), use_mmap_reader_(use_mmap_reader) {}
 
 std::unique_ptr<Reader> FileOperationsFactory::CreateReader(
     std::string full_path) {
+  if (use_mmap_reader_) {
+    return std::make_unique<FileMmapReader>(std::move(full_path));
+  }
   return std::make_unique<FileReader>(std::move(full_path));
 }
 
@@ -113,4 +113,69 @@ TEST(DumpOperationsFile, Underread) {
   FAIL();
 }
 
+UTEST(DumpOperationsFile, MmapReader) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  constexpr std::size_t kMaxLength = 10;
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  for (std::size_t i = 0; i <= kMaxLength; ++i) {
+    WriteStringViewUnsafe(writer, std::string(i, static_cast<char>('a' + i)));
+  }
+  writer.Finish();
+
+  dump::FileMmapReader reader(path);
+  for (std::size_t i = 0; i <= kMaxLength; ++i) {
+    EXPECT_EQ(ReadStringViewUnsafe(reader, i), std::string(i, static_cast<char>('a' + i)));
+  }
+  reader.Finish();
+}
+
+UTEST(DumpOperationsFile, MmapReaderEmptyDump) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  writer.Finish();
+
+  dump::FileMmapReader reader(path);
+  EXPECT_EQ(ReadStringViewUnsafe(reader, 0), "");
+  reader.Finish();
+}
+
+TEST(DumpOperationsFile, MmapReaderOverread) {
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), std::string(10, 'a'));
+
+  dump::FileMmapReader reader(file.GetPath());
+  EXPECT_THROW(ReadStringViewUnsafe(reader, 11), dump::Error);
+}
+
+TEST(DumpOperationsFile, MmapReaderUnderread) {
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), std::string(10, 'a'));
+
+  dump::FileMmapReader reader(file.GetPath());
+  EXPECT_EQ(ReadStringViewUnsafe(reader, 9), std::string(9, 'a'));
+  try {
+    reader.Finish();
+  } catch (const dump::Error& ex) {
+    EXPECT_TRUE(boost::regex_match(
+        ex.what(),
+        boost::regex{"Unexpected extra data at the end of the dump file "
+                     "\".+\": file-size=10, position=9, unread-size=1"}))
+        << ex.what();
+    return;
+  }
+  FAIL();
+}
+
+TEST(DumpOperationsFile, MmapReaderMissingFile) {
+  EXPECT_THROW(dump::FileMmapReader("/non-existing/dump"), dump::Error);
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,45 @@
+#include <userver/dump/probabilistic_filters.hpp>
+
+#include <string>
+
+#include <userver/dump/test_helpers.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(DumpProbabilisticFilters, BlockedBloomFilter) {
+  using Filter = utils::BlockedBloomFilter<std::string>;
+  Filter filter{1000};
+  for (int i = 0; i < 1000; ++i) filter.Insert(std::to_string(i));
+
+  const auto restored = dump::FromBinary<Filter>(dump::ToBinary(filter));
+  EXPECT_EQ(restored.GetRawData(), filter.GetRawData());
+  EXPECT_EQ(restored.GetSize(), filter.GetSize());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(restored.MayContain(std::to_string(i)));
+  }
+}
+
+TEST(DumpProbabilisticFilters, CuckooFilter) {
+  using Filter = utils::CuckooFilter<std::string>;
+  Filter filter{1000};
+  for (int i = 0; i < 1000; ++i) ASSERT_TRUE(filter.Insert(std::to_string(i)));
+
+  auto restored = dump::FromBinary<Filter>(dump::ToBinary(filter));
+  EXPECT_EQ(restored.GetRawData(), filter.GetRawData());
+  EXPECT_EQ(restored.GetSize(), filter.GetSize());
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(restored.Erase(std::to_string(i)));
+  }
+  EXPECT_EQ(restored.GetSize(), 0);
+}
+
+TEST(DumpProbabilisticFilters, Corrupted) {
+  const auto data = dump::ToBinary(std::string(7, 'x'));
+  EXPECT_THROW(dump::FromBinary<utils::CuckooFilter<int>>(data), dump::Error);
+  EXPECT_THROW(dump::FromBinary<utils::BlockedBloomFilter<int>>(
+                   dump::ToBinary(std::size_t{1}) + data),
+               dump::Error);
+}
+
+USERVER_NAMESPACE_END
@@ -2,11 +2,13 @@
 
 #include <vector>
 
+#include <userver/dynamic_config/impl/snapshot.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/dynamic_config/source.hpp>
 #include <userver/dynamic_config/storage_mock.hpp>
 #include <userver/dynamic_config/test_helpers.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value_builder.hpp>
 
 using namespace std::chrono_literals;
 
@@ -504,6 +506,78 @@ UTEST(DynamicConfig, JsonConfig) {
   EXPECT_EQ(snapshot[kJsonConfig], kJson);
 }
 
+UTEST(DynamicConfig, GetCopyAfterUpdate) {
+  dynamic_config::StorageMock storage{{kIntConfig, 1}, {kBoolConfig, false}};
+  const auto source = storage.GetSource();
+  EXPECT_EQ(source.GetCopy(kIntConfig), 1);
+  EXPECT_EQ(source.GetCopy(kBoolConfig), false);
+
+  storage.Extend({{kIntConfig, 2}});
+  EXPECT_EQ(source.GetCopy(kIntConfig), 2);
+  EXPECT_EQ(source.GetCopy(kBoolConfig), false);
+  UEXPECT_THROW(source.GetCopy(kDummyConfig), std::logic_error);
+}
+
+UTEST(DynamicConfig, GetCopyMultipleStorages) {
+  std::vector<dynamic_config::StorageMock> storages;
+  for (int i = 0; i < 10; ++i) {
+    storages.push_back(dynamic_config::StorageMock{{kIntConfig, i}});
+  }
+
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int i = 0; i < 10; ++i) {
+      EXPECT_EQ(storages[i].GetSource().GetCopy(kIntConfig), i);
+    }
+  }
+
+  // A new storage may reuse the memory of the destroyed one
+  storages.clear();
+  const dynamic_config::StorageMock storage{{kIntConfig, 42}};
+  EXPECT_EQ(storage.GetSource().GetCopy(kIntConfig), 42);
+}
+
+int counted_parses = 0;
+
+int ParseCounted(const formats::json::Value& value) {
+  ++counted_parses;
+  return value.As<int>();
+}
+
+const dynamic_config::Key<int> kCountedConfig{
+    "COUNTED_CONFIG", &ParseCounted, dynamic_config::DefaultAsJsonString{"1"}};
+
+const dynamic_config::Key<int> kOtherConfig{"OTHER_CONFIG", 2};
+
+UTEST(DynamicConfig, ParseOnlyChanged) {
+  const auto counted_id =
+      dynamic_config::impl::ConfigIdGetter::Get(kCountedConfig);
+  const auto other_id = dynamic_config::impl::ConfigIdGetter::Get(kOtherConfig);
+
+  const auto docs_map = dynamic_config::impl::MakeDefaultDocsMap();
+  const dynamic_config::impl::SnapshotData first(docs_map, {});
+  const auto initial_parses = counted_parses;
+
+  auto other_changed = docs_map;
+  other_changed.Set("OTHER_CONFIG",
+                    formats::json::ValueBuilder(3).ExtractValue());
+  const dynamic_config::impl::SnapshotData second(other_changed, first,
+                                                  docs_map);
+  EXPECT_EQ(second.Get<int>(other_id), 3);
+  EXPECT_EQ(second.Get<int>(counted_id), 1);
+  EXPECT_EQ(counted_parses, initial_parses);
+  EXPECT_EQ(&second.Get<int>(counted_id), &first.Get<int>(counted_id));
+
+  auto counted_changed = other_changed;
+  counted_changed.Set("COUNTED_CONFIG",
+                      formats::json::ValueBuilder(5).ExtractValue());
+  const dynamic_config::impl::SnapshotData third(counted_changed, second,
+                                                 other_changed);
+  EXPECT_EQ(third.Get<int>(counted_id), 5);
+  EXPECT_EQ(third.Get<int>(other_id), 3);
+  EXPECT_EQ(counted_parses, initial_parses + 1);
+  EXPECT_EQ(&third.Get<int>(other_id), &second.Get<int>(other_id));
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
@@ -34,6 +34,23 @@ bool IsValidJson(std::string_view json_string) {
   }
 }
 
+std::shared_ptr<const std::any> ParseVariable(const VariableMetadata& metadata,
+                                              const DocsMap& docs_map) {
+  try {
+    return std::make_shared<const std::any>(metadata.factory(docs_map));
+  } catch (const std::exception& ex) {
+    throw ConfigParseError(
+        fmt::format("While parsing dynamic config values: {} ({})", ex.what(),
+                    compiler::GetTypeName(typeid(ex))));
+  }
+}
+
+bool IsSameDoc(std::string_view name, const DocsMap& docs_map,
+               const DocsMap& previous_docs_map) {
+  return docs_map.Has(name) && previous_docs_map.Has(name) &&
+         docs_map.Get(name) == previous_docs_map.Get(name);
+}
+
 }  // namespace
 
 [[noreturn]] void WrapGetError(const std::exception& ex, std::type_index type) {
@@ -112,7 +129,8 @@ SnapshotData::SnapshotData(const std::vector<KeyValue>& config_variables) {
   user_configs_.resize(Registry().size());
 
   for (const auto& config_variable : config_variables) {
-    user_configs_[config_variable.GetId()] = config_variable.GetValue();
+    user_configs_[config_variable.GetId()] =
+        std::make_shared<const std::any>(config_variable.GetValue());
   }
 }
 
@@ -121,15 +139,9 @@ SnapshotData::SnapshotData(const DocsMap& defaults,
     : SnapshotData(overrides) {
   utils::StreamingCpuRelax relax(1, nullptr);
   for (const auto [id, metadata] : utils::enumerate(Registry())) {
-    if (!user_configs_[id].has_value()) {
+    if (!user_configs_[id]) {
       relax.Relax(1);
-      try {
-        user_configs_[id] = metadata.factory(defaults);
-      } catch (const std::exception& ex) {
-        throw ConfigParseError(
-            fmt::format("While parsing dynamic config values: {} ({})",
-                        ex.what(), compiler::GetTypeName(typeid(ex))));
-      }
+      user_configs_[id] = ParseVariable(metadata, defaults);
     }
   }
 }
@@ -140,22 +152,49 @@ SnapshotData::SnapshotData(const SnapshotData& defaults,
   if (defaults.IsEmpty()) return;
 
   for (const auto [id, factory] : utils::enumerate(Registry())) {
-    if (user_configs_[id].has_value()) continue;
+    if (user_configs_[id]) continue;
     user_configs_[id] = defaults.user_configs_[id];
   }
 }
 
+SnapshotData::SnapshotData(const DocsMap& docs_map,
+                           const SnapshotData& previous,
+                           const DocsMap& previous_docs_map)
+    : SnapshotData(std::vector<KeyValue>{}) {
+  UASSERT(previous.IsEmpty() ||
+          previous.user_configs_.size() == user_configs_.size());
+
+  utils::StreamingCpuRelax relax(1, nullptr);
+  for (const auto [id, metadata] : utils::enumerate(Registry())) {
+    relax.Relax(1);
+    // The configs parsed from the whole DocsMap may depend on any of the docs,
+    // so only the configs with a name are shared
+    if (!previous.IsEmpty() && previous.user_configs_[id] &&
+        !metadata.name.empty() &&
+        IsSameDoc(metadata.name, docs_map, previous_docs_map)) {
+      user_configs_[id] = previous.user_configs_[id];
+    } else {
+      user_configs_[id] = ParseVariable(metadata, docs_map);
+    }
+  }
+}
+
 bool SnapshotData::IsEmpty() const noexcept { return user_configs_.empty(); }
 
-const std::any& SnapshotData::DoGet(ConfigId id) const {
+const std::shared_ptr<const std::any>& SnapshotData::GetShared(
+    ConfigId id) const {
   UASSERT_MSG(id < user_configs_.size(), "SnapshotData is in an empty state.");
   const auto& config = user_configs_[id];
-  if (!config.has_value()) {
+  if (!config || !config->has_value()) {
     throw std::logic_error("This type is not registered as config");
   }
   return config;
 }
 
+const std::any& SnapshotData::DoGet(ConfigId id) const {
+  return *GetShared(id);
+}
+
 }  // namespace dynamic_config::impl
 
 USERVER_NAMESPACE_END
@@ -1,17 +1,73 @@
 #include <userver/dynamic_config/source.hpp>
 
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
 
+#include <userver/compiler/thread_local.hpp>
+
 #include <dynamic_config/storage_data.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace dynamic_config {
+namespace {
+
+struct CachedVariable final {
+  const impl::StorageData* storage{nullptr};
+  std::uint64_t version{0};
+  impl::ConfigId id{0};
+  std::shared_ptr<const std::any> value;
+};
+
+// Direct-mapped, a collision of the variables only costs a reload
+constexpr std::size_t kCachedVariablesCount = 64;
+
+using VariableCache = std::array<CachedVariable, kCachedVariablesCount>;
+
+compiler::ThreadLocal local_variable_cache = [] { return VariableCache{}; };
+
+CachedVariable& GetCacheSlot(VariableCache& cache,
+                             const impl::StorageData& storage,
+                             impl::ConfigId id) noexcept {
+  return cache[(std::hash<const void*>{}(&storage) ^ id) %
+               kCachedVariablesCount];
+}
+
+}  // namespace
 
 Source::Source(impl::StorageData& storage) : storage_(&storage) {}
 
 Snapshot Source::GetSnapshot() const { return Snapshot{*storage_}; }
 
+void Source::ReadCached(
+    impl::ConfigId id,
+    utils::function_ref<void(const std::any&)> visitor) const {
+  // The version is loaded before the value, so a value loaded concurrently
+  // with an update is reloaded on the next read
+  const auto version = storage_->GetVersion();
+  {
+    auto cache = local_variable_cache.Use();
+    const auto& slot = GetCacheSlot(*cache, *storage_, id);
+    if (slot.storage == storage_ && slot.version == version && slot.id == id) {
+      visitor(*slot.value);
+      return;
+    }
+  }
+
+  std::shared_ptr<const std::any> value;
+  {
+    const auto data = storage_->Read();
+    value = data->GetShared(id);
+  }
+  auto cache = local_variable_cache.Use();
+  auto& slot = GetCacheSlot(*cache, *storage_, id);
+  slot = CachedVariable{storage_, version, id, std::move(value)};
+  visitor(*slot.value);
+}
+
 Source::SnapshotEventSource& Source::GetEventChannel() {
   return storage_->GetChannel();
 }
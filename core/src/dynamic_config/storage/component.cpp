@@ -88,6 +88,9 @@ class DynamicConfig::Impl final {
   engine::TaskProcessor* fs_task_processor_;
 
   dynamic_config::impl::StorageData cache_;
+  // Docs of the config in `cache_`, guarded by `set_config_mutex_`
+  dynamic_config::DocsMap cache_docs_map_;
+  engine::Mutex set_config_mutex_;
   std::string fs_loading_error_msg_;
   dynamic_config::DocsMap fallback_config_;
 
@@ -177,7 +180,10 @@ void DynamicConfig::Impl::NotifyLoadingFailed(std::string_view updater,
 dynamic_config::impl::SnapshotData DynamicConfig::Impl::ParseConfig(
     const dynamic_config::DocsMap& value) {
   try {
-    dynamic_config::impl::SnapshotData config(value, {});
+    // Only the configs with changed docs are parsed
+    const auto previous = cache_.Read();
+    dynamic_config::impl::SnapshotData config(value, *previous,
+                                              cache_docs_map_);
     stats_.was_last_parse_successful = true;
     alert_storage_.StopAlertNow("config_parse_error");
     return config;
@@ -194,6 +200,7 @@ dynamic_config::impl::SnapshotData DynamicConfig::Impl::ParseConfig(
 }
 
 void DynamicConfig::Impl::DoSetConfig(const dynamic_config::DocsMap& value) {
+  const std::lock_guard lock(set_config_mutex_);
   auto config = ParseConfig(value);
 
   if (!value.GetConfigsExpectedToBeUsed(utils::InternalTag{}).empty()) {
@@ -209,6 +216,7 @@ void DynamicConfig::Impl::DoSetConfig(const dynamic_config::DocsMap& value) {
     loaded_cv_.NotifyAll();
   };
   cache_.Update(std::move(config), std::move(after_assign_hook));
+  cache_docs_map_ = value;
 }
 
 void DynamicConfig::Impl::SetConfig(std::string_view updater,
@@ -10,9 +10,18 @@
 USERVER_NAMESPACE_BEGIN
 
 namespace dynamic_config::impl {
+namespace {
+
+std::uint64_t NextVersion() noexcept {
+  static std::atomic<std::uint64_t> last_version{0};
+  return last_version.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+}  // namespace
 
 StorageData::StorageData(SnapshotData config)
     : config_(std::move(config)),
+      version_(NextVersion()),
       snapshot_channel_("dynamic-config-snapshot",
                         [&](auto& func) {
                           const auto snapshot = GetSnapshot();
@@ -31,6 +40,10 @@ rcu::ReadablePtr<SnapshotData> StorageData::Read() const {
   return config_.Read();
 }
 
+std::uint64_t StorageData::GetVersion() const noexcept {
+  return version_.load(std::memory_order_acquire);
+}
+
 void StorageData::Update(SnapshotData config,
                          AfterAssignHook after_assign_hook) {
   std::lock_guard lock(update_mutex_);
@@ -43,6 +56,7 @@ void StorageData::Update(SnapshotData config,
   }
 
   config_.Assign(std::move(config));
+  version_.store(NextVersion(), std::memory_order_release);
   after_assign_hook();
 
   const Diff diff{std::move(previous_config), GetSnapshot()};
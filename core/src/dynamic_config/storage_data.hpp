@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
 #include <userver/concurrent/async_event_channel.hpp>
 #include <userver/dynamic_config/impl/snapshot.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
@@ -22,6 +25,10 @@ class StorageData final {
 
   rcu::ReadablePtr<SnapshotData> Read() const;
 
+  // Changes on each Update, unique among all the storages, so that a pair of
+  // a storage and its version identifies the config
+  std::uint64_t GetVersion() const noexcept;
+
   void Update(SnapshotData config, AfterAssignHook after_assign_hook);
 
   SnapshotChannel& GetChannel();
@@ -38,6 +45,7 @@ class StorageData final {
   Snapshot GetSnapshot() { return Snapshot{*this}; }
 
   rcu::Variable<SnapshotData> config_;
+  std::atomic<std::uint64_t> version_;
   SnapshotChannel snapshot_channel_;
   DiffChannel diff_channel_;
 
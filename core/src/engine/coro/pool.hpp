@@ -3,17 +3,28 @@
 #include <algorithm>  // for std::max
 #include <atomic>
 #include <cerrno>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <utility>
+#include <vector>
 
+#include <boost/intrusive/list.hpp>
 #include <moodycamel/concurrentqueue.h>
 
 #include <coroutines/coroutine.hpp>
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/impl/intrusive_link_mode.hpp>
+#include <userver/utils/thread_name.hpp>
+#include <utils/numa.hpp>
 
 #include "pool_config.hpp"
 #include "pool_stats.hpp"
+#include "stack_allocator.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -35,9 +46,57 @@ class Pool final {
   PoolStats GetStats() const;
   std::size_t GetStackSize() const;
 
+  /// Used sizes of the sampled stacks, KiB. Null if
+  /// PoolConfig::stack_usage_sample_period is not set.
+  const utils::statistics::Histogram* GetStackUsage() const noexcept;
+
+  /// Enables the local cache of coroutines for the current thread. Must be
+  /// paired with UnregisterLocalCache on the same thread before it exits.
+  /// The thread goes without the cache if its memory can't be allocated.
+  void RegisterLocalCache() noexcept;
+  void UnregisterLocalCache() noexcept;
+
+  /// Destroys the idle coroutines from the 'working set' above
+  /// PoolConfig::trim_watermark. Called periodically if
+  /// PoolConfig::trim_interval is set.
+  void TrimIdleCoroutines() noexcept;
+
  private:
+  struct LocalCache {
+    Pool* pool{nullptr};
+    std::vector<Coroutine> coroutines;
+    // Only written by the owning thread, read by GetStats
+    std::atomic<std::size_t> size{0};
+    // Links the caches of a pool without allocations
+    boost::intrusive::list_member_hook<utils::impl::IntrusiveLinkMode>
+        list_hook;
+  };
+
+  using LocalCacheList = boost::intrusive::list<
+      LocalCache,
+      boost::intrusive::member_hook<LocalCache,
+                                    boost::intrusive::list_member_hook<
+                                        utils::impl::IntrusiveLinkMode>,
+                                    &LocalCache::list_hook>,
+      boost::intrusive::constant_time_size<false>>;
+
+  struct CoroutineMover {
+    std::optional<Coroutine>& result;
+
+    CoroutineMover& operator=(Coroutine&& coro) {
+      result.emplace(std::move(coro));
+      return *this;
+    }
+  };
+
+  static LocalCache& GetLocalCache() noexcept;
+
   Coroutine CreateCoroutine(bool quiet = false);
   void OnCoroutineDestruction() noexcept;
+  void PutCoroutineToSharedPool(CoroutinePtr&& coroutine_ptr);
+  void RunTrimmer();
+
+  moodycamel::ConcurrentQueue<Coroutine>& GetUsedPool();
 
   template <typename Token>
   Token& GetUsedPoolToken();
@@ -45,7 +104,7 @@ class Pool final {
   const PoolConfig config_;
   const Executor executor_;
 
-  boost::coroutines2::protected_fixedsize_stack stack_allocator_;
+  StackAllocator stack_allocator_;
 
   // We aim to reuse coroutines as much as possible,
   // because since coroutine stack is a mmap-ed chunk of memory and not actually
@@ -53,11 +112,25 @@ class Pool final {
   //
   // The same could've been achieved with some LIFO container, but apparently
   // we don't have a container handy enough to not just use 2 queues.
+  //
+  // There is a 'working set' per NUMA node, so that a stack touched by the
+  // threads of one node is not reused on another node.
   moodycamel::ConcurrentQueue<Coroutine> initial_coroutines_;
-  moodycamel::ConcurrentQueue<Coroutine> used_coroutines_;
+  utils::FixedArray<moodycamel::ConcurrentQueue<Coroutine>> used_coroutines_;
 
   std::atomic<std::size_t> idle_coroutines_num_;
   std::atomic<std::size_t> total_coroutines_num_;
+  std::atomic<std::size_t> trimmed_coroutines_num_{0};
+
+  // Per-thread caches serve the common GetCoroutine/PutCoroutine pair of a
+  // worker without touching the shared queues and counters above.
+  mutable std::mutex local_caches_mutex_;
+  LocalCacheList local_caches_;
+
+  std::mutex trimmer_mutex_;
+  std::condition_variable trimmer_cv_;
+  bool is_trimmer_stopped_{false};
+  std::thread trimmer_;
 };
 
 template <typename Task>
@@ -93,9 +166,9 @@ template <typename Task>
 Pool<Task>::Pool(PoolConfig config, Executor executor)
     : config_(std::move(config)),
       executor_(executor),
-      stack_allocator_(config_.stack_size),
+      stack_allocator_(config_),
       initial_coroutines_(config_.initial_size),
-      used_coroutines_(config_.max_size),
+      used_coroutines_(utils::numa::GetNodesCount(), config_.max_size),
       idle_coroutines_num_(config_.initial_size),
       total_coroutines_num_(0) {
   moodycamel::ProducerToken token(initial_coroutines_);
@@ -104,21 +177,40 @@ Pool<Task>::Pool(PoolConfig config, Executor executor)
         initial_coroutines_.enqueue(token, CreateCoroutine(/*quiet =*/true));
     UINVARIANT(ok, "Failed to allocate the initial coro pool");
   }
+
+  if (config_.trim_interval.count() > 0) {
+    trimmer_ = std::thread([this] { RunTrimmer(); });
+  }
 }
 
 template <typename Task>
-Pool<Task>::~Pool() = default;
+Pool<Task>::~Pool() {
+  if (trimmer_.joinable()) {
+    {
+      const std::lock_guard lock{trimmer_mutex_};
+      is_trimmer_stopped_ = true;
+    }
+    trimmer_cv_.notify_all();
+    trimmer_.join();
+  }
+
+  const std::lock_guard lock{local_caches_mutex_};
+  UASSERT_MSG(local_caches_.empty(),
+              "Some threads did not unregister their coroutine caches");
+}
 
 template <typename Task>
 typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
-  struct CoroutineMover {
-    std::optional<Coroutine>& result;
-
-    CoroutineMover& operator=(Coroutine&& coro) {
-      result.emplace(std::move(coro));
-      return *this;
-    }
-  };
+  auto& local_cache = GetLocalCache();
+  if (local_cache.pool == this && !local_cache.coroutines.empty()) {
+    // LIFO: the most recently used stack is the most likely to be hot in the
+    // CPU cache
+    CoroutinePtr result(std::move(local_cache.coroutines.back()), *this);
+    local_cache.coroutines.pop_back();
+    local_cache.size.store(local_cache.coroutines.size(),
+                           std::memory_order_relaxed);
+    return result;
+  }
 
   std::optional<Coroutine> coroutine;
   CoroutineMover mover{coroutine};
@@ -126,8 +218,8 @@ typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
   // First try to dequeue from 'working set': if we can get a coroutine
   // from there we are happy, because we saved on minor-page-faulting (thus
   // increasing resident memory usage) a not-yet-de-virtualized coroutine stack.
-  if (used_coroutines_.try_dequeue(
-          GetUsedPoolToken<moodycamel::ConsumerToken>(), mover) ||
+  if (GetUsedPool().try_dequeue(GetUsedPoolToken<moodycamel::ConsumerToken>(),
+                                mover) ||
       initial_coroutines_.try_dequeue(mover)) {
     --idle_coroutines_num_;
   } else {
@@ -138,25 +230,129 @@ typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
 
 template <typename Task>
 void Pool<Task>::PutCoroutine(CoroutinePtr&& coroutine_ptr) {
+  auto& local_cache = GetLocalCache();
+  if (local_cache.pool == this &&
+      local_cache.coroutines.size() < config_.local_cache_size) {
+    local_cache.coroutines.push_back(std::move(coroutine_ptr.Get()));
+    local_cache.size.store(local_cache.coroutines.size(),
+                           std::memory_order_relaxed);
+    return;
+  }
+
+  PutCoroutineToSharedPool(std::move(coroutine_ptr));
+}
+
+template <typename Task>
+void Pool<Task>::PutCoroutineToSharedPool(CoroutinePtr&& coroutine_ptr) {
   if (idle_coroutines_num_.load() >= config_.max_size) return;
   auto& token = GetUsedPoolToken<moodycamel::ProducerToken>();
   const bool ok =
       // We only ever return coroutines into our 'working set'.
-      used_coroutines_.enqueue(token, std::move(coroutine_ptr.Get()));
+      GetUsedPool().enqueue(token, std::move(coroutine_ptr.Get()));
   if (ok) ++idle_coroutines_num_;
 }
 
 template <typename Task>
 PoolStats Pool<Task>::GetStats() const {
   PoolStats stats;
+  {
+    const std::lock_guard lock{local_caches_mutex_};
+    for (const auto& local_cache : local_caches_) {
+      stats.cached_coroutines +=
+          local_cache.size.load(std::memory_order_relaxed);
+    }
+  }
+
+  std::size_t idle_coroutines =
+      initial_coroutines_.size_approx() + stats.cached_coroutines;
+  for (const auto& used_coroutines : used_coroutines_) {
+    idle_coroutines += used_coroutines.size_approx();
+  }
+  const auto total_coroutines = total_coroutines_num_.load();
   stats.active_coroutines =
-      total_coroutines_num_.load() -
-      (used_coroutines_.size_approx() + initial_coroutines_.size_approx());
-  stats.total_coroutines =
-      std::max(total_coroutines_num_.load(), stats.active_coroutines);
+      total_coroutines - std::min(idle_coroutines, total_coroutines);
+  stats.total_coroutines = total_coroutines;
+  stats.trimmed_coroutines = trimmed_coroutines_num_.load();
   return stats;
 }
 
+template <typename Task>
+void Pool<Task>::RegisterLocalCache() noexcept {
+  if (config_.local_cache_size == 0) return;
+
+  auto& local_cache = GetLocalCache();
+  UASSERT_MSG(local_cache.pool == nullptr,
+              "The thread already has a coroutine cache");
+  try {
+    local_cache.coroutines.reserve(config_.local_cache_size);
+  } catch (const std::bad_alloc&) {
+    LOG_ERROR() << "Failed to allocate the local cache of "
+                << config_.local_cache_size
+                << " coroutines, the thread uses the shared pool only";
+    return;
+  }
+
+  const std::lock_guard lock{local_caches_mutex_};
+  local_caches_.push_back(local_cache);
+  local_cache.pool = this;
+}
+
+template <typename Task>
+void Pool<Task>::UnregisterLocalCache() noexcept {
+  auto& local_cache = GetLocalCache();
+  if (local_cache.pool != this) return;
+
+  {
+    const std::lock_guard lock{local_caches_mutex_};
+    local_caches_.erase(local_caches_.iterator_to(local_cache));
+  }
+  local_cache.pool = nullptr;
+
+  for (auto& coroutine : local_cache.coroutines) {
+    PutCoroutineToSharedPool(CoroutinePtr(std::move(coroutine), *this));
+  }
+  local_cache.coroutines.clear();
+  local_cache.size.store(0, std::memory_order_relaxed);
+}
+
+template <typename Task>
+void Pool<Task>::TrimIdleCoroutines() noexcept {
+  // 'initial_coroutines_' stacks were never touched, there is nothing to give
+  // back to the OS. Coroutines are destroyed rather than madvise-d, because
+  // the stack pointer of a parked coroutine is not known to us.
+  std::size_t used_total = 0;
+  for (const auto& used_coroutines : used_coroutines_) {
+    used_total += used_coroutines.size_approx();
+  }
+  if (used_total <= config_.trim_watermark) return;
+
+  auto to_trim = used_total - config_.trim_watermark;
+  std::optional<Coroutine> coroutine;
+  CoroutineMover mover{coroutine};
+  for (auto& used_coroutines : used_coroutines_) {
+    while (to_trim > 0 && used_coroutines.try_dequeue(mover)) {
+      --to_trim;
+      --idle_coroutines_num_;
+      coroutine.reset();
+      OnCoroutineDestruction();
+      ++trimmed_coroutines_num_;
+    }
+  }
+}
+
+template <typename Task>
+void Pool<Task>::RunTrimmer() {
+  utils::SetCurrentThreadName("coro-trimmer");
+
+  std::unique_lock lock{trimmer_mutex_};
+  while (!trimmer_cv_.wait_for(lock, config_.trim_interval,
+                               [this] { return is_trimmer_stopped_; })) {
+    lock.unlock();
+    TrimIdleCoroutines();
+    lock.lock();
+  }
+}
+
 template <typename Task>
 typename Pool<Task>::Coroutine Pool<Task>::CreateCoroutine(bool quiet) {
   try {
@@ -194,10 +390,31 @@ std::size_t Pool<Task>::GetStackSize() const {
   return config_.stack_size;
 }
 
+template <typename Task>
+const utils::statistics::Histogram* Pool<Task>::GetStackUsage() const noexcept {
+  if (config_.stack_usage_sample_period == 0) return nullptr;
+  return &stack_allocator_.GetStackUsage();
+}
+
+template <typename Task>
+typename Pool<Task>::LocalCache& Pool<Task>::GetLocalCache() noexcept {
+  thread_local LocalCache local_cache;
+  return local_cache;
+}
+
+template <typename Task>
+moodycamel::ConcurrentQueue<typename Pool<Task>::Coroutine>&
+Pool<Task>::GetUsedPool() {
+  const auto node = utils::numa::GetCurrentThreadNode();
+  return used_coroutines_[std::min(node, used_coroutines_.size() - 1)];
+}
+
 template <typename Task>
 template <typename Token>
 Token& Pool<Task>::GetUsedPoolToken() {
-  thread_local Token token(used_coroutines_);
+  // Node of a thread is set before the thread starts running coroutines, so
+  // it is safe to cache the token.
+  thread_local Token token(GetUsedPool());
   return token;
 }
 
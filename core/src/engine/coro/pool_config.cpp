@@ -1,15 +1,40 @@
 #include "pool_config.hpp"
 
+#include <userver/utils/trivial_map.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::coro {
 
+StackHugePages Parse(const yaml_config::YamlConfig& value,
+                     formats::parse::To<StackHugePages>) {
+  static constexpr utils::TrivialBiMap kMap([](auto selector) {
+    return selector()
+        .Case(StackHugePages::kNone, "none")
+        .Case(StackHugePages::kTransparent, "transparent")
+        .Case(StackHugePages::kExplicit, "explicit");
+  });
+
+  return utils::ParseFromValueString(value, kMap);
+}
+
 PoolConfig Parse(const yaml_config::YamlConfig& value,
                  formats::parse::To<PoolConfig>) {
   PoolConfig config;
   config.initial_size = value["initial_size"].As<size_t>(config.initial_size);
   config.max_size = value["max_size"].As<size_t>(config.max_size);
   config.stack_size = value["stack_size"].As<size_t>(config.stack_size);
+  config.local_cache_size =
+      value["local_cache_size"].As<size_t>(config.local_cache_size);
+  config.trim_watermark =
+      value["trim_watermark"].As<size_t>(config.trim_watermark);
+  config.trim_interval =
+      value["trim_interval"].As<std::chrono::milliseconds>(config.trim_interval);
+  config.stack_huge_pages =
+      value["stack_huge_pages"].As<StackHugePages>(config.stack_huge_pages);
+  config.stack_usage_sample_period =
+      value["stack_usage_sample_period"].As<size_t>(
+          config.stack_usage_sample_period);
   return config;
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 
 #include <userver/formats/yaml.hpp>
@@ -9,10 +10,39 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::coro {
 
+enum class StackHugePages {
+  /// A separate mapping with a guard page for each stack
+  kNone,
+  /// Stacks are cut from slabs advised for the transparent huge pages
+  kTransparent,
+  /// Stacks are cut from slabs of the reserved huge pages (MAP_HUGETLB)
+  kExplicit,
+};
+
+StackHugePages Parse(const yaml_config::YamlConfig& value,
+                     formats::parse::To<StackHugePages>);
+
 struct PoolConfig {
   std::size_t initial_size = 1000;
   std::size_t max_size = 4000;
   std::size_t stack_size = 256 * 1024ULL;
+
+  /// Max amount of idle coroutines kept by each worker thread for itself
+  std::size_t local_cache_size = 16;
+
+  /// Idle coroutines with touched stacks above this amount are periodically
+  /// destroyed to give the stacks memory back to the OS
+  std::size_t trim_watermark = 1000;
+
+  /// Trimming is disabled if zero
+  std::chrono::milliseconds trim_interval{0};
+
+  /// The stacks from huge page slabs have no guard pages
+  StackHugePages stack_huge_pages{StackHugePages::kNone};
+
+  /// Each N-th stack is painted to measure its usage when it is freed,
+  /// sampling is disabled if zero
+  std::size_t stack_usage_sample_period = 0;
 };
 
 PoolConfig Parse(const yaml_config::YamlConfig& value,
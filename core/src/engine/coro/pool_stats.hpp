@@ -10,11 +10,17 @@ namespace engine::coro {
 struct PoolStats {
   size_t active_coroutines = 0;
   size_t total_coroutines = 0;
+  /// Idle coroutines in the per-thread caches
+  size_t cached_coroutines = 0;
+  /// Idle coroutines destroyed by the trimmer since the start
+  size_t trimmed_coroutines = 0;
 };
 
 inline PoolStats& operator+=(PoolStats& lhs, const PoolStats& rhs) {
   lhs.active_coroutines += rhs.active_coroutines;
   lhs.total_coroutines += rhs.total_coroutines;
+  lhs.cached_coroutines += rhs.cached_coroutines;
+  lhs.trimmed_coroutines += rhs.trimmed_coroutines;
   return lhs;
 }
 
@@ -0,0 +1,88 @@
+#include <engine/coro/pool.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Pool caches thread_local tokens per Task type, so each test uses its own
+template <int>
+struct DummyTask {};
+
+template <typename Task>
+using DummyPool = engine::coro::Pool<Task>;
+
+template <typename Task>
+void DummyExecutor(typename DummyPool<Task>::TaskPipe& task_pipe) {
+  for ([[maybe_unused]] auto* task : task_pipe) {
+  }
+}
+
+engine::coro::PoolConfig MakeConfig() {
+  engine::coro::PoolConfig config;
+  config.initial_size = 0;
+  config.max_size = 10;
+  config.stack_size = 64 * 1024;
+  config.local_cache_size = 2;
+  return config;
+}
+
+}  // namespace
+
+TEST(CoroPool, LocalCache) {
+  using Task = DummyTask<0>;
+  DummyPool<Task> pool(MakeConfig(), &DummyExecutor<Task>);
+  pool.RegisterLocalCache();
+
+  std::vector<DummyPool<Task>::CoroutinePtr> coroutines;
+  for (int i = 0; i < 3; ++i) coroutines.push_back(pool.GetCoroutine());
+  EXPECT_EQ(pool.GetStats().active_coroutines, 3);
+
+  for (auto& coroutine : coroutines) std::move(coroutine).ReturnToPool();
+  coroutines.clear();
+
+  auto stats = pool.GetStats();
+  EXPECT_EQ(stats.active_coroutines, 0);
+  EXPECT_EQ(stats.total_coroutines, 3);
+  EXPECT_EQ(stats.cached_coroutines, 2);
+
+  // Served from the local cache
+  auto coroutine = pool.GetCoroutine();
+  EXPECT_EQ(pool.GetStats().cached_coroutines, 1);
+  std::move(coroutine).ReturnToPool();
+
+  pool.UnregisterLocalCache();
+  stats = pool.GetStats();
+  EXPECT_EQ(stats.active_coroutines, 0);
+  EXPECT_EQ(stats.total_coroutines, 3);
+  EXPECT_EQ(stats.cached_coroutines, 0);
+}
+
+TEST(CoroPool, TrimIdleCoroutines) {
+  using Task = DummyTask<1>;
+  auto config = MakeConfig();
+  config.trim_watermark = 1;
+  DummyPool<Task> pool(config, &DummyExecutor<Task>);
+
+  std::vector<DummyPool<Task>::CoroutinePtr> coroutines;
+  for (int i = 0; i < 5; ++i) coroutines.push_back(pool.GetCoroutine());
+  for (auto& coroutine : coroutines) std::move(coroutine).ReturnToPool();
+  coroutines.clear();
+  EXPECT_EQ(pool.GetStats().total_coroutines, 5);
+
+  pool.TrimIdleCoroutines();
+
+  const auto stats = pool.GetStats();
+  EXPECT_EQ(stats.total_coroutines, 1);
+  EXPECT_EQ(stats.active_coroutines, 0);
+  EXPECT_EQ(stats.trimmed_coroutines, 4);
+
+  // Trimming does not go below the watermark
+  pool.TrimIdleCoroutines();
+  EXPECT_EQ(pool.GetStats().total_coroutines, 1);
+}
+
+USERVER_NAMESPACE_END
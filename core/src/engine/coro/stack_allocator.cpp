@@ -0,0 +1,254 @@
+#include "stack_allocator.hpp"
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+namespace {
+
+constexpr std::size_t kHugePageSize = 2 * 1024 * 1024;
+// A slab is mapped at once, so it is big enough to serve many stacks
+constexpr std::size_t kMinSlabSize = 8 * kHugePageSize;
+
+constexpr std::uint64_t kPaintPattern = 0xdeadbeefcafebabe;
+
+constexpr std::array<double, 12> kStackUsageBoundsKb{
+    4, 8, 16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 8192};
+
+std::size_t RoundUp(std::size_t value, std::size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+std::size_t GetPageSize() noexcept {
+  return boost::context::stack_traits::page_size();
+}
+
+void* MapExplicitHugePages(std::size_t size) {
+#ifdef MAP_HUGETLB
+  void* slab = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+  if (slab == MAP_FAILED) {
+    const auto error = errno;
+    LOG_ERROR() << "Failed to map a slab of huge pages for coroutine stacks, "
+                   "are there enough huge pages reserved in vm.nr_hugepages?";
+    errno = error;
+    throw std::bad_alloc();
+  }
+  return slab;
+#else
+  static_cast<void>(size);
+  throw std::runtime_error(
+      "Explicit huge pages are not supported on this platform");
+#endif
+}
+
+void* MapTransparentHugePages(std::size_t size) {
+  // Huge pages are used only for the aligned ranges
+  const auto mapped_size = size + kHugePageSize;
+  void* mapping = ::mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED) throw std::bad_alloc();
+
+  auto* const begin = static_cast<char*>(mapping);
+  auto* const slab = reinterpret_cast<char*>(
+      RoundUp(reinterpret_cast<std::uintptr_t>(begin), kHugePageSize));
+  if (slab != begin) ::munmap(begin, slab - begin);
+  auto* const end = begin + mapped_size;
+  if (slab + size != end) ::munmap(slab + size, end - (slab + size));
+
+#ifdef MADV_HUGEPAGE
+  if (::madvise(slab, size, MADV_HUGEPAGE) != 0) {
+    LOG_LIMITED_WARNING() << "Transparent huge pages are not available for "
+                             "coroutine stacks, errno="
+                          << errno;
+  }
+#endif
+  return slab;
+}
+
+}  // namespace
+
+class StackAllocator::Impl final {
+ public:
+  explicit Impl(const PoolConfig& config);
+  ~Impl();
+
+  Impl(Impl&&) = delete;
+  Impl& operator=(Impl&&) = delete;
+
+  boost::context::stack_context Allocate();
+  void Deallocate(boost::context::stack_context& sctx) noexcept;
+
+  const utils::statistics::Histogram& GetStackUsage() const noexcept {
+    return stack_usage_;
+  }
+
+ private:
+  bool UsesSlabs() const noexcept {
+    return huge_pages_ != StackHugePages::kNone;
+  }
+
+  // The lowest usable address, above the guard page if any
+  char* GetStackBottom(const boost::context::stack_context& sctx) const;
+
+  char* AllocateFromSlabs();
+  void Paint(const boost::context::stack_context& sctx);
+  void AccountUsage(const boost::context::stack_context& sctx) noexcept;
+
+  const StackHugePages huge_pages_;
+  const std::size_t stack_size_;
+  const std::size_t slab_size_;
+  const std::size_t sample_period_;
+  boost::context::protected_fixedsize_stack protected_allocator_;
+
+  std::atomic<std::uint64_t> allocations_{0};
+  utils::statistics::Histogram stack_usage_{kStackUsageBoundsKb};
+
+  std::mutex mutex_;
+  std::vector<char*> slabs_;
+  // Bottoms of the free stacks from slabs
+  std::vector<char*> free_stacks_;
+  // Tops of the sampled stacks
+  std::unordered_set<void*> painted_stacks_;
+};
+
+StackAllocator::Impl::Impl(const PoolConfig& config)
+    : huge_pages_(config.stack_huge_pages),
+      stack_size_(RoundUp(config.stack_size, GetPageSize())),
+      slab_size_(RoundUp(std::max(stack_size_, kMinSlabSize), kHugePageSize)),
+      sample_period_(config.stack_usage_sample_period),
+      protected_allocator_(config.stack_size) {
+#ifndef MAP_HUGETLB
+  if (huge_pages_ == StackHugePages::kExplicit) {
+    throw std::runtime_error(
+        "coro_pool.stack_huge_pages 'explicit' is not supported on this "
+        "platform");
+  }
+#endif
+}
+
+StackAllocator::Impl::~Impl() {
+  for (auto* slab : slabs_) ::munmap(slab, slab_size_);
+}
+
+boost::context::stack_context StackAllocator::Impl::Allocate() {
+  boost::context::stack_context sctx;
+  if (UsesSlabs()) {
+    sctx.size = stack_size_;
+    sctx.sp = AllocateFromSlabs() + stack_size_;
+  } else {
+    sctx = protected_allocator_.allocate();
+  }
+
+  if (sample_period_ != 0 &&
+      allocations_.fetch_add(1, std::memory_order_relaxed) % sample_period_ ==
+          0) {
+    Paint(sctx);
+  }
+  return sctx;
+}
+
+void StackAllocator::Impl::Deallocate(
+    boost::context::stack_context& sctx) noexcept {
+  if (sample_period_ != 0) AccountUsage(sctx);
+
+  if (UsesSlabs()) {
+    const std::lock_guard lock{mutex_};
+    // Does not allocate, the capacity is reserved for each slab
+    free_stacks_.push_back(GetStackBottom(sctx));
+  } else {
+    protected_allocator_.deallocate(sctx);
+  }
+}
+
+char* StackAllocator::Impl::GetStackBottom(
+    const boost::context::stack_context& sctx) const {
+  auto* const bottom = static_cast<char*>(sctx.sp) - sctx.size;
+  return UsesSlabs() ? bottom : bottom + GetPageSize();
+}
+
+char* StackAllocator::Impl::AllocateFromSlabs() {
+  const std::lock_guard lock{mutex_};
+  if (free_stacks_.empty()) {
+    const auto stacks_per_slab = slab_size_ / stack_size_;
+    slabs_.reserve(slabs_.size() + 1);
+    free_stacks_.reserve((slabs_.size() + 1) * stacks_per_slab);
+
+    auto* const slab = static_cast<char*>(
+        huge_pages_ == StackHugePages::kExplicit
+            ? MapExplicitHugePages(slab_size_)
+            : MapTransparentHugePages(slab_size_));
+    slabs_.push_back(slab);
+    // The stacks are given away from the slab start
+    for (auto i = stacks_per_slab; i > 0; --i) {
+      free_stacks_.push_back(slab + (i - 1) * stack_size_);
+    }
+  }
+
+  auto* const stack = free_stacks_.back();
+  free_stacks_.pop_back();
+  return stack;
+}
+
+void StackAllocator::Impl::Paint(const boost::context::stack_context& sctx) {
+  auto* const begin = reinterpret_cast<std::uint64_t*>(GetStackBottom(sctx));
+  auto* const end = static_cast<std::uint64_t*>(sctx.sp);
+  std::fill(begin, end, kPaintPattern);
+
+  const std::lock_guard lock{mutex_};
+  painted_stacks_.insert(sctx.sp);
+}
+
+void StackAllocator::Impl::AccountUsage(
+    const boost::context::stack_context& sctx) noexcept {
+  {
+    const std::lock_guard lock{mutex_};
+    if (painted_stacks_.erase(sctx.sp) == 0) return;
+  }
+
+  // The stack grows down, so the pattern is intact at the bottom
+  const auto* const begin =
+      reinterpret_cast<const std::uint64_t*>(GetStackBottom(sctx));
+  const auto* const end = static_cast<const std::uint64_t*>(sctx.sp);
+  const auto* const used_begin = std::find_if(
+      begin, end, [](std::uint64_t word) { return word != kPaintPattern; });
+
+  const auto used_bytes = reinterpret_cast<const char*>(end) -
+                          reinterpret_cast<const char*>(used_begin);
+  stack_usage_.Account(static_cast<double>(used_bytes) / 1024);
+}
+
+StackAllocator::StackAllocator(const PoolConfig& config)
+    : impl_(std::make_shared<Impl>(config)) {}
+
+boost::context::stack_context StackAllocator::allocate() {
+  return impl_->Allocate();
+}
+
+void StackAllocator::deallocate(boost::context::stack_context& sctx) noexcept {
+  impl_->Deallocate(sctx);
+}
+
+const utils::statistics::Histogram& StackAllocator::GetStackUsage()
+    const noexcept {
+  return impl_->GetStackUsage();
+}
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
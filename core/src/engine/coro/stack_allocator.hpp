@@ -0,0 +1,43 @@
+#pragma once
+
+#include <memory>
+
+#include <coroutines/coroutine.hpp>
+
+#include <userver/utils/statistics/histogram.hpp>
+
+#include "pool_config.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+/// Allocates the coroutine stacks either as separate mappings with a guard
+/// page or from the huge page slabs, see PoolConfig::stack_huge_pages.
+///
+/// Each PoolConfig::stack_usage_sample_period-th stack is filled with a
+/// pattern on allocation. The untouched part of the pattern is measured when
+/// the stack is freed, and the used size is accounted in the histogram.
+///
+/// Copies share the state, as required by the boost.context StackAllocator
+/// concept. The stacks from slabs are kept for reuse and are unmapped only
+/// when the last copy is destroyed.
+class StackAllocator final {
+ public:
+  explicit StackAllocator(const PoolConfig& config);
+
+  boost::context::stack_context allocate();
+  void deallocate(boost::context::stack_context& sctx) noexcept;
+
+  /// Used sizes of the sampled stacks, KiB
+  const utils::statistics::Histogram& GetStackUsage() const noexcept;
+
+ private:
+  class Impl;
+
+  std::shared_ptr<Impl> impl_;
+};
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,84 @@
+#include <engine/coro/stack_allocator.hpp>
+
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kStackSize = 64 * 1024;
+
+engine::coro::PoolConfig MakeConfig(engine::coro::StackHugePages huge_pages) {
+  engine::coro::PoolConfig config;
+  config.stack_size = kStackSize;
+  config.stack_huge_pages = huge_pages;
+  return config;
+}
+
+// Imitates the stack usage, the stack grows down
+void UseStack(const boost::context::stack_context& sctx, std::size_t size) {
+  std::memset(static_cast<char*>(sctx.sp) - size, 1, size);
+}
+
+std::uint64_t GetUsageCount(const engine::coro::StackAllocator& allocator,
+                            double upper_bound_kb) {
+  const auto view = allocator.GetStackUsage().GetView();
+  for (std::size_t i = 0; i < view.GetBucketCount(); ++i) {
+    if (view.GetUpperBoundAt(i) == upper_bound_kb) return view.GetValueAt(i);
+  }
+  ADD_FAILURE() << "No bucket with the bound " << upper_bound_kb;
+  return 0;
+}
+
+}  // namespace
+
+TEST(CoroStackAllocator, StackUsage) {
+  auto config = MakeConfig(engine::coro::StackHugePages::kNone);
+  config.stack_usage_sample_period = 2;
+  engine::coro::StackAllocator allocator(config);
+
+  auto sampled = allocator.allocate();
+  auto not_sampled = allocator.allocate();
+  EXPECT_GE(sampled.size, kStackSize);
+
+  UseStack(sampled, 20 * 1024);
+  UseStack(not_sampled, 20 * 1024);
+  allocator.deallocate(sampled);
+  allocator.deallocate(not_sampled);
+
+  EXPECT_EQ(GetUsageCount(allocator, 32), 1);
+  EXPECT_EQ(GetUsageCount(allocator, 16), 0);
+}
+
+TEST(CoroStackAllocator, TransparentHugePages) {
+  auto config = MakeConfig(engine::coro::StackHugePages::kTransparent);
+  config.stack_usage_sample_period = 1;
+  engine::coro::StackAllocator allocator(config);
+
+  std::vector<boost::context::stack_context> stacks;
+  for (int i = 0; i < 3; ++i) {
+    stacks.push_back(allocator.allocate());
+    EXPECT_EQ(stacks.back().size, kStackSize);
+    UseStack(stacks.back(), kStackSize);
+  }
+  // Stacks are adjacent and do not overlap
+  EXPECT_EQ(static_cast<char*>(stacks[1].sp),
+            static_cast<char*>(stacks[0].sp) + kStackSize);
+  EXPECT_EQ(static_cast<char*>(stacks[2].sp),
+            static_cast<char*>(stacks[1].sp) + kStackSize);
+
+  void* const last_sp = stacks.back().sp;
+  for (auto& stack : stacks) allocator.deallocate(stack);
+  EXPECT_EQ(GetUsageCount(allocator, 64), 3);
+
+  // The freed stack is reused
+  auto stack = allocator.allocate();
+  EXPECT_EQ(stack.sp, last_sp);
+  allocator.deallocate(stack);
+  EXPECT_EQ(GetUsageCount(allocator, 4), 1);
+}
+
+USERVER_NAMESPACE_END
@@ -2,7 +2,9 @@
 
 #include <chrono>
 
+#include <engine/ev/timer_wheel.hpp>
 #include <userver/engine/deadline.hpp>
+#include <userver/utils/fixed_array.hpp>
 
 #include <utils/gbench_auxilary.hpp>
 
@@ -47,6 +49,28 @@ void deadline_100s_interval_reached(benchmark::State& state) {
   deadline_is_reached(state, std::chrono::seconds{100});
 }
 
+// Typical deadline timer lifetime: armed for a request and then removed
+// after the request has finished before the deadline is reached.
+void deadline_timer_wheel_add_remove(benchmark::State& state) {
+  const auto now = engine::ev::TimerWheel::Clock::now();
+  engine::ev::TimerWheel wheel{now};
+  utils::FixedArray<engine::ev::TimerWheel::Entry> background(
+      state.range(0), [](void*) noexcept {}, nullptr);
+  for (std::size_t i = 0; i < background.size(); ++i) {
+    wheel.Add(background[i],
+              now + std::chrono::microseconds{i * 37 % 10'000'000});
+  }
+
+  engine::ev::TimerWheel::Entry entry{[](void*) noexcept {}, nullptr};
+  std::int64_t i = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    wheel.Add(entry, now + std::chrono::milliseconds{++i % 30'000});
+    wheel.Remove(entry);
+  }
+
+  for (auto& background_entry : background) wheel.Remove(background_entry);
+}
+
 }  // namespace
 
 BENCHMARK(deadline_1us_interval_construction);
@@ -56,4 +80,6 @@ BENCHMARK(deadline_1us_interval_reached);
 BENCHMARK(deadline_20ms_interval_reached);
 BENCHMARK(deadline_100s_interval_reached);
 
+BENCHMARK(deadline_timer_wheel_add_remove)->Range(1, 100'000);
+
 USERVER_NAMESPACE_END
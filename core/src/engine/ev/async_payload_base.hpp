@@ -4,7 +4,7 @@
 #include <type_traits>
 #include <utility>
 
-#include <concurrent/impl/intrusive_hooks.hpp>
+#include <userver/concurrent/impl/intrusive_hooks.hpp>
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -1,5 +1,6 @@
 #include "thread.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <stdexcept>
 
@@ -60,23 +61,47 @@ void ReleaseEvDefaultLoop() {
 constexpr std::chrono::milliseconds kCpuStatsCollectInterval{1000};
 constexpr std::size_t kCpuStatsThrottle{16};
 
+// Bounds for the number of empty busy-polling iterations of the payloads
+// queue before the ev thread goes to sleep. The actual value adapts to the
+// load: it grows while polling finds new payloads and shrinks otherwise.
+constexpr std::size_t kMinPollIterations = 16;
+constexpr std::size_t kMaxPollIterations = 1024;
+
+// Limits the number of batches processed without returning to the main
+// loop, so that the cpu stats are collected regularly.
+constexpr std::size_t kMaxPolledBatches = 256;
+
+void CpuPause() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
 }  // namespace
 
 Thread::Thread(const std::string& thread_name,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, false, register_event_mode) {}
+               RegisterEventMode register_event_mode,
+               const utils::numa::ThreadPlacement& placement)
+    : Thread(thread_name, false, register_event_mode, placement) {}
 
 Thread::Thread(const std::string& thread_name, UseDefaultEvLoop,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, true, register_event_mode) {}
+               RegisterEventMode register_event_mode,
+               const utils::numa::ThreadPlacement& placement)
+    : Thread(thread_name, true, register_event_mode, placement) {}
 
 Thread::Thread(const std::string& thread_name, bool use_ev_default_loop,
-               RegisterEventMode register_event_mode)
-    : use_ev_default_loop_(use_ev_default_loop),
+               RegisterEventMode register_event_mode,
+               const utils::numa::ThreadPlacement& placement)
+    : poll_iterations_(kMinPollIterations),
+      use_ev_default_loop_(use_ev_default_loop),
       register_event_mode_(register_event_mode),
       loop_(nullptr),
       lock_(loop_mutex_, std::defer_lock),
       name_{thread_name},
+      placement_{placement},
+      cpus_{placement_.ResolveCpus()},
       cpu_stats_storage_{kCpuStatsCollectInterval, kCpuStatsThrottle},
       is_running_(false) {
   if (use_ev_default_loop_) AcquireEvDefaultLoop(name_);
@@ -92,7 +117,10 @@ Thread::~Thread() {
 void Thread::RunInEvLoopAsync(AsyncPayloadBase& payload) noexcept {
   RegisterInEvLoop(payload);
 
-  if (!IsInEvThread()) {
+  // The ev thread is either awake and will drain the queue before going to
+  // sleep, or someone has already sent the wakeup.
+  if (!IsInEvThread() &&
+      !wakeup_pending_.exchange(true, std::memory_order_acq_rel)) {
     ev_async_send(loop_, &watch_update_);
   }
 }
@@ -129,6 +157,19 @@ bool Thread::IsInEvThread() const {
   return (std::this_thread::get_id() == thread_.get_id());
 }
 
+void Thread::StartTimer(TimerWheel::Entry& entry,
+                        TimerWheel::TimePoint expiry) noexcept {
+  UASSERT(IsInEvThread());
+  timer_wheel_.Add(entry, expiry);
+  ArmTimerWheelWatcher();
+}
+
+void Thread::StopTimer(TimerWheel::Entry& entry) noexcept {
+  UASSERT(IsInEvThread());
+  // The watcher is not rearmed here, a spurious wakeup is cheaper
+  timer_wheel_.Remove(entry);
+}
+
 std::uint8_t Thread::GetCurrentLoadPercent() const {
   return cpu_stats_storage_.GetCurrentLoadPercent();
 }
@@ -154,6 +195,9 @@ void Thread::Start() {
   ev_set_priority(&watch_break_, EV_MAXPRI);
   ev_async_start(loop_, &watch_break_);
 
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  ev_timer_init(&timer_wheel_watcher_, TimerWheelWatcher, 0.0, 0.0);
+
   using LibEvDuration = std::chrono::duration<double>;
   if (register_event_mode_ == RegisterEventMode::kDeferred) {
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
@@ -183,6 +227,13 @@ void Thread::Start() {
   is_running_ = true;
   thread_ = std::thread([this] {
     utils::SetCurrentThreadName(name_);
+    if (!placement_.IsEmpty()) {
+      try {
+        placement_.ApplyToCurrentThread(cpus_);
+      } catch (const std::exception& ex) {
+        LOG_ERROR() << "Failed to pin ev thread " << name_ << ": " << ex;
+      }
+    }
     RunEvLoop();
   });
 }
@@ -202,14 +253,17 @@ void Thread::StopEventLoop() {
 void Thread::RunEvLoop() {
   while (is_running_) {
     AcquireImpl();
+    drained_since_poll_ = 0;
     ev_run(loop_, EVRUN_ONCE);
     UpdateLoopWatcherImpl();
+    if (drained_since_poll_ != 0) PollFuncQueue();
     cpu_stats_storage_.Collect();
     ReleaseImpl();
   }
 
   ev_async_stop(loop_, &watch_update_);
   ev_async_stop(loop_, &watch_break_);
+  ev_timer_stop(loop_, &timer_wheel_watcher_);
   if (register_event_mode_ == RegisterEventMode::kDeferred) {
     ev_timer_stop(loop_, &timers_driver_);
   } else {
@@ -218,6 +272,38 @@ void Thread::RunEvLoop() {
   if (use_ev_default_loop_) ev_child_stop(loop_, &watch_child_);
 }
 
+// Payloads come in bursts under load. Instead of going to sleep right away and
+// making the producers wake us up through ev_async_send (an eventfd write
+// each), keep the wakeup flag set and busy-poll the queue for a while,
+// processing ready fds and timers between the batches.
+void Thread::PollFuncQueue() {
+  wakeup_pending_.exchange(true, std::memory_order_acq_rel);
+
+  bool found_payloads = false;
+  std::size_t idle_iterations = 0;
+  std::size_t batches = 0;
+  while (is_running_ && idle_iterations < poll_iterations_ &&
+         batches < kMaxPolledBatches) {
+    if (DrainFuncQueue() == 0) {
+      ++idle_iterations;
+      CpuPause();
+      continue;
+    }
+
+    found_payloads = true;
+    idle_iterations = 0;
+    ++batches;
+    ev_run(loop_, EVRUN_NOWAIT);
+  }
+
+  poll_iterations_ = found_payloads
+                         ? std::min(poll_iterations_ * 2, kMaxPollIterations)
+                         : std::max(poll_iterations_ / 2, kMinPollIterations);
+
+  // Re-enable the wakeups and pick up the payloads pushed meanwhile
+  UpdateLoopWatcherImpl();
+}
+
 void Thread::UpdateLoopWatcher(struct ev_loop* loop, ev_async*, int) noexcept {
   auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
   UASSERT(ev_thread != nullptr);
@@ -232,7 +318,17 @@ void Thread::UpdateTimersWatcher(struct ev_loop* loop, ev_timer*,
 }
 
 void Thread::UpdateLoopWatcherImpl() {
+  // Producers that have seen the flag set skip ev_async_send, so it must be
+  // reset before draining the queue. The RMW synchronizes with them, making
+  // their payloads visible to the DrainFuncQueue below.
+  wakeup_pending_.exchange(false, std::memory_order_acq_rel);
+  DrainFuncQueue();
+}
+
+std::size_t Thread::DrainFuncQueue() {
+  std::size_t drained = 0;
   while (AsyncPayloadBase* payload = func_queue_.TryPop()) {
+    ++drained;
     LOG_TRACE() << "Thread::UpdateLoopWatcherImpl(), "
                 << compiler::GetTypeName(typeid(*payload));
     try {
@@ -241,6 +337,45 @@ void Thread::UpdateLoopWatcherImpl() {
       LOG_WARNING() << "exception in async thread func: " << ex;
     }
   }
+  drained_since_poll_ += drained;
+  return drained;
+}
+
+void Thread::TimerWheelWatcher(struct ev_loop* loop, ev_timer*,
+                               int) noexcept {
+  auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
+  UASSERT(ev_thread != nullptr);
+  try {
+    ev_thread->TimerWheelWatcherImpl();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Exception in TimerWheelWatcherImpl(): " << ex;
+  }
+}
+
+void Thread::TimerWheelWatcherImpl() {
+  // The watcher is single-shot, it is stopped at this point
+  timer_wheel_wakeup_.reset();
+  timer_wheel_.Advance(TimerWheel::Clock::now());
+  ArmTimerWheelWatcher();
+}
+
+void Thread::ArmTimerWheelWatcher() noexcept {
+  const auto next_wakeup = timer_wheel_.GetNextWakeup();
+  if (next_wakeup == timer_wheel_wakeup_) return;
+  timer_wheel_wakeup_ = next_wakeup;
+
+  ev_timer_stop(loop_, &timer_wheel_watcher_);
+  if (!next_wakeup) return;
+
+  using LibEvDuration = std::chrono::duration<double>;
+  const auto time_left =
+      std::max(*next_wakeup - TimerWheel::Clock::now(),
+               TimerWheel::Clock::duration::zero());
+  ev_now_update(loop_);
+  ev_timer_set(&timer_wheel_watcher_,
+               std::chrono::duration_cast<LibEvDuration>(time_left).count(),
+               0.0);
+  ev_timer_start(loop_, &timer_wheel_watcher_);
 }
 
 void Thread::BreakLoopWatcher(struct ev_loop* loop, ev_async*, int) noexcept {
@@ -265,9 +400,10 @@ void Thread::ChildWatcher(struct ev_loop*, ev_child* w, int) noexcept {
 
 void Thread::ChildWatcherImpl(ev_child* w) {
   auto* child_process_info = ChildProcessMapGetOptional(w->rpid);
-  UASSERT(child_process_info);
   if (!child_process_info) {
-    LOG_ERROR()
+    // With the zygote the current process is a child subreaper, and the
+    // orphaned descendants of the started processes are reparented to it
+    LOG_WARNING()
         << "Got signal for thread with pid=" << w->rpid
         << ", status=" << w->rstatus
         << ", but thread with this pid was not found in child_process_map";
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 
@@ -12,6 +13,8 @@
 
 #include <concurrent/impl/intrusive_mpsc_queue.hpp>
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/timer_wheel.hpp>
+#include <utils/numa.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -34,8 +37,10 @@ class Thread final {
     kDeferred
   };
 
-  Thread(const std::string& thread_name, RegisterEventMode);
-  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode);
+  Thread(const std::string& thread_name, RegisterEventMode,
+         const utils::numa::ThreadPlacement& placement = {});
+  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode,
+         const utils::numa::ThreadPlacement& placement = {});
   ~Thread();
 
   struct ev_loop* GetEvLoop() const { return loop_; }
@@ -52,12 +57,19 @@ class Thread final {
 
   bool IsInEvThread() const;
 
+  // Timers of the thread are kept in a timer wheel driven by a single
+  // ev_timer. Must be called from the ev thread.
+  void StartTimer(TimerWheel::Entry& entry,
+                  TimerWheel::TimePoint expiry) noexcept;
+  void StopTimer(TimerWheel::Entry& entry) noexcept;
+
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
 
  private:
   Thread(const std::string& thread_name, bool use_ev_default_loop,
-         RegisterEventMode register_event_mode);
+         RegisterEventMode register_event_mode,
+         const utils::numa::ThreadPlacement& placement);
 
   void RegisterInEvLoop(AsyncPayloadBase& payload);
 
@@ -65,10 +77,15 @@ class Thread final {
 
   void StopEventLoop();
   void RunEvLoop();
+  void PollFuncQueue();
 
   static void UpdateLoopWatcher(struct ev_loop*, ev_async* w, int) noexcept;
   static void UpdateTimersWatcher(struct ev_loop*, ev_timer* w, int) noexcept;
   void UpdateLoopWatcherImpl();
+  std::size_t DrainFuncQueue();
+  static void TimerWheelWatcher(struct ev_loop*, ev_timer* w, int) noexcept;
+  void TimerWheelWatcherImpl();
+  void ArmTimerWheelWatcher() noexcept;
   static void BreakLoopWatcher(struct ev_loop*, ev_async* w, int) noexcept;
   void BreakLoopWatcherImpl();
   static void ChildWatcher(struct ev_loop*, ev_child* w, int) noexcept;
@@ -80,6 +97,11 @@ class Thread final {
   void ReleaseImpl() noexcept;
 
   concurrent::impl::IntrusiveMpscQueue<AsyncPayloadBase> func_queue_;
+  // Set while the ev thread is awake or is going to wake up: producers call
+  // ev_async_send only if they are the first to set it.
+  std::atomic<bool> wakeup_pending_{false};
+  std::size_t drained_since_poll_{0};
+  std::size_t poll_iterations_;
 
   bool use_ev_default_loop_;
   RegisterEventMode register_event_mode_;
@@ -89,13 +111,20 @@ class Thread final {
   std::mutex loop_mutex_;
   std::unique_lock<std::mutex> lock_;
 
+  TimerWheel timer_wheel_;
+  // The time point timer_wheel_watcher_ is armed for, if any
+  std::optional<TimerWheel::TimePoint> timer_wheel_wakeup_;
+
   ev_timer timers_driver_{};
+  ev_timer timer_wheel_watcher_{};
   ev_timer stats_timer_{};
   ev_async watch_update_{};
   ev_async watch_break_{};
   ev_child watch_child_{};
 
   const std::string name_;
+  const utils::numa::ThreadPlacement placement_;
+  const utils::numa::CpuSet cpus_;
   utils::statistics::ThreadCpuStatsStorage cpu_stats_storage_;
 
   bool is_running_;
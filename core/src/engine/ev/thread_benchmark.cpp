@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <engine/ev/thread.hpp>
+#include <engine/ev/thread_control.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kPayloadsPerIteration = 1000;
+
+}  // namespace
+
+// Measures the throughput of payloads submission from several producer
+// threads into a single ev thread, i.e. the cost of watcher starts and stops
+// issued by coroutines waiting on sockets.
+void ev_thread_run_in_ev_loop_async(benchmark::State& state) {
+  engine::ev::Thread thread("bench-ev",
+                            engine::ev::Thread::RegisterEventMode::kImmediate);
+  engine::ev::ThreadControl thread_control(thread);
+
+  const auto producers_count = static_cast<std::size_t>(state.range(0));
+  std::atomic<std::size_t> executed{0};
+  std::size_t expected = 0;
+
+  for ([[maybe_unused]] auto _ : state) {
+    std::vector<std::thread> producers;
+    producers.reserve(producers_count);
+    for (std::size_t i = 0; i < producers_count; ++i) {
+      producers.emplace_back([&] {
+        for (std::size_t j = 0; j < kPayloadsPerIteration; ++j) {
+          thread_control.RunInEvLoopAsync(
+              [&executed] { executed.fetch_add(1, std::memory_order_relaxed); });
+        }
+      });
+    }
+    for (auto& producer : producers) producer.join();
+
+    expected += producers_count * kPayloadsPerIteration;
+    while (executed.load(std::memory_order_relaxed) != expected) {
+      std::this_thread::yield();
+    }
+  }
+
+  state.SetItemsProcessed(static_cast<std::int64_t>(expected));
+}
+BENCHMARK(ev_thread_run_in_ev_loop_async)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime();
+
+USERVER_NAMESPACE_END
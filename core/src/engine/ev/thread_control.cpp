@@ -56,6 +56,17 @@ void ThreadControlBase::DoAgain(ev_timer& w) noexcept {
   ev_timer_again(GetEvLoop(), &w);
 }
 
+// NOLINTNEXTLINE(readability-make-member-function-const)
+void ThreadControlBase::DoStart(TimerWheel::Entry& entry,
+                                TimerWheel::TimePoint expiry) noexcept {
+  thread_.StartTimer(entry, expiry);
+}
+
+// NOLINTNEXTLINE(readability-make-member-function-const)
+void ThreadControlBase::DoStop(TimerWheel::Entry& entry) noexcept {
+  thread_.StopTimer(entry);
+}
+
 // NOLINTNEXTLINE(readability-make-member-function-const)
 void ThreadControlBase::DoStart(ev_async& w) noexcept {
   UASSERT(IsInEvThread());
@@ -89,13 +100,15 @@ TimerThreadControl::TimerThreadControl(Thread& thread) noexcept
     : ThreadControlBase{thread} {}
 
 // NOLINTNEXTLINE(readability-make-member-function-const)
-void TimerThreadControl::Start(ev_timer& w) noexcept { DoStart(w); }
-
-// NOLINTNEXTLINE(readability-make-member-function-const)
-void TimerThreadControl::Stop(ev_timer& w) noexcept { DoStop(w); }
+void TimerThreadControl::Start(TimerWheel::Entry& entry,
+                               TimerWheel::TimePoint expiry) noexcept {
+  DoStart(entry, expiry);
+}
 
 // NOLINTNEXTLINE(readability-make-member-function-const)
-void TimerThreadControl::Again(ev_timer& w) noexcept { DoAgain(w); }
+void TimerThreadControl::Stop(TimerWheel::Entry& entry) noexcept {
+  DoStop(entry);
+}
 
 ThreadControl::ThreadControl(Thread& thread) noexcept
     : ThreadControlBase{thread} {}
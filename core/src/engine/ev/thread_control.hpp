@@ -9,6 +9,7 @@
 #include <ev.h>
 
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/timer_wheel.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/single_use_event.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
@@ -139,6 +140,9 @@ class ThreadControlBase {
   void DoStop(ev_timer& w) noexcept;
   void DoAgain(ev_timer& w) noexcept;
 
+  void DoStart(TimerWheel::Entry& entry, TimerWheel::TimePoint expiry) noexcept;
+  void DoStop(TimerWheel::Entry& entry) noexcept;
+
   void DoStart(ev_async& w) noexcept;
   void DoStop(ev_async& w) noexcept;
   void DoSend(ev_async& w) noexcept;
@@ -211,9 +215,9 @@ class TimerThreadControl final : public ThreadControlBase {
  public:
   explicit TimerThreadControl(Thread& thread) noexcept;
 
-  void Start(ev_timer& w) noexcept;
-  void Stop(ev_timer& w) noexcept;
-  void Again(ev_timer& w) noexcept;
+  /// Starts or restarts the timer in the timer wheel of the ev thread.
+  void Start(TimerWheel::Entry& entry, TimerWheel::TimePoint expiry) noexcept;
+  void Stop(TimerWheel::Entry& entry) noexcept;
 };
 
 class ThreadControl final : public ThreadControlBase {
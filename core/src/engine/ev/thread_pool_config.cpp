@@ -13,6 +13,9 @@ ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
           config.dedicated_timer_threads);
   config.thread_name = value["thread_name"].As<std::string>(config.thread_name);
   config.defer_events = value["defer_events"].As<bool>(config.defer_events);
+  config.io_uring_entries =
+      value["io_uring_entries"].As<std::size_t>(config.io_uring_entries);
+  config.placement = value.As<utils::numa::ThreadPlacement>();
   return config;
 }
 
@@ -5,6 +5,8 @@
 #include <userver/formats/yaml.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
+#include <utils/numa.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
@@ -15,6 +17,8 @@ struct ThreadPoolConfig {
   std::string thread_name = "event-worker";
   bool ev_default_loop_disabled = false;
   bool defer_events = false;
+  std::size_t io_uring_entries = 0;
+  utils::numa::ThreadPlacement placement;
 };
 
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
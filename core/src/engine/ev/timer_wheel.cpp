@@ -0,0 +1,188 @@
+#include <engine/ev/timer_wheel.hpp>
+
+#include <algorithm>
+
+#include <boost/intrusive/list.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+namespace {
+
+std::uint64_t RotateRight(std::uint64_t value, std::size_t shift) noexcept {
+  shift %= 64;
+  if (shift == 0) return value;
+  return (value >> shift) | (value << (64 - shift));
+}
+
+}  // namespace
+
+struct TimerWheel::Slot final {
+  boost::intrusive::list<
+      Entry,
+      boost::intrusive::member_hook<Entry, boost::intrusive::list_member_hook<>,
+                                    &Entry::hook_>,
+      boost::intrusive::constant_time_size<false>>
+      entries;
+};
+
+TimerWheel::Entry::~Entry() { UASSERT(!IsScheduled()); }
+
+TimerWheel::TimerWheel(TimePoint now)
+    : origin_(now),
+      slots_(std::make_unique<Slot[]>(kLevels * kSlotsPerLevel)) {}
+
+TimerWheel::~TimerWheel() {
+  UASSERT_MSG(size_ == 0, "Timers are left scheduled on TimerWheel destruction");
+  for (std::size_t i = 0; i < kLevels * kSlotsPerLevel; ++i) {
+    slots_[i].entries.clear();
+  }
+}
+
+void TimerWheel::Add(Entry& entry, TimePoint expiry) noexcept {
+  Remove(entry);
+
+  // The current tick has already been fired
+  entry.expiry_tick_ = std::max(ToTickCeil(expiry), current_tick_ + 1);
+  Insert(entry);
+  ++size_;
+}
+
+void TimerWheel::Remove(Entry& entry) noexcept {
+  if (!entry.IsScheduled()) return;
+
+  auto& entries = slots_[entry.slot_].entries;
+  entries.erase(entries.iterator_to(entry));
+  if (entries.empty()) {
+    occupied_[entry.slot_ / kSlotsPerLevel] &=
+        ~(std::uint64_t{1} << (entry.slot_ % kSlotsPerLevel));
+  }
+  --size_;
+}
+
+void TimerWheel::Advance(TimePoint now) {
+  const auto now_tick = ToTickFloor(now);
+
+  while (current_tick_ < now_tick) {
+    if (size_ == 0) {
+      current_tick_ = now_tick;
+      break;
+    }
+
+    if (occupied_[0] == 0) {
+      // Nothing to fire until the next cascade
+      const auto granularity = GetCascadeGranularity();
+      current_tick_ = std::min(
+          now_tick, current_tick_ / granularity * granularity + granularity - 1);
+      if (current_tick_ == now_tick) break;
+    }
+
+    ++current_tick_;
+    for (std::size_t level = 1; level < kLevels; ++level) {
+      const auto level_mask = (Tick{1} << (kLevelBits * level)) - 1;
+      if ((current_tick_ & level_mask) != 0) break;
+      Cascade(level);
+    }
+    FireSlot(current_tick_ % kSlotsPerLevel);
+  }
+}
+
+std::optional<TimerWheel::TimePoint> TimerWheel::GetNextWakeup()
+    const noexcept {
+  if (size_ == 0) return std::nullopt;
+
+  const auto granularity = GetCascadeGranularity();
+  Tick ticks_left = granularity - current_tick_ % granularity;
+
+  const auto next_occupied =
+      RotateRight(occupied_[0], (current_tick_ + 1) % kSlotsPerLevel);
+  if (next_occupied != 0) {
+    ticks_left = std::min<Tick>(ticks_left, __builtin_ctzll(next_occupied) + 1);
+  }
+
+  return origin_ + (current_tick_ + ticks_left) * kTick;
+}
+
+// Upper levels are cascaded when the lower levels wrap around. Returns the
+// period of the cascades that may bring timers to the lowest level.
+TimerWheel::Tick TimerWheel::GetCascadeGranularity() const noexcept {
+  std::size_t level = 1;
+  while (level + 1 < kLevels && occupied_[level] == 0 &&
+         occupied_[0] == 0) {
+    ++level;
+  }
+  return Tick{1} << (kLevelBits * level);
+}
+
+TimerWheel::Tick TimerWheel::ToTickCeil(TimePoint time_point) const noexcept {
+  const auto elapsed = time_point - origin_;
+  if (elapsed <= Clock::duration::zero()) return 0;
+  return (elapsed + kTick - Clock::duration{1}) / kTick;
+}
+
+TimerWheel::Tick TimerWheel::ToTickFloor(TimePoint time_point) const noexcept {
+  const auto elapsed = time_point - origin_;
+  if (elapsed <= Clock::duration::zero()) return 0;
+  return elapsed / kTick;
+}
+
+void TimerWheel::Insert(Entry& entry) noexcept {
+  UASSERT(entry.expiry_tick_ >= current_tick_);
+  const auto delta = entry.expiry_tick_ - current_tick_;
+
+  std::size_t level = 0;
+  while (level + 1 < kLevels &&
+         delta >= (Tick{1} << (kLevelBits * (level + 1)))) {
+    ++level;
+  }
+
+  // Timers beyond the wheel range are re-inserted on each pass of the upper
+  // level.
+  constexpr Tick kMaxDelta = (Tick{1} << (kLevelBits * kLevels)) - 1;
+  const auto placement_tick = current_tick_ + std::min(delta, kMaxDelta);
+  const auto index =
+      (placement_tick >> (kLevelBits * level)) % kSlotsPerLevel;
+
+  entry.slot_ = static_cast<std::uint16_t>(level * kSlotsPerLevel + index);
+  slots_[entry.slot_].entries.push_back(entry);
+  occupied_[level] |= std::uint64_t{1} << index;
+}
+
+void TimerWheel::Cascade(std::size_t level) noexcept {
+  const auto index = (current_tick_ >> (kLevelBits * level)) % kSlotsPerLevel;
+  if (!(occupied_[level] & (std::uint64_t{1} << index))) return;
+
+  decltype(Slot::entries) entries;
+  entries.swap(slots_[level * kSlotsPerLevel + index].entries);
+  occupied_[level] &= ~(std::uint64_t{1} << index);
+
+  while (!entries.empty()) {
+    auto& entry = entries.front();
+    entries.pop_front();
+    Insert(entry);
+  }
+}
+
+void TimerWheel::FireSlot(std::size_t slot) {
+  if (!(occupied_[0] & (std::uint64_t{1} << slot))) return;
+
+  auto& entries = slots_[slot].entries;
+  occupied_[0] &= ~(std::uint64_t{1} << slot);
+
+  // Callbacks may add, remove or destroy other entries of this slot, so
+  // the entries are unlinked one by one.
+  while (!entries.empty()) {
+    auto& entry = entries.front();
+    UASSERT(entry.expiry_tick_ == current_tick_);
+    entries.pop_front();
+    --size_;
+    entry.callback_(entry.data_);
+  }
+}
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
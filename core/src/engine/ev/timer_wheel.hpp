@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include <boost/intrusive/list_hook.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+/// @brief Hierarchical timer wheel with 1ms ticks.
+///
+/// Timers that expire within the same tick are fired in a single batch, add
+/// and remove are O(1). Timers fire not earlier than requested and at most one
+/// tick later.
+///
+/// Not thread-safe, each ev thread owns its own wheel.
+class TimerWheel final {
+ public:
+  using Clock = std::chrono::steady_clock;
+  using TimePoint = Clock::time_point;
+
+  static constexpr std::chrono::milliseconds kTick{1};
+
+  class Entry;
+
+  explicit TimerWheel(TimePoint now = Clock::now());
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+  ~TimerWheel();
+
+  /// Schedules the entry to fire at `expiry`, reschedules if already added.
+  void Add(Entry& entry, TimePoint expiry) noexcept;
+
+  /// Does nothing if the entry is not scheduled.
+  void Remove(Entry& entry) noexcept;
+
+  /// Fires all the entries that have expired by `now`.
+  void Advance(TimePoint now);
+
+  /// @returns the time point at which Advance should be called next, or
+  /// std::nullopt if there are no timers
+  std::optional<TimePoint> GetNextWakeup() const noexcept;
+
+  std::size_t GetSize() const noexcept { return size_; }
+
+ private:
+  static constexpr std::size_t kLevelBits = 6;
+  static constexpr std::size_t kSlotsPerLevel = 1 << kLevelBits;
+  static constexpr std::size_t kLevels = 4;
+
+  using Tick = std::uint64_t;
+
+  Tick GetCascadeGranularity() const noexcept;
+  Tick ToTickCeil(TimePoint time_point) const noexcept;
+  Tick ToTickFloor(TimePoint time_point) const noexcept;
+
+  void Insert(Entry& entry) noexcept;
+  void Cascade(std::size_t level) noexcept;
+  void FireSlot(std::size_t slot);
+
+  struct Slot;
+
+  const TimePoint origin_;
+  Tick current_tick_{0};
+  std::size_t size_{0};
+  std::array<std::uint64_t, kLevels> occupied_{};
+  std::unique_ptr<Slot[]> slots_;
+};
+
+class TimerWheel::Entry final {
+ public:
+  using Callback = void (*)(void* data) noexcept;
+
+  Entry(Callback callback, void* data) noexcept
+      : callback_(callback), data_(data) {}
+
+  Entry(const Entry&) = delete;
+  Entry& operator=(const Entry&) = delete;
+  ~Entry();
+
+  bool IsScheduled() const noexcept { return hook_.is_linked(); }
+
+ private:
+  friend class TimerWheel;
+
+  boost::intrusive::list_member_hook<> hook_;
+  Tick expiry_tick_{0};
+  std::uint16_t slot_{0};
+  Callback callback_;
+  void* data_;
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
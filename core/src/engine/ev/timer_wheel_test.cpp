@@ -0,0 +1,150 @@
+#include <engine/ev/timer_wheel.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+using engine::ev::TimerWheel;
+
+namespace {
+
+using namespace std::chrono_literals;
+
+struct TestTimer final {
+  TestTimer() : entry(&OnTimer, this) {}
+
+  static void OnTimer(void* data) noexcept {
+    static_cast<TestTimer*>(data)->fired_count++;
+  }
+
+  int fired_count{0};
+  TimerWheel::Entry entry;
+};
+
+// Advances the wheel the way an ev thread does: wakes up when asked to
+void AdvanceByWakeups(TimerWheel& wheel, TimerWheel::TimePoint until) {
+  while (const auto wakeup = wheel.GetNextWakeup()) {
+    if (*wakeup > until) break;
+    wheel.Advance(*wakeup);
+  }
+  wheel.Advance(until);
+}
+
+}  // namespace
+
+TEST(TimerWheel, FiresNotEarlier) {
+  const auto now = TimerWheel::Clock::now();
+  TimerWheel wheel{now};
+  TestTimer timer;
+
+  wheel.Add(timer.entry, now + 5ms + 100us);
+  EXPECT_TRUE(timer.entry.IsScheduled());
+  EXPECT_EQ(wheel.GetSize(), 1);
+
+  wheel.Advance(now + 5ms);
+  EXPECT_EQ(timer.fired_count, 0);
+
+  wheel.Advance(now + 6ms);
+  EXPECT_EQ(timer.fired_count, 1);
+  EXPECT_FALSE(timer.entry.IsScheduled());
+  EXPECT_EQ(wheel.GetSize(), 0);
+  EXPECT_FALSE(wheel.GetNextWakeup());
+}
+
+TEST(TimerWheel, Remove) {
+  const auto now = TimerWheel::Clock::now();
+  TimerWheel wheel{now};
+  TestTimer timer;
+
+  wheel.Add(timer.entry, now + 1s);
+  wheel.Remove(timer.entry);
+  EXPECT_FALSE(timer.entry.IsScheduled());
+  EXPECT_EQ(wheel.GetSize(), 0);
+
+  wheel.Advance(now + 2s);
+  EXPECT_EQ(timer.fired_count, 0);
+
+  // Removing an unscheduled entry is a noop
+  wheel.Remove(timer.entry);
+}
+
+TEST(TimerWheel, Reschedule) {
+  const auto now = TimerWheel::Clock::now();
+  TimerWheel wheel{now};
+  TestTimer timer;
+
+  wheel.Add(timer.entry, now + 10ms);
+  wheel.Add(timer.entry, now + 100ms);
+  EXPECT_EQ(wheel.GetSize(), 1);
+
+  wheel.Advance(now + 50ms);
+  EXPECT_EQ(timer.fired_count, 0);
+  wheel.Advance(now + 100ms);
+  EXPECT_EQ(timer.fired_count, 1);
+}
+
+TEST(TimerWheel, PastExpiryFiresOnNextTick) {
+  const auto now = TimerWheel::Clock::now();
+  TimerWheel wheel{now};
+  TestTimer timer;
+
+  wheel.Advance(now + 10ms);
+  wheel.Add(timer.entry, now);
+  wheel.Advance(now + 10ms);
+  EXPECT_EQ(timer.fired_count, 0);
+  wheel.Advance(now + 11ms);
+  EXPECT_EQ(timer.fired_count, 1);
+}
+
+TEST(TimerWheel, Cascades) {
+  const auto now = TimerWheel::Clock::now();
+  TimerWheel wheel{now};
+
+  const std::vector<TimerWheel::Clock::duration> timeouts{
+      1ms, 63ms, 64ms, 65ms, 1s, 4096ms, 5s, 100s, 300s, 1h, 10h};
+  std::vector<TestTimer> timers(timeouts.size());
+  for (std::size_t i = 0; i < timeouts.size(); ++i) {
+    wheel.Add(timers[i].entry, now + timeouts[i]);
+  }
+
+  for (std::size_t i = 0; i < timeouts.size(); ++i) {
+    AdvanceByWakeups(wheel, now + timeouts[i] - 1ms);
+    EXPECT_EQ(timers[i].fired_count, 0) << i;
+
+    AdvanceByWakeups(wheel, now + timeouts[i]);
+    EXPECT_EQ(timers[i].fired_count, 1) << i;
+  }
+  EXPECT_EQ(wheel.GetSize(), 0);
+}
+
+TEST(TimerWheel, CallbackMayScheduleTimers) {
+  const auto now = TimerWheel::Clock::now();
+  TimerWheel wheel{now};
+
+  struct Rescheduler final {
+    static void OnTimer(void* data) noexcept {
+      auto& self = *static_cast<Rescheduler*>(data);
+      if (++self.fired_count < 3) {
+        self.wheel.Add(self.entry, self.wheel_now + 1ms);
+      }
+    }
+
+    TimerWheel& wheel;
+    TimerWheel::TimePoint wheel_now;
+    int fired_count{0};
+    TimerWheel::Entry entry{&OnTimer, this};
+  };
+
+  Rescheduler rescheduler{wheel, now};
+  wheel.Add(rescheduler.entry, now + 1ms);
+  for (int i = 1; i <= 10; ++i) {
+    rescheduler.wheel_now = now + std::chrono::milliseconds{i};
+    wheel.Advance(rescheduler.wheel_now);
+  }
+  EXPECT_EQ(rescheduler.fired_count, 3);
+  EXPECT_EQ(wheel.GetSize(), 0);
+}
+
+USERVER_NAMESPACE_END
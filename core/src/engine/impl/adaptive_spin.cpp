@@ -0,0 +1,16 @@
+#include <engine/impl/adaptive_spin.hpp>
+
+#include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+bool IsSpinningUseful(TaskContext& current) noexcept {
+  return current.GetTaskProcessor().GetWorkerCount() > 1;
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
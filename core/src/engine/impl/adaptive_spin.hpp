@@ -0,0 +1,65 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#include <compiler/relax_cpu.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+class TaskContext;
+
+/// @brief Self-tuning spin-wait budget for the "spin-then-park" locking.
+///
+/// Critical sections of a few hundred nanoseconds are much cheaper to wait for
+/// by spinning than by a context switch. The budget doubles the iterations
+/// count that was required for the recent successful spins and is halved on
+/// each failed spin, so that long critical sections quickly stop spinning.
+class AdaptiveSpin final {
+ public:
+  static constexpr std::uint32_t kMinIterations = 8;
+  static constexpr std::uint32_t kMaxIterations = 1024;
+
+  /// Calls `try_lock` while it returns `false`, up to the current budget.
+  /// @returns `true` if `try_lock` has succeeded
+  template <typename TryLock>
+  bool Spin(TaskContext& current, TryLock&& try_lock) noexcept;
+
+ private:
+  std::atomic<std::uint32_t> budget_{kMinIterations};
+};
+
+/// Spinning is only useful if the lock owner may run in parallel with the
+/// current task, i.e. there are other workers in its TaskProcessor.
+bool IsSpinningUseful(TaskContext& current) noexcept;
+
+template <typename TryLock>
+bool AdaptiveSpin::Spin(TaskContext& current, TryLock&& try_lock) noexcept {
+  if (!IsSpinningUseful(current)) return false;
+
+  const auto budget = budget_.load(std::memory_order_relaxed);
+  compiler::RelaxCpu relax;
+  for (std::uint32_t i = 0; i < budget; ++i) {
+    relax();
+    if (try_lock()) {
+      const auto new_budget = std::clamp(2 * (i + 1), budget, kMaxIterations);
+      if (new_budget != budget) {
+        budget_.store(new_budget, std::memory_order_relaxed);
+      }
+      return true;
+    }
+  }
+
+  const auto new_budget = std::max(budget / 2, kMinIterations);
+  if (new_budget != budget) {
+    budget_.store(new_budget, std::memory_order_relaxed);
+  }
+  return false;
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
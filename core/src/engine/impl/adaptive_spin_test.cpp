@@ -0,0 +1,107 @@
+#include <engine/impl/adaptive_spin.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <engine/task/task_context.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/shared_mutex.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using engine::impl::AdaptiveSpin;
+
+// Returns the number of the `try_lock` calls of a spin that never succeeds,
+// i.e. the current budget. Halves the budget as a side effect.
+std::uint32_t SpinUntilFailure(AdaptiveSpin& spin) {
+  std::uint32_t calls = 0;
+  EXPECT_FALSE(spin.Spin(engine::current_task::GetCurrentTaskContext(),
+                         [&calls] {
+                           ++calls;
+                           return false;
+                         }));
+  return calls;
+}
+
+// Succeeds on the `successful_call`-th call of `try_lock`
+bool SpinUntil(AdaptiveSpin& spin, std::uint32_t successful_call) {
+  std::uint32_t calls = 0;
+  return spin.Spin(engine::current_task::GetCurrentTaskContext(),
+                   [&calls, successful_call] {
+                     return ++calls == successful_call;
+                   });
+}
+
+template <typename Mutex>
+void CheckShortCriticalSections() {
+  constexpr std::size_t kTasks = 8;
+  constexpr std::size_t kIterations = 10000;
+
+  Mutex mutex;
+  std::size_t counter = 0;
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      for (std::size_t j = 0; j < kIterations; ++j) {
+        std::lock_guard lock{mutex};
+        ++counter;
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(counter, kTasks * kIterations);
+}
+
+}  // namespace
+
+UTEST(AdaptiveSpin, NoSpinningOnSingleThread) {
+  AdaptiveSpin spin;
+  EXPECT_EQ(SpinUntilFailure(spin), 0U);
+  EXPECT_FALSE(SpinUntil(spin, 1));
+}
+
+UTEST_MT(AdaptiveSpin, BudgetAdapts, 2) {
+  AdaptiveSpin spin;
+  EXPECT_EQ(SpinUntilFailure(spin), AdaptiveSpin::kMinIterations);
+
+  // Short successful spins keep the budget
+  EXPECT_TRUE(SpinUntil(spin, 1));
+  EXPECT_EQ(SpinUntilFailure(spin), AdaptiveSpin::kMinIterations);
+
+  // A spin that succeeds at the end of the budget doubles it
+  EXPECT_TRUE(SpinUntil(spin, AdaptiveSpin::kMinIterations));
+  EXPECT_TRUE(SpinUntil(spin, AdaptiveSpin::kMinIterations * 2));
+  EXPECT_EQ(SpinUntilFailure(spin), AdaptiveSpin::kMinIterations * 4);
+
+  // Each failed spin halves it
+  EXPECT_EQ(SpinUntilFailure(spin), AdaptiveSpin::kMinIterations * 2);
+  EXPECT_EQ(SpinUntilFailure(spin), AdaptiveSpin::kMinIterations);
+  EXPECT_EQ(SpinUntilFailure(spin), AdaptiveSpin::kMinIterations);
+}
+
+UTEST_MT(AdaptiveSpin, BudgetIsLimited, 2) {
+  AdaptiveSpin spin;
+  for (auto budget = AdaptiveSpin::kMinIterations;
+       budget < AdaptiveSpin::kMaxIterations; budget *= 2) {
+    EXPECT_TRUE(SpinUntil(spin, budget));
+  }
+  EXPECT_TRUE(SpinUntil(spin, AdaptiveSpin::kMaxIterations));
+  EXPECT_FALSE(SpinUntil(spin, AdaptiveSpin::kMaxIterations + 1));
+  EXPECT_EQ(SpinUntilFailure(spin), AdaptiveSpin::kMaxIterations / 2);
+}
+
+UTEST_MT(AdaptiveSpin, MutexShortCriticalSections, 4) {
+  CheckShortCriticalSections<engine::Mutex>();
+}
+
+UTEST_MT(AdaptiveSpin, SharedMutexShortCriticalSections, 4) {
+  CheckShortCriticalSections<engine::SharedMutex>();
+}
+
+USERVER_NAMESPACE_END
@@ -6,6 +6,7 @@
 
 #include <userver/utils/assert.hpp>
 
+#include <engine/impl/adaptive_spin.hpp>
 #include <engine/impl/wait_list.hpp>
 #include <engine/impl/wait_list_light.hpp>
 #include <engine/task/task_context.hpp>
@@ -38,9 +39,11 @@ class MutexImpl {
   class MutexWaitStrategy;
 
   bool LockFastPath(TaskContext&) noexcept;
+  bool LockSpinPath(TaskContext&) noexcept;
   bool LockSlowPath(TaskContext&, Deadline);
 
   std::atomic<TaskContext*> owner_;
+  AdaptiveSpin spin_;
   Waiters lock_waiters_;
 };
 
@@ -113,6 +116,14 @@ bool MutexImpl<Waiters>::LockFastPath(TaskContext& current) noexcept {
                                         std::memory_order_acquire);
 }
 
+template <class Waiters>
+bool MutexImpl<Waiters>::LockSpinPath(TaskContext& current) noexcept {
+  return spin_.Spin(current, [this, &current] {
+    return owner_.load(std::memory_order_relaxed) == nullptr &&
+           LockFastPath(current);
+  });
+}
+
 template <class Waiters>
 bool MutexImpl<Waiters>::LockSlowPath(TaskContext& current, Deadline deadline) {
   TaskContext* expected = nullptr;
@@ -187,7 +198,9 @@ bool MutexImpl<Waiters>::try_lock_until(Deadline deadline) {
 #endif
 
   auto& current = current_task::GetCurrentTaskContext();
-  const auto result = LockFastPath(current) || LockSlowPath(current, deadline);
+  const auto result = LockFastPath(current) ||
+                      (!deadline.IsReached() && LockSpinPath(current)) ||
+                      LockSlowPath(current, deadline);
 
 #if USERVER_IMPL_HAS_TSAN
   __tsan_mutex_post_lock(
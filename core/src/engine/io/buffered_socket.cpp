@@ -0,0 +1,99 @@
+#include <userver/engine/io/buffered_socket.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+#include <engine/io/impl/read_buffer.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+
+BufferedSocket::BufferedSocket(ReadableBase& source, std::size_t buffer_size)
+    : source_(&source), buffer_size_(std::max<std::size_t>(buffer_size, 1)) {}
+
+BufferedSocket::~BufferedSocket() = default;
+
+BufferedSocket::BufferedSocket(BufferedSocket&&) noexcept = default;
+BufferedSocket& BufferedSocket::operator=(BufferedSocket&&) noexcept = default;
+
+bool BufferedSocket::IsValid() const { return source_->IsValid(); }
+
+std::string_view BufferedSocket::GetReadable() const noexcept {
+  if (begin_ == end_) return {};
+  return {buffer_->Data() + begin_, end_ - begin_};
+}
+
+void BufferedSocket::Consume(std::size_t size) noexcept {
+  UASSERT(size <= end_ - begin_);
+  begin_ += size;
+  if (begin_ == end_) begin_ = end_ = 0;
+}
+
+void BufferedSocket::ReleaseBuffer() noexcept {
+  if (begin_ == end_) buffer_->Release();
+}
+
+std::size_t BufferedSocket::GetBufferSize() const noexcept {
+  return buffer_->IsAcquired() ? buffer_->Size() : 0;
+}
+
+bool BufferedSocket::WaitReadable(Deadline deadline) {
+  if (is_last_read_full_) return true;
+  ReleaseBuffer();
+  return source_->WaitReadable(deadline);
+}
+
+std::size_t BufferedSocket::ReadSome(Deadline deadline) {
+  // Small reads are not worth the syscalls
+  PrepareWrite(std::max<std::size_t>(buffer_size_ / 4, 1));
+  auto& buffer = *buffer_;
+  const auto free_size = buffer.Size() - end_;
+  const auto read =
+      source_->ReadSome(buffer.Data() + end_, free_size, deadline);
+  end_ += read;
+  is_last_read_full_ = read == free_size;
+  return read;
+}
+
+std::size_t BufferedSocket::ReadAtLeast(std::size_t size, Deadline deadline) {
+  if (end_ - begin_ < size) PrepareWrite(size - (end_ - begin_));
+  auto& buffer = *buffer_;
+  while (end_ - begin_ < size) {
+    // Everything that is available is read, not just the requested part
+    const auto free_size = buffer.Size() - end_;
+    const auto read =
+        source_->ReadSome(buffer.Data() + end_, free_size, deadline);
+    if (!read) break;
+    end_ += read;
+    is_last_read_full_ = read == free_size;
+  }
+  return end_ - begin_;
+}
+
+void BufferedSocket::PrepareWrite(std::size_t min_free_size) {
+  auto& buffer = *buffer_;
+  const auto size = end_ - begin_;
+  if (!buffer.IsAcquired()) {
+    UASSERT(size == 0);
+    buffer = impl::ReadBuffer{std::max(buffer_size_, min_free_size)};
+    begin_ = end_ = 0;
+    return;
+  }
+  if (buffer.Size() - end_ >= min_free_size) return;
+
+  if (buffer.Size() - size >= min_free_size) {
+    std::memmove(buffer.Data(), buffer.Data() + begin_, size);
+  } else {
+    impl::ReadBuffer grown{std::max(buffer.Size() * 2, size + min_free_size)};
+    std::memcpy(grown.Data(), buffer.Data() + begin_, size);
+    buffer = std::move(grown);
+  }
+  begin_ = 0;
+  end_ = size;
+}
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
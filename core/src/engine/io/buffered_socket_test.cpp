@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <userver/engine/io/buffered_socket.hpp>
+#include <userver/engine/io/common.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using BufferedSocket = engine::io::BufferedSocket;
+
+class ReadableMock final : public engine::io::ReadableBase {
+ public:
+  bool IsValid() const override { return true; }
+
+  bool WaitReadable(engine::Deadline) override {
+    ++waits;
+    return true;
+  }
+
+  size_t ReadSome(void* buf, size_t len, engine::Deadline) override {
+    const auto size = std::min(len, data.size());
+    std::memcpy(buf, data.data(), size);
+    data.erase(0, size);
+    max_read_len = std::max(max_read_len, len);
+    return size;
+  }
+
+  size_t ReadAll(void*, size_t, engine::Deadline) override { std::abort(); }
+
+  std::string data;
+  std::size_t waits{0};
+  std::size_t max_read_len{0};
+};
+
+}  // namespace
+
+TEST(BufferedSocket, ConsumeInPlace) {
+  ReadableMock source;
+  BufferedSocket socket{source, 16};
+  EXPECT_TRUE(socket.GetReadable().empty());
+
+  source.data = "hello world";
+  EXPECT_EQ(socket.ReadSome({}), 11);
+  EXPECT_EQ(socket.GetReadable(), "hello world");
+  const auto* const data = socket.GetReadable().data();
+
+  socket.Consume(6);
+  EXPECT_EQ(socket.GetReadable(), "world");
+  EXPECT_EQ(socket.GetReadable().data(), data + 6);
+
+  source.data = "!";
+  EXPECT_EQ(socket.ReadSome({}), 1);
+  EXPECT_EQ(socket.GetReadable(), "world!");
+
+  socket.Consume(6);
+  EXPECT_TRUE(socket.GetReadable().empty());
+  EXPECT_EQ(socket.ReadSome({}), 0);
+}
+
+TEST(BufferedSocket, CompactsAndGrows) {
+  ReadableMock source;
+  BufferedSocket socket{source, 16};
+
+  source.data = std::string(16, 'a');
+  EXPECT_EQ(socket.ReadSome({}), 16);
+  socket.Consume(12);
+
+  // The unconsumed bytes are moved to the beginning
+  source.data = std::string(12, 'b');
+  EXPECT_EQ(socket.ReadSome({}), 12);
+  EXPECT_EQ(socket.GetReadable(), std::string(4, 'a') + std::string(12, 'b'));
+
+  // The buffer is full of the unconsumed data
+  source.data = std::string(100, 'c');
+  EXPECT_EQ(socket.ReadSome({}), 16);
+  EXPECT_EQ(socket.GetReadable().size(), 32);
+  EXPECT_EQ(socket.GetReadable().substr(0, 16),
+            std::string(4, 'a') + std::string(12, 'b'));
+}
+
+TEST(BufferedSocket, ReadAtLeast) {
+  ReadableMock source;
+  BufferedSocket socket{source, 16};
+
+  source.data = std::string(100, 'a');
+  EXPECT_EQ(socket.ReadAtLeast(50, {}), 50);
+  EXPECT_EQ(socket.GetReadable(), std::string(50, 'a'));
+
+  source.data = "bbb";
+  socket.Consume(49);
+  EXPECT_EQ(socket.ReadAtLeast(10, {}), 4);
+  EXPECT_EQ(socket.GetReadable(), "abbb");
+  EXPECT_EQ(socket.ReadAtLeast(2, {}), 4);
+}
+
+TEST(BufferedSocket, WaitsAfterPartialRead) {
+  ReadableMock source;
+  BufferedSocket socket{source, 16};
+
+  EXPECT_TRUE(socket.WaitReadable({}));
+  EXPECT_EQ(source.waits, 1);
+
+  source.data = std::string(20, 'a');
+  EXPECT_EQ(socket.ReadSome({}), 16);
+  socket.Consume(16);
+  // The buffer was filled, there should be more data
+  EXPECT_TRUE(socket.WaitReadable({}));
+  EXPECT_EQ(source.waits, 1);
+
+  EXPECT_EQ(socket.ReadSome({}), 4);
+  socket.Consume(4);
+  EXPECT_TRUE(socket.WaitReadable({}));
+  EXPECT_EQ(source.waits, 2);
+  EXPECT_EQ(source.max_read_len, 16);
+}
+
+TEST(BufferedSocket, ReleasesBufferWhenIdle) {
+  ReadableMock source;
+  BufferedSocket socket{source, 16};
+  EXPECT_EQ(socket.GetBufferSize(), 0);
+
+  source.data = "hello";
+  EXPECT_EQ(socket.ReadSome({}), 5);
+  EXPECT_GE(socket.GetBufferSize(), 16);
+
+  // The unconsumed data keeps the buffer
+  socket.ReleaseBuffer();
+  EXPECT_GE(socket.GetBufferSize(), 16);
+  EXPECT_EQ(socket.GetReadable(), "hello");
+
+  socket.Consume(5);
+  EXPECT_TRUE(socket.WaitReadable({}));
+  EXPECT_EQ(socket.GetBufferSize(), 0);
+
+  source.data = "world";
+  EXPECT_EQ(socket.ReadSome({}), 5);
+  EXPECT_EQ(socket.GetReadable(), "world");
+  socket.Consume(5);
+  socket.ReleaseBuffer();
+  EXPECT_EQ(socket.GetBufferSize(), 0);
+}
+
+USERVER_NAMESPACE_END
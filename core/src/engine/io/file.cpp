@@ -0,0 +1,285 @@
+#include <userver/engine/io/file.hpp>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <engine/io/io_uring.hpp>
+#include <fs/blocking/native_open_mode.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_base.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/utils/assert.hpp>
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io {
+
+namespace {
+
+constexpr std::size_t kReadChunkSize = 64 * 1024;
+// io_uring operations take a 32-bit length
+constexpr std::size_t kMaxOperationSize = 1 << 30;
+
+bool IsMissingFileError(int error) noexcept {
+  return error == ENOENT || error == ENOTDIR;
+}
+
+// Moves the blocking call off the current thread if it should not be blocked
+template <typename Function>
+auto RunBlocking(engine::TaskProcessor* fs_task_processor,
+                 Function&& function) {
+  if (!fs_task_processor || !engine::current_task::IsTaskProcessorThread() ||
+      &engine::current_task::GetTaskProcessor() == fs_task_processor) {
+    return function();
+  }
+  return engine::AsyncNoSpan(*fs_task_processor,
+                             std::forward<Function>(function))
+      .Get();
+}
+
+// Repeats `read_some(done, len)` till `size` bytes are read or EOF is reached
+template <typename ReadSome>
+std::size_t ReadAll(std::size_t size, ReadSome read_some) {
+  std::size_t done = 0;
+  while (done < size) {
+    const auto read = read_some(done, std::min(size - done, kMaxOperationSize));
+    if (read == 0) break;
+    done += read;
+  }
+  return done;
+}
+
+template <typename WriteSome>
+void WriteAll(std::size_t size, WriteSome write_some) {
+  std::size_t done = 0;
+  while (done < size) {
+    done += write_some(done, std::min(size - done, kMaxOperationSize));
+  }
+}
+
+std::size_t BlockingReadAt(int fd, char* buffer, std::size_t len,
+                           std::uint64_t offset) {
+  while (true) {
+    const auto read = ::pread(fd, buffer, len, static_cast<off_t>(offset));
+    if (read < 0 && errno == EINTR) continue;
+    return utils::CheckSyscall(read, "calling ::pread");
+  }
+}
+
+std::size_t BlockingWriteAt(int fd, const char* buffer, std::size_t len,
+                            std::uint64_t offset) {
+  while (true) {
+    const auto written =
+        ::pwrite(fd, buffer, len, static_cast<off_t>(offset));
+    if (written < 0 && errno == EINTR) continue;
+    return utils::CheckSyscall(written, "calling ::pwrite");
+  }
+}
+
+[[noreturn]] void ThrowOpenError(int error, const std::string& path) {
+  throw std::system_error(std::error_code(error, std::system_category()),
+                          fmt::format("Error while opening file '{}'", path));
+}
+
+}  // namespace
+
+File::File(engine::TaskProcessor* fs_task_processor,
+           fs::blocking::FileDescriptor fd) noexcept
+    : fs_task_processor_(fs_task_processor), fd_(std::move(fd)) {}
+
+File File::Open(engine::TaskProcessor* fs_task_processor,
+                const std::string& path, fs::blocking::OpenMode flags,
+                boost::filesystem::perms perms) {
+  UASSERT(!path.empty());
+  if (auto* io_uring = impl::GetCurrentIoUring()) {
+    const int fd = io_uring->OpenAt(path, fs::blocking::impl::ToNative(flags),
+                                    static_cast<mode_t>(perms));
+    return File{fs_task_processor, fs::blocking::FileDescriptor::AdoptFd(fd)};
+  }
+  return File{fs_task_processor, RunBlocking(fs_task_processor, [&] {
+                return fs::blocking::FileDescriptor::Open(path, flags, perms);
+              })};
+}
+
+bool File::IsOpen() const { return fd_.IsOpen(); }
+
+int File::GetNative() const { return fd_.GetNative(); }
+
+std::size_t File::ReadAt(char* buffer, std::size_t max_size,
+                         std::uint64_t offset) {
+  UASSERT(IsOpen());
+  const int fd = fd_.GetNative();
+  if (auto* io_uring = impl::GetCurrentIoUring()) {
+    return ReadAll(max_size, [&](std::size_t done, std::size_t len) {
+      return io_uring->Read(fd, buffer + done, len, offset + done);
+    });
+  }
+  return RunBlocking(fs_task_processor_, [&] {
+    return ReadAll(max_size, [&](std::size_t done, std::size_t len) {
+      return BlockingReadAt(fd, buffer + done, len, offset + done);
+    });
+  });
+}
+
+void File::WriteAt(std::string_view data, std::uint64_t offset) {
+  UASSERT(IsOpen());
+  const int fd = fd_.GetNative();
+  if (auto* io_uring = impl::GetCurrentIoUring()) {
+    WriteAll(data.size(), [&](std::size_t done, std::size_t len) {
+      return io_uring->Write(fd, data.data() + done, len, offset + done);
+    });
+    return;
+  }
+  RunBlocking(fs_task_processor_, [&] {
+    WriteAll(data.size(), [&](std::size_t done, std::size_t len) {
+      return BlockingWriteAt(fd, data.data() + done, len, offset + done);
+    });
+  });
+}
+
+void File::Fsync() {
+  UASSERT(IsOpen());
+  if (auto* io_uring = impl::GetCurrentIoUring()) {
+    io_uring->Fsync(fd_.GetNative());
+    return;
+  }
+  RunBlocking(fs_task_processor_, [this] { fd_.FSync(); });
+}
+
+std::uint64_t File::GetSize() const {
+  UASSERT(IsOpen());
+  if (auto* io_uring = impl::GetCurrentIoUring()) {
+    return io_uring->GetSize(fd_.GetNative());
+  }
+  return RunBlocking(fs_task_processor_, [this] {
+    return static_cast<std::uint64_t>(fd_.GetSize());
+  });
+}
+
+void File::Close() && {
+  UASSERT(IsOpen());
+  const int fd = std::move(fd_).Release();
+  if (auto* io_uring = impl::GetCurrentIoUring()) {
+    io_uring->Close(fd);
+    return;
+  }
+  RunBlocking(fs_task_processor_, [fd] {
+    fs::blocking::FileDescriptor::AdoptFd(fd).Close();
+  });
+}
+
+std::vector<File> OpenFiles(engine::TaskProcessor* fs_task_processor,
+                            const std::vector<std::string>& paths,
+                            fs::blocking::OpenMode flags,
+                            boost::filesystem::perms perms) {
+  std::vector<File> result;
+  result.reserve(paths.size());
+
+  if (auto* io_uring = impl::GetCurrentIoUring()) {
+    const auto fds = io_uring->OpenAll(
+        paths, fs::blocking::impl::ToNative(flags), static_cast<mode_t>(perms));
+    // All the opened files are owned before throwing to get them closed
+    for (const auto fd : fds) {
+      if (fd < 0) continue;
+      result.push_back(
+          File{fs_task_processor, fs::blocking::FileDescriptor::AdoptFd(fd)});
+    }
+    for (std::size_t i = 0; i < fds.size(); ++i) {
+      if (fds[i] < 0) ThrowOpenError(-fds[i], paths[i]);
+    }
+    return result;
+  }
+
+  RunBlocking(fs_task_processor, [&] {
+    for (const auto& path : paths) {
+      result.push_back(File{
+          fs_task_processor,
+          fs::blocking::FileDescriptor::Open(path, flags, perms),
+      });
+    }
+  });
+  return result;
+}
+
+std::vector<FileStatus> StatFiles(engine::TaskProcessor* fs_task_processor,
+                                  const std::vector<std::string>& paths) {
+  std::vector<FileStatus> result(paths.size());
+
+  if (auto* io_uring = impl::GetCurrentIoUring()) {
+    const auto stats = io_uring->StatAll(paths);
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+      const auto& stat = stats[i];
+      if (stat.result < 0) {
+        if (IsMissingFileError(-stat.result)) continue;
+        throw std::system_error(
+            std::error_code(-stat.result, std::system_category()),
+            fmt::format("Error while fetching status of '{}'", paths[i]));
+      }
+      result[i] = {true, stat.is_regular_file, stat.size};
+    }
+    return result;
+  }
+
+  RunBlocking(fs_task_processor, [&] {
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
+      struct ::stat stat;
+      if (::stat(paths[i].c_str(), &stat) == -1) {
+        const auto error = errno;
+        if (IsMissingFileError(error)) continue;
+        throw std::system_error(
+            std::error_code(error, std::system_category()),
+            fmt::format("Error while fetching status of '{}'", paths[i]));
+      }
+      result[i] = {true, S_ISREG(stat.st_mode),
+                   static_cast<std::uint64_t>(stat.st_size)};
+    }
+  });
+  return result;
+}
+
+std::vector<std::string> ReadFilesContents(
+    engine::TaskProcessor* fs_task_processor,
+    const std::vector<std::string>& paths) {
+  std::vector<std::string> result;
+  result.reserve(paths.size());
+
+  if (!impl::GetCurrentIoUring()) {
+    RunBlocking(fs_task_processor, [&] {
+      for (const auto& path : paths) {
+        result.push_back(fs::blocking::ReadFileContents(path));
+      }
+    });
+    return result;
+  }
+
+  auto files =
+      OpenFiles(fs_task_processor, paths, fs::blocking::OpenFlag::kRead);
+  for (auto& file : files) {
+    auto& contents = result.emplace_back();
+    std::size_t size = 0;
+    while (true) {
+      contents.resize(size + kReadChunkSize);
+      const auto read =
+          file.ReadAt(contents.data() + size, kReadChunkSize, size);
+      size += read;
+      if (read < kReadChunkSize) break;
+    }
+    contents.resize(size);
+    std::move(file).Close();
+  }
+  return result;
+}
+
+}  // namespace engine::io
+
+USERVER_NAMESPACE_END
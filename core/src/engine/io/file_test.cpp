@@ -0,0 +1,97 @@
+#include <userver/engine/io/file.hpp>
+
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <userver/engine/task/task.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr fs::blocking::OpenMode kWriteMode{
+    fs::blocking::OpenFlag::kWrite, fs::blocking::OpenFlag::kCreateIfNotExists};
+
+}  // namespace
+
+UTEST(File, WriteAtReadAt) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+  auto* fs_task_processor = &engine::current_task::GetTaskProcessor();
+
+  auto file = engine::io::File::Open(fs_task_processor, path, kWriteMode);
+  file.WriteAt("world", 6);
+  file.WriteAt("hello ", 0);
+  file.Fsync();
+  EXPECT_EQ(file.GetSize(), 11);
+  std::move(file).Close();
+  EXPECT_EQ(fs::blocking::ReadFileContents(path), "hello world");
+
+  auto reader = engine::io::File::Open(fs_task_processor, path,
+                                       fs::blocking::OpenFlag::kRead);
+  std::string buffer(16, '\0');
+  EXPECT_EQ(reader.ReadAt(buffer.data(), 5, 6), 5);
+  EXPECT_EQ(buffer.substr(0, 5), "world");
+  EXPECT_EQ(reader.ReadAt(buffer.data(), buffer.size(), 0), 11);
+  EXPECT_EQ(buffer.substr(0, 11), "hello world");
+  EXPECT_EQ(reader.ReadAt(buffer.data(), buffer.size(), 11), 0);
+}
+
+UTEST(File, MissingFile) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/missing";
+
+  EXPECT_THROW(engine::io::File::Open(nullptr, path,
+                                      fs::blocking::OpenFlag::kRead),
+               std::system_error);
+  EXPECT_THROW(engine::io::OpenFiles(nullptr, {path},
+                                     fs::blocking::OpenFlag::kRead),
+               std::system_error);
+}
+
+UTEST(File, Batches) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  std::vector<std::string> paths;
+  for (std::size_t i = 0; i < 10; ++i) {
+    paths.push_back(dir.GetPath() + "/file" + std::to_string(i));
+    fs::blocking::RewriteFileContents(paths.back(), std::string(i, 'a'));
+  }
+
+  const auto contents = engine::io::ReadFilesContents(nullptr, paths);
+  ASSERT_EQ(contents.size(), paths.size());
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    EXPECT_EQ(contents[i], std::string(i, 'a'));
+  }
+
+  paths.push_back(dir.GetPath() + "/missing");
+  paths.push_back(dir.GetPath());
+  const auto statuses = engine::io::StatFiles(nullptr, paths);
+  ASSERT_EQ(statuses.size(), paths.size());
+  for (std::size_t i = 0; i < 10; ++i) {
+    EXPECT_TRUE(statuses[i].exists);
+    EXPECT_TRUE(statuses[i].is_regular_file);
+    EXPECT_EQ(statuses[i].size, i);
+  }
+  EXPECT_FALSE(statuses[10].exists);
+  EXPECT_TRUE(statuses[11].exists);
+  EXPECT_FALSE(statuses[11].is_regular_file);
+}
+
+TEST(File, OutsideOfCoroutine) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = dir.GetPath() + "/file";
+
+  auto file = engine::io::File::Open(nullptr, path, kWriteMode);
+  file.WriteAt("data", 0);
+  EXPECT_EQ(file.GetSize(), 4);
+  std::move(file).Close();
+  EXPECT_EQ(engine::io::ReadFilesContents(nullptr, {path}),
+            std::vector<std::string>{"data"});
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,128 @@
+#include <engine/io/impl/read_buffer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+#include <userver/compiler/thread_local.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::impl {
+
+namespace {
+
+constexpr std::size_t kMinSizeClassLog2 = 12;  // 4KiB
+constexpr std::size_t kMaxSizeClassLog2 = 20;  // 1MiB
+constexpr std::size_t kSizeClassesCount =
+    kMaxSizeClassLog2 - kMinSizeClassLog2 + 1;
+
+// Larger buffers are allocated and freed as is
+constexpr std::size_t kNotPooled = kSizeClassesCount;
+
+// Per size class and thread
+constexpr std::size_t kMaxCachedBytes = 1024 * 1024;
+constexpr std::size_t kMinCachedBuffers = 2;
+
+constexpr std::size_t GetCapacity(std::size_t size_class) noexcept {
+  return std::size_t{1} << (kMinSizeClassLog2 + size_class);
+}
+
+constexpr std::size_t GetSizeClass(std::size_t size) noexcept {
+  std::size_t size_class = 0;
+  while (size_class < kSizeClassesCount && GetCapacity(size_class) < size) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+constexpr std::size_t GetMaxCachedBuffers(std::size_t size_class) noexcept {
+  return std::max(kMinCachedBuffers,
+                  kMaxCachedBytes / GetCapacity(size_class));
+}
+
+static_assert(GetSizeClass(1) == 0);
+static_assert(GetSizeClass(4096) == 0);
+static_assert(GetSizeClass(4097) == 1);
+static_assert(GetSizeClass(32 * 1024) == 3);
+static_assert(GetSizeClass(1024 * 1024 + 1) == kNotPooled);
+
+struct FreeBuffers final {
+  FreeBuffers() {
+    // Releasing a buffer should not allocate
+    for (std::size_t i = 0; i < kSizeClassesCount; ++i) {
+      by_size_class[i].reserve(GetMaxCachedBuffers(i));
+    }
+  }
+
+  std::array<std::vector<std::unique_ptr<char[]>>, kSizeClassesCount>
+      by_size_class;
+};
+
+compiler::ThreadLocal kFreeBuffers = [] { return FreeBuffers{}; };
+
+}  // namespace
+
+ReadBuffer::ReadBuffer(std::size_t size)
+    : size_(size), size_class_(GetSizeClass(size)) {
+  if (size_class_ == kNotPooled) {
+    // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+    data_.reset(new char[size_]);
+    return;
+  }
+
+  {
+    auto free_buffers = kFreeBuffers.Use();
+    auto& buffers = free_buffers->by_size_class[size_class_];
+    if (!buffers.empty()) {
+      data_ = std::move(buffers.back());
+      buffers.pop_back();
+      return;
+    }
+  }
+
+  // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays)
+  data_.reset(new char[GetCapacity(size_class_)]);
+}
+
+ReadBuffer::ReadBuffer(ReadBuffer&& other) noexcept
+    : data_(std::move(other.data_)),
+      size_(std::exchange(other.size_, 0)),
+      size_class_(other.size_class_) {}
+
+ReadBuffer& ReadBuffer::operator=(ReadBuffer&& other) noexcept {
+  if (this == &other) return *this;
+
+  Release();
+  data_ = std::move(other.data_);
+  size_ = std::exchange(other.size_, 0);
+  size_class_ = other.size_class_;
+  return *this;
+}
+
+ReadBuffer::~ReadBuffer() { Release(); }
+
+void ReadBuffer::Release() noexcept {
+  if (!data_) return;
+  size_ = 0;
+
+  if (size_class_ == kNotPooled) {
+    data_.reset();
+    return;
+  }
+
+  auto free_buffers = kFreeBuffers.Use();
+  auto& buffers = free_buffers->by_size_class[size_class_];
+  if (buffers.size() < GetMaxCachedBuffers(size_class_)) {
+    UASSERT(buffers.size() < buffers.capacity());
+    buffers.push_back(std::move(data_));
+  } else {
+    data_.reset();
+  }
+}
+
+}  // namespace engine::io::impl
+
+USERVER_NAMESPACE_END
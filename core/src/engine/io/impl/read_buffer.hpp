@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::impl {
+
+/// @brief A read buffer borrowed from a thread-local pool.
+///
+/// Keep-alive connections spend most of their time waiting for the next
+/// request, so the buffer is only held while the data is read and parsed.
+/// Capacities are rounded up to a power of two and each size class keeps a
+/// few free buffers per thread, so new connections and reads reuse them
+/// instead of allocating and zeroing their own.
+class ReadBuffer final {
+ public:
+  ReadBuffer() noexcept = default;
+
+  /// Borrows a buffer of at least `size` bytes, its contents are unspecified
+  explicit ReadBuffer(std::size_t size);
+
+  ReadBuffer(ReadBuffer&& other) noexcept;
+  ReadBuffer& operator=(ReadBuffer&& other) noexcept;
+  ~ReadBuffer();
+
+  char* Data() noexcept { return data_.get(); }
+  const char* Data() const noexcept { return data_.get(); }
+
+  /// The size requested on construction
+  std::size_t Size() const noexcept { return size_; }
+
+  bool IsAcquired() const noexcept { return data_ != nullptr; }
+
+  /// Returns the buffer to the pool
+  void Release() noexcept;
+
+ private:
+  std::unique_ptr<char[]> data_;
+  std::size_t size_{0};
+  std::size_t size_class_{0};
+};
+
+}  // namespace engine::io::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,49 @@
+#include <engine/io/impl/read_buffer.hpp>
+
+#include <cstring>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(ReadBuffer, ReusesReleased) {
+  engine::io::impl::ReadBuffer buffer{32 * 1024};
+  ASSERT_TRUE(buffer.IsAcquired());
+  EXPECT_EQ(buffer.Size(), 32 * 1024);
+  std::memset(buffer.Data(), 'a', buffer.Size());
+
+  const auto* const data = buffer.Data();
+  buffer.Release();
+  EXPECT_FALSE(buffer.IsAcquired());
+
+  // Same size class
+  engine::io::impl::ReadBuffer other{20 * 1024};
+  EXPECT_EQ(other.Size(), 20 * 1024);
+  EXPECT_EQ(other.Data(), data);
+}
+
+TEST(ReadBuffer, Move) {
+  engine::io::impl::ReadBuffer buffer{1000};
+  const auto* const data = buffer.Data();
+
+  engine::io::impl::ReadBuffer other{std::move(buffer)};
+  EXPECT_EQ(other.Data(), data);
+  EXPECT_EQ(other.Size(), 1000);
+  // NOLINTNEXTLINE(bugprone-use-after-move)
+  EXPECT_FALSE(buffer.IsAcquired());
+
+  buffer = std::move(other);
+  EXPECT_EQ(buffer.Data(), data);
+  EXPECT_TRUE(buffer.IsAcquired());
+}
+
+TEST(ReadBuffer, Large) {
+  constexpr std::size_t kSize = 3 * 1024 * 1024;
+  engine::io::impl::ReadBuffer buffer{kSize};
+  ASSERT_TRUE(buffer.IsAcquired());
+  EXPECT_EQ(buffer.Size(), kSize);
+  std::memset(buffer.Data(), 'a', kSize);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,557 @@
+#include <engine/io/io_uring.hpp>
+
+// must go before <linux/io_uring.h> that defines BLOCK_SIZE macro, which
+// breaks moodycamel::ConcurrentQueue
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_pools.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <shared_mutex>
+#include <system_error>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#define USERVER_IMPL_HAS_IO_URING 1
+#endif
+
+#include <fmt/format.h>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::impl {
+
+namespace {
+
+constexpr std::size_t kReadChunkSize = 64 * 1024;
+constexpr std::size_t kMaxWriteSize = 1 << 30;
+
+[[noreturn]] void ThrowNotSupported(std::string_view what) {
+  throw std::system_error(std::make_error_code(std::errc::not_supported),
+                          fmt::format("io_uring is not available: {}", what));
+}
+
+std::int32_t CheckResult(std::int32_t result, std::string_view operation,
+                         std::string_view path = {}) {
+  if (result >= 0) return result;
+  throw std::system_error(
+      std::error_code(-result, std::system_category()),
+      path.empty() ? fmt::format("Error while {}", operation)
+                   : fmt::format("Error while {} '{}'", operation, path));
+}
+
+}  // namespace
+
+struct IoUring::Operation final {
+  engine::SingleConsumerEvent completed{
+      engine::SingleConsumerEvent::NoAutoReset{}};
+  std::int32_t result{0};
+};
+
+#ifdef USERVER_IMPL_HAS_IO_URING
+
+namespace {
+
+int IoUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int ring_fd, unsigned to_submit) {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, to_submit, 0,
+                                    0, nullptr, 0));
+}
+
+int IoUringRegister(int ring_fd, unsigned opcode, void* arg, unsigned nr_args) {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+unsigned LoadAcquire(const unsigned* ptr) noexcept {
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+void StoreRelease(unsigned* ptr, unsigned value) noexcept {
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+template <typename T>
+T* Offset(void* base, std::uint32_t offset) noexcept {
+  return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+constexpr std::uint8_t kRequiredOpcodes[] = {
+    IORING_OP_READ,
+    IORING_OP_WRITE,
+    IORING_OP_OPENAT,
+    IORING_OP_CLOSE,
+    IORING_OP_FSYNC,
+    IORING_OP_STATX,
+};
+
+void PrepareStatx(io_uring_sqe& sqe, int fd, const char* path, int flags,
+                  struct statx& result) noexcept {
+  sqe.opcode = IORING_OP_STATX;
+  sqe.fd = fd;
+  sqe.addr = reinterpret_cast<std::uintptr_t>(path);
+  sqe.len = STATX_TYPE | STATX_SIZE;
+  sqe.off = reinterpret_cast<std::uintptr_t>(&result);
+  sqe.statx_flags = static_cast<std::uint32_t>(flags);
+}
+
+}  // namespace
+
+struct IoUring::Rings final {
+  explicit Rings(unsigned entries) {
+    io_uring_params params{};
+    ring_fd = IoUringSetup(entries, &params);
+    if (ring_fd < 0) ThrowNotSupported(std::strerror(errno));
+
+    try {
+      Map(params);
+      CheckOpcodes();
+    } catch (...) {
+      Unmap();
+      ::close(ring_fd);
+      throw;
+    }
+  }
+
+  ~Rings() {
+    Unmap();
+    ::close(ring_fd);
+  }
+
+  void Map(const io_uring_params& params) {
+    sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (single_mmap) {
+      sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+    }
+
+    sq_ring = utils::CheckSyscallNotEquals(
+        ::mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING),
+        MAP_FAILED, "mapping io_uring submission queue");
+    if (single_mmap) {
+      cq_ring = sq_ring;
+    } else {
+      cq_ring = utils::CheckSyscallNotEquals(
+          ::mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE,
+                 MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING),
+          MAP_FAILED, "mapping io_uring completion queue");
+    }
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_mapping = utils::CheckSyscallNotEquals(
+        ::mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES),
+        MAP_FAILED, "mapping io_uring submission entries");
+
+    sq_head = Offset<unsigned>(sq_ring, params.sq_off.head);
+    sq_tail = Offset<unsigned>(sq_ring, params.sq_off.tail);
+    sq_mask = *Offset<unsigned>(sq_ring, params.sq_off.ring_mask);
+    sq_array = Offset<unsigned>(sq_ring, params.sq_off.array);
+    sq_entries = params.sq_entries;
+    sqes = static_cast<io_uring_sqe*>(sqes_mapping);
+
+    cq_head = Offset<unsigned>(cq_ring, params.cq_off.head);
+    cq_tail = Offset<unsigned>(cq_ring, params.cq_off.tail);
+    cq_mask = *Offset<unsigned>(cq_ring, params.cq_off.ring_mask);
+    cqes = Offset<io_uring_cqe>(cq_ring, params.cq_off.cqes);
+  }
+
+  void Unmap() noexcept {
+    if (sqes_mapping && sqes_mapping != MAP_FAILED) {
+      ::munmap(sqes_mapping, sqes_size);
+    }
+    if (cq_ring && cq_ring != MAP_FAILED && cq_ring != sq_ring) {
+      ::munmap(cq_ring, cq_ring_size);
+    }
+    if (sq_ring && sq_ring != MAP_FAILED) ::munmap(sq_ring, sq_ring_size);
+    sqes_mapping = cq_ring = sq_ring = nullptr;
+  }
+
+  void CheckOpcodes() const {
+    constexpr unsigned kProbeOps = 256;
+    std::vector<char> buffer(sizeof(io_uring_probe) +
+                             kProbeOps * sizeof(io_uring_probe_op));
+    auto* probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+    if (IoUringRegister(ring_fd, IORING_REGISTER_PROBE, probe, kProbeOps) < 0) {
+      ThrowNotSupported("opcodes probing failed");
+    }
+    for (const auto opcode : kRequiredOpcodes) {
+      if (opcode > probe->last_op ||
+          !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED)) {
+        ThrowNotSupported(fmt::format("opcode {} is not supported", opcode));
+      }
+    }
+  }
+
+  int ring_fd{-1};
+
+  void* sq_ring{nullptr};
+  std::size_t sq_ring_size{0};
+  void* cq_ring{nullptr};
+  std::size_t cq_ring_size{0};
+  void* sqes_mapping{nullptr};
+  std::size_t sqes_size{0};
+
+  unsigned* sq_head{nullptr};
+  unsigned* sq_tail{nullptr};
+  unsigned sq_mask{0};
+  unsigned* sq_array{nullptr};
+  unsigned sq_entries{0};
+  io_uring_sqe* sqes{nullptr};
+
+  unsigned* cq_head{nullptr};
+  unsigned* cq_tail{nullptr};
+  unsigned cq_mask{0};
+  io_uring_cqe* cqes{nullptr};
+};
+
+IoUring::IoUring(ev::ThreadControl& thread_control, std::size_t entries)
+    : thread_control_(thread_control),
+      rings_(std::make_unique<Rings>(static_cast<unsigned>(entries))),
+      in_flight_(rings_->sq_entries) {
+  event_fd_ = utils::CheckSyscall(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC),
+                                  "creating eventfd for io_uring");
+  if (IoUringRegister(rings_->ring_fd, IORING_REGISTER_EVENTFD, &event_fd_,
+                      1) < 0) {
+    const auto error = errno;
+    ::close(event_fd_);
+    ThrowNotSupported(fmt::format("registering eventfd failed: {}",
+                                  std::strerror(error)));
+  }
+
+  ev_io_init(&event_fd_watcher_, &IoUring::OnEventFd, event_fd_, EV_READ);
+  event_fd_watcher_.data = this;
+  thread_control_.RunInEvLoopBlocking(
+      [this] { ev_io_start(thread_control_.GetEvLoop(), &event_fd_watcher_); });
+
+  LOG_INFO() << "io_uring is enabled with " << rings_->sq_entries
+             << " submission entries";
+}
+
+IoUring::~IoUring() {
+  // All the operations are waited for non-cancellably, so nothing is in flight
+  thread_control_.RunInEvLoopBlocking(
+      [this] { ev_io_stop(thread_control_.GetEvLoop(), &event_fd_watcher_); });
+  ::close(event_fd_);
+}
+
+template <typename Prepare>
+void IoUring::Enqueue(std::size_t count, Prepare& prepare,
+                      Operation* operations) {
+  const std::lock_guard lock{submit_mutex_};
+  auto& rings = *rings_;
+
+  const auto tail = *rings.sq_tail;
+  UASSERT(tail - LoadAcquire(rings.sq_head) + count <= rings.sq_entries);
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto index = (tail + i) & rings.sq_mask;
+
+    auto& sqe = rings.sqes[index];
+    std::memset(&sqe, 0, sizeof(sqe));
+    prepare(sqe, i);
+    sqe.user_data = reinterpret_cast<std::uintptr_t>(&operations[i]);
+
+    rings.sq_array[index] = index;
+  }
+  StoreRelease(rings.sq_tail, tail + static_cast<unsigned>(count));
+
+  auto to_submit = static_cast<unsigned>(count);
+  while (to_submit != 0) {
+    const auto submitted = IoUringEnter(rings.ring_fd, to_submit);
+    if (submitted >= 0) {
+      to_submit -= static_cast<unsigned>(submitted);
+      continue;
+    }
+    if (errno == EINTR || errno == EAGAIN || errno == EBUSY) continue;
+    utils::CheckSyscall(submitted, "submitting to io_uring");
+  }
+}
+
+template <typename Prepare>
+std::int32_t IoUring::Submit(Prepare&& prepare) {
+  // The kernel may access the buffers until the completion arrives
+  const engine::TaskCancellationBlocker cancellation_blocker;
+  const std::shared_lock in_flight_lock{in_flight_};
+
+  Operation operation;
+  auto prepare_one = [&prepare](io_uring_sqe& sqe, std::size_t) {
+    prepare(sqe);
+  };
+  Enqueue(1, prepare_one, &operation);
+
+  [[maybe_unused]] const bool completed = operation.completed.WaitForEvent();
+  UASSERT(completed);
+  return operation.result;
+}
+
+template <typename Prepare>
+std::vector<std::int32_t> IoUring::SubmitAll(std::size_t count,
+                                             Prepare&& prepare) {
+  const engine::TaskCancellationBlocker cancellation_blocker;
+  const std::size_t max_batch = rings_->sq_entries;
+
+  std::vector<std::int32_t> results;
+  results.reserve(count);
+  while (results.size() < count) {
+    const auto first = results.size();
+    const auto batch = std::min(count - first, max_batch);
+    auto prepare_batch = [&prepare, first](io_uring_sqe& sqe, std::size_t i) {
+      prepare(sqe, first + i);
+    };
+
+    in_flight_.lock_shared_count(batch);
+    const utils::FastScopeGuard unlock{
+        [&]() noexcept { in_flight_.unlock_shared_count(batch); }};
+
+    const auto operations = std::make_unique<Operation[]>(batch);
+    Enqueue(batch, prepare_batch, operations.get());
+    for (std::size_t i = 0; i < batch; ++i) {
+      [[maybe_unused]] const bool completed =
+          operations[i].completed.WaitForEvent();
+      UASSERT(completed);
+      results.push_back(operations[i].result);
+    }
+  }
+  return results;
+}
+
+void IoUring::OnEventFd(struct ev_loop*, ev_io* watcher, int) noexcept {
+  auto* self = static_cast<IoUring*>(watcher->data);
+
+  std::uint64_t counter = 0;
+  [[maybe_unused]] const auto res =
+      ::read(self->event_fd_, &counter, sizeof(counter));
+
+  self->ReapCompletions();
+}
+
+void IoUring::ReapCompletions() noexcept {
+  auto& rings = *rings_;
+
+  auto head = *rings.cq_head;
+  const auto tail = LoadAcquire(rings.cq_tail);
+  for (; head != tail; ++head) {
+    const auto& cqe = rings.cqes[head & rings.cq_mask];
+    auto* operation =
+        reinterpret_cast<Operation*>(static_cast<std::uintptr_t>(cqe.user_data));
+    operation->result = cqe.res;
+    operation->completed.Send();
+  }
+  StoreRelease(rings.cq_head, head);
+}
+
+int IoUring::OpenAt(const std::string& path, int flags, mode_t mode) {
+  return CheckResult(Submit([&](io_uring_sqe& sqe) {
+                       sqe.opcode = IORING_OP_OPENAT;
+                       sqe.fd = AT_FDCWD;
+                       sqe.addr = reinterpret_cast<std::uintptr_t>(path.c_str());
+                       sqe.len = mode;
+                       sqe.open_flags = static_cast<std::uint32_t>(flags);
+                     }),
+                     "opening file", path);
+}
+
+std::size_t IoUring::Read(int fd, void* buf, std::size_t len,
+                          std::uint64_t offset) {
+  return CheckResult(Submit([&](io_uring_sqe& sqe) {
+                       sqe.opcode = IORING_OP_READ;
+                       sqe.fd = fd;
+                       sqe.addr = reinterpret_cast<std::uintptr_t>(buf);
+                       sqe.len = static_cast<std::uint32_t>(len);
+                       sqe.off = offset;
+                     }),
+                     "reading file");
+}
+
+std::size_t IoUring::Write(int fd, const void* buf, std::size_t len,
+                           std::uint64_t offset) {
+  return CheckResult(Submit([&](io_uring_sqe& sqe) {
+                       sqe.opcode = IORING_OP_WRITE;
+                       sqe.fd = fd;
+                       sqe.addr = reinterpret_cast<std::uintptr_t>(buf);
+                       sqe.len = static_cast<std::uint32_t>(
+                           std::min(len, kMaxWriteSize));
+                       sqe.off = offset;
+                     }),
+                     "writing file");
+}
+
+void IoUring::Close(int fd) {
+  CheckResult(Submit([&](io_uring_sqe& sqe) {
+                sqe.opcode = IORING_OP_CLOSE;
+                sqe.fd = fd;
+              }),
+              "closing file");
+}
+
+void IoUring::Fsync(int fd) {
+  CheckResult(Submit([&](io_uring_sqe& sqe) {
+                sqe.opcode = IORING_OP_FSYNC;
+                sqe.fd = fd;
+              }),
+              "syncing file");
+}
+
+std::uint64_t IoUring::GetSize(int fd) {
+  struct statx result {};
+  CheckResult(Submit([&](io_uring_sqe& sqe) {
+                PrepareStatx(sqe, fd, "", AT_EMPTY_PATH, result);
+              }),
+              "fetching file size");
+  return result.stx_size;
+}
+
+std::vector<std::int32_t> IoUring::OpenAll(
+    const std::vector<std::string>& paths, int flags, mode_t mode) {
+  return SubmitAll(paths.size(), [&](io_uring_sqe& sqe, std::size_t i) {
+    sqe.opcode = IORING_OP_OPENAT;
+    sqe.fd = AT_FDCWD;
+    sqe.addr = reinterpret_cast<std::uintptr_t>(paths[i].c_str());
+    sqe.len = mode;
+    sqe.open_flags = static_cast<std::uint32_t>(flags);
+  });
+}
+
+std::vector<IoUring::StatResult> IoUring::StatAll(
+    const std::vector<std::string>& paths) {
+  std::vector<struct statx> stats(paths.size());
+  const auto results =
+      SubmitAll(paths.size(), [&](io_uring_sqe& sqe, std::size_t i) {
+        PrepareStatx(sqe, AT_FDCWD, paths[i].c_str(), 0, stats[i]);
+      });
+
+  std::vector<StatResult> result(paths.size());
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    result[i].result = results[i];
+    if (results[i] < 0) continue;
+    result[i].is_regular_file = S_ISREG(stats[i].stx_mode);
+    result[i].size = stats[i].stx_size;
+  }
+  return result;
+}
+
+#else  // USERVER_IMPL_HAS_IO_URING
+
+struct IoUring::Rings final {};
+
+IoUring::IoUring(ev::ThreadControl& thread_control, std::size_t)
+    : thread_control_(thread_control), in_flight_(0) {
+  ThrowNotSupported("not supported on this platform");
+}
+
+IoUring::~IoUring() = default;
+
+void IoUring::OnEventFd(struct ev_loop*, ev_io*, int) noexcept {}
+
+void IoUring::ReapCompletions() noexcept {}
+
+int IoUring::OpenAt(const std::string&, int, mode_t) {
+  ThrowNotSupported("not supported on this platform");
+}
+
+std::size_t IoUring::Read(int, void*, std::size_t, std::uint64_t) {
+  ThrowNotSupported("not supported on this platform");
+}
+
+std::size_t IoUring::Write(int, const void*, std::size_t, std::uint64_t) {
+  ThrowNotSupported("not supported on this platform");
+}
+
+void IoUring::Close(int) { ThrowNotSupported("not supported on this platform"); }
+
+void IoUring::Fsync(int) { ThrowNotSupported("not supported on this platform"); }
+
+std::uint64_t IoUring::GetSize(int) {
+  ThrowNotSupported("not supported on this platform");
+}
+
+std::vector<std::int32_t> IoUring::OpenAll(const std::vector<std::string>&,
+                                           int, mode_t) {
+  ThrowNotSupported("not supported on this platform");
+}
+
+std::vector<IoUring::StatResult> IoUring::StatAll(
+    const std::vector<std::string>&) {
+  ThrowNotSupported("not supported on this platform");
+}
+
+#endif  // USERVER_IMPL_HAS_IO_URING
+
+std::string IoUring::ReadFileContents(const std::string& path) {
+  const int fd = OpenAt(path, O_RDONLY | O_CLOEXEC, 0);
+
+  std::string result;
+  try {
+    std::size_t size = 0;
+    while (true) {
+      result.resize(size + kReadChunkSize);
+      const auto read = Read(fd, result.data() + size, kReadChunkSize, size);
+      size += read;
+      if (read == 0) break;
+    }
+    result.resize(size);
+  } catch (...) {
+    Close(fd);
+    throw;
+  }
+  Close(fd);
+  return result;
+}
+
+void IoUring::RewriteFileContents(const std::string& path,
+                                  std::string_view contents) {
+  const int fd = OpenAt(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+                        S_IRUSR | S_IWUSR);
+
+  try {
+    std::size_t written = 0;
+    while (written < contents.size()) {
+      const auto result = Write(fd, contents.data() + written,
+                                contents.size() - written, written);
+      // Retrying would never end
+      if (result == 0) {
+        throw std::system_error(
+            std::make_error_code(std::errc::io_error),
+            fmt::format("Error while writing file '{}': nothing was written",
+                        path));
+      }
+      written += result;
+    }
+  } catch (...) {
+    Close(fd);
+    throw;
+  }
+  Close(fd);
+}
+
+IoUring* GetCurrentIoUring() noexcept {
+  if (!engine::current_task::IsTaskProcessorThread()) return nullptr;
+  return engine::current_task::GetTaskProcessor()
+      .GetTaskProcessorPools()
+      ->GetIoUring();
+}
+
+}  // namespace engine::io::impl
+
+USERVER_NAMESPACE_END
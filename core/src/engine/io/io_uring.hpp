@@ -0,0 +1,115 @@
+#pragma once
+
+#include <sys/types.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ev.h>
+
+#include <engine/ev/thread_control.hpp>
+#include <userver/engine/semaphore.hpp>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::impl {
+
+/// Completion-based I/O through Linux io_uring.
+///
+/// Operations are submitted from coroutines, the completions are reaped in a
+/// bound ev thread that is woken up through an eventfd registered in the ring.
+/// The waiting coroutine is not cancellable: the kernel may write into the
+/// passed buffers until the operation completes.
+///
+/// Backs the fs:: file operations only. The sockets of engine::io stay on the
+/// readiness-based path and no buffers are registered in the ring.
+class IoUring final {
+ public:
+  /// @throws std::system_error if io_uring is not available (old kernel,
+  /// seccomp, non-Linux platform) or does not support the required opcodes.
+  IoUring(ev::ThreadControl& thread_control, std::size_t entries);
+
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+  ~IoUring();
+
+  /// @returns file descriptor, throws std::system_error on failure
+  int OpenAt(const std::string& path, int flags, mode_t mode);
+
+  /// @returns the number of read bytes, 0 on EOF
+  std::size_t Read(int fd, void* buf, std::size_t len, std::uint64_t offset);
+
+  /// @returns the number of written bytes
+  std::size_t Write(int fd, const void* buf, std::size_t len,
+                    std::uint64_t offset);
+
+  void Close(int fd);
+
+  void Fsync(int fd);
+
+  /// @returns the size of the open file
+  std::uint64_t GetSize(int fd);
+
+  struct StatResult final {
+    /// 0 on success, -errno on failure
+    std::int32_t result{0};
+    bool is_regular_file{false};
+    std::uint64_t size{0};
+  };
+
+  /// Opens the files with a single submission per up to `entries` files.
+  /// @returns a file descriptor or -errno per path
+  std::vector<std::int32_t> OpenAll(const std::vector<std::string>& paths,
+                                    int flags, mode_t mode);
+
+  /// Fetches the status of the files with a single submission per up to
+  /// `entries` files, the symlinks are followed
+  std::vector<StatResult> StatAll(const std::vector<std::string>& paths);
+
+  /// Reads the whole file, same as fs::blocking::ReadFileContents
+  std::string ReadFileContents(const std::string& path);
+
+  /// Rewrites the file, same as fs::blocking::RewriteFileContents
+  void RewriteFileContents(const std::string& path, std::string_view contents);
+
+ private:
+  struct Operation;
+  struct Rings;
+
+  template <typename Prepare>
+  std::int32_t Submit(Prepare&& prepare);
+
+  // Calls prepare(sqe, index) for each of the `count` entries
+  template <typename Prepare>
+  std::vector<std::int32_t> SubmitAll(std::size_t count, Prepare&& prepare);
+
+  template <typename Prepare>
+  void Enqueue(std::size_t count, Prepare& prepare, Operation* operations);
+
+  static void OnEventFd(struct ev_loop*, ev_io* watcher, int) noexcept;
+  void ReapCompletions() noexcept;
+
+  ev::ThreadControl& thread_control_;
+  std::unique_ptr<Rings> rings_;
+  int event_fd_{-1};
+  ev_io event_fd_watcher_{};
+
+  std::mutex submit_mutex_;
+  engine::Semaphore in_flight_;
+};
+
+/// Returns the io_uring of the current coroutine engine, nullptr if it is
+/// disabled or is not available
+IoUring* GetCurrentIoUring() noexcept;
+
+}  // namespace engine::io::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,90 @@
+#include <engine/io/io_uring.hpp>
+
+#include <fcntl.h>
+
+#include <memory>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kEntries = 64;
+
+std::unique_ptr<engine::io::impl::IoUring> TryMakeIoUring() {
+  try {
+    return std::make_unique<engine::io::impl::IoUring>(
+        engine::current_task::GetEventThread(), kEntries);
+  } catch (const std::system_error&) {
+    return nullptr;
+  }
+}
+
+}  // namespace
+
+UTEST(IoUring, ReadWrite) {
+  auto io_uring = TryMakeIoUring();
+  if (!io_uring) GTEST_SKIP() << "io_uring is not available";
+
+  const auto file = fs::blocking::TempFile::Create();
+  const std::string contents(200 * 1024, 'a');
+  io_uring->RewriteFileContents(file.GetPath(), contents);
+
+  EXPECT_EQ(fs::blocking::ReadFileContents(file.GetPath()), contents);
+  EXPECT_EQ(io_uring->ReadFileContents(file.GetPath()), contents);
+
+  io_uring->RewriteFileContents(file.GetPath(), "short");
+  EXPECT_EQ(io_uring->ReadFileContents(file.GetPath()), "short");
+}
+
+UTEST(IoUring, MissingFile) {
+  auto io_uring = TryMakeIoUring();
+  if (!io_uring) GTEST_SKIP() << "io_uring is not available";
+
+  const auto file = fs::blocking::TempFile::Create();
+  const auto path = file.GetPath() + "-missing";
+  EXPECT_THROW(io_uring->ReadFileContents(path), std::system_error);
+  EXPECT_THROW(io_uring->OpenAt(path, O_RDONLY, 0), std::system_error);
+}
+
+UTEST(IoUring, WriteError) {
+  auto io_uring = TryMakeIoUring();
+  if (!io_uring) GTEST_SKIP() << "io_uring is not available";
+
+  // Every write fails with ENOSPC
+  EXPECT_THROW(io_uring->RewriteFileContents("/dev/full", "contents"),
+               std::system_error);
+}
+
+UTEST_MT(IoUring, Concurrent, 4) {
+  auto io_uring = TryMakeIoUring();
+  if (!io_uring) GTEST_SKIP() << "io_uring is not available";
+
+  constexpr std::size_t kTasks = 16;
+  const auto file = fs::blocking::TempFile::Create();
+  const std::string contents(kEntries * 1024, 'b');
+  fs::blocking::RewriteFileContents(file.GetPath(), contents);
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasks);
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      for (int j = 0; j < 10; ++j) {
+        EXPECT_EQ(io_uring->ReadFileContents(file.GetPath()), contents);
+      }
+    }));
+  }
+  engine::WaitAllChecked(tasks);
+}
+
+USERVER_NAMESPACE_END
@@ -224,6 +224,21 @@ size_t Socket::RecvSome(void* buf, size_t len, Deadline deadline) {
                        deadline, "RecvSome from ", peername_);
 }
 
+size_t Socket::RecvSome(struct iovec* list, std::size_t list_size,
+                        Deadline deadline) {
+  if (!IsValid()) {
+    throw IoException("Attempt to RecvSome from closed socket");
+  }
+  UASSERT(list);
+  UASSERT(list_size > 0);
+  UINVARIANT(list_size <= IOV_MAX, "To big array of iovec for RecvSome");
+  auto& dir = fd_control_->Read();
+  impl::Direction::SingleUserGuard guard(dir);
+  return dir.PerformIoV(guard, &readv, list, list_size,
+                        impl::TransferMode::kOnce, deadline, "RecvSome from ",
+                        peername_);
+}
+
 size_t Socket::RecvAll(void* buf, size_t len, Deadline deadline) {
   if (!IsValid()) {
     throw IoException("Attempt to RecvAll from closed socket");
@@ -175,6 +175,28 @@ UTEST(Socket, SendAllVector) {
   EXPECT_EQ(bytes_sent, bytes_read);
 }
 
+UTEST(Socket, RecvSomeVector) {
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  TcpListener listener;
+  auto sockets = listener.MakeSocketPair(deadline);
+
+  const std::string data = "datachunk 1chunk 2";
+  EXPECT_EQ(data.size(),
+            sockets.second.SendAll(data.data(), data.size(), deadline));
+
+  std::array<char, 4> head{};
+  std::array<char, 32> tail{};
+  std::array<struct iovec, 2> list{{{head.data(), head.size()},
+                                    {tail.data(), tail.size()}}};
+  const auto bytes_read =
+      sockets.first.RecvSome(list.data(), list.size(), deadline);
+  EXPECT_EQ(data.size(), bytes_read);
+  EXPECT_EQ(std::string(head.data(), head.size()), "data");
+  EXPECT_EQ(std::string(tail.data(), bytes_read - head.size()),
+            "chunk 1chunk 2");
+}
+
 UTEST(Socket, SendAllVectorHeap) {
   const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
 
@@ -0,0 +1,170 @@
+#include <engine/io/tls_session_cache.hpp>
+
+#include <cstring>
+#include <exception>
+
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/rand.h>
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+#include <openssl/core_names.h>
+#include <openssl/params.h>
+#else
+#include <openssl/hmac.h>
+#endif
+
+#include <userver/engine/io/exception.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/datetime.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::impl {
+
+namespace {
+
+const EVP_CIPHER* GetTicketCipher() noexcept { return EVP_aes_256_cbc(); }
+
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+using TicketMacCtx = EVP_MAC_CTX;
+
+int InitTicketMac(TicketMacCtx* mac_ctx, TlsTicketKeys::Key& key) noexcept {
+  // OSSL_PARAM takes a non-const string
+  static char kDigest[] = "SHA256";
+  const OSSL_PARAM params[] = {
+      OSSL_PARAM_construct_octet_string(OSSL_MAC_PARAM_KEY, key.hmac_key.data(),
+                                        key.hmac_key.size()),
+      OSSL_PARAM_construct_utf8_string(OSSL_MAC_PARAM_DIGEST, kDigest, 0),
+      OSSL_PARAM_construct_end(),
+  };
+  return EVP_MAC_CTX_set_params(mac_ctx, params);
+}
+#else
+using TicketMacCtx = HMAC_CTX;
+
+int InitTicketMac(TicketMacCtx* mac_ctx, TlsTicketKeys::Key& key) noexcept {
+  return HMAC_Init_ex(mac_ctx, key.hmac_key.data(),
+                      static_cast<int>(key.hmac_key.size()), EVP_sha256(),
+                      nullptr);
+}
+#endif
+
+// See SSL_CTX_set_tlsext_ticket_key_evp_cb for the return values
+int TicketKeyCallback(SSL* ssl, unsigned char* key_name, unsigned char* iv,
+                      EVP_CIPHER_CTX* cipher_ctx, TicketMacCtx* mac_ctx,
+                      int enc) noexcept {
+  try {
+    auto& keys = TlsTicketKeys::GetInstance();
+    if (enc) {
+      auto key = keys.GetEncryptionKey();
+      if (1 != RAND_bytes(iv, EVP_CIPHER_iv_length(GetTicketCipher()))) {
+        return -1;
+      }
+      std::memcpy(key_name, key.name.data(), key.name.size());
+      if (1 != EVP_EncryptInit_ex(cipher_ctx, GetTicketCipher(), nullptr,
+                                  key.aes_key.data(), iv)) {
+        return -1;
+      }
+      return InitTicketMac(mac_ctx, key) == 1 ? 1 : -1;
+    }
+
+    TlsTicketKeys::Key key;
+    bool renew = false;
+    // unknown key, a full handshake is performed
+    if (!keys.FindDecryptionKey(key_name, key, renew)) return 0;
+    if (1 != InitTicketMac(mac_ctx, key)) return -1;
+    if (1 != EVP_DecryptInit_ex(cipher_ctx, GetTicketCipher(), nullptr,
+                                key.aes_key.data(), iv)) {
+      return -1;
+    }
+    // TLS 1.3 tickets are single-use (RFC 8446, C.4), a new ticket is only
+    // sent after the resumption if it is renewed
+    return renew || SSL_version(ssl) >= TLS1_3_VERSION ? 2 : 1;
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_ERROR() << "Failed to process a TLS session ticket: " << ex;
+    return -1;
+  }
+}
+
+TlsTicketKeys::Key GenerateKey(std::chrono::steady_clock::time_point now) {
+  TlsTicketKeys::Key key;
+  if (1 != RAND_bytes(key.name.data(), key.name.size()) ||
+      1 != RAND_bytes(key.aes_key.data(), key.aes_key.size()) ||
+      1 != RAND_bytes(key.hmac_key.data(), key.hmac_key.size())) {
+    throw TlsException("Failed to generate a TLS session ticket key");
+  }
+  key.created = now;
+  return key;
+}
+
+}  // namespace
+
+TlsTicketKeys::Key::~Key() {
+  OPENSSL_cleanse(aes_key.data(), aes_key.size());
+  OPENSSL_cleanse(hmac_key.data(), hmac_key.size());
+}
+
+TlsTicketKeys& TlsTicketKeys::GetInstance() {
+  static TlsTicketKeys keys;
+  return keys;
+}
+
+void TlsTicketKeys::SetUp(SSL_CTX* ctx) {
+#if OPENSSL_VERSION_NUMBER >= 0x30000000L
+  SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, &TicketKeyCallback);
+#else
+  // cast in openssl macro expansion
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  SSL_CTX_set_tlsext_ticket_key_cb(ctx, &TicketKeyCallback);
+#endif
+}
+
+TlsTicketKeys::Key TlsTicketKeys::GetEncryptionKey() {
+  const std::lock_guard lock{mutex_};
+  RotateIfNeeded(utils::datetime::SteadyNow());
+  return keys_.front();
+}
+
+bool TlsTicketKeys::FindDecryptionKey(const unsigned char* name, Key& key,
+                                      bool& renew) {
+  const std::lock_guard lock{mutex_};
+  RotateIfNeeded(utils::datetime::SteadyNow());
+  for (std::size_t i = 0; i < keys_.size(); ++i) {
+    if (std::memcmp(keys_[i].name.data(), name, kNameSize) != 0) continue;
+    key = keys_[i];
+    renew = i != 0;
+    return true;
+  }
+  return false;
+}
+
+void TlsTicketKeys::RotateIfNeeded(std::chrono::steady_clock::time_point now) {
+  if (!keys_.empty() && now - keys_.front().created < kRotationPeriod) return;
+  keys_.push_front(GenerateKey(now));
+  while (keys_.size() > kMaxKeys ||
+         now - keys_.back().created >= kRotationPeriod * kMaxKeys) {
+    keys_.pop_back();
+  }
+}
+
+TlsClientSessionCache& TlsClientSessionCache::GetInstance() {
+  static TlsClientSessionCache cache;
+  return cache;
+}
+
+void TlsClientSessionCache::Put(const std::string& key, SslSession session) {
+  const std::lock_guard lock{mutex_};
+  sessions_.Put(key, std::move(session));
+}
+
+SslSession TlsClientSessionCache::Get(const std::string& key) {
+  const std::lock_guard lock{mutex_};
+  auto* session = sessions_.Get(key);
+  if (!session) return {};
+  SSL_SESSION_up_ref(session->get());
+  return SslSession{session->get()};
+}
+
+}  // namespace engine::io::impl
+
+USERVER_NAMESPACE_END
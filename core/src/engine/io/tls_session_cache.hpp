@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <openssl/ssl.h>
+
+#include <userver/cache/lru_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::impl {
+
+struct SslSessionDeleter {
+  void operator()(SSL_SESSION* session) const noexcept {
+    SSL_SESSION_free(session);
+  }
+};
+using SslSession = std::unique_ptr<SSL_SESSION, SslSessionDeleter>;
+
+/// Keys that encrypt the TLS session tickets of all the servers of the
+/// process.
+///
+/// A new key is generated every kRotationPeriod. The tickets of the previous
+/// keys are accepted and renewed until the key is kMaxKeys periods old,
+/// which is longer than the default ticket lifetime of 2 hours.
+class TlsTicketKeys final {
+ public:
+  static constexpr std::chrono::hours kRotationPeriod{1};
+  static constexpr std::size_t kMaxKeys = 3;
+  static constexpr std::size_t kNameSize = 16;
+  static constexpr std::size_t kSecretSize = 32;
+
+  struct Key final {
+    Key() = default;
+    Key(const Key&) = default;
+    Key& operator=(const Key&) = default;
+    ~Key();
+
+    std::array<unsigned char, kNameSize> name{};
+    std::array<unsigned char, kSecretSize> aes_key{};
+    std::array<unsigned char, kSecretSize> hmac_key{};
+    std::chrono::steady_clock::time_point created;
+  };
+
+  static TlsTicketKeys& GetInstance();
+
+  /// Makes the server context encrypt and decrypt the tickets with the keys
+  static void SetUp(SSL_CTX* ctx);
+
+  /// @returns the key for the new tickets
+  Key GetEncryptionKey();
+
+  /// @returns false if the key is unknown or too old
+  /// @param renew set to true if the ticket should be replaced with the one
+  /// encrypted by the current key
+  bool FindDecryptionKey(const unsigned char* name, Key& key, bool& renew);
+
+ private:
+  void RotateIfNeeded(std::chrono::steady_clock::time_point now);
+
+  std::mutex mutex_;
+  // The current key is the first one
+  std::deque<Key> keys_;
+};
+
+/// Sessions of the TLS clients of the process for the resumption on
+/// reconnects, by the server name and address
+class TlsClientSessionCache final {
+ public:
+  static constexpr std::size_t kMaxSessions = 1024;
+
+  static TlsClientSessionCache& GetInstance();
+
+  void Put(const std::string& key, SslSession session);
+
+  /// The session stays in the cache till a newer one is put: the servers do
+  /// not always issue a new ticket after the resumed handshake.
+  /// @returns nullptr if there is no session for the key
+  SslSession Get(const std::string& key);
+
+ private:
+  std::mutex mutex_;
+  cache::LruMap<std::string, SslSession> sessions_{kMaxSessions};
+};
+
+}  // namespace engine::io::impl
+
+USERVER_NAMESPACE_END
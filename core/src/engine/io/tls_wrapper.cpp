@@ -1,7 +1,9 @@
 #include <userver/engine/io/tls_wrapper.hpp>
 
+#include <deque>
 #include <exception>
 #include <memory>
+#include <mutex>
 
 #include <fmt/format.h>
 #include <openssl/bio.h>
@@ -10,10 +12,16 @@
 #include <crypto/helpers.hpp>
 #include <crypto/openssl.hpp>
 #include <engine/io/fd_control.hpp>
+#include <engine/io/tls_session_cache.hpp>
 #include <userver/engine/io/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#if defined(SSL_OP_ENABLE_KTLS) && !defined(OPENSSL_NO_KTLS)
+#define USERVER_IMPL_HAS_KTLS 1
+#endif
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::io {
@@ -23,6 +31,7 @@ struct SslCtxDeleter {
   void operator()(SSL_CTX* ctx) const noexcept { SSL_CTX_free(ctx); }
 };
 using SslCtx = std::unique_ptr<SSL_CTX, SslCtxDeleter>;
+using SharedSslCtx = std::shared_ptr<SSL_CTX>;
 
 struct SslDeleter {
   void operator()(SSL* ssl) const noexcept { SSL_free(ssl); }
@@ -225,6 +234,145 @@ SslCtx MakeSslCtx() {
   return ssl_ctx;
 }
 
+// Passes the new sessions to TlsClientSessionCache, the app data of the SSL
+// is the key of the session in the cache
+int OnNewClientSession(SSL* ssl, SSL_SESSION* session) noexcept {
+  const auto* key = static_cast<const std::string*>(SSL_get_app_data(ssl));
+  if (!key || key->empty()) return 0;
+
+  try {
+    SSL_SESSION_up_ref(session);
+    impl::TlsClientSessionCache::GetInstance().Put(*key,
+                                                   impl::SslSession{session});
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_WARNING() << "Failed to cache a TLS session: " << ex;
+  }
+  // the reference of OpenSSL is released by OpenSSL
+  return 0;
+}
+
+// Creating a context loads the default verify paths, so the contexts are
+// shared by the connections
+SharedSslCtx GetClientSslCtx() {
+  static const SharedSslCtx kSslCtx = [] {
+    auto ssl_ctx = MakeSslCtx();
+    SSL_CTX_set_session_cache_mode(
+        ssl_ctx.get(),
+        SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ssl_ctx.get(), &OnNewClientSession);
+    return SharedSslCtx{ssl_ctx.release(), SslCtxDeleter{}};
+  }();
+  return kSslCtx;
+}
+
+SslCtx MakeServerSslCtx(
+    const crypto::Certificate& cert, const crypto::PrivateKey& key,
+    const std::vector<crypto::Certificate>& cert_authorities) {
+  auto ssl_ctx = MakeSslCtx();
+
+  if (!cert_authorities.empty()) {
+    auto* store = SSL_CTX_get_cert_store(ssl_ctx.get());
+    for (const auto& ca : cert_authorities) {
+      if (1 != X509_STORE_add_cert(store, ca.GetNative())) {
+        throw TlsException(crypto::FormatSslError(
+            "Failed to set up server TLS wrapper: X509_STORE_add_cert"));
+      }
+    }
+    SSL_CTX_set_verify(ssl_ctx.get(),
+                       SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
+                       nullptr);
+    LOG_INFO() << "Client SSL cert is verified";
+  } else {
+    LOG_INFO() << "Client SSL cert is not verified";
+  }
+
+  if (1 != SSL_CTX_use_certificate(ssl_ctx.get(), cert.GetNative())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_use_certificate"));
+  }
+
+  if (1 != SSL_CTX_use_PrivateKey(ssl_ctx.get(), key.GetNative())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
+  }
+
+  // the sessions of the verified clients are not resumed without it
+  constexpr std::string_view kSessionIdContext = "userver";
+  if (1 != SSL_CTX_set_session_id_context(
+               ssl_ctx.get(),
+               reinterpret_cast<const unsigned char*>(kSessionIdContext.data()),
+               kSessionIdContext.size())) {
+    throw TlsException(crypto::FormatSslError(
+        "Failed to set up server TLS wrapper: SSL_CTX_set_session_id_context"));
+  }
+  impl::TlsTicketKeys::SetUp(ssl_ctx.get());
+  return ssl_ctx;
+}
+
+// The contexts of the recently used certificates, the certificates are held
+// to keep their native pointers unique
+class ServerSslCtxCache final {
+ public:
+  static constexpr std::size_t kMaxContexts = 16;
+
+  SharedSslCtx Get(const crypto::Certificate& cert,
+                   const crypto::PrivateKey& key,
+                   const std::vector<crypto::Certificate>& cert_authorities) {
+    {
+      const std::lock_guard lock{mutex_};
+      if (auto* entry = Find(cert, key, cert_authorities)) return entry->ctx;
+    }
+
+    SharedSslCtx ssl_ctx{
+        MakeServerSslCtx(cert, key, cert_authorities).release(),
+        SslCtxDeleter{}};
+
+    const std::lock_guard lock{mutex_};
+    if (auto* entry = Find(cert, key, cert_authorities)) return entry->ctx;
+    if (entries_.size() >= kMaxContexts) entries_.pop_front();
+    entries_.push_back({cert, key, cert_authorities, ssl_ctx});
+    return ssl_ctx;
+  }
+
+ private:
+  struct Entry {
+    crypto::Certificate cert;
+    crypto::PrivateKey key;
+    std::vector<crypto::Certificate> cert_authorities;
+    SharedSslCtx ctx;
+  };
+
+  Entry* Find(const crypto::Certificate& cert, const crypto::PrivateKey& key,
+              const std::vector<crypto::Certificate>& cert_authorities) {
+    const auto same_native = [](const auto& lhs, const auto& rhs) {
+      return lhs.GetNative() == rhs.GetNative();
+    };
+    for (auto& entry : entries_) {
+      if (same_native(entry.cert, cert) && same_native(entry.key, key) &&
+          std::equal(entry.cert_authorities.begin(),
+                     entry.cert_authorities.end(), cert_authorities.begin(),
+                     cert_authorities.end(), same_native)) {
+        return &entry;
+      }
+    }
+    return nullptr;
+  }
+
+  std::mutex mutex_;
+  std::deque<Entry> entries_;
+};
+
+SharedSslCtx GetServerSslCtx(
+    const crypto::Certificate& cert, const crypto::PrivateKey& key,
+    const std::vector<crypto::Certificate>& cert_authorities) {
+  static ServerSslCtxCache cache;
+  return cache.Get(cert, key, cert_authorities);
+}
+
+bool IsRetryError(int ssl_error) noexcept {
+  return ssl_error == SSL_ERROR_WANT_READ || ssl_error == SSL_ERROR_WANT_WRITE;
+}
+
 enum InterruptAction {
   kPass,
   kFail,
@@ -239,22 +387,16 @@ class TlsWrapper::Impl {
   Impl(Impl&& other) noexcept
       : bio_data(std::move(other.bio_data)),
         ssl(std::move(other.ssl)),
+        session_cache_key(std::move(other.session_cache_key)),
+        is_socket_bio(other.is_socket_bio),
         is_in_shutdown(other.is_in_shutdown) {
     UASSERT(SSL_get_rbio(ssl.get()) == SSL_get_wbio(ssl.get()));
-    SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
+    SSL_set_app_data(ssl.get(), &session_cache_key);
+    if (!is_socket_bio) SyncBioData(SSL_get_rbio(ssl.get()), &other.bio_data);
   }
 
-  void SetUp(SslCtx&& ssl_ctx) {
-    Bio socket_bio{BIO_new(GetSocketBioMethod())};
-    if (!socket_bio) {
-      throw TlsException(
-          crypto::FormatSslError("Failed to set up TLS wrapper: BIO_new"));
-    }
-    BIO_set_shutdown(socket_bio.get(), 0);
-    SyncBioData(socket_bio.get(), nullptr);
-    BIO_set_init(socket_bio.get(), 1);
-
-    ssl.reset(SSL_new(ssl_ctx.get()));
+  void SetUp(SSL_CTX* ssl_ctx, const TlsSettings& settings) {
+    ssl.reset(SSL_new(ssl_ctx));
     if (!ssl) {
       throw TlsException(
           crypto::FormatSslError("Failed to set up TLS wrapper: SSL_new"));
@@ -262,10 +404,104 @@ class TlsWrapper::Impl {
 #if OPENSSL_VERSION_NUMBER < 0x010100000L
     ssl->s3->flags |= SSL3_FLAGS_NO_RENEGOTIATE_CIPHERS;
 #endif
+    SSL_set_app_data(ssl.get(), &session_cache_key);
+
+    Bio socket_bio;
+#ifdef USERVER_IMPL_HAS_KTLS
+    if (settings.enable_ktls) {
+      // OpenSSL hands the connection over to the kernel only through its own
+      // socket BIO, the waits for the socket are performed by PerformSslIo
+      socket_bio.reset(BIO_new_socket(bio_data.socket.Fd(), BIO_NOCLOSE));
+      if (!socket_bio) {
+        throw TlsException(crypto::FormatSslError(
+            "Failed to set up TLS wrapper: BIO_new_socket"));
+      }
+      SSL_set_options(ssl.get(), SSL_OP_ENABLE_KTLS);
+      is_socket_bio = true;
+    }
+#else
+    if (settings.enable_ktls) {
+      LOG_LIMITED_INFO() << "Kernel TLS is not supported by the OpenSSL";
+    }
+#endif
+    if (!socket_bio) {
+      socket_bio.reset(BIO_new(GetSocketBioMethod()));
+      if (!socket_bio) {
+        throw TlsException(
+            crypto::FormatSslError("Failed to set up TLS wrapper: BIO_new"));
+      }
+      BIO_set_shutdown(socket_bio.get(), 0);
+      SyncBioData(socket_bio.get(), nullptr);
+      BIO_set_init(socket_bio.get(), 1);
+    }
+
     SSL_set_bio(ssl.get(), socket_bio.get(), socket_bio.get());
     [[maybe_unused]] const auto* disowned_bio = socket_bio.release();
   }
 
+  void SetUpClientSession(const std::string& server_name) {
+    session_cache_key =
+        fmt::format("{}@{}", server_name, bio_data.socket.Getpeername());
+    auto session =
+        impl::TlsClientSessionCache::GetInstance().Get(session_cache_key);
+    if (session && 1 != SSL_set_session(ssl.get(), session.get())) {
+      LOG_LIMITED_WARNING() << crypto::FormatSslError(
+          "Failed to resume TLS session: SSL_set_session");
+    }
+  }
+
+  void DisableServerSessions() {
+    SSL_set_options(ssl.get(), SSL_OP_NO_TICKET);
+#if OPENSSL_VERSION_NUMBER >= 0x010101000L
+    SSL_set_num_tickets(ssl.get(), 0);
+#endif
+  }
+
+  template <typename Handshake>
+  void PerformHandshake(Handshake handshake, Deadline deadline,
+                        const char* context) {
+    bio_data.current_deadline = deadline;
+    while (true) {
+      const auto ret = handshake(ssl.get());
+      if (ret == 1) return;
+
+      const int ssl_error = SSL_get_error(ssl.get(), ret);
+      if (is_socket_bio && IsRetryError(ssl_error)) {
+        WaitSocket(ssl_error, deadline, 0);
+        if (!bio_data.last_exception) continue;
+      }
+      if (bio_data.last_exception) {
+        std::rethrow_exception(bio_data.last_exception);
+      }
+
+      throw TlsException(crypto::FormatSslError(
+          fmt::format("Failed to set up {} TLS wrapper ({})", context,
+                      ssl_error)));
+    }
+  }
+
+  // The socket BIO does not wait for the socket, the failure of the wait is
+  // reported in the same way as the one of SocketBioData
+  void WaitSocket(int ssl_error, Deadline deadline,
+                  std::size_t bytes_transferred) {
+    UASSERT(is_socket_bio);
+    bio_data.last_exception = {};
+    auto& socket = bio_data.socket;
+    const bool is_ready = ssl_error == SSL_ERROR_WANT_READ
+                              ? socket.WaitReadable(deadline)
+                              : socket.WaitWriteable(deadline);
+    if (is_ready) return;
+
+    try {
+      if (engine::current_task::ShouldCancel()) {
+        throw IoCancelled(bytes_transferred);
+      }
+      throw IoTimeout(bytes_transferred);
+    } catch (const IoInterrupted&) {
+      bio_data.last_exception = std::current_exception();
+    }
+  }
+
   template <typename SslIoFunc>
   size_t PerformSslIo(SslIoFunc&& io_func, void* buf, size_t len,
                       impl::TransferMode mode, InterruptAction interrupt_action,
@@ -274,6 +510,7 @@ class TlsWrapper::Impl {
     if (!len) return 0;
 
     bio_data.current_deadline = deadline;
+    if (is_socket_bio) bio_data.last_exception = {};
 
     char* const begin = static_cast<char*>(buf);
     char* const end = begin + len;
@@ -294,6 +531,8 @@ class TlsWrapper::Impl {
           // timeout, cancel, EOF, or just a spurious wakeup
           case SSL_ERROR_WANT_READ:
           case SSL_ERROR_WANT_WRITE:
+            if (is_socket_bio) WaitSocket(ssl_error, deadline, pos - begin);
+            break;
           case SSL_ERROR_ZERO_RETURN:
             break;
 
@@ -335,6 +574,10 @@ class TlsWrapper::Impl {
 
   SocketBioData bio_data;
   Ssl ssl;
+  // Key of the client session in TlsClientSessionCache, empty if the session
+  // is not cached
+  std::string session_cache_key;
+  bool is_socket_bio{false};
   bool is_in_shutdown{false};
 
  private:
@@ -349,97 +592,53 @@ TlsWrapper::TlsWrapper(Socket&& socket) : impl_(std::move(socket)) {}
 
 TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
                                       const std::string& server_name,
-                                      Deadline deadline) {
-  auto ssl_ctx = MakeSslCtx();
+                                      Deadline deadline,
+                                      const TlsSettings& settings) {
+  TlsWrapper wrapper{std::move(socket)};
+  wrapper.impl_->SetUp(GetClientSslCtx().get(), settings);
+  auto* ssl = wrapper.impl_->ssl.get();
 
   if (!server_name.empty()) {
-    X509_VERIFY_PARAM* verify_param = SSL_CTX_get0_param(ssl_ctx.get());
+    X509_VERIFY_PARAM* verify_param = SSL_get0_param(ssl);
     if (!verify_param) {
-      throw TlsException(
-          "Failed to set up client TLS wrapper: SSL_CTX_get0_param");
+      throw TlsException("Failed to set up client TLS wrapper: SSL_get0_param");
     }
     if (1 != X509_VERIFY_PARAM_set1_host(verify_param, server_name.data(),
                                          server_name.size())) {
       throw TlsException(crypto::FormatSslError(
           "Failed to set up client TLS wrapper: X509_VERIFY_PARAM_set1_host"));
     }
-    SSL_CTX_set_verify(ssl_ctx.get(), SSL_VERIFY_PEER, nullptr);
-  }
+    SSL_set_verify(ssl, SSL_VERIFY_PEER, nullptr);
 
-  TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
-  if (!server_name.empty()) {
     // cast in openssl1.0 macro expansion
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
-    if (1 != SSL_set_tlsext_host_name(wrapper.impl_->ssl.get(),
-                                      server_name.c_str())) {
+    if (1 != SSL_set_tlsext_host_name(ssl, server_name.c_str())) {
       throw TlsException(crypto::FormatSslError(
           "Failed to set up client TLS wrapper: SSL_set_tlsext_host_name"));
     }
   }
-
-  wrapper.impl_->bio_data.current_deadline = deadline;
-
-  auto ret = SSL_connect(wrapper.impl_->ssl.get());
-  if (1 != ret) {
-    if (wrapper.impl_->bio_data.last_exception) {
-      std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
-    }
-
-    throw TlsException(crypto::FormatSslError(
-        fmt::format("Failed to set up client TLS wrapper ({})",
-                    SSL_get_error(wrapper.impl_->ssl.get(), ret))));
+  if (settings.enable_session_resumption) {
+    wrapper.impl_->SetUpClientSession(server_name);
   }
+
+  wrapper.impl_->PerformHandshake(&SSL_connect, deadline, "client");
   return wrapper;
 }
 
 TlsWrapper TlsWrapper::StartTlsServer(
     Socket&& socket, const crypto::Certificate& cert,
     const crypto::PrivateKey& key, Deadline deadline,
-    const std::vector<crypto::Certificate>& cert_authorities) {
-  auto ssl_ctx = MakeSslCtx();
-
-  if (!cert_authorities.empty()) {
-    auto* store = SSL_CTX_get_cert_store(ssl_ctx.get());
-    for (const auto& ca : cert_authorities) {
-      if (1 != X509_STORE_add_cert(store, ca.GetNative())) {
-        throw TlsException(crypto::FormatSslError(
-            "Failed to set up server TLS wrapper: X509_STORE_add_cert"));
-      }
-    }
-    SSL_CTX_set_verify(ssl_ctx.get(),
-                       SSL_VERIFY_PEER | SSL_VERIFY_FAIL_IF_NO_PEER_CERT,
-                       nullptr);
-    LOG_INFO() << "Client SSL cert is verified";
-  } else {
-    LOG_INFO() << "Client SSL cert is not verified";
-  }
-
-  if (1 != SSL_CTX_use_certificate(ssl_ctx.get(), cert.GetNative())) {
-    throw TlsException(crypto::FormatSslError(
-        "Failed to set up server TLS wrapper: SSL_CTX_use_certificate"));
-  }
-
-  if (1 != SSL_CTX_use_PrivateKey(ssl_ctx.get(), key.GetNative())) {
-    throw TlsException(crypto::FormatSslError(
-        "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
-  }
+    const std::vector<crypto::Certificate>& cert_authorities,
+    const TlsSettings& settings) {
+  const auto ssl_ctx = GetServerSslCtx(cert, key, cert_authorities);
 
   TlsWrapper wrapper{std::move(socket)};
-  wrapper.impl_->SetUp(std::move(ssl_ctx));
-  wrapper.impl_->bio_data.current_deadline = deadline;
-
-  auto ret = SSL_accept(wrapper.impl_->ssl.get());
-  if (1 != ret) {
-    if (wrapper.impl_->bio_data.last_exception) {
-      std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
-    }
-
-    throw TlsException(crypto::FormatSslError(
-        fmt::format("Failed to set up server TLS wrapper ({})",
-                    SSL_get_error(wrapper.impl_->ssl.get(), ret))));
+  wrapper.impl_->SetUp(ssl_ctx.get(), settings);
+  if (!settings.enable_session_resumption) {
+    wrapper.impl_->DisableServerSessions();
   }
 
+  wrapper.impl_->PerformHandshake(&SSL_accept, deadline, "server");
   return wrapper;
 }
 
@@ -456,6 +655,20 @@ bool TlsWrapper::IsValid() const {
   return impl_->ssl && !impl_->is_in_shutdown;
 }
 
+bool TlsWrapper::IsKernelTlsEnabled() const {
+#ifdef USERVER_IMPL_HAS_KTLS
+  if (!impl_->ssl || !impl_->is_socket_bio) return false;
+  return BIO_get_ktls_send(SSL_get_wbio(impl_->ssl.get())) &&
+         BIO_get_ktls_recv(SSL_get_rbio(impl_->ssl.get()));
+#else
+  return false;
+#endif
+}
+
+bool TlsWrapper::IsSessionReused() const {
+  return impl_->ssl && SSL_session_reused(impl_->ssl.get()) == 1;
+}
+
 bool TlsWrapper::WaitReadable(Deadline deadline) {
   impl_->CheckAlive();
   char buf = 0;
@@ -492,6 +705,7 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
   if (impl_->ssl) {
     impl_->is_in_shutdown = true;
     impl_->bio_data.current_deadline = deadline;
+    if (impl_->is_socket_bio) impl_->bio_data.last_exception = {};
     int shutdown_ret = 0;
     while (shutdown_ret != 1) {
       shutdown_ret = SSL_shutdown(impl_->ssl.get());
@@ -501,6 +715,9 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
           // this is fine
           case SSL_ERROR_WANT_READ:
           case SSL_ERROR_WANT_WRITE:
+            if (impl_->is_socket_bio) {
+              impl_->WaitSocket(ssl_error, deadline, 0);
+            }
             break;
 
           // connection breaking errors
@@ -520,6 +737,8 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
         }
       }
     }
+    // the kernel TLS can not be detached from the socket
+    if (IsKernelTlsEnabled()) impl_->bio_data.socket.Close();
     impl_->ssl.reset();
   }
   return std::move(impl_->bio_data.socket);
@@ -15,6 +15,7 @@
 #include <userver/internal/net/net_listener.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/async.hpp>
+#include <utils/ignore_signal_scope.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -572,4 +573,116 @@ UTEST(TlsWrapper, PeerDisconnect) {
   server_task.Get();
 }
 
+UTEST_MT(TlsWrapper, SessionResumption, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  TcpListener tcp_listener;
+  const auto exchange = [&] {
+    auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+    auto server_task = engine::AsyncNoSpan(
+        [test_deadline](auto&& server) {
+          auto tls_server = io::TlsWrapper::StartTlsServer(
+              std::forward<decltype(server)>(server),
+              crypto::Certificate::LoadFromString(cert),
+              crypto::PrivateKey::LoadFromString(key), test_deadline);
+          EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+          char c = 0;
+          EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+          EXPECT_EQ('2', c);
+          return tls_server.IsSessionReused();
+        },
+        std::move(server));
+
+    auto tls_client =
+        io::TlsWrapper::StartTlsClient(std::move(client), {}, test_deadline);
+    // the TLS 1.3 session ticket is received along with the data
+    char c = 0;
+    EXPECT_EQ(1, tls_client.RecvSome(&c, 1, test_deadline));
+    EXPECT_EQ('1', c);
+    EXPECT_EQ(1, tls_client.SendAll("2", 1, test_deadline));
+    EXPECT_EQ(tls_client.IsSessionReused(), server_task.Get());
+    return tls_client.IsSessionReused();
+  };
+
+  // the first session may be resumed if a previous test used the same port
+  exchange();
+  EXPECT_TRUE(exchange());
+  EXPECT_TRUE(exchange());
+}
+
+UTEST_MT(TlsWrapper, SessionResumptionDisabled, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  const io::TlsSettings settings{/*enable_ktls=*/false,
+                                 /*enable_session_resumption=*/false};
+
+  TcpListener tcp_listener;
+  for (int i = 0; i < 2; ++i) {
+    auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+    auto server_task = engine::AsyncNoSpan(
+        [test_deadline, &settings](auto&& server) {
+          auto tls_server = io::TlsWrapper::StartTlsServer(
+              std::forward<decltype(server)>(server),
+              crypto::Certificate::LoadFromString(cert),
+              crypto::PrivateKey::LoadFromString(key), test_deadline, {},
+              settings);
+          EXPECT_FALSE(tls_server.IsSessionReused());
+          EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+        },
+        std::move(server));
+
+    auto tls_client = io::TlsWrapper::StartTlsClient(std::move(client), {},
+                                                     test_deadline, settings);
+    EXPECT_FALSE(tls_client.IsSessionReused());
+    char c = 0;
+    EXPECT_EQ(1, tls_client.RecvSome(&c, 1, test_deadline));
+    EXPECT_EQ('1', c);
+    server_task.Get();
+  }
+}
+
+UTEST_MT(TlsWrapper, KernelTls, 2) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+  const io::TlsSettings settings{/*enable_ktls=*/true};
+  // the socket BIO of OpenSSL does not suppress SIGPIPE
+  const utils::IgnoreSignalScope ignore_sigpipe_scope(SIGPIPE);
+  // larger than a TLS record
+  const std::string data(100 * 1024, 'a');
+
+  TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+
+  auto server_task = engine::AsyncNoSpan(
+      [test_deadline, &settings, &data](auto&& server) {
+        auto tls_server = io::TlsWrapper::StartTlsServer(
+            std::forward<decltype(server)>(server),
+            crypto::Certificate::LoadFromString(cert),
+            crypto::PrivateKey::LoadFromString(key), test_deadline, {},
+            settings);
+        LOG_INFO() << "Kernel TLS is "
+                   << (tls_server.IsKernelTlsEnabled() ? "enabled"
+                                                       : "not available");
+        EXPECT_EQ(data.size(),
+                  tls_server.SendAll(data.data(), data.size(), test_deadline));
+        char c = 0;
+        EXPECT_EQ(1, tls_server.RecvSome(&c, 1, test_deadline));
+        EXPECT_EQ('2', c);
+      },
+      std::move(server));
+
+  auto tls_client = io::TlsWrapper::StartTlsClient(std::move(client), {},
+                                                   test_deadline, settings);
+  std::string received(data.size(), '\0');
+  EXPECT_EQ(data.size(), tls_client.RecvAll(received.data(), received.size(),
+                                            test_deadline));
+  EXPECT_EQ(data, received);
+  EXPECT_EQ(1, tls_client.SendAll("2", 1, test_deadline));
+  server_task.Get();
+
+  const bool is_kernel_tls = tls_client.IsKernelTlsEnabled();
+  auto raw_client = tls_client.StopTls(test_deadline);
+  if (is_kernel_tls) {
+    EXPECT_FALSE(raw_client.IsValid());
+  }
+}
+
 USERVER_NAMESPACE_END
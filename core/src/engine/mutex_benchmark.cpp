@@ -6,11 +6,12 @@
 #include <thread>
 #include <vector>
 
-#include <concurrent/impl/interference_shield.hpp>
+#include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/single_waiting_task_mutex.hpp>
+#include <userver/ubench/engine_benchmark.hpp>
 #include <userver/utils/rand.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -276,6 +277,19 @@ void single_waiting_task_mutex_contention_with_payload(
   });
 }
 
+/// [RunConcurrently sample]
+void mutex_coro_contention_latency(benchmark::State& state) {
+  engine::Mutex mutex;
+  std::uint64_t counter = 0;
+
+  ubench::RunConcurrently(
+      state, ubench::ConcurrencyOptionsFromArgs(state), [&](std::size_t) {
+        const std::lock_guard lock{mutex};
+        benchmark::DoNotOptimize(++counter);
+      });
+}
+/// [RunConcurrently sample]
+
 }  // namespace
 
 BENCHMARK(mutex_coro_lock);
@@ -294,4 +308,8 @@ BENCHMARK(mutex_coro_contention_with_payload)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(mutex_std_contention_with_payload)->RangeMultiplier(2)->Range(1, 32);
 BENCHMARK(single_waiting_task_mutex_contention_with_payload)->Range(1, 2);
 
+BENCHMARK(mutex_coro_contention_latency)
+    ->ArgsProduct({{1, 2, 4}, {1, 4, 32}})
+    ->UseRealTime();
+
 USERVER_NAMESPACE_END
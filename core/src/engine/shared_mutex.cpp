@@ -1,5 +1,7 @@
 #include <userver/engine/shared_mutex.hpp>
 
+#include <engine/impl/adaptive_spin.hpp>
+#include <engine/task/task_context.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/utils/scope_guard.hpp>
 
@@ -14,6 +16,8 @@ constexpr auto kWriterLock = std::numeric_limits<Semaphore::Counter>::max();
 SharedMutex::SharedMutex()
     : semaphore_(kWriterLock), waiting_writers_count_(0) {}
 
+SharedMutex::~SharedMutex() = default;
+
 void SharedMutex::lock() {
   const auto ok = try_lock_until(Deadline{});
   UASSERT(ok);
@@ -45,7 +49,14 @@ bool SharedMutex::try_lock_until(Deadline deadline) {
   waiting_writers_count_.fetch_add(1, std::memory_order_relaxed);
 
   utils::ScopeGuard stop_wait([this] { DecWaitingWriters(); });
-  if (semaphore_.try_lock_shared_until_count(deadline, kWriterLock)) {
+  if (semaphore_.try_lock_shared_count(kWriterLock) ||
+      (!deadline.IsReached() &&
+       writers_spin_->Spin(current_task::GetCurrentTaskContext(),
+                           [this] {
+                             return semaphore_.try_lock_shared_count(
+                                 kWriterLock);
+                           })) ||
+      semaphore_.try_lock_shared_until_count(deadline, kWriterLock)) {
     stop_wait.Release();
     return true;
   }
@@ -89,6 +100,12 @@ bool SharedMutex::WaitForNoWaitingWriters(Deadline deadline) {
   /* Fast path */
   if (waiting_writers_count_ == 0) return true;
 
+  if (!deadline.IsReached() &&
+      readers_spin_->Spin(current_task::GetCurrentTaskContext(),
+                          [this] { return waiting_writers_count_ == 0; })) {
+    return true;
+  }
+
   std::unique_lock<Mutex> lock(waiting_writers_count_mutex_);
   return waiting_writers_count_cv_.WaitUntil(
       lock, deadline, [this] { return waiting_writers_count_ == 0; });
@@ -1,5 +1,8 @@
 #include <benchmark/benchmark.h>
 
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
 #include <vector>
 
 #include <userver/engine/async.hpp>
@@ -46,4 +49,35 @@ void shared_mutex_benchmark(benchmark::State& state) {
 }
 BENCHMARK(shared_mutex_benchmark)->DenseRange(1, 6);
 
+void shared_mutex_writers_benchmark(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    int variable = 0;
+    engine::SharedMutex mutex;
+    std::atomic<bool> is_running(true);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(state.range(0) - 1);
+    for (int i = 0; i < state.range(0) - 1; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&] {
+        while (is_running) {
+          std::unique_lock lock(mutex);
+          benchmark::DoNotOptimize(++variable);
+        }
+      }));
+    }
+
+    for ([[maybe_unused]] auto _ : state) {
+      std::unique_lock lock(mutex);
+      benchmark::DoNotOptimize(++variable);
+    }
+
+    is_running = false;
+
+    for (auto& task : tasks) {
+      task.Get();
+    }
+  });
+}
+BENCHMARK(shared_mutex_writers_benchmark)->DenseRange(1, 6);
+
 USERVER_NAMESPACE_END
@@ -34,6 +34,13 @@ void SleepUntil(Deadline deadline) {
 
 void Yield() { SleepUntil(Deadline::Passed()); }
 
+void CooperativeYieldPoint(std::chrono::microseconds budget) {
+  if (current_task::GetCurrentTaskContext().GetCurrentSliceDuration() >=
+      budget) {
+    Yield();
+  }
+}
+
 }  // namespace engine
 
 USERVER_NAMESPACE_END
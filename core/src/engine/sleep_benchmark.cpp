@@ -1,9 +1,12 @@
 #include <benchmark/benchmark.h>
 
+#include <vector>
+
 #include <engine/ev/thread_control.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 
 using namespace std::chrono_literals;
 
@@ -63,6 +66,30 @@ void unreached_task_deadline_benchmark(benchmark::State& state,
     }
   });
 }
+// Many concurrent sleepers, as with lots of in-flight requests with deadlines
+void concurrent_sleep_benchmark(benchmark::State& state) {
+  engine::RunStandalone(4, [&] {
+    const auto tasks_count = static_cast<std::size_t>(state.range(0));
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(tasks_count);
+
+    for ([[maybe_unused]] auto _ : state) {
+      for (std::size_t i = 0; i < tasks_count; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([i] {
+          engine::SleepFor(std::chrono::microseconds{100 + i % 1000});
+        }));
+      }
+      for (auto& task : tasks) task.Get();
+      tasks.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * tasks_count);
+  });
+}
+BENCHMARK(concurrent_sleep_benchmark)
+    ->RangeMultiplier(8)
+    ->Range(8, 32 * 1024)
+    ->Unit(benchmark::kMillisecond);
+
 BENCHMARK_CAPTURE(unreached_task_deadline_benchmark, no_task_deadline, false);
 BENCHMARK_CAPTURE(unreached_task_deadline_benchmark, unreached_task_deadline,
                   true);
@@ -0,0 +1,100 @@
+#include <userver/engine/stackless_task.hpp>
+
+#ifdef USERVER_IMPL_HAS_STACKLESS_TASKS
+
+#include <algorithm>
+
+#include <userver/engine/exception.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/wait_any.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::stackless::impl {
+
+void Scheduler::Schedule(std::coroutine_handle<> handle) {
+  ready_.push_back(handle);
+}
+
+void Scheduler::Wait(engine::impl::ContextAccessor* target, Deadline deadline,
+                     std::coroutine_handle<> handle, WaitResult& result) {
+  waiters_.push_back({target, deadline, handle, &result});
+}
+
+void Scheduler::Run(std::size_t roots_count) {
+  unfinished_roots_ = roots_count;
+
+  while (true) {
+    while (!ready_.empty()) {
+      const auto handle = ready_.front();
+      ready_.pop_front();
+      handle.resume();
+    }
+
+    if (unfinished_roots_ == 0) break;
+
+    UINVARIANT(!waiters_.empty(),
+               "A stackless coroutine was suspended on something other than "
+               "the engine awaitables");
+    WaitForAny();
+  }
+
+  UASSERT(waiters_.empty());
+}
+
+void Scheduler::OnRootFinished() noexcept {
+  UASSERT(unfinished_roots_ > 0);
+  --unfinished_roots_;
+}
+
+// The whole set of waiters is re-registered in the wait lists on each call,
+// which gives O(N) per wakeup. That is fine for the fan-outs of up to several
+// thousands of subtasks.
+void Scheduler::WaitForAny() {
+  Deadline deadline;
+  targets_.clear();
+  for (const auto& waiter : waiters_) {
+    if (waiter.target) targets_.push_back(waiter.target);
+    deadline = std::min(deadline, waiter.deadline);
+  }
+
+  // Multiple coroutines may await the same future
+  std::sort(targets_.begin(), targets_.end());
+  targets_.erase(std::unique(targets_.begin(), targets_.end()),
+                 targets_.end());
+
+  if (targets_.empty()) {
+    engine::InterruptibleSleepUntil(deadline);
+  } else {
+    engine::impl::DoWaitAny(targets_, deadline);
+  }
+
+  const bool is_cancelled = current_task::ShouldCancel();
+  const auto is_woken_up = [this, is_cancelled](const Waiter& waiter) {
+    if (waiter.target && waiter.target->IsReady()) {
+      *waiter.result = WaitResult::kReady;
+    } else if (waiter.deadline.IsReached()) {
+      *waiter.result = WaitResult::kTimeout;
+    } else if (is_cancelled) {
+      *waiter.result = WaitResult::kCancelled;
+    } else {
+      return false;
+    }
+    ready_.push_back(waiter.handle);
+    return true;
+  };
+  waiters_.erase(
+      std::remove_if(waiters_.begin(), waiters_.end(), is_woken_up),
+      waiters_.end());
+}
+
+void ThrowWaitInterrupted() {
+  throw WaitInterruptedException(current_task::CancellationReason());
+}
+
+}  // namespace engine::stackless::impl
+
+USERVER_NAMESPACE_END
+
+#endif  // USERVER_IMPL_HAS_STACKLESS_TASKS
@@ -0,0 +1,133 @@
+#include <userver/engine/stackless_task.hpp>
+
+#ifdef USERVER_IMPL_HAS_STACKLESS_TASKS
+
+#include <stdexcept>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/exception.hpp>
+#include <userver/engine/future.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace stackless = engine::stackless;
+
+namespace {
+
+constexpr auto kMaxTestWaitTime = std::chrono::seconds{10};
+
+stackless::Task<int> Answer() { co_return 42; }
+
+stackless::Task<int> AddOne(stackless::Task<int> task) {
+  co_return co_await std::move(task) + 1;
+}
+
+stackless::Task<int> AwaitTask(int value) {
+  auto task = engine::AsyncNoSpan([value] { return value; });
+  co_return co_await task;
+}
+
+stackless::Task<int> AwaitFuture(engine::Future<int>& future) {
+  co_return co_await future;
+}
+
+stackless::Task<std::size_t> SleepAndReturn(std::size_t value) {
+  co_await stackless::SleepFor(std::chrono::milliseconds{1});
+  co_return value;
+}
+
+stackless::Task<void> Throw() {
+  co_await stackless::SleepFor(std::chrono::milliseconds{1});
+  throw std::runtime_error("failure");
+}
+
+stackless::Task<engine::FutureStatus> WaitWithTimeout(
+    engine::Future<int>& future) {
+  co_return co_await stackless::WaitUntil(
+      future, engine::Deadline::FromDuration(std::chrono::milliseconds{10}));
+}
+
+stackless::Task<bool> AwaitUntilCancelled(engine::Future<int>& future) {
+  try {
+    co_await future;
+  } catch (const engine::WaitInterruptedException&) {
+    co_return true;
+  }
+  co_return false;
+}
+
+}  // namespace
+
+UTEST(StacklessTask, Simple) { EXPECT_EQ(stackless::Run(Answer()), 42); }
+
+UTEST(StacklessTask, Nested) {
+  EXPECT_EQ(stackless::Run(AddOne(AddOne(Answer()))), 44);
+}
+
+UTEST(StacklessTask, AwaitTask) { EXPECT_EQ(stackless::Run(AwaitTask(3)), 3); }
+
+UTEST(StacklessTask, AwaitFuture) {
+  engine::Promise<int> promise;
+  auto future = promise.get_future();
+
+  auto setter = engine::AsyncNoSpan([&promise] {
+    engine::Yield();
+    promise.set_value(5);
+  });
+  EXPECT_EQ(stackless::Run(AwaitFuture(future)), 5);
+  setter.Get();
+}
+
+UTEST(StacklessTask, FanOut) {
+  constexpr std::size_t kTasks = 1000;
+
+  std::vector<stackless::Task<std::size_t>> tasks;
+  tasks.reserve(kTasks);
+  for (std::size_t i = 0; i < kTasks; ++i) tasks.push_back(SleepAndReturn(i));
+
+  const auto results = stackless::RunAll(std::move(tasks));
+  ASSERT_EQ(results.size(), kTasks);
+  for (std::size_t i = 0; i < kTasks; ++i) EXPECT_EQ(results[i], i);
+}
+
+UTEST(StacklessTask, Exception) {
+  EXPECT_THROW(stackless::Run(Throw()), std::runtime_error);
+}
+
+UTEST(StacklessTask, WaitUntilTimeout) {
+  engine::Promise<int> promise;
+  auto future = promise.get_future();
+  EXPECT_EQ(stackless::Run(WaitWithTimeout(future)),
+            engine::FutureStatus::kTimeout);
+}
+
+UTEST(StacklessTask, Cancellation) {
+  engine::Promise<int> promise;
+  auto future = promise.get_future();
+
+  auto task = engine::AsyncNoSpan(
+      [&future] { return stackless::Run(AwaitUntilCancelled(future)); });
+  engine::Yield();
+  task.RequestCancel();
+
+  task.WaitFor(kMaxTestWaitTime);
+  ASSERT_TRUE(task.IsFinished());
+  EXPECT_TRUE(task.Get());
+}
+
+USERVER_NAMESPACE_END
+
+#else
+
+#include <gtest/gtest.h>
+
+// Keeps the lack of coverage visible in the test reports, the CI job with
+// CMAKE_CXX_STANDARD=20 runs the real tests
+TEST(StacklessTask, NotSupported) {
+  GTEST_SKIP() << "stackless tasks require C++20 coroutines support";
+}
+
+#endif  // USERVER_IMPL_HAS_STACKLESS_TASKS
@@ -1,13 +1,16 @@
 #include <userver/engine/subprocess/process_starter.hpp>
 
+#include <fcntl.h>
+#include <spawn.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <chrono>
 #include <csignal>
-#include <cstdio>
 #include <cstring>
-#include <iostream>
+#include <exception>
+#include <system_error>
 
 #include <fmt/format.h>
 #include <boost/algorithm/string.hpp>
@@ -15,7 +18,12 @@
 
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
-#include <utils/check_syscall.hpp>
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 #include <engine/ev/child_process_map.hpp>
 #include <engine/ev/thread_control.hpp>
@@ -25,26 +33,35 @@
 #include <userver/engine/task/cancel.hpp>
 
 #include <engine/subprocess/child_process_impl.hpp>
+#include <engine/subprocess/zygote.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::subprocess {
+namespace impl {
+
+struct ProcessStarterStatistics final {
+  using Percentile =
+      utils::statistics::Percentile<2048, unsigned int, 120, 10000>;
+
+  utils::statistics::RecentPeriod<Percentile, Percentile,
+                                  utils::datetime::SteadyClock>
+      start_timings;
+  utils::statistics::RateCounter started;
+  utils::statistics::RateCounter errors;
+};
+
+}  // namespace impl
+
 namespace {
 
-void DoExecve(const std::string& command, const std::vector<std::string>& args,
-              const EnvironmentVariables& env,
-              const std::optional<std::string>& stdout_file,
-              const std::optional<std::string>& stderr_file) {
-  if (stdout_file) {
-    if (!std::freopen(stdout_file->c_str(), "a", stdout)) {
-      utils::CheckSyscall(-1, "freopen stdout to {}", *stdout_file);
-    }
-  }
-  if (stderr_file) {
-    if (!std::freopen(stderr_file->c_str(), "a", stderr)) {
-      utils::CheckSyscall(-1, "freopen stderr to {}", *stdout_file);
-    }
-  }
+using SpawnResult = impl::Zygote::SpawnResult;
+
+SpawnResult PosixSpawn(const std::string& command,
+                       const std::vector<std::string>& args,
+                       const EnvironmentVariables& env,
+                       const std::optional<std::string>& stdout_file,
+                       const std::optional<std::string>& stderr_file) {
   std::vector<char*> argv_ptrs;
   std::vector<std::string> envp_buf;
   std::vector<char*> envp_ptrs;
@@ -67,15 +84,69 @@ void DoExecve(const std::string& command, const std::vector<std::string>& args,
   }
   envp_ptrs.push_back(nullptr);
 
-  utils::CheckSyscall(
-      execve(command.c_str(), argv_ptrs.data(), envp_ptrs.data()), "execve");
+  posix_spawn_file_actions_t file_actions;
+  if (const int error = ::posix_spawn_file_actions_init(&file_actions)) {
+    throw std::system_error(error, std::system_category(),
+                            "posix_spawn_file_actions_init");
+  }
+  utils::FastScopeGuard destroy_guard{[&file_actions]() noexcept {
+    ::posix_spawn_file_actions_destroy(&file_actions);
+  }};
+  const auto redirect = [&file_actions](const std::string& path, int fd) {
+    const int error = ::posix_spawn_file_actions_addopen(
+        &file_actions, fd, path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0666);
+    if (error) {
+      throw std::system_error(error, std::system_category(),
+                              "posix_spawn_file_actions_addopen " + path);
+    }
+  };
+  if (stdout_file) redirect(*stdout_file, STDOUT_FILENO);
+  if (stderr_file) redirect(*stderr_file, STDERR_FILENO);
+
+  // posix_spawn uses vfork-like clone, the page tables are not copied. The
+  // exec failures are reported by posix_spawn itself, the failed child is
+  // reaped by it.
+  pid_t pid = -1;
+  const int error =
+      ::posix_spawn(&pid, command.c_str(), &file_actions, nullptr,
+                    argv_ptrs.data(), envp_ptrs.data());
+  if (error) return {-1, error};
+  return {pid, 0};
 }
 
 }  // namespace
 
 ProcessStarter::ProcessStarter(TaskProcessor& task_processor)
+    : ProcessStarter(task_processor, ProcessStarterSettings{}) {}
+
+ProcessStarter::ProcessStarter(TaskProcessor& task_processor,
+                               const ProcessStarterSettings& settings)
     : thread_control_(
-          task_processor.EventThreadPool().GetEvDefaultLoopThread()) {}
+          task_processor.EventThreadPool().GetEvDefaultLoopThread()),
+      stats_(std::make_shared<impl::ProcessStarterStatistics>()) {
+  if (!settings.use_zygote) return;
+  if (!impl::Zygote::IsSupported()) {
+    LOG_WARNING() << "The zygote is not supported on this platform, the "
+                     "processes are started with posix_spawn()";
+    return;
+  }
+
+  std::exception_ptr exception;
+  thread_control_.RunInEvLoopBlocking([this, &exception] {
+    try {
+      auto zygote = std::make_shared<impl::Zygote>();
+      // The exit of the zygote is reported to the child watcher as well
+      ev::ChildProcessMapSet(
+          zygote->GetPid(),
+          ev::ChildProcessMapValue(Promise<ChildProcessStatus>{}));
+      zygote_ = std::move(zygote);
+    } catch (const std::exception&) {
+      exception = std::current_exception();
+    }
+  });
+  if (exception) std::rethrow_exception(exception);
+  LOG_INFO() << "Started the zygote process with pid=" << zygote_->GetPid();
+}
 
 ChildProcess ProcessStarter::Exec(
     const std::string& command, const std::vector<std::string>& args,
@@ -87,7 +158,9 @@ ChildProcess ProcessStarter::Exec(
   Promise<ChildProcess> promise;
   auto future = promise.get_future();
   thread_control_.RunInEvLoopAsync([&, promise = std::move(promise)]() mutable {
-    LOG_DEBUG() << "do fork() + execve(), command=" << command << ", args=["
+    LOG_DEBUG() << "starting a process"
+                << (zygote_ ? " with the zygote" : " with posix_spawn()")
+                << ", command=" << command << ", args=["
                 << (args.empty() ? "" : '\'' + boost::join(args, "' '") + '\'')
                 << "], env=["
                 << (env.empty()
@@ -99,37 +172,62 @@ ChildProcess ProcessStarter::Exec(
                                                 }),
                                       ", "))
                 << ']';
-    auto pid = utils::CheckSyscall(fork(), "fork");
-    if (pid) {
-      // in parent thread
-      span.AddTag("child-process-pid", pid);
-      LOG_DEBUG() << "Started child process with pid=" << pid;
-      Promise<ChildProcessStatus> exec_result_promise;
-      auto res = ChildProcessMapSet(
-          pid, ev::ChildProcessMapValue(std::move(exec_result_promise)));
-      if (res.second) {
-        promise.set_value(ChildProcess{
-            ChildProcessImpl{pid, res.first->status_promise.get_future()}});
-      } else {
-        std::string msg = "process with pid=" + std::to_string(pid) +
-                          " already exists in child_process_map";
-        LOG_ERROR() << msg << ", send SIGKILL";
-        ChildProcessImpl(pid, Future<ChildProcessStatus>{}).SendSignal(SIGKILL);
-        promise.set_exception(std::make_exception_ptr(std::runtime_error(msg)));
-      }
-    } else {
-      // in child thread
-      try {
+    const auto start = std::chrono::steady_clock::now();
+    SpawnResult result;
+    try {
+      std::optional<SpawnResult> zygote_result;
+      if (zygote_) {
         try {
-          DoExecve(command, args, env, stdout_file, stderr_file);
+          zygote_result =
+              zygote_->Spawn(command, args, env, stdout_file, stderr_file);
         } catch (const std::exception& ex) {
-          std::cerr << "Cannot execute child: " << ex.what();
+          LOG_LIMITED_ERROR() << "Failed to start a process with the zygote, "
+                                 "falling back to posix_spawn(): "
+                              << ex;
         }
-      } catch (...) {
-        // must not do anything in a child
       }
-      // on success execve does not return
-      std::abort();
+      result = zygote_result ? *zygote_result
+                             : PosixSpawn(command, args, env, stdout_file,
+                                          stderr_file);
+    } catch (const std::exception&) {
+      ++stats_->errors;
+      promise.set_exception(std::current_exception());
+      return;
+    }
+    stats_->start_timings.GetCurrentCounter().Account(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count());
+
+    const auto pid = result.pid;
+    if (result.error) {
+      ++stats_->errors;
+      if (pid > 0) {
+        // The child has failed after the fork and is to be reaped
+        ChildProcessMapSet(
+            pid, ev::ChildProcessMapValue(Promise<ChildProcessStatus>{}));
+      }
+      promise.set_exception(std::make_exception_ptr(std::system_error(
+          result.error, std::system_category(),
+          fmt::format("Failed to start '{}'", command))));
+      return;
+    }
+
+    ++stats_->started;
+    span.AddTag("child-process-pid", pid);
+    LOG_DEBUG() << "Started child process with pid=" << pid;
+    Promise<ChildProcessStatus> exec_result_promise;
+    auto res = ChildProcessMapSet(
+        pid, ev::ChildProcessMapValue(std::move(exec_result_promise)));
+    if (res.second) {
+      promise.set_value(ChildProcess{
+          ChildProcessImpl{pid, res.first->status_promise.get_future()}});
+    } else {
+      std::string msg = "process with pid=" + std::to_string(pid) +
+                        " already exists in child_process_map";
+      LOG_ERROR() << msg << ", send SIGKILL";
+      ChildProcessImpl(pid, Future<ChildProcessStatus>{}).SendSignal(SIGKILL);
+      promise.set_exception(std::make_exception_ptr(std::runtime_error(msg)));
     }
   });
 
@@ -156,6 +254,14 @@ ChildProcess ProcessStarter::Exec(
               stderr_file);
 }
 
+void DumpMetric(utils::statistics::Writer& writer,
+                const ProcessStarter& process_starter) {
+  const auto& stats = *process_starter.stats_;
+  writer["started"] = stats.started;
+  writer["errors"] = stats.errors;
+  writer["start-timings-us"] = stats.start_timings.GetStatsForPeriod();
+}
+
 }  // namespace engine::subprocess
 
 USERVER_NAMESPACE_END
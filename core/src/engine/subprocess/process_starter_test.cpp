@@ -5,6 +5,7 @@
 
 #include <chrono>
 #include <string>
+#include <system_error>
 #include <thread>
 #include <vector>
 
@@ -23,6 +24,7 @@
 #include <userver/engine/subprocess/process_starter.hpp>
 #include <userver/engine/task/task.hpp>
 #include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/fs/blocking/read.hpp>
 #include <userver/fs/blocking/temp_file.hpp>
 #include <userver/logging/format.hpp>
 #include <userver/logging/logger.hpp>
@@ -65,6 +67,58 @@ UTEST(Subprocess, False) {
   EXPECT_NE(0, status.GetExitCode());
 }
 
+UTEST(Subprocess, ExecFailure) {
+  engine::subprocess::ProcessStarter starter(
+      engine::current_task::GetTaskProcessor());
+
+  EXPECT_THROW(starter.Exec("/nonexistent/command", {}), std::system_error);
+  auto status = starter.Exec(kTestProgram, {"-n", "1"}).Get();
+  ASSERT_TRUE(status.IsExited());
+  EXPECT_EQ(0, status.GetExitCode());
+}
+
+UTEST(Subprocess, StdoutFile) {
+  const auto file = fs::blocking::TempFile::Create();
+  engine::subprocess::ProcessStarter starter(
+      engine::current_task::GetTaskProcessor());
+
+  auto status =
+      starter.Exec("/bin/sh", {"-c", "echo hello"}, file.GetPath()).Get();
+  ASSERT_TRUE(status.IsExited());
+  EXPECT_EQ(0, status.GetExitCode());
+  EXPECT_EQ(fs::blocking::ReadFileContents(file.GetPath()), "hello\n");
+}
+
+#ifdef __linux__
+UTEST(Subprocess, Zygote) {
+  const auto file = fs::blocking::TempFile::Create();
+  engine::subprocess::ProcessStarter starter(
+      engine::current_task::GetTaskProcessor(),
+      engine::subprocess::ProcessStarterSettings{/*use_zygote=*/true});
+
+  const auto status_true = starter.Exec(kTestProgram, {"-n", "1"}).Get();
+  ASSERT_TRUE(status_true.IsExited());
+  EXPECT_EQ(0, status_true.GetExitCode());
+
+  const auto status_false = starter.Exec(kTestProgram, {"-z", "1"}).Get();
+  ASSERT_TRUE(status_false.IsExited());
+  EXPECT_NE(0, status_false.GetExitCode());
+
+  const auto status_echo =
+      starter
+          .Exec("/bin/sh", {"-c", "echo \"$VALUE\""},
+                engine::subprocess::EnvironmentVariablesUpdate{
+                    {{"VALUE", "hello"}}},
+                file.GetPath())
+          .Get();
+  ASSERT_TRUE(status_echo.IsExited());
+  EXPECT_EQ(0, status_echo.GetExitCode());
+  EXPECT_EQ(fs::blocking::ReadFileContents(file.GetPath()), "hello\n");
+
+  EXPECT_THROW(starter.Exec("/nonexistent/command", {}), std::system_error);
+}
+#endif
+
 UTEST(Subprocess, CheckLogClosesFds) {
   auto file = fs::blocking::TempFile::Create("/tmp", kLogFilePart);
   auto logger = logging::MakeFileLogger("to_file", file.GetPath(),
@@ -0,0 +1,328 @@
+#include <engine/subprocess/zygote.hpp>
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::subprocess::impl {
+
+#ifdef __linux__
+namespace {
+
+constexpr std::size_t kMaxRequestSize = 128 * 1024;
+constexpr std::size_t kMaxStrings = 4096;
+constexpr rlim_t kMaxDescriptors = 1 << 20;
+
+// The request is followed by the NUL-terminated strings: stdout_file and
+// stderr_file if present, the command, the args and the "key=value" env
+struct RequestHeader final {
+  std::uint32_t args_count;
+  std::uint32_t env_count;
+  std::uint8_t has_stdout_file;
+  std::uint8_t has_stderr_file;
+};
+
+struct Response final {
+  int pid;
+  int error;
+};
+
+// Sent to the zygote from the intermediate process and from the child
+struct Report final {
+  enum Kind : int { kPid, kError };
+
+  int kind;
+  int value;
+};
+
+// The zygote is forked from a multithreaded process, so it and its children
+// use only the async-signal-safe functions and do not allocate memory.
+
+void WriteReport(int fd, Report report) noexcept {
+  while (::write(fd, &report, sizeof(report)) < 0 && errno == EINTR) {
+  }
+}
+
+// Returns errno of the failure or 0
+int Redirect(const char* path, int target_fd) noexcept {
+  if (!path) return 0;
+  const int fd = ::open(path, O_WRONLY | O_CREAT | O_APPEND, 0666);
+  if (fd < 0) return errno;
+  if (fd == target_fd) return 0;
+  const int error = ::dup2(fd, target_fd) < 0 ? errno : 0;
+  ::close(fd);
+  return error;
+}
+
+[[noreturn]] void ExecChild(char* const* argv, char* const* envp,
+                            const char* stdout_file, const char* stderr_file,
+                            int report_fd) noexcept {
+  int error = Redirect(stdout_file, STDOUT_FILENO);
+  if (!error) error = Redirect(stderr_file, STDERR_FILENO);
+  if (!error) {
+    ::execve(argv[0], argv, envp);
+    error = errno;
+  }
+  WriteReport(report_fd, {Report::kError, error});
+  ::_exit(127);
+}
+
+// `request` must be NUL-terminated past `size`, `strings` must hold
+// kMaxStrings + 2 pointers
+Response StartProcess(char* request, std::size_t size,
+                      char** strings) noexcept {
+  if (size < sizeof(RequestHeader)) return {-1, EINVAL};
+  RequestHeader header{};
+  std::memcpy(&header, request, sizeof(header));
+  if (std::size_t{header.args_count} + header.env_count + 1 > kMaxStrings) {
+    return {-1, E2BIG};
+  }
+
+  char* pos = request + sizeof(header);
+  char* const end = request + size;
+  const auto next = [&pos, end]() noexcept -> char* {
+    if (pos >= end) return nullptr;
+    char* const str = pos;
+    pos += std::strlen(str) + 1;
+    return str;
+  };
+
+  const char* stdout_file = header.has_stdout_file ? next() : nullptr;
+  const char* stderr_file = header.has_stderr_file ? next() : nullptr;
+  if ((header.has_stdout_file && !stdout_file) ||
+      (header.has_stderr_file && !stderr_file)) {
+    return {-1, EINVAL};
+  }
+
+  // argv is the command with the args, envp follows it
+  char** argv = strings;
+  for (std::size_t i = 0; i <= header.args_count; ++i) {
+    argv[i] = next();
+    if (!argv[i]) return {-1, EINVAL};
+  }
+  argv[header.args_count + 1] = nullptr;
+  char** envp = argv + header.args_count + 2;
+  for (std::size_t i = 0; i < header.env_count; ++i) {
+    envp[i] = next();
+    if (!envp[i]) return {-1, EINVAL};
+  }
+  envp[header.env_count] = nullptr;
+
+  int pipe_fds[2];
+  if (::pipe2(pipe_fds, O_CLOEXEC) != 0) return {-1, errno};
+
+  // The intermediate process exits right after the fork, so the child is
+  // reparented to the subreaper
+  const pid_t intermediate = ::fork();
+  if (intermediate < 0) {
+    const int error = errno;
+    ::close(pipe_fds[0]);
+    ::close(pipe_fds[1]);
+    return {-1, error};
+  }
+  if (intermediate == 0) {
+    ::close(pipe_fds[0]);
+    const pid_t child = ::fork();
+    if (child == 0) {
+      ExecChild(argv, envp, stdout_file, stderr_file, pipe_fds[1]);
+    }
+    WriteReport(pipe_fds[1], child < 0 ? Report{Report::kError, errno}
+                                       : Report{Report::kPid, child});
+    ::_exit(0);
+  }
+
+  ::close(pipe_fds[1]);
+  // The pipe is closed on the successful exec of the child or on its exit
+  Response response{-1, 0};
+  Report report{};
+  while (true) {
+    const auto read = ::read(pipe_fds[0], &report, sizeof(report));
+    if (read < 0 && errno == EINTR) continue;
+    if (read != sizeof(report)) break;
+    if (report.kind == Report::kPid) {
+      response.pid = report.value;
+    } else {
+      response.error = report.value;
+    }
+  }
+  ::close(pipe_fds[0]);
+  while (::waitpid(intermediate, nullptr, 0) < 0 && errno == EINTR) {
+  }
+  if (response.pid < 0 && !response.error) response.error = ECHILD;
+  return response;
+}
+
+void CloseDescriptorsExcept(int keep_fd, int max_fd) noexcept {
+#ifdef SYS_close_range
+  if ((keep_fd <= 3 || ::syscall(SYS_close_range, 3, keep_fd - 1, 0) == 0) &&
+      ::syscall(SYS_close_range, std::max(keep_fd + 1, 3), ~0U, 0) == 0) {
+    return;
+  }
+#endif
+  for (int fd = 3; fd < max_fd; ++fd) {
+    if (fd != keep_fd) ::close(fd);
+  }
+}
+
+void SetUpZygote(int socket, int max_fd) noexcept {
+  ::prctl(PR_SET_PDEATHSIG, SIGKILL);
+
+  // The handlers of the parent process must not run in the zygote
+  for (int signum = 1; signum < NSIG; ++signum) {
+    struct sigaction action {};
+    if (::sigaction(signum, nullptr, &action) != 0) continue;
+    if (action.sa_handler == SIG_DFL || action.sa_handler == SIG_IGN) continue;
+    action = {};
+    action.sa_handler = SIG_DFL;
+    ::sigaction(signum, &action, nullptr);
+  }
+  sigset_t mask;
+  ::sigemptyset(&mask);
+  ::sigprocmask(SIG_SETMASK, &mask, nullptr);
+
+  CloseDescriptorsExcept(socket, max_fd);
+}
+
+[[noreturn]] void RunZygote(int socket, char* buffer, char** strings) noexcept {
+  while (true) {
+    const auto size = ::recv(socket, buffer, kMaxRequestSize, 0);
+    if (size < 0 && errno == EINTR) continue;
+    // The parent has closed the socket or has died
+    if (size <= 0) ::_exit(0);
+
+    buffer[size] = '\0';
+    const auto response =
+        StartProcess(buffer, static_cast<std::size_t>(size), strings);
+    while (::send(socket, &response, sizeof(response), MSG_NOSIGNAL) < 0 &&
+           errno == EINTR) {
+    }
+  }
+}
+
+}  // namespace
+
+bool Zygote::IsSupported() noexcept { return true; }
+
+Zygote::Zygote() {
+  utils::CheckSyscall(::prctl(PR_SET_CHILD_SUBREAPER, 1),
+                      "prctl(PR_SET_CHILD_SUBREAPER)");
+
+  int fds[2];
+  utils::CheckSyscall(
+      ::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, fds),
+      "socketpair");
+
+  // The zygote must not allocate, so everything is allocated before the fork
+  std::vector<char> buffer(kMaxRequestSize + 1);
+  std::vector<char*> strings(kMaxStrings + 2);
+  rlimit limit{};
+  const int max_fd = static_cast<int>(
+      ::getrlimit(RLIMIT_NOFILE, &limit) == 0 &&
+              limit.rlim_cur != RLIM_INFINITY
+          ? std::min(limit.rlim_cur, kMaxDescriptors)
+          : kMaxDescriptors);
+
+  const pid_t pid = ::fork();
+  if (pid < 0) {
+    const int error = errno;
+    ::close(fds[0]);
+    ::close(fds[1]);
+    throw std::system_error(error, std::system_category(),
+                            "fork of the zygote");
+  }
+  if (pid == 0) {
+    SetUpZygote(fds[1], max_fd);
+    RunZygote(fds[1], buffer.data(), strings.data());
+  }
+
+  ::close(fds[1]);
+  socket_ = fds[0];
+  pid_ = pid;
+}
+
+Zygote::~Zygote() { ::close(socket_); }
+
+std::optional<Zygote::SpawnResult> Zygote::Spawn(
+    const std::string& command, const std::vector<std::string>& args,
+    const EnvironmentVariables& env,
+    const std::optional<std::string>& stdout_file,
+    const std::optional<std::string>& stderr_file) {
+  if (args.size() + env.size() + 1 > kMaxStrings) return std::nullopt;
+
+  const RequestHeader header{static_cast<std::uint32_t>(args.size()),
+                             static_cast<std::uint32_t>(env.size()),
+                             stdout_file.has_value(), stderr_file.has_value()};
+  std::string request;
+  request.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  const auto append = [&request](const std::string& str) {
+    request.append(str);
+    request.push_back('\0');
+  };
+  if (stdout_file) append(*stdout_file);
+  if (stderr_file) append(*stderr_file);
+  append(command);
+  for (const auto& arg : args) append(arg);
+  for (const auto& [key, value] : env) {
+    request.append(key).append(1, '=');
+    append(value);
+  }
+  if (request.size() > kMaxRequestSize) return std::nullopt;
+
+  ssize_t sent = -1;
+  do {
+    sent = ::send(socket_, request.data(), request.size(), MSG_NOSIGNAL);
+  } while (sent < 0 && errno == EINTR);
+  utils::CheckSyscall(sent, "sending a request to the zygote");
+
+  Response response{};
+  ssize_t received = -1;
+  do {
+    received = ::recv(socket_, &response, sizeof(response), 0);
+  } while (received < 0 && errno == EINTR);
+  utils::CheckSyscall(received, "receiving a response from the zygote");
+  if (received != sizeof(response)) {
+    throw std::system_error(ECONNRESET, std::system_category(),
+                            "the zygote has exited");
+  }
+  return SpawnResult{response.pid, response.error};
+}
+#else
+bool Zygote::IsSupported() noexcept { return false; }
+
+Zygote::Zygote() {
+  throw std::system_error(ENOTSUP, std::system_category(),
+                          "the zygote is supported on Linux only");
+}
+
+Zygote::~Zygote() = default;
+
+std::optional<Zygote::SpawnResult> Zygote::Spawn(
+    const std::string&, const std::vector<std::string>&,
+    const EnvironmentVariables&, const std::optional<std::string>&,
+    const std::optional<std::string>&) {
+  throw std::system_error(ENOTSUP, std::system_category(),
+                          "the zygote is supported on Linux only");
+}
+#endif
+
+}  // namespace engine::subprocess::impl
+
+USERVER_NAMESPACE_END
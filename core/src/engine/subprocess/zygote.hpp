@@ -0,0 +1,61 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/engine/subprocess/environment_variables.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::subprocess::impl {
+
+/// @brief A helper process that starts the child processes
+///
+/// The zygote forks an intermediate process for each request, which starts
+/// the child and exits right away. The child is then reparented to the
+/// current process, which is made a child subreaper, and is waited for by the
+/// ev child watcher as usual.
+///
+/// All the methods should be called from ev_default_loop's thread only.
+class Zygote final {
+ public:
+  /// Whether the zygote is supported by the platform
+  static bool IsSupported() noexcept;
+
+  /// @brief Forks the zygote
+  /// @throws std::system_error
+  Zygote();
+
+  /// Stops the zygote
+  ~Zygote();
+
+  Zygote(const Zygote&) = delete;
+  Zygote& operator=(const Zygote&) = delete;
+
+  int GetPid() const noexcept { return pid_; }
+
+  struct SpawnResult final {
+    /// -1 if the process was not forked
+    int pid{-1};
+    /// errno of the failed fork or exec
+    int error{0};
+  };
+
+  /// @brief Starts the process
+  /// @returns std::nullopt if the request is too large for the zygote
+  /// @throws std::system_error if the zygote is not available
+  std::optional<SpawnResult> Spawn(
+      const std::string& command, const std::vector<std::string>& args,
+      const EnvironmentVariables& env,
+      const std::optional<std::string>& stdout_file,
+      const std::optional<std::string>& stderr_file);
+
+ private:
+  int socket_{-1};
+  int pid_{-1};
+};
+
+}  // namespace engine::subprocess::impl
+
+USERVER_NAMESPACE_END
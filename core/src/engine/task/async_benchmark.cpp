@@ -2,10 +2,13 @@
 
 #include <array>
 #include <thread>
+#include <vector>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/impl/task_local_storage.hpp>
 #include <userver/engine/run_standalone.hpp>
+#include <userver/engine/stackless_task.hpp>
+#include <userver/engine/wait_all_checked.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/fixed_array.hpp>
 
@@ -99,4 +102,48 @@ void async_comparisons_coro_spanned(benchmark::State& state) {
 }
 BENCHMARK(async_comparisons_coro_spanned)->RangeMultiplier(2)->Range(1, 32);
 
+void async_fan_out_spanned(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto fan_out = static_cast<std::size_t>(state.range(0));
+    std::vector<engine::TaskWithResult<std::size_t>> tasks;
+    tasks.reserve(fan_out);
+
+    for ([[maybe_unused]] auto _ : state) {
+      for (std::size_t i = 0; i < fan_out; ++i) {
+        tasks.push_back(utils::Async("", [i] { return i; }));
+      }
+      engine::WaitAllChecked(tasks);
+      tasks.clear();
+    }
+  });
+}
+BENCHMARK(async_fan_out_spanned)->RangeMultiplier(4)->Range(1, 1024);
+
+#ifdef USERVER_IMPL_HAS_STACKLESS_TASKS
+namespace {
+
+engine::stackless::Task<std::size_t> StacklessIdentity(std::size_t value) {
+  co_return value;
+}
+
+}  // namespace
+
+void async_fan_out_stackless(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto fan_out = static_cast<std::size_t>(state.range(0));
+    std::vector<engine::stackless::Task<std::size_t>> tasks;
+
+    for ([[maybe_unused]] auto _ : state) {
+      tasks.reserve(fan_out);
+      for (std::size_t i = 0; i < fan_out; ++i) {
+        tasks.push_back(StacklessIdentity(i));
+      }
+      benchmark::DoNotOptimize(engine::stackless::RunAll(std::move(tasks)));
+      tasks.clear();
+    }
+  });
+}
+BENCHMARK(async_fan_out_stackless)->RangeMultiplier(4)->Range(1, 1024);
+#endif
+
 USERVER_NAMESPACE_END
@@ -64,27 +64,20 @@ class ContextTimer::Impl final : public TimerArmer<Impl>,
  private:
   void StopTimerInEvThread() noexcept;
 
-  static void OnTimer(struct ev_loop*, ev_timer* w, int) noexcept;
+  static void OnTimer(void* data) noexcept;
   static void InvokeTimerFunction(const Params& params, TaskContext& context);
   void DoOnTimer();
 
   boost::intrusive_ptr<TaskContext> context_;
   ev::TimerThreadControl* thread_control_ = nullptr;
   Params params_;
-  ev_timer timer_{};
+  ev::TimerWheel::Entry timer_{&OnTimer, this};
   ev::DataPipeToEv<Params> params_pipe_to_ev_;
 };
 
-ContextTimer::Impl::Impl() {
-  timer_.data = this;
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
-  ev_init(&timer_, OnTimer);
-}
+ContextTimer::Impl::Impl() = default;
 
-ContextTimer::Impl::~Impl() {
-  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
-  UASSERT(!ev_is_active(&timer_));
-}
+ContextTimer::Impl::~Impl() { UASSERT(!timer_.IsScheduled()); }
 
 bool ContextTimer::Impl::WasStarted() const noexcept {
   return context_ && thread_control_;
@@ -136,21 +129,21 @@ void ContextTimer::Impl::DoArmTimerInEvThread() {
 
   params_ = std::move(*params);
 
-  using LibEvDuration = std::chrono::duration<double>;
-  const auto time_left =
-      std::chrono::duration_cast<LibEvDuration>(params_.deadline.TimeLeft())
-          .count();
+  const auto time_left = params_.deadline.TimeLeft();
 
-  LOG_TRACE() << "time_left=" << time_left;
-  if (time_left <= 0.0) {
+  LOG_TRACE() << "time_left="
+              << std::chrono::duration_cast<std::chrono::microseconds>(
+                     time_left)
+                     .count()
+              << "us";
+  if (time_left <= Deadline::Duration::zero()) {
     // Optimization for small deadlines or high load
     DoOnTimer();
     return;
   }
 
-  timer_.repeat = time_left;
   UASSERT(thread_control_);
-  thread_control_->Again(timer_);
+  thread_control_->Start(timer_, Deadline::Clock::now() + time_left);
 }
 
 void ContextTimer::Impl::InvokeTimerFunction(const Params& params,
@@ -185,12 +178,12 @@ void ContextTimer::Impl::DoFinalizeInEvThread() {
   // ContextTimer may be destroyed at this point
 }
 
-void ContextTimer::Impl::OnTimer(struct ev_loop*, ev_timer* w, int) noexcept {
+void ContextTimer::Impl::OnTimer(void* data) noexcept {
   UASSERT(!engine::current_task::IsTaskProcessorThread());
 
-  auto* ev_timer = static_cast<Impl*>(w->data);
-  UASSERT(ev_timer != nullptr);
-  ev_timer->DoOnTimer();
+  auto* timer = static_cast<Impl*>(data);
+  UASSERT(timer != nullptr);
+  timer->DoOnTimer();
 }
 
 void ContextTimer::Impl::DoOnTimer() {
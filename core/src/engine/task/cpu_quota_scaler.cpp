@@ -0,0 +1,89 @@
+#include <engine/task/cpu_quota_scaler.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+#include <engine/task/task_processor.hpp>
+#include <userver/hostinfo/blocking/cgroup_cpu.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/thread_name.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+void UpdateCpuQuotaWorkersState(CpuQuotaWorkersState& state,
+                                std::size_t max_workers,
+                                std::optional<double> quota,
+                                bool was_throttled) {
+  const auto quota_workers =
+      quota ? static_cast<std::size_t>(std::ceil(*quota)) : max_workers;
+  const auto target = std::clamp<std::size_t>(quota_workers, 1, max_workers);
+
+  if (was_throttled) {
+    state.calm_intervals = 0;
+    if (state.active_workers > 1) --state.active_workers;
+  } else if (state.active_workers < target) {
+    if (++state.calm_intervals >= CpuQuotaWorkersState::kCalmIntervalsToGrow) {
+      state.calm_intervals = 0;
+      ++state.active_workers;
+    }
+  }
+  // A lowered quota applies at once
+  state.active_workers =
+      std::clamp<std::size_t>(state.active_workers, 1, target);
+}
+
+CpuQuotaWorkersScaler::CpuQuotaWorkersScaler(
+    std::vector<TaskProcessor*> task_processors,
+    std::chrono::milliseconds interval)
+    : interval_(interval),
+      task_processors_(std::move(task_processors)),
+      thread_([this] { Run(); }) {}
+
+CpuQuotaWorkersScaler::~CpuQuotaWorkersScaler() {
+  {
+    const std::lock_guard lock{mutex_};
+    is_stopped_ = true;
+  }
+  cv_.notify_one();
+  thread_.join();
+}
+
+void CpuQuotaWorkersScaler::Run() {
+  utils::SetCurrentThreadName("cpu-quota");
+  for (auto* task_processor : task_processors_) {
+    states_.push_back({task_processor->GetWorkerCount()});
+  }
+
+  std::unique_lock lock{mutex_};
+  do {
+    Update();
+  } while (!cv_.wait_for(lock, interval_, [this] { return is_stopped_; }));
+}
+
+void CpuQuotaWorkersScaler::Update() noexcept {
+  std::optional<hostinfo::blocking::CgroupCpuStats> stats;
+  try {
+    stats = hostinfo::blocking::ReadCgroupCpuStats();
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_ERROR() << "Failed to read the cgroup CPU stats: " << ex;
+    return;
+  }
+  if (!stats) return;
+
+  const bool was_throttled =
+      last_nr_throttled_ && stats->nr_throttled > *last_nr_throttled_;
+  last_nr_throttled_ = stats->nr_throttled;
+
+  for (std::size_t i = 0; i < task_processors_.size(); ++i) {
+    auto& task_processor = *task_processors_[i];
+    UpdateCpuQuotaWorkersState(states_[i], task_processor.GetWorkerCount(),
+                               stats->quota, was_throttled);
+    task_processor.SetActiveWorkerCount(states_[i].active_workers);
+  }
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
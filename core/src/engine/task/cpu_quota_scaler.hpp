@@ -0,0 +1,71 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+class TaskProcessor;
+
+namespace impl {
+
+// The count of the active workers starts at the count allowed by the quota.
+// Each interval with throttling parks one more worker. The worker is
+// unparked after kCalmIntervalsToGrow intervals without throttling.
+struct CpuQuotaWorkersState {
+  static constexpr std::size_t kCalmIntervalsToGrow = 10;
+
+  std::size_t active_workers;
+  std::size_t calm_intervals{0};
+};
+
+void UpdateCpuQuotaWorkersState(CpuQuotaWorkersState& state,
+                                std::size_t max_workers,
+                                std::optional<double> quota,
+                                bool was_throttled);
+
+// Adjusts the active worker count of the task processors to the cgroup v2 CPU
+// quota from a dedicated thread, as the cgroup files are read with blocking
+// calls
+class CpuQuotaWorkersScaler final {
+ public:
+  static constexpr std::chrono::seconds kDefaultInterval{1};
+
+  explicit CpuQuotaWorkersScaler(
+      std::vector<TaskProcessor*> task_processors,
+      std::chrono::milliseconds interval = kDefaultInterval);
+
+  CpuQuotaWorkersScaler(CpuQuotaWorkersScaler&&) = delete;
+  CpuQuotaWorkersScaler& operator=(CpuQuotaWorkersScaler&&) = delete;
+
+  ~CpuQuotaWorkersScaler();
+
+ private:
+  void Run();
+  void Update() noexcept;
+
+  const std::chrono::milliseconds interval_;
+  std::vector<TaskProcessor*> task_processors_;
+  std::vector<CpuQuotaWorkersState> states_;
+  std::optional<std::uint64_t> last_nr_throttled_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool is_stopped_{false};
+  // Must be the last, uses the fields above
+  std::thread thread_;
+};
+
+}  // namespace impl
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,80 @@
+#include <engine/task/cpu_quota_scaler.hpp>
+
+#include <vector>
+
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using engine::impl::CpuQuotaWorkersState;
+using engine::impl::UpdateCpuQuotaWorkersState;
+
+constexpr std::size_t kMaxWorkers = 8;
+
+}  // namespace
+
+TEST(CpuQuotaWorkersScaler, FollowsQuota) {
+  CpuQuotaWorkersState state{kMaxWorkers};
+
+  UpdateCpuQuotaWorkersState(state, kMaxWorkers, 2.5, false);
+  EXPECT_EQ(state.active_workers, 3);
+
+  UpdateCpuQuotaWorkersState(state, kMaxWorkers, 0.1, false);
+  EXPECT_EQ(state.active_workers, 1);
+
+  // The workers are added back slowly
+  for (std::size_t i = 1; i < CpuQuotaWorkersState::kCalmIntervalsToGrow;
+       ++i) {
+    UpdateCpuQuotaWorkersState(state, kMaxWorkers, 4, false);
+    EXPECT_EQ(state.active_workers, 1);
+  }
+  UpdateCpuQuotaWorkersState(state, kMaxWorkers, 4, false);
+  EXPECT_EQ(state.active_workers, 2);
+}
+
+TEST(CpuQuotaWorkersScaler, Throttling) {
+  CpuQuotaWorkersState state{kMaxWorkers};
+
+  UpdateCpuQuotaWorkersState(state, kMaxWorkers, std::nullopt, false);
+  EXPECT_EQ(state.active_workers, kMaxWorkers);
+
+  UpdateCpuQuotaWorkersState(state, kMaxWorkers, std::nullopt, true);
+  EXPECT_EQ(state.active_workers, kMaxWorkers - 1);
+
+  for (std::size_t i = 0; i < 2 * kMaxWorkers; ++i) {
+    UpdateCpuQuotaWorkersState(state, kMaxWorkers, std::nullopt, true);
+  }
+  EXPECT_EQ(state.active_workers, 1);
+}
+
+UTEST(CpuQuotaWorkersScaler, ParkedWorkers) {
+  engine::TaskProcessorConfig config;
+  config.name = "parked-workers-task-processor";
+  config.worker_threads = 4;
+  config.thread_name = "parked-worker";
+  engine::TaskProcessor tp(
+      config, engine::current_task::GetTaskProcessor().GetTaskProcessorPools());
+
+  tp.SetActiveWorkerCount(0);
+  EXPECT_EQ(tp.GetActiveWorkerCount(), 1);
+
+  std::vector<engine::TaskWithResult<int>> tasks;
+  for (int i = 0; i < 100; ++i) {
+    tasks.push_back(engine::AsyncNoSpan(tp, [i] { return i; }));
+  }
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(tasks[i].Get(), i);
+
+  tp.SetActiveWorkerCount(100);
+  EXPECT_EQ(tp.GetActiveWorkerCount(), 4);
+
+  // The task processor stops with the parked workers
+  tp.SetActiveWorkerCount(2);
+}
+
+USERVER_NAMESPACE_END
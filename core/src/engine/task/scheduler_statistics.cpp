@@ -0,0 +1,162 @@
+#include <engine/task/scheduler_statistics.hpp>
+
+#include <array>
+
+#include <userver/compiler/thread_local.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/rate.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+namespace {
+
+// In microseconds
+constexpr std::array<double, 18> kBounds{
+    5,    10,    25,    50,    100,    250,    500,    1000,    2500,
+    5000, 10000, 25000, 50000, 100000, 250000, 500000, 1000000, 2500000};
+
+// Protects from unbounded memory growth if span names are generated
+// dynamically
+constexpr std::size_t kMaxSampledSpans = 256;
+constexpr std::string_view kOtherSpans = "other";
+constexpr std::string_view kNoSpan = "no-span";
+
+double ToMicroseconds(SchedulerStatistics::Duration duration) noexcept {
+  return std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(
+             duration)
+      .count();
+}
+
+void AccountBySpan(std::unordered_map<std::string, std::uint64_t>& values,
+                   std::string_view span_name, std::uint64_t value) {
+  if (span_name.empty()) span_name = kNoSpan;
+  auto it = values.find(std::string{span_name});
+  if (it == values.end()) {
+    if (values.size() >= kMaxSampledSpans) span_name = kOtherSpans;
+    it = values.emplace(span_name, 0).first;
+  }
+  it->second += value;
+}
+
+struct LocalSchedulerStatisticsData final {
+  SchedulerStatistics* statistics{nullptr};
+  std::size_t task_processor_thread_index{};
+};
+
+compiler::ThreadLocal local_scheduler_statistics_data = [] {
+  return LocalSchedulerStatisticsData{};
+};
+
+}  // namespace
+
+SchedulerStatistics::LocalData::LocalData()
+    : queue_wait(kBounds), time_slices(kBounds), task_cpu(kBounds) {}
+
+SchedulerStatistics::SchedulerStatistics(std::size_t thread_count,
+                                         std::size_t cpu_sampling_every)
+    : local_(thread_count), cpu_sampling_every_(cpu_sampling_every) {}
+
+void SchedulerStatistics::AccountQueueWait(Duration duration) noexcept {
+  GetLocalData().queue_wait.Account(ToMicroseconds(duration));
+}
+
+void SchedulerStatistics::AccountTimeSlice(Duration duration) noexcept {
+  GetLocalData().time_slices.Account(ToMicroseconds(duration));
+}
+
+void SchedulerStatistics::AccountTaskCpu(Duration duration) noexcept {
+  GetLocalData().task_cpu.Account(ToMicroseconds(duration));
+}
+
+bool SchedulerStatistics::ShouldSampleCpu() noexcept {
+  if (cpu_sampling_every_ == 0) return false;
+  auto& started_tasks = GetLocalData().started_tasks;
+  if (++started_tasks < cpu_sampling_every_) return false;
+  started_tasks = 0;
+  return true;
+}
+
+void SchedulerStatistics::AccountSampledCpu(std::string_view span_name,
+                                            Duration duration) {
+  const auto duration_us =
+      std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+
+  const std::lock_guard lock(by_span_mutex_);
+  AccountBySpan(sampled_cpu_us_, span_name, duration_us);
+}
+
+void SchedulerStatistics::AccountLongSlice(std::string_view span_name) {
+  const std::lock_guard lock(by_span_mutex_);
+  AccountBySpan(long_slices_, span_name, 1);
+}
+
+utils::statistics::HistogramAggregator SchedulerStatistics::GetQueueWait()
+    const {
+  return Aggregate(&LocalData::queue_wait);
+}
+
+utils::statistics::HistogramAggregator SchedulerStatistics::GetTimeSlices()
+    const {
+  return Aggregate(&LocalData::time_slices);
+}
+
+utils::statistics::HistogramAggregator SchedulerStatistics::GetTaskCpu()
+    const {
+  return Aggregate(&LocalData::task_cpu);
+}
+
+std::unordered_map<std::string, std::uint64_t>
+SchedulerStatistics::GetSampledCpu() const {
+  const std::lock_guard lock(by_span_mutex_);
+  return sampled_cpu_us_;
+}
+
+std::unordered_map<std::string, std::uint64_t>
+SchedulerStatistics::GetLongSlices() const {
+  const std::lock_guard lock(by_span_mutex_);
+  return long_slices_;
+}
+
+SchedulerStatistics::LocalData& SchedulerStatistics::GetLocalData() noexcept {
+  auto local_data = local_scheduler_statistics_data.Use();
+  UASSERT(local_data->statistics == this);
+  return *local_[local_data->task_processor_thread_index];
+}
+
+utils::statistics::HistogramAggregator SchedulerStatistics::Aggregate(
+    Histogram LocalData::*histogram) const {
+  utils::statistics::HistogramAggregator result(kBounds);
+  for (const auto& local_data : local_) {
+    result.Add(((*local_data).*histogram).GetView());
+  }
+  return result;
+}
+
+void SetLocalSchedulerStatistics(SchedulerStatistics& statistics,
+                                 std::size_t thread_id) {
+  auto local_data = local_scheduler_statistics_data.Use();
+  *local_data = {&statistics, thread_id};
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const SchedulerStatistics& statistics) {
+  writer["queue-wait-us"] = statistics.GetQueueWait();
+  writer["time-slice-us"] = statistics.GetTimeSlices();
+  writer["task-cpu-us"] = statistics.GetTaskCpu();
+
+  for (const auto& [span_name, cpu_us] : statistics.GetSampledCpu()) {
+    writer["sampled-cpu-us"].ValueWithLabels(
+        utils::statistics::Rate{cpu_us}, {{"span_name", span_name}});
+  }
+  for (const auto& [span_name, count] : statistics.GetLongSlices()) {
+    writer["long-slices"].ValueWithLabels(utils::statistics::Rate{count},
+                                          {{"span_name", span_name}});
+  }
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/histogram.hpp>
+#include <userver/utils/statistics/histogram_aggregator.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+/// Scheduling latency histograms of a single TaskProcessor. Histograms are
+/// sharded by worker threads and are summed up on statistics dump.
+class SchedulerStatistics final {
+ public:
+  using Duration = std::chrono::steady_clock::duration;
+
+  /// @param cpu_sampling_every attribute CPU time of each Nth task to its
+  /// root tracing::Span name, 0 disables the sampling
+  SchedulerStatistics(std::size_t thread_count,
+                      std::size_t cpu_sampling_every);
+
+  // The following functions may only be called from the worker threads of
+  // the bound TaskProcessor.
+
+  /// Time from the task push to the task queue until the task start
+  void AccountQueueWait(Duration duration) noexcept;
+
+  /// Time the task was running between context switches
+  void AccountTimeSlice(Duration duration) noexcept;
+
+  /// Total CPU time of the finished task
+  void AccountTaskCpu(Duration duration) noexcept;
+
+  /// @returns true if the CPU time of a task that is being started should be
+  /// attributed to its span name
+  bool ShouldSampleCpu() noexcept;
+
+  void AccountSampledCpu(std::string_view span_name, Duration duration);
+
+  // The following functions may be called from any thread.
+
+  /// A task step of the span that has been running for longer than the
+  /// watchdog threshold
+  void AccountLongSlice(std::string_view span_name);
+
+  utils::statistics::HistogramAggregator GetQueueWait() const;
+
+  utils::statistics::HistogramAggregator GetTimeSlices() const;
+
+  utils::statistics::HistogramAggregator GetTaskCpu() const;
+
+  /// Sampled CPU time by span name, in microseconds
+  std::unordered_map<std::string, std::uint64_t> GetSampledCpu() const;
+
+  /// Long task steps by span name
+  std::unordered_map<std::string, std::uint64_t> GetLongSlices() const;
+
+ private:
+  struct LocalData final {
+    LocalData();
+
+    utils::statistics::Histogram queue_wait;
+    utils::statistics::Histogram time_slices;
+    utils::statistics::Histogram task_cpu;
+    std::size_t started_tasks{0};
+  };
+
+  using Histogram = utils::statistics::Histogram;
+
+  LocalData& GetLocalData() noexcept;
+
+  utils::statistics::HistogramAggregator Aggregate(
+      Histogram LocalData::*histogram) const;
+
+  utils::FixedArray<concurrent::impl::InterferenceShield<LocalData>> local_;
+  const std::size_t cpu_sampling_every_;
+
+  mutable std::mutex by_span_mutex_;
+  std::unordered_map<std::string, std::uint64_t> sampled_cpu_us_;
+  std::unordered_map<std::string, std::uint64_t> long_slices_;
+};
+
+void SetLocalSchedulerStatistics(SchedulerStatistics& statistics,
+                                 std::size_t thread_id);
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const SchedulerStatistics& statistics);
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,77 @@
+#include <engine/task/scheduler_statistics.hpp>
+
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+engine::TaskProcessorConfig MakeConfig(std::size_t cpu_sampling_every) {
+  engine::TaskProcessorConfig config;
+  config.name = "scheduler-statistics-task-processor";
+  config.worker_threads = 2;
+  config.thread_name = "sched-worker";
+  config.cpu_sampling_every = cpu_sampling_every;
+  return config;
+}
+
+std::uint64_t GetTotalCount(utils::statistics::HistogramView histogram) {
+  std::uint64_t result = histogram.GetValueAtInf();
+  for (std::size_t i = 0; i < histogram.GetBucketCount(); ++i) {
+    result += histogram.GetValueAt(i);
+  }
+  return result;
+}
+
+}  // namespace
+
+UTEST(SchedulerStatistics, Histograms) {
+  engine::TaskProcessor tp(
+      MakeConfig(0),
+      engine::current_task::GetTaskProcessor().GetTaskProcessorPools());
+  constexpr std::size_t kTasks = 20;
+
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    engine::AsyncNoSpan(tp, [] {
+      engine::SleepFor(std::chrono::milliseconds{1});
+    }).Get();
+  }
+
+  const auto& statistics = tp.GetSchedulerStatistics();
+  const auto time_slices = statistics.GetTimeSlices();
+  const auto task_cpu = statistics.GetTaskCpu();
+  const auto queue_wait = statistics.GetQueueWait();
+
+  // Each task has at least 2 time slices: before and after the sleep
+  EXPECT_GE(GetTotalCount(time_slices.GetView()), 2 * kTasks);
+  EXPECT_EQ(GetTotalCount(task_cpu.GetView()), kTasks);
+  // Queue wait time is only measured for some of the tasks
+  EXPECT_GT(GetTotalCount(queue_wait.GetView()), 0);
+  EXPECT_TRUE(statistics.GetSampledCpu().empty());
+}
+
+UTEST(SchedulerStatistics, SampledCpu) {
+  engine::TaskProcessor tp(
+      MakeConfig(1),
+      engine::current_task::GetTaskProcessor().GetTaskProcessorPools());
+
+  engine::AsyncNoSpan(tp, [] {
+    tracing::Span span{"cpu-hog"};
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds{2};
+    while (std::chrono::steady_clock::now() < deadline) {
+    }
+  }).Get();
+
+  const auto sampled = tp.GetSchedulerStatistics().GetSampledCpu();
+  const auto it = sampled.find("cpu-hog");
+  ASSERT_NE(it, sampled.end());
+  EXPECT_GE(it->second, 1000);
+}
+
+USERVER_NAMESPACE_END
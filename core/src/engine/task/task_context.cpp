@@ -1,8 +1,12 @@
 #include "task_context.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <exception>
 #include <utility>
 
+#include <time.h>
+
 #include <fmt/format.h>
 #include <boost/exception/diagnostic_information.hpp>
 
@@ -104,15 +108,24 @@ constexpr SleepState MakeNextEpochSleepState(SleepState::Epoch current) {
 auto* const kFinishedDetachedToken =
     reinterpret_cast<DetachedTasksSyncBlock::Token*>(1);
 
+auto* const kFinishedListener = reinterpret_cast<TaskFinishListener*>(1);
+
+std::chrono::nanoseconds GetThreadCpuTime() noexcept {
+  timespec ts{};
+  if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return {};
+  return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+}
+
 }  // namespace
 
 TaskContext::TaskContext(TaskProcessor& task_processor,
-                         Task::Importance importance, Task::WaitMode wait_type,
-                         Deadline deadline,
+                         Task::Importance importance, Task::Priority priority,
+                         Task::WaitMode wait_type, Deadline deadline,
                          utils::impl::WrappedCallBase& payload)
     : task_processor_(task_processor),
       task_counter_token_(task_processor_.GetTaskCounter()),
       is_critical_(importance == Task::Importance::kCritical),
+      priority_(priority),
       payload_(&payload),
       finish_waiters_(wait_type),
       cancel_deadline_(deadline),
@@ -173,6 +186,21 @@ void TaskContext::FinishDetached() noexcept {
   }
 }
 
+bool TaskContext::SetFinishListener(TaskFinishListener& listener) noexcept {
+  TaskFinishListener* expected = nullptr;
+  if (finish_listener_.compare_exchange_strong(expected, &listener)) {
+    return true;
+  }
+  UASSERT_MSG(expected == kFinishedListener,
+              "The task already has a finish listener");
+  return false;
+}
+
+void TaskContext::NotifyFinishListener() noexcept {
+  auto* const listener = finish_listener_.exchange(kFinishedListener);
+  if (listener != nullptr) listener->OnTaskFinished();
+}
+
 void TaskContext::Wait() const { WaitUntil({}); }
 
 namespace {
@@ -255,6 +283,9 @@ void TaskContext::DoStep() {
           TaskCancellationReason::kNone) {
         GetTaskProcessor().GetTaskCounter().AccountTaskCancel();
       }
+      // Before the state change, so that the listener outlives the
+      // notification as long as the task is waited for before its destruction
+      NotifyFinishListener();
       SetState(new_state);
       deadline_timer_.Finalize();
       finish_waiters_->WakeupAll();
@@ -505,6 +536,8 @@ void TaskContext::CoroFunc(TaskPipe& task_pipe) {
     context->TsanReleaseBarrier();
     context->yield_reason_ = YieldReason::kNone;
     context->task_pipe_ = &task_pipe;
+    context->is_cpu_sampled_ =
+        context->task_processor_.GetSchedulerStatistics().ShouldSampleCpu();
 
     context->ProfilerStartExecution();
 
@@ -542,6 +575,7 @@ void TaskContext::CoroFunc(TaskPipe& task_pipe) {
     }
 
     context->ProfilerStopExecution();
+    context->AccountTaskCpu();
 
     context->task_pipe_ = nullptr;
     context->TsanAcquireBarrier();
@@ -685,25 +719,21 @@ void TaskContext::Schedule() {
 }
 
 void TaskContext::ProfilerStartExecution() {
-  auto threshold_us = task_processor_.GetProfilerThreshold();
-  if (threshold_us.count() > 0) {
-    execute_started_ = std::chrono::steady_clock::now();
-  } else {
-    execute_started_ = {};
-  }
+  execute_started_ = std::chrono::steady_clock::now();
+  if (is_thread_cpu_accounted_) thread_cpu_started_ = GetThreadCpuTime();
 }
 
 void TaskContext::ProfilerStopExecution() {
+  const auto duration = std::chrono::steady_clock::now() - execute_started_;
+  cpu_time_ += duration;
+  if (is_thread_cpu_accounted_) {
+    thread_cpu_time_ += GetThreadCpuTime() - thread_cpu_started_;
+  }
+  task_processor_.GetSchedulerStatistics().AccountTimeSlice(duration);
+
   auto threshold_us = task_processor_.GetProfilerThreshold();
   if (threshold_us.count() <= 0) return;
 
-  if (execute_started_ == std::chrono::steady_clock::time_point{}) {
-    // the task was started w/o profiling, skip it
-    return;
-  }
-
-  auto now = std::chrono::steady_clock::now();
-  auto duration = now - execute_started_;
   auto duration_us =
       std::chrono::duration_cast<std::chrono::microseconds>(duration);
 
@@ -719,6 +749,67 @@ void TaskContext::ProfilerStopExecution() {
   }
 }
 
+void TaskContext::AccountSampledCpu(std::string_view span_name) {
+  UASSERT(IsCurrent());
+  if (!is_cpu_sampled_) return;
+
+  const auto cpu_time =
+      cpu_time_ + (std::chrono::steady_clock::now() - execute_started_);
+  task_processor_.GetSchedulerStatistics().AccountSampledCpu(
+      span_name, cpu_time - sampled_cpu_time_);
+  sampled_cpu_time_ = cpu_time;
+}
+
+void TaskContext::SetProfilerSpanName(std::string_view span_name) noexcept {
+  UASSERT(IsCurrent());
+  const auto size = std::min(span_name.size(), kMaxProfilerSpanName);
+  // A concurrent reader is the signal handler on this thread, a torn name
+  // is acceptable there, but the size should never exceed the copied bytes
+  profiler_span_name_size_ = 0;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  std::copy_n(span_name.data(), size, profiler_span_name_);
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+  profiler_span_name_size_ = static_cast<std::uint8_t>(size);
+}
+
+std::string_view TaskContext::GetProfilerSpanName() const noexcept {
+  return {profiler_span_name_, profiler_span_name_size_};
+}
+
+std::chrono::steady_clock::duration TaskContext::GetCurrentSliceDuration()
+    const noexcept {
+  UASSERT(IsCurrent());
+  return std::chrono::steady_clock::now() - execute_started_;
+}
+
+void TaskContext::EnableThreadCpuAccounting() noexcept {
+  UASSERT(IsCurrent());
+  if (is_thread_cpu_accounted_) return;
+  is_thread_cpu_accounted_ = true;
+  thread_cpu_started_ = GetThreadCpuTime();
+}
+
+TaskContext::ThreadTimes TaskContext::GetThreadTimes() const noexcept {
+  UASSERT(IsCurrent());
+  ThreadTimes result;
+  result.on_thread =
+      cpu_time_ + (std::chrono::steady_clock::now() - execute_started_);
+  if (is_thread_cpu_accounted_) {
+    result.thread_cpu =
+        thread_cpu_time_ + (GetThreadCpuTime() - thread_cpu_started_);
+  }
+  return result;
+}
+
+void TaskContext::AccountTaskCpu() {
+  auto& statistics = task_processor_.GetSchedulerStatistics();
+  statistics.AccountTaskCpu(cpu_time_);
+  if (is_cpu_sampled_) {
+    // CPU time that was spent outside of the root spans
+    statistics.AccountSampledCpu({}, cpu_time_ - sampled_cpu_time_);
+  }
+}
+
 void TaskContext::TraceStateTransition(Task::State state) {
   if (trace_csw_left_ == 0) return;
   --trace_csw_left_;
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include <ev.h>
@@ -61,6 +63,15 @@ class WaitStrategy {
   const Deadline deadline_;
 };
 
+// Notified by a task right before it becomes finished
+class TaskFinishListener {
+ public:
+  virtual void OnTaskFinished() noexcept = 0;
+
+ protected:
+  ~TaskFinishListener() = default;
+};
+
 class TaskContext final : public ContextAccessor {
  public:
   struct NoEpoch {};
@@ -78,8 +89,8 @@ class TaskContext final : public ContextAccessor {
     kBootstrap = static_cast<uint32_t>(SleepFlags::kWakeupByBootstrap),
   };
 
-  TaskContext(TaskProcessor&, Task::Importance, Task::WaitMode, Deadline,
-              utils::impl::WrappedCallBase& payload);
+  TaskContext(TaskProcessor&, Task::Importance, Task::Priority,
+              Task::WaitMode, Deadline, utils::impl::WrappedCallBase& payload);
 
   ~TaskContext() noexcept;
 
@@ -100,6 +111,9 @@ class TaskContext final : public ContextAccessor {
   // exceeding these limits causes task to become cancelled
   bool IsCritical() const;
 
+  // task processor queue lane of the task
+  Task::Priority GetPriority() const noexcept { return priority_; }
+
   // whether task is allowed to be awaited from multiple coroutines
   // simultaneously
   bool IsSharedWaitAllowed() const;
@@ -113,6 +127,10 @@ class TaskContext final : public ContextAccessor {
   void SetDetached(DetachedTasksSyncBlock::Token& token) noexcept;
   void FinishDetached() noexcept;
 
+  // Only one listener may be set. Returns false if the task is already
+  // finished, the listener is not notified then.
+  bool SetFinishListener(TaskFinishListener& listener) noexcept;
+
   // wait for this to become finished
   // should only be called from other context
   void Wait() const;
@@ -173,6 +191,37 @@ class TaskContext final : public ContextAccessor {
   void SetCancelDeadline(Deadline deadline);
 
   bool HasLocalStorage() const noexcept;
+
+  // Attributes CPU time since the previous call to the span name if the task
+  // is sampled for CPU accounting. Should be called from the task itself.
+  void AccountSampledCpu(std::string_view span_name);
+
+  // Name of the root span of the task, truncated, for utils::cpu_profiler.
+  // Should only be set from the task itself, is async-signal-safe to read
+  // from the thread that runs the task.
+  void SetProfilerSpanName(std::string_view span_name) noexcept;
+  std::string_view GetProfilerSpanName() const noexcept;
+
+  // Time since the last context switch into the task. Should be called from
+  // the task itself.
+  std::chrono::steady_clock::duration GetCurrentSliceDuration() const noexcept;
+
+  struct ThreadTimes {
+    // Time the task has been running on the threads
+    std::chrono::steady_clock::duration on_thread{};
+    // CPU time of the threads while they were running the task, since
+    // EnableThreadCpuAccounting()
+    std::chrono::nanoseconds thread_cpu{};
+  };
+
+  // Starts measuring the CPU time of the threads that run the task, so that
+  // the time the task has blocked a thread, e.g. on I/O, can be told from the
+  // time it has been computing. Should be called from the task itself.
+  void EnableThreadCpuAccounting() noexcept;
+
+  // Should be called from the task itself
+  ThreadTimes GetThreadTimes() const noexcept;
+
   task_local::Storage& GetLocalStorage() noexcept;
 
   // ContextAccessor implementation
@@ -199,12 +248,14 @@ class TaskContext final : public ContextAccessor {
 
   bool WasStartedAsCritical() const;
   void SetState(Task::State);
+  void NotifyFinishListener() noexcept;
 
   void Schedule();
   static bool ShouldSchedule(SleepState::Flags flags, WakeupSource source);
 
   void ProfilerStartExecution();
   void ProfilerStopExecution();
+  void AccountTaskCpu();
 
   void TraceStateTransition(Task::State state);
 
@@ -215,6 +266,7 @@ class TaskContext final : public ContextAccessor {
   TaskProcessor& task_processor_;
   TaskCounter::Token task_counter_token_;
   const bool is_critical_;
+  const Task::Priority priority_;
   bool is_cancellable_{true};
   bool within_sleep_{false};
   EhGlobals eh_globals_;
@@ -223,6 +275,7 @@ class TaskContext final : public ContextAccessor {
 
   std::atomic<Task::State> state_{Task::State::kNew};
   std::atomic<DetachedTasksSyncBlock::Token*> detached_token_{nullptr};
+  std::atomic<TaskFinishListener*> finish_listener_{nullptr};
   std::atomic<TaskCancellationReason> cancellation_reason_{
       TaskCancellationReason::kNone};
   mutable FastPimplGenericWaitList finish_waiters_;
@@ -235,6 +288,17 @@ class TaskContext final : public ContextAccessor {
   std::chrono::steady_clock::time_point execute_started_;
   std::chrono::steady_clock::time_point last_state_change_timepoint_;
 
+  std::chrono::steady_clock::duration cpu_time_{};
+  std::chrono::steady_clock::duration sampled_cpu_time_{};
+  bool is_cpu_sampled_{false};
+  bool is_thread_cpu_accounted_{false};
+  std::chrono::nanoseconds thread_cpu_started_{};
+  std::chrono::nanoseconds thread_cpu_time_{};
+
+  static constexpr std::size_t kMaxProfilerSpanName = 47;
+  char profiler_span_name_[kMaxProfilerSpanName]{};
+  std::uint8_t profiler_span_name_size_{0};
+
   std::size_t trace_csw_left_;
 
   AtomicSleepState sleep_state_{
@@ -6,7 +6,7 @@
 #include <cstddef>
 #include <cstdint>
 
-#include <concurrent/impl/interference_shield.hpp>
+#include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/utils/fixed_array.hpp>
 #include <userver/utils/statistics/rate_counter.hpp>
 
@@ -1,6 +1,7 @@
 #include "task_processor.hpp"
 
 #include <sys/types.h>
+#include <algorithm>
 #include <csignal>
 
 #include <fmt/format.h>
@@ -63,14 +64,48 @@ void TaskProcessorThreadStartedHook() {
   EmitMagicNanosleep();
 }
 
+std::vector<unsigned> CreateJemallocArenas(const TaskProcessorConfig& config) {
+  std::vector<unsigned> arenas;
+  arenas.reserve(config.jemalloc_arenas);
+  for (std::size_t i = 0; i < config.jemalloc_arenas; ++i) {
+    unsigned arena = 0;
+    if (const auto ec = utils::jemalloc::CreateArena(arena)) {
+      LOG_WARNING() << "Failed to create a jemalloc arena for task processor "
+                    << config.name << ", its workers use the default arenas: "
+                    << ec.message();
+      return {};
+    }
+    arenas.push_back(arena);
+  }
+  return arenas;
+}
+
+using TaskQueueVariant = std::variant<TaskQueue, WorkStealingTaskQueue>;
+
+TaskQueueVariant MakeTaskQueue(const TaskProcessorConfig& config) {
+  switch (config.task_queue) {
+    case TaskQueueType::kGlobalTaskQueue:
+      return TaskQueueVariant(std::in_place_type<TaskQueue>, config);
+    case TaskQueueType::kWorkStealingTaskQueue:
+      return TaskQueueVariant(std::in_place_type<WorkStealingTaskQueue>,
+                              config);
+  }
+  UINVARIANT(false, "Unexpected value of TaskQueueType");
+}
+
 }  // namespace
 
 TaskProcessor::TaskProcessor(TaskProcessorConfig config,
                              std::shared_ptr<impl::TaskProcessorPools> pools)
     : task_counter_(config.worker_threads),
-      task_queue_(config),
+      scheduler_statistics_(config.worker_threads, config.cpu_sampling_every),
+      worker_slice_starts_(config.worker_threads),
+      task_queue_(MakeTaskQueue(config)),
       config_(std::move(config)),
-      pools_(std::move(pools)) {
+      pools_(std::move(pools)),
+      worker_cpus_(config_.placement.ResolveCpus()),
+      jemalloc_arenas_(CreateJemallocArenas(config_)),
+      active_worker_count_(config_.worker_threads) {
   utils::impl::FinishStaticRegistration();
   try {
     LOG_INFO() << "creating task_processor " << Name() << " "
@@ -83,7 +118,8 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
       workers_.emplace_back([this, i, &workers_left] {
         PrepareWorkerThread(i);
         workers_left.count_down();
-        ProcessTasks();
+        ProcessTasks(i);
+        pools_->GetCoroPool().UnregisterLocalCache();
       });
     }
 
@@ -102,10 +138,13 @@ TaskProcessor::~TaskProcessor() { Cleanup(); }
 void TaskProcessor::Cleanup() noexcept {
   InitiateShutdown();
 
+  // The parked workers have to finish the tasks that are left
+  SetActiveWorkerCount(workers_.size());
+
   // Some tasks may be bound but not scheduled yet
   task_counter_.WaitForExhaustion();
 
-  task_queue_.StopProcessing();
+  std::visit([](auto& queue) { queue.StopProcessing(); }, task_queue_);
 
   for (auto& w : workers_) {
     w.join();
@@ -136,13 +175,25 @@ void TaskProcessor::Schedule(impl::TaskContext* context) {
 
   SetTaskQueueWaitTimepoint(context);
 
-  task_queue_.Push(context);
+  std::visit([context](auto& queue) { queue.Push(context); }, task_queue_);
 }
 
 void TaskProcessor::Adopt(impl::TaskContext& context) {
   detached_contexts_->Add(context);
 }
 
+size_t TaskProcessor::GetTaskQueueSize() const {
+  return std::visit([](const auto& queue) { return queue.GetSizeApproximate(); },
+                    task_queue_);
+}
+
+size_t TaskProcessor::GetTaskQueueStolenCount() const {
+  if (const auto* queue = std::get_if<WorkStealingTaskQueue>(&task_queue_)) {
+    return queue->GetStolenCount();
+  }
+  return 0;
+}
+
 ev::ThreadPool& TaskProcessor::EventThreadPool() {
   return pools_->EventThreadPool();
 }
@@ -156,6 +207,7 @@ void TaskProcessor::SetSettings(const TaskProcessorSettings& settings) {
   max_task_queue_wait_time_ = settings.wait_queue_time_limit;
   max_task_queue_wait_length_ = settings.wait_queue_length_limit;
   overload_action_ = settings.overload_action;
+  watchdog_threshold_ = settings.watchdog_slice_threshold;
 
   auto threshold = settings.profiler_execution_slice_threshold;
   if (threshold.count() > 0) {
@@ -189,6 +241,17 @@ bool TaskProcessor::ShouldProfilerForceStacktrace() const {
   return profiler_force_stacktrace_.load();
 }
 
+std::chrono::microseconds TaskProcessor::GetWatchdogThreshold() const noexcept {
+  return watchdog_threshold_.load(std::memory_order_relaxed);
+}
+
+utils::datetime::SteadyCoarseClock::time_point
+TaskProcessor::GetWorkerSliceStart(std::size_t index) const noexcept {
+  using Clock = utils::datetime::SteadyCoarseClock;
+  return Clock::time_point{
+      Clock::duration{worker_slice_starts_[index]->load()}};
+}
+
 size_t TaskProcessor::GetTaskTraceMaxCswForNewTask() const {
   thread_local size_t count = 0;
   if (count++ == config_.task_trace_every) {
@@ -228,6 +291,10 @@ void RegisterThreadStartedHook(std::function<void()> func) {
   ThreadStartedHooks().push_back(std::move(func));
 }
 
+std::size_t GetWorkerCount(const TaskProcessor& task_processor) noexcept {
+  return task_processor.GetWorkerCount();
+}
+
 void TaskProcessor::PrepareWorkerThread(std::size_t index) noexcept {
   switch (config_.os_scheduling) {
     case OsScheduling::kNormal:
@@ -242,19 +309,90 @@ void TaskProcessor::PrepareWorkerThread(std::size_t index) noexcept {
 
   utils::SetCurrentThreadName(fmt::format("{}_{}", config_.thread_name, index));
 
+  if (!config_.placement.IsEmpty()) {
+    try {
+      config_.placement.ApplyToCurrentThread(worker_cpus_);
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Failed to pin a worker of task processor " << Name()
+                  << ": " << ex;
+    }
+  }
+
+  if (!jemalloc_arenas_.empty()) {
+    const auto arena = jemalloc_arenas_[index % jemalloc_arenas_.size()];
+    if (const auto ec = utils::jemalloc::SetThreadArena(arena)) {
+      LOG_ERROR() << "Failed to bind a worker of task processor " << Name()
+                  << " to jemalloc arena " << arena << ": " << ec.message();
+    }
+  }
+
   impl::SetLocalTaskCounterData(task_counter_, index);
+  impl::SetLocalSchedulerStatistics(scheduler_statistics_, index);
+  pools_->GetCoroPool().RegisterLocalCache();
 
   TaskProcessorThreadStartedHook();
 }
 
-void TaskProcessor::ProcessTasks() noexcept {
+std::optional<utils::jemalloc::ArenaStats>
+TaskProcessor::GetJemallocArenaStats() const {
+  if (jemalloc_arenas_.empty()) return std::nullopt;
+
+  utils::jemalloc::ArenaStats result;
+  for (const auto arena : jemalloc_arenas_) {
+    utils::jemalloc::ArenaStats stats;
+    if (utils::jemalloc::GetArenaStats(arena, stats)) return std::nullopt;
+    result += stats;
+  }
+  return result;
+}
+
+void TaskProcessor::SetActiveWorkerCount(std::size_t count) {
+  count = std::clamp<std::size_t>(count, 1, workers_.size());
+  // Tasks in the local queue of a parked worker would wait for the worker
+  UINVARIANT(count == workers_.size() ||
+                 config_.task_queue == TaskQueueType::kGlobalTaskQueue,
+             "Workers may be parked only for the global task queue");
+  {
+    // Under the lock, so that a worker that is about to park does not miss
+    // the notification
+    const std::lock_guard lock{parked_workers_mutex_};
+    if (active_worker_count_.exchange(count) == count) return;
+  }
+  parked_workers_cv_.notify_all();
+  LOG_INFO() << "Task processor " << Name() << " uses " << count << " of "
+             << workers_.size() << " worker threads";
+}
+
+void TaskProcessor::ParkWorkerIfInactive(std::size_t index) noexcept {
+  if (index < active_worker_count_.load(std::memory_order_relaxed)) return;
+
+  std::unique_lock lock{parked_workers_mutex_};
+  parked_workers_cv_.wait(lock, [this, index] {
+    return index < active_worker_count_.load(std::memory_order_relaxed);
+  });
+}
+
+void TaskProcessor::ProcessTasks(std::size_t index) noexcept {
+  std::visit([this, index](auto& queue) { ProcessTasks(queue, index); },
+             task_queue_);
+}
+
+template <typename Queue>
+void TaskProcessor::ProcessTasks(Queue& task_queue,
+                                 std::size_t index) noexcept {
+  auto& slice_start = *worker_slice_starts_[index];
   while (true) {
-    auto context = task_queue_.PopBlocking();
+    ParkWorkerIfInactive(index);
+    auto context = task_queue.PopBlocking();
     if (!context) break;
 
     GetTaskCounter().AccountTaskSwitchSlow();
     CheckWaitTime(*context);
 
+    slice_start.store(utils::datetime::SteadyCoarseClock::now()
+                          .time_since_epoch()
+                          .count(),
+                      std::memory_order_relaxed);
     bool has_failed = false;
     try {
       context->DoStep();
@@ -262,6 +400,7 @@ void TaskProcessor::ProcessTasks() noexcept {
       LOG_ERROR() << "uncaught exception from DoStep: " << ex;
       has_failed = true;
     }
+    slice_start.store(0, std::memory_order_relaxed);
 
     if (has_failed || context->IsFinished()) {
       context->FinishDetached();
@@ -270,6 +409,14 @@ void TaskProcessor::ProcessTasks() noexcept {
 }
 
 void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
+  const auto wait_timepoint = context.GetQueueWaitTimepoint();
+  const bool has_wait_time =
+      wait_timepoint != std::chrono::steady_clock::time_point();
+  const auto wait_time = has_wait_time
+                             ? std::chrono::steady_clock::now() - wait_timepoint
+                             : std::chrono::steady_clock::duration{};
+  if (has_wait_time) scheduler_statistics_.AccountQueueWait(wait_time);
+
   const auto max_wait_time = max_task_queue_wait_time_.load();
   const auto sensor_wait_time = sensor_task_queue_wait_time_.load();
 
@@ -278,9 +425,7 @@ void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
     return;
   }
 
-  const auto wait_timepoint = context.GetQueueWaitTimepoint();
-  if (wait_timepoint != std::chrono::steady_clock::time_point()) {
-    const auto wait_time = std::chrono::steady_clock::now() - wait_timepoint;
+  if (has_wait_time) {
     const auto wait_time_us =
         std::chrono::duration_cast<std::chrono::microseconds>(wait_time);
     LOG_TRACE() << "queue wait time = " << wait_time_us.count() << "us";
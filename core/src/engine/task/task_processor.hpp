@@ -1,22 +1,31 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <thread>
+#include <variant>
 #include <vector>
 
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
-#include <concurrent/impl/interference_shield.hpp>
+#include <engine/task/scheduler_statistics.hpp>
 #include <engine/task/task_counter.hpp>
 #include <engine/task/task_processor_config.hpp>
 #include <engine/task/task_queue.hpp>
+#include <engine/task/work_stealing_task_queue.hpp>
+#include <utils/jemalloc.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
+#include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
 #include <userver/logging/logger.hpp>
+#include <userver/utils/datetime/steady_coarse_clock.hpp>
+#include <userver/utils/fixed_array.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -57,16 +66,48 @@ class TaskProcessor final {
 
   const impl::TaskCounter& GetTaskCounter() const { return task_counter_; }
 
-  size_t GetTaskQueueSize() const { return task_queue_.GetSizeApproximate(); }
+  impl::SchedulerStatistics& GetSchedulerStatistics() noexcept {
+    return scheduler_statistics_;
+  }
+
+  const impl::SchedulerStatistics& GetSchedulerStatistics() const noexcept {
+    return scheduler_statistics_;
+  }
+
+  size_t GetTaskQueueSize() const;
+
+  TaskQueueType GetTaskQueueType() const { return config_.task_queue; }
+
+  // Returns 0 for queues that do not support work stealing
+  size_t GetTaskQueueStolenCount() const;
 
   size_t GetWorkerCount() const { return workers_.size(); }
 
+  // The workers with greater indices are parked after their current task.
+  // The count is clamped to [1, GetWorkerCount()].
+  void SetActiveWorkerCount(std::size_t count);
+
+  std::size_t GetActiveWorkerCount() const noexcept {
+    return active_worker_count_.load(std::memory_order_relaxed);
+  }
+
+  // Start of the task step that the worker is running now, a default
+  // constructed time point if the worker is idle
+  utils::datetime::SteadyCoarseClock::time_point GetWorkerSliceStart(
+      std::size_t index) const noexcept;
+
+  std::thread::native_handle_type GetWorkerNativeHandle(std::size_t index) {
+    return workers_[index].native_handle();
+  }
+
   void SetSettings(const TaskProcessorSettings& settings);
 
   std::chrono::microseconds GetProfilerThreshold() const;
 
   bool ShouldProfilerForceStacktrace() const;
 
+  std::chrono::microseconds GetWatchdogThreshold() const noexcept;
+
   size_t GetTaskTraceMaxCswForNewTask() const;
 
   const std::string& GetTaskTraceLoggerName() const;
@@ -77,12 +118,30 @@ class TaskProcessor final {
 
   std::vector<std::uint8_t> CollectCurrentLoadPct() const;
 
+  bool HasJemallocArenas() const noexcept { return !jemalloc_arenas_.empty(); }
+
+  // Memory of the own jemalloc arenas of the workers as of the last
+  // utils::jemalloc::RefreshStats() call, std::nullopt if the workers use the
+  // default arenas
+  std::optional<utils::jemalloc::ArenaStats> GetJemallocArenaStats() const;
+
+  // The last scheduled task waited in the queue for longer than the
+  // `wait_queue_overload` limit of the task processor settings
+  bool IsTaskQueueWaitTimeOverloaded() const noexcept {
+    return task_queue_wait_time_overloaded_->load(std::memory_order_relaxed);
+  }
+
  private:
   void Cleanup() noexcept;
 
   void PrepareWorkerThread(std::size_t index) noexcept;
 
-  void ProcessTasks() noexcept;
+  void ProcessTasks(std::size_t index) noexcept;
+
+  template <typename Queue>
+  void ProcessTasks(Queue& task_queue, std::size_t index) noexcept;
+
+  void ParkWorkerIfInactive(std::size_t index) noexcept;
 
   void CheckWaitTime(impl::TaskContext& context);
 
@@ -91,18 +150,26 @@ class TaskProcessor final {
   void HandleOverload(impl::TaskContext& context);
 
   impl::TaskCounter task_counter_;
+  impl::SchedulerStatistics scheduler_statistics_;
+  // SteadyCoarseClock ticks, written by the workers, read by the watchdog
+  utils::FixedArray<concurrent::impl::InterferenceShield<
+      std::atomic<utils::datetime::SteadyCoarseClock::rep>>>
+      worker_slice_starts_;
   concurrent::impl::InterferenceShield<impl::DetachedTasksSyncBlock>
       detached_contexts_{impl::DetachedTasksSyncBlock::StopMode::kCancel};
   concurrent::impl::InterferenceShield<std::atomic<bool>>
       task_queue_wait_time_overloaded_{false};
-  TaskQueue task_queue_;
+  std::variant<TaskQueue, WorkStealingTaskQueue> task_queue_;
 
   const TaskProcessorConfig config_;
   const std::shared_ptr<impl::TaskProcessorPools> pools_;
+  const utils::numa::CpuSet worker_cpus_;
+  const std::vector<unsigned> jemalloc_arenas_;
   std::vector<std::thread> workers_;
   logging::LoggerPtr task_trace_logger_{nullptr};
 
   std::atomic<std::chrono::microseconds> task_profiler_threshold_{{}};
+  std::atomic<std::chrono::microseconds> watchdog_threshold_{{}};
   std::atomic<std::chrono::microseconds> sensor_task_queue_wait_time_{{}};
   std::atomic<std::chrono::microseconds> max_task_queue_wait_time_{{}};
   std::atomic<std::size_t> max_task_queue_wait_length_{0};
@@ -113,6 +180,10 @@ class TaskProcessor final {
   std::atomic<bool> is_shutting_down_{false};
   std::atomic<bool> task_trace_logger_set_{false};
 
+  std::atomic<std::size_t> active_worker_count_;
+  std::mutex parked_workers_mutex_;
+  std::condition_variable parked_workers_cv_;
+
   std::unique_ptr<utils::statistics::ThreadPoolCpuStatsStorage>
       cpu_stats_storage_{nullptr};
 };
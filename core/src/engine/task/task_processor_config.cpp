@@ -45,17 +45,39 @@ OsScheduling Parse(const yaml_config::YamlConfig& value,
   return utils::ParseFromValueString(value, kMap);
 }
 
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>) {
+  static constexpr utils::TrivialBiMap kMap([](auto selector) {
+    return selector()
+        .Case(TaskQueueType::kGlobalTaskQueue, "global-task-queue")
+        .Case(TaskQueueType::kWorkStealingTaskQueue,
+              "work-stealing-task-queue");
+  });
+
+  return utils::ParseFromValueString(value, kMap);
+}
+
 TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
                           formats::parse::To<TaskProcessorConfig>) {
   TaskProcessorConfig config;
   config.should_guess_cpu_limit =
       value["guess-cpu-limit"].As<bool>(config.should_guess_cpu_limit);
+  config.should_autoscale_to_cpu_quota =
+      value["autoscale-to-cpu-quota"].As<bool>(
+          config.should_autoscale_to_cpu_quota);
   config.worker_threads = value["worker_threads"].As<std::size_t>();
   config.thread_name = value["thread_name"].As<std::string>({});
   config.os_scheduling =
       value["os-scheduling"].As<OsScheduling>(config.os_scheduling);
   config.spinning_iterations =
       value["spinning-iterations"].As<int>(config.spinning_iterations);
+  config.task_queue =
+      value["task-processor-queue"].As<TaskQueueType>(config.task_queue);
+  config.placement = value.As<utils::numa::ThreadPlacement>();
+  config.cpu_sampling_every =
+      value["cpu-sampling-every"].As<std::size_t>(config.cpu_sampling_every);
+  config.jemalloc_arenas =
+      value["jemalloc-arenas"].As<std::size_t>(config.jemalloc_arenas);
 
   const auto task_trace = value["task-trace"];
   if (!task_trace.IsMissing()) {
@@ -8,6 +8,8 @@
 #include <userver/formats/json_fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
 
+#include <utils/numa.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine {
@@ -21,19 +23,36 @@ enum class OsScheduling {
 OsScheduling Parse(const yaml_config::YamlConfig& value,
                    formats::parse::To<OsScheduling>);
 
+enum class TaskQueueType {
+  kGlobalTaskQueue,
+  kWorkStealingTaskQueue,
+};
+
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>);
+
 struct TaskProcessorConfig {
   std::string name;
 
   bool should_guess_cpu_limit{false};
+  // worker_threads is the upper bound of the active worker threads
+  bool should_autoscale_to_cpu_quota{false};
   std::size_t worker_threads{6};
   std::string thread_name;
   OsScheduling os_scheduling{OsScheduling::kNormal};
   int spinning_iterations{10000};
+  TaskQueueType task_queue{TaskQueueType::kGlobalTaskQueue};
+  utils::numa::ThreadPlacement placement;
 
   std::size_t task_trace_every{1000};
   std::size_t task_trace_max_csw{0};
   std::string task_trace_logger_name;
 
+  std::size_t cpu_sampling_every{0};
+
+  // The workers use their own jemalloc arenas if not zero
+  std::size_t jemalloc_arenas{0};
+
   void SetName(const std::string& new_name);
 };
 
@@ -50,6 +69,10 @@ struct TaskProcessorSettings {
 
   std::chrono::microseconds profiler_execution_slice_threshold{0};
   bool profiler_force_stacktrace{false};
+
+  // The stacks of the tasks that are running without a context switch for
+  // longer are captured while they are still running, 0 disables that
+  std::chrono::microseconds watchdog_slice_threshold{0};
 };
 
 TaskProcessorSettings::OverloadAction Parse(
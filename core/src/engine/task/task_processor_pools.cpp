@@ -2,6 +2,7 @@
 
 #include <utility>
 
+#include <engine/io/io_uring.hpp>
 #include <engine/task/task_context.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
@@ -13,8 +14,16 @@ namespace engine::impl {
 TaskProcessorPools::TaskProcessorPools(coro::PoolConfig coro_pool_config,
                                        ev::ThreadPoolConfig ev_pool_config)
     : coro_pool_(std::move(coro_pool_config), &TaskContext::CoroFunc),
-      event_thread_pool_(std::move(ev_pool_config),
-                         ev::ThreadPool::kUseDefaultEvLoop) {
+      event_thread_pool_(ev_pool_config, ev::ThreadPool::kUseDefaultEvLoop) {
+  if (ev_pool_config.io_uring_entries) {
+    try {
+      io_uring_ = std::make_unique<io::impl::IoUring>(
+          event_thread_pool_.NextThread(), ev_pool_config.io_uring_entries);
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "Falling back to blocking file operations: " << ex;
+    }
+  }
+
   const bool old_value =
       std::exchange(logging::impl::has_background_threads_which_can_log, true);
   UASSERT_MSG(!old_value,
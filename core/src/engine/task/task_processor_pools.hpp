@@ -1,10 +1,16 @@
 #pragma once
 
+#include <memory>
+
 #include <engine/coro/pool.hpp>
 #include <engine/ev/thread_pool.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
+namespace engine::io::impl {
+class IoUring;
+}  // namespace engine::io::impl
+
 namespace engine::impl {
 
 class TaskContext;
@@ -21,9 +27,13 @@ class TaskProcessorPools final {
   CoroPool& GetCoroPool() { return coro_pool_; }
   ev::ThreadPool& EventThreadPool() { return event_thread_pool_; }
 
+  // Returns nullptr if io_uring is disabled in config or is not available
+  io::impl::IoUring* GetIoUring() { return io_uring_.get(); }
+
  private:
   CoroPool coro_pool_;
   ev::ThreadPool event_thread_pool_;
+  std::unique_ptr<io::impl::IoUring> io_uring_;
 };
 
 }  // namespace engine::impl
@@ -1,6 +1,7 @@
 #include <engine/task/task_queue.hpp>
 
 #include <engine/task/task_context.hpp>
+#include <userver/utils/underlying_value.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -8,8 +9,32 @@ namespace engine {
 
 namespace {
 constexpr std::size_t kSemaphoreInitialCount = 0;
+
+// Every N-th pop of a worker starts with the normal/low lane, so that a flood
+// of higher priority tasks slows the lower lanes down instead of stopping them.
+constexpr std::size_t kNormalLaneFirstPeriod = 4;
+constexpr std::size_t kLowLaneFirstPeriod = 16;
+
+constexpr std::size_t ToLaneIndex(Task::Priority priority) noexcept {
+  return static_cast<std::size_t>(utils::UnderlyingValue(priority));
 }
 
+static_assert(ToLaneIndex(Task::Priority::kHigh) == 0);
+static_assert(ToLaneIndex(Task::Priority::kNormal) == 1);
+static_assert(ToLaneIndex(Task::Priority::kLow) == 2);
+
+}  // namespace
+
+struct TaskQueue::ConsumerState {
+  explicit ConsumerState(TaskQueue& queue)
+      : tokens{moodycamel::ConsumerToken{queue.lanes_[0].queue},
+               moodycamel::ConsumerToken{queue.lanes_[1].queue},
+               moodycamel::ConsumerToken{queue.lanes_[2].queue}} {}
+
+  std::array<moodycamel::ConsumerToken, kLanesCount> tokens;
+  std::size_t pops_count{0};
+};
+
 TaskQueue::TaskQueue(const TaskProcessorConfig& config)
     : queue_semaphore_(kSemaphoreInitialCount, config.spinning_iterations) {}
 
@@ -21,10 +46,10 @@ void TaskQueue::Push(boost::intrusive_ptr<impl::TaskContext>&& context) {
 
 boost::intrusive_ptr<impl::TaskContext> TaskQueue::PopBlocking() {
   // Current thread handles only a single TaskProcessor, so it's safe to store
-  // a token for the task processor in a thread-local variable.
-  thread_local moodycamel::ConsumerToken token(queue_);
+  // the tokens for the task processor in a thread-local variable.
+  thread_local ConsumerState state(*this);
 
-  boost::intrusive_ptr<impl::TaskContext> context{DoPopBlocking(token),
+  boost::intrusive_ptr<impl::TaskContext> context{DoPopBlocking(state),
                                                   /* add_ref= */ false};
 
   if (!context) {
@@ -38,23 +63,45 @@ boost::intrusive_ptr<impl::TaskContext> TaskQueue::PopBlocking() {
 void TaskQueue::StopProcessing() { DoPush(nullptr); }
 
 std::size_t TaskQueue::GetSizeApproximate() const noexcept {
-  return queue_.size_approx();
+  std::size_t size = 0;
+  for (const auto& lane : lanes_) size += lane.queue.size_approx();
+  return size;
 }
 
 void TaskQueue::DoPush(impl::TaskContext* context) {
+  const auto priority =
+      context ? context->GetPriority() : Task::Priority::kNormal;
+  auto& lane = lanes_[ToLaneIndex(priority)];
+  if (priority != Task::Priority::kNormal) {
+    lane.size->fetch_add(1, std::memory_order_relaxed);
+  }
+
   // This piece of code is copy-pasted from
   // moodycamel::BlockingConcurrentQueue::enqueue
-  queue_.enqueue(context);
+  lane.queue.enqueue(context);
   queue_semaphore_.signal();
 }
 
-impl::TaskContext* TaskQueue::DoPopBlocking(moodycamel::ConsumerToken& token) {
+impl::TaskContext* TaskQueue::DoPopBlocking(ConsumerState& state) {
   impl::TaskContext* context{};
 
-  // This piece of code is copy-pasted from
+  // This piece of code is based on
   // moodycamel::BlockingConcurrentQueue::wait_dequeue
   queue_semaphore_.wait();
-  while (!queue_.try_dequeue(token, context)) {
+
+  ++state.pops_count;
+  if (state.pops_count % kLowLaneFirstPeriod == 0 &&
+      TryPop(Task::Priority::kLow, state, context)) {
+    return context;
+  }
+  if (state.pops_count % kNormalLaneFirstPeriod == 0 &&
+      TryPop(Task::Priority::kNormal, state, context)) {
+    return context;
+  }
+
+  while (!TryPop(Task::Priority::kHigh, state, context) &&
+         !TryPop(Task::Priority::kNormal, state, context) &&
+         !TryPop(Task::Priority::kLow, state, context)) {
     // Can happen when another consumer steals our item in exchange for another
     // item in a Moodycamel sub-queue that we have already passed.
   }
@@ -62,6 +109,21 @@ impl::TaskContext* TaskQueue::DoPopBlocking(moodycamel::ConsumerToken& token) {
   return context;
 }
 
+bool TaskQueue::TryPop(Task::Priority priority, ConsumerState& state,
+                       impl::TaskContext*& context) {
+  const auto index = ToLaneIndex(priority);
+  auto& lane = lanes_[index];
+  const bool is_counted = (priority != Task::Priority::kNormal);
+
+  if (is_counted && lane.size->load(std::memory_order_relaxed) == 0) {
+    return false;
+  }
+  if (!lane.queue.try_dequeue(state.tokens[index], context)) return false;
+
+  if (is_counted) lane.size->fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
 }  // namespace engine
 
 USERVER_NAMESPACE_END
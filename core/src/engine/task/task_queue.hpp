@@ -1,10 +1,15 @@
 #pragma once
 
+#include <array>
+#include <atomic>
+
 #include <moodycamel/blockingconcurrentqueue.h>
 #include <moodycamel/lightweightsemaphore.h>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <engine/task/task_processor_config.hpp>
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/engine/task/task.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -14,6 +19,9 @@ namespace impl {
 class TaskContext;
 }  // namespace impl
 
+// Tasks are stored in lanes by their Task::Priority. Workers drain higher lanes
+// first, but once in a while the lower lanes are served first to avoid their
+// starvation.
 class TaskQueue final {
  public:
   explicit TaskQueue(const TaskProcessorConfig& config);
@@ -28,11 +36,26 @@ class TaskQueue final {
   std::size_t GetSizeApproximate() const noexcept;
 
  private:
+  static constexpr std::size_t kLanesCount = 3;
+
+  struct Lane {
+    moodycamel::ConcurrentQueue<impl::TaskContext*> queue;
+    // Not maintained for the normal lane, which is the only one used unless
+    // the priorities are set explicitly. Allows skipping the empty lanes
+    // without iterating over all the moodycamel sub-queues.
+    concurrent::impl::InterferenceShield<std::atomic<std::size_t>> size{0};
+  };
+
+  struct ConsumerState;
+
   void DoPush(impl::TaskContext* context);
 
-  impl::TaskContext* DoPopBlocking(moodycamel::ConsumerToken& token);
+  impl::TaskContext* DoPopBlocking(ConsumerState& state);
+
+  bool TryPop(Task::Priority priority, ConsumerState& state,
+              impl::TaskContext*& context);
 
-  moodycamel::ConcurrentQueue<impl::TaskContext*> queue_;
+  std::array<Lane, kLanesCount> lanes_;
   moodycamel::LightweightSemaphore queue_semaphore_;
 };
 
@@ -0,0 +1,86 @@
+#include <engine/task/task_queue.hpp>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+engine::TaskProcessorConfig MakeSingleThreadedConfig() {
+  engine::TaskProcessorConfig config;
+  config.name = "priority-task-processor";
+  config.worker_threads = 1;
+  config.thread_name = "prio-worker";
+  return config;
+}
+
+}  // namespace
+
+UTEST(TaskQueue, HighPriorityFirst) {
+  engine::TaskProcessor tp(
+      MakeSingleThreadedConfig(),
+      engine::current_task::GetTaskProcessor().GetTaskProcessorPools());
+  constexpr std::size_t kTasksPerLane = 8;
+
+  std::atomic<bool> is_blocker_started{false};
+  std::atomic<bool> is_blocker_released{false};
+  auto blocker = engine::AsyncNoSpan(tp, [&] {
+    is_blocker_started = true;
+    while (!is_blocker_released) std::this_thread::yield();
+  });
+  while (!is_blocker_started) engine::Yield();
+
+  // Only accessed from the single worker thread of 'tp'
+  std::vector<engine::Task::Priority> order;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (auto priority : {engine::Task::Priority::kLow,
+                        engine::Task::Priority::kHigh}) {
+    for (std::size_t i = 0; i < kTasksPerLane; ++i) {
+      tasks.push_back(engine::AsyncNoSpan(
+          tp, priority, [&order, priority] { order.push_back(priority); }));
+    }
+  }
+
+  is_blocker_released = true;
+  blocker.Get();
+  engine::WaitAllChecked(tasks);
+
+  ASSERT_EQ(order.size(), 2 * kTasksPerLane);
+  std::size_t high_first = 0;
+  for (std::size_t i = 0; i < kTasksPerLane; ++i) {
+    if (order[i] == engine::Task::Priority::kHigh) ++high_first;
+  }
+  // Anti-starvation may let a low priority task in
+  EXPECT_GE(high_first, kTasksPerLane - 1);
+}
+
+UTEST(TaskQueue, LowPriorityIsNotStarved) {
+  engine::TaskProcessor tp(
+      MakeSingleThreadedConfig(),
+      engine::current_task::GetTaskProcessor().GetTaskProcessorPools());
+
+  std::atomic<bool> stop{false};
+  std::atomic<bool> low_done{false};
+  auto spinner = engine::AsyncNoSpan(tp, engine::Task::Priority::kHigh, [&] {
+    while (!stop) engine::Yield();
+  });
+  auto low = engine::AsyncNoSpan(tp, engine::Task::Priority::kLow,
+                                 [&] { low_done = true; });
+
+  low.Get();
+  EXPECT_TRUE(low_done);
+  stop = true;
+  spinner.Get();
+}
+
+USERVER_NAMESPACE_END
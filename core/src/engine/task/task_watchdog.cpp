@@ -0,0 +1,191 @@
+#include <engine/task/task_watchdog.hpp>
+
+#include <pthread.h>
+#include <signal.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+#include <boost/stacktrace/frame.hpp>
+
+#include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
+#include <userver/utils/thread_name.hpp>
+#include <utils/check_syscall.hpp>
+#include <utils/signal_backtrace.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+namespace {
+
+// The engine does not use it, the sockets send it only after F_SETOWN
+constexpr int kCaptureSignal = SIGURG;
+constexpr std::chrono::milliseconds kCaptureTimeout{10};
+constexpr std::size_t kMaxSpanName = 64;
+
+struct StackCapture final {
+  pthread_t thread{};
+  std::atomic<bool> is_ready{false};
+  std::size_t depth{0};
+  void* frames[utils::impl::kMaxSignalBacktraceDepth]{};
+  std::size_t span_name_size{0};
+  char span_name[kMaxSpanName]{};
+};
+
+std::atomic<StackCapture*> pending_capture{nullptr};
+std::atomic<int> running_handlers{0};
+
+void OnCaptureSignal(int, siginfo_t*, void* ucontext) {
+  const auto saved_errno = errno;
+  ++running_handlers;
+  auto* const capture = pending_capture.load();
+  if (capture && pthread_equal(capture->thread, pthread_self()) &&
+      !capture->is_ready.load(std::memory_order_relaxed)) {
+    capture->depth = utils::impl::SignalBacktrace(ucontext, capture->frames);
+    if (auto* const context = current_task::GetCurrentTaskContextUnchecked()) {
+      const auto span_name = context->GetProfilerSpanName();
+      capture->span_name_size = std::min(span_name.size(), kMaxSpanName);
+      std::copy_n(span_name.data(), capture->span_name_size,
+                  capture->span_name);
+    }
+    capture->is_ready.store(true, std::memory_order_release);
+  }
+  --running_handlers;
+  errno = saved_errno;
+}
+
+void InstallSignalHandler() {
+  static std::once_flag installed;
+  std::call_once(installed, [] {
+    utils::impl::PrepareSignalBacktrace();
+
+    // The handler is never removed, it ignores the signals that are not
+    // requested by a watchdog
+    struct sigaction action {};
+    action.sa_sigaction = &OnCaptureSignal;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    utils::CheckSyscall(sigaction(kCaptureSignal, &action, nullptr),
+                        "installing the task watchdog signal handler");
+  });
+}
+
+// Captures the stack of the worker with a signal, returns false if the worker
+// did not respond in time or another capture is in progress
+bool CaptureStack(StackCapture& capture) noexcept {
+  StackCapture* expected = nullptr;
+  if (!pending_capture.compare_exchange_strong(expected, &capture)) {
+    return false;
+  }
+
+  if (pthread_kill(capture.thread, kCaptureSignal) == 0) {
+    const auto deadline = std::chrono::steady_clock::now() + kCaptureTimeout;
+    while (!capture.is_ready.load(std::memory_order_acquire) &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::microseconds{100});
+    }
+  }
+
+  // Wait for the handler that may still write into the capture
+  pending_capture = nullptr;
+  while (running_handlers.load() != 0) std::this_thread::yield();
+  return capture.is_ready.load(std::memory_order_acquire);
+}
+
+std::string FormatStacktrace(const StackCapture& capture) {
+  std::string result;
+  for (std::size_t i = 0; i < capture.depth; ++i) {
+    // Return addresses point past the call, step back into it
+    auto* const address = static_cast<char*>(capture.frames[i]) - (i ? 1 : 0);
+    auto name = boost::stacktrace::frame{address}.name();
+    if (name.empty()) name = fmt::format("{}", capture.frames[i]);
+    fmt::format_to(std::back_inserter(result), "{:>2}# {}\n", i, name);
+  }
+  return result;
+}
+
+}  // namespace
+
+TaskWatchdog::TaskWatchdog(std::vector<TaskProcessor*> task_processors,
+                           std::chrono::milliseconds interval)
+    : interval_(interval),
+      task_processors_(std::move(task_processors)),
+      reported_(task_processors_.size()) {
+  for (std::size_t i = 0; i < task_processors_.size(); ++i) {
+    reported_[i].resize(task_processors_[i]->GetWorkerCount());
+  }
+  InstallSignalHandler();
+  thread_ = std::thread([this] { Run(); });
+}
+
+TaskWatchdog::~TaskWatchdog() {
+  {
+    const std::lock_guard lock{mutex_};
+    is_stopped_ = true;
+  }
+  cv_.notify_one();
+  thread_.join();
+}
+
+void TaskWatchdog::Run() {
+  utils::SetCurrentThreadName("task-watchdog");
+  std::unique_lock lock{mutex_};
+  while (!cv_.wait_for(lock, interval_, [this] { return is_stopped_; })) {
+    Check();
+  }
+}
+
+void TaskWatchdog::Check() noexcept {
+  const auto now = Clock::now();
+  for (std::size_t i = 0; i < task_processors_.size(); ++i) {
+    auto& task_processor = *task_processors_[i];
+    const auto threshold = task_processor.GetWatchdogThreshold();
+    if (threshold.count() <= 0) continue;
+
+    for (std::size_t worker = 0; worker < reported_[i].size(); ++worker) {
+      const auto slice_start = task_processor.GetWorkerSliceStart(worker);
+      if (slice_start == Clock::time_point{}) continue;
+      if (now - slice_start < threshold) continue;
+      if (reported_[i][worker] == slice_start) continue;
+
+      reported_[i][worker] = slice_start;
+      try {
+        Report(task_processor, worker, now - slice_start);
+      } catch (const std::exception& ex) {
+        LOG_LIMITED_ERROR() << "Failed to report a long task step: " << ex;
+      }
+    }
+  }
+}
+
+void TaskWatchdog::Report(TaskProcessor& task_processor, std::size_t worker,
+                          Clock::duration duration) {
+  StackCapture capture;
+  capture.thread = task_processor.GetWorkerNativeHandle(worker);
+  const bool is_captured = CaptureStack(capture);
+
+  const std::string_view span_name{capture.span_name, capture.span_name_size};
+  task_processor.GetSchedulerStatistics().AccountLongSlice(span_name);
+
+  logging::LogExtra extra;
+  if (is_captured) extra.Extend("stacktrace", FormatStacktrace(capture));
+  LOG_LIMITED_ERROR()
+      << "Task of task processor '" << task_processor.Name() << "' with span '"
+      << span_name << "' has been running on worker " << worker << " for "
+      << std::chrono::duration_cast<std::chrono::milliseconds>(duration).count()
+      << "ms without a context switch" << extra;
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <userver/utils/datetime/steady_coarse_clock.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+class TaskProcessor;
+
+namespace impl {
+
+// Finds the task steps that are running for longer than the watchdog
+// threshold of their TaskProcessor. The stack of such a step is captured by
+// a signal to its worker thread while the step is still running, then the
+// step is logged and counted by its root span name.
+class TaskWatchdog final {
+ public:
+  static constexpr std::chrono::milliseconds kDefaultInterval{50};
+
+  explicit TaskWatchdog(std::vector<TaskProcessor*> task_processors,
+                        std::chrono::milliseconds interval = kDefaultInterval);
+
+  TaskWatchdog(TaskWatchdog&&) = delete;
+  TaskWatchdog& operator=(TaskWatchdog&&) = delete;
+
+  ~TaskWatchdog();
+
+ private:
+  using Clock = utils::datetime::SteadyCoarseClock;
+
+  void Run();
+  void Check() noexcept;
+  void Report(TaskProcessor& task_processor, std::size_t worker,
+              Clock::duration duration);
+
+  const std::chrono::milliseconds interval_;
+  const std::vector<TaskProcessor*> task_processors_;
+  // Slice starts that are already reported, by task processor and worker
+  std::vector<std::vector<Clock::time_point>> reported_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool is_stopped_{false};
+  // Must be the last, uses the fields above
+  std::thread thread_;
+};
+
+}  // namespace impl
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,42 @@
+#include <engine/task/task_watchdog.hpp>
+
+#include <chrono>
+
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(TaskWatchdog, LongSlice) {
+  engine::TaskProcessorConfig config;
+  config.name = "watchdog-task-processor";
+  config.worker_threads = 2;
+  config.thread_name = "watchdog-worker";
+  engine::TaskProcessor tp(
+      config, engine::current_task::GetTaskProcessor().GetTaskProcessorPools());
+
+  engine::TaskProcessorSettings settings;
+  settings.watchdog_slice_threshold = std::chrono::milliseconds{20};
+  tp.SetSettings(settings);
+
+  {
+    engine::impl::TaskWatchdog watchdog({&tp}, std::chrono::milliseconds{10});
+
+    // Does not yield
+    engine::AsyncNoSpan(tp, [] {
+      const auto start = std::chrono::steady_clock::now();
+      while (std::chrono::steady_clock::now() - start <
+             std::chrono::milliseconds{200}) {
+      }
+    }).Get();
+  }
+
+  const auto long_slices = tp.GetSchedulerStatistics().GetLongSlices();
+  ASSERT_EQ(long_slices.count("no-span"), 1);
+  // Reported once per slice
+  EXPECT_EQ(long_slices.at("no-span"), 1);
+}
+
+USERVER_NAMESPACE_END
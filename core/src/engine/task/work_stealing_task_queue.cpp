@@ -0,0 +1,325 @@
+#include <engine/task/work_stealing_task_queue.hpp>
+
+#include <engine/task/task_context.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace {
+
+constexpr std::size_t kSemaphoreInitialCount = 0;
+
+// Same value as in Tokio and Go schedulers: check the global queue from time
+// to time, otherwise tasks pushed from outside may starve.
+constexpr std::size_t kGlobalQueueCheckInterval = 61;
+
+// Do not let a pair of tasks that wake up each other starve the local queue.
+constexpr std::size_t kMaxConsecutiveLifoPops = 3;
+
+// Current thread handles only a single TaskProcessor, so it's safe to keep the
+// worker data in thread-local variables.
+thread_local const void* current_queue = nullptr;
+thread_local void* current_worker = nullptr;
+
+std::uint64_t NextRandom(std::uint64_t& state) noexcept {
+  // xorshift64, good enough to pick a victim
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+}  // namespace
+
+bool WorkStealingTaskQueue::LocalQueue::TryPush(
+    impl::TaskContext* context) noexcept {
+  const auto tail = tail_.load(std::memory_order_relaxed);
+  const auto head = head_.load(std::memory_order_acquire);
+  if (tail - head >= kLocalQueueCapacity) return false;
+
+  buffer_[tail % kLocalQueueCapacity].store(context, std::memory_order_relaxed);
+  tail_.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::LocalQueue::TryPop() noexcept {
+  auto head = head_.load(std::memory_order_acquire);
+  while (true) {
+    const auto tail = tail_.load(std::memory_order_acquire);
+    if (head == tail) return nullptr;
+
+    // The slot can not be overwritten by the owner before head_ moves past it,
+    // in which case the CAS below fails.
+    auto* context =
+        buffer_[head % kLocalQueueCapacity].load(std::memory_order_relaxed);
+    if (head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel,
+                                    std::memory_order_acquire)) {
+      return context;
+    }
+  }
+}
+
+impl::TaskContext* WorkStealingTaskQueue::LocalQueue::StealHalfFrom(
+    LocalQueue& victim) noexcept {
+  UASSERT(this != &victim);
+
+  const auto our_tail = tail_.load(std::memory_order_relaxed);
+  auto victim_head = victim.head_.load(std::memory_order_acquire);
+  while (true) {
+    const auto victim_tail = victim.tail_.load(std::memory_order_acquire);
+    const std::uint32_t available = victim_tail - victim_head;
+    if (available == 0 || available > kLocalQueueCapacity) return nullptr;
+
+    const std::uint32_t to_steal = available - available / 2;
+    // Only the owner thread pushes into *this, and the queue was empty when
+    // we decided to steal, so there is room for `to_steal` elements.
+    for (std::uint32_t i = 0; i < to_steal; ++i) {
+      auto* context = victim.buffer_[(victim_head + i) % kLocalQueueCapacity]
+                          .load(std::memory_order_relaxed);
+      buffer_[(our_tail + i) % kLocalQueueCapacity].store(
+          context, std::memory_order_relaxed);
+    }
+
+    if (victim.head_.compare_exchange_weak(
+            victim_head, victim_head + to_steal, std::memory_order_acq_rel,
+            std::memory_order_acquire)) {
+      // Keep the last one for ourselves, publish the rest
+      auto* result = buffer_[(our_tail + to_steal - 1) % kLocalQueueCapacity]
+                         .load(std::memory_order_relaxed);
+      tail_.store(our_tail + to_steal - 1, std::memory_order_release);
+      return result;
+    }
+  }
+}
+
+template <typename Overflow>
+void WorkStealingTaskQueue::LocalQueue::MoveHalfTo(Overflow& overflow) {
+  for (std::size_t i = 0; i < kLocalQueueCapacity / 2; ++i) {
+    auto* context = TryPop();
+    if (!context) break;
+    overflow(context);
+  }
+}
+
+std::size_t WorkStealingTaskQueue::LocalQueue::GetSizeApproximate()
+    const noexcept {
+  const auto head = head_.load(std::memory_order_relaxed);
+  const auto tail = tail_.load(std::memory_order_relaxed);
+  const std::uint32_t size = tail - head;
+  // Tail and head are loaded non-atomically, so the difference may be garbage
+  return size <= kLocalQueueCapacity ? size : 0;
+}
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(const TaskProcessorConfig& config)
+    : workers_(config.worker_threads, global_queue_),
+      sleepers_semaphore_(kSemaphoreInitialCount, config.spinning_iterations) {}
+
+WorkStealingTaskQueue::~WorkStealingTaskQueue() {
+  // All the tasks must have been processed before the TaskProcessor shutdown
+  UASSERT(GetSizeApproximate() == 0);
+}
+
+void WorkStealingTaskQueue::Push(
+    boost::intrusive_ptr<impl::TaskContext>&& context) {
+  UASSERT(context);
+  auto* const raw_context = context.get();
+  context.detach();
+
+  auto* worker = GetCurrentWorker();
+  if (worker) {
+    DoPushLocal(*worker, raw_context);
+  } else {
+    DoPushGlobal(raw_context);
+  }
+  WakeupSleeper();
+}
+
+boost::intrusive_ptr<impl::TaskContext> WorkStealingTaskQueue::PopBlocking() {
+  auto& worker = GetOrRegisterCurrentWorker();
+  worker.last_popped = nullptr;
+
+  while (true) {
+    if (auto* context = TryPopAny(worker)) {
+      worker.last_popped = context;
+      return {context, /* add_ref= */ false};
+    }
+
+    if (is_stopped_.load(std::memory_order_acquire)) return nullptr;
+
+    sleepers_->fetch_add(1, std::memory_order_seq_cst);
+    // Pairs with the fence in WakeupSleeper(): either we see the pushed task
+    // or the pusher sees us sleeping.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (auto* context = TryPopAny(worker)) {
+      sleepers_->fetch_sub(1, std::memory_order_relaxed);
+      worker.last_popped = context;
+      return {context, /* add_ref= */ false};
+    }
+
+    if (is_stopped_.load(std::memory_order_acquire)) {
+      sleepers_->fetch_sub(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+
+    sleepers_semaphore_.wait();
+    pending_wakeups_->fetch_sub(1, std::memory_order_seq_cst);
+    sleepers_->fetch_sub(1, std::memory_order_seq_cst);
+  }
+}
+
+void WorkStealingTaskQueue::StopProcessing() {
+  is_stopped_.store(true, std::memory_order_seq_cst);
+  const auto workers_count = static_cast<std::int64_t>(workers_.size());
+  pending_wakeups_->fetch_add(workers_count, std::memory_order_seq_cst);
+  sleepers_semaphore_.signal(workers_count);
+}
+
+std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
+  std::size_t size = global_queue_.size_approx();
+  for (const auto& worker : workers_) {
+    size += worker.local_queue.GetSizeApproximate();
+    if (worker.lifo_slot.load(std::memory_order_relaxed)) ++size;
+  }
+  return size;
+}
+
+std::size_t WorkStealingTaskQueue::GetStolenCount() const noexcept {
+  std::size_t result = 0;
+  for (const auto& worker : workers_) {
+    result += worker.stolen_count.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+WorkStealingTaskQueue::Worker&
+WorkStealingTaskQueue::GetOrRegisterCurrentWorker() {
+  if (auto* worker = GetCurrentWorker()) return *worker;
+
+  const auto index =
+      registered_workers_.fetch_add(1, std::memory_order_relaxed);
+  UINVARIANT(index < workers_.size(),
+             "More threads than configured are popping from the task queue");
+
+  auto& worker = workers_[index];
+  worker.steal_rng_state = utils::WithDefaultRandom(
+      [](auto& rng) { return static_cast<std::uint64_t>(rng()) | 1; });
+  current_queue = this;
+  current_worker = &worker;
+  return worker;
+}
+
+WorkStealingTaskQueue::Worker* WorkStealingTaskQueue::GetCurrentWorker()
+    const noexcept {
+  if (current_queue != this) return nullptr;
+  return static_cast<Worker*>(current_worker);
+}
+
+void WorkStealingTaskQueue::DoPushLocal(Worker& worker,
+                                        impl::TaskContext* context) {
+  auto overflow = [this](impl::TaskContext* overflow_context) {
+    DoPushGlobal(overflow_context);
+  };
+
+  if (context == worker.last_popped) {
+    // The task reschedules itself (e.g. engine::Yield()), give others a chance
+    if (!worker.local_queue.TryPush(context)) {
+      worker.local_queue.MoveHalfTo(overflow);
+      DoPushGlobal(context);
+    }
+    return;
+  }
+
+  auto* const previous =
+      worker.lifo_slot.exchange(context, std::memory_order_acq_rel);
+  if (!previous) return;
+
+  if (!worker.local_queue.TryPush(previous)) {
+    worker.local_queue.MoveHalfTo(overflow);
+    DoPushGlobal(previous);
+  }
+}
+
+void WorkStealingTaskQueue::DoPushGlobal(impl::TaskContext* context) {
+  global_queue_.enqueue(context);
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopLocal(Worker& worker) noexcept {
+  if (worker.consecutive_lifo_pops < kMaxConsecutiveLifoPops) {
+    if (auto* context =
+            worker.lifo_slot.exchange(nullptr, std::memory_order_acq_rel)) {
+      ++worker.consecutive_lifo_pops;
+      return context;
+    }
+  } else if (auto* context = worker.lifo_slot.exchange(
+                 nullptr, std::memory_order_acq_rel)) {
+    worker.consecutive_lifo_pops = 0;
+    if (!worker.local_queue.TryPush(context)) return context;
+  }
+
+  worker.consecutive_lifo_pops = 0;
+  return worker.local_queue.TryPop();
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopGlobal(Worker& worker) {
+  impl::TaskContext* context = nullptr;
+  if (global_queue_.try_dequeue(worker.global_token, context)) return context;
+  return nullptr;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TrySteal(Worker& worker) noexcept {
+  const auto workers_count = workers_.size();
+  if (workers_count < 2) return nullptr;
+
+  const auto start = NextRandom(worker.steal_rng_state) % workers_count;
+  for (std::size_t i = 0; i < workers_count; ++i) {
+    auto& victim = workers_[(start + i) % workers_count];
+    if (&victim == &worker) continue;
+
+    auto* context = worker.local_queue.StealHalfFrom(victim.local_queue);
+    if (!context) {
+      // The victim may be busy running a long task, do not let the task in
+      // its LIFO slot wait for it.
+      context = victim.lifo_slot.exchange(nullptr, std::memory_order_acq_rel);
+    }
+
+    if (context) {
+      worker.stolen_count.fetch_add(1, std::memory_order_relaxed);
+      return context;
+    }
+  }
+  return nullptr;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopAny(Worker& worker) {
+  if (++worker.pops_since_global_check >= kGlobalQueueCheckInterval) {
+    worker.pops_since_global_check = 0;
+    if (auto* context = TryPopGlobal(worker)) return context;
+  }
+
+  if (auto* context = TryPopLocal(worker)) return context;
+  if (auto* context = TryPopGlobal(worker)) return context;
+  return TrySteal(worker);
+}
+
+void WorkStealingTaskQueue::WakeupSleeper() noexcept {
+  // Pairs with the fence in PopBlocking()
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  const auto sleepers = sleepers_->load(std::memory_order_seq_cst);
+  auto pending = pending_wakeups_->load(std::memory_order_seq_cst);
+  while (pending < sleepers) {
+    if (pending_wakeups_->compare_exchange_weak(pending, pending + 1,
+                                                std::memory_order_seq_cst)) {
+      sleepers_semaphore_.signal();
+      return;
+    }
+  }
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <moodycamel/concurrentqueue.h>
+#include <moodycamel/lightweightsemaphore.h>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include <engine/task/task_processor_config.hpp>
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+}  // namespace impl
+
+/// Task queue with a local queue per worker thread.
+///
+/// Tasks scheduled from a worker thread go into its local LIFO slot and
+/// bounded ring, so that the hot path does not touch any shared cache lines.
+/// Tasks scheduled from outside go to a global injection queue. Idle workers
+/// steal half of the local ring of a random busy worker before going to sleep.
+class WorkStealingTaskQueue final {
+ public:
+  explicit WorkStealingTaskQueue(const TaskProcessorConfig& config);
+
+  ~WorkStealingTaskQueue();
+
+  void Push(boost::intrusive_ptr<impl::TaskContext>&& context);
+
+  // Returns nullptr as a stop signal
+  boost::intrusive_ptr<impl::TaskContext> PopBlocking();
+
+  void StopProcessing();
+
+  std::size_t GetSizeApproximate() const noexcept;
+
+  std::size_t GetStolenCount() const noexcept;
+
+ private:
+  static constexpr std::size_t kLocalQueueCapacity = 256;
+
+  // Bounded single-producer multi-consumer ring. Only the owning worker
+  // pushes, the owner and the thieves pop from the head.
+  class LocalQueue final {
+   public:
+    bool TryPush(impl::TaskContext* context) noexcept;
+
+    impl::TaskContext* TryPop() noexcept;
+
+    // Moves up to a half of `victim` elements into *this, returns one of them.
+    impl::TaskContext* StealHalfFrom(LocalQueue& victim) noexcept;
+
+    // Moves a half of the elements from a full queue into `overflow`
+    template <typename Overflow>
+    void MoveHalfTo(Overflow& overflow);
+
+    std::size_t GetSizeApproximate() const noexcept;
+
+   private:
+    std::atomic<std::uint32_t> head_{0};
+    std::atomic<std::uint32_t> tail_{0};
+    std::array<std::atomic<impl::TaskContext*>, kLocalQueueCapacity> buffer_{};
+  };
+
+  struct alignas(concurrent::impl::kDestructiveInterferenceSize) Worker final {
+    explicit Worker(moodycamel::ConcurrentQueue<impl::TaskContext*>& global)
+        : global_token(global) {}
+
+    std::atomic<impl::TaskContext*> lifo_slot{nullptr};
+    LocalQueue local_queue;
+    moodycamel::ConsumerToken global_token;
+
+    // The following fields are accessed only from the owning thread
+    impl::TaskContext* last_popped{nullptr};
+    std::size_t pops_since_global_check{0};
+    std::size_t consecutive_lifo_pops{0};
+    std::uint64_t steal_rng_state{0};
+
+    std::atomic<std::size_t> stolen_count{0};
+  };
+
+  Worker& GetOrRegisterCurrentWorker();
+
+  Worker* GetCurrentWorker() const noexcept;
+
+  void DoPushLocal(Worker& worker, impl::TaskContext* context);
+
+  void DoPushGlobal(impl::TaskContext* context);
+
+  impl::TaskContext* TryPopLocal(Worker& worker) noexcept;
+
+  impl::TaskContext* TryPopGlobal(Worker& worker);
+
+  impl::TaskContext* TrySteal(Worker& worker) noexcept;
+
+  impl::TaskContext* TryPopAny(Worker& worker);
+
+  void WakeupSleeper() noexcept;
+
+  moodycamel::ConcurrentQueue<impl::TaskContext*> global_queue_;
+  utils::FixedArray<Worker> workers_;
+  std::atomic<std::size_t> registered_workers_{0};
+
+  concurrent::impl::InterferenceShield<std::atomic<std::int64_t>> sleepers_{0};
+  concurrent::impl::InterferenceShield<std::atomic<std::int64_t>>
+      pending_wakeups_{0};
+  moodycamel::LightweightSemaphore sleepers_semaphore_;
+  std::atomic<bool> is_stopped_{false};
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
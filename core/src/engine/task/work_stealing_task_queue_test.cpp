@@ -0,0 +1,121 @@
+#include <engine/task/work_stealing_task_queue.hpp>
+
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/engine/wait_all_checked.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWorkerThreads = 4;
+
+engine::TaskProcessorConfig MakeWorkStealingConfig() {
+  engine::TaskProcessorConfig config;
+  config.name = "work-stealing-task-processor";
+  config.worker_threads = kWorkerThreads;
+  config.thread_name = "ws-worker";
+  config.task_queue = engine::TaskQueueType::kWorkStealingTaskQueue;
+  return config;
+}
+
+class WorkStealingTaskProcessor final {
+ public:
+  WorkStealingTaskProcessor()
+      : task_processor_(
+            MakeWorkStealingConfig(),
+            engine::current_task::GetTaskProcessor().GetTaskProcessorPools()) {
+  }
+
+  engine::TaskProcessor& operator*() { return task_processor_; }
+
+ private:
+  engine::TaskProcessor task_processor_;
+};
+
+}  // namespace
+
+UTEST(WorkStealingTaskQueue, Simple) {
+  WorkStealingTaskProcessor tp;
+
+  auto task = engine::AsyncNoSpan(*tp, [] { return 42; });
+  EXPECT_EQ(task.Get(), 42);
+}
+
+UTEST(WorkStealingTaskQueue, ManyExternalTasks) {
+  WorkStealingTaskProcessor tp;
+  constexpr std::size_t kTasks = 1000;
+
+  std::atomic<std::size_t> counter{0};
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasks);
+  for (std::size_t i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan(*tp, [&counter] { ++counter; }));
+  }
+  engine::WaitAllChecked(tasks);
+
+  EXPECT_EQ(counter.load(), kTasks);
+}
+
+UTEST(WorkStealingTaskQueue, NestedTasksAreStolen) {
+  WorkStealingTaskProcessor tp;
+  constexpr std::size_t kTasks = 500;
+
+  // All the subtasks are pushed into the local queue of a single worker,
+  // other workers have to steal them to run concurrently.
+  auto thread_ids = engine::AsyncNoSpan(*tp, [&tp] {
+                      engine::Mutex mutex;
+                      std::unordered_set<std::thread::id> ids;
+
+                      std::vector<engine::TaskWithResult<void>> tasks;
+                      tasks.reserve(kTasks);
+                      for (std::size_t i = 0; i < kTasks; ++i) {
+                        tasks.push_back(engine::AsyncNoSpan(*tp, [&] {
+                          std::this_thread::sleep_for(
+                              std::chrono::microseconds{100});
+                          const std::lock_guard lock{mutex};
+                          ids.insert(std::this_thread::get_id());
+                        }));
+                      }
+                      engine::WaitAllChecked(tasks);
+                      return ids;
+                    }).Get();
+
+  EXPECT_GT(thread_ids.size(), 1);
+  EXPECT_GT((*tp).GetTaskQueueStolenCount(), 0);
+}
+
+UTEST(WorkStealingTaskQueue, YieldDoesNotStarveOthers) {
+  WorkStealingTaskProcessor tp;
+
+  std::atomic<bool> stop{false};
+  std::vector<engine::TaskWithResult<void>> spinners;
+  for (std::size_t i = 0; i < kWorkerThreads; ++i) {
+    spinners.push_back(engine::AsyncNoSpan(*tp, [&stop] {
+      while (!stop) engine::Yield();
+    }));
+  }
+
+  auto task = engine::AsyncNoSpan(*tp, [&stop] { stop = true; });
+  task.Get();
+  engine::WaitAllChecked(spinners);
+}
+
+UTEST(WorkStealingTaskQueue, QueueSize) {
+  WorkStealingTaskProcessor tp;
+  EXPECT_EQ((*tp).GetTaskQueueSize(), 0);
+  EXPECT_EQ((*tp).GetTaskQueueType(),
+            engine::TaskQueueType::kWorkStealingTaskQueue);
+}
+
+USERVER_NAMESPACE_END
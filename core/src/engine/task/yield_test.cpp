@@ -1,5 +1,7 @@
 #include <userver/utest/utest.hpp>
 
+#include <atomic>
+#include <chrono>
 #include <thread>
 
 #include <userver/engine/async.hpp>
@@ -47,4 +49,23 @@ UTEST_MT(EngineYield, DISABLED_IsBroken, 2) {
   slow_task.Get();
 }
 
+UTEST(EngineYield, CooperativeYieldPoint) {
+  std::atomic<bool> is_other_task_run{false};
+  auto other_task = engine::AsyncNoSpan([&] { is_other_task_run = true; });
+
+  // Does not yield until the budget is spent
+  engine::CooperativeYieldPoint(utest::kMaxTestWaitTime);
+  EXPECT_FALSE(is_other_task_run);
+
+  // The engine has a single thread, so the other task runs only if the
+  // loop yields
+  const auto start = std::chrono::steady_clock::now();
+  while (!is_other_task_run &&
+         std::chrono::steady_clock::now() - start < utest::kMaxTestWaitTime) {
+    engine::CooperativeYieldPoint(std::chrono::milliseconds{1});
+  }
+  EXPECT_TRUE(is_other_task_run);
+  other_task.Get();
+}
+
 USERVER_NAMESPACE_END
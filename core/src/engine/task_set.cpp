@@ -0,0 +1,102 @@
+#include <userver/engine/task_set.hpp>
+
+#include <atomic>
+
+#include <engine/task/task_context.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+struct TaskSetImpl::Impl final {
+  class Node final : public TaskFinishListener {
+   public:
+    Node(Impl& set, std::size_t index) noexcept : set_(set), index_(index) {}
+
+    void OnTaskFinished() noexcept override { set_.Push(*this); }
+
+    std::size_t GetIndex() const noexcept { return index_; }
+
+    Node* next{nullptr};
+
+   private:
+    Impl& set_;
+    const std::size_t index_;
+  };
+
+  void Push(Node& node) noexcept;
+
+  // Moves the pushed nodes to `ready` in the order of completion
+  bool TakePushed() noexcept;
+
+  // Node addresses must be stable
+  std::deque<Node> nodes;
+  // The nodes of the finished tasks, most recent first
+  std::atomic<Node*> pushed{nullptr};
+  SingleConsumerEvent pushed_event;
+
+  // Only used by the owner of the set
+  Node* ready{nullptr};
+  std::size_t returned_count{0};
+};
+
+void TaskSetImpl::Impl::Push(Node& node) noexcept {
+  auto* head = pushed.load(std::memory_order_relaxed);
+  do {
+    node.next = head;
+  } while (!pushed.compare_exchange_weak(
+      head, &node, std::memory_order_release, std::memory_order_relaxed));
+  pushed_event.Send();
+}
+
+bool TaskSetImpl::Impl::TakePushed() noexcept {
+  UASSERT(ready == nullptr);
+  auto* node = pushed.exchange(nullptr, std::memory_order_acquire);
+  while (node) {
+    auto* const next = node->next;
+    node->next = ready;
+    ready = node;
+    node = next;
+  }
+  return ready != nullptr;
+}
+
+TaskSetImpl::TaskSetImpl() : impl_(std::make_unique<Impl>()) {}
+
+TaskSetImpl::~TaskSetImpl() = default;
+
+std::size_t TaskSetImpl::Add(TaskBase& task) {
+  UINVARIANT(task.IsValid(), "Adding an invalid task to a TaskSet");
+  const auto index = impl_->nodes.size();
+  auto& node = impl_->nodes.emplace_back(*impl_, index);
+  if (!task.GetContext().SetFinishListener(node)) {
+    // Already finished
+    impl_->Push(node);
+  }
+  return index;
+}
+
+std::optional<std::size_t> TaskSetImpl::NextReady(Deadline deadline) {
+  auto& impl = *impl_;
+  while (impl.ready == nullptr) {
+    if (impl.returned_count == impl.nodes.size()) return std::nullopt;
+    if (impl.TakePushed()) break;
+    // The event may be left signaled by the nodes that are already taken
+    if (!impl.pushed_event.WaitForEventUntil(deadline)) return std::nullopt;
+  }
+
+  auto* const node = impl.ready;
+  impl.ready = node->next;
+  ++impl.returned_count;
+  return node->GetIndex();
+}
+
+std::size_t TaskSetImpl::GetPendingCount() const noexcept {
+  return impl_->nodes.size() - impl_->returned_count;
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,55 @@
+#include <userver/engine/task_set.hpp>
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/wait_any.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// The tasks finish only after the waiter goes to sleep
+auto MakeTask() {
+  return engine::AsyncNoSpan([] { engine::Yield(); });
+}
+
+}  // namespace
+
+void wait_any_all_tasks(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto task_count = static_cast<std::size_t>(state.range(0));
+    for ([[maybe_unused]] auto _ : state) {
+      std::vector<engine::TaskWithResult<void>> tasks;
+      tasks.reserve(task_count);
+      for (std::size_t i = 0; i < task_count; ++i) tasks.push_back(MakeTask());
+
+      for (std::size_t i = 0; i < task_count; ++i) {
+        // The invalidated tasks are skipped
+        tasks[*engine::WaitAny(tasks)].Get();
+      }
+    }
+  });
+}
+BENCHMARK(wait_any_all_tasks)->RangeMultiplier(4)->Range(4, 4096);
+
+void task_set_all_tasks(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto task_count = static_cast<std::size_t>(state.range(0));
+    for ([[maybe_unused]] auto _ : state) {
+      engine::TaskSet<void> tasks;
+      for (std::size_t i = 0; i < task_count; ++i) tasks.Add(MakeTask());
+
+      while (const auto index = tasks.NextReady()) {
+        tasks.GetTask(*index).Get();
+      }
+    }
+  });
+}
+BENCHMARK(task_set_all_tasks)->RangeMultiplier(4)->Range(4, 4096);
+
+USERVER_NAMESPACE_END
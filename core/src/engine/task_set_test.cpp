@@ -0,0 +1,97 @@
+#include <userver/engine/task_set.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using namespace std::chrono_literals;
+
+UTEST(TaskSet, Sample) {
+  /// [Sample engine::TaskSet]
+  constexpr std::size_t kTaskCount = 100;
+
+  engine::TaskSet<std::size_t> tasks;
+  for (std::size_t i = 0; i < kTaskCount; ++i) {
+    tasks.Add(engine::AsyncNoSpan([i] { return i * i; }));
+  }
+
+  std::vector<std::size_t> results(kTaskCount);
+  while (const auto index = tasks.NextReady()) {
+    results[*index] = tasks.GetTask(*index).Get();
+  }
+  /// [Sample engine::TaskSet]
+
+  EXPECT_EQ(tasks.GetPendingCount(), 0);
+  for (std::size_t i = 0; i < kTaskCount; ++i) EXPECT_EQ(results[i], i * i);
+}
+
+UTEST_MT(TaskSet, CompletionOrder, 4) {
+  constexpr std::size_t kTaskCount = 4;
+  std::vector<engine::SingleConsumerEvent> events(kTaskCount);
+
+  engine::TaskSet<std::size_t> tasks;
+  for (std::size_t i = 0; i < kTaskCount; ++i) {
+    tasks.Add(engine::AsyncNoSpan([&events, i] {
+      EXPECT_TRUE(events[i].WaitForEventFor(utest::kMaxTestWaitTime));
+      return i;
+    }));
+  }
+  EXPECT_EQ(tasks.GetSize(), kTaskCount);
+
+  for (std::size_t i = kTaskCount; i > 0; --i) {
+    events[i - 1].Send();
+    const auto index = tasks.NextReady();
+    ASSERT_EQ(index, i - 1);
+    EXPECT_EQ(tasks.GetTask(*index).Get(), i - 1);
+    EXPECT_EQ(tasks.GetPendingCount(), i - 1);
+  }
+  EXPECT_EQ(tasks.NextReady(), std::nullopt);
+}
+
+UTEST(TaskSet, FinishedBeforeAdd) {
+  auto task = engine::AsyncNoSpan([] {});
+  task.Wait();
+
+  engine::TaskSet<void> tasks;
+  EXPECT_EQ(tasks.Add(std::move(task)), 0);
+  EXPECT_EQ(tasks.NextReady(), 0);
+  EXPECT_EQ(tasks.NextReady(), std::nullopt);
+}
+
+UTEST(TaskSet, Exception) {
+  engine::TaskSet<void> tasks;
+  tasks.Add(engine::AsyncNoSpan([] { throw std::runtime_error("error"); }));
+
+  const auto index = tasks.NextReady();
+  ASSERT_EQ(index, 0);
+  UEXPECT_THROW(tasks.GetTask(*index).Get(), std::runtime_error);
+}
+
+UTEST(TaskSet, Deadline) {
+  engine::TaskSet<void> tasks;
+  tasks.Add(engine::AsyncNoSpan([] { engine::InterruptibleSleepFor(1h); }));
+
+  EXPECT_EQ(tasks.NextReady(engine::Deadline::FromDuration(10ms)),
+            std::nullopt);
+  EXPECT_EQ(tasks.GetPendingCount(), 1);
+
+  // The task is cancelled on the set destruction
+}
+
+UTEST(TaskSet, Cancelled) {
+  engine::TaskSet<void> tasks;
+  tasks.Add(engine::AsyncNoSpan([] { engine::InterruptibleSleepFor(1h); }));
+
+  engine::current_task::GetCancellationToken().RequestCancel();
+  EXPECT_EQ(tasks.NextReady(), std::nullopt);
+}
+
+USERVER_NAMESPACE_END
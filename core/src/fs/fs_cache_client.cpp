@@ -3,6 +3,7 @@
 #include <boost/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
 
+#include <userver/engine/io/file.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/fs/read.hpp>
 #include <userver/rcu/rcu_map.hpp>
@@ -37,6 +38,24 @@ bool IsFilepathHidden(const std::string& path) {
   return filename[0] == '.';
 }
 
+struct DirectoryEntries {
+  std::vector<std::string> directories;
+  std::vector<std::string> files;
+};
+
+DirectoryEntries ListDirectory(const std::string& path) {
+  DirectoryEntries result;
+  for (boost::filesystem::directory_iterator it(path), end; it != end; ++it) {
+    auto entry_path = path + '/' + it->path().filename().string();
+    if (is_directory(it->status())) {
+      result.directories.push_back(std::move(entry_path));
+    } else if (!IsFilepathHidden(entry_path)) {
+      result.files.push_back(std::move(entry_path));
+    }
+  }
+  return result;
+}
+
 }  // namespace
 #endif  // __linux__
 
@@ -132,19 +151,22 @@ void FsCacheClient::HandleCreateDirectory(
                              linux::EventType::kCreate,
                          });
 
-  for (auto it =
-           utils::Async(
-               tp_, "init",
-               [&path] { return boost::filesystem::directory_iterator(path); })
-               .Get();
-       it != boost::filesystem::directory_iterator();
-       utils::Async(tp_, "next", [&it] { ++it; }).Get()) {
-    if (is_directory(it->status())) {
-      HandleCreateDirectory(inotify,
-                            path + '/' + it->path().filename().string());
-    } else {
-      HandleCreate(path + '/' + it->path().filename().string());
-    }
+  // The directory is listed in a single round trip to tp_, the files are read
+  // in a batch
+  const auto entries = utils::Async(tp_, "list", &ListDirectory, path).Get();
+  auto contents = engine::io::ReadFilesContents(&tp_, entries.files);
+  for (std::size_t i = 0; i < entries.files.size(); ++i) {
+    const auto& file = entries.files[i];
+    FileInfoWithData info{};
+    info.extension = boost::filesystem::path(file).extension().string();
+    info.data = std::move(contents[i]);
+    data_.InsertOrAssign(
+        GetLexicallyRelative(file, dir_),
+        std::make_shared<const FileInfoWithData>(std::move(info)));
+  }
+
+  for (const auto& directory : entries.directories) {
+    HandleCreateDirectory(inotify, directory);
   }
 }
 #endif
@@ -1,6 +1,10 @@
 #include <userver/fs/read.hpp>
 
+#include <vector>
+
+#include <engine/io/io_uring.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/io/file.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/utils/async.hpp>
 
@@ -16,6 +20,20 @@ bool IsHiddenFile(const boost::filesystem::path& path) {
   return name != ".." && name != "." && name[0] == '.';
 }
 
+std::vector<std::string> ListRegularFiles(
+    const std::string& path, utils::Flags<SettingsReadFile> flags) {
+  std::vector<std::string> result;
+  for (boost::filesystem::recursive_directory_iterator it(path), end;
+       it != end; ++it) {
+    // only files
+    if (it->status().type() != boost::filesystem::regular_file) continue;
+    if ((flags & SettingsReadFile::kSkipHidden) && IsHiddenFile(it->path()))
+      continue;
+    result.push_back(it->path().string());
+  }
+  return result;
+}
+
 }  // namespace
 
 std::string GetLexicallyRelative(std::string_view path, std::string_view dir) {
@@ -27,6 +45,9 @@ std::string GetLexicallyRelative(std::string_view path, std::string_view dir) {
 
 std::string ReadFileContents(engine::TaskProcessor& async_tp,
                              const std::string& path) {
+  if (auto* io_uring = engine::io::impl::GetCurrentIoUring()) {
+    return io_uring->ReadFileContents(path);
+  }
   return engine::AsyncNoSpan(async_tp, &fs::blocking::ReadFileContents, path)
       .Get();
 }
@@ -34,24 +55,18 @@ std::string ReadFileContents(engine::TaskProcessor& async_tp,
 FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
     engine::TaskProcessor& async_tp, const std::string& path,
     utils::Flags<SettingsReadFile> flags) {
+  // The directory is traversed in a single round trip to async_tp, the files
+  // are read in a batch
+  const auto paths =
+      utils::Async(async_tp, "list", &ListRegularFiles, path, flags).Get();
+  auto contents = engine::io::ReadFilesContents(&async_tp, paths);
+
   FileInfoWithDataMap data{};
-  for (auto it =
-           utils::Async(
-               async_tp, "init",
-               [&path] {
-                 return boost::filesystem::recursive_directory_iterator(path);
-               })
-               .Get();
-       it != boost::filesystem::recursive_directory_iterator();
-       utils::Async(async_tp, "next", [&it] { ++it; }).Get()) {
-    // only files
-    if (it->status().type() != boost::filesystem::regular_file) continue;
-    if ((flags & SettingsReadFile::kSkipHidden) && IsHiddenFile(it->path()))
-      continue;
+  for (std::size_t i = 0; i < paths.size(); ++i) {
     FileInfoWithData info{};
-    info.extension = it->path().extension().string();
-    info.data = ReadFileContents(async_tp, it->path().string());
-    data[GetLexicallyRelative(it->path().string(), path)] =
+    info.extension = boost::filesystem::path(paths[i]).extension().string();
+    info.data = std::move(contents[i]);
+    data[GetLexicallyRelative(paths[i], path)] =
         std::make_shared<const FileInfoWithData>(std::move(info));
   }
   return data;
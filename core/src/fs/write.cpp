@@ -2,6 +2,7 @@
 
 #include <fmt/format.h>
 
+#include <engine/io/io_uring.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/fs/blocking/write.hpp>
 
@@ -24,6 +25,10 @@ void CreateDirectories(engine::TaskProcessor& async_tp, std::string_view path) {
 
 void RewriteFileContents(engine::TaskProcessor& async_tp,
                          const std::string& path, std::string_view contents) {
+  if (auto* io_uring = engine::io::impl::GetCurrentIoUring()) {
+    io_uring->RewriteFileContents(path, contents);
+    return;
+  }
   engine::AsyncNoSpan(async_tp, &fs::blocking::RewriteFileContents, path,
                       contents)
       .Get();
@@ -4,6 +4,7 @@
 #include <stdexcept>
 
 #include <logging/config.hpp>
+#include <logging/dynamic_debug.hpp>
 #include <logging/impl/tcp_socket_sink.hpp>
 #include <logging/tp_logger.hpp>
 #include <logging/tp_logger_utils.hpp>
@@ -17,6 +18,7 @@
 #include <userver/logging/logger.hpp>
 #include <userver/os_signals/component.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/utils/statistics/rate.hpp>
 #include <userver/utils/statistics/writer.hpp>
 #include <userver/utils/thread_name.hpp>
 #include <userver/yaml_config/map_to_array.hpp>
@@ -210,6 +212,16 @@ void Logging::WriteStatistics(utils::statistics::Writer& writer) const {
     writer.ValueWithLabels(logger->GetStatistics(),
                            {"logger", logger->GetLoggerName()});
   }
+
+  // Only the log sites that dropped something, there are thousands of them
+  auto sampling_writer = writer["sampling"]["dropped"];
+  for (const auto& location : logging::GetDynamicDebugLocations()) {
+    const auto dropped = location.sampling.dropped.load();
+    if (dropped == 0) continue;
+    sampling_writer.ValueWithLabels(
+        utils::statistics::Rate{dropped},
+        {"location", fmt::format("{}:{}", location.path, location.line)});
+  }
 }
 
 void Logging::FlushLogs() {
@@ -252,13 +264,14 @@ properties:
                       - tskv
                       - ltsv
                       - raw
+                      - binary
                 flush_level:
                     type: string
                     description: messages of this and higher levels get flushed to the file immediately
                     defaultDescription: warning
                 message_queue_size:
                     type: integer
-                    description: the size of internal message queue, must be a power of 2
+                    description: the size of internal message queue of each thread, must be a power of 2
                     defaultDescription: 65536
                 overflow_behavior:
                     type: string
@@ -267,6 +280,10 @@ properties:
                     enum:
                       - discard
                       - block
+                batched_writes:
+                    type: boolean
+                    description: write the messages of each logging batch to the file with a single system call instead of stdio buffering
+                    defaultDescription: false
                 fs-task-processor:
                     type: string
                     description: task processor for disk I/O operations for this logger
@@ -52,6 +52,9 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
       value["overflow_behavior"].As<QueueOverflowBehavior>(
           config.queue_overflow_behavior);
 
+  config.batched_writes =
+      value["batched_writes"].As<bool>(config.batched_writes);
+
   config.fs_task_processor =
       value["fs-task-processor"].As<std::optional<std::string>>();
 
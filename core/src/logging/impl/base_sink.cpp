@@ -16,6 +16,8 @@ void BaseSink::Log(const LogMessage& message) {
 
 void BaseSink::Flush() {}
 
+void BaseSink::EndBatch() {}
+
 void BaseSink::Reopen(ReopenMode) {}
 
 void BaseSink::SetLevel(Level log_level) { level_.store(log_level); }
@@ -24,6 +24,10 @@ class BaseSink {
 
   virtual void Flush();
 
+  /// Called by the logger after writing a batch of messages, sinks that
+  /// accumulate messages should write them out.
+  virtual void EndBatch();
+
   virtual void Reopen(ReopenMode);
 
   void SetLevel(Level log_level);
@@ -0,0 +1,111 @@
+#include "batched_file_sink.hpp"
+
+#include <sys/uio.h>
+
+#include <cerrno>
+#include <system_error>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+#include "open_file_helper.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+void WriteAll(int fd, ::iovec* iov, int iov_count) {
+  while (iov_count > 0) {
+    ::ssize_t written = ::writev(fd, iov, iov_count);
+    if (written < 0) {
+      if (errno == EAGAIN || errno == EINTR) continue;
+
+      const auto code = std::make_error_code(std::errc{errno});
+      throw std::system_error(code, "calling ::writev");
+    }
+
+    // Skip the fully written parts and adjust the partially written one
+    while (iov_count > 0 &&
+           static_cast<std::size_t>(written) >= iov->iov_len) {
+      written -= iov->iov_len;
+      ++iov;
+      --iov_count;
+    }
+    if (iov_count > 0) {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+      iov->iov_len -= written;
+    }
+  }
+}
+
+}  // namespace
+
+BatchedFileSink::BatchedFileSink(const std::string& filename,
+                                 std::size_t buffer_size)
+    : filename_{filename},
+      buffer_size_{buffer_size},
+      fd_{OpenFile<fs::blocking::FileDescriptor>(filename)} {
+  buffer_.reserve(buffer_size_);
+  if (fd_.GetSize() > 0) {
+    fd_.Write("\n");
+  }
+}
+
+BatchedFileSink::~BatchedFileSink() {
+  try {
+    if (fd_.IsOpen()) WriteBuffer();
+  } catch (const std::exception& e) {
+    UASSERT_MSG(false, std::string{"Failed to write the remaining logs: "} +
+                           e.what());
+  }
+}
+
+void BatchedFileSink::Reopen(ReopenMode mode) {
+  WriteBuffer();
+  auto new_fd = OpenFile<fs::blocking::FileDescriptor>(filename_, mode);
+  std::move(fd_).Close();
+  fd_ = std::move(new_fd);
+}
+
+void BatchedFileSink::Flush() {
+  if (fd_.IsOpen()) {
+    WriteBuffer();
+  }
+}
+
+void BatchedFileSink::EndBatch() { WriteBuffer(); }
+
+void BatchedFileSink::Write(std::string_view log) {
+  if (buffer_.size() + log.size() <= buffer_size_) {
+    buffer_.append(log);
+  } else {
+    // Big records are written directly, without copying to the buffer
+    WriteBuffer(log);
+  }
+}
+
+void BatchedFileSink::WriteBuffer(std::string_view extra) {
+  ::iovec iov[2]{};
+  int iov_count = 0;
+  if (!buffer_.empty()) {
+    iov[iov_count++] = {buffer_.data(), buffer_.size()};
+  }
+  if (!extra.empty()) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    iov[iov_count++] = {const_cast<char*>(extra.data()), extra.size()};
+  }
+  if (iov_count == 0) return;
+
+  // The buffer is dropped even on errors, so that a broken disk does not make
+  // the sink accumulate records forever.
+  const utils::FastScopeGuard clear_guard{[this]() noexcept {
+    buffer_.clear();
+  }};
+  WriteAll(fd_.GetNative(), iov, iov_count);
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <userver/fs/blocking/file_descriptor.hpp>
+
+#include "base_sink.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// @brief File sink that accumulates the records of a logger batch and writes
+/// them out with a single system call.
+///
+/// Records are written on EndBatch(), on Flush() or when the buffer is full.
+/// Unlike FdSink, Flush() does not fsync the file.
+class BatchedFileSink final : public BaseSink {
+ public:
+  static constexpr std::size_t kDefaultBufferSize = 256 * 1024;
+
+  explicit BatchedFileSink(const std::string& filename,
+                           std::size_t buffer_size = kDefaultBufferSize);
+  ~BatchedFileSink() override;
+
+  void Reopen(ReopenMode mode) override;
+
+  void Flush() override;
+
+  void EndBatch() override;
+
+ protected:
+  void Write(std::string_view log) override;
+
+ private:
+  void WriteBuffer(std::string_view extra = {});
+
+  const std::string filename_;
+  const std::size_t buffer_size_;
+  fs::blocking::FileDescriptor fd_;
+  std::string buffer_;
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
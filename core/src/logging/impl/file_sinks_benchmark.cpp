@@ -3,6 +3,7 @@
 #include <userver/fs/blocking/temp_directory.hpp>
 #include <userver/utils/rand.hpp>
 
+#include "batched_file_sink.hpp"
 #include "buffered_file_sink.hpp"
 #include "file_sink.hpp"
 
@@ -38,4 +39,23 @@ void check_buffered_file_sink(benchmark::State& state) {
 }
 BENCHMARK(check_buffered_file_sink);
 
+// The logger ends a batch after each wakeup, so the batch size depends on
+// the load
+void check_batched_file_sink(benchmark::State& state) {
+  const auto temp_root = fs::blocking::TempDirectory::Create();
+  const std::string filename =
+      temp_root.GetPath() + "/temp_file_" + std::to_string(utils::Rand());
+  auto sink = logging::impl::BatchedFileSink(filename);
+  const auto batch_size = state.range(0);
+  for ([[maybe_unused]] auto _ : state) {
+    for (auto i = 0; i < kCountLogs; ++i) {
+      sink.Log({"message\n", logging::Level::kWarning});
+      if ((i + 1) % batch_size == 0) sink.EndBatch();
+    }
+    sink.EndBatch();
+  }
+  sink.Flush();
+}
+BENCHMARK(check_batched_file_sink)->RangeMultiplier(8)->Range(1, 4096);
+
 USERVER_NAMESPACE_END
@@ -8,6 +8,7 @@
 #include <userver/utest/parameter_names.hpp>
 #include <userver/utest/utest.hpp>
 
+#include "batched_file_sink.hpp"
 #include "buffered_file_sink.hpp"
 #include "sink_helper_test.hpp"
 
@@ -30,6 +31,10 @@ SinkPtr MakeBufferedFileSink(const std::string& filename) {
   return std::make_unique<logging::impl::BufferedFileSink>(filename);
 }
 
+SinkPtr MakeBatchedFileSink(const std::string& filename) {
+  return std::make_unique<logging::impl::BatchedFileSink>(filename);
+}
+
 class FileSinks : public testing::TestWithParam<SinkFactory> {
  protected:
   const std::string& GetTempRootPath() const { return temp_root_.GetPath(); }
@@ -191,7 +196,30 @@ UTEST_P(FileSinks, TestValidWriteMultiInFile) {
 INSTANTIATE_UTEST_SUITE_P(/* no prefix */, FileSinks,
                           testing::Values(SinkFactory{"FileSink", MakeFileSink},
                                           SinkFactory{"BufferedFileSink",
-                                                      MakeBufferedFileSink}),
+                                                      MakeBufferedFileSink},
+                                          SinkFactory{"BatchedFileSink",
+                                                      MakeBatchedFileSink}),
                           utest::PrintTestName());
 
+UTEST(BatchedFileSink, WritesOnBatchEnd) {
+  const auto temp_root = fs::blocking::TempDirectory::Create();
+  const auto filename = temp_root.GetPath() + "/temp_file";
+  logging::impl::BatchedFileSink sink{filename, /*buffer_size=*/32};
+
+  sink.Log({"message\n", logging::Level::kInfo});
+  sink.Log({"message 2\n", logging::Level::kInfo});
+  EXPECT_EQ(test::ReadFromFile(filename), test::Messages());
+
+  sink.EndBatch();
+  EXPECT_EQ(test::ReadFromFile(filename),
+            test::Messages("message", "message 2"));
+
+  // Records that do not fit into the buffer are written immediately
+  const std::string big(64, 'x');
+  sink.Log({"message 3\n", logging::Level::kInfo});
+  sink.Log({big + "\n", logging::Level::kInfo});
+  EXPECT_EQ(test::ReadFromFile(filename),
+            test::Messages("message", "message 2", "message 3", big));
+}
+
 USERVER_NAMESPACE_END
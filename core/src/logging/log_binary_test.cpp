@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <logging/logging_test.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/log_extra.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct BinaryField {
+  std::string key;
+  char type;
+  std::string value;
+};
+
+struct BinaryRecord {
+  std::uint64_t timestamp_us;
+  logging::Level level;
+  std::vector<BinaryField> fields;
+
+  const BinaryField& Get(std::string_view key) const {
+    for (const auto& field : fields) {
+      if (field.key == key) return field;
+    }
+    throw std::runtime_error("no field " + std::string{key});
+  }
+};
+
+std::uint64_t Read(std::string_view& data, std::size_t size) {
+  if (data.size() < size) throw std::runtime_error("truncated record");
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    value |= std::uint64_t{static_cast<unsigned char>(data[i])} << (i * 8);
+  }
+  data.remove_prefix(size);
+  return value;
+}
+
+std::string ReadBytes(std::string_view& data, std::size_t size) {
+  if (data.size() < size) throw std::runtime_error("truncated record");
+  std::string result{data.substr(0, size)};
+  data.remove_prefix(size);
+  return result;
+}
+
+std::vector<BinaryRecord> ParseRecords(std::string_view data) {
+  std::vector<BinaryRecord> records;
+  while (!data.empty()) {
+    const auto storage = ReadBytes(data, Read(data, 4));
+    std::string_view record_data{storage};
+
+    BinaryRecord record{};
+    record.timestamp_us = Read(record_data, 8);
+    record.level = static_cast<logging::Level>(Read(record_data, 1));
+    while (!record_data.empty()) {
+      BinaryField field;
+      field.key = ReadBytes(record_data, Read(record_data, 2));
+      field.type = static_cast<char>(Read(record_data, 1));
+      field.value = ReadBytes(record_data, Read(record_data, 4));
+      record.fields.push_back(std::move(field));
+    }
+    records.push_back(std::move(record));
+  }
+  return records;
+}
+
+template <typename T>
+T AsTyped(const BinaryField& field) {
+  T value{};
+  EXPECT_EQ(sizeof(value), field.value.size());
+  std::memcpy(&value, field.value.data(), sizeof(value));
+  return value;
+}
+
+}  // namespace
+
+TEST_F(LoggingBinaryTest, Basic) {
+  LOG_INFO() << "text\twith\nspecial=chars";
+  LOG_WARNING() << "second";
+  logging::LogFlush();
+
+  const auto records = ParseRecords(GetStreamString());
+  ASSERT_EQ(records.size(), 2);
+
+  EXPECT_EQ(records[0].level, logging::Level::kInfo);
+  EXPECT_EQ(records[0].Get("text").value, "text\twith\nspecial=chars");
+  EXPECT_NE(records[0].Get("module").value.find("log_binary_test.cpp"),
+            std::string::npos);
+  EXPECT_GT(records[0].timestamp_us, 0);
+
+  EXPECT_EQ(records[1].level, logging::Level::kWarning);
+  EXPECT_EQ(records[1].Get("text").value, "second");
+  EXPECT_LE(records[0].timestamp_us, records[1].timestamp_us);
+}
+
+TEST_F(LoggingBinaryTest, TypedValues) {
+  LOG_INFO() << logging::LogExtra{{"int", -42},
+                                  {"uint", std::uint64_t{42}},
+                                  {"double", 0.5},
+                                  {"string", "value"}};
+  LOG_INFO() << true;
+  LOG_INFO() << 42 << " apples";
+  logging::LogFlush();
+
+  const auto records = ParseRecords(GetStreamString());
+  ASSERT_EQ(records.size(), 3);
+
+  const auto& record = records[0];
+  EXPECT_EQ(record.Get("int").type, 1);
+  EXPECT_EQ(AsTyped<std::int64_t>(record.Get("int")), -42);
+  EXPECT_EQ(record.Get("uint").type, 2);
+  EXPECT_EQ(AsTyped<std::uint64_t>(record.Get("uint")), 42);
+  EXPECT_EQ(record.Get("double").type, 3);
+  EXPECT_EQ(AsTyped<double>(record.Get("double")), 0.5);
+  EXPECT_EQ(record.Get("string").type, 0);
+  EXPECT_EQ(record.Get("string").value, "value");
+
+  EXPECT_EQ(records[1].Get("text").type, 4);
+  EXPECT_EQ(records[1].Get("text").value, std::string(1, '\1'));
+
+  // Text appended to a typed value turns it into a string
+  EXPECT_EQ(records[2].Get("text").type, 0);
+  EXPECT_EQ(records[2].Get("text").value, "42 apples");
+}
+
+USERVER_NAMESPACE_END
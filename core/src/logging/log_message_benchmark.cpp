@@ -15,7 +15,8 @@ namespace {
 
 class NoopLogger : public logging::impl::LoggerBase {
  public:
-  NoopLogger() noexcept : LoggerBase(logging::Format::kRaw) {
+  explicit NoopLogger(logging::Format format = logging::Format::kRaw) noexcept
+      : LoggerBase(format) {
     SetLevel(logging::Level::kInfo);
   }
   void Log(logging::Level, std::string_view) override {}
@@ -162,6 +163,23 @@ void LogPrependedTags(benchmark::State& state) {
 }
 BENCHMARK(LogPrependedTags);
 
+// Compares the per-call cost of the text and binary formats
+void LogFormats(benchmark::State& state) {
+  const auto format = static_cast<logging::Format>(state.range(0));
+  const logging::DefaultLoggerGuard guard{std::make_shared<NoopLogger>(format)};
+  const auto msg = Launder(std::string(state.range(1), '*'));
+
+  for ([[maybe_unused]] auto _ : state) {
+    LOG_INFO() << msg << logging::LogExtra{{"int_tag", 42},
+                                           {"double_tag", 42.5},
+                                           {"string_tag", "value\twith tab"}};
+  }
+}
+BENCHMARK(LogFormats)
+    ->ArgsProduct({{static_cast<int>(logging::Format::kTskv),
+                    static_cast<int>(logging::Format::kBinary)},
+                   {8, 256, 4 << 10}});
+
 }  // namespace
 
 USERVER_NAMESPACE_END
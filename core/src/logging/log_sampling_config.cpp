@@ -0,0 +1,45 @@
+#include "log_sampling_config.hpp"
+
+#include <fmt/format.h>
+
+#include <userver/formats/common/items.hpp>
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+bool operator==(const LogSamplingSettings& a, const LogSamplingSettings& b) {
+  return a.site_records_per_second == b.site_records_per_second &&
+         a.site_burst == b.site_burst &&
+         a.level_probability == b.level_probability;
+}
+
+LogSamplingSettings Parse(const formats::json::Value& value,
+                          formats::parse::To<LogSamplingSettings>) {
+  LogSamplingSettings settings;
+
+  const auto site_limit = value["site-rate-limit"];
+  settings.site_records_per_second =
+      site_limit["records-per-second"].As<double>(0);
+  settings.site_burst = site_limit["burst"].As<std::uint32_t>(0);
+
+  for (const auto& [name, probability] :
+       Items(value["level-probability"])) {
+    const auto level = LevelFromString(name);
+    const auto parsed = probability.As<double>();
+    if (parsed < 0 || parsed > 1) {
+      throw formats::json::ParseException(fmt::format(
+          "Log sampling probability of '{}' must be in [0, 1], got {}", name,
+          parsed));
+    }
+    settings.level_probability[static_cast<int>(level)] = parsed;
+  }
+
+  return settings;
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
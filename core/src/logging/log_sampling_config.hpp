@@ -0,0 +1,22 @@
+#pragma once
+
+#include <userver/formats/parse/to.hpp>
+
+#include <logging/log_sampling.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+class Value;
+}
+
+namespace logging::impl {
+
+bool operator==(const LogSamplingSettings& a, const LogSamplingSettings& b);
+
+LogSamplingSettings Parse(const formats::json::Value&,
+                          formats::parse::To<LogSamplingSettings>);
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
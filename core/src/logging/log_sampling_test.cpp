@@ -0,0 +1,93 @@
+#include <userver/utest/utest.hpp>
+
+#include <logging/dynamic_debug.hpp>
+#include <logging/log_sampling.hpp>
+#include <logging/logging_test.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+auto SetSamplingScope(const logging::impl::LogSamplingSettings& settings) {
+  logging::impl::SetLogSampling(settings);
+  return utils::FastScopeGuard(
+      []() noexcept { logging::impl::SetLogSampling({}); });
+}
+
+}  // namespace
+
+TEST_F(LoggingTest, SamplingSiteRateLimit) {
+  logging::impl::LogSamplingSettings settings;
+  settings.site_records_per_second = 0.001;
+  settings.site_burst = 9;
+  const auto scope = SetSamplingScope(settings);
+
+  for (int i = 0; i < 100; ++i) {
+    LOG_INFO() << "limited";
+  }
+  LOG_INFO() << "other site";
+
+  EXPECT_EQ(GetRecordsCount(), 11);
+}
+
+TEST_F(LoggingTest, SamplingLevelProbability) {
+  logging::impl::LogSamplingSettings settings;
+  settings.level_probability[static_cast<int>(logging::Level::kInfo)] = 0;
+  const auto scope = SetSamplingScope(settings);
+
+  for (int i = 0; i < 100; ++i) {
+    LOG_INFO() << "sampled out";
+  }
+  LOG_WARNING() << "kept";
+
+  EXPECT_EQ(GetRecordsCount(), 1);
+  EXPECT_TRUE(LoggedTextContains("kept"));
+}
+
+TEST_F(LoggingTest, SamplingForceEnabled) {
+  const std::string filename{USERVER_FILEPATH};
+  logging::impl::LogSamplingSettings settings;
+  settings.level_probability[static_cast<int>(logging::Level::kInfo)] = 0;
+  const auto scope = SetSamplingScope(settings);
+
+  const auto do_log = [] {
+#line 30001
+    LOG_INFO() << "forced";
+  };
+
+  logging::AddDynamicDebugLog(filename, 30001);
+  do_log();
+  logging::RemoveDynamicDebugLog(filename, 30001);
+
+  EXPECT_EQ(GetRecordsCount(), 1);
+}
+
+UTEST_F(LoggingTest, SamplingKeepsWholeTraces) {
+  logging::impl::LogSamplingSettings settings;
+  settings.level_probability[static_cast<int>(logging::Level::kInfo)] = 0.5;
+  const auto scope = SetSamplingScope(settings);
+
+  std::size_t kept_traces = 0;
+  constexpr std::size_t kTraces = 100;
+  for (std::size_t trace = 0; trace < kTraces; ++trace) {
+    ClearLog();
+    {
+      tracing::Span span{"trace"};
+      span.SetLogLevel(logging::Level::kNone);
+      for (int i = 0; i < 10; ++i) {
+        LOG_INFO() << "record";
+      }
+    }
+
+    const auto records = GetRecordsCount();
+    EXPECT_TRUE(records == 0 || records == 10) << records;
+    if (records != 0) ++kept_traces;
+  }
+
+  EXPECT_GT(kept_traces, 0);
+  EXPECT_LT(kept_traces, kTraces);
+}
+
+USERVER_NAMESPACE_END
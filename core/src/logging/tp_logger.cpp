@@ -1,8 +1,13 @@
 #include "tp_logger.hpp"
 
+#include <algorithm>
+#include <array>
+#include <functional>
+
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
+#include <userver/compiler/thread_local.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
@@ -14,13 +19,86 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
-struct TpLogger::ActionVisitor final {
-  TpLogger& logger;
+namespace {
+
+struct CachedBuffer final {
+  std::uint64_t logger_id{0};
+  async::LogBuffer* buffer{nullptr};
+};
+
+// Most threads write into a handful of loggers, older entries are evicted.
+constexpr std::size_t kCachedBuffersCount = 4;
+using BufferCache = std::array<CachedBuffer, kCachedBuffersCount>;
 
-  void operator()(impl::async::Log&& log) const {
-    logger.AccountLogConsumed();
-    logger.BackendLog(std::move(log));
+compiler::ThreadLocal local_buffers = [] { return BufferCache{}; };
+
+std::atomic<std::uint64_t> next_logger_id{1};
+
+}  // namespace
+
+namespace async {
+
+LogBuffer::LogBuffer(std::thread::id owner) : owner_(owner) {
+  wakeup_node.action = DrainBuffer{this};
+  auto* const stub = new Node{};
+  producer_->tail = stub;
+  consumer_->head = stub;
+}
+
+LogBuffer::~LogBuffer() {
+  auto* node = consumer_->head;
+  while (node) {
+    auto* const next = node->next.load(std::memory_order_relaxed);
+    delete node;
+    node = next;
   }
+}
+
+bool LogBuffer::Push(Log&& log) {
+  auto* const node = new Node{{nullptr}, std::move(log)};
+  producer_->produced.store(
+      producer_->produced.load(std::memory_order_relaxed) + 1,
+      std::memory_order_relaxed);
+
+  // seq_cst pairs with ResetWakeUp + TryPop: either the consumer sees the new
+  // node, or we see that the wakeup has been reset.
+  producer_->tail->next.store(node);
+  producer_->tail = node;
+
+  if (wakeup_pending_->load()) return false;
+  // Only the producer sets the flag, the consumer only resets it after
+  // popping the wakeup node.
+  wakeup_pending_->store(true);
+  return true;
+}
+
+void LogBuffer::ResetWakeUp() noexcept { wakeup_pending_->store(false); }
+
+std::optional<Log> LogBuffer::TryPop() noexcept {
+  auto* const head = consumer_->head;
+  auto* const next = head->next.load();
+  if (!next) return std::nullopt;
+
+  // 'next' becomes the new stub node.
+  std::optional<Log> result{std::move(next->log)};
+  consumer_->head = next;
+  delete head;
+
+  consumer_->consumed.store(
+      consumer_->consumed.load(std::memory_order_relaxed) + 1,
+      std::memory_order_relaxed);
+  return result;
+}
+
+LogBuffer::Size LogBuffer::GetSize() const noexcept {
+  return producer_->produced.load(std::memory_order_relaxed) -
+         consumer_->consumed.load(std::memory_order_relaxed);
+}
+
+}  // namespace async
+
+struct TpLogger::ActionVisitor final {
+  TpLogger& logger;
 
   void operator()(impl::async::Stop&&) const noexcept {
     // The consumer thread will check state_ later.
@@ -37,6 +115,10 @@ struct TpLogger::ActionVisitor final {
     }
   }
 
+  void operator()(impl::async::DrainBuffer&&) const noexcept {
+    UASSERT_MSG(false, "Wakeup nodes are not performed as actions");
+  }
+
   template <class Flush>
   void operator()(Flush&& flush) const {
     logger.BackendFlush();
@@ -45,7 +127,9 @@ struct TpLogger::ActionVisitor final {
 };
 
 TpLogger::TpLogger(Format format, std::string logger_name)
-    : LoggerBase(format), logger_name_(std::move(logger_name)) {
+    : LoggerBase(format),
+      logger_name_(std::move(logger_name)),
+      id_(next_logger_id.fetch_add(1, std::memory_order_relaxed)) {
   SetLevel(logging::Level::kInfo);
 }
 
@@ -85,6 +169,13 @@ TpLogger::~TpLogger() {
   UASSERT_MSG(!consuming_task_.IsValid(),
               "We may be in non coroutine context, async logger must be in "
               "sync mode and consuming task must be stopped");
+
+  auto* buffer = buffers_.load();
+  while (buffer) {
+    auto* const next = buffer->next;
+    delete buffer;
+    buffer = next;
+  }
 }
 
 void TpLogger::StopConsumerTask() {
@@ -134,15 +225,17 @@ void TpLogger::Log(Level level, std::string_view msg) {
 
   impl::async::Log action{level, std::string{msg}};
 
-  if (TryWaitFreeQueueCapacity()) {
-    // The queue might have concurrently become full, in which case the size
-    // will temporarily go over the max size. The actual number of log actions
-    // in queue_ will not typically go over max_size + n_threads.
-    produced_->fetch_add(1);
-
-    Push(std::move(action));
-  } else {
+  // There must be no context switches between getting the buffer and pushing
+  // into it, otherwise the task may migrate to another thread and break the
+  // single producer guarantee.
+  auto* const buffer = TryWaitFreeQueueCapacity();
+  if (!buffer) {
     ++stats_.dropped;
+    return;
+  }
+
+  if (buffer->Push(std::move(action))) {
+    DoPush(buffer->wakeup_node);
   }
 }
 
@@ -157,6 +250,15 @@ void TpLogger::PrependCommonTags(TagWriter writer) const {
   writer.PutTag("thread_id", Hex{thread_id});
 }
 
+std::uint64_t TpLogger::GetSamplingKey() const noexcept {
+  const auto* const span = tracing::Span::CurrentSpanUnchecked();
+  if (!span) return 0;
+
+  // Services that share the trace make the same sampling decisions
+  const auto key = std::hash<std::string_view>{}(span->GetTraceId());
+  return key == 0 ? 1 : key;
+}
+
 bool TpLogger::DoShouldLog(Level level) const noexcept {
   const auto* const span = tracing::Span::CurrentSpanUnchecked();
   if (span) {
@@ -200,6 +302,7 @@ void TpLogger::ProcessingLoop() {
 
   while (true) {
     ConsumeQueueOnce(queue_consumer_);
+    BackendEndBatch();
     if (state_ != State::kAsync) {
       UASSERT(state_ == State::kStoppingAsync);
       break;
@@ -219,27 +322,70 @@ void TpLogger::BackendPerform(impl::async::Action&& action) noexcept {
   }
 }
 
-bool TpLogger::HasFreeQueueCapacity() noexcept {
-  return produced_->load() - consumed_->load() < max_queue_size_.load();
+impl::async::LogBuffer& TpLogger::GetThreadBuffer() {
+  {
+    auto cache = local_buffers.Use();
+    for (const auto& entry : *cache) {
+      if (entry.logger_id == id_) return *entry.buffer;
+    }
+  }
+
+  auto& buffer = FindOrAddBuffer(std::this_thread::get_id());
+
+  auto cache = local_buffers.Use();
+  std::move_backward(cache->begin(), cache->end() - 1, cache->end());
+  cache->front() = CachedBuffer{id_, &buffer};
+  return buffer;
+}
+
+impl::async::LogBuffer& TpLogger::FindOrAddBuffer(std::thread::id thread_id) {
+  // Thread ids may be reused by the OS, in which case the new thread takes
+  // over the buffer of the finished one.
+  for (auto* buffer = buffers_.load(); buffer; buffer = buffer->next) {
+    if (buffer->GetOwner() == thread_id) return *buffer;
+  }
+
+  auto buffer = std::make_unique<impl::async::LogBuffer>(thread_id);
+  buffer->next = buffers_.load(std::memory_order_relaxed);
+  while (!buffers_.compare_exchange_weak(buffer->next, buffer.get(),
+                                         std::memory_order_release,
+                                         std::memory_order_relaxed)) {
+  }
+  return *buffer.release();
+}
+
+bool TpLogger::HasFreeQueueCapacity(
+    const impl::async::LogBuffer& buffer) noexcept {
+  return buffer.GetSize() < max_queue_size_.load();
 }
 
-bool TpLogger::TryWaitFreeQueueCapacity() {
-  if (HasFreeQueueCapacity()) {
-    return true;
+impl::async::LogBuffer* TpLogger::TryWaitFreeQueueCapacity() {
+  auto* buffer = &GetThreadBuffer();
+  if (HasFreeQueueCapacity(*buffer)) {
+    return buffer;
   }
 
   // Do not do blocking push if we are not in a coroutine context.
   if (overflow_policy_.load() != QueueOverflowBehavior::kBlock ||
       !engine::current_task::IsTaskProcessorThread()) {
-    return false;
+    return nullptr;
   }
 
   const engine::TaskCancellationBlocker block_cancel;
-  std::unique_lock lock{capacity_waiters_mutex_};
-  [[maybe_unused]] const bool success = capacity_waiters_cv_.Wait(
-      lock, [this] { return HasFreeQueueCapacity(); });
-  UASSERT(success);
-  return true;
+  while (true) {
+    {
+      std::unique_lock lock{capacity_waiters_mutex_};
+      [[maybe_unused]] const bool success = capacity_waiters_cv_.Wait(
+          lock, [this, buffer] { return HasFreeQueueCapacity(*buffer); });
+      UASSERT(success);
+    }
+
+    // The task might have been woken up on another thread.
+    buffer = &GetThreadBuffer();
+    if (HasFreeQueueCapacity(*buffer)) {
+      return buffer;
+    }
+  }
 }
 
 void TpLogger::Push(impl::async::Action&& action) {
@@ -255,19 +401,18 @@ void TpLogger::DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept {
   }
 }
 
-void TpLogger::AccountLogConsumed() noexcept {
-  consumed_->store(consumed_->load(std::memory_order_relaxed) + 1,
-                   std::memory_order_relaxed);
+void TpLogger::NotifyCapacityWaiters() noexcept {
   if (overflow_policy_.load() == QueueOverflowBehavior::kBlock) {
     {
-      // Atomic consumed_ mutation doesn't need to be protected by lock.
+      // Atomic buffer size mutation doesn't need to be protected by lock.
       // With this lock in place, a waiter can check + wait either:
       // 1. before us locking, then we will notify the waiter, or
       // 2. after us locking, then the waiter will receive our updates and
       //    not fall asleep
       const std::lock_guard lock{capacity_waiters_mutex_};
     }
-    capacity_waiters_cv_.NotifyOne();
+    // Waiters wait for different buffers.
+    capacity_waiters_cv_.NotifyAll();
   }
 }
 
@@ -275,12 +420,47 @@ void TpLogger::ConsumeNode(
     concurrent::impl::SinglyLinkedBaseHook& node) noexcept {
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
   auto& action_node = static_cast<impl::async::ActionNode&>(node);
+
+  // Wakeup nodes are owned by the buffers and are reused.
+  if (auto* const drain =
+          std::get_if<impl::async::DrainBuffer>(&action_node.action)) {
+    drain->buffer->ResetWakeUp();
+    ConsumeBuffer(*drain->buffer);
+    return;
+  }
+
+  // Records logged before a flush, a reopen or a stop must be written first.
+  ConsumeAllBuffers();
   if (&action_node == &stop_node_) return;
 
   BackendPerform(std::move(action_node.action));
   delete &action_node;
 }
 
+void TpLogger::ConsumeBuffer(impl::async::LogBuffer& buffer) noexcept {
+  bool consumed_any = false;
+  while (auto log = buffer.TryPop()) {
+    consumed_any = true;
+    try {
+      BackendLog(std::move(*log));
+    } catch (const std::exception& e) {
+      UASSERT_MSG(false, fmt::format(
+                             "Exception while doing an async logging: {}",
+                             e.what()));
+    }
+  }
+
+  if (consumed_any) {
+    NotifyCapacityWaiters();
+  }
+}
+
+void TpLogger::ConsumeAllBuffers() noexcept {
+  for (auto* buffer = buffers_.load(); buffer; buffer = buffer->next) {
+    ConsumeBuffer(*buffer);
+  }
+}
+
 void TpLogger::ConsumeQueueOnce(Queue::Consumer& consumer) noexcept {
   while (auto* const node_base = consumer.TryPop()) {
     ConsumeNode(*node_base);
@@ -290,6 +470,7 @@ void TpLogger::ConsumeQueueOnce(Queue::Consumer& consumer) noexcept {
 void TpLogger::CleanUpQueue(Queue::Consumer&& consumer) noexcept {
   std::move(consumer).ConsumeAndStop(
       [this](auto& node) noexcept { ConsumeNode(node); });
+  BackendEndBatch();
 }
 
 void TpLogger::BackendLog(impl::async::Log&& action) const {
@@ -322,6 +503,18 @@ void TpLogger::BackendFlush() const {
   }
 }
 
+void TpLogger::BackendEndBatch() const noexcept {
+  for (const auto& sink : GetSinks()) {
+    try {
+      sink->EndBatch();
+    } catch (const std::exception& e) {
+      UASSERT_MSG(false, "While writing a batch of log messages caught an "
+                         "exception: " +
+                             std::string(e.what()));
+    }
+  }
+}
+
 void TpLogger::BackendReopen(ReopenMode reopen_mode) const {
   std::string result_messages{};
   for (const auto& [index, sink] : utils::enumerate(GetSinks())) {
@@ -1,14 +1,19 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <future>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <variant>
 #include <vector>
 
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/concurrent/impl/intrusive_hooks.hpp>
 #include <userver/engine/condition_variable.hpp>
 #include <userver/engine/future.hpp>
 #include <userver/engine/mutex.hpp>
@@ -16,8 +21,6 @@
 #include <userver/logging/format.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 
-#include <concurrent/impl/interference_shield.hpp>
-#include <concurrent/impl/intrusive_hooks.hpp>
 #include <engine/impl/async_flat_combining_queue.hpp>
 #include <logging/config.hpp>
 #include <logging/impl/base_sink.hpp>
@@ -53,15 +56,84 @@ struct ReopenCoro {
 
 struct Stop {};
 
-using Action = std::variant<Stop, Log, FlushCoro, FlushThreaded, ReopenCoro>;
+class LogBuffer;
+
+struct DrainBuffer {
+  LogBuffer* buffer;
+};
+
+using Action =
+    std::variant<Stop, FlushCoro, FlushThreaded, ReopenCoro, DrainBuffer>;
 
 struct ActionNode final : public concurrent::impl::SinglyLinkedBaseHook {
   Action action{Stop{}};
 };
 
+/// @brief Unbounded lock-free single-producer single-consumer queue of log
+/// records written by a single thread.
+///
+/// The consumer is woken up through `wakeup_node`, which is pushed into the
+/// TpLogger control queue at most once until the consumer picks it up.
+class LogBuffer final {
+ public:
+  using Size = std::int64_t;
+
+  explicit LogBuffer(std::thread::id owner);
+  ~LogBuffer();
+
+  LogBuffer(LogBuffer&&) = delete;
+  LogBuffer& operator=(LogBuffer&&) = delete;
+
+  /// @brief Producer side, returns `true` if `wakeup_node` has to be pushed
+  /// to notify the consumer.
+  bool Push(Log&& log);
+
+  /// Consumer side, must be called before draining the buffer on wakeup
+  void ResetWakeUp() noexcept;
+
+  /// Consumer side
+  std::optional<Log> TryPop() noexcept;
+
+  /// Returns the approximate number of records in the buffer
+  Size GetSize() const noexcept;
+
+  std::thread::id GetOwner() const noexcept { return owner_; }
+
+  ActionNode wakeup_node;
+
+  // Next buffer of the same logger, immutable after registration.
+  LogBuffer* next{nullptr};
+
+ private:
+  struct Node {
+    std::atomic<Node*> next{nullptr};
+    Log log;
+  };
+
+  struct ProducerSide {
+    Node* tail;
+    std::atomic<Size> produced{0};
+  };
+
+  struct ConsumerSide {
+    Node* head;
+    std::atomic<Size> consumed{0};
+  };
+
+  const std::thread::id owner_;
+  concurrent::impl::InterferenceShield<ProducerSide> producer_;
+  concurrent::impl::InterferenceShield<ConsumerSide> consumer_;
+  concurrent::impl::InterferenceShield<std::atomic<bool>> wakeup_pending_{
+      false};
+};
+
 }  // namespace async
 
 /// @brief Asynchronous logger that logs into a specific TaskProcessor.
+///
+/// Each thread writes log records into its own async::LogBuffer, so that
+/// producers do not contend with each other. Flushes, reopens and consumer
+/// wakeups go through a shared flat-combining queue.
 class TpLogger final : public LoggerBase {
  public:
   TpLogger(Format format, std::string logger_name);
@@ -76,6 +148,7 @@ class TpLogger final : public LoggerBase {
   void Log(Level level, std::string_view msg) override;
   void Flush() override;
   void PrependCommonTags(TagWriter writer) const override;
+  std::uint64_t GetSamplingKey() const noexcept override;
 
   void AddSink(impl::SinkPtr&& sink);
   const std::vector<impl::SinkPtr>& GetSinks() const;
@@ -101,20 +174,27 @@ class TpLogger final : public LoggerBase {
   using QueueSize = std::int64_t;
 
   void ProcessingLoop();
-  bool HasFreeQueueCapacity() noexcept;
-  bool TryWaitFreeQueueCapacity();
+  impl::async::LogBuffer& GetThreadBuffer();
+  impl::async::LogBuffer& FindOrAddBuffer(std::thread::id thread_id);
+  bool HasFreeQueueCapacity(const impl::async::LogBuffer& buffer) noexcept;
+  impl::async::LogBuffer* TryWaitFreeQueueCapacity();
   void Push(impl::async::Action&& action);
   void DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
   void ConsumeNode(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
+  void ConsumeBuffer(impl::async::LogBuffer& buffer) noexcept;
+  void ConsumeAllBuffers() noexcept;
   void ConsumeQueueOnce(Queue::Consumer& consumer) noexcept;
   void CleanUpQueue(Queue::Consumer&& consumer) noexcept;
-  void AccountLogConsumed() noexcept;
+  void NotifyCapacityWaiters() noexcept;
   void BackendPerform(impl::async::Action&& action) noexcept;
   void BackendLog(impl::async::Log&& action) const;
   void BackendFlush() const;
+  void BackendEndBatch() const noexcept;
   void BackendReopen(ReopenMode reopen_mode) const;
 
   const std::string logger_name_;
+  // Unique for the process lifetime, unlike the address of the logger.
+  const std::uint64_t id_;
   std::vector<impl::SinkPtr> sinks_;
   mutable statistics::LogStatistics stats_{};
 
@@ -131,8 +211,8 @@ class TpLogger final : public LoggerBase {
   impl::async::ActionNode stop_node_;
 
   Queue queue_;
-  concurrent::impl::InterferenceShield<std::atomic<QueueSize>> produced_{0};
-  concurrent::impl::InterferenceShield<std::atomic<QueueSize>> consumed_{0};
+  // Push-only list of per-thread buffers, freed in the destructor.
+  std::atomic<impl::async::LogBuffer*> buffers_{nullptr};
 };
 
 }  // namespace logging::impl
@@ -3,6 +3,7 @@
 #include <benchmark/benchmark.h>
 
 #include <logging/impl/null_sink.hpp>
+#include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/logger.hpp>
@@ -65,6 +66,37 @@ BENCHMARK_REGISTER_F(TpLoggerBenchmark, LogString)
     ->Range(8, 8 << 10)
     ->Complexity();
 
+BENCHMARK_DEFINE_F(TpLoggerBenchmark, LogStringMultithreaded)
+(benchmark::State& state) {
+  constexpr std::size_t kLogsPerTask = 1000;
+  const auto thread_count = static_cast<std::size_t>(state.range(0));
+
+  engine::RunStandalone(thread_count, [&] {
+    auto scope = StartAsyncLoggerScope();
+    const auto msg = Launder(std::string(64, '*'));
+    std::vector<engine::TaskWithResult<void>> tasks;
+    tasks.reserve(thread_count);
+
+    for ([[maybe_unused]] auto _ : state) {
+      for (std::size_t i = 0; i < thread_count; ++i) {
+        tasks.push_back(engine::AsyncNoSpan([&msg] {
+          for (std::size_t j = 0; j < kLogsPerTask; ++j) {
+            LOG_INFO() << msg;
+          }
+        }));
+      }
+      for (auto& task : tasks) task.Get();
+      tasks.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * thread_count * kLogsPerTask);
+  });
+}
+// Producers contend for the logger only if they share a queue
+BENCHMARK_REGISTER_F(TpLoggerBenchmark, LogStringMultithreaded)
+    ->Arg(4)
+    ->Arg(32)
+    ->UseRealTime();
+
 namespace {
 
 __attribute__((noinline)) void LogDebug() { LOG_DEBUG() << 42; }
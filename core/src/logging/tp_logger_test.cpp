@@ -577,6 +577,30 @@ UTEST_F(LoggingTestCoro, TpLoggerFlush) {
   EXPECT_EQ(GetRecordsCount(), 4);
 }
 
+UTEST_F(LoggingTestCoro, TpLoggerFlushOtherThreads) {
+  constexpr std::size_t kThreadCount = 4;
+  auto logger = StartAsyncLogger(kLoggingTestIterations);
+
+  std::vector<std::thread> threads;
+  threads.reserve(kThreadCount);
+  for (std::size_t thread_index = 0; thread_index < kThreadCount;
+       ++thread_index) {
+    threads.emplace_back([&logger, thread_index] {
+      for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+        LOG_INFO_TO(logger) << i << " at " << thread_index;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  // Each thread has its own buffer, Flush must drain all of them
+  logger->Flush();
+  EXPECT_EQ(GetRecordsCount(), kLoggingTestIterations * kThreadCount);
+  logger->StopConsumerTask();
+
+  EXPECT_EQ(GetMetric("dropped"), 0);
+}
+
 UTEST_F(LoggingTestCoro, TpLoggerFlushMultiple) {
   constexpr std::size_t kQueueSize = 16;
   auto logger = StartAsyncLogger(kQueueSize);
@@ -8,6 +8,7 @@
 #include <boost/filesystem/operations.hpp>
 #include <boost/range/algorithm/find_if.hpp>
 
+#include <logging/impl/batched_file_sink.hpp>
 #include <logging/impl/buffered_file_sink.hpp>
 #include <logging/impl/tcp_socket_sink.hpp>
 #include <logging/impl/unix_socket_sink.hpp>
@@ -38,11 +39,14 @@ void CreateLogDirectory(const std::string& logger_name,
   }
 }
 
-SinkPtr GetSinkFromFilename(const std::string& file_path) {
+SinkPtr GetSinkFromFilename(const std::string& file_path,
+                            bool batched_writes) {
   if (utils::text::StartsWith(file_path, kUnixSocketPrefix)) {
     // Use Unix-socket sink
     return std::make_unique<UnixSocketSink>(
         file_path.substr(kUnixSocketPrefix.size()));
+  } else if (batched_writes) {
+    return std::make_unique<BatchedFileSink>(file_path);
   } else {
     return std::make_unique<BufferedFileSink>(file_path);
   }
@@ -57,7 +61,7 @@ SinkPtr MakeOptionalSink(const LoggerConfig& config) {
     return std::make_unique<logging::impl::BufferedUnownedFileSink>(stdout);
   } else {
     CreateLogDirectory(config.logger_name, config.file_path);
-    return GetSinkFromFilename(config.file_path);
+    return GetSinkFromFilename(config.file_path, config.batched_writes);
   }
 }
 
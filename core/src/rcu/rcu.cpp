@@ -2,6 +2,8 @@
 
 #include <atomic>
 
+#include <userver/compiler/thread_local.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace rcu::impl {
@@ -11,6 +13,55 @@ uint64_t GetNextEpoch() noexcept {
   return counter++;
 }
 
+namespace {
+
+compiler::ThreadLocal local_epoch_stripe = [] {
+  static std::atomic<std::size_t> next_stripe{0};
+  return next_stripe.fetch_add(1, std::memory_order_relaxed);
+};
+
+}  // namespace
+
+EpochDomain::ReadLock EpochDomain::LockRead() noexcept {
+  const auto stripe = [] {
+    auto local_stripe = local_epoch_stripe.Use();
+    return *local_stripe % kStripes;
+  }();
+  while (true) {
+    const auto epoch = epoch_.load();
+    const std::size_t epoch_index = epoch % 2;
+    stripes_[stripe].readers[epoch_index].fetch_add(1);
+    // Otherwise the writer could have checked our stripe before we were
+    // counted in it, and we could have obtained a value retired in the previous
+    // epoch
+    if (epoch_.load() == epoch) return {stripe, epoch_index};
+    stripes_[stripe].readers[epoch_index].fetch_sub(1);
+  }
+}
+
+void EpochDomain::UnlockRead(ReadLock lock) noexcept {
+  stripes_[lock.stripe].readers[lock.epoch_index].fetch_sub(1);
+}
+
+void EpochDomain::StartNewEpoch() noexcept { epoch_.fetch_add(1); }
+
+bool EpochDomain::IsPreviousEpochDrained() const noexcept {
+  const std::size_t epoch_index = (epoch_.load() + 1) % 2;
+  for (const auto& stripe : stripes_) {
+    if (stripe.readers[epoch_index].load() != 0) return false;
+  }
+  return true;
+}
+
+bool EpochDomain::HasReaders() const noexcept {
+  for (const auto& stripe : stripes_) {
+    if (stripe.readers[0].load() != 0 || stripe.readers[1].load() != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
 }  // namespace rcu::impl
 
 USERVER_NAMESPACE_END
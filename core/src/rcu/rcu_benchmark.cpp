@@ -13,10 +13,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
-template <int VariableCount>
-void rcu_read(benchmark::State& state) {
+template <int VariableCount, typename RcuTraits>
+void RcuRead(benchmark::State& state) {
   engine::RunStandalone([&] {
-    rcu::Variable<std::uint64_t> vars[VariableCount];
+    rcu::Variable<std::uint64_t, RcuTraits> vars[VariableCount];
     {
       std::uint64_t i = 0;
       for (auto& var : vars) {
@@ -33,10 +33,23 @@ void rcu_read(benchmark::State& state) {
     }
   });
 }
+
+template <int VariableCount>
+void rcu_read(benchmark::State& state) {
+  RcuRead<VariableCount, rcu::DefaultRcuTraits<std::uint64_t>>(state);
+}
 BENCHMARK_TEMPLATE(rcu_read, 1);
 BENCHMARK_TEMPLATE(rcu_read, 2);
 BENCHMARK_TEMPLATE(rcu_read, 4);
 
+template <int VariableCount>
+void rcu_epoch_read(benchmark::State& state) {
+  RcuRead<VariableCount, rcu::EpochRcuTraits<std::uint64_t>>(state);
+}
+BENCHMARK_TEMPLATE(rcu_epoch_read, 1);
+BENCHMARK_TEMPLATE(rcu_epoch_read, 2);
+BENCHMARK_TEMPLATE(rcu_epoch_read, 4);
+
 template <int VariableCount>
 void rcu_write(benchmark::State& state) {
   engine::RunStandalone([&] {
@@ -53,7 +66,8 @@ BENCHMARK_TEMPLATE(rcu_write, 1);
 BENCHMARK_TEMPLATE(rcu_write, 2);
 BENCHMARK_TEMPLATE(rcu_write, 4);
 
-void rcu_contention(benchmark::State& state) {
+template <typename RcuTraits>
+void RcuContention(benchmark::State& state) {
   const std::size_t readers_count = state.range(0);
   const std::size_t writers_count = state.range(1);
   const std::size_t kept_readable_pointers_count = state.range(2);
@@ -63,14 +77,14 @@ void rcu_contention(benchmark::State& state) {
 
   engine::RunStandalone(thread_count, [&] {
     std::atomic<bool> run{true};
-    rcu::Variable<std::uint64_t> var{0};
+    rcu::Variable<std::uint64_t, RcuTraits> var{0};
 
     std::vector<engine::TaskWithResult<void>> tasks;
     tasks.reserve(readers_count - 1 + writers_count);
 
     for (std::size_t j = 0; j < readers_count - 1; j++) {
       tasks.push_back(utils::Async("reader", [&] {
-        std::vector<rcu::ReadablePtr<std::uint64_t>> pointers;
+        std::vector<rcu::ReadablePtr<std::uint64_t, RcuTraits>> pointers;
         pointers.reserve(kept_readable_pointers_count);
 
         while (run) {
@@ -94,7 +108,7 @@ void rcu_contention(benchmark::State& state) {
     }
 
     {
-      std::queue<rcu::ReadablePtr<std::uint64_t>> pointers;
+      std::queue<rcu::ReadablePtr<std::uint64_t, RcuTraits>> pointers;
       for (std::size_t i = 0; i < kept_readable_pointers_count; i++) {
         pointers.push(var.Read());
       }
@@ -112,11 +126,23 @@ void rcu_contention(benchmark::State& state) {
     }
   });
 }
+
+void rcu_contention(benchmark::State& state) {
+  RcuContention<rcu::DefaultRcuTraits<std::uint64_t>>(state);
+}
 BENCHMARK(rcu_contention)
     ->RangeMultiplier(2)
     ->Ranges({{1, 16}, {0, 1}, {1, 4}})
     ->Ranges({{2048, 2048}, {0, 1}, {1, 4}});
 
+void rcu_epoch_contention(benchmark::State& state) {
+  RcuContention<rcu::EpochRcuTraits<std::uint64_t>>(state);
+}
+BENCHMARK(rcu_epoch_contention)
+    ->RangeMultiplier(2)
+    ->Ranges({{1, 16}, {0, 1}, {1, 4}})
+    ->Ranges({{2048, 2048}, {0, 1}, {1, 4}});
+
 void rcu_of_shared_ptr(benchmark::State& state) {
   const std::size_t readers_count = state.range(0);
 
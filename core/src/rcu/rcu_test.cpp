@@ -457,6 +457,109 @@ UTEST_MT(Rcu, TortureTest, kTotalTasks) {
   keep_running = false;
 }
 
+UTEST_MT(Rcu, EpochTortureTest, kTotalTasks) {
+  using Traits = rcu::EpochRcuTraits<CleaningUpInt>;
+  rcu::Variable<CleaningUpInt, Traits> data{1};
+  std::atomic<bool> keep_running{true};
+
+  engine::Mutex ping_pong_mutex;
+  rcu::ReadablePtr<CleaningUpInt, Traits> ptr = data.Read();
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+
+  for (std::size_t i = 0; i < kReadablePtrPingPongTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        std::lock_guard lock(ping_pong_mutex);
+        // copy a ptr created by another thread
+        ptr = rcu::ReadablePtr{ptr};
+        ASSERT_GT(ptr->value, 0);
+      }
+    }));
+  }
+
+  for (std::size_t i = 0; i < kReadingTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        const auto local_ptr = data.Read();
+        ASSERT_GT(local_ptr->value, 0);
+      }
+    }));
+  }
+
+  for (std::size_t i = 0; i < kWritingTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        const auto old = data.Read();
+        data.Assign(CleaningUpInt{old->value + 1});
+      }
+    }));
+  }
+
+  engine::SleepFor(std::chrono::milliseconds{100});
+  keep_running = false;
+}
+
+UTEST(Rcu, EpochLifetime) {
+  using Counted = Counted<struct EpochLifetimeTag>;
+  using Traits = rcu::EpochRcuTraits<Counted>;
+
+  {
+    rcu::Variable<Counted, Traits> var{rcu::DestructionType::kSync};
+    EXPECT_EQ(1, Counted::counter);
+
+    auto reader = var.Read();
+    var.Emplace();
+    EXPECT_EQ(2, Counted::counter);
+
+    // the copy reads the current value
+    auto reader_copy = reader;
+    reader = std::move(reader_copy);
+    EXPECT_EQ(2, Counted::counter);
+
+    // the previous value is destroyed once the readers of its epoch are gone
+    var.Cleanup();
+    EXPECT_EQ(1, Counted::counter);
+
+    var.Emplace();
+    EXPECT_EQ(2, Counted::counter);
+    {
+      auto writer = var.StartWrite();
+      writer->value = 10;
+      writer.Commit();
+    }
+    EXPECT_EQ(3, Counted::counter);
+
+    reader = var.Read();
+    EXPECT_EQ(10, reader->value);
+    var.Cleanup();
+    // the reader of the current epoch delays the destruction of all the values
+    // retired in it
+    EXPECT_EQ(2, Counted::counter);
+
+    { [[maybe_unused]] auto released = std::move(reader); }
+    var.Cleanup();
+    EXPECT_EQ(1, Counted::counter);
+  }
+  EXPECT_EQ(0, Counted::counter);
+}
+
+UTEST(Rcu, EpochAsyncGc) {
+  auto& mutation_task = engine::current_task::GetCurrentTaskContext();
+
+  rcu::Variable<utils::ScopeGuard, rcu::EpochRcuTraits<utils::ScopeGuard>> var(
+      [&] { EXPECT_FALSE(mutation_task.IsCurrent()); });
+
+  {
+    auto read_ptr = var.Read();
+    var.Emplace([&] { EXPECT_FALSE(mutation_task.IsCurrent()); });
+  }
+  var.Cleanup();
+
+  // destruction of the last value is executed synchronously
+  var.Emplace([&] { EXPECT_TRUE(mutation_task.IsCurrent()); });
+}
+
 UTEST(Rcu, WritablePtrUnlocksInCommit) {
   rcu::Variable<int> var{1};
 
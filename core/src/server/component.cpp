@@ -130,6 +130,14 @@ properties:
                     private-key-passphrase-name:
                         type: string
                         description: passphrase name located in secdist
+                    ktls:
+                        type: boolean
+                        description: hand the established connections over to the kernel TLS if it is supported
+                        defaultDescription: false
+                    session-resumption:
+                        type: boolean
+                        description: issue TLS session tickets
+                        defaultDescription: true
             handler-defaults:
                 type: object
                 description: handler defaults options
@@ -180,9 +188,52 @@ properties:
                         type: integer
                         description: timeout in seconds to drop connection if there's not data received from it
                         defaultDescription: 600
+                    max_requests:
+                        type: integer
+                        description: close the connection after about that many requests (up to 10% less to spread the reconnects in time); 0 to not limit
+                        defaultDescription: 0
+                        minimum: 0
+                    max_age:
+                        type: integer
+                        description: close the connection with the first request after about that many seconds since the connection was accepted (up to 10% less); 0 to not limit
+                        defaultDescription: 0
+                        minimum: 0
+                    overload_close_fraction:
+                        type: number
+                        description: "fraction of the requests that get a `Connection: close` response while the task processor of the listener is overloaded by wait_queue_overload of USERVER_TASK_PROCESSOR_QOS"
+                        defaultDescription: 0
+                        minimum: 0
+                        maximum: 1
+                    http2:
+                        type: object
+                        description: HTTP/2 options, HTTP/2 is detected by the client connection preface
+                        additionalProperties: false
+                        properties:
+                            enabled:
+                                type: boolean
+                                description: accept HTTP/2 connections with prior knowledge (h2c or h2 over TLS) along with HTTP/1.1
+                                defaultDescription: false
+                            max_concurrent_streams:
+                                type: integer
+                                description: max number of requests that are processed concurrently within a single connection
+                                defaultDescription: 100
+                            initial_window_size:
+                                type: integer
+                                description: initial flow control window size in bytes for each stream
+                                defaultDescription: 65535
+                            max_frame_size:
+                                type: integer
+                                description: max size of a frame payload in bytes that the server accepts
+                                defaultDescription: 16384
             shards:
                 type: integer
-                description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
+                description: how many SO_REUSEPORT sockets accept the connections, each one is served by its own ev thread; must not be greater than 1 for unix-socket
+                defaultDescription: <number of ev threads of task_processor>
+                minimum: 1
+            reuseport_cpu_steering:
+                type: boolean
+                description: pass a new connection to the shard with the index of the CPU that received it instead of the connection hash (Linux only)
+                defaultDescription: false
     listener-monitor:
         type: object
         description: describes the special monitoring socket, used for getting statistics and processing utility requests that should succeed even is the main socket is under heavy pressure
@@ -11,6 +11,7 @@ void Limiter::SetLimit(
   const auto lock = limitees_.Lock();
   for (const auto& limitee : *lock) {
     limitee->SetLimit(limit);
+    limitee->SetShedLevel(new_limit.shed_level);
   }
 }
 
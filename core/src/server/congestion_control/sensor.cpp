@@ -1,18 +1,31 @@
 #include <server/congestion_control/sensor.hpp>
 
+#include <utility>
+
+#include <engine/task/scheduler_statistics.hpp>
 #include <engine/task/task_processor.hpp>
+#include <server/http/http_request_handler.hpp>
 #include <server/net/stats.hpp>
+#include <utils/statistics/pressure.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::congestion_control {
 
 namespace {
+
 const std::chrono::seconds kSecond{1};
-}
+
+// 0.99 quantile, the overload shows up in the tail long before the median
+constexpr std::uint64_t kQueueWaitQuantilePermille = 990;
+
+}  // namespace
 
 Sensor::Sensor(const Server& server, engine::TaskProcessor& tp)
-    : server_(server), tp_(tp) {}
+    : server_(server),
+      tp_(tp),
+      has_memory_pressure_(
+          utils::statistics::impl::HasCgroupPressure("memory")) {}
 
 Sensor::Data Sensor::FetchCurrent() {
   const bool first_fetch =
@@ -34,8 +47,10 @@ Sensor::Data Sensor::FetchCurrent() {
   // TODO: wrong value, it includes ratelimited ones too
   //       it might lead to too high start RPS limits
   auto server_stats = server_.GetServerStats();
+  // Limits apply to the request costs, see handler's `throttling_cost`
   auto requests = server_stats.active_request_count.load() +
-                  server_stats.requests_processed_count.load();
+                  server_stats.requests_processed_count.load() +
+                  server_.GetHttpRequestHandler().GetThrottlingExtraCost();
   auto rps = (requests - last_requests_) * kSecond / duration_ms;
 
   last_fetch_tp_ = now;
@@ -43,12 +58,63 @@ Sensor::Data Sensor::FetchCurrent() {
   last_no_overloads_ = no_overloads;
   last_requests_ = requests;
 
-  return Data{
+  const auto queue_wait = FetchQueueWait();
+  const auto cpu_usage = cpu_usage_.Fetch(now);
+
+  Data data{
       first_fetch ? 0 : rps,
       first_fetch ? 0 : overloads_ps,
       first_fetch ? 0 : no_overloads_ps,
       now,
+      first_fetch ? std::chrono::microseconds{0} : queue_wait,
+      first_fetch ? 0 : cpu_usage,
   };
+  FetchMemoryPressure(data);
+  return data;
+}
+
+void Sensor::FetchMemoryPressure(Data& data) const {
+  if (!has_memory_pressure_) return;
+  // PSI averages are computed by the kernel, so the first fetch is valid too
+  const auto pressure = utils::statistics::impl::ReadCgroupPressure("memory");
+  if (!pressure) return;
+  data.memory_pressure = pressure->some.avg10 / 100;
+  if (pressure->full) data.memory_full_pressure = pressure->full->avg10 / 100;
+}
+
+std::chrono::microseconds Sensor::FetchQueueWait() {
+  const auto histogram = tp_.GetSchedulerStatistics().GetQueueWait();
+  const auto view = histogram.GetView();
+  const auto bucket_count = view.GetBucketCount();
+
+  // The counters only grow, the percentile is taken over the difference
+  std::vector<std::uint64_t> buckets(bucket_count + 1);
+  for (std::size_t i = 0; i < bucket_count; ++i) {
+    buckets[i] = view.GetValueAt(i);
+  }
+  buckets[bucket_count] = view.GetValueAtInf();
+  auto last_buckets = std::exchange(last_queue_wait_buckets_, buckets);
+  if (last_buckets.size() != buckets.size()) return {};
+
+  std::uint64_t total = 0;
+  for (std::size_t i = 0; i < buckets.size(); ++i) {
+    buckets[i] -= last_buckets[i];
+    total += buckets[i];
+  }
+  if (total == 0 || bucket_count == 0) return {};
+
+  const auto threshold = (total * kQueueWaitQuantilePermille + 999) / 1000;
+  std::uint64_t accumulated = 0;
+  for (std::size_t i = 0; i < bucket_count; ++i) {
+    accumulated += buckets[i];
+    if (accumulated >= threshold) {
+      return std::chrono::microseconds{
+          static_cast<std::int64_t>(view.GetUpperBoundAt(i))};
+    }
+  }
+  // Above the last bound, the exact value is unknown
+  return std::chrono::microseconds{
+      static_cast<std::int64_t>(view.GetUpperBoundAt(bucket_count - 1))};
 }
 
 }  // namespace server::congestion_control
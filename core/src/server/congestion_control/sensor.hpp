@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
+
+#include <congestion_control/cpu_usage.hpp>
 
 #include <userver/congestion_control/sensor.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -18,6 +21,10 @@ class Sensor final : public USERVER_NAMESPACE::congestion_control::Sensor {
   Data FetchCurrent() override;
 
  private:
+  std::chrono::microseconds FetchQueueWait();
+
+  void FetchMemoryPressure(Data& data) const;
+
   const Server& server_;
   engine::TaskProcessor& tp_;
 
@@ -25,6 +32,9 @@ class Sensor final : public USERVER_NAMESPACE::congestion_control::Sensor {
   std::uint64_t last_overloads_{0};
   std::uint64_t last_no_overloads_{0};
   std::uint64_t last_requests_{0};
+  std::vector<std::uint64_t> last_queue_wait_buckets_;
+  USERVER_NAMESPACE::congestion_control::impl::CpuUsage cpu_usage_;
+  const bool has_memory_pressure_;
 };
 
 }  // namespace server::congestion_control
@@ -0,0 +1,109 @@
+#include <userver/server/handlers/cpu_profiler.hpp>
+
+#include <optional>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/components/component_config.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/http/content_type.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+#include <utils/cpu_profiler.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+constexpr std::int64_t kDefaultSeconds = 30;
+constexpr std::int64_t kDefaultFrequency = 100;
+constexpr std::int64_t kMaxFrequency = 1000;
+
+std::int64_t GetIntArg(const http::HttpRequest& request,
+                       const std::string& name, std::int64_t default_value,
+                       std::int64_t min, std::int64_t max) {
+  const auto& value = request.GetArg(name);
+  if (value.empty()) return default_value;
+
+  std::int64_t result = 0;
+  try {
+    result = utils::FromString<std::int64_t>(value);
+  } catch (const std::exception& ex) {
+    throw ClientError(ExternalBody{
+        fmt::format("Invalid '{}' argument: {}", name, ex.what())});
+  }
+  if (result < min || result > max) {
+    throw ClientError(ExternalBody{fmt::format(
+        "The '{}' argument must be in [{}, {}], got {}", name, min, max,
+        result)});
+  }
+  return result;
+}
+
+}  // namespace
+
+CpuProfiler::CpuProfiler(const components::ComponentConfig& config,
+                         const components::ComponentContext& component_context)
+    : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
+      max_duration_(std::chrono::duration_cast<std::chrono::seconds>(
+          config["max-duration"].As<std::chrono::milliseconds>(
+              std::chrono::minutes{5}))),
+      max_samples_(config["max-samples"].As<std::size_t>(100'000)) {}
+
+std::string CpuProfiler::HandleRequestThrow(const http::HttpRequest& request,
+                                            request::RequestContext&) const {
+  const std::chrono::seconds duration{
+      GetIntArg(request, "seconds", kDefaultSeconds, 1, max_duration_.count())};
+  const auto frequency =
+      GetIntArg(request, "frequency", kDefaultFrequency, 1, kMaxFrequency);
+
+  utils::cpu_profiler::SessionSettings settings;
+  settings.period = std::chrono::microseconds{1'000'000 / frequency};
+  settings.max_samples = max_samples_;
+
+  std::optional<utils::cpu_profiler::Session> session;
+  try {
+    session.emplace(settings);
+  } catch (const std::runtime_error& ex) {
+    throw ConflictError(ExternalBody{ex.what()});
+  }
+
+  // A cancelled request stops the profiling early
+  engine::InterruptibleSleepFor(duration);
+
+  request.GetHttpResponse().SetContentType(
+      USERVER_NAMESPACE::http::content_type::kApplicationOctetStream);
+  return session->StopAndGetProfile();
+}
+
+std::string CpuProfiler::GetResponseDataForLogging(
+    const http::HttpRequest&, request::RequestContext&,
+    const std::string&) const {
+  return "<cpu profile>";
+}
+
+yaml_config::Schema CpuProfiler::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<HttpHandlerBase>(R"(
+type: object
+description: handler-cpu-profiler config
+additionalProperties: false
+properties:
+    max-duration:
+        type: string
+        description: the longest profile that may be requested
+        defaultDescription: 5m
+    max-samples:
+        type: integer
+        description: samples above that are dropped
+        defaultDescription: 100000
+        minimum: 1
+)");
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,91 @@
+#include <userver/server/handlers/dump_snapshot.hpp>
+
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/components/component.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
+#include <userver/testsuite/testsuite_support.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+constexpr std::size_t kChunkSize = 64 * 1024;
+
+// Sends the written data in chunks of the response body. The headers are sent
+// with the first chunk, so the errors of the beginning of the write are still
+// reported with the status code.
+class ResponseStreamWriter final : public dump::Writer {
+ public:
+  explicit ResponseStreamWriter(http::ResponseBodyStream& response)
+      : response_(response) {}
+
+  void Finish() override { PushChunk(); }
+
+ private:
+  void WriteRaw(std::string_view data) override {
+    buffer_.append(data);
+    if (buffer_.size() >= kChunkSize) PushChunk();
+  }
+
+  void PushChunk() {
+    if (!headers_sent_) {
+      response_.SetStatusCode(http::HttpStatus::kOk);
+      response_.SetHeader(USERVER_NAMESPACE::http::headers::kContentType,
+                          std::string{"application/octet-stream"});
+      response_.SetEndOfHeaders();
+      headers_sent_ = true;
+    }
+    if (buffer_.empty()) return;
+    response_.PushBodyChunk(std::exchange(buffer_, {}), engine::Deadline{});
+    buffer_.reserve(kChunkSize);
+  }
+
+  http::ResponseBodyStream& response_;
+  std::string buffer_;
+  bool headers_sent_{false};
+};
+
+}  // namespace
+
+DumpSnapshot::DumpSnapshot(const components::ComponentConfig& config,
+                           const components::ComponentContext& context)
+    : HttpHandlerBase(config, context, /*is_monitor = */ true),
+      dump_control_(context.FindComponent<components::TestsuiteSupport>()
+                        .GetDumpControl()) {}
+
+void DumpSnapshot::HandleStreamRequest(
+    const http::HttpRequest& request, request::RequestContext&,
+    http::ResponseBodyStream& response) const {
+  const auto& name = request.GetArg("name");
+  if (name.empty()) {
+    throw ClientError(ExternalBody{"Missing the 'name' argument"});
+  }
+
+  ResponseStreamWriter writer{response};
+  if (!dump_control_.WriteSnapshot(name, writer)) {
+    throw ResourceNotFound(
+        ExternalBody{fmt::format("Unknown dumper '{}'", name)});
+  }
+}
+
+yaml_config::Schema DumpSnapshot::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<HttpHandlerBase>(R"(
+type: object
+description: Handler that streams the current data of a dumper to another instance
+additionalProperties: false
+properties: {}
+)");
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
@@ -91,14 +91,111 @@ properties:
         type: integer
         description: integer to limit RPS to this handler
         defaultDescription: <no limit>
+    ratelimit_per_client:
+        type: object
+        description: limit RPS of each client to this handler separately
+        defaultDescription: <no limit>
+        additionalProperties: false
+        properties:
+            header:
+                type: string
+                description: request header identifying the client, the requests without it share a single limit
+            max_requests_per_second:
+                type: integer
+                description: RPS limit of each client
+                minimum: 1
+            burst:
+                type: integer
+                description: number of requests a client may send at once after being idle
+                defaultDescription: max_requests_per_second
+                minimum: 1
     decompress_request:
         type: boolean
         description: allow decompression of the requests
         defaultDescription: false
+    request_zstd_dictionary:
+        type: string
+        description: path to a zstd dictionary file to decompress the zstd requests with
+        defaultDescription: <no dictionary>
+    response_compression:
+        type: object
+        description: compress the responses with the codings accepted by the client
+        defaultDescription: <no compression>
+        additionalProperties: false
+        properties:
+            encodings:
+                type: array
+                description: content codings in the order of preference
+                defaultDescription: '[zstd, br, gzip]'
+                items:
+                    type: string
+                    description: content coding
+                    enum:
+                      - gzip
+                      - zstd
+                      - br
+            min_size:
+                type: integer
+                description: responses smaller than this are not compressed, streamed responses are always compressed
+                defaultDescription: 1024
+                minimum: 0
+            gzip_level:
+                type: integer
+                description: gzip compression level from 1 to 9
+                defaultDescription: 6
+            zstd_level:
+                type: integer
+                description: zstd compression level from 1 to 22
+                defaultDescription: 3
+            brotli_level:
+                type: integer
+                description: brotli quality from 0 to 11
+                defaultDescription: 5
+    response_cache:
+        type: object
+        description: cache the responses to GET and HEAD requests, see server::handlers::HttpHandlerBase::GetResponseCacheVersion
+        defaultDescription: <no caching>
+        additionalProperties: false
+        properties:
+            headers:
+                type: array
+                description: request headers the response depends on
+                defaultDescription: '[]'
+                items:
+                    type: string
+                    description: header name
+            max_entries:
+                type: integer
+                description: approximate limit of the cached responses count
+                defaultDescription: 1000
+                minimum: 1
+            ways:
+                type: integer
+                description: number of the independently locked parts of the cache
+                defaultDescription: 16
+                minimum: 1
     throttling_enabled:
         type: boolean
         description: allow throttling of the requests by components::Server , for more info see its `max_response_size_in_flight` and `requests_queue_size_threshold` options
         defaultDescription: true
+    throttling_cost:
+        type: integer
+        description: number of congestion control tokens a request to this handler takes, more expensive handlers are throttled first when the RPS limit is set
+        defaultDescription: 1
+        minimum: 1
+    throttling_body_bytes_per_cost:
+        type: integer
+        description: add one congestion control token to the request cost for each full chunk of this many request body bytes
+        defaultDescription: <body size does not affect the cost>
+        minimum: 1
+    throttling_priority:
+        type: string
+        description: request priority class for the congestion control shedding, the lower classes are rejected entirely first when the server is heavily overloaded
+        defaultDescription: normal
+        enum:
+          - low
+          - normal
+          - high
     set-response-server-hostname:
         type: boolean
         description: set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header
@@ -107,6 +204,10 @@ properties:
         type: boolean
         description: TODO
         defaultDescription: false
+    request-body-stream:
+        type: boolean
+        description: set to true to read the request body in the handler while it is being received, see server::http::RequestBodyStream
+        defaultDescription: false
     monitor-handler:
         type: boolean
         description: overrides the in-code `is_monitor` flag that makes the handler run either on 'server.listener' or on 'server.listener-monitor'
@@ -31,6 +31,79 @@ FallbackHandler Parse(const yaml_config::YamlConfig& yaml,
   return FallbackHandlerFromString(value);
 }
 
+ThrottlingPriority Parse(const yaml_config::YamlConfig& yaml,
+                         formats::parse::To<ThrottlingPriority>) {
+  const auto& value = yaml.As<std::string>();
+  if (value == "low") return ThrottlingPriority::kLow;
+  if (value == "normal") return ThrottlingPriority::kNormal;
+  if (value == "high") return ThrottlingPriority::kHigh;
+  throw std::runtime_error("can't parse ThrottlingPriority from '" + value +
+                           "' at " + yaml.GetPath());
+}
+
+ResponseEncoding Parse(const yaml_config::YamlConfig& yaml,
+                       formats::parse::To<ResponseEncoding>) {
+  const auto& value = yaml.As<std::string>();
+  if (value == "gzip") return ResponseEncoding::kGzip;
+  if (value == "zstd") return ResponseEncoding::kZstd;
+  if (value == "br") return ResponseEncoding::kBrotli;
+  throw std::runtime_error("can't parse ResponseEncoding from '" + value +
+                           "' at " + yaml.GetPath());
+}
+
+ResponseCompressionConfig Parse(const yaml_config::YamlConfig& value,
+                                formats::parse::To<ResponseCompressionConfig>) {
+  ResponseCompressionConfig config;
+  config.encodings = value["encodings"].As<std::vector<ResponseEncoding>>(
+      config.encodings);
+  config.min_size = value["min_size"].As<std::size_t>(config.min_size);
+  config.gzip_level = value["gzip_level"].As<int>(config.gzip_level);
+  config.zstd_level = value["zstd_level"].As<int>(config.zstd_level);
+  config.brotli_level = value["brotli_level"].As<int>(config.brotli_level);
+
+  if (config.encodings.empty()) {
+    throw std::runtime_error("Empty response compression encodings in " +
+                             value.GetPath());
+  }
+  return config;
+}
+
+ResponseCacheConfig Parse(const yaml_config::YamlConfig& value,
+                          formats::parse::To<ResponseCacheConfig>) {
+  ResponseCacheConfig config;
+  config.headers =
+      value["headers"].As<std::vector<std::string>>(config.headers);
+  config.max_entries =
+      value["max_entries"].As<std::size_t>(config.max_entries);
+  config.ways = value["ways"].As<std::size_t>(config.ways);
+
+  if (config.max_entries == 0 || config.ways == 0) {
+    throw std::runtime_error(
+        "Response cache max_entries and ways should be greater than 0 in " +
+        value.GetPath());
+  }
+  return config;
+}
+
+PerClientRatelimitConfig Parse(const yaml_config::YamlConfig& value,
+                               formats::parse::To<PerClientRatelimitConfig>) {
+  PerClientRatelimitConfig config;
+  config.header = value["header"].As<std::string>();
+  config.max_requests_per_second =
+      value["max_requests_per_second"].As<std::size_t>();
+  config.burst =
+      value["burst"].As<std::size_t>(config.max_requests_per_second);
+
+  if (config.header.empty() || config.max_requests_per_second == 0 ||
+      config.burst == 0) {
+    throw std::runtime_error(
+        "Per client ratelimit header, max_requests_per_second and burst "
+        "should not be empty in " +
+        value.GetPath());
+  }
+  return config;
+}
+
 HandlerConfig ParseHandlerConfigsWithDefaults(
     const yaml_config::YamlConfig& value,
     const server::ServerConfig& server_config, bool is_monitor) {
@@ -82,12 +155,29 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
           kLogRequestDataSizeDefaultLimit);
   config.max_requests_per_second =
       value["max_requests_per_second"].As<std::optional<size_t>>();
+  config.ratelimit_per_client =
+      value["ratelimit_per_client"]
+          .As<std::optional<PerClientRatelimitConfig>>();
   config.decompress_request = value["decompress_request"].As<bool>(true);
+  config.request_zstd_dictionary =
+      value["request_zstd_dictionary"].As<std::optional<std::string>>();
+  config.response_compression =
+      value["response_compression"]
+          .As<std::optional<ResponseCompressionConfig>>();
+  config.response_cache =
+      value["response_cache"].As<std::optional<ResponseCacheConfig>>();
   config.throttling_enabled = value["throttling_enabled"].As<bool>(true);
+  config.throttling_cost = value["throttling_cost"].As<size_t>(1);
+  config.throttling_body_bytes_per_cost =
+      value["throttling_body_bytes_per_cost"].As<std::optional<size_t>>();
+  config.throttling_priority =
+      value["throttling_priority"].As<ThrottlingPriority>(
+          ThrottlingPriority::kNormal);
   config.set_response_server_hostname =
       value["set-response-server-hostname"].As<std::optional<bool>>();
 
   config.response_body_stream = value["response-body-stream"].As<bool>(false);
+  config.request_body_stream = value["request-body-stream"].As<bool>(false);
 
   if (config.max_requests_per_second &&
       config.max_requests_per_second.value() <= 0) {
@@ -96,6 +186,15 @@ HandlerConfig ParseHandlerConfigsWithDefaults(
         std::to_string(config.max_requests_per_second.value()));
   }
 
+  if (config.throttling_cost == 0) {
+    throw std::runtime_error("throttling_cost should be greater than 0");
+  }
+  if (config.throttling_body_bytes_per_cost &&
+      config.throttling_body_bytes_per_cost.value() == 0) {
+    throw std::runtime_error(
+        "throttling_body_bytes_per_cost should be greater than 0");
+  }
+
   config.set_tracing_headers = value["set_tracing_headers"].As<bool>(
       handler_defaults.set_tracing_headers);
 
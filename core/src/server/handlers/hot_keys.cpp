@@ -0,0 +1,86 @@
+#include <userver/server/handlers/hot_keys.hpp>
+
+#include <fmt/format.h>
+
+#include <userver/components/component_context.hpp>
+#include <userver/components/hot_keys_storage.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+constexpr std::size_t kDefaultLimit = 10;
+
+std::size_t GetLimit(const http::HttpRequest& request) {
+  const auto& value = request.GetArg("limit");
+  if (value.empty()) return kDefaultLimit;
+  try {
+    return utils::FromString<std::size_t>(value);
+  } catch (const std::exception& ex) {
+    throw ClientError(
+        ExternalBody{fmt::format("Invalid 'limit' argument: {}", ex.what())});
+  }
+}
+
+formats::json::ValueBuilder FormatSource(
+    const utils::statistics::HotKeys& hot_keys, std::size_t limit) {
+  formats::json::ValueBuilder keys(formats::json::Type::kArray);
+  for (const auto& hot_key : hot_keys.GetTop(limit)) {
+    formats::json::ValueBuilder key_json(formats::json::Type::kObject);
+    key_json["key"] = hot_key.key;
+    key_json["count"] = hot_key.count;
+    key_json["error"] = hot_key.error;
+    keys.PushBack(std::move(key_json));
+  }
+
+  formats::json::ValueBuilder result(formats::json::Type::kObject);
+  result["accesses"] = hot_keys.GetTotal();
+  result["keys"] = std::move(keys);
+  return result;
+}
+
+}  // namespace
+
+HotKeys::HotKeys(const components::ComponentConfig& config,
+                 const components::ComponentContext& context)
+    : HttpHandlerJsonBase(config, context, /*is_monitor=*/true),
+      storage_(context.FindComponent<components::HotKeysStorage>()) {}
+
+formats::json::Value HotKeys::HandleRequestJsonThrow(
+    const http::HttpRequest& request, const formats::json::Value&,
+    request::RequestContext&) const {
+  const auto limit = GetLimit(request);
+  const auto& source = request.GetArg("source");
+  const auto sources = storage_.GetSources();
+
+  formats::json::ValueBuilder result(formats::json::Type::kObject);
+  if (!source.empty()) {
+    const auto it = sources.find(source);
+    if (it == sources.end()) {
+      throw ResourceNotFound(
+          ExternalBody{fmt::format("Unknown hot keys source '{}'", source)});
+    }
+    result[source] = FormatSource(*it->second, limit);
+  } else {
+    for (const auto& [name, hot_keys] : sources) {
+      result[name] = FormatSource(*hot_keys, limit);
+    }
+  }
+  return result.ExtractValue();
+}
+
+yaml_config::Schema HotKeys::GetStaticConfigSchema() {
+  auto schema = HttpHandlerBase::GetStaticConfigSchema();
+  schema.UpdateDescription("handler-hot-keys config");
+  return schema;
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
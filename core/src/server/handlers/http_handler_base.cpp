@@ -4,19 +4,25 @@
 #include <boost/algorithm/string/split.hpp>
 
 #include <compression/gzip.hpp>
+#include <compression/zstd.hpp>
 #include <server/handlers/http_handler_base_statistics.hpp>
 #include <server/handlers/http_server_settings.hpp>
+#include <server/handlers/response_cache.hpp>
+#include <server/http/headers_propagator.hpp>
 #include <server/http/http_request_impl.hpp>
+#include <server/http/response_compression.hpp>
 #include <server/server_config.hpp>
 #include <userver/baggage/baggage.hpp>
 #include <userver/baggage/baggage_settings.hpp>
 #include <userver/components/component.hpp>
+#include <userver/components/headers_propagator_component.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/task/inherited_variable.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/fs/blocking/read.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/hostinfo/blocking/get_hostname.hpp>
 #include <userver/http/common_headers.hpp>
@@ -36,10 +42,12 @@
 #include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracing.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/utils/current_arena.hpp>
 #include <userver/utils/encoding/hex.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
 #include <userver/utils/from_string.hpp>
 #include <userver/utils/graphite.hpp>
+#include <userver/utils/keyed_rate_limiter.hpp>
 #include <userver/utils/log.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/scope_guard.hpp>
@@ -106,16 +114,15 @@ void SetFormattedErrorResponse(
 void SetUpBaggage(const http::HttpRequest& http_request,
                   const dynamic_config::Snapshot& config_snapshot) {
   if (config_snapshot[baggage::kBaggageEnabled]) {
-    auto baggage_header =
+    const auto& baggage_header =
         http_request.GetHeader(USERVER_NAMESPACE::http::headers::kXBaggage);
     if (!baggage_header.empty()) {
       LOG_DEBUG() << "Got baggage header: " << baggage_header;
       const auto& baggage_settings = config_snapshot[baggage::kBaggageSettings];
-      auto baggage = baggage::TryMakeBaggage(std::move(baggage_header),
-                                             baggage_settings.allowed_keys);
-      if (baggage) {
-        baggage::kInheritedBaggage.Set(std::move(*baggage));
-      }
+      // Parsed once right in the task inherited variable, it is shared by
+      // the child tasks and by the outgoing requests
+      baggage::TrySetInheritedBaggage(baggage_header,
+                                      baggage_settings.allowed_keys);
     }
   }
 }
@@ -498,6 +505,42 @@ logging::LogExtra LogRequestExtra(bool need_log_request_headers,
   return log_extra;
 }
 
+bool IsBodyAllowed(http::HttpStatus status) noexcept {
+  const auto code = static_cast<int>(status);
+  return code >= 200 && status != http::HttpStatus::kNoContent &&
+         status != http::HttpStatus::kNotModified;
+}
+
+void CompressResponse(const ResponseCompressionConfig& config,
+                      const http::HttpRequest& http_request,
+                      http::HttpResponse& response,
+                      HttpHandlerMethodStatistics& statistics) {
+  namespace headers = USERVER_NAMESPACE::http::headers;
+
+  const auto& data = response.GetData();
+  if (data.size() < config.min_size || !IsBodyAllowed(response.GetStatus())) {
+    return;
+  }
+  // Already encoded or a part of the representation
+  if (response.HasHeader(headers::kContentEncoding) ||
+      response.HasHeader(headers::kContentRange)) {
+    return;
+  }
+
+  const auto encoding = http::NegotiateResponseEncoding(
+      http_request.GetHeader(headers::kAcceptEncoding), config.encodings);
+  if (!encoding) return;
+
+  const auto start = std::chrono::steady_clock::now();
+  std::string compressed;
+  http::MakeResponseCompressor(*encoding, config)->Finish(data, compressed);
+  statistics.AccountCompression(data.size(), compressed.size(),
+                                std::chrono::steady_clock::now() - start);
+
+  http::SetResponseContentEncoding(response, *encoding);
+  response.SetData(std::move(compressed));
+}
+
 std::unordered_map<int, logging::Level> ParseStatusCodesLogLevel(
     const std::unordered_map<std::string, std::string>& codes) {
   std::unordered_map<int, logging::Level> result;
@@ -520,6 +563,11 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
       tracing_manager_(
           context.FindComponent<tracing::DefaultTracingManagerLocator>()
               .GetTracingManager()),
+      headers_propagator_([&context]() -> const http::HeadersPropagator* {
+        auto* component = context.FindComponentOptional<
+            components::HeadersPropagatorComponent>();
+        return component ? &component->Get() : nullptr;
+      }()),
       log_level_for_status_codes_(ParseStatusCodesLogLevel(
           config["status-codes-log-level"]
               .As<std::unordered_map<std::string, std::string>>({}))),
@@ -535,6 +583,22 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
     LOG_WARNING() << "empty allowed methods list in " << config.Name();
   }
 
+  if (const auto& compression = GetConfig().response_compression) {
+    // Reports invalid compression levels at startup
+    for (const auto encoding : compression->encodings) {
+      http::MakeResponseCompressor(encoding, *compression);
+    }
+  }
+
+  if (const auto& cache_config = GetConfig().response_cache) {
+    response_cache_ = std::make_unique<impl::ResponseCache>(*cache_config);
+  }
+
+  if (const auto& dictionary_path = GetConfig().request_zstd_dictionary) {
+    request_zstd_dictionary_ = std::make_unique<compression::zstd::Dictionary>(
+        fs::blocking::ReadFileContents(*dictionary_path));
+  }
+
   if (GetConfig().max_requests_per_second) {
     const auto max_rps = *GetConfig().max_requests_per_second;
     UASSERT_MSG(
@@ -545,6 +609,13 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
         {1, utils::TokenBucket::Duration{std::chrono::seconds(1)} / max_rps});
   }
 
+  if (const auto& per_client = GetConfig().ratelimit_per_client) {
+    per_client_rate_limit_ = std::make_unique<utils::KeyedRateLimiter>(
+        utils::KeyedRateLimiter::Config{
+            static_cast<double>(per_client->max_requests_per_second),
+            per_client->burst});
+  }
+
   auto& server_component = context.FindComponent<components::Server>();
 
   engine::TaskProcessor& task_processor =
@@ -592,15 +663,95 @@ HttpHandlerBase::HttpHandlerBase(const components::ComponentConfig& config,
 
 HttpHandlerBase::~HttpHandlerBase() { statistics_holder_.Unregister(); }
 
+void HttpHandlerBase::HandleRequestNonStream(
+    const http::HttpRequest& http_request,
+    request::RequestContext& context) const {
+  auto& response = http_request.GetHttpResponse();
+  auto data = HandleRequestThrow(http_request, context);
+  // Keep the body shared by the handler via SetSharedData()
+  if (!data.empty() || !response.HasSharedData()) {
+    response.SetData(std::move(data));
+  }
+}
+
+void HttpHandlerBase::HandleRequestCached(
+    const http::HttpRequest& http_request,
+    request::RequestContext& context) const {
+  UASSERT(response_cache_);
+  const auto method = http_request.GetMethod();
+  // The version is taken before the response is built, so a response built
+  // from the older data is never stored with the newer version
+  const auto version =
+      method == http::HttpMethod::kGet || method == http::HttpMethod::kHead
+          ? GetResponseCacheVersion(http_request, context)
+          : std::nullopt;
+  if (!version) {
+    HandleRequestNonStream(http_request, context);
+    return;
+  }
+
+  auto& response = http_request.GetHttpResponse();
+  const auto key = response_cache_->MakeKey(http_request);
+  auto entry = response_cache_->Get(key, *version);
+  if (!entry) {
+    HandleRequestNonStream(http_request, context);
+    if (response.GetStatus() != http::HttpStatus::kOk) return;
+
+    auto new_entry = std::make_shared<impl::ResponseCacheEntry>();
+    new_entry->version = *version;
+    new_entry->body = response.GetData();
+    new_entry->content_type =
+        response.GetHeader(USERVER_NAMESPACE::http::headers::kContentType);
+    new_entry->etag =
+        response.GetHeader(USERVER_NAMESPACE::http::headers::kETag);
+    if (new_entry->etag.empty()) {
+      new_entry->etag = impl::MakeETag(new_entry->body);
+    }
+    entry = std::move(new_entry);
+    response_cache_->Put(key, entry);
+  } else if (!entry->content_type.empty()) {
+    response.SetHeader(USERVER_NAMESPACE::http::headers::kContentType,
+                       entry->content_type);
+  }
+
+  response.SetHeader(USERVER_NAMESPACE::http::headers::kETag, entry->etag);
+  const auto& if_none_match =
+      http_request.GetHeader(USERVER_NAMESPACE::http::headers::kIfNoneMatch);
+  if (!if_none_match.empty() &&
+      impl::IsETagMatched(if_none_match, entry->etag)) {
+    response.SetStatus(http::HttpStatus::kNotModified);
+    response.SetData({});
+    return;
+  }
+
+  // Shares the body with the cache entry without copying it
+  const auto* body = &entry->body;
+  response.SetSharedData(
+      std::shared_ptr<const std::string>(std::move(entry), body));
+}
+
 void HttpHandlerBase::HandleRequestStream(
     const http::HttpRequest& http_request,
     request::RequestContext& context) const {
   auto& response = http_request.GetHttpResponse();
   const utils::ScopeGuard scope([&response] { response.SetHeadersEnd(); });
 
+  std::unique_ptr<http::impl::ResponseStreamCompressor> compressor;
+  if (const auto& compression = GetConfig().response_compression) {
+    const auto encoding = http::NegotiateResponseEncoding(
+        http_request.GetHeader(
+            USERVER_NAMESPACE::http::headers::kAcceptEncoding),
+        compression->encodings);
+    if (encoding) {
+      compressor = std::make_unique<http::impl::ResponseStreamCompressor>(
+          *encoding, *compression,
+          handler_statistics_->ForMethod(http_request.GetMethod()));
+    }
+  }
+
   auto& http_response = http_request.GetHttpResponse();
   server::http::ResponseBodyStream response_body_stream{
-      response.GetBodyProducer(), http_response};
+      response.GetBodyProducer(), http_response, std::move(compressor)};
 
   // Just in case HandleStreamRequest() throws an exception.
   // Though it can be changed in HandleStreamRequest().
@@ -649,6 +800,9 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
   auto& http_request_impl = static_cast<http::HttpRequestImpl&>(request);
   http::HttpRequest http_request(http_request_impl);
   auto& response = http_request.GetHttpResponse();
+  // Does not allocate unless used, the memory is freed with the request
+  utils::Arena request_arena;
+  const utils::CurrentArenaScope arena_scope{request_arena};
   std::optional<tracing::Span> span_storage;
 
   try {
@@ -665,6 +819,9 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
                                        context, config_source_.GetSnapshot());
 
     SetUpBaggage(http_request, request_processor.GetInitialDynamicConfig());
+    if (headers_propagator_) {
+      headers_propagator_->SetUpPropagatedHeaders(http_request);
+    }
     LogYandexHeaders(http_request);
 
     request_processor.ProcessRequestStepNoScopeTime(
@@ -680,7 +837,8 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
         "http_check_auth",
         [this, &http_request, &context] { CheckAuth(http_request, context); });
 
-    if (GetConfig().decompress_request) {
+    // Streamed bodies are passed to the handler as they were sent
+    if (GetConfig().decompress_request && !http_request.IsBodyStreamed()) {
       request_processor.ProcessRequestStep(
           "http_decompress_request_body",
           [this, &http_request] { DecompressRequestBody(http_request); });
@@ -711,9 +869,10 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
         "http_handle_request", [this, &response, &http_request, &context] {
           if (response.IsBodyStreamed()) {
             HandleRequestStream(http_request, context);
+          } else if (response_cache_) {
+            HandleRequestCached(http_request, context);
           } else {
-            // !IsBodyStreamed()
-            response.SetData(HandleRequestThrow(http_request, context));
+            HandleRequestNonStream(http_request, context);
           }
         });
 
@@ -728,6 +887,19 @@ void HttpHandlerBase::HandleRequest(request::RequestBase& request,
     LOG_ERROR() << "unable to handle request: " << ex;
   }
 
+  // Goes after the response is logged to keep the logs readable
+  if (GetConfig().response_compression && span_storage &&
+      !response.IsBodyStreamed()) {
+    try {
+      const tracing::ScopeTime scope_time{"http_compress_response"};
+      CompressResponse(*GetConfig().response_compression, http_request,
+                       response,
+                       handler_statistics_->ForMethod(http_request.GetMethod()));
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "unable to compress response: " << ex;
+    }
+  }
+
   SetResponseAcceptEncoding(response);
   SetResponseServerHostname(response);
   response.SetHeadersEnd();
@@ -854,6 +1026,24 @@ void HttpHandlerBase::CheckRatelimit(
     throw ExceptionWithCode<HandlerErrorCode::kTooManyRequests>();
   }
 
+  if (per_client_rate_limit_) {
+    const auto& per_client = *GetConfig().ratelimit_per_client;
+    const auto& client = http_request.GetHeader(per_client.header);
+    if (!per_client_rate_limit_->Obtain(client)) {
+      auto& http_response = http_request.GetHttpResponse();
+      auto log_reason = fmt::format(
+          "reached per client max_requests_per_second={}, client header '{}'",
+          per_client.max_requests_per_second, per_client.header);
+      SetThrottleReason(
+          http_response, std::move(log_reason),
+          std::string{USERVER_NAMESPACE::http::headers::ratelimit_reason::
+                          kPerClient});
+      statistics.IncrementRateLimitReached();
+
+      throw ExceptionWithCode<HandlerErrorCode::kTooManyRequests>();
+    }
+  }
+
   auto max_requests_in_flight = GetConfig().max_requests_in_flight;
   auto requests_in_flight = statistics.GetInFlight();
   if (max_requests_in_flight &&
@@ -884,12 +1074,19 @@ void HttpHandlerBase::DecompressRequestBody(
   }};
 
   try {
+    const auto max_size = GetConfig().request_config.max_request_size;
+    std::optional<std::string> body;
     if (content_encoding == "gzip") {
+      body = compression::gzip::Decompress(http_request.RequestBody(),
+                                           max_size);
+    } else if (content_encoding == "zstd") {
+      body = compression::zstd::Decompress(http_request.RequestBody(), max_size,
+                                           request_zstd_dictionary_.get());
+    }
+
+    if (body) {
       http_request.RemoveHeader("Content-Encoding");
-      auto body = compression::gzip::Decompress(
-          http_request.RequestBody(),
-          GetConfig().request_config.max_request_size);
-      http_request.SetRequestBody(std::move(body));
+      http_request.SetRequestBody(std::move(*body));
       if (GetConfig().request_config.parse_args_from_body) {
         http_request.ParseArgsFromBody();
       }
@@ -982,7 +1179,7 @@ void HttpHandlerBase::SetResponseAcceptEncoding(
 
   if (!response.HasHeader(USERVER_NAMESPACE::http::headers::kAcceptEncoding)) {
     response.SetHeader(USERVER_NAMESPACE::http::headers::kAcceptEncoding,
-                       "gzip, identity");
+                       "gzip, zstd, identity");
   }
 }
 
@@ -25,6 +25,19 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["deadline-received"] = stats.deadline_received;
   writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
   writer["timings"] = stats.timings;
+
+  if (!stats.compressed_responses) return;
+  if (auto compression = writer["compression"]) {
+    compression["responses"] = stats.compressed_responses;
+    compression["bytes-in"] = stats.compression_bytes_in;
+    compression["bytes-out"] = stats.compression_bytes_out;
+    compression["time-us"] = stats.compression_time_us;
+    if (stats.compression_bytes_out) {
+      compression["ratio"] =
+          static_cast<double>(stats.compression_bytes_in.value) /
+          static_cast<double>(stats.compression_bytes_out.value);
+    }
+  }
 }
 
 }  // namespace
@@ -38,6 +51,17 @@ void HttpHandlerMethodStatistics::Account(
   if (stats.cancelled_by_deadline) ++cancelled_by_deadline_;
 }
 
+void HttpHandlerMethodStatistics::AccountCompression(
+    std::size_t input_size, std::size_t output_size,
+    std::chrono::steady_clock::duration time) noexcept {
+  using Rate = utils::statistics::Rate;
+  ++compressed_responses_;
+  compression_bytes_in_.Add(Rate{input_size});
+  compression_bytes_out_.Add(Rate{output_size});
+  compression_time_us_.Add(Rate{static_cast<Rate::ValueType>(
+      std::chrono::duration_cast<std::chrono::microseconds>(time).count())});
+}
+
 std::size_t HttpHandlerMethodStatistics::GetInFlight() const noexcept {
   const auto finished = finished_.Load();
   const auto started = started_.Load();
@@ -59,7 +83,11 @@ HttpHandlerStatisticsSnapshot::HttpHandlerStatisticsSnapshot(
       too_many_requests_in_flight(stats.too_many_requests_in_flight_.Load()),
       rate_limit_reached(stats.rate_limit_reached_.Load()),
       deadline_received(stats.deadline_received_.Load()),
-      cancelled_by_deadline(stats.cancelled_by_deadline_.Load()) {}
+      cancelled_by_deadline(stats.cancelled_by_deadline_.Load()),
+      compressed_responses(stats.compressed_responses_.Load()),
+      compression_bytes_in(stats.compression_bytes_in_.Load()),
+      compression_bytes_out(stats.compression_bytes_out_.Load()),
+      compression_time_us(stats.compression_time_us_.Load()) {}
 
 void HttpHandlerStatisticsSnapshot::Add(
     const HttpHandlerStatisticsSnapshot& other) {
@@ -71,6 +99,10 @@ void HttpHandlerStatisticsSnapshot::Add(
   rate_limit_reached += other.rate_limit_reached;
   deadline_received += other.deadline_received;
   cancelled_by_deadline += other.cancelled_by_deadline;
+  compressed_responses += other.compressed_responses;
+  compression_bytes_in += other.compression_bytes_in;
+  compression_bytes_out += other.compression_bytes_out;
+  compression_time_us += other.compression_time_us;
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
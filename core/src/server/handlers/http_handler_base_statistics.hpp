@@ -47,6 +47,9 @@ class HttpHandlerMethodStatistics final {
 
   void IncrementRateLimitReached() noexcept { ++rate_limit_reached_; }
 
+  void AccountCompression(std::size_t input_size, std::size_t output_size,
+                          std::chrono::steady_clock::duration time) noexcept;
+
  private:
   friend struct HttpHandlerStatisticsSnapshot;
 
@@ -63,6 +66,10 @@ class HttpHandlerMethodStatistics final {
   utils::statistics::RateCounter rate_limit_reached_;
   utils::statistics::RateCounter deadline_received_;
   utils::statistics::RateCounter cancelled_by_deadline_;
+  utils::statistics::RateCounter compressed_responses_;
+  utils::statistics::RateCounter compression_bytes_in_;
+  utils::statistics::RateCounter compression_bytes_out_;
+  utils::statistics::RateCounter compression_time_us_;
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -84,6 +91,10 @@ struct HttpHandlerStatisticsSnapshot final {
   utils::statistics::Rate rate_limit_reached;
   utils::statistics::Rate deadline_received;
   utils::statistics::Rate cancelled_by_deadline;
+  utils::statistics::Rate compressed_responses;
+  utils::statistics::Rate compression_bytes_in;
+  utils::statistics::Rate compression_bytes_out;
+  utils::statistics::Rate compression_time_us;
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -1,7 +1,13 @@
 #include <userver/server/handlers/http_handler_json_base.hpp>
 
+#include <algorithm>
+#include <string_view>
+
 #include <userver/formats/json/exception.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/validate.hpp>
+#include <userver/formats/msgpack/serialize.hpp>
+#include <userver/http/common_headers.hpp>
 #include <userver/http/content_type.hpp>
 #include <userver/tracing/span.hpp>
 
@@ -9,6 +15,7 @@
 #include <userver/server/handlers/json_error_builder.hpp>
 #include <userver/server/handlers/legacy_json_error_builder.hpp>
 #include <userver/server/http/http_error.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
 #include <userver/server/http/http_status.hpp>
 #include <userver/yaml_config/schema.hpp>
 
@@ -19,11 +26,59 @@ namespace server::handlers {
 namespace {
 
 const std::string kRequestDataName = "__request_json";
+const std::string kRequestLazyDataName = "__request_lazy_json";
 const std::string kResponseDataName = "__response_json";
 const std::string kSerializeJson = "serialize_json";
 
 const formats::json::Value kEmptyJson{};
 
+constexpr std::size_t kResponseChunkSize = 64 * 1024;
+
+namespace content_type = USERVER_NAMESPACE::http::content_type;
+
+bool IsMsgpackContentType(const http::HttpRequest& request) {
+  const auto& header =
+      request.GetHeader(USERVER_NAMESPACE::http::headers::kContentType);
+  if (header.empty()) return false;
+
+  try {
+    const USERVER_NAMESPACE::http::ContentType type{header};
+    return type.DoesAccept(content_type::kApplicationMsgpack);
+  } catch (const USERVER_NAMESPACE::http::MalformedContentType&) {
+    return false;
+  }
+}
+
+// MessagePack is chosen only if it has greater quality than JSON in the
+// Accept header, so wildcards and missing headers keep the JSON responses
+bool IsMsgpackAccepted(const http::HttpRequest& request) {
+  std::string_view header =
+      request.GetHeader(USERVER_NAMESPACE::http::headers::kAccept);
+  int msgpack_quality = 0;
+  int json_quality = 0;
+
+  while (!header.empty()) {
+    const auto delim_pos = header.find(',');
+    const auto media_range = header.substr(0, delim_pos);
+    header.remove_prefix(
+        delim_pos == std::string_view::npos ? header.size() : delim_pos + 1);
+
+    try {
+      const USERVER_NAMESPACE::http::ContentType range{media_range};
+      if (range.DoesAccept(content_type::kApplicationMsgpack)) {
+        msgpack_quality = std::max(msgpack_quality, range.Quality());
+      }
+      if (range.DoesAccept(content_type::kApplicationJson)) {
+        json_quality = std::max(json_quality, range.Quality());
+      }
+    } catch (const USERVER_NAMESPACE::http::MalformedContentType&) {
+      // malformed media ranges are ignored
+    }
+  }
+
+  return msgpack_quality > json_quality;
+}
+
 }  // namespace
 
 HttpHandlerJsonBase::HttpHandlerJsonBase(
@@ -33,22 +88,102 @@ HttpHandlerJsonBase::HttpHandlerJsonBase(
 
 std::string HttpHandlerJsonBase::HandleRequestThrow(
     const http::HttpRequest& request, request::RequestContext& context) const {
-  const auto& request_json =
-      context.GetData<const formats::json::Value&>(kRequestDataName);
-
   auto& response = request.GetHttpResponse();
-  response.SetContentType(
-      USERVER_NAMESPACE::http::content_type::kApplicationJson);
+  if (IsResponseJsonStreamed()) {
+    // the streaming is disabled, the whole JSON is returned at once
+    response.SetContentType(content_type::kApplicationJson);
+    const auto& request_json =
+        context.GetData<const formats::json::Value&>(kRequestDataName);
+    formats::json::StringBuilder response_json;
+    HandleRequestJsonStreamThrow(request, request_json, context,
+                                 response_json);
+    return response_json.GetString();
+  }
 
+  const bool is_msgpack_response =
+      IsMsgpackAllowed() && IsMsgpackAccepted(request);
+  response.SetContentType(is_msgpack_response
+                              ? content_type::kApplicationMsgpack
+                              : content_type::kApplicationJson);
+
+  auto response_json_value = [&] {
+    if (IsRequestJsonLazy()) {
+      const auto& request_document =
+          context.GetData<const formats::json::LazyDocument&>(
+              kRequestLazyDataName);
+      return HandleRequestLazyJsonThrow(request, request_document.GetRoot(),
+                                        context);
+    }
+    const auto& request_json =
+        context.GetData<const formats::json::Value&>(kRequestDataName);
+    return HandleRequestJsonThrow(request, request_json, context);
+  }();
   const auto& response_json = context.SetData<const formats::json::Value>(
-      kResponseDataName,
-      HandleRequestJsonThrow(request, request_json, context));
+      kResponseDataName, std::move(response_json_value));
 
   const auto scope_time =
       tracing::Span::CurrentSpan().CreateScopeTime(kSerializeJson);
+  if (is_msgpack_response) return formats::msgpack::ToString(response_json);
   return formats::json::ToString(response_json);
 }
 
+formats::json::Value HttpHandlerJsonBase::HandleRequestJsonThrow(
+    const http::HttpRequest&, const formats::json::Value&,
+    request::RequestContext&) const {
+  throw std::runtime_error(
+      "HandleRequestJsonThrow() is executed, but the handler doesn't "
+      "override HandleRequestJsonThrow().");
+}
+
+formats::json::Value HttpHandlerJsonBase::HandleRequestLazyJsonThrow(
+    const http::HttpRequest&, const formats::json::LazyValue&,
+    request::RequestContext&) const {
+  throw std::runtime_error(
+      "HandleRequestLazyJsonThrow() is executed, but the handler doesn't "
+      "override HandleRequestLazyJsonThrow().");
+}
+
+void HttpHandlerJsonBase::HandleRequestJsonStreamThrow(
+    const http::HttpRequest&, const formats::json::Value&,
+    request::RequestContext&, formats::json::StringBuilder&) const {
+  throw std::runtime_error(
+      "HandleRequestJsonStreamThrow() is executed, but the handler doesn't "
+      "override HandleRequestJsonStreamThrow().");
+}
+
+void HttpHandlerJsonBase::HandleStreamRequest(
+    const http::HttpRequest& request, request::RequestContext& context,
+    http::ResponseBodyStream& response) const {
+  if (!IsResponseJsonStreamed()) {
+    HttpHandlerBase::HandleStreamRequest(request, context, response);
+    return;
+  }
+
+  // The headers are sent with the first chunk, so the errors of the beginning
+  // of the handling are still reported with the status code
+  bool headers_sent = false;
+  const auto send_headers = [&response, &headers_sent] {
+    if (headers_sent) return;
+    response.SetStatusCode(http::HttpStatus::kOk);
+    response.SetHeader(USERVER_NAMESPACE::http::headers::kContentType,
+                       content_type::kApplicationJson.ToString());
+    response.SetEndOfHeaders();
+    headers_sent = true;
+  };
+
+  const auto& request_json =
+      context.GetData<const formats::json::Value&>(kRequestDataName);
+  formats::json::StringBuilder response_json{
+      [&response, &send_headers](std::string&& chunk) {
+        send_headers();
+        response.PushBodyChunk(std::move(chunk), engine::Deadline{});
+      },
+      kResponseChunkSize};
+  HandleRequestJsonStreamThrow(request, request_json, context, response_json);
+  response_json.Flush();
+  send_headers();
+}
+
 const formats::json::Value* HttpHandlerJsonBase::GetRequestJson(
     const request::RequestContext& context) {
   return context.GetDataOptional<const formats::json::Value>(kRequestDataName);
@@ -72,14 +207,63 @@ FormattedErrorData HttpHandlerJsonBase::GetFormattedExternalErrorBody(
 
 void HttpHandlerJsonBase::ParseRequestData(
     const http::HttpRequest& request, request::RequestContext& context) const {
+  if (IsRequestJsonLazy()) {
+    ParseRequestLazyData(request, context);
+    return;
+  }
+
   if (request.RequestBody().empty()) {
     context.SetData<const formats::json::Value>(kRequestDataName, kEmptyJson);
     return;
   }
 
+  if (IsMsgpackAllowed() && IsMsgpackContentType(request)) {
+    try {
+      const auto& body = request.RequestBody();
+      auto request_json = formats::msgpack::FromString(body);
+      const auto* schema = GetRequestJsonSchema();
+      if (schema && !formats::json::Validate(request_json, *schema)) {
+        throw formats::json::SchemaValidationException(
+            "JSON schema validation error");
+      }
+      context.SetData<const formats::json::Value>(kRequestDataName,
+                                                  std::move(request_json));
+    } catch (const formats::json::Exception& e) {
+      throw RequestParseError(
+          InternalMessage{"Invalid MessagePack body"},
+          ExternalBody{std::string("Invalid MessagePack body: ") + e.what()});
+    }
+    return;
+  }
+
+  try {
+    const auto& body = request.RequestBody();
+    formats::json::Value request_json;
+    if (const auto* schema = GetRequestJsonSchema()) {
+      request_json = formats::json::FromStringValidated(body, *schema);
+    } else if (IsRequestJsonArenaAllocated()) {
+      request_json = formats::json::FromStringWithArena(body);
+    } else {
+      request_json = formats::json::FromString(body);
+    }
+    context.SetData<const formats::json::Value>(kRequestDataName,
+                                                std::move(request_json));
+  } catch (const formats::json::Exception& e) {
+    throw RequestParseError(
+        InternalMessage{"Invalid JSON body"},
+        ExternalBody{std::string("Invalid JSON body: ") + e.what()});
+  }
+}
+
+void HttpHandlerJsonBase::ParseRequestLazyData(
+    const http::HttpRequest& request, request::RequestContext& context) const {
+  // The document refers to the body, that outlives the request context data
+  const std::string_view body = request.RequestBody().empty()
+                                    ? std::string_view{"null"}
+                                    : std::string_view{request.RequestBody()};
   try {
-    context.SetData<const formats::json::Value>(
-        kRequestDataName, formats::json::FromString(request.RequestBody()));
+    context.EmplaceData<formats::json::LazyDocument>(kRequestLazyDataName,
+                                                     body);
   } catch (const formats::json::Exception& e) {
     throw RequestParseError(
         InternalMessage{"Invalid JSON body"},
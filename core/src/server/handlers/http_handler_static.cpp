@@ -52,9 +52,12 @@ std::string HttpHandlerStatic::HandleRequestThrow(
   const auto file = storage_.TryGetFile(request.GetRequestPath());
   if (file) {
     const auto config = config_.GetSnapshot();
-    request.GetHttpResponse().SetContentType(
-        config[kContentTypeMap][file->extension]);
-    return file->data;
+    auto& response = request.GetHttpResponse();
+    response.SetContentType(config[kContentTypeMap][file->extension]);
+    // Sends the cached file without copying it into the response
+    response.SetSharedData(
+        std::shared_ptr<const std::string>{file, &file->data});
+    return {};
   }
   request.GetResponse().SetStatusNotFound();
   return "File not found";
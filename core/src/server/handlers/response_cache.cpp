@@ -0,0 +1,99 @@
+#include <server/handlers/response_cache.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+#include <fmt/format.h>
+
+#include <userver/crypto/hash.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers::impl {
+
+namespace {
+
+// Length prefixed, so that the args with separators inside do not collide
+void AppendKeyPart(std::string& key, std::string_view part) {
+  fmt::format_to(std::back_inserter(key), "{}:", part.size());
+  key.append(part);
+}
+
+std::string_view TrimSpaces(std::string_view value) {
+  while (!value.empty() && utils::text::IsAsciiSpace(value.front())) {
+    value.remove_prefix(1);
+  }
+  while (!value.empty() && utils::text::IsAsciiSpace(value.back())) {
+    value.remove_suffix(1);
+  }
+  return value;
+}
+
+std::string_view StripWeakPrefix(std::string_view etag) {
+  constexpr std::string_view kWeakPrefix = "W/";
+  if (utils::text::StartsWith(etag, kWeakPrefix)) {
+    etag.remove_prefix(kWeakPrefix.size());
+  }
+  return etag;
+}
+
+}  // namespace
+
+ResponseCache::ResponseCache(const ResponseCacheConfig& config)
+    : headers_(config.headers),
+      entries_(config.ways, std::max<std::size_t>(
+                                1, config.max_entries / config.ways)) {}
+
+std::string ResponseCache::MakeKey(const http::HttpRequest& request) const {
+  std::string key;
+  AppendKeyPart(key, request.GetRequestPath());
+
+  auto arg_names = request.ArgNames();
+  std::sort(arg_names.begin(), arg_names.end());
+  for (const auto& name : arg_names) {
+    const auto& values = request.GetArgVector(name);
+    AppendKeyPart(key, name);
+    fmt::format_to(std::back_inserter(key), "{}:", values.size());
+    for (const auto& value : values) AppendKeyPart(key, value);
+  }
+
+  for (const auto& header : headers_) {
+    AppendKeyPart(key, request.GetHeader(header));
+  }
+  return key;
+}
+
+ResponseCacheEntryPtr ResponseCache::Get(const std::string& key,
+                                         std::uint64_t version) {
+  auto entry = entries_.Get(key, [version](const ResponseCacheEntryPtr& e) {
+    return e->version == version;
+  });
+  return entry ? std::move(*entry) : nullptr;
+}
+
+void ResponseCache::Put(const std::string& key, ResponseCacheEntryPtr entry) {
+  UASSERT(entry);
+  entries_.Put(key, std::move(entry));
+}
+
+std::string MakeETag(std::string_view body) {
+  const auto hash =
+      crypto::hash::Sha1(body, crypto::hash::OutputEncoding::kBase64);
+  return fmt::format("\"{}\"", hash);
+}
+
+bool IsETagMatched(std::string_view if_none_match, std::string_view etag) {
+  etag = StripWeakPrefix(etag);
+  for (auto candidate :
+       utils::text::SplitIntoStringViewVector(if_none_match, ",")) {
+    candidate = TrimSpaces(candidate);
+    if (candidate == "*" || StripWeakPrefix(candidate) == etag) return true;
+  }
+  return false;
+}
+
+}  // namespace server::handlers::impl
+
+USERVER_NAMESPACE_END
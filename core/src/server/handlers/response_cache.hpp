@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/server/handlers/handler_config.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/utils/hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers::impl {
+
+struct ResponseCacheEntry {
+  std::uint64_t version{0};
+  std::string body;
+  std::string content_type;
+  std::string etag;
+};
+
+using ResponseCacheEntryPtr = std::shared_ptr<const ResponseCacheEntry>;
+
+// Serialized responses of a handler by the request path, args and the
+// configured headers
+class ResponseCache final {
+ public:
+  explicit ResponseCache(const ResponseCacheConfig& config);
+
+  std::string MakeKey(const http::HttpRequest& request) const;
+
+  // Entries of other versions are dropped
+  ResponseCacheEntryPtr Get(const std::string& key, std::uint64_t version);
+
+  void Put(const std::string& key, ResponseCacheEntryPtr entry);
+
+ private:
+  const std::vector<std::string> headers_;
+  // The keys come from the requests
+  cache::NWayLRU<std::string, ResponseCacheEntryPtr,
+                 utils::hash::SeededHash<std::string>>
+      entries_;
+};
+
+// Strong entity tag of the body
+std::string MakeETag(std::string_view body);
+
+// Weak comparison of the If-None-Match header value with the entity tag
+bool IsETagMatched(std::string_view if_none_match, std::string_view etag);
+
+}  // namespace server::handlers::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,55 @@
+#include <server/handlers/response_cache.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::handlers::impl::IsETagMatched;
+using server::handlers::impl::MakeETag;
+using server::handlers::impl::ResponseCache;
+using server::handlers::impl::ResponseCacheEntry;
+
+}  // namespace
+
+TEST(ResponseCache, ETag) {
+  const auto etag = MakeETag("body");
+  EXPECT_EQ(etag, MakeETag("body"));
+  EXPECT_NE(etag, MakeETag("other body"));
+  EXPECT_EQ(etag.front(), '"');
+  EXPECT_EQ(etag.back(), '"');
+}
+
+TEST(ResponseCache, IfNoneMatch) {
+  EXPECT_TRUE(IsETagMatched(R"("abc")", R"("abc")"));
+  EXPECT_TRUE(IsETagMatched(R"(W/"abc")", R"("abc")"));
+  EXPECT_TRUE(IsETagMatched(R"("xyz", W/"abc" )", R"("abc")"));
+  EXPECT_TRUE(IsETagMatched("*", R"("abc")"));
+  EXPECT_TRUE(IsETagMatched(R"("abc")", R"(W/"abc")"));
+
+  EXPECT_FALSE(IsETagMatched(R"("xyz")", R"("abc")"));
+  EXPECT_FALSE(IsETagMatched(R"("abcd", "ab")", R"("abc")"));
+  EXPECT_FALSE(IsETagMatched("abc", R"("abc")"));
+}
+
+UTEST(ResponseCache, Versions) {
+  ResponseCache cache{{}};
+  EXPECT_EQ(cache.Get("key", 1), nullptr);
+
+  auto entry = std::make_shared<ResponseCacheEntry>();
+  entry->version = 1;
+  entry->body = "body";
+  cache.Put("key", entry);
+
+  const auto found = cache.Get("key", 1);
+  ASSERT_NE(found, nullptr);
+  EXPECT_EQ(found->body, "body");
+  EXPECT_EQ(cache.Get("other", 1), nullptr);
+
+  // The entry of an older version is dropped
+  EXPECT_EQ(cache.Get("key", 2), nullptr);
+  EXPECT_EQ(cache.Get("key", 1), nullptr);
+}
+
+USERVER_NAMESPACE_END
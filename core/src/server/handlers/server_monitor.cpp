@@ -1,9 +1,17 @@
 #include <userver/server/handlers/server_monitor.hpp>
 
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include <userver/components/component.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/http/common_headers.hpp>
 #include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
 #include <userver/utils/statistics/graphite.hpp>
 #include <userver/utils/statistics/json.hpp>
 #include <userver/utils/statistics/pretty_format.hpp>
@@ -22,6 +30,11 @@ namespace server::handlers {
 
 namespace {
 
+// Sent while the rest of the metrics is being serialized
+constexpr std::size_t kStreamChunkSize = 64 * 1024;
+// The whole output goes to a single chunk
+constexpr std::size_t kWholeResponse = std::numeric_limits<std::size_t>::max();
+
 enum class StatsFormat {
   kInternal,
   kGraphite,
@@ -55,8 +68,47 @@ StatsFormat ParseFormat(std::string_view format) {
                   format, kToFormat.DescribeFirst())});
 }
 
+std::string_view GetContentType(StatsFormat format) {
+  switch (format) {
+    case StatsFormat::kJson:
+    case StatsFormat::kSolomon:
+    case StatsFormat::kInternal:
+      return "application/json";
+    default:
+      return "text/plain; charset=utf-8";
+  }
+}
+
 }  // namespace
 
+struct ServerMonitor::DeltaConsumers final {
+  explicit DeltaConsumers(std::size_t max_consumers)
+      : max_consumers(max_consumers) {}
+
+  utils::statistics::MetricsDelta& Get(const std::string& consumer) {
+    const std::lock_guard lock{mutex};
+    auto& delta = deltas[consumer];
+    if (!delta) {
+      if (deltas.size() > max_consumers) {
+        deltas.erase(consumer);
+        throw handlers::ClientError(handlers::ExternalBody{fmt::format(
+            "Too many distinct 'delta' URL parameter values, at most {} are "
+            "supported",
+            max_consumers)});
+      }
+      delta = std::make_unique<utils::statistics::MetricsDelta>();
+    }
+    return *delta;
+  }
+
+  const std::size_t max_consumers;
+  engine::Mutex mutex;
+  // MetricsDelta are never removed, references to them stay valid
+  std::unordered_map<std::string,
+                     std::unique_ptr<utils::statistics::MetricsDelta>>
+      deltas;
+};
+
 ServerMonitor::ServerMonitor(
     const components::ComponentConfig& config,
     const components::ComponentContext& component_context)
@@ -64,10 +116,60 @@ ServerMonitor::ServerMonitor(
       statistics_storage_(
           component_context.FindComponent<components::StatisticsStorage>()
               .GetStorage()),
-      common_labels_{config["common-labels"].As<CommonLabels>({})} {}
+      common_labels_{config["common-labels"].As<CommonLabels>({})},
+      delta_consumers_(std::make_unique<DeltaConsumers>(
+          config["max-delta-consumers"].As<std::size_t>(16))),
+      prometheus_names_(
+          std::make_unique<utils::statistics::PrometheusNamesCache>()) {}
+
+ServerMonitor::~ServerMonitor() = default;
+
+struct ServerMonitor::ParsedRequest final {
+  StatsFormat format;
+  utils::statistics::Request statistics_request;
+};
 
 std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
                                               request::RequestContext&) const {
+  const auto parsed = ParseRequest(request);
+  request.GetHttpResponse().SetContentType(GetContentType(parsed.format));
+  return Serialize(parsed);
+}
+
+void ServerMonitor::HandleStreamRequest(
+    const http::HttpRequest& request, request::RequestContext&,
+    http::ResponseBodyStream& stream) const {
+  const auto parsed = ParseRequest(request);
+  stream.SetHeader(USERVER_NAMESPACE::http::headers::kContentType,
+                   std::string{GetContentType(parsed.format)});
+  stream.SetStatusCode(http::HttpStatus::kOk);
+  stream.SetEndOfHeaders();
+
+  // Called under the lock of the statistics storage. The body queue of the
+  // response is unbounded, so the push never waits for the client.
+  const auto consumer = [&stream](std::string&& chunk) {
+    stream.PushBodyChunk(std::move(chunk), engine::Deadline{});
+  };
+  switch (parsed.format) {
+    case StatsFormat::kPrometheus:
+      utils::statistics::ToPrometheusFormat(
+          statistics_storage_, parsed.statistics_request, *prometheus_names_,
+          kStreamChunkSize, consumer);
+      return;
+
+    case StatsFormat::kPrometheusUntyped:
+      utils::statistics::ToPrometheusFormatUntyped(
+          statistics_storage_, parsed.statistics_request, *prometheus_names_,
+          kStreamChunkSize, consumer);
+      return;
+
+    default:
+      stream.PushBodyChunk(Serialize(parsed), engine::Deadline{});
+  }
+}
+
+ServerMonitor::ParsedRequest ServerMonitor::ParseRequest(
+    const http::HttpRequest& request) const {
   const auto& prefix = request.GetArg("prefix");
   const auto& path = request.GetArg("path");
   if (!path.empty() && !prefix.empty() && path != prefix) {
@@ -89,28 +191,49 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
   using utils::statistics::Request;
   auto common_labels =
       format == StatsFormat::kSolomon ? Request::AddLabels{} : common_labels_;
-  const auto statistics_request =
+  const auto& delta_consumer = request.GetArg("delta");
+  if (!delta_consumer.empty() && format == StatsFormat::kInternal) {
+    throw handlers::ClientError(handlers::ExternalBody{
+        "'delta' URL parameter is not supported by the internal format"});
+  }
+
+  const auto full_request =
       (path.empty() ? Request::MakeWithPrefix(prefix, std::move(common_labels),
                                               std::move(labels))
                     : Request::MakeWithPath(path, std::move(common_labels),
                                             std::move(labels)));
+  return {format,
+          delta_consumer.empty()
+              ? full_request
+              : full_request.WithDelta(delta_consumers_->Get(delta_consumer))};
+}
 
-  request.GetHttpResponse().SetContentType("text/plain; charset=utf-8");
-  switch (format) {
+std::string ServerMonitor::Serialize(const ParsedRequest& request) const {
+  const auto& statistics_request = request.statistics_request;
+  switch (request.format) {
     case StatsFormat::kGraphite:
       return utils::statistics::ToGraphiteFormat(statistics_storage_,
                                                  statistics_request);
 
-    case StatsFormat::kPrometheus:
-      return utils::statistics::ToPrometheusFormat(statistics_storage_,
-                                                   statistics_request);
+    case StatsFormat::kPrometheus: {
+      std::string result;
+      utils::statistics::ToPrometheusFormat(
+          statistics_storage_, statistics_request, *prometheus_names_,
+          kWholeResponse,
+          [&result](std::string&& chunk) { result = std::move(chunk); });
+      return result;
+    }
 
-    case StatsFormat::kPrometheusUntyped:
-      return utils::statistics::ToPrometheusFormatUntyped(statistics_storage_,
-                                                          statistics_request);
+    case StatsFormat::kPrometheusUntyped: {
+      std::string result;
+      utils::statistics::ToPrometheusFormatUntyped(
+          statistics_storage_, statistics_request, *prometheus_names_,
+          kWholeResponse,
+          [&result](std::string&& chunk) { result = std::move(chunk); });
+      return result;
+    }
 
     case StatsFormat::kJson:
-      request.GetHttpResponse().SetContentType("application/json");
       return utils::statistics::ToJsonFormat(statistics_storage_,
                                              statistics_request);
 
@@ -119,12 +242,10 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
                                                statistics_request);
 
     case StatsFormat::kSolomon:
-      request.GetHttpResponse().SetContentType("application/json");
       return utils::statistics::ToSolomonFormat(
           statistics_storage_, common_labels_, statistics_request);
 
     case StatsFormat::kInternal:
-      request.GetHttpResponse().SetContentType("application/json");
       const auto json = statistics_storage_.GetAsJson();
       UASSERT(utils::statistics::AreAllMetricsNumbers(json));
       return formats::json::ToString(json);
@@ -153,6 +274,13 @@ properties:
             added to each metric.
         additionalProperties: true
         properties: {}
+    max-delta-consumers:
+        type: integer
+        description: |
+            How many distinct values of the 'delta' URL parameter are
+            remembered
+        defaultDescription: 16
+        minimum: 1
   )");
 }
 
@@ -30,16 +30,23 @@ void FixedPathIndex::AddHandler(const handlers::HttpHandlerBase& handler,
 void FixedPathIndex::AddHandler(std::string path,
                                 const handlers::HttpHandlerBase& handler,
                                 engine::TaskProcessor& task_processor) {
-  handler_method_index_map_[std::move(path)].AddHandler(handler, task_processor,
-                                                        {});
+  auto index = path_index_.Find(path);
+  if (index == PerfectHashIndex::kNotFound) {
+    index = paths_.size();
+    paths_.push_back(std::move(path));
+    path_index_ = PerfectHashIndex{paths_};
+    handler_method_indices_.emplace_back();
+  }
+  handler_method_indices_[index].AddHandler(handler, task_processor, {});
 }
 
 bool FixedPathIndex::MatchRequest(HttpMethod method, const std::string& path,
                                   MatchRequestResult& match_result) const {
-  auto it = handler_method_index_map_.find(path);
-  if (it == handler_method_index_map_.end()) return false;
+  const auto index = path_index_.Find(path);
+  if (index == PerfectHashIndex::kNotFound) return false;
 
-  const auto* handler_info_data = it->second.GetHandlerInfoData(method);
+  const auto* handler_info_data =
+      handler_method_indices_[index].GetHandlerInfoData(method);
   if (!handler_info_data) {
     match_result.status = MatchRequestResult::Status::kMethodNotAllowed;
     return false;
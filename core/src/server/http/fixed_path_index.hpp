@@ -1,12 +1,14 @@
 #pragma once
 
+#include <deque>
 #include <string>
-#include <unordered_map>
+#include <vector>
 
 #include <userver/engine/task/task_processor_fwd.hpp>
 
 #include <server/http/handler_info_index.hpp>
 #include <server/http/handler_method_index.hpp>
+#include <server/http/perfect_hash_index.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/server/http/http_method.hpp>
 
@@ -25,7 +27,10 @@ class FixedPathIndex final {
   void AddHandler(std::string path, const handlers::HttpHandlerBase& handler,
                   engine::TaskProcessor& task_processor);
 
-  std::unordered_map<std::string, HandlerMethodIndex> handler_method_index_map_;
+  // rebuilt on each new path, handlers are registered once on startup
+  std::vector<std::string> paths_;
+  PerfectHashIndex path_index_;
+  std::deque<HandlerMethodIndex> handler_method_indices_;
 };
 
 }  // namespace server::http::impl
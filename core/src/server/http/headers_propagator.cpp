@@ -2,6 +2,8 @@
 
 #include <userver/server/request/task_inherited_request.hpp>
 
+#include <utils/internal_tag.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
@@ -9,8 +11,35 @@ namespace server::http {
 HeadersPropagator::HeadersPropagator(std::vector<std::string>&& headers)
     : headers_(std::move(headers)) {}
 
+void HeadersPropagator::SetUpPropagatedHeaders(
+    const HttpRequest& request) const {
+  if (headers_.empty()) return;
+
+  PropagatedHeaders propagated;
+  propagated.headers.reserve(headers_.size());
+  for (const auto& header : headers_) {
+    const auto& value = request.GetHeader(header);
+    // Empty headers are not sent, same as with RequestTracingEditor::SetHeader
+    if (value.empty()) continue;
+
+    auto& serialized = propagated.headers.emplace_back();
+    serialized.name_size = header.size();
+    serialized.serialized.reserve(header.size() + 2 + value.size());
+    serialized.serialized.append(header).append(": ").append(value);
+  }
+  kPropagatedHeaders.Set(std::move(propagated));
+}
+
 void HeadersPropagator::PropagateHeaders(
     clients::http::RequestTracingEditor request) const {
+  if (const auto* propagated = kPropagatedHeaders.GetOptional()) {
+    for (const auto& header : propagated->headers) {
+      request.SetSerializedHeader(header.GetName(), header.serialized,
+                                  utils::InternalTag{});
+    }
+    return;
+  }
+
   for (const auto& header : headers_) {
     if (server::request::HasTaskInheritedHeader(header)) {
       request.SetHeader(header,
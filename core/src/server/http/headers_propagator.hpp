@@ -1,19 +1,43 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <userver/clients/http/request_tracing_editor.hpp>
+#include <userver/engine/task/inherited_variable.hpp>
 #include <userver/server/http/http_request.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
+/// Headers of the incoming request to propagate. They are serialized once per
+/// request and are shared by all the outgoing requests of the task hierarchy.
+struct PropagatedHeaders final {
+  struct Header final {
+    std::string_view GetName() const {
+      return std::string_view{serialized}.substr(0, name_size);
+    }
+
+    // "name: value"
+    std::string serialized;
+    std::size_t name_size{0};
+  };
+
+  std::vector<Header> headers;
+};
+
+inline engine::TaskInheritedVariable<PropagatedHeaders> kPropagatedHeaders;
+
 class HeadersPropagator final {
  public:
   explicit HeadersPropagator(std::vector<std::string>&&);
 
+  /// Serializes the headers of the incoming request into kPropagatedHeaders
+  void SetUpPropagatedHeaders(const HttpRequest& request) const;
+
   void PropagateHeaders(clients::http::RequestTracingEditor request) const;
 
  private:
@@ -0,0 +1,643 @@
+#include <server/http/http2_session.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <fmt/format.h>
+#include <nghttp2/nghttp2.h>
+
+#include <userver/engine/task/cancel.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <server/http/http_cached_date.hpp>
+
+#include "http_request_constructor.hpp"
+#include "http_request_impl.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+// Same as for HTTP/1.1, see http_response.cpp
+constexpr std::string_view kDefaultContentType = "application/octet-stream";
+
+// Bigger chunks are written to the socket right away
+constexpr std::size_t kMaxSendBufferSize = 64 * 1024;
+
+constexpr std::size_t kFrameHeaderSize = 9;
+
+bool IsBodyForbiddenForStatus(HttpStatus status) {
+  return status == HttpStatus::kNoContent ||
+         status == HttpStatus::kNotModified ||
+         (static_cast<int>(status) >= 100 && static_cast<int>(status) < 200);
+}
+
+// RFC 9113, section 8.2.2
+bool IsConnectionSpecificHeader(std::string_view lowercase_name) {
+  return lowercase_name == "connection" || lowercase_name == "keep-alive" ||
+         lowercase_name == "proxy-connection" ||
+         lowercase_name == "transfer-encoding" || lowercase_name == "upgrade" ||
+         lowercase_name == "content-length";
+}
+
+std::string ToLowerAscii(std::string_view str) {
+  std::string result{str};
+  for (auto& c : result) {
+    if (c >= 'A' && c <= 'Z') c = c - 'A' + 'a';
+  }
+  return result;
+}
+
+nghttp2_nv MakeNv(const std::string& name, const std::string& value) {
+  // nghttp2 copies the headers on submit
+  return {reinterpret_cast<std::uint8_t*>(const_cast<char*>(name.data())),
+          reinterpret_cast<std::uint8_t*>(const_cast<char*>(value.data())),
+          name.size(), value.size(), NGHTTP2_NV_FLAG_NONE};
+}
+
+}  // namespace
+
+namespace impl {
+
+class Http2ResponseWriter final {
+ public:
+  using Headers = std::vector<std::pair<std::string, std::string>>;
+
+  static bool HasBody(const HttpResponse& response) {
+    return !IsBodyForbiddenForStatus(response.status_) &&
+           response.request_.GetMethod() != HttpMethod::kHead;
+  }
+
+  static bool IsBodyStreamed(const HttpResponse& response) {
+    // e.g. a CustomHandlerException replaces the streamed body
+    return response.IsBodyStreamed() && response.GetData().empty();
+  }
+
+  static Headers MakeHeaders(const HttpResponse& response, bool is_streamed) {
+    namespace headers = USERVER_NAMESPACE::http::headers;
+
+    Headers result;
+    result.reserve(response.headers_.size() + response.cookies_.size() + 4);
+    result.emplace_back(":status",
+                        fmt::to_string(static_cast<int>(response.status_)));
+    for (const auto& [name, value] : response.headers_) {
+      auto lowercase_name = ToLowerAscii(name);
+      if (IsConnectionSpecificHeader(lowercase_name)) continue;
+      result.emplace_back(std::move(lowercase_name), value);
+    }
+
+    if (!response.HasHeader(headers::kDate)) {
+      result.emplace_back("date", std::string{impl::GetCachedDate()});
+    }
+    if (!response.HasHeader(headers::kContentType)) {
+      result.emplace_back("content-type", std::string{kDefaultContentType});
+    }
+    if (!is_streamed && !IsBodyForbiddenForStatus(response.status_)) {
+      result.emplace_back("content-length",
+                          fmt::to_string(response.GetData().size()));
+    }
+    for (const auto& cookie : response.cookies_) {
+      result.emplace_back("set-cookie", cookie.second.ToString());
+    }
+    return result;
+  }
+
+  static bool PopBodyPart(HttpResponse& response, std::string& part) {
+    return response.body_stream_->Pop(part);
+  }
+
+  static void FinishBodyStream(HttpResponse& response) {
+    response.body_stream_producer_.reset();
+    response.body_stream_.reset();
+  }
+
+  static void SetSent(HttpResponse& response, std::size_t sent_bytes) {
+    response.SetSent(sent_bytes, std::chrono::steady_clock::now());
+  }
+};
+
+}  // namespace impl
+
+struct Http2Session::Stream final {
+  Stream(const request::HttpRequestConfig& request_config,
+         const HandlerInfoIndex& handler_info_index,
+         request::ResponseDataAccounter& data_accounter) {
+    constructor.emplace(request_config, handler_info_index, data_accounter);
+  }
+
+  std::string_view GetPendingBody() const noexcept {
+    if (!is_body_streamed) return body_view;
+    return std::string_view{streamed_body}.substr(streamed_body_offset);
+  }
+
+  void ConsumeBody(std::size_t size) noexcept {
+    if (!is_body_streamed) {
+      body_view.remove_prefix(size);
+      return;
+    }
+    streamed_body_offset += size;
+    if (streamed_body_offset == streamed_body.size()) {
+      streamed_body.clear();
+      streamed_body_offset = 0;
+    }
+  }
+
+  // Request receive, the constructor is reset once the request is finalized
+  std::optional<HttpRequestConstructor> constructor;
+  std::string method;
+  std::string path;
+  std::string authority;
+  bool is_url_parsed{false};
+
+  std::shared_ptr<request::RequestBase> request;
+  // Closed by the peer before the response was submitted
+  bool is_closed{false};
+
+  // Response send
+  bool is_response_submitted{false};
+  bool is_reset{false};
+  bool is_body_streamed{false};
+  bool is_body_complete{false};
+  std::string_view body_view;
+  std::string streamed_body;
+  std::size_t streamed_body_offset{0};
+  std::size_t sent_bytes{0};
+};
+
+struct Http2Session::Callbacks final {
+  static const nghttp2_session_callbacks* Get() {
+    using CallbacksPtr =
+        std::unique_ptr<nghttp2_session_callbacks,
+                        decltype(&nghttp2_session_callbacks_del)>;
+
+    static const CallbacksPtr callbacks = [] {
+      nghttp2_session_callbacks* result = nullptr;
+      if (nghttp2_session_callbacks_new(&result) != 0) {
+        throw std::bad_alloc();
+      }
+      nghttp2_session_callbacks_set_on_begin_headers_callback(result,
+                                                              &OnBeginHeaders);
+      nghttp2_session_callbacks_set_on_header_callback(result, &OnHeader);
+      nghttp2_session_callbacks_set_on_frame_recv_callback(result,
+                                                           &OnFrameRecv);
+      nghttp2_session_callbacks_set_on_data_chunk_recv_callback(
+          result, &OnDataChunkRecv);
+      nghttp2_session_callbacks_set_on_frame_send_callback(result,
+                                                           &OnFrameSend);
+      nghttp2_session_callbacks_set_on_stream_close_callback(result,
+                                                             &OnStreamClose);
+      return CallbacksPtr{result, &nghttp2_session_callbacks_del};
+    }();
+    return callbacks.get();
+  }
+
+  static int OnBeginHeaders(nghttp2_session*, const nghttp2_frame* frame,
+                            void* user_data) {
+    if (frame->hd.type != NGHTTP2_HEADERS ||
+        frame->headers.cat != NGHTTP2_HCAT_REQUEST) {
+      return 0;
+    }
+
+    auto& self = *static_cast<Http2Session*>(user_data);
+    try {
+      self.streams_.emplace(
+          frame->hd.stream_id,
+          std::make_unique<Stream>(self.request_config_,
+                                   self.handler_info_index_,
+                                   self.data_accounter_));
+      ++self.stats_.parsing_request_count;
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Failed to start HTTP/2 stream: " << ex;
+      return NGHTTP2_ERR_CALLBACK_FAILURE;
+    }
+    return 0;
+  }
+
+  static int OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+                      const std::uint8_t* name, std::size_t name_size,
+                      const std::uint8_t* value, std::size_t value_size,
+                      std::uint8_t /*flags*/, void* user_data) {
+    // Trailers are ignored
+    if (frame->hd.type != NGHTTP2_HEADERS ||
+        frame->headers.cat != NGHTTP2_HCAT_REQUEST) {
+      return 0;
+    }
+
+    auto& self = *static_cast<Http2Session*>(user_data);
+    const auto stream_id = frame->hd.stream_id;
+    auto* stream = self.FindStream(stream_id);
+    if (!stream) return 0;
+
+    const std::string_view name_view{reinterpret_cast<const char*>(name),
+                                     name_size};
+    const std::string_view value_view{reinterpret_cast<const char*>(value),
+                                      value_size};
+    LOG_TRACE() << "stream " << stream_id << " header: '" << name_view
+                << "': '" << value_view << '\'';
+
+    // nghttp2 guarantees that pseudo-headers come first
+    if (!name_view.empty() && name_view.front() == ':') {
+      if (name_view == ":method") {
+        stream->method = value_view;
+      } else if (name_view == ":path") {
+        stream->path = value_view;
+      } else if (name_view == ":authority") {
+        stream->authority = value_view;
+      }
+      return 0;
+    }
+    // :authority takes precedence, see RFC 9113, section 8.3.1
+    if (name_view == "host" && !stream->authority.empty()) return 0;
+
+    return ModifyRequest(
+        self, stream_id, *stream, [&](HttpRequestConstructor& constructor) {
+          ParseUrl(*stream);
+          constructor.AppendHeaderField(name_view.data(), name_view.size());
+          constructor.AppendHeaderValue(value_view.data(), value_view.size());
+        });
+  }
+
+  static int OnFrameRecv(nghttp2_session*, const nghttp2_frame* frame,
+                         void* user_data) {
+    if (frame->hd.type != NGHTTP2_HEADERS && frame->hd.type != NGHTTP2_DATA) {
+      return 0;
+    }
+
+    auto& self = *static_cast<Http2Session*>(user_data);
+    const auto stream_id = frame->hd.stream_id;
+    auto* stream = self.FindStream(stream_id);
+    if (!stream) return 0;
+
+    if (frame->hd.type == NGHTTP2_HEADERS &&
+        frame->headers.cat == NGHTTP2_HCAT_REQUEST) {
+      const auto res = ModifyRequest(
+          self, stream_id, *stream, [&](HttpRequestConstructor& constructor) {
+            ParseUrl(*stream);
+            // Flushes the last header
+            constructor.AppendHeaderField("", 0);
+          });
+      if (res != 0) return res;
+    }
+
+    if ((frame->hd.flags & NGHTTP2_FLAG_END_STREAM) && stream->constructor) {
+      try {
+        self.FinalizeRequest(stream_id, *stream);
+      } catch (const std::exception& ex) {
+        LOG_ERROR() << "Failed to finalize HTTP/2 request: " << ex;
+        return NGHTTP2_ERR_CALLBACK_FAILURE;
+      }
+    }
+    return 0;
+  }
+
+  static int OnDataChunkRecv(nghttp2_session*, std::uint8_t /*flags*/,
+                             std::int32_t stream_id, const std::uint8_t* data,
+                             std::size_t size, void* user_data) {
+    auto& self = *static_cast<Http2Session*>(user_data);
+    auto* stream = self.FindStream(stream_id);
+    if (!stream) return 0;
+
+    return ModifyRequest(self, stream_id, *stream,
+                         [&](HttpRequestConstructor& constructor) {
+                           constructor.AppendBody(
+                               reinterpret_cast<const char*>(data), size);
+                         });
+  }
+
+  static int OnFrameSend(nghttp2_session*, const nghttp2_frame* frame,
+                         void* user_data) {
+    auto& self = *static_cast<Http2Session*>(user_data);
+    if (auto* stream = self.FindStream(frame->hd.stream_id)) {
+      stream->sent_bytes += kFrameHeaderSize + frame->hd.length;
+    }
+    return 0;
+  }
+
+  static int OnStreamClose(nghttp2_session*, std::int32_t stream_id,
+                           std::uint32_t error_code, void* user_data) {
+    auto& self = *static_cast<Http2Session*>(user_data);
+    auto* stream = self.FindStream(stream_id);
+    if (!stream) return 0;
+
+    if (stream->request && !stream->is_response_submitted) {
+      // The handler is still running, the stream is finished by SendResponse
+      stream->is_closed = true;
+      return 0;
+    }
+
+    self.FinishStream(stream_id, error_code == NGHTTP2_NO_ERROR &&
+                                     stream->is_response_submitted &&
+                                     !stream->is_reset);
+    return 0;
+  }
+
+  static ssize_t ReadData(nghttp2_session*, std::int32_t /*stream_id*/,
+                          std::uint8_t* buf, std::size_t length,
+                          std::uint32_t* data_flags,
+                          nghttp2_data_source* source, void* /*user_data*/) {
+    auto& stream = *static_cast<Stream*>(source->ptr);
+    if (stream.is_reset) return NGHTTP2_ERR_DEFERRED;
+
+    const auto pending = stream.GetPendingBody();
+    const auto size = std::min(length, pending.size());
+    if (size == 0 && !stream.is_body_complete) return NGHTTP2_ERR_DEFERRED;
+
+    std::memcpy(buf, pending.data(), size);
+    stream.ConsumeBody(size);
+    if (size == pending.size() && stream.is_body_complete) {
+      *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+    }
+    return static_cast<ssize_t>(size);
+  }
+
+  // Must be called before the first regular header is added
+  static void ParseUrl(Stream& stream) {
+    if (stream.is_url_parsed) return;
+    stream.is_url_parsed = true;
+
+    auto& constructor = *stream.constructor;
+    constructor.SetMethod(HttpMethodFromString(stream.method));
+    constructor.SetHttpMajor(2);
+    constructor.SetHttpMinor(0);
+    constructor.AppendUrl(stream.path.data(), stream.path.size());
+    constructor.ParseUrl();
+
+    if (!stream.authority.empty()) {
+      constexpr std::string_view kHost = "Host";
+      constructor.AppendHeaderField(kHost.data(), kHost.size());
+      constructor.AppendHeaderValue(stream.authority.data(),
+                                    stream.authority.size());
+    }
+  }
+
+  // Malformed requests are answered right away with the status set by the
+  // constructor, the rest of their frames is ignored
+  template <typename Func>
+  static int ModifyRequest(Http2Session& self, StreamId stream_id,
+                           Stream& stream, Func&& func) {
+    if (!stream.constructor) return 0;
+    try {
+      try {
+        func(*stream.constructor);
+      } catch (const std::exception& ex) {
+        LOG_WARNING() << "can't process HTTP/2 request: " << ex;
+        self.FinalizeRequest(stream_id, stream);
+      }
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Failed to finalize HTTP/2 request: " << ex;
+      return NGHTTP2_ERR_CALLBACK_FAILURE;
+    }
+    return 0;
+  }
+};
+
+Http2Session::Http2Session(const net::Http2Config& config,
+                           const HandlerInfoIndex& handler_info_index,
+                           const request::HttpRequestConfig& request_config,
+                           engine::io::RwBase& socket,
+                           OnNewRequestCb&& on_new_request_cb,
+                           OnResponseDoneCb&& on_response_done_cb,
+                           net::ParserStats& stats,
+                           request::ResponseDataAccounter& data_accounter)
+    : handler_info_index_(handler_info_index),
+      request_config_(request_config),
+      socket_(socket),
+      on_new_request_cb_(std::move(on_new_request_cb)),
+      on_response_done_cb_(std::move(on_response_done_cb)),
+      stats_(stats),
+      data_accounter_(data_accounter) {
+  if (nghttp2_session_server_new(&session_, Callbacks::Get(), this) != 0) {
+    throw std::bad_alloc();
+  }
+
+  const std::array<nghttp2_settings_entry, 3> settings{{
+      {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS, config.max_concurrent_streams},
+      {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE, config.initial_window_size},
+      {NGHTTP2_SETTINGS_MAX_FRAME_SIZE, config.max_frame_size},
+  }};
+  const auto res = nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE,
+                                           settings.data(), settings.size());
+  if (res != 0) {
+    nghttp2_session_del(session_);
+    throw std::runtime_error(
+        fmt::format("Failed to submit HTTP/2 settings: {}",
+                    nghttp2_strerror(res)));
+  }
+}
+
+Http2Session::~Http2Session() {
+  nghttp2_session_del(session_);
+  while (!streams_.empty()) {
+    FinishStream(streams_.begin()->first, false);
+  }
+}
+
+bool Http2Session::Parse(const char* data, size_t size) {
+  const std::lock_guard lock(mutex_);
+  const auto res = nghttp2_session_mem_recv(
+      session_, reinterpret_cast<const std::uint8_t*>(data), size);
+  // Sends GOAWAY on errors
+  Flush();
+  if (res < 0) {
+    LOG_WARNING() << "HTTP/2 session error: "
+                  << nghttp2_strerror(static_cast<int>(res));
+    return false;
+  }
+  return true;
+}
+
+void Http2Session::SendResponse(StreamId stream_id,
+                                request::RequestBase& request) {
+  auto& response = static_cast<HttpResponse&>(request.GetResponse());
+  const bool has_body = impl::Http2ResponseWriter::HasBody(response);
+  const bool is_streamed = impl::Http2ResponseWriter::IsBodyStreamed(response);
+
+  {
+    const std::lock_guard lock(mutex_);
+    auto* stream = FindStream(stream_id);
+    UASSERT(stream);
+    if (!stream) return;
+    if (stream->is_closed || is_broken_) {
+      FinishStream(stream_id, false);
+      return;
+    }
+
+    const auto headers =
+        impl::Http2ResponseWriter::MakeHeaders(response, is_streamed);
+    std::vector<nghttp2_nv> nva;
+    nva.reserve(headers.size());
+    for (const auto& [name, value] : headers) {
+      nva.push_back(MakeNv(name, value));
+    }
+
+    stream->is_body_streamed = is_streamed;
+    stream->is_body_complete = !is_streamed;
+    if (!is_streamed) stream->body_view = response.GetData();
+
+    nghttp2_data_provider provider{};
+    provider.source.ptr = stream;
+    provider.read_callback = &Callbacks::ReadData;
+
+    const auto res = nghttp2_submit_response(session_, stream_id, nva.data(),
+                                             nva.size(),
+                                             has_body ? &provider : nullptr);
+    if (res != 0) {
+      LOG_ERROR() << "Failed to submit HTTP/2 response: "
+                  << nghttp2_strerror(res);
+      FinishStream(stream_id, false);
+      return;
+    }
+    stream->is_response_submitted = true;
+    Flush();
+  }
+
+  if (!has_body || !is_streamed) return;
+
+  std::string body_part;
+  while (impl::Http2ResponseWriter::PopBodyPart(response, body_part)) {
+    if (body_part.empty()) continue;
+
+    const std::lock_guard lock(mutex_);
+    auto* stream = FindStream(stream_id);
+    if (!stream || stream->is_reset) break;
+    stream->streamed_body.append(body_part);
+    nghttp2_session_resume_data(session_, stream_id);
+    Flush();
+  }
+  impl::Http2ResponseWriter::FinishBodyStream(response);
+
+  if (engine::current_task::ShouldCancel()) {
+    // The body may be incomplete
+    ResetStream(stream_id);
+    return;
+  }
+
+  const std::lock_guard lock(mutex_);
+  if (auto* stream = FindStream(stream_id)) {
+    stream->is_body_complete = true;
+    nghttp2_session_resume_data(session_, stream_id);
+    Flush();
+  }
+}
+
+void Http2Session::ResetStream(StreamId stream_id) noexcept {
+  const std::lock_guard lock(mutex_);
+  auto* stream = FindStream(stream_id);
+  if (!stream) return;
+
+  if (!stream->is_closed) {
+    nghttp2_submit_rst_stream(session_, NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_CANCEL);
+  }
+  if (stream->is_response_submitted) {
+    // nghttp2 may still reference the stream, it is finished by OnStreamClose
+    stream->is_reset = true;
+  } else {
+    FinishStream(stream_id, false);
+  }
+
+  try {
+    Flush();
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Failed to send HTTP/2 stream reset: " << ex;
+  }
+}
+
+bool Http2Session::IsAlive() const {
+  const std::lock_guard lock(mutex_);
+  return !is_broken_ && (nghttp2_session_want_read(session_) ||
+                         nghttp2_session_want_write(session_));
+}
+
+bool Http2Session::HasActiveStreams() const {
+  const std::lock_guard lock(mutex_);
+  return !streams_.empty();
+}
+
+Http2Session::Stream* Http2Session::FindStream(StreamId stream_id) noexcept {
+  const auto it = streams_.find(stream_id);
+  return it == streams_.end() ? nullptr : it->second.get();
+}
+
+void Http2Session::FinalizeRequest(StreamId stream_id, Stream& stream) {
+  UASSERT(stream.constructor);
+  auto request = stream.constructor->Finalize();
+  stream.constructor.reset();
+  --stats_.parsing_request_count;
+
+  if (!request) {
+    LOG_ERROR() << "request is null after Finalize()";
+    nghttp2_submit_rst_stream(session_, NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_INTERNAL_ERROR);
+    return;
+  }
+
+  stream.request = request;
+  on_new_request_cb_(stream_id, std::move(request));
+}
+
+void Http2Session::FinishStream(StreamId stream_id, bool is_sent) noexcept {
+  const auto it = streams_.find(stream_id);
+  if (it == streams_.end()) return;
+  const auto stream = std::move(it->second);
+  streams_.erase(it);
+
+  if (stream->constructor) --stats_.parsing_request_count;
+  if (!stream->request) return;
+
+  auto& response = static_cast<HttpResponse&>(stream->request->GetResponse());
+  if (is_sent) {
+    impl::Http2ResponseWriter::SetSent(response, stream->sent_bytes);
+  } else {
+    response.SetSendFailed(std::chrono::steady_clock::now());
+  }
+
+  try {
+    on_response_done_cb_(*stream->request);
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to finish HTTP/2 stream: " << ex;
+  }
+}
+
+void Http2Session::Flush() {
+  if (is_broken_) return;
+
+  try {
+    send_buffer_.clear();
+    while (true) {
+      const std::uint8_t* data = nullptr;
+      const auto size = nghttp2_session_mem_send(session_, &data);
+      if (size < 0) {
+        throw std::runtime_error(
+            fmt::format("nghttp2_session_mem_send failed: {}",
+                        nghttp2_strerror(static_cast<int>(size))));
+      }
+      if (size == 0) break;
+
+      send_buffer_.append(reinterpret_cast<const char*>(data), size);
+      if (send_buffer_.size() >= kMaxSendBufferSize) {
+        socket_.WriteAll(send_buffer_.data(), send_buffer_.size(), {});
+        send_buffer_.clear();
+      }
+    }
+    if (!send_buffer_.empty()) {
+      socket_.WriteAll(send_buffer_.data(), send_buffer_.size(), {});
+    }
+  } catch (const std::exception&) {
+    is_broken_ = true;
+    throw;
+  }
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
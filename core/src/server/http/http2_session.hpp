@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <server/net/connection_config.hpp>
+#include <server/net/stats.hpp>
+#include <server/request/request_parser.hpp>
+
+#include <userver/engine/io/common.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/server/request/request_base.hpp>
+#include <userver/server/request/request_config.hpp>
+
+#include "handler_info_index.hpp"
+
+struct nghttp2_session;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// @brief Server side of an HTTP/2 connection built on nghttp2.
+///
+/// Turns the incoming frames into requests and the responses into frames.
+/// Streams are independent: a response is sent as soon as it is ready, without
+/// waiting for the responses of the requests that came earlier. HPACK and flow
+/// control are handled by nghttp2.
+///
+/// Parse() is called by the connection reader task, SendResponse() and
+/// ResetStream() are called concurrently by the tasks that wait for handlers.
+class Http2Session final : public request::RequestParser {
+ public:
+  using StreamId = std::int32_t;
+
+  using OnNewRequestCb =
+      std::function<void(StreamId, std::shared_ptr<request::RequestBase>&&)>;
+
+  /// Called exactly once for each request passed to OnNewRequestCb, after its
+  /// response was either sent or failed
+  using OnResponseDoneCb = std::function<void(request::RequestBase&)>;
+
+  /// The connection preface every HTTP/2 client starts with
+  static constexpr std::string_view kClientPreface{
+      "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n"};
+
+  Http2Session(const net::Http2Config& config,
+               const HandlerInfoIndex& handler_info_index,
+               const request::HttpRequestConfig& request_config,
+               engine::io::RwBase& socket, OnNewRequestCb&& on_new_request_cb,
+               OnResponseDoneCb&& on_response_done_cb, net::ParserStats& stats,
+               request::ResponseDataAccounter& data_accounter);
+
+  /// Fails all the responses that were not sent yet. Must be destroyed after
+  /// all the SendResponse() and ResetStream() calls have returned.
+  ~Http2Session() override;
+
+  /// Feeds the received bytes into the session and sends the pending frames.
+  /// @returns false on a connection level protocol error
+  bool Parse(const char* data, size_t size) override;
+
+  /// Sends the response of the stream. For a streamed body waits until the
+  /// handler finishes producing it.
+  void SendResponse(StreamId stream_id, request::RequestBase& request);
+
+  /// Aborts the stream without a response, e.g. if the handler was cancelled
+  void ResetStream(StreamId stream_id) noexcept;
+
+  /// @returns false if the session is done with the peer, e.g. after GOAWAY
+  bool IsAlive() const;
+
+  bool HasActiveStreams() const;
+
+ private:
+  struct Callbacks;
+  struct Stream;
+
+  Stream* FindStream(StreamId stream_id) noexcept;
+  void FinalizeRequest(StreamId stream_id, Stream& stream);
+  void FinishStream(StreamId stream_id, bool is_sent) noexcept;
+  void Flush();
+
+  const HandlerInfoIndex& handler_info_index_;
+  const request::HttpRequestConfig& request_config_;
+  engine::io::RwBase& socket_;
+  OnNewRequestCb on_new_request_cb_;
+  OnResponseDoneCb on_response_done_cb_;
+  net::ParserStats& stats_;
+  request::ResponseDataAccounter& data_accounter_;
+
+  mutable engine::Mutex mutex_;
+  nghttp2_session* session_{nullptr};
+  std::unordered_map<StreamId, std::unique_ptr<Stream>> streams_;
+  std::string send_buffer_;
+  bool is_broken_{false};
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
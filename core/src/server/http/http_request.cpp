@@ -172,6 +172,12 @@ const HttpRequest::CookiesMap& HttpRequest::RequestCookies() const {
   return impl_.GetCookies();
 }
 
+bool HttpRequest::IsBodyStreamed() const { return impl_.IsBodyStreamed(); }
+
+RequestBodyStream& HttpRequest::GetBodyStream() const {
+  return impl_.GetBodyStream();
+}
+
 void HttpRequest::SetRequestBody(std::string body) {
   impl_.SetRequestBody(std::move(body));
 }  // namespace server::http
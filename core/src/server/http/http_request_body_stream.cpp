@@ -0,0 +1,115 @@
+#include <userver/server/http/http_request_body_stream.hpp>
+
+#include <algorithm>
+
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <server/http/request_body_producer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+// Chunks are smaller than the queue, so the producer does not wait for the
+// queue to become completely empty
+constexpr std::size_t kMaxChunkSize = impl::RequestBodyProducer::kQueueSize / 4;
+
+}  // namespace
+
+RequestBodyStream::RequestBodyStream(Queue::Consumer&& consumer)
+    : consumer_(std::move(consumer)) {}
+
+RequestBodyStream::RequestBodyStream(std::string_view buffered_body)
+    : buffered_body_(buffered_body) {}
+
+RequestBodyStream::RequestBodyStream(RequestBodyStream&&) noexcept = default;
+
+RequestBodyStream::~RequestBodyStream() = default;
+
+bool RequestBodyStream::ReadChunk(std::string& chunk,
+                                  engine::Deadline deadline) {
+  chunk.clear();
+  if (is_finished_) return false;
+
+  if (!consumer_) {
+    is_finished_ = true;
+    if (buffered_body_.empty()) return false;
+    chunk.assign(buffered_body_.data(), buffered_body_.size());
+    read_bytes_ += chunk.size();
+    buffered_body_ = {};
+    return true;
+  }
+
+  if (!consumer_->Pop(chunk, deadline)) {
+    if (engine::current_task::ShouldCancel()) {
+      throw RequestBodyStreamException(
+          "Task was cancelled while reading the request body");
+    }
+    if (deadline.IsReached()) {
+      throw RequestBodyStreamException(
+          "Deadline expired while reading the request body");
+    }
+    is_finished_ = true;
+    throw RequestBodyStreamException(
+        "Connection was closed before the whole request body was received");
+  }
+
+  // An empty chunk marks the end of the body
+  if (chunk.empty()) {
+    is_finished_ = true;
+    consumer_.reset();
+    return false;
+  }
+  read_bytes_ += chunk.size();
+  return true;
+}
+
+std::string RequestBodyStream::ReadAll(engine::Deadline deadline) {
+  std::string body;
+  std::string chunk;
+  while (ReadChunk(chunk, deadline)) {
+    if (body.empty()) {
+      body = std::move(chunk);
+    } else {
+      body += chunk;
+    }
+  }
+  return body;
+}
+
+namespace impl {
+
+RequestBodyProducer::RequestBodyProducer(
+    RequestBodyStream::Queue::Producer&& producer)
+    : producer_(std::move(producer)) {}
+
+bool RequestBodyProducer::Push(std::string_view data) {
+  while (!data.empty()) {
+    const auto size = std::min(data.size(), kMaxChunkSize);
+    std::string chunk{data.substr(0, size)};
+    // Push() wakes up once per popped chunk, which may free not enough room
+    while (!producer_.Push(std::move(chunk))) {
+      if (producer_.Queue()->NoMoreConsumers() ||
+          engine::current_task::ShouldCancel()) {
+        return false;
+      }
+    }
+    data.remove_prefix(size);
+  }
+  return true;
+}
+
+void RequestBodyProducer::Finish() {
+  // Empty chunk does not take the queue room, so it is never blocked
+  [[maybe_unused]] const bool success = producer_.PushNoblock(std::string{});
+  UASSERT(success || producer_.Queue()->NoMoreConsumers());
+}
+
+}  // namespace impl
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,288 @@
+#include <userver/server/http/http_request_body_stream.hpp>
+
+#include <string>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/server/http/multipart_form_data_stream.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+#include <server/http/request_body_producer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::MultipartFormDataStream;
+using server::http::RequestBodyStream;
+using server::http::RequestBodyStreamException;
+using server::http::impl::RequestBodyProducer;
+
+struct StreamPair {
+  StreamPair()
+      : queue(
+            RequestBodyStream::Queue::Create(RequestBodyProducer::kQueueSize)),
+        producer(queue->GetProducer()),
+        stream(queue->GetConsumer()) {}
+
+  std::shared_ptr<RequestBodyStream::Queue> queue;
+  RequestBodyProducer producer;
+  RequestBodyStream stream;
+};
+
+// Pushes the body in small pieces to check the parsing across the chunks
+void PushByPieces(RequestBodyProducer& producer, std::string_view body,
+                  std::size_t piece_size) {
+  while (!body.empty()) {
+    const auto size = std::min(body.size(), piece_size);
+    ASSERT_TRUE(producer.Push(body.substr(0, size)));
+    body.remove_prefix(size);
+  }
+  producer.Finish();
+}
+
+constexpr std::string_view kMultipartContentType =
+    "multipart/form-data; boundary=------------------------8099aaf9723cd601";
+
+constexpr std::string_view kMultipartBody =
+    "preamble\r\n"
+    "--------------------------8099aaf9723cd601\r\n"
+    "Content-Disposition: form-data; name=\"text\"\r\n"
+    "\r\n"
+    "default\r\n"
+    "--------------------------8099aaf9723cd601  \r\n"
+    "Content-Disposition: form-data; name=\"file1\"; filename=\"a.html\"\r\n"
+    "Content-Type: text/html\r\n"
+    "\r\n"
+    "<!DOCTYPE html><title>Content of a.html.</title>\r\n"
+    "--------------------------8099aaf9723cd60\r\n"
+    "\r\n"
+    "--------------------------8099aaf9723cd601\r\n"
+    "Content-Disposition: form-data; name=\"empty\"\r\n"
+    "\r\n"
+    "\r\n"
+    "--------------------------8099aaf9723cd601--\r\n"
+    "epilogue";
+
+struct ReadPart {
+  MultipartFormDataStream::Part part;
+  std::string value;
+};
+
+std::vector<ReadPart> ReadAllParts(MultipartFormDataStream& form) {
+  std::vector<ReadPart> result;
+  std::string chunk;
+  while (auto part = form.NextPart()) {
+    ReadPart read{std::move(*part), {}};
+    while (form.ReadPartChunk(chunk)) read.value += chunk;
+    result.push_back(std::move(read));
+  }
+  return result;
+}
+
+}  // namespace
+
+UTEST(RequestBodyStream, Buffered) {
+  RequestBodyStream stream{std::string_view{"body"}};
+  EXPECT_FALSE(stream.IsFinished());
+
+  std::string chunk;
+  ASSERT_TRUE(stream.ReadChunk(chunk));
+  EXPECT_EQ(chunk, "body");
+  EXPECT_FALSE(stream.ReadChunk(chunk));
+  EXPECT_TRUE(chunk.empty());
+  EXPECT_TRUE(stream.IsFinished());
+  EXPECT_EQ(stream.GetReadBytes(), 4);
+
+  RequestBodyStream empty{std::string_view{}};
+  EXPECT_EQ(empty.ReadAll(), "");
+  EXPECT_TRUE(empty.IsFinished());
+}
+
+UTEST(RequestBodyStream, Streamed) {
+  StreamPair pair;
+  auto task = utils::Async("producer", [&pair] {
+    ASSERT_TRUE(pair.producer.Push("first "));
+    engine::Yield();
+    ASSERT_TRUE(pair.producer.Push("second"));
+    pair.producer.Finish();
+  });
+
+  EXPECT_EQ(pair.stream.ReadAll(), "first second");
+  EXPECT_TRUE(pair.stream.IsFinished());
+  EXPECT_EQ(pair.stream.GetReadBytes(), 12);
+  task.Get();
+}
+
+UTEST(RequestBodyStream, Backpressure) {
+  StreamPair pair;
+  const std::string body(RequestBodyProducer::kQueueSize * 3, 'a');
+  auto task = utils::Async("producer", [&pair, &body] {
+    ASSERT_TRUE(pair.producer.Push(body));
+    pair.producer.Finish();
+  });
+
+  // The producer waits for the consumer instead of queueing the whole body
+  engine::SleepFor(std::chrono::milliseconds{10});
+  EXPECT_FALSE(task.IsFinished());
+
+  std::string chunk;
+  std::size_t read_bytes = 0;
+  while (pair.stream.ReadChunk(chunk)) {
+    EXPECT_LE(chunk.size(), RequestBodyProducer::kQueueSize);
+    read_bytes += chunk.size();
+  }
+  EXPECT_EQ(read_bytes, body.size());
+  task.Get();
+}
+
+UTEST(RequestBodyStream, Truncated) {
+  auto queue =
+      RequestBodyStream::Queue::Create(RequestBodyProducer::kQueueSize);
+  RequestBodyStream stream{queue->GetConsumer()};
+  {
+    RequestBodyProducer producer{queue->GetProducer()};
+    ASSERT_TRUE(producer.Push("part of the body"));
+  }
+
+  std::string chunk;
+  ASSERT_TRUE(stream.ReadChunk(chunk));
+  EXPECT_THROW(stream.ReadChunk(chunk), RequestBodyStreamException);
+}
+
+UTEST(RequestBodyStream, ConsumerGone) {
+  auto queue =
+      RequestBodyStream::Queue::Create(RequestBodyProducer::kQueueSize);
+  RequestBodyProducer producer{queue->GetProducer()};
+  { RequestBodyStream stream{queue->GetConsumer()}; }
+
+  const std::string body(RequestBodyProducer::kQueueSize * 2, 'a');
+  EXPECT_FALSE(producer.Push(body));
+}
+
+UTEST(MultipartFormDataStream, Parts) {
+  for (std::size_t piece_size : {1, 3, 16, 1024}) {
+    StreamPair pair;
+    auto task = utils::Async("producer", [&pair, piece_size] {
+      PushByPieces(pair.producer, kMultipartBody, piece_size);
+    });
+
+    MultipartFormDataStream form{kMultipartContentType, pair.stream};
+    const auto parts = ReadAllParts(form);
+    task.Get();
+
+    ASSERT_EQ(parts.size(), 3) << "piece_size=" << piece_size;
+    EXPECT_EQ(parts[0].part.name, "text");
+    EXPECT_EQ(parts[0].part.content_disposition, R"(form-data; name="text")");
+    EXPECT_EQ(parts[0].part.filename, std::nullopt);
+    EXPECT_EQ(parts[0].value, "default");
+
+    EXPECT_EQ(parts[1].part.name, "file1");
+    EXPECT_EQ(parts[1].part.filename, "a.html");
+    EXPECT_EQ(parts[1].part.content_type, "text/html");
+    EXPECT_EQ(parts[1].value,
+              "<!DOCTYPE html><title>Content of a.html.</title>\r\n"
+              "--------------------------8099aaf9723cd60\r\n");
+
+    EXPECT_EQ(parts[2].part.name, "empty");
+    EXPECT_EQ(parts[2].value, "");
+
+    EXPECT_FALSE(form.NextPart());
+  }
+}
+
+UTEST(MultipartFormDataStream, Pieces) {
+  for (std::size_t piece_size : {1, 7, 1024}) {
+    StreamPair pair;
+    auto task = utils::Async("producer", [&pair, piece_size] {
+      PushByPieces(pair.producer, kMultipartBody, piece_size);
+    });
+
+    MultipartFormDataStream form{kMultipartContentType, pair.stream};
+    std::vector<std::string> values;
+    std::string_view piece;
+    while (form.NextPart()) {
+      auto& value = values.emplace_back();
+      while (form.ReadPartPiece(piece)) value += piece;
+      EXPECT_TRUE(piece.empty());
+    }
+    task.Get();
+
+    ASSERT_EQ(values.size(), 3) << "piece_size=" << piece_size;
+    EXPECT_EQ(values[0], "default");
+    EXPECT_EQ(values[1],
+              "<!DOCTYPE html><title>Content of a.html.</title>\r\n"
+              "--------------------------8099aaf9723cd60\r\n");
+    EXPECT_EQ(values[2], "");
+  }
+}
+
+UTEST(MultipartFormDataStream, ReadPartToFile) {
+  constexpr std::string_view kFileValue =
+      "<!DOCTYPE html><title>Content of a.html.</title>\r\n"
+      "--------------------------8099aaf9723cd60\r\n";
+
+  RequestBodyStream stream{kMultipartBody};
+  MultipartFormDataStream form{kMultipartContentType, stream};
+  auto& fs_task_processor = engine::current_task::GetTaskProcessor();
+  const auto file = fs::blocking::TempFile::Create();
+
+  ASSERT_TRUE(form.NextPart());
+  EXPECT_EQ(form.ReadPartToFile(fs_task_processor, file.GetPath()), 7);
+
+  // Only the rest of the current part value is written
+  ASSERT_TRUE(form.NextPart());
+  std::string_view piece;
+  ASSERT_TRUE(form.ReadPartPiece(piece));
+  ASSERT_EQ(piece, kFileValue);
+  EXPECT_EQ(form.ReadPartToFile(fs_task_processor, file.GetPath()), 0);
+  EXPECT_EQ(fs::blocking::ReadFileContents(file.GetPath()), "default");
+
+  ASSERT_TRUE(form.NextPart());
+  EXPECT_EQ(form.ReadPartToFile(fs_task_processor, file.GetPath()), 0);
+  EXPECT_FALSE(form.NextPart());
+}
+
+UTEST(MultipartFormDataStream, SkipUnreadValue) {
+  RequestBodyStream stream{kMultipartBody};
+  MultipartFormDataStream form{kMultipartContentType, stream};
+
+  auto part = form.NextPart();
+  ASSERT_TRUE(part);
+  EXPECT_EQ(part->name, "text");
+  part = form.NextPart();
+  ASSERT_TRUE(part);
+  EXPECT_EQ(part->name, "file1");
+  part = form.NextPart();
+  ASSERT_TRUE(part);
+  EXPECT_EQ(part->name, "empty");
+  EXPECT_FALSE(form.NextPart());
+}
+
+UTEST(MultipartFormDataStream, Malformed) {
+  RequestBodyStream stream{kMultipartBody};
+  EXPECT_THROW(MultipartFormDataStream("multipart/form-data", stream),
+               RequestBodyStreamException);
+
+  const auto truncated = kMultipartBody.substr(0, kMultipartBody.size() / 2);
+  RequestBodyStream truncated_stream{truncated};
+  MultipartFormDataStream form{kMultipartContentType, truncated_stream};
+  EXPECT_THROW(ReadAllParts(form), RequestBodyStreamException);
+
+  constexpr std::string_view kNoDisposition =
+      "--------------------------8099aaf9723cd601\r\n"
+      "Content-Type: text/html\r\n"
+      "\r\n"
+      "value\r\n"
+      "--------------------------8099aaf9723cd601--\r\n";
+  RequestBodyStream no_disposition_stream{kNoDisposition};
+  MultipartFormDataStream no_disposition_form{kMultipartContentType,
+                                              no_disposition_stream};
+  EXPECT_THROW(no_disposition_form.NextPart(), RequestBodyStreamException);
+}
+
+USERVER_NAMESPACE_END
@@ -112,6 +112,7 @@ void HttpRequestConstructor::ParseUrl() {
     config_.parse_args_from_body =
         handler_config.request_config.parse_args_from_body;
     if (handler_config.decompress_request) config_.decompress_request = true;
+    request_body_stream_ = handler_config.request_body_stream;
 
     request_->SetTaskProcessor(handler_info->task_processor);
     request_->SetHttpHandler(handler_info->handler);
@@ -156,6 +157,12 @@ void HttpRequestConstructor::AppendHeaderValue(const char* data, size_t size) {
   header_value_.append(data, size);
 }
 
+void HttpRequestConstructor::AppendHeader(std::string_view field,
+                                          std::string_view value) {
+  AppendHeaderField(field.data(), field.size());
+  AppendHeaderValue(value.data(), value.size());
+}
+
 void HttpRequestConstructor::AppendBody(const char* data, size_t size) {
   AccountRequestSize(size);
   request_->request_body_.append(data, size);
@@ -165,6 +172,20 @@ void HttpRequestConstructor::SetIsFinal(bool is_final) {
   request_->is_final_ = is_final;
 }
 
+bool HttpRequestConstructor::IsBodyStreamed() const {
+  return request_body_stream_ && url_parsed_ && status_ == Status::kOk;
+}
+
+impl::RequestBodyProducer HttpRequestConstructor::StartBodyStream() {
+  UASSERT(IsBodyStreamed());
+  UASSERT(request_->request_body_.empty());
+  auto queue = RequestBodyStream::Queue::Create(
+      impl::RequestBodyProducer::kQueueSize);
+  request_->body_stream_.emplace(queue->GetConsumer());
+  request_->is_body_streamed_ = true;
+  return impl::RequestBodyProducer{queue->GetProducer()};
+}
+
 std::shared_ptr<request::RequestBase> HttpRequestConstructor::Finalize() {
   LOG_TRACE() << "method=" << request_->GetMethodStr();
 
@@ -188,7 +209,7 @@ void HttpRequestConstructor::FinalizeImpl() {
 
   try {
     ParseArgs(parsed_url_);
-    if (config_.parse_args_from_body) {
+    if (config_.parse_args_from_body && !request_->is_body_streamed_) {
       if (!config_.decompress_request || !request_->IsBodyCompressed())
         ParseArgs(request_->request_body_.data(),
                   request_->request_body_.size());
@@ -218,7 +239,8 @@ void HttpRequestConstructor::FinalizeImpl() {
 
   const auto& content_type =
       request_->GetHeader(USERVER_NAMESPACE::http::headers::kContentType);
-  if (IsMultipartFormDataContentType(content_type)) {
+  if (!request_->is_body_streamed_ &&
+      IsMultipartFormDataContentType(content_type)) {
     if (!ParseMultipartFormData(content_type, request_->RequestBody(),
                                 request_->form_data_args_)) {
       SetStatus(Status::kParseMultipartFormDataError);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <string_view>
 
 #include <http_parser.h>
 
@@ -12,6 +13,7 @@
 
 #include "handler_info_index.hpp"
 #include "http_request_impl.hpp"
+#include "request_body_producer.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -50,10 +52,19 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   void ParseUrl();
   void AppendHeaderField(const char* data, size_t size);
   void AppendHeaderValue(const char* data, size_t size);
+  // Same as AppendHeaderField() followed by AppendHeaderValue()
+  void AppendHeader(std::string_view field, std::string_view value);
   void AppendBody(const char* data, size_t size);
 
   void SetIsFinal(bool is_final);
 
+  // The handler reads the body with RequestBodyStream. Call after the headers
+  // are parsed.
+  bool IsBodyStreamed() const;
+  // Must be called before Finalize() for the streamed bodies, AppendBody()
+  // should not be used after that
+  impl::RequestBodyProducer StartBodyStream();
+
   std::shared_ptr<request::RequestBase> Finalize() override;
 
  private:
@@ -84,6 +95,7 @@ class HttpRequestConstructor final : public request::RequestConstructor {
   size_t url_size_ = 0;
   size_t headers_size_ = 0;
   bool url_parsed_ = false;
+  bool request_body_stream_ = false;
   Status status_ = Status::kOk;
 
   std::shared_ptr<HttpRequestImpl> request_;
@@ -1,6 +1,10 @@
 #include <benchmark/benchmark.h>
 
+#include <fmt/format.h>
+
 #include <server/http/http_request_constructor.hpp>
+#include <server/http/http_request_parser.hpp>
+#include <userver/engine/run_standalone.hpp>
 #include <utils/gbench_auxilary.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -16,9 +20,52 @@ void http_request_constructor_url_decode(benchmark::State& state) {
   for ([[maybe_unused]] auto _ : state)
     benchmark::DoNotOptimize(USERVER_NAMESPACE::http::parser::UrlDecode(input));
 }
+// Request that is split between two reads is parsed by http_parser, a request
+// that is received at once goes through the SIMD head parser
+void http_request_parser_parse(benchmark::State& state) {
+  const auto headers_count = state.range(0);
+  const bool is_split = state.range(1);
+
+  std::string request =
+      "POST /some/path/to/handler?arg1=value1&arg2=value2 HTTP/1.1\r\n"
+      "Content-Length: 16\r\n";
+  for (std::int64_t i = 0; i < headers_count; ++i) {
+    request += fmt::format("X-Header-{}: some-typical-header-value\r\n", i);
+  }
+  request += "\r\n0123456789abcdef";
+  const auto split_pos = is_split ? request.size() - 1 : request.size();
+
+  engine::RunStandalone([&] {
+    const server::http::HandlerInfoIndex handler_info_index;
+    const server::request::HttpRequestConfig request_config{};
+    server::net::ParserStats stats;
+    server::request::ResponseDataAccounter accounter;
+
+    std::size_t requests_count = 0;
+    server::http::HttpRequestParser parser{
+        handler_info_index, request_config,
+        [&requests_count](std::shared_ptr<server::request::RequestBase>&&) {
+          ++requests_count;
+        },
+        stats, accounter};
+
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(parser.Parse(request.data(), split_pos));
+      benchmark::DoNotOptimize(parser.Parse(request.data() + split_pos,
+                                            request.size() - split_pos));
+    }
+    benchmark::DoNotOptimize(requests_count);
+  });
+  state.SetBytesProcessed(state.iterations() * request.size());
+}
+
 }  // namespace
 BENCHMARK(http_request_constructor_url_decode)
     ->RangeMultiplier(2)
     ->Range(1, 1024);
 
+BENCHMARK(http_request_parser_parse)
+    ->ArgsProduct({{1, 8, 32}, {0, 1}})
+    ->ArgNames({"headers", "split"});
+
 USERVER_NAMESPACE_END
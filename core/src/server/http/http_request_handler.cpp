@@ -5,6 +5,7 @@
 
 #include <server/handlers/http_handler_base_statistics.hpp>
 #include <server/handlers/http_server_settings.hpp>
+#include <server/http/throttling_cost.hpp>
 #include <server/request/task_inherited_request_impl.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
@@ -124,10 +125,11 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
                            "limit via 'server.max_response_size_in_flight')";
     return StartFailsafeTask(std::move(request));
   }
-  const auto& config = config_source_.GetSnapshot();
-
-  if (throttling_enabled && !rate_limit_.Obtain()) {
-    auto config_var = config[handlers::kCcCustomStatus];
+  if (throttling_enabled &&
+      (IsThrottlingPriorityShed(handler->GetConfig().throttling_priority) ||
+       !ObtainThrottlingTokens(GetThrottlingCost(
+           handler->GetConfig(), http_request.RequestBody().size())))) {
+    const auto config_var = config_source_.GetCopy(handlers::kCcCustomStatus);
     const auto& delta = config_var.max_time_delta;
 
     auto status = HttpStatus::kTooManyRequests;
@@ -150,6 +152,7 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
         << "Request throttled (congestion control, "
            "limit via USERVER_RPS_CCONTROL and USERVER_RPS_CCONTROL_ENABLED), "
         << "limit=" << rate_limit_.GetRatePs() << "/sec, "
+        << "shed_level=" << throttling_shed_level_.load() << ", "
         << "url=" << http_request.GetUrl()
         << ", status_code=" << static_cast<size_t>(status);
 
@@ -157,7 +160,7 @@ engine::TaskWithResult<void> HttpRequestHandler::StartRequestTask(
   }
 
   if (handler->GetConfig().response_body_stream &&
-      config[handlers::kStreamApiEnabled]) {
+      config_source_.GetCopy(handlers::kStreamApiEnabled)) {
     http_response.SetStreamBody();
   }
 
@@ -215,6 +218,17 @@ void HttpRequestHandler::SetNewRequestHook(NewRequestHook hook) {
   new_request_hook_ = std::move(hook);
 }
 
+std::uint64_t HttpRequestHandler::GetThrottlingExtraCost() const noexcept {
+  return throttling_extra_cost_.load(std::memory_order_relaxed);
+}
+
+bool HttpRequestHandler::ObtainThrottlingTokens(size_t cost) const {
+  if (cost > 1) {
+    throttling_extra_cost_.fetch_add(cost - 1, std::memory_order_relaxed);
+  }
+  return ObtainThrottlingCost(rate_limit_, cost);
+}
+
 void HttpRequestHandler::SetRpsRatelimit(std::optional<size_t> rps) {
   if (rps) {
     if (rate_limit_.IsUnbounded()) {
@@ -236,6 +250,16 @@ void HttpRequestHandler::SetRpsRatelimit(std::optional<size_t> rps) {
   }
 }
 
+bool HttpRequestHandler::IsThrottlingPriorityShed(
+    handlers::ThrottlingPriority priority) const noexcept {
+  return static_cast<std::size_t>(priority) <
+         throttling_shed_level_.load(std::memory_order_relaxed);
+}
+
+void HttpRequestHandler::SetThrottlingShedLevel(std::size_t shed_level) {
+  throttling_shed_level_.store(shed_level, std::memory_order_relaxed);
+}
+
 void HttpRequestHandler::SetRpsRatelimitStatusCode(HttpStatus status_code) {
   LOG_DEBUG() << "CC status code changed to " << static_cast<int>(status_code);
   cc_status_code_ = status_code;
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <optional>
 
 #include <server/http/request_handler_base.hpp>
@@ -50,7 +52,20 @@ class HttpRequestHandler final : public RequestHandlerBase {
 
   void SetRpsRatelimitStatusCode(HttpStatus status_code);
 
+  /// Requests of the `shed_level` lowest throttling priority classes are
+  /// rejected as if the RPS limit was reached
+  void SetThrottlingShedLevel(std::size_t shed_level);
+
+  /// Sum of the throttling costs above 1 of all the throttlable requests,
+  /// converts the requests count into the RPS limit units
+  std::uint64_t GetThrottlingExtraCost() const noexcept;
+
  private:
+  bool ObtainThrottlingTokens(size_t cost) const;
+
+  bool IsThrottlingPriorityShed(
+      handlers::ThrottlingPriority priority) const noexcept;
+
   logging::LoggerPtr logger_access_;
   logging::LoggerPtr logger_access_tskv_;
 
@@ -65,6 +80,8 @@ class HttpRequestHandler final : public RequestHandlerBase {
   const std::string server_name_;
   NewRequestHook new_request_hook_;
   mutable utils::TokenBucket rate_limit_;
+  mutable std::atomic<std::uint64_t> throttling_extra_cost_{0};
+  std::atomic<std::size_t> throttling_shed_level_{0};
   std::atomic<HttpStatus> cc_status_code_{HttpStatus::kTooManyRequests};
   std::chrono::steady_clock::time_point cc_enabled_tp_;
   utils::statistics::MetricsStoragePtr metrics_;
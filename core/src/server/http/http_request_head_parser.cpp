@@ -0,0 +1,285 @@
+#include <server/http/http_request_head_parser.hpp>
+
+#include <array>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+#include <userver/http/common_headers.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+// Same limit as the HTTP_MAX_HEADER_SIZE of http_parser
+constexpr std::size_t kMaxHeadSize = 80 * 1024;
+
+// Content-Length values with more digits are left for http_parser to reject
+constexpr std::size_t kMaxContentLengthDigits = 18;
+
+constexpr std::string_view kProxyConnection = "Proxy-Connection";
+
+enum class CharClass {
+  // Ends at SP, control characters, DEL and non-ASCII characters
+  kUrl,
+  // Ends at control characters other than HT and at DEL
+  kHeaderValue,
+};
+
+template <CharClass kClass>
+constexpr bool IsDelimiter(unsigned char c) noexcept {
+  if constexpr (kClass == CharClass::kUrl) {
+    return c <= ' ' || c >= 0x7f;
+  } else {
+    return (c < ' ' && c != '\t') || c == 0x7f;
+  }
+}
+
+// tchar from RFC 9110
+constexpr auto kTokenChars = [] {
+  std::array<bool, 256> result{};
+  for (unsigned char c = '0'; c <= '9'; ++c) result[c] = true;
+  for (unsigned char c = 'a'; c <= 'z'; ++c) result[c] = true;
+  for (unsigned char c = 'A'; c <= 'Z'; ++c) result[c] = true;
+  for (const unsigned char c : std::string_view{"!#$%&'*+-.^_`|~"}) {
+    result[c] = true;
+  }
+  return result;
+}();
+
+constexpr bool IsTokenChar(char c) noexcept {
+  return kTokenChars[static_cast<unsigned char>(c)];
+}
+
+// Returns the first delimiter in [begin, end) or `end`
+template <CharClass kClass>
+const char* FindDelimiter(const char* begin, const char* end) noexcept {
+#if defined(__AVX2__)
+  while (end - begin >= 32) {
+    const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    __m256i matches{};
+    if constexpr (kClass == CharClass::kUrl) {
+      // Signed comparison catches both the characters up to SP and non-ASCII
+      matches = _mm256_or_si256(
+          _mm256_cmpgt_epi8(_mm256_set1_epi8(' ' + 1), v),
+          _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7f)));
+    } else {
+      const auto control = _mm256_cmpeq_epi8(
+          _mm256_max_epu8(v, _mm256_set1_epi8(' ' - 1)),
+          _mm256_set1_epi8(' ' - 1));
+      matches = _mm256_or_si256(
+          _mm256_andnot_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')),
+                              control),
+          _mm256_cmpeq_epi8(v, _mm256_set1_epi8(0x7f)));
+    }
+    const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(matches));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+    begin += 32;
+  }
+#endif
+#if defined(__SSE2__)
+  while (end - begin >= 16) {
+    const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    __m128i matches{};
+    if constexpr (kClass == CharClass::kUrl) {
+      // Signed comparison catches both the characters up to SP and non-ASCII
+      matches = _mm_or_si128(_mm_cmplt_epi8(v, _mm_set1_epi8(' ' + 1)),
+                             _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7f)));
+    } else {
+      const auto control = _mm_cmpeq_epi8(
+          _mm_max_epu8(v, _mm_set1_epi8(' ' - 1)), _mm_set1_epi8(' ' - 1));
+      matches = _mm_or_si128(
+          _mm_andnot_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\t')), control),
+          _mm_cmpeq_epi8(v, _mm_set1_epi8(0x7f)));
+    }
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(matches));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+    begin += 16;
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  while (end - begin >= 16) {
+    const auto v = vld1q_u8(reinterpret_cast<const std::uint8_t*>(begin));
+    uint8x16_t matches{};
+    if constexpr (kClass == CharClass::kUrl) {
+      matches = vorrq_u8(vcltq_u8(v, vdupq_n_u8(' ' + 1)),
+                         vcgeq_u8(v, vdupq_n_u8(0x7f)));
+    } else {
+      matches = vorrq_u8(
+          vbicq_u8(vcltq_u8(v, vdupq_n_u8(' ')), vceqq_u8(v, vdupq_n_u8('\t'))),
+          vceqq_u8(v, vdupq_n_u8(0x7f)));
+    }
+    if (vmaxvq_u8(matches) != 0) break;
+    begin += 16;
+  }
+#endif
+  while (begin != end && !IsDelimiter<kClass>(*begin)) ++begin;
+  return begin;
+}
+
+// Returns the end of the token that starts at `begin` or `end`
+const char* FindTokenEnd(const char* begin, const char* end) noexcept {
+  while (begin != end && IsTokenChar(*begin)) ++begin;
+  return begin;
+}
+
+HttpMethod ParseMethod(std::string_view method) noexcept {
+  // CONNECT and the methods of WebDAV are left for http_parser
+  switch (method.size()) {
+    case 3:
+      if (method == "GET") return HttpMethod::kGet;
+      if (method == "PUT") return HttpMethod::kPut;
+      break;
+    case 4:
+      if (method == "POST") return HttpMethod::kPost;
+      if (method == "HEAD") return HttpMethod::kHead;
+      break;
+    case 5:
+      if (method == "PATCH") return HttpMethod::kPatch;
+      break;
+    case 6:
+      if (method == "DELETE") return HttpMethod::kDelete;
+      break;
+    case 7:
+      if (method == "OPTIONS") return HttpMethod::kOptions;
+      break;
+  }
+  return HttpMethod::kUnknown;
+}
+
+bool ParseContentLength(std::string_view value, std::size_t& result) noexcept {
+  if (value.empty() || value.size() > kMaxContentLengthDigits) return false;
+  result = 0;
+  for (const char c : value) {
+    if (c < '0' || c > '9') return false;
+    result = result * 10 + static_cast<std::size_t>(c - '0');
+  }
+  return true;
+}
+
+}  // namespace
+
+void HttpRequestHead::Clear() noexcept {
+  method = HttpMethod::kUnknown;
+  url = {};
+  http_major = 0;
+  http_minor = 0;
+  headers.clear();
+  content_length = 0;
+  keep_alive = false;
+  size = 0;
+}
+
+HttpRequestHeadParseResult ParseHttpRequestHead(std::string_view data,
+                                                HttpRequestHead& head) {
+  using Result = HttpRequestHeadParseResult;
+  namespace headers = USERVER_NAMESPACE::http::headers;
+  constexpr utils::StrIcaseEqual kIcaseEqual{};
+
+  head.Clear();
+  const char* const begin = data.data();
+  const char* const end = begin + data.size();
+  const char* pos = begin;
+
+  // Request line
+  const char* const method_end = FindTokenEnd(pos, end);
+  if (method_end == end) return Result::kIncomplete;
+  if (*method_end != ' ') return Result::kUnsupported;
+  head.method = ParseMethod({pos, static_cast<std::size_t>(method_end - pos)});
+  if (head.method == HttpMethod::kUnknown) return Result::kUnsupported;
+  pos = method_end + 1;
+
+  const char* const url_end = FindDelimiter<CharClass::kUrl>(pos, end);
+  if (url_end == end) return Result::kIncomplete;
+  if (*url_end != ' ' || url_end == pos) return Result::kUnsupported;
+  head.url = {pos, static_cast<std::size_t>(url_end - pos)};
+  pos = url_end + 1;
+
+  constexpr std::string_view kVersionPrefix = "HTTP/1.";
+  constexpr std::size_t kVersionLineSize = kVersionPrefix.size() + 3;
+  if (end - pos < static_cast<std::ptrdiff_t>(kVersionLineSize)) {
+    return Result::kIncomplete;
+  }
+  if (std::string_view{pos, kVersionPrefix.size()} != kVersionPrefix ||
+      (pos[7] != '0' && pos[7] != '1') || pos[8] != '\r' || pos[9] != '\n') {
+    return Result::kUnsupported;
+  }
+  head.http_major = 1;
+  head.http_minor = pos[7] - '0';
+  pos += kVersionLineSize;
+
+  // Headers
+  bool has_content_length = false;
+  bool has_connection_close = false;
+  bool has_connection_keep_alive = false;
+  while (true) {
+    if (static_cast<std::size_t>(pos - begin) > kMaxHeadSize) {
+      return Result::kUnsupported;
+    }
+    if (end - pos < 2) return Result::kIncomplete;
+    if (pos[0] == '\r') {
+      if (pos[1] != '\n') return Result::kUnsupported;
+      pos += 2;
+      break;
+    }
+
+    // Lines starting with a whitespace (obsolete line folding) end up here
+    const char* const name_end = FindTokenEnd(pos, end);
+    if (name_end == end) return Result::kIncomplete;
+    if (*name_end != ':' || name_end == pos) return Result::kUnsupported;
+    const std::string_view name{pos, static_cast<std::size_t>(name_end - pos)};
+    pos = name_end + 1;
+
+    while (pos != end && (*pos == ' ' || *pos == '\t')) ++pos;
+    const char* const value_end =
+        FindDelimiter<CharClass::kHeaderValue>(pos, end);
+    if (end - value_end < 2) return Result::kIncomplete;
+    if (value_end[0] != '\r' || value_end[1] != '\n') {
+      return Result::kUnsupported;
+    }
+    const std::string_view value{pos,
+                                 static_cast<std::size_t>(value_end - pos)};
+    // Trailing whitespace is left for http_parser to deal with
+    if (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+      return Result::kUnsupported;
+    }
+    pos = value_end + 2;
+
+    if (kIcaseEqual(name, headers::kContentLength)) {
+      if (has_content_length || !ParseContentLength(value, head.content_length))
+        return Result::kUnsupported;
+      has_content_length = true;
+    } else if (kIcaseEqual(name, headers::kConnection) ||
+               kIcaseEqual(name, kProxyConnection)) {
+      // Lists of options and upgrades are left for http_parser
+      if (kIcaseEqual(value, "close")) {
+        has_connection_close = true;
+      } else if (kIcaseEqual(value, "keep-alive")) {
+        has_connection_keep_alive = true;
+      } else {
+        return Result::kUnsupported;
+      }
+    } else if (kIcaseEqual(name, headers::kTransferEncoding) ||
+               kIcaseEqual(name, headers::kUpgrade)) {
+      return Result::kUnsupported;
+    }
+
+    head.headers.push_back({name, value});
+  }
+
+  // http_should_keep_alive() semantics
+  head.keep_alive =
+      head.http_minor == 1 ? !has_connection_close : has_connection_keep_alive;
+  head.size = pos - begin;
+  return Result::kComplete;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
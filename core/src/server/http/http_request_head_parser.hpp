@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include <boost/container/small_vector.hpp>
+
+#include <userver/server/http/http_method.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+struct HttpRequestHeadField final {
+  std::string_view name;
+  std::string_view value;
+};
+
+/// Request line and headers of an HTTP/1.x request, the views point into the
+/// parsed buffer
+struct HttpRequestHead final {
+  static constexpr std::size_t kTypicalHeadersCount = 16;
+
+  void Clear() noexcept;
+
+  HttpMethod method{HttpMethod::kUnknown};
+  std::string_view url;
+  unsigned short http_major{0};
+  unsigned short http_minor{0};
+  boost::container::small_vector<HttpRequestHeadField, kTypicalHeadersCount>
+      headers;
+  std::size_t content_length{0};
+  bool keep_alive{false};
+
+  /// Size of the request line and headers, including the final empty line
+  std::size_t size{0};
+};
+
+enum class HttpRequestHeadParseResult {
+  kComplete,
+  kIncomplete,
+  /// The request is either malformed or uses features that are not handled
+  /// by ParseHttpRequestHead, e.g. chunked body, upgrade, obsolete line
+  /// folding or an uncommon method
+  kUnsupported,
+};
+
+/// @brief Parses the request line and headers of a request that starts at the
+/// beginning of `data`.
+///
+/// Delimiters are searched for 16 or 32 bytes at a time with SSE2/AVX2 or NEON.
+/// Only the common and unambiguous requests are accepted, everything else is
+/// reported as kUnsupported and should be handled by a full HTTP parser.
+HttpRequestHeadParseResult ParseHttpRequestHead(std::string_view data,
+                                                HttpRequestHead& head);
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
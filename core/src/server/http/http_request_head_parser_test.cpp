@@ -0,0 +1,161 @@
+#include <server/http/http_request_head_parser.hpp>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "create_parser_test.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::HttpMethod;
+using server::http::HttpRequestHead;
+using server::http::ParseHttpRequestHead;
+using Result = server::http::HttpRequestHeadParseResult;
+
+}  // namespace
+
+TEST(HttpRequestHeadParser, Simple) {
+  const std::string request =
+      "POST /some/path?arg=1 HTTP/1.1\r\n"
+      "Host: localhost\r\n"
+      "Content-Length: 4\r\n"
+      "X-Empty:\r\n"
+      "X-Spaces: \t value with spaces\r\n"
+      "\r\n"
+      "body";
+
+  HttpRequestHead head;
+  ASSERT_EQ(ParseHttpRequestHead(request, head), Result::kComplete);
+  EXPECT_EQ(head.method, HttpMethod::kPost);
+  EXPECT_EQ(head.url, "/some/path?arg=1");
+  EXPECT_EQ(head.http_major, 1);
+  EXPECT_EQ(head.http_minor, 1);
+  EXPECT_EQ(head.content_length, 4);
+  EXPECT_TRUE(head.keep_alive);
+  EXPECT_EQ(head.size, request.size() - 4);
+
+  ASSERT_EQ(head.headers.size(), 4);
+  EXPECT_EQ(head.headers[0].name, "Host");
+  EXPECT_EQ(head.headers[0].value, "localhost");
+  EXPECT_EQ(head.headers[2].name, "X-Empty");
+  EXPECT_EQ(head.headers[2].value, "");
+  EXPECT_EQ(head.headers[3].value, "value with spaces");
+}
+
+TEST(HttpRequestHeadParser, LongLines) {
+  // Longer than any SIMD register, with the delimiter at every offset
+  for (std::size_t length = 1; length < 100; ++length) {
+    const std::string url = '/' + std::string(length, 'u');
+    const std::string value(length, 'v');
+    const std::string request =
+        "GET " + url + " HTTP/1.1\r\nX-Header: " + value + "\r\n\r\n";
+
+    HttpRequestHead head;
+    ASSERT_EQ(ParseHttpRequestHead(request, head), Result::kComplete) << length;
+    EXPECT_EQ(head.url, url);
+    ASSERT_EQ(head.headers.size(), 1);
+    EXPECT_EQ(head.headers[0].value, value);
+    EXPECT_EQ(head.size, request.size());
+  }
+}
+
+TEST(HttpRequestHeadParser, Incomplete) {
+  const std::string request =
+      "GET / HTTP/1.1\r\n"
+      "Host: localhost\r\n"
+      "\r\n";
+
+  HttpRequestHead head;
+  for (std::size_t size = 0; size < request.size(); ++size) {
+    EXPECT_EQ(ParseHttpRequestHead({request.data(), size}, head),
+              Result::kIncomplete)
+        << size;
+  }
+  EXPECT_EQ(ParseHttpRequestHead(request, head), Result::kComplete);
+}
+
+TEST(HttpRequestHeadParser, KeepAlive) {
+  HttpRequestHead head;
+  ASSERT_EQ(ParseHttpRequestHead("GET / HTTP/1.0\r\n\r\n", head),
+            Result::kComplete);
+  EXPECT_FALSE(head.keep_alive);
+
+  ASSERT_EQ(ParseHttpRequestHead(
+                "GET / HTTP/1.0\r\nConnection: Keep-Alive\r\n\r\n", head),
+            Result::kComplete);
+  EXPECT_TRUE(head.keep_alive);
+
+  ASSERT_EQ(
+      ParseHttpRequestHead("GET / HTTP/1.1\r\nConnection: close\r\n\r\n", head),
+      Result::kComplete);
+  EXPECT_FALSE(head.keep_alive);
+}
+
+TEST(HttpRequestHeadParser, Unsupported) {
+  const std::vector<std::string> requests{
+      "\r\nGET / HTTP/1.1\r\n\r\n",
+      "CONNECT host:443 HTTP/1.1\r\n\r\n",
+      "get / HTTP/1.1\r\n\r\n",
+      "GET  / HTTP/1.1\r\n\r\n",
+      "GET /\x01 HTTP/1.1\r\n\r\n",
+      "GET /\xd0\xb0 HTTP/1.1\r\n\r\n",
+      "GET / HTTP/2.0\r\n\r\n",
+      "GET / HTTP/1.1\n\n",
+      "GET / HTTP/1.1\r\nHost : localhost\r\n\r\n",
+      "GET / HTTP/1.1\r\nHost: localhost \r\n\r\n",
+      "GET / HTTP/1.1\r\nHost: local\x01host\r\n\r\n",
+      "GET / HTTP/1.1\r\nX-Folded: a\r\n b\r\n\r\n",
+      "GET / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 1\r\n\r\n",
+      "GET / HTTP/1.1\r\nContent-Length: -1\r\n\r\n",
+      "GET / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n",
+      "GET / HTTP/1.1\r\nConnection: Upgrade\r\nUpgrade: websocket\r\n\r\n",
+      "GET / HTTP/1.1\r\nConnection: keep-alive, Upgrade\r\n\r\n",
+  };
+
+  HttpRequestHead head;
+  for (const auto& request : requests) {
+    EXPECT_EQ(ParseHttpRequestHead(request, head), Result::kUnsupported)
+        << request;
+  }
+}
+
+UTEST(HttpRequestParser, FastPathAndFallback) {
+  std::vector<std::string> urls;
+  std::vector<std::string> bodies;
+  auto parser = server::CreateTestParser(
+      [&](std::shared_ptr<server::request::RequestBase>&& request) {
+        auto& http_request_impl =
+            dynamic_cast<server::http::HttpRequestImpl&>(*request);
+        const server::http::HttpRequest http_request(http_request_impl);
+        urls.push_back(http_request.GetUrl());
+        bodies.push_back(http_request.RequestBody());
+      });
+
+  const std::string requests =
+      "POST /first HTTP/1.1\r\nContent-Length: 3\r\n\r\none"
+      "POST /chunked HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n"
+      "3\r\ntwo\r\n0\r\n\r\n"
+      "GET /third?a=b HTTP/1.1\r\nHost: localhost\r\n\r\n"
+      "POST /split HTTP/1.1\r\nContent-Length: 4\r\n\r\nfour";
+
+  // Every split point switches between the fast path and http_parser
+  for (std::size_t split = 0; split <= requests.size(); ++split) {
+    urls.clear();
+    bodies.clear();
+    ASSERT_TRUE(parser.Parse(requests.data(), split));
+    ASSERT_TRUE(
+        parser.Parse(requests.data() + split, requests.size() - split));
+
+    const std::vector<std::string> expected_urls{"/first", "/chunked",
+                                                 "/third?a=b", "/split"};
+    const std::vector<std::string> expected_bodies{"one", "two", "", "four"};
+    EXPECT_EQ(urls, expected_urls) << split;
+    EXPECT_EQ(bodies, expected_bodies) << split;
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,9 @@
 #include <benchmark/benchmark.h>
 
+#include <http_parser.h>
+
 #include <server/http/http_request_constructor.hpp>
+#include <server/http/http_request_head_parser.hpp>
 #include <userver/http/predefined_header.hpp>
 
 #include <utils/gbench_auxilary.hpp>
@@ -51,6 +54,63 @@ void http_request_headers_get(benchmark::State& state) {
   }
 }
 
+std::string MakeRequestHead(std::size_t headers_count) {
+  std::string request =
+      "GET /some/path/to/handler?arg1=value1&arg2=value2 HTTP/1.1\r\n";
+  for (std::size_t i = 0; i < headers_count; ++i) {
+    request += fmt::format("{}: some-typical-header-value-{}\r\n",
+                           kHeadersArray[i], i);
+  }
+  request += "\r\n";
+  return request;
+}
+
+void http_request_head_parse_simd(benchmark::State& state) {
+  const auto request = MakeRequestHead(state.range(0));
+  server::http::HttpRequestHead head;
+
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(server::http::ParseHttpRequestHead(request, head));
+    benchmark::DoNotOptimize(head);
+  }
+  state.SetBytesProcessed(state.iterations() * request.size());
+}
+
+void http_request_head_parse_http_parser(benchmark::State& state) {
+  const auto request = MakeRequestHead(state.range(0));
+
+  // Collects the views like a zero-copy consumer would
+  struct Views final {
+    std::string_view url;
+    std::vector<std::string_view> fields;
+  } views;
+  views.fields.reserve(kHeadersCount * 2);
+
+  http_parser_settings settings{};
+  settings.on_url = [](http_parser* p, const char* data, size_t size) {
+    static_cast<Views*>(p->data)->url = {data, size};
+    return 0;
+  };
+  settings.on_header_field = [](http_parser* p, const char* data,
+                                size_t size) {
+    static_cast<Views*>(p->data)->fields.emplace_back(data, size);
+    return 0;
+  };
+  settings.on_header_value = settings.on_header_field;
+
+  for ([[maybe_unused]] auto _ : state) {
+    http_parser parser{};
+    http_parser_init(&parser, HTTP_REQUEST);
+    parser.data = &views;
+    views.fields.clear();
+    benchmark::DoNotOptimize(http_parser_execute(&parser, &settings,
+                                                 request.data(),
+                                                 request.size()));
+    benchmark::DoNotOptimize(views);
+  }
+  state.SetBytesProcessed(state.iterations() * request.size());
+}
+
 }  // namespace
 BENCHMARK(http_request_headers_insert)
     ->RangeMultiplier(2)
@@ -58,4 +118,11 @@ BENCHMARK(http_request_headers_insert)
 
 BENCHMARK(http_request_headers_get);
 
+BENCHMARK(http_request_head_parse_simd)
+    ->RangeMultiplier(2)
+    ->Range(1, kHeadersCount);
+BENCHMARK(http_request_head_parse_http_parser)
+    ->RangeMultiplier(2)
+    ->Range(1, kHeadersCount);
+
 USERVER_NAMESPACE_END
@@ -267,6 +267,12 @@ void HttpRequestImpl::ParseArgsFromBody() {
       });
 }
 
+RequestBodyStream& HttpRequestImpl::GetBodyStream() const {
+  UASSERT(!is_body_streamed_ || body_stream_);
+  if (!body_stream_) body_stream_.emplace(std::string_view{request_body_});
+  return *body_stream_;
+}
+
 bool HttpRequestImpl::IsBodyCompressed() const {
   const auto& encoding =
       GetHeader(USERVER_NAMESPACE::http::headers::kContentEncoding);
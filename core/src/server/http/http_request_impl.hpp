@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -10,6 +11,7 @@
 
 #include <userver/server/http/http_method.hpp>
 #include <userver/server/http/http_request.hpp>
+#include <userver/server/http/http_request_body_stream.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/request/request_base.hpp>
 #include <userver/utils/datetime/wall_coarse_clock.hpp>
@@ -84,6 +86,8 @@ class HttpRequestImpl final : public request::RequestBase {
 
   const std::string& RequestBody() const { return request_body_; }
   void SetRequestBody(std::string body);
+  bool IsBodyStreamed() const { return is_body_streamed_; }
+  RequestBodyStream& GetBodyStream() const;
   void ParseArgsFromBody();
   void SetResponseStatus(HttpStatus status) const {
     response_.SetStatus(status);
@@ -158,6 +162,10 @@ class HttpRequestImpl final : public request::RequestBase {
   HttpRequest::HeadersMap headers_;
   HttpRequest::CookiesMap cookies_;
   bool is_final_{false};
+  bool is_body_streamed_{false};
+  // Lazily created over the request_body_ for the requests that are not
+  // streamed
+  mutable std::optional<RequestBodyStream> body_stream_;
   UpgradeCallback upgrade_websocket_cb_;
 
   mutable HttpResponse response_;
@@ -63,12 +63,82 @@ HttpRequestParser::HttpRequestParser(
 }
 
 bool HttpRequestParser::Parse(const char* data, size_t size) {
+  // Requests that are completely in the buffer take the fast path, the rest
+  // are fed into http_parser starting from a message boundary
+  while (size != 0 && !is_http_parser_in_message_) {
+    if (is_final_request_parsed_) return ParseAfterFinalRequest(data, size);
+
+    if (ParseHttpRequestHead({data, size}, request_head_) !=
+        HttpRequestHeadParseResult::kComplete) {
+      break;
+    }
+    const auto body_size = request_head_.content_length;
+    if (size - request_head_.size < body_size) break;
+
+    const std::string_view body{data + request_head_.size, body_size};
+    if (!ConstructRequest(request_head_, body)) return false;
+    data += request_head_.size + body_size;
+    size -= request_head_.size + body_size;
+  }
+  request_head_.Clear();
+
+  if (size == 0) return true;
+  return ParseWithHttpParser(data, size);
+}
+
+bool HttpRequestParser::ConstructRequest(const HttpRequestHead& head,
+                                         std::string_view body) {
+  CreateRequestConstructor();
+  try {
+    request_constructor_->SetMethod(head.method);
+    request_constructor_->AppendUrl(head.url.data(), head.url.size());
+    request_constructor_->SetHttpMajor(head.http_major);
+    request_constructor_->SetHttpMinor(head.http_minor);
+    url_complete_ = true;
+    request_constructor_->ParseUrl();
+
+    for (const auto& header : head.headers) {
+      request_constructor_->AppendHeader(header.name, header.value);
+    }
+    request_constructor_->AppendHeaderField("", 0);
+
+    if (!request_constructor_->IsBodyStreamed()) {
+      request_constructor_->AppendBody(body.data(), body.size());
+    }
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "can't construct request: " << ex;
+    FinalizeRequest();
+    return false;
+  }
+
+  const bool is_final = IsFinalRequest(head.keep_alive);
+  if (is_final) is_final_request_parsed_ = true;
+  if (request_constructor_->IsBodyStreamed()) {
+    if (!StartStreamedRequest(is_final)) return false;
+    if (body_producer_ && body_producer_->Push(body)) body_producer_->Finish();
+    body_producer_.reset();
+    is_streaming_body_ = false;
+    return true;
+  }
+
+  request_constructor_->SetIsFinal(is_final);
+  LOG_TRACE() << "message complete";
+  return FinalizeRequest();
+}
+
+bool HttpRequestParser::ParseWithHttpParser(const char* data, size_t size) {
   size_t parsed = http_parser_execute(&parser_, &parser_settings, data, size);
   if (parsed != size) {
     LOG_WARNING() << "parsed=" << parsed << " size=" << size
                   << " error_description="
                   << http_errno_description(HTTP_PARSER_ERRNO(&parser_));
-    FinalizeRequest();
+    if (is_streaming_body_) {
+      // The request is already passed to the handler, it gets the body
+      // truncated
+      AbortStreamedBody();
+    } else {
+      FinalizeRequest();
+    }
     return false;
   }
   if (parser_.upgrade) {
@@ -78,6 +148,21 @@ bool HttpRequestParser::Parse(const char* data, size_t size) {
   return true;
 }
 
+bool HttpRequestParser::ParseAfterFinalRequest(const char* data, size_t size) {
+  // Same as http_parser does after a "Connection: close" request
+  const std::string_view rest{data, size};
+  if (rest.find_first_not_of("\r\n") == std::string_view::npos) return true;
+
+  if (is_close_requested_) {
+    LOG_DEBUG() << "dropping the pipelined requests after the last request of "
+                   "the connection";
+    return false;
+  }
+  LOG_WARNING() << "data received after completed connection: close message";
+  FinalizeRequest();
+  return false;
+}
+
 int HttpRequestParser::OnMessageBegin(http_parser* p) {
   auto* http_request_parser = static_cast<HttpRequestParser*>(p->data);
   UASSERT(http_request_parser != nullptr);
@@ -124,6 +209,7 @@ int HttpRequestParser::OnBody(http_parser* p, const char* data, size_t size) {
 
 int HttpRequestParser::OnMessageBeginImpl(http_parser*) {
   LOG_TRACE() << "message begin";
+  is_http_parser_in_message_ = true;
   CreateRequestConstructor();
   return 0;
 }
@@ -181,11 +267,25 @@ int HttpRequestParser::OnHeadersCompleteImpl(http_parser* p) {
     return -1;
   }
   LOG_TRACE() << "headers complete";
+
+  if (request_constructor_->IsBodyStreamed()) {
+    if (!StartStreamedRequest(IsFinalRequest(http_should_keep_alive(p)))) {
+      return -1;
+    }
+  }
   return 0;
 }
 
 int HttpRequestParser::OnBodyImpl(http_parser* p, const char* data,
                                   size_t size) {
+  if (is_streaming_body_) {
+    if (body_producer_ && !body_producer_->Push({data, size})) {
+      LOG_TRACE() << "skipping the rest of the streamed body";
+      body_producer_.reset();
+    }
+    return 0;
+  }
+
   UASSERT(request_constructor_);
   if (!CheckUrlComplete(p)) return -1;
   LOG_TRACE() << "body: '" << std::string_view(data, size) << "'";
@@ -199,11 +299,26 @@ int HttpRequestParser::OnBodyImpl(http_parser* p, const char* data,
 }
 
 int HttpRequestParser::OnMessageCompleteImpl(http_parser* p) {
-  UASSERT(request_constructor_);
   if (p->upgrade) {
     return -1;  // error
   }
-  request_constructor_->SetIsFinal(!http_should_keep_alive(p));
+  is_http_parser_in_message_ = false;
+
+  if (is_streaming_body_) {
+    // The handler already has the request, so it stays as final as it was
+    if (is_streamed_request_final_) is_final_request_parsed_ = true;
+    LOG_TRACE() << "streamed body complete";
+    if (body_producer_) body_producer_->Finish();
+    body_producer_.reset();
+    is_streaming_body_ = false;
+    return 0;
+  }
+
+  const bool is_final = IsFinalRequest(http_should_keep_alive(p));
+  if (is_final) is_final_request_parsed_ = true;
+
+  UASSERT(request_constructor_);
+  request_constructor_->SetIsFinal(is_final);
   if (!CheckUrlComplete(p)) return -1;
   LOG_TRACE() << "message complete";
   if (!FinalizeRequest()) return -1;
@@ -240,6 +355,22 @@ bool HttpRequestParser::FinalizeRequest() {
   return res;
 }
 
+bool HttpRequestParser::StartStreamedRequest(bool is_final) {
+  UASSERT(request_constructor_);
+  request_constructor_->SetIsFinal(is_final);
+  is_streamed_request_final_ = is_final;
+  body_producer_.emplace(request_constructor_->StartBodyStream());
+  is_streaming_body_ = true;
+  if (FinalizeRequest()) return true;
+  AbortStreamedBody();
+  return false;
+}
+
+void HttpRequestParser::AbortStreamedBody() {
+  body_producer_.reset();
+  is_streaming_body_ = false;
+}
+
 bool HttpRequestParser::FinalizeRequestImpl() {
   if (!request_constructor_) CreateRequestConstructor();
 
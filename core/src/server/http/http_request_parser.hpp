@@ -13,6 +13,7 @@
 #include <userver/server/request/request_config.hpp>
 
 #include "http_request_constructor.hpp"
+#include "http_request_head_parser.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -33,7 +34,26 @@ class HttpRequestParser final : public request::RequestParser {
 
   bool Parse(const char* data, size_t size) override;
 
+  // The request was passed to the handler, but the rest of its streamed body
+  // is not received yet
+  bool IsReadingBody() const { return is_streaming_body_; }
+
+  // The beginning of a request is received, but not the whole request
+  bool IsInMessage() const { return is_http_parser_in_message_; }
+
+  // The next request gets a `Connection: close` response, the requests after
+  // it are dropped
+  void CloseAfterNextRequest() { is_close_requested_ = true; }
+
  private:
+  // Constructs the request from a parsed head and the whole body
+  bool ConstructRequest(const HttpRequestHead& head, std::string_view body);
+  bool ParseWithHttpParser(const char* data, size_t size);
+  bool ParseAfterFinalRequest(const char* data, size_t size);
+  bool IsFinalRequest(bool keep_alive) const {
+    return !keep_alive || is_close_requested_;
+  }
+
   static int OnMessageBegin(http_parser* p);
   static int OnUrl(http_parser* p, const char* data, size_t size);
   static int OnHeaderField(http_parser* p, const char* data, size_t size);
@@ -57,15 +77,29 @@ class HttpRequestParser final : public request::RequestParser {
   bool FinalizeRequest();
   bool FinalizeRequestImpl();
 
+  // Passes the request to the handler before its body is received
+  bool StartStreamedRequest(bool is_final);
+  void AbortStreamedBody();
+
   const HandlerInfoIndex& handler_info_index_;
   const HttpRequestConstructor::Config request_constructor_config_;
 
   bool url_complete_ = false;
+  // http_parser is in the middle of a request, it has to get the rest of it
+  bool is_http_parser_in_message_ = false;
+  bool is_final_request_parsed_ = false;
+  bool is_streaming_body_ = false;
+  bool is_streamed_request_final_ = false;
+  bool is_close_requested_ = false;
 
   OnNewRequestCb on_new_request_cb_;
 
   http_parser parser_{};
+  HttpRequestHead request_head_;
   std::optional<HttpRequestConstructor> request_constructor_;
+  // Is reset if the handler does not read the body anymore, the rest of the
+  // body is skipped
+  std::optional<impl::RequestBodyProducer> body_producer_;
 
   static const http_parser_settings parser_settings;
   net::ParserStats& stats_;
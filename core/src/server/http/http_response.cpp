@@ -85,6 +85,54 @@ void AppendToCharArray(char*& data, const std::string_view what) {
 
 const std::string kEmptyString{};
 
+// Body parts of a chunked response that are sent with a single vectored write
+class ChunksBatch final {
+ public:
+  static constexpr std::size_t kMaxChunks = 32;
+
+  bool IsFull() const noexcept { return chunks_count_ == kMaxChunks; }
+
+  void AddRaw(std::string_view data) noexcept {
+    UASSERT(io_size_ < io_.size());
+    io_[io_size_++] = {data.data(), data.size()};
+  }
+
+  // Takes the chunk and keeps it alive until the batch is written
+  void AddChunk(std::string& chunk) {
+    UASSERT(!IsFull());
+    if (chunk.empty()) {
+      LOG_DEBUG() << "Zero size body_part in http_response.cpp";
+      return;
+    }
+
+    auto& size_line = size_lines_[chunks_count_];
+    const auto* size_line_end = fmt::format_to(
+        size_line.data(), FMT_COMPILE("\r\n{:x}\r\n"), chunk.size());
+    AddRaw({size_line.data(),
+            static_cast<std::size_t>(size_line_end - size_line.data())});
+
+    auto& stored_chunk = chunks_[chunks_count_++];
+    std::swap(stored_chunk, chunk);
+    AddRaw(stored_chunk);
+  }
+
+  std::size_t Write(engine::io::RwBase& socket) {
+    if (io_size_ == 0) return 0;
+    const auto sent_bytes = socket.WriteAll(io_.data(), io_size_, {});
+    io_size_ = 0;
+    chunks_count_ = 0;
+    return sent_bytes;
+  }
+
+ private:
+  // "\r\n" + up to 16 hex digits + "\r\n"
+  std::array<std::array<char, 20>, kMaxChunks> size_lines_{};
+  std::array<std::string, kMaxChunks> chunks_;
+  std::array<engine::io::IoData, 2 * kMaxChunks + 1> io_{};
+  std::size_t io_size_{0};
+  std::size_t chunks_count_{0};
+};
+
 }  // namespace
 
 namespace server::http {
@@ -351,29 +399,28 @@ std::size_t HttpResponse::SetBodyStreamed(
 
   if (is_body_forbidden) {
     header.append(kCrlf);
+    return socket.WriteAll(header.data(), header.size(), {});
   }
 
-  // send HTTP headers
-  size_t sent_bytes = socket.WriteAll(header.data(), header.size(), {});
+  // Body parts that are already produced are sent with a single write, the
+  // HTTP headers are sent right away along with the ready parts
+  ChunksBatch batch;
+  std::string body_part;
+  batch.AddRaw({header.data(), header.size()});
+  while (!batch.IsFull() && body_stream_->PopNoblock(body_part)) {
+    batch.AddChunk(body_part);
+  }
+  std::size_t sent_bytes = batch.Write(socket);
   header.clear();
   header.shrink_to_fit();  // free memory before time-consuming operation
 
-  if (is_body_forbidden) {
-    return sent_bytes;
-  }
-
   // Transmit HTTP response body
-  std::string body_part;
   while (body_stream_->Pop(body_part)) {
-    if (body_part.empty()) {
-      LOG_DEBUG() << "Zero size body_part in http_response.cpp";
-      continue;
+    batch.AddChunk(body_part);
+    while (!batch.IsFull() && body_stream_->PopNoblock(body_part)) {
+      batch.AddChunk(body_part);
     }
-
-    auto size = fmt::format("\r\n{:x}\r\n", body_part.size());
-    sent_bytes += socket.WriteAll(
-        {{size.data(), size.size()}, {body_part.data(), body_part.size()}},
-        engine::Deadline{});
+    sent_bytes += batch.Write(socket);
   }
 
   const constexpr std::string_view terminating_chunk{"\r\n0\r\n\r\n"};
@@ -1,8 +1,13 @@
 #include <benchmark/benchmark.h>
 
 #include <fmt/compile.h>
+#include <cstring>
 #include <sstream>
 
+#include <server/http/http_request_impl.hpp>
+#include <server/net/buffered_writer.hpp>
+#include <userver/engine/io/common.hpp>
+#include <userver/engine/run_standalone.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/http/http_status.hpp>
@@ -120,10 +125,114 @@ void http_headers_serialization_ostreams(benchmark::State& state) {
   }
 }
 
+// Consumes the written data and counts the write calls, each of them is a
+// send/sendmsg syscall on a real socket
+class CountingSocket final : public engine::io::RwBase {
+ public:
+  bool IsValid() const override { return true; }
+
+  bool WaitReadable(engine::Deadline) override { return false; }
+
+  size_t ReadSome(void*, size_t, engine::Deadline) override { return 0; }
+
+  size_t ReadAll(void*, size_t, engine::Deadline) override { return 0; }
+
+  bool WaitWriteable(engine::Deadline) override { return true; }
+
+  size_t WriteAll(const void*, size_t len, engine::Deadline) override {
+    ++writes_count_;
+    return len;
+  }
+
+  size_t WriteAll(std::initializer_list<engine::io::IoData> list,
+                  engine::Deadline deadline) override {
+    return WriteAll(list.begin(), list.size(), deadline);
+  }
+
+  size_t WriteAll(const engine::io::IoData* list, std::size_t list_size,
+                  engine::Deadline) override {
+    ++writes_count_;
+    std::size_t total_size = 0;
+    for (std::size_t i = 0; i < list_size; ++i) total_size += list[i].len;
+    return total_size;
+  }
+
+  std::size_t GetWritesCount() const { return writes_count_; }
+
+ private:
+  std::size_t writes_count_{0};
+};
+
+void http_response_streamed_send(benchmark::State& state) {
+  const auto chunks_count = state.range(0);
+  const std::string chunk(state.range(1), 'a');
+
+  engine::RunStandalone([&] {
+    CountingSocket socket;
+    std::size_t responses_count = 0;
+
+    for ([[maybe_unused]] auto _ : state) {
+      server::request::ResponseDataAccounter accounter;
+      server::http::HttpRequestImpl request{accounter};
+      server::http::HttpResponse response{request, accounter};
+      response.SetStatus(server::http::HttpStatus::kOk);
+      response.SetStreamBody();
+
+      {
+        auto producer = response.GetBodyProducer();
+        for (std::int64_t i = 0; i < chunks_count; ++i) {
+          [[maybe_unused]] const bool pushed = producer.Push(std::string{chunk});
+        }
+      }
+
+      response.SendResponse(socket);
+      ++responses_count;
+    }
+
+    state.counters["writes_per_response"] = benchmark::Counter(
+        static_cast<double>(socket.GetWritesCount()) / responses_count);
+  });
+}
+
+void http_pipelined_responses_send(benchmark::State& state) {
+  const auto responses_count = state.range(0);
+  const bool is_buffered = state.range(1);
+  const std::string header(256, 'h');
+  const std::string body(512, 'b');
+
+  engine::RunStandalone([&] {
+    CountingSocket socket;
+    std::size_t batches_count = 0;
+
+    for ([[maybe_unused]] auto _ : state) {
+      server::net::BufferedWriter writer{socket};
+      engine::io::RwBase& out =
+          is_buffered ? static_cast<engine::io::RwBase&>(writer) : socket;
+      for (std::int64_t i = 0; i < responses_count; ++i) {
+        [[maybe_unused]] const auto sent =
+            out.WriteAll({{header.data(), header.size()},
+                          {body.data(), body.size()}},
+                         {});
+      }
+      writer.Flush({});
+      ++batches_count;
+    }
+
+    state.counters["writes_per_batch"] = benchmark::Counter(
+        static_cast<double>(socket.GetWritesCount()) / batches_count);
+  });
+}
+
 }  // namespace
 
 BENCHMARK(http_headers_serialization_inplace);
 BENCHMARK(http_headers_serialization_no_ostreams);
 BENCHMARK(http_headers_serialization_ostreams);
+BENCHMARK(http_response_streamed_send)
+    ->ArgsProduct({{1, 8, 64}, {16, 4096}})
+    ->ArgNames({"chunks", "chunk_size"});
+BENCHMARK(http_pipelined_responses_send)
+    ->ArgsProduct({{1, 4, 16}, {0, 1}})
+    ->ArgNames({"responses", "buffered"});
 
 USERVER_NAMESPACE_END
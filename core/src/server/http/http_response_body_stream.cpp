@@ -1,21 +1,48 @@
 #include <userver/server/http/http_response_body_stream.hpp>
 
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <server/http/response_compression.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::http {
 
 ResponseBodyStream::ResponseBodyStream(
     server::http::HttpResponse::Queue::Producer&& queue_producer,
-    server::http::HttpResponse& http_response)
+    server::http::HttpResponse& http_response,
+    std::unique_ptr<impl::ResponseStreamCompressor> compressor)
     : queue_producer_(std::move(queue_producer)),
-      http_response_(http_response) {}
+      http_response_(http_response),
+      compressor_(std::move(compressor)) {}
+
+ResponseBodyStream::ResponseBodyStream(ResponseBodyStream&&) noexcept = default;
+
+ResponseBodyStream::~ResponseBodyStream() {
+  if (!compressor_ || !headers_ended_) return;
+
+  try {
+    auto tail = compressor_->Finish();
+    if (!tail.empty()) {
+      const auto success =
+          queue_producer_.Push(std::move(tail), engine::Deadline{});
+      UASSERT(success);
+    }
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "failed to finish the compressed response body: " << ex;
+  }
+}
 
 void ResponseBodyStream::PushBodyChunk(std::string&& chunk,
                                        engine::Deadline deadline) {
   UASSERT_MSG(headers_ended_,
               "SetEndOfHeaders() was not called before PushBodyChunk()");
+  if (compressor_) {
+    chunk = compressor_->Compress(chunk);
+    if (chunk.empty()) return;
+  }
   const auto success = queue_producer_.Push(std::move(chunk), deadline);
   UASSERT(success);
 }
@@ -31,6 +58,16 @@ void ResponseBodyStream::SetHeader(std::string_view name,
 }
 
 void ResponseBodyStream::SetEndOfHeaders() {
+  if (compressor_) {
+    // The handler has encoded the body by itself
+    if (http_response_.HasHeader(
+            USERVER_NAMESPACE::http::headers::kContentEncoding)) {
+      compressor_.reset();
+    } else {
+      SetResponseContentEncoding(http_response_, compressor_->GetEncoding());
+    }
+  }
+
   headers_ended_ = true;
   http_response_.SetHeadersEnd();
 }
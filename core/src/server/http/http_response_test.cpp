@@ -83,6 +83,50 @@ UTEST(HttpResponse, AccounterLifetimeIfSent) {
   // Now we just should not crash
 }
 
+UTEST(HttpResponse, SharedData) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+
+  const auto body = std::make_shared<const std::string>("shared test data");
+  response.SetSharedData(body);
+  response.SetStatus(server::http::HttpStatus::kOk);
+  EXPECT_TRUE(response.HasSharedData());
+  EXPECT_EQ(&response.GetData(), body.get());
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [](auto&& response, auto&& socket) { response.SendResponse(socket); },
+      std::ref(response), std::move(server));
+
+  std::string buffer(4096, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+  buffer.resize(reply_size);
+
+  EXPECT_THAT(buffer, testing::EndsWith("\r\n\r\n" + *body));
+  EXPECT_THAT(buffer, testing::HasSubstr(fmt::format(
+                          "\r\n{}: {}\r\n", http::headers::kContentLength,
+                          body->size())));
+}
+
+TEST(HttpResponse, SetDataOverridesSharedData) {
+  server::request::ResponseDataAccounter accounter{};
+  const server::http::HttpRequestImpl request_impl{accounter};
+  server::http::HttpResponse response{request_impl, accounter};
+
+  const auto body = std::make_shared<const std::string>("shared test data");
+  response.SetSharedData(body);
+  response.SetData("own data");
+  EXPECT_FALSE(response.HasSharedData());
+  EXPECT_EQ(response.GetData(), "own data");
+  EXPECT_EQ(*body, "shared test data");
+}
+
 class HttpResponseBody : public testing::TestWithParam<int> {};
 
 UTEST_P(HttpResponseBody, ForbiddenBody) {
@@ -5,6 +5,8 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <utils/impl/byte_scan.hpp>
+
 #include <array>
 
 USERVER_NAMESPACE_BEGIN
@@ -262,40 +264,28 @@ bool ParseMultipartFormDataHeaders(std::string_view& body,
   return SkipCrLf(body, crlf);
 }
 
-size_t FindBoundaryEnd(std::string_view body, std::string_view boundary,
-                       std::string_view crlf) {
-  size_t pos = 0;
-  while (pos < body.size()) {
-    if (body[pos] == crlf.front()) {
-      if (pos + crlf.size() < body.size() &&
-          body.substr(pos, crlf.size()) == crlf) {
-        pos += crlf.size();
-        if (pos < body.size() && body[pos] == '-') {
-          ++pos;
-          if (pos < body.size() && body[pos] == '-') {
-            ++pos;
-            size_t idx = 0;
-            while (idx < boundary.size() && pos + idx < body.size() &&
-                   body[pos + idx] == boundary[idx])
-              ++idx;
-            pos += idx;
-            if (idx == boundary.size()) return pos;
-          }
-        }
-      } else
-        ++pos;
-    } else
-      ++pos;
-  }
-  return std::string_view::npos;
+// The delimiter is CRLF, "--" and the boundary
+std::string MakeDelimiter(std::string_view boundary, std::string_view crlf) {
+  std::string delimiter;
+  delimiter.reserve(crlf.size() + 2 + boundary.size());
+  delimiter.append(crlf).append("--").append(boundary);
+  return delimiter;
+}
+
+// Returns the position right after the first delimiter or npos
+size_t FindBoundaryEnd(std::string_view body, std::string_view delimiter) {
+  const char* const end = body.data() + body.size();
+  const char* const pos =
+      utils::impl::FindSubstring(body.data(), end, delimiter);
+  if (pos == end) return std::string_view::npos;
+  return pos - body.data() + delimiter.size();
 }
 
 bool ParseMultipartFormDataValue(std::string_view& body,
-                                 std::string_view boundary,
+                                 std::string_view delimiter,
                                  FormDataArgInfo&& arg_info,
                                  std::optional<std::string>& charset,
-                                 FormDataArgs& form_data_args,
-                                 std::string_view crlf) {
+                                 FormDataArgs& form_data_args) {
   static const std::string kCharset = "_charset_";
 
   if (arg_info.arg.content_disposition.empty()) {
@@ -303,12 +293,12 @@ bool ParseMultipartFormDataValue(std::string_view& body,
     return false;
   }
 
-  size_t pos = FindBoundaryEnd(body, boundary, crlf);
+  size_t pos = FindBoundaryEnd(body, delimiter);
   if (pos == std::string_view::npos) {
     LOG_WARNING() << "Unexpected end of form-data part value";
     return false;
   }
-  arg_info.arg.value = body.substr(0, pos - boundary.size() - 2 - crlf.size());
+  arg_info.arg.value = body.substr(0, pos - delimiter.size());
   if (arg_info.name == kCharset) {
     charset = arg_info.arg.value;
   } else {
@@ -336,7 +326,7 @@ bool ParseMultipartFormDataBody(std::string_view body,
     while (!body.empty() && body.front() != kCr && body.front() != kLf)
       body.remove_prefix(1);
     if (!strict_cr_lf) crlf = AutoDetectCrLf(body, crlf);
-    size_t pos = FindBoundaryEnd(body, boundary, crlf);
+    size_t pos = FindBoundaryEnd(body, MakeDelimiter(boundary, crlf));
     if (pos == std::string_view::npos) {
       LOG_WARNING() << "Unexpected request body end";
       return false;
@@ -349,6 +339,7 @@ bool ParseMultipartFormDataBody(std::string_view body,
   if (!default_charset.empty()) charset = std::move(default_charset);
 
   LOG_TRACE() << "crlf=" << crlf;
+  const auto delimiter = MakeDelimiter(boundary, crlf);
 
   while (!body.empty()) {
     if (body.front() == '-') {
@@ -381,8 +372,8 @@ bool ParseMultipartFormDataBody(std::string_view body,
     if (!ParseMultipartFormDataHeaders(body, arg_info, crlf)) return false;
     LOG_TRACE() << "ParseMultipartFormDataHeaders finished, body=" << body
                 << ", body.size()=" << body.size();
-    if (!ParseMultipartFormDataValue(body, boundary, std::move(arg_info),
-                                     charset, form_data_args, crlf)) {
+    if (!ParseMultipartFormDataValue(body, delimiter, std::move(arg_info),
+                                     charset, form_data_args)) {
       return false;
     }
   }
@@ -390,25 +381,9 @@ bool ParseMultipartFormDataBody(std::string_view body,
   return false;
 }
 
-}  // namespace
-
-bool IsMultipartFormDataContentType(std::string_view content_type) {
-  if (!IEquals(content_type.substr(0, kMultipartFormData.size()),
-               kMultipartFormData))
-    return false;
-  if (content_type.size() == kMultipartFormData.size()) return true;
-  switch (content_type[kMultipartFormData.size()]) {
-    case ';':
-    case ' ':
-    case '\t':
-      return true;
-  }
-  return false;
-}
-
-bool ParseMultipartFormData(const std::string& content_type,
-                            std::string_view body, FormDataArgs& form_data_args,
-                            bool strict_cr_lf) {
+bool ParseMultipartFormDataContentType(std::string_view content_type,
+                                       std::string& boundary,
+                                       std::string& charset) {
   static const std::string kBoundary = "boundary";
   static const std::string kCharset = "charset";
   static const std::string kBoundaryNotFound =
@@ -422,8 +397,6 @@ bool ParseMultipartFormData(const std::string& content_type,
   unparsed.remove_prefix(kMultipartFormData.size());
   SkipOptionalSpaces(unparsed);
 
-  std::string boundary;
-  std::string charset;
   while (!unparsed.empty()) {
     if (!SkipSymbol(unparsed, ';')) return false;
     SkipOptionalSpaces(unparsed);
@@ -456,10 +429,62 @@ bool ParseMultipartFormData(const std::string& content_type,
     return false;
   }
 
+  return true;
+}
+
+}  // namespace
+
+bool IsMultipartFormDataContentType(std::string_view content_type) {
+  if (!IEquals(content_type.substr(0, kMultipartFormData.size()),
+               kMultipartFormData))
+    return false;
+  if (content_type.size() == kMultipartFormData.size()) return true;
+  switch (content_type[kMultipartFormData.size()]) {
+    case ';':
+    case ' ':
+    case '\t':
+      return true;
+  }
+  return false;
+}
+
+bool ParseMultipartFormData(const std::string& content_type,
+                            std::string_view body, FormDataArgs& form_data_args,
+                            bool strict_cr_lf) {
+  std::string boundary;
+  std::string charset;
+  if (!ParseMultipartFormDataContentType(content_type, boundary, charset)) {
+    return false;
+  }
+
   return ParseMultipartFormDataBody(body, boundary, std::move(charset),
                                     form_data_args, strict_cr_lf);
 }
 
+std::string ParseMultipartFormDataBoundary(std::string_view content_type) {
+  std::string boundary;
+  std::string charset;
+  if (!ParseMultipartFormDataContentType(content_type, boundary, charset)) {
+    return {};
+  }
+  return boundary;
+}
+
+bool ParseMultipartFormDataPartHeaders(std::string_view headers,
+                                       std::string& name, FormDataArg& arg) {
+  static constexpr std::string_view kCrLf = "\r\n";
+
+  FormDataArgInfo arg_info;
+  if (!ParseMultipartFormDataHeaders(headers, arg_info, kCrLf)) return false;
+  if (arg_info.arg.content_disposition.empty()) {
+    LOG_WARNING() << "Missing Content-Disposition header";
+    return false;
+  }
+  name = std::move(arg_info.name);
+  arg = std::move(arg_info.arg);
+  return true;
+}
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
@@ -22,6 +22,15 @@ bool ParseMultipartFormData(const std::string& content_type,
                             std::string_view body, FormDataArgs& form_data_args,
                             bool strict_cr_lf = false);
 
+// Returns the boundary of the multipart/form-data content type, an empty
+// string if the content type is not a valid multipart/form-data one
+std::string ParseMultipartFormDataBoundary(std::string_view content_type);
+
+// Parses the headers of a single part, that are terminated by an empty line.
+// The string views of the `arg` point into the `headers`.
+bool ParseMultipartFormDataPartHeaders(std::string_view headers,
+                                       std::string& name, FormDataArg& arg);
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
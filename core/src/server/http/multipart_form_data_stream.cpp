@@ -0,0 +1,242 @@
+#include <userver/server/http/multipart_form_data_stream.hpp>
+
+#include <algorithm>
+#include <utility>
+
+#include <userver/engine/async.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/server/http/form_data_arg.hpp>
+
+#include <server/http/multipart_form_data_parser.hpp>
+#include <utils/impl/byte_scan.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+constexpr std::string_view kCrLf = "\r\n";
+constexpr std::string_view kHeadersEnd = "\r\n\r\n";
+constexpr std::string_view kCloseDelimiterSuffix = "--";
+
+// Limits the memory used by the headers of a single part and by the
+// transport padding after the delimiter
+constexpr std::size_t kMaxHeadersSize = 64 * 1024;
+
+std::string MakeDelimiter(std::string_view content_type) {
+  auto boundary = ParseMultipartFormDataBoundary(content_type);
+  if (boundary.empty()) {
+    throw RequestBodyStreamException(
+        "Request body is not a multipart/form-data with a boundary");
+  }
+  return "\r\n--" + boundary;
+}
+
+}  // namespace
+
+MultipartFormDataStream::MultipartFormDataStream(std::string_view content_type,
+                                                 RequestBodyStream& body)
+    : body_(body),
+      delimiter_(MakeDelimiter(content_type)),
+      // The first delimiter may be at the very beginning of the body
+      buffer_(kCrLf) {}
+
+std::optional<MultipartFormDataStream::Part> MultipartFormDataStream::NextPart(
+    engine::Deadline deadline) {
+  ConsumePiece();
+  if (state_ == State::kFinished) return std::nullopt;
+  if (state_ != State::kAfterDelimiter) SkipBeforeDelimiter(deadline);
+  if (!ParseAfterDelimiter(deadline)) return std::nullopt;
+  return ParseHeaders(deadline);
+}
+
+bool MultipartFormDataStream::ReadPartChunk(std::string& chunk,
+                                            engine::Deadline deadline) {
+  std::string_view piece;
+  if (!ReadPartPiece(piece, deadline)) {
+    chunk.clear();
+    return false;
+  }
+  chunk.assign(piece);
+  return true;
+}
+
+bool MultipartFormDataStream::ReadPartPiece(std::string_view& piece,
+                                            engine::Deadline deadline) {
+  ConsumePiece();
+  piece = {};
+  if (state_ != State::kValue) return false;
+
+  while (true) {
+    const auto pos = FindDelimiter();
+    if (pos == 0) {
+      state_ = State::kAfterDelimiter;
+      return false;
+    }
+
+    // A tail shorter than the delimiter may be the beginning of it
+    const auto safe_size =
+        pos != std::string::npos
+            ? pos
+            : buffer_.size() - std::min(buffer_.size(), delimiter_.size() - 1);
+    if (safe_size != 0) {
+      piece = std::string_view{buffer_}.substr(0, safe_size);
+      piece_size_ = safe_size;
+      return true;
+    }
+
+    if (!ReadMore(deadline)) {
+      throw RequestBodyStreamException(
+          "Unexpected end of the multipart/form-data part value");
+    }
+  }
+}
+
+std::size_t MultipartFormDataStream::ReadPartToFile(
+    engine::TaskProcessor& fs_task_processor, const std::string& path,
+    engine::Deadline deadline) {
+  using fs::blocking::OpenFlag;
+
+  auto file = engine::AsyncNoSpan(fs_task_processor, [&path] {
+                return fs::blocking::FileDescriptor::Open(
+                    path, {OpenFlag::kWrite, OpenFlag::kCreateIfNotExists,
+                           OpenFlag::kAppend});
+              }).Get();
+
+  std::size_t written = 0;
+  std::string_view piece;
+  while (ReadPartPiece(piece, deadline)) {
+    engine::AsyncNoSpan(fs_task_processor, [&file, piece] {
+      file.Write(piece);
+    }).Get();
+    written += piece.size();
+  }
+
+  engine::AsyncNoSpan(fs_task_processor, [&file] {
+    std::move(file).Close();
+  }).Get();
+  return written;
+}
+
+void MultipartFormDataStream::ConsumePiece() {
+  buffer_.erase(0, std::exchange(piece_size_, 0));
+}
+
+std::size_t MultipartFormDataStream::FindDelimiter() const noexcept {
+  const char* const end = buffer_.data() + buffer_.size();
+  const char* const pos =
+      utils::impl::FindSubstring(buffer_.data(), end, delimiter_);
+  return pos == end ? std::string::npos : pos - buffer_.data();
+}
+
+bool MultipartFormDataStream::ReadMore(engine::Deadline deadline) {
+  if (!body_.ReadChunk(body_chunk_, deadline)) return false;
+  if (buffer_.empty()) {
+    buffer_.swap(body_chunk_);
+  } else {
+    buffer_ += body_chunk_;
+  }
+  return true;
+}
+
+void MultipartFormDataStream::ReadAtLeast(std::size_t size,
+                                          engine::Deadline deadline) {
+  while (buffer_.size() < size) {
+    if (!ReadMore(deadline)) {
+      throw RequestBodyStreamException(
+          "Unexpected end of the multipart/form-data body");
+    }
+  }
+}
+
+void MultipartFormDataStream::SkipBeforeDelimiter(engine::Deadline deadline) {
+  while (true) {
+    const auto pos = FindDelimiter();
+    if (pos != std::string::npos) {
+      buffer_.erase(0, pos);
+      state_ = State::kAfterDelimiter;
+      return;
+    }
+
+    const auto tail_size = std::min(buffer_.size(), delimiter_.size() - 1);
+    buffer_.erase(0, buffer_.size() - tail_size);
+    if (!ReadMore(deadline)) {
+      throw RequestBodyStreamException(
+          "Multipart/form-data body has no closing delimiter");
+    }
+  }
+}
+
+bool MultipartFormDataStream::ParseAfterDelimiter(engine::Deadline deadline) {
+  auto pos = delimiter_.size();
+  ReadAtLeast(pos + kCloseDelimiterSuffix.size(), deadline);
+  if (std::string_view{buffer_}.substr(pos, kCloseDelimiterSuffix.size()) ==
+      kCloseDelimiterSuffix) {
+    // The epilogue is ignored
+    state_ = State::kFinished;
+    buffer_.clear();
+    return false;
+  }
+
+  // Skip the transport padding
+  while (true) {
+    ReadAtLeast(pos + kCrLf.size(), deadline);
+    if (buffer_[pos] != ' ' && buffer_[pos] != '\t') break;
+    if (++pos > kMaxHeadersSize) {
+      throw RequestBodyStreamException(
+          "Too long padding after the multipart/form-data delimiter");
+    }
+  }
+  if (std::string_view{buffer_}.substr(pos, kCrLf.size()) != kCrLf) {
+    throw RequestBodyStreamException(
+        "Malformed multipart/form-data delimiter line");
+  }
+
+  // Keep the CRLF, so the headers of a part without headers are found by
+  // kHeadersEnd from the beginning of the buffer
+  buffer_.erase(0, pos);
+  return true;
+}
+
+MultipartFormDataStream::Part MultipartFormDataStream::ParseHeaders(
+    engine::Deadline deadline) {
+  auto end = buffer_.find(kHeadersEnd);
+  while (end == std::string::npos) {
+    if (buffer_.size() > kMaxHeadersSize) {
+      throw RequestBodyStreamException(
+          "Too large headers of the multipart/form-data part");
+    }
+    const auto searched =
+        buffer_.size() - std::min(buffer_.size(), kHeadersEnd.size() - 1);
+    ReadAtLeast(buffer_.size() + 1, deadline);
+    end = buffer_.find(kHeadersEnd, searched);
+  }
+
+  // Headers start after the CRLF of the delimiter line and include the
+  // terminating empty line
+  const auto headers = std::string_view{buffer_}.substr(
+      kCrLf.size(), end - kCrLf.size() + kHeadersEnd.size());
+  std::string name;
+  FormDataArg arg;
+  if (!ParseMultipartFormDataPartHeaders(headers, name, arg)) {
+    throw RequestBodyStreamException(
+        "Malformed headers of the multipart/form-data part");
+  }
+
+  Part part;
+  part.name = std::move(name);
+  part.content_disposition = std::string{arg.content_disposition};
+  part.filename = std::move(arg.filename);
+  if (arg.content_type) part.content_type.emplace(*arg.content_type);
+
+  // The value starts right after the headers, the CRLF before the next
+  // delimiter is a part of the delimiter
+  buffer_.erase(0, end + kHeadersEnd.size());
+  state_ = State::kValue;
+  return part;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
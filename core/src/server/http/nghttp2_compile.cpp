@@ -1 +0,0 @@
-#include <nghttp2/nghttp2.h>
@@ -0,0 +1,60 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <server/http/perfect_hash_index.hpp>
+#include <server/http/wildcard_path_index.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::vector<std::string> MakePaths(std::int64_t count) {
+  std::vector<std::string> paths;
+  paths.reserve(count);
+  for (std::int64_t i = 0; i < count; ++i) {
+    paths.push_back(fmt::format("/v{}/some-service/handler-{}", i % 4, i));
+  }
+  return paths;
+}
+
+void http_fixed_path_perfect_hash(benchmark::State& state) {
+  const auto paths = MakePaths(state.range(0));
+  const server::http::impl::PerfectHashIndex index{paths};
+
+  std::size_t i = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(index.Find(paths[i]));
+    if (++i == paths.size()) i = 0;
+  }
+}
+BENCHMARK(http_fixed_path_perfect_hash)->Arg(16)->Arg(400)->Arg(4000);
+
+void http_fixed_path_unordered_map(benchmark::State& state) {
+  const auto paths = MakePaths(state.range(0));
+  std::unordered_map<std::string, std::size_t> index;
+  for (std::size_t i = 0; i < paths.size(); ++i) index.emplace(paths[i], i);
+
+  std::size_t i = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(index.find(paths[i]));
+    if (++i == paths.size()) i = 0;
+  }
+}
+BENCHMARK(http_fixed_path_unordered_map)->Arg(16)->Arg(400)->Arg(4000);
+
+void http_wildcard_split_path(benchmark::State& state) {
+  const std::string path = "/v1/some-service/users/12345/orders/67890/items";
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(server::http::impl::SplitPath(path));
+  }
+}
+BENCHMARK(http_wildcard_split_path);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,148 @@
+#include <server/http/perfect_hash_index.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+namespace {
+
+constexpr std::uint32_t kMaxDisplacement = 1 << 16;
+constexpr std::size_t kMaxBuildAttempts = 8;
+
+constexpr std::uint64_t Mix(std::uint64_t value) noexcept {
+  // splitmix64 finalizer
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31;
+  return value;
+}
+
+std::size_t RoundUpToPowerOfTwo(std::size_t value) noexcept {
+  std::size_t result = 1;
+  while (result < value) result <<= 1;
+  return result;
+}
+
+std::size_t HashKey(std::string_view key) noexcept {
+  return std::hash<std::string_view>{}(key);
+}
+
+}  // namespace
+
+PerfectHashIndex::PerfectHashIndex(std::vector<std::string> keys)
+    : keys_(std::move(keys)) {
+  if (keys_.empty()) return;
+
+  std::vector<std::size_t> hashes;
+  hashes.reserve(keys_.size());
+  for (const auto& key : keys_) hashes.push_back(HashKey(key));
+
+  // Keys with equal hashes can not be separated by a displacement
+  std::vector<std::size_t> order(keys_.size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::sort(order.begin(), order.end(), [&hashes](auto lhs, auto rhs) {
+    return hashes[lhs] < hashes[rhs];
+  });
+  for (std::size_t i = 1; i < order.size(); ++i) {
+    if (hashes[order[i - 1]] != hashes[order[i]]) continue;
+    const auto& lhs = keys_[order[i - 1]];
+    const auto& rhs = keys_[order[i]];
+    if (lhs == rhs) {
+      throw std::runtime_error(fmt::format("duplicate key '{}'", lhs));
+    }
+    throw std::runtime_error(
+        fmt::format("hash collision of keys '{}' and '{}'", lhs, rhs));
+  }
+
+  auto slots_count = RoundUpToPowerOfTwo(keys_.size() * 2);
+  const auto buckets_count = RoundUpToPowerOfTwo(keys_.size() / 2);
+  for (std::size_t attempt = 0; attempt < kMaxBuildAttempts; ++attempt) {
+    slots_.assign(slots_count, Slot{});
+    displacements_.assign(buckets_count, 0);
+    if (TryBuild(hashes)) return;
+    slots_count *= 2;
+  }
+  throw std::runtime_error(fmt::format(
+      "failed to build a perfect hash index for {} keys", keys_.size()));
+}
+
+std::size_t PerfectHashIndex::Find(std::string_view key) const noexcept {
+  if (slots_.empty()) return kNotFound;
+
+  const auto hash = HashKey(key);
+  const auto& slot = slots_[GetSlot(hash, displacements_[GetBucket(hash)])];
+  if (slot.index == kNotFound || slot.hash != hash ||
+      keys_[slot.index] != key) {
+    return kNotFound;
+  }
+  return slot.index;
+}
+
+bool PerfectHashIndex::TryBuild(const std::vector<std::size_t>& hashes) {
+  std::vector<std::vector<std::size_t>> buckets(displacements_.size());
+  for (std::size_t i = 0; i < hashes.size(); ++i) {
+    buckets[GetBucket(hashes[i])].push_back(i);
+  }
+
+  // Placing the largest buckets first while most of the slots are free
+  std::vector<std::size_t> order(buckets.size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::stable_sort(order.begin(), order.end(), [&buckets](auto lhs, auto rhs) {
+    return buckets[lhs].size() > buckets[rhs].size();
+  });
+
+  std::vector<std::size_t> candidate_slots;
+  for (const auto bucket_index : order) {
+    const auto& bucket = buckets[bucket_index];
+    if (bucket.empty()) break;
+
+    bool is_placed = false;
+    for (std::uint32_t displacement = 0; displacement < kMaxDisplacement;
+         ++displacement) {
+      candidate_slots.clear();
+      for (const auto key_index : bucket) {
+        const auto slot = GetSlot(hashes[key_index], displacement);
+        if (slots_[slot].index != kNotFound ||
+            std::find(candidate_slots.begin(), candidate_slots.end(), slot) !=
+                candidate_slots.end()) {
+          break;
+        }
+        candidate_slots.push_back(slot);
+      }
+      if (candidate_slots.size() != bucket.size()) continue;
+
+      for (std::size_t i = 0; i < bucket.size(); ++i) {
+        slots_[candidate_slots[i]] = Slot{hashes[bucket[i]], bucket[i]};
+      }
+      displacements_[bucket_index] = displacement;
+      is_placed = true;
+      break;
+    }
+    if (!is_placed) return false;
+  }
+  return true;
+}
+
+std::size_t PerfectHashIndex::GetBucket(std::size_t hash) const noexcept {
+  // High bits, the low ones select the slot
+  return (Mix(hash) >> 32) & (displacements_.size() - 1);
+}
+
+std::size_t PerfectHashIndex::GetSlot(
+    std::size_t hash, std::uint32_t displacement) const noexcept {
+  return Mix(hash ^ (displacement * 0x9e3779b97f4a7c15ULL)) &
+         (slots_.size() - 1);
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// @brief Collision-free hash table for a fixed set of strings.
+///
+/// Keys are spread over the slots with a per-bucket displacement chosen at
+/// construction (hash and displace), so a lookup hashes the key once and
+/// compares it with a single candidate.
+class PerfectHashIndex final {
+ public:
+  static constexpr std::size_t kNotFound =
+      std::numeric_limits<std::size_t>::max();
+
+  PerfectHashIndex() = default;
+
+  /// @throws std::runtime_error on duplicate keys
+  explicit PerfectHashIndex(std::vector<std::string> keys);
+
+  /// Returns the position of `key` in the constructor argument or kNotFound
+  std::size_t Find(std::string_view key) const noexcept;
+
+  std::size_t Size() const noexcept { return keys_.size(); }
+
+ private:
+  struct Slot final {
+    std::size_t hash{0};
+    std::size_t index{kNotFound};
+  };
+
+  bool TryBuild(const std::vector<std::size_t>& hashes);
+  std::size_t GetBucket(std::size_t hash) const noexcept;
+  std::size_t GetSlot(std::size_t hash,
+                      std::uint32_t displacement) const noexcept;
+
+  std::vector<std::string> keys_;
+  std::vector<std::uint32_t> displacements_;
+  std::vector<Slot> slots_;
+};
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
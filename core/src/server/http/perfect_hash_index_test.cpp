@@ -0,0 +1,41 @@
+#include <server/http/perfect_hash_index.hpp>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+using server::http::impl::PerfectHashIndex;
+
+TEST(PerfectHashIndex, Empty) {
+  const PerfectHashIndex index;
+  EXPECT_EQ(index.Find(""), PerfectHashIndex::kNotFound);
+  EXPECT_EQ(index.Find("/ping"), PerfectHashIndex::kNotFound);
+
+  const PerfectHashIndex empty_index{{}};
+  EXPECT_EQ(empty_index.Find("/ping"), PerfectHashIndex::kNotFound);
+}
+
+TEST(PerfectHashIndex, Find) {
+  std::vector<std::string> keys;
+  for (int i = 0; i < 1000; ++i) {
+    keys.push_back(fmt::format("/v1/service/handler-{}", i));
+  }
+  keys.emplace_back();
+  const PerfectHashIndex index{keys};
+  ASSERT_EQ(index.Size(), keys.size());
+
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    EXPECT_EQ(index.Find(keys[i]), i) << keys[i];
+  }
+  EXPECT_EQ(index.Find("/v1/service/handler-1000"),
+            PerfectHashIndex::kNotFound);
+  EXPECT_EQ(index.Find("/v1/service/handler-"), PerfectHashIndex::kNotFound);
+  EXPECT_EQ(index.Find("/v1/service/handler-1/"), PerfectHashIndex::kNotFound);
+}
+
+TEST(PerfectHashIndex, Duplicate) {
+  EXPECT_THROW(PerfectHashIndex({"/a", "/b", "/a"}), std::runtime_error);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+
+#include <userver/server/http/http_request_body_stream.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+// Pushes the body of a streamed request into the RequestBodyStream of the
+// handler, used by the socket reading task
+class RequestBodyProducer final {
+ public:
+  // Bytes of the body that may be received ahead of the handler
+  static constexpr std::size_t kQueueSize = 256 * 1024;
+
+  explicit RequestBodyProducer(RequestBodyStream::Queue::Producer&& producer);
+
+  // Waits for the handler to read the previous chunks if the queue is full.
+  // Returns false if the handler does not read the body anymore or the task is
+  // cancelled, the rest of the body should be skipped.
+  bool Push(std::string_view data);
+
+  // Marks the end of the body, without it the stream reports the body as
+  // truncated
+  void Finish();
+
+ private:
+  RequestBodyStream::Queue::Producer producer_;
+};
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
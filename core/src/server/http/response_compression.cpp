@@ -0,0 +1,212 @@
+#include <server/http/response_compression.hpp>
+
+#include <algorithm>
+
+#include <fmt/format.h>
+
+#include <compression/brotli.hpp>
+#include <compression/gzip.hpp>
+#include <compression/zstd.hpp>
+#include <server/handlers/http_handler_base_statistics.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/server/http/http_response.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+constexpr int kMaxQValue = 1000;
+
+std::string_view Trim(std::string_view str) noexcept {
+  constexpr std::string_view kWhitespace = " \t";
+  const auto begin = str.find_first_not_of(kWhitespace);
+  if (begin == std::string_view::npos) return {};
+  const auto end = str.find_last_not_of(kWhitespace);
+  return str.substr(begin, end - begin + 1);
+}
+
+// Returns q-value in thousandths or -1 for a malformed value
+int ParseQValue(std::string_view value) noexcept {
+  if (value.empty() || value.size() > 5) return -1;
+  if (value[0] != '0' && value[0] != '1') return -1;
+  int result = (value[0] - '0') * kMaxQValue;
+  if (value.size() == 1) return result;
+  if (value[1] != '.') return -1;
+
+  int multiplier = kMaxQValue / 10;
+  for (const char c : value.substr(2)) {
+    if (c < '0' || c > '9') return -1;
+    result += (c - '0') * multiplier;
+    multiplier /= 10;
+  }
+  return result <= kMaxQValue ? result : -1;
+}
+
+struct ContentCoding {
+  std::string_view name;
+  int q_value{kMaxQValue};
+};
+
+// Returns std::nullopt for a malformed list item
+std::optional<ContentCoding> ParseContentCoding(std::string_view item) {
+  ContentCoding result;
+  auto params_pos = item.find(';');
+  result.name = Trim(item.substr(0, params_pos));
+  if (result.name.empty()) return std::nullopt;
+
+  while (params_pos != std::string_view::npos) {
+    item = item.substr(params_pos + 1);
+    params_pos = item.find(';');
+    const auto param = Trim(item.substr(0, params_pos));
+    const auto eq_pos = param.find('=');
+    if (eq_pos != std::string_view::npos &&
+        utils::StrIcaseEqual{}(Trim(param.substr(0, eq_pos)), "q")) {
+      result.q_value = ParseQValue(Trim(param.substr(eq_pos + 1)));
+      if (result.q_value < 0) return std::nullopt;
+    }
+  }
+  return result;
+}
+
+bool IsSameCoding(std::string_view name, handlers::ResponseEncoding encoding) {
+  const utils::StrIcaseEqual icase_equal{};
+  if (icase_equal(name, ToContentCoding(encoding))) return true;
+  return encoding == handlers::ResponseEncoding::kGzip &&
+         icase_equal(name, "x-gzip");
+}
+
+}  // namespace
+
+std::string_view ToContentCoding(handlers::ResponseEncoding encoding) noexcept {
+  switch (encoding) {
+    case handlers::ResponseEncoding::kGzip:
+      return "gzip";
+    case handlers::ResponseEncoding::kZstd:
+      return "zstd";
+    case handlers::ResponseEncoding::kBrotli:
+      return "br";
+  }
+
+  UINVARIANT(false, "Unexpected response encoding");
+}
+
+std::optional<handlers::ResponseEncoding> NegotiateResponseEncoding(
+    std::string_view accept_encoding,
+    const std::vector<handlers::ResponseEncoding>& encodings) {
+  if (accept_encoding.empty() || encodings.empty()) return std::nullopt;
+
+  // -1 for the codings absent from the header
+  std::vector<int> q_values(encodings.size(), -1);
+  int wildcard_q_value = -1;
+
+  std::size_t pos = 0;
+  while (pos <= accept_encoding.size()) {
+    auto end = accept_encoding.find(',', pos);
+    if (end == std::string_view::npos) end = accept_encoding.size();
+    const auto coding =
+        ParseContentCoding(accept_encoding.substr(pos, end - pos));
+    pos = end + 1;
+    if (!coding) continue;
+
+    if (coding->name == "*") {
+      wildcard_q_value = std::max(wildcard_q_value, coding->q_value);
+      continue;
+    }
+    for (std::size_t i = 0; i < encodings.size(); ++i) {
+      if (IsSameCoding(coding->name, encodings[i])) {
+        q_values[i] = std::max(q_values[i], coding->q_value);
+      }
+    }
+  }
+
+  std::optional<handlers::ResponseEncoding> result;
+  int best_q_value = 0;
+  for (std::size_t i = 0; i < encodings.size(); ++i) {
+    const auto q_value = q_values[i] >= 0 ? q_values[i] : wildcard_q_value;
+    if (q_value > best_q_value) {
+      best_q_value = q_value;
+      result = encodings[i];
+    }
+  }
+  return result;
+}
+
+void SetResponseContentEncoding(HttpResponse& response,
+                                handlers::ResponseEncoding encoding) {
+  namespace headers = USERVER_NAMESPACE::http::headers;
+
+  response.SetHeader(headers::kContentEncoding,
+                     std::string{ToContentCoding(encoding)});
+
+  if (!response.HasHeader(headers::kVary)) {
+    response.SetHeader(headers::kVary, std::string{headers::kAcceptEncoding});
+    return;
+  }
+  const auto& vary = response.GetHeader(headers::kVary);
+  const std::string_view accept_encoding = headers::kAcceptEncoding;
+  if (vary.find(accept_encoding) == std::string::npos) {
+    response.SetHeader(headers::kVary,
+                       fmt::format("{}, {}", vary, accept_encoding));
+  }
+}
+
+std::unique_ptr<compression::StreamCompressor> MakeResponseCompressor(
+    handlers::ResponseEncoding encoding,
+    const handlers::ResponseCompressionConfig& config) {
+  switch (encoding) {
+    case handlers::ResponseEncoding::kGzip:
+      return compression::gzip::MakeStreamCompressor(config.gzip_level);
+    case handlers::ResponseEncoding::kZstd:
+      return compression::zstd::MakeStreamCompressor(config.zstd_level);
+    case handlers::ResponseEncoding::kBrotli:
+      return compression::brotli::MakeStreamCompressor(config.brotli_level);
+  }
+
+  UINVARIANT(false, "Unexpected response encoding");
+}
+
+namespace impl {
+
+ResponseStreamCompressor::ResponseStreamCompressor(
+    handlers::ResponseEncoding encoding,
+    const handlers::ResponseCompressionConfig& config,
+    handlers::HttpHandlerMethodStatistics& statistics)
+    : encoding_(encoding),
+      compressor_(MakeResponseCompressor(encoding, config)),
+      statistics_(statistics) {}
+
+ResponseStreamCompressor::~ResponseStreamCompressor() {
+  if (output_size_ == 0) return;
+  statistics_.AccountCompression(input_size_, output_size_, compression_time_);
+}
+
+std::string ResponseStreamCompressor::Compress(std::string_view chunk) {
+  const auto start = std::chrono::steady_clock::now();
+  std::string result;
+  compressor_->Compress(chunk, result);
+  compression_time_ += std::chrono::steady_clock::now() - start;
+
+  input_size_ += chunk.size();
+  output_size_ += result.size();
+  return result;
+}
+
+std::string ResponseStreamCompressor::Finish() {
+  const auto start = std::chrono::steady_clock::now();
+  std::string result;
+  compressor_->Finish({}, result);
+  compression_time_ += std::chrono::steady_clock::now() - start;
+
+  output_size_ += result.size();
+  return result;
+}
+
+}  // namespace impl
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
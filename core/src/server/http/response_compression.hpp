@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <compression/stream_compressor.hpp>
+#include <userver/server/handlers/handler_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+class HttpHandlerMethodStatistics;
+}  // namespace server::handlers
+
+namespace server::http {
+
+class HttpResponse;
+
+/// @returns the name of the content coding for Content-Encoding header
+std::string_view ToContentCoding(handlers::ResponseEncoding encoding) noexcept;
+
+/// @brief Picks the content coding with the highest q-value in `Accept-Encoding`
+/// request header.
+///
+/// Ties are resolved by the order of `encodings`.
+/// @returns std::nullopt if none of `encodings` is acceptable
+std::optional<handlers::ResponseEncoding> NegotiateResponseEncoding(
+    std::string_view accept_encoding,
+    const std::vector<handlers::ResponseEncoding>& encodings);
+
+/// Sets `Content-Encoding` and adds `Accept-Encoding` to `Vary` response
+/// header
+void SetResponseContentEncoding(HttpResponse& response,
+                                handlers::ResponseEncoding encoding);
+
+/// @throws compression::CompressionError on invalid level in config
+std::unique_ptr<compression::StreamCompressor> MakeResponseCompressor(
+    handlers::ResponseEncoding encoding,
+    const handlers::ResponseCompressionConfig& config);
+
+namespace impl {
+
+/// Compresses the chunks of a ResponseBodyStream and reports the totals into
+/// the handler statistics on destruction
+class ResponseStreamCompressor final {
+ public:
+  ResponseStreamCompressor(
+      handlers::ResponseEncoding encoding,
+      const handlers::ResponseCompressionConfig& config,
+      handlers::HttpHandlerMethodStatistics& statistics);
+
+  ResponseStreamCompressor(const ResponseStreamCompressor&) = delete;
+  ResponseStreamCompressor& operator=(const ResponseStreamCompressor&) = delete;
+  ~ResponseStreamCompressor();
+
+  handlers::ResponseEncoding GetEncoding() const noexcept { return encoding_; }
+
+  std::string Compress(std::string_view chunk);
+  std::string Finish();
+
+ private:
+  const handlers::ResponseEncoding encoding_;
+  const std::unique_ptr<compression::StreamCompressor> compressor_;
+  handlers::HttpHandlerMethodStatistics& statistics_;
+  std::size_t input_size_{0};
+  std::size_t output_size_{0};
+  std::chrono::steady_clock::duration compression_time_{};
+};
+
+}  // namespace impl
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
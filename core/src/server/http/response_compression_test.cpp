@@ -0,0 +1,76 @@
+#include <server/http/response_compression.hpp>
+
+#include <gtest/gtest.h>
+
+#include <compression/error.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::handlers::ResponseEncoding;
+using server::http::NegotiateResponseEncoding;
+
+const std::vector<ResponseEncoding> kEncodings{
+    ResponseEncoding::kZstd, ResponseEncoding::kBrotli, ResponseEncoding::kGzip};
+
+}  // namespace
+
+TEST(ResponseCompression, Negotiate) {
+  EXPECT_EQ(NegotiateResponseEncoding("", kEncodings), std::nullopt);
+  EXPECT_EQ(NegotiateResponseEncoding("identity", kEncodings), std::nullopt);
+  EXPECT_EQ(NegotiateResponseEncoding("gzip", kEncodings),
+            ResponseEncoding::kGzip);
+  EXPECT_EQ(NegotiateResponseEncoding("x-gzip", kEncodings),
+            ResponseEncoding::kGzip);
+  EXPECT_EQ(NegotiateResponseEncoding("GZIP, deflate", kEncodings),
+            ResponseEncoding::kGzip);
+
+  // Ties are resolved by the server preference
+  EXPECT_EQ(NegotiateResponseEncoding("gzip, deflate, br, zstd", kEncodings),
+            ResponseEncoding::kZstd);
+  EXPECT_EQ(NegotiateResponseEncoding("gzip, br", kEncodings),
+            ResponseEncoding::kBrotli);
+  EXPECT_EQ(NegotiateResponseEncoding("zstd, gzip",
+                                      {ResponseEncoding::kGzip,
+                                       ResponseEncoding::kZstd}),
+            ResponseEncoding::kGzip);
+}
+
+TEST(ResponseCompression, NegotiateQValues) {
+  EXPECT_EQ(NegotiateResponseEncoding("zstd;q=0.5, gzip", kEncodings),
+            ResponseEncoding::kGzip);
+  EXPECT_EQ(NegotiateResponseEncoding("zstd; q=0.5 , br;q=0.8", kEncodings),
+            ResponseEncoding::kBrotli);
+  EXPECT_EQ(NegotiateResponseEncoding("gzip;q=0", kEncodings), std::nullopt);
+  EXPECT_EQ(NegotiateResponseEncoding("gzip;q=1.000", kEncodings),
+            ResponseEncoding::kGzip);
+
+  // Malformed items are ignored
+  EXPECT_EQ(NegotiateResponseEncoding("zstd;q=2, gzip;q=0.1", kEncodings),
+            ResponseEncoding::kGzip);
+  EXPECT_EQ(NegotiateResponseEncoding("zstd;q=abc, , ;q=1", kEncodings),
+            std::nullopt);
+}
+
+TEST(ResponseCompression, NegotiateWildcard) {
+  EXPECT_EQ(NegotiateResponseEncoding("*", kEncodings),
+            ResponseEncoding::kZstd);
+  EXPECT_EQ(NegotiateResponseEncoding("zstd;q=0, *", kEncodings),
+            ResponseEncoding::kBrotli);
+  EXPECT_EQ(NegotiateResponseEncoding("*;q=0.1, gzip", kEncodings),
+            ResponseEncoding::kGzip);
+  EXPECT_EQ(NegotiateResponseEncoding("*;q=0", kEncodings), std::nullopt);
+}
+
+TEST(ResponseCompression, InvalidLevel) {
+  server::handlers::ResponseCompressionConfig config;
+  config.zstd_level = 100;
+  EXPECT_THROW(
+      server::http::MakeResponseCompressor(ResponseEncoding::kZstd, config),
+      compression::CompressionError);
+  EXPECT_NO_THROW(
+      server::http::MakeResponseCompressor(ResponseEncoding::kGzip, config));
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,27 @@
+#include <server/http/throttling_cost.hpp>
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+std::size_t GetThrottlingCost(const handlers::HandlerConfig& config,
+                              std::size_t body_size) noexcept {
+  auto cost = config.throttling_cost;
+  if (config.throttling_body_bytes_per_cost) {
+    cost += body_size / config.throttling_body_bytes_per_cost.value();
+  }
+  return cost;
+}
+
+bool ObtainThrottlingCost(utils::TokenBucket& rate_limit, std::size_t cost) {
+  if (cost > 1) {
+    cost = std::clamp<std::size_t>(rate_limit.GetMaxSizeApprox(), 1, cost);
+  }
+  return rate_limit.ObtainAll(cost);
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+
+#include <userver/server/handlers/handler_config.hpp>
+#include <userver/utils/token_bucket.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// Number of the RPS limiter tokens a request with `body_size` bytes of body
+/// takes for a handler with `config`
+std::size_t GetThrottlingCost(const handlers::HandlerConfig& config,
+                              std::size_t body_size) noexcept;
+
+/// Obtains `cost` tokens from the RPS limiter. A request costing more than
+/// the whole bucket takes all of it, but at least one token so that zero RPS
+/// limit still rejects everything.
+bool ObtainThrottlingCost(utils::TokenBucket& rate_limit, std::size_t cost);
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,61 @@
+#include <server/http/throttling_cost.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// No refills, so that the tests do not depend on time
+utils::TokenBucket MakeBucket(std::size_t max_size) {
+  return utils::TokenBucket{max_size, {0, utils::TokenBucket::Duration{1}}};
+}
+
+}  // namespace
+
+TEST(ThrottlingCost, Cost) {
+  server::handlers::HandlerConfig config;
+  EXPECT_EQ(server::http::GetThrottlingCost(config, 0), 1);
+  EXPECT_EQ(server::http::GetThrottlingCost(config, 100500), 1);
+
+  config.throttling_cost = 3;
+  EXPECT_EQ(server::http::GetThrottlingCost(config, 100500), 3);
+
+  config.throttling_body_bytes_per_cost = 1000;
+  EXPECT_EQ(server::http::GetThrottlingCost(config, 0), 3);
+  EXPECT_EQ(server::http::GetThrottlingCost(config, 999), 3);
+  EXPECT_EQ(server::http::GetThrottlingCost(config, 1000), 4);
+  EXPECT_EQ(server::http::GetThrottlingCost(config, 2500), 5);
+}
+
+TEST(ThrottlingCost, PartiallyFullBucket) {
+  auto bucket = MakeBucket(10);
+  EXPECT_TRUE(server::http::ObtainThrottlingCost(bucket, 4));
+  EXPECT_TRUE(server::http::ObtainThrottlingCost(bucket, 4));
+
+  // 2 tokens left
+  EXPECT_FALSE(server::http::ObtainThrottlingCost(bucket, 3));
+  EXPECT_TRUE(server::http::ObtainThrottlingCost(bucket, 2));
+  EXPECT_FALSE(server::http::ObtainThrottlingCost(bucket, 1));
+}
+
+TEST(ThrottlingCost, CostAboveBucketSize) {
+  auto bucket = MakeBucket(5);
+  EXPECT_TRUE(server::http::ObtainThrottlingCost(bucket, 100));
+  EXPECT_FALSE(server::http::ObtainThrottlingCost(bucket, 100));
+  EXPECT_FALSE(server::http::ObtainThrottlingCost(bucket, 1));
+
+  // Takes the whole bucket, so it is rejected while the bucket is not full
+  auto partial_bucket = MakeBucket(5);
+  EXPECT_TRUE(server::http::ObtainThrottlingCost(partial_bucket, 1));
+  EXPECT_FALSE(server::http::ObtainThrottlingCost(partial_bucket, 100));
+  EXPECT_TRUE(server::http::ObtainThrottlingCost(partial_bucket, 4));
+}
+
+TEST(ThrottlingCost, ZeroLimit) {
+  auto bucket = MakeBucket(0);
+  EXPECT_FALSE(server::http::ObtainThrottlingCost(bucket, 1));
+  EXPECT_FALSE(server::http::ObtainThrottlingCost(bucket, 100));
+}
+
+USERVER_NAMESPACE_END
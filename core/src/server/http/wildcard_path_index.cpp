@@ -9,7 +9,7 @@ USERVER_NAMESPACE_BEGIN
 namespace server::http::impl {
 namespace {
 
-const std::string kAnySuffixMark{"*"};
+constexpr std::string_view kAnySuffixMark{"*"};
 
 constexpr char kWildcardStart = '{';
 constexpr char kWildcardFinish = '}';
@@ -31,7 +31,7 @@ std::string ExtractWildcardName(const std::string& str) {
 
 bool GetFromHandlerMethodIndex(const WildcardPathIndex::Node& node,
                                HttpMethod method,
-                               const std::vector<std::string>& path,
+                               const PathSegments& path,
                                MatchRequestResult& match_result,
                                bool limit_path_length) {
   const auto& index_map = node.handler_method_index_map;
@@ -60,7 +60,8 @@ bool GetFromHandlerMethodIndex(const WildcardPathIndex::Node& node,
           "matched path from handler has length greater than path from "
           "request");
     match_result.args_from_path.emplace_back(
-        arg.name, arg.index == path.size() ? std::string{} : path[arg.index]);
+        arg.name, arg.index == path.size() ? std::string_view{}
+                                           : path[arg.index]);
   }
   match_result.status = MatchRequestResult::Status::kOk;
   return true;
@@ -73,6 +74,20 @@ bool HasWildcardSpecificSymbols(const std::string& path) {
          path.find(kWildcardFinish) != std::string::npos;
 }
 
+PathSegments SplitPath(std::string_view path) {
+  PathSegments segments;
+  std::size_t pos = 0;
+  while (true) {
+    const auto slash_pos = path.find('/', pos);
+    if (slash_pos == std::string_view::npos) {
+      segments.push_back(path.substr(pos));
+      return segments;
+    }
+    segments.push_back(path.substr(pos, slash_pos - pos));
+    pos = slash_pos + 1;
+  }
+}
+
 void WildcardPathIndex::AddHandler(const handlers::HttpHandlerBase& handler,
                                    engine::TaskProcessor& task_processor) {
   const auto& path = std::get<std::string>(handler.GetConfig().path);
@@ -108,7 +123,7 @@ void WildcardPathIndex::AddHandler(const handlers::HttpHandlerBase& handler,
 
 bool WildcardPathIndex::MatchRequest(HttpMethod method, const std::string& path,
                                      MatchRequestResult& match_result) const {
-  return MatchRequest(root_, method, SplitBySlash(path), path.size(),
+  return MatchRequest(root_, method, SplitPath(path), path.size(),
                       match_result);
 }
 
@@ -151,7 +166,7 @@ void WildcardPathIndex::AddPath(const handlers::HttpHandlerBase& handler,
 }
 
 bool WildcardPathIndex::MatchRequest(const Node& node, HttpMethod method,
-                                     const std::vector<std::string>& path,
+                                     const PathSegments& path,
                                      size_t path_string_length,
                                      MatchRequestResult& match_result) const {
   for (const auto& next_item : node.next) {
@@ -184,7 +199,8 @@ bool WildcardPathIndex::MatchRequest(const Node& node, HttpMethod method,
           match_result.matched_path_length += path[i].size();
         }
         for (size_t i = asterisk_pos; i < path.size(); i++) {
-          match_result.args_from_path.emplace_back(std::string{}, path[i]);
+          match_result.args_from_path.emplace_back(std::string{},
+                                                   std::string{path[i]});
         }
         return true;
       }
@@ -2,9 +2,12 @@
 
 #include <map>
 #include <string>
+#include <string_view>
 #include <unordered_set>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include <userver/engine/task/task_processor_fwd.hpp>
 
 #include <server/http/handler_info_index.hpp>
@@ -18,11 +21,16 @@ namespace server::http::impl {
 
 bool HasWildcardSpecificSymbols(const std::string& path);
 
+/// Request path split by '/', views into the path
+using PathSegments = boost::container::small_vector<std::string_view, 16>;
+
+PathSegments SplitPath(std::string_view path);
+
 class WildcardPathIndex final {
  public:
   struct Node {
     // ordered by position in path
-    std::map<size_t, std::map<std::string, Node>> next;
+    std::map<size_t, std::map<std::string, Node, std::less<>>> next;
 
     // by path length
     std::map<size_t, HandlerMethodIndex> handler_method_index_map;
@@ -45,7 +53,7 @@ class WildcardPathIndex final {
                std::vector<PathItem> wildcards);
 
   bool MatchRequest(const Node& node, HttpMethod method,
-                    const std::vector<std::string>& path,
+                    const PathSegments& path,
                     size_t path_string_length,
                     MatchRequestResult& match_result) const;
 
@@ -0,0 +1,96 @@
+#include <server/net/buffered_writer.hpp>
+
+#include <utility>
+
+#include <boost/container/small_vector.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+namespace {
+
+constexpr std::size_t kTypicalIoDataCount = 8;
+
+}  // namespace
+
+BufferedWriter::BufferedWriter(engine::io::RwBase& socket, std::size_t capacity)
+    : socket_(socket), capacity_(capacity) {}
+
+BufferedWriter::~BufferedWriter() {
+  UASSERT_MSG(buffer_.empty(), "BufferedWriter destroyed without a Flush()");
+}
+
+void BufferedWriter::Flush(engine::Deadline deadline) {
+  if (buffer_.empty()) return;
+  // Buffer is cleared even if the write fails, the connection is broken anyway
+  const std::string buffer = std::exchange(buffer_, {});
+  [[maybe_unused]] const auto sent_bytes =
+      socket_.WriteAll(buffer.data(), buffer.size(), deadline);
+}
+
+bool BufferedWriter::IsValid() const { return socket_.IsValid(); }
+
+bool BufferedWriter::WaitReadable(engine::Deadline deadline) {
+  return socket_.WaitReadable(deadline);
+}
+
+size_t BufferedWriter::ReadSome(void* buf, size_t len,
+                                engine::Deadline deadline) {
+  return socket_.ReadSome(buf, len, deadline);
+}
+
+size_t BufferedWriter::ReadAll(void* buf, size_t len,
+                               engine::Deadline deadline) {
+  return socket_.ReadAll(buf, len, deadline);
+}
+
+bool BufferedWriter::WaitWriteable(engine::Deadline deadline) {
+  return socket_.WaitWriteable(deadline);
+}
+
+size_t BufferedWriter::WriteAll(const void* buf, size_t len,
+                                engine::Deadline deadline) {
+  const engine::io::IoData io_data{buf, len};
+  return WriteAll(&io_data, 1, deadline);
+}
+
+size_t BufferedWriter::WriteAll(std::initializer_list<engine::io::IoData> list,
+                                engine::Deadline deadline) {
+  return WriteAll(list.begin(), list.size(), deadline);
+}
+
+size_t BufferedWriter::WriteAll(const engine::io::IoData* list,
+                                std::size_t list_size,
+                                engine::Deadline deadline) {
+  std::size_t total_size = 0;
+  for (std::size_t i = 0; i < list_size; ++i) total_size += list[i].len;
+
+  if (is_buffering_ && buffer_.size() + total_size <= capacity_) {
+    // The buffer is allocated only for the duration of a batch, idle
+    // connections do not hold it
+    if (buffer_.empty()) buffer_.reserve(capacity_);
+    for (std::size_t i = 0; i < list_size; ++i) {
+      buffer_.append(static_cast<const char*>(list[i].data), list[i].len);
+    }
+    return total_size;
+  }
+
+  if (buffer_.empty()) return socket_.WriteAll(list, list_size, deadline);
+
+  const std::string buffer = std::exchange(buffer_, {});
+
+  boost::container::small_vector<engine::io::IoData, kTypicalIoDataCount> io;
+  io.reserve(list_size + 1);
+  io.push_back({buffer.data(), buffer.size()});
+  io.insert(io.end(), list, list + list_size);
+
+  const auto sent_bytes = socket_.WriteAll(io.data(), io.size(), deadline);
+  return sent_bytes > buffer.size() ? sent_bytes - buffer.size() : 0;
+}
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include <userver/engine/io/common.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+/// @brief Coalesces the writes of pipelined responses.
+///
+/// Writes are copied into the buffer while they fit into it. A write that does
+/// not fit, or any write while the buffering is disabled, is sent right away
+/// together with the buffered data, using a single vectored write. Reads are
+/// forwarded to the socket as is.
+///
+/// The buffer is allocated by the first buffered write and is freed by the
+/// write that sends it.
+class BufferedWriter final : public engine::io::RwBase {
+ public:
+  static constexpr std::size_t kDefaultCapacity = 16 * 1024;
+
+  explicit BufferedWriter(engine::io::RwBase& socket,
+                          std::size_t capacity = kDefaultCapacity);
+  ~BufferedWriter() override;
+
+  /// Sends the buffered data
+  void Flush(engine::Deadline deadline);
+
+  bool HasBufferedData() const noexcept { return !buffer_.empty(); }
+
+  /// Enables the buffering of the following writes, it is enabled by default
+  void SetBuffering(bool enabled) noexcept { is_buffering_ = enabled; }
+
+  bool IsValid() const override;
+
+  [[nodiscard]] bool WaitReadable(engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t ReadSome(void* buf, size_t len,
+                                engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t ReadAll(void* buf, size_t len,
+                               engine::Deadline deadline) override;
+
+  [[nodiscard]] bool WaitWriteable(engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t WriteAll(const void* buf, size_t len,
+                                engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t WriteAll(std::initializer_list<engine::io::IoData> list,
+                                engine::Deadline deadline) override;
+
+  [[nodiscard]] size_t WriteAll(const engine::io::IoData* list,
+                                std::size_t list_size,
+                                engine::Deadline deadline) override;
+
+ private:
+  engine::io::RwBase& socket_;
+  const std::size_t capacity_;
+  std::string buffer_;
+  bool is_buffering_{true};
+};
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
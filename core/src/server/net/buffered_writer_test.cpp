@@ -0,0 +1,106 @@
+#include <server/net/buffered_writer.hpp>
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+class RecordingSocket final : public engine::io::RwBase {
+ public:
+  bool IsValid() const override { return true; }
+
+  bool WaitReadable(engine::Deadline) override { return false; }
+
+  size_t ReadSome(void*, size_t, engine::Deadline) override { return 0; }
+
+  size_t ReadAll(void*, size_t, engine::Deadline) override { return 0; }
+
+  bool WaitWriteable(engine::Deadline) override { return true; }
+
+  size_t WriteAll(const void* buf, size_t len, engine::Deadline) override {
+    writes.emplace_back(static_cast<const char*>(buf), len);
+    return len;
+  }
+
+  size_t WriteAll(std::initializer_list<engine::io::IoData> list,
+                  engine::Deadline deadline) override {
+    return WriteAll(list.begin(), list.size(), deadline);
+  }
+
+  size_t WriteAll(const engine::io::IoData* list, std::size_t list_size,
+                  engine::Deadline) override {
+    auto& write = writes.emplace_back();
+    for (std::size_t i = 0; i < list_size; ++i) {
+      write.append(static_cast<const char*>(list[i].data), list[i].len);
+    }
+    return write.size();
+  }
+
+  std::vector<std::string> writes;
+};
+
+}  // namespace
+
+TEST(BufferedWriter, CoalescesSmallWrites) {
+  RecordingSocket socket;
+  server::net::BufferedWriter writer{socket, 16};
+
+  EXPECT_EQ(writer.WriteAll("abc", 3, {}), 3);
+  EXPECT_EQ(writer.WriteAll({{"de", 2}, {"fgh", 3}}, {}), 5);
+  EXPECT_TRUE(socket.writes.empty());
+  EXPECT_TRUE(writer.HasBufferedData());
+
+  writer.Flush({});
+  EXPECT_FALSE(writer.HasBufferedData());
+  ASSERT_EQ(socket.writes.size(), 1);
+  EXPECT_EQ(socket.writes[0], "abcdefgh");
+
+  // Nothing to flush
+  writer.Flush({});
+  EXPECT_EQ(socket.writes.size(), 1);
+}
+
+TEST(BufferedWriter, LargeWriteSentWithBufferedData) {
+  RecordingSocket socket;
+  server::net::BufferedWriter writer{socket, 8};
+
+  EXPECT_EQ(writer.WriteAll("abc", 3, {}), 3);
+
+  const std::string large(10, 'x');
+  EXPECT_EQ(writer.WriteAll(large.data(), large.size(), {}), large.size());
+  EXPECT_FALSE(writer.HasBufferedData());
+  ASSERT_EQ(socket.writes.size(), 1);
+  EXPECT_EQ(socket.writes[0], "abc" + large);
+
+  EXPECT_EQ(writer.WriteAll(large.data(), large.size(), {}), large.size());
+  ASSERT_EQ(socket.writes.size(), 2);
+  EXPECT_EQ(socket.writes[1], large);
+}
+
+TEST(BufferedWriter, DisabledBuffering) {
+  RecordingSocket socket;
+  server::net::BufferedWriter writer{socket, 16};
+
+  writer.SetBuffering(false);
+  EXPECT_EQ(writer.WriteAll({{"ab", 2}, {"c", 1}}, {}), 3);
+  EXPECT_FALSE(writer.HasBufferedData());
+  ASSERT_EQ(socket.writes.size(), 1);
+  EXPECT_EQ(socket.writes[0], "abc");
+
+  writer.SetBuffering(true);
+  EXPECT_EQ(writer.WriteAll("de", 2, {}), 2);
+  EXPECT_EQ(socket.writes.size(), 1);
+
+  // The last write of a batch is sent together with the buffered ones
+  writer.SetBuffering(false);
+  EXPECT_EQ(writer.WriteAll("fg", 2, {}), 2);
+  EXPECT_FALSE(writer.HasBufferedData());
+  ASSERT_EQ(socket.writes.size(), 2);
+  EXPECT_EQ(socket.writes[1], "defg");
+}
+
+USERVER_NAMESPACE_END
@@ -2,13 +2,19 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <optional>
 #include <stdexcept>
+#include <string_view>
 #include <system_error>
 #include <vector>
 
 #include <server/http/http_request_parser.hpp>
 #include <server/http/request_handler_base.hpp>
+#include <engine/task/task_processor.hpp>
+#include <server/net/buffered_writer.hpp>
 
+#include <userver/concurrent/background_task_storage.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/exception.hpp>
 #include <userver/engine/io/exception.hpp>
@@ -18,11 +24,46 @@
 #include <userver/server/request/request_config.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
+#include <userver/utils/rand.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+// The limits are lowered by up to that fraction
+constexpr double kLimitJitter = 0.1;
+
+double Jitter(double limit) {
+  return limit * (1 - utils::RandRange(kLimitJitter));
+}
+
+// Accounts the connection in Stats while it waits for the next request with
+// no requests in flight
+class IdleScope final {
+ public:
+  IdleScope(Stats& stats, std::size_t buffers_size) noexcept
+      : stats_(stats), buffers_size_(buffers_size) {
+    ++stats_.idle_connections;
+    stats_.idle_connections_buffers_size += buffers_size_;
+  }
+
+  IdleScope(const IdleScope&) = delete;
+  IdleScope& operator=(const IdleScope&) = delete;
+
+  ~IdleScope() {
+    --stats_.idle_connections;
+    stats_.idle_connections_buffers_size -= buffers_size_;
+  }
+
+ private:
+  Stats& stats_;
+  const std::size_t buffers_size_;
+};
+
+}  // namespace
+
 Connection::Connection(
     const ConnectionConfig& config,
     const request::HttpRequestConfig& handler_defaults_config,
@@ -39,7 +80,12 @@ Connection::Connection(
       data_accounter_(data_accounter),
       remote_address_(remote_address),
       peer_name_(remote_address_.PrimaryAddressString()),
-      request_tasks_(Queue::Create()) {
+      request_tasks_(Queue::Create()),
+      start_time_(std::chrono::steady_clock::now()),
+      max_requests_(
+          static_cast<size_t>(std::ceil(Jitter(config_.max_requests)))),
+      max_age_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(Jitter(config_.max_age.count())))) {
   LOG_DEBUG() << "Incoming connection from " << Getpeername() << ", fd "
               << Fd();
 
@@ -111,29 +157,50 @@ void Connection::ListenForRequests(
         },
         stats_->parser_stats, data_accounter_);
 
-    std::vector<char> buf(config_.in_buffer_size);
-    std::size_t last_bytes_read = 0;
-    while (is_accepting_requests_) {
+    // The parsers keep no references to the buffer, so the received data is
+    // consumed right away and an idle connection does not hold a buffer
+    engine::io::BufferedSocket socket{*peer_socket_, config_.in_buffer_size};
+
+    if (config_.http2.enabled) {
+      if (!ReadHttp2Preface(socket, engine::Deadline::FromDuration(
+                                        config_.keepalive_timeout))) {
+        LOG_TRACE() << "Peer " << Getpeername() << " on fd " << Fd()
+                    << " closed connection or the connection timed out";
+        return;
+      }
+
+      const auto received = socket.GetReadable();
+      const auto preface = http::Http2Session::kClientPreface;
+      if (received.substr(0, preface.size()) == preface) {
+        ListenForHttp2Requests(socket);
+        send_stopper.Release();
+        return;
+      }
+
+      if (!request_parser.Parse(received.data(), received.size())) {
+        LOG_DEBUG() << "Malformed request from " << Getpeername() << " on fd "
+                    << Fd();
+        is_accepting_requests_ = false;
+      }
+      socket.Consume(received.size());
+    }
+
+    bool is_draining = false;
+    // The body of a streamed request is read even after the last request of
+    // the connection is accepted
+    while (is_accepting_requests_ || request_parser.IsReadingBody()) {
       auto deadline = engine::Deadline::FromDuration(config_.keepalive_timeout);
 
-      bool is_readable = true;
-      // If we didn't fill the buffer in the previous loop iteration we almost
-      // certainly will hit EWOULDBLOCK on the subsequent recv syscall from
-      // peer_socket_.RecvSome, which will fall back to event-loop waiting
-      // for socket to become readable, and then issue another recv syscall,
-      // effectively doing
-      // 1. recv (returns -1)
-      // 2. notify event-loop about read interest
-      // 3. recv (return some data)
-      //
-      // So instead we just do 2. and 3., shaving off a whole recv syscall
-      if (last_bytes_read != buf.size()) {
-        is_readable = peer_socket_->WaitReadable(deadline);
+      std::optional<IdleScope> idle_scope;
+      if (!request_parser.IsInMessage() && IsRequestTasksEmpty()) {
+        // Nothing is borrowed from the buffer pools while waiting
+        socket.ReleaseBuffer();
+        idle_scope.emplace(*stats_, socket.GetBufferSize());
       }
+      const bool is_readable = socket.WaitReadable(deadline);
+      idle_scope.reset();
 
-      last_bytes_read =
-          is_readable ? peer_socket_->ReadSome(buf.data(), buf.size(), deadline)
-                      : 0;
+      const auto last_bytes_read = is_readable ? socket.ReadSome(deadline) : 0;
       if (!last_bytes_read) {
         LOG_TRACE() << "Peer " << Getpeername() << " on fd " << Fd()
                     << " closed connection or the connection timed out";
@@ -150,13 +217,23 @@ void Connection::ListenForRequests(
       LOG_TRACE() << "Received " << last_bytes_read << " byte(s) from "
                   << Getpeername() << " on fd " << Fd();
 
-      if (!request_parser.Parse(buf.data(), last_bytes_read)) {
+      if (!is_draining && !request_parser.IsInMessage() && ShouldDrain()) {
+        LOG_DEBUG() << "Closing connection from " << Getpeername()
+                    << " on fd " << Fd() << " after the next request";
+        request_parser.CloseAfterNextRequest();
+        ++stats_->connections_drained;
+        is_draining = true;
+      }
+
+      const auto received = socket.GetReadable();
+      if (!request_parser.Parse(received.data(), received.size())) {
         LOG_DEBUG() << "Malformed request from " << Getpeername() << " on fd "
                     << Fd();
 
         // Stop accepting new requests, send previous answers.
         is_accepting_requests_ = false;
       }
+      socket.Consume(received.size());
     }
 
     send_stopper.Release();
@@ -195,36 +272,182 @@ bool Connection::NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
     is_accepting_requests_ = false;
   }
 
+  ++requests_count_;
   ++stats_->active_request_count;
   auto task = request_handler_.StartRequestTask(request_ptr);
   return producer.Push({std::move(request_ptr), std::move(task)});
 }
 
+bool Connection::ShouldDrain() const {
+  if (max_requests_ != 0 && requests_count_ + 1 >= max_requests_) return true;
+  if (max_age_.count() != 0 &&
+      std::chrono::steady_clock::now() - start_time_ >= max_age_) {
+    return true;
+  }
+
+  return config_.overload_close_fraction > 0 &&
+         engine::current_task::GetTaskProcessor()
+             .IsTaskQueueWaitTimeOverloaded() &&
+         utils::RandRange(1.0) < config_.overload_close_fraction;
+}
+
+bool Connection::ReadHttp2Preface(engine::io::BufferedSocket& socket,
+                                  engine::Deadline deadline) {
+  // Reads just enough to tell the HTTP/2 preface from an HTTP/1.1 request
+  const auto preface = http::Http2Session::kClientPreface;
+  while (socket.GetReadable().size() < preface.size()) {
+    if (!socket.WaitReadable(deadline) || !socket.ReadSome(deadline)) {
+      return false;
+    }
+
+    const auto received = socket.GetReadable();
+    const auto common_size = std::min(received.size(), preface.size());
+    if (received.substr(0, common_size) != preface.substr(0, common_size)) {
+      break;
+    }
+  }
+  return true;
+}
+
+void Connection::ListenForHttp2Requests(engine::io::BufferedSocket& socket) {
+  LOG_DEBUG() << "HTTP/2 connection from " << Getpeername() << " on fd "
+              << Fd();
+
+  // Each stream is answered by its own task as soon as the handler finishes,
+  // without waiting for the streams that were started earlier
+  concurrent::BackgroundTaskStorageCore responders;
+  http::Http2Session session(
+      config_.http2, request_handler_.GetHandlerInfoIndex(),
+      handler_defaults_config_, *peer_socket_,
+      [this, &responders, &session](
+          http::Http2Session::StreamId stream_id,
+          std::shared_ptr<request::RequestBase>&& request_ptr) {
+        ++stats_->active_request_count;
+        auto task = request_handler_.StartRequestTask(request_ptr);
+        responders.Detach(engine::CriticalAsyncNoSpan(
+            [this, &session, stream_id](QueueItem item) {
+              ProcessHttp2Response(session, stream_id, item);
+            },
+            QueueItem{std::move(request_ptr), std::move(task)}));
+      },
+      [this](request::RequestBase& request) { FinishResponse(request); },
+      stats_->parser_stats, data_accounter_);
+  // Responders use the session, so they are stopped before it is destroyed
+  const utils::FastScopeGuard stop_responders(
+      [&responders]() noexcept { responders.CancelAndWait(); });
+
+  while (session.IsAlive()) {
+    const auto received = socket.GetReadable();
+    if (!received.empty() &&
+        !session.Parse(received.data(), received.size())) {
+      LOG_DEBUG() << "Malformed HTTP/2 data from " << Getpeername()
+                  << " on fd " << Fd();
+      return;
+    }
+    socket.Consume(received.size());
+
+    const auto deadline =
+        engine::Deadline::FromDuration(config_.keepalive_timeout);
+    if (!socket.WaitReadable(deadline)) {
+      if (engine::current_task::ShouldCancel()) return;
+      // Long requests keep the connection alive
+      if (session.HasActiveStreams()) continue;
+      LOG_INFO() << "Closing idle connection on timeout";
+      return;
+    }
+
+    if (!socket.ReadSome(deadline)) {
+      LOG_TRACE() << "Peer " << Getpeername() << " on fd " << Fd()
+                  << " closed HTTP/2 connection";
+      return;
+    }
+  }
+}
+
+void Connection::ProcessHttp2Response(http::Http2Session& session,
+                                      http::Http2Session::StreamId stream_id,
+                                      QueueItem& item) noexcept {
+  auto& request = *item.first;
+  const bool is_response_valid = HandleQueueItem(item);
+  request.SetStartSendResponseTime();
+  if (!is_response_valid) {
+    session.ResetStream(stream_id);
+    return;
+  }
+
+  try {
+    session.SendResponse(stream_id, request);
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Error while sending HTTP/2 response to "
+                  << Getpeername() << " on fd " << Fd() << ": " << ex;
+  }
+}
+
 void Connection::ProcessResponses(Queue::Consumer& consumer) noexcept {
   try {
+    std::optional<BufferedWriter> writer;
+    if (peer_socket_) writer.emplace(*peer_socket_);
+
     QueueItem item;
-    while (consumer.Pop(item)) {
-      HandleQueueItem(item);
+    QueueItem next_item;
+    bool has_next_item = false;
+    while (has_next_item || consumer.Pop(item)) {
+      if (has_next_item) {
+        item = std::move(next_item);
+        has_next_item = false;
+      }
+      if (!HandleQueueItem(item)) is_response_chain_valid_ = false;
 
       // now we must complete processing
       engine::TaskCancellationBlocker block_cancel;
 
-      /* In stream case we don't want a user task to exit
-       * until SendResponse() as the task produces body chunks.
-       */
-      SendResponse(*item.first);
-      if (item.first->IsUpgradeWebsocket())
-        item.first->DoUpgrade(std::move(peer_socket_),
-                              std::move(remote_address_));
+      auto& request = *item.first;
+      const bool is_upgrade = request.IsUpgradeWebsocket();
+      if (!writer || request.GetResponse().IsBodyStreamed() || is_upgrade) {
+        FlushResponses(writer);
+
+        /* In stream case we don't want a user task to exit
+         * until SendResponse() as the task produces body chunks.
+         */
+        SendResponse(request, peer_socket_.get());
+        if (is_upgrade) {
+          writer.reset();
+          request.DoUpgrade(std::move(peer_socket_),
+                            std::move(remote_address_));
+        }
+      } else {
+        // Pipelined responses that are ready one after another are coalesced
+        // into a single write. The last one of a batch goes out right away
+        // together with the buffered ones, so a response that is not followed
+        // by a ready one is written directly without copying. Nothing is kept
+        // buffered while waiting for a handler.
+        has_next_item = consumer.PopNoblock(next_item);
+        const bool is_next_ready =
+            has_next_item && next_item.second.IsFinished();
+        writer->SetBuffering(is_next_ready);
+        SendResponse(request, &*writer);
+        if (!is_next_ready) FlushResponses(writer);
+      }
       item.first.reset();
       item.second = {};
     }
+    FlushResponses(writer);
   } catch (const std::exception& e) {
     LOG_ERROR() << "Exception for fd " << Fd() << ": " << e;
   }
 }
 
-void Connection::HandleQueueItem(QueueItem& item) noexcept {
+void Connection::FlushResponses(std::optional<BufferedWriter>& writer) {
+  if (!writer || !writer->HasBufferedData()) return;
+  try {
+    writer->Flush({});
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "Error while sending pipelined responses: " << ex;
+    is_response_chain_valid_ = false;
+  }
+}
+
+bool Connection::HandleQueueItem(QueueItem& item) noexcept {
   auto& request = *item.first;
 
   if (engine::current_task::IsCancelRequested()) {
@@ -233,8 +456,7 @@ void Connection::HandleQueueItem(QueueItem& item) noexcept {
     auto request_task = std::move(item.second);
     request_task.SyncCancel();
     LOG_DEBUG() << "Request processing interrupted";
-    is_response_chain_valid_ = false;
-    return;  // avoids throwing and catching exception down below
+    return false;  // avoids throwing and catching exception down below
   }
 
   try {
@@ -255,21 +477,23 @@ void Connection::HandleQueueItem(QueueItem& item) noexcept {
     }
   } catch (const engine::WaitInterruptedException&) {
     LOG_DEBUG() << "Request processing interrupted";
-    is_response_chain_valid_ = false;
+    return false;
   } catch (const std::exception& e) {
     LOG_WARNING() << "Request failed with unhandled exception: " << e;
     request.MarkAsInternalServerError();
   }
+  return true;
 }
 
-void Connection::SendResponse(request::RequestBase& request) {
+void Connection::SendResponse(request::RequestBase& request,
+                              engine::io::RwBase* socket) {
   auto& response = request.GetResponse();
   UASSERT(!response.IsSent());
   request.SetStartSendResponseTime();
-  if (is_response_chain_valid_ && peer_socket_) {
+  if (is_response_chain_valid_ && socket) {
     try {
       // Might be a stream reading or a fully constructed response
-      response.SendResponse(*peer_socket_);
+      response.SendResponse(*socket);
     } catch (const engine::io::IoSystemError& ex) {
       // working with raw values because std::errc compares error_category
       // default_error_category() fixed only in GCC 9.1 (PR libstdc++/60555)
@@ -286,6 +510,10 @@ void Connection::SendResponse(request::RequestBase& request) {
   } else {
     response.SetSendFailed(std::chrono::steady_clock::now());
   }
+  FinishResponse(request);
+}
+
+void Connection::FinishResponse(request::RequestBase& request) {
   request.SetFinishSendResponseTime();
   --stats_->active_request_count;
   ++stats_->requests_processed_count;
@@ -1,15 +1,21 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
+#include <server/http/http2_session.hpp>
 #include <server/http/request_handler_base.hpp>
+#include <server/net/buffered_writer.hpp>
 #include <server/net/connection_config.hpp>
 #include <server/net/stats.hpp>
 #include <server/request/request_parser.hpp>
 
 #include <userver/concurrent/queue.hpp>
+#include <userver/engine/io/buffered_socket.hpp>
 #include <userver/engine/io/socket.hpp>
 #include <userver/server/request/request_base.hpp>
 #include <userver/server/request/request_config.hpp>
@@ -47,10 +53,23 @@ class Connection final {
                          engine::TaskCancellationToken token) noexcept;
   bool NewRequest(std::shared_ptr<request::RequestBase>&& request_ptr,
                   Queue::Producer&);
+  // The connection is closed after the next request, so that the client
+  // reconnects to a less loaded instance
+  bool ShouldDrain() const;
+
+  bool ReadHttp2Preface(engine::io::BufferedSocket& socket,
+                        engine::Deadline deadline);
+  void ListenForHttp2Requests(engine::io::BufferedSocket& socket);
+  void ProcessHttp2Response(http::Http2Session& session,
+                            http::Http2Session::StreamId stream_id,
+                            QueueItem& item) noexcept;
 
   void ProcessResponses(Queue::Consumer&) noexcept;
-  void HandleQueueItem(QueueItem& item) noexcept;
-  void SendResponse(request::RequestBase& request);
+  // Returns false if the request processing was interrupted
+  bool HandleQueueItem(QueueItem& item) noexcept;
+  void SendResponse(request::RequestBase& request, engine::io::RwBase* socket);
+  void FlushResponses(std::optional<BufferedWriter>& writer);
+  void FinishResponse(request::RequestBase& request);
 
   std::string Getpeername() const;
 
@@ -66,6 +85,13 @@ class Connection final {
 
   std::shared_ptr<Queue> request_tasks_;
 
+  const std::chrono::steady_clock::time_point start_time_;
+  // Jittered limits of the config, so that the connections accepted at the
+  // same time are not closed all at once
+  const size_t max_requests_;
+  const std::chrono::steady_clock::duration max_age_;
+  size_t requests_count_{0};
+
   bool is_accepting_requests_{true};
   bool is_response_chain_valid_{true};
 };
@@ -1,11 +1,40 @@
 #include <server/net/connection_config.hpp>
 
+#include <stdexcept>
+
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+Http2Config Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<Http2Config>) {
+  Http2Config config;
+
+  config.enabled = value["enabled"].As<bool>(config.enabled);
+  config.max_concurrent_streams =
+      value["max_concurrent_streams"].As<std::uint32_t>(
+          config.max_concurrent_streams);
+  config.initial_window_size = value["initial_window_size"].As<std::uint32_t>(
+      config.initial_window_size);
+  config.max_frame_size =
+      value["max_frame_size"].As<std::uint32_t>(config.max_frame_size);
+
+  // Limits from RFC 9113, section 6.5.2
+  if (config.initial_window_size > (1U << 31) - 1) {
+    throw std::runtime_error("Invalid initial_window_size value in " +
+                             value.GetPath());
+  }
+  if (config.max_frame_size < (1U << 14) ||
+      config.max_frame_size > (1U << 24) - 1) {
+    throw std::runtime_error("Invalid max_frame_size value in " +
+                             value.GetPath());
+  }
+
+  return config;
+}
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>) {
   ConnectionConfig config;
@@ -18,6 +47,16 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value,
   config.keepalive_timeout =
       value["keepalive_timeout"].As<std::chrono::seconds>(
           config.keepalive_timeout);
+  config.max_requests = value["max_requests"].As<size_t>(config.max_requests);
+  config.max_age = value["max_age"].As<std::chrono::seconds>(config.max_age);
+  config.overload_close_fraction = value["overload_close_fraction"].As<double>(
+      config.overload_close_fraction);
+  if (config.overload_close_fraction < 0 ||
+      config.overload_close_fraction > 1) {
+    throw std::runtime_error("Invalid overload_close_fraction value in " +
+                             value.GetPath());
+  }
+  config.http2 = value["http2"].As<Http2Config>(config.http2);
 
   return config;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -9,12 +11,28 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+struct Http2Config {
+  bool enabled = false;
+  std::uint32_t max_concurrent_streams = 100;
+  std::uint32_t initial_window_size = 64 * 1024 - 1;
+  std::uint32_t max_frame_size = 16 * 1024;
+};
+
 struct ConnectionConfig {
   size_t in_buffer_size = 32 * 1024;
   size_t requests_queue_size_threshold = 100;
   std::chrono::seconds keepalive_timeout{10 * 60};
+  // The limits make the clients reconnect and so spread the load over the
+  // newly started instances, zero means no limit
+  size_t max_requests{0};
+  std::chrono::seconds max_age{0};
+  double overload_close_fraction{0.0};
+  Http2Config http2;
 };
 
+Http2Config Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<Http2Config>);
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>);
 
@@ -1,5 +1,7 @@
 #include <server/net/connection.hpp>
 
+#include <vector>
+
 #include <fmt/format.h>
 
 #include <server/handlers/http_handler_base_statistics.hpp>
@@ -9,6 +11,7 @@
 #include <userver/clients/http/client.hpp>
 #include <userver/engine/io/sockaddr.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/http/common_headers.hpp>
 
 #include <userver/utest/http_client.hpp>
 #include <userver/utest/utest.hpp>
@@ -92,6 +95,16 @@ clients::http::ResponseFuture CreateRequest(
   return ret.async_perform();
 }
 
+clients::http::ResponseFuture CreateHttp2Request(
+    clients::http::Client& http_client, engine::io::Socket& request_socket) {
+  return http_client.CreateRequest()
+      .get(HttpConnectionUriFromSocket(request_socket))
+      .http_version(clients::http::HttpVersion::k2PriorKnowledge)
+      .retry(1)
+      .timeout(utest::kMaxTestWaitTime)
+      .async_perform();
+}
+
 net::ListenerConfig CreateConfig() {
   net::ListenerConfig config;
   config.handler_defaults = server::request::HttpRequestConfig{};
@@ -274,6 +287,40 @@ UTEST(ServerNetConnection, KeepAlive) {
   EXPECT_EQ(handler.asyncs_finished, 2);
 }
 
+UTEST(ServerNetConnection, MaxRequests) {
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.max_requests = 1;
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  auto request = CreateRequest(*http_client_ptr, request_socket,
+                               ConnectionHeader::kKeepAlive);
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  auto task = engine::AsyncNoSpan([&] {
+    net::Connection connection(
+        config.connection_config, config.handler_defaults,
+        std::make_unique<engine::io::Socket>(std::move(peer)), {}, handler,
+        stats, data_accounter);
+
+    connection.Process();
+  });
+
+  const auto response = request.Get();
+  EXPECT_EQ(response->status_code(), 404);
+  EXPECT_EQ(response->headers()[http::headers::kConnection], "close");
+
+  // The server closes the connection by itself
+  task.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(task.IsFinished());
+  EXPECT_EQ(stats->connections_drained, 1);
+}
+
 UTEST(ServerNetConnection, CancelMultipleInFlight) {
   constexpr std::size_t kInFlightRequests = 10;
   constexpr std::size_t kMaxAttempts = 10;
@@ -323,4 +370,78 @@ UTEST(ServerNetConnection, CancelMultipleInFlight) {
   FAIL() << "Failed to simulate cancellation of multiple requests";
 }
 
+UTEST(ServerNetConnection, Http2Multiplexing) {
+  constexpr std::size_t kConcurrentRequests = 10;
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.http2.enabled = true;
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  http_client_ptr->SetMaxHostConnections(1);
+
+  auto request = CreateHttp2Request(*http_client_ptr, request_socket);
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  auto task = engine::AsyncNoSpan([&] {
+    net::Connection connection(
+        config.connection_config, config.handler_defaults,
+        std::make_unique<engine::io::Socket>(std::move(peer)), {}, handler,
+        stats, data_accounter);
+
+    connection.Process();
+  });
+  EXPECT_EQ(request.Get()->status_code(), 404);
+  EXPECT_EQ(handler.asyncs_finished, 1);
+
+  // All the requests share the single accepted connection
+  std::vector<clients::http::ResponseFuture> requests;
+  for (std::size_t i = 0; i < kConcurrentRequests; ++i) {
+    requests.push_back(CreateHttp2Request(*http_client_ptr, request_socket));
+  }
+  for (auto& future : requests) {
+    EXPECT_EQ(future.Get()->status_code(), 404);
+  }
+  EXPECT_EQ(handler.asyncs_finished, kConcurrentRequests + 1);
+  EXPECT_EQ(stats->requests_processed_count, kConcurrentRequests + 1);
+
+  task.RequestCancel();
+  task.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(task.IsFinished());
+}
+
+UTEST(ServerNetConnection, Http2EnabledServesHttp11) {
+  net::ListenerConfig config = CreateConfig();
+  config.connection_config.http2.enabled = true;
+  auto request_socket = net::CreateSocket(config);
+
+  auto http_client_ptr = utest::CreateHttpClient();
+  auto request = CreateRequest(*http_client_ptr, request_socket,
+                               ConnectionHeader::kClose);
+
+  auto peer = request_socket.Accept(Deadline::FromDuration(kAcceptTimeout));
+  ASSERT_TRUE(peer.IsValid());
+  auto stats = std::make_shared<net::Stats>();
+  server::request::ResponseDataAccounter data_accounter;
+  TestHttprequestHandler handler;
+
+  auto task = engine::AsyncNoSpan([&] {
+    net::Connection connection(
+        config.connection_config, config.handler_defaults,
+        std::make_unique<engine::io::Socket>(std::move(peer)), {}, handler,
+        stats, data_accounter);
+
+    connection.Process();
+  });
+  EXPECT_EQ(request.Get()->status_code(), 404);
+
+  task.RequestCancel();
+  task.WaitFor(utest::kMaxTestWaitTime);
+  EXPECT_TRUE(task.IsFinished());
+}
+
 USERVER_NAMESPACE_END
@@ -7,8 +7,13 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#ifdef __linux__
+#include <linux/filter.h>
+#endif
+
 #include <cstdint>
 #include <cstring>
+#include <iterator>
 #include <stdexcept>
 #include <string>
 #include <system_error>
@@ -22,6 +27,7 @@
 #include <userver/engine/sleep.hpp>
 #include <userver/fs/blocking/read.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/logging/log.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -48,18 +54,56 @@ engine::io::Socket CreateUnixSocket(const std::string& path, int backlog) {
   return socket;
 }
 
-engine::io::Socket CreateIpv6Socket(uint16_t port, int backlog) {
+// Makes the kernel pass a new connection to the socket with the index of the
+// CPU that received it, so a reconnect storm is spread as evenly as the NIC
+// queues rather than by the connection hash.
+void AttachReuseportCpuSteering(engine::io::Socket& socket,
+                                std::size_t shards) {
+#if defined(__linux__) && defined(SO_ATTACH_REUSEPORT_CBPF)
+  // A = cpu % shards; return A
+  sock_filter code[] = {
+      {BPF_LD | BPF_W | BPF_ABS, 0, 0,
+       static_cast<std::uint32_t>(SKF_AD_OFF + SKF_AD_CPU)},
+      {BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<std::uint32_t>(shards)},
+      {BPF_RET | BPF_A, 0, 0, 0},
+  };
+  sock_fprog program{};
+  program.len = std::size(code);
+  program.filter = code;
+
+  if (::setsockopt(socket.Fd(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program,
+                   sizeof(program)) == -1) {
+    const auto error = errno;
+    LOG_WARNING() << "Failed to attach SO_REUSEPORT CPU steering program, "
+                     "connections are distributed by hash: "
+                  << std::system_category().message(error);
+  }
+#else
+  (void)socket;
+  (void)shards;
+  LOG_WARNING() << "SO_REUSEPORT CPU steering is not supported on this "
+                   "platform, connections are distributed by hash";
+#endif
+}
+
+engine::io::Socket CreateIpv6Socket(const ListenerConfig& config) {
   engine::io::Sockaddr addr;
   auto* sa = addr.As<struct sockaddr_in6>();
   sa->sin6_family = AF_INET6;
   // may be implemented as a macro
   // NOLINTNEXTLINE(hicpp-no-assembler, readability-isolate-declaration)
-  sa->sin6_port = htons(port);
+  sa->sin6_port = htons(config.port);
   sa->sin6_addr = in6addr_any;
 
   engine::io::Socket socket{addr.Domain(), engine::io::SocketType::kStream};
   socket.Bind(addr);
-  socket.Listen(backlog);
+  // The program is shared by the whole SO_REUSEPORT group and selects the
+  // sockets by the order of binding
+  const auto shards = config.shards.value_or(1);
+  if (config.reuseport_cpu_steering && shards > 1) {
+    AttachReuseportCpuSteering(socket, shards);
+  }
+  socket.Listen(config.backlog);
   return socket;
 }
 
@@ -67,7 +111,7 @@ engine::io::Socket CreateIpv6Socket(uint16_t port, int backlog) {
 
 engine::io::Socket CreateSocket(const ListenerConfig& config) {
   if (config.unix_socket_path.empty())
-    return CreateIpv6Socket(config.port, config.backlog);
+    return CreateIpv6Socket(config);
   else
     return CreateUnixSocket(config.unix_socket_path, config.backlog);
 }
@@ -0,0 +1,55 @@
+#include <server/net/create_socket.hpp>
+
+#include <sys/socket.h>
+
+#include <cerrno>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+#ifdef SO_DETACH_REUSEPORT_BPF
+// Returns 0 if a program was attached to the SO_REUSEPORT group of the socket
+int DetachReuseportProgram(engine::io::Socket& socket) {
+  int unused = 0;
+  if (::setsockopt(socket.Fd(), SOL_SOCKET, SO_DETACH_REUSEPORT_BPF, &unused,
+                   sizeof(unused)) == -1) {
+    return errno;
+  }
+  return 0;
+}
+#endif
+
+server::net::ListenerConfig CreateConfig(std::size_t shards,
+                                         bool reuseport_cpu_steering) {
+  server::net::ListenerConfig config;
+  config.handler_defaults = server::request::HttpRequestConfig{};
+  config.shards = shards;
+  config.reuseport_cpu_steering = reuseport_cpu_steering;
+  return config;
+}
+
+}  // namespace
+
+UTEST(CreateSocket, ReuseportCpuSteering) {
+#ifdef SO_DETACH_REUSEPORT_BPF
+  auto plain_socket = server::net::CreateSocket(CreateConfig(2, false));
+  const auto plain_error = DetachReuseportProgram(plain_socket);
+  if (plain_error == ENOPROTOOPT) {
+    GTEST_SKIP() << "SO_DETACH_REUSEPORT_BPF is not supported by the kernel";
+  }
+  EXPECT_EQ(plain_error, ENOENT);
+
+  auto single_shard_socket = server::net::CreateSocket(CreateConfig(1, true));
+  EXPECT_EQ(DetachReuseportProgram(single_shard_socket), ENOENT);
+
+  auto steered_socket = server::net::CreateSocket(CreateConfig(2, true));
+  EXPECT_EQ(DetachReuseportProgram(steered_socket), 0);
+#else
+  GTEST_SKIP() << "SO_DETACH_REUSEPORT_BPF is not defined";
+#endif
+}
+
+USERVER_NAMESPACE_END
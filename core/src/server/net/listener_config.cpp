@@ -22,6 +22,8 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
   config.max_connections =
       value["max_connections"].As<size_t>(config.max_connections);
   config.shards = value["shards"].As<std::optional<size_t>>(config.shards);
+  config.reuseport_cpu_steering = value["reuseport_cpu_steering"].As<bool>(
+      config.reuseport_cpu_steering);
   config.task_processor = value["task_processor"].As<std::string>();
   config.backlog = value["backlog"].As<int>(config.backlog);
 
@@ -33,6 +35,21 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
     throw std::runtime_error(
         "Either non-zero 'port' or non-empty 'unix-socket' fields must be set");
 
+  if (config.shards && *config.shards == 0) {
+    throw std::runtime_error("Invalid shards value in " + value.GetPath());
+  }
+  // Every shard would remove the socket file of the previous one
+  if (config.shards && *config.shards > 1 && !config.unix_socket_path.empty()) {
+    throw std::runtime_error(
+        "Only a single shard is allowed for 'unix-socket' in " +
+        value.GetPath());
+  }
+  if (config.reuseport_cpu_steering && !config.unix_socket_path.empty()) {
+    throw std::runtime_error(
+        "'reuseport_cpu_steering' is not applicable to 'unix-socket' in " +
+        value.GetPath());
+  }
+
   if (config.backlog <= 0) {
     throw std::runtime_error("Invalid backlog value in " + value.GetPath());
   }
@@ -62,6 +79,9 @@ ListenerConfig Parse(const yaml_config::YamlConfig& value,
     config.tls_certificate_authorities.push_back(
         crypto::Certificate::LoadFromString(contents));
   }
+  config.tls_settings.enable_ktls = value["tls"]["ktls"].As<bool>(false);
+  config.tls_settings.enable_session_resumption =
+      value["tls"]["session-resumption"].As<bool>(true);
 
   return config;
 }
@@ -5,6 +5,7 @@
 
 #include <userver/crypto/certificate.hpp>
 #include <userver/crypto/private_key.hpp>
+#include <userver/engine/io/tls_wrapper.hpp>
 #include <userver/server/request/request_config.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
@@ -22,6 +23,7 @@ struct ListenerConfig {
   int backlog = 1024;  // truncated to net.core.somaxconn
   size_t max_connections = 32768;
   std::optional<size_t> shards;
+  bool reuseport_cpu_steering{false};
   std::string task_processor;
 
   bool tls{false};
@@ -30,6 +32,7 @@ struct ListenerConfig {
   std::string tls_private_key_passphrase_name;
   crypto::PrivateKey tls_private_key;
   std::vector<crypto::Certificate> tls_certificate_authorities;
+  engine::io::TlsSettings tls_settings;
 };
 
 ListenerConfig Parse(const yaml_config::YamlConfig& value,
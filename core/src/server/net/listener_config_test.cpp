@@ -0,0 +1,74 @@
+#include <server/net/listener_config.hpp>
+
+#include <stdexcept>
+
+#include <userver/formats/yaml/serialize.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+server::net::ListenerConfig ParseConfig(const std::string& yaml) {
+  const yaml_config::YamlConfig config{formats::yaml::FromString(yaml), {}};
+  return config.As<server::net::ListenerConfig>();
+}
+
+}  // namespace
+
+TEST(ListenerConfig, Shards) {
+  const auto config = ParseConfig(R"(
+    port: 8080
+    task_processor: main-task-processor
+    shards: 4
+    reuseport_cpu_steering: true
+  )");
+  EXPECT_EQ(config.port, 8080);
+  EXPECT_EQ(config.shards, 4);
+  EXPECT_TRUE(config.reuseport_cpu_steering);
+}
+
+TEST(ListenerConfig, DefaultShards) {
+  const auto config = ParseConfig(R"(
+    port: 8080
+    task_processor: main-task-processor
+  )");
+  EXPECT_FALSE(config.shards);
+  EXPECT_FALSE(config.reuseport_cpu_steering);
+}
+
+TEST(ListenerConfig, ZeroShards) {
+  UEXPECT_THROW(ParseConfig(R"(
+    port: 8080
+    task_processor: main-task-processor
+    shards: 0
+  )"),
+                std::runtime_error);
+}
+
+TEST(ListenerConfig, UnixSocketShards) {
+  const auto config = ParseConfig(R"(
+    unix-socket: /tmp/listener.sock
+    task_processor: main-task-processor
+    shards: 1
+  )");
+  EXPECT_EQ(config.shards, 1);
+
+  UEXPECT_THROW(ParseConfig(R"(
+    unix-socket: /tmp/listener.sock
+    task_processor: main-task-processor
+    shards: 2
+  )"),
+                std::runtime_error);
+}
+
+TEST(ListenerConfig, UnixSocketCpuSteering) {
+  UEXPECT_THROW(ParseConfig(R"(
+    unix-socket: /tmp/listener.sock
+    task_processor: main-task-processor
+    reuseport_cpu_steering: true
+  )"),
+                std::runtime_error);
+}
+
+USERVER_NAMESPACE_END
@@ -103,7 +103,7 @@ void ListenerImpl::ProcessConnection(engine::io::Socket peer_socket) {
     socket = std::make_unique<engine::io::TlsWrapper>(
         engine::io::TlsWrapper::StartTlsServer(
             std::move(peer_socket), config.tls_cert, config.tls_private_key, {},
-            config.tls_certificate_authorities));
+            config.tls_certificate_authorities, config.tls_settings));
   } else {
     socket = std::make_unique<engine::io::Socket>(std::move(peer_socket));
   }
@@ -27,6 +27,10 @@ struct Stats {
       : active_connections(other.active_connections.load()),
         connections_created(other.connections_created.load()),
         connections_closed(other.connections_closed.load()),
+        connections_drained(other.connections_drained.load()),
+        idle_connections(other.idle_connections.load()),
+        idle_connections_buffers_size(
+            other.idle_connections_buffers_size.load()),
         parser_stats(other.parser_stats),
         active_request_count(other.active_request_count.load()),
         requests_processed_count(other.requests_processed_count.load()) {}
@@ -37,6 +41,12 @@ struct Stats {
   std::atomic<size_t> active_connections{0};
   std::atomic<size_t> connections_created{0};
   std::atomic<size_t> connections_closed{0};
+  // Connections closed by the server to spread the load over the instances
+  std::atomic<size_t> connections_drained{0};
+  // Connections that wait for the next request with no requests in flight
+  std::atomic<size_t> idle_connections{0};
+  // Bytes of the read buffers held by the idle connections
+  std::atomic<size_t> idle_connections_buffers_size{0};
 
   // per connection
   ParserStats parser_stats;
@@ -48,6 +58,9 @@ inline Stats& operator+=(Stats& lhs, const Stats& rhs) {
   lhs.active_connections += rhs.active_connections;
   lhs.connections_created += rhs.connections_created;
   lhs.connections_closed += rhs.connections_closed;
+  lhs.connections_drained += rhs.connections_drained;
+  lhs.idle_connections += rhs.idle_connections;
+  lhs.idle_connections_buffers_size += rhs.idle_connections_buffers_size;
 
   lhs.parser_stats += rhs.parser_stats;
   lhs.active_request_count += rhs.active_request_count;
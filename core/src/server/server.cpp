@@ -39,6 +39,8 @@ struct PortInfo final {
   bool IsRunning() const noexcept;
 
   std::optional<http::HttpRequestHandler> request_handler_;
+  // With `shards` resolved, referenced by endpoint_info_
+  net::ListenerConfig listener_config_;
   std::shared_ptr<net::EndpointInfo> endpoint_info_;
   request::ResponseDataAccounter data_accounter_;
   std::vector<net::Listener> listeners_;
@@ -57,13 +59,19 @@ void PortInfo::Init(const ServerConfig& config,
                            config.logger_access_tskv, is_monitor,
                            config.server_name);
 
-  endpoint_info_ =
-      std::make_shared<net::EndpointInfo>(listener_config, *request_handler_);
+  listener_config_ = listener_config;
+  if (!listener_config_.unix_socket_path.empty()) {
+    // More shards are rejected by the config parser
+    listener_config_.shards = 1;
+  } else if (!listener_config_.shards) {
+    // One SO_REUSEPORT socket per ev thread
+    listener_config_.shards = task_processor.EventThreadPool().GetSize();
+  }
 
-  const auto& event_thread_pool = task_processor.EventThreadPool();
-  size_t listener_shards = listener_config.shards ? *listener_config.shards
-                                                  : event_thread_pool.GetSize();
+  endpoint_info_ =
+      std::make_shared<net::EndpointInfo>(listener_config_, *request_handler_);
 
+  size_t listener_shards = *listener_config_.shards;
   listeners_.reserve(listener_shards);
   while (listener_shards--) {
     listeners_.emplace_back(endpoint_info_, task_processor, data_accounter_);
@@ -123,6 +131,7 @@ class ServerImpl final {
 
   void SetRpsRatelimitStatusCode(http::HttpStatus status_code);
   void SetRpsRatelimit(std::optional<size_t> rps);
+  void SetThrottlingShedLevel(std::size_t shed_level);
 
  private:
   PortInfo main_port_info_;
@@ -275,6 +284,10 @@ void Server::SetLimit(std::optional<size_t> new_limit) {
   SetRpsRatelimit(new_limit);
 }
 
+void Server::SetShedLevel(std::size_t shed_level) {
+  pimpl->SetThrottlingShedLevel(shed_level);
+}
+
 void ServerImpl::WriteTotalHandlerStatistics(
     utils::statistics::Writer& writer) const {
   handlers::HttpHandlerStatisticsSnapshot total;
@@ -311,6 +324,11 @@ void ServerImpl::SetRpsRatelimit(std::optional<size_t> rps) {
   main_port_info_.request_handler_->SetRpsRatelimit(rps);
 }
 
+void ServerImpl::SetThrottlingShedLevel(std::size_t shed_level) {
+  UASSERT(main_port_info_.request_handler_);
+  main_port_info_.request_handler_->SetThrottlingShedLevel(shed_level);
+}
+
 Server::Server(ServerConfig config,
                const storages::secdist::SecdistConfig& secdist,
                const components::ComponentContext& component_context)
@@ -329,6 +347,10 @@ void Server::WriteMonitorData(utils::statistics::Writer& writer) const {
     conn_stats["active"] = server_stats.active_connections;
     conn_stats["opened"] = server_stats.connections_created;
     conn_stats["closed"] = server_stats.connections_closed;
+    conn_stats["drained"] = server_stats.connections_drained;
+    conn_stats["idle"] = server_stats.idle_connections;
+    conn_stats["idle-buffers-bytes"] =
+        server_stats.idle_connections_buffers_size;
   }
 
   if (auto request_stats = writer["requests"]) {
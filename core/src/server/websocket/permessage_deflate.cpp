@@ -0,0 +1,248 @@
+#include <server/websocket/permessage_deflate.hpp>
+
+#include <algorithm>
+#include <limits>
+
+#include <fmt/format.h>
+
+#include <compression/error.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+namespace {
+
+constexpr std::string_view kExtensionName = "permessage-deflate";
+
+// zlib does not support 8 bits window for raw deflate streams
+constexpr int kMinWindowBits = 9;
+constexpr int kMaxWindowBits = 15;
+constexpr int kMemLevel = 8;
+
+constexpr std::size_t kMinBufferSize = 256;
+
+// Removed from the end of each compressed message,
+// https://datatracker.ietf.org/doc/html/rfc7692#section-7.2.1
+constexpr std::string_view kMessageTail{"\x00\x00\xff\xff", 4};
+
+std::string_view Trim(std::string_view str) noexcept {
+  constexpr std::string_view kWhitespace = " \t";
+  const auto begin = str.find_first_not_of(kWhitespace);
+  if (begin == std::string_view::npos) return {};
+  const auto end = str.find_last_not_of(kWhitespace);
+  return str.substr(begin, end - begin + 1);
+}
+
+std::string_view Unquote(std::string_view value) noexcept {
+  if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+    return value.substr(1, value.size() - 2);
+  }
+  return value;
+}
+
+std::optional<int> ParseWindowBits(std::string_view value) noexcept {
+  if (value.empty() || value.size() > 2) return std::nullopt;
+  int result = 0;
+  for (const char c : value) {
+    if (c < '0' || c > '9') return std::nullopt;
+    result = result * 10 + (c - '0');
+  }
+  if (result < 8 || result > kMaxWindowBits) return std::nullopt;
+  return result;
+}
+
+// Returns std::nullopt for offers of other extensions and for the offers
+// with unknown, duplicate or unsupported parameters
+std::optional<DeflateConfig> ParseOffer(std::string_view offer) {
+  auto params_pos = offer.find(';');
+  if (Trim(offer.substr(0, params_pos)) != kExtensionName) return std::nullopt;
+
+  DeflateConfig config;
+  bool has_client_max_window_bits = false;
+  while (params_pos != std::string_view::npos) {
+    offer = offer.substr(params_pos + 1);
+    params_pos = offer.find(';');
+    const auto param = Trim(offer.substr(0, params_pos));
+
+    const auto eq_pos = param.find('=');
+    const auto name = Trim(param.substr(0, eq_pos));
+    std::optional<std::string_view> value;
+    if (eq_pos != std::string_view::npos) {
+      value = Unquote(Trim(param.substr(eq_pos + 1)));
+    }
+
+    if (name == "server_no_context_takeover") {
+      if (value || config.server_no_context_takeover) return std::nullopt;
+      config.server_no_context_takeover = true;
+    } else if (name == "client_no_context_takeover") {
+      if (value || config.client_no_context_takeover) return std::nullopt;
+      config.client_no_context_takeover = true;
+    } else if (name == "server_max_window_bits") {
+      if (!value || config.server_max_window_bits) return std::nullopt;
+      const auto bits = ParseWindowBits(*value);
+      if (!bits || *bits < kMinWindowBits) return std::nullopt;
+      config.server_max_window_bits = bits;
+    } else if (name == "client_max_window_bits") {
+      // The client may use any window, ours is the largest one
+      if (has_client_max_window_bits) return std::nullopt;
+      if (value && !ParseWindowBits(*value)) return std::nullopt;
+      has_client_max_window_bits = true;
+    } else {
+      return std::nullopt;
+    }
+  }
+  return config;
+}
+
+}  // namespace
+
+std::optional<DeflateConfig> NegotiateDeflate(std::string_view extensions) {
+  std::size_t pos = 0;
+  while (pos < extensions.size()) {
+    auto end = extensions.find(',', pos);
+    if (end == std::string_view::npos) end = extensions.size();
+    auto config = ParseOffer(extensions.substr(pos, end - pos));
+    if (config) return config;
+    pos = end + 1;
+  }
+  return std::nullopt;
+}
+
+std::string MakeDeflateExtensionHeader(const DeflateConfig& config) {
+  std::string result{kExtensionName};
+  if (config.server_no_context_takeover) {
+    result += "; server_no_context_takeover";
+  }
+  if (config.client_no_context_takeover) {
+    result += "; client_no_context_takeover";
+  }
+  if (config.server_max_window_bits) {
+    result += fmt::format("; server_max_window_bits={}",
+                          *config.server_max_window_bits);
+  }
+  return result;
+}
+
+MessageDeflater::MessageDeflater(const DeflateConfig& config)
+    : no_context_takeover_(config.server_no_context_takeover) {
+  const auto window_bits =
+      config.server_max_window_bits.value_or(kMaxWindowBits);
+  // Negative window bits for raw deflate stream without the zlib header
+  const auto ret = deflateInit2(&stream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                                -window_bits, kMemLevel, Z_DEFAULT_STRATEGY);
+  if (ret != Z_OK) {
+    throw compression::CompressionError(fmt::format(
+        "failed to initialize permessage-deflate compression, zlib error {}",
+        ret));
+  }
+}
+
+MessageDeflater::~MessageDeflater() { deflateEnd(&stream_); }
+
+void MessageDeflater::Compress(std::string_view data, std::string& out) {
+  if (data.size() > std::numeric_limits<uInt>::max()) {
+    throw compression::CompressionError(
+        "too large message for permessage-deflate compression");
+  }
+  out.clear();
+
+  // zlib does not modify the input
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream_.avail_in = static_cast<uInt>(data.size());
+
+  while (true) {
+    const auto old_size = out.size();
+    const auto buffer_size = std::max<std::size_t>(
+        deflateBound(&stream_, stream_.avail_in), kMinBufferSize);
+    out.resize(old_size + buffer_size);
+    stream_.next_out = reinterpret_cast<Bytef*>(out.data() + old_size);
+    stream_.avail_out = static_cast<uInt>(buffer_size);
+
+    const auto ret = deflate(&stream_, Z_SYNC_FLUSH);
+    out.resize(out.size() - stream_.avail_out);
+
+    if (ret != Z_OK && ret != Z_BUF_ERROR) {
+      throw compression::CompressionError(fmt::format(
+          "failed to compress websocket message, zlib error {}", ret));
+    }
+    if (stream_.avail_out != 0) break;
+  }
+
+  // Sync flush always ends with the empty stored block
+  if (out.size() >= kMessageTail.size() &&
+      std::string_view{out}.substr(out.size() - kMessageTail.size()) ==
+          kMessageTail) {
+    out.resize(out.size() - kMessageTail.size());
+  }
+  // Nothing is flushed for an empty message, send an empty stored block
+  if (out.empty()) out.push_back('\0');
+  if (no_context_takeover_) deflateReset(&stream_);
+}
+
+MessageInflater::MessageInflater(const DeflateConfig& config)
+    : no_context_takeover_(config.client_no_context_takeover) {
+  const auto ret = inflateInit2(&stream_, -kMaxWindowBits);
+  if (ret != Z_OK) {
+    throw compression::DecompressionError(fmt::format(
+        "failed to initialize permessage-deflate decompression, zlib error {}",
+        ret));
+  }
+}
+
+MessageInflater::~MessageInflater() { inflateEnd(&stream_); }
+
+void MessageInflater::Decompress(std::string_view data, std::string& out,
+                                 std::size_t max_size) {
+  if (data.size() > std::numeric_limits<uInt>::max()) {
+    throw compression::TooBigError();
+  }
+  out.clear();
+  // Not a valid deflate data, but may be sent for an empty message
+  if (data.empty()) return;
+
+  Inflate(data, out, max_size);
+  Inflate(kMessageTail, out, max_size);
+  if (no_context_takeover_) inflateReset(&stream_);
+}
+
+void MessageInflater::Inflate(std::string_view data, std::string& out,
+                              std::size_t max_size) {
+  // zlib does not modify the input
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream_.avail_in = static_cast<uInt>(data.size());
+
+  while (true) {
+    const auto old_size = out.size();
+    // One byte over the limit to detect too big messages
+    const auto buffer_size = std::min<std::size_t>(
+        {std::max(data.size() * 2, kMinBufferSize), max_size + 1 - old_size,
+         std::numeric_limits<uInt>::max()});
+    out.resize(old_size + buffer_size);
+    stream_.next_out = reinterpret_cast<Bytef*>(out.data() + old_size);
+    stream_.avail_out = static_cast<uInt>(buffer_size);
+
+    const auto ret = inflate(&stream_, Z_SYNC_FLUSH);
+    out.resize(out.size() - stream_.avail_out);
+    if (out.size() > max_size) throw compression::TooBigError();
+
+    if (ret == Z_STREAM_END) {
+      // The client ended the stream with a final block, the next message
+      // starts a new one
+      inflateReset(&stream_);
+      stream_.avail_in = 0;
+      return;
+    }
+    if (ret != Z_OK && ret != Z_BUF_ERROR) {
+      throw compression::DecompressionError(fmt::format(
+          "failed to decompress websocket message, zlib error {}", ret));
+    }
+    if (stream_.avail_in == 0 && stream_.avail_out != 0) return;
+  }
+}
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
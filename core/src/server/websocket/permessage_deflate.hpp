@@ -0,0 +1,70 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <zlib.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::websocket::impl {
+
+/// Parameters of the permessage-deflate extension,
+/// https://datatracker.ietf.org/doc/html/rfc7692#section-7
+struct DeflateConfig final {
+  bool server_no_context_takeover{false};
+  bool client_no_context_takeover{false};
+  std::optional<int> server_max_window_bits;
+};
+
+/// Returns the parameters of the first acceptable permessage-deflate offer
+/// from the `Sec-WebSocket-Extensions` request header
+std::optional<DeflateConfig> NegotiateDeflate(std::string_view extensions);
+
+/// `Sec-WebSocket-Extensions` response header value accepting the offer
+std::string MakeDeflateExtensionHeader(const DeflateConfig& config);
+
+/// Compresses the messages sent by the server
+class MessageDeflater final {
+ public:
+  explicit MessageDeflater(const DeflateConfig& config);
+  ~MessageDeflater();
+
+  MessageDeflater(const MessageDeflater&) = delete;
+  MessageDeflater& operator=(const MessageDeflater&) = delete;
+
+  /// Replaces `out` with the compressed message payload
+  /// @throws compression::CompressionError
+  void Compress(std::string_view data, std::string& out);
+
+ private:
+  z_stream stream_{};
+  const bool no_context_takeover_;
+};
+
+/// Decompresses the messages sent by the client
+class MessageInflater final {
+ public:
+  explicit MessageInflater(const DeflateConfig& config);
+  ~MessageInflater();
+
+  MessageInflater(const MessageInflater&) = delete;
+  MessageInflater& operator=(const MessageInflater&) = delete;
+
+  /// Replaces `out` with the decompressed message payload
+  /// @throws compression::TooBigError if the result exceeds `max_size`
+  /// @throws compression::DecompressionError
+  void Decompress(std::string_view data, std::string& out,
+                  std::size_t max_size);
+
+ private:
+  void Inflate(std::string_view data, std::string& out, std::size_t max_size);
+
+  z_stream stream_{};
+  const bool no_context_takeover_;
+};
+
+}  // namespace server::websocket::impl
+
+USERVER_NAMESPACE_END
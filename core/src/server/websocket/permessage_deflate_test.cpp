@@ -0,0 +1,91 @@
+#include <server/websocket/permessage_deflate.hpp>
+
+#include <gtest/gtest.h>
+
+#include <compression/error.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+using server::websocket::impl::DeflateConfig;
+using server::websocket::impl::MakeDeflateExtensionHeader;
+using server::websocket::impl::MessageDeflater;
+using server::websocket::impl::MessageInflater;
+using server::websocket::impl::NegotiateDeflate;
+
+TEST(PermessageDeflate, Negotiate) {
+  EXPECT_FALSE(NegotiateDeflate(""));
+  EXPECT_FALSE(NegotiateDeflate("x-webkit-deflate-frame"));
+
+  auto config = NegotiateDeflate("permessage-deflate");
+  ASSERT_TRUE(config);
+  EXPECT_EQ(MakeDeflateExtensionHeader(*config), "permessage-deflate");
+
+  config = NegotiateDeflate(
+      "permessage-deflate; client_max_window_bits; "
+      "server_no_context_takeover");
+  ASSERT_TRUE(config);
+  EXPECT_EQ(MakeDeflateExtensionHeader(*config),
+            "permessage-deflate; server_no_context_takeover");
+
+  config = NegotiateDeflate(
+      "permessage-deflate; server_max_window_bits=\"10\"; "
+      "client_no_context_takeover");
+  ASSERT_TRUE(config);
+  EXPECT_EQ(MakeDeflateExtensionHeader(*config),
+            "permessage-deflate; client_no_context_takeover; "
+            "server_max_window_bits=10");
+}
+
+TEST(PermessageDeflate, NegotiateFallback) {
+  // zlib can not use the 8 bits window, the next offer is accepted
+  auto config = NegotiateDeflate(
+      "permessage-deflate; server_max_window_bits=8, permessage-deflate");
+  ASSERT_TRUE(config);
+  EXPECT_FALSE(config->server_max_window_bits);
+
+  EXPECT_FALSE(NegotiateDeflate("permessage-deflate; unknown_param"));
+  EXPECT_FALSE(NegotiateDeflate(
+      "permessage-deflate; server_no_context_takeover; "
+      "server_no_context_takeover"));
+  EXPECT_FALSE(NegotiateDeflate("permessage-deflate; server_max_window_bits"));
+  EXPECT_FALSE(
+      NegotiateDeflate("permessage-deflate; client_max_window_bits=16"));
+}
+
+TEST(PermessageDeflate, RoundTrip) {
+  for (const bool no_context_takeover : {false, true}) {
+    DeflateConfig config;
+    config.server_no_context_takeover = no_context_takeover;
+    config.client_no_context_takeover = no_context_takeover;
+    MessageDeflater deflater{config};
+    MessageInflater inflater{config};
+
+    std::string compressed;
+    std::string decompressed;
+    for (const std::string message :
+         {std::string(10000, 'a'), std::string{"hello"}, std::string{},
+          std::string(10000, 'a')}) {
+      deflater.Compress(message, compressed);
+      inflater.Decompress(compressed, decompressed, 65536);
+      EXPECT_EQ(decompressed, message);
+    }
+  }
+}
+
+TEST(PermessageDeflate, TooBig) {
+  const DeflateConfig config;
+  MessageDeflater deflater{config};
+  MessageInflater inflater{config};
+
+  std::string compressed;
+  std::string decompressed;
+  deflater.Compress(std::string(100000, 'a'), compressed);
+  EXPECT_THROW(inflater.Decompress(compressed, decompressed, 65536),
+               compression::TooBigError);
+
+  MessageInflater other_inflater{config};
+  EXPECT_THROW(other_inflater.Decompress("garbage", decompressed, 65536),
+               compression::DecompressionError);
+}
+
+USERVER_NAMESPACE_END
@@ -40,13 +40,16 @@ union Mask32 {
 };
 
 void XorMaskInplace(uint8_t* dest, size_t len, Mask32 mask) {
-  auto* dest32 = reinterpret_cast<uint32_t*>(dest);
+  // dest may be unaligned when a continuation frame is appended to a message
   while (len >= sizeof(uint32_t)) {
-    *(dest32++) ^= mask.mask32;
+    uint32_t value = 0;
+    std::memcpy(&value, dest, sizeof(value));
+    value ^= mask.mask32;
+    std::memcpy(dest, &value, sizeof(value));
+    dest += sizeof(uint32_t);
     len -= sizeof(uint32_t);
   }
-  auto* dest8 = reinterpret_cast<uint8_t*>(dest32);
-  for (unsigned i = 0; i < len; ++i) *(dest8++) ^= mask.mask8[i];
+  for (unsigned i = 0; i < len; ++i) *(dest++) ^= mask.mask8[i];
 }
 
 template <class T, class V>
@@ -61,7 +64,7 @@ namespace frames {
 
 boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
     utils::span<const std::byte> data, bool is_text,
-    Continuation is_continuation, Final is_final) {
+    Continuation is_continuation, Final is_final, Compressed is_compressed) {
   boost::container::small_vector<char, impl::kMaxFrameHeaderSize> frame;
 
   frame.resize(sizeof(WSHeader));
@@ -73,7 +76,11 @@ boost::container::small_vector<char, impl::kMaxFrameHeaderSize> DataFrameHeader(
   hdr->bytes = 0;
   hdr->bits.fin = is_final == Final::kYes ? 1 : 0;
   hdr->bits.opcode = is_text ? kText : kBinary;
-  if (is_continuation == Continuation::kYes) hdr->bits.opcode = kContinuation;
+  if (is_continuation == Continuation::kYes) {
+    hdr->bits.opcode = kContinuation;
+  } else if (is_compressed == Compressed::kYes) {
+    hdr->bits.reserved = kReservedCompressed;
+  }
 
   if (data.size() <= 125) {
     hdr->bits.payloadLen = data.size();
@@ -178,6 +185,15 @@ CloseStatus ReadWSFrame(FrameParserState& frame, engine::io::ReadableBase& io,
     return CloseStatus::kProtocolError;
   }
 
+  if (hdr.bits.reserved != 0) {
+    // only the first frame of a data message may be marked as compressed
+    if (hdr.bits.reserved != kReservedCompressed || !frame.deflate_enabled ||
+        !isDataFrame || hdr.bits.opcode == kContinuation) {
+      return CloseStatus::kProtocolError;
+    }
+    frame.is_compressed = true;
+  }
+
   if (payload_len + frame.payload->size() > max_payload_size)
     return CloseStatus::kTooBigData;
 
@@ -201,8 +217,9 @@ CloseStatus ReadWSFrame(FrameParserState& frame, engine::io::ReadableBase& io,
     if (engine::current_task::ShouldCancel()) return CloseStatus::kGoingAway;
 
     if (mask.mask32)
-      XorMaskInplace(reinterpret_cast<uint8_t*>(frame.payload->data()),
-                     frame.payload->size(), mask);
+      XorMaskInplace(
+          reinterpret_cast<uint8_t*>(frame.payload->data() + newPayloadOffset),
+          payload_len, mask);
   }
   char opcode = hdr.bits.opcode;
   char fin = hdr.bits.fin;
@@ -1,7 +1,9 @@
 #include <userver/server/websocket/server.hpp>
 
+#include <compression/error.hpp>
 #include <userver/components/component.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/async.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
@@ -14,6 +16,10 @@ USERVER_NAMESPACE_BEGIN
 namespace server::websocket {
 
 namespace {
+
+// Compressing smaller messages is not worth the CPU
+constexpr std::size_t kMinCompressedMessageSize = 64;
+
 inline void SendExactly(engine::io::WritableBase& writable,
                         utils::span<const char> data1,
                         utils::span<const std::byte> data2) {
@@ -29,6 +35,10 @@ utils::span<const std::byte> MakeBinarySpan(utils::span<const char> span) {
   return utils::as_bytes(span);
 }
 
+std::string_view AsStringView(utils::span<const std::byte> span) {
+  return {reinterpret_cast<const char*>(span.data()), span.size()};
+}
+
 }  // namespace
 
 Config Parse(const yaml_config::YamlConfig& config,
@@ -36,9 +46,20 @@ Config Parse(const yaml_config::YamlConfig& config,
   return {
       config["max-remote-payload"].As<unsigned>(65536),
       config["fragment-size"].As<unsigned>(65536),
+      config["permessage-deflate"].As<bool>(false),
   };
 }
 
+PreparedMessage::PreparedMessage(std::string_view data, bool is_text)
+    : payload_size_(data.size()) {
+  const auto data_frame_header = impl::frames::DataFrameHeader(
+      MakeBinarySpan(data), is_text, impl::frames::Continuation::kNo,
+      impl::frames::Final::kYes);
+  frame_.reserve(data_frame_header.size() + data.size());
+  frame_.append(data_frame_header.data(), data_frame_header.size());
+  frame_.append(data);
+}
+
 class WebSocketConnectionImpl final : public WebSocketConnection {
  public:
  private:
@@ -64,11 +85,31 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
 
   Config config;
 
+  // permessage-deflate state, compressed_ is guarded by write_mutex_ and
+  // inflated_ is used by Recv() only
+  std::unique_ptr<impl::MessageDeflater> deflater_;
+  std::unique_ptr<impl::MessageInflater> inflater_;
+  std::string compressed_;
+  std::string inflated_;
+
+  void FailConnection(CloseStatus status, Message& msg) {
+    MessageExtended close_msg{{}, impl::WSOpcodes::kClose, status};
+    SendExtended(close_msg);
+    msg = CloseMessage(status);
+  }
+
  public:
-  WebSocketConnectionImpl(std::unique_ptr<engine::io::RwBase> io_,
-                          const engine::io::Sockaddr& remote_addr,
-                          const Config& server_config)
-      : io(std::move(io_)), remote_addr_(remote_addr), config(server_config) {}
+  WebSocketConnectionImpl(
+      std::unique_ptr<engine::io::RwBase> io_,
+      const engine::io::Sockaddr& remote_addr, const Config& server_config,
+      const std::optional<impl::DeflateConfig>& deflate_config)
+      : io(std::move(io_)), remote_addr_(remote_addr), config(server_config) {
+    if (deflate_config) {
+      deflater_ = std::make_unique<impl::MessageDeflater>(*deflate_config);
+      inflater_ = std::make_unique<impl::MessageInflater>(*deflate_config);
+      frame_.deflate_enabled = true;
+    }
+  }
 
   ~WebSocketConnectionImpl() override {
     LOG_TRACE() << "Websocket connection closed";
@@ -93,13 +134,20 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
       SendExactly(*io, close_frame, {});
     } else if (!message.data.empty()) {
       utils::span<const std::byte> data_to_send{message.data};
+      auto is_compressed = impl::frames::Compressed::kNo;
+      if (deflater_ && message.data.size() >= kMinCompressedMessageSize) {
+        deflater_->Compress(AsStringView(message.data), compressed_);
+        data_to_send = MakeBinarySpan(compressed_);
+        is_compressed = impl::frames::Compressed::kYes;
+      }
+
       auto continuation = impl::frames::Continuation::kNo;
       while (data_to_send.size() > config.fragment_size &&
              config.fragment_size > 0) {
         const auto data_frame_header = impl::frames::DataFrameHeader(
             data_to_send.first(config.fragment_size),
             message.opcode == impl::WSOpcodes::kText, continuation,
-            impl::frames::Final::kNo);
+            impl::frames::Final::kNo, is_compressed);
         SendExactly(*io, data_frame_header,
                     data_to_send.first(config.fragment_size));
         continuation = impl::frames::Continuation::kYes;
@@ -108,7 +156,7 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
       }
       const auto data_frame_header = impl::frames::DataFrameHeader(
           data_to_send, message.opcode == impl::WSOpcodes::kText, continuation,
-          impl::frames::Final::kYes);
+          impl::frames::Final::kYes, is_compressed);
       SendExactly(*io, data_frame_header, data_to_send);
     }
   }
@@ -131,10 +179,21 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
     SendExtended(mext);
   }
 
+  void SendPrepared(const PreparedMessage& message) override {
+    stats_.msg_sent++;
+    stats_.bytes_sent += message.PayloadSize();
+
+    const std::unique_lock lock(write_mutex_);
+    LOG_TRACE() << "Write prepared message " << message.PayloadSize()
+                << " bytes";
+    SendExactly(*io, message.frame_, {});
+  }
+
   void Recv(Message& msg) override {
     msg.data.resize(0);  // do not call .clear() to keep the allocated memory
     frame_.payload = &msg.data;
     frame_.payload->resize(0);
+    frame_.is_compressed = false;
 
     try {
       while (true) {
@@ -150,9 +209,7 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
             frame_.is_text, frame_.closed, frame_.payload->size(), status,
             frame_.waiting_continuation);
         if (status != 0) {
-          MessageExtended close_msg{{}, impl::WSOpcodes::kClose, status_raw};
-          SendExtended(close_msg);
-          msg = CloseMessage(status_raw);
+          FailConnection(status_raw, msg);
           return;
         }
 
@@ -176,6 +233,22 @@ class WebSocketConnectionImpl final : public WebSocketConnection {
         }
         if (frame_.waiting_continuation) continue;
 
+        if (frame_.is_compressed) {
+          try {
+            inflater_->Decompress(msg.data, inflated_,
+                                  config.max_remote_payload);
+          } catch (const compression::TooBigError&) {
+            FailConnection(CloseStatus::kTooBigData, msg);
+            return;
+          } catch (const compression::DecompressionError& e) {
+            LOG_TRACE() << "Failed to decompress websocket message: " << e;
+            FailConnection(CloseStatus::kBadMessageData, msg);
+            return;
+          }
+          // keeps both buffers for the next messages
+          std::swap(msg.data, inflated_);
+        }
+
         msg.is_text = frame_.is_text;
         stats_.msg_recv++;
         stats_.bytes_recv += msg.data.size();
@@ -215,13 +288,42 @@ WebSocketConnection::WebSocketConnection() = default;
 
 WebSocketConnection::~WebSocketConnection() = default;
 
+std::size_t Broadcast(const PreparedMessage& message,
+                      utils::span<WebSocketConnection* const> connections) {
+  std::size_t sent = 0;
+  for (auto* connection : connections) {
+    if (engine::current_task::ShouldCancel()) break;
+    try {
+      connection->SendPrepared(message);
+      ++sent;
+    } catch (const engine::io::IoException& e) {
+      LOG_WARNING() << "Failed to send websocket message to "
+                    << connection->RemoteAddr().PrimaryAddressString() << ": "
+                    << e;
+    }
+  }
+  return sent;
+}
+
 std::shared_ptr<WebSocketConnection> MakeWebSocket(
     std::unique_ptr<engine::io::RwBase>&& socket,
     engine::io::Sockaddr&& peer_name, const Config& config) {
+  return impl::MakeWebSocket(std::move(socket), std::move(peer_name), config,
+                             std::nullopt);
+}
+
+namespace impl {
+
+std::shared_ptr<WebSocketConnection> MakeWebSocket(
+    std::unique_ptr<engine::io::RwBase>&& socket,
+    engine::io::Sockaddr&& peer_name, const Config& config,
+    const std::optional<DeflateConfig>& deflate_config) {
   return std::make_shared<WebSocketConnectionImpl>(
-      std::move(socket), std::move(peer_name), config);
+      std::move(socket), std::move(peer_name), config, deflate_config);
 }
 
+}  // namespace impl
+
 }  // namespace server::websocket
 
 USERVER_NAMESPACE_END
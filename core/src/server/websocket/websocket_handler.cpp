@@ -63,6 +63,17 @@ std::string WebsocketHandlerBase::HandleRequestThrow(
 
   if (!HandleHandshake(request, response, context)) return "";
 
+  std::optional<websocket::impl::DeflateConfig> deflate_config;
+  if (config_.permessage_deflate) {
+    deflate_config = websocket::impl::NegotiateDeflate(request.GetHeader(
+        USERVER_NAMESPACE::http::headers::kWebsocketExtensions));
+    if (deflate_config) {
+      response.SetHeader(
+          USERVER_NAMESPACE::http::headers::kWebsocketExtensions,
+          websocket::impl::MakeDeflateExtensionHeader(*deflate_config));
+    }
+  }
+
   response.SetStatus(server::http::HttpStatus::kSwitchingProtocols);
   response.SetHeader(USERVER_NAMESPACE::http::headers::kConnection, "Upgrade");
   response.SetHeader(USERVER_NAMESPACE::http::headers::kUpgrade, "websocket");
@@ -72,11 +83,12 @@ std::string WebsocketHandlerBase::HandleRequestThrow(
   request.SetUpgradeWebsocket(
       [context = std::make_shared<server::request::RequestContext>(
            std::move(context)),
+       deflate_config,
        this](std::unique_ptr<engine::io::RwBase> socket,
              engine::io::Sockaddr&& peer_name) {
         tracing::Span span("ws/" + HandlerName());
-        auto ws = websocket::MakeWebSocket(std::move(socket),
-                                           std::move(peer_name), config_);
+        auto ws = websocket::impl::MakeWebSocket(
+            std::move(socket), std::move(peer_name), config_, deflate_config);
         try {
           Handle(*ws, *context);
         } catch (const std::exception& e) {
@@ -112,6 +124,10 @@ properties:
         type: integer
         description: max output fragment size
         defaultDescription: 65536
+    permessage-deflate:
+        type: boolean
+        description: accept the permessage-deflate extension offered by the clients to compress the messages
+        defaultDescription: false
 )");
 }
 
@@ -28,6 +28,14 @@ void DumpControl::ReadCacheDumps(const std::vector<std::string>& dumper_names) {
   }
 }
 
+bool DumpControl::WriteSnapshot(const std::string& dumper_name,
+                                dump::Writer& writer) {
+  auto* const dumper = FindDumperOptional(dumper_name);
+  if (!dumper) return false;
+  dumper->WriteSnapshot(writer);
+  return true;
+}
+
 void DumpControl::RegisterDumper(dump::Dumper& dumper) {
   auto dumpers = dumpers_.Lock();
   const auto [_, success] = dumpers->try_emplace(dumper.Name(), &dumper);
@@ -51,6 +59,12 @@ dump::Dumper& DumpControl::FindDumper(const std::string& name) const {
   return *iter->second;
 }
 
+dump::Dumper* DumpControl::FindDumperOptional(const std::string& name) const {
+  const auto dumpers = dumpers_.Lock();
+  const auto iter = dumpers->find(name);
+  return iter == dumpers->end() ? nullptr : iter->second.GetBase();
+}
+
 DumperRegistrationHolder::DumperRegistrationHolder(DumpControl& control,
                                                    dump::Dumper& dumper)
     : control_(control), dumper_(dumper) {
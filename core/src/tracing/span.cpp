@@ -1,16 +1,22 @@
 #include <tracing/span_impl.hpp>
+#include <tracing/tail_sampling.hpp>
 
+#include <new>
 #include <type_traits>
+#include <variant>
+#include <vector>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
 #include <logging/log_helper_impl.hpp>
+#include <userver/compiler/thread_local.hpp>
 #include <userver/engine/task/local_variable.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/encoding/hex.hpp>
@@ -62,6 +68,30 @@ TsBuffer StartTsToString(std::chrono::system_clock::time_point start) {
 // Maintain coro-local span stack to identify "current span" in O(1).
 engine::TaskLocalVariable<SpanStack> task_local_spans;
 
+// Span::Impl is large and is allocated for almost every Span, so its memory
+// is reused instead of going through the allocator each time. Storage freed
+// on another thread simply moves to that thread's cache.
+constexpr std::size_t kMaxCachedImplsPerThread = 64;
+
+struct FreeImpls final {
+  FreeImpls() {
+    // Releasing the storage should not allocate
+    storages.reserve(kMaxCachedImplsPerThread);
+  }
+
+  FreeImpls(FreeImpls&&) = default;
+
+  ~FreeImpls() {
+    for (void* storage : storages) ::operator delete(storage);
+  }
+
+  std::vector<void*> storages;
+};
+
+compiler::ThreadLocal kFreeImpls = [] { return FreeImpls{}; };
+
+static_assert(alignof(Span::Impl) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+
 std::string GenerateSpanId() {
   std::uniform_int_distribution<std::uint64_t> dist;
   const auto random_value = utils::WithDefaultRandom(dist);
@@ -96,10 +126,20 @@ Span::Impl::Impl(TracerPtr tracer, std::string name, const Span::Impl* parent,
   if (parent) {
     log_extra_inheritable_ = parent->log_extra_inheritable_;
     local_log_level_ = parent->local_log_level_;
+    tail_sampling_ = parent->tail_sampling_;
+  } else {
+    tail_sampling_ = impl::StartTailSampledTrace();
+    is_tail_sampling_root_ = tail_sampling_ != nullptr;
   }
 }
 
 Span::Impl::~Impl() {
+  AccountRootSpanCpu();
+
+  if (tail_sampling_ && !TailSample()) {
+    return;
+  }
+
   if (!ShouldLog()) {
     return;
   }
@@ -113,7 +153,8 @@ Span::Impl::~Impl() {
 }
 
 void Span::Impl::PutIntoLogger(logging::impl::TagWriter writer) && {
-  const auto steady_now = std::chrono::steady_clock::now();
+  const auto steady_now =
+      finish_steady_time_.value_or(std::chrono::steady_clock::now());
   const auto duration = steady_now - start_steady_time_;
   const auto total_time_ms =
       std::chrono::duration_cast<RealMilliseconds>(duration).count();
@@ -139,6 +180,39 @@ void Span::Impl::PutIntoLogger(logging::impl::TagWriter writer) && {
   writer.PutLogExtra(log_extra_inheritable_);
 
   LogOpenTracing();
+  ExportOtlp();
+}
+
+bool Span::Impl::TailSample() {
+  // Keeps the trace alive while *this is moved into it
+  const auto trace = std::move(tail_sampling_);
+
+  if (is_tail_sampling_root_) {
+    return trace->Finish(std::chrono::steady_clock::now() - start_steady_time_,
+                         HasErrorTag());
+  }
+
+  if (!ShouldLog()) return false;
+  finish_steady_time_ = std::chrono::steady_clock::now();
+  trace->Add(std::move(*this));
+  return false;
+}
+
+bool Span::Impl::HasErrorTag() const {
+  const auto is_error = [](const logging::LogExtra& tags) {
+    // Boolean tags are stored as integers
+    return std::visit(
+        [](const auto& value) {
+          if constexpr (std::is_arithmetic_v<std::decay_t<decltype(value)>>) {
+            return value != 0;
+          } else {
+            return false;
+          }
+        },
+        tags.GetValue(kErrorFlag));
+  };
+  return is_error(log_extra_inheritable_) ||
+         (log_extra_local_ && is_error(*log_extra_local_));
 }
 
 void Span::Impl::LogTo(logging::impl::TagWriter writer) {
@@ -146,11 +220,28 @@ void Span::Impl::LogTo(logging::impl::TagWriter writer) {
   tracer_->LogSpanContextTo(*this, writer);
 }
 
+void Span::Impl::AccountRootSpanCpu() {
+  if (!is_linked()) return;
+
+  auto* current = engine::current_task::GetCurrentTaskContextUnchecked();
+  if (current == nullptr || !current->HasLocalStorage()) return;
+
+  const auto* spans_ptr = task_local_spans.GetOptional();
+  if (spans_ptr && !spans_ptr->empty() && &spans_ptr->front() == this) {
+    current->AccountSampledCpu(name_);
+    current->SetProfilerSpanName({});
+  }
+}
+
 void Span::Impl::DetachFromCoroStack() { unlink(); }
 
 void Span::Impl::AttachToCoroStack() {
   UASSERT(!is_linked());
-  task_local_spans->push_back(*this);
+  auto& spans = *task_local_spans;
+  if (spans.empty()) {
+    engine::current_task::GetCurrentTaskContext().SetProfilerSpanName(name_);
+  }
+  spans.push_back(*this);
 }
 
 std::string Span::Impl::GetParentIdForLogging(const Span::Impl* parent) {
@@ -189,9 +280,44 @@ bool Span::Impl::ShouldLog() const {
          local_log_level_.value_or(logging::Level::kTrace) <= log_level_;
 }
 
+namespace impl {
+
+void* AllocateImplStorage() {
+  {
+    auto free_impls = kFreeImpls.Use();
+    auto& storages = free_impls->storages;
+    if (!storages.empty()) {
+      void* storage = storages.back();
+      storages.pop_back();
+      return storage;
+    }
+  }
+
+  return ::operator new(sizeof(Span::Impl));
+}
+
+void DeallocateImplStorage(void* storage) noexcept {
+  auto free_impls = kFreeImpls.Use();
+  auto& storages = free_impls->storages;
+  if (storages.size() < kMaxCachedImplsPerThread) {
+    UASSERT(storages.size() < storages.capacity());
+    storages.push_back(storage);
+  } else {
+    ::operator delete(storage);
+  }
+}
+
+}  // namespace impl
+
+void DeleteImpl(Span::Impl* impl) noexcept {
+  // The destructor logs the span, keep the thread-local cache out of it
+  impl->~Impl();
+  impl::DeallocateImplStorage(impl);
+}
+
 void Span::OptionalDeleter::operator()(Span::Impl* impl) const noexcept {
   if (do_delete) {
-    std::default_delete<Impl>{}(impl);
+    DeleteImpl(impl);
   }
 }
 
@@ -391,6 +517,8 @@ const std::string& Span::GetSpanId() const { return pimpl_->GetSpanId(); }
 
 const std::string& Span::GetParentId() const { return pimpl_->GetParentId(); }
 
+const std::string& Span::GetName() const { return pimpl_->GetName(); }
+
 ScopeTime::Duration Span::GetTotalDuration(
     const std::string& scope_name) const {
   return pimpl_->GetTimeStorage().DurationTotal(scope_name);
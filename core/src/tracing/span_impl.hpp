@@ -3,6 +3,8 @@
 #include <chrono>
 #include <list>
 #include <optional>
+#include <memory>
+#include <new>
 #include <string>
 #include <string_view>
 
@@ -27,6 +29,10 @@ namespace tracing {
 inline const std::string kLinkTag = "link";
 inline const std::string kParentLinkTag = "parent_link";
 
+namespace impl {
+class TailSamplingTrace;
+}  // namespace impl
+
 class Span::Impl
     : public boost::intrusive::list_base_hook<
           boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
@@ -57,6 +63,7 @@ class Span::Impl
   const std::string& GetTraceId() const& noexcept { return trace_id_; }
   const std::string& GetSpanId() const& noexcept { return span_id_; }
   const std::string& GetParentId() const& noexcept { return parent_id_; }
+  const std::string& GetName() const noexcept { return name_; }
 
   std::string GetTraceId() && noexcept { return std::move(trace_id_); }
   std::string GetSpanId() && noexcept { return std::move(span_id_); }
@@ -73,6 +80,8 @@ class Span::Impl
 
  private:
   void LogOpenTracing() const;
+  void ExportOtlp() const;
+  std::string ToOtlpSpan() const;
   void DoLogOpenTracing(logging::impl::TagWriter writer) const;
   static void AddOpentracingTags(formats::json::StringBuilder& output,
                                  const logging::LogExtra& input);
@@ -80,6 +89,16 @@ class Span::Impl
   static std::string GetParentIdForLogging(const Span::Impl* parent);
   bool ShouldLog() const;
 
+  // Hands the finished span over to the tail sampling of its trace.
+  // Returns whether the span should be logged right away.
+  bool TailSample();
+  bool HasErrorTag() const;
+  void DiscardLog() noexcept { log_level_ = logging::Level::kNone; }
+
+  // Attributes CPU time of the current task to this span, if it is the root
+  // span of the task
+  void AccountRootSpanCpu();
+
   const std::string name_;
   const bool is_no_log_span_;
   logging::Level log_level_;
@@ -95,6 +114,8 @@ class Span::Impl
 
   const std::chrono::system_clock::time_point start_system_time_;
   const std::chrono::steady_clock::time_point start_steady_time_;
+  // Set for spans that are logged after they have finished
+  std::optional<std::chrono::steady_clock::time_point> finish_steady_time_;
 
   std::string trace_id_;
   std::string span_id_;
@@ -102,7 +123,11 @@ class Span::Impl
   const ReferenceType reference_type_;
   utils::impl::SourceLocation source_location_;
 
+  std::shared_ptr<impl::TailSamplingTrace> tail_sampling_;
+  bool is_tail_sampling_root_{false};
+
   friend class Span;
+  friend class impl::TailSamplingTrace;
   friend class SpanBuilder;
 };
 
@@ -114,11 +139,27 @@ using SpanStack =
 
 const Span::Impl* GetParentSpanImpl();
 
+namespace impl {
+
+// Memory for heap-allocated Span::Impl is cached per thread, see span.cpp
+void* AllocateImplStorage();
+void DeallocateImplStorage(void* storage) noexcept;
+
+}  // namespace impl
+
 template <typename... Args>
 Span::Impl* AllocateImpl(Args&&... args) {
-  return new Span::Impl(std::forward<Args>(args)...);
+  void* storage = impl::AllocateImplStorage();
+  try {
+    return new (storage) Span::Impl(std::forward<Args>(args)...);
+  } catch (...) {
+    impl::DeallocateImplStorage(storage);
+    throw;
+  }
 }
 
+void DeleteImpl(Span::Impl* impl) noexcept;
+
 class DetachLocalSpansScope final {
  public:
   DetachLocalSpansScope() noexcept;
@@ -1,11 +1,19 @@
 #include "span_impl.hpp"
 
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <variant>
+
 #include <boost/container/small_vector.hpp>
 
 #include <userver/formats/json/string_builder.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/logging/log_extra.hpp>
+#include <userver/tracing/span_exporter.hpp>
 #include <userver/tracing/tags.hpp>
+#include <userver/utils/encoding/hex.hpp>
 #include <userver/utils/trivial_map.hpp>
 
 #include <logging/log_helper_impl.hpp>
@@ -77,6 +85,169 @@ constexpr std::string_view kStartTimeMillis = "start_time_millis";
 constexpr std::string_view kDuration = "duration";
 
 }  // namespace jaeger
+
+// Hand-written encoding of `opentelemetry.proto.trace.v1.Span`, see
+// https://github.com/open-telemetry/opentelemetry-proto
+namespace otlp {
+
+enum WireType : std::uint8_t {
+  kVarint = 0,
+  kFixed64 = 1,
+  kLengthDelimited = 2,
+};
+
+// Span
+constexpr std::uint8_t kTraceIdField = 1;
+constexpr std::uint8_t kSpanIdField = 2;
+constexpr std::uint8_t kParentSpanIdField = 4;
+constexpr std::uint8_t kNameField = 5;
+constexpr std::uint8_t kStartTimeField = 7;
+constexpr std::uint8_t kEndTimeField = 8;
+constexpr std::uint8_t kAttributesField = 9;
+constexpr std::uint8_t kStatusField = 15;
+// KeyValue
+constexpr std::uint8_t kKeyField = 1;
+constexpr std::uint8_t kValueField = 2;
+// AnyValue
+constexpr std::uint8_t kStringValueField = 1;
+constexpr std::uint8_t kBoolValueField = 2;
+constexpr std::uint8_t kIntValueField = 3;
+constexpr std::uint8_t kDoubleValueField = 4;
+// Status
+constexpr std::uint8_t kStatusCodeField = 3;
+constexpr std::uint64_t kStatusCodeError = 2;
+
+constexpr std::size_t kTraceIdSize = 16;
+constexpr std::size_t kSpanIdSize = 8;
+
+void PutTag(std::string& out, std::uint8_t field, WireType type) {
+  // all the fields in use are below 16 and fit into a single byte
+  out.push_back(static_cast<char>((field << 3) | type));
+}
+
+std::size_t VarintSize(std::uint64_t value) noexcept {
+  std::size_t size = 1;
+  for (; value >= 0x80; value >>= 7) ++size;
+  return size;
+}
+
+void PutVarint(std::string& out, std::uint64_t value) {
+  for (; value >= 0x80; value >>= 7) {
+    out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+void PutFixed64(std::string& out, std::uint8_t field, std::uint64_t value) {
+  PutTag(out, field, kFixed64);
+  for (int i = 0; i < 8; ++i) {
+    out.push_back(static_cast<char>(value >> (i * 8)));
+  }
+}
+
+std::size_t BytesFieldSize(std::size_t size) noexcept {
+  return 1 + VarintSize(size) + size;
+}
+
+void PutBytes(std::string& out, std::uint8_t field, std::string_view value) {
+  PutTag(out, field, kLengthDelimited);
+  PutVarint(out, value.size());
+  out.append(value);
+}
+
+std::uint64_t Fnv1a(std::string_view data, std::uint64_t hash) noexcept {
+  for (const char c : data) {
+    hash ^= static_cast<std::uint8_t>(c);
+    hash *= 0x100000001b3;
+  }
+  return hash;
+}
+
+// OTLP ids have fixed sizes. Ids generated by userver are hex strings of
+// exactly that size, foreign ids of any other form are hashed.
+void PutId(std::string& out, std::uint8_t field, std::string_view id,
+           std::size_t size) {
+  if (id.size() == size * 2 && utils::encoding::IsHexData(id)) {
+    PutBytes(out, field, utils::encoding::FromHex(id));
+    return;
+  }
+
+  std::array<char, kTraceIdSize> hashed{};
+  for (std::size_t i = 0; i < size; i += 8) {
+    const auto hash = Fnv1a(id, 0xcbf29ce484222325 + i);
+    for (std::size_t j = 0; j < 8; ++j) {
+      hashed[i + j] = static_cast<char>(hash >> (j * 8));
+    }
+  }
+  PutBytes(out, field, {hashed.data(), size});
+}
+
+// Writes the AnyValue message contents
+void PutAnyValue(std::string& out, const logging::LogExtra::Value& value,
+                 bool is_bool) {
+  std::visit(
+      [&out, is_bool](const auto& v) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, std::string>) {
+          PutBytes(out, kStringValueField, v);
+        } else if constexpr (std::is_floating_point_v<T>) {
+          std::uint64_t bits{};
+          const double d = v;
+          static_assert(sizeof(bits) == sizeof(d));
+          std::memcpy(&bits, &d, sizeof(bits));
+          PutFixed64(out, kDoubleValueField, bits);
+        } else if (is_bool) {
+          PutTag(out, kBoolValueField, kVarint);
+          PutVarint(out, v != 0);
+        } else {
+          PutTag(out, kIntValueField, kVarint);
+          PutVarint(out, static_cast<std::uint64_t>(
+                             static_cast<std::int64_t>(v)));
+        }
+      },
+      value);
+}
+
+bool IsTrue(const logging::LogExtra::Value& value) {
+  return std::visit(
+      [](const auto& v) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(v)>>) {
+          return v != 0;
+        } else {
+          return false;
+        }
+      },
+      value);
+}
+
+template <typename Tags>
+void PutAttributes(std::string& out, const Tags& tags,
+                   std::string& value_buffer, bool& has_error) {
+  for (const auto& [key, protected_value] : tags) {
+    const auto& value = protected_value.GetValue();
+    const auto tag = jaeger::kGetOpentracingTags.TryFind(key);
+    const std::string_view name = tag ? tag->opentracing_name : key;
+    const bool is_bool = tag && tag->type == "bool";
+    if (key == kErrorFlag) has_error = has_error || IsTrue(value);
+
+    value_buffer.clear();
+    PutAnyValue(value_buffer, value, is_bool);
+
+    PutTag(out, kAttributesField, kLengthDelimited);
+    PutVarint(out, BytesFieldSize(name.size()) +
+                       BytesFieldSize(value_buffer.size()));
+    PutBytes(out, kKeyField, name);
+    PutBytes(out, kValueField, value_buffer);
+  }
+}
+
+std::uint64_t ToUnixNanos(std::chrono::system_clock::time_point tp) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             tp.time_since_epoch())
+      .count();
+}
+
+}  // namespace otlp
 }  // namespace
 
 void Span::Impl::LogOpenTracing() const {
@@ -123,6 +294,55 @@ void Span::Impl::DoLogOpenTracing(logging::impl::TagWriter writer) const {
   writer.PutTag("tags", tags.GetStringView());
 }
 
+void Span::Impl::ExportOtlp() const {
+  const auto exporter = Tracer::GetSpanExporter();
+  if (exporter) {
+    exporter->Export(ToOtlpSpan());
+  }
+}
+
+std::string Span::Impl::ToOtlpSpan() const {
+  const auto finish_steady_time =
+      finish_steady_time_.value_or(std::chrono::steady_clock::now());
+  const auto finish_system_time =
+      start_system_time_ + std::chrono::duration_cast<
+                               std::chrono::system_clock::duration>(
+                               finish_steady_time - start_steady_time_);
+
+  std::string result;
+  result.reserve(128 + name_.size());
+
+  otlp::PutId(result, otlp::kTraceIdField, trace_id_, otlp::kTraceIdSize);
+  otlp::PutId(result, otlp::kSpanIdField, span_id_, otlp::kSpanIdSize);
+  if (!parent_id_.empty()) {
+    otlp::PutId(result, otlp::kParentSpanIdField, parent_id_,
+                otlp::kSpanIdSize);
+  }
+  otlp::PutBytes(result, otlp::kNameField, name_);
+  otlp::PutFixed64(result, otlp::kStartTimeField,
+                   otlp::ToUnixNanos(start_system_time_));
+  otlp::PutFixed64(result, otlp::kEndTimeField,
+                   otlp::ToUnixNanos(finish_system_time));
+
+  std::string value_buffer;
+  bool has_error = false;
+  otlp::PutAttributes(result, *log_extra_inheritable_.extra_, value_buffer,
+                      has_error);
+  if (log_extra_local_) {
+    otlp::PutAttributes(result, *log_extra_local_->extra_, value_buffer,
+                        has_error);
+  }
+
+  if (has_error) {
+    otlp::PutTag(result, otlp::kStatusField, otlp::kLengthDelimited);
+    otlp::PutVarint(result, 1 + otlp::VarintSize(otlp::kStatusCodeError));
+    otlp::PutTag(result, otlp::kStatusCodeField, otlp::kVarint);
+    otlp::PutVarint(result, otlp::kStatusCodeError);
+  }
+
+  return result;
+}
+
 void Span::Impl::AddOpentracingTags(formats::json::StringBuilder& output,
                                     const logging::LogExtra& input) {
   for (const auto& [key, value] : *input.extra_) {
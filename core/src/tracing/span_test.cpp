@@ -3,9 +3,12 @@
 #include <logging/log_helper_impl.hpp>
 #include <logging/logging_test.hpp>
 #include <tracing/no_log_spans.hpp>
+#include <tracing/tail_sampling.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/span_exporter.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utest/utest.hpp>
 #include <userver/utils/regex.hpp>
@@ -718,4 +721,130 @@ UTEST_F(Span, MakeSpanWithParentIdTraceIdLinkWithExisting) {
   }
 }
 
+UTEST_F(Span, TailSamplingDropsTraces) {
+  tracing::impl::TailSamplingSettings settings;
+  settings.enabled = true;
+  tracing::impl::SetTailSampling(settings);
+
+  {
+    auto root = tracing::Tracer::GetTracer()->CreateSpanWithoutParent(
+        "tail_root");
+    { tracing::Span child("tail_child"); }
+  }
+  {
+    auto root = tracing::Tracer::GetTracer()->CreateSpanWithoutParent(
+        "tail_failed_root");
+    {
+      tracing::Span child("tail_failed_child");
+      child.AddTag(tracing::kErrorFlag, true);
+    }
+    { tracing::Span child("tail_other_child"); }
+  }
+  tracing::impl::SetTailSampling({});
+
+  logging::LogFlush();
+  EXPECT_FALSE(LoggedTextContains("stopwatch_name=tail_root\t"));
+  EXPECT_FALSE(LoggedTextContains("stopwatch_name=tail_child\t"));
+  EXPECT_TRUE(LoggedTextContains("stopwatch_name=tail_failed_root\t"));
+  EXPECT_TRUE(LoggedTextContains("stopwatch_name=tail_failed_child\t"));
+  EXPECT_TRUE(LoggedTextContains("stopwatch_name=tail_other_child\t"));
+}
+
+UTEST_F(Span, TailSamplingBoundsMemory) {
+  tracing::impl::TailSamplingSettings settings;
+  settings.enabled = true;
+  settings.max_spans_per_trace = 2;
+  tracing::impl::SetTailSampling(settings);
+
+  {
+    auto root = tracing::Tracer::GetTracer()->CreateSpanWithoutParent(
+        "tail_root");
+    for (int i = 0; i < 4; ++i) {
+      tracing::Span child(fmt::format("tail_child_{}", i));
+    }
+    root.AddTag(tracing::kErrorFlag, true);
+  }
+  tracing::impl::SetTailSampling({});
+
+  logging::LogFlush();
+  EXPECT_TRUE(LoggedTextContains("stopwatch_name=tail_root\t"));
+  EXPECT_FALSE(LoggedTextContains("stopwatch_name=tail_child_0\t"));
+  EXPECT_FALSE(LoggedTextContains("stopwatch_name=tail_child_1\t"));
+  EXPECT_TRUE(LoggedTextContains("stopwatch_name=tail_child_2\t"));
+  EXPECT_TRUE(LoggedTextContains("stopwatch_name=tail_child_3\t"));
+}
+
+UTEST_F(Span, TailSamplingKeepsSlowAndSampledTraces) {
+  tracing::impl::TailSamplingSettings settings;
+  settings.enabled = true;
+  settings.latency_threshold = std::chrono::milliseconds{1};
+  tracing::impl::SetTailSampling(settings);
+  {
+    auto root = tracing::Tracer::GetTracer()->CreateSpanWithoutParent(
+        "tail_slow_root");
+    tracing::Span child("tail_slow_child");
+    engine::SleepFor(std::chrono::milliseconds{2});
+  }
+
+  settings.latency_threshold = {};
+  settings.probability = 1;
+  tracing::impl::SetTailSampling(settings);
+  {
+    auto root = tracing::Tracer::GetTracer()->CreateSpanWithoutParent(
+        "tail_sampled_root");
+    tracing::Span child("tail_sampled_child");
+  }
+  tracing::impl::SetTailSampling({});
+
+  logging::LogFlush();
+  EXPECT_TRUE(LoggedTextContains("stopwatch_name=tail_slow_root\t"));
+  EXPECT_TRUE(LoggedTextContains("stopwatch_name=tail_slow_child\t"));
+  EXPECT_TRUE(LoggedTextContains("stopwatch_name=tail_sampled_root\t"));
+  EXPECT_TRUE(LoggedTextContains("stopwatch_name=tail_sampled_child\t"));
+}
+
+UTEST_F(Span, ExportsOtlpSpans) {
+  class CollectingExporter final : public tracing::SpanExporter {
+   public:
+    void Export(std::string&& otlp_span) noexcept override {
+      spans.push_back(std::move(otlp_span));
+    }
+
+    std::vector<std::string> spans;
+  };
+
+  auto exporter = std::make_shared<CollectingExporter>();
+  tracing::Tracer::SetSpanExporter(exporter);
+  {
+    tracing::Span span("exported_span");
+    span.AddTag(tracing::kErrorFlag, true);
+    span.AddNonInheritableTag("exported_tag", "exported_value");
+  }
+  { tracing::Span span("not_exported_span", tracing::ReferenceType::kChild,
+                       logging::Level::kTrace); }
+  tracing::Tracer::SetSpanExporter(nullptr);
+
+  ASSERT_EQ(exporter->spans.size(), 1);
+  const auto& otlp_span = exporter->spans[0];
+  // trace_id field of 16 bytes, then span_id field of 8 bytes
+  ASSERT_GT(otlp_span.size(), 2 + 16 + 2 + 8);
+  EXPECT_EQ(otlp_span.substr(0, 2), "\x0a\x10");
+  EXPECT_EQ(otlp_span.substr(18, 2), "\x12\x08");
+  EXPECT_NE(otlp_span.find("exported_span"), std::string::npos);
+  EXPECT_NE(otlp_span.find("exported_value"), std::string::npos);
+  // status with the error code
+  EXPECT_EQ(otlp_span.substr(otlp_span.size() - 4), "\x7a\x02\x18\x02");
+}
+
+UTEST_F(Span, ReusedSpanStorageStartsClean) {
+  for (int i = 0; i < 3; ++i) {
+    tracing::Span span(fmt::format("reused_span_{}", i));
+    if (i == 0) span.AddTag("first_only_tag", "value");
+  }
+
+  const auto logged = LoggedText();
+  EXPECT_EQ(logged.find("first_only_tag"), logged.rfind("first_only_tag"));
+  EXPECT_NE(logged.find("reused_span_2"), std::string::npos);
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,122 @@
+#include <tracing/tail_sampling.hpp>
+
+#include <optional>
+
+#include <fmt/format.h>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/parse/common.hpp>
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing::impl {
+
+namespace {
+
+auto& GlobalTailSampling() {
+  static rcu::Variable<TailSamplingSettings> settings{};
+  return settings;
+}
+
+}  // namespace
+
+TailSamplingSettings Parse(const formats::json::Value& value,
+                           formats::parse::To<TailSamplingSettings>) {
+  TailSamplingSettings settings;
+  settings.enabled = value["enabled"].As<bool>(false);
+  settings.max_spans_per_trace = value["max-spans-per-trace"].As<std::size_t>(
+      settings.max_spans_per_trace);
+  settings.latency_threshold = std::chrono::milliseconds{
+      value["latency-threshold-ms"].As<std::int64_t>(0)};
+  settings.probability = value["probability"].As<double>(0);
+
+  if (settings.max_spans_per_trace == 0) {
+    throw formats::json::ParseException(
+        "Tail sampling 'max-spans-per-trace' must be positive");
+  }
+  if (settings.probability < 0 || settings.probability > 1) {
+    throw formats::json::ParseException(
+        fmt::format("Tail sampling probability must be in [0, 1], got {}",
+                    settings.probability));
+  }
+
+  return settings;
+}
+
+void SetTailSampling(const TailSamplingSettings& settings) {
+  GlobalTailSampling().Assign(settings);
+}
+
+std::shared_ptr<TailSamplingTrace> StartTailSampledTrace() {
+  const auto settings = GlobalTailSampling().Read();
+  if (!settings->enabled) return nullptr;
+  return std::make_shared<TailSamplingTrace>(*settings);
+}
+
+TailSamplingTrace::TailSamplingTrace(const TailSamplingSettings& settings)
+    : max_spans_(settings.max_spans_per_trace),
+      latency_threshold_(settings.latency_threshold),
+      probability_(settings.probability) {}
+
+void TailSamplingTrace::Add(Span::Impl&& span) {
+  const bool has_error = span.HasErrorTag();
+
+  // Spans are logged or dropped out of the lock
+  std::optional<Span::Impl> released;
+  {
+    const std::lock_guard lock{mutex_};
+    has_errors_ = has_errors_ || has_error;
+
+    switch (state_) {
+      case State::kPending:
+        spans_.push_back(std::move(span));
+        if (spans_.size() <= max_spans_) return;
+
+        // The ring is full, forget the oldest span
+        released.emplace(std::move(spans_.front()));
+        spans_.pop_front();
+        released->DiscardLog();
+        return;
+      case State::kKept:
+        released.emplace(std::move(span));
+        return;
+      case State::kDropped:
+        released.emplace(std::move(span));
+        released->DiscardLog();
+        return;
+    }
+  }
+}
+
+bool TailSamplingTrace::Finish(
+    std::chrono::steady_clock::duration root_duration, bool root_has_error) {
+  std::deque<Span::Impl> spans;
+  bool keep = false;
+  {
+    const std::lock_guard lock{mutex_};
+    UASSERT(state_ == State::kPending);
+
+    keep = root_has_error || has_errors_ ||
+           (latency_threshold_.count() > 0 &&
+            root_duration >= latency_threshold_) ||
+           (probability_ > 0 && utils::RandRange(1.0) < probability_);
+    state_ = keep ? State::kKept : State::kDropped;
+    spans.swap(spans_);
+  }
+
+  if (!keep) {
+    for (auto& span : spans) span.DiscardLog();
+  }
+  // Buffered spans are logged on destruction, in the order they finished
+  while (!spans.empty()) spans.pop_front();
+
+  return keep;
+}
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+#include <userver/formats/parse/to.hpp>
+
+#include <tracing/span_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+class Value;
+}
+
+namespace tracing::impl {
+
+struct TailSamplingSettings {
+  bool enabled{false};
+  std::size_t max_spans_per_trace{256};
+  // Traces with the root span slower than that are always kept, 0 disables
+  std::chrono::milliseconds latency_threshold{0};
+  // Probability to keep a trace that is neither slow nor failed
+  double probability{0};
+};
+
+TailSamplingSettings Parse(const formats::json::Value& value,
+                           formats::parse::To<TailSamplingSettings>);
+
+void SetTailSampling(const TailSamplingSettings& settings);
+
+/// Finished spans of a single trace, held back until the root span decides
+/// whether the whole trace is worth logging.
+class TailSamplingTrace final {
+ public:
+  explicit TailSamplingTrace(const TailSamplingSettings& settings);
+
+  /// Takes a finished non-root span. The span is logged or dropped right away
+  /// if the root span has already decided.
+  void Add(Span::Impl&& span);
+
+  /// Decides the fate of the trace, flushes or drops the buffered spans.
+  /// @returns whether the root span should be logged
+  bool Finish(std::chrono::steady_clock::duration root_duration,
+              bool root_has_error);
+
+ private:
+  enum class State { kPending, kKept, kDropped };
+
+  const std::size_t max_spans_;
+  const std::chrono::milliseconds latency_threshold_;
+  const double probability_;
+
+  std::mutex mutex_;
+  State state_{State::kPending};
+  bool has_errors_{false};
+  std::deque<Span::Impl> spans_;
+};
+
+/// @returns a new trace if tail sampling is enabled, nullptr otherwise
+std::shared_ptr<TailSamplingTrace> StartTailSampledTrace();
+
+}  // namespace tracing::impl
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/rcu/rcu.hpp>
+#include <userver/tracing/span_exporter.hpp>
 #include <userver/utils/uuid4.hpp>
 
 #include <tracing/no_log_spans.hpp>
@@ -40,6 +41,11 @@ auto& GlobalNoLogSpans() {
   return spans;
 }
 
+auto& GlobalSpanExporter() {
+  static rcu::Variable<std::shared_ptr<SpanExporter>> exporter{};
+  return exporter;
+}
+
 auto& GlobalTracer() {
   static rcu::Variable<TracerPtr> tracer(tracing::MakeTracer({}, {}));
   return tracer;
@@ -69,6 +75,8 @@ bool ValueMatchesOneOfPrefixes(const T& value,
 
 }  // namespace
 
+SpanExporter::~SpanExporter() = default;
+
 Tracer::~Tracer() = default;
 
 void Tracer::SetNoLogSpans(NoLogSpans&& spans) {
@@ -83,6 +91,14 @@ bool Tracer::IsNoLogSpan(const std::string& name) {
          spans->names.find(name) != spans->names.end();
 }
 
+void Tracer::SetSpanExporter(std::shared_ptr<SpanExporter> exporter) {
+  GlobalSpanExporter().Assign(std::move(exporter));
+}
+
+std::shared_ptr<SpanExporter> Tracer::GetSpanExporter() {
+  return GlobalSpanExporter().ReadCopy();
+}
+
 void Tracer::SetTracer(std::shared_ptr<Tracer> tracer) {
   GlobalTracer().Assign(std::move(tracer));
 }
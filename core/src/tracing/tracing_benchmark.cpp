@@ -33,6 +33,18 @@ void tracing_happy_log(benchmark::State& state) {
 }
 BENCHMARK(tracing_happy_log);
 
+void tracing_child_ctr(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    auto tracer = tracing::MakeTracer("test_service", {});
+    auto parent = tracer->CreateSpanWithoutParent("parent");
+    parent.AddTag("meta_code", 200);
+
+    for ([[maybe_unused]] auto _ : state)
+      benchmark::DoNotOptimize(tracing::Span{"child"});
+  });
+}
+BENCHMARK(tracing_child_ctr);
+
 tracing::Span GetSpanWithOpentracingHttpTags(tracing::TracerPtr tracer) {
   auto span = tracer->CreateSpanWithoutParent("name");
   span.AddTag("meta_code", 200);
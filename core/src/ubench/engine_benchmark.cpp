@@ -0,0 +1,226 @@
+#include <userver/ubench/engine_benchmark.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <engine/impl/standalone.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/shared_mutex.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ubench {
+
+namespace {
+
+/// Counts an event for the current thread and all the threads it starts
+/// afterwards
+class PerfCounter final {
+ public:
+  PerfCounter(std::uint32_t type, std::uint64_t config) {
+#ifdef __linux__
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.inherit = 1;
+    attr.exclude_hv = 1;
+    if (type == PERF_TYPE_HARDWARE) attr.exclude_kernel = 1;
+    fd_ = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+    (void)type;
+    (void)config;
+#endif
+  }
+
+  PerfCounter(PerfCounter&& other) noexcept
+      : fd_(std::exchange(other.fd_, -1)) {}
+  PerfCounter& operator=(PerfCounter&&) = delete;
+
+  ~PerfCounter() {
+#ifdef __linux__
+    if (fd_ >= 0) ::close(fd_);
+#endif
+  }
+
+  std::optional<std::uint64_t> Read() const noexcept {
+#ifdef __linux__
+    std::uint64_t value = 0;
+    if (fd_ >= 0 && ::read(fd_, &value, sizeof(value)) == sizeof(value)) {
+      return value;
+    }
+#endif
+    return std::nullopt;
+  }
+
+ private:
+  int fd_{-1};
+};
+
+struct PerfCounterSpec final {
+  const char* name;
+  std::uint32_t type;
+  std::uint64_t config;
+};
+
+#ifdef __linux__
+constexpr std::array<PerfCounterSpec, 3> kPerfCounters{{
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"cache_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"context_switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+}};
+#else
+constexpr std::array<PerfCounterSpec, 0> kPerfCounters{};
+#endif
+
+struct LatencyPercentile final {
+  const char* name;
+  double percent;
+};
+
+constexpr LatencyPercentile kLatencyPercentiles[]{
+    {"p50_ns", 50}, {"p90_ns", 90}, {"p99_ns", 99}, {"p999_ns", 99.9}};
+
+}  // namespace
+
+ConcurrencyOptions ConcurrencyOptionsFromArgs(const benchmark::State& state) {
+  ConcurrencyOptions options;
+  options.worker_threads = static_cast<std::size_t>(state.range(0));
+  options.coroutines = static_cast<std::size_t>(state.range(1));
+  return options;
+}
+
+namespace impl {
+
+void LatencyHistogram::Add(const LatencyHistogram& other) noexcept {
+  for (std::size_t i = 0; i < kBuckets; ++i) {
+    buckets_[i] += other.buckets_[i];
+  }
+}
+
+std::uint64_t LatencyHistogram::GetCount() const noexcept {
+  std::uint64_t count = 0;
+  for (const auto bucket : buckets_) count += bucket;
+  return count;
+}
+
+std::uint64_t LatencyHistogram::GetPercentileNs(
+    double percent) const noexcept {
+  const auto count = GetCount();
+  if (count == 0) return 0;
+
+  const auto rank = std::max<std::uint64_t>(
+      static_cast<std::uint64_t>(std::ceil(count * percent / 100)), 1);
+  std::uint64_t accumulated = 0;
+  for (std::size_t i = 0; i < kBuckets; ++i) {
+    accumulated += buckets_[i];
+    if (accumulated >= rank) return BucketLowerBound(i);
+  }
+  return BucketLowerBound(kBuckets - 1);
+}
+
+std::uint64_t LatencyHistogram::BucketLowerBound(std::size_t index) noexcept {
+  if (index < kSubBuckets) return index;
+  const auto exponent = index / kSubBuckets + kSubBucketBits - 1;
+  const auto sub_bucket = index % kSubBuckets;
+  return (kSubBuckets + sub_bucket) << (exponent - kSubBucketBits);
+}
+
+void RunConcurrently(benchmark::State& state, const ConcurrencyOptions& options,
+                     utils::function_ref<void(const CoroutineRun&)> run) {
+  UINVARIANT(options.worker_threads != 0 && options.coroutines != 0,
+             "Unable to run anything using 0 threads or coroutines");
+
+  // Counters are inherited only by the threads started after their creation,
+  // so they go before the engine
+  std::vector<PerfCounter> perf_counters;
+  perf_counters.reserve(kPerfCounters.size());
+  for (const auto& spec : kPerfCounters) {
+    perf_counters.emplace_back(spec.type, spec.config);
+  }
+
+  engine::TaskProcessorPoolsConfig pools_config;
+  pools_config.initial_coro_pool_size = options.coroutines + 1;
+  pools_config.max_coro_pool_size =
+      std::max(pools_config.max_coro_pool_size, options.coroutines + 1);
+  auto task_processor = engine::impl::TaskProcessorHolder::Make(
+      options.worker_threads, "bench-worker",
+      engine::impl::MakeTaskProcessorPools(pools_config));
+
+  const auto total_iterations = static_cast<std::size_t>(state.max_iterations);
+  std::vector<LatencyHistogram> latencies(
+      options.measure_latency ? options.coroutines : 0);
+  std::vector<std::optional<std::uint64_t>> perf_before(perf_counters.size());
+  std::vector<std::optional<std::uint64_t>> perf_after(perf_counters.size());
+
+  // A single batch of all the iterations
+  while (state.KeepRunningBatch(state.max_iterations)) {
+    engine::impl::RunOnTaskProcessorSync(*task_processor, [&] {
+      std::vector<engine::TaskWithResult<void>> tasks;
+      tasks.reserve(options.coroutines);
+
+      // Holds the coroutines until all of them are started
+      engine::SharedMutex start_gate;
+      std::unique_lock start_lock{start_gate};
+
+      for (std::size_t i = 0; i < options.coroutines; ++i) {
+        const CoroutineRun coroutine_run{
+            i,
+            total_iterations / options.coroutines +
+                (i < total_iterations % options.coroutines ? 1 : 0),
+            options.measure_latency ? &latencies[i] : nullptr};
+        tasks.push_back(engine::AsyncNoSpan([&start_gate, &run, coroutine_run] {
+          { std::shared_lock wait{start_gate}; }
+          run(coroutine_run);
+        }));
+      }
+
+      for (std::size_t i = 0; i < perf_counters.size(); ++i) {
+        perf_before[i] = perf_counters[i].Read();
+      }
+      start_lock.unlock();
+      for (auto& task : tasks) task.Get();
+      for (std::size_t i = 0; i < perf_counters.size(); ++i) {
+        perf_after[i] = perf_counters[i].Read();
+      }
+    });
+  }
+
+  state.SetItemsProcessed(state.iterations());
+
+  if (options.measure_latency) {
+    LatencyHistogram total;
+    for (const auto& histogram : latencies) total.Add(histogram);
+    for (const auto& percentile : kLatencyPercentiles) {
+      state.counters[percentile.name] =
+          static_cast<double>(total.GetPercentileNs(percentile.percent));
+    }
+  }
+
+  for (std::size_t i = 0; i < perf_counters.size(); ++i) {
+    if (!perf_before[i] || !perf_after[i]) continue;
+    state.counters[kPerfCounters[i].name] = benchmark::Counter(
+        static_cast<double>(*perf_after[i] - *perf_before[i]),
+        benchmark::Counter::kAvgIterations);
+  }
+}
+
+}  // namespace impl
+
+}  // namespace ubench
+
+USERVER_NAMESPACE_END
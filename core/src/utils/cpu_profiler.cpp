@@ -0,0 +1,385 @@
+#include <utils/cpu_profiler.hpp>
+
+#include <signal.h>
+#include <sys/time.h>
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <fmt/format.h>
+#include <boost/stacktrace/frame.hpp>
+
+#include <engine/task/task_context.hpp>
+#include <engine/task/task_processor.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/span.hpp>
+#include <utils/check_syscall.hpp>
+#include <utils/signal_backtrace.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::cpu_profiler {
+
+namespace {
+
+constexpr std::size_t kMaxDepth = utils::impl::kMaxSignalBacktraceDepth;
+constexpr std::size_t kMaxSpanName = 47;
+constexpr std::size_t kMaxThreadName = 16;
+
+}  // namespace
+
+struct Sample final {
+  std::atomic<bool> is_ready{false};
+  std::uint8_t depth{0};
+  std::uint8_t span_name_size{0};
+  std::uint8_t thread_name_size{0};
+  const std::string* task_processor{nullptr};
+  void* frames[kMaxDepth]{};
+  char span_name[kMaxSpanName]{};
+  char thread_name[kMaxThreadName]{};
+};
+
+class SampleBuffer final {
+ public:
+  explicit SampleBuffer(std::size_t capacity)
+      : samples_(std::make_unique<Sample[]>(capacity)), capacity_(capacity) {}
+
+  // Called from the signal handler, must be async-signal-safe
+  void Record(void* ucontext) noexcept;
+
+  utils::span<const Sample> GetSamples() const noexcept {
+    const auto size = std::min(next_.load(), capacity_);
+    return {samples_.get(), samples_.get() + size};
+  }
+
+  std::size_t GetDroppedCount() const noexcept { return dropped_.load(); }
+
+ private:
+  const std::unique_ptr<Sample[]> samples_;
+  const std::size_t capacity_;
+  std::atomic<std::size_t> next_{0};
+  std::atomic<std::size_t> dropped_{0};
+};
+
+namespace {
+
+std::atomic<SampleBuffer*> active_buffer{nullptr};
+std::atomic<int> running_handlers{0};
+std::atomic<bool> is_session_active{false};
+
+void OnSigprof(int, siginfo_t*, void* ucontext) {
+  const auto saved_errno = errno;
+  ++running_handlers;
+  if (auto* const buffer = active_buffer.load()) {
+    buffer->Record(ucontext);
+  }
+  --running_handlers;
+  errno = saved_errno;
+}
+
+void InstallSignalHandler() {
+  static std::once_flag installed;
+  std::call_once(installed, [] {
+    utils::impl::PrepareSignalBacktrace();
+
+    // The handler is never removed, it does nothing between sessions
+    struct sigaction action {};
+    action.sa_sigaction = &OnSigprof;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    utils::CheckSyscall(sigaction(SIGPROF, &action, nullptr),
+                        "installing SIGPROF handler");
+  });
+}
+
+void SetTimer(std::chrono::microseconds period) {
+  itimerval timer{};
+  timer.it_interval.tv_sec = period.count() / 1'000'000;
+  timer.it_interval.tv_usec = period.count() % 1'000'000;
+  timer.it_value = timer.it_interval;
+  utils::CheckSyscall(setitimer(ITIMER_PROF, &timer, nullptr),
+                      "setting ITIMER_PROF");
+}
+
+// Minimal protobuf encoder for the pprof profile.proto messages
+class ProtoWriter final {
+ public:
+  void Varint(std::uint32_t field, std::uint64_t value) {
+    if (value == 0) return;
+    WriteVarint(field << 3);
+    WriteVarint(value);
+  }
+
+  void Bytes(std::uint32_t field, std::string_view value) {
+    WriteVarint((field << 3) | 2);
+    WriteVarint(value.size());
+    data_.append(value);
+  }
+
+  void Message(std::uint32_t field, const ProtoWriter& message) {
+    Bytes(field, message.data_);
+  }
+
+  template <typename Range>
+  void Packed(std::uint32_t field, const Range& values) {
+    ProtoWriter packed;
+    for (const auto value : values) {
+      packed.WriteVarint(static_cast<std::uint64_t>(value));
+    }
+    Bytes(field, packed.data_);
+  }
+
+  std::string Extract() && { return std::move(data_); }
+
+ private:
+  void WriteVarint(std::uint64_t value) {
+    while (value >= 0x80) {
+      data_.push_back(static_cast<char>(value | 0x80));
+      value >>= 7;
+    }
+    data_.push_back(static_cast<char>(value));
+  }
+
+  std::string data_;
+};
+
+class StringTable final {
+ public:
+  StringTable() { Get({}); }
+
+  std::int64_t Get(std::string_view value) {
+    const auto [it, inserted] =
+        indices_.try_emplace(std::string{value}, strings_.size());
+    if (inserted) strings_.push_back(it->first);
+    return it->second;
+  }
+
+  void WriteTo(ProtoWriter& profile) const {
+    for (const auto& value : strings_) profile.Bytes(6, value);
+  }
+
+ private:
+  std::unordered_map<std::string, std::int64_t> indices_;
+  std::vector<std::string> strings_;
+};
+
+std::string Symbolize(void* address, bool is_return_address) {
+  // Return addresses point past the call, step back into it
+  auto* const symbolized_address =
+      is_return_address ? static_cast<char*>(address) - 1 : address;
+  auto name = boost::stacktrace::frame{symbolized_address}.name();
+  if (name.empty()) {
+    name = fmt::format("{}", address);
+  }
+  return name;
+}
+
+std::string MakeProfile(const SampleBuffer& buffer,
+                        const SessionSettings& settings,
+                        std::chrono::system_clock::time_point start_time) {
+  using Stack = std::vector<void*>;
+  using Key =
+      std::tuple<Stack, std::string_view, std::string_view, std::string_view>;
+  std::map<Key, std::uint64_t> counts;
+  for (const auto& sample : buffer.GetSamples()) {
+    if (!sample.is_ready.load(std::memory_order_acquire)) continue;
+    const std::string_view task_processor =
+        sample.task_processor ? *sample.task_processor : std::string_view{};
+    ++counts[Key{
+        Stack(sample.frames, sample.frames + sample.depth),
+        std::string_view{sample.span_name, sample.span_name_size},
+        task_processor,
+        std::string_view{sample.thread_name, sample.thread_name_size},
+    }];
+  }
+
+  StringTable strings;
+  ProtoWriter profile;
+  const auto period_ns =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(settings.period)
+          .count();
+
+  const auto write_value_type = [&](std::uint32_t field, std::string_view type,
+                                    std::string_view unit) {
+    ProtoWriter value_type;
+    value_type.Varint(1, strings.Get(type));
+    value_type.Varint(2, strings.Get(unit));
+    profile.Message(field, value_type);
+  };
+  write_value_type(1, "samples", "count");
+  write_value_type(1, "cpu", "nanoseconds");
+
+  std::unordered_map<void*, std::uint64_t> location_ids;
+  std::vector<std::pair<void*, bool>> locations;
+  for (const auto& [key, count] : counts) {
+    const auto& [stack, span_name, task_processor, thread_name] = key;
+    std::vector<std::uint64_t> sample_locations;
+    sample_locations.reserve(stack.size());
+    for (std::size_t i = 0; i < stack.size(); ++i) {
+      const auto [it, inserted] =
+          location_ids.try_emplace(stack[i], locations.size() + 1);
+      if (inserted) locations.emplace_back(stack[i], i != 0);
+      sample_locations.push_back(it->second);
+    }
+
+    ProtoWriter sample;
+    sample.Packed(1, sample_locations);
+    sample.Packed(2, std::initializer_list<std::int64_t>{
+                         static_cast<std::int64_t>(count),
+                         static_cast<std::int64_t>(count) * period_ns});
+    const auto write_label = [&](std::string_view name,
+                                 std::string_view value) {
+      if (value.empty()) return;
+      ProtoWriter label;
+      label.Varint(1, strings.Get(name));
+      label.Varint(2, strings.Get(value));
+      sample.Message(3, label);
+    };
+    write_label("span", span_name);
+    write_label("task_processor", task_processor);
+    write_label("thread", thread_name);
+    profile.Message(2, sample);
+  }
+
+  // A single mapping that tells pprof not to symbolize the addresses again
+  ProtoWriter mapping;
+  mapping.Varint(1, 1);
+  mapping.Varint(3, ~std::uint64_t{0});
+  mapping.Varint(7, 1);
+  profile.Message(3, mapping);
+
+  std::unordered_map<std::string, std::uint64_t> function_ids;
+  for (std::size_t i = 0; i < locations.size(); ++i) {
+    const auto [address, is_return_address] = locations[i];
+    auto name = Symbolize(address, is_return_address);
+    const auto [function, inserted] =
+        function_ids.try_emplace(name, function_ids.size() + 1);
+    if (inserted) {
+      ProtoWriter function_message;
+      function_message.Varint(1, function->second);
+      function_message.Varint(2, strings.Get(name));
+      function_message.Varint(3, strings.Get(name));
+      profile.Message(5, function_message);
+    }
+
+    ProtoWriter line;
+    line.Varint(1, function->second);
+    ProtoWriter location;
+    location.Varint(1, i + 1);
+    location.Varint(2, 1);
+    location.Varint(3, reinterpret_cast<std::uintptr_t>(address));
+    location.Message(4, line);
+    profile.Message(4, location);
+  }
+
+  const auto now = std::chrono::system_clock::now();
+  profile.Varint(9, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        start_time.time_since_epoch())
+                        .count());
+  profile.Varint(10, std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         now - start_time)
+                         .count());
+  write_value_type(11, "cpu", "nanoseconds");
+  profile.Varint(12, period_ns);
+  if (const auto dropped = buffer.GetDroppedCount()) {
+    profile.Varint(13, strings.Get(fmt::format(
+                           "{} samples were dropped, increase max-samples",
+                           dropped)));
+  }
+  profile.Varint(14, strings.Get("cpu"));
+
+  strings.WriteTo(profile);
+  return std::move(profile).Extract();
+}
+
+}  // namespace
+
+void SampleBuffer::Record(void* ucontext) noexcept {
+  const auto index = next_.fetch_add(1, std::memory_order_relaxed);
+  if (index >= capacity_) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  auto& sample = samples_[index];
+
+  sample.depth = static_cast<std::uint8_t>(
+      utils::impl::SignalBacktrace(ucontext, sample.frames));
+
+  if (auto* const context =
+          engine::current_task::GetCurrentTaskContextUnchecked()) {
+    const auto span_name = context->GetProfilerSpanName();
+    sample.span_name_size =
+        static_cast<std::uint8_t>(std::min(span_name.size(), kMaxSpanName));
+    std::copy_n(span_name.data(), sample.span_name_size, sample.span_name);
+    sample.task_processor = &context->GetTaskProcessor().Name();
+  }
+
+#ifdef __linux__
+  if (prctl(PR_GET_NAME, sample.thread_name) == 0) {
+    sample.thread_name_size = static_cast<std::uint8_t>(
+        strnlen(sample.thread_name, kMaxThreadName));
+  }
+#endif
+
+  sample.is_ready.store(true, std::memory_order_release);
+}
+
+Session::Session(SessionSettings settings)
+    : settings_(settings), start_time_(std::chrono::system_clock::now()) {
+  UINVARIANT(settings_.period.count() > 0,
+             "CPU profiler period must be positive");
+  if (is_session_active.exchange(true)) {
+    throw std::runtime_error("Another CPU profiling session is active");
+  }
+
+  try {
+    InstallSignalHandler();
+    buffer_ = std::make_unique<SampleBuffer>(settings_.max_samples);
+    active_buffer = buffer_.get();
+    is_running_ = true;
+    SetTimer(settings_.period);
+  } catch (...) {
+    Stop();
+    is_session_active = false;
+    throw;
+  }
+}
+
+Session::~Session() { Stop(); }
+
+std::string Session::StopAndGetProfile() {
+  Stop();
+  return MakeProfile(*buffer_, settings_, start_time_);
+}
+
+void Session::Stop() noexcept {
+  if (!is_running_) return;
+  is_running_ = false;
+
+  itimerval timer{};
+  setitimer(ITIMER_PROF, &timer, nullptr);
+
+  // Wait for the handlers that may still write into the buffer
+  active_buffer = nullptr;
+  while (running_handlers.load() != 0) std::this_thread::yield();
+
+  is_session_active = false;
+}
+
+}  // namespace utils::cpu_profiler
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::cpu_profiler {
+
+struct SessionSettings final {
+  // Interval of the process CPU time between samples
+  std::chrono::microseconds period{10'000};
+  // Samples above that are dropped
+  std::size_t max_samples{20'000};
+};
+
+class SampleBuffer;
+
+/// Sampling CPU profiler of the whole process.
+///
+/// SIGPROF is delivered by ITIMER_PROF to the thread that consumes CPU, the
+/// handler unwinds the stack of the interrupted code (a coroutine stack for
+/// tasks) and remembers the root span name and the task processor of the
+/// current task. Only one session may be active at a time.
+class Session final {
+ public:
+  /// @throws std::runtime_error if another session is active
+  explicit Session(SessionSettings settings);
+
+  Session(Session&&) = delete;
+  Session& operator=(Session&&) = delete;
+  ~Session();
+
+  /// Stops sampling and returns the profile in the pprof protobuf format
+  std::string StopAndGetProfile();
+
+ private:
+  void Stop() noexcept;
+
+  const SessionSettings settings_;
+  const std::chrono::system_clock::time_point start_time_;
+  std::unique_ptr<SampleBuffer> buffer_;
+  bool is_running_{false};
+};
+
+}  // namespace utils::cpu_profiler
+
+USERVER_NAMESPACE_END
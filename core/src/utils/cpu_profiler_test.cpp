@@ -0,0 +1,59 @@
+#include <utils/cpu_profiler.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+
+#include <userver/engine/async.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kSpanName = "cpu_profiler_test_span";
+
+void BurnCpu(std::chrono::milliseconds duration) {
+  const auto deadline = std::chrono::steady_clock::now() + duration;
+  volatile double sink = 0;
+  while (std::chrono::steady_clock::now() < deadline) {
+    for (int i = 0; i < 1000; ++i) sink = sink + std::sqrt(i + sink);
+  }
+}
+
+utils::cpu_profiler::SessionSettings MakeSettings() {
+  utils::cpu_profiler::SessionSettings settings;
+  settings.period = std::chrono::milliseconds{1};
+  settings.max_samples = 10'000;
+  return settings;
+}
+
+}  // namespace
+
+UTEST(CpuProfiler, SamplesSpanAndTaskProcessor) {
+  utils::cpu_profiler::Session session{MakeSettings()};
+
+  engine::AsyncNoSpan([] {
+    tracing::Span span{std::string{kSpanName}};
+    BurnCpu(std::chrono::milliseconds{300});
+  }).Get();
+
+  const auto profile = session.StopAndGetProfile();
+  EXPECT_NE(profile.find(kSpanName), std::string::npos);
+  EXPECT_NE(profile.find("task_processor"), std::string::npos);
+  EXPECT_NE(profile.find("nanoseconds"), std::string::npos);
+}
+
+UTEST(CpuProfiler, SingleSession) {
+  std::optional<utils::cpu_profiler::Session> session{std::in_place,
+                                                      MakeSettings()};
+  EXPECT_THROW(utils::cpu_profiler::Session{MakeSettings()},
+               std::runtime_error);
+
+  session.reset();
+  EXPECT_NO_THROW(utils::cpu_profiler::Session{MakeSettings()});
+}
+
+USERVER_NAMESPACE_END
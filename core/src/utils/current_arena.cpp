@@ -0,0 +1,55 @@
+#include <userver/utils/current_arena.hpp>
+
+#include <utility>
+
+#include <engine/task/task_context.hpp>
+#include <userver/engine/task/local_variable.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace {
+
+engine::TaskLocalVariable<CurrentArenaScope*> current_arena_scope;
+
+CurrentArenaScope* GetCurrentScope() noexcept {
+  auto* current = engine::current_task::GetCurrentTaskContextUnchecked();
+  if (current == nullptr || !current->HasLocalStorage()) return nullptr;
+
+  auto* const* scope = current_arena_scope.GetOptional();
+  return scope ? *scope : nullptr;
+}
+
+}  // namespace
+
+CurrentArenaScope::CurrentArenaScope(Arena& arena)
+    : arena_(arena),
+#ifdef USERVER_IMPL_HAS_MEMORY_RESOURCE
+      resource_(arena),
+#endif
+      previous_(std::exchange(*current_arena_scope, this)) {
+}
+
+CurrentArenaScope::~CurrentArenaScope() {
+  UASSERT_MSG(*current_arena_scope == this,
+              "CurrentArenaScope objects are destroyed out of order or in "
+              "another task");
+  *current_arena_scope = previous_;
+}
+
+Arena* GetCurrentArena() noexcept {
+  auto* scope = GetCurrentScope();
+  return scope ? &scope->arena_ : nullptr;
+}
+
+#ifdef USERVER_IMPL_HAS_MEMORY_RESOURCE
+std::pmr::memory_resource* GetCurrentMemoryResource() noexcept {
+  auto* scope = GetCurrentScope();
+  return scope ? &scope->resource_ : std::pmr::get_default_resource();
+}
+#endif
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
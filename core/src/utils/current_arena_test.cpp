@@ -0,0 +1,74 @@
+#include <userver/utils/current_arena.hpp>
+
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(CurrentArenaScope, Sample) {
+  /// [Sample utils::CurrentArenaScope usage]
+  utils::Arena arena;
+  {
+    const utils::CurrentArenaScope scope{arena};
+
+    // Somewhere deep in the call stack
+    auto* current_arena = utils::GetCurrentArena();
+    ASSERT_NE(current_arena, nullptr);
+    std::vector<int, utils::ArenaAllocator<int>> values{
+        utils::ArenaAllocator<int>{*current_arena}};
+    values.assign(100, 42);
+  }
+  EXPECT_EQ(utils::GetCurrentArena(), nullptr);
+  /// [Sample utils::CurrentArenaScope usage]
+
+  EXPECT_GE(arena.GetStatistics().allocated_bytes, 100 * sizeof(int));
+}
+
+UTEST(CurrentArenaScope, Nested) {
+  EXPECT_EQ(utils::GetCurrentArena(), nullptr);
+
+  utils::Arena outer;
+  const utils::CurrentArenaScope outer_scope{outer};
+  EXPECT_EQ(utils::GetCurrentArena(), &outer);
+  {
+    utils::Arena inner;
+    const utils::CurrentArenaScope inner_scope{inner};
+    EXPECT_EQ(utils::GetCurrentArena(), &inner);
+  }
+  EXPECT_EQ(utils::GetCurrentArena(), &outer);
+}
+
+UTEST(CurrentArenaScope, NotInherited) {
+  utils::Arena arena;
+  const utils::CurrentArenaScope scope{arena};
+
+  engine::AsyncNoSpan([] {
+    EXPECT_EQ(utils::GetCurrentArena(), nullptr);
+  }).Get();
+  EXPECT_EQ(utils::GetCurrentArena(), &arena);
+}
+
+TEST(CurrentArenaScope, NoCoroutine) {
+  EXPECT_EQ(utils::GetCurrentArena(), nullptr);
+#ifdef USERVER_IMPL_HAS_MEMORY_RESOURCE
+  EXPECT_EQ(utils::GetCurrentMemoryResource(),
+            std::pmr::get_default_resource());
+#endif
+}
+
+#ifdef USERVER_IMPL_HAS_MEMORY_RESOURCE
+UTEST(CurrentArenaScope, MemoryResource) {
+  EXPECT_EQ(utils::GetCurrentMemoryResource(),
+            std::pmr::get_default_resource());
+
+  utils::Arena arena;
+  const utils::CurrentArenaScope scope{arena};
+  std::pmr::vector<int> values{utils::GetCurrentMemoryResource()};
+  values.assign(100, 42);
+  EXPECT_GE(arena.GetStatistics().allocated_bytes, 100 * sizeof(int));
+}
+#endif
+
+USERVER_NAMESPACE_END
@@ -6,6 +6,11 @@
 #include <cerrno>
 #endif
 
+#include <cstdint>
+#include <string_view>
+
+#include <fmt/format.h>
+
 #include <userver/utils/thread_name.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -36,6 +41,20 @@ std::error_code MallCtl(const char* name) {
   return MakeErrorCode(rc);
 }
 
+template <typename T>
+std::error_code MallCtlRead(const char* name, T& value) {
+  size_t size = sizeof(value);
+  int rc = mallctl(name, &value, &size, nullptr, 0);
+  return MakeErrorCode(rc);
+}
+
+template <typename T>
+std::error_code MallCtlReadArena(unsigned arena, std::string_view stat,
+                                 T& value) {
+  const auto name = fmt::format("stats.arenas.{}.{}", arena, stat);
+  return MallCtlRead(name.c_str(), value);
+}
+
 void MallocStatPrintCb(void* data, const char* msg) {
   auto* s = static_cast<std::string*>(data);
   *s += msg;
@@ -68,6 +87,49 @@ std::error_code StopBgThreads() {
   return MallCtl<bool>("background_thread", false);
 }
 
+ArenaStats& operator+=(ArenaStats& lhs, const ArenaStats& rhs) noexcept {
+  lhs.allocated_bytes += rhs.allocated_bytes;
+  lhs.resident_bytes += rhs.resident_bytes;
+  lhs.mapped_bytes += rhs.mapped_bytes;
+  return lhs;
+}
+
+std::error_code CreateArena(unsigned& arena) {
+  return MallCtlRead("arenas.create", arena);
+}
+
+std::error_code SetThreadArena(unsigned arena) {
+  if (auto ec = MallCtl<unsigned>("thread.arena", arena)) return ec;
+  return MallCtl("thread.tcache.flush");
+}
+
+std::error_code RefreshStats() {
+  std::uint64_t epoch = 1;
+  size_t size = sizeof(epoch);
+  int rc = mallctl("epoch", &epoch, &size, &epoch, size);
+  return MakeErrorCode(rc);
+}
+
+std::error_code GetArenaStats(unsigned arena, ArenaStats& stats) {
+  stats = {};
+  size_t small_allocated = 0;
+  size_t large_allocated = 0;
+  if (auto ec = MallCtlReadArena(arena, "small.allocated", small_allocated)) {
+    return ec;
+  }
+  if (auto ec = MallCtlReadArena(arena, "large.allocated", large_allocated)) {
+    return ec;
+  }
+  if (auto ec = MallCtlReadArena(arena, "resident", stats.resident_bytes)) {
+    return ec;
+  }
+  if (auto ec = MallCtlReadArena(arena, "mapped", stats.mapped_bytes)) {
+    return ec;
+  }
+  stats.allocated_bytes = small_allocated + large_allocated;
+  return {};
+}
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
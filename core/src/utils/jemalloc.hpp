@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <system_error>
 
@@ -22,6 +23,26 @@ std::error_code EnableBgThreads();
 // blocking
 std::error_code StopBgThreads();
 
+struct ArenaStats {
+  std::size_t allocated_bytes{0};
+  std::size_t resident_bytes{0};
+  std::size_t mapped_bytes{0};
+};
+
+ArenaStats& operator+=(ArenaStats& lhs, const ArenaStats& rhs) noexcept;
+
+// Creates a new arena, its index is written to `arena`
+std::error_code CreateArena(unsigned& arena);
+
+// Binds the current thread to the arena and flushes the thread cache, so that
+// the cached memory of the previous arena is not reused
+std::error_code SetThreadArena(unsigned arena);
+
+// Refreshes the statistics returned by GetArenaStats()
+std::error_code RefreshStats();
+
+std::error_code GetArenaStats(unsigned arena, ArenaStats& stats);
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,59 @@
+#include <utils/jemalloc.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Smaller than 'opt.oversize_threshold', so that the memory comes from the
+// arena of the worker rather than from the dedicated huge arena
+constexpr std::size_t kSize = 1024 * 1024;
+
+engine::TaskProcessorConfig MakeConfig(std::size_t jemalloc_arenas) {
+  engine::TaskProcessorConfig config;
+  config.name = "jemalloc-task-processor";
+  config.worker_threads = 2;
+  config.thread_name = "jemalloc-worker";
+  config.jemalloc_arenas = jemalloc_arenas;
+  return config;
+}
+
+}  // namespace
+
+UTEST(Jemalloc, NoArenas) {
+  engine::TaskProcessor tp(
+      MakeConfig(0),
+      engine::current_task::GetTaskProcessor().GetTaskProcessorPools());
+  EXPECT_FALSE(tp.HasJemallocArenas());
+  EXPECT_FALSE(tp.GetJemallocArenaStats());
+}
+
+UTEST(Jemalloc, TaskProcessorArenas) {
+  if (utils::jemalloc::RefreshStats()) {
+    GTEST_SKIP() << "jemalloc is not used";
+  }
+
+  engine::TaskProcessor tp(
+      MakeConfig(2),
+      engine::current_task::GetTaskProcessor().GetTaskProcessorPools());
+  ASSERT_TRUE(tp.HasJemallocArenas());
+
+  auto memory = engine::AsyncNoSpan(tp, [] {
+                  return std::make_unique<std::vector<char>>(kSize, 'a');
+                }).Get();
+
+  ASSERT_FALSE(utils::jemalloc::RefreshStats());
+  const auto stats = tp.GetJemallocArenaStats();
+  ASSERT_TRUE(stats);
+  EXPECT_GE(stats->allocated_bytes, kSize);
+  EXPECT_GE(stats->mapped_bytes, kSize);
+}
+
+USERVER_NAMESPACE_END
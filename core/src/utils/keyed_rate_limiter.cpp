@@ -0,0 +1,145 @@
+#include <userver/utils/keyed_rate_limiter.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/engine/shared_mutex.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/impl/transparent_hash.hpp>
+#include <userver/utils/mock_now.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace {
+
+using Rep = KeyedRateLimiter::Duration::rep;
+
+// A shard is swept of the idle keys when it grows twice since the last sweep
+constexpr std::size_t kMinSweepSize = 64;
+
+// The bucket keeps the time it becomes full ("theoretical arrival time" of
+// GCRA), each token moves it by the refill interval into the future. The
+// tokens are obtainable while it is at most a bucket size ahead of now.
+using Bucket = std::atomic<Rep>;
+
+Rep Now() noexcept {
+  return utils::datetime::MockSteadyNow().time_since_epoch().count();
+}
+
+bool IsIdle(const Bucket& bucket, Rep now) noexcept {
+  return bucket.load(std::memory_order_relaxed) <= now;
+}
+
+bool TryObtain(Bucket& bucket, Rep now, Rep cost, Rep capacity) noexcept {
+  auto full_at = bucket.load(std::memory_order_relaxed);
+  Rep new_full_at{};
+  do {
+    new_full_at = std::max(full_at, now) + cost;
+    if (new_full_at - now > capacity) return false;
+  } while (!bucket.compare_exchange_weak(full_at, new_full_at,
+                                         std::memory_order_relaxed));
+  return true;
+}
+
+KeyedRateLimiter::Duration MakeRefillInterval(double tokens_per_second) {
+  UINVARIANT(tokens_per_second > 0,
+             "KeyedRateLimiter tokens_per_second must be positive");
+  const std::chrono::duration<double> interval{1.0 / tokens_per_second};
+  return std::max(
+      std::chrono::duration_cast<KeyedRateLimiter::Duration>(interval),
+      KeyedRateLimiter::Duration{1});
+}
+
+}  // namespace
+
+struct alignas(concurrent::impl::kDestructiveInterferenceSize)
+    KeyedRateLimiter::Shard final {
+  mutable engine::SharedMutex mutex;
+  utils::impl::TransparentMap<std::string, Bucket> buckets;
+  std::size_t sweep_size{kMinSweepSize};
+
+  std::size_t SweepIdle(Rep now) {
+    std::size_t removed = 0;
+    for (auto it = buckets.begin(); it != buckets.end();) {
+      if (IsIdle(it->second, now)) {
+        it = buckets.erase(it);
+        ++removed;
+      } else {
+        ++it;
+      }
+    }
+    sweep_size = std::max(kMinSweepSize, buckets.size() * 2);
+    return removed;
+  }
+};
+
+KeyedRateLimiter::KeyedRateLimiter(const Config& config)
+    : refill_interval_(MakeRefillInterval(config.tokens_per_second)),
+      max_size_(config.max_size),
+      shards_count_(config.shards),
+      shards_(std::make_unique<Shard[]>(config.shards)) {
+  UINVARIANT(max_size_ > 0, "KeyedRateLimiter max_size must be positive");
+  UINVARIANT(shards_count_ > 0, "KeyedRateLimiter shards must be positive");
+}
+
+KeyedRateLimiter::~KeyedRateLimiter() = default;
+
+bool KeyedRateLimiter::Obtain(std::string_view key, std::size_t count) {
+  if (count > max_size_) return false;
+
+  const auto now = Now();
+  const auto cost = refill_interval_.count() * static_cast<Rep>(count);
+  const auto capacity = refill_interval_.count() * static_cast<Rep>(max_size_);
+  auto& shard = GetShard(key);
+
+  {
+    std::shared_lock lock{shard.mutex};
+    auto* bucket = utils::impl::FindTransparentOrNullptr(shard.buckets, key);
+    if (bucket) return TryObtain(*bucket, now, cost, capacity);
+  }
+
+  std::unique_lock lock{shard.mutex};
+  if (shard.buckets.size() >= shard.sweep_size) shard.SweepIdle(now);
+  // Another task may have added the key while the lock was released
+  auto& bucket =
+      shard.buckets.try_emplace(std::string{key}, Rep{0}).first->second;
+  return TryObtain(bucket, now, cost, capacity);
+}
+
+std::size_t KeyedRateLimiter::EvictIdle() {
+  const auto now = Now();
+  std::size_t removed = 0;
+  for (std::size_t i = 0; i < shards_count_; ++i) {
+    std::unique_lock lock{shards_[i].mutex};
+    removed += shards_[i].SweepIdle(now);
+  }
+  return removed;
+}
+
+std::size_t KeyedRateLimiter::GetKeysCountApprox() const {
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < shards_count_; ++i) {
+    std::shared_lock lock{shards_[i].mutex};
+    result += shards_[i].buckets.size();
+  }
+  return result;
+}
+
+KeyedRateLimiter::Shard& KeyedRateLimiter::GetShard(
+    std::string_view key) const noexcept {
+  // The high bits of the hash select the shard, the low ones are left for
+  // the buckets of the map
+  const auto hash = std::hash<std::string_view>{}(key);
+  return shards_[(hash >> (sizeof(hash) * 4)) % shards_count_];
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
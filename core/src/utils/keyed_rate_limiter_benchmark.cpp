@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/utils/keyed_rate_limiter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::vector<std::string> MakeKeys(std::size_t count) {
+  std::vector<std::string> keys;
+  keys.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    keys.push_back("client-" + std::to_string(i));
+  }
+  return keys;
+}
+
+}  // namespace
+
+// Obtain of state.range(0) known keys
+void keyed_rate_limiter_obtain(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto keys = MakeKeys(state.range(0));
+    utils::KeyedRateLimiter limiter{{1e9, 1'000'000'000}};
+    for (const auto& key : keys) benchmark::DoNotOptimize(limiter.Obtain(key));
+
+    std::size_t i = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(limiter.Obtain(keys[i]));
+      if (++i == keys.size()) i = 0;
+    }
+  });
+}
+BENCHMARK(keyed_rate_limiter_obtain)->RangeMultiplier(32)->Range(1, 32768);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,113 @@
+#include <userver/utils/keyed_rate_limiter.hpp>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/mock_now.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct MockNowScope final {
+  MockNowScope() {
+    utils::datetime::MockNowSet(std::chrono::system_clock::time_point{});
+  }
+  ~MockNowScope() { utils::datetime::MockNowUnset(); }
+};
+
+}  // namespace
+
+UTEST(KeyedRateLimiter, Burst) {
+  const MockNowScope mock_now;
+  utils::KeyedRateLimiter limiter{{10, 3}};
+
+  EXPECT_TRUE(limiter.Obtain("a"));
+  EXPECT_TRUE(limiter.Obtain("a"));
+  EXPECT_TRUE(limiter.Obtain("a"));
+  EXPECT_FALSE(limiter.Obtain("a"));
+
+  // Buckets of the other keys are independent
+  EXPECT_TRUE(limiter.Obtain("b", 3));
+  EXPECT_FALSE(limiter.Obtain("b"));
+  EXPECT_EQ(limiter.GetKeysCountApprox(), 2UL);
+}
+
+UTEST(KeyedRateLimiter, Refill) {
+  const MockNowScope mock_now;
+  utils::KeyedRateLimiter limiter{{10, 2}};
+
+  EXPECT_TRUE(limiter.Obtain("a", 2));
+  EXPECT_FALSE(limiter.Obtain("a"));
+
+  utils::datetime::MockSleep(std::chrono::milliseconds{100});
+  EXPECT_TRUE(limiter.Obtain("a"));
+  EXPECT_FALSE(limiter.Obtain("a"));
+
+  // The bucket is not refilled above its size
+  utils::datetime::MockSleep(std::chrono::seconds{10});
+  EXPECT_TRUE(limiter.Obtain("a", 2));
+  EXPECT_FALSE(limiter.Obtain("a"));
+}
+
+UTEST(KeyedRateLimiter, ObtainMoreThanSize) {
+  const MockNowScope mock_now;
+  utils::KeyedRateLimiter limiter{{10, 2}};
+
+  EXPECT_FALSE(limiter.Obtain("a", 3));
+  EXPECT_TRUE(limiter.Obtain("a", 2));
+}
+
+UTEST(KeyedRateLimiter, EvictIdle) {
+  const MockNowScope mock_now;
+  utils::KeyedRateLimiter limiter{{10, 2}};
+
+  EXPECT_TRUE(limiter.Obtain("a", 2));
+  EXPECT_TRUE(limiter.Obtain("b"));
+  EXPECT_EQ(limiter.GetKeysCountApprox(), 2UL);
+
+  utils::datetime::MockSleep(std::chrono::milliseconds{100});
+  EXPECT_EQ(limiter.EvictIdle(), 1UL);
+  EXPECT_EQ(limiter.GetKeysCountApprox(), 1UL);
+
+  // The evicted key starts with a full bucket, just as it would without
+  // the eviction
+  EXPECT_TRUE(limiter.Obtain("b", 2));
+  EXPECT_FALSE(limiter.Obtain("a", 2));
+}
+
+UTEST(KeyedRateLimiter, IdleKeysAreSweptOnInsert) {
+  const MockNowScope mock_now;
+  utils::KeyedRateLimiter limiter{{10, 1, 1}};
+
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(limiter.Obtain(std::to_string(i)));
+    utils::datetime::MockSleep(std::chrono::milliseconds{100});
+  }
+  EXPECT_LT(limiter.GetKeysCountApprox(), 100UL);
+}
+
+UTEST_MT(KeyedRateLimiter, Concurrent, 4) {
+  const MockNowScope mock_now;
+  constexpr std::size_t kSize = 1000;
+  utils::KeyedRateLimiter limiter{{1, kSize}};
+  std::atomic<std::size_t> obtained{0};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int i = 0; i < 4; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      for (std::size_t j = 0; j < kSize; ++j) {
+        if (limiter.Obtain("key")) ++obtained;
+        if (limiter.Obtain(std::to_string(j))) ++obtained;
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_EQ(obtained.load(), kSize * (1 + 4));
+}
+
+USERVER_NAMESPACE_END
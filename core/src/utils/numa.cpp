@@ -0,0 +1,182 @@
+#include <utils/numa.hpp>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include <userver/fs/blocking/read.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/text_light.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::numa {
+
+namespace {
+
+constexpr std::string_view kNodesPossiblePath =
+    "/sys/devices/system/node/possible";
+
+thread_local std::size_t current_thread_node = 0;
+
+std::string_view Trim(std::string_view str) {
+  while (!str.empty() && utils::text::IsAsciiSpace(str.front())) {
+    str.remove_prefix(1);
+  }
+  while (!str.empty() && utils::text::IsAsciiSpace(str.back())) {
+    str.remove_suffix(1);
+  }
+  return str;
+}
+
+std::optional<std::size_t> FindNodeOfCpu(std::size_t cpu) {
+  const auto nodes_count = GetNodesCount();
+  for (std::size_t node = 0; node < nodes_count; ++node) {
+    try {
+      const auto cpus = GetNodeCpus(node);
+      if (std::find(cpus.begin(), cpus.end(), cpu) != cpus.end()) return node;
+    } catch (const std::exception&) {
+      // nodes may be sparse
+    }
+  }
+  return std::nullopt;
+}
+
+}  // namespace
+
+CpuSet ParseCpuList(std::string_view cpu_list) {
+  CpuSet result;
+
+  cpu_list = Trim(cpu_list);
+  while (!cpu_list.empty()) {
+    const auto comma_pos = cpu_list.find(',');
+    const auto range = Trim(cpu_list.substr(0, comma_pos));
+    cpu_list = (comma_pos == std::string_view::npos)
+                   ? std::string_view{}
+                   : cpu_list.substr(comma_pos + 1);
+
+    if (range.empty()) {
+      throw std::runtime_error("Empty range in CPU list");
+    }
+
+    const auto dash_pos = range.find('-');
+    const auto first =
+        utils::FromString<std::size_t>(Trim(range.substr(0, dash_pos)));
+    const auto last =
+        (dash_pos == std::string_view::npos)
+            ? first
+            : utils::FromString<std::size_t>(Trim(range.substr(dash_pos + 1)));
+    if (last < first) {
+      throw std::runtime_error(
+          fmt::format("Invalid range '{}' in CPU list", range));
+    }
+
+    for (auto cpu = first; cpu <= last; ++cpu) result.push_back(cpu);
+  }
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+std::size_t GetNodesCount() {
+  static const std::size_t kNodesCount = [] {
+    try {
+      const auto nodes = ParseCpuList(
+          fs::blocking::ReadFileContents(std::string{kNodesPossiblePath}));
+      return nodes.empty() ? std::size_t{1} : nodes.back() + 1;
+    } catch (const std::exception& ex) {
+      LOG_DEBUG() << "Failed to get NUMA nodes count, assuming 1: " << ex;
+      return std::size_t{1};
+    }
+  }();
+  return kNodesCount;
+}
+
+CpuSet GetNodeCpus(std::size_t node) {
+  const auto path =
+      fmt::format("/sys/devices/system/node/node{}/cpulist", node);
+  if (!fs::blocking::FileExists(path)) {
+    throw std::runtime_error(
+        fmt::format("NUMA node {} does not exist on this host", node));
+  }
+  return ParseCpuList(fs::blocking::ReadFileContents(path));
+}
+
+void SetCurrentThreadAffinity(const CpuSet& cpus) {
+  if (cpus.empty()) return;
+
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      throw std::runtime_error(fmt::format("CPU {} is out of range", cpu));
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  static constexpr ::pid_t kThisThreadPid = 0;
+  utils::CheckSyscall(
+      ::sched_setaffinity(kThisThreadPid, sizeof(cpu_set), &cpu_set),
+      "setting thread affinity to CPUs {}", fmt::join(cpus, ","));
+#else
+  LOG_WARNING() << "Thread affinity is not supported on this platform";
+#endif
+}
+
+void SetCurrentThreadNode(std::size_t node) noexcept {
+  current_thread_node = node;
+}
+
+std::size_t GetCurrentThreadNode() noexcept { return current_thread_node; }
+
+CpuSet ThreadPlacement::ResolveCpus() const {
+  if (!numa_node) return cpu_set;
+
+  auto node_cpus = GetNodeCpus(*numa_node);
+  if (cpu_set.empty()) return node_cpus;
+
+  for (const auto cpu : cpu_set) {
+    if (std::find(node_cpus.begin(), node_cpus.end(), cpu) == node_cpus.end()) {
+      throw std::runtime_error(fmt::format(
+          "CPU {} from cpu-set does not belong to NUMA node {}", cpu,
+          *numa_node));
+    }
+  }
+  return cpu_set;
+}
+
+void ThreadPlacement::ApplyToCurrentThread(const CpuSet& cpus) const {
+  SetCurrentThreadAffinity(cpus);
+
+  if (numa_node) {
+    SetCurrentThreadNode(*numa_node);
+  } else if (!cpus.empty()) {
+    SetCurrentThreadNode(FindNodeOfCpu(cpus.front()).value_or(0));
+  }
+}
+
+ThreadPlacement Parse(const yaml_config::YamlConfig& value,
+                      formats::parse::To<ThreadPlacement>) {
+  ThreadPlacement placement;
+  placement.numa_node =
+      value["numa-node"].As<std::optional<std::size_t>>();
+  const auto cpu_set = value["cpu-set"].As<std::optional<std::string>>();
+  if (cpu_set) placement.cpu_set = ParseCpuList(*cpu_set);
+  return placement;
+}
+
+}  // namespace utils::numa
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <userver/formats/parse/to.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// Helpers to place OS threads on NUMA nodes and CPUs.
+namespace utils::numa {
+
+using CpuSet = std::vector<std::size_t>;
+
+/// Parses a Linux CPU list, e.g. "0-3,8,10-11"
+/// @throws std::runtime_error on invalid input
+CpuSet ParseCpuList(std::string_view cpu_list);
+
+/// Returns the number of NUMA nodes, 1 if the information is not available
+std::size_t GetNodesCount();
+
+/// Returns the CPUs of the NUMA node
+/// @throws std::runtime_error if there's no such node
+CpuSet GetNodeCpus(std::size_t node);
+
+/// Pins the current thread to `cpus`, does nothing if `cpus` is empty
+/// @throws std::system_error
+void SetCurrentThreadAffinity(const CpuSet& cpus);
+
+/// Remembers the NUMA node the current thread is running on. It is used by
+/// per-node resource pools, e.g. by the coroutine stacks pool.
+void SetCurrentThreadNode(std::size_t node) noexcept;
+
+/// Returns the NUMA node set by SetCurrentThreadNode or 0
+std::size_t GetCurrentThreadNode() noexcept;
+
+/// Placement of a group of threads, parsed from the `numa-node` and `cpu-set`
+/// static config options.
+struct ThreadPlacement {
+  std::optional<std::size_t> numa_node;
+  CpuSet cpu_set;
+
+  bool IsEmpty() const noexcept { return !numa_node && cpu_set.empty(); }
+
+  /// Returns the CPUs to pin the threads to: `cpu_set` if it is not empty, all
+  /// the CPUs of `numa_node` otherwise.
+  /// @throws std::runtime_error if both options are set and `cpu_set` has CPUs
+  /// from outside of `numa_node`.
+  CpuSet ResolveCpus() const;
+
+  /// Pins the current thread to `cpus` and remembers its node
+  void ApplyToCurrentThread(const CpuSet& cpus) const;
+};
+
+ThreadPlacement Parse(const yaml_config::YamlConfig& value,
+                      formats::parse::To<ThreadPlacement>);
+
+}  // namespace utils::numa
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,58 @@
+#include <utils/numa.hpp>
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(Numa, ParseCpuList) {
+  using utils::numa::CpuSet;
+  using utils::numa::ParseCpuList;
+
+  EXPECT_EQ(ParseCpuList(""), CpuSet{});
+  EXPECT_EQ(ParseCpuList("0\n"), (CpuSet{0}));
+  EXPECT_EQ(ParseCpuList("0-3"), (CpuSet{0, 1, 2, 3}));
+  EXPECT_EQ(ParseCpuList("8, 0-1,10-11"), (CpuSet{0, 1, 8, 10, 11}));
+  EXPECT_EQ(ParseCpuList("1,1,0-1"), (CpuSet{0, 1}));
+
+  EXPECT_ANY_THROW(ParseCpuList("3-1"));
+  EXPECT_ANY_THROW(ParseCpuList("1,,2"));
+  EXPECT_ANY_THROW(ParseCpuList("a-b"));
+}
+
+TEST(Numa, NodesCount) { EXPECT_GE(utils::numa::GetNodesCount(), 1); }
+
+TEST(Numa, ResolveCpus) {
+  utils::numa::ThreadPlacement placement;
+  EXPECT_TRUE(placement.IsEmpty());
+  EXPECT_TRUE(placement.ResolveCpus().empty());
+
+  placement.cpu_set = {0};
+  EXPECT_FALSE(placement.IsEmpty());
+  EXPECT_EQ(placement.ResolveCpus(), utils::numa::CpuSet{0});
+
+  placement.numa_node = utils::numa::GetNodesCount() + 1;
+  EXPECT_ANY_THROW(placement.ResolveCpus());
+}
+
+TEST(Numa, CurrentThreadNode) {
+  std::thread([] {
+    EXPECT_EQ(utils::numa::GetCurrentThreadNode(), 0);
+    utils::numa::SetCurrentThreadNode(1);
+    EXPECT_EQ(utils::numa::GetCurrentThreadNode(), 1);
+  }).join();
+
+  EXPECT_EQ(utils::numa::GetCurrentThreadNode(), 0);
+}
+
+TEST(Numa, SetCurrentThreadAffinity) {
+  std::thread([] {
+    EXPECT_NO_THROW(utils::numa::SetCurrentThreadAffinity({}));
+#ifdef __linux__
+    EXPECT_NO_THROW(utils::numa::SetCurrentThreadAffinity({0}));
+#endif
+  }).join();
+}
+
+USERVER_NAMESPACE_END
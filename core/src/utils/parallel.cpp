@@ -0,0 +1,101 @@
+#include <userver/utils/parallel.hpp>
+
+#include <userver/engine/task/task.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+namespace {
+
+// A chunk is the remaining elements divided by the number of the workers and
+// by this factor, so that a slow chunk can not delay the finish much
+constexpr std::size_t kChunksPerWorker = 4;
+
+engine::TaskProcessor& GetTaskProcessor(const ParallelSettings& settings) {
+  return settings.task_processor ? *settings.task_processor
+                                 : engine::current_task::GetTaskProcessor();
+}
+
+}  // namespace
+
+std::size_t GetParallelism(std::size_t size, const ParallelSettings& settings) {
+  const auto max_concurrency =
+      settings.max_concurrency != 0
+          ? settings.max_concurrency
+          : engine::GetWorkerCount(GetTaskProcessor(settings));
+  const auto min_chunk_size = std::max<std::size_t>(settings.min_chunk_size, 1);
+  const auto max_chunks = (size + min_chunk_size - 1) / min_chunk_size;
+  return std::max<std::size_t>(std::min(max_concurrency, max_chunks), 1);
+}
+
+ParallelScheduler::ParallelScheduler(std::size_t size,
+                                     const ParallelSettings& settings)
+    : task_processor_(GetTaskProcessor(settings)),
+      size_(size),
+      min_chunk_size_(std::max<std::size_t>(settings.min_chunk_size, 1)),
+      worker_count_(GetParallelism(size, settings)),
+      deadline_(settings.deadline) {}
+
+auto ParallelScheduler::NextChunk(std::size_t worker) noexcept
+    -> std::optional<Chunk> {
+  if (stopped_.load(std::memory_order_relaxed)) return std::nullopt;
+
+  if (engine::current_task::ShouldCancel()) {
+    // A cancelled helper leaves its chunks to the others
+    if (worker == 0) Interrupt(engine::current_task::CancellationReason());
+    return std::nullopt;
+  }
+  if (deadline_.IsReached()) {
+    Interrupt(engine::TaskCancellationReason::kDeadline);
+    return std::nullopt;
+  }
+
+  auto begin = next_.load(std::memory_order_relaxed);
+  std::size_t end = 0;
+  do {
+    if (begin >= size_) return std::nullopt;
+    const auto chunk_size = std::max(
+        min_chunk_size_, (size_ - begin) / (worker_count_ * kChunksPerWorker));
+    end = std::min(size_, begin + chunk_size);
+  } while (!next_.compare_exchange_weak(begin, end, std::memory_order_relaxed));
+
+  return Chunk{begin, end};
+}
+
+void ParallelScheduler::SetException(std::exception_ptr exception) noexcept {
+  if (!has_exception_.exchange(true)) exception_ = std::move(exception);
+  stopped_ = true;
+}
+
+void ParallelScheduler::Interrupt(
+    engine::TaskCancellationReason reason) noexcept {
+  auto expected = engine::TaskCancellationReason::kNone;
+  interrupt_reason_.compare_exchange_strong(expected, reason);
+  stopped_ = true;
+}
+
+void ParallelScheduler::Join(
+    std::vector<engine::TaskWithResult<void>>& helpers) {
+  for (auto& helper : helpers) {
+    try {
+      helper.Get();
+    } catch (const engine::TaskCancelledException&) {
+      // The helper has been cancelled before the start, e.g. due to the task
+      // processor overload, its chunks have been processed by the others
+    }
+  }
+
+  if (has_exception_) std::rethrow_exception(exception_);
+
+  const auto reason = interrupt_reason_.load();
+  if (reason != engine::TaskCancellationReason::kNone) {
+    throw engine::WaitInterruptedException(reason);
+  }
+  UASSERT(next_.load() >= size_);
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/utils/parallel.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kSize = 1'000'000;
+
+std::vector<std::uint32_t> MakeValues() {
+  std::vector<std::uint32_t> values(kSize);
+  for (auto& value : values) value = utils::Rand();
+  return values;
+}
+
+}  // namespace
+
+// std::sort, state.range(0) is unused
+void parallel_sort_baseline(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto source = MakeValues();
+    for ([[maybe_unused]] auto _ : state) {
+      state.PauseTiming();
+      auto values = source;
+      state.ResumeTiming();
+      std::sort(values.begin(), values.end());
+      benchmark::DoNotOptimize(values.data());
+    }
+  });
+}
+BENCHMARK(parallel_sort_baseline)->Arg(1);
+
+// utils::ParallelSort on state.range(0) threads
+void parallel_sort(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    const auto source = MakeValues();
+    for ([[maybe_unused]] auto _ : state) {
+      state.PauseTiming();
+      auto values = source;
+      state.ResumeTiming();
+      utils::ParallelSort(values.begin(), values.end());
+      benchmark::DoNotOptimize(values.data());
+    }
+  });
+}
+BENCHMARK(parallel_sort)->RangeMultiplier(2)->Range(1, 8);
+
+// utils::ParallelTransformReduce of a cheap transform on state.range(0)
+// threads
+void parallel_transform_reduce(benchmark::State& state) {
+  engine::RunStandalone(state.range(0), [&] {
+    const auto values = MakeValues();
+    utils::ParallelSettings settings;
+    settings.min_chunk_size = 4096;
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(utils::ParallelTransformReduce(
+          values.begin(), values.end(), std::uint64_t{0}, std::plus<>{},
+          [](std::uint32_t value) { return std::uint64_t{value} * value; },
+          settings));
+    }
+  });
+}
+BENCHMARK(parallel_transform_reduce)->RangeMultiplier(2)->Range(1, 8);
+
+USERVER_NAMESPACE_END
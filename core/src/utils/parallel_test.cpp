@@ -0,0 +1,105 @@
+#include <userver/utils/parallel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/rand.hpp>
+
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST_MT(UtilsParallel, ParallelFor, 4) {
+  std::vector<std::atomic<int>> counters(10000);
+
+  utils::ParallelFor(counters.begin(), counters.end(),
+                     [](std::atomic<int>& counter) { ++counter; });
+
+  for (const auto& counter : counters) ASSERT_EQ(counter, 1);
+}
+
+UTEST_MT(UtilsParallel, ParallelForEmpty, 4) {
+  std::vector<int> values;
+  utils::ParallelFor(values.begin(), values.end(),
+                     [](int) { ADD_FAILURE() << "Called for an empty range"; });
+}
+
+UTEST_MT(UtilsParallel, ParallelForThrows, 4) {
+  std::vector<int> values(1000);
+  std::iota(values.begin(), values.end(), 0);
+
+  UEXPECT_THROW(utils::ParallelFor(values.begin(), values.end(),
+                                   [](int value) {
+                                     if (value == 500) {
+                                       throw std::runtime_error("test");
+                                     }
+                                   }),
+                std::runtime_error);
+}
+
+UTEST_MT(UtilsParallel, ParallelForDeadline, 4) {
+  std::vector<int> values(1000);
+  utils::ParallelSettings settings;
+  settings.deadline =
+      engine::Deadline::FromDuration(std::chrono::milliseconds{10});
+
+  UEXPECT_THROW(
+      utils::ParallelFor(
+          values.begin(), values.end(),
+          [](int) { engine::SleepFor(std::chrono::milliseconds{1}); },
+          settings),
+      engine::WaitInterruptedException);
+}
+
+UTEST_MT(UtilsParallel, ParallelForCancelled, 4) {
+  std::vector<int> values(1000);
+  engine::current_task::GetCancellationToken().RequestCancel();
+
+  UEXPECT_THROW(utils::ParallelFor(values.begin(), values.end(), [](int) {}),
+                engine::WaitInterruptedException);
+}
+
+UTEST_MT(UtilsParallel, ParallelTransformReduce, 4) {
+  std::vector<std::int64_t> values(100000);
+  std::iota(values.begin(), values.end(), 0);
+
+  utils::ParallelSettings settings;
+  settings.min_chunk_size = 100;
+  const auto sum = utils::ParallelTransformReduce(
+      values.begin(), values.end(), std::int64_t{1}, std::plus<>{},
+      [](std::int64_t value) { return value * 2; }, settings);
+
+  EXPECT_EQ(sum, 1 + std::int64_t{100000} * (100000 - 1));
+}
+
+UTEST_MT(UtilsParallel, ParallelSort, 4) {
+  std::vector<std::uint32_t> values(100000);
+  for (auto& value : values) value = utils::Rand();
+  auto expected = values;
+  std::sort(expected.begin(), expected.end(), std::greater<>{});
+
+  utils::ParallelSort(values.begin(), values.end(), std::greater<>{});
+  EXPECT_EQ(values, expected);
+}
+
+UTEST(UtilsParallel, SingleThread) {
+  std::vector<int> values(100);
+  std::iota(values.rbegin(), values.rend(), 0);
+
+  utils::ParallelSort(values.begin(), values.end());
+  EXPECT_TRUE(std::is_sorted(values.begin(), values.end()));
+
+  const auto sum = utils::ParallelTransformReduce(
+      values.begin(), values.end(), 0, std::plus<>{}, [](int value) {
+        return value;
+      });
+  EXPECT_EQ(sum, 99 * 100 / 2);
+}
+
+USERVER_NAMESPACE_END
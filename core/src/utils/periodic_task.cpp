@@ -1,5 +1,6 @@
 #include <userver/utils/periodic_task.hpp>
 
+#include <algorithm>
 #include <random>
 
 #include <fmt/format.h>
@@ -9,7 +10,9 @@
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/tracer.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
 #include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -114,11 +117,13 @@ bool PeriodicTask::IsRunning() const { return task_.IsValid(); }
 
 void PeriodicTask::Run() {
   bool skip_step = false;
+  bool random_start = false;
   {
     auto settings = settings_.Read();
     if (!(settings->flags & Flags::kNow)) {
       skip_step = true;
     }
+    random_start = static_cast<bool>(settings->flags & Flags::kRandomStart);
   }
 
   while (!engine::current_task::ShouldCancel()) {
@@ -142,8 +147,13 @@ void PeriodicTask::Run() {
       start = std::chrono::steady_clock::now();
     }
 
-    while (changed_event_.WaitForEventUntil(start + MutatePeriod(period))) {
+    auto next_step = start + (std::exchange(random_start, false)
+                                  ? MakeRandomStartDelay(period)
+                                  : MutatePeriod(period));
+    bool forced = false;
+    while (changed_event_.WaitForEventUntil(next_step)) {
       if (should_force_step_.exchange(false)) {
+        forced = true;
         break;
       }
       // The config variable value has been changed, reload
@@ -151,6 +161,15 @@ void PeriodicTask::Run() {
       period = settings->period;
       const auto exception_period = settings->exception_period.value_or(period);
       if (!no_exception) period = exception_period;
+      next_step = start + MutatePeriod(period);
+    }
+
+    // The wait is also interrupted early by the cancellation
+    if (!forced && !engine::current_task::ShouldCancel()) {
+      const auto lag = std::max(std::chrono::steady_clock::now() - next_step,
+                                std::chrono::steady_clock::duration::zero());
+      statistics_.last_lag_us =
+          std::chrono::duration_cast<std::chrono::microseconds>(lag).count();
     }
   }
 }
@@ -160,12 +179,23 @@ bool PeriodicTask::DoStep() {
   const auto span_log_level = settings_ptr->span_level;
   const auto name_ptr = name_.Read();
   tracing::Span span(*name_ptr, tracing::ReferenceType::kChild, span_log_level);
+
+  const auto start = std::chrono::steady_clock::now();
+  const utils::FastScopeGuard account_run([&]() noexcept {
+    ++statistics_.runs;
+    statistics_.run_time_us +=
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+            .count();
+  });
+
   try {
     callback_();
     return true;
   } catch (const std::exception& e) {
     LOG_ERROR() << "Exception in PeriodicTask with name=" << *name_ptr << ": "
                 << e;
+    ++statistics_.failures;
     return false;
   }
 }
@@ -211,6 +241,12 @@ std::chrono::milliseconds PeriodicTask::MutatePeriod(
   return std::chrono::milliseconds(ms);
 }
 
+std::chrono::milliseconds PeriodicTask::MakeRandomStartDelay(
+    std::chrono::milliseconds period) {
+  if (period <= std::chrono::milliseconds::zero()) return period;
+  return std::chrono::milliseconds{utils::RandRange(period.count() + 1)};
+}
+
 void PeriodicTask::SuspendDebug() {
   // step_mutex_ waits, for a potentially long time, for Step() call completion
   const std::lock_guard lock_step(step_mutex_);
@@ -240,6 +276,14 @@ PeriodicTask::Settings PeriodicTask::GetCurrentSettings() const {
   return *settings_ptr;
 }
 
+void DumpMetric(utils::statistics::Writer& writer,
+                const PeriodicTask::Statistics& stats) {
+  writer["runs"] = stats.runs;
+  writer["failures"] = stats.failures;
+  writer["run-time-us"] = stats.run_time_us;
+  writer["last-lag-us"] = stats.last_lag_us;
+}
+
 }  // namespace utils
 
 USERVER_NAMESPACE_END
@@ -421,6 +421,40 @@ UTEST(PeriodicTask, SynchronizeDebugSpan) {
   task.Stop();
 }
 
+UTEST(PeriodicTask, RandomStart) {
+  SimpleTaskData simple;
+
+  constexpr auto period = 20ms;
+  constexpr Count n = 3;
+  utils::PeriodicTask task(
+      "task",
+      utils::PeriodicTask::Settings(period,
+                                    utils::PeriodicTask::Flags::kRandomStart),
+      simple.GetTaskFunction());
+  EXPECT_TRUE(simple.WaitFor(period * n * kSlowRatio,
+                             [&simple]() { return simple.GetCount() > n; }));
+  task.Stop();
+}
+
+UTEST(PeriodicTask, Statistics) {
+  SimpleTaskData simple;
+  simple.throw_exception = true;
+
+  constexpr auto period = 1ms;
+  constexpr Count n = 3;
+  utils::PeriodicTask task(
+      "task",
+      utils::PeriodicTask::Settings(period, utils::PeriodicTask::Flags::kNow),
+      simple.GetTaskFunction());
+  EXPECT_TRUE(simple.WaitFor(utest::kMaxTestWaitTime,
+                             [&simple]() { return simple.GetCount() > n; }));
+  task.Stop();
+
+  const auto& stats = task.GetStatistics();
+  EXPECT_EQ(stats.runs.Load(), simple.GetCount());
+  EXPECT_EQ(stats.failures.Load(), simple.GetCount());
+}
+
 class PeriodicTaskLog : public LoggingTest {};
 
 UTEST_F(PeriodicTaskLog, ErrorLog) {
@@ -0,0 +1,60 @@
+#include <utils/signal_backtrace.hpp>
+
+#include <execinfo.h>
+#include <ucontext.h>
+
+#include <algorithm>
+#include <iterator>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+namespace {
+
+// Frames of the signal handler itself
+constexpr std::size_t kMaxHandlerFrames = 8;
+constexpr std::size_t kFallbackHandlerFrames = 2;
+
+void* GetInterruptedPc([[maybe_unused]] void* ucontext) noexcept {
+#if defined(__linux__) && defined(__x86_64__)
+  return reinterpret_cast<void*>(
+      static_cast<ucontext_t*>(ucontext)->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__linux__) && defined(__aarch64__)
+  return reinterpret_cast<void*>(
+      static_cast<ucontext_t*>(ucontext)->uc_mcontext.pc);
+#else
+  return nullptr;
+#endif
+}
+
+}  // namespace
+
+void PrepareSignalBacktrace() {
+  // backtrace() loads libgcc on the first call, which must not happen in
+  // the signal handler
+  void* frame = nullptr;
+  backtrace(&frame, 1);
+}
+
+std::size_t SignalBacktrace(void* ucontext, void** frames) noexcept {
+  void* all_frames[kMaxSignalBacktraceDepth + kMaxHandlerFrames];
+  const auto depth = static_cast<std::size_t>(
+      backtrace(all_frames, static_cast<int>(std::size(all_frames))));
+
+  auto first = std::min(kFallbackHandlerFrames, depth);
+  if (auto* const interrupted_pc = GetInterruptedPc(ucontext)) {
+    const auto handler_frames = std::min(kMaxHandlerFrames, depth);
+    const auto* const it =
+        std::find(all_frames, all_frames + handler_frames, interrupted_pc);
+    if (it != all_frames + handler_frames) first = it - all_frames;
+  }
+
+  const auto result = std::min(depth - first, kMaxSignalBacktraceDepth);
+  std::copy_n(all_frames + first, result, frames);
+  return result;
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+inline constexpr std::size_t kMaxSignalBacktraceDepth = 64;
+
+// Loads what backtrace() needs, so that SignalBacktrace() does not allocate.
+// Must be called before the signal handler is installed.
+void PrepareSignalBacktrace();
+
+// Collects up to kMaxSignalBacktraceDepth return addresses of the code that
+// was interrupted by the signal into `frames`, skipping the frames of the
+// signal handler. Async-signal-safe.
+std::size_t SignalBacktrace(void* ucontext, void** frames) noexcept;
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
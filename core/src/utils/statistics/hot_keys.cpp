@@ -0,0 +1,133 @@
+#include <userver/utils/statistics/hot_keys.hpp>
+
+#include <algorithm>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace impl {
+
+SpaceSaving::SpaceSaving(std::size_t capacity) : capacity_(capacity) {
+  UINVARIANT(capacity_ > 0, "HotKeys must track at least one key");
+  counters_.reserve(capacity_);
+}
+
+void SpaceSaving::Account(std::string_view key) {
+  ++total_;
+  // Heterogeneous lookup is not available for unordered_map in C++17
+  const std::string key_str{key};
+  const auto it = counters_.find(key_str);
+  if (it != counters_.end()) {
+    ++it->second.count;
+    return;
+  }
+  if (counters_.size() < capacity_) {
+    counters_.emplace(key_str, Counter{1, 0});
+    return;
+  }
+
+  // The new key replaces the least frequent one and inherits its count as
+  // the error. The scan is linear, the capacity is small and the accesses
+  // are sampled.
+  const auto min = std::min_element(
+      counters_.begin(), counters_.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.second.count < rhs.second.count;
+      });
+  const auto min_count = min->second.count;
+  counters_.erase(min);
+  counters_.emplace(key_str, Counter{min_count + 1, min_count});
+}
+
+void SpaceSaving::Decay() {
+  total_ /= 2;
+  for (auto it = counters_.begin(); it != counters_.end();) {
+    it->second.count /= 2;
+    it->second.error /= 2;
+    if (it->second.count == 0) {
+      it = counters_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void SpaceSaving::MergeInto(
+    std::unordered_map<std::string, HotKey>& keys) const {
+  for (const auto& [key, counter] : counters_) {
+    auto& hot_key = keys[key];
+    hot_key.count += counter.count;
+    hot_key.error += counter.error;
+  }
+}
+
+}  // namespace impl
+
+HotKeys::HotKeys(HotKeysSettings settings)
+    : settings_(settings), shards_(settings.capacity) {
+  UINVARIANT(settings_.sample_rate > 0, "HotKeys sample rate must be positive");
+}
+
+std::vector<HotKey> HotKeys::GetTop(std::size_t limit) const {
+  std::unordered_map<std::string, HotKey> merged;
+  shards_.VisitAll([&merged](const impl::SpaceSaving& shard) {
+    shard.MergeInto(merged);
+  });
+
+  std::vector<HotKey> result;
+  result.reserve(merged.size());
+  for (auto& [key, hot_key] : merged) {
+    hot_key.key = key;
+    hot_key.count *= settings_.sample_rate;
+    hot_key.error *= settings_.sample_rate;
+    result.push_back(std::move(hot_key));
+  }
+
+  limit = std::min(limit, result.size());
+  std::partial_sort(result.begin(), result.begin() + limit, result.end(),
+                    [](const HotKey& lhs, const HotKey& rhs) {
+                      return lhs.count > rhs.count;
+                    });
+  result.resize(limit);
+  return result;
+}
+
+std::uint64_t HotKeys::GetTotal() const {
+  std::uint64_t total = 0;
+  shards_.VisitAll(
+      [&total](const impl::SpaceSaving& shard) { total += shard.GetTotal(); });
+  return total * settings_.sample_rate;
+}
+
+void HotKeys::Decay() {
+  shards_.VisitAll([](impl::SpaceSaving& shard) { shard.Decay(); });
+}
+
+bool HotKeys::ShouldSample() const {
+  return settings_.sample_rate == 1 ||
+         utils::RandRange(settings_.sample_rate) == 0;
+}
+
+void HotKeys::DoAccount(std::string_view key) {
+  auto shard = shards_.Lock();
+  shard->Account(key);
+}
+
+void DumpMetric(Writer& writer, const HotKeys& hot_keys) {
+  const auto total = hot_keys.GetTotal();
+  const auto top = hot_keys.GetTop(1);
+  writer["accesses"] = total;
+  writer["top-key-percent"] =
+      (top.empty() || total == 0)
+          ? 0.0
+          : 100.0 * static_cast<double>(top.front().count) /
+                static_cast<double>(total);
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,102 @@
+#include <userver/utils/statistics/hot_keys.hpp>
+
+#include <string>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using utils::statistics::HotKeys;
+using utils::statistics::HotKeysSettings;
+
+HotKeysSettings MakeSettings(std::size_t capacity) {
+  HotKeysSettings settings;
+  settings.capacity = capacity;
+  settings.sample_rate = 1;
+  return settings;
+}
+
+}  // namespace
+
+UTEST(HotKeys, Top) {
+  HotKeys hot_keys{MakeSettings(8)};
+  for (int i = 0; i < 100; ++i) hot_keys.Account(std::string{"hot"});
+  for (int i = 0; i < 10; ++i) hot_keys.Account(std::string_view{"warm"});
+  hot_keys.Account(42);
+
+  const auto top = hot_keys.GetTop(2);
+  ASSERT_EQ(top.size(), 2);
+  EXPECT_EQ(top[0].key, "hot");
+  EXPECT_EQ(top[0].count, 100);
+  EXPECT_EQ(top[0].error, 0);
+  EXPECT_EQ(top[1].key, "warm");
+  EXPECT_EQ(top[1].count, 10);
+
+  EXPECT_EQ(hot_keys.GetTop(10).size(), 3);
+  EXPECT_EQ(hot_keys.GetTop(10).back().key, "42");
+  EXPECT_EQ(hot_keys.GetTotal(), 111);
+}
+
+UTEST(HotKeys, Eviction) {
+  HotKeys hot_keys{MakeSettings(2)};
+  for (int i = 0; i < 50; ++i) hot_keys.Account(std::string{"hot"});
+  // A stream of the unique keys does not push out the hot one
+  for (int i = 0; i < 40; ++i) hot_keys.Account(std::to_string(i));
+
+  const auto top = hot_keys.GetTop(1);
+  ASSERT_EQ(top.size(), 1);
+  EXPECT_EQ(top[0].key, "hot");
+  EXPECT_EQ(top[0].count, 50);
+
+  const auto all = hot_keys.GetTop(10);
+  ASSERT_EQ(all.size(), 2);
+  // The count of the replacing key includes the count of the replaced one
+  EXPECT_EQ(all[1].count, 40);
+  EXPECT_EQ(all[1].error, 39);
+}
+
+UTEST(HotKeys, Decay) {
+  HotKeys hot_keys{MakeSettings(8)};
+  for (int i = 0; i < 10; ++i) hot_keys.Account(std::string{"a"});
+  hot_keys.Account(std::string{"b"});
+
+  hot_keys.Decay();
+  const auto top = hot_keys.GetTop(10);
+  ASSERT_EQ(top.size(), 1);
+  EXPECT_EQ(top[0].key, "a");
+  EXPECT_EQ(top[0].count, 5);
+  EXPECT_EQ(hot_keys.GetTotal(), 5);
+}
+
+UTEST(HotKeys, Sampling) {
+  HotKeysSettings settings;
+  settings.sample_rate = 4;
+  HotKeys hot_keys{settings};
+  for (int i = 0; i < 4000; ++i) hot_keys.Account(std::string{"key"});
+
+  // The counts are scaled back by the sample rate
+  const auto top = hot_keys.GetTop(1);
+  ASSERT_EQ(top.size(), 1);
+  EXPECT_EQ(top[0].count % 4, 0);
+  EXPECT_GT(top[0].count, 3000);
+  EXPECT_LT(top[0].count, 5000);
+}
+
+UTEST(HotKeys, Metrics) {
+  HotKeys hot_keys{MakeSettings(8)};
+  for (int i = 0; i < 3; ++i) hot_keys.Account(std::string{"a"});
+  hot_keys.Account(std::string{"b"});
+
+  utils::statistics::Storage storage;
+  const auto entry = storage.RegisterWriter(
+      "hot-keys",
+      [&hot_keys](utils::statistics::Writer& writer) { writer = hot_keys; });
+  const utils::statistics::Snapshot snapshot{storage, "hot-keys"};
+  EXPECT_EQ(snapshot.SingleMetric("accesses").AsInt(), 4);
+  EXPECT_DOUBLE_EQ(snapshot.SingleMetric("top-key-percent").AsFloat(), 75.0);
+}
+
+USERVER_NAMESPACE_END
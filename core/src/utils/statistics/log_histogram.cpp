@@ -0,0 +1,166 @@
+#include <userver/utils/statistics/log_histogram.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/impl/histogram_bucket.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+namespace {
+
+double GetGamma(const LogHistogramSettings& settings) {
+  UINVARIANT(settings.relative_error > 0 && settings.relative_error < 1,
+             fmt::format("LogHistogram relative error must be in (0, 1), "
+                         "got {}",
+                         settings.relative_error));
+  return (1 + settings.relative_error) / (1 - settings.relative_error);
+}
+
+std::vector<double> MakeBounds(const LogHistogramSettings& settings,
+                               double gamma) {
+  UINVARIANT(settings.min_value > 0 && settings.max_value > settings.min_value,
+             fmt::format("LogHistogram values range must be positive and "
+                         "non-empty, got [{}, {}]",
+                         settings.min_value, settings.max_value));
+
+  const auto steps = static_cast<std::size_t>(std::ceil(
+      std::log(settings.max_value / settings.min_value) / std::log(gamma)));
+  std::vector<double> bounds;
+  bounds.reserve(steps + 1);
+  for (std::size_t i = 0; i <= steps; ++i) {
+    bounds.push_back(settings.min_value *
+                     std::pow(gamma, static_cast<double>(i)));
+  }
+  return bounds;
+}
+
+}  // namespace
+
+LogHistogram::LogHistogram(LogHistogramSettings settings)
+    : gamma_(GetGamma(settings)) {
+  const auto bounds = MakeBounds(settings, gamma_);
+  buckets_ = std::make_unique<impl::histogram::Bucket[]>(bounds.size() + 1);
+  impl::histogram::CopyBounds(buckets_.get(), bounds);
+  bucket_count_ = bounds.size();
+  min_value_ = settings.min_value;
+  inv_log_gamma_ = 1 / std::log(gamma_);
+}
+
+LogHistogram::LogHistogram(LogHistogram&& other) noexcept = default;
+
+LogHistogram::LogHistogram(const LogHistogram& other)
+    : buckets_(std::make_unique<impl::histogram::Bucket[]>(
+          other.bucket_count_ + 1)),
+      bucket_count_(other.bucket_count_),
+      min_value_(other.min_value_),
+      gamma_(other.gamma_),
+      inv_log_gamma_(other.inv_log_gamma_) {
+  impl::histogram::CopyBoundsAndValues(buckets_.get(), other.GetView());
+}
+
+LogHistogram& LogHistogram::operator=(LogHistogram&& other) noexcept = default;
+
+LogHistogram& LogHistogram::operator=(const LogHistogram& other) {
+  *this = LogHistogram{other};
+  return *this;
+}
+
+LogHistogram::~LogHistogram() = default;
+
+// NOLINTNEXTLINE(readability-make-member-function-const)
+void LogHistogram::Account(double value, std::uint64_t count) noexcept {
+  buckets_[GetBucketIndex(value)].counter.fetch_add(count,
+                                                    std::memory_order_relaxed);
+}
+
+// NOLINTNEXTLINE(readability-make-member-function-const)
+void LogHistogram::Add(const LogHistogram& other) {
+  UINVARIANT(bucket_count_ == other.bucket_count_ &&
+                 min_value_ == other.min_value_ && gamma_ == other.gamma_,
+             "Only LogHistogram with the same settings can be added");
+  for (std::size_t i = 0; i <= bucket_count_; ++i) {
+    buckets_[i].counter.fetch_add(
+        other.buckets_[i].counter.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+  }
+}
+
+LogHistogram& LogHistogram::operator+=(const LogHistogram& other) {
+  Add(other);
+  return *this;
+}
+
+double LogHistogram::GetQuantile(double quantile) const noexcept {
+  UASSERT(quantile >= 0 && quantile <= 1);
+  const auto total = GetTotalCount();
+  if (total == 0) return 0;
+
+  const auto rank =
+      std::clamp(quantile, 0.0, 1.0) * static_cast<double>(total - 1);
+  std::uint64_t accumulated = 0;
+  for (std::size_t i = 0; i < bucket_count_; ++i) {
+    accumulated += buckets_[i + 1].counter.load(std::memory_order_relaxed);
+    if (static_cast<double>(accumulated) > rank) {
+      // The value that is the closest, relatively, to any value of the bucket
+      return i == 0 ? min_value_ : 2 * GetBound(i) / (gamma_ + 1);
+    }
+  }
+  return GetBound(bucket_count_ - 1);
+}
+
+std::uint64_t LogHistogram::GetTotalCount() const noexcept {
+  std::uint64_t total = 0;
+  for (std::size_t i = 0; i <= bucket_count_; ++i) {
+    total += buckets_[i].counter.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+void LogHistogram::Reset() noexcept {
+  impl::histogram::ResetMetric(buckets_.get());
+}
+
+void ResetMetric(LogHistogram& histogram) noexcept { histogram.Reset(); }
+
+HistogramView LogHistogram::GetView() const& noexcept {
+  return impl::histogram::MakeView(buckets_.get());
+}
+
+std::size_t LogHistogram::GetBucketIndex(double value) const noexcept {
+  // 0th bucket is the "infinity" bucket, i-th bound is in (i+1)-th bucket.
+  // NaN falls into the first bucket.
+  if (!(value > min_value_)) return 1;
+  if (value > GetBound(bucket_count_ - 1)) return 0;
+
+  auto index = static_cast<std::size_t>(
+      std::ceil(std::log(value / min_value_) * inv_log_gamma_));
+  index = std::min(index, bucket_count_ - 1);
+  // Fix up the rounding errors of the logarithm
+  if (index > 0 && value <= GetBound(index - 1)) {
+    --index;
+  } else if (value > GetBound(index)) {
+    ++index;
+  }
+  return index + 1;
+}
+
+double LogHistogram::GetBound(std::size_t bound_index) const noexcept {
+  UASSERT(bound_index < bucket_count_);
+  return buckets_[bound_index + 1].upper_bound.bound;
+}
+
+void DumpMetric(Writer& writer, const LogHistogram& histogram) {
+  writer = histogram.GetView();
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,102 @@
+#include <userver/utils/statistics/log_histogram.hpp>
+
+#include <cmath>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/pretty_format.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr utils::statistics::LogHistogramSettings kSettings{1, 1000, 0.01};
+
+void ExpectClose(double expected, double actual) {
+  EXPECT_LE(std::abs(actual - expected), expected * kSettings.relative_error)
+      << "expected " << expected << ", got " << actual;
+}
+
+}  // namespace
+
+UTEST(StatisticsLogHistogram, Quantiles) {
+  utils::statistics::LogHistogram histogram{kSettings};
+  EXPECT_EQ(histogram.GetQuantile(0.5), 0);
+
+  for (int i = 1; i <= 1000; ++i) histogram.Account(i);
+  EXPECT_EQ(histogram.GetTotalCount(), 1000);
+
+  ExpectClose(1, histogram.GetQuantile(0));
+  ExpectClose(500, histogram.GetQuantile(0.5));
+  ExpectClose(990, histogram.GetQuantile(0.99));
+  ExpectClose(1000, histogram.GetQuantile(1));
+}
+
+UTEST(StatisticsLogHistogram, OutOfRange) {
+  utils::statistics::LogHistogram histogram{kSettings};
+  histogram.Account(0.001);
+  histogram.Account(-5);
+  histogram.Account(1e9, 2);
+
+  const auto view = histogram.GetView();
+  EXPECT_EQ(view.GetValueAt(0), 2);
+  EXPECT_EQ(view.GetValueAtInf(), 2);
+  EXPECT_GE(view.GetUpperBoundAt(view.GetBucketCount() - 1), 1000);
+  EXPECT_EQ(histogram.GetQuantile(0), 1);
+}
+
+UTEST(StatisticsLogHistogram, ValueOnBucketBorder) {
+  utils::statistics::LogHistogram histogram{kSettings};
+  const auto view = histogram.GetView();
+  for (std::size_t i = 0; i < view.GetBucketCount(); ++i) {
+    histogram.Account(view.GetUpperBoundAt(i));
+  }
+  for (std::size_t i = 0; i < view.GetBucketCount(); ++i) {
+    EXPECT_EQ(view.GetValueAt(i), 1) << "bucket " << i;
+  }
+}
+
+UTEST(StatisticsLogHistogram, Add) {
+  utils::statistics::LogHistogram first{kSettings};
+  utils::statistics::LogHistogram second{kSettings};
+  first.Account(10);
+  second.Account(10, 2);
+  second.Account(1e6);
+
+  first += second;
+  EXPECT_EQ(first.GetTotalCount(), 4);
+  EXPECT_EQ(first.GetView().GetValueAtInf(), 1);
+  ExpectClose(10, first.GetQuantile(0.5));
+}
+
+UTEST_DEATH(StatisticsLogHistogramDeathTest, InvalidUsage) {
+  utils::statistics::LogHistogram histogram{kSettings};
+  const utils::statistics::LogHistogram other{{1, 1000, 0.1}};
+  EXPECT_UINVARIANT_FAILURE_MSG(histogram.Add(other), "same settings");
+  EXPECT_UINVARIANT_FAILURE_MSG(
+      (utils::statistics::LogHistogram{{1, 1000, 1.5}}), "relative error");
+  EXPECT_UINVARIANT_FAILURE_MSG(
+      (utils::statistics::LogHistogram{{10, 1, 0.1}}), "values range");
+}
+
+UTEST(StatisticsLogHistogram, RecentPeriod) {
+  utils::statistics::RecentPeriod<utils::statistics::LogHistogram,
+                                  utils::statistics::LogHistogram>
+      recent_period;
+  recent_period.GetCurrentCounter().Account(42);
+  EXPECT_EQ(recent_period.GetStatsForPeriod().GetTotalCount(), 1);
+}
+
+UTEST(StatisticsLogHistogram, Dump) {
+  utils::statistics::LogHistogram histogram{{1, 4, 0.5}};
+  histogram.Account(2);
+
+  utils::statistics::Storage storage;
+  const auto entry = storage.RegisterWriter(
+      "test", [&](utils::statistics::Writer& writer) { writer = histogram; });
+  EXPECT_EQ(utils::statistics::ToPrettyFormat(storage),
+            "test:\tHIST_RATE\t[1]=0,[3]=1,[9]=0,[inf]=0\n");
+}
+
+USERVER_NAMESPACE_END
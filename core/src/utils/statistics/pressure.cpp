@@ -0,0 +1,180 @@
+#include <utils/statistics/pressure.hpp>
+
+#include <algorithm>
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/fs/blocking/read.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+namespace {
+
+constexpr std::string_view kCgroupV2Path = "/sys/fs/cgroup";
+
+// Calls `func(line)` for each non-empty line
+template <typename Func>
+void ForEachLine(std::string_view data, Func&& func) {
+  while (!data.empty()) {
+    const auto end = std::min(data.find('\n'), data.size());
+    const auto line = data.substr(0, end);
+    if (!line.empty()) func(line);
+    data.remove_prefix(std::min(end + 1, data.size()));
+  }
+}
+
+// Splits "key value" or "key=value"
+std::pair<std::string_view, std::string_view> Split(std::string_view field,
+                                                    char separator) {
+  const auto pos = field.find(separator);
+  if (pos == std::string_view::npos) return {field, {}};
+  return {field.substr(0, pos), field.substr(pos + 1)};
+}
+
+// "avg10=0.00 avg60=0.00 avg300=0.00 total=0"
+PressureStall ParseStall(std::string_view fields) {
+  PressureStall stall;
+  while (!fields.empty()) {
+    auto [field, rest] = Split(fields, ' ');
+    fields = rest;
+    if (field.empty()) continue;
+
+    const auto [key, value] = Split(field, '=');
+    if (key == "avg10") {
+      stall.avg10 = utils::FromString<double>(std::string{value});
+    } else if (key == "avg60") {
+      stall.avg60 = utils::FromString<double>(std::string{value});
+    } else if (key == "avg300") {
+      stall.avg300 = utils::FromString<double>(std::string{value});
+    } else if (key == "total") {
+      stall.total_us = utils::FromString<std::uint64_t>(std::string{value});
+    }
+  }
+  return stall;
+}
+
+std::optional<std::string> ReadCgroupFile(std::string_view name) {
+  const auto path = fmt::format("{}/{}", kCgroupV2Path, name);
+  try {
+    return fs::blocking::ReadFileContents(path);
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_DEBUG() << "Could not read " << path << ": " << ex;
+    return std::nullopt;
+  }
+}
+
+}  // namespace
+
+std::optional<Pressure> ParsePressure(std::string_view data) {
+  std::optional<PressureStall> some;
+  std::optional<PressureStall> full;
+  try {
+    ForEachLine(data, [&](std::string_view line) {
+      const auto [kind, fields] = Split(line, ' ');
+      if (kind == "some") {
+        some = ParseStall(fields);
+      } else if (kind == "full") {
+        full = ParseStall(fields);
+      }
+    });
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_WARNING() << "Malformed PSI data '" << data << "': " << ex;
+    return std::nullopt;
+  }
+  if (!some) return std::nullopt;
+  return Pressure{*some, full};
+}
+
+std::optional<MemoryEvents> ParseMemoryEvents(std::string_view data) {
+  MemoryEvents events;
+  try {
+    ForEachLine(data, [&events](std::string_view line) {
+      const auto [key, value_str] = Split(line, ' ');
+      const auto value =
+          utils::FromString<std::int64_t>(std::string{value_str});
+      if (key == "low") {
+        events.low = value;
+      } else if (key == "high") {
+        events.high = value;
+      } else if (key == "max") {
+        events.max = value;
+      } else if (key == "oom") {
+        events.oom = value;
+      } else if (key == "oom_kill") {
+        events.oom_kill = value;
+      }
+    });
+  } catch (const std::exception& ex) {
+    LOG_LIMITED_WARNING() << "Malformed memory.events '" << data
+                          << "': " << ex;
+    return std::nullopt;
+  }
+  return events;
+}
+
+bool HasCgroupPressure(std::string_view resource) {
+#ifdef __linux__
+  return fs::blocking::FileExists(
+      fmt::format("{}/{}.pressure", kCgroupV2Path, resource));
+#else
+  (void)resource;
+  return false;
+#endif
+}
+
+std::optional<Pressure> ReadCgroupPressure(std::string_view resource) {
+  const auto data = ReadCgroupFile(fmt::format("{}.pressure", resource));
+  if (!data) return std::nullopt;
+  return ParsePressure(*data);
+}
+
+CgroupPressureStats GetCgroupPressureStatistics() {
+  CgroupPressureStats stats;
+#ifdef __linux__
+  stats.cpu = ReadCgroupPressure("cpu");
+  stats.memory = ReadCgroupPressure("memory");
+  stats.io = ReadCgroupPressure("io");
+  if (const auto data = ReadCgroupFile("memory.events")) {
+    stats.memory_events = ParseMemoryEvents(*data);
+  }
+#endif
+  return stats;
+}
+
+void DumpMetric(Writer& writer, const PressureStall& stall) {
+  writer["avg10"] = stall.avg10;
+  writer["avg60"] = stall.avg60;
+  writer["avg300"] = stall.avg300;
+  writer["total_us"] = stall.total_us;
+}
+
+void DumpMetric(Writer& writer, const Pressure& pressure) {
+  writer["some"] = pressure.some;
+  if (pressure.full) writer["full"] = *pressure.full;
+}
+
+void DumpMetric(Writer& writer, const MemoryEvents& events) {
+  writer["low"] = events.low;
+  writer["high"] = events.high;
+  writer["max"] = events.max;
+  writer["oom"] = events.oom;
+  writer["oom_kill"] = events.oom_kill;
+}
+
+void DumpMetric(Writer& writer, const CgroupPressureStats& stats) {
+  if (stats.cpu) writer["pressure"]["cpu"] = *stats.cpu;
+  if (stats.memory) writer["pressure"]["memory"] = *stats.memory;
+  if (stats.io) writer["pressure"]["io"] = *stats.io;
+  if (stats.memory_events) writer["memory_events"] = *stats.memory_events;
+}
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
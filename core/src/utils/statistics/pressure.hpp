@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics::impl {
+
+/// Share of the time some or all of the tasks of the cgroup were stalled on
+/// a resource, as in Linux PSI
+struct PressureStall {
+  /// Percent of the time stalled over the last 10, 60 and 300 seconds
+  double avg10{0};
+  double avg60{0};
+  double avg300{0};
+  /// Total time stalled
+  std::uint64_t total_us{0};
+};
+
+/// Contents of a cgroup v2 `<resource>.pressure` file
+struct Pressure {
+  /// Some of the tasks were stalled
+  PressureStall some;
+  /// All of the tasks were stalled, missing for the CPU on older kernels
+  std::optional<PressureStall> full;
+};
+
+/// Contents of a cgroup v2 `memory.events` file
+struct MemoryEvents {
+  std::int64_t low{0};
+  std::int64_t high{0};
+  std::int64_t max{0};
+  std::int64_t oom{0};
+  std::int64_t oom_kill{0};
+};
+
+struct CgroupPressureStats {
+  std::optional<Pressure> cpu;
+  std::optional<Pressure> memory;
+  std::optional<Pressure> io;
+  std::optional<MemoryEvents> memory_events;
+};
+
+/// @returns std::nullopt if the data is malformed
+std::optional<Pressure> ParsePressure(std::string_view data);
+
+/// @returns std::nullopt if the data is malformed
+std::optional<MemoryEvents> ParseMemoryEvents(std::string_view data);
+
+/// @returns true if cgroup v2 PSI of the resource is available
+bool HasCgroupPressure(std::string_view resource);
+
+/// @brief Reads the pressure of the cgroup of the process on a resource:
+/// "cpu", "memory" or "io"
+/// @returns std::nullopt if cgroup v2 PSI is not available
+/// @note Uses blocking file reads
+std::optional<Pressure> ReadCgroupPressure(std::string_view resource);
+
+/// @note Uses blocking file reads
+CgroupPressureStats GetCgroupPressureStatistics();
+
+void DumpMetric(Writer& writer, const PressureStall& stall);
+void DumpMetric(Writer& writer, const Pressure& pressure);
+void DumpMetric(Writer& writer, const MemoryEvents& events);
+void DumpMetric(Writer& writer, const CgroupPressureStats& stats);
+
+}  // namespace utils::statistics::impl
+
+USERVER_NAMESPACE_END
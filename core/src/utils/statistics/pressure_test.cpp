@@ -0,0 +1,54 @@
+#include <utils/statistics/pressure.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using utils::statistics::impl::ParseMemoryEvents;
+using utils::statistics::impl::ParsePressure;
+
+}  // namespace
+
+TEST(CgroupPressure, Parse) {
+  const auto pressure = ParsePressure(
+      "some avg10=1.50 avg60=0.75 avg300=0.10 total=123456\n"
+      "full avg10=0.50 avg60=0.25 avg300=0.00 total=6543\n");
+  ASSERT_TRUE(pressure);
+  EXPECT_DOUBLE_EQ(pressure->some.avg10, 1.5);
+  EXPECT_DOUBLE_EQ(pressure->some.avg60, 0.75);
+  EXPECT_DOUBLE_EQ(pressure->some.avg300, 0.1);
+  EXPECT_EQ(pressure->some.total_us, 123456);
+  ASSERT_TRUE(pressure->full);
+  EXPECT_DOUBLE_EQ(pressure->full->avg10, 0.5);
+  EXPECT_EQ(pressure->full->total_us, 6543);
+}
+
+TEST(CgroupPressure, ParseWithoutFull) {
+  const auto pressure =
+      ParsePressure("some avg10=0.00 avg60=0.00 avg300=0.00 total=0\n");
+  ASSERT_TRUE(pressure);
+  EXPECT_FALSE(pressure->full);
+}
+
+TEST(CgroupPressure, ParseMalformed) {
+  EXPECT_FALSE(ParsePressure(""));
+  EXPECT_FALSE(ParsePressure("full avg10=0.00 total=0\n"));
+  EXPECT_FALSE(ParsePressure("some avg10=abc total=0\n"));
+}
+
+TEST(CgroupPressure, ParseMemoryEvents) {
+  const auto events = ParseMemoryEvents(
+      "low 1\nhigh 2\nmax 3\noom 4\noom_kill 5\noom_group_kill 0\n");
+  ASSERT_TRUE(events);
+  EXPECT_EQ(events->low, 1);
+  EXPECT_EQ(events->high, 2);
+  EXPECT_EQ(events->max, 3);
+  EXPECT_EQ(events->oom, 4);
+  EXPECT_EQ(events->oom_kill, 5);
+
+  EXPECT_FALSE(ParseMemoryEvents("oom x\n"));
+}
+
+USERVER_NAMESPACE_END
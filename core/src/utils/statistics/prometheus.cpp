@@ -7,6 +7,7 @@
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
+#include <userver/rcu/rcu.hpp>
 #include <userver/utils/impl/transparent_hash.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/statistics/fmt.hpp>
@@ -18,43 +19,116 @@ namespace utils::statistics {
 
 namespace impl {
 
+using NamesMap = utils::impl::TransparentMap<std::string, std::string>;
+
+struct PrometheusNames final {
+  NamesMap metrics;
+  NamesMap labels;
+};
+
 namespace {
 
+// Metrics with identifiers in their names should not grow the cache forever
+constexpr std::size_t kMaxCachedNames = 100'000;
+
 enum class Typed { kYes, kNo };
 
+using NameRef = std::pair<std::string_view, std::string_view>;
+
+template <typename Converter>
+NameRef FindOrConvert(std::string_view name, const NamesMap* cached,
+                      NamesMap& added, Converter converter) {
+  if (cached) {
+    const auto it = utils::impl::FindTransparent(*cached, name);
+    if (it != cached->end()) return {it->first, it->second};
+  }
+  auto it = utils::impl::FindTransparent(added, name);
+  if (it == added.end()) {
+    it = added.emplace(std::string{name}, converter(name)).first;
+  }
+  // Nodes of the maps are stable, the views stay valid
+  return {it->first, it->second};
+}
+
 template <Typed IsTyped>
 class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
  public:
-  explicit FormatBuilder() = default;
+  FormatBuilder() = default;
+
+  FormatBuilder(const PrometheusNames& cached, std::size_t chunk_size,
+                const ChunkConsumer& consumer)
+      : cached_(&cached), chunk_size_(chunk_size), consumer_(&consumer) {}
 
   void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels,
                     const MetricValue& value) override {
     if (value.IsHistogram()) {
-      // TODO support histogram metrics using 'le', or better yet,
-      //  using Prometheus native histograms.
-      UASSERT_MSG(false,
-                  "Histogram metrics are not supported for Prometheus yet");
-      return;
+      DumpHistogram(path, labels, value);
+    } else {
+      buf_.append(GetMetricName(path, value));
+      DumpLabels(labels);
+      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), value);
     }
-    DumpMetricNameAndType(path, value);
-    DumpLabels(labels);
-    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), value);
+
+    if (consumer_ && buf_.size() >= chunk_size_) Flush();
   }
 
   std::string Release() { return fmt::to_string(buf_); }
 
+  void Flush() {
+    if (buf_.size() == 0) return;
+    (*consumer_)(fmt::to_string(buf_));
+    buf_.clear();
+  }
+
+  PrometheusNames ExtractAddedNames() && {
+    converted_.clear();
+    return std::move(added_);
+  }
+
  private:
-  void DumpMetricNameAndType(std::string_view name, const MetricValue& value) {
-    if (const auto* const converted =
-            utils::impl::FindTransparentOrNullptr(metrics_, name)) {
-      buf_.append(*converted);
-      return;
+  // Classic Prometheus histogram with cumulative 'le' buckets
+  void DumpHistogram(std::string_view path,
+                     utils::statistics::LabelsSpan labels,
+                     const MetricValue& value) {
+    const auto name = GetMetricName(path, value);
+    const auto histogram = value.AsHistogram();
+
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < histogram.GetBucketCount(); ++i) {
+      total += histogram.GetValueAt(i);
+      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}_bucket"), name);
+      DumpLabels(labels, fmt::to_string(histogram.GetUpperBoundAt(i)));
+      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), total);
+    }
+    total += histogram.GetValueAtInf();
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}_bucket"), name);
+    DumpLabels(labels, "+Inf");
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), total);
+
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}_count"), name);
+    DumpLabels(labels);
+    fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), total);
+  }
+
+  // Writes the type of the metric when it is met for the first time
+  std::string_view GetMetricName(std::string_view path,
+                                 const MetricValue& value) {
+    if (const auto it = converted_.find(path); it != converted_.end()) {
+      return it->second;
     }
 
-    auto prometheus_name = impl::ToPrometheusName(name);
+    const auto [key, prometheus_name] =
+        FindOrConvert(path, cached_ ? &cached_->metrics : nullptr,
+                      added_.metrics, &impl::ToPrometheusName);
     DumpMetricType(prometheus_name, value);
-    buf_.append(prometheus_name);
-    metrics_.emplace(name, std::move(prometheus_name));
+    converted_.emplace(key, prometheus_name);
+    return prometheus_name;
+  }
+
+  std::string_view GetLabelName(std::string_view name) {
+    return FindOrConvert(name, cached_ ? &cached_->labels : nullptr,
+                         added_.labels, &impl::ToPrometheusLabel)
+        .second;
   }
 
   void DumpMetricType([[maybe_unused]] std::string_view prometheus_name,
@@ -73,39 +147,91 @@ class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
         [](std::int64_t) -> std::string_view { return "gauge"; },
         [](double) -> std::string_view { return "gauge"; },
         [](Rate) -> std::string_view { return "counter"; },
-        [](HistogramView) -> std::string_view {
-          UINVARIANT(false,
-                     "Histogram metrics are not supported for Prometheus yet");
-        },
+        [](HistogramView) -> std::string_view { return "histogram"; },
     });
     fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("# TYPE {} {}\n"),
                    prometheus_name, type);
   }
 
-  void DumpLabels(utils::statistics::LabelsSpan labels) {
+  void DumpLabels(utils::statistics::LabelsSpan labels,
+                  std::string_view histogram_bound = {}) {
     buf_.push_back('{');
     bool sep = false;
     for (const auto& label : labels) {
       if (sep) {
         buf_.push_back(',');
       }
-      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}=\""),
-                     impl::ToPrometheusLabel(label.Name()));
+      buf_.append(GetLabelName(label.Name()));
+      buf_.append(std::string_view{"=\""});
       const auto& value = label.Value();
       std::replace_copy(value.cbegin(), value.cend(), std::back_inserter(buf_),
                         '"', '\'');
       buf_.push_back('"');
       sep = true;
     }
+    if (!histogram_bound.empty()) {
+      if (sep) {
+        buf_.push_back(',');
+      }
+      fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("le=\"{}\""),
+                     histogram_bound);
+    }
     buf_.push_back('}');
   }
 
   fmt::memory_buffer buf_;
-  utils::impl::TransparentMap<std::string, std::string> metrics_;
+
+  const PrometheusNames* cached_{nullptr};
+  std::size_t chunk_size_{0};
+  const ChunkConsumer* consumer_{nullptr};
+
+  // Names converted by this output, by the previous outputs are in cached_
+  PrometheusNames added_;
+  // Metrics met by this output with the type already written
+  std::unordered_map<std::string_view, std::string_view> converted_;
 };
 
 }  // namespace
 
+struct PrometheusNamesCacheAccess final {
+  static rcu::Variable<PrometheusNames>& Get(PrometheusNamesCache& cache);
+};
+
+namespace {
+
+void Merge(NamesMap& to, NamesMap&& from) {
+  if (to.size() + from.size() > kMaxCachedNames) return;
+  for (auto& [name, converted] : from) {
+    to.emplace(name, std::move(converted));
+  }
+}
+
+template <Typed IsTyped>
+void ToPrometheusFormatChunked(const utils::statistics::Storage& statistics,
+                               const utils::statistics::Request& request,
+                               PrometheusNamesCache& cache,
+                               std::size_t chunk_size,
+                               const ChunkConsumer& consumer) {
+  auto& names = PrometheusNamesCacheAccess::Get(cache);
+
+  PrometheusNames added;
+  {
+    const auto cached = names.Read();
+    FormatBuilder<IsTyped> builder{*cached, chunk_size, consumer};
+    statistics.VisitMetrics(builder, request);
+    builder.Flush();
+    added = std::move(builder).ExtractAddedNames();
+  }
+
+  if (added.metrics.empty() && added.labels.empty()) return;
+  auto writer = names.StartWrite();
+  Merge(writer->metrics, std::move(added.metrics));
+  Merge(writer->labels, std::move(added.labels));
+  writer.Commit();
+}
+
+}  // namespace
+
 std::string ToPrometheusName(std::string_view data) {
   std::string name;
   if (!data.empty()) {
@@ -138,6 +264,20 @@ std::string ToPrometheusLabel(std::string_view name) {
 
 }  // namespace impl
 
+struct PrometheusNamesCache::Impl final {
+  rcu::Variable<impl::PrometheusNames> names;
+};
+
+PrometheusNamesCache::PrometheusNamesCache()
+    : impl_(std::make_unique<Impl>()) {}
+
+PrometheusNamesCache::~PrometheusNamesCache() = default;
+
+rcu::Variable<impl::PrometheusNames>& impl::PrometheusNamesCacheAccess::Get(
+    PrometheusNamesCache& cache) {
+  return cache.impl_->names;
+}
+
 std::string ToPrometheusFormat(const utils::statistics::Storage& statistics,
                                const utils::statistics::Request& request) {
   impl::FormatBuilder<impl::Typed::kYes> builder{};
@@ -153,6 +293,23 @@ std::string ToPrometheusFormatUntyped(
   return builder.Release();
 }
 
+void ToPrometheusFormat(const utils::statistics::Storage& statistics,
+                        const utils::statistics::Request& request,
+                        PrometheusNamesCache& cache, std::size_t chunk_size,
+                        const ChunkConsumer& consumer) {
+  impl::ToPrometheusFormatChunked<impl::Typed::kYes>(statistics, request, cache,
+                                                     chunk_size, consumer);
+}
+
+void ToPrometheusFormatUntyped(const utils::statistics::Storage& statistics,
+                               const utils::statistics::Request& request,
+                               PrometheusNamesCache& cache,
+                               std::size_t chunk_size,
+                               const ChunkConsumer& consumer) {
+  impl::ToPrometheusFormatChunked<impl::Typed::kNo>(statistics, request, cache,
+                                                    chunk_size, consumer);
+}
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
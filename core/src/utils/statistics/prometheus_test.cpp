@@ -22,13 +22,33 @@ std::string Sorted(const std::string_view raw) {
 void TestToMetricsPrometheus(const utils::statistics::Storage& statistics,
                              const std::string_view expected,
                              const bool sorted = false) {
-  const auto result =
-      ToPrometheusFormat(statistics, utils::statistics::Request::MakeWithPrefix(
-                                         {}, {{"application", "processing"}}));
-  if (sorted) {
-    EXPECT_EQ(Sorted(expected), Sorted(result));
-  } else {
-    EXPECT_EQ(expected, result);
+  const auto request = utils::statistics::Request::MakeWithPrefix(
+      {}, {{"application", "processing"}});
+  const auto check = [&](const std::string& result) {
+    if (sorted) {
+      EXPECT_EQ(Sorted(expected), Sorted(result));
+    } else {
+      EXPECT_EQ(expected, result);
+    }
+  };
+
+  check(ToPrometheusFormat(statistics, request));
+
+  // The second output reuses the names converted by the first one
+  PrometheusNamesCache cache;
+  for (const std::size_t chunk_size : {1, 1, 1 << 20}) {
+    std::string result;
+    std::size_t chunks = 0;
+    ToPrometheusFormat(statistics, request, cache, chunk_size,
+                       [&](std::string&& chunk) {
+                         EXPECT_FALSE(chunk.empty());
+                         result += chunk;
+                         ++chunks;
+                       });
+    check(result);
+    if (chunk_size > expected.size()) {
+      EXPECT_LE(chunks, 1UL);
+    }
   }
 }
 
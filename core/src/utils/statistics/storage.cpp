@@ -1,9 +1,13 @@
 #include <userver/utils/statistics/storage.hpp>
 
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
 #include <utility>
 
-#include <boost/container/small_vector.hpp>
+#include <boost/container_hash/hash.hpp>
 
+#include <userver/engine/mutex.hpp>
 #include <userver/formats/common/utils.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
@@ -67,8 +71,68 @@ CheckDataUsedByCallbackHasNotBeenDestroyedBeforeUnregistering(
   }
 }
 
+std::uint64_t MakeMetricId(std::string_view path, LabelsSpan labels) {
+  std::size_t seed = std::hash<std::string_view>{}(path);
+  for (const auto& label : labels) {
+    boost::hash_combine(seed, std::hash<std::string_view>{}(label.Name()));
+    boost::hash_combine(seed, std::hash<std::string_view>{}(label.Value()));
+  }
+  return seed;
+}
+
 }  // namespace
 
+struct MetricsDelta::Impl final {
+  // Forwards only the metrics that changed since the previous visit
+  class FormatBuilder;
+
+  struct Reported final {
+    MetricValue value;
+    std::uint64_t visit;
+  };
+
+  engine::Mutex mutex;
+  std::unordered_map<std::uint64_t, Reported> reported;
+  std::uint64_t visit{0};
+};
+
+class MetricsDelta::Impl::FormatBuilder final : public BaseFormatBuilder {
+ public:
+  FormatBuilder(BaseFormatBuilder& out, Impl& delta)
+      : out_(out), delta_(delta) {}
+
+  void HandleMetric(std::string_view path, LabelsSpan labels,
+                    const MetricValue& value) override {
+    // HistogramView points to the live data, there is nothing to compare with
+    if (value.IsHistogram()) {
+      out_.HandleMetric(path, labels, value);
+      return;
+    }
+
+    const auto [it, inserted] = delta_.reported.try_emplace(
+        MakeMetricId(path, labels), Reported{value, 0});
+    it->second.visit = delta_.visit;
+    if (!inserted) {
+      if (it->second.value == value) return;
+      it->second.value = value;
+    }
+    out_.HandleMetric(path, labels, value);
+  }
+
+ private:
+  BaseFormatBuilder& out_;
+  Impl& delta_;
+};
+
+MetricsDelta::MetricsDelta() : impl_(std::make_unique<Impl>()) {}
+
+MetricsDelta::~MetricsDelta() = default;
+
+void MetricsDelta::Reset() {
+  const std::lock_guard lock{impl_->mutex};
+  impl_->reported.clear();
+}
+
 Request Request::MakeWithPrefix(const std::string& prefix, AddLabels add_labels,
                                 std::vector<Label> require_labels) {
   RemoveAddedLabels(require_labels, add_labels);
@@ -85,12 +149,18 @@ Request Request::MakeWithPath(const std::string& path, AddLabels add_labels,
           std::move(add_labels)};
 }
 
+Request Request::WithDelta(MetricsDelta& delta_in) const {
+  return {prefix, prefix_match_type, require_labels, add_labels, &delta_in};
+}
+
 Request::Request(std::string prefix_in, PrefixMatch path_match_type_in,
-                 std::vector<Label> require_labels_in, AddLabels add_labels_in)
+                 std::vector<Label> require_labels_in, AddLabels add_labels_in,
+                 MetricsDelta* delta_in)
     : prefix(std::move(prefix_in)),
       prefix_match_type(path_match_type_in),
       require_labels(std::move(require_labels_in)),
-      add_labels(std::move(add_labels_in)) {}
+      add_labels(std::move(add_labels_in)),
+      delta(delta_in) {}
 
 BaseFormatBuilder::~BaseFormatBuilder() = default;
 
@@ -117,31 +187,47 @@ formats::json::Value Storage::GetAsJson() const {
 
 void Storage::VisitMetrics(BaseFormatBuilder& out,
                            const Request& request) const {
+  if (!request.delta) {
+    DoVisitMetrics(out, request);
+    return;
+  }
+
+  auto& delta = *request.delta->impl_;
+  const std::lock_guard lock{delta.mutex};
+  ++delta.visit;
+
+  MetricsDelta::Impl::FormatBuilder delta_builder{out, delta};
+  DoVisitMetrics(delta_builder, request);
+
+  // Forget the metrics that were not written this time
+  for (auto it = delta.reported.begin(); it != delta.reported.end();) {
+    if (it->second.visit == delta.visit) {
+      ++it;
+    } else {
+      it = delta.reported.erase(it);
+    }
+  }
+}
+
+void Storage::DoVisitMetrics(BaseFormatBuilder& out,
+                             const Request& request) const {
   {
     impl::WriterState state{out, request, {}, {}};
     for (const auto& [name, value] : request.add_labels) {
       state.add_labels.emplace_back(name, value);
     }
 
-    boost::container::small_vector<LabelView, 16> labels_vector;
-
     std::shared_lock lock(mutex_);
     for (const auto& entry : metrics_sources_) {
       if (!entry.writer) {
         continue;
       }
 
-      labels_vector.clear();
-      labels_vector.reserve(entry.writer_labels.size());
-      for (const auto& l : entry.writer_labels) {
-        labels_vector.emplace_back(l);
-      }
-
+      const LabelsSpan labels{entry.writer_label_views};
       try {
-        auto writer =
-            (entry.prefix_path.empty()
-                 ? Writer{state, LabelsSpan{labels_vector}}
-                 : Writer{state, LabelsSpan{labels_vector}}[entry.prefix_path]);
+        auto writer = (entry.prefix_path.empty()
+                           ? Writer{state, labels}
+                           : Writer{state, labels}[entry.prefix_path]);
         if (writer) {
           LOG_DEBUG() << "Getting statistics for prefix=" << entry.prefix_path;
           entry.writer(writer);
@@ -164,13 +250,13 @@ void Storage::StopRegisteringExtenders() { may_register_extenders_ = false; }
 Entry Storage::RegisterWriter(std::string prefix, WriterFunc func,
                               std::vector<Label> add_labels) {
   return DoRegisterExtender(impl::MetricsSource{
-      std::move(prefix), {}, {}, std::move(func), std::move(add_labels)});
+      std::move(prefix), {}, {}, std::move(func), std::move(add_labels), {}});
 }
 
 Entry Storage::RegisterExtender(std::string prefix, ExtenderFunc func) {
   auto prefix_split = formats::common::SplitPathString(prefix);
   return DoRegisterExtender(impl::MetricsSource{
-      std::move(prefix), std::move(prefix_split), std::move(func), {}, {}});
+      std::move(prefix), std::move(prefix_split), std::move(func), {}, {}, {}});
 }
 
 Entry Storage::DoRegisterExtender(impl::MetricsSource&& source) {
@@ -178,9 +264,14 @@ Entry Storage::DoRegisterExtender(impl::MetricsSource&& source) {
               "You may not register statistics extender outside of component "
               "constructors");
 
+  // Labels are stored in the list node, views into them stay valid
   std::lock_guard lock(mutex_);
   const auto res =
       metrics_sources_.insert(metrics_sources_.end(), std::move(source));
+  res->writer_label_views.reserve(res->writer_labels.size());
+  for (const auto& label : res->writer_labels) {
+    res->writer_label_views.emplace_back(label);
+  }
   return Entry(Entry::Impl{this, res});
 }
 
@@ -1,6 +1,9 @@
 #include <userver/utils/statistics/storage.hpp>
 
+#include <atomic>
+
 #include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/pretty_format.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -14,4 +17,38 @@ UTEST(StatisticsStorage, RegisterExtender) {
   EXPECT_EQ(json["foo"]["bar"]["baz"].As<int>(), 42);
 }
 
+UTEST(StatisticsStorage, DeltaReportsChangedMetrics) {
+  utils::statistics::Storage storage;
+  std::atomic<int> changing{0};
+  const auto entry = storage.RegisterWriter(
+      "delta", [&changing](utils::statistics::Writer& writer) {
+        writer["changing"] = changing.load();
+        writer["constant"] = 42;
+      });
+
+  utils::statistics::MetricsDelta delta;
+  const auto request =
+      utils::statistics::Request::MakeWithPrefix("delta").WithDelta(delta);
+
+  auto result = utils::statistics::ToPrettyFormat(storage, request);
+  EXPECT_NE(result.find("delta.changing"), std::string::npos) << result;
+  EXPECT_NE(result.find("delta.constant"), std::string::npos) << result;
+
+  EXPECT_EQ(utils::statistics::ToPrettyFormat(storage, request), "");
+
+  changing = 1;
+  result = utils::statistics::ToPrettyFormat(storage, request);
+  EXPECT_NE(result.find("delta.changing"), std::string::npos) << result;
+  EXPECT_EQ(result.find("delta.constant"), std::string::npos) << result;
+
+  delta.Reset();
+  result = utils::statistics::ToPrettyFormat(storage, request);
+  EXPECT_NE(result.find("delta.constant"), std::string::npos) << result;
+
+  // Requests without the delta are not affected
+  result = utils::statistics::ToPrettyFormat(
+      storage, utils::statistics::Request::MakeWithPrefix("delta"));
+  EXPECT_NE(result.find("delta.constant"), std::string::npos) << result;
+}
+
 USERVER_NAMESPACE_END
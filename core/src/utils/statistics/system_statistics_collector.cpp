@@ -4,6 +4,7 @@
 #include <userver/components/statistics_storage.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
+#include <utils/statistics/pressure.hpp>
 #include <utils/statistics/system_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -32,6 +33,8 @@ void SystemStatisticsCollector::ExtendStatistics(
     utils::statistics::Writer& writer) {
   engine::CriticalAsyncNoSpan(fs_task_processor_, [&] {
     DumpMetric(writer, utils::statistics::impl::GetSelfSystemStatistics());
+    writer["cgroup"] =
+        utils::statistics::impl::GetCgroupPressureStatistics();
     if (with_nginx_) {
       writer.ValueWithLabels(
           utils::statistics::impl::GetSystemStatisticsByExeName("nginx"),
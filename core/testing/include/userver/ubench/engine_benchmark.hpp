@@ -0,0 +1,128 @@
+#pragma once
+
+/// @file userver/ubench/engine_benchmark.hpp
+/// @brief @copybrief ubench::RunConcurrently
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/utils/function_ref.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// Helpers for benchmarking in the coroutine environment
+namespace ubench {
+
+/// @brief Parameters of ubench::RunConcurrently
+struct ConcurrencyOptions final {
+  /// Engine thread pool size
+  std::size_t worker_threads{1};
+
+  /// Number of coroutines that run the benchmark body concurrently
+  std::size_t coroutines{1};
+
+  /// Measure each call of the body to report latency percentiles. Adds the
+  /// cost of two clock reads to each operation.
+  bool measure_latency{true};
+};
+
+/// @brief Makes ubench::ConcurrencyOptions from benchmark arguments, the
+/// first one being the worker threads count and the second one being the
+/// coroutines count.
+///
+/// @code
+/// BENCHMARK(Foo)->ArgsProduct({{1, 2, 4}, {1, 8, 64}})->UseRealTime();
+/// @endcode
+ConcurrencyOptions ConcurrencyOptionsFromArgs(const benchmark::State& state);
+
+namespace impl {
+
+/// Log-linear histogram, keeps values with 1/16 relative precision
+class LatencyHistogram final {
+ public:
+  void Account(std::chrono::steady_clock::duration duration) noexcept {
+    const auto ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    ++buckets_[BucketIndex(ns > 0 ? static_cast<std::uint64_t>(ns) : 0)];
+  }
+
+  void Add(const LatencyHistogram& other) noexcept;
+
+  std::uint64_t GetCount() const noexcept;
+
+  /// @returns the lower bound of the bucket containing the percentile
+  std::uint64_t GetPercentileNs(double percent) const noexcept;
+
+ private:
+  static constexpr int kSubBucketBits = 4;
+  static constexpr std::uint64_t kSubBuckets = 1 << kSubBucketBits;
+  static constexpr std::size_t kBuckets =
+      (64 - kSubBucketBits + 1) * kSubBuckets;
+
+  static std::size_t BucketIndex(std::uint64_t value) noexcept {
+    if (value < kSubBuckets) return value;
+    const int exponent = 63 - __builtin_clzll(value);
+    const auto sub_bucket =
+        (value >> (exponent - kSubBucketBits)) & (kSubBuckets - 1);
+    return (exponent - kSubBucketBits + 1) * kSubBuckets + sub_bucket;
+  }
+
+  static std::uint64_t BucketLowerBound(std::size_t index) noexcept;
+
+  std::array<std::uint64_t, kBuckets> buckets_{};
+};
+
+struct CoroutineRun final {
+  std::size_t index;
+  std::size_t iterations;
+  LatencyHistogram* latencies;
+};
+
+void RunConcurrently(benchmark::State& state, const ConcurrencyOptions& options,
+                     utils::function_ref<void(const CoroutineRun&)> run);
+
+}  // namespace impl
+
+/// @brief Runs the benchmark body concurrently in multiple coroutines of
+/// a multithreaded engine.
+///
+/// The engine is started once for the benchmark run, outside of the measured
+/// time. The body is called as `func(coroutine_index)`, `state.iterations()`
+/// times in total, iterations are evenly split between the coroutines.
+///
+/// Reports the following counters:
+/// * `p50_ns`, `p90_ns`, `p99_ns`, `p999_ns` - latency of a single body call,
+///   if ubench::ConcurrencyOptions::measure_latency is set;
+/// * `cycles`, `cache_misses`, `context_switches` - Linux perf counters of
+///   all the engine threads per iteration, if perf events are available
+///   (see `perf_event_paranoid`).
+///
+/// Use `->UseRealTime()` for such benchmarks, as the main benchmark thread
+/// only waits for the coroutines.
+///
+/// @snippet core/src/engine/mutex_benchmark.cpp  RunConcurrently sample
+template <typename Func>
+void RunConcurrently(benchmark::State& state, const ConcurrencyOptions& options,
+                     Func&& func) {
+  impl::RunConcurrently(state, options, [&func](const impl::CoroutineRun& run) {
+    if (run.latencies) {
+      for (std::size_t i = 0; i < run.iterations; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        func(run.index);
+        run.latencies->Account(std::chrono::steady_clock::now() - start);
+      }
+    } else {
+      for (std::size_t i = 0; i < run.iterations; ++i) {
+        func(run.index);
+      }
+    }
+  });
+}
+
+}  // namespace ubench
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #include <utility>
 #include <vector>
 
+#include <userver/dynamic_config/test_helpers.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/get_all.hpp>
 #include <userver/engine/run_standalone.hpp>
@@ -72,6 +73,24 @@ class UnitTestService final : public sample::ugrpc::UnitTestServiceBase {
 
 using GrpcClientTest = tests::Service<UnitTestService>;
 
+class GrpcBackendTest final : public tests::ServiceBase {
+ public:
+  explicit GrpcBackendTest(bool use_callback_api) {
+    RegisterService(service_, server::ServiceConfig{
+                                  engine::current_task::GetTaskProcessor(),
+                                  {},
+                                  /*use_arena=*/false,
+                                  use_callback_api,
+                              });
+    StartServer();
+  }
+
+  ~GrpcBackendTest() override { StopServer(); }
+
+ private:
+  UnitTestService service_;
+};
+
 std::unique_ptr<grpc::ClientContext> PrepareClientContext() {
   auto context = std::make_unique<grpc::ClientContext>();
   context->AddMetadata("req_header", "value");
@@ -166,6 +185,81 @@ void BatchOfUnaryRPC(benchmark::State& state) {
 
 BENCHMARK(BatchOfUnaryRPC)->DenseRange(1, 8)->Unit(benchmark::kMillisecond);
 
+// Compares the server backends: range(1) is the number of completion queues,
+// each one drained by its own thread
+void BatchOfUnaryRPCCompletionQueues(benchmark::State& state) {
+  engine::RunStandalone(
+      state.range(0),
+      engine::TaskProcessorPoolsConfig{10000, 100000, 256 * 1024ULL, 1, "ev",
+                                       false, false},
+      [&] {
+        static constexpr std::size_t kBatchSize = 16;
+        server::ServerConfig server_config;
+        server_config.completion_queue_num = state.range(1);
+        GrpcClientTest client_factory{dynamic_config::MakeDefaultStorage({}),
+                                      std::move(server_config)};
+        auto clients =
+            utils::GenerateFixedArray(kBatchSize, [&client_factory](auto) {
+              return client_factory
+                  .MakeClient<sample::ugrpc::UnitTestServiceClient>();
+            });
+
+        for (auto _ : state) {
+          auto tasks =
+              utils::GenerateFixedArray(kBatchSize, [&clients](auto i) {
+                return engine::AsyncNoSpan(UnaryRPCPayloadRepeated,
+                                           std::ref(clients[i]));
+              });
+          engine::GetAll(tasks);
+        }
+
+        state.counters["rps"] = benchmark::Counter(
+            static_cast<std::size_t>(state.iterations()) * kBatchSize *
+                kUnaryRPCPayloadRepeatedRepetitions,
+            benchmark::Counter::kIsRate);
+      });
+}
+
+BENCHMARK(BatchOfUnaryRPCCompletionQueues)
+    ->ArgsProduct({{4, 8}, {1, 2, 4}})
+    ->Unit(benchmark::kMillisecond);
+
+// Compares the server backends: range(1) is 0 for the completion queues and
+// 1 for the callback API
+void BatchOfUnaryRPCCallbackApi(benchmark::State& state) {
+  engine::RunStandalone(
+      state.range(0),
+      engine::TaskProcessorPoolsConfig{10000, 100000, 256 * 1024ULL, 1, "ev",
+                                       false, false},
+      [&] {
+        static constexpr std::size_t kBatchSize = 16;
+        GrpcBackendTest client_factory{state.range(1) != 0};
+        auto clients =
+            utils::GenerateFixedArray(kBatchSize, [&client_factory](auto) {
+              return client_factory
+                  .MakeClient<sample::ugrpc::UnitTestServiceClient>();
+            });
+
+        for (auto _ : state) {
+          auto tasks =
+              utils::GenerateFixedArray(kBatchSize, [&clients](auto i) {
+                return engine::AsyncNoSpan(UnaryRPCPayloadRepeated,
+                                           std::ref(clients[i]));
+              });
+          engine::GetAll(tasks);
+        }
+
+        state.counters["rps"] = benchmark::Counter(
+            static_cast<std::size_t>(state.iterations()) * kBatchSize *
+                kUnaryRPCPayloadRepeatedRepetitions,
+            benchmark::Counter::kIsRate);
+      });
+}
+
+BENCHMARK(BatchOfUnaryRPCCallbackApi)
+    ->ArgsProduct({{4, 8}, {0, 1}})
+    ->Unit(benchmark::kMillisecond);
+
 void BatchOfUnaryRPCNewClient(benchmark::State& state) {
   engine::RunStandalone(
       state.range(0),
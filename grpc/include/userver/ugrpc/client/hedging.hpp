@@ -0,0 +1,200 @@
+#pragma once
+
+/// @file userver/ugrpc/client/hedging.hpp
+/// @brief @copybrief ugrpc::client::HedgingPolicy
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/engine/wait_any.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/scope_guard.hpp>
+
+#include <userver/ugrpc/client/exceptions.hpp>
+#include <userver/ugrpc/client/impl/retry_budget.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+
+/// Settings of the retry budget of ugrpc::client::HedgingPolicy
+struct RetryBudgetSettings final {
+  /// Maximum number of tokens, additional attempts are started only while
+  /// more than a half of them is left
+  float max_tokens{100.0f};
+
+  /// Tokens returned by a successful attempt, a failed one takes a whole token
+  float token_ratio{0.1f};
+};
+
+/// Settings of ugrpc::client::HedgingPolicy
+struct HedgingSettings final {
+  /// Maximum number of attempts of a call, including the first one
+  std::size_t max_attempts{2};
+
+  /// An additional attempt is started when none of the started ones has
+  /// finished in that time, usually a high percentile of the method latency.
+  /// The attempts are not hedged if not set.
+  std::optional<std::chrono::milliseconds> hedging_delay;
+
+  /// Whether an additional attempt is started after an UNAVAILABLE error
+  bool retry_unavailable{true};
+
+  RetryBudgetSettings retry_budget{};
+};
+
+/// Statistics of a method called through ugrpc::client::HedgingPolicy
+struct HedgingStatistics final {
+  std::size_t calls{0};
+  /// Attempts started after `hedging_delay`
+  std::size_t hedged_attempts{0};
+  /// Attempts started after an UNAVAILABLE error
+  std::size_t retries{0};
+  /// Calls answered by an additional attempt
+  std::size_t hedge_wins{0};
+  /// Additional attempts not started because of the retry budget
+  std::size_t budget_exhausted{0};
+};
+
+/// @brief Performs unary RPCs with hedging and retries bounded by a retry
+/// budget shared between all the calls of the policy.
+///
+/// An additional attempt is started when the started ones have not finished
+/// in `hedging_delay` or when one of them has failed with UNAVAILABLE, up to
+/// `max_attempts` in total. The first successful response wins and the
+/// remaining attempts are cancelled. Other errors are not retried and are
+/// rethrown at once. The attempts should be idempotent.
+///
+/// The budget follows the retry throttling of gRPC: the additional attempts
+/// are started only while more than a half of the tokens is left, so that
+/// the retries do not multiply the load on an unhealthy service.
+///
+/// Usually a single policy is kept per client.
+///
+/// ## Example:
+///
+/// @code
+/// auto response = policy.Perform([&] { return client.SayHello(request); });
+/// @endcode
+class HedgingPolicy final {
+ public:
+  explicit HedgingPolicy(const HedgingSettings& settings);
+
+  HedgingPolicy(const HedgingPolicy&) = delete;
+  HedgingPolicy& operator=(const HedgingPolicy&) = delete;
+
+  /// @brief Performs the call, @p make_call starts a single attempt and
+  /// returns its ugrpc::client::UnaryCall
+  /// @returns the response of the first successful attempt
+  /// @throws ugrpc::client::RpcError if the call has failed
+  template <typename MakeCall>
+  auto Perform(MakeCall&& make_call);
+
+  /// @returns statistics of the calls by their names
+  std::unordered_map<std::string, HedgingStatistics> GetStatistics() const;
+
+ private:
+  void Account(std::string_view call_name, const HedgingStatistics& stats);
+
+  const HedgingSettings settings_;
+  impl::RetryBudget budget_;
+  concurrent::Variable<std::unordered_map<std::string, HedgingStatistics>,
+                       std::mutex>
+      statistics_;
+};
+
+template <typename MakeCall>
+auto HedgingPolicy::Perform(MakeCall&& make_call) {
+  using Call = std::invoke_result_t<MakeCall&>;
+  using Response = decltype(std::declval<Call&>().Finish());
+
+  std::vector<std::unique_ptr<Call>> calls;
+  std::vector<engine::TaskWithResult<Response>> attempts;
+  calls.reserve(settings_.max_attempts);
+  attempts.reserve(settings_.max_attempts);
+
+  // The attempts still running are waited for by the destructors of the tasks
+  const utils::ScopeGuard cancel_guard{[&calls] {
+    for (auto& call : calls) call->GetContext().TryCancel();
+  }};
+
+  const auto start_attempt = [&] {
+    calls.push_back(std::make_unique<Call>(make_call()));
+    attempts.push_back(
+        utils::Async("grpc_hedged_attempt",
+                     [call = calls.back().get()] { return call->Finish(); }));
+  };
+  start_attempt();
+
+  HedgingStatistics stats;
+  stats.calls = 1;
+  const std::string call_name{calls.front()->GetCallName()};
+  const utils::ScopeGuard account_guard{
+      [this, &call_name, &stats] { Account(call_name, stats); }};
+
+  std::size_t running = 1;
+  bool may_hedge = settings_.hedging_delay.has_value();
+  std::exception_ptr last_error;
+  while (running != 0) {
+    const auto hedge_deadline =
+        may_hedge && calls.size() < settings_.max_attempts
+            ? engine::Deadline::FromDuration(*settings_.hedging_delay)
+            : engine::Deadline{};
+    const auto index = engine::WaitAnyUntil(hedge_deadline, attempts);
+
+    if (!index) {
+      if (engine::current_task::ShouldCancel()) {
+        throw RpcCancelledError(call_name, "HedgingPolicy::Perform");
+      }
+      if (budget_.CanRetry()) {
+        ++stats.hedged_attempts;
+        start_attempt();
+        ++running;
+      } else {
+        ++stats.budget_exhausted;
+        may_hedge = false;
+      }
+      continue;
+    }
+
+    --running;
+    try {
+      auto response = attempts[*index].Get();
+      budget_.AccountOk();
+      if (*index != 0) ++stats.hedge_wins;
+      return response;
+    } catch (const UnavailableError&) {
+      budget_.AccountFail();
+      last_error = std::current_exception();
+    }
+
+    if (settings_.retry_unavailable && calls.size() < settings_.max_attempts) {
+      if (budget_.CanRetry()) {
+        ++stats.retries;
+        start_attempt();
+        ++running;
+      } else {
+        ++stats.budget_exhausted;
+      }
+    }
+  }
+  std::rethrow_exception(last_error);
+}
+
+}  // namespace ugrpc::client
+
+USERVER_NAMESPACE_END
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <grpcpp/client_context.h>
 #include <grpcpp/completion_queue.h>
@@ -147,6 +149,7 @@ class RpcData final {
   grpc::CompletionQueue& queue_;
   RpcConfigValues config_values_;
   const Middlewares& mws_;
+  ChannelCache::ChannelLoad channel_load_;
 
   std::variant<std::monostate, AsyncMethodInvocation,
                FinishAsyncMethodInvocation>
@@ -245,8 +248,23 @@ bool Write(GrpcStream& stream, const Request& request,
   }
   if (result != impl::AsyncMethodInvocation::WaitStatus::kOk) {
     data.SetWritesFinished();
+    return false;
   }
-  return result == impl::AsyncMethodInvocation::WaitStatus::kOk;
+  data.GetStatsScope().OnMessagesWritten(1);
+  return true;
+}
+
+template <typename GrpcStream, typename Request>
+bool WriteBatch(GrpcStream& stream, const std::vector<Request>& requests,
+                RpcData& data) {
+  if (requests.empty()) return true;
+  // The messages are buffered until the last one, which is sent at once
+  grpc::WriteOptions buffered_options{};
+  buffered_options.set_buffer_hint();
+  for (std::size_t i = 0; i + 1 < requests.size(); ++i) {
+    if (!Write(stream, requests[i], buffered_options, data)) return false;
+  }
+  return Write(stream, requests.back(), {}, data);
 }
 
 void PrepareWriteAndCheck(RpcData& data);
@@ -258,6 +276,7 @@ void WriteAndCheck(GrpcStream& stream, const Request& request,
   AsyncMethodInvocation write;
   stream.Write(request, options, write.GetTag());
   CheckOk(data, Wait(write, data.GetContext()), "WriteAndCheck");
+  data.GetStatsScope().OnMessagesWritten(1);
 }
 
 template <typename GrpcStream>
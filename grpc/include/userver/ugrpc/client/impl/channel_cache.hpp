@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -26,6 +27,7 @@ class ChannelCache final {
   ~ChannelCache();
 
   class Token;
+  class ChannelLoad;
 
   // The grpc::Channel is kept in cache as long as some Token pointing to it is
   // alive.
@@ -39,6 +41,8 @@ class ChannelCache final {
                    std::size_t count);
 
     utils::FixedArray<std::shared_ptr<grpc::Channel>> channels;
+    // Number of calls in flight on each of the channels
+    utils::FixedArray<std::atomic<std::size_t>> in_flight;
     std::uint64_t counter{0};
   };
 
@@ -67,12 +71,37 @@ class ChannelCache::Token final {
   const std::shared_ptr<grpc::Channel>& GetChannel(std::size_t index) const
       noexcept;
 
+  // Picks the channel with the least calls in flight, preferring the channels
+  // that are not failing to connect, and accounts a new call on it
+  ChannelLoad AcquireChannel() const;
+
+  std::size_t GetInFlightCount(std::size_t index) const noexcept;
+
  private:
   ChannelCache* cache_{nullptr};
   const std::string* endpoint_{nullptr};
   CountedChannel* counted_channel_{nullptr};
 };
 
+// Accounts a call in flight on a channel until released or destroyed
+class ChannelCache::ChannelLoad final {
+ public:
+  ChannelLoad() noexcept = default;
+  ChannelLoad(std::atomic<std::size_t>& in_flight, std::size_t index) noexcept;
+
+  ChannelLoad(ChannelLoad&&) noexcept;
+  ChannelLoad& operator=(ChannelLoad&&) noexcept;
+  ~ChannelLoad();
+
+  std::size_t GetChannelIndex() const noexcept { return index_; }
+
+  void Release() noexcept;
+
+ private:
+  std::atomic<std::size_t>* in_flight_{nullptr};
+  std::size_t index_{0};
+};
+
 }  // namespace ugrpc::client::impl
 
 USERVER_NAMESPACE_END
@@ -13,8 +13,8 @@
 #include <userver/ugrpc/client/middlewares/fwd.hpp>
 #include <userver/ugrpc/impl/static_metadata.hpp>
 #include <userver/ugrpc/impl/statistics.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/fixed_array.hpp>
-#include <userver/utils/rand.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -57,9 +57,13 @@ class ClientData final {
   ClientData& operator=(const ClientData&) = delete;
 
   template <typename Service>
-  Stub<Service>& NextStub() const {
-    return *static_cast<Stub<Service>*>(
-        stubs_[utils::RandRange(stubs_.size())].get());
+  Stub<Service>& GetStub(std::size_t channel_index) const {
+    UASSERT(channel_index < stubs_.size());
+    return *static_cast<Stub<Service>*>(stubs_[channel_index].get());
+  }
+
+  ChannelCache::ChannelLoad AcquireChannel() const {
+    return params_.channel_token.AcquireChannel();
   }
 
   grpc::CompletionQueue& GetQueue() const { return params_.queue; }
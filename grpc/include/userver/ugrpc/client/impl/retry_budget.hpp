@@ -0,0 +1,32 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+struct RetryBudgetSettings;
+}  // namespace ugrpc::client
+
+namespace ugrpc::client::impl {
+
+/// Implements the throttling described in
+/// https://github.com/grpc/proposal/blob/master/A6-client-retries.md#throttling-configuration
+class RetryBudget final {
+ public:
+  explicit RetryBudget(const RetryBudgetSettings& settings);
+
+  void AccountOk() noexcept;
+  void AccountFail() noexcept;
+  bool CanRetry() const noexcept;
+
+ private:
+  const std::int32_t max_tokens_;
+  const std::int32_t token_ratio_;
+  std::atomic<std::int32_t> token_count_;
+};
+
+}  // namespace ugrpc::client::impl
+
+USERVER_NAMESPACE_END
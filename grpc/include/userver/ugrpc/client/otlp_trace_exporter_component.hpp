@@ -0,0 +1,81 @@
+#pragma once
+
+/// @file userver/ugrpc/client/otlp_trace_exporter_component.hpp
+/// @brief @copybrief ugrpc::client::OtlpTraceExporterComponent
+
+#include <memory>
+
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+
+namespace impl {
+class OtlpTraceExporter;
+}  // namespace impl
+
+// clang-format off
+
+/// @ingroup userver_components
+///
+/// @brief Exports the finished tracing::Span to an OpenTelemetry collector
+/// over OTLP/gRPC.
+///
+/// Spans are encoded right from tracing::Span, without going through the
+/// text logs, and are sent in batches from a background task. A batch is sent
+/// once it has `max-batch-size` spans or `max-batch-delay` after its first
+/// span. Spans that do not fit into the `max-queue-size` queue are dropped.
+///
+/// Only the spans that are written to the logs are exported, so
+/// @ref USERVER_NO_LOG_SPANS and the span log levels apply to the export too.
+///
+/// The component is only available with `USERVER_FEATURE_GRPC_OTLP`.
+///
+/// ## Static options:
+/// The default component name for static config is `"grpc-otlp-trace-exporter"`.
+///
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// endpoint | address of the OpenTelemetry collector | -
+/// factory-component | ClientFactoryComponent name to use for the client | grpc-client-factory
+/// service-name | `service.name` resource attribute | `service-name` of components::Tracer
+/// max-queue-size | spans kept in memory until they are sent | 65536
+/// max-batch-size | spans in a single export request | 512
+/// max-batch-delay | max time to wait for a batch to fill up | 100ms
+/// export-timeout | timeout of a single export request | 1s
+///
+/// ## Metrics
+/// The `grpc.otlp-exporter` metrics contain `exported`, `dropped` (queue
+/// overflow), `failed` (export errors) span counters and `queue_size`.
+
+// clang-format on
+
+class OtlpTraceExporterComponent final
+    : public components::LoggableComponentBase {
+ public:
+  /// @ingroup userver_component_names
+  /// @brief The default name of ugrpc::client::OtlpTraceExporterComponent
+  static constexpr std::string_view kName = "grpc-otlp-trace-exporter";
+
+  OtlpTraceExporterComponent(const components::ComponentConfig& config,
+                             const components::ComponentContext& context);
+
+  ~OtlpTraceExporterComponent() override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::shared_ptr<impl::OtlpTraceExporter> exporter_;
+  utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace ugrpc::client
+
+template <>
+inline constexpr bool
+    components::kHasValidate<ugrpc::client::OtlpTraceExporterComponent> =
+        true;
+
+USERVER_NAMESPACE_END
@@ -10,6 +10,7 @@
 
 #include <userver/utils/fixed_array.hpp>
 #include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/log_histogram.hpp>
 #include <userver/utils/statistics/percentile.hpp>
 #include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
@@ -45,6 +46,8 @@ class MethodStatistics final {
 
   void AccountCancelled() noexcept;
 
+  void AccountMessagesWritten(std::size_t count) noexcept;
+
   friend void DumpMetric(utils::statistics::Writer& writer,
                          const MethodStatistics& stats);
 
@@ -60,12 +63,17 @@ class MethodStatistics final {
   RateCounter started_{0};
   std::array<RateCounter, kCodesCount> status_codes_{};
   utils::statistics::RecentPeriod<Percentile, Percentile> timings_;
+  // Unlike 'timings_', is lock-free, takes one atomic increment per RPC and
+  // can be summed up across hosts
+  utils::statistics::LogHistogram timings_histogram_;
   RateCounter network_errors_{0};
   RateCounter internal_errors_{0};
   RateCounter cancelled_{0};
 
   RateCounter deadline_updated_{0};
   RateCounter deadline_cancelled_{0};
+
+  RateCounter messages_written_{0};
 };
 
 class ServiceStatistics final {
@@ -28,6 +28,9 @@ class RpcStatisticsScope final {
 
   void OnNetworkError();
 
+  // Messages written into streams
+  void OnMessagesWritten(std::size_t count);
+
   void Flush();
 
  private:
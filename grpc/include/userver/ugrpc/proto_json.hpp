@@ -1,12 +1,15 @@
 #pragma once
 
 /// @file userver/ugrpc/proto_json.hpp
-/// @brief Utilities for conversion Protobuf -> Json
+/// @brief Utilities for conversion Protobuf <-> Json
+
+#include <string_view>
 
 #include <google/protobuf/util/json_util.h>
 
 #include <userver/formats/json.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder_fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -23,8 +26,24 @@ std::string ToString(const google::protobuf::Message& message);
 /// @throws formats::json::ConversionException
 std::string ToJsonString(const google::protobuf::Message& message);
 
+/// @brief Parses Json-string into protobuf message without building a
+/// formats::json::Value, unknown fields are ignored
+/// @throws formats::json::ParseException
+void JsonStringToMessage(std::string_view json,
+                         google::protobuf::Message& message);
+
 }  // namespace ugrpc
 
+namespace formats::json {
+
+/// @brief Writes Json representation of protobuf message without building a
+/// formats::json::Value
+/// @throws formats::json::ConversionException
+void WriteToStream(const google::protobuf::Message& message,
+                   StringBuilder& sw);
+
+}  // namespace formats::json
+
 namespace formats::serialize {
 
 json::Value Serialize(const google::protobuf::Message& message,
@@ -1,13 +1,17 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 #include <grpcpp/impl/codegen/async_stream.h>
 #include <grpcpp/impl/codegen/async_unary_call.h>
 #include <grpcpp/impl/codegen/status.h>
 
+#include <userver/utils/assert.hpp>
+
 #include <userver/ugrpc/server/exceptions.hpp>
 #include <userver/ugrpc/server/impl/async_method_invocation.hpp>
 
@@ -104,6 +108,19 @@ void Write(GrpcStream& stream, const Response& response,
   ThrowOnError(Wait(write), call_name, "Write");
 }
 
+template <typename GrpcStream, typename Response>
+void WriteBatch(GrpcStream& stream, const std::vector<Response>& responses,
+                std::string_view call_name) {
+  UASSERT(!responses.empty());
+  // The messages are buffered until the last one, which is sent at once
+  grpc::WriteOptions buffered_options{};
+  buffered_options.set_buffer_hint();
+  for (std::size_t i = 0; i + 1 < responses.size(); ++i) {
+    Write(stream, responses[i], buffered_options, call_name);
+  }
+  Write(stream, responses.back(), {}, call_name);
+}
+
 template <typename GrpcStream, typename Response>
 void WriteAndFinish(GrpcStream& stream, const Response& response,
                     grpc::WriteOptions options, const grpc::Status& status,
@@ -20,6 +20,13 @@ class AsyncService final : public Service::Service {
     }
   }
 
+  // Serves the method with the gRPC callback API instead of the completion
+  // queues, takes the ownership of `handler`
+  void SetCallbackHandler(int method_id,
+                          grpc::internal::MethodHandler* handler) {
+    this->MarkMethodRawCallback(method_id, handler);
+  }
+
   template <typename CallTraits>
   void Prepare(int method_id, grpc::ServerContext& context,
                typename CallTraits::InitialRequest& initial_request,
@@ -2,6 +2,7 @@
 
 #include <string_view>
 
+#include <google/protobuf/arena.h>
 #include <grpcpp/completion_queue.h>
 #include <grpcpp/server_context.h>
 
@@ -16,11 +17,12 @@ USERVER_NAMESPACE_BEGIN
 namespace ugrpc::server::impl {
 
 struct CallParams {
-  grpc::ServerContext& context;
+  grpc::ServerContextBase& context;
   const std::string_view call_name;
   ugrpc::impl::RpcStatisticsScope& statistics;
   logging::LoggerRef access_tskv_logger;
   tracing::Span& call_span;
+  google::protobuf::Arena* arena;
 };
 
 }  // namespace ugrpc::server::impl
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <grpcpp/impl/codegen/byte_buffer.h>
+#include <grpcpp/impl/codegen/proto_utils.h>
+#include <grpcpp/impl/codegen/server_callback.h>
+#include <grpcpp/impl/codegen/status.h>
+#include <grpcpp/server_context.h>
+
+#include <userver/engine/single_use_event.hpp>
+#include <userver/engine/task/cancel.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server::impl {
+
+/// @brief The reactor of a unary RPC served with the gRPC callback API
+///
+/// Completes `Finish` the way a completion queue completes its tags, so that
+/// the RPC is handled by the same code as the one of the asynchronous API.
+class UnaryReactor final : public grpc::ServerUnaryReactor {
+ public:
+  explicit UnaryReactor(grpc::CallbackServerContext& context) noexcept;
+
+  /// The task that handles the RPC, it is cancelled with the RPC
+  void SetCancellationToken(engine::TaskCancellationToken token) noexcept;
+
+  /// Finishes the RPC, `tag` (if any) is notified once the RPC is done
+  void Finish(const grpc::Status& status, void* tag);
+
+  /// Waits for gRPC to release the RPC, the context and the messages must not
+  /// be used afterwards
+  void WaitForDone() noexcept;
+
+  void OnCancel() override;
+
+  void OnDone() override;
+
+ private:
+  grpc::CallbackServerContext& context_;
+  engine::TaskCancellationToken cancellation_token_;
+  void* finish_tag_{nullptr};
+  engine::SingleUseEvent done_;
+};
+
+/// @brief Mimics `grpc::ServerAsyncResponseWriter` for the unary RPCs of the
+/// gRPC callback API, serializes the response straight into the gRPC buffer
+template <typename Response>
+class CallbackResponseWriter final {
+ public:
+  CallbackResponseWriter(UnaryReactor& reactor, grpc::ByteBuffer& response)
+      : reactor_(reactor), response_(response) {}
+
+  void Finish(const Response& response, const grpc::Status& status,
+              void* tag) {
+    bool own_buffer = false;
+    const auto serialization_status =
+        grpc::SerializationTraits<Response>::Serialize(response, &response_,
+                                                       &own_buffer);
+    reactor_.Finish(serialization_status.ok() ? status : serialization_status,
+                    tag);
+  }
+
+  void FinishWithError(const grpc::Status& status, void* tag) {
+    reactor_.Finish(status, tag);
+  }
+
+ private:
+  UnaryReactor& reactor_;
+  grpc::ByteBuffer& response_;
+};
+
+}  // namespace ugrpc::server::impl
+
+USERVER_NAMESPACE_END
@@ -31,6 +31,8 @@ struct ServiceSettings final {
   Middlewares middlewares;
   logging::LoggerPtr access_tskv_logger;
   const dynamic_config::Source config_source;
+  bool use_arena{false};
+  bool use_callback_api{false};
 };
 
 /// @brief Listens to requests for a gRPC service, forwarding them to a
@@ -3,12 +3,17 @@
 #include <chrono>
 #include <exception>
 #include <functional>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <optional>
 #include <type_traits>
 #include <utility>
 
+#include <google/protobuf/arena.h>
 #include <grpcpp/completion_queue.h>
+#include <grpcpp/impl/codegen/byte_buffer.h>
+#include <grpcpp/impl/codegen/server_callback_handlers.h>
 #include <grpcpp/impl/service_type.h>
 #include <grpcpp/server_context.h>
 
@@ -31,6 +36,7 @@
 #include <userver/ugrpc/server/impl/async_service.hpp>
 #include <userver/ugrpc/server/impl/call_params.hpp>
 #include <userver/ugrpc/server/impl/call_traits.hpp>
+#include <userver/ugrpc/server/impl/callback_methods.hpp>
 #include <userver/ugrpc/server/impl/error_code.hpp>
 #include <userver/ugrpc/server/impl/service_worker.hpp>
 #include <userver/ugrpc/server/middlewares/base.hpp>
@@ -53,7 +59,7 @@ void ReportCustomError(
     CallAnyBase& call, tracing::Span& span);
 
 void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
-               grpc::ServerContext& context, std::string_view call_name);
+               grpc::ServerContextBase& context, std::string_view call_name);
 
 /// Per-gRPC-service data
 template <typename GrpcppService>
@@ -92,6 +98,66 @@ struct MethodData final {
       service_data.statistics.GetMethodStatistics(method_id)};
 };
 
+// Handles an accepted RPC, `raw_call` is a grpcpp asynchronous stream or a
+// CallbackResponseWriter
+template <typename GrpcppService, typename CallTraits, typename RawCall>
+void HandleRpc(const MethodData<GrpcppService, CallTraits>& method_data,
+               grpc::ServerContextBase& context,
+               typename CallTraits::InitialRequest& initial_request,
+               RawCall& raw_call, google::protobuf::Arena* arena,
+               std::optional<tracing::InPlaceSpan>& span) {
+  using InitialRequest = typename CallTraits::InitialRequest;
+  using Call = typename CallTraits::Call;
+
+  const auto call_name = method_data.call_name;
+  auto& service = method_data.service;
+  const auto service_method = method_data.service_method;
+
+  const auto& service_name =
+      method_data.service_data.metadata.service_full_name;
+  const auto& method_name = method_data.method_name;
+
+  SetupSpan(span, context, call_name);
+  utils::FastScopeGuard destroy_span([&]() noexcept { span.reset(); });
+
+  ugrpc::impl::RpcStatisticsScope statistics_scope(method_data.statistics);
+
+  auto& access_tskv_logger =
+      method_data.service_data.settings.access_tskv_logger;
+  Call responder(CallParams{context, call_name, statistics_scope,
+                            *access_tskv_logger, span->Get(), arena},
+                 raw_call);
+  auto do_call = [&] {
+    if constexpr (std::is_same_v<InitialRequest, NoInitialRequest>) {
+      (service.*service_method)(responder);
+    } else {
+      (service.*service_method)(responder, std::move(initial_request));
+    }
+  };
+
+  try {
+    ::google::protobuf::Message* initial_request_message = nullptr;
+    if constexpr (!std::is_same_v<InitialRequest, NoInitialRequest>) {
+      initial_request_message = &initial_request;
+    }
+
+    auto& middlewares = method_data.service_data.settings.middlewares;
+    MiddlewareCallContext middleware_context(
+        middlewares, responder, do_call, service_name, method_name,
+        method_data.service_data.settings.config_source.GetSnapshot(),
+        initial_request_message);
+    middleware_context.Next();
+  } catch (
+      const USERVER_NAMESPACE::server::handlers::CustomHandlerException& ex) {
+    ReportCustomError(ex, responder, span->Get());
+  } catch (const RpcInterruptedError& ex) {
+    ReportNetworkError(ex, call_name, span->Get());
+    statistics_scope.OnNetworkError();
+  } catch (const std::exception& ex) {
+    ReportHandlerError(ex, call_name, span->Get());
+  }
+}
+
 template <typename GrpcppService, typename CallTraits>
 class CallData final {
  public:
@@ -100,6 +166,14 @@ class CallData final {
         method_data_(method_data) {
     UASSERT(method_data.method_id <
             method_data.service_data.metadata.method_full_names.size());
+
+    if (method_data.service_data.settings.use_arena) {
+      arena_.emplace();
+      if constexpr (!std::is_same_v<InitialRequest, NoInitialRequest>) {
+        initial_request_on_arena_ =
+            google::protobuf::Arena::CreateMessage<InitialRequest>(&*arena_);
+      }
+    }
   }
 
   void operator()() && {
@@ -118,7 +192,7 @@ class CallData final {
         method_data_.queue_num);
 
     method_data_.service_data.async_service.template Prepare<CallTraits>(
-        method_data_.method_id, context_, initial_request_, raw_responder_,
+        method_data_.method_id, context_, GetInitialRequest(), raw_responder_,
         queue, queue, prepare_.GetTag());
 
     // Note: we ignore task cancellations here. Even if notify_when_done has
@@ -137,7 +211,8 @@ class CallData final {
     // start a concurrent listener immediately, as advised by gRPC docs
     ListenAsync(method_data_);
 
-    HandleRpc();
+    HandleRpc(method_data_, context_, GetInitialRequest(), raw_responder_,
+              arena_ ? &*arena_ : nullptr, span_);
 
     // Even if we finished before receiving notification that call is done, we
     // should wait on this async operation. CompletionQueue has a pointer to
@@ -156,56 +231,10 @@ class CallData final {
  private:
   using InitialRequest = typename CallTraits::InitialRequest;
   using RawCall = typename CallTraits::RawCall;
-  using Call = typename CallTraits::Call;
 
-  void HandleRpc() {
-    const auto call_name = method_data_.call_name;
-    auto& service = method_data_.service;
-    const auto service_method = method_data_.service_method;
-
-    const auto& service_name =
-        method_data_.service_data.metadata.service_full_name;
-    const auto& method_name = method_data_.method_name;
-
-    SetupSpan(span_, context_, call_name);
-    utils::FastScopeGuard destroy_span([&]() noexcept { span_.reset(); });
-
-    ugrpc::impl::RpcStatisticsScope statistics_scope(method_data_.statistics);
-
-    auto& access_tskv_logger =
-        method_data_.service_data.settings.access_tskv_logger;
-    Call responder(CallParams{context_, call_name, statistics_scope,
-                              *access_tskv_logger, span_->Get()},
-                   raw_responder_);
-    auto do_call = [&] {
-      if constexpr (std::is_same_v<InitialRequest, NoInitialRequest>) {
-        (service.*service_method)(responder);
-      } else {
-        (service.*service_method)(responder, std::move(initial_request_));
-      }
-    };
-
-    try {
-      ::google::protobuf::Message* initial_request = nullptr;
-      if constexpr (!std::is_same_v<InitialRequest, NoInitialRequest>) {
-        initial_request = &initial_request_;
-      }
-
-      auto& middlewares = method_data_.service_data.settings.middlewares;
-      MiddlewareCallContext middleware_context(
-          middlewares, responder, do_call, service_name, method_name,
-          method_data_.service_data.settings.config_source.GetSnapshot(),
-          initial_request);
-      middleware_context.Next();
-    } catch (
-        const USERVER_NAMESPACE::server::handlers::CustomHandlerException& ex) {
-      ReportCustomError(ex, responder, span_->Get());
-    } catch (const RpcInterruptedError& ex) {
-      ReportNetworkError(ex, call_name, span_->Get());
-      statistics_scope.OnNetworkError();
-    } catch (const std::exception& ex) {
-      ReportHandlerError(ex, call_name, span_->Get());
-    }
+  InitialRequest& GetInitialRequest() {
+    return initial_request_on_arena_ ? *initial_request_on_arena_
+                                     : initial_request_;
   }
 
   // 'wait_token_' must be the first field, because its lifetime keeps
@@ -215,12 +244,115 @@ class CallData final {
   MethodData<GrpcppService, CallTraits> method_data_;
 
   grpc::ServerContext context_{};
+  // Messages on the arena are destroyed with it
+  std::optional<google::protobuf::Arena> arena_;
+  InitialRequest* initial_request_on_arena_{nullptr};
   InitialRequest initial_request_{};
   RawCall raw_responder_{&context_};
   ugrpc::impl::AsyncMethodInvocation prepare_;
   std::optional<tracing::InPlaceSpan> span_{};
 };
 
+/// @brief Serves a unary RPC of a service with `use-callback-api` enabled
+///
+/// gRPC calls the handler right on its own threads, so that there are no
+/// completion queue threads between the gRPC I/O and the task of the RPC.
+/// The request is parsed in the task, just like with the completion queues.
+template <typename GrpcppService, typename CallTraits>
+class CallbackCallData final {
+ public:
+  static_assert(CallTraits::kCallCategory == CallCategory::kUnary);
+
+  // Called once before the server starts
+  static void Register(const MethodData<GrpcppService, CallTraits>& data) {
+    data.service_data.async_service.SetCallbackHandler(
+        static_cast<int>(data.method_id),
+        new grpc::internal::CallbackUnaryHandler<grpc::ByteBuffer,
+                                                 grpc::ByteBuffer>(
+            [data](grpc::CallbackServerContext* context,
+                   const grpc::ByteBuffer* request,
+                   grpc::ByteBuffer* response) {
+              return Start(data, *context, *request, *response);
+            }));
+  }
+
+  CallbackCallData(const MethodData<GrpcppService, CallTraits>& method_data,
+                   grpc::CallbackServerContext& context,
+                   const grpc::ByteBuffer& raw_request,
+                   grpc::ByteBuffer& raw_response)
+      : wait_token_(method_data.service_data.wait_tokens.GetToken()),
+        method_data_(method_data),
+        context_(context),
+        raw_request_(raw_request),
+        reactor_(context),
+        response_writer_(reactor_, raw_response) {
+    if (method_data.service_data.settings.use_arena) {
+      arena_.emplace();
+      request_on_arena_ =
+          google::protobuf::Arena::CreateMessage<Request>(&*arena_);
+    }
+  }
+
+ private:
+  using Request = typename CallTraits::Request;
+  using Response = typename CallTraits::Response;
+
+  static grpc::ServerUnaryReactor* Start(
+      const MethodData<GrpcppService, CallTraits>& method_data,
+      grpc::CallbackServerContext& context, const grpc::ByteBuffer& request,
+      grpc::ByteBuffer& response) {
+    auto call_data = std::make_unique<CallbackCallData>(method_data, context,
+                                                        request, response);
+    auto& reactor = call_data->reactor_;
+    auto task = engine::CriticalAsyncNoSpan(
+        method_data.service_data.settings.task_processor,
+        [call_data = std::move(call_data)] { call_data->HandleRpc(); });
+    // gRPC calls OnCancel and OnDone only after the reactor is returned, so
+    // the task does not destroy the reactor before this point
+    reactor.SetCancellationToken(engine::TaskCancellationToken{task});
+    std::move(task).Detach();
+    return &reactor;
+  }
+
+  Request& GetRequest() {
+    return request_on_arena_ ? *request_on_arena_ : request_;
+  }
+
+  void HandleRpc() {
+    auto& request = GetRequest();
+    // The slices are shared with the gRPC buffer, which is alive until
+    // OnDone
+    grpc::ByteBuffer buffer{raw_request_};
+    const auto parse_status =
+        grpc::SerializationTraits<Request>::Deserialize(&buffer, &request);
+    if (parse_status.ok()) {
+      impl::HandleRpc(method_data_, context_, request, response_writer_,
+                      arena_ ? &*arena_ : nullptr, span_);
+    } else {
+      reactor_.Finish(parse_status, nullptr);
+    }
+
+    // The context and the messages are released by gRPC after OnDone
+    reactor_.WaitForDone();
+  }
+
+  // 'wait_token_' must be the first field, because its lifetime keeps
+  // ServiceData alive during server shutdown.
+  const utils::impl::WaitTokenStorage::Token wait_token_;
+
+  const MethodData<GrpcppService, CallTraits> method_data_;
+
+  grpc::CallbackServerContext& context_;
+  const grpc::ByteBuffer& raw_request_;
+  UnaryReactor reactor_;
+  CallbackResponseWriter<Response> response_writer_;
+  // Messages on the arena are destroyed with it
+  std::optional<google::protobuf::Arena> arena_;
+  Request* request_on_arena_{nullptr};
+  Request request_{};
+  std::optional<tracing::InPlaceSpan> span_{};
+};
+
 template <typename GrpcppService>
 class ServiceWorkerImpl final : public ServiceWorker {
  public:
@@ -232,12 +364,19 @@ class ServiceWorkerImpl final : public ServiceWorker {
         start_{[this, &service, service_methods...] {
           for (size_t i = 0; i < service_data_.settings.queue.GetSize(); i++) {
             std::size_t method_id = 0;
-            (CallData<GrpcppService, CallTraits<ServiceMethods>>::ListenAsync(
+            (ListenAsync<CallTraits<ServiceMethods>>(
                  {service_data_, static_cast<int>(i), method_id++, service,
                   service_methods}),
              ...);
           }
-        }} {}
+        }} {
+    if (service_data_.settings.use_callback_api) {
+      std::size_t method_id = 0;
+      (RegisterCallback<CallTraits<ServiceMethods>>(
+           {service_data_, 0, method_id++, service, service_methods}),
+       ...);
+    }
+  }
 
   ~ServiceWorkerImpl() override {
     service_data_.wait_tokens.WaitForAllTokens();
@@ -252,6 +391,27 @@ class ServiceWorkerImpl final : public ServiceWorker {
   void Start() override { start_(); }
 
  private:
+  // Only the unary methods are served with the callback API, the streaming
+  // ones still use the completion queues
+  template <typename Traits>
+  static constexpr bool kIsCallbackCapable =
+      Traits::kCallCategory == CallCategory::kUnary;
+
+  template <typename Traits>
+  void RegisterCallback(const MethodData<GrpcppService, Traits>& data) {
+    if constexpr (kIsCallbackCapable<Traits>) {
+      CallbackCallData<GrpcppService, Traits>::Register(data);
+    }
+  }
+
+  template <typename Traits>
+  void ListenAsync(const MethodData<GrpcppService, Traits>& data) {
+    if (kIsCallbackCapable<Traits> && service_data_.settings.use_callback_api) {
+      return;
+    }
+    CallData<GrpcppService, Traits>::ListenAsync(data);
+  }
+
   ServiceData<GrpcppService> service_data_;
   std::function<void()> start_;
 };
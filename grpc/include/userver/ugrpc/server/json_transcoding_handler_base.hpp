@@ -0,0 +1,98 @@
+#pragma once
+
+/// @file userver/ugrpc/server/json_transcoding_handler_base.hpp
+/// @brief @copybrief ugrpc::server::JsonTranscodingHandlerBase
+
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <google/protobuf/message.h>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/http/content_type.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+
+#include <userver/ugrpc/proto_json.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server {
+
+/// @ingroup userver_http_handlers userver_base_classes
+///
+/// @brief Base for HTTP handlers that expose a unary gRPC method over
+/// HTTP/JSON.
+///
+/// The request body is parsed straight into the `Request` message by the
+/// streaming JSON parser of protobuf, and the `Response` message is written
+/// into the response body, neither of them goes through a
+/// formats::json::Value. A request body that does not match the message gets
+/// a `400 Bad Request` response.
+///
+/// The JSON mapping of the messages is the canonical protobuf one, the fields
+/// are not taken from the path and the query of the request.
+///
+/// ## Example usage:
+///
+/// @code
+/// class SayHelloHandler final
+///     : public ugrpc::server::JsonTranscodingHandlerBase<
+///           samples::api::GreetingRequest, samples::api::GreetingResponse> {
+///  public:
+///   static constexpr std::string_view kName = "handler-say-hello-json";
+///
+///   using JsonTranscodingHandlerBase::JsonTranscodingHandlerBase;
+///
+///   samples::api::GreetingResponse HandleMessage(
+///       samples::api::GreetingRequest&& request,
+///       const server::http::HttpRequest&,
+///       server::request::RequestContext&) const override {
+///     samples::api::GreetingResponse response;
+///     response.set_greeting("Hello, " + request.name());
+///     return response;
+///   }
+/// };
+/// @endcode
+template <typename Request, typename Response>
+class JsonTranscodingHandlerBase
+    : public USERVER_NAMESPACE::server::handlers::HttpHandlerBase {
+  static_assert(std::is_base_of_v<google::protobuf::Message, Request> &&
+                std::is_base_of_v<google::protobuf::Message, Response>);
+
+ public:
+  using HttpHandlerBase::HttpHandlerBase;
+
+  std::string HandleRequestThrow(
+      const USERVER_NAMESPACE::server::http::HttpRequest& request,
+      USERVER_NAMESPACE::server::request::RequestContext& context)
+      const final {
+    Request request_message;
+    try {
+      ugrpc::JsonStringToMessage(request.RequestBody(), request_message);
+    } catch (const formats::json::ParseException& ex) {
+      throw USERVER_NAMESPACE::server::handlers::ClientError(
+          USERVER_NAMESPACE::server::handlers::ExternalBody{ex.what()});
+    }
+
+    const Response response_message =
+        HandleMessage(std::move(request_message), request, context);
+
+    request.GetHttpResponse().SetContentType(
+        USERVER_NAMESPACE::http::content_type::kApplicationJson);
+    formats::json::StringBuilder response_json;
+    WriteToStream(response_message, response_json);
+    return response_json.GetString();
+  }
+
+  virtual Response HandleMessage(
+      Request&& request,
+      const USERVER_NAMESPACE::server::http::HttpRequest& http_request,
+      USERVER_NAMESPACE::server::request::RequestContext& context) const = 0;
+};
+
+}  // namespace ugrpc::server
+
+USERVER_NAMESPACE_END
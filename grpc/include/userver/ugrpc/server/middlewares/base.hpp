@@ -4,6 +4,7 @@
 /// @brief @copybrief ugrpc::server::MiddlewareBase
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include <userver/components/loggable_component_base.hpp>
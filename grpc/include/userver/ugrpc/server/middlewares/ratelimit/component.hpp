@@ -0,0 +1,46 @@
+#pragma once
+
+/// @file userver/ugrpc/server/middlewares/ratelimit/component.hpp
+/// @brief @copybrief ugrpc::server::middlewares::ratelimit::Component
+
+#include <userver/ugrpc/server/middlewares/base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// Server per-client ratelimit middleware
+namespace ugrpc::server::middlewares::ratelimit {
+
+/// @ingroup userver_components userver_base_classes
+///
+/// @brief Component for gRPC server per-client rate limiting
+///
+/// Each client gets a separate limit, see utils::KeyedRateLimiter. The calls
+/// over the limit are finished with RESOURCE_EXHAUSTED.
+///
+/// ## Static options:
+/// Name | Description | Default value
+/// ---- | ----------- | -------------
+/// metadata-key | client metadata key identifying the client, the calls without it share a single limit | <peer address>
+/// requests-per-second | calls per second of each client | -
+/// burst | calls a client may make at once after being idle | requests-per-second
+class Component final : public MiddlewareComponentBase {
+ public:
+  /// @ingroup userver_component_names
+  /// @brief The default name of
+  /// ugrpc::server::middlewares::ratelimit::Component
+  static constexpr std::string_view kName = "grpc-server-ratelimit";
+
+  Component(const components::ComponentConfig& config,
+            const components::ComponentContext& context);
+
+  std::shared_ptr<MiddlewareBase> GetMiddleware() override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::shared_ptr<MiddlewareBase> middleware_;
+};
+
+}  // namespace ugrpc::server::middlewares::ratelimit
+
+USERVER_NAMESPACE_END
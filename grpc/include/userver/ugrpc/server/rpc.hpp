@@ -3,6 +3,10 @@
 /// @file userver/ugrpc/server/rpc.hpp
 /// @brief Classes representing an incoming RPC
 
+#include <cstddef>
+#include <variant>
+#include <vector>
+
 #include <grpcpp/impl/codegen/proto_utils.h>
 #include <grpcpp/server_context.h>
 
@@ -15,6 +19,7 @@
 #include <userver/ugrpc/server/exceptions.hpp>
 #include <userver/ugrpc/server/impl/async_methods.hpp>
 #include <userver/ugrpc/server/impl/call_params.hpp>
+#include <userver/ugrpc/server/impl/callback_methods.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -42,16 +47,24 @@ class CallAnyBase {
   /// @throws ugrpc::server::RpcError on an RPC error
   virtual void FinishWithError(const grpc::Status& status) = 0;
 
-  /// @returns the `ServerContext` used for this RPC
+  /// @returns the context used for this RPC, a `grpc::ServerContext` or a
+  /// `grpc::CallbackServerContext` if `use-callback-api` is enabled
   /// @note Initial server metadata is not currently supported
   /// @note Trailing metadata, if any, must be set before the `Finish` call
-  grpc::ServerContext& GetContext() { return params_.context; }
+  grpc::ServerContextBase& GetContext() { return params_.context; }
 
   /// @brief Name of the call. Consists of service and method names
   std::string_view GetCallName() const { return params_.call_name; }
 
   tracing::Span& GetSpan() { return params_.call_span; }
 
+  /// @returns the arena freed when the RPC finishes, if `use-arena` is
+  /// enabled for the service, nullptr otherwise. Messages created there with
+  /// google::protobuf::Arena::CreateMessage must not outlive the RPC.
+  /// @note Moving the request into a message on the heap copies it deeply,
+  /// as protobuf does not move messages between arenas.
+  google::protobuf::Arena* GetArena() { return params_.arena; }
+
   virtual bool IsFinished() const = 0;
 
   /// @cond
@@ -96,6 +109,10 @@ class UnaryCall final : public CallAnyBase {
   UnaryCall(impl::CallParams&& call_params,
             impl::RawResponseWriter<Response>& stream);
 
+  /// For internal use only
+  UnaryCall(impl::CallParams&& call_params,
+            impl::CallbackResponseWriter<Response>& stream);
+
   UnaryCall(UnaryCall&&) = delete;
   UnaryCall& operator=(UnaryCall&&) = delete;
   ~UnaryCall();
@@ -103,7 +120,9 @@ class UnaryCall final : public CallAnyBase {
   bool IsFinished() const override;
 
  private:
-  impl::RawResponseWriter<Response>& stream_;
+  std::variant<impl::RawResponseWriter<Response>*,
+               impl::CallbackResponseWriter<Response>*>
+      stream_;
   bool is_finished_{false};
 };
 
@@ -172,6 +191,15 @@ class OutputStream final : public CallAnyBase {
   /// @throws ugrpc::server::RpcError on an RPC error
   void Write(const Response& response);
 
+  /// @brief Write several messages at once
+  ///
+  /// The messages are buffered by gRPC and sent together with the last one,
+  /// which saves a network round-trip per message for high-rate streams.
+  ///
+  /// @param responses the next messages to write
+  /// @throws ugrpc::server::RpcError on an RPC error
+  void WriteBatch(const std::vector<Response>& responses);
+
   /// @brief Complete the RPC successfully
   ///
   /// `Finish` must not be called multiple times.
@@ -239,6 +267,15 @@ class BidirectionalStream : public CallAnyBase {
   /// @throws ugrpc::server::RpcError on an RPC error
   void Write(const Response& response);
 
+  /// @brief Write several messages at once
+  ///
+  /// The messages are buffered by gRPC and sent together with the last one,
+  /// which saves a network round-trip per message for high-rate streams.
+  ///
+  /// @param responses the next messages to write
+  /// @throws ugrpc::server::RpcError on an RPC error
+  void WriteBatch(const std::vector<Response>& responses);
+
   /// @brief Complete the RPC successfully
   ///
   /// `Finish` must not be called multiple times.
@@ -285,12 +322,19 @@ class BidirectionalStream : public CallAnyBase {
 template <typename Response>
 UnaryCall<Response>::UnaryCall(impl::CallParams&& call_params,
                                impl::RawResponseWriter<Response>& stream)
-    : CallAnyBase(std::move(call_params)), stream_(stream) {}
+    : CallAnyBase(std::move(call_params)), stream_(&stream) {}
+
+template <typename Response>
+UnaryCall<Response>::UnaryCall(impl::CallParams&& call_params,
+                               impl::CallbackResponseWriter<Response>& stream)
+    : CallAnyBase(std::move(call_params)), stream_(&stream) {}
 
 template <typename Response>
 UnaryCall<Response>::~UnaryCall() {
   if (!is_finished_) {
-    impl::CancelWithError(stream_, GetCallName());
+    std::visit(
+        [this](auto* stream) { impl::CancelWithError(*stream, GetCallName()); },
+        stream_);
     LogFinish(impl::kUnknownErrorStatus);
   }
 }
@@ -301,7 +345,11 @@ void UnaryCall<Response>::Finish(const Response& response) {
   is_finished_ = true;
 
   LogFinish(grpc::Status::OK);
-  impl::Finish(stream_, response, grpc::Status::OK, GetCallName());
+  std::visit(
+      [&](auto* stream) {
+        impl::Finish(*stream, response, grpc::Status::OK, GetCallName());
+      },
+      stream_);
   Statistics().OnExplicitFinish(grpc::StatusCode::OK);
   ugrpc::impl::UpdateSpanWithStatus(GetSpan(), grpc::Status::OK);
 }
@@ -311,7 +359,11 @@ void UnaryCall<Response>::FinishWithError(const grpc::Status& status) {
   UINVARIANT(!is_finished_, "'FinishWithError' called on a finished call");
   is_finished_ = true;
   LogFinish(status);
-  impl::FinishWithError(stream_, status, GetCallName());
+  std::visit(
+      [&](auto* stream) {
+        impl::FinishWithError(*stream, status, GetCallName());
+      },
+      stream_);
   Statistics().OnExplicitFinish(status.error_code());
   ugrpc::impl::UpdateSpanWithStatus(GetSpan(), status);
 }
@@ -401,6 +453,19 @@ void OutputStream<Response>::Write(const Response& response) {
   grpc::WriteOptions write_options{};
 
   impl::Write(stream_, response, write_options, GetCallName());
+  Statistics().OnMessagesWritten(1);
+}
+
+template <typename Response>
+void OutputStream<Response>::WriteBatch(
+    const std::vector<Response>& responses) {
+  UINVARIANT(state_ != State::kFinished,
+             "'WriteBatch' called on a finished stream");
+  if (responses.empty()) return;
+
+  impl::SendInitialMetadataIfNew(stream_, GetCallName(), state_);
+  impl::WriteBatch(stream_, responses, GetCallName());
+  Statistics().OnMessagesWritten(responses.size());
 }
 
 template <typename Response>
@@ -440,6 +505,7 @@ void OutputStream<Response>::WriteAndFinish(const Response& response) {
   const auto status = grpc::Status::OK;
   LogFinish(status);
   impl::WriteAndFinish(stream_, response, write_options, status, GetCallName());
+  Statistics().OnMessagesWritten(1);
 }
 
 template <typename Response>
@@ -486,6 +552,22 @@ void BidirectionalStream<Request, Response>::Write(const Response& response) {
     is_finished_ = true;
     throw;
   }
+  Statistics().OnMessagesWritten(1);
+}
+
+template <typename Request, typename Response>
+void BidirectionalStream<Request, Response>::WriteBatch(
+    const std::vector<Response>& responses) {
+  UINVARIANT(!is_finished_, "'WriteBatch' called on a finished stream");
+  if (responses.empty()) return;
+
+  try {
+    impl::WriteBatch(stream_, responses, GetCallName());
+  } catch (const RpcInterruptedError&) {
+    is_finished_ = true;
+    throw;
+  }
+  Statistics().OnMessagesWritten(responses.size());
 }
 
 template <typename Request, typename Response>
@@ -523,6 +605,7 @@ void BidirectionalStream<Request, Response>::WriteAndFinish(
   const auto status = grpc::Status::OK;
   LogFinish(status);
   impl::WriteAndFinish(stream_, response, write_options, status, GetCallName());
+  Statistics().OnMessagesWritten(1);
 }
 
 template <typename Request, typename Response>
@@ -19,6 +19,16 @@ struct ServiceConfig final {
 
   /// Server middlewares to use for the gRPC service.
   Middlewares middlewares;
+
+  /// Create the requests on a per-call google::protobuf::Arena, which is
+  /// freed all at once when the RPC finishes. Handlers may create responses
+  /// there as well, see CallAnyBase::GetArena.
+  bool use_arena{false};
+
+  /// Serve the unary methods with the gRPC callback API: gRPC passes the
+  /// requests right to the tasks, without the completion queue threads. The
+  /// streaming methods still use the completion queues.
+  bool use_callback_api{false};
 };
 
 /// @brief The type-erased base class for all gRPC service implementations
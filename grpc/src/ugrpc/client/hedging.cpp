@@ -0,0 +1,33 @@
+#include <userver/ugrpc/client/hedging.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+
+HedgingPolicy::HedgingPolicy(const HedgingSettings& settings)
+    : settings_(settings), budget_(settings_.retry_budget) {
+  UINVARIANT(settings_.max_attempts > 0, "max_attempts is set to zero");
+}
+
+std::unordered_map<std::string, HedgingStatistics>
+HedgingPolicy::GetStatistics() const {
+  const auto statistics = statistics_.Lock();
+  return *statistics;
+}
+
+void HedgingPolicy::Account(std::string_view call_name,
+                            const HedgingStatistics& stats) {
+  auto statistics = statistics_.Lock();
+  auto& method = (*statistics)[std::string{call_name}];
+  method.calls += stats.calls;
+  method.hedged_attempts += stats.hedged_attempts;
+  method.retries += stats.retries;
+  method.hedge_wins += stats.hedge_wins;
+  method.budget_exhausted += stats.budget_exhausted;
+}
+
+}  // namespace ugrpc::client
+
+USERVER_NAMESPACE_END
@@ -1,12 +1,14 @@
 #include <userver/ugrpc/client/impl/channel_cache.hpp>
 
 #include <algorithm>
+#include <limits>
 #include <utility>
 
 #include <grpcpp/create_channel.h>
 #include <grpcpp/security/credentials.h>
 
 #include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
 
 #include <ugrpc/impl/to_string.hpp>
 
@@ -14,6 +16,25 @@ USERVER_NAMESPACE_BEGIN
 
 namespace ugrpc::client::impl {
 
+namespace {
+
+// The lesser the better
+int GetStateRank(grpc_connectivity_state state) noexcept {
+  switch (state) {
+    case GRPC_CHANNEL_IDLE:
+    case GRPC_CHANNEL_READY:
+      return 0;
+    case GRPC_CHANNEL_CONNECTING:
+      return 1;
+    case GRPC_CHANNEL_TRANSIENT_FAILURE:
+    case GRPC_CHANNEL_SHUTDOWN:
+      return 2;
+  }
+  return 2;
+}
+
+}  // namespace
+
 ChannelCache::Token::Token(ChannelCache& cache, const std::string& endpoint,
                            CountedChannel& counted_channel) noexcept
     : cache_(&cache), endpoint_(&endpoint), counted_channel_(&counted_channel) {
@@ -55,10 +76,69 @@ std::size_t ChannelCache::Token::GetChannelCount() const noexcept {
   return counted_channel_->channels.size();
 }
 
+ChannelCache::ChannelLoad ChannelCache::Token::AcquireChannel() const {
+  UASSERT(counted_channel_);
+  auto& channels = counted_channel_->channels;
+  auto& in_flight = counted_channel_->in_flight;
+  const auto count = channels.size();
+  if (count == 1) return {in_flight[0], 0};
+
+  // Random start breaks the ties between equally loaded channels
+  const auto start = utils::RandRange(count);
+  std::size_t best_index = start;
+  int best_rank = std::numeric_limits<int>::max();
+  std::size_t best_load = std::numeric_limits<std::size_t>::max();
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto index = (start + i) % count;
+    const auto rank =
+        GetStateRank(channels[index]->GetState(/*try_to_connect=*/false));
+    const auto load = in_flight[index].load(std::memory_order_relaxed);
+    if (rank < best_rank || (rank == best_rank && load < best_load)) {
+      best_index = index;
+      best_rank = rank;
+      best_load = load;
+    }
+  }
+  return {in_flight[best_index], best_index};
+}
+
+std::size_t ChannelCache::Token::GetInFlightCount(std::size_t index) const
+    noexcept {
+  UASSERT(counted_channel_);
+  UASSERT(index < counted_channel_->in_flight.size());
+  return counted_channel_->in_flight[index].load(std::memory_order_relaxed);
+}
+
+ChannelCache::ChannelLoad::ChannelLoad(std::atomic<std::size_t>& in_flight,
+                                       std::size_t index) noexcept
+    : in_flight_(&in_flight), index_(index) {
+  in_flight_->fetch_add(1, std::memory_order_relaxed);
+}
+
+ChannelCache::ChannelLoad::ChannelLoad(ChannelLoad&& other) noexcept
+    : in_flight_(std::exchange(other.in_flight_, nullptr)),
+      index_(other.index_) {}
+
+ChannelCache::ChannelLoad& ChannelCache::ChannelLoad::operator=(
+    ChannelLoad&& other) noexcept {
+  std::swap(in_flight_, other.in_flight_);
+  std::swap(index_, other.index_);
+  return *this;
+}
+
+ChannelCache::ChannelLoad::~ChannelLoad() { Release(); }
+
+void ChannelCache::ChannelLoad::Release() noexcept {
+  if (in_flight_) {
+    std::exchange(in_flight_, nullptr)->fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
 ChannelCache::CountedChannel::CountedChannel(
     const std::string& endpoint,
     const std::shared_ptr<grpc::ChannelCredentials>& credentials,
-    const grpc::ChannelArguments& channel_args, std::size_t count) {
+    const grpc::ChannelArguments& channel_args, std::size_t count)
+    : in_flight(count, 0) {
   const auto endpoint_string = ugrpc::impl::ToGrpcString(endpoint);
   channels = utils::GenerateFixedArray(count, [&](std::size_t) {
     return grpc::CreateCustomChannel(endpoint_string, credentials,
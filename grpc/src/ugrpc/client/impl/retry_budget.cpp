@@ -0,0 +1,47 @@
+#include <userver/ugrpc/client/impl/retry_budget.hpp>
+
+#include <algorithm>
+
+#include <userver/ugrpc/client/hedging.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client::impl {
+
+namespace {
+constexpr std::int32_t kMillis = 1000;
+}  // namespace
+
+RetryBudget::RetryBudget(const RetryBudgetSettings& settings)
+    : max_tokens_(settings.max_tokens * kMillis),
+      token_ratio_(settings.token_ratio * kMillis),
+      token_count_(max_tokens_) {
+  UINVARIANT(settings.max_tokens > 0 && settings.max_tokens <= 1000000,
+             "max_tokens should be in (0, 1000000]");
+  UINVARIANT(settings.token_ratio > 0, "token_ratio should be positive");
+}
+
+void RetryBudget::AccountOk() noexcept {
+  auto expected = token_count_.load(std::memory_order_relaxed);
+  while (!token_count_.compare_exchange_weak(
+      expected, std::min(max_tokens_, expected + token_ratio_),
+      std::memory_order_relaxed, std::memory_order_relaxed)) {
+  }
+}
+
+void RetryBudget::AccountFail() noexcept {
+  auto expected = token_count_.load(std::memory_order_relaxed);
+  while (!token_count_.compare_exchange_weak(
+      expected, std::max(0, expected - kMillis), std::memory_order_relaxed,
+      std::memory_order_relaxed)) {
+  }
+}
+
+bool RetryBudget::CanRetry() const noexcept {
+  return token_count_.load(std::memory_order_relaxed) > max_tokens_ / 2;
+}
+
+}  // namespace ugrpc::client::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,139 @@
+#include <ugrpc/client/otlp_trace_exporter.hpp>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/ugrpc/client/exceptions.hpp>
+#include <userver/ugrpc/client/qos.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client::impl {
+
+namespace {
+
+namespace otlp_proto = opentelemetry::proto;
+
+constexpr std::string_view kServiceNameAttribute = "service.name";
+constexpr std::string_view kScopeName = "userver";
+
+}  // namespace
+
+OtlpTraceExporter::OtlpTraceExporter(Client&& client,
+                                     OtlpTraceExporterSettings&& settings)
+    : client_(std::move(client)),
+      settings_(std::move(settings)),
+      queue_(Queue::Create(settings_.max_queue_size)),
+      producer_(queue_->GetMultiProducer()),
+      consumer_(queue_->GetConsumer()) {
+  UINVARIANT(settings_.max_batch_size > 0,
+             "OTLP exporter batch size must be positive");
+  batch_.reserve(settings_.max_batch_size);
+  export_task_ =
+      utils::CriticalAsync("otlp_trace_exporter", [this] { ExportLoop(); });
+}
+
+OtlpTraceExporter::~OtlpTraceExporter() { Stop(); }
+
+void OtlpTraceExporter::Export(std::string&& otlp_span) noexcept {
+  if (!producer_.PushNoblock(std::move(otlp_span))) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void OtlpTraceExporter::Stop() noexcept {
+  if (!export_task_.IsValid()) return;
+  export_task_.SyncCancel();
+  export_task_ = {};
+
+  std::string otlp_span;
+  while (consumer_.PopNoblock(otlp_span)) {
+    batch_.push_back(std::move(otlp_span));
+    if (batch_.size() >= settings_.max_batch_size) SendBatch();
+  }
+  if (!batch_.empty()) SendBatch();
+}
+
+void OtlpTraceExporter::WriteStatistics(
+    utils::statistics::Writer& writer) const {
+  writer["exported"] = utils::statistics::Rate{exported_.load()};
+  writer["dropped"] = utils::statistics::Rate{dropped_.load()};
+  writer["failed"] = utils::statistics::Rate{failed_.load()};
+  writer["queue_size"] = queue_->GetSizeApproximate();
+}
+
+void OtlpTraceExporter::ExportLoop() {
+  std::string otlp_span;
+  while (consumer_.Pop(otlp_span)) {
+    batch_.push_back(std::move(otlp_span));
+
+    // Collect spans until the batch is full or for max_batch_delay
+    const auto deadline =
+        engine::Deadline::FromDuration(settings_.max_batch_delay);
+    while (batch_.size() < settings_.max_batch_size &&
+           consumer_.Pop(otlp_span, deadline)) {
+      batch_.push_back(std::move(otlp_span));
+    }
+
+    // The rest is sent by Stop()
+    if (engine::current_task::ShouldCancel()) return;
+    SendBatch();
+  }
+}
+
+void OtlpTraceExporter::SendBatch() noexcept {
+  UASSERT(!batch_.empty());
+  const auto batch_size = batch_.size();
+
+  try {
+    // Spans of the export itself are neither logged nor exported
+    tracing::Span span{"otlp_export"};
+    span.SetLocalLogLevel(logging::Level::kNone);
+
+    otlp_proto::collector::trace::v1::ExportTraceServiceRequest request;
+    auto& resource_spans = *request.add_resource_spans();
+    auto& service_name = *resource_spans.mutable_resource()->add_attributes();
+    service_name.set_key(std::string{kServiceNameAttribute});
+    service_name.mutable_value()->set_string_value(settings_.service_name);
+
+    auto& scope_spans = *resource_spans.add_scope_spans();
+    scope_spans.mutable_scope()->set_name(std::string{kScopeName});
+    scope_spans.mutable_spans()->Reserve(static_cast<int>(batch_size));
+    for (const auto& otlp_span : batch_) {
+      [[maybe_unused]] const bool parsed =
+          scope_spans.add_spans()->ParseFromString(otlp_span);
+      UASSERT_MSG(parsed, "Malformed OTLP span from tracing::Span");
+    }
+    batch_.clear();
+
+    Qos qos;
+    qos.timeout = settings_.export_timeout;
+    const auto response =
+        client_
+            .Export(request, std::make_unique<grpc::ClientContext>(), qos)
+            .Finish();
+
+    const auto rejected = std::min<std::uint64_t>(
+        response.partial_success().rejected_spans(), batch_size);
+    exported_.fetch_add(batch_size - rejected, std::memory_order_relaxed);
+    if (rejected != 0) {
+      failed_.fetch_add(rejected, std::memory_order_relaxed);
+      LOG_LIMITED_WARNING() << "OTLP collector rejected " << rejected
+                            << " spans: "
+                            << response.partial_success().error_message();
+    }
+  } catch (const std::exception& e) {
+    batch_.clear();
+    failed_.fetch_add(batch_size, std::memory_order_relaxed);
+    LOG_LIMITED_WARNING() << "Failed to export " << batch_size
+                          << " spans over OTLP: " << e;
+  }
+}
+
+}  // namespace ugrpc::client::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <opentelemetry/proto/collector/trace/v1/trace_service_client.usrv.pb.hpp>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/tracing/span_exporter.hpp>
+#include <userver/utils/statistics/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client::impl {
+
+struct OtlpTraceExporterSettings final {
+  std::string service_name;
+  std::size_t max_queue_size{65536};
+  std::size_t max_batch_size{512};
+  std::chrono::milliseconds max_batch_delay{100};
+  std::chrono::milliseconds export_timeout{1000};
+};
+
+/// Queues the finished spans and sends them to an OpenTelemetry collector
+/// in batches from a background task.
+///
+/// Spans that do not fit into the queue are dropped, so that the exporter
+/// never slows down the code that finishes spans.
+class OtlpTraceExporter final : public tracing::SpanExporter {
+ public:
+  using Client = opentelemetry::proto::collector::trace::v1::TraceServiceClient;
+
+  OtlpTraceExporter(Client&& client, OtlpTraceExporterSettings&& settings);
+  ~OtlpTraceExporter() override;
+
+  void Export(std::string&& otlp_span) noexcept override;
+
+  /// Stops the background task and sends out the queued spans
+  void Stop() noexcept;
+
+  void WriteStatistics(utils::statistics::Writer& writer) const;
+
+ private:
+  using Queue = concurrent::NonFifoMpscQueue<std::string>;
+
+  void ExportLoop();
+  void SendBatch() noexcept;
+
+  Client client_;
+  const OtlpTraceExporterSettings settings_;
+
+  std::shared_ptr<Queue> queue_;
+  Queue::MultiProducer producer_;
+  Queue::Consumer consumer_;
+  // Only accessed by the export task, or by Stop() after the task is done
+  std::vector<std::string> batch_;
+
+  std::atomic<std::uint64_t> exported_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<std::uint64_t> failed_{0};
+
+  engine::TaskWithResult<void> export_task_;
+};
+
+}  // namespace ugrpc::client::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,114 @@
+#include <userver/ugrpc/client/otlp_trace_exporter_component.hpp>
+
+#include <userver/components/component.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/tracing/component.hpp>
+#include <userver/tracing/tracer.hpp>
+#include <userver/ugrpc/client/client_factory_component.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+#include <ugrpc/client/otlp_trace_exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::client {
+
+namespace {
+
+impl::OtlpTraceExporterSettings ParseSettings(
+    const components::ComponentConfig& config) {
+  impl::OtlpTraceExporterSettings settings;
+  settings.service_name = config["service-name"].As<std::string>({});
+  if (settings.service_name.empty()) {
+    settings.service_name = tracing::Tracer::GetTracer()->GetServiceName();
+  }
+  settings.max_queue_size =
+      config["max-queue-size"].As<std::size_t>(settings.max_queue_size);
+  settings.max_batch_size =
+      config["max-batch-size"].As<std::size_t>(settings.max_batch_size);
+  settings.max_batch_delay =
+      config["max-batch-delay"].As<std::chrono::milliseconds>(
+          settings.max_batch_delay);
+  settings.export_timeout =
+      config["export-timeout"].As<std::chrono::milliseconds>(
+          settings.export_timeout);
+  return settings;
+}
+
+}  // namespace
+
+OtlpTraceExporterComponent::OtlpTraceExporterComponent(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : LoggableComponentBase(config, context) {
+  // The tracer must be set up before the service name is taken from it
+  context.FindComponent<components::Tracer>();
+
+  auto& factory = context
+                      .FindComponent<ClientFactoryComponent>(
+                          config["factory-component"].As<std::string>(
+                              ClientFactoryComponent::kName))
+                      .GetFactory();
+  exporter_ = std::make_shared<impl::OtlpTraceExporter>(
+      factory.MakeClient<impl::OtlpTraceExporter::Client>(
+          config.Name(), config["endpoint"].As<std::string>()),
+      ParseSettings(config));
+
+  auto& storage =
+      context.FindComponent<components::StatisticsStorage>().GetStorage();
+  statistics_holder_ = storage.RegisterWriter(
+      "grpc.otlp-exporter", [this](utils::statistics::Writer& writer) {
+        exporter_->WriteStatistics(writer);
+      });
+
+  tracing::Tracer::SetSpanExporter(exporter_);
+}
+
+OtlpTraceExporterComponent::~OtlpTraceExporterComponent() {
+  tracing::Tracer::SetSpanExporter(nullptr);
+  statistics_holder_.Unregister();
+  exporter_->Stop();
+}
+
+yaml_config::Schema OtlpTraceExporterComponent::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
+type: object
+description: Exports the finished spans to an OpenTelemetry collector over OTLP/gRPC
+additionalProperties: false
+properties:
+    endpoint:
+        type: string
+        description: address of the OpenTelemetry collector
+    factory-component:
+        type: string
+        description: ClientFactoryComponent name to use for client creation
+        defaultDescription: grpc-client-factory
+    service-name:
+        type: string
+        description: service.name resource attribute
+        defaultDescription: service-name of the tracer component
+    max-queue-size:
+        type: integer
+        minimum: 1
+        description: spans kept in memory until they are sent, the rest are dropped
+        defaultDescription: 65536
+    max-batch-size:
+        type: integer
+        minimum: 1
+        description: spans in a single export request
+        defaultDescription: 512
+    max-batch-delay:
+        type: string
+        description: max time to wait for a batch to fill up
+        defaultDescription: 100ms
+    export-timeout:
+        type: string
+        description: timeout of a single export request
+        defaultDescription: 1s
+)");
+}
+
+}  // namespace ugrpc::client
+
+USERVER_NAMESPACE_END
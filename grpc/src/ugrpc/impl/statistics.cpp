@@ -13,6 +13,10 @@ namespace ugrpc::impl {
 
 namespace {
 
+// 47 buckets from 1ms to 10s, fits into the Solomon limit of 50 buckets
+constexpr utils::statistics::LogHistogramSettings kTimingsHistogramSettings{
+    /*min_value=*/1, /*max_value=*/10'000, /*relative_error=*/0.1};
+
 // For now, we need to dump metrics in legacy format - without 'rate'
 // support - in order not to break existing dashboards
 struct AsRateAndGauge final {
@@ -32,7 +36,8 @@ void DumpMetric(utils::statistics::Writer& writer,
 
 }  // namespace
 
-MethodStatistics::MethodStatistics() = default;
+MethodStatistics::MethodStatistics()
+    : timings_histogram_(kTimingsHistogramSettings) {}
 
 void MethodStatistics::AccountStarted() noexcept { ++started_; }
 
@@ -47,6 +52,7 @@ void MethodStatistics::AccountStatus(grpc::StatusCode code) noexcept {
 void MethodStatistics::AccountTiming(
     std::chrono::milliseconds timing) noexcept {
   timings_.GetCurrentCounter().Account(timing.count());
+  timings_histogram_.Account(timing.count());
 }
 
 void MethodStatistics::AccountNetworkError() noexcept { ++network_errors_; }
@@ -63,9 +69,14 @@ void MethodStatistics::AccountDeadlinePropagated() noexcept {
 
 void MethodStatistics::AccountCancelled() noexcept { ++cancelled_; }
 
+void MethodStatistics::AccountMessagesWritten(std::size_t count) noexcept {
+  messages_written_ += utils::statistics::Rate{count};
+}
+
 void DumpMetric(utils::statistics::Writer& writer,
                 const MethodStatistics& stats) {
   writer["timings"] = stats.timings_;
+  writer["timings-histogram"] = stats.timings_histogram_;
 
   utils::statistics::Rate total_requests{0};
   utils::statistics::Rate error_requests{0};
@@ -117,6 +128,8 @@ void DumpMetric(utils::statistics::Writer& writer,
       AsRateAndGauge{stats.deadline_updated_.Load()};
   writer["cancelled-by-deadline-propagation"] =
       AsRateAndGauge{deadline_cancelled_value};
+
+  writer["messages-written"] = AsRateAndGauge{stats.messages_written_.Load()};
 }
 
 ServiceStatistics::~ServiceStatistics() = default;
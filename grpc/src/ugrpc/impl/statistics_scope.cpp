@@ -24,6 +24,10 @@ void RpcStatisticsScope::OnNetworkError() {
   finish_kind_ = std::max(finish_kind_, FinishKind::kNetworkError);
 }
 
+void RpcStatisticsScope::OnMessagesWritten(std::size_t count) {
+  statistics_.AccountMessagesWritten(count);
+}
+
 void RpcStatisticsScope::OnCancelledByDeadlinePropagation() {
   finish_kind_ = std::max(finish_kind_, FinishKind::kDeadlinePropagation);
 }
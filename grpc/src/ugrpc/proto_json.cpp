@@ -2,6 +2,7 @@
 
 #include <grpcpp/support/config.h>
 
+#include <userver/formats/json/string_builder.hpp>
 #include <userver/logging/log.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -15,7 +16,14 @@ const google::protobuf::util::JsonPrintOptions kOptions = []() {
   options.always_print_primitive_fields = true;
   return options;
 }();
-}
+
+const google::protobuf::util::JsonParseOptions kParseOptions = []() {
+  google::protobuf::util::JsonParseOptions options;
+  options.ignore_unknown_fields = true;
+  return options;
+}();
+
+}  // namespace
 
 formats::json::Value MessageToJson(const google::protobuf::Message& message) {
   return formats::json::FromString(ToJsonString(message));
@@ -39,8 +47,30 @@ std::string ToJsonString(const google::protobuf::Message& message) {
   return result;
 }
 
+void JsonStringToMessage(std::string_view json,
+                         google::protobuf::Message& message) {
+  // The JSON is parsed by the streaming parser of protobuf straight into the
+  // fields of the message
+  const auto status = google::protobuf::util::JsonStringToMessage(
+      {json.data(), json.size()}, &message, kParseOptions);
+
+  if (!status.ok()) {
+    throw formats::json::ParseException(
+        "Cannot parse protobuf message from JSON: " + status.ToString());
+  }
+}
+
 }  // namespace ugrpc
 
+namespace formats::json {
+
+void WriteToStream(const google::protobuf::Message& message,
+                   StringBuilder& sw) {
+  sw.WriteRawString(ugrpc::ToJsonString(message));
+}
+
+}  // namespace formats::json
+
 namespace formats::serialize {
 
 json::Value Serialize(const google::protobuf::Message& message,
@@ -0,0 +1,42 @@
+#include <userver/ugrpc/server/impl/callback_methods.hpp>
+
+#include <utility>
+
+#include <userver/ugrpc/impl/async_method_invocation.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server::impl {
+
+UnaryReactor::UnaryReactor(grpc::CallbackServerContext& context) noexcept
+    : context_(context) {}
+
+void UnaryReactor::SetCancellationToken(
+    engine::TaskCancellationToken token) noexcept {
+  cancellation_token_ = std::move(token);
+}
+
+void UnaryReactor::Finish(const grpc::Status& status, void* tag) {
+  UASSERT(!finish_tag_);
+  finish_tag_ = tag;
+  grpc::ServerUnaryReactor::Finish(status);
+}
+
+void UnaryReactor::WaitForDone() noexcept { done_.WaitNonCancellable(); }
+
+void UnaryReactor::OnCancel() { cancellation_token_.RequestCancel(); }
+
+void UnaryReactor::OnDone() {
+  // 'ok' of the completion queue is false if the status has not reached the
+  // client
+  if (finish_tag_) {
+    static_cast<ugrpc::impl::EventBase*>(finish_tag_)
+        ->Notify(!context_.IsCancelled());
+  }
+  done_.Send();
+}
+
+}  // namespace ugrpc::server::impl
+
+USERVER_NAMESPACE_END
@@ -17,6 +17,8 @@ namespace {
 
 constexpr std::string_view kTaskProcessorKey = "task-processor";
 constexpr std::string_view kMiddlewaresKey = "middlewares";
+constexpr std::string_view kUseArenaKey = "use-arena";
+constexpr std::string_view kUseCallbackApiKey = "use-callback-api";
 
 template <typename ParserFunc>
 auto ParseOptional(const yaml_config::YamlConfig& service_field,
@@ -88,6 +90,8 @@ server::ServiceConfig ParseServiceConfig(
           MergeField(value[kMiddlewaresKey], defaults.middleware_names, context,
                      ParseMiddlewares),
           context),
+      /*use_arena=*/value[kUseArenaKey].As<bool>(false),
+      /*use_callback_api=*/value[kUseCallbackApiKey].As<bool>(false),
   };
 }
 
@@ -49,7 +49,7 @@ void ReportCustomError(
 }
 
 void SetupSpan(std::optional<tracing::InPlaceSpan>& span_holder,
-               grpc::ServerContext& context, std::string_view call_name) {
+               grpc::ServerContextBase& context, std::string_view call_name) {
   auto span_name = utils::StrCat("grpc/", call_name);
   const auto& client_metadata = context.client_metadata();
 
@@ -28,12 +28,9 @@ void Middleware::Handle(MiddlewareCallContext& context) const {
     if (baggage_header) {
       LOG_DEBUG() << "Got baggage header: " << *baggage_header;
 
-      auto baggage = USERVER_NAMESPACE::baggage::TryMakeBaggage(
+      USERVER_NAMESPACE::baggage::TrySetInheritedBaggage(
           ugrpc::impl::ToString(*baggage_header),
           baggage_settings.allowed_keys);
-      if (baggage) {
-        USERVER_NAMESPACE::baggage::kInheritedBaggage.Set(std::move(*baggage));
-      }
     }
   }
 
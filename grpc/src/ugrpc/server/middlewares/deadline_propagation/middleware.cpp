@@ -28,7 +28,8 @@ std::optional<engine::Deadline> TryExtractDeadline(
   return engine::Deadline::FromDuration(duration);
 }
 
-bool CheckAndSetupDeadline(tracing::Span& span, grpc::ServerContext& context,
+bool CheckAndSetupDeadline(tracing::Span& span,
+                           grpc::ServerContextBase& context,
                            std::string_view service_name,
                            std::string_view method_name,
                            ugrpc::impl::RpcStatisticsScope& statistics_scope,
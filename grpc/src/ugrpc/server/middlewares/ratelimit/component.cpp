@@ -0,0 +1,59 @@
+#include <userver/ugrpc/server/middlewares/ratelimit/component.hpp>
+
+#include <ugrpc/server/middlewares/ratelimit/middleware.hpp>
+#include <userver/components/component_config.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server::middlewares::ratelimit {
+
+namespace {
+
+Middleware::Settings ParseSettings(const components::ComponentConfig& config) {
+  Middleware::Settings settings;
+  settings.metadata_key =
+      config["metadata-key"].As<std::optional<std::string>>();
+  settings.requests_per_second =
+      config["requests-per-second"].As<std::size_t>();
+  settings.burst =
+      config["burst"].As<std::size_t>(settings.requests_per_second);
+  return settings;
+}
+
+}  // namespace
+
+Component::Component(const components::ComponentConfig& config,
+                     const components::ComponentContext& context)
+    : MiddlewareComponentBase(config, context),
+      middleware_(std::make_shared<Middleware>(ParseSettings(config))) {}
+
+std::shared_ptr<MiddlewareBase> Component::GetMiddleware() {
+  return middleware_;
+}
+
+yaml_config::Schema Component::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<MiddlewareComponentBase>(R"(
+type: object
+description: gRPC service per-client ratelimit middleware component
+additionalProperties: false
+properties:
+    metadata-key:
+        type: string
+        description: client metadata key identifying the client, the calls without it share a single limit
+        defaultDescription: <peer address>
+    requests-per-second:
+        type: integer
+        description: calls per second of each client
+        minimum: 1
+    burst:
+        type: integer
+        description: calls a client may make at once after being idle
+        defaultDescription: requests-per-second
+        minimum: 1
+)");
+}
+
+}  // namespace ugrpc::server::middlewares::ratelimit
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,59 @@
+#include "middleware.hpp"
+
+#include <string_view>
+
+#include <userver/logging/log.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server::middlewares::ratelimit {
+
+namespace {
+
+// The port differs for each connection of a client
+std::string_view StripPort(std::string_view peer) {
+  if (peer.substr(0, 5) != "ipv4:" && peer.substr(0, 5) != "ipv6:") {
+    return peer;
+  }
+  const auto port_pos = peer.rfind(':');
+  return port_pos > 4 ? peer.substr(0, port_pos) : peer;
+}
+
+}  // namespace
+
+Middleware::Middleware(const Settings& settings)
+    : metadata_key_(settings.metadata_key),
+      limiter_({static_cast<double>(settings.requests_per_second),
+                settings.burst}) {}
+
+void Middleware::Handle(MiddlewareCallContext& context) const {
+  auto& call = context.GetCall();
+  auto& server_context = call.GetContext();
+
+  std::string peer;
+  std::string_view client;
+  if (metadata_key_) {
+    const auto& metadata = server_context.client_metadata();
+    const auto it = metadata.find(*metadata_key_);
+    if (it != metadata.end()) {
+      client = std::string_view{it->second.data(), it->second.size()};
+    }
+  } else {
+    peer = server_context.peer();
+    client = StripPort(peer);
+  }
+
+  if (!limiter_.Obtain(client)) {
+    LOG_LIMITED_WARNING() << "Request throttled (per-client ratelimit), "
+                          << "service/method=" << call.GetCallName();
+    call.FinishWithError(grpc::Status{grpc::StatusCode::RESOURCE_EXHAUSTED,
+                                      "Client rate limit exceeded"});
+    return;
+  }
+
+  context.Next();
+}
+
+}  // namespace ugrpc::server::middlewares::ratelimit
+
+USERVER_NAMESPACE_END
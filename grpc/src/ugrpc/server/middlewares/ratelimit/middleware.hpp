@@ -0,0 +1,32 @@
+#pragma once
+
+#include <optional>
+#include <string>
+
+#include <userver/ugrpc/server/middlewares/base.hpp>
+#include <userver/utils/keyed_rate_limiter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace ugrpc::server::middlewares::ratelimit {
+
+class Middleware final : public MiddlewareBase {
+ public:
+  struct Settings {
+    std::optional<std::string> metadata_key;
+    std::size_t requests_per_second{};
+    std::size_t burst{};
+  };
+
+  explicit Middleware(const Settings& settings);
+
+  void Handle(MiddlewareCallContext& context) const override;
+
+ private:
+  const std::optional<std::string> metadata_key_;
+  mutable utils::KeyedRateLimiter limiter_;
+};
+
+}  // namespace ugrpc::server::middlewares::ratelimit
+
+USERVER_NAMESPACE_END
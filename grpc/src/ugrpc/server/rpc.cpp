@@ -1,5 +1,7 @@
 #include <userver/ugrpc/server/rpc.hpp>
 
+#include <iterator>
+
 #include <fmt/chrono.h>
 #include <fmt/compile.h>
 #include <fmt/format.h>
@@ -20,15 +22,16 @@ namespace ugrpc::server {
 
 namespace {
 
-std::string EscapeForAccessTskvLog(std::string_view str) {
-  if (str.empty()) return "-";
-
-  std::string encoded_str;
-  EncodeTskv(encoded_str, str, utils::encoding::EncodeTskvMode::kValue);
-  return encoded_str;
+void WriteEscapedForAccessTskvLog(fmt::memory_buffer& buffer,
+                                  std::string_view str) {
+  if (str.empty()) {
+    buffer.push_back('-');
+    return;
+  }
+  EncodeTskv(buffer, str, utils::encoding::EncodeTskvMode::kValue);
 }
 
-std::string ParseIp(std::string_view sv) {
+std::string_view ParseIp(std::string_view sv) {
   static constexpr std::string_view kIpv6 = "ipv6:";
   static constexpr std::string_view kIpv4 = "ipv4:";
   if (utils::text::StartsWith(sv, kIpv6)) sv = sv.substr(kIpv6.size());
@@ -40,7 +43,7 @@ std::string ParseIp(std::string_view sv) {
     sv = sv.substr(pos1 + 3, pos2 - pos1 - 3);
   }
 
-  return EscapeForAccessTskvLog(sv);
+  return sv;
 }
 
 using SecondsTimePoint =
@@ -87,29 +90,42 @@ std::string FormatLogMessage(
     user_agent = std::string_view(ref.data(), ref.size());
   }
 
-  auto ip = ParseIp(peer);
+  const auto ip = ParseIp(peer);
 
   auto now = std::chrono::system_clock::now();
   auto response_time =
       std::chrono::duration_cast<std::chrono::microseconds>(now - start_time)
           .count();
 
+  // The escaped values are written straight into the buffer, so the message
+  // is built without temporary strings
+  fmt::memory_buffer buffer;
   // FMT_COMPILE makes it slower
-  return fmt::format(
-      "tskv"
-      "\ttimestamp={}"
-      "\ttimezone={}"
-      "\tuser_agent={}"
-      "\tip={}"
-      "\tx_real_ip={}"
-      "\trequest={}"
-      "\tupstream_response_time_ms={}.{:0>3}"
-      "\tgrpc_status={}"
-      "\tgrpc_status_code={}\n",
-      GetCurrentTimeString(start_time), timezone,
-      EscapeForAccessTskvLog(user_agent), ip, ip,
-      EscapeForAccessTskvLog(call_name), response_time / 1000,
-      response_time % 1000, static_cast<int>(code), ToString(code));
+  fmt::format_to(std::back_inserter(buffer),
+                 "tskv"
+                 "\ttimestamp={}"
+                 "\ttimezone={}"
+                 "\tuser_agent=",
+                 GetCurrentTimeString(start_time), timezone);
+  WriteEscapedForAccessTskvLog(buffer, user_agent);
+
+  const auto append = [&buffer](std::string_view str) {
+    buffer.append(str.data(), str.data() + str.size());
+  };
+  append("\tip=");
+  WriteEscapedForAccessTskvLog(buffer, ip);
+  append("\tx_real_ip=");
+  WriteEscapedForAccessTskvLog(buffer, ip);
+  append("\trequest=");
+  WriteEscapedForAccessTskvLog(buffer, call_name);
+
+  fmt::format_to(std::back_inserter(buffer),
+                 "\tupstream_response_time_ms={}.{:0>3}"
+                 "\tgrpc_status={}"
+                 "\tgrpc_status_code={}\n",
+                 response_time / 1000, response_time % 1000,
+                 static_cast<int>(code), ToString(code));
+  return fmt::to_string(buffer);
 }
 
 }  // namespace impl
@@ -172,6 +172,8 @@ void Server::Impl::AddService(ServiceBase& service, ServiceConfig&& config) {
       std::move(config.middlewares),
       access_tskv_logger_,
       config_source_,
+      config.use_arena,
+      config.use_callback_api,
   }));
 }
 
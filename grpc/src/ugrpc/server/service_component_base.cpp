@@ -42,6 +42,18 @@ properties:
         items:
             type: string
             description: middleware component name
+    use-arena:
+        type: boolean
+        description: |
+            create the requests on a per-call protobuf arena, which pays off
+            for messages with many nested sub-messages
+        defaultDescription: false
+    use-callback-api:
+        type: boolean
+        description: |
+            serve the unary methods with the gRPC callback API, without the
+            completion queue threads
+        defaultDescription: false
 )");
 }
 
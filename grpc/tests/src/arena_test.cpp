@@ -0,0 +1,99 @@
+#include <userver/utest/utest.hpp>
+
+#include <google/protobuf/arena.h>
+
+#include <userver/engine/task/task.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+#include <userver/ugrpc/tests/service.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr int kNumber = 42;
+
+class ArenaService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    EXPECT_NE(call.GetArena(), nullptr);
+    EXPECT_EQ(request.GetArena(), call.GetArena());
+
+    auto* response =
+        google::protobuf::Arena::CreateMessage<sample::ugrpc::GreetingResponse>(
+            call.GetArena());
+    response->set_name("Hello " + request.name());
+    call.Finish(*response);
+  }
+
+  void ReadMany(ReadManyCall& call,
+                sample::ugrpc::StreamGreetingRequest&& request) override {
+    EXPECT_NE(call.GetArena(), nullptr);
+    EXPECT_EQ(request.GetArena(), call.GetArena());
+
+    sample::ugrpc::StreamGreetingResponse response;
+    response.set_name("Hello again " + request.name());
+    for (int i = 0; i < request.number(); ++i) {
+      response.set_number(i);
+      call.Write(response);
+    }
+    call.Finish();
+  }
+};
+
+// The parameter is `use_callback_api`
+// NOLINTNEXTLINE(fuchsia-multiple-inheritance)
+class GrpcArena : public ::testing::TestWithParam<bool>,
+                  protected ugrpc::tests::ServiceBase {
+ protected:
+  GrpcArena() {
+    RegisterService(service_, ugrpc::server::ServiceConfig{
+                                  engine::current_task::GetTaskProcessor(),
+                                  {},
+                                  /*use_arena=*/true,
+                                  /*use_callback_api=*/GetParam(),
+                              });
+    StartServer();
+  }
+
+  ~GrpcArena() override { StopServer(); }
+
+ private:
+  ArenaService service_;
+};
+
+}  // namespace
+
+UTEST_P(GrpcArena, UnaryRPC) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::GreetingRequest out;
+  out.set_name("userver");
+
+  for (int i = 0; i < kNumber; ++i) {
+    sample::ugrpc::GreetingResponse in;
+    UEXPECT_NO_THROW(in = client.SayHello(out).Finish());
+    EXPECT_EQ(in.name(), "Hello userver");
+  }
+}
+
+UTEST_P(GrpcArena, StreamingRPC) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::StreamGreetingRequest out;
+  out.set_name("userver");
+  out.set_number(kNumber);
+  auto is = client.ReadMany(out);
+
+  sample::ugrpc::StreamGreetingResponse in;
+  for (int i = 0; i < kNumber; ++i) {
+    ASSERT_TRUE(is.Read(in));
+    EXPECT_EQ(in.number(), i);
+    EXPECT_EQ(in.name(), "Hello again userver");
+  }
+  EXPECT_FALSE(is.Read(in));
+}
+
+INSTANTIATE_UTEST_SUITE_P(Basic, GrpcArena, ::testing::Bool());
+
+USERVER_NAMESPACE_END
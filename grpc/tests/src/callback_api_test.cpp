@@ -0,0 +1,139 @@
+#include <userver/utest/utest.hpp>
+
+#include <stdexcept>
+
+#include <grpcpp/server_context.h>
+
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/ugrpc/client/exceptions.hpp>
+#include <userver/utils/algo.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+#include <userver/ugrpc/tests/service_fixtures.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr int kNumber = 42;
+
+class CallbackApiService final : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call,
+                sample::ugrpc::GreetingRequest&& request) override {
+    auto& context = call.GetContext();
+    EXPECT_NE(dynamic_cast<grpc::CallbackServerContext*>(&context), nullptr);
+    EXPECT_FALSE(engine::current_task::ShouldCancel());
+
+    if (request.name() == "error") {
+      call.FinishWithError({grpc::StatusCode::INVALID_ARGUMENT, "message"});
+      return;
+    }
+    if (request.name() == "exception") {
+      throw std::runtime_error("exception in SayHello");
+    }
+
+    EXPECT_EQ(utils::FindOptional(context.client_metadata(), "req_header"),
+              "value");
+    context.AddTrailingMetadata("resp_header", "value");
+
+    sample::ugrpc::GreetingResponse response;
+    response.set_name("Hello " + request.name());
+    call.Finish(response);
+  }
+
+  void ReadMany(ReadManyCall& call,
+                sample::ugrpc::StreamGreetingRequest&& request) override {
+    // The streaming methods are still served from the completion queues
+    EXPECT_NE(dynamic_cast<grpc::ServerContext*>(&call.GetContext()), nullptr);
+
+    sample::ugrpc::StreamGreetingResponse response;
+    response.set_name("Hello again " + request.name());
+    for (int i = 0; i < request.number(); ++i) {
+      response.set_number(i);
+      call.Write(response);
+    }
+    call.Finish();
+  }
+};
+
+class GrpcCallbackApi : public ugrpc::tests::ServiceFixtureBase {
+ protected:
+  GrpcCallbackApi() {
+    RegisterService(service_, ugrpc::server::ServiceConfig{
+                                  engine::current_task::GetTaskProcessor(),
+                                  {},
+                                  /*use_arena=*/false,
+                                  /*use_callback_api=*/true,
+                              });
+    StartServer();
+  }
+
+  ~GrpcCallbackApi() override { StopServer(); }
+
+ private:
+  CallbackApiService service_;
+};
+
+}  // namespace
+
+UTEST_F(GrpcCallbackApi, UnaryRPC) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+
+  for (int i = 0; i < kNumber; ++i) {
+    auto context = std::make_unique<grpc::ClientContext>();
+    context->AddMetadata("req_header", "value");
+    sample::ugrpc::GreetingRequest out;
+    out.set_name("userver");
+    auto call = client.SayHello(out, std::move(context));
+
+    sample::ugrpc::GreetingResponse in;
+    UEXPECT_NO_THROW(in = call.Finish());
+    EXPECT_EQ(in.name(), "Hello userver");
+    EXPECT_EQ(utils::FindOptional(call.GetContext().GetServerTrailingMetadata(),
+                                  "resp_header"),
+              "value");
+  }
+}
+
+UTEST_F(GrpcCallbackApi, UnaryRPCError) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::GreetingRequest out;
+  out.set_name("error");
+  UEXPECT_THROW(client.SayHello(out).Finish(),
+                ugrpc::client::InvalidArgumentError);
+}
+
+UTEST_F(GrpcCallbackApi, UnaryRPCException) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::GreetingRequest out;
+  out.set_name("exception");
+  UEXPECT_THROW(client.SayHello(out).Finish(), ugrpc::client::UnknownError);
+
+  // The service keeps working
+  out.set_name("userver");
+  auto context = std::make_unique<grpc::ClientContext>();
+  context->AddMetadata("req_header", "value");
+  sample::ugrpc::GreetingResponse in;
+  UEXPECT_NO_THROW(in = client.SayHello(out, std::move(context)).Finish());
+  EXPECT_EQ(in.name(), "Hello userver");
+}
+
+UTEST_F(GrpcCallbackApi, StreamingRPC) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::StreamGreetingRequest out;
+  out.set_name("userver");
+  out.set_number(kNumber);
+  auto is = client.ReadMany(out);
+
+  sample::ugrpc::StreamGreetingResponse in;
+  for (int i = 0; i < kNumber; ++i) {
+    ASSERT_TRUE(is.Read(in));
+    EXPECT_EQ(in.number(), i);
+  }
+  EXPECT_FALSE(is.Read(in));
+}
+
+USERVER_NAMESPACE_END
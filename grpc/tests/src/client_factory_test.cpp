@@ -1,5 +1,7 @@
 #include <userver/ugrpc/client/client_factory.hpp>
 
+#include <vector>
+
 #include <userver/engine/task/task.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/yaml/value.hpp>
@@ -46,4 +48,47 @@ UTEST(GrpcClient, ChannelsCount) {
   ASSERT_EQ(kChannelsCount, data.GetChannelToken().GetChannelCount());
 }
 
+UTEST(GrpcClient, AcquiresLeastLoadedChannel) {
+  constexpr int kChannelsCount = 4;
+  formats::yaml::ValueBuilder builder(formats::common::Type::kObject);
+  builder["channel-count"] = kChannelsCount;
+
+  const auto yaml_data = builder.ExtractValue();
+  yaml_config::YamlConfig yaml_config(yaml_data, formats::yaml::Value());
+
+  auto config = yaml_config.As<ugrpc::client::ClientFactoryConfig>();
+  ugrpc::client::QueueHolder client_queue;
+  utils::statistics::Storage statistics_storage;
+  dynamic_config::StorageMock config_storage;
+
+  testsuite::GrpcControl ts({}, false);
+  ugrpc::client::MiddlewareFactories mws;
+  ugrpc::client::ClientFactory client_factory(
+      std::move(config), engine::current_task::GetTaskProcessor(), mws,
+      client_queue.GetQueue(), statistics_storage, ts,
+      config_storage.GetSource());
+
+  auto client = client_factory.MakeClient<sample::ugrpc::UnitTestServiceClient>(
+      "test", "[::]:50051");
+  auto& token = ugrpc::client::impl::GetClientData(client).GetChannelToken();
+
+  std::vector<ugrpc::client::impl::ChannelCache::ChannelLoad> loads;
+  for (int i = 0; i < kChannelsCount * 2; ++i) {
+    loads.push_back(token.AcquireChannel());
+  }
+  for (int i = 0; i < kChannelsCount; ++i) {
+    EXPECT_EQ(token.GetInFlightCount(i), 2);
+  }
+
+  loads.front().Release();
+  const auto index = loads.front().GetChannelIndex();
+  EXPECT_EQ(token.GetInFlightCount(index), 1);
+  EXPECT_EQ(token.AcquireChannel().GetChannelIndex(), index);
+
+  loads.clear();
+  for (int i = 0; i < kChannelsCount; ++i) {
+    EXPECT_EQ(token.GetInFlightCount(i), 0);
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,155 @@
+#include <userver/ugrpc/server/rpc.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fmt/chrono.h>
+#include <fmt/format.h>
+
+#include <userver/ugrpc/status_codes.hpp>
+#include <userver/utils/datetime.hpp>
+#include <userver/utils/encoding/tskv.hpp>
+#include <userver/utils/text.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// The access log line as it was built before FormatLogMessage started to
+// write the escaped values straight into a single buffer
+
+std::string EscapeForAccessTskvLog(std::string_view str) {
+  if (str.empty()) return "-";
+
+  std::string encoded_str;
+  EncodeTskv(encoded_str, str, utils::encoding::EncodeTskvMode::kValue);
+  return encoded_str;
+}
+
+std::string ParseIp(std::string_view sv) {
+  static constexpr std::string_view kIpv6 = "ipv6:";
+  static constexpr std::string_view kIpv4 = "ipv4:";
+  if (utils::text::StartsWith(sv, kIpv6)) sv = sv.substr(kIpv6.size());
+  if (utils::text::StartsWith(sv, kIpv4)) sv = sv.substr(kIpv4.size());
+
+  auto pos1 = sv.find("%5B");
+  auto pos2 = sv.find("%5D");
+  if (pos1 != std::string::npos && pos2 != std::string::npos) {
+    sv = sv.substr(pos1 + 3, pos2 - pos1 - 3);
+  }
+
+  return EscapeForAccessTskvLog(sv);
+}
+
+std::string ReferenceFormatLogMessage(
+    const std::multimap<grpc::string_ref, grpc::string_ref>& metadata,
+    std::string_view peer, std::chrono::system_clock::time_point start_time,
+    std::string_view call_name, grpc::StatusCode code) {
+  const auto timezone =
+      utils::datetime::LocalTimezoneTimestring(start_time, "%z");
+
+  auto it = metadata.find("user-agent");
+  std::string_view user_agent;
+  if (it != metadata.end()) {
+    auto ref = it->second;
+    user_agent = std::string_view(ref.data(), ref.size());
+  }
+
+  auto ip = ParseIp(peer);
+
+  return fmt::format(
+      "tskv"
+      "\ttimestamp={:%FT%T}"
+      "\ttimezone={}"
+      "\tuser_agent={}"
+      "\tip={}"
+      "\tx_real_ip={}"
+      "\trequest={}"
+      "\tupstream_response_time_ms=-"
+      "\tgrpc_status={}"
+      "\tgrpc_status_code={}\n",
+      fmt::localtime(std::chrono::system_clock::to_time_t(start_time)),
+      timezone, EscapeForAccessTskvLog(user_agent), ip, ip,
+      EscapeForAccessTskvLog(call_name), static_cast<int>(code),
+      ugrpc::ToString(code));
+}
+
+// The response time depends on the current time, so it is not compared
+std::string MaskResponseTime(std::string str) {
+  static constexpr std::string_view kKey = "\tupstream_response_time_ms=";
+  const auto begin = str.find(kKey);
+  EXPECT_NE(begin, std::string::npos) << str;
+  if (begin == std::string::npos) return str;
+
+  const auto value_begin = begin + kKey.size();
+  const auto value_end = str.find('\t', value_begin);
+  EXPECT_NE(value_end, std::string::npos) << str;
+  if (value_end == std::string::npos) return str;
+
+  str.replace(value_begin, value_end - value_begin, "-");
+  return str;
+}
+
+struct LogMessageParams final {
+  std::multimap<grpc::string_ref, grpc::string_ref> metadata;
+  std::string_view peer;
+  std::string_view call_name;
+  grpc::StatusCode code{grpc::StatusCode::OK};
+};
+
+void ExpectSameAsReference(const LogMessageParams& params) {
+  const std::chrono::system_clock::time_point start_time{
+      std::chrono::seconds{1024 * 1024 * 42}};
+
+  const auto result = ugrpc::server::impl::FormatLogMessage(
+      params.metadata, params.peer, start_time, params.call_name,
+      params.code);
+  EXPECT_EQ(MaskResponseTime(result),
+            ReferenceFormatLogMessage(params.metadata, params.peer,
+                                      start_time, params.call_name,
+                                      params.code));
+}
+
+}  // namespace
+
+TEST(FormatLogMessage, Ipv6) {
+  ExpectSameAsReference({{{"user-agent", "grpc-go/1.45.0"}},
+                         "ipv6:%5B2a02:aaaa:aaaa:aaaa::1:1f%5D:50051",
+                         "hello.HelloService/SayHello",
+                         grpc::StatusCode::OK});
+}
+
+TEST(FormatLogMessage, Ipv4) {
+  ExpectSameAsReference({{{"user-agent", "grpc-c++/1.50.0"}},
+                         "ipv4:127.0.0.1:50051",
+                         "hello.HelloService/SayHello",
+                         grpc::StatusCode::NOT_FOUND});
+}
+
+TEST(FormatLogMessage, RawPeer) {
+  ExpectSameAsReference({{{"user-agent", "grpc-go/1.45.0"}},
+                         "2a02:aaaa:aaaa:aaaa::1:1f",
+                         "hello.HelloService/SayHello",
+                         grpc::StatusCode::UNAVAILABLE});
+}
+
+TEST(FormatLogMessage, EmptyValues) {
+  ExpectSameAsReference({{}, "", "", grpc::StatusCode::INTERNAL});
+}
+
+TEST(FormatLogMessage, EscapedValues) {
+  ExpectSameAsReference({{{"user-agent", "agent\twith\nspecial\\chars\r"}},
+                         "ipv4:1.2.3.4\t:1",
+                         "hello.Hello\tService/Say\nHello",
+                         grpc::StatusCode::DEADLINE_EXCEEDED});
+}
+
+TEST(FormatLogMessage, FirstUserAgent) {
+  ExpectSameAsReference({{{"user-agent", "first"},
+                          {"user-agent", "second"},
+                          {"x-other", "value"}},
+                         "ipv4:127.0.0.1:1",
+                         "hello.HelloService/SayHello",
+                         grpc::StatusCode::OK});
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,134 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <chrono>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/ugrpc/client/exceptions.hpp>
+#include <userver/ugrpc/client/hedging.hpp>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+#include <userver/ugrpc/tests/service_fixtures.hpp>
+
+using namespace std::chrono_literals;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// The first attempt is slow, the rest are fast
+class UnitTestServiceSlowFirst final
+    : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call, sample::ugrpc::GreetingRequest&&) override {
+    sample::ugrpc::GreetingResponse response;
+    if (attempts_++ == 0) {
+      engine::InterruptibleSleepFor(200ms);
+      response.set_name("slow");
+    } else {
+      response.set_name("fast");
+    }
+    call.Finish(response);
+  }
+
+ private:
+  std::atomic<int> attempts_{0};
+};
+
+// The first attempt fails with UNAVAILABLE, the rest succeed
+class UnitTestServiceUnavailableFirst final
+    : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call, sample::ugrpc::GreetingRequest&&) override {
+    if (attempts_++ == 0) {
+      call.FinishWithError({grpc::StatusCode::UNAVAILABLE, "unavailable"});
+      return;
+    }
+    sample::ugrpc::GreetingResponse response;
+    response.set_name("available");
+    call.Finish(response);
+  }
+
+ private:
+  std::atomic<int> attempts_{0};
+};
+
+class UnitTestServiceUnavailable final
+    : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void SayHello(SayHelloCall& call, sample::ugrpc::GreetingRequest&&) override {
+    call.FinishWithError({grpc::StatusCode::UNAVAILABLE, "unavailable"});
+  }
+};
+
+}  // namespace
+
+using GrpcHedgingSlowFirst =
+    ugrpc::tests::ServiceFixture<UnitTestServiceSlowFirst>;
+
+UTEST_F(GrpcHedgingSlowFirst, HedgedAttemptWins) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  ugrpc::client::HedgingSettings settings;
+  settings.hedging_delay = 10ms;
+  ugrpc::client::HedgingPolicy policy{settings};
+
+  sample::ugrpc::GreetingRequest request;
+  request.set_name("userver");
+  const auto response =
+      policy.Perform([&] { return client.SayHello(request); });
+  EXPECT_EQ(response.name(), "fast");
+
+  const auto statistics = policy.GetStatistics();
+  ASSERT_EQ(statistics.size(), 1);
+  const auto& stats = statistics.begin()->second;
+  EXPECT_EQ(stats.calls, 1);
+  EXPECT_EQ(stats.hedged_attempts, 1);
+  EXPECT_EQ(stats.hedge_wins, 1);
+  EXPECT_EQ(stats.retries, 0);
+}
+
+using GrpcHedgingUnavailableFirst =
+    ugrpc::tests::ServiceFixture<UnitTestServiceUnavailableFirst>;
+
+UTEST_F(GrpcHedgingUnavailableFirst, RetriesUnavailable) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  ugrpc::client::HedgingPolicy policy{{}};
+
+  sample::ugrpc::GreetingRequest request;
+  request.set_name("userver");
+  const auto response =
+      policy.Perform([&] { return client.SayHello(request); });
+  EXPECT_EQ(response.name(), "available");
+
+  const auto statistics = policy.GetStatistics();
+  ASSERT_EQ(statistics.size(), 1);
+  const auto& stats = statistics.begin()->second;
+  EXPECT_EQ(stats.retries, 1);
+  EXPECT_EQ(stats.hedged_attempts, 0);
+}
+
+using GrpcHedgingUnavailable =
+    ugrpc::tests::ServiceFixture<UnitTestServiceUnavailable>;
+
+UTEST_F(GrpcHedgingUnavailable, RetryBudgetExhausted) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  ugrpc::client::HedgingSettings settings;
+  settings.max_attempts = 3;
+  // A single failure leaves no more than a half of the tokens
+  settings.retry_budget.max_tokens = 2;
+  ugrpc::client::HedgingPolicy policy{settings};
+
+  sample::ugrpc::GreetingRequest request;
+  request.set_name("userver");
+  UEXPECT_THROW(policy.Perform([&] { return client.SayHello(request); }),
+                ugrpc::client::UnavailableError);
+
+  const auto statistics = policy.GetStatistics();
+  ASSERT_EQ(statistics.size(), 1);
+  const auto& stats = statistics.begin()->second;
+  EXPECT_EQ(stats.retries, 0);
+  EXPECT_EQ(stats.budget_exhausted, 1);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,99 @@
+#include <userver/utest/utest.hpp>
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <opentelemetry/proto/collector/trace/v1/trace_service_client.usrv.pb.hpp>
+#include <opentelemetry/proto/collector/trace/v1/trace_service_service.usrv.pb.hpp>
+
+#include <userver/logging/log.hpp>
+#include <userver/logging/null_logger.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/tracing/tracer.hpp>
+#include <userver/ugrpc/tests/service_fixtures.hpp>
+#include <userver/utils/text_light.hpp>
+
+#include <ugrpc/client/otlp_trace_exporter.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace otlp_collector = opentelemetry::proto::collector::trace::v1;
+
+class CollectorMock final : public otlp_collector::TraceServiceBase {
+ public:
+  void Export(ExportCall& call,
+              otlp_collector::ExportTraceServiceRequest&& request) override {
+    {
+      const std::lock_guard lock{mutex_};
+      for (const auto& resource_spans : request.resource_spans()) {
+        for (const auto& attribute : resource_spans.resource().attributes()) {
+          if (attribute.key() == "service.name") {
+            service_name_ = attribute.value().string_value();
+          }
+        }
+        for (const auto& scope_spans : resource_spans.scope_spans()) {
+          for (const auto& span : scope_spans.spans()) {
+            // Server spans of the Export calls are exported too, skip them
+            if (!utils::text::StartsWith(span.name(), "test_span_")) continue;
+            names_.push_back(span.name());
+            EXPECT_EQ(span.trace_id().size(), 16);
+            EXPECT_EQ(span.span_id().size(), 8);
+          }
+        }
+      }
+    }
+    call.Finish({});
+  }
+
+  std::vector<std::string> GetNames() const {
+    const std::lock_guard lock{mutex_};
+    return names_;
+  }
+
+  std::string GetServiceName() const {
+    const std::lock_guard lock{mutex_};
+    return service_name_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::vector<std::string> names_;
+  std::string service_name_;
+};
+
+using OtlpTraceExporter = ugrpc::tests::ServiceFixture<CollectorMock>;
+
+}  // namespace
+
+UTEST_F(OtlpTraceExporter, ExportsSpans) {
+  // Spans are only exported if they are logged
+  const logging::DefaultLoggerGuard logger_guard{logging::MakeNullLogger()};
+  const logging::DefaultLoggerLevelScope level_scope{logging::Level::kInfo};
+
+  ugrpc::client::impl::OtlpTraceExporterSettings settings;
+  settings.service_name = "test-service";
+  settings.max_batch_size = 2;
+  auto exporter = std::make_shared<ugrpc::client::impl::OtlpTraceExporter>(
+      MakeClient<otlp_collector::TraceServiceClient>(), std::move(settings));
+
+  tracing::Tracer::SetSpanExporter(exporter);
+  for (int i = 0; i < 3; ++i) {
+    tracing::Span span{fmt::format("test_span_{}", i)};
+    span.AddTag(tracing::kHttpStatusCode, 200);
+  }
+  tracing::Tracer::SetSpanExporter(nullptr);
+  exporter->Stop();
+
+  EXPECT_EQ(GetService().GetNames(),
+            (std::vector<std::string>{"test_span_0", "test_span_1",
+                                      "test_span_2"}));
+  EXPECT_EQ(GetService().GetServiceName(), "test-service");
+}
+
+USERVER_NAMESPACE_END
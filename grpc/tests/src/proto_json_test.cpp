@@ -0,0 +1,42 @@
+#include <userver/utest/utest.hpp>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/ugrpc/proto_json.hpp>
+
+#include <tests/messages.pb.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(ProtoJson, JsonStringToMessage) {
+  sample::ugrpc::StreamGreetingRequest message;
+  ugrpc::JsonStringToMessage(
+      R"({"name": "userver", "number": 42, "unknown": [1, 2]})", message);
+  EXPECT_EQ(message.name(), "userver");
+  EXPECT_EQ(message.number(), 42);
+
+  UEXPECT_THROW(ugrpc::JsonStringToMessage(R"({"name": )", message),
+                formats::json::ParseException);
+  UEXPECT_THROW(ugrpc::JsonStringToMessage(R"({"number": "abc"})", message),
+                formats::json::ParseException);
+}
+
+TEST(ProtoJson, WriteToStream) {
+  sample::ugrpc::StreamGreetingRequest message;
+  message.set_name("userver");
+  message.set_number(42);
+
+  formats::json::StringBuilder sb;
+  {
+    const formats::json::StringBuilder::ObjectGuard guard{sb};
+    sb.Key("message");
+    WriteToStream(message, sb);
+  }
+
+  const auto json = formats::json::FromString(sb.GetString());
+  EXPECT_EQ(json["message"]["name"].As<std::string>(), "userver");
+  EXPECT_EQ(json["message"]["number"].As<int>(), 42);
+}
+
+USERVER_NAMESPACE_END
@@ -64,6 +64,13 @@ UTEST_F(GrpcStatistics, LongRequest) {
     EXPECT_EQ(stats.SingleMetric("network-error").AsRate(), 0);
     EXPECT_EQ(stats.SingleMetric("abandoned-error").AsRate(), 0);
 
+    const auto timings = stats.SingleMetric("timings-histogram").AsHistogram();
+    std::uint64_t timings_count = timings.GetValueAtInf();
+    for (std::size_t i = 0; i < timings.GetBucketCount(); ++i) {
+      timings_count += timings.GetValueAt(i);
+    }
+    EXPECT_EQ(timings_count, 1);
+
     // check that legacy stats is still collected
     EXPECT_EQ(get_status_code_count_legacy("OK"), 0);
     EXPECT_EQ(get_status_code_count_legacy("INVALID_ARGUMENT"), 1);
@@ -53,7 +53,7 @@ class UnitTestServiceWithTracingChecks final
   }
 
  private:
-  static void SetMetadata(grpc::ServerContext& context) {
+  static void SetMetadata(grpc::ServerContextBase& context) {
     const auto& span = tracing::Span::CurrentSpan();
     const auto& client_meta = context.client_metadata();
 
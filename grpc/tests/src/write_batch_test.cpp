@@ -0,0 +1,103 @@
+#include <userver/utest/utest.hpp>
+
+#include <vector>
+
+#include <tests/unit_test_client.usrv.pb.hpp>
+#include <tests/unit_test_service.usrv.pb.hpp>
+#include <userver/ugrpc/tests/service_fixtures.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr int kNumber = 42;
+
+std::vector<sample::ugrpc::StreamGreetingRequest> MakeRequests() {
+  std::vector<sample::ugrpc::StreamGreetingRequest> requests(kNumber);
+  for (int i = 0; i < kNumber; ++i) {
+    requests[i].set_name("userver");
+    requests[i].set_number(i);
+  }
+  return requests;
+}
+
+class UnitTestServiceBatched final
+    : public sample::ugrpc::UnitTestServiceBase {
+ public:
+  void ReadMany(ReadManyCall& call,
+                sample::ugrpc::StreamGreetingRequest&& request) override {
+    std::vector<sample::ugrpc::StreamGreetingResponse> responses(
+        request.number());
+    for (int i = 0; i < request.number(); ++i) {
+      responses[i].set_number(i);
+    }
+    call.WriteBatch(responses);
+    call.Finish();
+  }
+
+  void WriteMany(WriteManyCall& call) override {
+    sample::ugrpc::StreamGreetingRequest request;
+    int count = 0;
+    while (call.Read(request)) {
+      EXPECT_EQ(request.number(), count);
+      ++count;
+    }
+    sample::ugrpc::StreamGreetingResponse response;
+    response.set_number(count);
+    call.Finish(response);
+  }
+
+  void Chat(ChatCall& call) override {
+    sample::ugrpc::StreamGreetingRequest request;
+    std::vector<sample::ugrpc::StreamGreetingResponse> responses;
+    while (call.Read(request)) {
+      responses.emplace_back().set_number(request.number());
+    }
+    call.WriteBatch(responses);
+    call.Finish();
+  }
+};
+
+}  // namespace
+
+using GrpcWriteBatch = ugrpc::tests::ServiceFixture<UnitTestServiceBatched>;
+
+UTEST_F(GrpcWriteBatch, ServerOutputStream) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  sample::ugrpc::StreamGreetingRequest out;
+  out.set_number(kNumber);
+  auto is = client.ReadMany(out);
+
+  sample::ugrpc::StreamGreetingResponse in;
+  for (int i = 0; i < kNumber; ++i) {
+    ASSERT_TRUE(is.Read(in));
+    EXPECT_EQ(in.number(), i);
+  }
+  EXPECT_FALSE(is.Read(in));
+}
+
+UTEST_F(GrpcWriteBatch, ClientOutputStream) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  auto os = client.WriteMany();
+  EXPECT_TRUE(os.WriteBatch(MakeRequests()));
+  EXPECT_TRUE(os.WriteBatch({}));
+
+  const auto in = os.Finish();
+  EXPECT_EQ(in.number(), kNumber);
+}
+
+UTEST_F(GrpcWriteBatch, BidirectionalStream) {
+  auto client = MakeClient<sample::ugrpc::UnitTestServiceClient>();
+  auto bs = client.Chat();
+  EXPECT_TRUE(bs.WriteBatch(MakeRequests()));
+  EXPECT_TRUE(bs.WritesDone());
+
+  sample::ugrpc::StreamGreetingResponse in;
+  for (int i = 0; i < kNumber; ++i) {
+    ASSERT_TRUE(bs.Read(in));
+    EXPECT_EQ(in.number(), i);
+  }
+  EXPECT_FALSE(bs.Read(in));
+}
+
+USERVER_NAMESPACE_END
@@ -31,6 +31,11 @@ class ServiceBase {
 
   void RegisterService(server::ServiceBase& service);
 
+  /// @overload Uses the task processor and the options of `config`, the
+  /// fixture middlewares are run before `config.middlewares`
+  void RegisterService(server::ServiceBase& service,
+                       server::ServiceConfig&& config);
+
   /// Must be called after the services are registered
   void StartServer(client::ClientFactoryConfig&& config = {});
 
@@ -47,11 +47,19 @@ ServiceBase::ServiceBase(dynamic_config::StorageMock&& dynconf,
 ServiceBase::~ServiceBase() = default;
 
 void ServiceBase::RegisterService(server::ServiceBase& service) {
+  RegisterService(service, server::ServiceConfig{
+                               engine::current_task::GetTaskProcessor(),
+                               {},
+                           });
+}
+
+void ServiceBase::RegisterService(server::ServiceBase& service,
+                                  server::ServiceConfig&& config) {
   adding_middlewares_allowed_ = false;
-  server_.AddService(service, server::ServiceConfig{
-                                  engine::current_task::GetTaskProcessor(),
-                                  server_middlewares_,
-                              });
+  config.middlewares.insert(config.middlewares.begin(),
+                            server_middlewares_.begin(),
+                            server_middlewares_.end());
+  server_.AddService(service, std::move(config));
 }
 
 void ServiceBase::StartServer(
@@ -3,7 +3,13 @@
 /// @file userver/cache/base_mongo_cache.hpp
 /// @brief @copybrief components::MongoCache
 
+#include <algorithm>
 #include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -11,14 +17,22 @@
 #include <userver/cache/caching_component_base.hpp>
 #include <userver/cache/mongo_cache_type_traits.hpp>
 #include <userver/components/component_context.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/dump/common.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/formats/bson/binary.hpp>
 #include <userver/formats/bson/document.hpp>
 #include <userver/formats/bson/inline.hpp>
 #include <userver/formats/bson/value_builder.hpp>
+#include <userver/storages/mongo/change_stream.hpp>
 #include <userver/storages/mongo/collection.hpp>
+#include <userver/storages/mongo/exception.hpp>
 #include <userver/storages/mongo/operations.hpp>
 #include <userver/storages/mongo/options.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/cpu_relax.hpp>
+#include <userver/utils/meta.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -34,7 +48,12 @@ namespace impl {
 
 std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 
-}
+// How long the server waits for the new events of a change stream
+inline constexpr std::chrono::milliseconds kChangeStreamMaxAwaitTime{50};
+// Limits the time of reading a change stream by a single update
+inline constexpr std::chrono::seconds kChangeStreamReadTime{1};
+
+}  // namespace impl
 
 // clang-format off
 
@@ -111,10 +130,36 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 ///   // Whether update part of the cache even if failed to parse some documents
 ///   static constexpr bool kAreInvalidDocumentsSkipped = false;
 ///
+///   // Whether incremental updates tail a change stream instead of
+///   // polling (optional, false by default)
+///   static constexpr bool kUseChangeStream = false;
+///   // Optional function that gets the key of a deleted document from its
+///   // _id for the change stream updates
+///   static KeyType GetKeyFromId(const formats::bson::Value& id) {
+///     return id.As<std::string>();
+///   }
+///   // (default implementation calls id.As<KeyType>())
+///
 ///   // Component to get the collections
 ///   using MongoCollectionsComponent = components::MongoCollections;
 /// };
 /// ```
+///
+/// ## Change stream updates
+/// With `kUseChangeStream` the cache opens a change stream of the collection
+/// before each full update, and the incremental updates apply the changes
+/// from the stream instead of querying `kMongoUpdateFieldName`. Change
+/// streams require a replica set or a sharded cluster, and the stream holds
+/// a connection of the pool.
+///
+/// The documents are taken from the events with the full document lookup,
+/// the deleted documents are erased by the key from GetKeyFromId. The
+/// stream is resumed from the token stored in the cache dump, if any. When
+/// the stream is invalidated or fails, e.g. the token has expired from the
+/// oplog, the cache falls back to a full update.
+///
+/// The resume token is appended to the dumped data, so the dump
+/// `format-version` should be bumped when the mode is switched.
 
 // clang-format on
 
@@ -134,14 +179,52 @@ class MongoCache
   static yaml_config::Schema GetStaticConfigSchema();
 
  private:
+  using DataType = typename MongoCacheTraits::DataType;
+  using KeyType = meta::MapKeyType<DataType>;
+  using ObjectType = typename MongoCacheTraits::ObjectType;
+
+  static constexpr bool kUseChangeStream =
+      mongo_cache::impl::UseChangeStream<MongoCacheTraits>();
+
+  struct ResumeToken {
+    std::weak_ptr<const DataType> contents;
+    formats::bson::Document token;
+  };
+
   void Update(cache::UpdateType type,
               const std::chrono::system_clock::time_point& last_update,
               const std::chrono::system_clock::time_point& now,
               cache::UpdateStatisticsScope& stats_scope) override;
 
+  void WriteContents(dump::Writer& writer,
+                     const DataType& contents) const override;
+
+  std::unique_ptr<const DataType> ReadContents(
+      dump::Reader& reader) const override;
+
   typename MongoCacheTraits::ObjectType DeserializeObject(
       const formats::bson::Document& doc) const;
 
+  // Returns std::nullopt if the invalid document is skipped
+  std::optional<ObjectType> ParseDocument(
+      const formats::bson::Document& doc,
+      cache::UpdateStatisticsScope& stats_scope) const;
+
+  KeyType GetKeyFromId(const formats::bson::Value& id) const;
+
+  storages::mongo::ChangeStream OpenChangeStream(
+      std::optional<formats::bson::Document> resume_token) const;
+
+  // Returns false if a full update is needed
+  bool ChangeStreamUpdate(cache::UpdateStatisticsScope& stats_scope);
+
+  // Returns false if the stream is invalidated
+  bool ApplyChangeEvent(DataType& data, const formats::bson::Document& event,
+                        std::vector<KeyType>& changed_keys,
+                        cache::UpdateStatisticsScope& stats_scope) const;
+
+  void RememberResumeToken(std::optional<formats::bson::Document> token);
+
   storages::mongo::operations::Find GetFindOperation(
       cache::UpdateType type,
       const std::chrono::system_clock::time_point& last_update,
@@ -155,6 +238,12 @@ class MongoCache
   const storages::mongo::Collection* const mongo_collection_;
   const std::chrono::system_clock::duration correction_;
   std::size_t cpu_relax_iterations_{0};
+
+  std::optional<storages::mongo::ChangeStream> change_stream_;
+  // The tokens to resume the stream after the recent contents, for dumps
+  mutable concurrent::Variable<std::vector<ResumeToken>> resume_tokens_;
+  mutable concurrent::Variable<std::optional<formats::bson::Document>>
+      dumped_resume_token_;
 };
 
 template <class MongoCacheTraits>
@@ -176,9 +265,19 @@ MongoCache<MongoCacheTraits>::MongoCache(const ComponentConfig& config,
   [[maybe_unused]] mongo_cache::impl::CheckTraits<MongoCacheTraits>
       check_traits;
 
+  if constexpr (kUseChangeStream) {
+    if (this->GetAllowedUpdateTypes() !=
+        cache::AllowedUpdateTypes::kFullAndIncremental) {
+      throw std::logic_error(
+          "Change stream updates require incremental updates to be allowed "
+          "in config of '" +
+          components::GetCurrentComponentName(config) + "' cache");
+    }
+  }
   if (CachingComponentBase<
           typename MongoCacheTraits::DataType>::GetAllowedUpdateTypes() ==
           cache::AllowedUpdateTypes::kFullAndIncremental &&
+      !kUseChangeStream &&
       !mongo_cache::impl::kHasUpdateFieldName<MongoCacheTraits> &&
       !mongo_cache::impl::kHasFindOperation<MongoCacheTraits>) {
     throw std::logic_error(
@@ -209,6 +308,20 @@ void MongoCache<MongoCacheTraits>::Update(
     cache::UpdateStatisticsScope& stats_scope) {
   namespace sm = storages::mongo;
 
+  std::optional<sm::ChangeStream> change_stream;
+  std::optional<formats::bson::Document> resume_token;
+  if constexpr (kUseChangeStream) {
+    if (type == cache::UpdateType::kIncremental &&
+        ChangeStreamUpdate(stats_scope)) {
+      return;
+    }
+    type = cache::UpdateType::kFull;
+    // The stream keeps the changes made during the full update
+    change_stream_.reset();
+    change_stream = OpenChangeStream(std::nullopt);
+    resume_token = change_stream->GetResumeToken();
+  }
+
   const auto* collection = mongo_collection_;
   auto find_op = GetFindOperation(type, last_update, now, correction_);
   auto cursor = collection->Execute(find_op);
@@ -235,25 +348,16 @@ void MongoCache<MongoCacheTraits>::Update(
 
     stats_scope.IncreaseDocumentsReadCount(1);
 
-    try {
-      auto object = DeserializeObject(doc);
-      auto key = (object.*MongoCacheTraits::kKeyField);
-
-      if (type == cache::UpdateType::kIncremental ||
-          new_cache->count(key) == 0) {
-        (*new_cache)[key] = std::move(object);
-      } else {
-        LOG_LIMITED_ERROR() << "Found duplicate key for 2 items in cache "
-                            << MongoCacheTraits::kName << ", key=" << key;
-      }
-    } catch (const std::exception& e) {
-      LOG_LIMITED_ERROR() << "Failed to deserialize cache item of cache "
-                          << MongoCacheTraits::kName << ", _id="
-                          << doc["_id"].template ConvertTo<std::string>()
-                          << ", what(): " << e;
-      stats_scope.IncreaseDocumentsParseFailures(1);
-
-      if (!MongoCacheTraits::kAreInvalidDocumentsSkipped) throw;
+    auto object = ParseDocument(doc, stats_scope);
+    if (!object) continue;
+    auto key = ((*object).*MongoCacheTraits::kKeyField);
+
+    if (type == cache::UpdateType::kIncremental ||
+        new_cache->count(key) == 0) {
+      (*new_cache)[key] = std::move(*object);
+    } else {
+      LOG_LIMITED_ERROR() << "Found duplicate key for 2 items in cache "
+                          << MongoCacheTraits::kName << ", key=" << key;
     }
   }
 
@@ -271,9 +375,48 @@ void MongoCache<MongoCacheTraits>::Update(
 
   const auto size = new_cache->size();
   this->Set(std::move(new_cache));
+  if constexpr (kUseChangeStream) {
+    RememberResumeToken(std::move(resume_token));
+    change_stream_ = std::move(change_stream);
+  }
   stats_scope.Finish(size);
 }
 
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::WriteContents(
+    dump::Writer& writer, const DataType& contents) const {
+  CachingComponentBase<DataType>::WriteContents(writer, contents);
+  if constexpr (kUseChangeStream) {
+    // Only the token of these very contents may be written, a newer one
+    // would skip the changes on resume
+    std::optional<std::string> token;
+    {
+      auto tokens = resume_tokens_.Lock();
+      const auto it = std::find_if(
+          tokens->rbegin(), tokens->rend(), [&](const ResumeToken& entry) {
+            return entry.contents.lock().get() == &contents;
+          });
+      if (it != tokens->rend()) {
+        token = formats::bson::ToBinaryString(it->token).ToString();
+      }
+    }
+    writer.Write(token);
+  }
+}
+
+template <class MongoCacheTraits>
+std::unique_ptr<const typename MongoCacheTraits::DataType>
+MongoCache<MongoCacheTraits>::ReadContents(dump::Reader& reader) const {
+  auto contents = CachingComponentBase<DataType>::ReadContents(reader);
+  if constexpr (kUseChangeStream) {
+    const auto token = reader.Read<std::optional<std::string>>();
+    auto dumped_token = dumped_resume_token_.Lock();
+    dumped_token->reset();
+    if (token) *dumped_token = formats::bson::FromBinaryString(*token);
+  }
+  return contents;
+}
+
 template <class MongoCacheTraits>
 typename MongoCacheTraits::ObjectType
 MongoCache<MongoCacheTraits>::DeserializeObject(
@@ -289,6 +432,188 @@ MongoCache<MongoCacheTraits>::DeserializeObject(
               "No deserialize operation defined but DeserializeObject invoked");
 }
 
+template <class MongoCacheTraits>
+std::optional<typename MongoCacheTraits::ObjectType>
+MongoCache<MongoCacheTraits>::ParseDocument(
+    const formats::bson::Document& doc,
+    cache::UpdateStatisticsScope& stats_scope) const {
+  try {
+    return DeserializeObject(doc);
+  } catch (const std::exception& e) {
+    LOG_LIMITED_ERROR() << "Failed to deserialize cache item of cache "
+                        << MongoCacheTraits::kName << ", _id="
+                        << doc["_id"].template ConvertTo<std::string>()
+                        << ", what(): " << e;
+    stats_scope.IncreaseDocumentsParseFailures(1);
+
+    if (!MongoCacheTraits::kAreInvalidDocumentsSkipped) throw;
+  }
+  return std::nullopt;
+}
+
+template <class MongoCacheTraits>
+typename MongoCache<MongoCacheTraits>::KeyType
+MongoCache<MongoCacheTraits>::GetKeyFromId(
+    const formats::bson::Value& id) const {
+  if constexpr (mongo_cache::impl::kHasGetKeyFromId<MongoCacheTraits>) {
+    return MongoCacheTraits::GetKeyFromId(id);
+  } else {
+    return id.As<KeyType>();
+  }
+}
+
+template <class MongoCacheTraits>
+storages::mongo::ChangeStream MongoCache<MongoCacheTraits>::OpenChangeStream(
+    std::optional<formats::bson::Document> resume_token) const {
+  namespace sm = storages::mongo;
+
+  sm::operations::Watch watch_op;
+  watch_op.SetOption(sm::options::FullDocumentLookup{});
+  watch_op.SetOption(
+      sm::options::MaxAwaitTime{impl::kChangeStreamMaxAwaitTime});
+  if (MongoCacheTraits::kIsSecondaryPreferred) {
+    watch_op.SetOption(sm::options::ReadPreference::kSecondaryPreferred);
+  }
+  if (resume_token) {
+    watch_op.SetOption(sm::options::ResumeAfter{std::move(*resume_token)});
+  }
+  return mongo_collection_->Execute(watch_op);
+}
+
+template <class MongoCacheTraits>
+bool MongoCache<MongoCacheTraits>::ChangeStreamUpdate(
+    cache::UpdateStatisticsScope& stats_scope) {
+  if (!change_stream_) {
+    std::optional<formats::bson::Document> resume_token;
+    {
+      auto dumped_token = dumped_resume_token_.Lock();
+      resume_token = std::exchange(*dumped_token, std::nullopt);
+    }
+    if (!resume_token) return false;
+    try {
+      change_stream_.emplace(OpenChangeStream(std::move(resume_token)));
+    } catch (const storages::mongo::MongoException& e) {
+      LOG_WARNING() << "Failed to resume the change stream of cache "
+                    << MongoCacheTraits::kName
+                    << " from the dump, falling back to a full update: " << e;
+      return false;
+    }
+  }
+
+  auto scope =
+      tracing::Span::CurrentSpan().CreateScopeTime(kFetchAndParseStage);
+  std::vector<formats::bson::Document> events;
+  const auto deadline =
+      engine::Deadline::FromDuration(impl::kChangeStreamReadTime);
+  try {
+    while (!deadline.IsReached()) {
+      auto event = change_stream_->Next();
+      if (!event) break;
+      events.push_back(std::move(*event));
+    }
+  } catch (const storages::mongo::MongoException& e) {
+    // E.g. the driver could not resume the stream as its token has expired
+    LOG_WARNING() << "Change stream of cache " << MongoCacheTraits::kName
+                  << " failed, falling back to a full update: " << e;
+    change_stream_.reset();
+    return false;
+  }
+  auto resume_token = change_stream_->GetResumeToken();
+  stats_scope.IncreaseDocumentsReadCount(events.size());
+
+  if (events.empty()) {
+    // There were no changes up to the new token
+    RememberResumeToken(std::move(resume_token));
+    LOG_INFO() << "No changes in cache " << MongoCacheTraits::kName;
+    stats_scope.FinishNoChanges();
+    return true;
+  }
+
+  scope.Reset("copy_data");
+  auto new_cache = GetData(cache::UpdateType::kIncremental);
+  scope.Reset(kFetchAndParseStage);
+
+  std::vector<KeyType> changed_keys;
+  changed_keys.reserve(events.size());
+  try {
+    for (const auto& event : events) {
+      if (!ApplyChangeEvent(*new_cache, event, changed_keys, stats_scope)) {
+        LOG_WARNING() << "Change stream of cache " << MongoCacheTraits::kName
+                      << " is invalidated, falling back to a full update";
+        change_stream_.reset();
+        return false;
+      }
+    }
+  } catch (const std::exception&) {
+    // The events are already consumed, the next update must be a full one
+    change_stream_.reset();
+    throw;
+  }
+  scope.Reset();
+
+  const auto size = new_cache->size();
+  if constexpr (meta::kIsUniqueMap<DataType>) {
+    this->Set(std::move(new_cache), changed_keys);
+  } else {
+    this->Set(std::move(new_cache));
+  }
+  RememberResumeToken(std::move(resume_token));
+  stats_scope.Finish(size);
+  return true;
+}
+
+template <class MongoCacheTraits>
+bool MongoCache<MongoCacheTraits>::ApplyChangeEvent(
+    DataType& data, const formats::bson::Document& event,
+    std::vector<KeyType>& changed_keys,
+    cache::UpdateStatisticsScope& stats_scope) const {
+  const auto operation_type =
+      event["operationType"].template As<std::string>();
+  if (operation_type == "insert" || operation_type == "replace" ||
+      operation_type == "update") {
+    const auto full_document = event["fullDocument"];
+    // The document was deleted after the change, the deletion follows
+    if (full_document.IsMissing() || full_document.IsNull()) return true;
+
+    auto object = ParseDocument(
+        full_document.template As<formats::bson::Document>(), stats_scope);
+    if (!object) return true;
+    auto key = ((*object).*MongoCacheTraits::kKeyField);
+    data[key] = std::move(*object);
+    changed_keys.push_back(std::move(key));
+  } else if (operation_type == "delete") {
+    auto key = GetKeyFromId(event["documentKey"]["_id"]);
+    data.erase(key);
+    changed_keys.push_back(std::move(key));
+  } else if (operation_type == "invalidate" || operation_type == "drop" ||
+             operation_type == "rename" || operation_type == "dropDatabase") {
+    return false;
+  }
+  return true;
+}
+
+template <class MongoCacheTraits>
+void MongoCache<MongoCacheTraits>::RememberResumeToken(
+    std::optional<formats::bson::Document> token) {
+  if (!token) return;
+  const auto contents = this->Get();
+  const std::shared_ptr<const DataType>& shared_contents = contents;
+
+  auto tokens = resume_tokens_.Lock();
+  tokens->erase(
+      std::remove_if(tokens->begin(), tokens->end(),
+                     [](const ResumeToken& entry) {
+                       return entry.contents.expired();
+                     }),
+      tokens->end());
+  if (!tokens->empty() &&
+      tokens->back().contents.lock() == shared_contents) {
+    tokens->back().token = std::move(*token);
+  } else {
+    tokens->push_back({shared_contents, std::move(*token)});
+  }
+}
+
 template <class MongoCacheTraits>
 storages::mongo::operations::Find
 MongoCache<MongoCacheTraits>::GetFindOperation(
@@ -322,6 +647,8 @@ MongoCache<MongoCacheTraits>::GetFindOperation(
   if (MongoCacheTraits::kIsSecondaryPreferred) {
     find_op.SetOption(sm::options::ReadPreference::kSecondaryPreferred);
   }
+  // Documents are copied by the iteration anyway, fetch them in advance
+  find_op.SetOption(sm::options::Prefetch{});
   return find_op;
 }
 
@@ -11,7 +11,8 @@ USERVER_NAMESPACE_BEGIN
 
 namespace formats::bson {
 class Document;
-}
+class Value;
+}  // namespace formats::bson
 
 namespace storages::mongo::operations {
 class Find;
@@ -100,6 +101,35 @@ template <typename T>
 inline constexpr bool kHasInvalidDocumentsSkipped =
     meta::kIsDetected<HasInvalidDocumentsSkipped, T>;
 
+template <typename T>
+using HasUseChangeStream = decltype(T::kUseChangeStream);
+template <typename T>
+inline constexpr bool kHasUseChangeStream =
+    meta::kIsDetected<HasUseChangeStream, T>;
+
+template <typename T>
+constexpr bool UseChangeStream() {
+  if constexpr (kHasUseChangeStream<T>) {
+    return T::kUseChangeStream;
+  } else {
+    return false;
+  }
+}
+
+template <typename T>
+using HasGetKeyFromId = decltype(T::GetKeyFromId);
+template <typename T>
+inline constexpr bool kHasGetKeyFromId = meta::kIsDetected<HasGetKeyFromId, T>;
+
+template <typename T>
+using HasCorrectGetKeyFromId =
+    meta::ExpectSame<typename T::KeyType,
+                     decltype(std::declval<const T&>().GetKeyFromId(
+                         std::declval<const formats::bson::Value&>()))>;
+template <typename T>
+inline constexpr bool kHasCorrectGetKeyFromId =
+    meta::kIsDetected<HasCorrectGetKeyFromId, T>;
+
 template <typename>
 struct ClassByMemberPointer {};
 template <typename T, typename C>
@@ -130,6 +160,13 @@ struct CheckTraits {
               bool>,
           "Mongo cache traits must specify kUseDefaultFindOperation as bool");
     }
+    if constexpr (kHasUseChangeStream<MongoCacheTraits>) {
+      static_assert(
+          std::is_same_v<
+              std::decay_t<decltype(MongoCacheTraits::kUseChangeStream)>,
+              bool>,
+          "Mongo cache traits must specify kUseChangeStream as bool");
+    }
   }
 
   static_assert(kHasCollectionsField<MongoCacheTraits>,
@@ -178,6 +215,12 @@ struct CheckTraits {
       "signature and return value type: "
       "static ObjectType DeserializeObject(const formats::bson::Document& "
       "doc)");
+
+  static_assert(!kHasGetKeyFromId<MongoCacheTraits> ||
+                    kHasCorrectGetKeyFromId<MongoCacheTraits>,
+                "Mongo cache traits must specify key from id getter with "
+                "correct signature and return value type: "
+                "static KeyType GetKeyFromId(const formats::bson::Value& id)");
 };
 
 }  // namespace mongo_cache::impl
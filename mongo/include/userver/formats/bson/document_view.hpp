@@ -0,0 +1,355 @@
+#pragma once
+
+/// @file userver/formats/bson/document_view.hpp
+/// @brief @copybrief formats::bson::DocumentView
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include <bson/bson.h>
+
+#include <userver/formats/bson/document.hpp>
+#include <userver/formats/bson/exception.hpp>
+#include <userver/formats/bson/types.hpp>
+#include <userver/formats/bson/value.hpp>
+#include <userver/formats/common/meta.hpp>
+#include <userver/formats/parse/common.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson {
+
+class DocumentView;
+class ViewIterator;
+
+/// @brief Non-owning read-only view of a single BSON element.
+///
+/// Unlike formats::bson::Value, no parsed representation is ever built:
+/// every member lookup walks the raw BSON bytes. Lookups are linear in the
+/// number of fields, which is cheaper than building a hash map for documents
+/// that are read once.
+///
+/// The view does not own the data and is only valid while the underlying
+/// buffer (formats::bson::Document, a cursor document etc.) is alive.
+///
+/// @note GetPath() returns the element name only, views do not track the
+/// full path from the root document.
+class ElementView {
+ public:
+  struct DefaultConstructed {};
+
+  using const_iterator = ViewIterator;
+  using Exception = formats::bson::BsonException;
+  using ParseException = formats::bson::ConversionException;
+
+  /// Constructs a missing element
+  ElementView() = default;
+
+  /// @cond
+  /// Constructs from a native iterator, internal use only
+  explicit ElementView(const bson_iter_t& iter);
+  /// @endcond
+
+  /// @brief Selects a field by name
+  /// @returns a missing element if this is missing, null or has no such field
+  /// @throws TypeMismatchException if the element is not a document
+  ElementView operator[](std::string_view name) const;
+
+  /// @brief Selects an array element by index
+  /// @throws TypeMismatchException if the element is not an array
+  /// @throws OutOfBoundsException if index is greater than the array size
+  ElementView operator[](uint32_t index) const;
+
+  /// @brief Checks whether the document has a field
+  /// @throws TypeMismatchException if the element is not a document
+  bool HasMember(std::string_view name) const;
+
+  /// @brief Returns an iterator to the first nested element
+  /// @throws TypeMismatchException if the element is not a document or array
+  const_iterator begin() const;
+
+  /// Returns an iterator past the last nested element
+  const_iterator end() const;
+
+  /// @brief Returns whether the document or array is empty
+  /// @throws TypeMismatchException if the element is not a document or array
+  bool IsEmpty() const;
+
+  /// @brief Returns the number of nested elements, linear in their count
+  /// @throws TypeMismatchException if the element is not a document or array
+  uint32_t GetSize() const;
+
+  /// Returns the element name
+  std::string GetPath() const;
+
+  /// @brief Checks that the element is of specified type.
+  /// @{
+  bool IsMissing() const;
+  bool IsArray() const;
+  bool IsDocument() const;
+  bool IsNull() const;
+  bool IsBool() const;
+  bool IsInt32() const;
+  bool IsInt64() const;
+  bool IsDouble() const;
+  bool IsString() const;
+  bool IsDateTime() const;
+  bool IsOid() const;
+  bool IsBinary() const;
+  bool IsDecimal128() const;
+  bool IsTimestamp() const;
+
+  bool IsObject() const { return IsDocument(); }
+  /// @}
+
+  /// @brief Returns a view of the nested document.
+  /// Arrays are returned as their internal representation, with indices
+  /// as field names.
+  /// @throws TypeMismatchException if the element is not a document or array
+  DocumentView GetDocument() const;
+
+  /// @brief Copies the element into an owning formats::bson::Value
+  /// @throws MemberMissingException if the element is missing
+  Value ToValue() const;
+
+  /// @brief Extracts the specified type with strict type checks.
+  ///
+  /// Uses `Parse(const ElementView&, formats::parse::To<T>)` or
+  /// `Parse(const DocumentView&, formats::parse::To<T>)` if available,
+  /// otherwise copies the element and uses
+  /// `Parse(const Value&, formats::parse::To<T>)`.
+  template <typename T>
+  auto As() const {
+    if constexpr (formats::common::impl::kHasParse<ElementView, T>) {
+      return Parse(*this, formats::parse::To<T>{});
+    } else if constexpr (formats::common::impl::kHasParse<DocumentView, T>) {
+      return Parse(GetDocument(), formats::parse::To<T>{});
+    } else {
+      static_assert(
+          formats::common::impl::kHasParse<Value, T>,
+          "There is no `Parse(const ElementView&, formats::parse::To<T>)` nor "
+          "`Parse(const Value&, formats::parse::To<T>)` in namespace of `T` "
+          "or `formats::parse`. "
+          "Probably you have not provided a `Parse` function overload.");
+      return ToValue().As<T>();
+    }
+  }
+
+  /// Extracts the specified type with strict type checks, or constructs the
+  /// default value when the field is not present
+  template <typename T, typename First, typename... Rest>
+  auto As(First&& default_arg, Rest&&... more_default_args) const {
+    if (IsMissing() || IsNull()) {
+      // intended raw ctor call, sometimes casts
+      // NOLINTNEXTLINE(google-readability-casting)
+      return decltype(As<T>())(std::forward<First>(default_arg),
+                               std::forward<Rest>(more_default_args)...);
+    }
+    return As<T>();
+  }
+
+  /// @brief Returns value of *this converted to T or T() if this->IsMissing().
+  /// @note Use as `view.As<T>({})`
+  template <typename T>
+  auto As(DefaultConstructed) const {
+    return (IsMissing() || IsNull()) ? decltype(As<T>())() : As<T>();
+  }
+
+  /// Throws a MemberMissingException if the selected element does not exist
+  void CheckNotMissing() const;
+
+  /// @brief Throws a TypeMismatchException if the selected element
+  /// is not an array or null
+  void CheckArrayOrNull() const;
+
+  /// @brief Throws a TypeMismatchException if the selected element
+  /// is not a document or null
+  void CheckDocumentOrNull() const;
+
+  /// @cond
+  /// Same, for parsing capabilities
+  void CheckObjectOrNull() const { CheckDocumentOrNull(); }
+  /// @endcond
+
+ private:
+  friend class ViewIterator;
+
+  bson_type_t Type() const;
+  bool Recurse(bson_iter_t& child) const;
+
+  friend bool Parse(const ElementView&, parse::To<bool>);
+  friend int64_t Parse(const ElementView&, parse::To<int64_t>);
+  friend uint64_t Parse(const ElementView&, parse::To<uint64_t>);
+  friend double Parse(const ElementView&, parse::To<double>);
+  friend std::string Parse(const ElementView&, parse::To<std::string>);
+  friend std::chrono::system_clock::time_point Parse(
+      const ElementView&, parse::To<std::chrono::system_clock::time_point>);
+  friend Oid Parse(const ElementView&, parse::To<Oid>);
+  friend Binary Parse(const ElementView&, parse::To<Binary>);
+  friend Decimal128 Parse(const ElementView&, parse::To<Decimal128>);
+  friend Timestamp Parse(const ElementView&, parse::To<Timestamp>);
+  friend Document Parse(const ElementView&, parse::To<Document>);
+
+  bson_iter_t iter_{};
+  bool is_missing_{true};
+  // only set for missing fields to report their names
+  std::string missing_name_;
+};
+
+/// Forward iterator over the elements of a DocumentView or an ElementView
+class ViewIterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = ElementView;
+  using reference = const ElementView&;
+  using pointer = const ElementView*;
+
+  /// Constructs an end iterator
+  ViewIterator() = default;
+
+  /// @cond
+  /// Constructs from a native iterator before the first element,
+  /// internal use only
+  explicit ViewIterator(const bson_iter_t& iter);
+  /// @endcond
+
+  ViewIterator operator++(int);
+  ViewIterator& operator++();
+  reference operator*() const { return current_; }
+  pointer operator->() const { return &current_; }
+
+  bool operator==(const ViewIterator&) const;
+  bool operator!=(const ViewIterator& rhs) const { return !(*this == rhs); }
+
+  /// Returns name of currently selected field
+  std::string_view GetName() const;
+
+  /// @brief Returns index of currently selected array element
+  /// @warning Only meaningful for arrays
+  uint32_t GetIndex() const { return index_; }
+
+ private:
+  ElementView current_;
+  uint32_t index_{0};
+};
+
+/// @brief Non-owning read-only view of a BSON document.
+///
+/// Allows reading a document without copying or parsing it in advance,
+/// see formats::bson::ElementView for details.
+///
+/// The view does not own the data and is only valid while the underlying
+/// buffer is alive.
+///
+/// ## Example usage:
+///
+/// @snippet formats/bson/document_view_test.cpp  Sample DocumentView usage
+class DocumentView {
+ public:
+  using const_iterator = ViewIterator;
+  using Exception = formats::bson::BsonException;
+  using ParseException = formats::bson::ConversionException;
+
+  /// Constructs a view of an empty document
+  DocumentView();
+
+  /// Constructs a view of the document, which must outlive the view
+  /* implicit */ DocumentView(const Document& doc);
+
+  /// @cond
+  /// Constructs from native types, internal use only
+  explicit DocumentView(const bson_t* bson);
+  DocumentView(const uint8_t* data, std::size_t size);
+  /// @endcond
+
+  /// @brief Selects a field by name
+  /// @returns a missing element if there is no such field
+  ElementView operator[](std::string_view name) const;
+
+  /// Checks whether the document has a field
+  bool HasMember(std::string_view name) const;
+
+  const_iterator begin() const;
+  const_iterator end() const;
+
+  bool IsEmpty() const;
+
+  /// Returns the number of fields, linear in their count
+  uint32_t GetSize() const;
+
+  /// Returns the path of the root document
+  std::string GetPath() const;
+
+  /// Copies the viewed document
+  Document ToDocument() const;
+
+  /// @brief Extracts the specified type with strict type checks.
+  ///
+  /// Uses `Parse(const DocumentView&, formats::parse::To<T>)` if available,
+  /// otherwise copies the document and uses
+  /// `Parse(const Value&, formats::parse::To<T>)`.
+  template <typename T>
+  auto As() const {
+    if constexpr (formats::common::impl::kHasParse<DocumentView, T>) {
+      return Parse(*this, formats::parse::To<T>{});
+    } else {
+      static_assert(
+          formats::common::impl::kHasParse<Value, T>,
+          "There is no `Parse(const DocumentView&, formats::parse::To<T>)` nor "
+          "`Parse(const Value&, formats::parse::To<T>)` in namespace of `T` "
+          "or `formats::parse`. "
+          "Probably you have not provided a `Parse` function overload.");
+      return ToDocument().As<T>();
+    }
+  }
+
+  /// @cond
+  /// For parsing capabilities
+  bool IsMissing() const { return false; }
+  bool IsNull() const { return false; }
+  void CheckObjectOrNull() const {}
+  /// @endcond
+
+ private:
+  bson_iter_t Init() const;
+
+  const uint8_t* data_;
+  std::size_t size_;
+};
+
+/// @cond
+bool Parse(const ElementView&, parse::To<bool>);
+
+int64_t Parse(const ElementView&, parse::To<int64_t>);
+
+uint64_t Parse(const ElementView&, parse::To<uint64_t>);
+
+double Parse(const ElementView&, parse::To<double>);
+
+std::string Parse(const ElementView&, parse::To<std::string>);
+
+std::chrono::system_clock::time_point Parse(
+    const ElementView&, parse::To<std::chrono::system_clock::time_point>);
+
+Oid Parse(const ElementView&, parse::To<Oid>);
+
+Binary Parse(const ElementView&, parse::To<Binary>);
+
+Decimal128 Parse(const ElementView&, parse::To<Decimal128>);
+
+Timestamp Parse(const ElementView&, parse::To<Timestamp>);
+
+Document Parse(const ElementView&, parse::To<Document>);
+
+Value Parse(const ElementView&, parse::To<Value>);
+/// @endcond
+
+}  // namespace formats::bson
+
+USERVER_NAMESPACE_END
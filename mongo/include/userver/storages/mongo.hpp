@@ -8,6 +8,7 @@
 #include <userver/storages/mongo/cursor.hpp>
 #include <userver/storages/mongo/exception.hpp>
 #include <userver/storages/mongo/options.hpp>
+#include <userver/storages/mongo/parallel_bulk_writer.hpp>
 #include <userver/storages/mongo/pool.hpp>
 #include <userver/storages/mongo/write_result.hpp>
 
@@ -0,0 +1,51 @@
+#pragma once
+
+/// @file userver/storages/mongo/change_stream.hpp
+/// @brief @copybrief storages::mongo::ChangeStream
+
+#include <memory>
+#include <optional>
+
+#include <userver/formats/bson/document.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo {
+namespace impl {
+class ChangeStreamImpl;
+}  // namespace impl
+
+/// @brief Change stream of a collection, opened with Collection::Watch
+///
+/// Holds a connection of the pool for its whole lifetime. The driver resumes
+/// the stream once on a transient error, the other errors are thrown. A
+/// stream that threw should be reopened with options::ResumeAfter using the
+/// last resume token, or the watched data should be reloaded if the token
+/// has already expired from the oplog.
+class ChangeStream {
+ public:
+  explicit ChangeStream(std::unique_ptr<impl::ChangeStreamImpl>&&);
+  ~ChangeStream();
+
+  ChangeStream(ChangeStream&&) noexcept;
+  ChangeStream& operator=(ChangeStream&&) noexcept;
+
+  /// @brief Returns the next change event.
+  ///
+  /// When the received events are over, waits for the new ones on the server
+  /// no longer than options::MaxAwaitTime.
+  ///
+  /// @returns the change event or std::nullopt if there were no new events
+  std::optional<formats::bson::Document> Next();
+
+  /// @brief Returns the token to resume the stream after the last returned
+  /// event, or after the last empty wait if there were no events since.
+  std::optional<formats::bson::Document> GetResumeToken() const;
+
+ private:
+  std::unique_ptr<impl::ChangeStreamImpl> impl_;
+};
+
+}  // namespace storages::mongo
+
+USERVER_NAMESPACE_END
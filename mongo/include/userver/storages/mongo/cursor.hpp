@@ -7,6 +7,7 @@
 #include <memory>
 
 #include <userver/formats/bson/document.hpp>
+#include <userver/formats/bson/document_view.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -55,12 +56,52 @@ class Cursor {
     Cursor* cursor_;
   };
 
+  /// Iterator over the documents as formats::bson::DocumentView
+  class ViewIterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = ptrdiff_t;
+    using value_type = formats::bson::DocumentView;
+    using reference = value_type;
+    using pointer = void;
+
+    explicit ViewIterator(Cursor*);
+
+    ViewIterator& operator++();
+    value_type operator*() const;
+
+    bool operator==(const ViewIterator&) const;
+    bool operator!=(const ViewIterator&) const;
+
+   private:
+    Cursor* cursor_;
+  };
+
+  /// @brief Range of document views, see Views()
+  class ViewRange {
+   public:
+    explicit ViewRange(Cursor* cursor) : cursor_(cursor) {}
+
+    ViewIterator begin() const { return ViewIterator(cursor_); }
+    ViewIterator end() const { return ViewIterator(nullptr); }
+
+   private:
+    Cursor* cursor_;
+  };
+
   bool HasMore() const;
   explicit operator bool() const { return HasMore(); }
 
   Iterator begin();
   Iterator end();
 
+  /// @brief Iterates over the documents without copying them.
+  ///
+  /// Views point into the driver reply buffer and are only valid until
+  /// the cursor is advanced. Use formats::bson::DocumentView::ToDocument()
+  /// to keep a document for longer.
+  ViewRange Views() { return ViewRange(this); }
+
  private:
   std::unique_ptr<impl::CursorImpl> impl_;
 };
@@ -1,8 +1,13 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
 
+#include <userver/concurrent/variable.hpp>
+#include <userver/dist_lock/acquire_batcher.hpp>
 #include <userver/dist_lock/dist_lock_strategy.hpp>
 #include <userver/storages/mongo/collection.hpp>
 
@@ -10,7 +15,10 @@ USERVER_NAMESPACE_BEGIN
 
 namespace storages::mongo {
 
-/// Strategy for mongodb-based distributed locking
+/// @brief Strategy for mongodb-based distributed locking
+///
+/// The strategy maintains the fencing tokens of the locks. The released locks
+/// are expired instead of being removed to keep their tokens.
 class DistLockStrategy final : public dist_lock::DistLockStrategyBase {
  public:
   /// Targets a distributed lock in a specified collection as a host.
@@ -19,15 +27,43 @@ class DistLockStrategy final : public dist_lock::DistLockStrategyBase {
   DistLockStrategy(Collection collection, std::string lock_name,
                    std::string owner);
 
+  /// @brief Targets a distributed lock in a specified collection and
+  /// prolongs the held lock with the `batcher`
+  /// @param batcher batcher of MakeBatcher() for the same collection
+  DistLockStrategy(Collection collection, std::string lock_name,
+                   std::string owner,
+                   std::shared_ptr<dist_lock::AcquireBatcher> batcher);
+
+  /// @brief Creates a batcher that prolongs the held locks of multiple
+  /// strategies of the `collection` in a single bulk write
+  ///
+  /// Only the held locks are batched, the locks are acquired by a separate
+  /// request each.
+  static std::shared_ptr<dist_lock::AcquireBatcher> MakeBatcher(
+      Collection collection,
+      const dist_lock::AcquireBatcherSettings& batcher_settings);
+
   void Acquire(std::chrono::milliseconds lock_ttl,
                const std::string& locker_id) override;
 
+  std::optional<dist_lock::FencingToken> AcquireWithFencingToken(
+      std::chrono::milliseconds lock_ttl,
+      const std::string& locker_id) override;
+
   void Release(const std::string& locker_id) override;
 
  private:
+  dist_lock::FencingToken AcquireSingle(std::chrono::milliseconds lock_ttl,
+                                        const std::string& owner);
+
   storages::mongo::Collection collection_;
   std::string lock_name_;
   std::string owner_prefix_;
+  std::shared_ptr<dist_lock::AcquireBatcher> batcher_;
+
+  // Tokens of the held locks by locker_id, maintained for batched prolonging
+  concurrent::Variable<std::unordered_map<std::string, dist_lock::FencingToken>>
+      held_tokens_;
 };
 
 }  // namespace storages::mongo
@@ -276,6 +276,24 @@ class SuppressServerExceptions {};
 /// @see https://docs.mongodb.com/manual/core/tailable-cursors/
 class Tailable {};
 
+/// @brief Requests the next batch of a cursor in background while the
+/// current one is being iterated
+/// @note The documents are copied out of the driver reply buffers.
+class Prefetch {};
+
+/// @brief Adjusts the number of documents requested by each batch of a cursor
+/// to receive about the specified number of bytes per batch
+/// @note The initial batch is sized by the server.
+class TargetBatchBytes {
+ public:
+  explicit TargetBatchBytes(size_t value) : value_(value) {}
+
+  size_t Value() const { return value_; }
+
+ private:
+  size_t value_;
+};
+
 /// Sets a comment for the operation, which would be visible in profile data
 class Comment {
  public:
@@ -300,6 +318,36 @@ class MaxServerTime {
   std::chrono::milliseconds value_;
 };
 
+/// @brief Starts a change stream right after the event with the resume token
+/// @see https://www.mongodb.com/docs/manual/changeStreams/#resume-a-change-stream
+class ResumeAfter {
+ public:
+  explicit ResumeAfter(formats::bson::Document token)
+      : value_(std::move(token)) {}
+
+  const formats::bson::Document& Value() const { return value_; }
+
+ private:
+  formats::bson::Document value_;
+};
+
+/// @brief Makes the update events of a change stream contain the current
+/// version of the whole changed document
+class FullDocumentLookup {};
+
+/// @brief Specifies how long the server waits for new events of a change
+/// stream before it returns an empty batch
+class MaxAwaitTime {
+ public:
+  explicit MaxAwaitTime(const std::chrono::milliseconds& value)
+      : value_(value) {}
+
+  const std::chrono::milliseconds& Value() const { return value_; }
+
+ private:
+  std::chrono::milliseconds value_;
+};
+
 }  // namespace storages::mongo::options
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,246 @@
+#pragma once
+
+/// @file userver/storages/mongo/parallel_bulk_writer.hpp
+/// @brief @copybrief storages::mongo::ParallelBulkWriter
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <userver/engine/semaphore.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/formats/bson/document.hpp>
+#include <userver/storages/mongo/bulk_ops.hpp>
+#include <userver/storages/mongo/collection.hpp>
+#include <userver/storages/mongo/options.hpp>
+#include <userver/storages/mongo/write_result.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo {
+
+/// Settings of storages::mongo::ParallelBulkWriter
+struct ParallelBulkWriterSettings final {
+  /// Maximum number of sub-operations in a single bulk
+  std::size_t max_batch_operations{100000};
+
+  /// Maximum total size of the documents of a single bulk, in bytes
+  std::size_t max_batch_bytes{16 * 1024 * 1024};
+
+  /// Maximum number of bulks executed concurrently
+  std::size_t max_in_flight{4};
+
+  /// Number of attempts to execute a bulk failed with a network error or
+  /// with no server available
+  std::size_t attempts{3};
+
+  /// Delay between the attempts
+  std::chrono::milliseconds retry_delay{100};
+
+  /// Write concern of the bulks, the default one of the pool if not set
+  std::optional<options::WriteConcern> write_concern;
+};
+
+/// Statistics of storages::mongo::ParallelBulkWriter
+struct ParallelBulkWriterStatistics final {
+  /// Number of sub-operations in the executed bulks
+  std::size_t operations{0};
+  /// Total size of the documents of the executed bulks, in bytes
+  std::size_t bytes{0};
+  /// Number of the executed bulks
+  std::size_t batches{0};
+  /// Number of the bulks executed again after a retryable error
+  std::size_t retries{0};
+  /// Number of the bulks that have failed all the attempts
+  std::size_t failed_batches{0};
+  /// Time since the first bulk was started till the last one was finished
+  std::chrono::milliseconds elapsed{0};
+
+  /// Throughput of the writer
+  double OperationsPerSecond() const;
+};
+
+/// @brief Splits a large number of write operations over a collection into
+/// unordered bulks and executes several of them concurrently.
+///
+/// A bulk is started as soon as it reaches `max_batch_operations`
+/// sub-operations or `max_batch_bytes` of documents. At most `max_in_flight`
+/// bulks are executed at once, each on its own connection of the pool, and
+/// the methods that add sub-operations wait for a bulk to finish when the
+/// limit is reached.
+///
+/// Server errors of the sub-operations do not interrupt the execution, they
+/// are gathered into WriteResult::ServerErrors() of the aggregated result
+/// with the indices of the sub-operations in the order of their addition.
+/// A bulk failed with a network error or with no server available is
+/// executed again up to `attempts` times, so all its sub-operations should
+/// be idempotent. Other errors are rethrown from Finish().
+///
+/// @warning The writer is not thread-safe, sub-operations must be added
+/// from a single task.
+///
+/// ## Example:
+///
+/// @code
+/// storages::mongo::ParallelBulkWriter writer(
+///     pool->GetCollection("data"), {});
+/// for (auto&& doc : docs) writer.InsertOne(std::move(doc));
+/// auto result = writer.Finish();
+/// @endcode
+class ParallelBulkWriter final {
+ public:
+  ParallelBulkWriter(Collection collection,
+                     ParallelBulkWriterSettings settings);
+
+  /// Waits for the started bulks, the rest of the sub-operations is dropped
+  /// unless Finish() has been called
+  ~ParallelBulkWriter();
+
+  ParallelBulkWriter(const ParallelBulkWriter&) = delete;
+  ParallelBulkWriter& operator=(const ParallelBulkWriter&) = delete;
+
+  /// Inserts a single document
+  template <typename... Options>
+  void InsertOne(formats::bson::Document document, Options&&... options);
+
+  /// @brief Replaces a single matching document
+  /// @see options::Upsert
+  template <typename... Options>
+  void ReplaceOne(formats::bson::Document selector,
+                  formats::bson::Document replacement, Options&&... options);
+
+  /// @brief Updates a single matching document
+  /// @see options::Upsert
+  template <typename... Options>
+  void UpdateOne(formats::bson::Document selector,
+                 formats::bson::Document update, Options&&... options);
+
+  /// @brief Updates all matching documents
+  /// @see options::Upsert
+  template <typename... Options>
+  void UpdateMany(formats::bson::Document selector,
+                  formats::bson::Document update, Options&&... options);
+
+  /// Deletes a single matching document
+  template <typename... Options>
+  void DeleteOne(formats::bson::Document selector, Options&&... options);
+
+  /// Deletes all matching documents
+  template <typename... Options>
+  void DeleteMany(formats::bson::Document selector, Options&&... options);
+
+  /// @brief Executes the remaining sub-operations, waits for all the bulks
+  /// and returns their aggregated result
+  /// @throws the first non-retryable error of the bulks
+  WriteResult Finish();
+
+  ParallelBulkWriterStatistics GetStatistics() const;
+
+ private:
+  using SubOperation = std::variant<bulk_ops::InsertOne, bulk_ops::ReplaceOne,
+                                    bulk_ops::Update, bulk_ops::Delete>;
+
+  struct Batch {
+    std::vector<SubOperation> operations;
+    std::size_t bytes{0};
+  };
+
+  struct BatchTask {
+    std::size_t first_index;
+    engine::TaskWithResult<WriteResult> task;
+  };
+
+  static std::size_t GetSize(const formats::bson::Document& document);
+
+  void Add(SubOperation&& operation, std::size_t bytes);
+  void StartBatch();
+  WriteResult ExecuteBatch(const Batch& batch);
+  void WaitAll() noexcept;
+
+  Collection collection_;
+  const ParallelBulkWriterSettings settings_;
+
+  Batch batch_;
+  std::size_t operations_added_{0};
+
+  engine::Semaphore in_flight_;
+  std::vector<BatchTask> tasks_;
+
+  std::atomic<std::size_t> operations_{0};
+  std::atomic<std::size_t> bytes_{0};
+  std::atomic<std::size_t> batches_{0};
+  std::atomic<std::size_t> retries_{0};
+  std::atomic<std::size_t> failed_batches_{0};
+  std::optional<std::chrono::steady_clock::time_point> start_time_;
+  std::atomic<std::chrono::steady_clock::duration> elapsed_{};
+};
+
+template <typename... Options>
+void ParallelBulkWriter::InsertOne(formats::bson::Document document,
+                                   Options&&... options) {
+  const auto bytes = GetSize(document);
+  bulk_ops::InsertOne insert_subop(std::move(document));
+  (insert_subop.SetOption(std::forward<Options>(options)), ...);
+  Add(std::move(insert_subop), bytes);
+}
+
+template <typename... Options>
+void ParallelBulkWriter::ReplaceOne(formats::bson::Document selector,
+                                    formats::bson::Document replacement,
+                                    Options&&... options) {
+  const auto bytes = GetSize(selector) + GetSize(replacement);
+  bulk_ops::ReplaceOne replace_subop(std::move(selector),
+                                     std::move(replacement));
+  (replace_subop.SetOption(std::forward<Options>(options)), ...);
+  Add(std::move(replace_subop), bytes);
+}
+
+template <typename... Options>
+void ParallelBulkWriter::UpdateOne(formats::bson::Document selector,
+                                   formats::bson::Document update,
+                                   Options&&... options) {
+  const auto bytes = GetSize(selector) + GetSize(update);
+  bulk_ops::Update update_subop(bulk_ops::Update::Mode::kSingle,
+                                std::move(selector), std::move(update));
+  (update_subop.SetOption(std::forward<Options>(options)), ...);
+  Add(std::move(update_subop), bytes);
+}
+
+template <typename... Options>
+void ParallelBulkWriter::UpdateMany(formats::bson::Document selector,
+                                    formats::bson::Document update,
+                                    Options&&... options) {
+  const auto bytes = GetSize(selector) + GetSize(update);
+  bulk_ops::Update update_subop(bulk_ops::Update::Mode::kMulti,
+                                std::move(selector), std::move(update));
+  (update_subop.SetOption(std::forward<Options>(options)), ...);
+  Add(std::move(update_subop), bytes);
+}
+
+template <typename... Options>
+void ParallelBulkWriter::DeleteOne(formats::bson::Document selector,
+                                   Options&&... options) {
+  const auto bytes = GetSize(selector);
+  bulk_ops::Delete delete_subop(bulk_ops::Delete::Mode::kSingle,
+                                std::move(selector));
+  (delete_subop.SetOption(std::forward<Options>(options)), ...);
+  Add(std::move(delete_subop), bytes);
+}
+
+template <typename... Options>
+void ParallelBulkWriter::DeleteMany(formats::bson::Document selector,
+                                    Options&&... options) {
+  const auto bytes = GetSize(selector);
+  bulk_ops::Delete delete_subop(bulk_ops::Delete::Mode::kMulti,
+                                std::move(selector));
+  (delete_subop.SetOption(std::forward<Options>(options)), ...);
+  Add(std::move(delete_subop), bytes);
+}
+
+}  // namespace storages::mongo
+
+USERVER_NAMESPACE_END
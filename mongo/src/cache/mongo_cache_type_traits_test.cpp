@@ -2,6 +2,7 @@
 
 #include <userver/cache/update_type.hpp>
 #include <userver/formats/bson/document.hpp>
+#include <userver/formats/bson/value.hpp>
 #include <userver/storages/mongo/operations.hpp>
 
 #include <gtest/gtest.h>
@@ -41,6 +42,20 @@ struct CorrectMongoCacheTraits {
       const std::chrono::system_clock::duration& correction);
 };
 
+struct CorrectChangeStreamMongoCacheTraits : CorrectMongoCacheTraits {
+  using KeyType = int;
+
+  static constexpr bool kUseChangeStream = true;
+
+  static KeyType GetKeyFromId(const formats::bson::Value& id);
+};
+
+struct IncorrectSignatureOfGetKeyFromId {
+  using KeyType = int;
+
+  static KeyType GetKeyFromId(const formats::bson::Document& id, int x);
+};
+
 struct IncorrectReturnTypeOfFindOperation {
   static int GetFindOperation(
       cache::UpdateType type,
@@ -71,8 +86,19 @@ TEST(CheckTraits, FindOperation) {
                IncorrectSignatureOfFindOperation>);
 }
 
+TEST(CheckTraits, ChangeStream) {
+  EXPECT_FALSE(mongo_cache::impl::UseChangeStream<CorrectMongoCacheTraits>());
+  EXPECT_TRUE(mongo_cache::impl::UseChangeStream<
+              CorrectChangeStreamMongoCacheTraits>());
+  EXPECT_TRUE(mongo_cache::impl::kHasCorrectGetKeyFromId<
+              CorrectChangeStreamMongoCacheTraits>);
+  EXPECT_FALSE(mongo_cache::impl::kHasCorrectGetKeyFromId<
+               IncorrectSignatureOfGetKeyFromId>);
+}
+
 TEST(CheckTraits, CorrectTraits) {
   mongo_cache::impl::CheckTraits<CorrectMongoCacheTraits>{};
+  mongo_cache::impl::CheckTraits<CorrectChangeStreamMongoCacheTraits>{};
 }
 
 USERVER_NAMESPACE_END
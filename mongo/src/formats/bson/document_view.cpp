@@ -0,0 +1,377 @@
+#include <userver/formats/bson/document_view.hpp>
+
+#include <cmath>
+#include <limits>
+
+#include <formats/bson/wrappers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::bson {
+namespace {
+
+constexpr uint32_t kEmptyDocSize = 5;
+constexpr uint8_t kEmptyDoc[kEmptyDocSize] = {kEmptyDocSize, 0, 0, 0, 0};
+
+constexpr std::int64_t kMaxIntDouble{std::int64_t{1}
+                                     << std::numeric_limits<double>::digits};
+
+constexpr std::string_view kRootPath = "/";
+
+bool FindMember(bson_iter_t& iter, std::string_view name) {
+  while (bson_iter_next(&iter)) {
+    if (bson_iter_key(&iter) == name) return true;
+  }
+  return false;
+}
+
+uint32_t CountElements(bson_iter_t& iter) {
+  uint32_t size = 0;
+  while (bson_iter_next(&iter)) ++size;
+  return size;
+}
+
+}  // namespace
+
+ElementView::ElementView(const bson_iter_t& iter)
+    : iter_(iter), is_missing_(false) {}
+
+ElementView ElementView::operator[](std::string_view name) const {
+  if (!IsMissing() && !IsNull()) {
+    if (!IsDocument()) {
+      throw TypeMismatchException(Type(), BSON_TYPE_DOCUMENT, GetPath());
+    }
+    bson_iter_t child;
+    if (Recurse(child) && FindMember(child, name)) return ElementView(child);
+  }
+  ElementView missing;
+  missing.missing_name_ = name;
+  return missing;
+}
+
+ElementView ElementView::operator[](uint32_t index) const {
+  if (IsNull()) throw OutOfBoundsException(index, 0, GetPath());
+  if (!IsArray()) {
+    throw TypeMismatchException(Type(), BSON_TYPE_ARRAY, GetPath());
+  }
+
+  bson_iter_t child;
+  if (Recurse(child)) {
+    for (uint32_t i = 0; bson_iter_next(&child); ++i) {
+      if (i == index) return ElementView(child);
+    }
+  }
+  throw OutOfBoundsException(index, GetSize(), GetPath());
+}
+
+bool ElementView::HasMember(std::string_view name) const {
+  return !(*this)[name].IsMissing();
+}
+
+ElementView::const_iterator ElementView::begin() const {
+  if (IsNull()) return {};
+  bson_iter_t child;
+  if (!Recurse(child)) {
+    throw TypeMismatchException(Type(), BSON_TYPE_DOCUMENT, GetPath());
+  }
+  return ViewIterator(child);
+}
+
+ElementView::const_iterator ElementView::end() const { return {}; }
+
+bool ElementView::IsEmpty() const {
+  if (IsNull()) return true;
+  return GetDocument().IsEmpty();
+}
+
+uint32_t ElementView::GetSize() const {
+  if (IsNull()) return 0;
+  return GetDocument().GetSize();
+}
+
+std::string ElementView::GetPath() const {
+  if (IsMissing()) return missing_name_;
+  return bson_iter_key(&iter_);
+}
+
+bool ElementView::IsMissing() const { return is_missing_; }
+bool ElementView::IsArray() const { return Type() == BSON_TYPE_ARRAY; }
+bool ElementView::IsDocument() const { return Type() == BSON_TYPE_DOCUMENT; }
+bool ElementView::IsNull() const { return Type() == BSON_TYPE_NULL; }
+bool ElementView::IsBool() const { return Type() == BSON_TYPE_BOOL; }
+bool ElementView::IsInt32() const { return Type() == BSON_TYPE_INT32; }
+
+bool ElementView::IsInt64() const {
+  return Type() == BSON_TYPE_INT64 || IsInt32();
+}
+
+bool ElementView::IsDouble() const {
+  return Type() == BSON_TYPE_DOUBLE || IsInt64();
+}
+
+bool ElementView::IsString() const { return Type() == BSON_TYPE_UTF8; }
+bool ElementView::IsDateTime() const { return Type() == BSON_TYPE_DATE_TIME; }
+bool ElementView::IsOid() const { return Type() == BSON_TYPE_OID; }
+bool ElementView::IsBinary() const { return Type() == BSON_TYPE_BINARY; }
+
+bool ElementView::IsDecimal128() const {
+  return Type() == BSON_TYPE_DECIMAL128;
+}
+
+bool ElementView::IsTimestamp() const { return Type() == BSON_TYPE_TIMESTAMP; }
+
+DocumentView ElementView::GetDocument() const {
+  CheckNotMissing();
+  const uint8_t* data = nullptr;
+  uint32_t size = 0;
+  if (IsDocument()) {
+    bson_iter_document(&iter_, &size, &data);
+  } else if (IsArray()) {
+    bson_iter_array(&iter_, &size, &data);
+  } else {
+    throw TypeMismatchException(Type(), BSON_TYPE_DOCUMENT, GetPath());
+  }
+  return {data, size};
+}
+
+Value ElementView::ToValue() const {
+  CheckNotMissing();
+  const auto* key = bson_iter_key(&iter_);
+  impl::MutableBson bson;
+  bson_append_iter(bson.Get(), key, -1, &iter_);
+  return Document(bson.Extract())[key];
+}
+
+void ElementView::CheckNotMissing() const {
+  if (IsMissing()) throw MemberMissingException(GetPath());
+}
+
+void ElementView::CheckArrayOrNull() const {
+  CheckNotMissing();
+  if (!IsArray() && !IsNull()) {
+    throw TypeMismatchException(Type(), BSON_TYPE_ARRAY, GetPath());
+  }
+}
+
+void ElementView::CheckDocumentOrNull() const {
+  CheckNotMissing();
+  if (!IsDocument() && !IsNull()) {
+    throw TypeMismatchException(Type(), BSON_TYPE_DOCUMENT, GetPath());
+  }
+}
+
+bson_type_t ElementView::Type() const {
+  return IsMissing() ? BSON_TYPE_EOD : bson_iter_type(&iter_);
+}
+
+bool ElementView::Recurse(bson_iter_t& child) const {
+  if (IsMissing() || (!IsDocument() && !IsArray())) return false;
+  return bson_iter_recurse(&iter_, &child);
+}
+
+ViewIterator::ViewIterator(const bson_iter_t& iter) : current_(iter) {
+  if (!bson_iter_next(&current_.iter_)) current_ = ElementView{};
+}
+
+ViewIterator ViewIterator::operator++(int) {
+  auto old = *this;
+  ++*this;
+  return old;
+}
+
+ViewIterator& ViewIterator::operator++() {
+  if (!bson_iter_next(&current_.iter_)) current_ = ElementView{};
+  ++index_;
+  return *this;
+}
+
+bool ViewIterator::operator==(const ViewIterator& rhs) const {
+  if (current_.IsMissing() || rhs.current_.IsMissing()) {
+    return current_.IsMissing() == rhs.current_.IsMissing();
+  }
+  return current_.iter_.raw == rhs.current_.iter_.raw &&
+         current_.iter_.off == rhs.current_.iter_.off;
+}
+
+std::string_view ViewIterator::GetName() const {
+  return bson_iter_key(&current_.iter_);
+}
+
+DocumentView::DocumentView() : DocumentView(kEmptyDoc, kEmptyDocSize) {}
+
+DocumentView::DocumentView(const Document& doc)
+    : DocumentView(doc.GetBson().get()) {}
+
+DocumentView::DocumentView(const bson_t* bson)
+    : DocumentView(bson_get_data(bson), bson->len) {}
+
+DocumentView::DocumentView(const uint8_t* data, std::size_t size)
+    : data_(data), size_(size) {}
+
+ElementView DocumentView::operator[](std::string_view name) const {
+  auto iter = Init();
+  if (FindMember(iter, name)) return ElementView(iter);
+
+  return ElementView{}[name];
+}
+
+bool DocumentView::HasMember(std::string_view name) const {
+  auto iter = Init();
+  return FindMember(iter, name);
+}
+
+DocumentView::const_iterator DocumentView::begin() const {
+  return ViewIterator(Init());
+}
+
+DocumentView::const_iterator DocumentView::end() const { return {}; }
+
+bool DocumentView::IsEmpty() const { return size_ <= kEmptyDocSize; }
+
+uint32_t DocumentView::GetSize() const {
+  auto iter = Init();
+  return CountElements(iter);
+}
+
+std::string DocumentView::GetPath() const { return std::string{kRootPath}; }
+
+Document DocumentView::ToDocument() const {
+  return Document(impl::MutableBson(data_, size_).Extract());
+}
+
+bson_iter_t DocumentView::Init() const {
+  bson_iter_t iter;
+  if (!bson_iter_init_from_data(&iter, data_, size_)) {
+    throw formats::bson::ParseException("malformed BSON document");
+  }
+  return iter;
+}
+
+bool Parse(const ElementView& view, parse::To<bool>) {
+  view.CheckNotMissing();
+  if (view.IsBool()) return bson_iter_bool(&view.iter_);
+  throw TypeMismatchException(view.Type(), BSON_TYPE_BOOL, view.GetPath());
+}
+
+int64_t Parse(const ElementView& view, parse::To<int64_t>) {
+  view.CheckNotMissing();
+  if (view.IsInt32()) return bson_iter_int32(&view.iter_);
+  if (view.IsInt64()) return bson_iter_int64(&view.iter_);
+  if (view.IsDouble()) {
+    const auto as_double = bson_iter_double(&view.iter_);
+    double int_part = 0.0;
+    auto frac_part = std::modf(as_double, &int_part);
+    if (frac_part || std::abs(as_double) >= kMaxIntDouble) {
+      throw ConversionException("Conversion of ")
+          << view.GetPath() << '=' << as_double
+          << " to integer causes precision change";
+    }
+    return static_cast<int64_t>(as_double);
+  }
+  throw TypeMismatchException(view.Type(), BSON_TYPE_INT64, view.GetPath());
+}
+
+uint64_t Parse(const ElementView& view, parse::To<uint64_t>) {
+  const auto as_int = view.As<int64_t>();
+  if (as_int < 0) {
+    throw ConversionException("Cannot convert to unsigned value from negative ")
+        << view.GetPath() << '=' << as_int;
+  }
+  return static_cast<uint64_t>(as_int);
+}
+
+double Parse(const ElementView& view, parse::To<double>) {
+  view.CheckNotMissing();
+  if (view.IsInt32()) return bson_iter_int32(&view.iter_);
+  if (view.IsInt64()) {
+    const auto as_int = bson_iter_int64(&view.iter_);
+    if (as_int == std::numeric_limits<int64_t>::min() ||
+        std::abs(as_int) > kMaxIntDouble) {
+      throw ConversionException("Conversion of ")
+          << view.GetPath() << '=' << as_int
+          << " to double causes precision loss";
+    }
+    return static_cast<double>(as_int);
+  }
+  if (view.IsDouble()) return bson_iter_double(&view.iter_);
+  throw TypeMismatchException(view.Type(), BSON_TYPE_DOUBLE, view.GetPath());
+}
+
+std::string Parse(const ElementView& view, parse::To<std::string>) {
+  view.CheckNotMissing();
+  if (view.IsString()) {
+    uint32_t size = 0;
+    const char* str = bson_iter_utf8(&view.iter_, &size);
+    return {str, size};
+  }
+  throw TypeMismatchException(view.Type(), BSON_TYPE_UTF8, view.GetPath());
+}
+
+std::chrono::system_clock::time_point Parse(
+    const ElementView& view, parse::To<std::chrono::system_clock::time_point>) {
+  view.CheckNotMissing();
+  if (view.IsDateTime()) {
+    return std::chrono::system_clock::time_point(
+        std::chrono::milliseconds(bson_iter_date_time(&view.iter_)));
+  }
+  throw TypeMismatchException(view.Type(), BSON_TYPE_DATE_TIME,
+                              view.GetPath());
+}
+
+Oid Parse(const ElementView& view, parse::To<Oid>) {
+  view.CheckNotMissing();
+  if (view.IsOid()) return *bson_iter_oid(&view.iter_);
+  throw TypeMismatchException(view.Type(), BSON_TYPE_OID, view.GetPath());
+}
+
+Binary Parse(const ElementView& view, parse::To<Binary>) {
+  view.CheckNotMissing();
+  if (view.IsBinary()) {
+    bson_subtype_t subtype{};
+    uint32_t size = 0;
+    const uint8_t* data = nullptr;
+    bson_iter_binary(&view.iter_, &subtype, &size, &data);
+    return Binary(std::string(reinterpret_cast<const char*>(data), size));
+  }
+  throw TypeMismatchException(view.Type(), BSON_TYPE_BINARY, view.GetPath());
+}
+
+Decimal128 Parse(const ElementView& view, parse::To<Decimal128>) {
+  view.CheckNotMissing();
+  if (view.IsDecimal128()) {
+    bson_decimal128_t value;
+    bson_iter_decimal128(&view.iter_, &value);
+    return value;
+  }
+  throw TypeMismatchException(view.Type(), BSON_TYPE_DECIMAL128,
+                              view.GetPath());
+}
+
+Timestamp Parse(const ElementView& view, parse::To<Timestamp>) {
+  view.CheckNotMissing();
+  if (view.IsTimestamp()) {
+    uint32_t timestamp = 0;
+    uint32_t increment = 0;
+    bson_iter_timestamp(&view.iter_, &timestamp, &increment);
+    return {timestamp, increment};
+  }
+  throw TypeMismatchException(view.Type(), BSON_TYPE_TIMESTAMP,
+                              view.GetPath());
+}
+
+Document Parse(const ElementView& view, parse::To<Document>) {
+  view.CheckNotMissing();
+  if (!view.IsDocument()) {
+    throw TypeMismatchException(view.Type(), BSON_TYPE_DOCUMENT,
+                                view.GetPath());
+  }
+  return view.GetDocument().ToDocument();
+}
+
+Value Parse(const ElementView& view, parse::To<Value>) {
+  return view.ToValue();
+}
+
+}  // namespace formats::bson
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,161 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/formats/bson.hpp>
+#include <userver/formats/bson/document_view.hpp>
+#include <userver/utest/assert_macros.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fb = formats::bson;
+
+namespace {
+
+const auto kDoc =
+    fb::MakeDoc("arr", fb::MakeArray(1, "elem", fb::MinKey{}),      //
+                "doc", fb::MakeDoc("b", true, "i", 0, "d", -1.25),  //
+                "null", nullptr,                                    //
+                "bool", false,                                      //
+                "str", "string",                                    //
+                "big", int64_t{1} << 60);
+
+struct Point {
+  int x;
+  int y;
+};
+
+Point Parse(const fb::DocumentView& doc, formats::parse::To<Point>) {
+  return {doc["x"].As<int>(), doc["y"].As<int>()};
+}
+
+struct Legacy {
+  std::string value;
+};
+
+Legacy Parse(const fb::Value& value, formats::parse::To<Legacy>) {
+  return {value["value"].As<std::string>()};
+}
+
+}  // namespace
+
+TEST(BsonDocumentView, SubvalAccess) {
+  const fb::DocumentView view{kDoc};
+  EXPECT_FALSE(view.IsEmpty());
+  EXPECT_EQ(6, view.GetSize());
+
+  EXPECT_TRUE(view["missing"].IsMissing());
+  EXPECT_FALSE(view.HasMember("missing"));
+  EXPECT_TRUE(view.HasMember("arr"));
+  EXPECT_TRUE(view["arr"].IsArray());
+  EXPECT_TRUE(view["doc"].IsDocument());
+  EXPECT_TRUE(view["null"].IsNull());
+  UEXPECT_THROW(view["arr"]["1"], fb::TypeMismatchException);
+  EXPECT_TRUE(view["doc"]["?"].IsMissing());
+  EXPECT_TRUE(view["missing"]["?"].IsMissing());
+  EXPECT_TRUE(view["null"]["?"].IsMissing());
+  EXPECT_EQ("?", view["doc"]["?"].GetPath());
+}
+
+TEST(BsonDocumentView, Scalars) {
+  const fb::DocumentView view{kDoc};
+  EXPECT_FALSE(view["bool"].As<bool>());
+  EXPECT_EQ("string", view["str"].As<std::string>());
+  EXPECT_TRUE(view["doc"]["b"].As<bool>());
+  EXPECT_EQ(0, view["doc"]["i"].As<int>());
+  EXPECT_EQ(-1.25, view["doc"]["d"].As<double>());
+  EXPECT_EQ(0.0, view["doc"]["i"].As<double>());
+  EXPECT_EQ(int64_t{1} << 60, view["big"].As<int64_t>());
+
+  UEXPECT_THROW(view["doc"]["d"].As<int>(), fb::ConversionException);
+  UEXPECT_THROW(view["doc"]["d"].As<unsigned>(), fb::ConversionException);
+  UEXPECT_THROW(view["big"].As<int32_t>(), fb::ConversionException);
+  UEXPECT_THROW(view["str"].As<int>(), fb::TypeMismatchException);
+  UEXPECT_THROW(view["missing"].As<int>(), fb::MemberMissingException);
+
+  EXPECT_EQ(42, view["missing"].As<int>(42));
+  EXPECT_EQ(42, view["null"].As<int>(42));
+  EXPECT_EQ(0, view["missing"].As<int>({}));
+  EXPECT_EQ(std::nullopt, view["missing"].As<std::optional<int>>());
+}
+
+TEST(BsonDocumentView, Array) {
+  const auto arr = fb::DocumentView{kDoc}["arr"];
+  EXPECT_FALSE(arr.IsEmpty());
+  ASSERT_EQ(3, arr.GetSize());
+
+  EXPECT_EQ(1, arr[0].As<int>());
+  EXPECT_EQ("elem", arr[1].As<std::string>());
+  UEXPECT_THROW(arr[3], fb::OutOfBoundsException);
+
+  uint32_t i = 0;
+  for (auto it = arr.begin(); it != arr.end(); ++it, ++i) {
+    EXPECT_EQ(i, it.GetIndex());
+    EXPECT_EQ(std::to_string(i), it.GetName());
+  }
+  EXPECT_EQ(3, i);
+
+  UEXPECT_THROW(arr.As<std::vector<int>>(), fb::TypeMismatchException);
+  EXPECT_EQ((std::vector<int>{1, 2}),
+            fb::DocumentView{fb::MakeDoc("a", fb::MakeArray(1, 2))}["a"]
+                .As<std::vector<int>>());
+}
+
+TEST(BsonDocumentView, Document) {
+  const auto doc = fb::DocumentView{kDoc}["doc"];
+  std::vector<std::string> names;
+  for (auto it = doc.begin(); it != doc.end(); ++it) {
+    names.emplace_back(it.GetName());
+  }
+  EXPECT_EQ((std::vector<std::string>{"b", "i", "d"}), names);
+
+  EXPECT_EQ(fb::Document(kDoc["doc"]), doc.As<fb::Document>());
+  EXPECT_EQ(kDoc["doc"], doc.ToValue());
+  EXPECT_EQ(kDoc, fb::DocumentView{kDoc}.ToDocument());
+
+  const auto empty = fb::DocumentView{};
+  EXPECT_TRUE(empty.IsEmpty());
+  EXPECT_EQ(0, empty.GetSize());
+  EXPECT_EQ(empty.begin(), empty.end());
+}
+
+TEST(BsonDocumentView, UserTypes) {
+  const auto doc = fb::MakeDoc(
+      "point", fb::MakeDoc("x", 1, "y", -1),                 //
+      "points", fb::MakeArray(fb::MakeDoc("x", 2, "y", 3)),  //
+      "legacy", fb::MakeDoc("value", "old"),                 //
+      "map", fb::MakeDoc("one", 1, "two", 2));
+  const fb::DocumentView view{doc};
+
+  const auto point = view["point"].As<Point>();
+  EXPECT_EQ(1, point.x);
+  EXPECT_EQ(-1, point.y);
+
+  const auto points = view["points"].As<std::vector<Point>>();
+  ASSERT_EQ(1, points.size());
+  EXPECT_EQ(3, points[0].y);
+
+  EXPECT_EQ("old", view["legacy"].As<Legacy>().value);
+  using Map = std::map<std::string, int>;
+  EXPECT_EQ((Map{{"one", 1}, {"two", 2}}), view["map"].As<Map>());
+}
+
+/// [Sample DocumentView usage]
+TEST(BsonDocumentView, Example) {
+  const auto doc = fb::MakeDoc("name", "userver", "tags",
+                               fb::MakeArray("fast", "async"));
+
+  // The view must not outlive `doc`
+  const fb::DocumentView view{doc};
+  EXPECT_EQ("userver", view["name"].As<std::string>());
+
+  std::vector<std::string> tags;
+  for (const auto& tag : view["tags"]) tags.push_back(tag.As<std::string>());
+  EXPECT_EQ((std::vector<std::string>{"fast", "async"}), tags);
+}
+/// [Sample DocumentView usage]
+
+USERVER_NAMESPACE_END
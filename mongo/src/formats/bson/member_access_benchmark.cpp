@@ -1,6 +1,7 @@
 #include <benchmark/benchmark.h>
 
 #include <userver/formats/bson.hpp>
+#include <userver/formats/bson/document_view.hpp>
 #include <userver/formats/bson/serialize.hpp>
 #include <userver/formats/json.hpp>
 
@@ -115,4 +116,21 @@ void bson_path_first_access(benchmark::State& state) {
 }
 BENCHMARK(bson_path_first_access);
 
+void bson_view_path_first_access(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto bson = formats::bson::FromJsonString(bench_bson_data);
+    state.ResumeTiming();
+
+    const formats::bson::DocumentView view{bson};
+    const auto res =
+        (view["nested_very_long_long_long_long_path"]["deeply"]["deeply"]
+             ["nested"]["bson"]["value"]["with"]["some"]["data"]
+                 .As<std::string>() == "4");
+    benchmark::DoNotOptimize(res);
+    if (!res) throw std::runtime_error("unexpected");
+  }
+}
+BENCHMARK(bson_view_path_first_access);
+
 USERVER_NAMESPACE_END
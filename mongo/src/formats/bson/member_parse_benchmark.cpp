@@ -1,6 +1,7 @@
 #include <benchmark/benchmark.h>
 
 #include <userver/formats/bson.hpp>
+#include <userver/formats/bson/document_view.hpp>
 #include <userver/formats/bson/serialize.hpp>
 #include <userver/formats/json.hpp>
 
@@ -124,26 +125,29 @@ struct Profile {
   models::ClassesGrade grades;
 };
 
-models::DriverId Parse(const formats::bson::Value& val, To<models::DriverId>) {
+template <typename BsonValue>
+models::DriverId Parse(const BsonValue& val, To<models::DriverId>) {
   models::DriverId driver_id;
-  driver_id.uuid = val[names::kUuid].As<std::string>();
-  driver_id.dbid = val[names::kUuid].As<std::string>();  // changed
+  driver_id.uuid = val[names::kUuid].template As<std::string>();
+  driver_id.dbid = val[names::kUuid].template As<std::string>();  // changed
   return driver_id;
 }
 
-models::ProfileCar Parse(const formats::bson::Value& val,
-                         To<models::ProfileCar>) {
+template <typename BsonValue>
+models::ProfileCar Parse(const BsonValue& val, To<models::ProfileCar>) {
   models::ProfileCar car;
-  car.number = val[names::car::kNumber].As<std::string>();
-  car.model = val[names::car::kModel].As<std::string>(std::string{});
-  car.mark_code = val[names::car::kMarkCode].As<std::string>(std::string{});
-  car.age = val[names::car::kAge].As<short>(0);
-  car.price = val[names::car::kPrice].As<double>(0);
+  car.number = val[names::car::kNumber].template As<std::string>();
+  car.model = val[names::car::kModel].template As<std::string>(std::string{});
+  car.mark_code =
+      val[names::car::kMarkCode].template As<std::string>(std::string{});
+  car.age = val[names::car::kAge].template As<short>(0);
+  car.price = val[names::car::kPrice].template As<double>(0);
   return car;
 }
 
+template <typename BsonValue>
 models::Requirements::ChildSeats Parse(
-    const formats::bson::Value& bson,
+    const BsonValue& bson,
     formats::parse::To<models::Requirements::ChildSeats>) {
   if (!bson.IsArray()) return {};
 
@@ -154,7 +158,7 @@ models::Requirements::ChildSeats Parse(
     models::Requirements::ChildSeat seat;
     for (const auto& chair_class : chair_supported_classes) {
       if (!chair_class.IsInt64()) return seats;
-      seat.push_back(chair_class.As<short>());
+      seat.push_back(chair_class.template As<short>());
     }
 
     std::sort(seat.begin(), seat.end());
@@ -164,47 +168,48 @@ models::Requirements::ChildSeats Parse(
   return seats;
 }
 
-models::Requirements Parse(const formats::bson::Value& bson,
-                           To<models::Requirements>) {
+template <typename BsonValue>
+models::Requirements Parse(const BsonValue& bson, To<models::Requirements>) {
   models::Requirements result;
 
   for (auto it = bson.begin(); it != bson.end(); ++it) {
-    const std::string& name = it.GetName();
+    const std::string name{it.GetName()};
 
     if (name == names::requirements::kChildSeats)
-      result.Add(name, it->As<models::Requirements::ChildSeats>());
+      result.Add(name, it->template As<models::Requirements::ChildSeats>());
     else if (it->IsBool())
-      result.Add(name, it->As<bool>());
+      result.Add(name, it->template As<bool>());
     else if (it->IsInt64())
-      result.Add(name, it->As<short>());
+      result.Add(name, it->template As<short>());
   }
 
   return result;
 }
 
-models::ClassesGrade Parse(const formats::bson::Value& bson,
-                           To<models::ClassesGrade>) {
+template <typename BsonValue>
+models::ClassesGrade Parse(const BsonValue& bson, To<models::ClassesGrade>) {
   bson.CheckArrayOrNull();
   models::ClassesGrade ret;
   for (const auto& el : bson) {
-    const auto class_name = el[names::kGradeClass].As<std::string>();
+    const auto class_name = el[names::kGradeClass].template As<std::string>();
     const auto value =
-        el[names::kGradeValue].As<models::ClassesGrade::value_t>();
+        el[names::kGradeValue].template As<models::ClassesGrade::value_t>();
     ret.Set(class_name, value);
   }
   return ret;
 }
 
-models::Profile Parse(const formats::bson::Value& val, To<models::Profile>) {
+template <typename BsonValue>
+models::Profile Parse(const BsonValue& val, To<models::Profile>) {
   models::Profile profile;
-  profile.driver_id = val.As<models::DriverId>();
-  profile.car = val[names::kCar].As<models::ProfileCar>();
-  profile.license = val[names::kLicense].As<std::string>();
+  profile.driver_id = val.template As<models::DriverId>();
+  profile.car = val[names::kCar].template As<models::ProfileCar>();
+  profile.license = val[names::kLicense].template As<std::string>();
   profile.available_requirements =
-      val[names::kRequirements].As<models::Requirements>(
+      val[names::kRequirements].template As<models::Requirements>(
           models::Requirements{});
-  profile.grades =
-      val[names::kGrades].As<models::ClassesGrade>(models::ClassesGrade{});
+  profile.grades = val[names::kGrades].template As<models::ClassesGrade>(
+      models::ClassesGrade{});
   return profile;
 }
 
@@ -239,4 +244,16 @@ void bson_parse_access(benchmark::State& state) {
 }
 BENCHMARK(bson_parse_access);
 
+void bson_parse_view(benchmark::State& state) {
+  static unsigned i = 0;
+
+  for (auto _ : state) {
+    auto bson = formats::bson::Document(bench_bson_data[++i % kBenchRows]);
+
+    const auto res = formats::bson::DocumentView{bson}.As<models::Profile>();
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(bson_parse_view);
+
 USERVER_NAMESPACE_END
@@ -5,7 +5,9 @@
 #include <netinet/tcp.h>
 #include <poll.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cerrno>
@@ -43,6 +45,9 @@ namespace {
 // chosen empirically as the best performance for size (16K-32K)
 constexpr size_t kBufferSize = 32 * 1024;
 
+// mongoc reads into one or two buffers, the last entry is for the excess
+constexpr size_t kMaxRecvIovecs = 8;
+
 constexpr int kCompatibleMajorVersion = 1;
 constexpr int kMaxCompatibleMinorVersion = 21;  // Tested on Fedora, works
 
@@ -80,8 +85,9 @@ class AsyncStream : public mongoc_stream_t {
   AsyncStream(engine::io::Socket) noexcept;
 
   // mongoc_stream_buffered resizes itself indiscriminately
-  // NOTE: returns number of bytes stored to data, not buffered!
-  size_t BufferedRecv(void* data, size_t size, size_t min_bytes,
+  // Reads into the caller buffers directly, the excess is buffered.
+  // NOTE: returns number of bytes stored to iov, not buffered!
+  size_t BufferedRecv(mongoc_iovec_t* iov, size_t iovcnt, size_t min_bytes,
                       engine::Deadline deadline);
 
   // mongoc_stream_t interface
@@ -370,49 +376,64 @@ AsyncStream::AsyncStream(engine::io::Socket socket) noexcept
   should_retry = &ShouldRetry;
 }
 
-size_t AsyncStream::BufferedRecv(void* data, size_t size, size_t min_bytes,
-                                 engine::Deadline deadline) {
+size_t AsyncStream::BufferedRecv(mongoc_iovec_t* iov, size_t iovcnt,
+                                 size_t min_bytes, engine::Deadline deadline) {
   size_t bytes_stored = 0;
-  size_t bytes_left = size;
-  char* pos = static_cast<char*>(data);
+  size_t curr_iov = 0;
+  const auto advance = [&](size_t bytes) {
+    bytes_stored += bytes;
+    while (bytes) {
+      UASSERT(curr_iov < iovcnt);
+      auto& current = iov[curr_iov];
+      const auto step = std::min(bytes, current.iov_len);
+      current.iov_base = static_cast<char*>(current.iov_base) + step;
+      current.iov_len -= step;
+      bytes -= step;
+      if (!current.iov_len) ++curr_iov;
+    }
+  };
+
   try {
-    while ((bytes_stored < min_bytes || !bytes_stored) && bytes_left) {
-      size_t iter_bytes_stored = 0;
-      const size_t old_recv_buffer_bytes_used = recv_buffer_bytes_used_;
-      if (recv_buffer_bytes_used_) {
-        // has pending data
-        UASSERT(recv_buffer_pos_ <= recv_buffer_bytes_used_);
-        const auto batch_size =
-            std::min(bytes_left, recv_buffer_bytes_used_ - recv_buffer_pos_);
+    while (true) {
+      while (curr_iov < iovcnt && !iov[curr_iov].iov_len) ++curr_iov;
+      if (curr_iov == iovcnt || (bytes_stored >= min_bytes && bytes_stored)) {
+        break;
+      }
 
-        std::memcpy(pos, recv_buffer_.data() + recv_buffer_pos_, batch_size);
-        iter_bytes_stored = batch_size;
+      if (recv_buffer_pos_ < recv_buffer_bytes_used_) {
+        // has pending data
+        auto& current = iov[curr_iov];
+        const auto batch_size = std::min(
+            current.iov_len, recv_buffer_bytes_used_ - recv_buffer_pos_);
+        std::memcpy(current.iov_base, recv_buffer_.data() + recv_buffer_pos_,
+                    batch_size);
         recv_buffer_pos_ += batch_size;
-
-        UASSERT(recv_buffer_pos_ <= recv_buffer_bytes_used_);
-        if (recv_buffer_pos_ == recv_buffer_bytes_used_) {
-          recv_buffer_pos_ = 0;
-          recv_buffer_bytes_used_ = 0;
-        }
-      } else {
-        UASSERT(!recv_buffer_pos_);
-        if (bytes_left < recv_buffer_.size()) {
-          // no pending data, can be buffered
-          recv_buffer_bytes_used_ += socket_.RecvSome(
-              recv_buffer_.data(), recv_buffer_.size(), deadline);
-          UASSERT(recv_buffer_bytes_used_ <= recv_buffer_.size());
-          if (!recv_buffer_bytes_used_) break;  // EOF
-        } else {
-          // no pending data, will overflow the buffer, stream directly
-          const auto batch_size = bytes_left - bytes_left % recv_buffer_.size();
-          iter_bytes_stored = socket_.RecvSome(pos, batch_size, deadline);
-        }
+        advance(batch_size);
+        continue;
+      }
+      recv_buffer_pos_ = 0;
+      recv_buffer_bytes_used_ = 0;
+
+      // no pending data, receive into the caller buffers first and
+      // into the internal one whatever does not fit there
+      std::array<struct iovec, kMaxRecvIovecs> recv_iov{};
+      size_t recv_iovcnt = 0;
+      size_t direct_bytes = 0;
+      for (auto i = curr_iov; i < iovcnt && recv_iovcnt + 1 < recv_iov.size();
+           ++i) {
+        recv_iov[recv_iovcnt++] = {iov[i].iov_base, iov[i].iov_len};
+        direct_bytes += iov[i].iov_len;
       }
-      UASSERT(iter_bytes_stored ||
-              (recv_buffer_bytes_used_ > old_recv_buffer_bytes_used));
-      bytes_left -= iter_bytes_stored;
-      bytes_stored += iter_bytes_stored;
-      pos += iter_bytes_stored;
+      recv_iov[recv_iovcnt++] = {recv_buffer_.data(), recv_buffer_.size()};
+
+      const auto received =
+          socket_.RecvSome(recv_iov.data(), recv_iovcnt, deadline);
+      if (!received) break;  // EOF
+
+      const auto received_direct = std::min(received, direct_bytes);
+      advance(received_direct);
+      recv_buffer_bytes_used_ = received - received_direct;
+      UASSERT(recv_buffer_bytes_used_ <= recv_buffer_.size());
     }
   } catch (const engine::io::IoTimeout& timeout_ex) {
     // adjust the counter
@@ -525,20 +546,7 @@ ssize_t AsyncStream::Readv(mongoc_stream_t* stream, mongoc_iovec_t* iov,
   size_t recvd_total = 0;
   try {
     engine::TaskCancellationBlocker block_cancel;
-    size_t curr_iov = 0;
-    while (curr_iov < iovcnt && (min_bytes > recvd_total || !recvd_total)) {
-      const auto recvd_now =
-          self->BufferedRecv(iov[curr_iov].iov_base, iov[curr_iov].iov_len,
-                             min_bytes - recvd_total, deadline);
-      if (!recvd_now) break;  // EOF
-      recvd_total += recvd_now;
-
-      iov[curr_iov].iov_base =
-          reinterpret_cast<char*>(iov[curr_iov].iov_base) + recvd_now;
-      iov[curr_iov].iov_len -= recvd_now;
-
-      if (!iov[curr_iov].iov_len) ++curr_iov;
-    }
+    recvd_total = self->BufferedRecv(iov, iovcnt, min_bytes, deadline);
   } catch (const engine::io::IoCancelled&) {
     UASSERT_MSG(false,
                 "Cancellation is not supported in cdriver implementation");
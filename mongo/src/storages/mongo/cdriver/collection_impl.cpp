@@ -15,11 +15,13 @@
 #include <userver/utils/text.hpp>
 
 #include <formats/bson/wrappers.hpp>
+#include <storages/mongo/cdriver/change_stream_impl.hpp>
 #include <storages/mongo/cdriver/cursor_impl.hpp>
 #include <storages/mongo/cdriver/pool_impl.hpp>
 #include <storages/mongo/cdriver/wrappers.hpp>
 #include <storages/mongo/operations_common.hpp>
 #include <storages/mongo/operations_impl.hpp>
+#include <storages/mongo/prefetching_cursor_impl.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -30,6 +32,8 @@ const std::string kCancelledByDeadlineTag = "cancelled_by_deadline";
 const std::string kCancelledTag = "cancelled";
 const std::string kMaxTimeMsTag = "max_time_ms";
 
+constexpr size_t kDefaultPrefetchBytes = 4 * 1024 * 1024;
+
 class WriteResultHelper {
  public:
   bson_t* GetNative() { return bson_.Get(); }
@@ -266,9 +270,16 @@ Cursor CDriverCollectionImpl::Execute(const operations::Find& operation) const {
   impl::cdriver::CursorPtr cdriver_cursor(mongoc_collection_find_with_opts(
       context.collection.get(), native_filter_bson_ptr,
       impl::GetNative(options), operation.impl_->read_prefs.Get()));
-  return Cursor(std::make_unique<impl::cdriver::CDriverCursorImpl>(
-      std::move(context.client), std::move(cdriver_cursor),
-      std::move(context.stats)));
+  std::unique_ptr<impl::CursorImpl> cursor =
+      std::make_unique<impl::cdriver::CDriverCursorImpl>(
+          std::move(context.client), std::move(cdriver_cursor),
+          std::move(context.stats), operation.impl_->target_batch_bytes);
+  if (operation.impl_->prefetch) {
+    cursor = std::make_unique<impl::PrefetchingCursorImpl>(
+        std::move(cursor), operation.impl_->target_batch_bytes.value_or(
+                               kDefaultPrefetchBytes));
+  }
+  return Cursor(std::move(cursor));
 }
 
 WriteResult CDriverCollectionImpl::Execute(
@@ -535,6 +546,30 @@ Cursor CDriverCollectionImpl::Execute(const operations::Aggregate& operation) {
       impl::GetNative(options), operation.impl_->read_prefs.Get()));
   return Cursor(std::make_unique<impl::cdriver::CDriverCursorImpl>(
       std::move(context.client), std::move(cdriver_cursor),
+      std::move(context.stats), std::nullopt));
+}
+
+ChangeStream CDriverCollectionImpl::Execute(
+    const operations::Watch& operation) const {
+  auto context = MakeRequestContext("mongo_watch", operation);
+
+  auto options = operation.impl_->options;
+  bool has_comment_option = operation.impl_->has_comment_option;
+  if (!has_comment_option)
+    SetLinkComment(impl::EnsureBuilder(options), has_comment_option);
+
+  // the stream copies the read preferences of the collection
+  if (operation.impl_->read_prefs) {
+    mongoc_collection_set_read_prefs(context.collection.get(),
+                                     operation.impl_->read_prefs.Get());
+  }
+
+  auto pipeline_doc = operation.impl_->pipeline.GetInternalArrayDocument();
+  impl::cdriver::ChangeStreamPtr cdriver_stream(mongoc_collection_watch(
+      context.collection.get(), pipeline_doc.GetBson().get(),
+      impl::GetNative(options)));
+  return ChangeStream(std::make_unique<impl::cdriver::CDriverChangeStreamImpl>(
+      std::move(context.client), std::move(cdriver_stream),
       std::move(context.stats)));
 }
 
@@ -1,5 +1,8 @@
 #include <storages/mongo/cdriver/cursor_impl.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
 
 #include <bson/bson.h>
@@ -27,10 +30,12 @@ namespace storages::mongo::impl::cdriver {
 
 CDriverCursorImpl::CDriverCursorImpl(
     cdriver::CDriverPoolImpl::BoundClientPtr client, cdriver::CursorPtr cursor,
-    std::shared_ptr<stats::OperationStatisticsItem> find_stats)
+    std::shared_ptr<stats::OperationStatisticsItem> find_stats,
+    std::optional<size_t> target_batch_bytes)
     : client_(std::move(client)),
       cursor_(std::move(cursor)),
-      find_stats_(std::move(find_stats)) {
+      find_stats_(std::move(find_stats)),
+      target_batch_bytes_(target_batch_bytes) {
   if (cursor_) {
     // Precondition: we've got a valid cursor (it could be errored-out right
     // away due to stream selection error, for example).
@@ -44,7 +49,9 @@ CDriverCursorImpl::CDriverCursorImpl(
   Next();
 }
 
-bool CDriverCursorImpl::IsValid() const { return cursor_ || current_; }
+bool CDriverCursorImpl::IsValid() const {
+  return cursor_ || current_bson_ || current_;
+}
 
 bool CDriverCursorImpl::HasMore() const {
   return cursor_ && mongoc_cursor_more(cursor_.get());
@@ -52,13 +59,24 @@ bool CDriverCursorImpl::HasMore() const {
 
 const formats::bson::Document& CDriverCursorImpl::Current() const {
   if (!IsValid()) throw std::logic_error("Reading from invalid cursor");
+  if (!current_ && current_bson_) {
+    current_ = formats::bson::Document(
+        formats::bson::impl::MutableBson::CopyNative(current_bson_).Extract());
+  }
   return *current_;
 }
 
+formats::bson::DocumentView CDriverCursorImpl::CurrentView() const {
+  if (!IsValid()) throw std::logic_error("Reading from invalid cursor");
+  if (current_) return *current_;
+  return formats::bson::DocumentView(current_bson_);
+}
+
 void CDriverCursorImpl::Next() {
   if (!IsValid()) throw std::logic_error("Advancing cursor past the end");
 
   current_ = std::nullopt;
+  current_bson_ = nullptr;
   if (!HasMore()) {
     UASSERT(!cursor_ && !client_);
     return;
@@ -68,15 +86,11 @@ void CDriverCursorImpl::Next() {
   const auto batch_num_before = mongoc_cursor_get_batch_num(cursor_.get());
   stats::OperationStopwatch cursor_next_sw(find_stats_, "find");
 
-  const bson_t* current_bson = nullptr;
   MongoError error;
   while (!mongoc_cursor_error(cursor_.get(), error.GetNative()) && HasMore()) {
-    if (mongoc_cursor_next(cursor_.get(), &current_bson)) {
-      current_ = formats::bson::Document(
-          formats::bson::impl::MutableBson::CopyNative(current_bson).Extract());
-      break;
-    }
+    if (mongoc_cursor_next(cursor_.get(), &current_bson_)) break;
   }
+  if (target_batch_bytes_ && current_bson_) TuneBatchSize();
   if (batch_num_before == mongoc_cursor_get_batch_num(cursor_.get())) {
     cursor_next_sw.Discard();
   } else if (!error) {
@@ -85,6 +99,11 @@ void CDriverCursorImpl::Next() {
     cursor_next_sw.AccountError(error.GetKind());
   }
   if (!HasMore()) {
+    // the last document must outlive the cursor owning its buffer
+    if (current_bson_) {
+      Current();
+      current_bson_ = nullptr;
+    }
     cursor_.reset();
     client_.reset();
   }
@@ -93,6 +112,24 @@ void CDriverCursorImpl::Next() {
   }
 }
 
+void CDriverCursorImpl::TuneBatchSize() {
+  UASSERT(cursor_ && current_bson_);
+  received_bytes_ += current_bson_->len;
+  ++received_count_;
+
+  // Once per batch, before its getMore is sent
+  const auto batch_num = mongoc_cursor_get_batch_num(cursor_.get());
+  if (tuned_batch_num_ == batch_num) return;
+  tuned_batch_num_ = batch_num;
+
+  const auto average_size =
+      std::max<size_t>(received_bytes_ / received_count_, 1);
+  const auto batch_size = std::clamp<size_t>(
+      *target_batch_bytes_ / average_size, 1,
+      std::numeric_limits<uint32_t>::max());
+  mongoc_cursor_set_batch_size(cursor_.get(), batch_size);
+}
+
 }  // namespace storages::mongo::impl::cdriver
 
 USERVER_NAMESPACE_END
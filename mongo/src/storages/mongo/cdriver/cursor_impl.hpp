@@ -19,19 +19,31 @@ class CDriverCursorImpl final : public CursorImpl {
  public:
   CDriverCursorImpl(cdriver::CDriverPoolImpl::BoundClientPtr,
                     cdriver::CursorPtr,
-                    std::shared_ptr<stats::OperationStatisticsItem> find_stats);
+                    std::shared_ptr<stats::OperationStatisticsItem> find_stats,
+                    std::optional<size_t> target_batch_bytes);
 
   bool IsValid() const override;
   bool HasMore() const override;
 
   const formats::bson::Document& Current() const override;
+  formats::bson::DocumentView CurrentView() const override;
   void Next() override;
 
  private:
-  std::optional<formats::bson::Document> current_;
+  void TuneBatchSize();
+
+  // points into the cursor reply, valid until the next mongoc_cursor_next
+  const bson_t* current_bson_{nullptr};
+  // owning copy, made on demand or when the cursor is released
+  mutable std::optional<formats::bson::Document> current_;
   cdriver::CDriverPoolImpl::BoundClientPtr client_;
   cdriver::CursorPtr cursor_;
   const std::shared_ptr<stats::OperationStatisticsItem> find_stats_;
+
+  const std::optional<size_t> target_batch_bytes_;
+  size_t received_bytes_{0};
+  size_t received_count_{0};
+  std::optional<int> tuned_batch_num_;
 };
 
 }  // namespace storages::mongo::impl::cdriver
@@ -111,6 +111,47 @@ UTEST_F(Collection, Read) {
   EXPECT_EQ(0, other_coll.CountApprox());
 }
 
+UTEST_F(Collection, ReadBatched) {
+  auto coll = GetDefaultPool().GetCollection("read_batched");
+
+  constexpr int kDocsCount = 1000;
+  {
+    std::vector<bson::Document> docs;
+    for (int i = 0; i < kDocsCount; ++i) {
+      docs.push_back(bson::MakeDoc("_id", i, "payload", std::string(100, 'x')));
+    }
+    coll.InsertMany(std::move(docs));
+  }
+
+  const auto check_cursor = [](mongo::Cursor cursor) {
+    int expected_id = 0;
+    for (const auto& doc : cursor) {
+      EXPECT_EQ(expected_id++, doc["_id"].As<int>());
+    }
+    EXPECT_EQ(kDocsCount, expected_id);
+    EXPECT_FALSE(cursor);
+  };
+
+  const mongo::options::Sort sort{{"_id", mongo::options::Sort::kAscending}};
+  check_cursor(coll.Find({}, sort, mongo::options::TargetBatchBytes{1000}));
+  check_cursor(coll.Find({}, sort, mongo::options::Prefetch{}));
+  check_cursor(coll.Find({}, sort, mongo::options::Prefetch{},
+                         mongo::options::TargetBatchBytes{1000}));
+
+  {
+    auto cursor = coll.Find({}, sort, mongo::options::Prefetch{},
+                            mongo::options::TargetBatchBytes{1000});
+    int expected_id = 0;
+    for (auto view : cursor.Views()) {
+      EXPECT_EQ(expected_id++, view["_id"].As<int>());
+    }
+    EXPECT_EQ(kDocsCount, expected_id);
+  }
+
+  UEXPECT_THROW(coll.Find({}, mongo::options::TargetBatchBytes{0}),
+                mongo::InvalidQueryArgumentException);
+}
+
 UTEST_F(Collection, InsertOne) {
   auto coll = GetDefaultPool().GetCollection("insert_one");
 
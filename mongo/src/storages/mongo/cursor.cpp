@@ -53,6 +53,28 @@ bool Cursor::Iterator::operator!=(const Iterator& rhs) const {
   return !(*this == rhs);
 }
 
+Cursor::ViewIterator::ViewIterator(Cursor* cursor) : cursor_(cursor) {
+  if (cursor_ && !cursor_->impl_->IsValid()) cursor_ = nullptr;
+}
+
+Cursor::ViewIterator& Cursor::ViewIterator::operator++() {
+  cursor_->impl_->Next();
+  if (!cursor_->impl_->IsValid()) cursor_ = nullptr;
+  return *this;
+}
+
+formats::bson::DocumentView Cursor::ViewIterator::operator*() const {
+  return cursor_->impl_->CurrentView();
+}
+
+bool Cursor::ViewIterator::operator==(const ViewIterator& rhs) const {
+  return cursor_ == rhs.cursor_;
+}
+
+bool Cursor::ViewIterator::operator!=(const ViewIterator& rhs) const {
+  return !(*this == rhs);
+}
+
 }  // namespace storages::mongo
 
 USERVER_NAMESPACE_END
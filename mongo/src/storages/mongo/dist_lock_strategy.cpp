@@ -6,6 +6,7 @@
 #include <userver/formats/bson.hpp>
 #include <userver/hostinfo/blocking/get_hostname.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/storages/mongo/bulk.hpp>
 #include <userver/storages/mongo/exception.hpp>
 
 #include <userver/formats/bson/serialize.hpp>
@@ -20,6 +21,7 @@ namespace fields {
 const std::string kId = "_id";
 const std::string kLockedTill = "t";
 const std::string kOwner = "o";
+const std::string kFencingToken = "f";
 
 }  // namespace fields
 
@@ -35,19 +37,91 @@ DistLockStrategy::DistLockStrategy(Collection collection, std::string lock_name)
 
 DistLockStrategy::DistLockStrategy(Collection collection, std::string lock_name,
                                    std::string owner)
+    : DistLockStrategy(std::move(collection), std::move(lock_name),
+                       std::move(owner), nullptr) {}
+
+DistLockStrategy::DistLockStrategy(
+    Collection collection, std::string lock_name, std::string owner,
+    std::shared_ptr<dist_lock::AcquireBatcher> batcher)
     : collection_(std::move(collection)),
       lock_name_(std::move(lock_name)),
-      owner_prefix_(std::move(owner)) {}
+      owner_prefix_(std::move(owner)),
+      batcher_(std::move(batcher)) {}
+
+std::shared_ptr<dist_lock::AcquireBatcher> DistLockStrategy::MakeBatcher(
+    Collection collection,
+    const dist_lock::AcquireBatcherSettings& batcher_settings) {
+  auto batch_func =
+      [collection = std::move(collection)](
+          const std::vector<dist_lock::AcquireBatcher::Request>&
+              requests) mutable {
+        namespace bson = formats::bson;
+
+        const auto now = utils::datetime::Now();
+        operations::Bulk bulk(operations::Bulk::Mode::kUnordered);
+        for (const auto& request : requests) {
+          bulk.UpdateOne(
+              bson::MakeDoc(fields::kId, request.key, fields::kOwner,
+                            request.owner),
+              bson::MakeDoc("$set", bson::MakeDoc(fields::kLockedTill,
+                                                  now + request.lock_ttl)));
+        }
+        const auto matched = collection.Execute(std::move(bulk)).MatchedCount();
+
+        // The bulk write does not tell which of the locks were lost, so all of
+        // them are reacquired separately then
+        const bool all_prolonged = matched == requests.size();
+        return std::vector<dist_lock::AcquireBatcher::Result>(
+            requests.size(), {all_prolonged, std::nullopt});
+      };
+  return std::make_shared<dist_lock::AcquireBatcher>(std::move(batch_func),
+                                                     batcher_settings);
+}
 
 void DistLockStrategy::Acquire(std::chrono::milliseconds lock_ttl,
                                const std::string& locker_id) {
+  AcquireWithFencingToken(lock_ttl, locker_id);
+}
+
+std::optional<dist_lock::FencingToken>
+DistLockStrategy::AcquireWithFencingToken(std::chrono::milliseconds lock_ttl,
+                                          const std::string& locker_id) {
+  auto owner = MakeOwnerId(owner_prefix_, locker_id);
+  if (!batcher_) return AcquireSingle(lock_ttl, owner);
+
+  std::optional<dist_lock::FencingToken> held_token;
+  {
+    auto held_tokens = held_tokens_.Lock();
+    const auto it = held_tokens->find(locker_id);
+    if (it != held_tokens->end()) held_token = it->second;
+  }
+  if (held_token) {
+    try {
+      batcher_->Acquire({lock_name_, owner, lock_ttl});
+      return held_token;
+    } catch (const dist_lock::LockIsAcquiredByAnotherHostException&) {
+      LOG_INFO() << "Owner " << owner << " failed to prolong lock "
+                 << lock_name_ << " in a batch";
+    }
+  }
+
+  {
+    auto held_tokens = held_tokens_.Lock();
+    held_tokens->erase(locker_id);
+  }
+  const auto token = AcquireSingle(lock_ttl, owner);
+  auto held_tokens = held_tokens_.Lock();
+  (*held_tokens)[locker_id] = token;
+  return token;
+}
+
+dist_lock::FencingToken DistLockStrategy::AcquireSingle(
+    std::chrono::milliseconds lock_ttl, const std::string& owner) {
   namespace bson = formats::bson;
 
   const auto now = utils::datetime::Now();
   const auto expiration_time = now + lock_ttl;
 
-  const auto owner = MakeOwnerId(owner_prefix_, locker_id);
-
   auto query = bson::MakeDoc(
       fields::kId, lock_name_, "$or",
       bson::MakeArray(
@@ -59,13 +133,33 @@ void DistLockStrategy::Acquire(std::chrono::milliseconds lock_ttl,
 
   try {
     LOG_INFO() << "Owner " << owner << " try to acquire lock " << lock_name_;
-    auto lock = collection_
-                    .FindAndModify(std::move(query), update, options::Upsert{},
-                                   options::ReturnNew{})
-                    .FoundDocument();
-    if (!lock) {
-      throw dist_lock::LockIsAcquiredByAnotherHostException();
+    // Returns the previous state of the lock if there was one
+    const auto previous_lock =
+        collection_.FindAndModify(std::move(query), update, options::Upsert{})
+            .FoundDocument();
+    if (previous_lock &&
+        (*previous_lock)[fields::kOwner].As<std::string>({}) == owner &&
+        !(*previous_lock)[fields::kFencingToken].IsMissing()) {
+      return (*previous_lock)[fields::kFencingToken]
+          .As<dist_lock::FencingToken>();
+    }
+
+    // The lock passed to the current owner, its token is increased while no
+    // one else can take over the lock
+    auto token = dist_lock::FencingToken{1};
+    if (previous_lock) {
+      token += (*previous_lock)[fields::kFencingToken]
+                   .As<dist_lock::FencingToken>(0);
     }
+    const auto matched =
+        collection_
+            .UpdateOne(
+                bson::MakeDoc(fields::kId, lock_name_, fields::kOwner, owner),
+                bson::MakeDoc("$set", bson::MakeDoc(fields::kFencingToken,
+                                                    token)))
+            .MatchedCount();
+    if (!matched) throw dist_lock::LockIsAcquiredByAnotherHostException();
+    return token;
   } catch (const DuplicateKeyException& exc) {
     LOG_INFO() << "Lock " << lock_name_
                << " has not been acqired because of key duplication";
@@ -80,18 +174,27 @@ void DistLockStrategy::Acquire(std::chrono::milliseconds lock_ttl,
 void DistLockStrategy::Release(const std::string& locker_id) {
   namespace bson = formats::bson;
 
+  {
+    auto held_tokens = held_tokens_.Lock();
+    held_tokens->erase(locker_id);
+  }
   const auto owner = MakeOwnerId(owner_prefix_, locker_id);
 
+  // The lock is expired to keep its fencing token for the next owners
   auto query = bson::MakeDoc(fields::kId, lock_name_, fields::kOwner, owner);
-  size_t deleted_count = 0;
+  auto update = bson::MakeDoc(
+      "$set", bson::MakeDoc(fields::kLockedTill, utils::datetime::Now()));
+  size_t released_count = 0;
   try {
-    deleted_count = collection_.FindAndRemove(std::move(query)).DeletedCount();
+    released_count =
+        collection_.UpdateOne(std::move(query), std::move(update))
+            .MatchedCount();
   } catch (const std::exception& e) {
     LOG_WARNING() << "owner " << owner << " could not release a lock "
                   << lock_name_ << " because of mongo error: " << e.what();
     return;
   }
-  if (!deleted_count) {
+  if (!released_count) {
     LOG_WARNING() << "owner " << owner << " could not release a lock "
                   << lock_name_;
   }
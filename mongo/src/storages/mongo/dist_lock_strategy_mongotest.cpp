@@ -86,4 +86,53 @@ UTEST_F(DistLockTest, ReleaseAcquire) {
   UEXPECT_NO_THROW(strategy2.Acquire(1s, {}));
 }
 
+UTEST_F(DistLockTest, FencingToken) {
+  utils::datetime::MockNowSet(kMockTime);
+
+  auto collection = GetDefaultPool().GetCollection("test_fencing_token");
+  const std::string key = "key_fencing_token";
+  mongo::DistLockStrategy strategy1(collection, key, "owner1");
+  mongo::DistLockStrategy strategy2(collection, key, "owner2");
+
+  EXPECT_EQ(strategy1.AcquireWithFencingToken(1s, {}), 1);
+  EXPECT_EQ(strategy1.AcquireWithFencingToken(1s, {}), 1);
+
+  utils::datetime::MockSleep(5s);
+  EXPECT_EQ(strategy2.AcquireWithFencingToken(1s, {}), 2);
+  UEXPECT_THROW(strategy1.AcquireWithFencingToken(1s, {}),
+                dist_lock::LockIsAcquiredByAnotherHostException);
+
+  // The token is kept by the released lock
+  strategy2.Release({});
+  EXPECT_EQ(strategy1.AcquireWithFencingToken(1s, {}), 3);
+  strategy1.Release({});
+}
+
+UTEST_F(DistLockTest, BatchedProlong) {
+  utils::datetime::MockNowSet(kMockTime);
+
+  auto collection = GetDefaultPool().GetCollection("test_batched_prolong");
+  auto batcher = mongo::DistLockStrategy::MakeBatcher(collection, {});
+  mongo::DistLockStrategy strategy1(collection, "key1", "owner", batcher);
+  mongo::DistLockStrategy strategy2(collection, "key2", "owner", batcher);
+
+  EXPECT_EQ(strategy1.AcquireWithFencingToken(1s, {}), 1);
+  EXPECT_EQ(strategy2.AcquireWithFencingToken(1s, {}), 1);
+  EXPECT_EQ(batcher->GetStatistics().requests.Load(), 0);
+
+  EXPECT_EQ(strategy1.AcquireWithFencingToken(1s, {}), 1);
+  EXPECT_EQ(strategy2.AcquireWithFencingToken(1s, {}), 1);
+  EXPECT_EQ(batcher->GetStatistics().requests.Load(), 2);
+
+  // The lock lost while being held is reacquired separately
+  mongo::DistLockStrategy other(collection, "key1", "other");
+  utils::datetime::MockSleep(5s);
+  EXPECT_EQ(other.AcquireWithFencingToken(1s, {}), 2);
+  UEXPECT_THROW(strategy1.AcquireWithFencingToken(1s, {}),
+                dist_lock::LockIsAcquiredByAnotherHostException);
+
+  other.Release({});
+  strategy2.Release({});
+}
+
 USERVER_NAMESPACE_END
@@ -53,7 +53,9 @@ class Find::Impl {
   impl::cdriver::ReadPrefsPtr read_prefs;
   std::optional<formats::bson::impl::BsonBuilder> options;
   bool has_comment_option{false};
+  bool prefetch{false};
   std::chrono::milliseconds max_server_time{kNoMaxServerTime};
+  std::optional<size_t> target_batch_bytes;
 };
 
 class InsertOne::Impl {
@@ -166,6 +168,18 @@ class Aggregate::Impl {
   std::chrono::milliseconds max_server_time{kNoMaxServerTime};
 };
 
+class Watch::Impl {
+ public:
+  explicit Impl(formats::bson::Value pipeline_)
+      : pipeline(std::move(pipeline_)) {}
+
+  formats::bson::Value pipeline;
+  impl::cdriver::ReadPrefsPtr read_prefs;
+  stats::OperationKey op_key{stats::OpType::kWatch};
+  std::optional<formats::bson::impl::BsonBuilder> options;
+  bool has_comment_option{false};
+};
+
 class Drop::Impl {
  public:
   Impl() = default;
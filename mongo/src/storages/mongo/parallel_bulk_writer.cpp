@@ -0,0 +1,209 @@
+#include <userver/storages/mongo/parallel_bulk_writer.hpp>
+
+#include <exception>
+
+#include <bson/bson.h>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/formats/bson/inline.hpp>
+#include <userver/formats/bson/value_builder.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/mongo/exception.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo {
+namespace {
+
+bool IsRetryable(const MongoException& ex) {
+  return dynamic_cast<const NetworkException*>(&ex) ||
+         dynamic_cast<const ClusterUnavailableException*>(&ex) ||
+         dynamic_cast<const PoolOverloadException*>(&ex);
+}
+
+// Builds the document parsed by WriteResult, see the bulk write reply of
+// the mongo C driver
+class WriteResultAggregator {
+ public:
+  void Add(const WriteResult& result, std::size_t first_index) {
+    inserted_ += result.InsertedCount();
+    matched_ += result.MatchedCount();
+    modified_ += result.ModifiedCount();
+    upserted_ += result.UpsertedCount();
+    deleted_ += result.DeletedCount();
+
+    for (const auto& [index, id] : result.UpsertedIds()) {
+      upserted_ids_.PushBack(
+          formats::bson::MakeDoc("index", first_index + index, "_id", id));
+    }
+    for (const auto& [index, error] : result.ServerErrors()) {
+      server_errors_.PushBack(formats::bson::MakeDoc(
+          "index", first_index + index, "code", error.Code(), "errmsg",
+          error.Message()));
+    }
+    for (const auto& error : result.WriteConcernErrors()) {
+      write_concern_errors_.PushBack(formats::bson::MakeDoc(
+          "code", error.Code(), "errmsg", error.Message()));
+    }
+  }
+
+  WriteResult Extract() && {
+    formats::bson::ValueBuilder builder;
+    builder["nInserted"] = inserted_;
+    builder["nMatched"] = matched_;
+    builder["nModified"] = modified_;
+    builder["nUpserted"] = upserted_;
+    builder["nRemoved"] = deleted_;
+    if (!upserted_ids_.IsEmpty()) {
+      builder["upserted"] = std::move(upserted_ids_);
+    }
+    if (!server_errors_.IsEmpty()) {
+      builder["writeErrors"] = std::move(server_errors_);
+    }
+    if (!write_concern_errors_.IsEmpty()) {
+      builder["writeConcernErrors"] = std::move(write_concern_errors_);
+    }
+    return WriteResult{builder.ExtractValue().As<formats::bson::Document>()};
+  }
+
+ private:
+  std::size_t inserted_{0};
+  std::size_t matched_{0};
+  std::size_t modified_{0};
+  std::size_t upserted_{0};
+  std::size_t deleted_{0};
+  formats::bson::ValueBuilder upserted_ids_{
+      formats::bson::ValueBuilder::Type::kArray};
+  formats::bson::ValueBuilder server_errors_{
+      formats::bson::ValueBuilder::Type::kArray};
+  formats::bson::ValueBuilder write_concern_errors_{
+      formats::bson::ValueBuilder::Type::kArray};
+};
+
+}  // namespace
+
+double ParallelBulkWriterStatistics::OperationsPerSecond() const {
+  const std::chrono::duration<double> seconds = elapsed;
+  if (seconds.count() <= 0) return 0;
+  return operations / seconds.count();
+}
+
+ParallelBulkWriter::ParallelBulkWriter(Collection collection,
+                                       ParallelBulkWriterSettings settings)
+    : collection_(std::move(collection)),
+      settings_(std::move(settings)),
+      in_flight_(settings_.max_in_flight) {
+  UINVARIANT(settings_.max_batch_operations > 0,
+             "max_batch_operations is set to zero");
+  UINVARIANT(settings_.max_in_flight > 0, "max_in_flight is set to zero");
+  UINVARIANT(settings_.attempts > 0, "attempts is set to zero");
+}
+
+ParallelBulkWriter::~ParallelBulkWriter() { WaitAll(); }
+
+WriteResult ParallelBulkWriter::Finish() {
+  if (!batch_.operations.empty()) StartBatch();
+
+  auto tasks = std::move(tasks_);
+  tasks_.clear();
+
+  WriteResultAggregator aggregator;
+  std::exception_ptr error;
+  for (auto& [first_index, task] : tasks) {
+    try {
+      aggregator.Add(task.Get(), first_index);
+    } catch (const std::exception&) {
+      if (!error) error = std::current_exception();
+    }
+  }
+  if (error) std::rethrow_exception(error);
+  return std::move(aggregator).Extract();
+}
+
+ParallelBulkWriterStatistics ParallelBulkWriter::GetStatistics() const {
+  ParallelBulkWriterStatistics stats;
+  stats.operations = operations_.load();
+  stats.bytes = bytes_.load();
+  stats.batches = batches_.load();
+  stats.retries = retries_.load();
+  stats.failed_batches = failed_batches_.load();
+  stats.elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+      elapsed_.load());
+  return stats;
+}
+
+std::size_t ParallelBulkWriter::GetSize(
+    const formats::bson::Document& document) {
+  return document.GetBson()->len;
+}
+
+void ParallelBulkWriter::Add(SubOperation&& operation, std::size_t bytes) {
+  if (!batch_.operations.empty() &&
+      batch_.bytes + bytes > settings_.max_batch_bytes) {
+    StartBatch();
+  }
+  batch_.operations.push_back(std::move(operation));
+  batch_.bytes += bytes;
+  if (batch_.operations.size() >= settings_.max_batch_operations) {
+    StartBatch();
+  }
+}
+
+void ParallelBulkWriter::StartBatch() {
+  UASSERT(!batch_.operations.empty());
+  engine::SemaphoreLock lock{in_flight_};
+  if (!start_time_) start_time_ = std::chrono::steady_clock::now();
+
+  const auto first_index = operations_added_;
+  operations_added_ += batch_.operations.size();
+  tasks_.push_back(
+      {first_index,
+       utils::Async("mongo_parallel_bulk",
+                    [this, lock = std::move(lock),
+                     batch = std::exchange(batch_, {})] {
+                      return ExecuteBatch(batch);
+                    })});
+}
+
+WriteResult ParallelBulkWriter::ExecuteBatch(const Batch& batch) {
+  for (std::size_t attempt = 1;; ++attempt) {
+    try {
+      auto bulk =
+          collection_.MakeUnorderedBulk(options::SuppressServerExceptions{});
+      if (settings_.write_concern) bulk.SetOption(*settings_.write_concern);
+      for (const auto& operation : batch.operations) {
+        std::visit([&bulk](const auto& subop) { bulk.Append(subop); },
+                   operation);
+      }
+      auto result = collection_.Execute(std::move(bulk));
+
+      operations_ += batch.operations.size();
+      bytes_ += batch.bytes;
+      ++batches_;
+      elapsed_ = std::chrono::steady_clock::now() - *start_time_;
+      return result;
+    } catch (const MongoException& ex) {
+      if (!IsRetryable(ex) || attempt >= settings_.attempts) {
+        ++failed_batches_;
+        throw;
+      }
+      LOG_WARNING() << "Failed to execute a bulk of "
+                    << batch.operations.size() << " operations, retrying: "
+                    << ex;
+    }
+    ++retries_;
+    engine::InterruptibleSleepFor(settings_.retry_delay);
+  }
+}
+
+void ParallelBulkWriter::WaitAll() noexcept {
+  const engine::TaskCancellationBlocker block_cancel;
+  for (auto& batch_task : tasks_) batch_task.task.Wait();
+}
+
+}  // namespace storages::mongo
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,80 @@
+#include <userver/utest/utest.hpp>
+
+#include <storages/mongo/util_mongotest.hpp>
+#include <userver/formats/bson.hpp>
+#include <userver/storages/mongo.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace bson = formats::bson;
+namespace mongo = storages::mongo;
+
+namespace {
+class ParallelBulkWriter : public MongoPoolFixture {};
+}  // namespace
+
+UTEST_F_MT(ParallelBulkWriter, Insert, 2) {
+  auto coll = GetDefaultPool().GetCollection("parallel_bulk_insert");
+
+  mongo::ParallelBulkWriterSettings settings;
+  settings.max_batch_operations = 10;
+  settings.max_in_flight = 2;
+  mongo::ParallelBulkWriter writer(coll, settings);
+
+  for (int i = 0; i < 95; ++i) writer.InsertOne(bson::MakeDoc("_id", i));
+  auto result = writer.Finish();
+
+  EXPECT_EQ(95, result.InsertedCount());
+  EXPECT_TRUE(result.ServerErrors().empty());
+  EXPECT_EQ(95, coll.CountApprox());
+
+  const auto stats = writer.GetStatistics();
+  EXPECT_EQ(95, stats.operations);
+  EXPECT_EQ(10, stats.batches);
+  EXPECT_EQ(0, stats.failed_batches);
+}
+
+UTEST_F(ParallelBulkWriter, BatchBytes) {
+  auto coll = GetDefaultPool().GetCollection("parallel_bulk_bytes");
+
+  mongo::ParallelBulkWriterSettings settings;
+  settings.max_batch_bytes = 1000;
+  mongo::ParallelBulkWriter writer(coll, settings);
+
+  const std::string payload(400, 'x');
+  for (int i = 0; i < 6; ++i) {
+    writer.InsertOne(bson::MakeDoc("_id", i, "payload", payload));
+  }
+  EXPECT_EQ(6, writer.Finish().InsertedCount());
+  EXPECT_EQ(3, writer.GetStatistics().batches);
+}
+
+UTEST_F(ParallelBulkWriter, ServerErrors) {
+  auto coll = GetDefaultPool().GetCollection("parallel_bulk_errors");
+  coll.InsertOne(bson::MakeDoc("_id", 5));
+
+  mongo::ParallelBulkWriterSettings settings;
+  settings.max_batch_operations = 4;
+  mongo::ParallelBulkWriter writer(coll, settings);
+
+  for (int i = 0; i < 10; ++i) writer.InsertOne(bson::MakeDoc("_id", i));
+  writer.UpdateOne(bson::MakeDoc("_id", 100),
+                   bson::MakeDoc("$set", bson::MakeDoc("x", 1)),
+                   mongo::options::Upsert{});
+  auto result = writer.Finish();
+
+  EXPECT_EQ(9, result.InsertedCount());
+  EXPECT_EQ(1, result.UpsertedCount());
+
+  auto errors = result.ServerErrors();
+  ASSERT_EQ(1, errors.size());
+  EXPECT_EQ(11000, errors.begin()->second.Code());
+  EXPECT_EQ(5, errors.begin()->first);
+
+  auto upserted_ids = result.UpsertedIds();
+  ASSERT_EQ(1, upserted_ids.size());
+  EXPECT_EQ(10, upserted_ids.begin()->first);
+  EXPECT_EQ(100, upserted_ids.begin()->second.As<int>());
+}
+
+USERVER_NAMESPACE_END
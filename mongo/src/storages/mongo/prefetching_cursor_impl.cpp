@@ -0,0 +1,75 @@
+#include <storages/mongo/prefetching_cursor_impl.hpp>
+
+#include <stdexcept>
+
+#include <bson/bson.h>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo::impl {
+
+PrefetchingCursorImpl::PrefetchingCursorImpl(
+    std::unique_ptr<CursorImpl> cursor, size_t chunk_bytes)
+    : cursor_(std::move(cursor)), chunk_bytes_(chunk_bytes) {
+  UASSERT(cursor_);
+  chunk_ = ReadChunk(*cursor_, chunk_bytes_);
+  StartPrefetch();
+}
+
+bool PrefetchingCursorImpl::IsValid() const {
+  return index_ < chunk_.size() || prefetch_.IsValid();
+}
+
+bool PrefetchingCursorImpl::HasMore() const {
+  return index_ + 1 < chunk_.size() || prefetch_.IsValid();
+}
+
+const formats::bson::Document& PrefetchingCursorImpl::Current() const {
+  if (index_ >= chunk_.size()) {
+    throw std::logic_error("Reading from invalid cursor");
+  }
+  return chunk_[index_];
+}
+
+formats::bson::DocumentView PrefetchingCursorImpl::CurrentView() const {
+  return Current();
+}
+
+void PrefetchingCursorImpl::Next() {
+  if (!IsValid()) throw std::logic_error("Advancing cursor past the end");
+
+  if (++index_ < chunk_.size()) return;
+
+  chunk_.clear();
+  index_ = 0;
+  if (!prefetch_.IsValid()) return;
+
+  chunk_ = prefetch_.Get();
+  StartPrefetch();
+}
+
+PrefetchingCursorImpl::Chunk PrefetchingCursorImpl::ReadChunk(
+    CursorImpl& cursor, size_t chunk_bytes) {
+  Chunk chunk;
+  size_t bytes = 0;
+  while (cursor.IsValid() && bytes < chunk_bytes) {
+    chunk.push_back(cursor.Current());
+    bytes += chunk.back().GetBson()->len;
+    cursor.Next();
+  }
+  return chunk;
+}
+
+void PrefetchingCursorImpl::StartPrefetch() {
+  if (!cursor_->IsValid()) return;
+  prefetch_ = utils::Async("mongo_cursor_prefetch", [this] {
+    return ReadChunk(*cursor_, chunk_bytes_);
+  });
+}
+
+}  // namespace storages::mongo::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/formats/bson/document.hpp>
+
+#include <storages/mongo/cursor_impl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mongo::impl {
+
+/// Reads the documents of the underlying cursor in chunks of about
+/// `chunk_bytes`, the next chunk is read in background while the current one
+/// is being iterated
+class PrefetchingCursorImpl final : public CursorImpl {
+ public:
+  PrefetchingCursorImpl(std::unique_ptr<CursorImpl> cursor, size_t chunk_bytes);
+
+  bool IsValid() const override;
+  bool HasMore() const override;
+
+  const formats::bson::Document& Current() const override;
+  formats::bson::DocumentView CurrentView() const override;
+  void Next() override;
+
+ private:
+  using Chunk = std::vector<formats::bson::Document>;
+
+  static Chunk ReadChunk(CursorImpl& cursor, size_t chunk_bytes);
+  void StartPrefetch();
+
+  const std::unique_ptr<CursorImpl> cursor_;
+  const size_t chunk_bytes_;
+
+  Chunk chunk_;
+  size_t index_{0};
+  // accesses only cursor_, must be destroyed before it
+  engine::TaskWithResult<Chunk> prefetch_;
+};
+
+}  // namespace storages::mongo::impl
+
+USERVER_NAMESPACE_END
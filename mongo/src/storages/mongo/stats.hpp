@@ -74,6 +74,7 @@ enum class OpType {
   kCountApprox,
   kFind,
   kAggregate,
+  kWatch,
 
   kWriteMin,
   kInsertOne = kWriteMin,
@@ -6,6 +6,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/components/component_fwd.hpp>
@@ -15,7 +16,9 @@
 #include <userver/storages/mysql/cluster_host_type.hpp>
 #include <userver/storages/mysql/command_result_set.hpp>
 #include <userver/storages/mysql/cursor_result_set.hpp>
+#include <userver/storages/mysql/execution_result.hpp>
 #include <userver/storages/mysql/impl/bind_helper.hpp>
+#include <userver/storages/mysql/impl/bulk_chunks.hpp>
 #include <userver/storages/mysql/options.hpp>
 #include <userver/storages/mysql/query.hpp>
 #include <userver/storages/mysql/statement_result_set.hpp>
@@ -188,6 +191,42 @@ class Cluster final {
                                        const Query& query,
                                        const Container& params) const;
 
+  /// @brief Executes a statement on a host of host_type with default deadline,
+  /// splitting Container into chunks of `settings.max_chunk_rows` rows or
+  /// `settings.max_chunk_bytes` of approximate size, whichever comes first,
+  /// and executing up to `settings.max_parallel_chunks` of them concurrently.
+  /// Container is expected to be a std::Container, Container::value_type is
+  /// expected to be an aggregate of supported types.
+  /// See @ref scripts/docs/en/userver/mysql/supported_types.md for better
+  /// understanding of `Container::value_type` requirements.
+  ///
+  /// The chunks are executed independently of each other, so if a chunk
+  /// fails the ones already executed stay applied. Returned `rows_affected`
+  /// is the sum over all the chunks, `last_insert_id` is the one of the first
+  /// chunk.
+  ///
+  /// @note Requires MariaDB 10.2.6+ as a server
+  ///
+  /// UINVARIANTs on params count mismatch, doesn't validate types.
+  /// UINVARIANTs on empty params container.
+  template <typename Container>
+  ExecutionResult ExecuteBulkChunked(ClusterHostType host_type,
+                                     const Query& query,
+                                     const Container& params,
+                                     const BulkSettings& settings) const;
+
+  /// @brief Executes a statement on a host of host_type with provided
+  /// CommandControl, splitting Container into chunks executed concurrently.
+  /// The deadline is for all the chunks.
+  ///
+  /// @see ExecuteBulkChunked above for the details.
+  template <typename Container>
+  ExecutionResult ExecuteBulkChunked(OptionalCommandControl command_control,
+                                     ClusterHostType host_type,
+                                     const Query& query,
+                                     const Container& params,
+                                     const BulkSettings& settings) const;
+
   /// @brief Begin a transaction with default deadline.
   ///
   /// @note The deadline is transaction-wide, not just for Begin query itself.
@@ -271,6 +310,12 @@ class Cluster final {
                                impl::io::ParamsBinderBase& params,
                                std::optional<std::size_t> batch_size) const;
 
+  ExecutionResult DoExecuteChunked(
+      OptionalCommandControl command_control, ClusterHostType host_type,
+      const Query& query,
+      const std::vector<impl::io::ParamsBinderBase*>& chunks,
+      std::size_t max_parallel_chunks) const;
+
   std::unique_ptr<infra::topology::TopologyBase> topology_;
 };
 
@@ -349,6 +394,31 @@ StatementResultSet Cluster::ExecuteBulkMapped(
                    params_binder, std::nullopt);
 }
 
+template <typename Container>
+ExecutionResult Cluster::ExecuteBulkChunked(
+    ClusterHostType host_type, const Query& query, const Container& params,
+    const BulkSettings& settings) const {
+  return ExecuteBulkChunked(std::nullopt, host_type, query, params, settings);
+}
+
+template <typename Container>
+ExecutionResult Cluster::ExecuteBulkChunked(
+    OptionalCommandControl command_control, ClusterHostType host_type,
+    const Query& query, const Container& params,
+    const BulkSettings& settings) const {
+  UINVARIANT(!params.empty(), "Empty params in bulk execution");
+
+  const auto chunks = impl::SplitIntoChunks(params, settings);
+  const auto binders = impl::BindHelper::BindChunksAsParams(chunks);
+
+  std::vector<impl::io::ParamsBinderBase*> chunks_params;
+  chunks_params.reserve(binders.size());
+  for (const auto& binder : binders) chunks_params.push_back(binder.get());
+
+  return DoExecuteChunked(command_control, host_type, query, chunks_params,
+                          settings.max_parallel_chunks);
+}
+
 template <typename T, typename... Args>
 CursorResultSet<T> Cluster::GetCursor(ClusterHostType host_type,
                                       std::size_t batch_size,
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include <boost/pfr/core.hpp>
 
+#include <userver/storages/mysql/impl/bulk_chunks.hpp>
 #include <userver/storages/mysql/impl/io/insert_binder.hpp>
 #include <userver/storages/mysql/impl/io/params_binder.hpp>
 
@@ -41,6 +45,18 @@ class BindHelper final {
       const Container& rows) {
     return io::InsertBinder<Container, MapTo>{rows};
   }
+
+  template <typename Container>
+  static BulkChunkBinders<Container> BindChunksAsParams(
+      const std::vector<BulkChunk<Container>>& chunks) {
+    BulkChunkBinders<Container> result;
+    result.reserve(chunks.size());
+    for (const auto& chunk : chunks) {
+      result.push_back(
+          std::make_unique<io::InsertBinder<BulkChunk<Container>>>(chunk));
+    }
+    return result;
+  }
 };
 
 }  // namespace storages::mysql::impl
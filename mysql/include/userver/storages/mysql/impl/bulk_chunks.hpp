@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/utils/meta.hpp>
+
+#include <userver/storages/mysql/impl/io/insert_binder.hpp>
+#include <userver/storages/mysql/options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mysql::impl {
+
+// A consecutive range of rows of a container, suits io::InsertBinder
+template <typename Container>
+class BulkChunk final {
+ public:
+  using value_type = typename Container::value_type;
+  using const_iterator = typename Container::const_iterator;
+
+  BulkChunk(const_iterator begin, const_iterator end, std::size_t size)
+      : begin_{begin}, end_{end}, size_{size} {}
+
+  const_iterator begin() const { return begin_; }
+  const_iterator end() const { return end_; }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+ private:
+  const_iterator begin_;
+  const_iterator end_;
+  std::size_t size_;
+};
+
+// Approximate size of the field in the binary protocol,
+// fixed-size types (and json, which is serialized on binding) are
+// accounted by their in-memory size
+template <typename T>
+std::size_t EstimateFieldBytes(const T& field) {
+  if constexpr (meta::kIsOptional<T>) {
+    return field.has_value() ? EstimateFieldBytes(*field) : 1;
+  } else if constexpr (std::is_same_v<T, std::string> ||
+                       std::is_same_v<T, std::string_view>) {
+    // length-encoded, up to 9 bytes of the length
+    return field.size() + 9;
+  } else {
+    return sizeof(T);
+  }
+}
+
+template <typename Row>
+std::size_t EstimateRowBytes(const Row& row) {
+  std::size_t result = 0;
+  boost::pfr::for_each_field(row, [&result](const auto& field) {
+    result += EstimateFieldBytes(field);
+  });
+  return result;
+}
+
+template <typename Container>
+std::vector<BulkChunk<Container>> SplitIntoChunks(
+    const Container& rows, const BulkSettings& settings) {
+  std::vector<BulkChunk<Container>> chunks;
+
+  auto chunk_begin = rows.begin();
+  std::size_t chunk_rows = 0;
+  std::size_t chunk_bytes = 0;
+  for (auto it = rows.begin(); it != rows.end(); ++it) {
+    const auto row_bytes = EstimateRowBytes(*it);
+    if (chunk_rows != 0 &&
+        (chunk_rows >= settings.max_chunk_rows ||
+         chunk_bytes + row_bytes > settings.max_chunk_bytes)) {
+      chunks.emplace_back(chunk_begin, it, chunk_rows);
+      chunk_begin = it;
+      chunk_rows = 0;
+      chunk_bytes = 0;
+    }
+    ++chunk_rows;
+    chunk_bytes += row_bytes;
+  }
+  if (chunk_rows != 0) chunks.emplace_back(chunk_begin, rows.end(), chunk_rows);
+
+  return chunks;
+}
+
+template <typename Container>
+using BulkChunkBinders =
+    std::vector<std::unique_ptr<io::InsertBinder<BulkChunk<Container>>>>;
+
+}  // namespace storages::mysql::impl
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,7 @@
 /// @file userver/storages/mysql/options.hpp
 
 #include <chrono>
+#include <cstddef>
 #include <optional>
 
 USERVER_NAMESPACE_BEGIN
@@ -34,6 +35,20 @@ struct CommandControl final {
 /// @brief storages::mysql::CommandControl that may not be set.
 using OptionalCommandControl = std::optional<CommandControl>;
 
+/// @brief Settings of storages::mysql::Cluster::ExecuteBulkChunked
+struct BulkSettings final {
+  /// Maximum number of rows in a single execution of the statement
+  std::size_t max_chunk_rows{10000};
+
+  /// Maximum approximate size of the rows of a single execution, should be
+  /// kept below `max_allowed_packet` of the server
+  std::size_t max_chunk_bytes{4 * 1024 * 1024};
+
+  /// Maximum number of executions run concurrently, each one over its own
+  /// connection of the pool
+  std::size_t max_parallel_chunks{4};
+};
+
 }  // namespace storages::mysql
 
 USERVER_NAMESPACE_END
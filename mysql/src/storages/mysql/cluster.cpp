@@ -3,7 +3,11 @@
 #include <vector>
 
 #include <userver/components/component_config.hpp>
+#include <userver/engine/semaphore.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 
 #include <userver/storages/mysql/impl/tracing_tags.hpp>
 
@@ -114,6 +118,47 @@ StatementResultSet Cluster::DoExecute(
   return {std::move(connection), std::move(fetcher), std::move(span)};
 }
 
+ExecutionResult Cluster::DoExecuteChunked(
+    OptionalCommandControl command_control, ClusterHostType host_type,
+    const Query& query, const std::vector<impl::io::ParamsBinderBase*>& chunks,
+    std::size_t max_parallel_chunks) const {
+  UINVARIANT(max_parallel_chunks > 0, "max_parallel_chunks is set to zero");
+
+  const auto deadline =
+      GetDeadline(command_control, GetDefaultCommandControl());
+
+  auto& pool = topology_->SelectPool(host_type);
+
+  engine::Semaphore semaphore{max_parallel_chunks};
+  std::vector<engine::TaskWithResult<ExecutionResult>> tasks;
+  tasks.reserve(chunks.size());
+  for (auto* chunk : chunks) {
+    UASSERT(chunk);
+    engine::SemaphoreLock lock{semaphore};
+    tasks.push_back(utils::Async(
+        "mysql_bulk_chunk",
+        [&pool, &query, deadline, chunk, lock = std::move(lock)] {
+          tracing::Span span{impl::tracing::kExecuteSpan};
+
+          auto connection = pool.Acquire(deadline);
+          auto fetcher = connection->ExecuteStatement(
+              query.GetStatement(), *chunk, deadline, std::nullopt);
+          return StatementResultSet{std::move(connection), std::move(fetcher),
+                                    std::move(span)}
+              .AsExecutionResult();
+        }));
+  }
+
+  ExecutionResult result{};
+  for (std::size_t i = 0; i < tasks.size(); ++i) {
+    const auto chunk_result = tasks[i].Get();
+    result.rows_affected += chunk_result.rows_affected;
+    if (i == 0) result.last_insert_id = chunk_result.last_insert_id;
+  }
+
+  return result;
+}
+
 }  // namespace storages::mysql
 
 USERVER_NAMESPACE_END
@@ -109,9 +109,11 @@ Connection::Connection(clients::dns::Resolver& resolver,
                        const settings::EndpointInfo& endpoint_info,
                        const settings::AuthSettings& auth_settings,
                        const settings::ConnectionSettings& connection_settings,
-                       engine::Deadline deadline)
+                       engine::Deadline deadline,
+                       HotStatements* hot_statements)
     : socket_{-1, 0},
-      statements_cache_{*this, connection_settings.statements_cache_size} {
+      statements_cache_{*this, connection_settings.statements_cache_size,
+                        hot_statements} {
   { auto _ = mysql_local_scope.Use(); }
 
   InitSocket(resolver, endpoint_info, auth_settings, connection_settings,
@@ -122,6 +124,8 @@ Connection::Connection(clients::dns::Resolver& resolver,
   LOG_INFO() << "MySQL connection initialized."
              << " Server type: " << server_info.server_type_str << " "
              << server_info.server_version.ToString();
+
+  if (hot_statements) PrepareHotStatements(*hot_statements, deadline);
 }
 
 Connection::~Connection() {
@@ -319,6 +323,23 @@ void Connection::Close(engine::Deadline deadline) noexcept {
   NativeInterface{socket_, deadline}.Close(&mysql_);
 }
 
+void Connection::PrepareHotStatements(const HotStatements& hot_statements,
+                                      engine::Deadline deadline) {
+  for (const auto& statement : hot_statements.Get()) {
+    try {
+      auto guard = GetBrokenGuard();
+      guard.Execute(
+          [&] { statements_cache_.PrepareStatement(statement, deadline); });
+    } catch (const std::exception& ex) {
+      // The connection is no good if it broke, otherwise the statement could
+      // have been invalidated by a schema change: the user will get the error
+      // on execution
+      if (IsBroken()) throw;
+      LOG_WARNING() << "Failed to prepare a statement in advance: " << ex;
+    }
+  }
+}
+
 Statement& Connection::PrepareStatement(const std::string& statement,
                                         engine::Deadline deadline,
                                         std::optional<std::size_t> batch_size) {
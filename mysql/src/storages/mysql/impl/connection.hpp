@@ -38,7 +38,8 @@ class Connection final {
              const settings::EndpointInfo& endpoint_info,
              const settings::AuthSettings& auth_settings,
              const settings::ConnectionSettings& connection_settings,
-             engine::Deadline deadline);
+             engine::Deadline deadline,
+             HotStatements* hot_statements = nullptr);
   ~Connection();
 
   QueryResult ExecuteQuery(const std::string& query, engine::Deadline deadline);
@@ -83,6 +84,9 @@ class Connection final {
                     engine::Deadline deadline);
   void Close(engine::Deadline deadline) noexcept;
 
+  void PrepareHotStatements(const HotStatements& hot_statements,
+                            engine::Deadline deadline);
+
   Statement& PrepareStatement(const std::string& statement,
                               engine::Deadline deadline,
                               std::optional<std::size_t> batch_size);
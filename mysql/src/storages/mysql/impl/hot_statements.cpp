@@ -0,0 +1,31 @@
+#include <storages/mysql/impl/hot_statements.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mysql::impl {
+
+HotStatements::HotStatements(std::size_t capacity)
+    : statements_{capacity, utils::StrIcaseHash{}, utils::StrIcaseEqual{}} {
+  UASSERT(capacity > 0);
+}
+
+void HotStatements::Add(const std::string& statement) {
+  statements_.Lock()->Put(statement);
+}
+
+std::vector<std::string> HotStatements::Get() const {
+  std::vector<std::string> result;
+
+  const auto statements = statements_.Lock();
+  result.reserve(statements->GetSize());
+  statements->VisitAll(
+      [&result](const std::string& statement) { result.push_back(statement); });
+
+  return result;
+}
+
+}  // namespace storages::mysql::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <userver/cache/lru_set.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mysql::impl {
+
+// Statements most recently prepared by the connections of a pool, new
+// connections of the pool prepare them in advance
+class HotStatements final {
+ public:
+  explicit HotStatements(std::size_t capacity);
+
+  void Add(const std::string& statement);
+
+  std::vector<std::string> Get() const;
+
+ private:
+  using Statements =
+      cache::LruSet<std::string, utils::StrIcaseHash, utils::StrIcaseEqual>;
+
+  concurrent::Variable<Statements> statements_;
+};
+
+}  // namespace storages::mysql::impl
+
+USERVER_NAMESPACE_END
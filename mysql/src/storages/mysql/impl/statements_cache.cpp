@@ -10,8 +10,11 @@ constexpr std::chrono::milliseconds kDefaultStatementDeleteTimeout{200};
 
 }
 
-StatementsCache::StatementsCache(Connection& connection, std::size_t capacity)
-    : connection_{connection}, cache_{capacity} {
+StatementsCache::StatementsCache(Connection& connection, std::size_t capacity,
+                                 HotStatements* hot_statements)
+    : connection_{connection},
+      hot_statements_{hot_statements},
+      cache_{capacity} {
   UASSERT(capacity > 0);
 }
 
@@ -44,6 +47,7 @@ Statement& StatementsCache::PrepareStatement(const std::string& statement,
   auto* added_statement =
       cache_.Emplace(statement, connection_, statement, deadline);
   UASSERT(added_statement);
+  if (hot_statements_) hot_statements_->Add(statement);
   return *added_statement;
 }
 
@@ -3,6 +3,7 @@
 #include <userver/cache/lru_map.hpp>
 #include <userver/utils/str_icase.hpp>
 
+#include <storages/mysql/impl/hot_statements.hpp>
 #include <storages/mysql/impl/statement.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -13,7 +14,9 @@ class Connection;
 
 class StatementsCache final {
  public:
-  StatementsCache(Connection& connection, std::size_t capacity);
+  // hot_statements may be nullptr
+  StatementsCache(Connection& connection, std::size_t capacity,
+                  HotStatements* hot_statements);
   ~StatementsCache();
 
   Statement& PrepareStatement(const std::string& statement,
@@ -21,6 +24,7 @@ class StatementsCache final {
 
  private:
   Connection& connection_;
+  HotStatements* hot_statements_;
 
   cache::LruMap<std::string, Statement, utils::StrIcaseHash,
                 utils::StrIcaseEqual>
@@ -59,6 +59,7 @@ Pool::Pool(clients::dns::Resolver& resolver,
                                   kMaxSimultaneouslyConnectingClients},
       resolver_{resolver},
       settings_{pool_settings},
+      hot_statements_{settings_.connection_settings.statements_cache_size},
       monitor_{*this} {
   try {
     Init(settings_.initial_pool_size, kConnectionSetupTimeout);
@@ -72,7 +73,7 @@ Pool::ConnectionUniquePtr Pool::DoCreateConnection(engine::Deadline deadline) {
   try {
     auto connection_ptr = std::make_unique<impl::Connection>(
         resolver_, settings_.endpoint_info, settings_.auth_settings,
-        settings_.connection_settings, deadline);
+        settings_.connection_settings, deadline, &hot_statements_);
     monitor_.AccountSuccess();
 
     return connection_ptr;
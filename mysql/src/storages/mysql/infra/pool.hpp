@@ -10,6 +10,7 @@
 
 #include <userver/drivers/impl/connection_pool_base.hpp>
 
+#include <storages/mysql/impl/hot_statements.hpp>
 #include <storages/mysql/infra/connection_ptr.hpp>
 #include <storages/mysql/infra/statistics.hpp>
 #include <storages/mysql/settings/settings.hpp>
@@ -85,6 +86,8 @@ class Pool final
 
   PoolConnectionStatistics stats_{};
 
+  impl::HotStatements hot_statements_;
+
   PoolMonitor monitor_;
 };
 
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <userver/utest/utest.hpp>
 #include "../utils_mysqltest.hpp"
 
@@ -86,6 +88,40 @@ UTEST(Cluster, InsertMany) {
   EXPECT_EQ(db_rows, rows_to_insert);
 }
 
+UTEST(Cluster, InsertManyChunked) {
+  ClusterWrapper cluster{};
+  TmpTable table{cluster, "Id INT NOT NULL, Value TEXT NOT NULL"};
+
+  const std::string long_string_to_avoid_sso{
+      "hi i am some long string that doesn't fit in sso"};
+
+  constexpr int kRowsCount = 1000;
+
+  std::vector<Row> rows_to_insert;
+  rows_to_insert.reserve(kRowsCount);
+  for (int i = 0; i < kRowsCount; ++i) {
+    rows_to_insert.push_back(
+        {i, fmt::format("{}: {}", i, long_string_to_avoid_sso)});
+  }
+
+  BulkSettings settings;
+  settings.max_chunk_rows = 100;
+  settings.max_chunk_bytes = 2048;
+  settings.max_parallel_chunks = 3;
+
+  const auto result = cluster->ExecuteBulkChunked(
+      ClusterHostType::kPrimary,
+      table.FormatWithTableName("INSERT INTO {}(Id, Value) VALUES(?, ?)"),
+      rows_to_insert, settings);
+  EXPECT_EQ(result.rows_affected, kRowsCount);
+
+  auto db_rows =
+      table.DefaultExecute("SELECT Id, Value FROM {}").AsVector<Row>();
+  std::sort(db_rows.begin(), db_rows.end(),
+            [](const Row& lhs, const Row& rhs) { return lhs.id < rhs.id; });
+  EXPECT_EQ(db_rows, rows_to_insert);
+}
+
 UTEST(Cluster, UpdateMany) {
   ClusterWrapper cluster{};
   TmpTable table{cluster, "Id INT PRIMARY KEY, Value TEXT NOT NULL"};
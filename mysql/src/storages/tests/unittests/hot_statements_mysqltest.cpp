@@ -0,0 +1,149 @@
+#include <userver/utest/utest.hpp>
+
+#include <algorithm>
+#include <optional>
+
+#include <fmt/format.h>
+
+#include <userver/clients/dns/resolver.hpp>
+#include <userver/engine/task/task.hpp>
+#include <userver/storages/mysql/impl/io/params_binder.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/uuid4.hpp>
+
+#include <storages/mysql/impl/connection.hpp>
+#include <storages/mysql/impl/hot_statements.hpp>
+#include <storages/mysql/infra/connection_ptr.hpp>
+#include <storages/mysql/infra/pool.hpp>
+#include <storages/mysql/settings/settings.hpp>
+#include "../utils_mysqltest.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::mysql::tests {
+
+namespace {
+
+settings::PoolSettings MakePoolSettings(std::size_t statements_cache_size) {
+  settings::PoolSettings settings{};
+  settings.initial_pool_size = 1;
+  settings.max_pool_size = 2;
+  settings.endpoint_info = {"localhost", GetMysqlPort()};
+  settings.auth_settings.database = "userver_mysql_test";
+  settings.auth_settings.user = "root";
+  settings.connection_settings = {statements_cache_size, false, false,
+                                  settings::IpMode::kIpV4};
+  return settings;
+}
+
+engine::Deadline MakeDeadline() {
+  return engine::Deadline::FromDuration(std::chrono::seconds{20});
+}
+
+void Execute(impl::Connection& connection, const std::string& statement) {
+  impl::io::ParamsBinder params{0};
+  connection.ExecuteStatement(statement, params, MakeDeadline(), {});
+}
+
+// Number of the statements prepared in the session of the connection
+std::size_t GetPreparedCount(impl::Connection& connection) {
+  const auto result = connection.ExecuteQuery(
+      "SHOW SESSION STATUS LIKE 'Com_stmt_prepare'", MakeDeadline());
+  EXPECT_EQ(result.RowsCount(), 1);
+  return utils::FromString<std::size_t>(result.GetRow(0).GetField(1));
+}
+
+class PoolWrapper final {
+ public:
+  explicit PoolWrapper(std::size_t statements_cache_size)
+      : resolver_{engine::current_task::GetTaskProcessor(), {}},
+        pool_{infra::Pool::Create(resolver_,
+                                  MakePoolSettings(statements_cache_size))} {}
+
+  // The pool is kept busy by the callers, so every call after the first one
+  // creates a new connection
+  infra::ConnectionPtr Acquire() { return pool_->Acquire(MakeDeadline()); }
+
+ private:
+  clients::dns::Resolver resolver_;
+  std::shared_ptr<infra::Pool> pool_;
+};
+
+}  // namespace
+
+UTEST(HotStatements, PreparedOnNewPoolConnection) {
+  PoolWrapper pool{10};
+
+  auto first = pool.Acquire();
+  Execute(*first, "DO 1");
+
+  auto second = pool.Acquire();
+  const auto prepared_count = GetPreparedCount(*second);
+  Execute(*second, "DO 1");
+  EXPECT_EQ(GetPreparedCount(*second), prepared_count);
+
+  Execute(*second, "DO 2");
+  EXPECT_EQ(GetPreparedCount(*second), prepared_count + 1);
+}
+
+UTEST(HotStatements, FailedPrepareIsSkipped) {
+  PoolWrapper pool{10};
+
+  std::string table_name{"tmp_"};
+  for (const auto c : utils::generators::GenerateUuid()) {
+    if (c != '-') table_name.push_back(c);
+  }
+
+  auto first = pool.Acquire();
+  first->ExecuteQuery(fmt::format("CREATE TABLE {} (Id INT)", table_name),
+                      MakeDeadline());
+  Execute(*first, fmt::format("SELECT Id FROM {}", table_name));
+  Execute(*first, "DO 1");
+  // The statement can't be prepared on the new connections anymore
+  first->ExecuteQuery(fmt::format("DROP TABLE {}", table_name),
+                      MakeDeadline());
+
+  std::optional<infra::ConnectionPtr> second;
+  UEXPECT_NO_THROW(second.emplace(pool.Acquire()));
+  ASSERT_TRUE(second);
+  EXPECT_FALSE((*second)->IsBroken());
+
+  const auto prepared_count = GetPreparedCount(**second);
+  Execute(**second, "DO 1");
+  EXPECT_EQ(GetPreparedCount(**second), prepared_count);
+}
+
+UTEST(HotStatements, CapacityIsRespected) {
+  PoolWrapper pool{2};
+
+  auto first = pool.Acquire();
+  Execute(*first, "DO 1");
+  Execute(*first, "DO 2");
+  Execute(*first, "DO 3");
+
+  auto second = pool.Acquire();
+  const auto prepared_count = GetPreparedCount(*second);
+  Execute(*second, "DO 2");
+  Execute(*second, "DO 3");
+  EXPECT_EQ(GetPreparedCount(*second), prepared_count);
+
+  // Evicted by the more recent statements
+  Execute(*second, "DO 1");
+  EXPECT_EQ(GetPreparedCount(*second), prepared_count + 1);
+}
+
+TEST(HotStatements, LruOrder) {
+  impl::HotStatements hot_statements{2};
+  hot_statements.Add("DO 1");
+  hot_statements.Add("DO 2");
+  hot_statements.Add("DO 1");
+  hot_statements.Add("DO 3");
+
+  auto statements = hot_statements.Get();
+  std::sort(statements.begin(), statements.end());
+  EXPECT_EQ(statements, (std::vector<std::string>{"DO 1", "DO 3"}));
+}
+
+}  // namespace storages::mysql::tests
+
+USERVER_NAMESPACE_END
@@ -10,6 +10,7 @@
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -21,11 +22,14 @@
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
 #include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/storages/postgres/replication.hpp>
 
 #include <userver/compiler/demangle.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/cpu_relax.hpp>
 #include <userver/utils/meta.hpp>
 #include <userver/utils/void_t.hpp>
@@ -66,6 +70,7 @@ namespace components {
 /// incremental-update-op-timeout | timeout for an incremental update | 1s
 /// update-correction | incremental update window adjustment | - (0 for caches with defined GetLastKnownUpdated)
 /// chunk-size | number of rows to request from PostgreSQL via portals, 0 to fetch all rows in one request without portals | 1000
+/// full-update-parallelism | number of concurrent queries of a full update for each shard, see @ref pg_cc_parallel_full_update | 1
 ///
 /// @section pg_cc_cache_policy Cache policy
 ///
@@ -97,6 +102,70 @@ namespace components {
 ///
 /// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Custom Container With Write Notification Example
 ///
+/// Incremental updates copy the cache container. For large caches use
+/// cache::PersistentHashMap as the CacheContainer: its copy is O(1) and shares
+/// the data with the previous snapshot, so an update costs
+/// O(changed * log(size)) instead of O(size) time and memory.
+///
+/// Caches with full updates only may use cache::FlatHashMap as the
+/// CacheContainer for faster lookups.
+///
+/// @section pg_cc_parallel_full_update Parallel full updates
+///
+/// A full update of a big cache may be split into `full-update-parallelism`
+/// queries that are fetched and parsed concurrently on the task processor of
+/// the cache. The policy has to define `kFullUpdatePartitionKey`, an SQL
+/// expression the rows are distributed by:
+///
+/// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Parallel Full Update Example
+///
+/// The partition N of M gets the rows with
+/// `(hashtext((kFullUpdatePartitionKey)::text) & 2147483647) % M = N`.
+/// Each query still scans all the rows matching `kWhere` on the database
+/// side, so the option pays off when deserialization of the rows dominates.
+/// The queries run in separate transactions and do not see a single snapshot
+/// of the table. Rows changed during the update may be seen in any of their
+/// states until the next update.
+///
+/// @section pg_cc_replication Incremental updates by logical replication
+///
+/// Instead of polling the table by `kUpdatedField`, the cache may receive
+/// the changes of the table from a publication through
+/// storages::postgres::ReplicationStream. The policy defines
+/// `kReplicationPublication` and the `schema.table` name of the cached table
+/// in `kReplicationTable`:
+///
+/// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Replication Example
+///
+/// A full update creates a temporary replication slot on the master host of
+/// each shard, loads the data from the master and starts streaming the
+/// changes made since the slot creation. Each incremental update applies the
+/// transactions that are already received, for no longer than
+/// `incremental-update-op-timeout`, and reports them as applied to the
+/// server. Inserts, updates, deletes and truncates of the table are
+/// supported, the changes of the other tables of the publication are
+/// skipped. If the stream fails, e.g. on a switchover of the master, the
+/// next update is a full one.
+///
+/// Requirements and limitations:
+/// * `wal_level = logical` and PostgreSQL 14 or newer, the user of the
+///   cache needs the `REPLICATION` attribute;
+/// * the row type gets all the published columns in the table order, so the
+///   query has to select exactly them in the same order, `kWhere` is not
+///   supported;
+/// * the CacheContainer must support `erase` by the key, e.g.
+///   cache::PersistentHashMap is not supported;
+/// * an update of a row that does not change its TOASTed values sends no
+///   such values, set `REPLICA IDENTITY FULL` on the table to receive them
+///   from the old row image. Otherwise such changes are counted as parse
+///   failures;
+/// * each cache instance holds a replication connection and a slot on every
+///   shard, mind `max_wal_senders` and `max_replication_slots`.
+///
+/// Set `update-interval` to the desired staleness and `full-update-interval`
+/// large enough: the full updates are needed only at the startup and after
+/// a loss of the stream.
+///
 /// @section pg_cc_forward_declaration Forward Declaration
 ///
 /// To forward declare a cache you can forward declare a trait and
@@ -174,6 +243,61 @@ template <typename T>
 inline constexpr bool kWantIncrementalUpdates =
     meta::kIsDetected<WantIncrementalUpdates, T>;
 
+// Full update partition key in policy
+template <typename T>
+using HasFullUpdatePartitionKey = decltype(T::kFullUpdatePartitionKey);
+template <typename T>
+inline constexpr bool kHasFullUpdatePartitionKey =
+    meta::kIsDetected<HasFullUpdatePartitionKey, T>;
+
+// Logical replication publication in policy
+template <typename T>
+using WantReplicationUpdates =
+    std::enable_if_t<!std::string_view{T::kReplicationPublication}.empty()>;
+template <typename T>
+inline constexpr bool kWantReplicationUpdates =
+    meta::kIsDetected<WantReplicationUpdates, T>;
+
+// Replicated table in policy
+template <typename T>
+using HasReplicationTable = decltype(T::kReplicationTable);
+template <typename T>
+inline constexpr bool kHasReplicationTable =
+    meta::kIsDetected<HasReplicationTable, T>;
+
+template <typename T>
+constexpr std::string_view ReplicationPublication() {
+  if constexpr (kWantReplicationUpdates<T>) {
+    return T::kReplicationPublication;
+  } else {
+    return {};
+  }
+}
+
+template <typename T>
+constexpr std::string_view ReplicationTable() {
+  if constexpr (kHasReplicationTable<T>) {
+    return T::kReplicationTable;
+  } else {
+    return {};
+  }
+}
+
+// Checks that the relation is the `schema.table` of the policy
+template <typename T>
+bool IsReplicatedTable(
+    const storages::postgres::ReplicationRelation& relation) {
+  constexpr auto name = ReplicationTable<T>();
+  const auto& schema = relation.schema;
+  return name.size() == schema.size() + 1 + relation.table.size() &&
+         name.substr(0, schema.size()) == schema &&
+         name[schema.size()] == '.' &&
+         name.substr(schema.size() + 1) == relation.table;
+}
+
+// Unique name of a temporary replication slot of the cache
+std::string MakeReplicationSlotName(std::string_view cache_name);
+
 // Key member in policy
 template <typename T>
 using KeyMemberTypeImpl =
@@ -203,6 +327,8 @@ using DataCacheContainerType = typename DataCacheContainer<T>::type;
 
 // We have to whitelist container types, for which we perform by-element
 // copying, because it's not correct for certain custom containers.
+// Containers with structural sharing, e.g. cache::PersistentHashMap, are
+// copied in O(1) by their copy constructor.
 template <typename T>
 inline constexpr bool kIsContainerCopiedByElement =
     meta::kIsInstantiationOf<std::unordered_map, T> ||
@@ -240,6 +366,15 @@ void CacheInsertOrAssign(Container& container, Value&& value,
   container.insert_or_assign(std::move(key), std::forward<Value>(value));
 }
 
+template <typename Container, typename Value, typename KeyMember,
+          typename... Args>
+void CacheErase(Container& container, const Value& value,
+                const KeyMember& key_member, Args&&... /*args*/) {
+  // Args are only used to de-prioritize this default overload.
+  static_assert(sizeof...(Args) == 0);
+  container.erase(std::invoke(key_member, value));
+}
+
 template <typename T>
 using HasOnWritesDoneImpl = decltype(std::declval<T&>().OnWritesDone());
 
@@ -293,6 +428,9 @@ template <typename T>
 constexpr storages::postgres::ClusterHostTypeFlags ClusterHostType() {
   if constexpr (meta::kIsDetected<HasClusterHostTypeImpl, T>) {
     return T::kClusterHostType;
+  } else if constexpr (kWantReplicationUpdates<T>) {
+    // The full update must see the changes made before the slot creation
+    return storages::postgres::ClusterHostType::kMaster;
   } else {
     return storages::postgres::ClusterHostType::kSlave;
   }
@@ -345,6 +483,26 @@ struct PolicyChecker {
                 "Cluster host role must be specified for caching component, "
                 "please be more specific");
 
+  static_assert(!kWantReplicationUpdates<PostgreCachePolicy> ||
+                    kHasReplicationTable<PostgreCachePolicy>,
+                "The PostgreSQL cache policy with `kReplicationPublication` "
+                "must contain a static member `kReplicationTable` with the "
+                "'schema.table' name of the cached table");
+  static_assert(!(kWantReplicationUpdates<PostgreCachePolicy> &&
+                  kWantIncrementalUpdates<PostgreCachePolicy>),
+                "The PostgreSQL cache policy must use either `kUpdatedField` "
+                "or `kReplicationPublication` for incremental updates, set "
+                "`kUpdatedField` to `nullptr`");
+  static_assert(!(kWantReplicationUpdates<PostgreCachePolicy> &&
+                  kHasWhere<PostgreCachePolicy>),
+                "Replicated changes can not be filtered with `kWhere`");
+  static_assert(!kWantReplicationUpdates<PostgreCachePolicy> ||
+                    (ClusterHostType<PostgreCachePolicy>() &
+                     storages::postgres::kClusterHostRolesMask) ==
+                        storages::postgres::ClusterHostType::kMaster,
+                "The full updates of a cache with `kReplicationPublication` "
+                "must read the master host");
+
   static storages::postgres::Query GetQuery() {
     if constexpr (kHasGetQuery<PostgreCachePolicy>) {
       return PostgreCachePolicy::GetQuery();
@@ -366,8 +524,31 @@ inline constexpr std::chrono::milliseconds kCpuRelaxInterval{2};
 inline constexpr std::string_view kCopyStage = "copy_data";
 inline constexpr std::string_view kFetchStage = "fetch";
 inline constexpr std::string_view kParseStage = "parse";
+inline constexpr std::string_view kMergeStage = "merge";
 
 inline constexpr std::size_t kDefaultChunkSize = 1000;
+inline constexpr std::size_t kDefaultFullUpdateParallelism = 1;
+
+inline std::chrono::milliseconds ToMilliseconds(
+    tracing::ScopeTime::DurationMillis duration) {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+}
+
+inline void AddStageDurations(const tracing::ScopeTime& scope,
+                              cache::UpdateStatisticsScope& stats_scope) {
+  stats_scope.AddStageDuration(
+      cache::UpdateStage::kCopy,
+      ToMilliseconds(scope.ElapsedTotal(std::string{kCopyStage})));
+  stats_scope.AddStageDuration(
+      cache::UpdateStage::kFetch,
+      ToMilliseconds(scope.ElapsedTotal(std::string{kFetchStage})));
+  stats_scope.AddStageDuration(
+      cache::UpdateStage::kParse,
+      ToMilliseconds(scope.ElapsedTotal(std::string{kParseStage})));
+  stats_scope.AddStageDuration(
+      cache::UpdateStage::kMerge,
+      ToMilliseconds(scope.ElapsedTotal(std::string{kMergeStage})));
+}
 }  // namespace pg_cache::detail
 
 /// @ingroup userver_components
@@ -390,8 +571,11 @@ class PostgreCache final
   using BaseType = typename PolicyCheckerType::BaseType;
 
   // Calculated constants
+  constexpr static bool kReplicationUpdates =
+      pg_cache::detail::kWantReplicationUpdates<PolicyType>;
   constexpr static bool kIncrementalUpdates =
-      pg_cache::detail::kWantIncrementalUpdates<PolicyType>;
+      pg_cache::detail::kWantIncrementalUpdates<PolicyType> ||
+      kReplicationUpdates;
   constexpr static auto kClusterHostTypeFlags =
       pg_cache::detail::ClusterHostType<PolicyType>();
   constexpr static auto kName = PolicyType::kName;
@@ -416,21 +600,55 @@ class PostgreCache final
   bool MayReturnNull() const override;
 
   CachedData GetDataSnapshot(cache::UpdateType type, tracing::ScopeTime& scope);
-  void CacheResults(storages::postgres::ResultSet res, CachedData& data_cache,
+
+  // Fetches the rows of the `query` from the `cluster` and passes the parsed
+  // values to the `consumer`, returns the number of the fetched rows
+  template <typename Consumer>
+  std::size_t FetchAndParse(storages::postgres::Cluster& cluster,
+                            const storages::postgres::Query& query,
+                            std::chrono::milliseconds timeout,
+                            const UpdatedFieldType& last_updated,
+                            Consumer& consumer,
+                            cache::UpdateStatisticsScope& stats_scope,
+                            tracing::ScopeTime& scope);
+
+  template <typename Consumer>
+  void ParseResults(storages::postgres::ResultSet res, Consumer& consumer,
                     cache::UpdateStatisticsScope& stats_scope,
                     tracing::ScopeTime& scope);
 
+  std::size_t FullUpdateParallel(DataType& data_cache,
+                                 const UpdatedFieldType& last_updated,
+                                 cache::UpdateStatisticsScope& stats_scope,
+                                 tracing::ScopeTime& scope);
+
+  std::vector<storages::postgres::ReplicationStream> CreateReplicationStreams();
+
+  // Applies the changes received by the replication streams, the micro-batch
+  // is bounded by the incremental update timeout
+  void ReplicationUpdate(cache::UpdateStatisticsScope& stats_scope);
+
+  void ApplyReplicationChange(
+      DataType& data_cache,
+      const storages::postgres::ReplicationChange& change,
+      cache::UpdateStatisticsScope& stats_scope);
+
   static storages::postgres::Query GetAllQuery();
   static storages::postgres::Query GetDeltaQuery();
+  static storages::postgres::Query GetPartitionQuery(std::size_t partition,
+                                                     std::size_t partitions);
 
   std::chrono::milliseconds ParseCorrection(const ComponentConfig& config);
 
   std::vector<storages::postgres::ClusterPtr> clusters_;
+  // A stream for each shard, empty until a successful full update
+  std::vector<storages::postgres::ReplicationStream> replication_streams_;
 
   const std::chrono::system_clock::duration correction_;
   const std::chrono::milliseconds full_update_timeout_;
   const std::chrono::milliseconds incremental_update_timeout_;
   const std::size_t chunk_size_;
+  const std::size_t full_update_parallelism_;
   std::size_t cpu_relax_iterations_parse_{0};
   std::size_t cpu_relax_iterations_copy_{0};
 };
@@ -450,7 +668,9 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
           config["incremental-update-op-timeout"].As<std::chrono::milliseconds>(
               pg_cache::detail::kDefaultIncrementalUpdateTimeout)},
       chunk_size_{config["chunk-size"].As<size_t>(
-          pg_cache::detail::kDefaultChunkSize)} {
+          pg_cache::detail::kDefaultChunkSize)},
+      full_update_parallelism_{config["full-update-parallelism"].As<size_t>(
+          pg_cache::detail::kDefaultFullUpdateParallelism)} {
   UINVARIANT(
       !chunk_size_ || storages::postgres::Portal::IsSupportedByDriver(),
       "Either set 'chunk-size' to 0, or enable PostgreSQL portals by building "
@@ -470,6 +690,17 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
         "config for '" +
         config.Name() + "' cache");
   }
+  if (full_update_parallelism_ == 0) {
+    throw std::logic_error("'full-update-parallelism' must be positive for '" +
+                           config.Name() + "' cache");
+  }
+  if (full_update_parallelism_ > 1 &&
+      !pg_cache::detail::kHasFullUpdatePartitionKey<PostgreCachePolicy>) {
+    throw std::logic_error(
+        "Parallel full updates are requested in config but no "
+        "kFullUpdatePartitionKey is specified in traits of '" +
+        config.Name() + "' cache");
+  }
 
   const auto pg_alias = config["pgcomponent"].As<std::string>("");
   if (pg_alias.empty()) {
@@ -483,9 +714,23 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
     clusters_[i] = pg_cluster_comp.GetClusterForShard(i);
   }
 
-  LOG_INFO() << "Cache " << kName << " full update query `"
-             << GetAllQuery().Statement() << "` incremental update query `"
-             << GetDeltaQuery().Statement() << "`";
+  if constexpr (kReplicationUpdates) {
+    LOG_INFO() << "Cache " << kName << " full update query `"
+               << GetAllQuery().Statement()
+               << "` incremental updates are replicated from publication `"
+               << pg_cache::detail::ReplicationPublication<PolicyType>()
+               << "`";
+  } else {
+    LOG_INFO() << "Cache " << kName << " full update query `"
+               << GetAllQuery().Statement() << "` incremental update query `"
+               << GetDeltaQuery().Statement() << "`";
+  }
+  if (full_update_parallelism_ > 1) {
+    LOG_INFO() << "Cache " << kName << " full update is split into "
+               << full_update_parallelism_ << " queries like `"
+               << GetPartitionQuery(0, full_update_parallelism_).Statement()
+               << "`";
+  }
 
   this->StartPeriodicUpdates();
 }
@@ -509,7 +754,7 @@ storages::postgres::Query PostgreCache<PostgreCachePolicy>::GetAllQuery() {
 
 template <typename PostgreCachePolicy>
 storages::postgres::Query PostgreCache<PostgreCachePolicy>::GetDeltaQuery() {
-  if constexpr (kIncrementalUpdates) {
+  if constexpr (pg_cache::detail::kWantIncrementalUpdates<PolicyType>) {
     storages::postgres::Query query = PolicyCheckerType::GetQuery();
 
     if constexpr (pg_cache::detail::kHasWhere<PostgreCachePolicy>) {
@@ -527,11 +772,37 @@ storages::postgres::Query PostgreCache<PostgreCachePolicy>::GetDeltaQuery() {
   }
 }
 
+template <typename PostgreCachePolicy>
+storages::postgres::Query PostgreCache<PostgreCachePolicy>::GetPartitionQuery(
+    [[maybe_unused]] std::size_t partition,
+    [[maybe_unused]] std::size_t partitions) {
+  if constexpr (pg_cache::detail::kHasFullUpdatePartitionKey<
+                    PostgreCachePolicy>) {
+    storages::postgres::Query query = PolicyCheckerType::GetQuery();
+    const auto condition =
+        fmt::format("(hashtext(({})::text) & 2147483647) % {} = {}",
+                    PostgreCachePolicy::kFullUpdatePartitionKey, partitions,
+                    partition);
+
+    if constexpr (pg_cache::detail::kHasWhere<PostgreCachePolicy>) {
+      return {fmt::format("{} where ({}) and {}", query.Statement(),
+                          PostgreCachePolicy::kWhere, condition),
+              query.GetName()};
+    } else {
+      return {fmt::format("{} where {}", query.Statement(), condition),
+              query.GetName()};
+    }
+  } else {
+    return GetAllQuery();
+  }
+}
+
 template <typename PostgreCachePolicy>
 std::chrono::milliseconds PostgreCache<PostgreCachePolicy>::ParseCorrection(
     const ComponentConfig& config) {
   static constexpr std::string_view kUpdateCorrection = "update-correction";
   if (pg_cache::detail::kHasCustomUpdated<PostgreCachePolicy> ||
+      kReplicationUpdates ||
       this->GetAllowedUpdateTypes() == cache::AllowedUpdateTypes::kOnlyFull) {
     return config[kUpdateCorrection].As<std::chrono::milliseconds>(0);
   } else {
@@ -557,10 +828,24 @@ void PostgreCache<PostgreCachePolicy>::Update(
     const std::chrono::system_clock::time_point& last_update,
     const std::chrono::system_clock::time_point& /*now*/,
     cache::UpdateStatisticsScope& stats_scope) {
-  namespace pg = storages::postgres;
   if constexpr (!kIncrementalUpdates) {
     type = cache::UpdateType::kFull;
   }
+  std::vector<storages::postgres::ReplicationStream> replication_streams;
+  if constexpr (kReplicationUpdates) {
+    if (type == cache::UpdateType::kIncremental &&
+        !replication_streams_.empty()) {
+      ReplicationUpdate(stats_scope);
+      return;
+    }
+    type = cache::UpdateType::kFull;
+    if (this->GetAllowedUpdateTypes() !=
+        cache::AllowedUpdateTypes::kOnlyFull) {
+      // The slots keep the changes made during the full update
+      replication_streams_.clear();
+      replication_streams = CreateReplicationStreams();
+    }
+  }
   const auto query =
       (type == cache::UpdateType::kFull) ? GetAllQuery() : GetDeltaQuery();
   const std::chrono::milliseconds timeout = (type == cache::UpdateType::kFull)
@@ -576,42 +861,22 @@ void PostgreCache<PostgreCachePolicy>::Update(
   scope.Reset(std::string{pg_cache::detail::kFetchStage});
 
   size_t changes = 0;
-  // Iterate clusters
-  for (auto& cluster : clusters_) {
-    if (chunk_size_ > 0) {
-      auto trx = cluster->Begin(
-          kClusterHostTypeFlags, pg::Transaction::RO,
-          pg::CommandControl{timeout, pg_cache::detail::kStatementTimeoutOff});
-      auto portal =
-          trx.MakePortal(query, GetLastUpdated(last_update, *data_cache));
-      while (portal) {
-        scope.Reset(std::string{pg_cache::detail::kFetchStage});
-        auto res = portal.Fetch(chunk_size_);
-        stats_scope.IncreaseDocumentsReadCount(res.Size());
-
-        scope.Reset(std::string{pg_cache::detail::kParseStage});
-        CacheResults(res, data_cache, stats_scope, scope);
-        changes += res.Size();
-      }
-      trx.Commit();
-    } else {
-      bool has_parameter = query.Statement().find('$') != std::string::npos;
-      auto res = has_parameter
-                     ? cluster->Execute(
-                           kClusterHostTypeFlags,
-                           pg::CommandControl{
-                               timeout, pg_cache::detail::kStatementTimeoutOff},
-                           query, GetLastUpdated(last_update, *data_cache))
-                     : cluster->Execute(
-                           kClusterHostTypeFlags,
-                           pg::CommandControl{
-                               timeout, pg_cache::detail::kStatementTimeoutOff},
-                           query);
-      stats_scope.IncreaseDocumentsReadCount(res.Size());
-
-      scope.Reset(std::string{pg_cache::detail::kParseStage});
-      CacheResults(res, data_cache, stats_scope, scope);
-      changes += res.Size();
+  if (type == cache::UpdateType::kFull && full_update_parallelism_ > 1) {
+    changes = FullUpdateParallel(
+        *data_cache, GetLastUpdated(last_update, *data_cache), stats_scope,
+        scope);
+  } else {
+    const auto consumer = [&data_cache](ValueType&& value) {
+      using pg_cache::detail::CacheInsertOrAssign;
+      CacheInsertOrAssign(*data_cache, std::move(value),
+                          PostgreCachePolicy::kKeyMember);
+    };
+    // Iterate clusters
+    for (auto& cluster : clusters_) {
+      changes +=
+          FetchAndParse(*cluster, query, timeout,
+                        GetLastUpdated(last_update, *data_cache), consumer,
+                        stats_scope, scope);
     }
   }
 
@@ -646,6 +911,7 @@ void PostgreCache<PostgreCachePolicy>::Update(
                   << cpu_relax_iterations_parse_ << " iterations";
     }
   }
+  pg_cache::detail::AddStageDurations(scope, stats_scope);
   if (changes > 0 || type == cache::UpdateType::kFull) {
     // Set current cache
     stats_scope.Finish(data_cache->size());
@@ -654,6 +920,12 @@ void PostgreCache<PostgreCachePolicy>::Update(
   } else {
     stats_scope.FinishNoChanges();
   }
+
+  if constexpr (kReplicationUpdates) {
+    const auto deadline = engine::Deadline::FromDuration(full_update_timeout_);
+    for (auto& stream : replication_streams) stream.Start(deadline);
+    replication_streams_ = std::move(replication_streams);
+  }
 }
 
 template <typename PostgreCachePolicy>
@@ -662,18 +934,63 @@ bool PostgreCache<PostgreCachePolicy>::MayReturnNull() const {
 }
 
 template <typename PostgreCachePolicy>
-void PostgreCache<PostgreCachePolicy>::CacheResults(
-    storages::postgres::ResultSet res, CachedData& data_cache,
+template <typename Consumer>
+std::size_t PostgreCache<PostgreCachePolicy>::FetchAndParse(
+    storages::postgres::Cluster& cluster,
+    const storages::postgres::Query& query, std::chrono::milliseconds timeout,
+    const UpdatedFieldType& last_updated, Consumer& consumer,
+    cache::UpdateStatisticsScope& stats_scope, tracing::ScopeTime& scope) {
+  namespace pg = storages::postgres;
+  size_t changes = 0;
+  if (chunk_size_ > 0) {
+    auto trx = cluster.Begin(
+        kClusterHostTypeFlags, pg::Transaction::RO,
+        pg::CommandControl{timeout, pg_cache::detail::kStatementTimeoutOff});
+    auto portal = trx.MakePortal(query, last_updated);
+    while (portal) {
+      scope.Reset(std::string{pg_cache::detail::kFetchStage});
+      auto res = portal.Fetch(chunk_size_);
+      stats_scope.IncreaseDocumentsReadCount(res.Size());
+
+      scope.Reset(std::string{pg_cache::detail::kParseStage});
+      ParseResults(res, consumer, stats_scope, scope);
+      changes += res.Size();
+    }
+    trx.Commit();
+  } else {
+    scope.Reset(std::string{pg_cache::detail::kFetchStage});
+    bool has_parameter = query.Statement().find('$') != std::string::npos;
+    auto res = has_parameter
+                   ? cluster.Execute(
+                         kClusterHostTypeFlags,
+                         pg::CommandControl{
+                             timeout, pg_cache::detail::kStatementTimeoutOff},
+                         query, last_updated)
+                   : cluster.Execute(
+                         kClusterHostTypeFlags,
+                         pg::CommandControl{
+                             timeout, pg_cache::detail::kStatementTimeoutOff},
+                         query);
+    stats_scope.IncreaseDocumentsReadCount(res.Size());
+
+    scope.Reset(std::string{pg_cache::detail::kParseStage});
+    ParseResults(res, consumer, stats_scope, scope);
+    changes += res.Size();
+  }
+  return changes;
+}
+
+template <typename PostgreCachePolicy>
+template <typename Consumer>
+void PostgreCache<PostgreCachePolicy>::ParseResults(
+    storages::postgres::ResultSet res, Consumer& consumer,
     cache::UpdateStatisticsScope& stats_scope, tracing::ScopeTime& scope) {
   auto values = res.AsSetOf<RawValueType>(storages::postgres::kRowTag);
   utils::CpuRelax relax{cpu_relax_iterations_parse_, &scope};
   for (auto p = values.begin(); p != values.end(); ++p) {
     relax.Relax();
     try {
-      using pg_cache::detail::CacheInsertOrAssign;
-      CacheInsertOrAssign(
-          *data_cache, pg_cache::detail::ExtractValue<PostgreCachePolicy>(*p),
-          PostgreCachePolicy::kKeyMember);
+      consumer(pg_cache::detail::ExtractValue<PostgreCachePolicy>(*p));
     } catch (const std::exception& e) {
       stats_scope.IncreaseDocumentsParseFailures(1);
       LOG_ERROR() << "Error parsing data row in cache '" << kName << "' to '"
@@ -682,6 +999,189 @@ void PostgreCache<PostgreCachePolicy>::CacheResults(
   }
 }
 
+template <typename PostgreCachePolicy>
+std::size_t PostgreCache<PostgreCachePolicy>::FullUpdateParallel(
+    DataType& data_cache, const UpdatedFieldType& last_updated,
+    cache::UpdateStatisticsScope& stats_scope, tracing::ScopeTime& scope) {
+  using Values = std::vector<ValueType>;
+
+  std::vector<engine::TaskWithResult<Values>> tasks;
+  tasks.reserve(clusters_.size() * full_update_parallelism_);
+  for (auto& cluster : clusters_) {
+    for (std::size_t i = 0; i < full_update_parallelism_; ++i) {
+      tasks.push_back(utils::Async(
+          "pg_cache_full_update_partition",
+          [this, &cluster, &last_updated, &stats_scope, i] {
+            const auto timeout = full_update_timeout_;
+            auto partition_scope =
+                tracing::Span::CurrentSpan().CreateScopeTime();
+            Values values;
+            auto consumer = [&values](ValueType&& value) {
+              values.push_back(std::move(value));
+            };
+            FetchAndParse(*cluster,
+                          GetPartitionQuery(i, full_update_parallelism_),
+                          timeout, last_updated, consumer, stats_scope,
+                          partition_scope);
+            partition_scope.Reset();
+            // The durations are summed over the partitions
+            pg_cache::detail::AddStageDurations(partition_scope, stats_scope);
+            return values;
+          }));
+    }
+  }
+
+  std::size_t changes = 0;
+  // Partitions of the same shard do not intersect, the rows of the later
+  // shards overwrite the earlier ones, as in the sequential update
+  for (auto& task : tasks) {
+    auto values = task.Get();
+    scope.Reset(std::string{pg_cache::detail::kMergeStage});
+    changes += values.size();
+    utils::CpuRelax relax{cpu_relax_iterations_parse_, &scope};
+    for (auto& value : values) {
+      relax.Relax();
+      using pg_cache::detail::CacheInsertOrAssign;
+      CacheInsertOrAssign(data_cache, std::move(value),
+                          PostgreCachePolicy::kKeyMember);
+    }
+  }
+  return changes;
+}
+
+template <typename PostgreCachePolicy>
+std::vector<storages::postgres::ReplicationStream>
+PostgreCache<PostgreCachePolicy>::CreateReplicationStreams() {
+  storages::postgres::ReplicationSettings settings;
+  settings.publications.emplace_back(
+      pg_cache::detail::ReplicationPublication<PolicyType>());
+
+  std::vector<storages::postgres::ReplicationStream> streams;
+  streams.reserve(clusters_.size());
+  for (auto& cluster : clusters_) {
+    settings.slot_name = pg_cache::detail::MakeReplicationSlotName(kName);
+    streams.push_back(cluster->CreateReplicationStream(
+        settings,
+        storages::postgres::CommandControl{
+            full_update_timeout_, pg_cache::detail::kStatementTimeoutOff}));
+  }
+  return streams;
+}
+
+template <typename PostgreCachePolicy>
+void PostgreCache<PostgreCachePolicy>::ReplicationUpdate(
+    cache::UpdateStatisticsScope& stats_scope) {
+  auto scope = tracing::Span::CurrentSpan().CreateScopeTime(
+      std::string{pg_cache::detail::kFetchStage});
+  const auto deadline =
+      engine::Deadline::FromDuration(incremental_update_timeout_);
+
+  std::vector<std::vector<storages::postgres::ReplicationTransaction>> batches(
+      replication_streams_.size());
+  std::size_t changes = 0;
+  try {
+    for (std::size_t i = 0; i < replication_streams_.size(); ++i) {
+      while (!deadline.IsReached()) {
+        // Takes only the changes that are already received
+        auto transaction = replication_streams_[i].WaitTransaction(
+            engine::Deadline::Passed());
+        if (!transaction) break;
+        for (const auto& change : transaction->changes) {
+          if (pg_cache::detail::IsReplicatedTable<PolicyType>(
+                  *change.relation)) {
+            ++changes;
+          }
+        }
+        batches[i].push_back(std::move(*transaction));
+      }
+    }
+  } catch (const std::exception&) {
+    // The slots are lost with the streams, the next update is a full one
+    replication_streams_.clear();
+    throw;
+  }
+  stats_scope.IncreaseDocumentsReadCount(changes);
+
+  if (changes > 0) {
+    scope.Reset(std::string{pg_cache::detail::kCopyStage});
+    auto data_cache = GetDataSnapshot(cache::UpdateType::kIncremental, scope);
+
+    scope.Reset(std::string{pg_cache::detail::kParseStage});
+    utils::CpuRelax relax{cpu_relax_iterations_parse_, &scope};
+    for (const auto& batch : batches) {
+      for (const auto& transaction : batch) {
+        for (const auto& change : transaction.changes) {
+          if (!pg_cache::detail::IsReplicatedTable<PolicyType>(
+                  *change.relation)) {
+            continue;
+          }
+          relax.Relax();
+          ApplyReplicationChange(*data_cache, change, stats_scope);
+        }
+      }
+    }
+
+    scope.Reset();
+    pg_cache::detail::AddStageDurations(scope, stats_scope);
+    stats_scope.Finish(data_cache->size());
+    pg_cache::detail::OnWritesDone(*data_cache);
+    this->Set(std::move(data_cache));
+  } else {
+    scope.Reset();
+    pg_cache::detail::AddStageDurations(scope, stats_scope);
+    stats_scope.FinishNoChanges();
+  }
+
+  try {
+    // The changes are in the cache, the server may recycle their WAL
+    for (std::size_t i = 0; i < batches.size(); ++i) {
+      if (!batches[i].empty()) {
+        replication_streams_[i].Confirm(batches[i].back().end_lsn);
+      }
+    }
+  } catch (const std::exception& e) {
+    replication_streams_.clear();
+    LOG_ERROR() << "Replication of cache '" << kName
+                << "' failed, the next update is a full one: " << e.what();
+  }
+}
+
+template <typename PostgreCachePolicy>
+void PostgreCache<PostgreCachePolicy>::ApplyReplicationChange(
+    DataType& data_cache, const storages::postgres::ReplicationChange& change,
+    cache::UpdateStatisticsScope& stats_scope) {
+  using ChangeType = storages::postgres::ReplicationChange::Type;
+  try {
+    switch (change.type) {
+      case ChangeType::kInsert:
+      case ChangeType::kUpdate: {
+        using pg_cache::detail::CacheInsertOrAssign;
+        CacheInsertOrAssign(data_cache,
+                            pg_cache::detail::ExtractValue<PostgreCachePolicy>(
+                                change.tuple.As<RawValueType>()),
+                            PostgreCachePolicy::kKeyMember);
+        break;
+      }
+      case ChangeType::kDelete: {
+        using pg_cache::detail::CacheErase;
+        CacheErase(data_cache,
+                   pg_cache::detail::ExtractValue<PostgreCachePolicy>(
+                       change.tuple.AsReplicaIdentity<RawValueType>()),
+                   PostgreCachePolicy::kKeyMember);
+        break;
+      }
+      case ChangeType::kTruncate:
+        data_cache.clear();
+        break;
+    }
+  } catch (const std::exception& e) {
+    stats_scope.IncreaseDocumentsParseFailures(1);
+    LOG_ERROR() << "Error applying a replicated row change in cache '" << kName
+                << "' to '" << compiler::GetTypeName<ValueType>()
+                << "': " << e.what();
+  }
+}
+
 template <typename PostgreCachePolicy>
 typename PostgreCache<PostgreCachePolicy>::CachedData
 PostgreCache<PostgreCachePolicy>::GetDataSnapshot(cache::UpdateType type,
@@ -719,6 +1219,12 @@ void CacheInsertOrAssign(Set& set, Value&& value,
   DoInsert(set, std::forward<Value>(value));
 }
 
+template <typename Set, typename Value, typename KeyMember>
+void CacheErase(Set& set, const Value& value,
+                const KeyMember& /*key_member*/) {
+  set.erase(value);
+}
+
 }  // namespace utils::impl::projected_set
 
 USERVER_NAMESPACE_END
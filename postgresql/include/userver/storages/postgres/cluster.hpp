@@ -19,6 +19,9 @@
 #include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
+#include <userver/storages/postgres/query_cache.hpp>
+#include <userver/storages/postgres/replication.hpp>
 #include <userver/storages/postgres/statistics.hpp>
 #include <userver/storages/postgres/transaction.hpp>
 
@@ -71,6 +74,15 @@ namespace detail {
 class ClusterImpl;
 using ClusterImplPtr = std::unique_ptr<ClusterImpl>;
 
+template <typename T>
+constexpr bool IsMappedToSystemTypes() {
+  if constexpr (!io::traits::kIsMappedToPg<T>) {
+    return false;
+  } else {
+    return io::IsTypeMappedToSystem<T>() || io::IsTypeMappedToSystemArray<T>();
+  }
+}
+
 }  // namespace detail
 
 /// @ingroup userver_clients
@@ -196,11 +208,54 @@ class Cluster {
                     const Query& query, const ParameterStore& store);
   /// @}
 
+  /// @brief Execute independent statements at host of specified type in one
+  /// roundtrip on a single connection.
+  /// @note You must specify at least one role from ClusterHostType here
+  ///
+  /// The statements are pipelined if the pipeline mode is enabled, otherwise
+  /// they are executed one by one. Returns the results in the order of the
+  /// statements, an error of a statement is stored in its result. Throws if
+  /// no connection is available.
+  ///
+  /// @see storages::postgres::QueryBatch
+  std::vector<BatchResult> ExecuteBatch(ClusterHostTypeFlags,
+                                        const QueryBatch& batch);
+
+  /// @brief Execute a read-only statement at host of specified type,
+  /// repeated executions with the same arguments are served from the client
+  /// side cache of results.
+  ///
+  /// The cache is enabled by the `query-cache` static config option, without
+  /// it the statement is just executed. Only the arguments of the built-in
+  /// types are supported.
+  ///
+  /// @warning With the invalidation channel the cache holds a connection to
+  /// the master to listen for notifications. While there is no connection the
+  /// results are only dropped by the TTL.
+  ///
+  /// @see storages::postgres::CachedQuery
+  template <typename... Args>
+  ResultSet ExecuteCached(ClusterHostTypeFlags, const CachedQuery& query,
+                          const Args&... args);
+
+  /// @brief Execute a read-only statement with the cached results with
+  /// specified host selection rules and command control settings.
+  template <typename... Args>
+  ResultSet ExecuteCached(ClusterHostTypeFlags, OptionalCommandControl,
+                          const CachedQuery& query, const Args&... args);
+
   /// @brief Listen for notifications on channel
   /// @warning Each NotifyScope owns a single connection taken from the pool,
   /// which effectively decreases the number of usable connections
   NotifyScope Listen(std::string_view channel, OptionalCommandControl = {});
 
+  /// @brief Create a logical replication stream of the master host
+  /// @warning Each ReplicationStream owns a separate replication connection
+  /// that is not accounted in the pool size, and a replication slot of the
+  /// server
+  ReplicationStream CreateReplicationStream(ReplicationSettings settings,
+                                            OptionalCommandControl = {});
+
   /// Replaces globally updated command control with a static user-provided one
   void SetDefaultCommandControl(CommandControl);
 
@@ -230,10 +285,20 @@ class Cluster {
  private:
   detail::NonTransaction Start(ClusterHostTypeFlags, OptionalCommandControl);
 
+  ResultSet DoExecute(ClusterHostTypeFlags, OptionalCommandControl,
+                      const Query& query,
+                      const detail::QueryParameters& params);
+
+  ResultSet DoExecuteCached(ClusterHostTypeFlags, OptionalCommandControl,
+                            const CachedQuery& query,
+                            const detail::QueryParameters& params);
+
   OptionalCommandControl GetQueryCmdCtl(const std::string& query_name) const;
   OptionalCommandControl GetHandlersCmdCtl(
       OptionalCommandControl cmd_ctl) const;
 
+  static UserTypes kNoUserTypes;
+
   detail::ClusterImplPtr pimpl_;
 };
 
@@ -251,8 +316,42 @@ ResultSet Cluster::Execute(ClusterHostTypeFlags flags,
     statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
   }
   statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
-  auto ntrx = Start(flags, statement_cmd_ctl);
-  return ntrx.Execute(statement_cmd_ctl, query, args...);
+  if constexpr ((detail::IsMappedToSystemTypes<Args>() && ...)) {
+    // Built-in types do not depend on the connection, so the statement may
+    // be pipelined together with the statements of other tasks
+    detail::StaticQueryParameters<sizeof...(args)> params;
+    params.Write(kNoUserTypes, args...);
+    return DoExecute(flags, statement_cmd_ctl, query,
+                     detail::QueryParameters{params});
+  } else {
+    auto ntrx = Start(flags, statement_cmd_ctl);
+    return ntrx.Execute(statement_cmd_ctl, query, args...);
+  }
+}
+
+template <typename... Args>
+ResultSet Cluster::ExecuteCached(ClusterHostTypeFlags flags,
+                                 const CachedQuery& query,
+                                 const Args&... args) {
+  return ExecuteCached(flags, OptionalCommandControl{}, query, args...);
+}
+
+template <typename... Args>
+ResultSet Cluster::ExecuteCached(ClusterHostTypeFlags flags,
+                                 OptionalCommandControl statement_cmd_ctl,
+                                 const CachedQuery& query,
+                                 const Args&... args) {
+  static_assert((detail::IsMappedToSystemTypes<Args>() && ...),
+                "The cached results are keyed by the arguments in the binary "
+                "format, only the built-in types are supported");
+  if (!statement_cmd_ctl && query.query.GetName()) {
+    statement_cmd_ctl = GetQueryCmdCtl(query.query.GetName()->GetUnderlying());
+  }
+  statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
+  detail::StaticQueryParameters<sizeof...(args)> params;
+  params.Write(kNoUserTypes, args...);
+  return DoExecuteCached(flags, statement_cmd_ctl, query,
+                         detail::QueryParameters{params});
 }
 
 }  // namespace storages::postgres
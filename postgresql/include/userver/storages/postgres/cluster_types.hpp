@@ -44,6 +44,11 @@ enum class ClusterHostType {
 
   /// Chooses a host with the lowest RTT
   kNearest = 0x10,
+
+  /// Chooses the less loaded of two random hosts. The load is the recent
+  /// latency of the statements on the host times the number of the clients
+  /// using or waiting for its connections, so slow hosts drain on their own.
+  kLeastLoaded = 0x20,
   /// @}
 };
 
@@ -54,7 +59,8 @@ constexpr ClusterHostTypeFlags kClusterHostRolesMask{
     ClusterHostType::kSlave};
 
 constexpr ClusterHostTypeFlags kClusterHostStrategyMask{
-    ClusterHostType::kRoundRobin, ClusterHostType::kNearest};
+    ClusterHostType::kRoundRobin, ClusterHostType::kNearest,
+    ClusterHostType::kLeastLoaded};
 
 std::string ToString(ClusterHostType);
 std::string ToString(ClusterHostTypeFlags);
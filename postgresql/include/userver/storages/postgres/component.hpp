@@ -135,8 +135,16 @@ namespace components {
 /// max_pool_size           | maximum number of created connections                     | 15
 /// max_queue_size          | maximum number of clients waiting for a connection        | 200
 /// connecting_limit        | limit for concurrent establishing connections number per pool (0 - unlimited) | 0
+/// multiplexed_connections | number of connections that pipeline single statements of different tasks, requires pipeline mode (0 - disabled) | 0
+/// max_multiplexed_queries | maximum number of statements pipelined on a multiplexed connection at once | 64
+/// prepare_on_connect      | number of the statements most often prepared by the pool connections that are prepared on a new connection in advance (0 - none) | 0
+/// spare_size              | maximum number of idle connections opened ahead of demand when clients recently waited for a connection (0 - none) | 0
 /// connlimit_mode          | max_connections setup mode (manual or auto), also see @ref scripts/docs/en/userver/pg_connlimit_mode_auto.md | auto
 /// error-injection         | artificial error injection settings, error_injection::Settings | --
+/// query-cache.max-size    | number of results cached for storages::postgres::Cluster::ExecuteCached (0 - disabled) | 0
+/// query-cache.ways        | number of independently locked parts of the query cache   | 16
+/// query-cache.ttl         | time a result is served from the query cache              | 1s
+/// query-cache.invalidation-channel | NOTIFY channel with the names of changed tables as payloads, see storages::postgres::CachedQuery | --
 
 // clang-format on
 
@@ -0,0 +1,150 @@
+#pragma once
+
+/// @file userver/storages/postgres/copy.hpp
+/// @brief Streaming of rows with COPY in the binary format
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/io/buffer_io.hpp>
+#include <userver/storages/postgres/io/field_buffer.hpp>
+#include <userver/storages/postgres/io/supported_types.hpp>
+#include <userver/storages/postgres/io/type_mapping.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+#include <userver/storages/postgres/query.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace detail {
+class Connection;
+}  // namespace detail
+
+/// @brief Sends rows to a `COPY ... FROM STDIN (FORMAT binary)` statement.
+///
+/// Created by Transaction::CopyFrom. Rows are encoded with the same binary
+/// formatters as the query parameters and are sent in chunks, the connection
+/// can not be used for other statements until Finish() is called. A writer
+/// destroyed without Finish() aborts the COPY, which fails the transaction.
+///
+/// The writer must not outlive the transaction.
+///
+/// @snippet storages/postgres/tests/copy_pgtest.cpp CopyFrom
+class CopyWriter {
+ public:
+  CopyWriter(detail::Connection* conn, const Query& query,
+             OptionalCommandControl cmd_ctl);
+
+  CopyWriter(CopyWriter&&) noexcept;
+  CopyWriter& operator=(CopyWriter&&) = delete;
+  ~CopyWriter();
+
+  /// Writes a row with the values of the columns in the order of the column
+  /// list of the COPY statement
+  template <typename... Columns>
+  void WriteRow(const Columns&... columns);
+
+  /// Sends the rest of the rows and finishes the COPY
+  /// @returns the number of copied rows
+  std::size_t Finish();
+
+ private:
+  static constexpr std::size_t kChunkSize = 64 * 1024;
+
+  void SendChunk();
+
+  detail::Connection* conn_;
+  const UserTypes* types_;
+  std::string buffer_;
+};
+
+/// @brief Receives rows of a `COPY ... TO STDOUT (FORMAT binary)` statement.
+///
+/// Created by Transaction::CopyTo. Rows are parsed with the same binary
+/// parsers as the result sets, the connection can not be used for other
+/// statements until ReadRow returns false. A reader destroyed before that
+/// closes the connection, as the rest of the data can not be skipped cheaply.
+///
+/// The reader must not outlive the transaction.
+///
+/// @snippet storages/postgres/tests/copy_pgtest.cpp CopyTo
+class CopyReader {
+ public:
+  CopyReader(detail::Connection* conn, const Query& query,
+             OptionalCommandControl cmd_ctl);
+
+  CopyReader(CopyReader&&) noexcept;
+  CopyReader& operator=(CopyReader&&) = delete;
+  ~CopyReader();
+
+  /// Reads the next row into the columns
+  /// @returns false if there are no more rows
+  /// @throws FieldTupleMismatch if the row has another number of columns
+  template <typename... Columns>
+  bool ReadRow(Columns&... columns);
+
+ private:
+  /// @returns the number of columns of the next row, or nullopt after the
+  /// last row
+  std::optional<std::size_t> ReadRowHeader();
+  void ReadHeader();
+  void FetchData();
+  io::FieldBuffer GetRemainingData() const;
+
+  template <typename T>
+  void ReadColumn(T& value);
+
+  detail::Connection* conn_;
+  const UserTypes* types_;
+  std::string data_;
+  std::size_t position_{0};
+  bool is_header_read_{false};
+};
+
+template <typename... Columns>
+void CopyWriter::WriteRow(const Columns&... columns) {
+  static_assert(sizeof...(Columns) > 0,
+                "A row of COPY must have at least one column");
+  static_assert(
+      sizeof...(Columns) <=
+          static_cast<std::size_t>(std::numeric_limits<Smallint>::max()),
+      "Too many columns for a row of COPY");
+  static_assert((io::traits::kIsMappedToPg<Columns> && ...),
+                "Type doesn't have mapping to Postgres type");
+  if (!conn_) throw LogicError{"COPY is already finished"};
+
+  io::WriteBuffer(*types_, buffer_,
+                  static_cast<Smallint>(sizeof...(Columns)));
+  (io::WriteRawBinary(*types_, buffer_, columns), ...);
+  if (buffer_.size() >= kChunkSize) SendChunk();
+}
+
+template <typename... Columns>
+bool CopyReader::ReadRow(Columns&... columns) {
+  const auto column_count = ReadRowHeader();
+  if (!column_count) return false;
+  if (*column_count != sizeof...(Columns)) {
+    throw FieldTupleMismatch{*column_count, sizeof...(Columns)};
+  }
+  (ReadColumn(columns), ...);
+  return true;
+}
+
+template <typename T>
+void CopyReader::ReadColumn(T& value) {
+  using Parser = typename io::traits::IO<T>::ParserType;
+  constexpr auto kCategory = io::traits::kParserBufferCategory<Parser>;
+  position_ += GetRemainingData().ReadRaw(
+      value, types_->GetTypeBufferCategories(), kCategory);
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -65,6 +65,15 @@ class NonTransaction {
   ResultSet Execute(OptionalCommandControl statement_cmd_ctl,
                     const std::string& statement, const ParameterStore& store);
   /// @}
+
+  /// @cond
+  /// Execute statement with already written arguments
+  ResultSet Execute(OptionalCommandControl statement_cmd_ctl,
+                    const Query& query, const detail::QueryParameters& params) {
+    return DoExecute(query, params, statement_cmd_ctl);
+  }
+  /// @endcond
+
  private:
   ResultSet DoExecute(const Query& query, const detail::QueryParameters& params,
                       OptionalCommandControl statement_cmd_ctl);
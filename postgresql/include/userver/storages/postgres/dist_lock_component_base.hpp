@@ -52,6 +52,7 @@ namespace storages::postgres {
 /// autostart      | if true, start automatically after component load | true
 /// task-processor | the name of the TaskProcessor for running DoWork | main-task-processor
 /// testsuite-support | Enable testsuite support | false
+/// fencing-tokens | maintain the fencing tokens of the lock in the fencing_token column of the table, see dist_lock::DistLockedWorker::GetFencingToken() | false
 ///
 /// ## Migration example
 ///
@@ -67,6 +68,13 @@ namespace storages::postgres {
 /// );
 /// ```
 ///
+/// The `fencing-tokens` option requires an additional column:
+///
+/// ```SQL
+/// ALTER TABLE service.distlocks
+///     ADD COLUMN fencing_token BIGINT NOT NULL DEFAULT 0;
+/// ```
+///
 /// @see @ref scripts/docs/en/userver/periodics.md
 
 // clang-format on
@@ -3,6 +3,11 @@
 /// @file userver/storages/postgres/dist_lock_strategy.hpp
 /// @brief @copybrief storages::postgres::DistLockStrategy
 
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <userver/dist_lock/acquire_batcher.hpp>
 #include <userver/dist_lock/dist_lock_settings.hpp>
 #include <userver/dist_lock/dist_lock_strategy.hpp>
 #include <userver/engine/deadline.hpp>
@@ -13,6 +18,21 @@ USERVER_NAMESPACE_BEGIN
 
 namespace storages::postgres {
 
+/// Postgres distributed locking strategy options
+struct DistLockStrategyOptions {
+  /// @brief Whether to maintain the fencing tokens of the lock
+  ///
+  /// The locks table must have an additional column for the tokens:
+  /// `fencing_token BIGINT NOT NULL DEFAULT 0`. The released locks are expired
+  /// instead of being deleted to keep their tokens.
+  bool fencing_tokens{false};
+
+  /// @brief Batcher of DistLockStrategy::MakeBatcher() to acquire the lock with
+  ///
+  /// Must be created for the same table and fencing_tokens option.
+  std::shared_ptr<dist_lock::AcquireBatcher> batcher{};
+};
+
 /// Postgres distributed locking strategy
 class DistLockStrategy final : public dist_lock::DistLockStrategyBase {
  public:
@@ -20,9 +40,28 @@ class DistLockStrategy final : public dist_lock::DistLockStrategyBase {
                    const std::string& lock_name,
                    const dist_lock::DistLockSettings& settings);
 
+  DistLockStrategy(ClusterPtr cluster, const std::string& table,
+                   const std::string& lock_name,
+                   const dist_lock::DistLockSettings& settings,
+                   const DistLockStrategyOptions& options);
+
+  /// @brief Creates a batcher that acquires and prolongs the locks of
+  /// multiple strategies of the `table` in a single query
+  ///
+  /// The batcher uses the `settings` for the command control of the queries,
+  /// it is not affected by UpdateCommandControl().
+  static std::shared_ptr<dist_lock::AcquireBatcher> MakeBatcher(
+      ClusterPtr cluster, const std::string& table,
+      const dist_lock::DistLockSettings& settings, bool fencing_tokens,
+      const dist_lock::AcquireBatcherSettings& batcher_settings);
+
   void Acquire(std::chrono::milliseconds lock_ttl,
                const std::string& locker_id) override;
 
+  std::optional<dist_lock::FencingToken> AcquireWithFencingToken(
+      std::chrono::milliseconds lock_ttl,
+      const std::string& locker_id) override;
+
   void Release(const std::string& locker_id) override;
 
   void UpdateCommandControl(CommandControl cc);
@@ -34,6 +73,8 @@ class DistLockStrategy final : public dist_lock::DistLockStrategyBase {
   const std::string release_query_;
   const std::string lock_name_;
   const std::string owner_prefix_;
+  const bool fencing_tokens_;
+  const std::shared_ptr<dist_lock::AcquireBatcher> batcher_;
 };
 
 }  // namespace storages::postgres
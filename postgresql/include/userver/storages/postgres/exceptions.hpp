@@ -149,6 +149,7 @@ namespace storages::postgres {
  *     - ConnectionBusy
  *     - ConnectionInterrupted
  *     - PoolError
+ *     - ReplicationError
  *     - ClusterError
  *     - InvalidConfig
  *     - InvalidDSN
@@ -270,6 +271,12 @@ class ConnectionInterrupted : public RuntimeError {
   using RuntimeError::RuntimeError;
 };
 
+/// @brief A logical replication stream has failed or has sent the data that
+/// can not be read.
+class ReplicationError : public RuntimeError {
+  using RuntimeError::RuntimeError;
+};
+
 //@}
 
 //@{
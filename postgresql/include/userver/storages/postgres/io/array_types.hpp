@@ -6,11 +6,13 @@
 /// @ingroup userver_postgres_parse_and_format
 
 #include <array>
+#include <cstring>
 #include <iterator>
 #include <set>
 #include <unordered_set>
 #include <vector>
 
+#include <boost/endian/conversion.hpp>
 #include <boost/pfr/core.hpp>
 
 #include <userver/utils/impl/projecting_view.hpp>
@@ -24,6 +26,10 @@
 #include <userver/storages/postgres/io/type_traits.hpp>
 #include <userver/storages/postgres/io/user_types.hpp>
 
+namespace boost::uuids {
+struct uuid;
+}
+
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::postgres::io {
@@ -145,6 +151,101 @@ inline bool ForceInitElementMapping() {
   }
 }
 
+/// Element types with a binary representation of exactly sizeof(T) bytes,
+/// the last dimension of an array of them is parsed and formatted in bulk
+template <typename T>
+inline constexpr bool kIsFixedWidthElement =
+    std::is_same_v<T, Smallint> || std::is_same_v<T, Integer> ||
+    std::is_same_v<T, Bigint> || std::is_same_v<T, AltInteger> ||
+    std::is_same_v<T, float> || std::is_same_v<T, double> ||
+    std::is_same_v<T, boost::uuids::uuid>;
+
+template <typename T>
+T ReadFixedWidthElement(const char* data) {
+  if constexpr (std::is_integral_v<T>) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return boost::endian::big_to_native(value);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    auto bits = ReadFixedWidthElement<typename IntegralType<sizeof(T)>::type>(
+        data);
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+  } else {
+    // uuid bytes are in the network order
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+  }
+}
+
+template <typename T>
+void WriteFixedWidthElement(const T& value, char* data) {
+  if constexpr (std::is_integral_v<T>) {
+    const auto big = boost::endian::native_to_big(value);
+    std::memcpy(data, &big, sizeof(T));
+  } else if constexpr (std::is_floating_point_v<T>) {
+    typename IntegralType<sizeof(T)>::type bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    WriteFixedWidthElement(bits, data);
+  } else {
+    std::memcpy(data, &value, sizeof(T));
+  }
+}
+
+/// Reads `size` elements without the per element buffer checks. Returns
+/// false, leaving the buffer intact, if some element is NULL or of another
+/// size, those are left for the element parser.
+template <typename T, typename Allocator>
+bool ReadFixedWidthDimension(FieldBuffer& buffer, std::size_t size,
+                             std::vector<T, Allocator>& elem) {
+  constexpr std::size_t kElementSize = sizeof(Integer) + sizeof(T);
+  if (buffer.length / kElementSize < size) return false;
+
+  const auto expected_length =
+      boost::endian::native_to_big(static_cast<Integer>(sizeof(T)));
+  elem.resize(size);
+  const auto* data = buffer.buffer;
+  bool is_valid = true;
+  for (auto& value : elem) {
+    Integer length{0};
+    std::memcpy(&length, data, sizeof(Integer));
+    is_valid &= length == expected_length;
+    value = ReadFixedWidthElement<T>(
+        reinterpret_cast<const char*>(data) + sizeof(Integer));
+    data += kElementSize;
+  }
+  if (!is_valid) return false;
+
+  buffer.buffer += size * kElementSize;
+  buffer.length -= size * kElementSize;
+  return true;
+}
+
+template <typename Buffer, typename Element>
+void WriteFixedWidthDimension(Buffer& buffer, const Element& element) {
+  using T = typename Element::value_type;
+  constexpr std::size_t kElementSize = sizeof(Integer) + sizeof(T);
+
+  const auto length =
+      boost::endian::native_to_big(static_cast<Integer>(sizeof(T)));
+  const auto offset = buffer.size();
+  buffer.resize(offset + element.size() * kElementSize);
+  auto* data = buffer.data() + offset;
+  for (const auto& value : element) {
+    std::memcpy(data, &length, sizeof(Integer));
+    WriteFixedWidthElement(value, data + sizeof(Integer));
+    data += kElementSize;
+  }
+}
+
+template <typename T>
+struct IsVector : std::false_type {};
+
+template <typename... T>
+struct IsVector<std::vector<T...>> : std::true_type {};
+
 template <typename Container>
 struct ArrayBinaryParser : BufferParserBase<Container> {
   using BaseType = BufferParserBase<Container>;
@@ -249,6 +350,10 @@ struct ArrayBinaryParser : BufferParserBase<Container> {
                      BufferCategory elem_category,
                      const TypeBufferCategory& categories, Element& elem) {
     if constexpr (traits::kIsCompatibleContainer<Element>) {
+      if constexpr (IsVector<Element>::value &&
+                    kIsFixedWidthElement<typename Element::value_type>) {
+        if (ReadFixedWidthDimension(buffer, *dim, elem)) return;
+      }
       if constexpr (traits::kCanClear<Element>) {
         elem.clear();
       }
@@ -370,6 +475,9 @@ struct ArrayBinaryFormatter : BufferFormatterBase<Container> {
       for (const auto& sub : element) {
         WriteData(types, dim + 1, buffer, sub);
       }
+    } else if constexpr (kIsFixedWidthElement<
+                             typename Element::value_type>) {
+      WriteFixedWidthDimension(buffer, element);
     } else {
       // this is the final dimension
       for (const auto& sub : element) {
@@ -4,6 +4,7 @@
 /// @brief storages::postgres::Bytea I/O support
 /// @ingroup userver_postgres_parse_and_format
 
+#include <cstddef>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -12,6 +13,7 @@
 #include <userver/storages/postgres/io/buffer_io.hpp>
 #include <userver/storages/postgres/io/buffer_io_base.hpp>
 #include <userver/storages/postgres/io/type_mapping.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -24,10 +26,17 @@ namespace storages::postgres {
  * `bytea` type.
  *
  * Reading and writing to PostgreSQL is implemented for `std::string`,
- * `std::string_view` and `std::vector` of `char` or `unsigned char`.
+ * `std::string_view`, `utils::span<const std::byte>` and `std::vector` of
+ * `char` or `unsigned char`.
  *
- * @warning When reading to `std::string_view` the value MUST NOT be used after
- * the PostgreSQL result set is destroyed.
+ * `std::string_view` and `utils::span<const std::byte>` point into the memory
+ * of the result set instead of copying the data, and
+ * `utils::span<const std::byte>` can be read from or written to a `bytea`
+ * field without the `Bytea` wrapper, e.g. as a member of a row type.
+ *
+ * @warning When reading to `std::string_view` or
+ * `utils::span<const std::byte>` the value MUST NOT be used after the
+ * PostgreSQL result set and all its copies are destroyed.
  *
  * @code
  * namespace pg = storages::postgres;
@@ -52,6 +61,9 @@ template <>
 struct IsByteaCompatible<std::string> : std::true_type {};
 template <>
 struct IsByteaCompatible<std::string_view> : std::true_type {};
+template <>
+struct IsByteaCompatible<USERVER_NAMESPACE::utils::span<const std::byte>>
+    : std::true_type {};
 template <typename... VectorArgs>
 struct IsByteaCompatible<std::vector<char, VectorArgs...>> : std::true_type {};
 template <typename... VectorArgs>
@@ -126,6 +138,11 @@ struct BufferParser<
                                std::string_view>{}) {
       this->value.bytes = std::string_view{
           reinterpret_cast<const char*>(buffer.buffer), buffer.length};
+    } else if constexpr (std::is_same<typename ByteaType::BytesType,
+                                      USERVER_NAMESPACE::utils::span<
+                                          const std::byte>>{}) {
+      const auto* bytes = reinterpret_cast<const std::byte*>(buffer.buffer);
+      this->value.bytes = {bytes, bytes + buffer.length};
     } else {
       this->value.bytes.resize(buffer.length);
       std::copy(buffer.buffer, buffer.buffer + buffer.length,
@@ -161,7 +178,16 @@ struct BufferFormatter<
   template <typename Buffer>
   void operator()(const UserTypes&, Buffer& buf) const {
     buf.reserve(buf.size() + this->value.bytes.size());
-    buf.insert(buf.end(), this->value.bytes.begin(), this->value.bytes.end());
+    if constexpr (std::is_same<typename BaseType::ValueType::BytesType,
+                               USERVER_NAMESPACE::utils::span<
+                                   const std::byte>>{}) {
+      const auto* bytes =
+          reinterpret_cast<const char*>(this->value.bytes.data());
+      buf.insert(buf.end(), bytes, bytes + this->value.bytes.size());
+    } else {
+      buf.insert(buf.end(), this->value.bytes.begin(),
+                 this->value.bytes.end());
+    }
   }
 };
 
@@ -180,6 +206,37 @@ struct BufferFormatter<
   }
 };
 
+template <>
+struct BufferParser<USERVER_NAMESPACE::utils::span<const std::byte>>
+    : detail::BufferParserBase<
+          USERVER_NAMESPACE::utils::span<const std::byte>> {
+  using BaseType =
+      detail::BufferParserBase<USERVER_NAMESPACE::utils::span<const std::byte>>;
+  using BaseType::BaseType;
+
+  void operator()(const FieldBuffer& buffer) {
+    ReadBuffer(buffer, Bytea(this->value));
+  }
+};
+
+template <>
+struct BufferFormatter<USERVER_NAMESPACE::utils::span<const std::byte>>
+    : detail::BufferFormatterBase<
+          USERVER_NAMESPACE::utils::span<const std::byte>> {
+  using BaseType = detail::BufferFormatterBase<
+      USERVER_NAMESPACE::utils::span<const std::byte>>;
+  using BaseType::BaseType;
+
+  template <typename Buffer>
+  void operator()(const UserTypes& types, Buffer& buffer) const {
+    WriteBuffer(types, buffer, Bytea(this->value));
+  }
+};
+
+template <>
+struct CppToSystemPg<USERVER_NAMESPACE::utils::span<const std::byte>>
+    : PredefinedOid<PredefinedOids::kBytea> {};
+
 template <typename ByteContainer>
 struct CppToSystemPg<postgres::detail::ByteaRefWrapper<ByteContainer>>
     : PredefinedOid<PredefinedOids::kBytea> {};
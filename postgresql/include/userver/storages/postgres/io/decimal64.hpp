@@ -4,6 +4,8 @@
 /// @brief decimal64::Decimal I/O support
 /// @ingroup userver_postgres_parse_and_format
 
+#include <array>
+
 #include <userver/decimal64/decimal64.hpp>
 #include <userver/storages/postgres/io/buffer_io.hpp>
 #include <userver/storages/postgres/io/buffer_io_base.hpp>
@@ -24,10 +26,10 @@ struct BufferFormatter<decimal64::Decimal<Prec, RoundPolicy>>
 
   template <typename Buffer>
   void operator()(const UserTypes&, Buffer& buffer) const {
-    auto bin_str =
-        detail::Int64ToNumericBuffer({this->value.AsUnbiased(), Prec});
-    buffer.reserve(buffer.size() + bin_str.size());
-    std::copy(bin_str.begin(), bin_str.end(), std::back_inserter(buffer));
+    std::array<char, detail::kMaxInt64NumericBufferSize> bin_buffer;
+    const auto size = detail::WriteInt64NumericBuffer(
+        {this->value.AsUnbiased(), Prec}, bin_buffer);
+    buffer.insert(buffer.end(), bin_buffer.data(), bin_buffer.data() + size);
   }
 };
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+
 #include <userver/storages/postgres/io/buffer_io.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -31,6 +34,20 @@ IntegralRepresentation NumericBufferToInt64(const FieldBuffer& buffer);
 ///                              representation is unreasonable
 std::string Int64ToNumericBuffer(const IntegralRepresentation& rep);
 
+/// Size of a buffer that fits a numeric/decimal binary representation of
+/// any int64 value: 4 uint16 fields and up to 10 binary digits
+inline constexpr std::size_t kMaxInt64NumericBufferSize = 2 * (4 + 10);
+
+/// A helper function to write PostgreSQL numeric/decimal binary buffer using
+/// a value packed into a single int64 value, without allocations.
+/// Writes the same bytes as Int64ToNumericBuffer.
+/// @returns the number of bytes written to the `buffer`
+/// @throw InvalidRepresentation if the dec_digits field of binary
+///                              representation is unreasonable
+std::size_t WriteInt64NumericBuffer(
+    const IntegralRepresentation& rep,
+    std::array<char, kMaxInt64NumericBufferSize>& buffer);
+
 }  // namespace storages::postgres::io::detail
 
 USERVER_NAMESPACE_END
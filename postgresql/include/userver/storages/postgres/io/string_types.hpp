@@ -85,7 +85,11 @@ struct BufferParser<std::string> {
 //@}
 
 //@{
-/** @name string_view I/O */
+/** @name string_view I/O
+ *
+ * A parsed `std::string_view` points into the memory of the result set, it
+ * MUST NOT be used after the result set and all its copies are destroyed.
+ */
 template <>
 struct BufferFormatter<std::string_view>
     : detail::BufferFormatterBase<std::string_view> {
@@ -32,6 +32,7 @@
 /// decimal(p)        | decimal64::Decimal                      | +       |
 /// money             | N/A                                     |         |
 /// text              | std::string                             | +       |
+/// ^                 | std::string_view                        |         |
 /// char(n)           | std::string                             |         |
 /// varchar(n)        | std::string                             |         |
 /// "char"            | char                                    | +       |
@@ -42,6 +43,7 @@
 /// timetz            | N/A                                     |         |
 /// interval          | std::chrono::microseconds               |         |
 /// bytea             | container of one-byte type              |         |
+/// ^                 | utils::span<const std::byte>            | +       |
 /// bit(n)            | utils::Flags                            |         |
 /// ^                 | std::bitset<N>                          |         |
 /// ^                 | std::array<bool, N>                     |         |
@@ -168,6 +168,9 @@ static constexpr size_t kDefaultPoolMaxQueueSize = 200;
 /// Default limit for concurrent establishing connections number
 static constexpr size_t kDefaultConnectingLimit = 0;
 
+/// Default limit for statements pipelined on a multiplexed connection at once
+static constexpr size_t kDefaultMaxMultiplexedQueries = 64;
+
 /// @brief PostgreSQL connection pool options
 ///
 /// Dynamic option @ref POSTGRES_CONNECTION_POOL_SETTINGS
@@ -184,10 +187,30 @@ struct PoolSettings {
   /// Limits number of concurrent establishing connections (0 - unlimited)
   size_t connecting_limit{kDefaultConnectingLimit};
 
+  /// Number of connections that pipeline single statements of different
+  /// tasks, requires pipeline mode (0 - statements are not multiplexed)
+  size_t multiplexed_connections{0};
+
+  /// Maximum number of statements pipelined on a connection at once
+  size_t max_multiplexed_queries{kDefaultMaxMultiplexedQueries};
+
+  /// Number of the statements most often prepared by the pool connections
+  /// that are prepared on a new connection in advance (0 - none)
+  size_t prepare_on_connect{0};
+
+  /// Maximum number of idle connections opened ahead of demand. The pool
+  /// keeps as many of them as clients recently had to wait for a connection
+  /// and releases them gradually once the demand drops (0 - none)
+  size_t spare_size{0};
+
   bool operator==(const PoolSettings& rhs) const {
     return min_size == rhs.min_size && max_size == rhs.max_size &&
            max_queue_size == rhs.max_queue_size &&
-           connecting_limit == rhs.connecting_limit;
+           connecting_limit == rhs.connecting_limit &&
+           multiplexed_connections == rhs.multiplexed_connections &&
+           max_multiplexed_queries == rhs.max_multiplexed_queries &&
+           prepare_on_connect == rhs.prepare_on_connect &&
+           spare_size == rhs.spare_size;
   }
 };
 
@@ -292,6 +315,23 @@ struct StatementMetricsSettings final {
   }
 };
 
+/// @brief Client-side cache of read-only statement results
+///
+/// Used by Cluster::ExecuteCached, static config option `query-cache`
+struct QueryCacheSettings final {
+  static constexpr std::size_t kDefaultWays = 16;
+
+  /// Number of cached results, 0 disables the cache
+  std::size_t max_size{0};
+  /// Number of independently locked parts of the cache
+  std::size_t ways{kDefaultWays};
+  /// Time a result is served from the cache
+  std::chrono::milliseconds ttl{std::chrono::seconds{1}};
+  /// Channel of the NOTIFY with the names of the changed tables as payloads,
+  /// empty disables the invalidation by notifications
+  std::string invalidation_channel{};
+};
+
 /// Initialization modes
 enum class InitMode {
   kSync = 0,
@@ -328,6 +368,9 @@ struct ClusterSettings {
 
   /// congestion control settings
   congestion_control::v2::LinearController::StaticConfig cc_config;
+
+  /// query result cache settings
+  QueryCacheSettings query_cache_settings;
 };
 
 }  // namespace storages::postgres
@@ -32,6 +32,13 @@
 /// - Query result extraction to C++ types;
 /// - Binary protocol usage for communication rather than the libpq's text;
 /// - Portals for effective background cache updates;
+/// - Binary COPY FROM STDIN / TO STDOUT streaming for bulk loads, see
+///   storages::postgres::Transaction::CopyFrom() and
+///   storages::postgres::Transaction::CopyTo();
+/// - Row by row streaming of large results with constant memory, see
+///   storages::postgres::Transaction::Stream();
+/// - Client-side cache of read-only statement results invalidated by
+///   NOTIFY, see storages::postgres::Cluster::ExecuteCached();
 /// - Queries pipelining;
 /// - Mapping PostgreSQL user types to C++ types;
 /// - Transaction error injection via pytest_userver.sql.RegisteredTrx;
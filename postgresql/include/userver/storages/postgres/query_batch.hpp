@@ -0,0 +1,106 @@
+#pragma once
+
+/// @file userver/storages/postgres/query_batch.hpp
+/// @brief Independent statements executed at once
+
+#include <cstddef>
+#include <exception>
+#include <utility>
+#include <vector>
+
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/parameter_store.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// @brief Independent single statements executed by Cluster::ExecuteBatch
+/// in one roundtrip on a single connection.
+///
+/// Each statement runs in its own auto-commit transaction, so an error of a
+/// statement does not affect the others, and the order of their execution is
+/// the order of appending. Only the arguments of the built-in types are
+/// supported.
+///
+/// Transaction::ExecuteBatch executes the statements one by one in the
+/// transaction, where an error aborts the rest of them.
+///
+/// @code
+/// storages::postgres::QueryBatch batch;
+/// batch.Append("select count(*) from orders where user_id = $1", user_id)
+///     .Append("select name from users where id = $1", user_id);
+/// auto results = cluster->ExecuteBatch(ClusterHostType::kSlave, batch);
+/// auto orders = results[0].Get().AsSingleRow<std::int64_t>();
+/// @endcode
+class QueryBatch final {
+ public:
+  /// @cond
+  struct Statement {
+    Query query;
+    OptionalCommandControl cmd_ctl;
+    ParameterStore params;
+  };
+  /// @endcond
+
+  /// Appends a statement
+  template <typename... Args>
+  QueryBatch& Append(const Query& query, const Args&... args) {
+    return Append(OptionalCommandControl{}, query, args...);
+  }
+
+  /// Appends a statement with per-statement command control
+  template <typename... Args>
+  QueryBatch& Append(OptionalCommandControl statement_cmd_ctl,
+                     const Query& query, const Args&... args) {
+    ParameterStore params;
+    (params.PushBack(args), ...);
+    statements_.push_back(
+        Statement{query, std::move(statement_cmd_ctl), std::move(params)});
+    return *this;
+  }
+
+  /// Returns the number of statements
+  std::size_t Size() const { return statements_.size(); }
+
+  /// Returns whether there are no statements
+  bool IsEmpty() const { return statements_.empty(); }
+
+  /// @cond
+  const std::vector<Statement>& GetStatements() const { return statements_; }
+  /// @endcond
+
+ private:
+  std::vector<Statement> statements_;
+};
+
+/// @brief The result of a statement of a QueryBatch
+class BatchResult final {
+ public:
+  /// @cond
+  explicit BatchResult(ResultSet result) : result_{std::move(result)} {}
+  explicit BatchResult(std::exception_ptr error) : error_{std::move(error)} {}
+  /// @endcond
+
+  /// Returns whether the statement succeeded
+  bool IsOk() const { return !error_; }
+
+  /// Returns the result of the statement or rethrows its error
+  const ResultSet& Get() const {
+    if (error_) std::rethrow_exception(error_);
+    return result_;
+  }
+
+  /// Returns the error of the statement, nullptr if it succeeded
+  const std::exception_ptr& GetError() const { return error_; }
+
+ private:
+  ResultSet result_{nullptr};
+  std::exception_ptr error_;
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
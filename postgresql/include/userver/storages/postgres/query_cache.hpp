@@ -0,0 +1,46 @@
+#pragma once
+
+/// @file userver/storages/postgres/query_cache.hpp
+/// @brief Read-only statements with cached results
+
+#include <string>
+#include <vector>
+
+#include <userver/storages/postgres/query.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// @brief A read-only statement whose results are cached by
+/// Cluster::ExecuteCached.
+///
+/// The results are cached by the name of the query, or by the statement for
+/// an unnamed query, and the arguments. They are served until the TTL of the
+/// `query-cache` static config option expires, or until a notification on
+/// its `invalidation-channel` with one of the `tables` as the payload, e.g.
+/// sent by a trigger:
+///
+/// @code
+/// create function notify_query_cache() returns trigger as $$
+/// begin
+///   perform pg_notify('query_cache', TG_TABLE_NAME);
+///   return null;
+/// end;
+/// $$ language plpgsql;
+///
+/// create trigger foo_query_cache after insert or update or delete or truncate
+///   on foo for each statement execute function notify_query_cache();
+/// @endcode
+///
+/// A notification without a payload drops all the cached results.
+struct CachedQuery {
+  /// The statement, it must not modify data
+  Query query;
+  /// The tables the statement reads
+  std::vector<std::string> tables;
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
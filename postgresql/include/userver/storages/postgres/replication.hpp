@@ -0,0 +1,253 @@
+#pragma once
+
+/// @file userver/storages/postgres/replication.hpp
+/// @brief Streaming of the table changes with the logical replication
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/io/row_types.hpp>
+#include <userver/storages/postgres/io/supported_types.hpp>
+#include <userver/storages/postgres/io/type_mapping.hpp>
+#include <userver/storages/postgres/postgres_fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace detail {
+class PGConnectionWrapper;
+}  // namespace detail
+
+/// @brief Settings of a logical replication stream
+struct ReplicationSettings {
+  /// Name of the temporary replication slot of the stream, must be unique
+  /// for the database
+  std::string slot_name;
+  /// Names of the publications, the changes of their tables are streamed
+  std::vector<std::string> publications;
+};
+
+/// @brief A table which changes are streamed
+struct ReplicationRelation {
+  Oid id{kInvalidOid};
+  std::string schema;
+  std::string table;
+  /// Names of the published columns in the table order
+  std::vector<std::string> columns;
+};
+
+/// @brief Column values of a row from the replication stream
+///
+/// The values are in the binary format, as in the result sets.
+class ReplicationTuple final {
+ public:
+  enum class ValueKind : char {
+    kNull = 'n',
+    /// A TOASTed value that was not changed by an update and was not sent
+    kUnchangedToast = 'u',
+    kText = 't',
+    kBinary = 'b',
+  };
+
+  ReplicationTuple() = default;
+
+  /// @brief Parses the TupleData of a pgoutput message
+  /// @returns the size of the parsed data
+  /// @throws ReplicationError on malformed data
+  std::size_t Parse(std::string_view message);
+
+  std::size_t Size() const noexcept { return columns_.size(); }
+
+  bool IsEmpty() const noexcept { return columns_.empty(); }
+
+  ValueKind GetValueKind(std::size_t index) const;
+
+  /// @returns true if the row has values that were not sent
+  bool HasUnchangedToast() const noexcept;
+
+  /// Takes the values that were not sent from another image of the row,
+  /// e.g. from the old row of an update with `REPLICA IDENTITY FULL`
+  void FillUnchanged(const ReplicationTuple& other);
+
+  /// @brief Reads the columns into a row type in the order of the published
+  /// columns of the table
+  /// @throws FieldTupleMismatch if the row type has another number of columns
+  /// @throws ReplicationError if a value is unchanged TOAST or is not binary
+  ///
+  /// The row types with user composite types are not supported.
+  template <typename T>
+  T As() const;
+
+  /// @brief Reads the replica identity of a deleted row into a row type.
+  ///
+  /// Same as As(), but the columns that are not a part of the identity, i.e.
+  /// the null values, are set to the defaults for the non-nullable types.
+  template <typename T>
+  T AsReplicaIdentity() const;
+
+ private:
+  struct Column {
+    ValueKind kind;
+    // Offset of the length of the value in data_
+    std::uint32_t offset;
+  };
+
+  // The length of the value and the value itself
+  std::string_view GetRawValue(std::size_t index) const;
+  io::FieldBuffer GetValue(std::size_t index) const;
+
+  template <typename T>
+  T Read(bool is_identity) const;
+
+  template <typename T>
+  void ReadColumn(std::size_t index, T& value, bool is_identity) const;
+
+  template <typename Tuple, std::size_t... Indexes>
+  void ReadColumns(Tuple&& tuple, bool is_identity,
+                   std::index_sequence<Indexes...>) const;
+
+  std::string data_;
+  std::vector<Column> columns_;
+};
+
+/// @brief A row change from the replication stream
+struct ReplicationChange {
+  enum class Type {
+    kInsert,
+    kUpdate,
+    kDelete,
+    /// The table was truncated, the tuple is empty
+    kTruncate,
+  };
+
+  Type type{Type::kInsert};
+  std::shared_ptr<const ReplicationRelation> relation;
+  /// The new row for inserts and updates. For deletes it is the replica
+  /// identity of the row, i.e. only the primary key columns are not null
+  /// unless the table has `REPLICA IDENTITY FULL`.
+  ReplicationTuple tuple;
+};
+
+/// @brief The changes of a committed transaction
+struct ReplicationTransaction {
+  /// LSN of the end of the transaction, pass it to
+  /// ReplicationStream::Confirm after the changes are applied
+  std::uint64_t end_lsn{0};
+  std::vector<ReplicationChange> changes;
+};
+
+/// @brief Receives the changes of the published tables by the logical
+/// replication protocol with the `pgoutput` plugin in the binary format.
+///
+/// Created by Cluster::CreateReplicationStream. Exclusively holds a
+/// replication connection to the master host and a temporary replication
+/// slot. The slot keeps the changes made after the stream creation, so the
+/// tables may be loaded entirely before the Start() without losing the
+/// concurrent changes. Some of the loaded changes may be streamed again.
+///
+/// The slot is dropped by the server when the stream is destroyed or the
+/// connection is lost, so a stream that threw an error should be recreated
+/// along with a full reload of the data.
+///
+/// Requires `wal_level = logical` and PostgreSQL 14 or newer.
+///
+/// @snippet storages/postgres/tests/cluster_pgtest.cpp Replication
+class ReplicationStream final {
+ public:
+  /// @brief Creates a temporary slot on a connected replication connection
+  ReplicationStream(std::unique_ptr<detail::PGConnectionWrapper> conn,
+                    ReplicationSettings settings, engine::Deadline deadline);
+
+  ReplicationStream(ReplicationStream&&) noexcept;
+  ReplicationStream& operator=(ReplicationStream&&) noexcept;
+  ~ReplicationStream();
+
+  /// @brief Starts streaming the changes made after the slot creation
+  void Start(engine::Deadline deadline);
+
+  bool IsStarted() const noexcept;
+
+  /// @brief Waits for the next committed transaction.
+  ///
+  /// A passed deadline takes only the data that is already received. The
+  /// transactions are returned only entirely, the partially received ones
+  /// are kept until the rest arrives.
+  ///
+  /// @returns the transaction or std::nullopt if none was committed until
+  /// the deadline
+  /// @throws ReplicationError if the stream failed
+  std::optional<ReplicationTransaction> WaitTransaction(
+      engine::Deadline deadline);
+
+  /// @brief Reports the changes up to the lsn as applied, so the server may
+  /// recycle the WAL of the slot
+  void Confirm(std::uint64_t lsn);
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+template <typename T>
+T ReplicationTuple::As() const {
+  return Read<T>(false);
+}
+
+template <typename T>
+T ReplicationTuple::AsReplicaIdentity() const {
+  return Read<T>(true);
+}
+
+template <typename T>
+T ReplicationTuple::Read(bool is_identity) const {
+  using RowType = io::RowType<T>;
+  static_assert(io::traits::kIsRowType<T>,
+                "Replicated rows are read into row types");
+  if (RowType::size != columns_.size()) {
+    throw FieldTupleMismatch{columns_.size(), RowType::size};
+  }
+  T row{};
+  ReadColumns(RowType::GetTuple(row), is_identity,
+              std::make_index_sequence<RowType::size>{});
+  return row;
+}
+
+template <typename T>
+void ReplicationTuple::ReadColumn(std::size_t index, T& value,
+                                  bool is_identity) const {
+  using ValueType = std::decay_t<T>;
+  if (columns_[index].kind == ValueKind::kNull) {
+    if constexpr (io::traits::kIsNullable<ValueType>) {
+      io::traits::GetSetNull<ValueType>::SetNull(value);
+    } else if (is_identity) {
+      io::traits::GetSetNull<ValueType>::SetDefault(value);
+    } else {
+      io::traits::GetSetNull<ValueType>::SetNull(value);
+    }
+    return;
+  }
+  using Parser = typename io::traits::IO<ValueType>::ParserType;
+  constexpr auto kCategory = io::traits::kParserBufferCategory<Parser>;
+  const io::TypeBufferCategory categories;
+  GetValue(index).ReadRaw(value, categories, kCategory);
+}
+
+template <typename Tuple, std::size_t... Indexes>
+void ReplicationTuple::ReadColumns(Tuple&& tuple, bool is_identity,
+                                   std::index_sequence<Indexes...>) const {
+  (ReadColumn(Indexes, std::get<Indexes>(tuple), is_identity), ...);
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
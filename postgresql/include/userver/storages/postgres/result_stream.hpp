@@ -0,0 +1,174 @@
+#pragma once
+
+/// @file userver/storages/postgres/result_stream.hpp
+/// @brief Streaming of statement results row by row
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace detail {
+class Connection;
+}  // namespace detail
+
+template <typename T, typename ExtractionTag>
+class TypedResultStream;
+
+/// @brief Receives the rows of a statement one by one.
+///
+/// Created by Transaction::Stream. Only the data of the next row is read from
+/// the connection, so a result of any size takes constant memory and rows can
+/// be processed while the rest are still being transferred. A consumer that
+/// does not request rows stops the reading of the socket, which makes the
+/// server wait. The connection can not be used for other statements until
+/// the last row is read. A stream destroyed before that closes the
+/// connection, as the rest of the rows can not be skipped cheaply.
+///
+/// The stream must not outlive the transaction.
+///
+/// @snippet storages/postgres/tests/result_stream_pgtest.cpp ResultStream
+class ResultStream {
+ public:
+  ResultStream(detail::Connection* conn, const Query& query,
+               const detail::QueryParameters& params,
+               OptionalCommandControl cmd_ctl);
+
+  ResultStream(ResultStream&&) noexcept;
+  ResultStream& operator=(ResultStream&&) = delete;
+  ~ResultStream();
+
+  /// Reads the next row
+  /// @returns a result set with the single row, or nullopt after the last row
+  std::optional<ResultSet> Next();
+
+  //@{
+  /** @name Typed rows */
+  /// Reads the next row the same way as ResultSet::AsSingleRow does
+  /// @returns nullopt after the last row
+  template <typename T>
+  std::optional<T> NextAs();
+  template <typename T>
+  std::optional<T> NextAs(RowTag);
+  template <typename T>
+  std::optional<T> NextAs(FieldTag);
+  //@}
+
+  //@{
+  /** @name Typed iteration */
+  /// Returns an input range over the rest of the rows converted the same way
+  /// as ResultSet::AsSetOf does, each row is read when the iterator is
+  /// advanced
+  template <typename T>
+  TypedResultStream<T, FieldTag> AsStreamOf();
+  template <typename T>
+  TypedResultStream<T, RowTag> AsStreamOf(RowTag);
+  template <typename T>
+  TypedResultStream<T, FieldTag> AsStreamOf(FieldTag);
+  //@}
+
+  /// Number of rows read so far
+  std::size_t RowsRead() const { return rows_read_; }
+
+ private:
+  detail::Connection* conn_;
+  std::size_t rows_read_{0};
+};
+
+/// @brief Input range over the rows of a ResultStream converted to T.
+///
+/// Returned by ResultStream::AsStreamOf, the stream must outlive the range.
+template <typename T, typename ExtractionTag>
+class TypedResultStream {
+ public:
+  class Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = T;
+    using reference = T&;
+    using pointer = T*;
+
+    Iterator() = default;
+
+    reference operator*() const { return *range_->current_; }
+    pointer operator->() const { return &*range_->current_; }
+
+    Iterator& operator++() {
+      range_->Fetch();
+      if (!range_->current_) range_ = nullptr;
+      return *this;
+    }
+
+    bool operator==(const Iterator& rhs) const { return range_ == rhs.range_; }
+    bool operator!=(const Iterator& rhs) const { return !(*this == rhs); }
+
+   private:
+    friend class TypedResultStream;
+
+    explicit Iterator(TypedResultStream* range) : range_{range} {}
+
+    TypedResultStream* range_{nullptr};
+  };
+
+  explicit TypedResultStream(ResultStream& stream) : stream_{stream} {}
+
+  /// Reads the first row, must be called once
+  Iterator begin() {
+    Fetch();
+    return Iterator{current_ ? this : nullptr};
+  }
+  Iterator end() { return {}; }
+
+ private:
+  void Fetch() { current_ = stream_.NextAs<T>(ExtractionTag{}); }
+
+  ResultStream& stream_;
+  std::optional<T> current_;
+};
+
+template <typename T>
+std::optional<T> ResultStream::NextAs() {
+  return NextAs<T>(kFieldTag);
+}
+
+template <typename T>
+std::optional<T> ResultStream::NextAs(RowTag) {
+  auto row = Next();
+  if (!row) return std::nullopt;
+  return row->AsSingleRow<T>(kRowTag);
+}
+
+template <typename T>
+std::optional<T> ResultStream::NextAs(FieldTag) {
+  auto row = Next();
+  if (!row) return std::nullopt;
+  return row->AsSingleRow<T>(kFieldTag);
+}
+
+template <typename T>
+TypedResultStream<T, FieldTag> ResultStream::AsStreamOf() {
+  return AsStreamOf<T>(kFieldTag);
+}
+
+template <typename T>
+TypedResultStream<T, RowTag> ResultStream::AsStreamOf(RowTag) {
+  return TypedResultStream<T, RowTag>{*this};
+}
+
+template <typename T>
+TypedResultStream<T, FieldTag> ResultStream::AsStreamOf(FieldTag) {
+  return TypedResultStream<T, FieldTag>{*this};
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -3,6 +3,9 @@
 /// @file userver/storages/postgres/statistics.hpp
 /// @brief Statistics helpers
 
+#include <cstdint>
+#include <optional>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -219,6 +222,26 @@ struct InstanceStatsDescriptor {
   InstanceStatisticsNonatomic stats;
 };
 
+/// @brief Query result cache hits and misses
+struct QueryCacheCounters {
+  /// Number of results served from the cache
+  std::uint64_t hits{0};
+  /// Number of statements executed because of no valid cached result
+  std::uint64_t misses{0};
+};
+
+/// @brief Query result cache statistics
+struct QueryCacheStatistics {
+  /// Counters of all statements
+  QueryCacheCounters total;
+  /// Counters by the names of the statements
+  std::unordered_map<std::string, QueryCacheCounters> queries;
+  /// Number of cached results
+  std::size_t size{0};
+  /// Number of invalidations by notifications
+  std::uint64_t invalidations{0};
+};
+
 /// @brief Cluster statistics storage
 struct ClusterStatistics {
   /// Master instance statistics
@@ -229,6 +252,8 @@ struct ClusterStatistics {
   std::vector<InstanceStatsDescriptor> slaves;
   /// Unknown/unreachable instances statistics
   std::vector<InstanceStatsDescriptor> unknown;
+  /// Query result cache statistics, if the cache is enabled
+  std::optional<QueryCacheStatistics> query_cache;
 };
 
 // InstanceStatisticsNonatomic values support for utils::statistics::Writer
@@ -239,6 +264,14 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
                 const InstanceStatsDescriptor& value);
 
+/// @brief QueryCacheCounters values support for utils::statistics::Writer
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const QueryCacheCounters& value);
+
+/// @brief QueryCacheStatistics values support for utils::statistics::Writer
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const QueryCacheStatistics& value);
+
 /// @brief ClusterStatistics values support for utils::statistics::Writer
 void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
                 const ClusterStatistics& value);
@@ -5,7 +5,9 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
+#include <userver/storages/postgres/copy.hpp>
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
@@ -14,7 +16,9 @@
 #include <userver/storages/postgres/portal.hpp>
 #include <userver/storages/postgres/postgres_fwd.hpp>
 #include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/query_batch.hpp>
 #include <userver/storages/postgres/result_set.hpp>
+#include <userver/storages/postgres/result_stream.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -211,6 +215,15 @@ class Transaction {
   ResultSet Execute(OptionalCommandControl statement_cmd_ctl,
                     const Query& query, const ParameterStore& store);
 
+  /// Execute independent statements one by one in the transaction.
+  ///
+  /// Returns the results in the order of the statements, an error of a
+  /// statement is stored in its result. The statements after an error fail
+  /// as the transaction is aborted.
+  ///
+  /// @see storages::postgres::QueryBatch
+  std::vector<BatchResult> ExecuteBatch(const QueryBatch& batch);
+
   /// Execute statement that uses an array of arguments splitting that array in
   /// chunks and executing the statement with a chunk of arguments.
   ///
@@ -290,6 +303,57 @@ class Transaction {
   Portal MakePortal(OptionalCommandControl statement_cmd_ctl,
                     const Query& query, const ParameterStore& store);
 
+  /// Start a `COPY ... FROM STDIN (FORMAT binary)` statement and return a
+  /// writer for its rows. Much faster than inserting the rows with Execute
+  /// for bulk loads, the statement runs until CopyWriter::Finish.
+  ///
+  /// @snippet storages/postgres/tests/copy_pgtest.cpp CopyFrom
+  CopyWriter CopyFrom(const Query& query) {
+    return CopyFrom(OptionalCommandControl{}, query);
+  }
+
+  /// Start a `COPY ... FROM STDIN (FORMAT binary)` statement with
+  /// per-statement command control, the network timeout applies to each
+  /// chunk of rows.
+  CopyWriter CopyFrom(OptionalCommandControl statement_cmd_ctl,
+                      const Query& query);
+
+  /// Start a `COPY ... TO STDOUT (FORMAT binary)` statement and return a
+  /// reader for its rows. The rows are streamed, the result is never held in
+  /// memory as a whole.
+  ///
+  /// @snippet storages/postgres/tests/copy_pgtest.cpp CopyTo
+  CopyReader CopyTo(const Query& query) {
+    return CopyTo(OptionalCommandControl{}, query);
+  }
+
+  /// Start a `COPY ... TO STDOUT (FORMAT binary)` statement with
+  /// per-statement command control, the network timeout applies to each row.
+  CopyReader CopyTo(OptionalCommandControl statement_cmd_ctl,
+                    const Query& query);
+
+  /// Execute statement receiving its rows one by one. Unlike a portal, the
+  /// rows are not fetched in roundtrips, the server sends them continuously
+  /// while the rows read are deserialized, and the result is never held in
+  /// memory as a whole.
+  ///
+  /// @snippet storages/postgres/tests/result_stream_pgtest.cpp ResultStream
+  template <typename... Args>
+  ResultStream Stream(const Query& query, const Args&... args) {
+    return Stream(OptionalCommandControl{}, query, args...);
+  }
+
+  /// Execute statement receiving its rows one by one with per-statement
+  /// command control, the network timeout applies to each row.
+  template <typename... Args>
+  ResultStream Stream(OptionalCommandControl statement_cmd_ctl,
+                      const Query& query, const Args&... args) {
+    detail::StaticQueryParameters<sizeof...(args)> params;
+    params.Write(GetConnectionUserTypes(), args...);
+    return DoStream(query, detail::QueryParameters{params},
+                    std::move(statement_cmd_ctl));
+  }
+
   /// Set a connection parameter
   /// https://www.postgresql.org/docs/current/sql-set.html
   /// The parameter is set for this transaction only
@@ -314,6 +378,9 @@ class Transaction {
  private:
   ResultSet DoExecute(const Query& query, const detail::QueryParameters& params,
                       OptionalCommandControl statement_cmd_ctl);
+  ResultStream DoStream(const Query& query,
+                        const detail::QueryParameters& params,
+                        OptionalCommandControl statement_cmd_ctl);
   Portal MakePortal(const PortalName&, const Query& query,
                     const detail::QueryParameters& params,
                     OptionalCommandControl statement_cmd_ctl);
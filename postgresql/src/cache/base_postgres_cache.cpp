@@ -1,9 +1,42 @@
 #include <userver/cache/base_postgres_cache.hpp>
 
+#include <cstdint>
+#include <limits>
+
+#include <fmt/format.h>
+
+#include <userver/utils/rand.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
+namespace components::pg_cache::detail {
+
+namespace {
+// The slot names are limited by NAMEDATALEN - 1 = 63 characters, the random
+// suffix takes 17 of them
+constexpr std::size_t kMaxSlotNamePrefixSize = 40;
+}  // namespace
+
+std::string MakeReplicationSlotName(std::string_view cache_name) {
+  // Only lower case letters, digits and underscores are allowed
+  std::string name = "userver_";
+  for (const auto c : cache_name.substr(0, kMaxSlotNamePrefixSize)) {
+    if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+      name.push_back(c);
+    } else if (c >= 'A' && c <= 'Z') {
+      name.push_back(static_cast<char>(c - 'A' + 'a'));
+    } else {
+      name.push_back('_');
+    }
+  }
+  return fmt::format(
+      "{}_{:016x}", name,
+      utils::RandRange(std::numeric_limits<std::uint64_t>::max()));
+}
+
+}  // namespace components::pg_cache::detail
+
 namespace components::impl {
 
 std::string GetPostgreCacheSchema() {
@@ -28,6 +61,13 @@ properties:
         type: integer
         description: number of rows to request from PostgreSQL, 0 to fetch all rows in one request
         defaultDescription: 1000
+    full-update-parallelism:
+        type: integer
+        description: |
+            number of concurrent queries of a full update for each shard,
+            requires kFullUpdatePartitionKey in the cache policy
+        defaultDescription: 1
+        minimum: 1
     pgcomponent:
         type: string
         description: PostgreSQL component name
@@ -4,6 +4,8 @@
 
 #include <boost/functional/hash.hpp>
 
+#include <userver/cache/flat_hash_map.hpp>
+#include <userver/cache/persistent_hash_map.hpp>
 #include <userver/components/minimal_server_component_list.hpp>
 #include <userver/utils/projected_set.hpp>
 
@@ -295,6 +297,62 @@ struct PostgresExamplePolicy7 {
   using CacheContainer = utils::ProjectedUnorderedSet<ValueType, kKeyMember>;
 };
 
+// Tests PersistentHashMap as container
+struct PostgresExamplePolicy8 {
+  static constexpr std::string_view kName = "my-pg-cache";
+  using ValueType = MyStructure;
+  static constexpr auto kKeyMember = &MyStructure::id;
+  static constexpr const char* kQuery =
+      "select id, bar, updated from test.my_data";
+  static constexpr const char* kUpdatedField = "updated";
+  using UpdatedFieldType = storages::postgres::TimePointTz;
+  using CacheContainer = cache::PersistentHashMap<int, MyStructure>;
+};
+
+// Tests FlatHashMap as container
+struct PostgresExamplePolicy9 {
+  static constexpr std::string_view kName = "my-pg-cache";
+  using ValueType = MyStructure;
+  static constexpr auto kKeyMember = &MyStructure::id;
+  static constexpr const char* kQuery = "select id, bar from test.my_data";
+  static constexpr const char* kUpdatedField = "";  // Intentionally left blank
+  using CacheContainer = cache::FlatHashMap<int, MyStructure>;
+};
+
+/*! [Pg Cache Policy Parallel Full Update Example] */
+struct PostgresExamplePolicy10 {
+  static constexpr std::string_view kName = "my-pg-cache";
+  using ValueType = MyStructure;
+  static constexpr auto kKeyMember = &MyStructure::id;
+  static constexpr const char* kQuery =
+      "select id, bar, updated from test.my_data";
+  static constexpr const char* kUpdatedField = "updated";
+  using UpdatedFieldType = storages::postgres::TimePointTz;
+
+  // With `full-update-parallelism: 4` in the static config, a full update
+  // runs 4 queries, each one fetches the rows of a single partition by `id`
+  static constexpr const char* kFullUpdatePartitionKey = "id";
+};
+/*! [Pg Cache Policy Parallel Full Update Example] */
+
+/*! [Pg Cache Policy Replication Example] */
+struct PostgresExamplePolicy11 {
+  static constexpr std::string_view kName = "my-pg-cache";
+  using ValueType = MyStructure;
+  static constexpr auto kKeyMember = &MyStructure::id;
+  // The row type gets all the published columns of the table in the table
+  // order, the full update query must select them in the same order
+  static constexpr const char* kQuery =
+      "select id, bar, updated from test.my_data";
+  static constexpr const char* kUpdatedField = nullptr;
+
+  // Incremental updates apply the changes of the table from the publication
+  // made with `create publication my_data_pub for table test.my_data`
+  static constexpr std::string_view kReplicationPublication = "my_data_pub";
+  static constexpr std::string_view kReplicationTable = "test.my_data";
+};
+/*! [Pg Cache Policy Replication Example] */
+
 // Instantiation test
 using MyCache1 = PostgreCache<PostgresExamplePolicy>;
 using MyCache2 = PostgreCache<PostgresExamplePolicy2>;
@@ -304,6 +362,10 @@ using MyTrivialCache = PostgreCache<PostgresTrivialPolicy>;
 using MyCache5 = PostgreCache<PostgresExamplePolicy5>;
 using MyCache6 = PostgreCache<PostgresExamplePolicy6>;
 using MyCache7 = PostgreCache<PostgresExamplePolicy7>;
+using MyCache8 = PostgreCache<PostgresExamplePolicy8>;
+using MyCache9 = PostgreCache<PostgresExamplePolicy9>;
+using MyCache10 = PostgreCache<PostgresExamplePolicy10>;
+using MyCache11 = PostgreCache<PostgresExamplePolicy11>;
 
 // NB: field access required for actual instantiation
 static_assert(MyCache1::kIncrementalUpdates);
@@ -313,6 +375,12 @@ static_assert(MyCache4::kIncrementalUpdates);
 static_assert(MyCache5::kIncrementalUpdates);
 static_assert(MyCache6::kIncrementalUpdates);
 static_assert(MyCache7::kIncrementalUpdates);
+static_assert(MyCache8::kIncrementalUpdates);
+static_assert(!MyCache9::kIncrementalUpdates);
+static_assert(MyCache10::kIncrementalUpdates);
+static_assert(MyCache11::kIncrementalUpdates);
+static_assert(MyCache11::kReplicationUpdates);
+static_assert(!MyCache1::kReplicationUpdates);
 
 namespace pg = storages::postgres;
 static_assert(MyCache1::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
@@ -322,6 +390,12 @@ static_assert(MyCache4::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache5::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache6::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache7::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
+static_assert(MyCache8::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
+static_assert(MyCache9::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
+static_assert(MyCache10::kClusterHostTypeFlags ==
+              pg::ClusterHostType::kSlave);
+static_assert(MyCache11::kClusterHostTypeFlags ==
+              pg::ClusterHostType::kMaster);
 
 // Update() instantiation test
 [[maybe_unused]] void VerifyUpdateCompiles(
@@ -335,6 +409,10 @@ static_assert(MyCache7::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
   MyCache5 cache5{config, context};
   MyCache6 cache6{config, context};
   MyCache7 cache7{config, context};
+  MyCache8 cache8{config, context};
+  MyCache9 cache9{config, context};
+  MyCache10 cache10{config, context};
+  MyCache11 cache11{config, context};
 }
 
 inline auto SampleOfComponentRegistration() {
@@ -2,11 +2,14 @@
 
 #include <storages/postgres/detail/cluster_impl.hpp>
 #include <storages/postgres/detail/pg_impl_types.hpp>
+#include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace storages::postgres {
 
+UserTypes Cluster::kNoUserTypes{};
+
 Cluster::Cluster(DsnList dsns, clients::dns::Resolver* resolver,
                  engine::TaskProcessor& bg_task_processor,
                  const ClusterSettings& cluster_settings,
@@ -56,6 +59,11 @@ NotifyScope Cluster::Listen(std::string_view channel,
   return pimpl_->Listen(channel, cmd_ctl);
 }
 
+ReplicationStream Cluster::CreateReplicationStream(
+    ReplicationSettings settings, OptionalCommandControl cmd_ctl) {
+  return pimpl_->CreateReplicationStream(std::move(settings), cmd_ctl);
+}
+
 void Cluster::SetDefaultCommandControl(CommandControl cmd_ctl) {
   pimpl_->SetDefaultCommandControl(cmd_ctl,
                                    detail::DefaultCommandControlSource::kUser);
@@ -120,8 +128,57 @@ ResultSet Cluster::Execute(ClusterHostTypeFlags flags,
     statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
   }
   statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
-  auto ntrx = Start(flags, statement_cmd_ctl);
-  return ntrx.Execute(statement_cmd_ctl, query.Statement(), store);
+  return DoExecute(flags, statement_cmd_ctl, query,
+                   detail::QueryParameters{store.GetInternalData()});
+}
+
+std::vector<BatchResult> Cluster::ExecuteBatch(ClusterHostTypeFlags flags,
+                                               const QueryBatch& batch) {
+  const auto& statements = batch.GetStatements();
+  // The queries refer to the parameters, so both are reserved in advance
+  std::vector<detail::QueryParameters> params;
+  params.reserve(statements.size());
+  std::vector<detail::PipelinedQuery> queries;
+  queries.reserve(statements.size());
+  for (const auto& statement : statements) {
+    auto statement_cmd_ctl = statement.cmd_ctl;
+    if (!statement_cmd_ctl && statement.query.GetName()) {
+      statement_cmd_ctl =
+          GetQueryCmdCtl(statement.query.GetName()->GetUnderlying());
+    }
+    params.emplace_back(statement.params.GetInternalData());
+    queries.push_back(detail::PipelinedQuery{
+        statement.query, params.back(), GetHandlersCmdCtl(statement_cmd_ctl),
+        {}});
+  }
+
+  pimpl_->ExecuteBatch(flags, queries);
+
+  std::vector<BatchResult> results;
+  results.reserve(queries.size());
+  for (auto& query : queries) {
+    if (query.error) {
+      results.emplace_back(std::move(query.error));
+    } else {
+      UASSERT(query.result);
+      results.emplace_back(std::move(*query.result));
+    }
+  }
+  return results;
+}
+
+ResultSet Cluster::DoExecute(ClusterHostTypeFlags flags,
+                             OptionalCommandControl statement_cmd_ctl,
+                             const Query& query,
+                             const detail::QueryParameters& params) {
+  return pimpl_->Execute(flags, statement_cmd_ctl, query, params);
+}
+
+ResultSet Cluster::DoExecuteCached(ClusterHostTypeFlags flags,
+                                   OptionalCommandControl statement_cmd_ctl,
+                                   const CachedQuery& query,
+                                   const detail::QueryParameters& params) {
+  return pimpl_->ExecuteCached(flags, statement_cmd_ctl, query, params);
 }
 
 }  // namespace storages::postgres
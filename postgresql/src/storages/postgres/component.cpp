@@ -90,6 +90,18 @@ Postgres::Postgres(const ComponentConfig& config,
   initial_settings_.connlimit_mode =
       ParseConnlimitMode(config["connlimit_mode"].As<std::string>("auto"));
 
+  const auto query_cache_config = config["query-cache"];
+  auto& query_cache_settings = initial_settings_.query_cache_settings;
+  query_cache_settings.max_size =
+      query_cache_config["max-size"].As<std::size_t>(0);
+  query_cache_settings.ways = query_cache_config["ways"].As<std::size_t>(
+      storages::postgres::QueryCacheSettings::kDefaultWays);
+  query_cache_settings.ttl =
+      query_cache_config["ttl"].As<std::chrono::milliseconds>(
+          query_cache_settings.ttl);
+  query_cache_settings.invalidation_channel =
+      query_cache_config["invalidation-channel"].As<std::string>("");
+
   initial_settings_.topology_settings.max_replication_lag =
       config["max_replication_lag"].As<std::chrono::milliseconds>(
           kDefaultMaxReplicationLag);
@@ -314,6 +326,22 @@ properties:
         type: boolean
         description: turns on pipeline connection mode
         defaultDescription: false
+    multiplexed_connections:
+        type: integer
+        description: number of connections that pipeline single statements of different tasks, requires pipeline mode (0 - disabled)
+        defaultDescription: 0
+    max_multiplexed_queries:
+        type: integer
+        description: maximum number of statements pipelined on a multiplexed connection at once
+        defaultDescription: 64
+    prepare_on_connect:
+        type: integer
+        description: number of the statements most often prepared by the pool connections that are prepared on a new connection in advance (0 - none)
+        defaultDescription: 0
+    spare_size:
+        type: integer
+        description: maximum number of idle connections opened ahead of demand when clients recently waited for a connection (0 - none)
+        defaultDescription: 0
     connecting_limit:
         type: integer
         description: limit for concurrent establishing connections number per pool (0 - unlimited)
@@ -324,6 +352,29 @@ properties:
          - auto
          - manual
         description: how to learn a connection pool size
+    query-cache:
+        type: object
+        description: client side cache of the results of Cluster::ExecuteCached
+        additionalProperties: false
+        properties:
+            max-size:
+                type: integer
+                minimum: 0
+                description: number of cached results (0 - disabled)
+                defaultDescription: 0
+            ways:
+                type: integer
+                minimum: 1
+                description: number of independently locked parts of the cache
+                defaultDescription: 16
+            ttl:
+                type: string
+                description: time a result is served from the cache
+                defaultDescription: 1s
+            invalidation-channel:
+                type: string
+                description: NOTIFY channel with the names of changed tables as payloads
+                defaultDescription: no invalidation by notifications
 )");
 }
 
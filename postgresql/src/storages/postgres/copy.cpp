@@ -0,0 +1,154 @@
+#include <userver/storages/postgres/copy.hpp>
+
+#include <string_view>
+#include <utility>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace {
+
+// Signature of the binary COPY format, followed by flags and the length of
+// the header extension
+constexpr std::string_view kSignature{"PGCOPY\n\377\r\n\0", 11};
+
+// Column count that marks the end of the data
+constexpr Smallint kTrailer = -1;
+
+constexpr const char* kAbortMessage = "COPY was aborted by the client";
+
+}  // namespace
+
+CopyWriter::CopyWriter(detail::Connection* conn, const Query& query,
+                       OptionalCommandControl cmd_ctl)
+    : conn_(conn), types_(&conn->GetUserTypes()) {
+  UASSERT(conn_);
+  conn_->CopyInStart(query, std::move(cmd_ctl));
+  buffer_.reserve(kChunkSize);
+  buffer_.append(kSignature);
+  io::WriteBuffer(*types_, buffer_, Integer{0});
+  io::WriteBuffer(*types_, buffer_, Integer{0});
+}
+
+CopyWriter::CopyWriter(CopyWriter&& other) noexcept
+    : conn_(std::exchange(other.conn_, nullptr)),
+      types_(other.types_),
+      buffer_(std::move(other.buffer_)) {}
+
+CopyWriter::~CopyWriter() {
+  if (!conn_ || conn_->IsBroken()) return;
+  LOG_LIMITED_WARNING() << "COPY writer is destroyed without Finish(), "
+                           "aborting the COPY";
+  try {
+    conn_->CopyInEnd(kAbortMessage);
+  } catch (const std::exception& e) {
+    LOG_DEBUG() << "COPY was aborted: " << e;
+  }
+}
+
+std::size_t CopyWriter::Finish() {
+  if (!conn_) throw LogicError{"COPY is already finished"};
+  io::WriteBuffer(*types_, buffer_, kTrailer);
+  SendChunk();
+  return std::exchange(conn_, nullptr)->CopyInEnd().RowsAffected();
+}
+
+void CopyWriter::SendChunk() {
+  conn_->CopyInPutData(buffer_);
+  buffer_.clear();
+}
+
+CopyReader::CopyReader(detail::Connection* conn, const Query& query,
+                       OptionalCommandControl cmd_ctl)
+    : conn_(conn), types_(&conn->GetUserTypes()) {
+  UASSERT(conn_);
+  conn_->CopyOutStart(query, std::move(cmd_ctl));
+}
+
+CopyReader::CopyReader(CopyReader&& other) noexcept
+    : conn_(std::exchange(other.conn_, nullptr)),
+      types_(other.types_),
+      data_(std::move(other.data_)),
+      position_(other.position_),
+      is_header_read_(other.is_header_read_) {}
+
+CopyReader::~CopyReader() {
+  if (!conn_) return;
+  LOG_LIMITED_WARNING() << "COPY reader is destroyed before the end of data, "
+                           "closing the connection";
+  conn_->MarkAsBroken();
+}
+
+std::optional<std::size_t> CopyReader::ReadRowHeader() {
+  if (!conn_) return std::nullopt;
+  if (!is_header_read_) {
+    ReadHeader();
+    is_header_read_ = true;
+  }
+
+  FetchData();
+  Smallint column_count{0};
+  position_ += GetRemainingData().Read(column_count,
+                                       io::BufferCategory::kPlainBuffer);
+  if (column_count >= 0) return static_cast<std::size_t>(column_count);
+  if (column_count != kTrailer) {
+    conn_->MarkAsBroken();
+    throw InvalidBinaryBuffer{"Negative column count in COPY data"};
+  }
+
+  // The trailer, the next call returns the result of the statement
+  std::string extra_data;
+  auto* const conn = std::exchange(conn_, nullptr);
+  if (conn->CopyOutGetData(extra_data)) {
+    conn->MarkAsBroken();
+    throw InvalidBinaryBuffer{"COPY data continues after the trailer"};
+  }
+  return std::nullopt;
+}
+
+void CopyReader::ReadHeader() {
+  FetchData();
+  if (std::string_view{data_}.substr(position_, kSignature.size()) !=
+      kSignature) {
+    conn_->MarkAsBroken();
+    throw InvalidBinaryBuffer{
+        "COPY data is not in the binary format, FORMAT binary is required"};
+  }
+  position_ += kSignature.size();
+
+  auto buffer = GetRemainingData();
+  Integer flags{0};
+  Integer extension_size{0};
+  position_ += buffer.Read(flags, io::BufferCategory::kPlainBuffer);
+  position_ += buffer.Read(extension_size, io::BufferCategory::kPlainBuffer);
+  if (extension_size < 0 ||
+      static_cast<std::size_t>(extension_size) > data_.size() - position_) {
+    conn_->MarkAsBroken();
+    throw InvalidBinaryBuffer{"Invalid COPY header extension size"};
+  }
+  position_ += extension_size;
+}
+
+void CopyReader::FetchData() {
+  if (position_ < data_.size()) return;
+  position_ = 0;
+  data_.clear();
+  if (!conn_->CopyOutGetData(data_)) {
+    conn_ = nullptr;
+    throw InvalidBinaryBuffer{"COPY data has ended without the trailer"};
+  }
+}
+
+io::FieldBuffer CopyReader::GetRemainingData() const {
+  return {false, io::BufferCategory::kPlainBuffer, data_.size() - position_,
+          reinterpret_cast<const std::uint8_t*>(data_.data()) + position_};
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -4,8 +4,11 @@
 
 #include <userver/dynamic_config/value.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/server/request/task_inherited_data.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/rand.hpp>
 
 #include <storages/postgres/detail/topology/hot_standby.hpp>
 #include <storages/postgres/detail/topology/standalone.hpp>
@@ -20,6 +23,8 @@ namespace storages::postgres::detail {
 
 namespace {
 
+constexpr std::chrono::seconds kQueryCacheListenRetryDelay{1};
+
 ClusterHostType Fallback(ClusterHostType ht) {
   switch (ht) {
     case ClusterHostType::kMaster:
@@ -31,15 +36,31 @@ ClusterHostType Fallback(ClusterHostType ht) {
     case ClusterHostType::kNone:
     case ClusterHostType::kRoundRobin:
     case ClusterHostType::kNearest:
+    case ClusterHostType::kLeastLoaded:
       throw ClusterError("Invalid ClusterHostType value for fallback " +
                          ToString(ht));
   }
   UINVARIANT(false, "Unexpected cluster host type");
 }
 
-size_t SelectDsnIndex(const topology::TopologyBase::DsnIndices& indices,
-                      ClusterHostTypeFlags flags,
-                      std::atomic<uint32_t>& rr_host_idx) {
+// Power of two choices, avoids herding on the host that looked the least
+// loaded a moment ago
+size_t SelectLeastLoaded(
+    const topology::TopologyBase::DsnIndices& indices,
+    const std::vector<std::shared_ptr<ConnectionPool>>& host_pools) {
+  const auto first = USERVER_NAMESPACE::utils::RandRange(indices.size());
+  auto second = USERVER_NAMESPACE::utils::RandRange(indices.size() - 1);
+  if (second >= first) ++second;
+
+  const auto first_load = host_pools.at(indices[first])->GetLoad();
+  const auto second_load = host_pools.at(indices[second])->GetLoad();
+  return first_load <= second_load ? first : second;
+}
+
+size_t SelectDsnIndex(
+    const topology::TopologyBase::DsnIndices& indices,
+    ClusterHostTypeFlags flags, std::atomic<uint32_t>& rr_host_idx,
+    const std::vector<std::shared_ptr<ConnectionPool>>& host_pools) {
   UASSERT(!indices.empty());
   if (indices.empty()) {
     throw ClusterError("Cannot select host from an empty list");
@@ -54,6 +75,8 @@ size_t SelectDsnIndex(const topology::TopologyBase::DsnIndices& indices,
       idx_pos =
           rr_host_idx.fetch_add(1, std::memory_order_relaxed) % indices.size();
     }
+  } else if (strategy_flags == ClusterHostType::kLeastLoaded) {
+    if (indices.size() != 1) idx_pos = SelectLeastLoaded(indices, host_pools);
   } else if (strategy_flags != ClusterHostType::kNearest) {
     throw LogicError(
         fmt::format("Invalid strategy requested: {}, ensure only one is used",
@@ -117,9 +140,26 @@ ClusterImpl::ClusterImpl(DsnList dsns, clients::dns::Resolver* resolver,
   if (cluster_settings.connlimit_mode == ConnlimitMode::kAuto) {
     connlimit_watchdog_.Start();
   }
+
+  const auto& cache_settings = cluster_settings.query_cache_settings;
+  if (cache_settings.max_size > 0) {
+    query_cache_ = std::make_unique<QueryResultCache>(cache_settings);
+    if (!cache_settings.invalidation_channel.empty()) {
+      query_cache_invalidation_task_ = USERVER_NAMESPACE::utils::Async(
+          "pg_query_cache_invalidation",
+          [this, channel = cache_settings.invalidation_channel] {
+            ListenQueryCacheInvalidations(channel);
+          });
+    }
+  }
 }
 
-ClusterImpl::~ClusterImpl() { connlimit_watchdog_.Stop(); }
+ClusterImpl::~ClusterImpl() {
+  if (query_cache_invalidation_task_.IsValid()) {
+    query_cache_invalidation_task_.SyncCancel();
+  }
+  connlimit_watchdog_.Stop();
+}
 
 ClusterStatisticsPtr ClusterImpl::GetStatistics() const {
   auto cluster_stats = std::make_unique<ClusterStatistics>();
@@ -201,6 +241,7 @@ ClusterStatisticsPtr ClusterImpl::GetStatistics() const {
     cluster_stats->unknown.push_back(std::move(desc));
   }
 
+  if (query_cache_) cluster_stats->query_cache = query_cache_->GetStatistics();
   return cluster_stats;
 }
 
@@ -223,7 +264,8 @@ ClusterImpl::ConnectionPoolPtr ClusterImpl::FindPool(
     if (alive_dsn_indices->empty()) {
       throw ClusterUnavailable("None of cluster hosts are available");
     }
-    dsn_index = SelectDsnIndex(*alive_dsn_indices, flags, rr_host_idx_);
+    dsn_index = SelectDsnIndex(*alive_dsn_indices, flags, rr_host_idx_,
+                               host_pools_);
   } else {
     auto host_role = static_cast<ClusterHostType>(role_flags.GetValue());
     auto dsn_indices_by_type = topology_->GetDsnIndicesByType();
@@ -245,7 +287,8 @@ ClusterImpl::ConnectionPoolPtr ClusterImpl::FindPool(
                       ToString(host_role), ToString(role_flags)));
     }
     LOG_TRACE() << "Starting transaction on " << host_role;
-    dsn_index = SelectDsnIndex(dsn_indices_it->second, flags, rr_host_idx_);
+    dsn_index = SelectDsnIndex(dsn_indices_it->second, flags, rr_host_idx_,
+                               host_pools_);
   }
 
   UASSERT(dsn_index < host_pools_.size());
@@ -280,11 +323,75 @@ NonTransaction ClusterImpl::Start(ClusterHostTypeFlags flags,
   return FindPool(flags)->Start(cmd_ctl);
 }
 
+ResultSet ClusterImpl::Execute(ClusterHostTypeFlags flags,
+                               OptionalCommandControl cmd_ctl,
+                               const Query& query,
+                               const QueryParameters& params) {
+  if (!(flags & kClusterHostRolesMask)) {
+    throw LogicError(
+        "Host role must be specified for execution of a single statement");
+  }
+  LOG_TRACE() << "Requested single statement on " << flags;
+  return FindPool(flags)->Execute(cmd_ctl, query, params);
+}
+
+void ClusterImpl::ExecuteBatch(ClusterHostTypeFlags flags,
+                               std::vector<PipelinedQuery>& queries) {
+  if (!(flags & kClusterHostRolesMask)) {
+    throw LogicError(
+        "Host role must be specified for execution of a statement batch");
+  }
+  if (queries.empty()) return;
+  LOG_TRACE() << "Requested batch of " << queries.size() << " statements on "
+              << flags;
+  FindPool(flags)->ExecuteBatch(queries);
+}
+
+ResultSet ClusterImpl::ExecuteCached(ClusterHostTypeFlags flags,
+                                     OptionalCommandControl cmd_ctl,
+                                     const CachedQuery& query,
+                                     const QueryParameters& params) {
+  if (!query_cache_) return Execute(flags, cmd_ctl, query.query, params);
+  return query_cache_->GetOrFetch(
+      query.query, query.tables, params,
+      [&] { return Execute(flags, cmd_ctl, query.query, params); });
+}
+
+void ClusterImpl::ListenQueryCacheInvalidations(const std::string& channel) {
+  while (!engine::current_task::ShouldCancel()) {
+    try {
+      auto scope = Listen(channel, {});
+      // The notifications sent while there was no listener are lost
+      query_cache_->InvalidateAll();
+      while (true) {
+        const auto notification = scope.WaitNotify(engine::Deadline{});
+        if (notification.payload) {
+          query_cache_->Invalidate(*notification.payload);
+        } else {
+          query_cache_->InvalidateAll();
+        }
+      }
+    } catch (const std::exception& e) {
+      if (engine::current_task::ShouldCancel()) break;
+      LOG_WARNING() << "Failed to listen for query cache invalidations on '"
+                    << channel << "', the cached results are served until "
+                    << "their TTL expires: " << e;
+    }
+    engine::InterruptibleSleepFor(kQueryCacheListenRetryDelay);
+  }
+}
+
 NotifyScope ClusterImpl::Listen(std::string_view channel,
                                 OptionalCommandControl cmd_ctl) {
   return FindPool(ClusterHostType::kMaster)->Listen(channel, cmd_ctl);
 }
 
+ReplicationStream ClusterImpl::CreateReplicationStream(
+    ReplicationSettings settings, OptionalCommandControl cmd_ctl) {
+  return FindPool(ClusterHostType::kMaster)
+      ->CreateReplicationStream(std::move(settings), cmd_ctl);
+}
+
 void ClusterImpl::SetDefaultCommandControl(CommandControl cmd_ctl,
                                            DefaultCommandControlSource source) {
   default_cmd_ctls_.UpdateDefaultCmdCtl(cmd_ctl, source);
@@ -7,6 +7,7 @@
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/dynamic_config/source.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/error_injection/settings.hpp>
 #include <userver/testsuite/postgres_control.hpp>
 #include <userver/testsuite/tasks.hpp>
@@ -14,12 +15,15 @@
 #include <storages/postgres/connlimit_watchdog.hpp>
 #include <storages/postgres/detail/pg_impl_types.hpp>
 #include <storages/postgres/detail/pool.hpp>
+#include <storages/postgres/detail/query_result_cache.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
 #include <storages/postgres/detail/topology/base.hpp>
 #include <userver/storages/postgres/cluster_types.hpp>
 #include <userver/storages/postgres/detail/non_transaction.hpp>
 #include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/query_cache.hpp>
+#include <userver/storages/postgres/replication.hpp>
 #include <userver/storages/postgres/statistics.hpp>
 #include <userver/storages/postgres/transaction.hpp>
 
@@ -47,8 +51,20 @@ class ClusterImpl {
 
   NonTransaction Start(ClusterHostTypeFlags, OptionalCommandControl);
 
+  ResultSet Execute(ClusterHostTypeFlags, OptionalCommandControl,
+                    const Query& query, const QueryParameters& params);
+
+  void ExecuteBatch(ClusterHostTypeFlags, std::vector<PipelinedQuery>& queries);
+
+  ResultSet ExecuteCached(ClusterHostTypeFlags, OptionalCommandControl,
+                          const CachedQuery& query,
+                          const QueryParameters& params);
+
   NotifyScope Listen(std::string_view channel, OptionalCommandControl);
 
+  ReplicationStream CreateReplicationStream(ReplicationSettings settings,
+                                            OptionalCommandControl);
+
   void SetDefaultCommandControl(CommandControl, DefaultCommandControlSource);
   CommandControl GetDefaultCommandControl() const;
 
@@ -75,6 +91,8 @@ class ClusterImpl {
 
   bool IsConnlimitModeAuto(const ClusterSettings& settings) const;
 
+  void ListenQueryCacheInvalidations(const std::string& channel);
+
   using ConnectionPoolPtr = std::shared_ptr<ConnectionPool>;
 
   ConnectionPoolPtr FindPool(ClusterHostTypeFlags);
@@ -87,6 +105,8 @@ class ClusterImpl {
   std::atomic<uint32_t> rr_host_idx_;
   dynamic_config::Source config_source_;
   ConnlimitWatchdog connlimit_watchdog_;
+  std::unique_ptr<QueryResultCache> query_cache_;
+  engine::TaskWithResult<void> query_cache_invalidation_task_;
 };
 
 }  // namespace storages::postgres::detail
@@ -91,6 +91,16 @@ Connection::Statistics Connection::GetStatsAndReset() {
   return pimpl_->GetStatsAndReset();
 }
 
+std::vector<PreparableStatement> Connection::TakeNewlyPreparedStatements() {
+  return pimpl_->TakeNewlyPreparedStatements();
+}
+
+void Connection::PrepareStatements(
+    const std::vector<PreparableStatement>& statements,
+    engine::Deadline deadline) {
+  pimpl_->PrepareStatements(statements, deadline);
+}
+
 void Connection::Begin(const TransactionOptions& options,
                        SteadyClock::time_point trx_start_time,
                        OptionalCommandControl trx_cmd_ctl) {
@@ -123,6 +133,11 @@ ResultSet Connection::Execute(CommandControl statement_cmd_ctl,
                  OptionalCommandControl{statement_cmd_ctl});
 }
 
+void Connection::ExecutePipelined(
+    const std::vector<PipelinedQuery*>& queries) {
+  pimpl_->ExecutePipelined(queries);
+}
+
 Connection::StatementId Connection::PortalBind(
     const std::string& statement, const std::string& portal_name,
     const detail::QueryParameters& params,
@@ -139,6 +154,38 @@ ResultSet Connection::PortalExecute(StatementId statement_id,
                                std::move(statement_cmd_ctl));
 }
 
+void Connection::CopyInStart(const Query& query,
+                             OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->CopyInStart(query, std::move(statement_cmd_ctl));
+}
+
+void Connection::CopyInPutData(std::string_view data) {
+  pimpl_->CopyInPutData(data);
+}
+
+ResultSet Connection::CopyInEnd(const char* error_message) {
+  return pimpl_->CopyInEnd(error_message);
+}
+
+void Connection::CopyOutStart(const Query& query,
+                              OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->CopyOutStart(query, std::move(statement_cmd_ctl));
+}
+
+bool Connection::CopyOutGetData(std::string& data) {
+  return pimpl_->CopyOutGetData(data);
+}
+
+void Connection::StreamStart(const Query& query,
+                             const detail::QueryParameters& params,
+                             OptionalCommandControl statement_cmd_ctl) {
+  pimpl_->StreamStart(query, params, std::move(statement_cmd_ctl));
+}
+
+std::optional<ResultSet> Connection::StreamNextRow() {
+  return pimpl_->StreamNextRow();
+}
+
 void Connection::CancelAndCleanup(TimeoutDuration timeout) {
   pimpl_->CancelAndCleanup(timeout);
 }
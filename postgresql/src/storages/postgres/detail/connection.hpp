@@ -2,10 +2,14 @@
 
 #include <atomic>
 #include <chrono>
+#include <exception>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/concurrent/background_task_storage_fwd.hpp>
+#include <userver/engine/deadline.hpp>
 #include <userver/engine/semaphore.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/error_injection/settings.hpp>
@@ -39,6 +43,26 @@ namespace detail {
 
 class ConnectionImpl;
 
+/// @brief A single statement of a batch executed with
+/// Connection::ExecutePipelined
+struct PipelinedQuery {
+  const Query& query;
+  const QueryParameters& params;
+  OptionalCommandControl cmd_ctl;
+  engine::Deadline deadline;
+
+  /// Either the result or the error is set after the execution
+  std::optional<ResultSet> result{};
+  std::exception_ptr error{};
+};
+
+/// @brief A statement with the types of its parameters, enough to prepare it
+/// on another connection
+struct PreparableStatement {
+  std::string statement;
+  std::vector<Oid> param_types;
+};
+
 /// @brief PostreSQL connection class
 /// Handles connecting to Postgres, sending commands, processing command results
 /// and closing Postgres connection.
@@ -180,6 +204,15 @@ class Connection {
   /// @note May only be called when connection is not in transaction
   Statistics GetStatsAndReset();
 
+  /// Statements prepared by the connection since the previous call,
+  /// PrepareStatements excluded
+  std::vector<PreparableStatement> TakeNewlyPreparedStatements();
+
+  /// Prepare the statements in one pipeline roundtrip. The statements that
+  /// fail to prepare are skipped, they are prepared again before execution.
+  void PrepareStatements(const std::vector<PreparableStatement>& statements,
+                         engine::Deadline deadline);
+
   //@{
   /// Begin a transaction in Postgres with specific start time point
   /// Suspends coroutine for execution
@@ -227,6 +260,14 @@ class Connection {
   ResultSet Execute(CommandControl statement_cmd_ctl, const Query& query,
                     const ParameterStore& store);
 
+  /// @brief Execute independent single statements in one roundtrip
+  ///
+  /// Statements are sent at once, each in its own pipeline segment, so an
+  /// error of a statement does not affect the others. Falls back to
+  /// sequential execution if the connection is not in pipeline mode.
+  /// Must be called outside of a transaction.
+  void ExecutePipelined(const std::vector<PipelinedQuery*>& queries);
+
   StatementId PortalBind(const std::string& statement,
                          const std::string& portal_name,
                          const detail::QueryParameters& params,
@@ -234,6 +275,27 @@ class Connection {
   ResultSet PortalExecute(StatementId, const std::string& portal_name,
                           std::uint32_t n_rows, OptionalCommandControl);
 
+  /// Start a `COPY ... FROM STDIN` statement, the connection accepts only
+  /// the COPY data until CopyInEnd
+  void CopyInStart(const Query& query, OptionalCommandControl);
+  /// Send a chunk of the COPY data
+  void CopyInPutData(std::string_view data);
+  /// Finish the COPY, a non-null error_message aborts it
+  ResultSet CopyInEnd(const char* error_message = nullptr);
+
+  /// Start a `COPY ... TO STDOUT` statement, the connection returns only
+  /// the COPY data until CopyOutGetData returns false
+  void CopyOutStart(const Query& query, OptionalCommandControl);
+  /// Receive a row of the COPY data
+  bool CopyOutGetData(std::string& data);
+
+  /// Start a statement that returns its rows one by one, the connection
+  /// returns only the rows until StreamNextRow returns nullopt
+  void StreamStart(const Query& query, const detail::QueryParameters& params,
+                   OptionalCommandControl);
+  /// Receive the next row of the statement
+  std::optional<ResultSet> StreamNextRow();
+
   /// Send cancel to the database backend
   /// Try to return connection to idle state discarding all results.
   /// If there is a transaction in progress - roll it back.
@@ -41,6 +41,25 @@ constexpr std::string_view kStatementUnlisten = "unlisten {}";
 const std::string kBadCachedPlanErrorMessage =
     "cached plan must not change result type";
 
+// Statements prepared by a connection between two acquisitions that are
+// remembered for the pool
+constexpr std::size_t kMaxNewlyPreparedStatements = 64;
+
+// Parameters of a statement that is prepared without executing
+class ParameterTypes {
+ public:
+  explicit ParameterTypes(const std::vector<Oid>& types) : types_{types} {}
+
+  std::size_t Size() const { return types_.size(); }
+  const Oid* ParamTypesBuffer() const { return types_.data(); }
+  const char* const* ParamBuffers() const { return nullptr; }
+  const int* ParamLengthsBuffer() const { return nullptr; }
+  const int* ParamFormatsBuffer() const { return nullptr; }
+
+ private:
+  const std::vector<Oid>& types_;
+};
+
 std::size_t QueryHash(const std::string& statement,
                       const QueryParameters& params) {
   auto res = params.TypeHash();
@@ -368,6 +387,152 @@ ResultSet ConnectionImpl::ExecuteCommand(
   return ExecuteCommand(query, params, deadline);
 }
 
+void ConnectionImpl::ExecutePipelined(
+    const std::vector<PipelinedQuery*>& queries) {
+  UASSERT(!IsInTransaction());
+  // A batch larger than the cache would evict its own prepared statements
+  if (!IsPipelineActive() || queries.size() < 2 ||
+      queries.size() > settings_.max_prepared_cache_size) {
+    ExecuteSequentially(queries);
+    return;
+  }
+
+  // A statement of the batch that is sent in its own pipeline segment
+  struct SentQuery {
+    PipelinedQuery* query;
+    std::string statement_name;
+    ResultSet description{nullptr};
+    bool changes_timeout{false};
+  };
+
+  CheckBusy();
+  const auto& front_deadline = queries.front()->deadline;
+  tracing::Span span{scopes::kPipeline};
+  conn_wrapper_.FillSpanTags(
+      span, {std::chrono::duration_cast<std::chrono::milliseconds>(
+                 front_deadline.TimeLeft()),
+             GetStatementTimeout()});
+  span.AddTag("pipelined_queries", queries.size());
+  auto scope = span.CreateScopeTime();
+
+  std::vector<SentQuery> sent;
+  sent.reserve(queries.size());
+  try {
+    DiscardOldPreparedStatements(front_deadline);
+
+    // Preparing waits for the results, so it is done for all the statements
+    // before the pipeline is filled
+    for (auto* query : queries) {
+      try {
+        const auto& statement = query->query.Statement();
+        CheckDeadlineReached(query->deadline);
+        if (settings_.ignore_unused_query_params ==
+            ConnectionSettings::kCheckUnused) {
+          CheckQueryParameters(statement, query->params);
+        }
+        if (testsuite::AreTestpointsAvailable() && query->query.GetName()) {
+          ReportStatement(query->query.GetName()->GetUnderlying());
+        }
+
+        SentQuery sent_query{query, {}, ResultSet{nullptr}};
+        if (settings_.prepared_statements ==
+            ConnectionSettings::kCachePreparedStatements) {
+          const auto& prepared_info = PrepareStatement(
+              statement, query->params, query->deadline, span, scope);
+          sent_query.statement_name = prepared_info.statement_name;
+          if (IsOmitDescribeInExecuteEnabled()) {
+            sent_query.description = prepared_info.description;
+          }
+        }
+        sent.push_back(std::move(sent_query));
+      } catch (const std::exception&) {
+        if (IsBroken()) throw;
+        query->error = std::current_exception();
+      }
+    }
+
+    scope.Reset(scopes::kExec);
+    for (auto& sent_query : sent) {
+      const auto& query = *sent_query.query;
+      const auto timeout = testsuite_pg_ctl_.MakeStatementTimeout(
+          query.cmd_ctl ? query.cmd_ctl->statement
+                        : GetDefaultCommandControl().statement);
+      if (timeout != current_statement_timeout_) {
+        // Goes into the segment of the statement, so that the statement is
+        // aborted if the timeout is not set
+        StaticQueryParameters<3> params;
+        params.Write(db_types_, kStatementTimeoutParameter,
+                     std::to_string(timeout.count()), false);
+        conn_wrapper_.SendQuery("SELECT set_config($1, $2, $3)",
+                                QueryParameters{params}, scope);
+        current_statement_timeout_ = timeout;
+        sent_query.changes_timeout = true;
+      }
+      if (sent_query.statement_name.empty()) {
+        conn_wrapper_.SendQuery(query.query.Statement(), query.params, scope);
+      } else {
+        auto* description = sent_query.description.pimpl_
+                                ? sent_query.description.pimpl_->handle_.get()
+                                : nullptr;
+        conn_wrapper_.SendPreparedQuery(sent_query.statement_name,
+                                        query.params, scope, description);
+      }
+      conn_wrapper_.SendPipelineSync();
+    }
+  } catch (const std::exception&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    // The pipeline is in an unknown state
+    MarkAsBroken();
+    const auto error = std::current_exception();
+    for (auto* query : queries) {
+      if (!query->error) query->error = error;
+    }
+    return;
+  }
+
+  for (auto& sent_query : sent) {
+    auto& query = *sent_query.query;
+    if (IsBroken()) {
+      query.error = std::make_exception_ptr(
+          ConnectionError{"Connection was broken by a pipelined statement"});
+      continue;
+    }
+    CountExecute count_execute(stats_);
+    try {
+      query.result = WaitResult(
+          query.query.Statement(), query.deadline,
+          std::chrono::duration_cast<std::chrono::milliseconds>(
+              query.deadline.TimeLeft()),
+          count_execute, span, scope,
+          sent_query.description.pimpl_ ? &sent_query.description : nullptr,
+          /*pipeline_segment=*/true);
+    } catch (const std::exception&) {
+      query.error = std::current_exception();
+      // The statement might have been aborted by a failed timeout change
+      if (sent_query.changes_timeout) {
+        current_statement_timeout_ = TimeoutDuration::min();
+      }
+    }
+  }
+}
+
+void ConnectionImpl::ExecuteSequentially(
+    const std::vector<PipelinedQuery*>& queries) {
+  for (auto* query : queries) {
+    try {
+      if (IsBroken()) {
+        throw ConnectionError{"Connection was broken by a previous statement"};
+      }
+      CheckBusy();
+      SetStatementTimeout(query->cmd_ctl);
+      query->result =
+          ExecuteCommand(query->query, query->params, query->deadline);
+    } catch (const std::exception&) {
+      query->error = std::current_exception();
+    }
+  }
+}
+
 void ConnectionImpl::Begin(const TransactionOptions& options,
                            SteadyClock::time_point trx_start_time,
                            OptionalCommandControl trx_cmd_ctl) {
@@ -502,6 +667,61 @@ ResultSet ConnectionImpl::PortalExecute(
                     count_execute, span, scope, &prepared_info->description);
 }
 
+void ConnectionImpl::CopyInStart(const Query& query,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  StartCopy(query, std::move(statement_cmd_ctl));
+}
+
+void ConnectionImpl::CopyInPutData(std::string_view data) {
+  UASSERT(copy_);
+  try {
+    conn_wrapper_.PutCopyData(data, testsuite_pg_ctl_.MakeExecuteDeadline(
+                                        copy_->network_timeout));
+  } catch (const std::exception&) {
+    // The connection is stuck in the COPY IN state
+    MarkAsBroken();
+    throw;
+  }
+}
+
+ResultSet ConnectionImpl::CopyInEnd(const char* error_message) {
+  UASSERT(copy_);
+  auto copy = std::move(*copy_);
+  copy_.reset();
+  const auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(copy.network_timeout);
+  try {
+    conn_wrapper_.PutCopyEnd(error_message, deadline);
+  } catch (const std::exception&) {
+    MarkAsBroken();
+    throw;
+  }
+  return WaitCopyResult(std::move(copy), deadline);
+}
+
+void ConnectionImpl::CopyOutStart(const Query& query,
+                                  OptionalCommandControl statement_cmd_ctl) {
+  StartCopy(query, std::move(statement_cmd_ctl));
+}
+
+bool ConnectionImpl::CopyOutGetData(std::string& data) {
+  UASSERT(copy_);
+  const auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(copy_->network_timeout);
+  try {
+    if (conn_wrapper_.GetCopyData(data, deadline)) return true;
+  } catch (const std::exception&) {
+    // The connection is stuck in the COPY OUT state
+    MarkAsBroken();
+    throw;
+  }
+
+  auto copy = std::move(*copy_);
+  copy_.reset();
+  WaitCopyResult(std::move(copy), deadline);
+  return false;
+}
+
 void ConnectionImpl::Listen(std::string_view channel,
                             OptionalCommandControl cmd_ctl) {
   ExecuteCommandNoPrepare(
@@ -521,6 +741,166 @@ Notification ConnectionImpl::WaitNotify(engine::Deadline deadline) {
   return conn_wrapper_.WaitNotify(deadline);
 }
 
+void ConnectionImpl::StreamStart(const Query& query,
+                                 const QueryParameters& params,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  CheckBusy();
+  StreamState stream{query, ExecuteTimeout(statement_cmd_ctl)};
+  auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(stream.network_timeout);
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+
+  CheckDeadlineReached(deadline);
+  auto span =
+      MakeQuerySpan(query, {stream.network_timeout, GetStatementTimeout()});
+  auto scope = span.CreateScopeTime();
+  try {
+    if (IsPipelineActive()) {
+      // The single row mode applies to the first statement in the pipeline
+      // queue. The commands sent before are waited for to leave the mode,
+      // Cleanup() restores it if the statement fails to start.
+      conn_wrapper_.WaitResult(deadline, scope, nullptr);
+      conn_wrapper_.ExitPipelineMode();
+      stream.reenter_pipeline = true;
+    }
+    conn_wrapper_.SendSingleRowQuery(query.Statement(), params, scope);
+  } catch (const std::exception&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  }
+  ++stats_.execute_total;
+  stream.start_time = SteadyClock::now();
+  stream_ = std::move(stream);
+}
+
+std::optional<ResultSet> ConnectionImpl::StreamNextRow() {
+  UASSERT(stream_);
+  // The network timeout applies to each row, the socket is not read until
+  // the row is requested
+  const auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(stream_->network_timeout);
+  std::optional<ResultSet> row;
+  try {
+    row.emplace(conn_wrapper_.WaitSingleRow(deadline));
+  } catch (const std::exception&) {
+    FinishStream(/*completed=*/false);
+    throw;
+  }
+
+  if (row->IsEmpty()) {
+    FinishStream(/*completed=*/true);
+    return std::nullopt;
+  }
+  if (stream_->description) {
+    row->SetBufferCategoriesFrom(*stream_->description);
+  } else {
+    FillBufferCategories(*row);
+    stream_->description = *row;
+  }
+  return row;
+}
+
+void ConnectionImpl::FinishStream(bool completed) {
+  UASSERT(stream_);
+  auto stream = std::move(*stream_);
+  stream_.reset();
+
+  const auto now = SteadyClock::now();
+  if (completed) {
+    ++stats_.reply_total;
+  } else {
+    ++stats_.error_execute_total;
+  }
+  stats_.sum_query_duration += now - stream.start_time;
+  stats_.last_execute_finish = now;
+  if (stream.reenter_pipeline && !IsBroken()) {
+    conn_wrapper_.EnterPipelineMode();
+  }
+}
+
+std::vector<PreparableStatement> ConnectionImpl::TakeNewlyPreparedStatements() {
+  return std::exchange(newly_prepared_, {});
+}
+
+void ConnectionImpl::PrepareStatements(
+    const std::vector<PreparableStatement>& statements,
+    engine::Deadline deadline) {
+  if (statements.empty() || settings_.prepared_statements ==
+                                ConnectionSettings::kNoPreparedStatements) {
+    return;
+  }
+  CheckBusy();
+  tracing::Span span{scopes::kPrepareStatements};
+  span.AddTag("prepared_statements", statements.size());
+  auto scope = span.CreateScopeTime();
+  const auto max_count =
+      std::min(statements.size(),
+               settings_.max_prepared_cache_size - prepared_.GetSize());
+
+#if LIBPQ_HAS_PIPELINING
+  struct SentStatement {
+    const PreparableStatement& statement;
+    Connection::StatementId id;
+    std::string name;
+  };
+  std::vector<SentStatement> sent;
+  sent.reserve(max_count);
+
+  const bool is_pipeline_active = IsPipelineActive();
+  if (!is_pipeline_active) conn_wrapper_.EnterPipelineMode();
+  // Each statement is a pipeline segment, so that a failure is isolated
+  for (std::size_t i = 0; i < max_count; ++i) {
+    const auto& statement = statements[i];
+    ParameterTypes types{statement.param_types};
+    const QueryParameters params{types};
+    const auto query_hash = QueryHash(statement.statement, params);
+    const Connection::StatementId id{query_hash};
+    if (prepared_.Get(id)) continue;
+
+    auto name = "q" + std::to_string(query_hash) + "_" + uuid_;
+    conn_wrapper_.SendPrepare(name, statement.statement, params, scope);
+    conn_wrapper_.SendDescribePrepared(name, scope);
+    conn_wrapper_.SendPipelineSync();
+    sent.push_back({statement, id, std::move(name)});
+  }
+
+  for (auto& sent_statement : sent) {
+    try {
+      auto res = conn_wrapper_.WaitPipelineResult(deadline, scope, nullptr);
+      if (!res.pimpl_) throw CommandError("WaitResult() returned nullptr");
+      FillBufferCategories(res);
+      res.GetRowDescription().CheckBinaryFormat(db_types_);
+      prepared_.Put(sent_statement.id,
+                    {sent_statement.id, sent_statement.statement.statement,
+                     std::move(sent_statement.name), std::move(res)});
+      ++stats_.parse_total;
+    } catch (const std::exception& e) {
+      // The rest of the results can not be read
+      if (IsBroken()) throw;
+      LOG_LIMITED_WARNING() << "Failed to prepare statement `"
+                            << sent_statement.statement.statement
+                            << "` in advance: " << e;
+    }
+  }
+  if (!is_pipeline_active) conn_wrapper_.ExitPipelineMode();
+#else
+  const auto log_size = newly_prepared_.size();
+  for (std::size_t i = 0; i < max_count; ++i) {
+    const auto& statement = statements[i];
+    ParameterTypes types{statement.param_types};
+    try {
+      PrepareStatement(statement.statement, QueryParameters{types}, deadline,
+                       span, scope);
+    } catch (const std::exception& e) {
+      if (IsBroken()) throw;
+      LOG_LIMITED_WARNING() << "Failed to prepare statement `"
+                            << statement.statement << "` in advance: " << e;
+    }
+  }
+  newly_prepared_.resize(log_size);
+#endif
+}
+
 void ConnectionImpl::CancelAndCleanup(TimeoutDuration timeout) {
   auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(timeout);
 
@@ -616,6 +996,47 @@ void ConnectionImpl::CheckBusy() const {
   }
 }
 
+void ConnectionImpl::StartCopy(const Query& query,
+                               OptionalCommandControl statement_cmd_ctl) {
+  CheckBusy();
+  CopyState copy{query, ExecuteTimeout(statement_cmd_ctl)};
+  auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(copy.network_timeout);
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+
+  CheckDeadlineReached(deadline);
+  auto span =
+      MakeQuerySpan(query, {copy.network_timeout, GetStatementTimeout()});
+  auto scope = span.CreateScopeTime();
+  try {
+    if (IsPipelineActive()) {
+      // libpq does not allow COPY in the pipeline mode. The commands sent
+      // before are waited for to leave it, Cleanup() restores the mode if the
+      // COPY fails.
+      conn_wrapper_.WaitResult(deadline, scope, nullptr);
+      conn_wrapper_.ExitPipelineMode();
+      copy.reenter_pipeline = true;
+    }
+    conn_wrapper_.SendQuery(query.Statement(), scope);
+    conn_wrapper_.WaitCopyStart(deadline, scope);
+  } catch (const std::exception&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  }
+  copy_ = std::move(copy);
+}
+
+ResultSet ConnectionImpl::WaitCopyResult(CopyState&& copy,
+                                         engine::Deadline deadline) {
+  auto span =
+      MakeQuerySpan(copy.query, {copy.network_timeout, GetStatementTimeout()});
+  auto scope = span.CreateScopeTime();
+  CountExecute count_execute(stats_);
+  auto res = WaitResult(copy.query.Statement(), deadline, copy.network_timeout,
+                        count_execute, span, scope, nullptr);
+  if (copy.reenter_pipeline) conn_wrapper_.EnterPipelineMode();
+  return res;
+}
+
 void ConnectionImpl::CheckDeadlineReached(const engine::Deadline& deadline) {
   if (deadline.IsReached()) {
     ++stats_.execute_timeout;
@@ -755,6 +1176,11 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::PrepareStatement(
 
   statement_info = prepared_.Get(query_id);
   ++stats_.parse_total;
+  if (newly_prepared_.size() < kMaxNewlyPreparedStatements) {
+    newly_prepared_.push_back(
+        {statement, {params.ParamTypesBuffer(),
+                     params.ParamTypesBuffer() + params.Size()}});
+  }
 
   return *statement_info;
 }
@@ -929,12 +1355,16 @@ ResultSet ConnectionImpl::WaitResult(const std::string& statement,
                                      TimeoutDuration network_timeout,
                                      Counter& counter, tracing::Span& span,
                                      tracing::ScopeTime& scope,
-                                     const ResultSet* description_ptr) {
+                                     const ResultSet* description_ptr,
+                                     bool pipeline_segment) {
   const PGresult* description =
       description_ptr ? description_ptr->pimpl_->handle_.get() : nullptr;
 
   try {
-    auto res = conn_wrapper_.WaitResult(deadline, scope, description);
+    auto res =
+        pipeline_segment
+            ? conn_wrapper_.WaitPipelineResult(deadline, scope, description)
+            : conn_wrapper_.WaitResult(deadline, scope, description);
     if (description_ptr) {
       res.SetBufferCategoriesFrom(*description_ptr);
     } else if (!res.IsEmpty()) {
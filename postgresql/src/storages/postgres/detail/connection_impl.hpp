@@ -6,6 +6,7 @@
 #include <string_view>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 #include <userver/cache/lru_map.hpp>
 #include <userver/concurrent/background_task_storage_fwd.hpp>
@@ -67,10 +68,16 @@ class ConnectionImpl {
 
   Connection::Statistics GetStatsAndReset();
 
+  std::vector<PreparableStatement> TakeNewlyPreparedStatements();
+  void PrepareStatements(const std::vector<PreparableStatement>& statements,
+                         engine::Deadline deadline);
+
   ResultSet ExecuteCommand(const Query& query,
                            const detail::QueryParameters& params,
                            OptionalCommandControl statement_cmd_ctl);
 
+  void ExecutePipelined(const std::vector<PipelinedQuery*>& queries);
+
   void Begin(const TransactionOptions& options,
              SteadyClock::time_point trx_start_time,
              OptionalCommandControl trx_cmd_ctl = {});
@@ -89,6 +96,19 @@ class ConnectionImpl {
                           const std::string& portal_name, std::uint32_t n_rows,
                           OptionalCommandControl statement_cmd_ctl);
 
+  void CopyInStart(const Query& query,
+                   OptionalCommandControl statement_cmd_ctl);
+  void CopyInPutData(std::string_view data);
+  ResultSet CopyInEnd(const char* error_message);
+
+  void CopyOutStart(const Query& query,
+                    OptionalCommandControl statement_cmd_ctl);
+  bool CopyOutGetData(std::string& data);
+
+  void StreamStart(const Query& query, const QueryParameters& params,
+                   OptionalCommandControl statement_cmd_ctl);
+  std::optional<ResultSet> StreamNextRow();
+
   void Listen(std::string_view channel, OptionalCommandControl);
   void Unlisten(std::string_view channel, OptionalCommandControl);
   Notification WaitNotify(engine::Deadline deadline);
@@ -121,6 +141,29 @@ class ConnectionImpl {
 
   struct ResetTransactionCommandControl;
 
+  // A COPY statement that is streaming data, spans several calls
+  struct CopyState {
+    Query query;
+    TimeoutDuration network_timeout{};
+    bool reenter_pipeline{false};
+  };
+
+  // A statement in the single row mode, spans several calls
+  struct StreamState {
+    Query query;
+    TimeoutDuration network_timeout{};
+    bool reenter_pipeline{false};
+    SteadyClock::time_point start_time{};
+    // The first row, the buffer categories of the rest are taken from it
+    std::optional<ResultSet> description{};
+  };
+
+  void ExecuteSequentially(const std::vector<PipelinedQuery*>& queries);
+
+  void StartCopy(const Query& query, OptionalCommandControl statement_cmd_ctl);
+  ResultSet WaitCopyResult(CopyState&& copy, engine::Deadline deadline);
+  void FinishStream(bool completed);
+
   void CheckBusy() const;
   void CheckDeadlineReached(const engine::Deadline& deadline);
   tracing::Span MakeQuerySpan(const Query& query,
@@ -176,7 +219,8 @@ class ConnectionImpl {
   ResultSet WaitResult(const std::string& statement, engine::Deadline deadline,
                        TimeoutDuration network_timeout, Counter& counter,
                        tracing::Span& span, tracing::ScopeTime& scope,
-                       const ResultSet* description_ptr);
+                       const ResultSet* description_ptr,
+                       bool pipeline_segment = false);
 
   void Cancel();
 
@@ -200,6 +244,10 @@ class ConnectionImpl {
   testsuite::PostgresControl testsuite_pg_ctl_;
   OptionalCommandControl transaction_cmd_ctl_;
   TimeoutDuration current_statement_timeout_{};
+  std::optional<CopyState> copy_;
+  std::optional<StreamState> stream_;
+  // Bounded by kMaxNewlyPreparedStatements
+  std::vector<PreparableStatement> newly_prepared_;
   const error_injection::Settings ei_settings_;
 
   std::unordered_set<std::string> statements_reported_;
@@ -0,0 +1,67 @@
+#include <storages/postgres/detail/hot_statements.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+HotStatements::HotStatements() : statements_{kMaxSize} {}
+
+void HotStatements::Account(std::vector<PreparableStatement>&& statements) {
+  const std::lock_guard lock{mutex_};
+  for (auto& statement : statements) {
+    auto key = MakeKey(statement);
+    auto* entry = statements_.Get(key);
+    if (!entry) entry = statements_.Emplace(key, Entry{std::move(statement)});
+    ++entry->rank;
+  }
+
+  accounted_since_decay_ += statements.size();
+  if (accounted_since_decay_ >= kMaxSize) {
+    accounted_since_decay_ = 0;
+    statements_.VisitAll([](const std::string&, Entry& entry) {
+      entry.rank /= 2;
+    });
+  }
+}
+
+std::vector<PreparableStatement> HotStatements::GetHottest(
+    std::size_t limit) const {
+  std::vector<const Entry*> entries;
+  std::vector<PreparableStatement> result;
+
+  const std::lock_guard lock{mutex_};
+  entries.reserve(statements_.GetSize());
+  statements_.VisitAll(
+      [&entries](const std::string&, const Entry& entry) {
+        entries.push_back(&entry);
+      });
+
+  limit = std::min(limit, entries.size());
+  std::partial_sort(entries.begin(), entries.begin() + limit, entries.end(),
+                    [](const Entry* lhs, const Entry* rhs) {
+                      return lhs->rank > rhs->rank;
+                    });
+  result.reserve(limit);
+  for (std::size_t i = 0; i < limit; ++i) {
+    result.push_back(entries[i]->statement);
+  }
+  return result;
+}
+
+std::string HotStatements::MakeKey(const PreparableStatement& statement) {
+  std::string key;
+  key.reserve(statement.statement.size() + 1 +
+              statement.param_types.size() * sizeof(Oid));
+  key.append(statement.statement);
+  key.push_back('\0');
+  key.append(reinterpret_cast<const char*>(statement.param_types.data()),
+             statement.param_types.size() * sizeof(Oid));
+  return key;
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/engine/mutex.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// @brief Statements prepared by the connections of a pool, ranked by how
+/// often they were prepared.
+///
+/// A statement is prepared once per connection, so the rank tells how many
+/// connections needed the statement recently. The ranks decay, so the
+/// statements that are no longer executed give way to the new ones.
+class HotStatements final {
+ public:
+  static constexpr std::size_t kMaxSize = 1000;
+
+  HotStatements();
+
+  HotStatements(const HotStatements&) = delete;
+  HotStatements& operator=(const HotStatements&) = delete;
+
+  void Account(std::vector<PreparableStatement>&& statements);
+
+  /// Returns up to `limit` statements, the most prepared ones first
+  std::vector<PreparableStatement> GetHottest(std::size_t limit) const;
+
+ private:
+  struct Entry {
+    PreparableStatement statement;
+    std::uint64_t rank{0};
+  };
+
+  static std::string MakeKey(const PreparableStatement& statement);
+
+  mutable engine::Mutex mutex_;
+  cache::LruMap<std::string, Entry> statements_;
+  std::size_t accounted_since_decay_{0};
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -464,14 +464,24 @@ bool PGConnectionWrapper::WaitSocketWriteable(Deadline deadline) {
   return socket_.WaitWriteable(deadline);
 }
 
+void PGConnectionWrapper::SendPipelineSync() {
+#if LIBPQ_HAS_PIPELINING
+  HandleSocketPostClose();
+  CheckError<CommandError>("PQpipelineSync", PQpipelineSync(conn_));
+  ++pipeline_sync_counter_;
+#else
+  UINVARIANT(false, "Pipeline mode is not supported");
+#endif
+}
+
 void PGConnectionWrapper::Flush(Deadline deadline) {
 #if LIBPQ_HAS_PIPELINING
-  if (PQpipelineStatus(conn_) != PQ_PIPELINE_OFF) {
-    HandleSocketPostClose();
-    CheckError<CommandError>("PQpipelineSync", PQpipelineSync(conn_));
-    ++pipeline_sync_counter_;
-  }
+  if (PQpipelineStatus(conn_) != PQ_PIPELINE_OFF) SendPipelineSync();
 #endif
+  FlushOutput(deadline);
+}
+
+void PGConnectionWrapper::FlushOutput(Deadline deadline) {
   while (const int flush_res = PQflush(conn_)) {
     if (flush_res < 0) {
       HandleSocketPostClose();
@@ -562,6 +572,70 @@ ResultSet PGConnectionWrapper::WaitResult(Deadline deadline,
   return MakeResult(std::move(handle));
 }
 
+ResultSet PGConnectionWrapper::WaitPipelineResult(Deadline deadline,
+                                                  tracing::ScopeTime& scope,
+                                                  const PGresult* description) {
+#if LIBPQ_HAS_PIPELINING
+  UASSERT(IsSyncingPipeline());
+  scope.Reset(scopes::kLibpqWaitResult);
+  auto handle = MakeResultHandle(nullptr);
+  try {
+    FlushOutput(deadline);
+    auto null_res_counter{0};
+    while (true) {
+      auto* pg_res = ReadResult(deadline, description);
+      if (!pg_res) {
+        // Results of a command are terminated with a nullptr, see the issue
+        // with the shutting down db in WaitResult
+        if (++null_res_counter > 2 || PQstatus(conn_) == CONNECTION_BAD) {
+          throw ConnectionError{"Pipeline segment was not finished"};
+        }
+        continue;
+      }
+      null_res_counter = 0;
+      auto next_handle = MakeResultHandle(pg_res);
+      const auto status = PQresultStatus(pg_res);
+      if (status == PGRES_PIPELINE_SYNC) {
+        HandlePipelineSync();
+        break;
+      }
+      if (status != PGRES_PIPELINE_ABORTED) handle = std::move(next_handle);
+    }
+  } catch (const std::exception&) {
+    // The rest of the segment would be taken for the next one's results
+    MarkAsBroken();
+    throw;
+  }
+  // Server errors are isolated within the segment
+  return MakeResult(std::move(handle));
+#else
+  UINVARIANT(false, "Pipeline mode is not supported");
+  return WaitResult(deadline, scope, description);
+#endif
+}
+
+ResultSet PGConnectionWrapper::WaitSingleRow(Deadline deadline) {
+  auto handle = MakeResultHandle(nullptr);
+  try {
+    FlushOutput(deadline);
+    handle = MakeResultHandle(ReadResult(deadline, nullptr));
+    if (handle && PQresultStatus(handle.get()) == PGRES_SINGLE_TUPLE) {
+      return ResultSet{
+          std::make_shared<detail::ResultWrapper>(std::move(handle))};
+    }
+    // The final result of the statement is followed by a nullptr
+    while (auto* pg_res = ReadResult(deadline, nullptr)) {
+      handle = MakeResultHandle(pg_res);
+    }
+  } catch (const std::exception&) {
+    // The rest of the rows would be taken for the results of the next
+    // statement
+    MarkAsBroken();
+    throw;
+  }
+  return MakeResult(std::move(handle));
+}
+
 Notification PGConnectionWrapper::WaitNotify(Deadline deadline) {
   auto notify = std::unique_ptr<PGnotify, decltype(&PQfreemem)>(
       PQnotifies(conn_), &PQfreemem);
@@ -580,6 +654,100 @@ Notification PGConnectionWrapper::WaitNotify(Deadline deadline) {
   return result;
 }
 
+void PGConnectionWrapper::WaitCopyStart(Deadline deadline,
+                                        tracing::ScopeTime& scope) {
+  scope.Reset(scopes::kLibpqWaitResult);
+  Flush(deadline);
+  auto handle = MakeResultHandle(nullptr);
+  while (auto* pg_res = ReadResult(deadline, nullptr)) {
+    const auto status = PQresultStatus(pg_res);
+    handle = MakeResultHandle(pg_res);
+    if (status == PGRES_COPY_IN || status == PGRES_COPY_OUT ||
+        status == PGRES_COPY_BOTH) {
+      return;
+    }
+  }
+  // Throws on errors
+  MakeResult(std::move(handle));
+  throw LogicError{"The statement does not start a COPY"};
+}
+
+void PGConnectionWrapper::PutCopyData(std::string_view data,
+                                      Deadline deadline) {
+  while (true) {
+    const auto res = PQputCopyData(conn_, data.data(), data.size());
+    if (res > 0) break;
+    if (res < 0) {
+      HandleSocketPostClose();
+      throw CommandError(PQerrorMessage(conn_));
+    }
+    // Output buffer is full in the non-blocking mode, retrying flushes it
+    if (!WaitSocketWriteable(deadline)) ThrowWaitSocketError("sending COPY");
+  }
+  Flush(deadline);
+  UpdateLastUse();
+}
+
+void PGConnectionWrapper::PutCopyEnd(const char* error_message,
+                                     Deadline deadline) {
+  while (true) {
+    const auto res = PQputCopyEnd(conn_, error_message);
+    if (res > 0) break;
+    if (res < 0) {
+      HandleSocketPostClose();
+      throw CommandError(PQerrorMessage(conn_));
+    }
+    if (!WaitSocketWriteable(deadline)) ThrowWaitSocketError("ending COPY");
+  }
+  UpdateLastUse();
+}
+
+bool PGConnectionWrapper::GetCopyData(std::string& data, Deadline deadline) {
+  const auto status = WaitCopyData(data, deadline);
+  if (status == CopyDataStatus::kTimeout) {
+    ThrowWaitSocketError("receiving COPY");
+  }
+  return status == CopyDataStatus::kData;
+}
+
+PGConnectionWrapper::CopyDataStatus PGConnectionWrapper::WaitCopyData(
+    std::string& data, Deadline deadline) {
+  // The input is consumed once before waiting, so the data that is already
+  // in the socket is read regardless of the deadline
+  bool is_input_consumed = false;
+  while (true) {
+    char* buffer = nullptr;
+    const auto size = PQgetCopyData(conn_, &buffer, /*async=*/1);
+    if (size > 0) {
+      const std::unique_ptr<char, decltype(&PQfreemem)> guard{buffer,
+                                                              &PQfreemem};
+      data.assign(buffer, size);
+      return CopyDataStatus::kData;
+    }
+    if (size == -1) return CopyDataStatus::kEnd;
+    if (size < -1) {
+      HandleSocketPostClose();
+      throw CommandError(PQerrorMessage(conn_));
+    }
+    if (is_input_consumed && !WaitSocketReadable(deadline)) {
+      return CopyDataStatus::kTimeout;
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+    is_input_consumed = true;
+    UpdateLastUse();
+  }
+}
+
+void PGConnectionWrapper::ThrowWaitSocketError(std::string_view operation) {
+  if (engine::current_task::ShouldCancel()) {
+    throw ConnectionInterrupted(
+        fmt::format("Task cancelled while {}", operation));
+  }
+  PGCW_LOG_LIMITED_WARNING() << "Timeout while " << operation
+                             << " on PostgreSQL connection socket";
+  throw ConnectionTimeoutError(fmt::format("Timed out while {}", operation));
+}
+
 void PGConnectionWrapper::DiscardInput(Deadline deadline) {
   Flush(deadline);
   auto handle = MakeResultHandle(nullptr);
@@ -638,15 +806,20 @@ ResultSet PGConnectionWrapper::MakeResult(ResultHandle&& handle) {
       break;
     case PGRES_SINGLE_TUPLE:
       PGCW_LOG_LIMITED_ERROR()
-          << "libpq was switched to SINGLE_ROW mode, this is not supported.";
-      CloseWithError(NotImplemented{"Single row mode is not supported"});
+          << "libpq was switched to SINGLE_ROW mode outside of a result "
+             "stream, this is not supported.";
+      CloseWithError(NotImplemented{
+          "Single row mode is supported only via Transaction::Stream"});
     case PGRES_COPY_IN:
     case PGRES_COPY_OUT:
     case PGRES_COPY_BOTH:
       PGCW_LOG_LIMITED_ERROR()
-          << "PostgreSQL COPY command invoked which is not implemented"
+          << "PostgreSQL COPY command invoked via Execute, use "
+             "Transaction::CopyFrom or Transaction::CopyTo instead"
           << logging::LogExtra::Stacktrace();
-      CloseWithError(NotImplemented{"Copy is not implemented"});
+      CloseWithError(NotImplemented{
+          "COPY is supported only via Transaction::CopyFrom and "
+          "Transaction::CopyTo"});
     case PGRES_BAD_RESPONSE:
       CloseWithError(ConnectionError{"Failed to parse server response"});
     case PGRES_NONFATAL_ERROR: {
@@ -735,6 +908,23 @@ void PGConnectionWrapper::SendQuery(const std::string& statement,
   UpdateLastUse();
 }
 
+void PGConnectionWrapper::SendSingleRowQuery(const std::string& statement,
+                                             const QueryParameters& params,
+                                             tracing::ScopeTime& scope) {
+  scope.Reset(scopes::kLibpqSendQueryParams);
+  CheckError<CommandError>(
+      "PQsendQueryParams",
+      PQsendQueryParams(conn_, statement.c_str(), params.Size(),
+                        params.ParamTypesBuffer(), params.ParamBuffers(),
+                        params.ParamLengthsBuffer(),
+                        params.ParamFormatsBuffer(), io::kPgBinaryDataFormat));
+  UpdateLastUse();
+  if (!PQsetSingleRowMode(conn_)) {
+    PGCW_LOG_LIMITED_ERROR() << "Failed to switch to the single row mode";
+    CloseWithError(ConnectionError{"Failed to switch to the single row mode"});
+  }
+}
+
 void PGConnectionWrapper::SendPrepare(const std::string& name,
                                       const std::string& statement,
                                       const QueryParameters& params,
@@ -28,6 +28,8 @@ class PGConnectionWrapper {
   using Duration = Deadline::TimePoint::clock::duration;
   using ResultHandle = detail::ResultWrapper::ResultHandle;
 
+  enum class CopyDataStatus { kData, kEnd, kTimeout };
+
   PGConnectionWrapper(engine::TaskProcessor& tp,
                       concurrent::BackgroundTaskStorageCore& bts, uint32_t id,
                       engine::SemaphoreLock&& pool_size_lock);
@@ -70,6 +72,11 @@ class PGConnectionWrapper {
   /// Check if pipeline mode is currently enabled
   bool IsPipelineActive() const;
 
+  /// @brief Wrapper for PQpipelineSync, ends a segment of the pipeline.
+  ///
+  /// An error in a segment aborts only the commands of the same segment.
+  void SendPipelineSync();
+
   /// @brief Close the connection on a background task processor.
   [[nodiscard]] engine::Task Close();
 
@@ -108,9 +115,52 @@ class PGConnectionWrapper {
   ResultSet WaitResult(Deadline deadline, tracing::ScopeTime&,
                        const PGresult* description);
 
+  /// @brief Wait for the result of a single pipeline segment
+  ///
+  /// Unlike WaitResult, the results of the next segments are left unread. The
+  /// connection is marked as broken if the segment could not be read entirely.
+  ResultSet WaitPipelineResult(Deadline deadline, tracing::ScopeTime&,
+                               const PGresult* description);
+
+  /// @brief Wrapper for PQsendQueryParams with the results in the binary
+  /// format followed by PQsetSingleRowMode, the rows of the statement are
+  /// returned one by one
+  void SendSingleRowQuery(const std::string& statement,
+                          const QueryParameters& params, tracing::ScopeTime&);
+
+  /// @brief Wait for the next row of a statement sent with SendSingleRowQuery
+  ///
+  /// Only the data of the next row is read from the socket. The final result
+  /// of the statement without rows is returned after the last row. The
+  /// connection is marked as broken if a row could not be read entirely.
+  ResultSet WaitSingleRow(Deadline deadline);
+
   /// @brief Wait for notification
   Notification WaitNotify(Deadline deadline);
 
+  /// @brief Wait for the server to enter the COPY IN, COPY OUT or COPY BOTH
+  /// state after a COPY or START_REPLICATION statement was sent
+  /// @throws LogicError if the statement does not start a COPY
+  void WaitCopyStart(Deadline deadline, tracing::ScopeTime&);
+
+  /// @brief Wrapper for PQputCopyData
+  void PutCopyData(std::string_view data, Deadline deadline);
+
+  /// @brief Wrapper for PQputCopyEnd, the result of the COPY statement should
+  /// be read with WaitResult then. A non-null error_message makes the server
+  /// abort the COPY.
+  void PutCopyEnd(const char* error_message, Deadline deadline);
+
+  /// @brief Wrapper for PQgetCopyData
+  /// @returns false if there is no more data, the result of the COPY
+  /// statement should be read with WaitResult then
+  bool GetCopyData(std::string& data, Deadline deadline);
+
+  /// @brief Wrapper for PQgetCopyData that does not throw on the deadline,
+  /// the data that is already received is returned even if the deadline is
+  /// passed
+  CopyDataStatus WaitCopyData(std::string& data, Deadline deadline);
+
   /// Consume input from connection
   void ConsumeInput(Deadline deadline, const PGresult* description);
 
@@ -156,7 +206,12 @@ class PGConnectionWrapper {
   /// @return true if wait was successful, false if was awakened by the deadline
   [[nodiscard]] bool WaitSocketReadable(Deadline deadline);
 
+  /// Ends the pipeline segment if the pipeline is active and flushes
   void Flush(Deadline deadline);
+  void FlushOutput(Deadline deadline);
+
+  /// @throws ConnectionInterrupted or ConnectionTimeoutError
+  [[noreturn]] void ThrowWaitSocketError(std::string_view operation);
 
   PGresult* ReadResult(Deadline deadline, const PGresult* description);
 
@@ -0,0 +1,182 @@
+#include <storages/postgres/detail/pgoutput.hpp>
+
+#include <fmt/format.h>
+
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+std::uint8_t ReplicationMessageReader::ReadByte() {
+  return ReadInt<std::uint8_t>();
+}
+
+std::uint16_t ReplicationMessageReader::ReadInt16() {
+  return ReadInt<std::uint16_t>();
+}
+
+std::uint32_t ReplicationMessageReader::ReadInt32() {
+  return ReadInt<std::uint32_t>();
+}
+
+std::uint64_t ReplicationMessageReader::ReadInt64() {
+  return ReadInt<std::uint64_t>();
+}
+
+std::string_view ReplicationMessageReader::ReadString() {
+  const auto end = message_.find('\0');
+  if (end == std::string_view::npos) {
+    throw ReplicationError{"Unterminated string in a replication message"};
+  }
+  const auto value = message_.substr(0, end);
+  message_.remove_prefix(end + 1);
+  return value;
+}
+
+std::string_view ReplicationMessageReader::ReadBytes(std::size_t size) {
+  if (size > message_.size()) {
+    throw ReplicationError{"Truncated replication message"};
+  }
+  const auto bytes = message_.substr(0, size);
+  message_.remove_prefix(size);
+  return bytes;
+}
+
+template <typename T>
+T ReplicationMessageReader::ReadInt() {
+  T value = 0;
+  for (const auto byte : ReadBytes(sizeof(T))) {
+    value = static_cast<T>((value << 8) | static_cast<std::uint8_t>(byte));
+  }
+  return value;
+}
+
+std::optional<ReplicationTransaction> PgOutputDecoder::Decode(
+    std::string_view message) {
+  ReplicationMessageReader reader{message};
+  const auto type = static_cast<char>(reader.ReadByte());
+  switch (type) {
+    case 'B':
+      if (transaction_) {
+        throw ReplicationError{"Nested transaction in the replication stream"};
+      }
+      transaction_.emplace();
+      // The final LSN, the commit timestamp and the xid
+      reader.Skip(8 + 8 + 4);
+      break;
+    case 'C': {
+      auto& transaction = GetTransaction();
+      // The flags and the LSN of the commit
+      reader.Skip(1 + 8);
+      transaction.end_lsn = reader.ReadInt64();
+      auto result = std::move(transaction);
+      transaction_.reset();
+      return result;
+    }
+    case 'R':
+      DecodeRelation(reader);
+      break;
+    case 'I':
+    case 'U':
+    case 'D':
+      DecodeChange(type, reader);
+      break;
+    case 'T':
+      DecodeTruncate(reader);
+      break;
+    case 'Y':  // Type
+    case 'O':  // Origin
+    case 'M':  // Logical decoding message
+      break;
+    default:
+      throw ReplicationError{
+          fmt::format("Unexpected pgoutput message type '{}'", type)};
+  }
+  return std::nullopt;
+}
+
+void PgOutputDecoder::DecodeRelation(ReplicationMessageReader& reader) {
+  auto relation = std::make_shared<ReplicationRelation>();
+  relation->id = reader.ReadInt32();
+  relation->schema = reader.ReadString();
+  relation->table = reader.ReadString();
+  // Replica identity setting
+  reader.Skip(1);
+  const auto column_count = reader.ReadInt16();
+  relation->columns.reserve(column_count);
+  for (std::uint16_t i = 0; i < column_count; ++i) {
+    // Flags
+    reader.Skip(1);
+    relation->columns.emplace_back(reader.ReadString());
+    // Type oid and modifier
+    reader.Skip(4 + 4);
+  }
+  // The changes that are already decoded keep the previous description
+  relations_[relation->id] = std::move(relation);
+}
+
+void PgOutputDecoder::DecodeChange(char type,
+                                   ReplicationMessageReader& reader) {
+  const Oid relation_id = reader.ReadInt32();
+  auto tuple_type = static_cast<char>(reader.ReadByte());
+
+  ReplicationTuple old_tuple;
+  if (type != 'I' && (tuple_type == 'K' || tuple_type == 'O')) {
+    reader.Skip(old_tuple.Parse(reader.GetRest()));
+    if (type == 'D') {
+      AddChange(ReplicationChange::Type::kDelete, relation_id).tuple =
+          std::move(old_tuple);
+      return;
+    }
+    tuple_type = static_cast<char>(reader.ReadByte());
+  }
+  if (type == 'D' || tuple_type != 'N') {
+    throw ReplicationError{
+        fmt::format("Unexpected tuple type '{}' in a pgoutput message '{}'",
+                    tuple_type, type)};
+  }
+
+  auto& change =
+      AddChange(type == 'I' ? ReplicationChange::Type::kInsert
+                            : ReplicationChange::Type::kUpdate,
+                relation_id);
+  reader.Skip(change.tuple.Parse(reader.GetRest()));
+  if (!old_tuple.IsEmpty() && change.tuple.HasUnchangedToast()) {
+    change.tuple.FillUnchanged(old_tuple);
+  }
+}
+
+void PgOutputDecoder::DecodeTruncate(ReplicationMessageReader& reader) {
+  const auto relation_count = reader.ReadInt32();
+  // Options
+  reader.Skip(1);
+  for (std::uint32_t i = 0; i < relation_count; ++i) {
+    AddChange(ReplicationChange::Type::kTruncate, reader.ReadInt32());
+  }
+}
+
+ReplicationChange& PgOutputDecoder::AddChange(ReplicationChange::Type type,
+                                              Oid relation_id) {
+  auto& transaction = GetTransaction();
+  const auto it = relations_.find(relation_id);
+  if (it == relations_.end()) {
+    throw ReplicationError{fmt::format(
+        "A change of the relation {} that was not described", relation_id)};
+  }
+  auto& change = transaction.changes.emplace_back();
+  change.type = type;
+  change.relation = it->second;
+  return change;
+}
+
+ReplicationTransaction& PgOutputDecoder::GetTransaction() {
+  if (!transaction_) {
+    throw ReplicationError{"A change outside of a transaction"};
+  }
+  return *transaction_;
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
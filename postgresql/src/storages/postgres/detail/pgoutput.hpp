@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+
+#include <userver/storages/postgres/replication.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// Reads the network byte order fields of the replication protocol messages
+class ReplicationMessageReader final {
+ public:
+  explicit ReplicationMessageReader(std::string_view message) noexcept
+      : message_(message) {}
+
+  std::uint8_t ReadByte();
+  std::uint16_t ReadInt16();
+  std::uint32_t ReadInt32();
+  std::uint64_t ReadInt64();
+
+  /// Reads a null-terminated string
+  std::string_view ReadString();
+
+  std::string_view ReadBytes(std::size_t size);
+
+  std::string_view GetRest() const noexcept { return message_; }
+
+  void Skip(std::size_t size) { ReadBytes(size); }
+
+ private:
+  template <typename T>
+  T ReadInt();
+
+  std::string_view message_;
+};
+
+/// Collects the messages of the `pgoutput` plugin of protocol version 1 into
+/// the committed transactions. The relations are remembered across the
+/// transactions, as the server describes each of them only once per stream.
+class PgOutputDecoder final {
+ public:
+  /// @returns the transaction if the message commits it
+  /// @throws ReplicationError on malformed or unexpected messages
+  std::optional<ReplicationTransaction> Decode(std::string_view message);
+
+  bool IsInTransaction() const noexcept { return transaction_.has_value(); }
+
+ private:
+  void DecodeRelation(ReplicationMessageReader& reader);
+  void DecodeChange(char type, ReplicationMessageReader& reader);
+  void DecodeTruncate(ReplicationMessageReader& reader);
+
+  ReplicationChange& AddChange(ReplicationChange::Type type, Oid relation_id);
+  ReplicationTransaction& GetTransaction();
+
+  std::unordered_map<Oid, std::shared_ptr<const ReplicationRelation>>
+      relations_;
+  std::optional<ReplicationTransaction> transaction_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -2,7 +2,9 @@
 
 #include <storages/postgres/deadline.hpp>
 #include <storages/postgres/detail/cc_config.hpp>
+#include <storages/postgres/detail/pg_connection_wrapper.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
+#include <storages/postgres/detail/tracing_tags.hpp>
 
 #include <userver/dynamic_config/value.hpp>
 #include <userver/engine/async.hpp>
@@ -44,6 +46,9 @@ constexpr auto kIdleDropLimit = 1;
 // Practically unlimited number on concurrent establishing connections
 constexpr auto kUnlimitedConnecting = std::numeric_limits<std::size_t>::max();
 
+// Weight of the previous statement latencies is 1 - 1/kLatencySmoothing
+constexpr std::int64_t kLatencySmoothing = 8;
+
 class Stopwatch {
  public:
   using Accumulator =
@@ -96,6 +101,7 @@ ConnectionPool::ConnectionPool(
                     {1, kCancelPeriod}},
       sts_{statement_metrics_settings},
       config_source_(config_source),
+      multiplexer_(*this),
       cc_sensor_(*this),
       cc_limiter_(*this),
       cc_controller_("postgres" + db_name, cc_sensor_, cc_limiter_,
@@ -255,6 +261,19 @@ void ConnectionPool::AccountConnectionStats(Connection::Statistics conn_stats) {
       std::chrono::duration_cast<std::chrono::milliseconds>(
           now - conn_stats.trx_end_time)
           .count());
+
+  if (conn_stats.execute_total > 0) {
+    const auto latency =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            conn_stats.sum_query_duration)
+            .count() /
+        conn_stats.execute_total;
+    // Races may lose a sample, that is fine for an estimate
+    auto average = statement_latency_us_.load(std::memory_order_relaxed);
+    average = average ? average + (latency - average) / kLatencySmoothing
+                      : std::max<std::int64_t>(latency, 1);
+    statement_latency_us_.store(average, std::memory_order_relaxed);
+  }
 }
 
 void ConnectionPool::Release(Connection* connection) {
@@ -268,6 +287,7 @@ void ConnectionPool::Release(Connection* connection) {
   if (!connection->IsInTransaction()) {
     connection_stats.emplace(connection->GetStatsAndReset());
   }
+  auto newly_prepared = connection->TakeNewlyPreparedStatements();
 
   if (!connection->IsConnected() || connection->IsBroken()) {
     DeleteBrokenConnection(connection);
@@ -290,6 +310,12 @@ void ConnectionPool::Release(Connection* connection) {
   if (connection_stats.has_value()) {
     AccountConnectionStats(std::move(*connection_stats));
   }
+  if (!newly_prepared.empty()) {
+    const auto settings = settings_.Read();
+    if (settings->prepare_on_connect > 0) {
+      hot_statements_.Account(std::move(newly_prepared));
+    }
+  }
 }
 
 const InstanceStatistics& ConnectionPool::GetStatistics() const {
@@ -301,6 +327,15 @@ const InstanceStatistics& ConnectionPool::GetStatistics() const {
   return stats_;
 }
 
+std::uint64_t ConnectionPool::GetLoad() const {
+  // No statements were executed yet, the clients decide
+  const std::uint64_t latency = std::max<std::int64_t>(
+      statement_latency_us_.load(std::memory_order_relaxed), 1);
+  const auto clients = stats_.connection.used.Load() +
+                       wait_count_.load(std::memory_order_relaxed);
+  return latency * (clients + 1);
+}
+
 Transaction ConnectionPool::Begin(const TransactionOptions& options,
                                   OptionalCommandControl trx_cmd_ctl) {
   const auto trx_start_time = detail::SteadyClock::now();
@@ -320,6 +355,57 @@ NonTransaction ConnectionPool::Start(OptionalCommandControl cmd_ctl) {
   return NonTransaction{std::move(conn), start_time};
 }
 
+ResultSet ConnectionPool::Execute(OptionalCommandControl cmd_ctl,
+                                  const Query& query,
+                                  const QueryParameters& params) {
+  std::size_t max_connections = 0;
+  std::size_t max_queries = 0;
+  {
+    const auto settings = settings_.Read();
+    const auto conn_settings = conn_settings_.Read();
+    // Statements of different tasks are pipelined only in pipeline mode
+    if (conn_settings->pipeline_mode == PipelineMode::kEnabled) {
+      max_connections = settings->multiplexed_connections;
+      max_queries = settings->max_multiplexed_queries;
+    }
+  }
+  if (max_connections == 0) {
+    auto ntrx = Start(cmd_ctl);
+    return ntrx.Execute(cmd_ctl, query, params);
+  }
+
+  const auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(cmd_ctl));
+  return multiplexer_.Execute(query, params, cmd_ctl, deadline,
+                              max_connections, max_queries);
+}
+
+void ConnectionPool::ExecuteBatch(std::vector<PipelinedQuery>& queries) {
+  std::vector<PipelinedQuery*> batch;
+  batch.reserve(queries.size());
+  engine::Deadline deadline;
+  for (auto& query : queries) {
+    query.deadline =
+        testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(query.cmd_ctl));
+    // A statement that runs out of time fails on its own
+    if (batch.empty() || deadline < query.deadline) deadline = query.deadline;
+    batch.push_back(&query);
+  }
+
+  auto connection = Acquire(deadline);
+  connection->Start(SteadyClock::now());
+  try {
+    connection->ExecutePipelined(batch);
+  } catch (const std::exception&) {
+    for (auto* query : batch) {
+      if (!query->result && !query->error) {
+        query->error = std::current_exception();
+      }
+    }
+  }
+  connection->Finish();
+}
+
 NotifyScope ConnectionPool::Listen(std::string_view channel,
                                    OptionalCommandControl cmd_ctl) {
   const auto deadline =
@@ -329,6 +415,24 @@ NotifyScope ConnectionPool::Listen(std::string_view channel,
   return NotifyScope{std::move(conn), channel, cmd_ctl};
 }
 
+ReplicationStream ConnectionPool::CreateReplicationStream(
+    ReplicationSettings settings, OptionalCommandControl cmd_ctl) {
+  const auto deadline =
+      testsuite_pg_ctl_.MakeExecuteDeadline(GetExecuteTimeout(cmd_ctl));
+  // The pool DSNs are in the key=value form, the latter value of a keyword
+  // takes precedence
+  Dsn dsn{dsn_.GetUnderlying() + " replication=database"};
+  if (resolver_) dsn = ResolveDsnHostaddrs(dsn, *resolver_, deadline);
+
+  auto conn = std::make_unique<PGConnectionWrapper>(
+      bg_task_processor_, close_task_storage_,
+      ++stats_.connection.open_total, engine::SemaphoreLock{});
+  tracing::Span span{scopes::kConnect};
+  auto scope = span.CreateScopeTime();
+  conn->AsyncConnect(dsn, deadline, scope);
+  return ReplicationStream{std::move(conn), std::move(settings), deadline};
+}
+
 TimeoutDuration ConnectionPool::GetExecuteTimeout(
     OptionalCommandControl cmd_ctl) const {
   if (cmd_ctl) return cmd_ctl->execute;
@@ -441,10 +545,34 @@ bool ConnectionPool::DoConnect(engine::SemaphoreLock size_lock) {
   // Clean up the statistics and not account it
   [[maybe_unused]] const auto& stats = connection->GetStatsAndReset();
 
+  if (!PrepareHotStatements(*connection)) {
+    ++stats_.connection.error_total;
+    DeleteConnection(connection.release());
+    return false;
+  }
+
   Push(connection.release());
   return true;
 }
 
+bool ConnectionPool::PrepareHotStatements(Connection& connection) {
+  const auto settings = settings_.Read();
+  if (settings->prepare_on_connect == 0) return true;
+
+  const auto statements =
+      hot_statements_.GetHottest(settings->prepare_on_connect);
+  if (statements.empty()) return true;
+  try {
+    connection.PrepareStatements(
+        statements, engine::Deadline::FromDuration(kConnectingTimeout));
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Failed to prepare statements on a new "
+                             "connection: "
+                          << e;
+  }
+  return connection.IsConnected() && !connection.IsBroken();
+}
+
 void ConnectionPool::TryCreateConnectionAsync() {
   auto conn_settings = conn_settings_.Read();
   // Checking errors is more expensive than incrementing an atomic, so we
@@ -471,6 +599,41 @@ void ConnectionPool::CheckMinPoolSizeUnderflow() {
   }
 }
 
+void ConnectionPool::UpdateSpareTarget() {
+  const auto settings = settings_.Read();
+  const auto demand = std::min(
+      peak_wait_count_.exchange(0, std::memory_order_relaxed),
+      settings->spare_size);
+  // Scale up at once but shrink gradually, so that a periodic burst of load
+  // finds the connections still open
+  if (demand >= spare_target_) {
+    spare_target_ = demand;
+  } else {
+    spare_target_ = demand + (spare_target_ - demand) / 2;
+  }
+}
+
+void ConnectionPool::CheckSpareConnections() {
+  if (spare_target_ == 0) return;
+  auto conn_settings = conn_settings_.Read();
+  if (recent_conn_errors_.GetStatsForPeriod(kRecentErrorPeriod, true) >=
+      conn_settings->recent_errors_threshold) {
+    return;
+  }
+
+  // Connections being established count as spare ones
+  const auto used = stats_.connection.used.Load();
+  const auto count = size_semaphore_.UsedApprox();
+  const auto spare = count > used ? count - used : 0;
+  for (auto i = spare; i < spare_target_; ++i) {
+    engine::SemaphoreLock size_lock{size_semaphore_, std::try_to_lock};
+    if (!size_lock) break;
+    LOG_DEBUG() << "Open a spare connection to `" << DsnCutPassword(dsn_)
+                << "`, " << spare_target_ << " spare connections expected";
+    connect_task_storage_.Detach(Connect(std::move(size_lock)));
+  }
+}
+
 void ConnectionPool::Push(Connection* connection) {
   // However unlikely, this could happen when we return connection after
   // asynchronous cleanup routine.
@@ -531,6 +694,13 @@ Connection* ConnectionPool::Pop(engine::Deadline deadline) {
     ++stats_.queue_size_errors;
     throw PoolError("Wait queue size exceeded");
   }
+  if (settings->spare_size) {
+    auto peak = peak_wait_count_.load(std::memory_order_relaxed);
+    while (peak < wg.GetValue() &&
+           !peak_wait_count_.compare_exchange_weak(peak, wg.GetValue(),
+                                                   std::memory_order_relaxed)) {
+    }
+  }
   // No connections found - create a new one if pool is not exhausted
   LOG_DEBUG() << "No idle connections, waiting for one for "
               << deadline.TimeLeft();
@@ -637,6 +807,8 @@ Connection* ConnectionPool::AcquireImmediate() {
 }
 
 void ConnectionPool::MaintainConnections() {
+  UpdateSpareTarget();
+
   // No point in doing database roundtrips if there are queries waiting for
   // connections
   if (wait_count_ > 0) {
@@ -661,7 +833,7 @@ void ConnectionPool::MaintainConnections() {
         break;
       }
       stale_connection = conn->GetIdleDuration() >= kMaxIdleDuration;
-      if (count > settings->min_size && drop_left > 0) {
+      if (count > settings->min_size + spare_target_ && drop_left > 0) {
         --drop_left;
         --stats_.connection.used;
         LOG_DEBUG() << "Drop idle connection to `" << DsnCutPassword(dsn_)
@@ -687,6 +859,7 @@ void ConnectionPool::MaintainConnections() {
 
   // Check and maintain minimum count of connections
   CheckMinPoolSizeUnderflow();
+  CheckSpareConnections();
 }
 
 void ConnectionPool::StartMaintainTask() {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -28,11 +29,14 @@
 #include <userver/storages/postgres/detail/non_transaction.hpp>
 #include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/replication.hpp>
 #include <userver/storages/postgres/statistics.hpp>
 #include <userver/storages/postgres/transaction.hpp>
 
 #include <storages/postgres/detail/connection.hpp>
+#include <storages/postgres/detail/hot_statements.hpp>
 #include <storages/postgres/detail/pg_impl_types.hpp>
+#include <storages/postgres/detail/query_multiplexer.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -72,14 +76,32 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   void Release(Connection* connection);
 
   const InstanceStatistics& GetStatistics() const;
+
+  /// Recent latency of a statement times the number of the clients using or
+  /// waiting for a connection, a pool with a lower load serves sooner
+  std::uint64_t GetLoad() const;
+
   [[nodiscard]] Transaction Begin(const TransactionOptions& options,
                                   OptionalCommandControl trx_cmd_ctl = {});
 
   [[nodiscard]] NonTransaction Start(OptionalCommandControl cmd_ctl = {});
 
+  /// Executes a single statement, pipelines it with the statements of other
+  /// tasks if multiplexing is enabled
+  ResultSet Execute(OptionalCommandControl cmd_ctl, const Query& query,
+                    const QueryParameters& params);
+
+  /// Executes independent single statements on one connection, the results
+  /// and the errors are stored in the queries
+  void ExecuteBatch(std::vector<PipelinedQuery>& queries);
+
   NotifyScope Listen(std::string_view channel,
                      OptionalCommandControl cmd_ctl = {});
 
+  /// Opens a separate replication connection to the host of the pool
+  ReplicationStream CreateReplicationStream(
+      ReplicationSettings settings, OptionalCommandControl cmd_ctl = {});
+
   CommandControl GetDefaultCommandControl() const;
 
   void SetSettings(const PoolSettings& settings);
@@ -105,9 +127,16 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
 
   [[nodiscard]] engine::TaskWithResult<bool> Connect(engine::SemaphoreLock);
   bool DoConnect(engine::SemaphoreLock);
+  /// Prepares the hottest statements of the pool on a new connection,
+  /// returns false if the connection is broken
+  bool PrepareHotStatements(Connection& connection);
 
   void TryCreateConnectionAsync();
   void CheckMinPoolSizeUnderflow();
+  /// Scales the number of idle connections kept ahead of demand by the peak
+  /// number of clients waited for a connection since the previous run
+  void UpdateSpareTarget();
+  void CheckSpareConnections();
 
   void Push(Connection* connection);
   Connection* Pop(engine::Deadline);
@@ -149,6 +178,11 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   engine::Semaphore size_semaphore_;
   engine::Semaphore connecting_semaphore_;
   std::atomic<size_t> wait_count_;
+  std::atomic<size_t> peak_wait_count_{0};
+  // Only accessed by the maintenance task
+  size_t spare_target_{0};
+  // Exponentially weighted moving average
+  std::atomic<std::int64_t> statement_latency_us_{0};
   DefaultCommandControls default_cmd_ctls_;
   testsuite::PostgresControl testsuite_pg_ctl_;
   const error_injection::Settings ei_settings_;
@@ -156,6 +190,8 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   USERVER_NAMESPACE::utils::TokenBucket cancel_limit_;
   detail::StatementTimingsStorage sts_;
   dynamic_config::Source config_source_;
+  QueryMultiplexer multiplexer_;
+  HotStatements hot_statements_;
 
   // Congestion control stuff
   cc::Sensor cc_sensor_;
@@ -0,0 +1,154 @@
+#include <storages/postgres/detail/query_multiplexer.hpp>
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include <userver/engine/task/cancel.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <storages/postgres/detail/pool.hpp>
+#include <storages/postgres/detail/tracing_tags.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+struct QueryMultiplexer::Request {
+  PipelinedQuery query;
+  engine::SingleConsumerEvent event{};
+  bool is_leader{false};
+};
+
+QueryMultiplexer::QueryMultiplexer(ConnectionPool& pool) : pool_{pool} {}
+
+ResultSet QueryMultiplexer::Execute(const Query& query,
+                                    const QueryParameters& params,
+                                    OptionalCommandControl cmd_ctl,
+                                    engine::Deadline deadline,
+                                    std::size_t max_connections,
+                                    std::size_t max_queries) {
+  UASSERT(max_connections > 0 && max_queries > 0);
+  tracing::Span span{scopes::kQuery};
+  query.FillSpanTags(span);
+
+  Request request{{query, params, cmd_ctl, deadline}};
+  {
+    const std::lock_guard lock{mutex_};
+    if (leaders_ < max_connections) {
+      ++leaders_;
+      request.is_leader = true;
+    } else {
+      pending_.push_back(&request);
+    }
+  }
+
+  try {
+    if (!request.is_leader) WaitForTurn(request);
+    if (request.is_leader) Lead(request, max_queries);
+  } catch (const std::exception&) {
+    span.AddTag(tracing::kErrorFlag, true);
+    throw;
+  }
+
+  if (request.query.error) {
+    span.AddTag(tracing::kErrorFlag, true);
+    std::rethrow_exception(request.query.error);
+  }
+  UASSERT(request.query.result);
+  return std::move(*request.query.result);
+}
+
+void QueryMultiplexer::WaitForTurn(Request& request) {
+  if (request.event.WaitForEventUntil(request.query.deadline)) return;
+
+  {
+    const std::lock_guard lock{mutex_};
+    const auto it = std::find(pending_.begin(), pending_.end(), &request);
+    if (it != pending_.end()) {
+      pending_.erase(it);
+      if (engine::current_task::ShouldCancel()) {
+        throw PoolError("Task was cancelled while waiting for a pipeline");
+      }
+      throw PoolError("Deadline reached while waiting for a pipeline");
+    }
+  }
+
+  // The statement is already sent by a leader, the deadline is respected
+  // there and the leader must not be left with a dangling request
+  const engine::TaskCancellationBlocker block_cancel;
+  [[maybe_unused]] const bool is_ready = request.event.WaitForEvent();
+  UASSERT(is_ready);
+}
+
+void QueryMultiplexer::Lead(Request& request, std::size_t max_queries) {
+  // The connection is returned to the pool after each batch to account its
+  // statistics, the next leader is likely to get it back right away
+  std::optional<ConnectionPtr> connection;
+  try {
+    connection.emplace(pool_.Acquire(request.query.deadline));
+  } catch (const std::exception&) {
+    request.query.error = std::current_exception();
+    HandOver();
+    return;
+  }
+
+  std::vector<Request*> followers;
+  {
+    const std::lock_guard lock{mutex_};
+    while (followers.size() + 1 < max_queries && !pending_.empty()) {
+      followers.push_back(pending_.front());
+      pending_.pop_front();
+    }
+  }
+
+  std::vector<PipelinedQuery*> batch;
+  batch.reserve(followers.size() + 1);
+  batch.push_back(&request.query);
+  for (auto* follower : followers) batch.push_back(&follower->query);
+
+  {
+    // The statements of other tasks must not fail because of this task
+    const engine::TaskCancellationBlocker block_cancel;
+    (*connection)->Start(SteadyClock::now());
+    try {
+      (*connection)->ExecutePipelined(batch);
+    } catch (const std::exception&) {
+      for (auto* query : batch) {
+        if (!query->result && !query->error) {
+          query->error = std::current_exception();
+        }
+      }
+    }
+    (*connection)->Finish();
+  }
+  connection.reset();
+
+  for (auto* follower : followers) follower->event.Send();
+  HandOver();
+}
+
+void QueryMultiplexer::HandOver() {
+  Request* next = nullptr;
+  {
+    const std::lock_guard lock{mutex_};
+    if (pending_.empty()) {
+      --leaders_;
+    } else {
+      next = pending_.front();
+      pending_.pop_front();
+    }
+  }
+  if (!next) return;
+
+  next->is_leader = true;
+  next->event.Send();
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
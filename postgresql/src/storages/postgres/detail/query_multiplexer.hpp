@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/storages/postgres/detail/connection_ptr.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+class ConnectionPool;
+
+/// @brief Pipelines single statements of concurrent callers on a limited
+/// number of connections.
+///
+/// A caller that finds a free connection slot becomes a leader: it acquires
+/// a connection, executes its own statement together with all the statements
+/// queued by then in one pipeline roundtrip and hands the leadership over to
+/// the first statement queued after that. Other callers just wait for their
+/// results, so the number of connections does not grow with the load.
+class QueryMultiplexer final {
+ public:
+  explicit QueryMultiplexer(ConnectionPool& pool);
+
+  QueryMultiplexer(const QueryMultiplexer&) = delete;
+  QueryMultiplexer& operator=(const QueryMultiplexer&) = delete;
+
+  /// @param max_connections number of connections used at once
+  /// @param max_queries number of statements in a pipeline roundtrip
+  ResultSet Execute(const Query& query, const QueryParameters& params,
+                    OptionalCommandControl cmd_ctl, engine::Deadline deadline,
+                    std::size_t max_connections, std::size_t max_queries);
+
+ private:
+  struct Request;
+
+  void WaitForTurn(Request& request);
+  void Lead(Request& request, std::size_t max_queries);
+  void HandOver();
+
+  ConnectionPool& pool_;
+
+  engine::Mutex mutex_;
+  std::deque<Request*> pending_;
+  std::size_t leaders_{0};
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
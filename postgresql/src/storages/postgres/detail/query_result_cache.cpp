@@ -0,0 +1,133 @@
+#include <storages/postgres/detail/query_result_cache.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+namespace {
+
+template <typename T>
+void AppendRaw(std::string& key, const T& value) {
+  key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+}  // namespace
+
+QueryResultCache::QueryResultCache(const QueryCacheSettings& settings)
+    : ttl_{settings.ttl},
+      entries_{std::max<std::size_t>(settings.ways, 1),
+               std::max<std::size_t>(
+                   settings.max_size / std::max<std::size_t>(settings.ways, 1),
+                   1)} {
+  UASSERT(settings.max_size > 0);
+}
+
+void QueryResultCache::Invalidate(std::string_view table) {
+  ++invalidations_;
+  const std::lock_guard lock{mutex_};
+  auto* version =
+      USERVER_NAMESPACE::utils::impl::FindTransparentOrNullptr(table_versions_,
+                                                                table);
+  // No cached result reads the table otherwise
+  if (version) ++*version;
+}
+
+void QueryResultCache::InvalidateAll() {
+  ++invalidations_;
+  ++generation_;
+}
+
+QueryCacheStatistics QueryResultCache::GetStatistics() const {
+  QueryCacheStatistics stats;
+  stats.total.hits = total_.hits.load();
+  stats.total.misses = total_.misses.load();
+  stats.size = entries_.GetSize();
+  stats.invalidations = invalidations_.load();
+
+  const std::lock_guard lock{mutex_};
+  stats.queries.reserve(query_counters_.size());
+  for (const auto& [name, counters] : query_counters_) {
+    stats.queries.emplace(
+        name, QueryCacheCounters{counters.hits.load(), counters.misses.load()});
+  }
+  return stats;
+}
+
+std::string QueryResultCache::MakeKey(const Query& query,
+                                      const QueryParameters& params) {
+  const auto& name = query.GetName();
+  const auto& id = name ? name->GetUnderlying() : query.Statement();
+
+  std::size_t size = id.size() + 2;
+  for (std::size_t i = 0; i < params.Size(); ++i) {
+    size += sizeof(Oid) + sizeof(int) +
+            std::max(params.ParamLengthsBuffer()[i], 0);
+  }
+
+  std::string key;
+  key.reserve(size);
+  key.push_back(name ? 'n' : 's');
+  key.append(id);
+  key.push_back('\0');
+  for (std::size_t i = 0; i < params.Size(); ++i) {
+    const auto* value = params.ParamBuffers()[i];
+    const int length = value ? params.ParamLengthsBuffer()[i] : -1;
+    AppendRaw(key, params.ParamTypesBuffer()[i]);
+    AppendRaw(key, length);
+    if (length > 0) key.append(value, length);
+  }
+  return key;
+}
+
+std::optional<ResultSet> QueryResultCache::Get(const std::string& key) {
+  const auto entry = entries_.Get(
+      key, [this](const EntryPtr& entry) { return IsValid(*entry); });
+  if (!entry) return std::nullopt;
+
+  ++total_.hits;
+  if ((*entry)->counters) ++(*entry)->counters->hits;
+  return (*entry)->result;
+}
+
+QueryResultCache::Entry QueryResultCache::MakeEntry(
+    const Query& query, const std::vector<std::string>& tables) {
+  // The TTL counts from the start of the statement
+  Entry entry{ResultSet{nullptr}, Clock::now() + ttl_, generation_.load(), {},
+              nullptr};
+  entry.table_versions.reserve(tables.size());
+  ++total_.misses;
+
+  const std::lock_guard lock{mutex_};
+  for (const auto& table : tables) {
+    const auto& version = table_versions_[table];
+    entry.table_versions.emplace_back(&version, version.load());
+  }
+  if (const auto& name = query.GetName()) {
+    entry.counters = &query_counters_[name->GetUnderlying()];
+    ++entry.counters->misses;
+  }
+  return entry;
+}
+
+void QueryResultCache::Put(const std::string& key, Entry&& entry) {
+  entries_.Put(key, std::make_shared<const Entry>(std::move(entry)));
+}
+
+bool QueryResultCache::IsValid(const Entry& entry) const {
+  if (Clock::now() >= entry.expiration) return false;
+  if (entry.generation != generation_.load()) return false;
+  return std::all_of(entry.table_versions.begin(), entry.table_versions.end(),
+                     [](const auto& table_version) {
+                       return table_version.first->load() ==
+                              table_version.second;
+                     });
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
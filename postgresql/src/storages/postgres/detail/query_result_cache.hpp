@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+#include <userver/storages/postgres/statistics.hpp>
+#include <userver/utils/impl/transparent_hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// @brief Results of read-only statements keyed by the query and the
+/// arguments.
+///
+/// A result is valid until its TTL expires or one of the tables the statement
+/// reads is invalidated. The versions of the tables are taken before the
+/// statement is executed, so a result of a statement that raced with an
+/// invalidation is never served.
+class QueryResultCache final {
+ public:
+  explicit QueryResultCache(const QueryCacheSettings& settings);
+
+  QueryResultCache(const QueryResultCache&) = delete;
+  QueryResultCache& operator=(const QueryResultCache&) = delete;
+
+  /// Returns a valid cached result or the result of `fetch`, which is cached
+  template <typename Fetch>
+  ResultSet GetOrFetch(const Query& query,
+                       const std::vector<std::string>& tables,
+                       const QueryParameters& params, Fetch&& fetch);
+
+  /// Drops the results of the statements that read the table
+  void Invalidate(std::string_view table);
+
+  /// Drops all the results
+  void InvalidateAll();
+
+  QueryCacheStatistics GetStatistics() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+  using Version = std::atomic<std::uint64_t>;
+
+  struct Counters {
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+  };
+
+  struct Entry {
+    ResultSet result;
+    Clock::time_point expiration;
+    std::uint64_t generation;
+    std::vector<std::pair<const Version*, std::uint64_t>> table_versions;
+    Counters* counters;
+  };
+
+  using EntryPtr = std::shared_ptr<const Entry>;
+
+  static std::string MakeKey(const Query& query,
+                             const QueryParameters& params);
+
+  std::optional<ResultSet> Get(const std::string& key);
+  /// Accounts a miss and takes the versions of the tables
+  Entry MakeEntry(const Query& query, const std::vector<std::string>& tables);
+  void Put(const std::string& key, Entry&& entry);
+  bool IsValid(const Entry& entry) const;
+
+  const std::chrono::milliseconds ttl_;
+  cache::NWayLRU<std::string, EntryPtr> entries_;
+
+  Counters total_;
+  std::atomic<std::uint64_t> generation_{0};
+  std::atomic<std::uint64_t> invalidations_{0};
+
+  // The versions and the counters are never removed, the entries point to
+  // them
+  mutable engine::Mutex mutex_;
+  USERVER_NAMESPACE::utils::impl::TransparentMap<std::string, Version>
+      table_versions_;
+  std::unordered_map<std::string, Counters> query_counters_;
+};
+
+template <typename Fetch>
+ResultSet QueryResultCache::GetOrFetch(const Query& query,
+                                       const std::vector<std::string>& tables,
+                                       const QueryParameters& params,
+                                       Fetch&& fetch) {
+  auto key = MakeKey(query, params);
+  if (auto result = Get(key)) return *std::move(result);
+
+  auto entry = MakeEntry(query, tables);
+  entry.result = std::forward<Fetch>(fetch)();
+  auto result = entry.result;
+  Put(key, std::move(entry));
+  return result;
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
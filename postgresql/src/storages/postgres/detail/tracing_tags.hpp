@@ -14,6 +14,12 @@ const std::string kConnect = "pg_connect";
 const std::string kGetConnectData = "pg_get_conn_data";
 /// Execute query, top driver level
 const std::string kQuery = "pg_query";
+/// Execute a batch of pipelined queries, top driver level
+const std::string kPipeline = "pg_pipeline";
+/// Create or start a logical replication stream, top driver level
+const std::string kReplication = "pg_replication";
+/// Prepare the statements of other connections after connecting
+const std::string kPrepareStatements = "pg_prepare_statements";
 /// Prepare query, driver level
 const std::string kPrepare = "pg_prepare";
 /// Bind portal, driver level
@@ -36,8 +36,10 @@ DistLockComponentBase::DistLockComponentBase(
       component_config["restart-delay"].As<std::chrono::milliseconds>(
           settings.worker_func_restart_delay);
 
-  auto strategy = std::make_shared<DistLockStrategy>(std::move(cluster), table,
-                                                     lock_name, settings);
+  DistLockStrategyOptions options;
+  options.fencing_tokens = component_config["fencing-tokens"].As<bool>(false);
+  auto strategy = std::make_shared<DistLockStrategy>(
+      std::move(cluster), table, lock_name, settings, options);
 
   auto task_processor_name =
       component_config["task-processor"].As<std::optional<std::string>>();
@@ -130,6 +132,10 @@ properties:
         type: boolean
         description: Enable testsuite support
         defaultDescription: false
+    fencing-tokens:
+        type: boolean
+        description: maintain the fencing tokens of the lock in the fencing_token column of the table
+        defaultDescription: false
 )");
 }
 
@@ -3,6 +3,9 @@
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
+#include <unordered_map>
+#include <vector>
+
 #include <userver/hostinfo/blocking/get_hostname.hpp>
 #include <userver/storages/postgres/cluster.hpp>
 
@@ -27,6 +30,56 @@ std::string MakeAcquireQuery(const std::string& table) {
   return fmt::format(FMT_COMPILE(kAcquireQueryFmt), table);
 }
 
+// key - $1
+// owner - $2
+// timeout in seconds - $3
+std::string MakeFencedAcquireQuery(const std::string& table) {
+  static constexpr auto kAcquireQueryFmt = R"(
+    INSERT INTO {} AS t (key, owner, expiration_time, fencing_token) VALUES
+    ($1, $2, current_timestamp + make_interval(secs => $3), 1)
+    ON CONFLICT (key) DO UPDATE
+    SET owner = $2, expiration_time = current_timestamp + make_interval(secs => $3),
+    fencing_token = CASE WHEN t.owner = $2 THEN t.fencing_token
+                         ELSE t.fencing_token + 1 END
+    WHERE (t.owner = $2) OR
+    (t.expiration_time <= current_timestamp) RETURNING t.fencing_token;
+)";
+  return fmt::format(FMT_COMPILE(kAcquireQueryFmt), table);
+}
+
+// keys - $1
+// owners - $2
+// timeouts in seconds - $3
+std::string MakeBatchAcquireQuery(const std::string& table,
+                                  bool fencing_tokens) {
+  static constexpr auto kAcquireQueryFmt = R"(
+    INSERT INTO {} AS t (key, owner, expiration_time)
+    SELECT r.key, r.owner, current_timestamp + make_interval(secs => r.timeout)
+    FROM UNNEST($1::TEXT[], $2::TEXT[], $3::DOUBLE PRECISION[])
+    AS r(key, owner, timeout)
+    ON CONFLICT (key) DO UPDATE
+    SET owner = EXCLUDED.owner, expiration_time = EXCLUDED.expiration_time
+    WHERE (t.owner = EXCLUDED.owner) OR
+    (t.expiration_time <= current_timestamp) RETURNING t.key;
+)";
+  static constexpr auto kFencedAcquireQueryFmt = R"(
+    INSERT INTO {} AS t (key, owner, expiration_time, fencing_token)
+    SELECT r.key, r.owner,
+    current_timestamp + make_interval(secs => r.timeout), 1
+    FROM UNNEST($1::TEXT[], $2::TEXT[], $3::DOUBLE PRECISION[])
+    AS r(key, owner, timeout)
+    ON CONFLICT (key) DO UPDATE
+    SET owner = EXCLUDED.owner, expiration_time = EXCLUDED.expiration_time,
+    fencing_token = CASE WHEN t.owner = EXCLUDED.owner THEN t.fencing_token
+                         ELSE t.fencing_token + 1 END
+    WHERE (t.owner = EXCLUDED.owner) OR
+    (t.expiration_time <= current_timestamp) RETURNING t.key, t.fencing_token;
+)";
+  return fencing_tokens
+             ? fmt::format(FMT_COMPILE(kFencedAcquireQueryFmt), table)
+             : fmt::format(FMT_COMPILE(kAcquireQueryFmt), table);
+}
+
 // key - $1
 // owner - $2
 std::string MakeReleaseQuery(const std::string& table) {
@@ -39,6 +92,24 @@ std::string MakeReleaseQuery(const std::string& table) {
   return fmt::format(FMT_COMPILE(kReleaseQueryFmt), table);
 }
 
+// key - $1
+// owner - $2
+std::string MakeFencedReleaseQuery(const std::string& table) {
+  // The row keeps the fencing token for the next holders
+  static constexpr auto kReleaseQueryFmt = R"(
+    UPDATE {}
+    SET expiration_time = current_timestamp
+    WHERE key = $1
+    AND owner = $2
+    RETURNING 1;
+)";
+  return fmt::format(FMT_COMPILE(kReleaseQueryFmt), table);
+}
+
+double ToSeconds(std::chrono::milliseconds lock_ttl) {
+  return lock_ttl.count() / 1000.0;
+}
+
 std::string MakeOwnerId(const std::string& prefix, const std::string& locker) {
   return fmt::format(FMT_COMPILE("{}:{}"), prefix, locker);
 }
@@ -48,12 +119,74 @@ std::string MakeOwnerId(const std::string& prefix, const std::string& locker) {
 DistLockStrategy::DistLockStrategy(ClusterPtr cluster, const std::string& table,
                                    const std::string& lock_name,
                                    const dist_lock::DistLockSettings& settings)
+    : DistLockStrategy(std::move(cluster), table, lock_name, settings, {}) {}
+
+DistLockStrategy::DistLockStrategy(ClusterPtr cluster, const std::string& table,
+                                   const std::string& lock_name,
+                                   const dist_lock::DistLockSettings& settings,
+                                   const DistLockStrategyOptions& options)
     : cluster_(std::move(cluster)),
       cc_(settings.forced_stop_margin, settings.forced_stop_margin),
-      acquire_query_(MakeAcquireQuery(table)),
-      release_query_(MakeReleaseQuery(table)),
+      acquire_query_(options.fencing_tokens ? MakeFencedAcquireQuery(table)
+                                            : MakeAcquireQuery(table)),
+      release_query_(options.fencing_tokens ? MakeFencedReleaseQuery(table)
+                                            : MakeReleaseQuery(table)),
       lock_name_(lock_name),
-      owner_prefix_(hostinfo::blocking::GetRealHostName()) {}
+      owner_prefix_(hostinfo::blocking::GetRealHostName()),
+      fencing_tokens_(options.fencing_tokens),
+      batcher_(options.batcher) {}
+
+std::shared_ptr<dist_lock::AcquireBatcher> DistLockStrategy::MakeBatcher(
+    ClusterPtr cluster, const std::string& table,
+    const dist_lock::DistLockSettings& settings, bool fencing_tokens,
+    const dist_lock::AcquireBatcherSettings& batcher_settings) {
+  const CommandControl cc{settings.forced_stop_margin,
+                          settings.forced_stop_margin};
+  auto batch_func =
+      [cluster = std::move(cluster), cc, fencing_tokens,
+       query = MakeBatchAcquireQuery(table, fencing_tokens)](
+          const std::vector<dist_lock::AcquireBatcher::Request>& requests) {
+        std::vector<std::string> keys;
+        std::vector<std::string> owners;
+        std::vector<double> timeouts;
+        keys.reserve(requests.size());
+        owners.reserve(requests.size());
+        timeouts.reserve(requests.size());
+        for (const auto& request : requests) {
+          keys.push_back(request.key);
+          owners.push_back(request.owner);
+          timeouts.push_back(ToSeconds(request.lock_ttl));
+        }
+
+        const auto result = cluster->Execute(ClusterHostType::kMaster, cc,
+                                             query, keys, owners, timeouts);
+
+        // Keys are unique within a batch
+        std::unordered_map<std::string, std::optional<dist_lock::FencingToken>>
+            acquired;
+        for (const auto& row : result) {
+          std::optional<dist_lock::FencingToken> token;
+          if (fencing_tokens) {
+            token = row["fencing_token"].As<dist_lock::FencingToken>();
+          }
+          acquired.emplace(row["key"].As<std::string>(), token);
+        }
+
+        std::vector<dist_lock::AcquireBatcher::Result> results;
+        results.reserve(requests.size());
+        for (const auto& request : requests) {
+          const auto it = acquired.find(request.key);
+          if (it == acquired.end()) {
+            results.push_back({false, std::nullopt});
+          } else {
+            results.push_back({true, it->second});
+          }
+        }
+        return results;
+      };
+  return std::make_shared<dist_lock::AcquireBatcher>(std::move(batch_func),
+                                                     batcher_settings);
+}
 
 void DistLockStrategy::UpdateCommandControl(CommandControl cc) {
   auto cc_ptr = cc_.StartWrite();
@@ -63,13 +196,25 @@ void DistLockStrategy::UpdateCommandControl(CommandControl cc) {
 
 void DistLockStrategy::Acquire(std::chrono::milliseconds lock_ttl,
                                const std::string& locker_id) {
-  double timeout_seconds = lock_ttl.count() / 1000.0;
+  AcquireWithFencingToken(lock_ttl, locker_id);
+}
+
+std::optional<dist_lock::FencingToken>
+DistLockStrategy::AcquireWithFencingToken(std::chrono::milliseconds lock_ttl,
+                                          const std::string& locker_id) {
+  auto owner = MakeOwnerId(owner_prefix_, locker_id);
+  if (batcher_) {
+    return batcher_->Acquire({lock_name_, std::move(owner), lock_ttl});
+  }
+
   auto cc_ptr = cc_.Read();
-  auto result = cluster_->Execute(
-      ClusterHostType::kMaster, *cc_ptr, acquire_query_, lock_name_,
-      MakeOwnerId(owner_prefix_, locker_id), timeout_seconds);
+  auto result =
+      cluster_->Execute(ClusterHostType::kMaster, *cc_ptr, acquire_query_,
+                        lock_name_, owner, ToSeconds(lock_ttl));
 
   if (result.IsEmpty()) throw dist_lock::LockIsAcquiredByAnotherHostException();
+  if (!fencing_tokens_) return std::nullopt;
+  return result.AsSingleRow<dist_lock::FencingToken>();
 }
 
 void DistLockStrategy::Release(const std::string& locker_id) {
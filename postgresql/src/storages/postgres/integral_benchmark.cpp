@@ -1,8 +1,14 @@
 #include <benchmark/benchmark.h>
 
 #include <limits>
+#include <numeric>
+#include <vector>
 
 #include <storages/postgres/detail/connection.hpp>
+#include <storages/postgres/tests/test_buffers.hpp>
+#include <userver/storages/postgres/io/array_types.hpp>
+#include <userver/storages/postgres/io/floating_point_types.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
 
 #include <storages/postgres/util_benchmark.hpp>
 
@@ -13,6 +19,48 @@ namespace {
 namespace pg = storages::postgres;
 using namespace pg::bench;
 
+const pg::UserTypes types;
+const pg::io::TypeBufferCategory categories;
+
+template <typename T>
+std::vector<T> MakeArray(benchmark::State& state) {
+  std::vector<T> array(state.range(0));
+  std::iota(array.begin(), array.end(), T{1});
+  return array;
+}
+
+template <typename T>
+void PgArrayBinaryFormat(benchmark::State& state) {
+  const auto array = MakeArray<T>(state);
+  pg::test::Buffer buffer;
+  for (auto _ : state) {
+    pg::io::WriteBuffer(types, buffer, array);
+    buffer.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * array.size());
+}
+
+template <typename T>
+void PgArrayBinaryParse(benchmark::State& state) {
+  auto array = MakeArray<T>(state);
+  pg::test::Buffer buffer;
+  pg::io::WriteBuffer(types, buffer, array);
+  const auto fb =
+      pg::test::MakeFieldBuffer(buffer, pg::io::BufferCategory::kArrayBuffer);
+  for (auto _ : state) {
+    pg::io::ReadBuffer(fb, array, categories);
+    benchmark::DoNotOptimize(array);
+  }
+  state.SetItemsProcessed(state.iterations() * array.size());
+}
+
+BENCHMARK_TEMPLATE(PgArrayBinaryFormat, std::int32_t)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(PgArrayBinaryFormat, std::int64_t)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(PgArrayBinaryFormat, double)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(PgArrayBinaryParse, std::int32_t)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(PgArrayBinaryParse, std::int64_t)->Range(8, 8 << 10);
+BENCHMARK_TEMPLATE(PgArrayBinaryParse, double)->Range(8, 8 << 10);
+
 BENCHMARK_F(PgConnection, BoolRoundtrip)(benchmark::State& state) {
   RunStandalone(state, [this, &state] {
     bool v = true;
@@ -53,6 +101,17 @@ BENCHMARK_F(PgConnection, Int64Roundtrip)(benchmark::State& state) {
   });
 }
 
+BENCHMARK_F(PgConnection, Int64ArrayRoundtrip)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    std::vector<std::int64_t> v(1024);
+    std::iota(v.begin(), v.end(), 1);
+    for (auto _ : state) {
+      auto res = GetConnection().Execute("select $1", v);
+      res.Front().To(v);
+    }
+  });
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
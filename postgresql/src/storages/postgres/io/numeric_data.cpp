@@ -105,27 +105,10 @@ void ConvertDecimalToBinary(std::string_view dec_digits, int left_padding,
   }
 }
 
-/// Calculate number of decimal digits
-int Log10(std::int64_t number) {
-  for (auto p = 0U; p < kMaxPowerOfTen; ++p) {
-    if (number < kPowersOfTen[p]) {
-      return p;
-    }
-  }
-  return kMaxPowerOfTen;
-}
-
-void IntegralToBinary(std::int64_t integral_part, Smallint digits,
-                      std::vector<std::int16_t>& target) {
-  // Left pad
-  if (digits % kDigitWidth) {
-    digits += kDigitWidth - digits % kDigitWidth;
-  }
-  while (digits > 0) {
-    digits -= kDigitWidth;
-    target.push_back(integral_part / kPowersOfTen[digits]);
-    integral_part %= kPowersOfTen[digits];
-  }
+char* WriteBinDigit(char* out, std::uint16_t value) noexcept {
+  *out++ = static_cast<char>(value >> 8);
+  *out++ = static_cast<char>(value & 0xff);
+  return out;
 }
 
 /// @brief Class for reading/writing binary numeric data from/to PostgreSQL
@@ -179,8 +162,6 @@ struct NumericData {
   void Parse(const std::string&);
   // Output to string
   [[nodiscard]] std::string ToString() const;
-  // Create buffer representation from an int64 value representation
-  void FromInt64(IntegralRepresentation);
   // Output to int64 value
   [[nodiscard]] IntegralRepresentation ToInt64() const;
 };
@@ -429,63 +410,6 @@ IntegralRepresentation NumericData::ToInt64() const {
   return rep;
 }
 
-void NumericData::FromInt64(IntegralRepresentation rep) {
-  if (rep.fractional_digit_count < 0 ||
-      static_cast<std::int64_t>(kMaxPowerOfTen) < rep.fractional_digit_count) {
-    throw InvalidRepresentation{
-        "Number of digits after decimal point is invalid " +
-        std::to_string(rep.fractional_digit_count)};
-  }
-  if (rep.value == 0) return;
-
-  sign = rep.value < 0 ? kNumericNegative : kNumericPositive;
-  std::uint64_t abs_value = std::abs(rep.value);
-  std::int64_t integral_part =
-      abs_value / kPowersOfTen[rep.fractional_digit_count];
-  std::int64_t fractional_part =
-      abs_value % kPowersOfTen[rep.fractional_digit_count];
-
-  auto integral_digits = Log10(integral_part);
-  auto fractional_digits = rep.fractional_digit_count;
-
-  // Remove trailing zeros, but keeping the digit number divisible by binary
-  // digit width
-  while (fractional_part && fractional_part % 10 == 0 &&
-         fractional_digits % kDigitWidth != 0) {
-    fractional_part /= 10;
-    --fractional_digits;
-  }
-  // Here are the actual fractional digits
-  dscale = fractional_digits;
-  // Right pad fractional part to 4 digits boundary
-  if (fractional_digits % kDigitWidth) {
-    auto right_pad = kDigitWidth - (fractional_digits % kDigitWidth);
-    fractional_digits += right_pad;
-    fractional_part *= kPowersOfTen[right_pad];
-  }
-
-  std::int32_t dec_weight = integral_digits - 1;
-  if (integral_part == 0) {
-    dec_weight = Log10(fractional_part) - fractional_digits - 1;
-  }
-
-  // Convert to binary digits
-  digits.reserve((integral_digits + fractional_digits) / kDigitWidth + 1);
-  if (dec_weight >= 0) {
-    weight = dec_weight / kDigitWidth;
-  } else {
-    weight = -((-dec_weight - 1) / kDigitWidth + 1);
-  }
-  if (weight >= 0) {
-    IntegralToBinary(integral_part, integral_digits, digits);
-  }
-  IntegralToBinary(fractional_part, fractional_digits, digits);
-
-  // Trim zero binary digits
-  boost::trim_if(digits, [](auto c) { return c == 0; });
-  ndigits = digits.size();
-}
-
 }  // namespace
 
 std::string NumericBufferToString(const FieldBuffer& buffer) {
@@ -507,9 +431,94 @@ IntegralRepresentation NumericBufferToInt64(const FieldBuffer& buffer) {
 }
 
 std::string Int64ToNumericBuffer(const IntegralRepresentation& rep) {
-  NumericData num_data;
-  num_data.FromInt64(rep);
-  return num_data.GetBuffer();
+  std::array<char, kMaxInt64NumericBufferSize> buffer;
+  const auto size = WriteInt64NumericBuffer(rep, buffer);
+  return std::string(buffer.data(), size);
+}
+
+std::size_t WriteInt64NumericBuffer(
+    const IntegralRepresentation& rep,
+    std::array<char, kMaxInt64NumericBufferSize>& buffer) {
+  if (rep.fractional_digit_count < 0 ||
+      static_cast<std::int64_t>(kMaxPowerOfTen) < rep.fractional_digit_count) {
+    throw InvalidRepresentation{
+        "Number of digits after decimal point is invalid " +
+        std::to_string(rep.fractional_digit_count)};
+  }
+
+  std::uint16_t sign = kNumericPositive;
+  Smallint weight = 0;
+  std::uint16_t dscale = 0;
+  // Up to 5 binary digits for each of integral and fractional parts
+  std::array<std::int16_t, 10> digits{};
+  std::size_t first = 0;
+  std::size_t last = 0;
+
+  if (rep.value != 0) {
+    sign = rep.value < 0 ? kNumericNegative : kNumericPositive;
+    // Negation in unsigned arithmetic, to handle the min int64 value
+    const std::uint64_t abs_value =
+        rep.value < 0 ? -static_cast<std::uint64_t>(rep.value)
+                      : static_cast<std::uint64_t>(rep.value);
+    std::uint64_t integral_part =
+        abs_value / kPowersOfTen[rep.fractional_digit_count];
+    std::uint64_t fractional_part =
+        abs_value % kPowersOfTen[rep.fractional_digit_count];
+    auto fractional_digits = rep.fractional_digit_count;
+
+    // Remove trailing zeros, but keeping the digit number divisible by binary
+    // digit width
+    while (fractional_part && fractional_part % 10 == 0 &&
+           fractional_digits % kDigitWidth != 0) {
+      fractional_part /= 10;
+      --fractional_digits;
+    }
+    // Here are the actual fractional digits
+    dscale = fractional_digits;
+
+    // Binary digits are produced starting from the least significant one
+    std::array<std::int16_t, 5> integral_digits{};
+    std::size_t integral_count = 0;
+    while (integral_part) {
+      integral_digits[integral_count++] = integral_part % kBinEncodingBase;
+      integral_part /= kBinEncodingBase;
+    }
+    std::array<std::int16_t, 5> fractional_bin_digits{};
+    std::size_t fractional_count = 0;
+    // Right pad fractional part to 4 digits boundary
+    if (const auto tail = fractional_digits % kDigitWidth; tail != 0) {
+      fractional_bin_digits[fractional_count++] =
+          fractional_part % kPowersOfTen[tail] *
+          kPowersOfTen[kDigitWidth - tail];
+      fractional_part /= kPowersOfTen[tail];
+      fractional_digits -= tail;
+    }
+    for (; fractional_digits > 0; fractional_digits -= kDigitWidth) {
+      fractional_bin_digits[fractional_count++] =
+          fractional_part % kBinEncodingBase;
+      fractional_part /= kBinEncodingBase;
+    }
+
+    while (integral_count > 0) {
+      digits[last++] = integral_digits[--integral_count];
+    }
+    weight = static_cast<Smallint>(last) - 1;
+    while (fractional_count > 0) {
+      digits[last++] = fractional_bin_digits[--fractional_count];
+    }
+
+    // Trim zero binary digits
+    for (; first < last && digits[first] == 0; ++first) --weight;
+    while (last > first && digits[last - 1] == 0) --last;
+  }
+
+  char* out = buffer.data();
+  out = WriteBinDigit(out, last - first);
+  out = WriteBinDigit(out, static_cast<std::uint16_t>(weight));
+  out = WriteBinDigit(out, sign);
+  out = WriteBinDigit(out, dscale);
+  for (auto i = first; i < last; ++i) out = WriteBinDigit(out, digits[i]);
+  return out - buffer.data();
 }
 
 }  // namespace storages::postgres::io::detail
@@ -116,11 +116,27 @@ PoolSettings ParsePoolSettings(const ConfigType& config) {
       config["max_queue_size"].template As<size_t>(result.max_queue_size);
   result.connecting_limit =
       config["connecting_limit"].template As<size_t>(result.connecting_limit);
+  result.multiplexed_connections =
+      config["multiplexed_connections"].template As<size_t>(
+          result.multiplexed_connections);
+  result.max_multiplexed_queries =
+      config["max_multiplexed_queries"].template As<size_t>(
+          result.max_multiplexed_queries);
+  result.prepare_on_connect =
+      config["prepare_on_connect"].template As<size_t>(
+          result.prepare_on_connect);
+  result.spare_size =
+      config["spare_size"].template As<size_t>(result.spare_size);
 
   if (result.max_size == 0)
     throw InvalidConfig{"max_pool_size must be greater than 0"};
   if (result.max_size < result.min_size)
     throw InvalidConfig{"max_pool_size cannot be less than min_pool_size"};
+  if (result.max_size < result.multiplexed_connections)
+    throw InvalidConfig{
+        "max_pool_size cannot be less than multiplexed_connections"};
+  if (result.max_multiplexed_queries == 0)
+    throw InvalidConfig{"max_multiplexed_queries must be greater than 0"};
 
   return result;
 }
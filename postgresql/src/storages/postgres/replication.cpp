@@ -0,0 +1,310 @@
+#include <userver/storages/postgres/replication.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+#include <fmt/format.h>
+#include <fmt/ranges.h>
+
+#include <storages/postgres/detail/pg_connection_wrapper.hpp>
+#include <storages/postgres/detail/pgoutput.hpp>
+#include <storages/postgres/detail/tracing_tags.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+namespace {
+
+// Must be less than the wal_sender_timeout of the server, 60s by default
+constexpr std::chrono::seconds kStatusInterval{10};
+
+// Seconds between the Unix epoch and the PostgreSQL epoch of 2000-01-01
+constexpr std::chrono::seconds kPostgresEpoch{946'684'800};
+
+void AppendInt64(std::string& message, std::uint64_t value) {
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    message.push_back(static_cast<char>((value >> shift) & 0xff));
+  }
+}
+
+std::uint64_t GetPostgresTimestamp() {
+  const auto since_epoch =
+      std::chrono::system_clock::now().time_since_epoch() - kPostgresEpoch;
+  return std::chrono::duration_cast<std::chrono::microseconds>(since_epoch)
+      .count();
+}
+
+std::string QuoteLiteral(std::string_view value) {
+  std::string quoted{'\''};
+  for (const auto c : value) {
+    if (c == '\'') quoted.push_back('\'');
+    quoted.push_back(c);
+  }
+  quoted.push_back('\'');
+  return quoted;
+}
+
+}  // namespace
+
+std::size_t ReplicationTuple::Parse(std::string_view message) {
+  detail::ReplicationMessageReader reader{message};
+  const auto column_count = reader.ReadInt16();
+  columns_.clear();
+  columns_.reserve(column_count);
+  for (std::uint16_t i = 0; i < column_count; ++i) {
+    const auto kind = static_cast<ValueKind>(reader.ReadByte());
+    const auto offset =
+        static_cast<std::uint32_t>(message.size() - reader.GetRest().size());
+    switch (kind) {
+      case ValueKind::kNull:
+      case ValueKind::kUnchangedToast:
+        break;
+      case ValueKind::kText:
+      case ValueKind::kBinary:
+        reader.Skip(reader.ReadInt32());
+        break;
+      default:
+        throw ReplicationError{fmt::format(
+            "Unexpected column value kind '{}'", static_cast<char>(kind))};
+    }
+    columns_.push_back({kind, offset});
+  }
+
+  const auto size = message.size() - reader.GetRest().size();
+  data_.assign(message.data(), size);
+  return size;
+}
+
+ReplicationTuple::ValueKind ReplicationTuple::GetValueKind(
+    std::size_t index) const {
+  UINVARIANT(index < columns_.size(), "Column index is out of range");
+  return columns_[index].kind;
+}
+
+bool ReplicationTuple::HasUnchangedToast() const noexcept {
+  return std::any_of(columns_.begin(), columns_.end(), [](const Column& c) {
+    return c.kind == ValueKind::kUnchangedToast;
+  });
+}
+
+void ReplicationTuple::FillUnchanged(const ReplicationTuple& other) {
+  if (other.columns_.size() != columns_.size()) return;
+  for (std::size_t i = 0; i < columns_.size(); ++i) {
+    auto& column = columns_[i];
+    const auto& other_column = other.columns_[i];
+    if (column.kind != ValueKind::kUnchangedToast ||
+        other_column.kind == ValueKind::kUnchangedToast) {
+      continue;
+    }
+    // The value is appended with its length, the offsets of the other
+    // columns are not affected
+    column.kind = other_column.kind;
+    if (other_column.kind == ValueKind::kNull) continue;
+    const auto value = other.GetRawValue(i);
+    column.offset = static_cast<std::uint32_t>(data_.size());
+    data_.append(value);
+  }
+}
+
+std::string_view ReplicationTuple::GetRawValue(std::size_t index) const {
+  const auto offset = columns_[index].offset;
+  detail::ReplicationMessageReader reader{
+      std::string_view{data_}.substr(offset)};
+  const auto length = reader.ReadInt32();
+  return std::string_view{data_}.substr(offset, sizeof(Integer) + length);
+}
+
+io::FieldBuffer ReplicationTuple::GetValue(std::size_t index) const {
+  const auto& column = columns_[index];
+  if (column.kind == ValueKind::kUnchangedToast) {
+    throw ReplicationError{fmt::format(
+        "The value of the column #{} is unchanged TOAST and was not sent, set "
+        "REPLICA IDENTITY FULL on the table to receive it",
+        index)};
+  }
+  if (column.kind != ValueKind::kBinary) {
+    throw ReplicationError{fmt::format(
+        "The value of the column #{} is not in the binary format", index)};
+  }
+  // The length of the value and the value itself
+  const auto value = GetRawValue(index);
+  return {false, io::BufferCategory::kPlainBuffer, value.size(),
+          reinterpret_cast<const std::uint8_t*>(value.data())};
+}
+
+struct ReplicationStream::Impl {
+  Impl(std::unique_ptr<detail::PGConnectionWrapper> conn,
+       ReplicationSettings settings)
+      : conn(std::move(conn)), settings(std::move(settings)) {
+    UINVARIANT(this->conn, "Replication stream needs a connection");
+  }
+
+  void Execute(const std::string& statement, engine::Deadline deadline,
+               bool starts_copy) {
+    tracing::Span span{scopes::kReplication};
+    auto scope = span.CreateScopeTime();
+    LOG_DEBUG() << "Executing a replication command: " << statement;
+    conn->SendQuery(statement, scope);
+    if (starts_copy) {
+      conn->WaitCopyStart(deadline, scope);
+    } else {
+      conn->WaitResult(deadline, scope, nullptr);
+    }
+  }
+
+  void SendStatus(bool is_reply_requested) {
+    std::string message{'r'};
+    AppendInt64(message, received_lsn);
+    AppendInt64(message, confirmed_lsn);
+    AppendInt64(message, confirmed_lsn);
+    AppendInt64(message, GetPostgresTimestamp());
+    message.push_back(0);
+    conn->PutCopyData(message,
+                      engine::Deadline::FromDuration(kStatusInterval));
+    last_status_time = std::chrono::steady_clock::now();
+    if (is_reply_requested) {
+      LOG_TRACE() << "Replied to the replication keepalive of slot "
+                  << settings.slot_name;
+    }
+  }
+
+  void SendStatusIfNeeded() {
+    if (std::chrono::steady_clock::now() - last_status_time >=
+        kStatusInterval) {
+      SendStatus(false);
+    }
+  }
+
+  void OnKeepalive(detail::ReplicationMessageReader& reader) {
+    const auto wal_end = reader.ReadInt64();
+    // Send time
+    reader.Skip(8);
+    const bool is_reply_requested = reader.ReadByte() != 0;
+    received_lsn = std::max(received_lsn, wal_end);
+    // Nothing is pending, the WAL up to the end is of no interest for the
+    // stream, e.g. it has the changes of the other tables
+    if (!decoder.IsInTransaction() && confirmed_lsn == returned_lsn) {
+      confirmed_lsn = returned_lsn = std::max(confirmed_lsn, wal_end);
+    }
+    if (is_reply_requested) SendStatus(true);
+  }
+
+  [[noreturn]] void OnStreamEnd() {
+    tracing::Span span{scopes::kReplication};
+    auto scope = span.CreateScopeTime();
+    // Throws the error of the server, if any
+    conn->WaitResult(engine::Deadline::FromDuration(kStatusInterval), scope,
+                     nullptr);
+    throw ReplicationError{"The server has finished the replication stream"};
+  }
+
+  std::unique_ptr<detail::PGConnectionWrapper> conn;
+  const ReplicationSettings settings;
+  detail::PgOutputDecoder decoder;
+  std::string message;
+  bool is_started{false};
+  std::uint64_t received_lsn{0};
+  std::uint64_t returned_lsn{0};
+  std::uint64_t confirmed_lsn{0};
+  std::chrono::steady_clock::time_point last_status_time;
+};
+
+ReplicationStream::ReplicationStream(
+    std::unique_ptr<detail::PGConnectionWrapper> conn,
+    ReplicationSettings settings, engine::Deadline deadline)
+    : impl_(std::make_unique<Impl>(std::move(conn), std::move(settings))) {
+  if (impl_->settings.publications.empty()) {
+    throw LogicError{"Replication stream needs at least one publication"};
+  }
+  impl_->Execute(
+      fmt::format("CREATE_REPLICATION_SLOT {} TEMPORARY LOGICAL pgoutput "
+                  "NOEXPORT_SNAPSHOT",
+                  impl_->conn->EscapeIdentifier(impl_->settings.slot_name)),
+      deadline, false);
+  LOG_INFO() << "Created temporary replication slot "
+             << impl_->settings.slot_name;
+}
+
+ReplicationStream::ReplicationStream(ReplicationStream&&) noexcept = default;
+
+ReplicationStream& ReplicationStream::operator=(ReplicationStream&&) noexcept =
+    default;
+
+ReplicationStream::~ReplicationStream() = default;
+
+void ReplicationStream::Start(engine::Deadline deadline) {
+  UINVARIANT(impl_, "Replication stream is moved out");
+  if (impl_->is_started) throw LogicError{"Replication is already started"};
+
+  std::vector<std::string> publications;
+  publications.reserve(impl_->settings.publications.size());
+  for (const auto& publication : impl_->settings.publications) {
+    publications.push_back(impl_->conn->EscapeIdentifier(publication));
+  }
+  impl_->Execute(
+      fmt::format("START_REPLICATION SLOT {} LOGICAL 0/0 (proto_version '1', "
+                  "publication_names {}, binary 'true')",
+                  impl_->conn->EscapeIdentifier(impl_->settings.slot_name),
+                  QuoteLiteral(fmt::to_string(fmt::join(publications, ",")))),
+      deadline, true);
+  impl_->is_started = true;
+  impl_->last_status_time = std::chrono::steady_clock::now();
+}
+
+bool ReplicationStream::IsStarted() const noexcept {
+  return impl_ && impl_->is_started;
+}
+
+std::optional<ReplicationTransaction> ReplicationStream::WaitTransaction(
+    engine::Deadline deadline) {
+  UINVARIANT(IsStarted(), "Replication is not started");
+  auto& impl = *impl_;
+  while (true) {
+    using Status = detail::PGConnectionWrapper::CopyDataStatus;
+    const auto status = impl.conn->WaitCopyData(impl.message, deadline);
+    if (status == Status::kTimeout) {
+      impl.SendStatusIfNeeded();
+      return std::nullopt;
+    }
+    if (status == Status::kEnd) impl.OnStreamEnd();
+
+    detail::ReplicationMessageReader reader{impl.message};
+    const auto type = static_cast<char>(reader.ReadByte());
+    if (type == 'k') {
+      impl.OnKeepalive(reader);
+      continue;
+    }
+    if (type != 'w') {
+      throw ReplicationError{
+          fmt::format("Unexpected replication message type '{}'", type)};
+    }
+
+    const auto start_lsn = reader.ReadInt64();
+    // The end of the WAL on the server and the send time
+    reader.Skip(8 + 8);
+    const auto data = reader.GetRest();
+    impl.received_lsn = std::max(impl.received_lsn, start_lsn + data.size());
+
+    auto transaction = impl.decoder.Decode(data);
+    impl.SendStatusIfNeeded();
+    if (transaction) {
+      impl.returned_lsn = std::max(impl.returned_lsn, transaction->end_lsn);
+      return transaction;
+    }
+  }
+}
+
+void ReplicationStream::Confirm(std::uint64_t lsn) {
+  UINVARIANT(IsStarted(), "Replication is not started");
+  if (lsn <= impl_->confirmed_lsn) return;
+  impl_->confirmed_lsn = lsn;
+  impl_->SendStatus(false);
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
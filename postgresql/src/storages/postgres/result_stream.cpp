@@ -0,0 +1,52 @@
+#include <userver/storages/postgres/result_stream.hpp>
+
+#include <utility>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+ResultStream::ResultStream(detail::Connection* conn, const Query& query,
+                           const detail::QueryParameters& params,
+                           OptionalCommandControl cmd_ctl)
+    : conn_(conn) {
+  UASSERT(conn_);
+  conn_->StreamStart(query, params, std::move(cmd_ctl));
+}
+
+ResultStream::ResultStream(ResultStream&& other) noexcept
+    : conn_(std::exchange(other.conn_, nullptr)),
+      rows_read_(other.rows_read_) {}
+
+ResultStream::~ResultStream() {
+  if (!conn_) return;
+  LOG_LIMITED_WARNING() << "Result stream is destroyed before the last row, "
+                           "closing the connection";
+  conn_->MarkAsBroken();
+}
+
+std::optional<ResultSet> ResultStream::Next() {
+  if (!conn_) return std::nullopt;
+  std::optional<ResultSet> row;
+  try {
+    row = conn_->StreamNextRow();
+  } catch (const std::exception&) {
+    // The statement is finished by the error
+    conn_ = nullptr;
+    throw;
+  }
+  if (!row) {
+    conn_ = nullptr;
+    return std::nullopt;
+  }
+  ++rows_read_;
+  return row;
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
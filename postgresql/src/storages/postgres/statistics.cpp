@@ -86,6 +86,26 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
   for (const auto& item : value.unknown) {
     writer.ValueWithLabels(item, {kPostgresqlClusterHostType, "unknown"});
   }
+  if (value.query_cache) writer["query-cache"] = *value.query_cache;
+}
+
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const QueryCacheCounters& value) {
+  writer["hits"] = value.hits;
+  writer["misses"] = value.misses;
+}
+
+void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
+                const QueryCacheStatistics& value) {
+  writer = value.total;
+  writer["size"] = value.size;
+  writer["invalidations"] = value.invalidations;
+  if (!value.queries.empty()) {
+    auto queries = writer["queries"];
+    for (const auto& [name, counters] : value.queries) {
+      queries.ValueWithLabels(counters, {"postgresql_query", name});
+    }
+  }
 }
 
 }  // namespace storages::postgres
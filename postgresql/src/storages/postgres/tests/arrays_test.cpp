@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <optional>
+#include <vector>
+
+#include <boost/uuid/uuid.hpp>
+
+#include <storages/postgres/tests/test_buffers.hpp>
+#include <userver/storages/postgres/io/array_types.hpp>
+#include <userver/storages/postgres/io/floating_point_types.hpp>
+#include <userver/storages/postgres/io/optional.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+#include <userver/storages/postgres/io/uuid.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+namespace io = pg::io;
+
+namespace {
+
+const pg::UserTypes types;
+const io::TypeBufferCategory categories;
+
+template <typename To, typename From>
+To Roundtrip(const From& src) {
+  pg::test::Buffer buffer;
+  io::WriteBuffer(types, buffer, src);
+  auto fb = pg::test::MakeFieldBuffer(buffer, io::BufferCategory::kArrayBuffer);
+  To tgt{};
+  io::ReadBuffer(fb, tgt, categories);
+  return tgt;
+}
+
+template <typename T>
+void CheckRoundtrip(const T& src) {
+  EXPECT_EQ(Roundtrip<T>(src), src);
+}
+
+}  // namespace
+
+TEST(PostgreIOArrays, FixedWidthElements) {
+  CheckRoundtrip(std::vector<pg::Smallint>{1, -2, 3});
+  CheckRoundtrip(std::vector<pg::Integer>{
+      std::numeric_limits<pg::Integer>::min(), 0,
+      std::numeric_limits<pg::Integer>::max()});
+  CheckRoundtrip(std::vector<pg::Bigint>{1, 2, -3, 4, 5});
+  CheckRoundtrip(std::vector<float>{0.5, -1.25});
+  CheckRoundtrip(std::vector<double>{3.14, -2.71, 1e300});
+  CheckRoundtrip(std::vector<boost::uuids::uuid>{
+      {0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef, 0xfe, 0xdc, 0xba, 0x98,
+       0x76, 0x54, 0x32, 0x10},
+      {}});
+  CheckRoundtrip(std::vector<pg::Integer>{});
+  CheckRoundtrip(std::vector<std::vector<pg::Integer>>{{1, 2, 3}, {4, 5, 6}});
+}
+
+TEST(PostgreIOArrays, FixedWidthElementsOfAnotherSize) {
+  // int2 elements are parsed one by one into the wider type
+  EXPECT_EQ(Roundtrip<std::vector<pg::Bigint>>(
+                std::vector<pg::Smallint>{1, -2, 3}),
+            (std::vector<pg::Bigint>{1, -2, 3}));
+}
+
+TEST(PostgreIOArrays, NullElements) {
+  const std::vector<std::optional<pg::Integer>> src{1, std::nullopt, 3};
+  CheckRoundtrip(src);
+  EXPECT_THROW(Roundtrip<std::vector<pg::Integer>>(src),
+               pg::TypeCannotBeNull);
+}
+
+TEST(PostgreIOArrays, InvalidDimensions) {
+  const std::vector<std::vector<pg::Integer>> src{{1, 2}, {3}};
+  pg::test::Buffer buffer;
+  EXPECT_THROW(io::WriteBuffer(types, buffer, src), pg::InvalidDimensions);
+}
+
+USERVER_NAMESPACE_END
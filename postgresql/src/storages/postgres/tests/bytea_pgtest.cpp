@@ -13,6 +13,8 @@ namespace static_test {
 
 static_assert(tt::kIsByteaCompatible<std::string>);
 static_assert(tt::kIsByteaCompatible<std::string_view>);
+static_assert(tt::kIsByteaCompatible<utils::span<const std::byte>>);
+static_assert(tt::kIsMappedToPg<utils::span<const std::byte>>);
 static_assert(tt::kIsByteaCompatible<std::vector<char>>);
 static_assert(tt::kIsByteaCompatible<std::vector<unsigned char>>);
 static_assert(!tt::kIsByteaCompatible<std::vector<bool>>);
@@ -73,6 +75,20 @@ TEST(PostgreIO, Bytea) {
     UEXPECT_NO_THROW(io::ReadBuffer(fb, pg::Bytea(tgt_str)));
     EXPECT_EQ(bin_str, tgt_str);
   }
+  {
+    pg::test::Buffer buffer;
+    const auto bin_str = utils::as_bytes(utils::span<const char>{kFooBar});
+    UEXPECT_NO_THROW(io::WriteBuffer(types, buffer, bin_str));
+    EXPECT_EQ(kFooBar.size(), buffer.size());
+    auto fb =
+        pg::test::MakeFieldBuffer(buffer, io::BufferCategory::kPlainBuffer);
+    utils::span<const std::byte> tgt_bytes;
+    UEXPECT_NO_THROW(io::ReadBuffer(fb, tgt_bytes));
+    // Points into the buffer
+    EXPECT_EQ(static_cast<const void*>(tgt_bytes.data()),
+              static_cast<const void*>(buffer.data()));
+    EXPECT_EQ(tgt_bytes.size(), kFooBar.size());
+  }
 }
 
 UTEST_P(PostgreConnection, ByteaRoundtrip) {
@@ -84,6 +100,34 @@ UTEST_P(PostgreConnection, ByteaRoundtrip) {
   EXPECT_EQ(kFooBar, tgt_str);
 }
 
+UTEST_P(PostgreConnection, ByteaSpanRoundtrip) {
+  CheckConnection(GetConn());
+  pg::ResultSet res{nullptr};
+  const auto bytes = utils::as_bytes(utils::span<const char>{kFooBar});
+  UEXPECT_NO_THROW(res = GetConn()->Execute("select $1", bytes));
+  utils::span<const std::byte> tgt_bytes;
+  UEXPECT_NO_THROW(res[0][0].To(tgt_bytes));
+  EXPECT_EQ(std::string(reinterpret_cast<const char*>(tgt_bytes.data()),
+                        tgt_bytes.size()),
+            kFooBar);
+}
+
+UTEST_P(PostgreConnection, ByteaZeroCopyFields) {
+  CheckConnection(GetConn());
+  pg::ResultSet res{nullptr};
+  const auto bytes = utils::as_bytes(utils::span<const char>{kFooBar});
+  UEXPECT_NO_THROW(
+      res = GetConn()->Execute("select 'foobar'::text, $1", bytes));
+
+  // The views are valid while the result set is alive
+  const auto [text, blob] = res.AsSingleRow<
+      std::tuple<std::string_view, utils::span<const std::byte>>>();
+  EXPECT_EQ(text, "foobar");
+  EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(blob.data()),
+                             blob.size()),
+            kFooBar);
+}
+
 UTEST_P(PostgreConnection, ByteaOwningRoundtrip) {
   CheckConnection(GetConn());
   pg::ResultSet res{nullptr};
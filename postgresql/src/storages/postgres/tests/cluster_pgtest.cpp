@@ -55,6 +55,7 @@ pg::Cluster CreateCluster(
                       storages::postgres::InitMode::kAsync,
                       "",
                       {},
+                      {},
                       {}},
                      {kTestCmdCtl, {}, {}}, {}, {}, testsuite_tasks, source, 0);
 }
@@ -159,6 +160,10 @@ UTEST_F(PostgreCluster, ClusterAnyRW) {
       cluster.Begin({pg::ClusterHostType::kMaster, pg::ClusterHostType::kSlave,
                      pg::ClusterHostType::kNearest},
                     pg::Transaction::RW));
+  CheckRwTransaction(
+      cluster.Begin({pg::ClusterHostType::kMaster, pg::ClusterHostType::kSlave,
+                     pg::ClusterHostType::kLeastLoaded},
+                    pg::Transaction::RW));
 
   UEXPECT_THROW(
       cluster.Begin(
@@ -188,6 +193,9 @@ UTEST_F(PostgreCluster, ClusterSlaveRO) {
   CheckRoTransaction(cluster.Begin(
       {pg::ClusterHostType::kSlave, pg::ClusterHostType::kNearest},
       pg::Transaction::RO));
+  CheckRoTransaction(cluster.Begin(
+      {pg::ClusterHostType::kSlave, pg::ClusterHostType::kLeastLoaded},
+      pg::Transaction::RO));
 
   UEXPECT_THROW(cluster.Begin({pg::ClusterHostType::kSlave,
                                pg::ClusterHostType::kRoundRobin,
@@ -399,6 +407,45 @@ UTEST_F(PostgreCluster, NonTransactionExecuteWithParameterStoreMove) {
   }
 }
 
+UTEST_F(PostgreCluster, ExecuteBatch) {
+  testsuite::TestsuiteTasks testsuite_tasks{true};
+  for (const auto& conn_settings :
+       {kCachePreparedStatements, kPipelineEnabled}) {
+    auto cluster = CreateCluster(GetDsnListFromEnv(), GetTaskProcessor(), 1,
+                                 testsuite_tasks, conn_settings);
+
+    pg::QueryBatch batch;
+    batch.Append("select $1::integer", 1)
+        .Append("select 1 / ($1::integer - $1)", 2)
+        .Append("select $1::text, $2::integer", std::string{"foo"}, 3);
+    EXPECT_EQ(3, batch.Size());
+    UEXPECT_THROW(cluster.ExecuteBatch({}, batch), pg::LogicError);
+
+    std::vector<pg::BatchResult> results;
+    UEXPECT_NO_THROW(results =
+                         cluster.ExecuteBatch(pg::ClusterHostType::kMaster,
+                                              batch));
+    ASSERT_EQ(3, results.size());
+    ASSERT_TRUE(results[0].IsOk());
+    EXPECT_EQ(1, results[0].Get().AsSingleRow<int>());
+    // A failed statement does not affect the other ones
+    EXPECT_FALSE(results[1].IsOk());
+    UEXPECT_THROW(results[1].Get(), pg::DataException);
+    ASSERT_TRUE(results[2].IsOk());
+    EXPECT_EQ("foo", results[2].Get().Front()[0].As<std::string>());
+    EXPECT_EQ(3, results[2].Get().Front()[1].As<int>());
+
+    auto trx = cluster.Begin(pg::ClusterHostType::kMaster, {});
+    results = trx.ExecuteBatch(batch);
+    ASSERT_EQ(3, results.size());
+    EXPECT_TRUE(results[0].IsOk());
+    UEXPECT_THROW(results[1].Get(), pg::DataException);
+    // The transaction is aborted by the error
+    EXPECT_FALSE(results[2].IsOk());
+    UEXPECT_NO_THROW(trx.Rollback());
+  }
+}
+
 UTEST_F(PostgreCluster, ListenNotify) {
   constexpr auto kListenChannel = std::string_view{"foo"};
   constexpr auto kNotifyPayload = std::string_view{"bar"};
@@ -431,4 +478,62 @@ UTEST_F(PostgreCluster, ListenNotify) {
                 pg::ConnectionTimeoutError);
 }
 
+UTEST_F(PostgreCluster, Replication) {
+  using Row = std::tuple<pg::Integer, std::optional<std::string>>;
+  const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+  const auto master = pg::ClusterHostType::kMaster;
+
+  testsuite::TestsuiteTasks testsuite_tasks{true};
+  auto cluster = CreateCluster(GetDsnListFromEnv(), GetTaskProcessor(), 1,
+                               testsuite_tasks);
+  if (cluster.Execute(master, "show wal_level").AsSingleRow<std::string>() !=
+      "logical") {
+    GTEST_SKIP() << "Logical replication requires wal_level = logical";
+  }
+
+  cluster.Execute(master, "drop publication if exists replicated_items_pub");
+  cluster.Execute(master, "drop table if exists replicated_items");
+  cluster.Execute(master,
+                  "create table replicated_items(id integer primary key, "
+                  "value text)");
+  cluster.Execute(master,
+                  "create publication replicated_items_pub for table "
+                  "replicated_items");
+
+  /// [Replication]
+  auto stream = cluster.CreateReplicationStream(
+      {"userver_test_slot", {"replicated_items_pub"}});
+  // The changes made after the stream creation are kept by the slot, the
+  // table may be loaded entirely before the start
+  cluster.Execute(master, "insert into replicated_items values (1, 'first')");
+  stream.Start(deadline);
+
+  auto transaction = stream.WaitTransaction(deadline);
+  ASSERT_TRUE(transaction);
+  ASSERT_EQ(transaction->changes.size(), 1);
+  const auto& change = transaction->changes.front();
+  EXPECT_EQ(change.type, pg::ReplicationChange::Type::kInsert);
+  EXPECT_EQ(change.relation->table, "replicated_items");
+  EXPECT_EQ(change.tuple.As<Row>(), Row(1, "first"));
+  // The changes are applied, the server may recycle their WAL
+  stream.Confirm(transaction->end_lsn);
+  /// [Replication]
+
+  cluster.Execute(master, "delete from replicated_items where id = 1");
+  transaction = stream.WaitTransaction(deadline);
+  ASSERT_TRUE(transaction);
+  ASSERT_EQ(transaction->changes.size(), 1);
+  EXPECT_EQ(transaction->changes.front().type,
+            pg::ReplicationChange::Type::kDelete);
+  EXPECT_EQ(transaction->changes.front().tuple.AsReplicaIdentity<Row>(),
+            Row(1, std::nullopt));
+  stream.Confirm(transaction->end_lsn);
+
+  EXPECT_FALSE(stream.WaitTransaction(
+      engine::Deadline::FromDuration(std::chrono::milliseconds{50})));
+
+  cluster.Execute(master, "drop publication replicated_items_pub");
+  cluster.Execute(master, "drop table replicated_items");
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,120 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/copy.hpp>
+#include <userver/storages/postgres/transaction.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+constexpr int kRowCount = 10'000;
+
+/// [CopyFrom]
+std::size_t LoadRows(pg::Transaction& trx) {
+  auto writer = trx.CopyFrom(
+      "COPY copy_test (id, value, tags) FROM STDIN (FORMAT binary)");
+  for (int i = 0; i < kRowCount; ++i) {
+    const auto value =
+        i % 10 ? std::optional<std::string>{std::to_string(i)} : std::nullopt;
+    writer.WriteRow(i, value, std::vector<std::string>{"a", "b"});
+  }
+  return writer.Finish();
+}
+/// [CopyFrom]
+
+void CreateTable(pg::detail::ConnectionPtr& conn) {
+  conn->Execute(
+      "create temporary table copy_test("
+      "id integer, value text, tags text[])");
+}
+
+}  // namespace
+
+UTEST_P(PostgreConnection, CopyFrom) {
+  CheckConnection(GetConn());
+  CreateTable(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  EXPECT_EQ(LoadRows(trx), kRowCount);
+
+  auto res = trx.Execute(
+      "select count(*), count(value), sum(id) from copy_test "
+      "where tags = '{a,b}'");
+  EXPECT_EQ(res[0][0].As<pg::Bigint>(), kRowCount);
+  EXPECT_EQ(res[0][1].As<pg::Bigint>(), kRowCount - kRowCount / 10);
+  EXPECT_EQ(res[0][2].As<pg::Bigint>(),
+            pg::Bigint{kRowCount} * (kRowCount - 1) / 2);
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, CopyTo) {
+  CheckConnection(GetConn());
+  CreateTable(GetConn());
+
+  pg::Transaction trx{std::move(GetConn())};
+  LoadRows(trx);
+
+  /// [CopyTo]
+  auto reader = trx.CopyTo(
+      "COPY (select id, value, tags from copy_test order by id) "
+      "TO STDOUT (FORMAT binary)");
+  int id = 0;
+  std::optional<std::string> value;
+  std::vector<std::string> tags;
+  int rows = 0;
+  while (reader.ReadRow(id, value, tags)) {
+    EXPECT_EQ(id, rows);
+    EXPECT_EQ(value.has_value(), id % 10 != 0);
+    EXPECT_EQ(tags, (std::vector<std::string>{"a", "b"}));
+    ++rows;
+  }
+  /// [CopyTo]
+  EXPECT_EQ(rows, kRowCount);
+
+  // The connection is usable again
+  const auto res = trx.Execute("select 1");
+  EXPECT_EQ(res.Front().As<int>(), 1);
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, CopyFromAbort) {
+  CheckConnection(GetConn());
+  CreateTable(GetConn());
+
+  {
+    pg::CopyWriter writer{GetConn().get(),
+                          "COPY copy_test (id) FROM STDIN (FORMAT binary)", {}};
+    writer.WriteRow(1);
+    // Destroyed without Finish()
+  }
+  EXPECT_FALSE(GetConn()->IsBroken());
+  const auto res = GetConn()->Execute("select count(*) from copy_test");
+  EXPECT_EQ(res.Front().As<pg::Bigint>(), 0);
+}
+
+UTEST_P(PostgreConnection, CopyErrors) {
+  CheckConnection(GetConn());
+  CreateTable(GetConn());
+
+  UEXPECT_THROW(pg::CopyWriter(GetConn().get(), "select 1", {}),
+                pg::LogicError);
+  UEXPECT_THROW(pg::CopyWriter(GetConn().get(),
+                               "COPY missing_table FROM STDIN (FORMAT binary)",
+                               {}),
+                pg::Error);
+
+  GetConn()->Execute("insert into copy_test(id) values (1)");
+  pg::CopyReader reader{GetConn().get(), "COPY copy_test TO STDOUT", {}};
+  int id = 0;
+  UEXPECT_THROW(reader.ReadRow(id), pg::InvalidBinaryBuffer);
+  EXPECT_TRUE(GetConn()->IsBroken());
+}
+
+USERVER_NAMESPACE_END
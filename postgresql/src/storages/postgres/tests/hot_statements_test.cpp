@@ -0,0 +1,69 @@
+#include <userver/utest/utest.hpp>
+
+#include <string>
+#include <vector>
+
+#include <storages/postgres/detail/hot_statements.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+pg::detail::PreparableStatement MakeStatement(std::string statement,
+                                              std::vector<pg::Oid> types = {}) {
+  return {std::move(statement), std::move(types)};
+}
+
+std::vector<std::string> GetHottest(const pg::detail::HotStatements& hot,
+                                    std::size_t limit) {
+  std::vector<std::string> result;
+  for (auto& statement : hot.GetHottest(limit)) {
+    result.push_back(std::move(statement.statement));
+  }
+  return result;
+}
+
+}  // namespace
+
+UTEST(PostgreHotStatements, RankedByPrepares) {
+  pg::detail::HotStatements hot;
+  EXPECT_TRUE(hot.GetHottest(10).empty());
+
+  hot.Account({MakeStatement("select 1"), MakeStatement("select 2")});
+  hot.Account({MakeStatement("select 2"), MakeStatement("select 3")});
+  hot.Account({MakeStatement("select 2"), MakeStatement("select 3")});
+
+  EXPECT_EQ(GetHottest(hot, 2),
+            (std::vector<std::string>{"select 2", "select 3"}));
+  EXPECT_EQ(GetHottest(hot, 10).size(), 3);
+}
+
+UTEST(PostgreHotStatements, KeyedByParameterTypes) {
+  pg::detail::HotStatements hot;
+  hot.Account({MakeStatement("select $1", {23})});
+  hot.Account({MakeStatement("select $1", {25})});
+  hot.Account({MakeStatement("select $1", {25})});
+
+  const auto hottest = hot.GetHottest(10);
+  ASSERT_EQ(hottest.size(), 2);
+  EXPECT_EQ(hottest[0].param_types, std::vector<pg::Oid>{25});
+  EXPECT_EQ(hottest[1].param_types, std::vector<pg::Oid>{23});
+}
+
+UTEST(PostgreHotStatements, Decay) {
+  using Statements = std::vector<pg::detail::PreparableStatement>;
+  static_assert(pg::detail::HotStatements::kMaxSize == 1000);
+  pg::detail::HotStatements hot;
+
+  hot.Account(Statements(600, MakeStatement("select old")));
+  hot.Account(Statements(400, MakeStatement("select new")));
+  // The ranks are halved after 1000 prepares: 300 and 200
+  hot.Account(Statements(150, MakeStatement("select new")));
+
+  EXPECT_EQ(GetHottest(hot, 2),
+            (std::vector<std::string>{"select new", "select old"}));
+}
+
+USERVER_NAMESPACE_END
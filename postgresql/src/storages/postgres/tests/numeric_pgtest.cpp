@@ -165,7 +165,9 @@ INSTANTIATE_TEST_SUITE_P(
         DecIOTestData{"10000000", {10000000, 0}},
         DecIOTestData{"99999999", {99999999, 0}},
         DecIOTestData{"0.00001", {1, 5}},
-        DecIOTestData{"10000.00001", {1000000001, 5}}),
+        DecIOTestData{"10000.00001", {1000000001, 5}},
+        DecIOTestData{"0.09900000000000001", {9900000000000001, 17}},
+        DecIOTestData{"-92233720368.54775807", {-9223372036854775807, 8}}),
     TestDescription);
 
 UTEST_P(PostgreConnection, DecimalRoundtrip) {
@@ -0,0 +1,194 @@
+#include <userver/utest/utest.hpp>
+
+#include <optional>
+#include <string>
+#include <tuple>
+
+#include <storages/postgres/detail/pgoutput.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+
+using Row = std::tuple<pg::Integer, std::optional<std::string>>;
+
+constexpr pg::Oid kRelationId = 16384;
+constexpr std::uint64_t kEndLsn = 0x16B3748;
+
+class MessageBuilder {
+ public:
+  explicit MessageBuilder(char type) { message_.push_back(type); }
+
+  MessageBuilder& Int(std::uint64_t value, std::size_t size) {
+    for (auto i = size; i > 0; --i) {
+      message_.push_back(static_cast<char>((value >> ((i - 1) * 8)) & 0xff));
+    }
+    return *this;
+  }
+
+  MessageBuilder& Byte(char value) {
+    message_.push_back(value);
+    return *this;
+  }
+
+  MessageBuilder& String(std::string_view value) {
+    message_.append(value);
+    message_.push_back('\0');
+    return *this;
+  }
+
+  // A tuple with an integer and a text or a special value
+  MessageBuilder& Tuple(pg::Integer id, std::optional<std::string> value,
+                        char value_kind = 'b') {
+    Int(2, 2).Byte('b').Int(4, 4).Int(id, 4);
+    if (value) {
+      Byte(value_kind).Int(value->size(), 4);
+      message_.append(*value);
+    } else {
+      Byte(value_kind == 'b' ? 'n' : value_kind);
+    }
+    return *this;
+  }
+
+  std::string Build() const { return message_; }
+
+ private:
+  std::string message_;
+};
+
+std::string MakeRelation() {
+  return MessageBuilder{'R'}
+      .Int(kRelationId, 4)
+      .String("public")
+      .String("items")
+      .Byte('d')
+      .Int(2, 2)
+      .Byte(1)
+      .String("id")
+      .Int(23, 4)
+      .Int(-1, 4)
+      .Byte(0)
+      .String("value")
+      .Int(25, 4)
+      .Int(-1, 4)
+      .Build();
+}
+
+std::string MakeBegin() {
+  return MessageBuilder{'B'}.Int(kEndLsn, 8).Int(0, 8).Int(42, 4).Build();
+}
+
+std::string MakeCommit() {
+  return MessageBuilder{'C'}
+      .Byte(0)
+      .Int(kEndLsn - 8, 8)
+      .Int(kEndLsn, 8)
+      .Int(0, 8)
+      .Build();
+}
+
+}  // namespace
+
+TEST(PostgrePgOutput, Transaction) {
+  pg::detail::PgOutputDecoder decoder;
+  EXPECT_FALSE(decoder.Decode(MakeBegin()));
+  EXPECT_TRUE(decoder.IsInTransaction());
+  EXPECT_FALSE(decoder.Decode(MakeRelation()));
+  EXPECT_FALSE(decoder.Decode(MessageBuilder{'I'}
+                                  .Int(kRelationId, 4)
+                                  .Byte('N')
+                                  .Tuple(1, "first")
+                                  .Build()));
+  EXPECT_FALSE(decoder.Decode(MessageBuilder{'U'}
+                                  .Int(kRelationId, 4)
+                                  .Byte('O')
+                                  .Tuple(2, "old")
+                                  .Byte('N')
+                                  .Tuple(2, std::nullopt, 'u')
+                                  .Build()));
+  EXPECT_FALSE(decoder.Decode(MessageBuilder{'D'}
+                                  .Int(kRelationId, 4)
+                                  .Byte('K')
+                                  .Tuple(3, std::nullopt)
+                                  .Build()));
+
+  const auto transaction = decoder.Decode(MakeCommit());
+  ASSERT_TRUE(transaction);
+  EXPECT_FALSE(decoder.IsInTransaction());
+  EXPECT_EQ(transaction->end_lsn, kEndLsn);
+  ASSERT_EQ(transaction->changes.size(), 3);
+
+  const auto& insert = transaction->changes[0];
+  EXPECT_EQ(insert.type, pg::ReplicationChange::Type::kInsert);
+  ASSERT_TRUE(insert.relation);
+  EXPECT_EQ(insert.relation->schema, "public");
+  EXPECT_EQ(insert.relation->table, "items");
+  EXPECT_EQ(insert.relation->columns,
+            (std::vector<std::string>{"id", "value"}));
+  EXPECT_EQ(insert.tuple.As<Row>(), Row(1, "first"));
+
+  // The unchanged value is taken from the old row
+  const auto& update = transaction->changes[1];
+  EXPECT_EQ(update.type, pg::ReplicationChange::Type::kUpdate);
+  EXPECT_FALSE(update.tuple.HasUnchangedToast());
+  EXPECT_EQ(update.tuple.As<Row>(), Row(2, "old"));
+
+  const auto& del = transaction->changes[2];
+  EXPECT_EQ(del.type, pg::ReplicationChange::Type::kDelete);
+  EXPECT_EQ(del.tuple.As<Row>(), Row(3, std::nullopt));
+  UEXPECT_THROW(del.tuple.As<std::tuple<pg::Integer>>(),
+                pg::FieldTupleMismatch);
+
+  using RequiredRow = std::tuple<pg::Integer, std::string>;
+  UEXPECT_THROW(del.tuple.As<RequiredRow>(), pg::TypeCannotBeNull);
+  EXPECT_EQ(del.tuple.AsReplicaIdentity<RequiredRow>(), RequiredRow(3, ""));
+}
+
+TEST(PostgrePgOutput, UnchangedToast) {
+  pg::detail::PgOutputDecoder decoder;
+  decoder.Decode(MakeRelation());
+  decoder.Decode(MakeBegin());
+  decoder.Decode(MessageBuilder{'U'}
+                     .Int(kRelationId, 4)
+                     .Byte('N')
+                     .Tuple(1, std::nullopt, 'u')
+                     .Build());
+  decoder.Decode(
+      MessageBuilder{'T'}.Int(1, 4).Byte(0).Int(kRelationId, 4).Build());
+
+  const auto transaction = decoder.Decode(MakeCommit());
+  ASSERT_TRUE(transaction);
+  ASSERT_EQ(transaction->changes.size(), 2);
+  const auto& tuple = transaction->changes[0].tuple;
+  EXPECT_TRUE(tuple.HasUnchangedToast());
+  EXPECT_EQ(tuple.GetValueKind(1),
+            pg::ReplicationTuple::ValueKind::kUnchangedToast);
+  UEXPECT_THROW(tuple.As<Row>(), pg::ReplicationError);
+
+  EXPECT_EQ(transaction->changes[1].type,
+            pg::ReplicationChange::Type::kTruncate);
+  EXPECT_TRUE(transaction->changes[1].tuple.IsEmpty());
+}
+
+TEST(PostgrePgOutput, Errors) {
+  pg::detail::PgOutputDecoder decoder;
+  const auto insert =
+      MessageBuilder{'I'}.Int(kRelationId, 4).Byte('N').Tuple(1, "a").Build();
+  // Outside of a transaction
+  UEXPECT_THROW(decoder.Decode(insert), pg::ReplicationError);
+
+  decoder.Decode(MakeBegin());
+  // Relation was not described
+  UEXPECT_THROW(decoder.Decode(insert), pg::ReplicationError);
+  UEXPECT_THROW(decoder.Decode(MakeBegin()), pg::ReplicationError);
+
+  decoder.Decode(MakeRelation());
+  UEXPECT_THROW(decoder.Decode(insert.substr(0, insert.size() - 1)),
+                pg::ReplicationError);
+  UEXPECT_THROW(decoder.Decode("?"), pg::ReplicationError);
+}
+
+USERVER_NAMESPACE_END
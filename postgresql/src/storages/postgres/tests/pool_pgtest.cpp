@@ -383,6 +383,72 @@ UTEST_P(PostgrePool, CheckUserTypes) {
       pg::UserTypeError);
 }
 
+UTEST_P(PostgrePool, MultiplexedExecute) {
+  pg::PoolSettings pool_settings{1, 10, 100};
+  pool_settings.multiplexed_connections = 1;
+  pool_settings.max_multiplexed_queries = 16;
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "", GetParam(),
+      pool_settings, kPipelineEnabled, {}, GetTestCmdCtls(), {}, {}, {},
+      dynamic_config::GetDefaultSource());
+
+  constexpr int kTasks = 50;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasks);
+  for (int i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&pool, i] {
+      pg::ParameterStore params;
+      params.PushBack(i);
+      const pg::detail::QueryParameters query_params{params.GetInternalData()};
+      if (i % 10 == 5) {
+        // A failed statement does not affect the other ones in the pipeline
+        UEXPECT_THROW(
+            pool->Execute({}, "select 1 / ($1::integer - $1)", query_params),
+            pg::DataException);
+        return;
+      }
+      pg::ResultSet res{nullptr};
+      UEXPECT_NO_THROW(res = pool->Execute({}, "select $1::integer",
+                                           query_params));
+      ASSERT_EQ(1, res.Size());
+      EXPECT_EQ(i, res.Front().As<int>());
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  const auto& stats = pool->GetStatistics();
+  EXPECT_EQ(1, stats.connection.open_total);
+  EXPECT_EQ(0, stats.connection.drop_total);
+  EXPECT_EQ(0, stats.connection.used);
+}
+
+UTEST_P(PostgrePool, SpareConnectionsUnderBurst) {
+  pg::PoolSettings pool_settings{1, 4, 100};
+  pool_settings.spare_size = 2;
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "", GetParam(),
+      pool_settings, kCachePreparedStatements, {}, GetTestCmdCtls(), {}, {},
+      {}, dynamic_config::GetDefaultSource());
+
+  constexpr int kTasks = 20;
+  std::vector<engine::TaskWithResult<void>> tasks;
+  tasks.reserve(kTasks);
+  for (int i = 0; i < kTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&pool] {
+      pg::detail::ConnectionPtr conn(nullptr);
+      UASSERT_NO_THROW(conn = pool->Acquire(MakeDeadline()));
+      engine::SleepFor(std::chrono::milliseconds{10});
+      CheckConnection(std::move(conn));
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  const auto& stats = pool->GetStatistics();
+  EXPECT_LE(stats.connection.active, 4);
+  EXPECT_EQ(0, stats.connection.used);
+  EXPECT_EQ(0, stats.pool_exhaust_errors);
+}
+
 INSTANTIATE_UTEST_SUITE_P(
     PoolTests, PostgrePool,
     ::testing::Values(pg::InitMode::kAsync, pg::InitMode::kSync),
@@ -0,0 +1,109 @@
+#include <userver/utest/utest.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <storages/postgres/detail/query_result_cache.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+const pg::UserTypes kTypes;
+
+const pg::Query kQuery{"select value from foo where id = $1",
+                       pg::Query::Name{"select_foo"}};
+const std::vector<std::string> kTables{"foo"};
+
+class CountingFetch {
+ public:
+  std::size_t Execute(pg::detail::QueryResultCache& cache, int id) {
+    pg::detail::StaticQueryParameters<1> params;
+    params.Write(kTypes, id);
+    cache.GetOrFetch(kQuery, kTables, pg::detail::QueryParameters{params},
+                     [this] {
+                       ++fetches_;
+                       return pg::ResultSet{nullptr};
+                     });
+    return fetches_;
+  }
+
+ private:
+  std::size_t fetches_{0};
+};
+
+pg::QueryCacheSettings MakeSettings() {
+  pg::QueryCacheSettings settings;
+  settings.max_size = 100;
+  settings.ttl = std::chrono::minutes{1};
+  return settings;
+}
+
+}  // namespace
+
+UTEST(PostgreQueryResultCache, KeyedByArguments) {
+  pg::detail::QueryResultCache cache{MakeSettings()};
+  CountingFetch fetch;
+
+  EXPECT_EQ(fetch.Execute(cache, 1), 1);
+  EXPECT_EQ(fetch.Execute(cache, 1), 1);
+  EXPECT_EQ(fetch.Execute(cache, 2), 2);
+  EXPECT_EQ(fetch.Execute(cache, 2), 2);
+
+  const auto stats = cache.GetStatistics();
+  EXPECT_EQ(stats.total.hits, 2);
+  EXPECT_EQ(stats.total.misses, 2);
+  EXPECT_EQ(stats.size, 2);
+  ASSERT_EQ(stats.queries.count("select_foo"), 1);
+  EXPECT_EQ(stats.queries.at("select_foo").hits, 2);
+  EXPECT_EQ(stats.queries.at("select_foo").misses, 2);
+}
+
+UTEST(PostgreQueryResultCache, Invalidation) {
+  pg::detail::QueryResultCache cache{MakeSettings()};
+  CountingFetch fetch;
+
+  EXPECT_EQ(fetch.Execute(cache, 1), 1);
+  cache.Invalidate("bar");
+  EXPECT_EQ(fetch.Execute(cache, 1), 1);
+  cache.Invalidate("foo");
+  EXPECT_EQ(fetch.Execute(cache, 1), 2);
+  EXPECT_EQ(fetch.Execute(cache, 1), 2);
+  cache.InvalidateAll();
+  EXPECT_EQ(fetch.Execute(cache, 1), 3);
+
+  EXPECT_EQ(cache.GetStatistics().invalidations, 3);
+}
+
+UTEST(PostgreQueryResultCache, InvalidationDuringFetch) {
+  pg::detail::QueryResultCache cache{MakeSettings()};
+  pg::detail::StaticQueryParameters<1> params;
+  params.Write(kTypes, 1);
+
+  // The result could be read before the change, it must not be served
+  cache.GetOrFetch(kQuery, kTables, pg::detail::QueryParameters{params}, [&] {
+    cache.Invalidate("foo");
+    return pg::ResultSet{nullptr};
+  });
+
+  CountingFetch fetch;
+  EXPECT_EQ(fetch.Execute(cache, 1), 1);
+}
+
+UTEST(PostgreQueryResultCache, Ttl) {
+  auto settings = MakeSettings();
+  settings.ttl = std::chrono::milliseconds{1};
+  pg::detail::QueryResultCache cache{settings};
+  CountingFetch fetch;
+
+  EXPECT_EQ(fetch.Execute(cache, 1), 1);
+  engine::SleepFor(std::chrono::milliseconds{10});
+  EXPECT_EQ(fetch.Execute(cache, 1), 2);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,104 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <optional>
+#include <string>
+#include <tuple>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/result_stream.hpp>
+#include <userver/storages/postgres/transaction.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+constexpr int kRowCount = 10'000;
+
+const pg::Query kSelectRows{
+    "select i, case when i % 10 = 0 then null else i::text end "
+    "from generate_series(0, $1 - 1) as i"};
+
+struct IdValue {
+  int id;
+  std::optional<std::string> value;
+};
+
+}  // namespace
+
+UTEST_P(PostgreConnection, ResultStream) {
+  CheckConnection(GetConn());
+  pg::Transaction trx{std::move(GetConn())};
+
+  /// [ResultStream]
+  auto stream = trx.Stream(kSelectRows, kRowCount);
+  int rows = 0;
+  for (const auto& [id, value] : stream.AsStreamOf<IdValue>(pg::kRowTag)) {
+    EXPECT_EQ(id, rows);
+    EXPECT_EQ(value.has_value(), id % 10 != 0);
+    ++rows;
+  }
+  /// [ResultStream]
+  EXPECT_EQ(rows, kRowCount);
+  EXPECT_EQ(stream.RowsRead(), kRowCount);
+  EXPECT_FALSE(stream.Next());
+
+  // The connection is usable again
+  const auto res = trx.Execute("select 1");
+  EXPECT_EQ(res.Front().As<int>(), 1);
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, ResultStreamTypedRows) {
+  CheckConnection(GetConn());
+  pg::Transaction trx{std::move(GetConn())};
+
+  auto stream = trx.Stream("select generate_series(1, 3)");
+  EXPECT_EQ(stream.NextAs<int>(), 1);
+  const auto row = stream.Next();
+  ASSERT_TRUE(row);
+  EXPECT_EQ(row->Size(), 1);
+  EXPECT_EQ(row->Front()[0].As<int>(), 2);
+  EXPECT_EQ(stream.NextAs<std::tuple<int>>(pg::kRowTag), std::tuple<int>{3});
+  EXPECT_FALSE(stream.NextAs<int>());
+
+  auto empty = trx.Stream("select 1 where false");
+  EXPECT_FALSE(empty.Next());
+  trx.Commit();
+}
+
+UTEST_P(PostgreConnection, ResultStreamErrors) {
+  CheckConnection(GetConn());
+
+  {
+    pg::ResultStream stream{GetConn().get(), kSelectRows,
+                            pg::detail::QueryParameters{}, {}};
+    // The parameter is missing
+    UEXPECT_THROW(stream.Next(), pg::Error);
+  }
+  EXPECT_FALSE(GetConn()->IsBroken());
+
+  {
+    pg::Transaction trx{std::move(GetConn())};
+    auto stream = trx.Stream("select 1 / (2 - i) from generate_series(1, 3) i");
+    EXPECT_EQ(stream.NextAs<int>(), 1);
+    UEXPECT_THROW(stream.Next(), pg::DataException);
+    trx.Rollback();
+  }
+}
+
+UTEST_P(PostgreConnection, ResultStreamAbandoned) {
+  CheckConnection(GetConn());
+
+  {
+    pg::ResultStream stream{GetConn().get(), "select generate_series(1, 10)",
+                            pg::detail::QueryParameters{}, {}};
+    EXPECT_EQ(stream.NextAs<int>(), 1);
+    UEXPECT_THROW(GetConn()->Execute("select 1"), pg::ConnectionBusy);
+    // Destroyed before the last row
+  }
+  EXPECT_TRUE(GetConn()->IsBroken());
+}
+
+USERVER_NAMESPACE_END
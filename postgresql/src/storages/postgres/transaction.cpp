@@ -51,6 +51,24 @@ ResultSet Transaction::Execute(OptionalCommandControl statement_cmd_ctl,
                    statement_cmd_ctl);
 }
 
+std::vector<BatchResult> Transaction::ExecuteBatch(const QueryBatch& batch) {
+  std::vector<BatchResult> results;
+  results.reserve(batch.Size());
+  for (const auto& statement : batch.GetStatements()) {
+    try {
+      results.emplace_back(DoExecute(
+          statement.query,
+          detail::QueryParameters{statement.params.GetInternalData()},
+          statement.cmd_ctl));
+    } catch (const NotInTransaction&) {
+      throw;
+    } catch (const std::exception&) {
+      results.emplace_back(std::current_exception());
+    }
+  }
+  return results;
+}
+
 Portal Transaction::MakePortal(OptionalCommandControl statement_cmd_ctl,
                                const Query& query,
                                const ParameterStore& store) {
@@ -100,6 +118,47 @@ Portal Transaction::MakePortal(const PortalName& portal_name,
                 std::move(statement_cmd_ctl)};
 }
 
+CopyWriter Transaction::CopyFrom(OptionalCommandControl statement_cmd_ctl,
+                                 const Query& query) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "CopyFrom called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  if (!statement_cmd_ctl) {
+    statement_cmd_ctl = conn_->GetQueryCmdCtl(query.GetName());
+  }
+  return CopyWriter{conn_.get(), query, std::move(statement_cmd_ctl)};
+}
+
+CopyReader Transaction::CopyTo(OptionalCommandControl statement_cmd_ctl,
+                               const Query& query) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "CopyTo called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  if (!statement_cmd_ctl) {
+    statement_cmd_ctl = conn_->GetQueryCmdCtl(query.GetName());
+  }
+  return CopyReader{conn_.get(), query, std::move(statement_cmd_ctl)};
+}
+
+ResultStream Transaction::DoStream(const Query& query,
+                                   const detail::QueryParameters& params,
+                                   OptionalCommandControl statement_cmd_ctl) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "Stream called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  if (!statement_cmd_ctl) {
+    statement_cmd_ctl = conn_->GetQueryCmdCtl(query.GetName());
+  }
+  return ResultStream{conn_.get(), query, params,
+                      std::move(statement_cmd_ctl)};
+}
+
 void Transaction::SetParameter(const std::string& param_name,
                                const std::string& value) {
   if (!conn_) {
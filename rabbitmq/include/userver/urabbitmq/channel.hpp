@@ -4,6 +4,8 @@
 /// @brief Publisher interface for the broker.
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <userver/utils/fast_pimpl.hpp>
 
@@ -77,6 +79,14 @@ class ReliableChannel final : IReliableChannelInterface {
                     deadline);
   }
 
+  /// @brief Reliably publishes a batch of messages with the same routing key.
+  ///
+  /// @see Client::PublishReliableBatch
+  void PublishReliableBatch(const Exchange& exchange,
+                            const std::string& routing_key,
+                            const std::vector<std::string>& messages,
+                            MessageType type, engine::Deadline deadline);
+
  private:
   utils::FastPimpl<ConnectionPtr, 32, 8> impl_;
 };
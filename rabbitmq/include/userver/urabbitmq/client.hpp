@@ -4,6 +4,8 @@
 /// @brief @copybrief urabbitmq::Client
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/utils/fast_pimpl.hpp>
@@ -101,6 +103,24 @@ class Client : public std::enable_shared_from_this<Client>,
                     deadline);
   }
 
+  /// @brief Reliably publishes a batch of messages with the same routing key,
+  /// sending them all at once and waiting for the confirms of all of them.
+  ///
+  /// Saves a round-trip to the broker per message compared to
+  /// PublishReliable for each one of them. If any of the messages is not
+  /// confirmed an exception is thrown, some of the messages might have been
+  /// published still.
+  ///
+  /// @param exchange exchange to publish to
+  /// @param routing_key routing key of the messages
+  /// @param messages messages to publish, may not be empty
+  /// @param type type of the messages
+  /// @param deadline deadline of the whole operation
+  void PublishReliableBatch(const Exchange& exchange,
+                            const std::string& routing_key,
+                            const std::vector<std::string>& messages,
+                            MessageType type, engine::Deadline deadline);
+
   /// @brief Get a reliable publisher interface for the broker
   /// (publisher-confirms)
   ///
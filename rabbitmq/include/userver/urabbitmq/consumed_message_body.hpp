@@ -0,0 +1,60 @@
+#pragma once
+
+/// @file userver/urabbitmq/consumed_message_body.hpp
+/// @brief @copybrief urabbitmq::ConsumedMessageBody
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace urabbitmq {
+
+/// @brief Body of a consumed message.
+///
+/// Large bodies are not copied out of the connection read buffer, a part of
+/// the buffer is kept alive until the message is processed and acked.
+/// Do not keep the body after ConsumerBase::ProcessBody returns, that
+/// prevents the buffer from being reused.
+class ConsumedMessageBody final {
+ public:
+  ConsumedMessageBody() = default;
+
+  /// Takes ownership of the body
+  explicit ConsumedMessageBody(std::string body) noexcept
+      : owned_(std::move(body)) {}
+
+  /// References the body in a buffer kept alive by `buffer`
+  ConsumedMessageBody(std::shared_ptr<const void> buffer,
+                      std::string_view body) noexcept
+      : buffer_(std::move(buffer)), view_(body) {}
+
+  ConsumedMessageBody(ConsumedMessageBody&&) noexcept = default;
+  ConsumedMessageBody& operator=(ConsumedMessageBody&&) noexcept = default;
+
+  /// @returns the message body, valid while `*this` is alive
+  std::string_view GetView() const noexcept {
+    return buffer_ ? view_ : std::string_view{owned_};
+  }
+
+  /// @returns whether the body references the connection read buffer
+  bool IsInPlace() const noexcept { return buffer_ != nullptr; }
+
+  /// @returns the body as a string, copies it only if it is in place
+  std::string ExtractString() && {
+    if (!buffer_) return std::move(owned_);
+    std::string result{view_};
+    buffer_.reset();
+    return result;
+  }
+
+ private:
+  std::string owned_;
+  std::shared_ptr<const void> buffer_;
+  std::string_view view_;
+};
+
+}  // namespace urabbitmq
+
+USERVER_NAMESPACE_END
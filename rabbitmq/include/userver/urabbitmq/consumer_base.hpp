@@ -7,6 +7,7 @@
 
 #include <userver/utils/periodic_task.hpp>
 
+#include <userver/urabbitmq/consumed_message_body.hpp>
 #include <userver/urabbitmq/consumer_settings.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -68,7 +69,14 @@ class ConsumerBase {
   /// that `ack` ever reached the broker (network issues or unexpected shutdown,
   /// for example).
   /// It is however guaranteed for message to be requeued if `Process` fails.
-  virtual void Process(std::string message) = 0;
+  virtual void Process(std::string message);
+
+  /// @brief Override this method instead of `Process` to handle the message
+  /// without copying it out of the connection read buffer.
+  ///
+  /// The same rules as for `Process` apply. By default copies the body and
+  /// calls `Process`.
+  virtual void ProcessBody(ConsumedMessageBody body);
 
  private:
   std::shared_ptr<Client> client_;
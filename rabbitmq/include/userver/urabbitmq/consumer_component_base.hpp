@@ -6,6 +6,7 @@
 #include <memory>
 
 #include <userver/components/loggable_component_base.hpp>
+#include <userver/urabbitmq/consumed_message_body.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -64,7 +65,14 @@ class ConsumerComponentBase : public components::LoggableComponentBase {
   /// that `ack` ever reached the broker (network issues or unexpected shutdown,
   /// for example).
   /// It is however guaranteed for message to be requeued if `Process` fails.
-  virtual void Process(std::string message) = 0;
+  virtual void Process(std::string message);
+
+  /// @brief Override this method instead of `Process` to handle the message
+  /// without copying it out of the connection read buffer.
+  ///
+  /// The same rules as for `Process` apply. By default copies the body and
+  /// calls `Process`.
+  virtual void ProcessBody(ConsumedMessageBody body);
 
  private:
   // This is actually just a subclass of `ConsumerBase`
@@ -24,6 +24,12 @@ struct ConsumerSettings final {
   /// Settings this value to 1 basically makes a consumer synchronous, which
   /// could be of use for some workloads
   std::uint16_t prefetch_count;
+
+  /// Upper limit for the prefetch_count tuned at runtime. If greater than
+  /// `prefetch_count`, the consumer starts with `prefetch_count` and keeps
+  /// doubling it while the average processing time of a message doesn't
+  /// climb, which suits I/O-bound processing. Zero disables the tuning.
+  std::uint16_t max_prefetch_count{0};
 };
 
 }  // namespace urabbitmq
@@ -1,6 +1,8 @@
 #include "utils_rmqtest.hpp"
 
+#include <algorithm>
 #include <optional>
+#include <utility>
 
 #include <userver/engine/sleep.hpp>
 #include <userver/utils/uuid4.hpp>
@@ -49,6 +51,38 @@ class Consumer final : public urabbitmq::ConsumerBase {
   engine::SingleConsumerEvent event_;
 };
 
+class BodyConsumer final : public urabbitmq::ConsumerBase {
+ public:
+  using urabbitmq::ConsumerBase::ConsumerBase;
+  ~BodyConsumer() override { Stop(); }
+
+  void ProcessBody(urabbitmq::ConsumedMessageBody body) override {
+    {
+      auto locked = messages_.Lock();
+      locked->emplace_back(body.GetView(), body.IsInPlace());
+    }
+
+    if (++consumed_ == expected_consumed_) {
+      event_.Send();
+    }
+  }
+
+  void ExpectConsume(size_t count) { expected_consumed_ = count; }
+
+  // (body, in place)
+  std::vector<std::pair<std::string, bool>> Wait() {
+    [[maybe_unused]] auto res = event_.WaitForEventFor(utest::kMaxTestWaitTime);
+    auto locked = messages_.Lock();
+    return *locked;
+  }
+
+ private:
+  concurrent::Variable<std::vector<std::pair<std::string, bool>>> messages_;
+  std::atomic<size_t> expected_consumed_{0};
+  std::atomic<size_t> consumed_{0};
+  engine::SingleConsumerEvent event_;
+};
+
 class ThrowingConsumer final : public urabbitmq::ConsumerBase {
  public:
   using urabbitmq::ConsumerBase::ConsumerBase;
@@ -150,6 +184,84 @@ UTEST(Consumer, ExhaustesQueue) {
   consumer.Wait();
 }
 
+UTEST(Consumer, ConsumesReliableBatch) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+  const urabbitmq::ConsumerSettings settings{client.GetQueue(), 10};
+
+  const size_t messages_count = 1000;
+  std::vector<std::string> messages;
+  messages.reserve(messages_count);
+  for (size_t i = 0; i < messages_count; ++i) {
+    messages.push_back(std::to_string(i));
+  }
+  client->PublishReliableBatch(client.GetExchange(), client.GetRoutingKey(),
+                               messages, urabbitmq::MessageType::kTransient,
+                               client.GetDeadline());
+
+  Consumer consumer{client.Get(), settings};
+  consumer.ExpectConsume(messages_count);
+  consumer.Start();
+
+  auto consumed = consumer.Wait();
+  std::sort(consumed.begin(), consumed.end());
+  std::sort(messages.begin(), messages.end());
+  EXPECT_EQ(consumed, messages);
+}
+
+UTEST(Consumer, ConsumesLargeMessagesInPlace) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+  const urabbitmq::ConsumerSettings settings{client.GetQueue(), 10};
+
+  // Fits into a single frame, so the body is not copied
+  const std::string large_message(64 * 1024, 'a');
+  const std::string small_message = "Hi from userver!";
+  const size_t messages_count = 20;
+  for (size_t i = 0; i < messages_count; ++i) {
+    client->PublishReliable(client.GetExchange(), client.GetRoutingKey(),
+                            i % 2 ? large_message : small_message,
+                            urabbitmq::MessageType::kTransient,
+                            client.GetDeadline());
+  }
+
+  BodyConsumer consumer{client.Get(), settings};
+  consumer.ExpectConsume(messages_count);
+  consumer.Start();
+
+  const auto consumed = consumer.Wait();
+  ASSERT_EQ(consumed.size(), messages_count);
+  for (const auto& [body, in_place] : consumed) {
+    if (body.size() == large_message.size()) {
+      EXPECT_EQ(body, large_message);
+      EXPECT_TRUE(in_place);
+    } else {
+      EXPECT_EQ(body, small_message);
+      EXPECT_FALSE(in_place);
+    }
+  }
+}
+
+UTEST(Consumer, ExhaustesQueueWithPrefetchTuning) {
+  ClientWrapper client{};
+  client.SetupRmqEntities();
+  const urabbitmq::ConsumerSettings settings{client.GetQueue(), 2, 64};
+
+  const size_t messages_count = 1000;
+  for (size_t i = 0; i < messages_count; ++i) {
+    client->PublishReliable(client.GetExchange(), client.GetRoutingKey(),
+                            std::to_string(i),
+                            urabbitmq::MessageType::kTransient,
+                            client.GetDeadline());
+  }
+
+  Consumer consumer{client.Get(), settings};
+  consumer.ExpectConsume(messages_count);
+  consumer.Start();
+
+  EXPECT_EQ(consumer.Wait().size(), messages_count);
+}
+
 UTEST(Consumer, ThrowsReturnsToQueue) {
   ClientWrapper client{};
   client.SetupRmqEntities();
@@ -1,5 +1,7 @@
 #include <userver/urabbitmq/channel.hpp>
 
+#include <userver/utils/assert.hpp>
+
 #include <urabbitmq/connection_helper.hpp>
 #include <urabbitmq/connection_ptr.hpp>
 
@@ -44,6 +46,17 @@ void ReliableChannel::PublishReliable(const Exchange& exchange,
       .Wait(deadline);
 }
 
+void ReliableChannel::PublishReliableBatch(
+    const Exchange& exchange, const std::string& routing_key,
+    const std::vector<std::string>& messages, MessageType type,
+    engine::Deadline deadline) {
+  UINVARIANT(!messages.empty(), "Empty batch to publish");
+
+  ConnectionHelper::PublishReliableBatch(*impl_, exchange, routing_key,
+                                         messages, type, deadline)
+      .Wait(deadline);
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #include <userver/urabbitmq/client.hpp>
 
 #include <userver/formats/json/value.hpp>
+#include <userver/utils/assert.hpp>
 
 #include <userver/urabbitmq/admin_channel.hpp>
 #include <userver/urabbitmq/channel.hpp>
@@ -87,6 +88,18 @@ void Client::PublishReliable(const Exchange& exchange,
   awaiter.Wait(deadline);
 }
 
+void Client::PublishReliableBatch(const Exchange& exchange,
+                                  const std::string& routing_key,
+                                  const std::vector<std::string>& messages,
+                                  MessageType type, engine::Deadline deadline) {
+  UINVARIANT(!messages.empty(), "Empty batch to publish");
+
+  auto awaiter = ConnectionHelper::PublishReliableBatch(
+      impl_->GetConnection(deadline), exchange, routing_key, messages, type,
+      deadline);
+  awaiter.Wait(deadline);
+}
+
 AdminChannel Client::GetAdminChannel(engine::Deadline deadline) {
   return {impl_->GetConnection(deadline)};
 }
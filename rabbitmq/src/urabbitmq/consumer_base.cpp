@@ -3,6 +3,7 @@
 #include <userver/engine/async.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/urabbitmq/client.hpp>
+#include <userver/utils/assert.hpp>
 
 #include <urabbitmq/client_impl.hpp>
 #include <urabbitmq/consumer_base_impl.hpp>
@@ -51,7 +52,7 @@ void ConsumerBase::Start() {
   try {
     impl_ = CreateAndStartConsumerImpl(
         *client_->impl_, settings_,
-        [this](std::string message) { Process(std::move(message)); });
+        [this](ConsumedMessageBody body) { ProcessBody(std::move(body)); });
   } catch (const std::exception& ex) {
     LOG_WARNING() << "Failed to start a consumer: '" << ex.what()
                   << "'; will try to start again";
@@ -71,8 +72,9 @@ void ConsumerBase::Start() {
             // that is, but still
             impl_.reset();
             impl_ = CreateAndStartConsumerImpl(
-                *client_->impl_, settings_,
-                [this](std::string message) { Process(std::move(message)); });
+                *client_->impl_, settings_, [this](ConsumedMessageBody body) {
+                  ProcessBody(std::move(body));
+                });
             LOG_INFO() << "Restarted successfully";
           } catch (const std::exception& ex) {
             LOG_WARNING() << "Failed to restart a consumer: '" << ex.what()
@@ -87,6 +89,14 @@ void ConsumerBase::Stop() {
   impl_.reset();
 }
 
+void ConsumerBase::Process(std::string) {
+  UINVARIANT(false, "Either Process or ProcessBody should be overridden");
+}
+
+void ConsumerBase::ProcessBody(ConsumedMessageBody body) {
+  Process(std::move(body).ExtractString());
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include "consumer_base_impl.hpp"
 
+#include <algorithm>
+#include <mutex>
 #include <string>
 
 #include <fmt/format.h>
@@ -20,6 +22,10 @@ namespace urabbitmq {
 namespace {
 
 constexpr std::chrono::milliseconds kStartTimeout{2000};
+constexpr std::chrono::milliseconds kSetQosTimeout{2000};
+
+// Processing time growing over this ratio stops prefetch_count growth
+constexpr double kMaxProcessingTimeGrowth = 1.5;
 
 }  // namespace
 
@@ -27,6 +33,9 @@ ConsumerBaseImpl::ConsumerBaseImpl(ConnectionPtr&& connection,
                                    const ConsumerSettings& settings)
     : dispatcher_{engine::current_task::GetTaskProcessor()},
       queue_name_{settings.queue.GetUnderlying()},
+      min_prefetch_count_{settings.prefetch_count},
+      max_prefetch_count_{
+          std::max(settings.prefetch_count, settings.max_prefetch_count)},
       prefetch_count_{settings.prefetch_count},
       connection_ptr_{std::move(connection)},
       channel_{connection_ptr_->GetChannel()} {
@@ -39,7 +48,9 @@ ConsumerBaseImpl::~ConsumerBaseImpl() { Stop(); }
 
 void ConsumerBaseImpl::Start(DispatchCallback cb) {
   const auto start_deadline = engine::Deadline::FromDuration(kStartTimeout);
-  channel_.SetQos(prefetch_count_, start_deadline);
+  // The consumer takes the channel for itself, but only the global limit could
+  // be changed once the consumption is started
+  channel_.SetQos(prefetch_count_, start_deadline, IsTuningEnabled());
 
   dispatch_callback_ = std::move(cb);
 
@@ -96,38 +107,137 @@ void ConsumerBaseImpl::OnMessage(const AMQP::Message& message,
   std::string span_name{fmt::format("consume_{}_{}", queue_name_,
                                     consumer_tag_.value_or("ctag:unknown"))};
   std::string trace_id = message.headers().get("u-trace-id");
-  std::string message_data{message.body(), message.bodySize()};
+  // References the message in the read buffer until it is processed
+  auto body = channel_.MakeMessageBody(message);
+
+  if (first_delivery_tag_.load() == 0) first_delivery_tag_ = delivery_tag;
 
   bts_.Detach(engine::AsyncNoSpan(
-      dispatcher_, [this, message = std::move(message_data),
+      dispatcher_, [this, body = std::move(body),
                     span_name = std::move(span_name),
                     trace_id = std::move(trace_id), delivery_tag]() mutable {
         auto span = tracing::Span::MakeSpan(std::move(span_name), trace_id, {});
 
+        const auto start = std::chrono::steady_clock::now();
         bool success = false;
         try {
-          dispatch_callback_(std::move(message));
+          dispatch_callback_(std::move(body));
           success = true;
         } catch (const std::exception& ex) {
           LOG_ERROR() << "Failed to process the consumed message, " << ex.what()
                       << "; would requeue";
         }
 
-        try {
-          if (success) {
-            channel_.Ack(delivery_tag, {});
-            channel_.AccountMessageConsumed();
-          } else {
-            channel_.Reject(delivery_tag, true, {});
-          }
-        } catch (const std::exception& ex) {
-          LOG_WARNING()
-              << "Failed to " << (success ? "ack" : "requeue")
-              << " the message, it will be requeued by RabbitMQ at some point";
-        }
+        OnProcessed(delivery_tag, success,
+                    std::chrono::steady_clock::now() - start);
       }));
 }
 
+void ConsumerBaseImpl::OnProcessed(
+    uint64_t delivery_tag, bool success,
+    std::chrono::steady_clock::duration processing_time) {
+  channel_.AccountMessageProcessed(
+      std::chrono::duration_cast<std::chrono::milliseconds>(processing_time));
+
+  std::optional<uint16_t> new_prefetch_count;
+  {
+    std::lock_guard lock{acks_mutex_};
+    if (settled_up_to_ == 0) settled_up_to_ = first_delivery_tag_.load() - 1;
+
+    try {
+      if (success) {
+        processed_.emplace(delivery_tag, true);
+        ++deferred_acks_;
+        channel_.AccountMessageConsumed();
+      } else {
+        processed_.emplace(delivery_tag, false);
+        channel_.Reject(delivery_tag, true, {});
+      }
+      AckProcessed();
+    } catch (const std::exception& ex) {
+      LOG_WARNING()
+          << "Failed to " << (success ? "ack" : "requeue")
+          << " the message, it will be requeued by RabbitMQ at some point";
+    }
+
+    new_prefetch_count = TunePrefetch(processing_time);
+  }
+
+  if (new_prefetch_count.has_value()) {
+    try {
+      channel_.SetQos(*new_prefetch_count,
+                      engine::Deadline::FromDuration(kSetQosTimeout), true);
+      LOG_INFO() << "Set prefetch_count of the consumer for '" << queue_name_
+                 << "' queue to " << *new_prefetch_count;
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "Failed to set prefetch_count of the consumer: " << ex;
+    }
+  }
+}
+
+void ConsumerBaseImpl::AckProcessed() {
+  // Settle the processed messages right after the settled ones
+  std::optional<uint64_t> ack_up_to;
+  auto it = processed_.begin();
+  for (; it != processed_.end() && it->first == settled_up_to_ + 1; ++it) {
+    if (it->second) {
+      ack_up_to = it->first;
+      --deferred_acks_;
+    }
+    ++settled_up_to_;
+  }
+  processed_.erase(processed_.begin(), it);
+  if (ack_up_to.has_value()) channel_.Ack(*ack_up_to, {}, true);
+
+  // A long processing of a single message shouldn't hold the acks of the rest
+  // of the window, otherwise the broker stops delivering
+  if (deferred_acks_ * 2 >= prefetch_count_) {
+    for (auto& [tag, should_ack] : processed_) {
+      if (!should_ack) continue;
+      channel_.Ack(tag, {});
+      should_ack = false;
+    }
+    deferred_acks_ = 0;
+  }
+}
+
+bool ConsumerBaseImpl::IsTuningEnabled() const {
+  return max_prefetch_count_ > min_prefetch_count_;
+}
+
+std::optional<uint16_t> ConsumerBaseImpl::TunePrefetch(
+    std::chrono::steady_clock::duration processing_time) {
+  if (tuning_finished_ || !IsTuningEnabled()) {
+    return std::nullopt;
+  }
+
+  tuning_window_time_ += processing_time;
+  if (++tuning_window_messages_ < prefetch_count_) return std::nullopt;
+
+  const auto average_time = tuning_window_time_ / tuning_window_messages_;
+  tuning_window_messages_ = 0;
+  tuning_window_time_ = {};
+
+  if (!baseline_processing_time_.has_value()) {
+    baseline_processing_time_ = average_time;
+  } else if (average_time >
+             *baseline_processing_time_ * kMaxProcessingTimeGrowth) {
+    // The processing is saturated, step back and stay there
+    tuning_finished_ = true;
+    prefetch_count_ = std::max<uint16_t>(prefetch_count_ / 2,
+                                         min_prefetch_count_);
+    return prefetch_count_;
+  }
+
+  if (prefetch_count_ >= max_prefetch_count_) {
+    tuning_finished_ = true;
+    return std::nullopt;
+  }
+  prefetch_count_ = static_cast<uint16_t>(
+      std::min<size_t>(size_t{prefetch_count_} * 2, max_prefetch_count_));
+  return prefetch_count_;
+}
+
 }  // namespace urabbitmq
 
 USERVER_NAMESPACE_END
@@ -1,12 +1,17 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <map>
+#include <optional>
 
 #include <userver/concurrent/background_task_storage.hpp>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 
 #include <urabbitmq/connection_ptr.hpp>
 
+#include <userver/urabbitmq/consumed_message_body.hpp>
 #include <userver/urabbitmq/consumer_settings.hpp>
 
 #include <amqpcpp.h>
@@ -25,7 +30,7 @@ class ConsumerBaseImpl final {
                    const ConsumerSettings& settings);
   ~ConsumerBaseImpl();
 
-  using DispatchCallback = std::function<void(std::string message)>;
+  using DispatchCallback = std::function<void(ConsumedMessageBody body)>;
 
   void Start(DispatchCallback cb);
 
@@ -33,11 +38,37 @@ class ConsumerBaseImpl final {
 
  private:
   void OnMessage(const AMQP::Message& message, uint64_t delivery_tag);
+  void OnProcessed(uint64_t delivery_tag, bool success,
+                   std::chrono::steady_clock::duration processing_time);
   void Stop();
 
+  bool IsTuningEnabled() const;
+
+  // Should be called with acks_mutex_ held
+  void AckProcessed();
+  std::optional<uint16_t> TunePrefetch(
+      std::chrono::steady_clock::duration processing_time);
+
   engine::TaskProcessor& dispatcher_;
   const std::string queue_name_;
+  const uint16_t min_prefetch_count_;
+  const uint16_t max_prefetch_count_;
+
+  // Delivery tags of a channel go one after another, so successfully
+  // processed messages are acked with a single ack for all of them as soon as
+  // every preceding message is processed
+  engine::Mutex acks_mutex_;
+  std::atomic<uint64_t> first_delivery_tag_{0};
+  uint64_t settled_up_to_{0};
+  // processed messages after settled_up_to_, true for the ones to be acked
+  std::map<uint64_t, bool> processed_;
+  size_t deferred_acks_{0};
+
   uint16_t prefetch_count_;
+  size_t tuning_window_messages_{0};
+  std::chrono::steady_clock::duration tuning_window_time_{};
+  std::optional<std::chrono::steady_clock::duration> baseline_processing_time_;
+  bool tuning_finished_{false};
 
   ConnectionPtr connection_ptr_;
   impl::AmqpChannel& channel_;
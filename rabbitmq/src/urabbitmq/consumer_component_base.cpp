@@ -17,6 +17,9 @@ ConsumerSettings Parse(const yaml_config::YamlConfig& config,
   settings.queue = Queue{config["queue"].As<std::string>()};
   settings.prefetch_count = config["prefetch_count"].As<uint16_t>();
 
+  settings.max_prefetch_count =
+      config["max_prefetch_count"].As<uint16_t>(0);
+
   UINVARIANT(settings.prefetch_count > 0, "prefetch_count is set to zero");
 
   return settings;
@@ -35,9 +38,9 @@ class ConsumerComponentBase::Impl final : public ConsumerBase {
   }
 
  protected:
-  void Process(std::string message) override {
+  void ProcessBody(ConsumedMessageBody body) override {
     UASSERT(parent_ != nullptr);
-    parent_->Process(std::move(message));
+    parent_->ProcessBody(std::move(body));
   }
 
  private:
@@ -61,6 +64,14 @@ void ConsumerComponentBase::OnAllComponentsLoaded() { impl_->Start(this); }
 
 void ConsumerComponentBase::OnAllComponentsAreStopping() { impl_->Stop(); }
 
+void ConsumerComponentBase::Process(std::string) {
+  UINVARIANT(false, "Either Process or ProcessBody should be overridden");
+}
+
+void ConsumerComponentBase::ProcessBody(ConsumedMessageBody body) {
+  Process(std::move(body).ExtractString());
+}
+
 yaml_config::Schema ConsumerComponentBase::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
 type: object
@@ -76,6 +87,12 @@ properties:
     prefetch_count:
         type: integer
         description: prefetch_count for the consumer
+    max_prefetch_count:
+        type: integer
+        description: |
+            upper limit for prefetch_count tuned by the processing time,
+            0 disables the tuning
+        defaultDescription: 0
 )");
 }
 
@@ -1,9 +1,11 @@
 #include "amqp_channel.hpp"
 
+#include <atomic>
 #include <optional>
 
 #include <userver/engine/task/task.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/utils/scope_guard.hpp>
 
 #include <urabbitmq/impl/amqp_connection.hpp>
 #include <urabbitmq/impl/deferred_wrapper.hpp>
@@ -180,10 +182,11 @@ void AmqpChannel::Publish(const Exchange& exchange,
   // We don't account publish here, because there's no way to ensure success
 }
 
-void AmqpChannel::Ack(uint64_t delivery_tag, engine::Deadline deadline) {
+void AmqpChannel::Ack(uint64_t delivery_tag, engine::Deadline deadline,
+                      bool multiple) {
   // No way to acknowledge success, no way to handle synchronous errors
   auto channel = conn_.GetChannel(deadline);
-  channel->ack(delivery_tag);
+  channel->ack(delivery_tag, multiple ? AMQP::multiple : 0);
 }
 
 void AmqpChannel::Reject(uint64_t delivery_tag, bool requeue,
@@ -193,12 +196,13 @@ void AmqpChannel::Reject(uint64_t delivery_tag, bool requeue,
   channel->reject(delivery_tag, requeue ? AMQP::requeue : 0);
 }
 
-void AmqpChannel::SetQos(uint16_t prefetch_count, engine::Deadline deadline) {
+void AmqpChannel::SetQos(uint16_t prefetch_count, engine::Deadline deadline,
+                         bool global) {
   auto deferred = DeferredWrapper::Create();
 
   {
     auto channel = conn_.GetChannel(deadline);
-    deferred->Wrap(channel->setQos(prefetch_count));
+    deferred->Wrap(channel->setQos(prefetch_count, global));
   }
 
   deferred->Wait(deadline);
@@ -229,6 +233,23 @@ void AmqpChannel::AccountMessageConsumed() {
   conn_.GetStatistics().AccountMessageConsumed();
 }
 
+void AmqpChannel::AccountMessageProcessed(
+    std::chrono::milliseconds processing_time) {
+  conn_.GetStatistics().AccountMessageProcessed(processing_time);
+}
+
+ConsumedMessageBody AmqpChannel::MakeMessageBody(
+    const AMQP::Message& message) {
+  const std::string_view data{message.body(),
+                              static_cast<std::size_t>(message.bodySize())};
+  // Bodies that came in a single frame point into the read buffer
+  if (auto buffer = conn_.TryReferenceReadBuffer(data)) {
+    conn_.GetStatistics().AccountMessageConsumedInPlace();
+    return ConsumedMessageBody{std::move(buffer), data};
+  }
+  return ConsumedMessageBody{std::string{data}};
+}
+
 AmqpReliableChannel::AmqpReliableChannel(AmqpConnection& conn) : conn_{conn} {}
 
 AmqpReliableChannel::~AmqpReliableChannel() = default;
@@ -260,6 +281,43 @@ ResponseAwaiter AmqpReliableChannel::Publish(const Exchange& exchange,
   return awaiter;
 }
 
+ResponseAwaiter AmqpReliableChannel::PublishBatch(
+    const Exchange& exchange, const std::string& routing_key,
+    const std::vector<std::string>& messages, MessageType type,
+    engine::Deadline deadline) {
+  UASSERT(!messages.empty());
+
+  const auto headers = CreateHeaders();
+  auto awaiter = conn_.GetAwaiter(deadline);
+  auto unconfirmed = std::make_shared<std::atomic<size_t>>(messages.size());
+
+  {
+    auto reliable = conn_.GetReliableChannel(deadline);
+
+    conn_.Cork();
+    const utils::ScopeGuard uncork{[this] { conn_.Uncork(); }};
+
+    for (const auto& message : messages) {
+      AMQP::Envelope envelope{message.data(), message.size()};
+      envelope.setPersistent(type == MessageType::kPersistent);
+      envelope.setHeaders(headers);
+
+      // AMQP::Reliable tracks the delivery tags, including the acks of
+      // multiple messages at once
+      reliable->publish(exchange.GetUnderlying(), routing_key, envelope)
+          .onAck([this, unconfirmed, deferred = awaiter.GetWrapper()] {
+            AccountMessagePublished();
+            if (--*unconfirmed == 0) deferred->Ok();
+          })
+          .onError([deferred = awaiter.GetWrapper()](const char* error) {
+            deferred->Fail(error);
+          });
+    }
+  }
+
+  return awaiter;
+}
+
 void AmqpReliableChannel::AccountMessagePublished() {
   conn_.GetStatistics().AccountMessagePublished();
 }
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <vector>
 
 #include <userver/engine/deadline.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <userver/urabbitmq/consumed_message_body.hpp>
 #include <userver/urabbitmq/typedefs.hpp>
 #include <userver/utils/flags.hpp>
 
@@ -57,11 +60,15 @@ class AmqpChannel final {
                const std::string& message, MessageType type,
                engine::Deadline deadline);
 
-  void Ack(uint64_t delivery_tag, engine::Deadline deadline);
+  void Ack(uint64_t delivery_tag, engine::Deadline deadline,
+           bool multiple = false);
 
   void Reject(uint64_t delivery_tag, bool requeue, engine::Deadline deadline);
 
-  void SetQos(uint16_t prefetch_count, engine::Deadline deadline);
+  // A global limit is shared by the consumers of the channel and also applies
+  // to the already started ones
+  void SetQos(uint16_t prefetch_count, engine::Deadline deadline,
+              bool global = false);
 
   using ErrorCb = std::function<void(const char*)>;
   using SuccessCb = std::function<void(const std::string&)>;
@@ -74,6 +81,10 @@ class AmqpChannel final {
 
  private:
   void AccountMessageConsumed();
+  void AccountMessageProcessed(std::chrono::milliseconds processing_time);
+
+  // Takes the body of a message from the consumer callback
+  ConsumedMessageBody MakeMessageBody(const AMQP::Message& message);
 
   friend class urabbitmq::ConsumerBaseImpl;
 
@@ -90,6 +101,13 @@ class AmqpReliableChannel final {
                           const std::string& message, MessageType type,
                           engine::Deadline deadline);
 
+  // The whole batch is sent with a single write and is awaited as a single
+  // operation, which completes when all the messages are confirmed
+  ResponseAwaiter PublishBatch(const Exchange& exchange,
+                               const std::string& routing_key,
+                               const std::vector<std::string>& messages,
+                               MessageType type, engine::Deadline deadline);
+
  private:
   void AccountMessagePublished();
 
@@ -74,6 +74,11 @@ statistics::ConnectionStatistics& AmqpConnection::GetStatistics() {
   return handler_.GetStatistics();
 }
 
+std::shared_ptr<const void> AmqpConnection::TryReferenceReadBuffer(
+    std::string_view data) {
+  return handler_.TryReferenceReadBuffer(data);
+}
+
 LockedChannelProxy<AMQP::Channel> AmqpConnection::GetChannel(
     engine::Deadline deadline) {
   return DoGetChannel(channel_, deadline);
@@ -94,6 +99,10 @@ ResponseAwaiter AmqpConnection::GetAwaiter(engine::Deadline deadline) {
   return ResponseAwaiter{std::move(lock)};
 }
 
+void AmqpConnection::Cork() { handler_.Cork(); }
+
+void AmqpConnection::Uncork() { handler_.Uncork(&conn_); }
+
 ConnectionLock AmqpConnection::Lock(engine::Deadline deadline) {
   return {mutex_, deadline};
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <memory>
+#include <string_view>
+
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/engine/semaphore.hpp>
@@ -59,6 +62,9 @@ class AmqpConnection final {
 
   statistics::ConnectionStatistics& GetStatistics();
 
+  // Should only be called from the consumer callbacks
+  std::shared_ptr<const void> TryReferenceReadBuffer(std::string_view data);
+
   LockedChannelProxy<AMQP::Channel> GetChannel(engine::Deadline deadline);
 
   using ReliableChannel = AMQP::Reliable<AMQP::Tagger>;
@@ -67,6 +73,11 @@ class AmqpConnection final {
 
   ResponseAwaiter GetAwaiter(engine::Deadline deadline);
 
+  // Data sent between these calls goes into socket with a single write,
+  // they are expected to be called with a channel acquired
+  void Cork();
+  void Uncork();
+
  private:
   friend class AmqpConnectionLocker;
   [[nodiscard]] ConnectionLock Lock(engine::Deadline deadline);
@@ -92,6 +92,16 @@ void AmqpConnectionHandler::onData(AMQP::Connection* connection,
     return;
   }
 
+  if (corked_) {
+    corked_data_.append(buffer, size);
+    return;
+  }
+
+  Write(connection, buffer, size);
+}
+
+void AmqpConnectionHandler::Write(AMQP::Connection* connection,
+                                  const char* buffer, size_t size) {
   try {
     const auto sent = socket_->WriteAll(buffer, size, operation_deadline_);
     if (sent != size) {
@@ -160,6 +170,11 @@ void AmqpConnectionHandler::AccountRead(size_t size) {
   stats_.AccountRead(size);
 }
 
+std::shared_ptr<const void> AmqpConnectionHandler::TryReferenceReadBuffer(
+    std::string_view data) {
+  return reader_.TryReference(data);
+}
+
 void AmqpConnectionHandler::AccountWrite(size_t size) {
   stats_.AccountWrite(size);
 }
@@ -168,6 +183,16 @@ void AmqpConnectionHandler::SetOperationDeadline(engine::Deadline deadline) {
   operation_deadline_ = deadline;
 }
 
+void AmqpConnectionHandler::Cork() { corked_ = true; }
+
+void AmqpConnectionHandler::Uncork(AMQP::Connection* connection) {
+  corked_ = false;
+  if (!corked_data_.empty() && !IsBroken()) {
+    Write(connection, corked_data_.data(), corked_data_.size());
+  }
+  corked_data_.clear();
+}
+
 statistics::ConnectionStatistics& AmqpConnectionHandler::GetStatistics() {
   return stats_;
 }
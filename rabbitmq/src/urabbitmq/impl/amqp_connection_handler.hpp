@@ -4,6 +4,7 @@
 #include <optional>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
 #include <userver/engine/single_consumer_event.hpp>
@@ -69,14 +70,24 @@ class AmqpConnectionHandler final : public AMQP::ConnectionHandler {
 
   void SetOperationDeadline(engine::Deadline deadline);
 
+  // While corked the outgoing data is gathered and then sent with a single
+  // write on Uncork. Both are expected to be called under connection lock.
+  void Cork();
+  void Uncork(AMQP::Connection* connection);
+
   void AccountRead(size_t size);
   void AccountWrite(size_t size);
 
+  // See io::SocketReader::TryReference
+  std::shared_ptr<const void> TryReferenceReadBuffer(std::string_view data);
+
   statistics::ConnectionStatistics& GetStatistics();
 
   const AMQP::Address& GetAddress() const;
 
  private:
+  void Write(AMQP::Connection* connection, const char* buffer, size_t size);
+
   AMQP::Address address_;
   std::unique_ptr<engine::io::RwBase> socket_;
   io::SocketReader reader_;
@@ -88,6 +99,9 @@ class AmqpConnectionHandler final : public AMQP::ConnectionHandler {
 
   engine::Deadline operation_deadline_ = engine::Deadline::Passed();
 
+  bool corked_{false};
+  std::string corked_data_;
+
   std::atomic<bool> is_ready_{false};
   std::optional<std::string> error_;
 };
@@ -1,20 +1,38 @@
 #include "socket_reader.hpp"
 
+#include <algorithm>
 #include <cstring>
+#include <functional>
 
 #include <userver/engine/io/common.hpp>
 #include <userver/logging/log.hpp>
 
 #include <urabbitmq/impl/amqp_connection.hpp>
 #include <urabbitmq/impl/amqp_connection_handler.hpp>
+#include <urabbitmq/statistics/connection_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace urabbitmq::impl::io {
 
+namespace {
+
+// Fits a frame of the default RabbitMQ frame_max with room for the next ones
+constexpr std::size_t kChunkSize = 256 * 1024;
+constexpr std::size_t kMinReadSize = 16 * 1024;
+constexpr std::size_t kMaxIdleChunks = 4;
+
+// Smaller messages are copied, so that a few slowly processed ones do not
+// hold a lot of chunks
+constexpr std::size_t kMinReferencedSize = kChunkSize / 16;
+
+}  // namespace
+
 SocketReader::SocketReader(AmqpConnectionHandler& parent,
                            engine::io::RwBase& socket)
-    : parent_{parent}, socket_{socket} {}
+    : parent_{parent},
+      socket_{socket},
+      pool_{std::make_shared<ReadChunkPool>(kMaxIdleChunks)} {}
 
 SocketReader::~SocketReader() { Stop(); }
 
@@ -23,7 +41,7 @@ void SocketReader::Start(AmqpConnection* connection) {
 
   reader_task_ = engine::CriticalAsyncNoSpan([this] {
     while (!engine::current_task::IsCancelRequested()) {
-      if (!buffer_.Read(socket_, conn_, parent_)) {
+      if (!Read()) {
         break;
       }
     }
@@ -32,35 +50,47 @@ void SocketReader::Start(AmqpConnection* connection) {
 
 void SocketReader::Stop() { reader_task_.SyncCancel(); }
 
-SocketReader::Buffer::Buffer() { data_.resize(kTmpBufferSize); }
+std::shared_ptr<const void> SocketReader::TryReference(std::string_view data) {
+  if (!chunk_ || data.size() < kMinReferencedSize) return nullptr;
 
-bool SocketReader::Buffer::Read(engine::io::RwBase& socket,
-                                AmqpConnection* conn,
-                                AmqpConnectionHandler& parent) {
-  try {
-    bool is_readable = true;
-    if (last_bytes_read_ != kTmpBufferSize) {
-      is_readable = socket.WaitReadable({});
-    }
+  const std::less<const char*> less;
+  const char* begin = chunk_->data.get() + parse_begin_;
+  const char* end = chunk_->data.get() + read_end_;
+  if (less(data.data(), begin) || less(end, data.data() + data.size())) {
+    return nullptr;
+  }
 
-    last_bytes_read_ =
-        is_readable ? socket.ReadSome(&tmp_buffer_[0], kTmpBufferSize, {}) : 0;
-    if (last_bytes_read_ == 0) {
+  chunk_referenced_ = true;
+  return chunk_;
+}
+
+bool SocketReader::Read() {
+  try {
+    PrepareChunk();
+
+    const auto bytes_read =
+        socket_.WaitReadable({})
+            ? socket_.ReadSome(chunk_->data.get() + read_end_,
+                               chunk_->capacity - read_end_, {})
+            : 0;
+    if (bytes_read == 0) {
       throw std::runtime_error{"Connection is closed by remote"};
     }
-
-    data_.resize(size_ + last_bytes_read_);
-    std::memcpy(data_.data() + size_, &tmp_buffer_[0], last_bytes_read_);
-    size_ += last_bytes_read_;
-
-    const auto parsed = [this, conn] {
-      auto lock = AmqpConnectionLocker{*conn}.Lock({});
-      return conn->GetNative().parse(data_.data(), size_);
+    read_end_ += bytes_read;
+
+    // All the complete frames are parsed at once, consumed messages get
+    // dispatched right from the parser callbacks
+    const auto parsed = [this] {
+      auto lock = AmqpConnectionLocker{*conn_}.Lock({});
+      auto& native = conn_->GetNative();
+      const auto parsed = native.parse(chunk_->data.get() + parse_begin_,
+                                       read_end_ - parse_begin_);
+      expected_ = native.expected();
+      return parsed;
     }();
     if (parsed != 0) {
-      std::memmove(data_.data(), data_.data() + parsed, size_ - parsed);
-      size_ -= parsed;
-      parent.AccountRead(parsed);
+      parse_begin_ += parsed;
+      parent_.AccountRead(parsed);
     }
 
     return true;
@@ -71,15 +101,74 @@ bool SocketReader::Buffer::Read(engine::io::RwBase& socket,
     }
 
     LOG_ERROR() << "Failed to read/process data from socket: " << ex.what();
-    parent.Invalidate();
+    parent_.Invalidate();
     {
-      auto lock = AmqpConnectionLocker{*conn}.Lock({});
-      conn->GetNative().fail("Underlying connection broke.");
+      auto lock = AmqpConnectionLocker{*conn_}.Lock({});
+      conn_->GetNative().fail("Underlying connection broke.");
     }
     return false;
   }
 }
 
+void SocketReader::PrepareChunk() {
+  if (!chunk_) {
+    chunk_ = AcquireChunk(kChunkSize);
+    return;
+  }
+
+  const auto unparsed = read_end_ - parse_begin_;
+  if (unparsed == 0 && !chunk_referenced_) {
+    parse_begin_ = read_end_ = 0;
+    return;
+  }
+  if (chunk_->capacity - read_end_ >= kMinReadSize &&
+      chunk_->capacity - parse_begin_ >= expected_) {
+    return;
+  }
+
+  // The incomplete frame has to be moved to the beginning of a chunk
+  const auto required = std::max(unparsed + kMinReadSize, expected_);
+  if (!chunk_referenced_ && required <= chunk_->capacity) {
+    std::memmove(chunk_->data.get(), chunk_->data.get() + parse_begin_,
+                 unparsed);
+  } else {
+    auto chunk = AcquireChunk(required);
+    std::memcpy(chunk->data.get(), chunk_->data.get() + parse_begin_,
+                unparsed);
+    // The old chunk is released when the messages referencing it are
+    // processed
+    chunk_ = std::move(chunk);
+    chunk_referenced_ = false;
+  }
+  parse_begin_ = 0;
+  read_end_ = unparsed;
+}
+
+std::shared_ptr<ReadChunk> SocketReader::AcquireChunk(std::size_t min_size) {
+  auto& stats = parent_.GetStatistics();
+  stats.AccountReadBufferUsed();
+  if (min_size > kChunkSize) {
+    // A frame larger than the pooled chunks, not worth pooling
+    stats.AccountReadBufferAllocated();
+    return std::make_shared<ReadChunk>(min_size);
+  }
+
+  auto chunk = pool_->Acquire([&stats] {
+    stats.AccountReadBufferAllocated();
+    return ReadChunk{kChunkSize};
+  });
+
+  // Keeps the pool alive while the messages reference the chunk, as they
+  // may outlive the connection
+  struct Holder final {
+    std::shared_ptr<ReadChunkPool> pool;
+    ReadChunkPool::Ptr chunk;
+  };
+  auto holder = std::make_shared<Holder>(Holder{pool_, std::move(chunk)});
+  auto* chunk_ptr = holder->chunk.get();
+  return {std::move(holder), chunk_ptr};
+}
+
 }  // namespace urabbitmq::impl::io
 
 USERVER_NAMESPACE_END
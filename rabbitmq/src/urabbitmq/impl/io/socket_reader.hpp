@@ -1,7 +1,10 @@
 #pragma once
 
-#include <vector>
+#include <cstddef>
+#include <memory>
+#include <string_view>
 
+#include <userver/concurrent/object_pool.hpp>
 #include <userver/engine/async.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,6 +22,18 @@ namespace io {
 
 class ISocket;
 
+// A part of the read buffer, the messages consumed in place keep it alive
+// until they are processed
+struct ReadChunk final {
+  explicit ReadChunk(std::size_t size)
+      : data(std::make_unique<char[]>(size)), capacity(size) {}
+
+  std::unique_ptr<char[]> data;
+  std::size_t capacity;
+};
+
+using ReadChunkPool = concurrent::ObjectPool<ReadChunk>;
+
 class SocketReader final {
  public:
   SocketReader(AmqpConnectionHandler& parent, engine::io::RwBase& socket);
@@ -28,28 +43,31 @@ class SocketReader final {
 
   void Stop();
 
- private:
-  class Buffer final {
-   public:
-    Buffer();
+  // Returns the owner of the read buffer if `data` points into the part
+  // being parsed, nullptr otherwise. Should only be called from the parse
+  // callbacks.
+  std::shared_ptr<const void> TryReference(std::string_view data);
 
-    bool Read(engine::io::RwBase& socket, AmqpConnection* conn,
-              AmqpConnectionHandler& parent);
-
-   private:
-    static constexpr size_t kTmpBufferSize = 1 << 15;
-    char tmp_buffer_[kTmpBufferSize]{};
-
-    std::vector<char> data_{};
-    size_t size_{0};
+ private:
+  bool Read();
 
-    size_t last_bytes_read_{0};
-  };
+  // Makes room for the next read, keeping the unparsed data
+  void PrepareChunk();
+  std::shared_ptr<ReadChunk> AcquireChunk(std::size_t min_size);
 
   AmqpConnectionHandler& parent_;
   engine::io::RwBase& socket_;
 
-  Buffer buffer_;
+  // Frames are parsed in place, the incomplete ones stay in the chunk
+  std::shared_ptr<ReadChunkPool> pool_;
+  std::shared_ptr<ReadChunk> chunk_;
+  std::size_t parse_begin_{0};
+  std::size_t read_end_{0};
+  // Size of the next frame, as reported by the parser
+  std::size_t expected_{0};
+  // Some messages reference the chunk, it may not be overwritten
+  bool chunk_referenced_{false};
+
   AmqpConnection* conn_{nullptr};
 
   engine::TaskWithResult<void> reader_task_;
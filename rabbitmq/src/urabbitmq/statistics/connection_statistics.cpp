@@ -26,6 +26,21 @@ void ConnectionStatistics::AccountMessagePublished() { ++messages_published_; }
 
 void ConnectionStatistics::AccountMessageConsumed() { ++messages_consumed_; }
 
+void ConnectionStatistics::AccountMessageProcessed(
+    std::chrono::milliseconds processing_time) {
+  messages_processing_time_ms_ += processing_time.count();
+}
+
+void ConnectionStatistics::AccountMessageConsumedInPlace() {
+  ++messages_consumed_in_place_;
+}
+
+void ConnectionStatistics::AccountReadBufferAllocated() {
+  ++read_buffers_allocated_;
+}
+
+void ConnectionStatistics::AccountReadBufferUsed() { ++read_buffers_used_; }
+
 ConnectionStatistics::Frozen ConnectionStatistics::Get() const {
   Frozen result{};
   result.connections_created = connections_created_.Load();
@@ -34,6 +49,10 @@ ConnectionStatistics::Frozen ConnectionStatistics::Get() const {
   result.bytes_read = bytes_read_.Load();
   result.messages_published = messages_published_.Load();
   result.messages_consumed = messages_consumed_.Load();
+  result.messages_processing_time_ms = messages_processing_time_ms_.Load();
+  result.messages_consumed_in_place = messages_consumed_in_place_.Load();
+  result.read_buffers_allocated = read_buffers_allocated_.Load();
+  result.read_buffers_used = read_buffers_used_.Load();
 
   return result;
 }
@@ -46,6 +65,10 @@ ConnectionStatistics::Frozen& ConnectionStatistics::Frozen::operator+=(
   bytes_read += other.bytes_read;
   messages_published += other.messages_published;
   messages_consumed += other.messages_consumed;
+  messages_processing_time_ms += other.messages_processing_time_ms;
+  messages_consumed_in_place += other.messages_consumed_in_place;
+  read_buffers_allocated += other.read_buffers_allocated;
+  read_buffers_used += other.read_buffers_used;
 
   return *this;
 }
@@ -58,6 +81,10 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["bytes_read"] = value.bytes_read;
   writer["messages_published"] = value.messages_published;
   writer["messages_consumed"] = value.messages_consumed;
+  writer["messages_processing_time_ms"] = value.messages_processing_time_ms;
+  writer["messages_consumed_in_place"] = value.messages_consumed_in_place;
+  writer["read_buffers_allocated"] = value.read_buffers_allocated;
+  writer["read_buffers_used"] = value.read_buffers_used;
 }
 
 }  // namespace urabbitmq::statistics
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 
 #include <userver/utils/statistics/relaxed_counter.hpp>
@@ -19,6 +20,11 @@ class ConnectionStatistics final {
 
   void AccountMessagePublished();
   void AccountMessageConsumed();
+  void AccountMessageProcessed(std::chrono::milliseconds processing_time);
+  void AccountMessageConsumedInPlace();
+
+  void AccountReadBufferAllocated();
+  void AccountReadBufferUsed();
 
   struct Frozen final {
     Frozen& operator+=(const Frozen& other);
@@ -31,6 +37,11 @@ class ConnectionStatistics final {
 
     size_t messages_published{0};
     size_t messages_consumed{0};
+    size_t messages_processing_time_ms{0};
+    size_t messages_consumed_in_place{0};
+
+    size_t read_buffers_allocated{0};
+    size_t read_buffers_used{0};
   };
   Frozen Get() const;
 
@@ -43,6 +54,11 @@ class ConnectionStatistics final {
 
   utils::statistics::RelaxedCounter<size_t> messages_published_{0};
   utils::statistics::RelaxedCounter<size_t> messages_consumed_{0};
+  utils::statistics::RelaxedCounter<size_t> messages_processing_time_ms_{0};
+  utils::statistics::RelaxedCounter<size_t> messages_consumed_in_place_{0};
+
+  utils::statistics::RelaxedCounter<size_t> read_buffers_allocated_{0};
+  utils::statistics::RelaxedCounter<size_t> read_buffers_used_{0};
 };
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -0,0 +1,80 @@
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <hiredis/hiredis.h>
+
+#include <userver/storages/redis/impl/reply.hpp>
+#include <userver/storages/redis/parse_reply.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis::bench {
+
+namespace {
+
+// Reply to an MGET of `size` keys with `value_size` bytes values, assembled
+// the way hiredis does it
+class MgetReply final {
+ public:
+  MgetReply(std::size_t size, std::size_t value_size)
+      : value_(value_size, 'x'), elements_(size), element_ptrs_(size) {
+    for (std::size_t i = 0; i < size; ++i) {
+      elements_[i].type = REDIS_REPLY_STRING;
+      elements_[i].str = value_.data();
+      elements_[i].len = value_.size();
+      element_ptrs_[i] = &elements_[i];
+    }
+    reply_.type = REDIS_REPLY_ARRAY;
+    reply_.elements = size;
+    reply_.element = element_ptrs_.data();
+  }
+
+  const redisReply* Get() const { return &reply_; }
+
+  std::size_t Bytes() const { return value_.size() * elements_.size(); }
+
+ private:
+  std::string value_;
+  std::vector<redisReply> elements_;
+  std::vector<redisReply*> element_ptrs_;
+  redisReply reply_{};
+};
+
+const std::string kRequestDescription = "mget";
+
+}  // namespace
+
+void ReplyDataFromHiredis(benchmark::State& state) {
+  const MgetReply reply(state.range(0), state.range(1));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(ReplyData{reply.Get()});
+  }
+  state.SetBytesProcessed(state.iterations() * reply.Bytes());
+}
+BENCHMARK(ReplyDataFromHiredis)
+    ->ArgNames({"keys", "value_size"})
+    ->Args({1, 16})
+    ->Args({64, 16})
+    ->Args({64, 1024});
+
+void ParseMgetReply(benchmark::State& state) {
+  const MgetReply reply(state.range(0), state.range(1));
+  for ([[maybe_unused]] auto _ : state) {
+    auto values = ParseReplyDataArray(
+        ReplyData{reply.Get()}, kRequestDescription,
+        To<std::vector<std::optional<std::string>>>{});
+    benchmark::DoNotOptimize(values);
+  }
+  state.SetBytesProcessed(state.iterations() * reply.Bytes());
+}
+BENCHMARK(ParseMgetReply)
+    ->ArgNames({"keys", "value_size"})
+    ->Args({1, 16})
+    ->Args({64, 16})
+    ->Args({64, 1024});
+
+}  // namespace storages::redis::bench
+
+USERVER_NAMESPACE_END
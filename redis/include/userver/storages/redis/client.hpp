@@ -76,6 +76,9 @@ class Client {
   virtual RequestUnlink Unlink(std::vector<std::string> keys,
                                const CommandControl& command_control) = 0;
 
+  /// The script is sent as EVALSHA, it is loaded to the shards on the first
+  /// call and after their reconnects, a NOSCRIPT error is handled by loading
+  /// the script and retrying once.
   template <typename ScriptResult, typename ReplyType = ScriptResult>
   RequestEval<ScriptResult, ReplyType> Eval(
       std::string script, std::vector<std::string> keys,
@@ -241,6 +244,9 @@ class Client {
   virtual RequestLtrim Ltrim(std::string key, int64_t start, int64_t stop,
                              const CommandControl& command_control) = 0;
 
+  /// Keys of different shards, and of different hash slots in the cluster
+  /// mode, are requested by parallel commands, the values are returned in
+  /// the order of the keys.
   virtual RequestMget Mget(std::vector<std::string> keys,
                            const CommandControl& command_control) = 0;
 
@@ -360,6 +366,21 @@ class Client {
   virtual RequestType Type(std::string key,
                            const CommandControl& command_control) = 0;
 
+  virtual RequestXack Xack(std::string key, std::string group,
+                           std::vector<std::string> ids,
+                           const CommandControl& command_control) = 0;
+
+  virtual RequestXautoclaim Xautoclaim(
+      std::string key, std::string group, std::string consumer,
+      std::chrono::milliseconds min_idle_time, std::string start, size_t count,
+      const CommandControl& command_control) = 0;
+
+  /// Reads up to `count` entries of the stream without blocking. Use ">" as
+  /// `id` for the entries never delivered to other consumers of the group.
+  virtual RequestXreadgroup Xreadgroup(
+      std::string key, std::string group, std::string consumer, std::string id,
+      size_t count, const CommandControl& command_control) = 0;
+
   virtual RequestZadd Zadd(std::string key, double score, std::string member,
                            const CommandControl& command_control) = 0;
 
@@ -0,0 +1,112 @@
+#pragma once
+
+/// @file userver/storages/redis/client_side_cache.hpp
+/// @brief @copybrief storages::redis::ClientSideCache
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/storages/redis/client.hpp>
+#include <userver/storages/redis/subscribe_client.hpp>
+#include <userver/storages/redis/subscription_token.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+/// Settings of storages::redis::ClientSideCache
+struct ClientSideCacheSettings {
+  /// Maximum number of cached keys
+  std::size_t max_size{10000};
+
+  /// Number of independently locked parts of the cache
+  std::size_t ways{16};
+
+  /// Time a value is served for, bounds the staleness if notifications are
+  /// lost while the subscription is reestablished
+  std::chrono::milliseconds ttl{std::chrono::seconds{60}};
+
+  /// Number of the database of the cached keys
+  std::size_t database{0};
+
+  /// Prefixes of the cached keys, modifications of the keys with other
+  /// prefixes are not listened for (empty - any key)
+  std::vector<std::string> prefixes;
+};
+
+/// Statistics of storages::redis::ClientSideCache
+struct ClientSideCacheStatistics {
+  std::uint64_t hits{0};
+  std::uint64_t misses{0};
+  std::uint64_t invalidations{0};
+  std::size_t size{0};
+};
+
+/// @ingroup userver_clients
+///
+/// @brief Client side cache of the string values read by GET.
+///
+/// Hot keys, such as feature flags or rate limit configs, are served from
+/// memory instead of a network roundtrip. A cached value is dropped as soon
+/// as the server notifies about a modification of the key, or once its TTL
+/// expires.
+///
+/// The modifications are received as keyspace notifications through
+/// the storages::redis::SubscribeClient, so the server must have them enabled
+/// for the commands that modify the cached keys, e.g.
+/// `notify-keyspace-events KA`. A value read concurrently with a modification
+/// of any key is not cached.
+///
+/// @warning Notifications sent while the subscription is being reestablished
+/// are lost, stale values are served until their TTL expires then.
+class ClientSideCache final {
+ public:
+  ClientSideCache(ClientPtr client, SubscribeClientPtr subscribe_client,
+                  const ClientSideCacheSettings& settings);
+
+  ClientSideCache(const ClientSideCache&) = delete;
+  ClientSideCache& operator=(const ClientSideCache&) = delete;
+
+  /// Returns the cached value of the key or executes GET
+  std::optional<std::string> Get(const std::string& key,
+                                 const CommandControl& command_control = {});
+
+  /// Drops the cached value of the key
+  void Invalidate(const std::string& key);
+
+  /// Drops all the cached values
+  void InvalidateAll();
+
+  ClientSideCacheStatistics GetStatistics() const;
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    std::optional<std::string> value;
+    Clock::time_point expiration;
+  };
+
+  void OnNotification(const std::string& channel);
+
+  const ClientPtr client_;
+  const std::chrono::milliseconds ttl_;
+  const std::string channel_prefix_;
+  cache::NWayLRU<std::string, Entry> entries_;
+
+  std::atomic<std::uint64_t> hits_{0};
+  std::atomic<std::uint64_t> misses_{0};
+  std::atomic<std::uint64_t> invalidations_{0};
+
+  // Destroyed first, so that no notification is processed afterwards
+  std::vector<SubscriptionToken> subscriptions_;
+};
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -83,6 +83,11 @@ struct CommandControl {
 
     /// Send requests to 'best_dc_count' Redis instances with the min ping
     kNearestServerPing,
+
+    /// Send requests to the instances with the least expected reply time,
+    /// estimated from the moving average of the reply latency and the number
+    /// of running commands of an instance
+    kLatencyWeighted,
   };
 
   /// Timeout for a single attempt to execute command
@@ -62,10 +62,13 @@ namespace components {
 /// groups.[].db | name to refer to the cluster in components::Redis::GetClient() | -
 /// groups.[].sharding_strategy | one of RedisCluster, KeyShardCrc32, KeyShardTaximeterCrc32 or KeyShardGpsStorageDriver | "KeyShardTaximeterCrc32"
 /// groups.[].allow_reads_from_master | allows read requests from master instance | false
+/// groups.[].hot_keys | enables detection of the hot keys of the commands in components::HotKeysStorage as the `redis.<db>` source | false
+/// groups.[].connections_per_instance | number of parallel connections to each Redis server, the commands are balanced between them by the count of running commands. Connections are served by different ev threads, so the value should not exceed `thread_pools.redis_thread_pool_size`. Not supported by the auto topology cluster mode | 1
 /// subscribe_groups | array of redis clusters to work with in subscribe mode | -
 /// subscribe_groups.[].config_name | key name in secdist with options for this cluster | -
 /// subscribe_groups.[].db | name to refer to the cluster in components::Redis::GetSubscribeClient() | -
 /// subscribe_groups.[].sharding_strategy | either RedisCluster or KeyShardTaximeterCrc32 | "KeyShardTaximeterCrc32"
+/// subscribe_groups.[].connections_per_instance | number of parallel connections to each Redis server, the subscriptions are distributed between them | 1
 ///
 /// ## Static configuration example:
 ///
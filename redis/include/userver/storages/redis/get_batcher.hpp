@@ -0,0 +1,78 @@
+#pragma once
+
+/// @file userver/storages/redis/get_batcher.hpp
+/// @brief @copybrief storages::redis::GetBatcher
+
+#include <cstddef>
+#include <deque>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/storages/redis/client.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+/// Settings of storages::redis::GetBatcher
+struct GetBatcherSettings {
+  /// Maximum number of keys in an MGET
+  std::size_t max_batch_size{64};
+
+  /// Number of commands sent to a shard at once, the keys of the other
+  /// callers are collected into the next MGET meanwhile
+  std::size_t max_in_flight{1};
+
+  /// Whether the client is in the Redis Cluster mode. MGET accepts only the
+  /// keys of one hash slot there, so only such keys are batched together.
+  bool cluster_mode{false};
+};
+
+/// @ingroup userver_clients
+///
+/// @brief Fuses single GETs of concurrent callers into MGETs.
+///
+/// A caller that finds a free command slot of the shard becomes a leader: it
+/// sends its GET together with all the keys queued by then in one MGET and
+/// hands the leadership over to the first key queued after that. Other
+/// callers just wait for their values, so the number of commands does not
+/// grow with the load while an idle shard adds no delay.
+///
+/// The command control of the leader is used for the whole batch, an error
+/// of the MGET is reported to every caller of the batch.
+class GetBatcher final {
+ public:
+  GetBatcher(ClientPtr client, const GetBatcherSettings& settings);
+
+  GetBatcher(const GetBatcher&) = delete;
+  GetBatcher& operator=(const GetBatcher&) = delete;
+
+  /// Executes GET of the key, possibly as a part of an MGET
+  std::optional<std::string> Get(std::string key,
+                                 const CommandControl& command_control = {});
+
+ private:
+  struct Request;
+
+  struct Group {
+    std::deque<Request*> pending;
+    std::size_t leaders{0};
+  };
+
+  std::size_t GetGroupId(const std::string& key) const;
+  void WaitForTurn(std::size_t group_id, Request& request);
+  void Lead(std::size_t group_id, Request& request);
+  void HandOver(std::size_t group_id);
+
+  const ClientPtr client_;
+  const GetBatcherSettings settings_;
+
+  engine::Mutex mutex_;
+  std::unordered_map<std::size_t, Group> groups_;
+};
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
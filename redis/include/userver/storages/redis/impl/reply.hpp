@@ -37,8 +37,10 @@ class ReplyData final {
       KeyValue(const Array& array, size_t index)
           : array_(array), index_(index) {}
 
-      std::string Key() const { return array_[index_ * 2].GetString(); }
-      std::string Value() const { return array_[index_ * 2 + 1].GetString(); }
+      const std::string& Key() const { return array_[index_ * 2].GetString(); }
+      const std::string& Value() const {
+        return array_[index_ * 2 + 1].GetString();
+      }
 
      private:
       const Array& array_;
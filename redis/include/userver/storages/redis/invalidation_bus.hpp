@@ -0,0 +1,163 @@
+#pragma once
+
+/// @file userver/storages/redis/invalidation_bus.hpp
+/// @brief @copybrief storages::redis::InvalidationBus
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/cache/lru_cache_component_base.hpp>
+#include <userver/concurrent/async_event_channel.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/storages/redis/client.hpp>
+#include <userver/storages/redis/subscribe_client.hpp>
+#include <userver/storages/redis/subscription_token.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/periodic_task.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+/// Settings of storages::redis::InvalidationBus
+struct InvalidationBusSettings {
+  /// Channel the invalidations are published on by all the instances
+  std::string channel{"userver-cache-invalidations"};
+
+  /// Period of publishing the accumulated invalidations
+  std::chrono::milliseconds flush_interval{10};
+
+  /// Max keys of a cache in one message, a full batch is published right away
+  std::size_t max_batch_size{1000};
+};
+
+/// Keys of a cache to evict
+struct InvalidationBatch {
+  std::string cache_name;
+  std::vector<std::string> keys;
+};
+
+/// Statistics of storages::redis::InvalidationBus
+struct InvalidationBusStatistics {
+  using Percentile = utils::statistics::Percentile<2048>;
+
+  std::uint64_t published_messages{0};
+  std::uint64_t published_keys{0};
+  std::uint64_t received_messages{0};
+  std::uint64_t received_keys{0};
+  std::uint64_t malformed_messages{0};
+  /// Times from the invalidation on another instance to its receipt, in
+  /// milliseconds, for the last minute
+  Percentile lag;
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const InvalidationBusStatistics& stats);
+
+/// @ingroup userver_clients
+///
+/// @brief Cluster-wide invalidation of the in-memory caches over Redis
+/// pub/sub.
+///
+/// An instance that modifies the data calls Invalidate() with the keys of the
+/// changed entries. The keys are passed to the listeners of this instance
+/// right away and are published in compact batches on the channel, so the
+/// other instances evict them too.
+///
+/// Caches subscribe with AddListener(), or with
+/// ListenLruCacheInvalidations() for the cache::LruCacheComponent.
+///
+/// @warning Pub/sub delivers messages at most once, the messages published
+/// while a subscription is being reestablished are lost. Keep a TTL on the
+/// cached entries to bound the staleness in that case.
+class InvalidationBus final {
+ public:
+  InvalidationBus(ClientPtr client, SubscribeClientPtr subscribe_client,
+                  InvalidationBusSettings settings);
+  ~InvalidationBus();
+
+  InvalidationBus(const InvalidationBus&) = delete;
+  InvalidationBus& operator=(const InvalidationBus&) = delete;
+
+  /// @brief Evicts the keys of the cache on this instance and queues their
+  /// invalidation for the other instances
+  void Invalidate(const std::string& cache_name,
+                  std::vector<std::string> keys);
+
+  /// Publishes the queued invalidations right away
+  void Flush();
+
+  /// @brief Source of the invalidations, both local and of the other
+  /// instances. The listeners should check the InvalidationBatch::cache_name.
+  concurrent::AsyncEventSource<const InvalidationBatch&>& GetSource();
+
+  InvalidationBusStatistics GetStatistics() const;
+
+ private:
+  using PendingKeys =
+      std::unordered_map<std::string, std::vector<std::string>>;
+
+  void OnMessage(const std::string& message);
+
+  void Publish(const std::string& cache_name, std::vector<std::string> keys);
+
+  const ClientPtr client_;
+  const InvalidationBusSettings settings_;
+  const std::string sender_id_;
+
+  // Keys of the caches to publish
+  concurrent::Variable<PendingKeys> pending_;
+  concurrent::AsyncEventChannel<const InvalidationBatch&> channel_;
+
+  std::atomic<std::uint64_t> published_messages_{0};
+  std::atomic<std::uint64_t> published_keys_{0};
+  std::atomic<std::uint64_t> received_messages_{0};
+  std::atomic<std::uint64_t> received_keys_{0};
+  std::atomic<std::uint64_t> malformed_messages_{0};
+  utils::statistics::RecentPeriod<InvalidationBusStatistics::Percentile,
+                                  InvalidationBusStatistics::Percentile>
+      lag_;
+
+  utils::PeriodicTask flush_task_;
+  // Destroyed first, so that no message is processed afterwards
+  SubscriptionToken subscription_;
+};
+
+/// @brief Subscribes the LRU cache component to the invalidations of its
+/// keys published as `cache_name`.
+///
+/// The keys are parsed with utils::FromString unless the cache has string
+/// keys. The returned scope should be stored in the component and
+/// unsubscribed in its destructor.
+template <typename Key, typename Value, typename Hash, typename Equal>
+concurrent::AsyncEventSubscriberScope ListenLruCacheInvalidations(
+    InvalidationBus& bus, std::string cache_name,
+    cache::LruCacheComponent<Key, Value, Hash, Equal>& component) {
+  auto& source = bus.GetSource();
+  const auto name = cache_name;
+  return source.AddListener(
+      concurrent::FunctionId(&component), name,
+      [&component,
+       cache_name = std::move(cache_name)](const InvalidationBatch& batch) {
+        if (batch.cache_name != cache_name) return;
+        auto cache = component.GetCache();
+        for (const auto& key : batch.keys) {
+          if constexpr (std::is_same_v<Key, std::string>) {
+            cache.InvalidateByKey(key);
+          } else {
+            cache.InvalidateByKey(utils::FromString<Key>(key));
+          }
+        }
+      });
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,67 @@
+#pragma once
+
+/// @file userver/storages/redis/invalidation_bus_component.hpp
+/// @brief @copybrief storages::redis::InvalidationBusComponent
+
+#include <memory>
+#include <string_view>
+
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/utils/statistics/entry.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+class InvalidationBus;
+
+// clang-format off
+/// @ingroup userver_components
+///
+/// @brief Component that holds a storages::redis::InvalidationBus
+///
+/// The caches of all the instances with the same `channel` evict the keys
+/// invalidated on any of them. See storages::redis::ListenLruCacheInvalidations
+/// to subscribe a cache::LruCacheComponent.
+///
+/// ## Static options:
+/// Name                 | Description                                                 | Default value
+/// -------------------- | ----------------------------------------------------------- | ---------------
+/// redis_name           | name of the redis database in components::Redis to publish  | -
+/// subscribe_redis_name | name of the redis subscribe database in components::Redis   | redis_name
+/// channel              | channel of the invalidations                                | userver-cache-invalidations
+/// flush_interval       | period of publishing the accumulated invalidations          | 10ms
+/// max_batch_size       | max keys of a cache in one message                          | 1000
+///
+// clang-format on
+class InvalidationBusComponent final
+    : public components::LoggableComponentBase {
+ public:
+  /// @ingroup userver_component_names
+  /// @brief The default name of storages::redis::InvalidationBusComponent
+  static constexpr std::string_view kName = "redis-invalidation-bus";
+
+  InvalidationBusComponent(const components::ComponentConfig& config,
+                           const components::ComponentContext& context);
+  ~InvalidationBusComponent() override;
+
+  InvalidationBus& GetBus();
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ private:
+  std::unique_ptr<InvalidationBus> bus_;
+  utils::statistics::Entry statistics_holder_;
+};
+
+}  // namespace storages::redis
+
+namespace components {
+
+template <>
+inline constexpr bool
+    kHasValidate<storages::redis::InvalidationBusComponent> = true;
+
+}
+
+USERVER_NAMESPACE_END
@@ -122,6 +122,15 @@ std::unordered_map<std::string, std::string> Parse(
 ReplyData Parse(ReplyData&& reply_data, const std::string& request_description,
                 To<ReplyData>);
 
+/// Entries of XREADGROUP reply, a nil reply means no new entries
+std::vector<StreamEntry> Parse(ReplyData&& reply_data,
+                               const std::string& request_description,
+                               To<std::vector<StreamEntry>>);
+
+XautoclaimReply Parse(ReplyData&& reply_data,
+                      const std::string& request_description,
+                      To<XautoclaimReply>);
+
 template <typename Result, typename ReplyType = Result>
 std::enable_if_t<impl::HasParseFunctionFromRedisReply<Result, ReplyType>::value,
                  ReplyType>
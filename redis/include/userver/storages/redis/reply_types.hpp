@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <userver/storages/redis/impl/base.hpp>
@@ -109,6 +110,22 @@ enum class StatusOk { kOk };
 
 enum class StatusPong { kPong };
 
+/// Entry of a Redis Stream
+struct StreamEntry final {
+  std::string id;
+  std::vector<std::pair<std::string, std::string>> fields;
+};
+
+/// Reply to XAUTOCLAIM
+struct XautoclaimReply final {
+  /// Id to start the next XAUTOCLAIM from, "0-0" once the whole pending
+  /// entries list is scanned
+  std::string next_start_id;
+
+  /// Claimed entries, the ones deleted from the stream are omitted
+  std::vector<StreamEntry> entries;
+};
+
 using TtlReply = USERVER_NAMESPACE::redis::TtlReply;
 
 }  // namespace storages::redis
@@ -44,6 +44,8 @@ class [[nodiscard]] Request final {
   template <ScanTag scan_tag>
   friend class RequestScanData;
 
+  friend class EvalRequestDataImpl;
+
  private:
   ReplyPtr GetRaw() { return impl_->GetRaw(); }
 
@@ -210,6 +212,9 @@ using RequestStrlen = Request<size_t>;
 using RequestTime = Request<std::chrono::system_clock::time_point>;
 using RequestTtl = Request<TtlReply>;
 using RequestType = Request<KeyType>;
+using RequestXack = Request<size_t>;
+using RequestXautoclaim = Request<XautoclaimReply>;
+using RequestXreadgroup = Request<std::vector<StreamEntry>>;
 using RequestZadd = Request<size_t>;
 using RequestZaddIncr = Request<double>;
 using RequestZaddIncrExisting = Request<std::optional<double>>;
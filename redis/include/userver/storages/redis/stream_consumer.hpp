@@ -0,0 +1,103 @@
+#pragma once
+
+/// @file userver/storages/redis/stream_consumer.hpp
+/// @brief @copybrief storages::redis::StreamConsumer
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/storages/redis/client.hpp>
+#include <userver/storages/redis/reply_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+/// Settings of storages::redis::StreamConsumer
+struct StreamConsumerSettings {
+  /// Key of the stream
+  std::string stream;
+
+  /// Consumer group, must be created beforehand with XGROUP CREATE
+  std::string group;
+
+  /// Name of the consumer within the group
+  std::string consumer;
+
+  /// Maximum number of entries read by one XREADGROUP or XAUTOCLAIM and
+  /// acknowledged by one XACK
+  std::size_t batch_size{100};
+
+  /// Maximum number of entries processed concurrently
+  std::size_t max_in_flight{16};
+
+  /// Delay before the next XREADGROUP when the stream has no new entries
+  std::chrono::milliseconds poll_interval{100};
+
+  /// Entries pending for longer are claimed from the other consumers
+  std::chrono::milliseconds min_idle_time{30000};
+
+  /// Period of the scans of the pending entries list
+  std::chrono::milliseconds claim_interval{10000};
+
+  CommandControl command_control{};
+};
+
+/// @ingroup userver_clients
+///
+/// @brief Consumes a Redis stream as a member of a consumer group.
+///
+/// New entries are read with XREADGROUP in batches, processed concurrently
+/// and acknowledged with a single XACK per batch. Entries whose processing
+/// has thrown stay pending and, as well as the entries of the consumers that
+/// are gone, are claimed again with XAUTOCLAIM once they are idle for
+/// `min_idle_time`.
+///
+/// XREADGROUP is sent without BLOCK: the connections of the client are
+/// pipelined and shared with other commands, so an empty stream is polled
+/// every `poll_interval` instead.
+///
+/// @note Delivery is `at least once`, an entry may be processed again if
+/// the XACK did not reach the server.
+class StreamConsumer final {
+ public:
+  using Callback = std::function<void(StreamEntry)>;
+
+  StreamConsumer(ClientPtr client, StreamConsumerSettings settings,
+                 Callback callback, engine::TaskProcessor& task_processor);
+  ~StreamConsumer();
+
+  StreamConsumer(const StreamConsumer&) = delete;
+  StreamConsumer& operator=(const StreamConsumer&) = delete;
+
+  /// Starts the consumption in background, does nothing if already started
+  void Start();
+
+  /// Finishes processing of the current batch and stops the consumption
+  void Stop() noexcept;
+
+ private:
+  void Run();
+
+  /// Returns whether the whole pending entries list has been scanned
+  bool Claim();
+
+  void ProcessBatch(std::vector<StreamEntry> entries);
+
+  const ClientPtr client_;
+  const StreamConsumerSettings settings_;
+  const Callback callback_;
+  engine::TaskProcessor& task_processor_;
+
+  std::string claim_start_{"0-0"};
+  engine::TaskWithResult<void> task_;
+};
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,77 @@
+#pragma once
+
+/// @file userver/storages/redis/stream_consumer_component_base.hpp
+/// @brief @copybrief storages::redis::StreamConsumerComponentBase
+
+#include <memory>
+
+#include <userver/components/loggable_component_base.hpp>
+#include <userver/storages/redis/reply_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+class StreamConsumer;
+
+// clang-format off
+/// @ingroup userver_base_classes
+///
+/// @brief Base component for the consumers of Redis streams.
+/// Basically a storages::redis::StreamConsumer in a component-ish way
+///
+/// You should derive from it and override `Process` method, which gets called
+/// for every entry of the stream. The consumer is started after all the
+/// components are loaded and stopped before the components begin to stop.
+///
+/// ## Static options:
+/// Name           | Description                                                  | Default value
+/// -------------- | ------------------------------------------------------------ | ---------------
+/// redis_name     | name of the redis database in components::Redis              | -
+/// stream         | key of the stream                                            | -
+/// group          | consumer group, must already exist                           | -
+/// consumer       | name of the consumer within the group                        | -
+/// batch_size     | max entries read by one command and acknowledged by one XACK | 100
+/// max_in_flight  | max entries processed concurrently                           | 16
+/// poll_interval  | delay before the next read when there are no new entries     | 100ms
+/// min_idle_time  | pending entries idle for longer are claimed by the consumer  | 30s
+/// claim_interval | period of the scans of the pending entries                   | 10s
+/// task_processor | task processor to process the entries on                     | the task processor of the component
+///
+// clang-format on
+class StreamConsumerComponentBase : public components::LoggableComponentBase {
+ public:
+  StreamConsumerComponentBase(const components::ComponentConfig& config,
+                              const components::ComponentContext& context);
+  ~StreamConsumerComponentBase() override;
+
+  static yaml_config::Schema GetStaticConfigSchema();
+
+ protected:
+  void OnAllComponentsLoaded() final;
+
+  void OnAllComponentsAreStopping() final;
+
+  /// @brief Override this method in derived class and implement the entry
+  /// handling logic.
+  ///
+  /// If this method returns successfully the entry is acknowledged together
+  /// with the rest of its batch, if it throws the entry stays pending and is
+  /// delivered again after `min_idle_time`.
+  virtual void Process(StreamEntry entry) = 0;
+
+ private:
+  std::unique_ptr<StreamConsumer> consumer_;
+};
+
+}  // namespace storages::redis
+
+namespace components {
+
+template <>
+inline constexpr bool
+    kHasValidate<storages::redis::StreamConsumerComponentBase> = true;
+
+}
+
+USERVER_NAMESPACE_END
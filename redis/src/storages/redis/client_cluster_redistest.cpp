@@ -104,9 +104,11 @@ UTEST_F(RedisClusterClientTest, MgetCrossSlot) {
 
   const int add = 100;
 
-  size_t idx[2] = {0, 1};
+  // Two keys of different slots of one shard and a key of another shard
+  size_t idx[3] = {0, 1, 1};
   auto shard = client->ShardByKey(MakeKey(idx[0]));
   while (client->ShardByKey(MakeKey(idx[1])) != shard) ++idx[1];
+  while (client->ShardByKey(MakeKey(idx[2])) == shard) ++idx[2];
 
   for (unsigned long i : idx) {
     auto req = client->Set(MakeKey(i), std::to_string(add + i), kDefaultCc);
@@ -114,8 +116,15 @@ UTEST_F(RedisClusterClientTest, MgetCrossSlot) {
   }
 
   {
-    auto req = client->Mget({MakeKey(idx[0]), MakeKey(idx[1])}, kDefaultCc);
-    UASSERT_THROW(req.Get(), redis::ParseReplyException);
+    auto req = client->Mget({MakeKey(idx[2]), MakeKey(idx[0]), "missing",
+                             MakeKey(idx[1])},
+                            kDefaultCc);
+    const auto values = req.Get();
+    ASSERT_EQ(values.size(), 4);
+    EXPECT_EQ(values[0], std::to_string(add + idx[2]));
+    EXPECT_EQ(values[1], std::to_string(add + idx[0]));
+    EXPECT_EQ(values[2], std::nullopt);
+    EXPECT_EQ(values[3], std::to_string(add + idx[1]));
   }
 
   for (unsigned long i : idx) {
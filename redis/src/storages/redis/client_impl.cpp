@@ -1,5 +1,8 @@
 #include "client_impl.hpp"
 
+#include <numeric>
+#include <unordered_map>
+
 #include <userver/utils/assert.hpp>
 
 #include <storages/redis/impl/sentinel.hpp>
@@ -39,8 +42,22 @@ void DoCheckShard(size_t shard, std::optional<size_t> force_shard_idx) {
 
 ClientImpl::ClientImpl(
     std::shared_ptr<USERVER_NAMESPACE::redis::Sentinel> sentinel,
-    std::optional<size_t> force_shard_idx)
-    : redis_client_(std::move(sentinel)), force_shard_idx_(force_shard_idx) {}
+    std::optional<size_t> force_shard_idx,
+    std::shared_ptr<ScriptCache> script_cache)
+    : redis_client_(std::move(sentinel)),
+      force_shard_idx_(force_shard_idx),
+      script_cache_(script_cache ? std::move(script_cache)
+                                 : std::make_shared<ScriptCache>()) {
+  // Clients of single shards share the scripts of their parent, which
+  // preloads them to all the shards
+  if (force_shard_idx_) return;
+  preload_connection_ = redis_client_->signal_instances_changed.connect(
+      [script_cache = script_cache_, sentinel = redis_client_.get()](
+          size_t shard) {
+        script_cache->LoadAll(*sentinel, shard,
+                              sentinel->GetCommandControl({}));
+      });
+}
 
 void ClientImpl::WaitConnectedOnce(
     USERVER_NAMESPACE::redis::RedisWaitConnected wait_connected) {
@@ -58,7 +75,15 @@ const std::string& ClientImpl::GetAnyKeyForShard(size_t shard_idx) const {
 }
 
 std::shared_ptr<Client> ClientImpl::GetClientForShard(size_t shard_idx) {
-  return std::make_shared<ClientImpl>(redis_client_, shard_idx);
+  auto client =
+      std::make_shared<ClientImpl>(redis_client_, shard_idx, script_cache_);
+  client->hot_keys_ = hot_keys_;
+  return client;
+}
+
+void ClientImpl::SetHotKeys(
+    std::shared_ptr<utils::statistics::HotKeys> hot_keys) {
+  hot_keys_ = std::move(hot_keys);
 }
 
 std::optional<size_t> ClientImpl::GetForcedShardIdx() const {
@@ -145,11 +170,23 @@ RequestEvalCommon ClientImpl::EvalCommon(
     std::vector<std::string> args, const CommandControl& command_control) {
   UASSERT(!keys.empty());
   auto shard = ShardByKey(keys.at(0), command_control);
+  auto [sha, is_new] = script_cache_->Register(script);
+  if (is_new) {
+    ScriptCache::Load(*redis_client_, script,
+                      GetCommandControl(command_control));
+  }
+
+  // The keys and the arguments are kept for the retry after a NOSCRIPT error,
+  // which is still cheaper than sending the script on every call
   size_t keys_size = keys.size();
-  return CreateRequest<RequestEvalCommon>(
-      MakeRequest(CmdArgs{"eval", std::move(script), keys_size, std::move(keys),
-                          std::move(args)},
-                  shard, true, GetCommandControl(command_control)));
+  auto request =
+      MakeRequest(CmdArgs{"evalsha", sha, keys_size, keys, args}, shard, true,
+                  GetCommandControl(command_control));
+  return RequestEvalCommon(std::make_unique<EvalRequestDataImpl>(
+      shared_from_this(), std::move(request),
+      EvalRequestDataImpl::Retry{std::move(script), std::move(sha),
+                                 std::move(keys), std::move(args), shard,
+                                 command_control}));
 }
 
 RequestEvalShaCommon ClientImpl::EvalShaCommon(
@@ -516,21 +553,48 @@ RequestMget ClientImpl::Mget(std::vector<std::string> keys,
   if (keys.empty())
     return CreateDummyRequest<RequestMget>(
         std::make_shared<Reply>("mget", ReplyData::Array{}));
-  const auto shard = ShardByKey(keys.at(0), command_control);
   auto max_chunk_size = CommandControlImpl{command_control}.chunk_size;
   if (max_chunk_size == 0) {
     max_chunk_size = keys.size();
   }
-  auto make_request = [this, shard,
-                       cc = GetCommandControl(command_control)](auto keys) {
+  auto make_request = [this, cc = GetCommandControl(command_control)](
+                          size_t shard, auto keys) {
     return MakeRequest(CmdArgs{"mget", std::move(keys)}, shard, false, cc);
   };
-  if (max_chunk_size >= keys.size()) {
-    return CreateRequest<RequestMget>(make_request(std::move(keys)));
+
+  auto groups = GroupKeysByShards(keys, command_control);
+  if (groups.size() == 1) {
+    const auto shard = groups.front().shard;
+    if (max_chunk_size >= keys.size()) {
+      return CreateRequest<RequestMget>(make_request(shard, std::move(keys)));
+    }
+    return CreateAggregateRequest<RequestMget>(MakeRequestChunks(
+        max_chunk_size, std::move(keys), [&make_request, shard](auto keys) {
+          return make_request(shard, std::move(keys));
+        }));
   }
-  return CreateAggregateRequest<RequestMget>(MakeRequestChunks(
-      max_chunk_size, std::move(keys),
-      [&make_request](auto keys) { return make_request(std::move(keys)); }));
+
+  // Sub-commands to different shards are executed in parallel, the values
+  // are put back in the order of the keys
+  std::vector<USERVER_NAMESPACE::redis::Request> requests;
+  std::vector<std::vector<size_t>> positions;
+  for (auto& group : groups) {
+    for (auto it = group.positions.begin(); it != group.positions.end();) {
+      const auto chunk_end =
+          it + std::min<std::ptrdiff_t>(max_chunk_size,
+                                        group.positions.end() - it);
+      std::vector<std::string> chunk_keys;
+      chunk_keys.reserve(chunk_end - it);
+      for (auto pos = it; pos != chunk_end; ++pos) {
+        chunk_keys.push_back(std::move(keys[*pos]));
+      }
+      requests.push_back(make_request(group.shard, std::move(chunk_keys)));
+      positions.emplace_back(it, chunk_end);
+      it = chunk_end;
+    }
+  }
+  return CreateAggregateRequest<RequestMget>(std::move(requests),
+                                             std::move(positions));
 }
 
 RequestMset ClientImpl::Mset(
@@ -847,6 +911,40 @@ RequestType ClientImpl::Type(std::string key,
                   GetCommandControl(command_control)));
 }
 
+RequestXack ClientImpl::Xack(std::string key, std::string group,
+                             std::vector<std::string> ids,
+                             const CommandControl& command_control) {
+  if (ids.empty())
+    return CreateDummyRequest<RequestXack>(
+        std::make_shared<Reply>("xack", 0));
+  auto shard = ShardByKey(key, command_control);
+  return CreateRequest<RequestXack>(MakeRequest(
+      CmdArgs{"xack", std::move(key), std::move(group), std::move(ids)}, shard,
+      true, GetCommandControl(command_control)));
+}
+
+RequestXautoclaim ClientImpl::Xautoclaim(
+    std::string key, std::string group, std::string consumer,
+    std::chrono::milliseconds min_idle_time, std::string start, size_t count,
+    const CommandControl& command_control) {
+  auto shard = ShardByKey(key, command_control);
+  return CreateRequest<RequestXautoclaim>(MakeRequest(
+      CmdArgs{"xautoclaim", std::move(key), std::move(group),
+              std::move(consumer), min_idle_time.count(), std::move(start),
+              "COUNT", count},
+      shard, true, GetCommandControl(command_control)));
+}
+
+RequestXreadgroup ClientImpl::Xreadgroup(
+    std::string key, std::string group, std::string consumer, std::string id,
+    size_t count, const CommandControl& command_control) {
+  auto shard = ShardByKey(key, command_control);
+  return CreateRequest<RequestXreadgroup>(MakeRequest(
+      CmdArgs{"xreadgroup", "GROUP", std::move(group), std::move(consumer),
+              "COUNT", count, "STREAMS", std::move(key), std::move(id)},
+      shard, true, GetCommandControl(command_control)));
+}
+
 RequestZadd ClientImpl::Zadd(std::string key, double score, std::string member,
                              const CommandControl& command_control) {
   auto shard = ShardByKey(key, command_control);
@@ -1117,8 +1215,38 @@ size_t ClientImpl::GetPublishShard(
   return 0;
 }
 
+std::vector<ClientImpl::KeysGroup> ClientImpl::GroupKeysByShards(
+    const std::vector<std::string>& keys, const CommandControl& cc) const {
+  const bool is_cluster = redis_client_->IsInClusterMode();
+  if (!is_cluster && (force_shard_idx_ || cc.force_shard_idx ||
+                      redis_client_->ShardsCount() == 1)) {
+    std::vector<size_t> positions(keys.size());
+    std::iota(positions.begin(), positions.end(), 0);
+    // The first key is accounted by ShardByKey
+    if (hot_keys_) {
+      for (size_t i = 1; i < keys.size(); ++i) hot_keys_->Account(keys[i]);
+    }
+    return {{ShardByKey(keys.front(), cc), std::move(positions)}};
+  }
+
+  std::vector<KeysGroup> groups;
+  // shard or hash slot -> index in groups
+  std::unordered_map<size_t, size_t> group_indices;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    const auto shard = ShardByKey(keys[i], cc);
+    const auto group_id =
+        is_cluster ? USERVER_NAMESPACE::redis::Sentinel::HashSlot(keys[i])
+                   : shard;
+    const auto [it, inserted] = group_indices.emplace(group_id, groups.size());
+    if (inserted) groups.push_back({shard, {}});
+    groups[it->second].positions.push_back(i);
+  }
+  return groups;
+}
+
 size_t ClientImpl::ShardByKey(const std::string& key,
                               const CommandControl& cc) const {
+  if (hot_keys_) hot_keys_->Account(key);
   if (force_shard_idx_) {
     if (cc.force_shard_idx && *cc.force_shard_idx != *force_shard_idx_)
       throw USERVER_NAMESPACE::redis::InvalidArgumentException(
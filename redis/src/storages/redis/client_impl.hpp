@@ -12,8 +12,12 @@
 
 #include <userver/storages/redis/client.hpp>
 #include <userver/storages/redis/transaction.hpp>
+#include <userver/utils/statistics/hot_keys.hpp>
+
+#include <boost/signals2/connection.hpp>
 
 #include "scan_reply.hpp"
+#include "script_cache.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -31,7 +35,8 @@ class ClientImpl final : public Client,
  public:
   explicit ClientImpl(
       std::shared_ptr<USERVER_NAMESPACE::redis::Sentinel> sentinel,
-      std::optional<size_t> force_shard_idx = std::nullopt);
+      std::optional<size_t> force_shard_idx = std::nullopt,
+      std::shared_ptr<ScriptCache> script_cache = nullptr);
 
   void WaitConnectedOnce(
       USERVER_NAMESPACE::redis::RedisWaitConnected wait_connected) override;
@@ -46,6 +51,10 @@ class ClientImpl final : public Client,
 
   std::optional<size_t> GetForcedShardIdx() const;
 
+  /// The keys of the commands will be accounted in `hot_keys`. Not
+  /// thread-safe, must be called before the client is used.
+  void SetHotKeys(std::shared_ptr<utils::statistics::HotKeys> hot_keys);
+
   Request<ScanReplyTmpl<ScanTag::kScan>> MakeScanRequestNoKey(
       size_t shard, ScanReply::Cursor cursor, ScanOptions options,
       const CommandControl& command_control);
@@ -336,6 +345,21 @@ class ClientImpl final : public Client,
   RequestType Type(std::string key,
                    const CommandControl& command_control) override;
 
+  RequestXack Xack(std::string key, std::string group,
+                   std::vector<std::string> ids,
+                   const CommandControl& command_control) override;
+
+  RequestXautoclaim Xautoclaim(std::string key, std::string group,
+                               std::string consumer,
+                               std::chrono::milliseconds min_idle_time,
+                               std::string start, size_t count,
+                               const CommandControl& command_control) override;
+
+  RequestXreadgroup Xreadgroup(std::string key, std::string group,
+                               std::string consumer, std::string id,
+                               size_t count,
+                               const CommandControl& command_control) override;
+
   RequestZadd Zadd(std::string key, double score, std::string member,
                    const CommandControl& command_control) override;
 
@@ -462,6 +486,16 @@ class ClientImpl final : public Client,
     return requests;
   }
 
+  struct KeysGroup {
+    size_t shard;
+    std::vector<size_t> positions;
+  };
+
+  // Groups the keys of a multi-key command by shards, and by hash slots in
+  // the cluster mode as a command there must not cross slots.
+  std::vector<KeysGroup> GroupKeysByShards(const std::vector<std::string>& keys,
+                                           const CommandControl& cc) const;
+
   CommandControl GetCommandControl(const CommandControl& cc) const;
 
   size_t GetPublishShard(
@@ -475,6 +509,9 @@ class ClientImpl final : public Client,
   std::shared_ptr<USERVER_NAMESPACE::redis::Sentinel> redis_client_;
   std::atomic<int> publish_shard_{0};
   const std::optional<size_t> force_shard_idx_;
+  const std::shared_ptr<ScriptCache> script_cache_;
+  boost::signals2::scoped_connection preload_connection_;
+  std::shared_ptr<utils::statistics::HotKeys> hot_keys_;
 };
 
 }  // namespace storages::redis
@@ -196,6 +196,19 @@ UTEST_F(RedisClientTest, Eval) {
   EXPECT_EQ(result[0], "key1");
 }
 
+UTEST_F(RedisClientTest, EvalCachedScript) {
+  auto client = GetClient();
+  const std::string script = "return KEYS[1] .. ARGV[1]";
+
+  // The first call registers the script, the next ones are sent as EVALSHA
+  for (const auto* arg : {"1", "2"}) {
+    EXPECT_EQ(client->Eval<std::string>(script, {"key"}, {arg}, {}).Get(),
+              std::string{"key"} + arg);
+  }
+  EXPECT_EQ(client->ScriptLoad(script, 0, {}).Get(),
+            "dc8235f4444d746adf3374579406c129fb1f0f0a");
+}
+
 UTEST_F(RedisClientTest, EvalSha) {
   auto client = GetClient();
 
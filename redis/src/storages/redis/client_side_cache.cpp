@@ -0,0 +1,97 @@
+#include <userver/storages/redis/client_side_cache.hpp>
+
+#include <algorithm>
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+namespace {
+
+std::string MakeChannelPrefix(std::size_t database) {
+  return "__keyspace@" + std::to_string(database) + "__:";
+}
+
+}  // namespace
+
+ClientSideCache::ClientSideCache(ClientPtr client,
+                                 SubscribeClientPtr subscribe_client,
+                                 const ClientSideCacheSettings& settings)
+    : client_(std::move(client)),
+      ttl_(settings.ttl),
+      channel_prefix_(MakeChannelPrefix(settings.database)),
+      entries_(std::max<std::size_t>(settings.ways, 1),
+               std::max<std::size_t>(
+                   settings.max_size / std::max<std::size_t>(settings.ways, 1),
+                   1)) {
+  UASSERT(client_);
+  UASSERT(subscribe_client);
+
+  auto prefixes = settings.prefixes;
+  if (prefixes.empty()) prefixes.emplace_back();
+  subscriptions_.reserve(prefixes.size());
+  for (const auto& prefix : prefixes) {
+    // The key is the suffix of the channel, the message is the event
+    subscriptions_.push_back(subscribe_client->Psubscribe(
+        channel_prefix_ + prefix + '*',
+        [this](const std::string&, const std::string& channel,
+               const std::string&) { OnNotification(channel); }));
+  }
+}
+
+std::optional<std::string> ClientSideCache::Get(
+    const std::string& key, const CommandControl& command_control) {
+  const auto now = Clock::now();
+  auto entry = entries_.Get(
+      key, [now](const Entry& entry) { return now < entry.expiration; });
+  if (entry) {
+    ++hits_;
+    return std::move(entry->value);
+  }
+
+  ++misses_;
+  // The TTL counts from the start of the command
+  const auto invalidations = invalidations_.load();
+  auto value = client_->Get(key, command_control).Get();
+  // A notification about the key could have been received before the reply
+  if (invalidations == invalidations_.load()) {
+    entries_.Put(key, Entry{value, now + ttl_});
+  }
+  return value;
+}
+
+void ClientSideCache::Invalidate(const std::string& key) {
+  ++invalidations_;
+  entries_.InvalidateByKey(key);
+}
+
+void ClientSideCache::InvalidateAll() {
+  ++invalidations_;
+  entries_.Invalidate();
+}
+
+ClientSideCacheStatistics ClientSideCache::GetStatistics() const {
+  ClientSideCacheStatistics stats;
+  stats.hits = hits_.load();
+  stats.misses = misses_.load();
+  stats.invalidations = invalidations_.load();
+  stats.size = entries_.GetSize();
+  return stats;
+}
+
+void ClientSideCache::OnNotification(const std::string& channel) {
+  if (channel.size() < channel_prefix_.size() ||
+      channel.compare(0, channel_prefix_.size(), channel_prefix_) != 0) {
+    LOG_LIMITED_WARNING() << "Unexpected keyspace notification channel '"
+                          << channel << "'";
+    return;
+  }
+  Invalidate(channel.substr(channel_prefix_.size()));
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -176,7 +176,8 @@ CommandControl::Strategy StrategyFromString(std::string_view strategy) {
         .Case("every_dc", Strategy::kEveryDc)
         .Case("default", Strategy::kDefault)
         .Case("local_dc_conductor", Strategy::kLocalDcConductor)
-        .Case("nearest_server_ping", Strategy::kNearestServerPing);
+        .Case("nearest_server_ping", Strategy::kNearestServerPing)
+        .Case("latency_weighted", Strategy::kLatencyWeighted);
   };
 
   auto result = kToStrategy.TryFind(strategy);
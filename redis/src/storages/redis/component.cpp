@@ -5,6 +5,7 @@
 
 #include <engine/ev/thread_pool.hpp>
 #include <userver/components/component.hpp>
+#include <userver/components/hot_keys_storage.hpp>
 #include <userver/components/statistics_storage.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/formats/json/value_builder.hpp>
@@ -73,6 +74,8 @@ struct RedisGroup {
   std::string config_name;
   std::string sharding_strategy;
   bool allow_reads_from_master{false};
+  bool hot_keys{false};
+  size_t connections_per_instance{1};
 };
 
 RedisGroup Parse(const yaml_config::YamlConfig& value,
@@ -83,6 +86,9 @@ RedisGroup Parse(const yaml_config::YamlConfig& value,
   config.sharding_strategy = value["sharding_strategy"].As<std::string>("");
   config.allow_reads_from_master =
       value["allow_reads_from_master"].As<bool>(false);
+  config.hot_keys = value["hot_keys"].As<bool>(false);
+  config.connections_per_instance =
+      value["connections_per_instance"].As<size_t>(1);
   return config;
 }
 
@@ -90,6 +96,7 @@ struct SubscribeRedisGroup {
   std::string db;
   std::string config_name;
   std::string sharding_strategy;
+  size_t connections_per_instance{1};
 };
 
 SubscribeRedisGroup Parse(const yaml_config::YamlConfig& value,
@@ -98,6 +105,8 @@ SubscribeRedisGroup Parse(const yaml_config::YamlConfig& value,
   config.db = value["db"].As<std::string>();
   config.config_name = value["config_name"].As<std::string>();
   config.sharding_strategy = value["sharding_strategy"].As<std::string>("");
+  config.connections_per_instance =
+      value["connections_per_instance"].As<size_t>(1);
   return config;
 }
 
@@ -223,9 +232,15 @@ void Redis::Connect(const ComponentConfig& config,
         redis_group.db, redis::KeyShardFactory{redis_group.sharding_strategy},
         cc, testsuite_redis_control);
     if (sentinel) {
+      sentinel->SetConnectionsPerInstance(redis_group.connections_per_instance);
       sentinels_.emplace(redis_group.db, sentinel);
       const auto& client =
           std::make_shared<storages::redis::ClientImpl>(sentinel);
+      if (redis_group.hot_keys) {
+        client->SetHotKeys(
+            component_context.FindComponent<components::HotKeysStorage>()
+                .GetHotKeys("redis." + redis_group.db));
+      }
       clients_.emplace(redis_group.db, client);
     } else {
       LOG_WARNING() << "skip redis client for " << redis_group.db;
@@ -250,13 +265,15 @@ void Redis::Connect(const ComponentConfig& config,
     auto sentinel = redis::SubscribeSentinel::Create(
         thread_pools_, settings, redis_group.config_name, config_source,
         redis_group.db, is_cluster_mode, testsuite_redis_control);
-    if (sentinel)
+    if (sentinel) {
+      sentinel->SetConnectionsPerInstance(redis_group.connections_per_instance);
       subscribe_clients_.emplace(
           redis_group.db,
           std::make_shared<storages::redis::SubscribeClientImpl>(
               std::move(sentinel)));
-    else
+    } else {
       LOG_WARNING() << "skip subscribe-redis client for " << redis_group.db;
+    }
   }
 
   auto redis_wait_connected_subscribe = redis_config.redis_wait_connected;
@@ -384,6 +401,15 @@ properties:
                     type: boolean
                     description: allows read requests from master instance
                     defaultDescription: false
+                hot_keys:
+                    type: boolean
+                    description: enables detection of the hot keys of the commands in components::HotKeysStorage
+                    defaultDescription: false
+                connections_per_instance:
+                    type: integer
+                    description: number of parallel connections to each Redis server served by different ev threads, should not exceed redis_thread_pool_size
+                    defaultDescription: 1
+                    minimum: 1
     metrics_level:
         type: string
         description: set metrics detail level
@@ -413,6 +439,11 @@ properties:
                     enum:
                       - RedisCluster
                       - KeyShardTaximeterCrc32
+                connections_per_instance:
+                    type: integer
+                    description: number of parallel connections to each Redis server, the subscriptions are distributed between them
+                    defaultDescription: 1
+                    minimum: 1
 )");
 }
 
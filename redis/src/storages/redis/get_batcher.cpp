@@ -0,0 +1,169 @@
+#include <userver/storages/redis/get_batcher.hpp>
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <vector>
+
+#include <boost/crc.hpp>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/storages/redis/impl/exception.hpp>
+#include <userver/storages/redis/impl/keyshard.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+namespace {
+
+// Group ids of the shards and of the hash slots do not intersect
+constexpr std::size_t kClusterHashSlots = 16384;
+
+std::size_t HashSlot(const std::string& key) {
+  std::size_t start = 0;
+  std::size_t len = 0;
+  USERVER_NAMESPACE::redis::GetRedisKey(key, &start, &len);
+  return std::for_each(key.data() + start, key.data() + start + len,
+                       boost::crc_optimal<16, 0x1021>())() &
+         (kClusterHashSlots - 1);
+}
+
+}  // namespace
+
+struct GetBatcher::Request {
+  std::string key;
+  CommandControl command_control;
+  engine::SingleConsumerEvent event{engine::SingleConsumerEvent::NoAutoReset{}};
+
+  /// Set when the request is handed the leadership instead of the value
+  bool lead{false};
+  std::optional<std::string> value{};
+  std::exception_ptr error{};
+};
+
+GetBatcher::GetBatcher(ClientPtr client, const GetBatcherSettings& settings)
+    : client_(std::move(client)), settings_(settings) {
+  UASSERT(client_);
+  UASSERT(settings_.max_batch_size > 0);
+  UASSERT(settings_.max_in_flight > 0);
+}
+
+std::optional<std::string> GetBatcher::Get(
+    std::string key, const CommandControl& command_control) {
+  Request request{std::move(key), command_control};
+  const auto group_id = GetGroupId(request.key);
+  {
+    const std::lock_guard lock{mutex_};
+    auto& group = groups_[group_id];
+    if (group.leaders < settings_.max_in_flight) {
+      ++group.leaders;
+      request.lead = true;
+    } else {
+      group.pending.push_back(&request);
+    }
+  }
+
+  if (!request.lead) WaitForTurn(group_id, request);
+  if (request.lead) Lead(group_id, request);
+
+  if (request.error) std::rethrow_exception(request.error);
+  return std::move(request.value);
+}
+
+std::size_t GetBatcher::GetGroupId(const std::string& key) const {
+  if (settings_.cluster_mode) return HashSlot(key);
+  return kClusterHashSlots + client_->ShardByKey(key);
+}
+
+void GetBatcher::WaitForTurn(std::size_t group_id, Request& request) {
+  if (request.event.WaitForEvent()) return;
+
+  {
+    const std::lock_guard lock{mutex_};
+    auto& pending = groups_[group_id].pending;
+    const auto it = std::find(pending.begin(), pending.end(), &request);
+    if (it != pending.end()) {
+      pending.erase(it);
+      throw USERVER_NAMESPACE::redis::RequestCancelledException(
+          "Task was cancelled while waiting for a batch");
+    }
+  }
+
+  // The key is already taken by a leader, which must not be left with a
+  // dangling request
+  const engine::TaskCancellationBlocker block_cancel;
+  [[maybe_unused]] const bool is_ready = request.event.WaitForEvent();
+  UASSERT(is_ready);
+}
+
+void GetBatcher::Lead(std::size_t group_id, Request& request) {
+  std::vector<Request*> followers;
+  {
+    const std::lock_guard lock{mutex_};
+    auto& pending = groups_[group_id].pending;
+    while (followers.size() + 1 < settings_.max_batch_size &&
+           !pending.empty()) {
+      followers.push_back(pending.front());
+      pending.pop_front();
+    }
+  }
+
+  {
+    // The keys of other tasks must not fail because of this task
+    const engine::TaskCancellationBlocker block_cancel;
+    try {
+      if (followers.empty()) {
+        request.value =
+            client_->Get(request.key, request.command_control).Get();
+      } else {
+        std::vector<std::string> keys;
+        keys.reserve(followers.size() + 1);
+        keys.push_back(request.key);
+        for (const auto* follower : followers) keys.push_back(follower->key);
+
+        auto values =
+            client_->Mget(std::move(keys), request.command_control).Get();
+        if (values.size() != followers.size() + 1) {
+          throw USERVER_NAMESPACE::redis::ParseReplyException(
+              "Unexpected number of values in MGET reply");
+        }
+        request.value = std::move(values[0]);
+        for (std::size_t i = 0; i < followers.size(); ++i) {
+          followers[i]->value = std::move(values[i + 1]);
+        }
+      }
+    } catch (const std::exception&) {
+      request.error = std::current_exception();
+      for (auto* follower : followers) follower->error = request.error;
+    }
+  }
+  request.lead = false;
+
+  for (auto* follower : followers) follower->event.Send();
+  HandOver(group_id);
+}
+
+void GetBatcher::HandOver(std::size_t group_id) {
+  Request* next = nullptr;
+  {
+    const std::lock_guard lock{mutex_};
+    const auto it = groups_.find(group_id);
+    UASSERT(it != groups_.end());
+    auto& group = it->second;
+    if (group.pending.empty()) {
+      if (--group.leaders == 0) groups_.erase(it);
+      return;
+    }
+    next = group.pending.front();
+    group.pending.pop_front();
+    next->lead = true;
+  }
+  next->event.Send();
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
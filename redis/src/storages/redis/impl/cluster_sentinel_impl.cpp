@@ -752,7 +752,7 @@ void ClusterSentinelImpl::Init() {
 
 void ClusterSentinelImpl::AsyncCommand(const SentinelCommand& scommand,
                                        size_t prev_instance_idx) {
-  if (!AdjustDeadline(scommand, dynamic_config_source_.GetSnapshot())) {
+  if (!AdjustDeadline(scommand, dynamic_config_source_)) {
     auto reply = std::make_shared<Reply>("", ReplyData::CreateNil());
     reply->status = ReplyStatus::kTimeoutError;
     InvokeCommand(scommand.command, std::move(reply));
@@ -7,6 +7,7 @@
 
 #include <userver/utils/assert.hpp>
 
+#include <storages/redis/impl/instance_selection.hpp>
 #include "command_control_impl.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -19,6 +20,7 @@ bool IsNearestServerPing(const CommandControlImpl& control) {
   switch (control.strategy) {
     case CommandControl::Strategy::kEveryDc:
     case CommandControl::Strategy::kDefault:
+    case CommandControl::Strategy::kLatencyWeighted:
       return false;
     case CommandControl::Strategy::kLocalDcConductor:
     case CommandControl::Strategy::kNearestServerPing:
@@ -86,6 +88,8 @@ bool ClusterShard::AsyncCommand(CommandPtr command) const {
   const auto& available_servers = GetAvailableServers(command->control);
   const auto servers_count = available_servers.size();
   const auto is_nearest_ping_server = IsNearestServerPing(cc);
+  const auto latency_weighted =
+      cc.strategy == CommandControl::Strategy::kLatencyWeighted;
   const auto is_retry = command->counter != 0;
 
   const auto masters_count = 1;
@@ -98,7 +102,8 @@ bool ClusterShard::AsyncCommand(CommandPtr command) const {
     size_t idx = SentinelImpl::kDefaultPrevInstanceIdx;
     const auto instance =
         GetInstance(available_servers, is_retry, start_idx, attempt,
-                    is_nearest_ping_server, cc.best_dc_count, &idx);
+                    is_nearest_ping_server, cc.best_dc_count,
+                    latency_weighted, &idx);
     if (!instance) {
       continue;
     }
@@ -122,6 +127,9 @@ ShardStatistics ClusterShard::GetStatistics(
     }
     auto inst_stats =
         redis::InstanceStatistics(settings, instance->GetStatistics());
+    inst_stats.selection_weight = instance->GetSelectionWeight();
+    inst_stats.connections = 1;
+    inst_stats.ev_thread_load_percent = instance->GetEvThreadLoadPercent();
     stats.shard_total.Add(inst_stats);
     auto master_host_port = instance->GetServerHost() + ":" +
                             std::to_string(instance->GetServerPort());
@@ -217,7 +225,7 @@ std::vector<ClusterShard::RedisConnectionPtr> ClusterShard::GetAvailableServers(
 ClusterShard::RedisPtr ClusterShard::GetInstance(
     const std::vector<RedisConnectionPtr>& instances, bool retry,
     size_t start_idx, size_t attempt, bool is_nearest_ping_server,
-    size_t best_dc_count, size_t* pinstance_idx) {
+    size_t best_dc_count, bool latency_weighted, size_t* pinstance_idx) {
   RedisPtr ret;
   const auto end = (is_nearest_ping_server && attempt == 0 && best_dc_count)
                        ? std::min(instances.size(), best_dc_count)
@@ -233,7 +241,7 @@ ClusterShard::RedisPtr ClusterShard::GetInstance(
     if (cur_inst && cur_inst->IsAvailable() &&
         (!retry || cur_inst->CanRetry()) &&
         (!ret || ret->IsDestroying() ||
-         cur_inst->GetRunningCommands() < ret->GetRunningCommands())) {
+         IsPreferredInstance(*cur_inst, *ret, latency_weighted))) {
       if (pinstance_idx) *pinstance_idx = idx;
       ret = cur_inst;
     }
@@ -63,7 +63,7 @@ class ClusterShard {
   static RedisPtr GetInstance(const std::vector<RedisConnectionPtr>& instances,
                               bool is_retry, size_t start_idx, size_t attempt,
                               bool is_nearest_ping_server, size_t best_dc_count,
-                              size_t* pinstance_idx);
+                              bool latency_weighted, size_t* pinstance_idx);
   std::vector<RedisConnectionPtr> MakeReadonlyWithMasters() const;
   bool IsMasterReady() const;
   bool IsReplicaReady() const;
@@ -0,0 +1,32 @@
+#include <storages/redis/impl/instance_selection.hpp>
+
+#include <algorithm>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+namespace {
+
+constexpr double kReplyLatencyExp = 0.9;
+// Keeps sub-millisecond latencies of the instances comparable
+constexpr double kMinReplyLatencyMs = 0.1;
+
+}  // namespace
+
+double UpdateReplyLatency(
+    double average_ms, std::chrono::steady_clock::duration latency) noexcept {
+  const std::chrono::duration<double, std::milli> latency_ms = latency;
+  return average_ms * kReplyLatencyExp +
+         latency_ms.count() * (1 - kReplyLatencyExp);
+}
+
+double GetSelectionWeight(double reply_latency_ms,
+                          std::size_t running_commands) noexcept {
+  const auto latency_ms = std::max(reply_latency_ms, kMinReplyLatencyMs);
+  return 1.0 / (latency_ms * static_cast<double>(running_commands + 1));
+}
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
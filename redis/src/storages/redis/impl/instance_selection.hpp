@@ -0,0 +1,33 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+
+/// Moving average of the reply latency of an instance after a reply that
+/// took `latency` since the instance has sent the command
+double UpdateReplyLatency(double average_ms,
+                          std::chrono::steady_clock::duration latency) noexcept;
+
+/// Relative preference of an instance for the latency weighted selection, the
+/// inverse of the expected time to get a reply to a new command
+double GetSelectionWeight(double reply_latency_ms,
+                          std::size_t running_commands) noexcept;
+
+/// @returns true if `candidate` should get the command instead of `best`,
+/// the best suitable instance found so far
+template <typename Instance>
+bool IsPreferredInstance(const Instance& candidate, const Instance& best,
+                         bool latency_weighted) {
+  if (latency_weighted) {
+    return candidate.GetSelectionWeight() > best.GetSelectionWeight();
+  }
+  return candidate.GetRunningCommands() < best.GetRunningCommands();
+}
+
+}  // namespace redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,113 @@
+#include <storages/redis/impl/instance_selection.hpp>
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+#include <storages/redis/impl/redis_stats.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using namespace std::chrono_literals;
+
+struct FakeInstance {
+  double GetSelectionWeight() const {
+    return redis::GetSelectionWeight(reply_latency_ms, running_commands);
+  }
+  std::size_t GetRunningCommands() const { return running_commands; }
+
+  double reply_latency_ms;
+  std::size_t running_commands;
+};
+
+// Same loop as in Shard::GetInstance and ClusterShard::GetInstance
+std::size_t SelectInstance(const std::vector<FakeInstance>& instances,
+                           bool latency_weighted) {
+  std::size_t best = 0;
+  for (std::size_t i = 1; i < instances.size(); ++i) {
+    if (redis::IsPreferredInstance(instances[i], instances[best],
+                                   latency_weighted)) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+}  // namespace
+
+TEST(RedisInstanceSelection, ReplyLatencyAverage) {
+  EXPECT_DOUBLE_EQ(redis::UpdateReplyLatency(0, 10ms), 1);
+  EXPECT_DOUBLE_EQ(redis::UpdateReplyLatency(10, 10ms), 10);
+
+  // A single slow reply moves the average only slightly
+  EXPECT_DOUBLE_EQ(redis::UpdateReplyLatency(1, 1001ms), 101);
+
+  double average = 10;
+  for (int i = 0; i < 100; ++i) {
+    average = redis::UpdateReplyLatency(average, 1ms);
+  }
+  EXPECT_NEAR(average, 1, 0.01);
+}
+
+TEST(RedisInstanceSelection, Weight) {
+  EXPECT_DOUBLE_EQ(redis::GetSelectionWeight(2, 0), 0.5);
+  EXPECT_DOUBLE_EQ(redis::GetSelectionWeight(2, 3), 0.125);
+
+  // Sub-millisecond latencies are clamped, so that an idle instance with no
+  // replies yet is comparable with the others
+  EXPECT_DOUBLE_EQ(redis::GetSelectionWeight(0, 0),
+                   redis::GetSelectionWeight(0.01, 0));
+  EXPECT_GT(redis::GetSelectionWeight(0, 0), redis::GetSelectionWeight(1, 0));
+}
+
+TEST(RedisInstanceSelection, LeastRunningCommandsByDefault) {
+  const std::vector<FakeInstance> instances{{1, 5}, {100, 2}, {1, 3}};
+  EXPECT_EQ(SelectInstance(instances, false), 1);
+}
+
+TEST(RedisInstanceSelection, LatencyWeighted) {
+  // The slow replica gets no traffic while the fast ones are not overloaded
+  EXPECT_EQ(SelectInstance({{10, 0}, {1, 0}, {2, 0}}, true), 1);
+  EXPECT_EQ(SelectInstance({{10, 0}, {1, 5}, {2, 1}}, true), 2);
+  EXPECT_EQ(SelectInstance({{10, 0}, {1, 10}, {2, 5}}, true), 0);
+
+  // Same latencies fall back to the least running commands
+  EXPECT_EQ(SelectInstance({{1, 3}, {1, 1}, {1, 2}}, true), 1);
+
+  // The first one of the equally good instances is kept
+  EXPECT_EQ(SelectInstance({{1, 1}, {1, 1}}, true), 0);
+}
+
+TEST(RedisInstanceSelection, NoPerInstanceMetricsInTotals) {
+  redis::MetricsSettings settings;
+  settings.static_settings.level = redis::MetricsSettings::Level::kShard;
+
+  redis::Statistics statistics;
+  statistics.reply_latency_ms = 5;
+  redis::InstanceStatistics instance_stats{settings, statistics};
+  instance_stats.selection_weight = 0.2;
+
+  redis::ShardStatistics shard_stats{settings};
+  shard_stats.shard_total.Add(instance_stats);
+  shard_stats.instances.emplace("localhost:6379", instance_stats);
+
+  utils::statistics::Storage storage;
+  const auto holder =
+      storage.RegisterWriter("redis", [&](utils::statistics::Writer& writer) {
+        writer = shard_stats;
+      });
+  const utils::statistics::Snapshot snapshot{storage, "redis"};
+
+  EXPECT_NO_THROW(snapshot.SingleMetric("reconnects"));
+  EXPECT_THROW(snapshot.SingleMetric("reply_latency_ms"),
+               utils::statistics::MetricQueryError);
+  EXPECT_THROW(snapshot.SingleMetric("selection_weight"),
+               utils::statistics::MetricQueryError);
+}
+
+USERVER_NAMESPACE_END
@@ -19,9 +19,11 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/swappingsmart.hpp>
+#include <userver/utils/trivial_map.hpp>
 
 #include <storages/redis/impl/command.hpp>
 #include <storages/redis/impl/ev_wrapper.hpp>
+#include <storages/redis/impl/instance_selection.hpp>
 #include <storages/redis/impl/redis_info.hpp>
 #include <storages/redis/impl/redis_stats.hpp>
 #include <storages/redis/impl/tcp_socket.hpp>
@@ -163,6 +165,7 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
   std::chrono::milliseconds GetPingLatency() const {
     return std::chrono::milliseconds(ping_latency_ms_);
   }
+  double GetSelectionWeight() const;
   void SetCommandsBufferingSettings(
       CommandsBufferingSettings commands_buffering_settings);
   void SetReplicationMonitoringSettings(
@@ -177,9 +180,12 @@ class Redis::RedisImpl : public std::enable_shared_from_this<Redis::RedisImpl> {
     CommandPtr meta;
     ev_timer timer{};
     std::shared_ptr<RedisImpl> redis_impl;
+    std::chrono::steady_clock::time_point send_time;
     bool invoke_disabled = false;
   };
 
+  void AccountReplyLatency(const SingleCommand& command);
+
   void DoDisconnect();
   void Attach();
   void Detach();
@@ -327,7 +333,12 @@ const std::string& Redis::StateToString(State state) {
 
 Redis::Redis(const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
              const RedisCreationSettings& redis_settings)
-    : thread_control_(thread_pool->NextThread()) {
+    : Redis(thread_pool, thread_pool->NextThread(), redis_settings) {}
+
+Redis::Redis(const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
+             const engine::ev::ThreadControl& thread_control,
+             const RedisCreationSettings& redis_settings)
+    : thread_control_(thread_control) {
   impl_ = std::make_shared<RedisImpl>(thread_pool, thread_control_, *this,
                                       redis_settings);
 }
@@ -363,6 +374,10 @@ std::chrono::milliseconds Redis::GetPingLatency() const {
   return impl_->GetPingLatency();
 }
 
+double Redis::GetSelectionWeight() const {
+  return impl_->GetSelectionWeight();
+}
+
 bool Redis::IsDestroying() const { return impl_->IsDestroying(); }
 
 bool Redis::IsSyncing() const { return impl_->IsSyncing(); }
@@ -375,6 +390,10 @@ std::string Redis::GetServerHost() const { return impl_->GetHost(); }
 
 uint16_t Redis::GetServerPort() const { return impl_->GetPort(); }
 
+std::uint8_t Redis::GetEvThreadLoadPercent() const {
+  return thread_control_.GetCurrentLoadPercent();
+}
+
 void Redis::SetCommandsBufferingSettings(
     CommandsBufferingSettings commands_buffering_settings) {
   impl_->SetCommandsBufferingSettings(commands_buffering_settings);
@@ -660,6 +679,7 @@ void Redis::RedisImpl::OnCommandTimeoutImpl(ev_timer* w) {
     UASSERT(w == &command.timer);
     reply_privdata_rev_.erase(&command.timer);
     command.invoke_disabled = true;
+    if (!subscriber_) AccountReplyLatency(command);
     InvokeCommandError(command.meta, command.cmd, ReplyStatus::kTimeoutError);
   }
 }
@@ -820,6 +840,19 @@ Redis::State Redis::RedisImpl::GetState() const { return state_; }
 
 size_t Redis::RedisImpl::GetRunningCommands() const { return sent_count_; }
 
+double Redis::RedisImpl::GetSelectionWeight() const {
+  return redis::GetSelectionWeight(statistics_.reply_latency_ms.load(),
+                                   sent_count_);
+}
+
+void Redis::RedisImpl::AccountReplyLatency(const SingleCommand& command) {
+  // Measured from the send by this instance, so that the time spent in the
+  // previous attempts of the command is not accounted
+  statistics_.reply_latency_ms =
+      UpdateReplyLatency(statistics_.reply_latency_ms.load(),
+                         std::chrono::steady_clock::now() - command.send_time);
+}
+
 logging::Level Redis::RedisImpl::StateChangeToLogLevel(State /*old_state*/,
                                                        State new_state) {
   switch (new_state) {
@@ -1171,6 +1204,9 @@ void Redis::RedisImpl::OnRedisReplyImpl(redisReply* redis_reply, void* privdata,
     if (subscriber_ &&
         (!reply->IsOk() || !reply->data || !reply->data.IsArray()))
       pcommand->invoke_disabled = true;
+    if (!subscriber_ && reply->status == ReplyStatus::kOk) {
+      AccountReplyLatency(*pcommand);
+    }
     InvokeCommand(pcommand->meta, std::move(reply));
   }
 }
@@ -1246,6 +1282,7 @@ void Redis::RedisImpl::ProcessCommand(const CommandPtr& command) {
       entry->meta = command;
       entry->timer.data = this;
       entry->redis_impl = shared_from_this();
+      entry->send_time = std::chrono::steady_clock::now();
       // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
       ev_timer_init(
           &entry->timer, OnCommandTimeout,
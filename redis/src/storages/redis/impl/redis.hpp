@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <cstring>
 #include <memory>
 #include <vector>
@@ -31,6 +32,10 @@ class Redis {
 
   Redis(const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
         const RedisCreationSettings& redis_settings);
+  // Serves the connection in the specified thread of the `thread_pool`
+  Redis(const std::shared_ptr<engine::ev::ThreadPool>& thread_pool,
+        const engine::ev::ThreadControl& thread_control,
+        const RedisCreationSettings& redis_settings);
   ~Redis();
 
   Redis(Redis&& o) = delete;
@@ -41,9 +46,14 @@ class Redis {
   bool AsyncCommand(const CommandPtr& command);
   size_t GetRunningCommands() const;
   std::chrono::milliseconds GetPingLatency() const;
+  // Relative preference of the instance for the latency weighted selection,
+  // the lower the reply latency and the fewer the running commands the higher
+  double GetSelectionWeight() const;
   bool IsDestroying() const;
   std::string GetServerHost() const;
   uint16_t GetServerPort() const;
+  // CPU load of the ev thread that serves the connection
+  std::uint8_t GetEvThreadLoadPercent() const;
   bool IsSyncing() const;
   bool IsAvailable() const;
   bool CanRetry() const;
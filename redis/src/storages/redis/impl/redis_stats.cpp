@@ -92,6 +92,9 @@ const std::string_view kCommandTypes[] = {
     "type",
     "unlink",
     "unsubscribe",
+    "xack",
+    "xautoclaim",
+    "xreadgroup",
     "zadd",
     "zcard",
     "zcount",
@@ -224,6 +227,10 @@ void DumpMetric(utils::statistics::Writer& writer,
 
   if (real_instance) {
     writer["last_ping_ms"] = stats.last_ping_ms;
+    writer["reply_latency_ms"] = stats.reply_latency_ms;
+    writer["selection_weight"] = stats.selection_weight;
+    writer["connections"] = stats.connections;
+    writer["ev_thread_load_percent"] = stats.ev_thread_load_percent;
     writer["is_syncing"] = static_cast<int>(stats.is_syncing);
     writer["offset_from_master"] = stats.offset_from_master;
 
@@ -255,6 +262,7 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["not_ready_ms"] = stats.is_ready ? 0 : not_ready;
   // writer["shard-total"] = stats.shard_total;
   writer["instances_count"] = stats.instances.size();
+  writer["ev_thread_load_percent"] = stats.shard_total.ev_thread_load_percent;
   DumpMetric(writer, stats.shard_total, false);
   if (settings.GetMetricsLevel() >= MetricsSettings::Level::kInstance) {
     for (const auto& [inst_name, inst_stats] : stats.instances) {
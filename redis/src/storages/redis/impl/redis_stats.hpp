@@ -1,8 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <map>
 #include <string_view>
 #include <unordered_map>
@@ -48,6 +50,7 @@ class Statistics {
   RecentPeriod timings_percentile;
   std::unordered_map<std::string_view, RecentPeriod> command_timings_percentile;
   std::atomic_llong last_ping_ms{};
+  std::atomic<double> reply_latency_ms{0};
   std::atomic_bool is_syncing = false;
   std::atomic_size_t offset_from_master_bytes = 0;
 
@@ -66,6 +69,8 @@ struct InstanceStatistics {
         reply_size_percentile(other.reply_size_percentile.GetStatsForPeriod()),
         timings_percentile(other.timings_percentile.GetStatsForPeriod()),
         last_ping_ms(other.last_ping_ms.load(std::memory_order_relaxed)),
+        reply_latency_ms(
+            other.reply_latency_ms.load(std::memory_order_relaxed)),
         is_syncing(other.is_syncing.load(std::memory_order_relaxed)),
         offset_from_master(
             other.offset_from_master_bytes.load(std::memory_order_relaxed)) {
@@ -92,6 +97,13 @@ struct InstanceStatistics {
 
     for (const auto& [command, timings] : other.command_timings_percentile)
       command_timings_percentile[command].Add(timings);
+
+    connections += other.connections;
+    ev_thread_load_percent =
+        std::max(ev_thread_load_percent, other.ev_thread_load_percent);
+
+    // last_ping_ms, reply_latency_ms and selection_weight describe a single
+    // instance, they are not summed up and not exported for the totals
   }
 
   const MetricsSettings& settings;
@@ -104,6 +116,12 @@ struct InstanceStatistics {
   std::unordered_map<std::string, Statistics::Percentile>
       command_timings_percentile;
   long long last_ping_ms;
+  double reply_latency_ms;
+  double selection_weight{0};
+  // Number of the connections to the instance, stats of all of them are summed
+  size_t connections{0};
+  // The highest CPU load among the ev threads serving the connections
+  std::uint8_t ev_thread_load_percent{0};
   bool is_syncing;
   long long offset_from_master;
 
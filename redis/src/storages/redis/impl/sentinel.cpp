@@ -272,6 +272,12 @@ size_t Sentinel::ShardByKey(const std::string& key) const {
 
 size_t Sentinel::ShardsCount() const { return impl_->ShardsCount(); }
 
+bool Sentinel::IsInClusterMode() const { return impl_->IsInClusterMode(); }
+
+size_t Sentinel::HashSlot(const std::string& key) {
+  return SentinelImpl::HashSlot(key);
+}
+
 void Sentinel::CheckShardIdx(size_t shard_idx) const {
   CheckShardIdx(shard_idx, ShardsCount());
 }
@@ -308,6 +314,10 @@ void Sentinel::SetRetryBudgetSettings(const RetryBudgetSettings& settings) {
   impl_->SetRetryBudgetSettings(settings);
 }
 
+void Sentinel::SetConnectionsPerInstance(size_t connections_per_instance) {
+  impl_->SetConnectionsPerInstance(connections_per_instance);
+}
+
 void Sentinel::SetClusterAutoTopology(bool auto_topology) {
   impl_->SetClusterAutoTopology(auto_topology);
 }
@@ -20,6 +20,7 @@
 #include <userver/storages/redis/impl/wait_connected_mode.hpp>
 
 #include <storages/redis/impl/redis_stats.hpp>
+#include <storages/redis/impl/subscription_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -39,6 +40,24 @@ const auto kSentinelGetHostsCheckInterval = std::chrono::seconds(3);
 const auto kProcessWaitingCommandsInterval = std::chrono::seconds(3);
 const auto kCheckRedisConnectedInterval = std::chrono::seconds(3);
 
+/// Message received from a channel. It is immutable and shared by all the
+/// subscribers of the channel, so that it is not copied per subscriber.
+struct PubsubMessage {
+  std::string data;
+  std::chrono::steady_clock::time_point received_at;
+  std::shared_ptr<PubsubDeliveryTimings> delivery_timings;
+
+  /// Called by every subscriber on the start of the message processing
+  void AccountDelivery() const {
+    if (delivery_timings) {
+      delivery_timings->Account(std::chrono::steady_clock::now() -
+                                received_at);
+    }
+  }
+};
+
+using PubsubMessagePtr = std::shared_ptr<const PubsubMessage>;
+
 // Forward declarations
 class SentinelImplBase;
 class SentinelImpl;
@@ -113,6 +132,8 @@ class Sentinel {
 
   size_t ShardByKey(const std::string& key) const;
   size_t ShardsCount() const;
+  bool IsInClusterMode() const;
+  static size_t HashSlot(const std::string& key);
   void CheckShardIdx(size_t shard_idx) const;
   static void CheckShardIdx(size_t shard_idx, size_t shard_count);
 
@@ -128,6 +149,9 @@ class Sentinel {
       const ReplicationMonitoringSettings& replication_monitoring_settings);
   void SetRetryBudgetSettings(const RetryBudgetSettings& settings);
   void SetClusterAutoTopology(bool auto_topology);
+  // Number of parallel connections to each Redis server, the commands are
+  // balanced between them by the count of running commands.
+  void SetConnectionsPerInstance(size_t connections_per_instance);
 
   // NOLINTNEXTLINE(misc-non-private-member-variables-in-classes)
   boost::signals2::signal<void(size_t shard)> signal_instances_changed;
@@ -174,11 +198,11 @@ class Sentinel {
   virtual void SetConfigDefaultCommandControl(
       const std::shared_ptr<CommandControl>& cc);
 
-  using UserMessageCallback = std::function<void(const std::string& channel,
-                                                 const std::string& message)>;
+  using UserMessageCallback = std::function<void(
+      const std::string& channel, const PubsubMessagePtr& message)>;
   using UserPmessageCallback =
       std::function<void(const std::string& pattern, const std::string& channel,
-                         const std::string& message)>;
+                         const PubsubMessagePtr& message)>;
 
   using MessageCallback =
       std::function<void(ServerId server_id, const std::string& channel,
@@ -193,6 +193,7 @@ void SentinelImpl::InitShards(
       if (ready_callback) ready_callback(i, shard, ready);
     };
     auto object = std::make_shared<Shard>(std::move(shard_options));
+    object->SetConnectionsPerInstance(connections_per_instance_);
     object->SignalInstanceStateChange().connect(
         [this](ServerId, Redis::State state) {
           if (state != Redis::State::kInit) ev_thread_.Send(watch_state_);
@@ -249,11 +250,11 @@ std::optional<std::chrono::milliseconds> GetDeadlineTimeLeft() {
 }  // namespace
 
 bool AdjustDeadline(const SentinelImplBase::SentinelCommand& scommand,
-                    const dynamic_config::Snapshot& config) {
+                    const dynamic_config::Source& config_source) {
   const auto inherited_deadline = GetDeadlineTimeLeft();
   if (!inherited_deadline) return true;
 
-  if (config[kDeadlinePropagationVersion] !=
+  if (config_source.GetCopy(kDeadlinePropagationVersion) !=
       kDeadlinePropagationExperimentVersion) {
     return true;
   }
@@ -273,7 +274,7 @@ bool AdjustDeadline(const SentinelImplBase::SentinelCommand& scommand,
 
 void SentinelImpl::AsyncCommand(const SentinelCommand& scommand,
                                 size_t prev_instance_idx) {
-  if (!AdjustDeadline(scommand, dynamic_config_source_.GetSnapshot())) {
+  if (!AdjustDeadline(scommand, dynamic_config_source_)) {
     auto reply = std::make_shared<Reply>("", ReplyData::CreateNil());
     reply->status = ReplyStatus::kTimeoutError;
     InvokeCommand(scommand.command, std::move(reply));
@@ -556,6 +557,12 @@ void SentinelImpl::SetRetryBudgetSettings(
     shard->SetRetryBudgetSettings(retry_budget_settings);
 }
 
+void SentinelImpl::SetConnectionsPerInstance(size_t connections_per_instance) {
+  connections_per_instance_ = connections_per_instance;
+  for (auto& shard : master_shards_)
+    shard->SetConnectionsPerInstance(connections_per_instance);
+}
+
 PublishSettings SentinelImpl::GetPublishSettings() {
   /// Why do we always publish to master? We can actually publish to any host in
   /// shard to distribute load evenly
@@ -92,12 +92,14 @@ class SentinelImplBase {
   virtual void SetRetryBudgetSettings(
       const RetryBudgetSettings& retry_budget_settings) = 0;
   virtual void SetClusterAutoTopology(bool /*auto_topology*/) {}
+  // Nodes of the auto topology cluster keep a single connection
+  virtual void SetConnectionsPerInstance(size_t /*connections_per_instance*/) {}
 
   virtual PublishSettings GetPublishSettings() = 0;
 };
 
 bool AdjustDeadline(const SentinelImplBase::SentinelCommand& scommand,
-                    const dynamic_config::Snapshot& config);
+                    const dynamic_config::Source& config_source);
 
 class SentinelImpl : public SentinelImplBase {
  public:
@@ -149,8 +151,11 @@ class SentinelImpl : public SentinelImplBase {
       override;
   void SetRetryBudgetSettings(
       const RetryBudgetSettings& retry_budget_settings) override;
+  void SetConnectionsPerInstance(size_t connections_per_instance) override;
   PublishSettings GetPublishSettings() override;
 
+  static size_t HashSlot(const std::string& key);
+
  private:
   static constexpr const std::chrono::milliseconds cluster_slots_timeout_ =
       std::chrono::milliseconds(4000);
@@ -243,8 +248,6 @@ class SentinelImpl : public SentinelImplBase {
                   std::vector<std::shared_ptr<Shard>>& shard_objects,
                   const ReadyChangeCallback& ready_callback);
 
-  static size_t HashSlot(const std::string& key);
-
   void ProcessWaitingCommands();
 
   Sentinel& sentinel_obj_;
@@ -284,6 +287,7 @@ class SentinelImpl : public SentinelImplBase {
   SentinelStatisticsInternal statistics_internal_;
   utils::SwappingSmart<KeysForShards> keys_for_shards_;
   std::optional<CommandsBufferingSettings> commands_buffering_settings_;
+  std::atomic<size_t> connections_per_instance_{1};
   dynamic_config::Source dynamic_config_source_;
   std::atomic<int> publish_shard_{0};
 };
@@ -161,6 +161,14 @@ void ClusterSentinelImplSwitcher::SetRetryBudgetSettings(
   impl->SetRetryBudgetSettings(settings);
 }
 
+void ClusterSentinelImplSwitcher::SetConnectionsPerInstance(
+    size_t connections_per_instance) {
+  connections_per_instance_ = connections_per_instance;
+  auto impl = impl_.Get();
+  UASSERT(impl);
+  impl->SetConnectionsPerInstance(connections_per_instance);
+}
+
 void ClusterSentinelImplSwitcher::SetClusterAutoTopology(bool auto_topology) {
   enabled_by_config_ = auto_topology;
   UpdateImpl(true, true);
@@ -209,6 +217,7 @@ void ClusterSentinelImplSwitcher::UpdateImpl(bool async, bool wait) {
         params_.connection_security, params_.ready_callback,
         std::unique_ptr<KeyShard>(), params_.dynamic_config_source,
         params_.mode);
+    sentinel->SetConnectionsPerInstance(connections_per_instance_);
     /// Wait using same settings that were requested by client
     if (wait) {
       params_.sentinel_thread_control.RunInEvLoopAsync(
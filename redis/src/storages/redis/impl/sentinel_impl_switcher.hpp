@@ -67,6 +67,7 @@ class ClusterSentinelImplSwitcher : public SentinelImplBase {
       override;
   void SetRetryBudgetSettings(const RetryBudgetSettings& settings) override;
   void SetClusterAutoTopology(bool auto_topology) override;
+  void SetConnectionsPerInstance(size_t connections_per_instance) override;
   PublishSettings GetPublishSettings() override;
   ///@}
 
@@ -100,6 +101,7 @@ class ClusterSentinelImplSwitcher : public SentinelImplBase {
   engine::Task create_task_;
   std::atomic<bool> enabled_by_config_ = false;
   std::atomic<bool> creating_impl_ = false;
+  std::atomic<size_t> connections_per_instance_ = 1;
 };
 
 }  // namespace redis
@@ -261,4 +261,40 @@ UTEST(Redis, SentinelForceShardIdx) {
   }
 }
 
+UTEST(Redis, SentinelConnectionsPerInstance) {
+  const size_t master_count = 1;
+  const size_t slave_count = 0;
+  const size_t sentinel_count = 1;
+  const int magic_value = 17;
+  const size_t connections_per_instance = 3;
+
+  SentinelTest sentinel_test(sentinel_count, master_count, slave_count,
+                             magic_value, 0, connections_per_instance);
+  auto& sentinel = sentinel_test.SentinelClient();
+  sentinel.SetConnectionsPerInstance(connections_per_instance);
+  sentinel.ForceUpdateHosts();
+
+  const redis::MetricsSettings metrics_settings;
+  size_t connections = 0;
+  for (auto i = 0; i < kSentinelChangeHostsMaxAttempts; ++i) {
+    const auto stats = sentinel.GetStatistics(metrics_settings);
+    for (const auto& [shard_name, shard_stats] : stats.masters) {
+      ASSERT_LE(shard_stats.instances.size(), 1UL) << shard_name;
+      for (const auto& [instance_name, instance_stats] :
+           shard_stats.instances) {
+        connections = instance_stats.connections;
+      }
+    }
+    if (connections == connections_per_instance) break;
+    engine::SleepFor(kSentinelChangeHostsWaitingTime);
+  }
+  EXPECT_EQ(connections, connections_per_instance);
+
+  for (size_t i = 0; i < connections_per_instance * 2; ++i) {
+    auto res = MakeGetRequest(sentinel, "value").Get();
+    ASSERT_TRUE(res->data.IsInt());
+    EXPECT_EQ(res->data.GetInt(), magic_value);
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -1,13 +1,15 @@
 #include <storages/redis/impl/shard.hpp>
 
+#include <algorithm>
+
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
 #include <userver/logging/log.hpp>
-#include <userver/utils/algo.hpp>
 #include <userver/utils/assert.hpp>
 
 #include <storages/redis/impl/command.hpp>
+#include <storages/redis/impl/instance_selection.hpp>
 #include <userver/storages/redis/impl/base.hpp>
 #include <userver/storages/redis/impl/retry_budget.hpp>
 
@@ -123,7 +125,8 @@ std::vector<unsigned char> Shard::GetAvailableServers(
 
   switch (cc.strategy) {
     case CommandControl::Strategy::kEveryDc:
-    case CommandControl::Strategy::kDefault: {
+    case CommandControl::Strategy::kDefault:
+    case CommandControl::Strategy::kLatencyWeighted: {
       std::vector<unsigned char> result(instances_.size(), 0);
       for (size_t i = 0; i < instances_.size(); i++) {
         result[i] =
@@ -160,17 +163,28 @@ std::vector<unsigned char> Shard::GetNearestServersPing(
 
   std::sort(sorted_by_ping.begin(), sorted_by_ping.end());
 
+  // There may be several connections to a server, all of them are used if
+  // the server is among the `count` nearest ones
+  std::vector<const ConnectionInfoInt*> selected_servers;
   auto result = std::vector<unsigned char>(instances_.size(), 0);
-  for (size_t i = 0; i < sorted_by_ping.size() && count > 0; ++i) {
+  for (size_t i = 0; i < sorted_by_ping.size(); ++i) {
     int num = sorted_by_ping[i].second;
     const auto& info = instances_[num].info;
     if ((with_slaves && info.IsReadOnly()) ||
         (with_masters && !info.IsReadOnly())) {
+      const bool is_selected = std::any_of(
+          selected_servers.begin(), selected_servers.end(),
+          [&info](const ConnectionInfoInt* selected) {
+            return *selected == info;
+          });
+      if (!is_selected) {
+        if (selected_servers.size() >= count) continue;
+        selected_servers.push_back(&info);
+      }
       result[num] = 1;
       LOG_DEBUG() << "Trying redis server with acceptable ping, server="
                   << instances_[num].instance->GetServerHost() << ", ping="
                   << instances_[num].instance->GetPingLatency().count();
-      --count;
     }
   }
   return result;
@@ -179,7 +193,7 @@ std::vector<unsigned char> Shard::GetNearestServersPing(
 std::shared_ptr<Redis> Shard::GetInstance(
     const std::vector<unsigned char>& available_servers, bool is_retry,
     bool may_fallback_to_any, size_t skip_idx, bool read_only,
-    size_t* pinstance_idx) {
+    bool latency_weighted, size_t* pinstance_idx) {
   std::shared_ptr<Redis> instance;
 
   auto end = instances_.size();
@@ -196,7 +210,7 @@ std::shared_ptr<Redis> Shard::GetInstance(
     if (cur_inst && cur_inst->IsAvailable() &&
         (!is_retry || cur_inst->CanRetry()) &&
         (!instance || instance->IsDestroying() ||
-         cur_inst->GetRunningCommands() < instance->GetRunningCommands())) {
+         IsPreferredInstance(*cur_inst, *instance, latency_weighted))) {
       if (pinstance_idx) *pinstance_idx = instance_idx;
       instance = cur_inst;
     }
@@ -230,6 +244,8 @@ bool Shard::AsyncCommand(CommandPtr command) {
   const auto& available_servers = GetAvailableServers(
       command->control, !command->read_only || cc.allow_reads_from_master,
       command->read_only);
+  const bool latency_weighted =
+      cc.strategy == CommandControl::Strategy::kLatencyWeighted;
 
   auto max_attempts = instances_.size() + 1;
   for (size_t attempt = 0; attempt < max_attempts; attempt++) {
@@ -244,7 +260,8 @@ bool Shard::AsyncCommand(CommandPtr command) {
         (attempt != 0 && cc.force_server_id.IsAny());
 
     instance = GetInstance(available_servers, is_retry, may_fallback_to_any,
-                           skip_idx, command->read_only, &idx);
+                           skip_idx, command->read_only, latency_weighted,
+                           &idx);
     command->instance_idx = idx;
 
     if (instance) {
@@ -289,14 +306,19 @@ bool Shard::ProcessCreation(
   std::vector<ConnectionStatus> add_clean_wait;
   add_clean_wait.reserve(need_to_create.size());
 
+  // Consecutive threads of the pool, so the connections to the same server
+  // created at once do not share an ev thread
+  const auto ev_threads = redis_thread_pool->NextThreads(need_to_create.size());
+
   // https://github.com/boostorg/signals2/issues/59
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDelete)
-  for (const auto& id : need_to_create) {
+  for (size_t i = 0; i < need_to_create.size(); ++i) {
+    const auto& id = need_to_create[i];
     const auto redis_settings = RedisCreationSettings{
         id.GetConnectionSecurity(), cluster_mode_ && id.IsReadOnly()};
     ConnectionStatus entry{
         id, std::make_shared<Redis>(
-                redis_thread_pool,
+                redis_thread_pool, *ev_threads[i],
                 // https://github.com/boostorg/signals2/issues/59
                 // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDelete)
                 redis_settings)};
@@ -402,8 +424,15 @@ ShardStatistics Shard::GetStatistics(bool master,
     if (!instance.instance || instance.info.IsReadOnly() == master) continue;
     auto inst_stats =
         redis::InstanceStatistics(settings, instance.instance->GetStatistics());
+    inst_stats.selection_weight = instance.instance->GetSelectionWeight();
+    inst_stats.connections = 1;
+    inst_stats.ev_thread_load_percent =
+        instance.instance->GetEvThreadLoadPercent();
     stats.shard_total.Add(inst_stats);
-    stats.instances.emplace(instance.info.Fulltext(), std::move(inst_stats));
+    // Connections to the same server are reported as a single instance
+    auto [it, inserted] = stats.instances.try_emplace(
+        instance.info.Fulltext(), std::move(inst_stats));
+    if (!inserted) it->second.Add(inst_stats);
     if (instance.instance->GetState() == Redis::State::kConnected) {
       stats.is_ready = true;
     }
@@ -481,15 +510,34 @@ void Shard::SetRetryBudgetSettings(
       std::make_shared<RetryBudgetSettings>(retry_budget_settings));
 }
 
+// Connections are created or closed on the next ProcessCreation() call
+void Shard::SetConnectionsPerInstance(size_t connections_per_instance) {
+  UINVARIANT(connections_per_instance > 0,
+             "At least one connection per instance is required");
+  std::unique_lock lock(mutex_);
+  connections_per_instance_ = connections_per_instance;
+}
+
 std::vector<ConnectionInfoInt> Shard::GetConnectionInfosToCreate() const {
   std::shared_lock lock(mutex_);
 
-  auto need_to_create = connection_infos_;
-
-  for (const auto& instance : instances_)
-    utils::Erase(need_to_create, instance.info);
-  for (const auto& instance : clean_wait_)
-    utils::Erase(need_to_create, instance.info);
+  const auto count_connections = [](const auto& statuses,
+                                    const ConnectionInfoInt& info) {
+    return static_cast<size_t>(
+        std::count_if(statuses.begin(), statuses.end(),
+                      [&info](const auto& status) {
+                        return status.info == info;
+                      }));
+  };
+
+  std::vector<ConnectionInfoInt> need_to_create;
+  for (const auto& info : connection_infos_) {
+    const auto existing = count_connections(instances_, info) +
+                          count_connections(clean_wait_, info);
+    for (auto i = existing; i < connections_per_instance_; ++i) {
+      need_to_create.push_back(info);
+    }
+  }
 
   return need_to_create;
 }
@@ -504,6 +552,9 @@ bool Shard::UpdateCleanWaitQueue(
     for (auto& instance : add_clean_wait)
       clean_wait_.push_back(std::move(instance));
 
+    // Extra connections are closed if connections_per_instance_ decreased
+    std::unordered_map<std::string, size_t> connections;
+
     // NOLINTNEXTLINE(readability-qualified-auto)
     for (auto instance_iterator = instances_.begin();
          instance_iterator != instances_.end();) {
@@ -511,7 +562,8 @@ bool Shard::UpdateCleanWaitQueue(
       auto conn_info =
           std::find(connection_infos_.begin(), connection_infos_.end(),
                     instance_iterator->info);
-      if (conn_info == connection_infos_.end()) {
+      if (conn_info == connection_infos_.end() ||
+          ++connections[conn_info->Fulltext()] > connections_per_instance_) {
         erase_instance.emplace_back(std::move(*instance_iterator));
         instance_iterator = instances_.erase(instance_iterator);
         instances_changed = true;
@@ -79,7 +79,7 @@ class Shard {
   std::shared_ptr<Redis> GetInstance(
       const std::vector<unsigned char>& available_servers, bool is_retry,
       bool may_fallback_to_any, size_t skip_idx, bool read_only,
-      size_t* pinstance_idx);
+      bool latency_weighted, size_t* pinstance_idx);
   void Clean();
   bool ProcessCreation(
       const std::shared_ptr<engine::ev::ThreadPool>& redis_thread_pool);
@@ -102,6 +102,11 @@ class Shard {
   void SetRetryBudgetSettings(
       const RetryBudgetSettings& replication_monitoring_settings);
 
+  // Number of parallel connections to each server of the shard. The commands
+  // are balanced between them, connections to the same server are served by
+  // different ev threads if the thread pool is large enough.
+  void SetConnectionsPerInstance(size_t connections_per_instance);
+
  private:
   std::vector<unsigned char> GetAvailableServers(
       const CommandControl& command_control, bool with_masters,
@@ -121,6 +126,7 @@ class Shard {
   std::vector<ConnectionInfoInt> connection_infos_;
   std::vector<ConnectionStatus> instances_;
   std::vector<ConnectionStatus> clean_wait_;
+  size_t connections_per_instance_{1};
   std::chrono::steady_clock::time_point last_connected_time_;
   std::chrono::steady_clock::time_point last_ready_time_ =
       std::chrono::steady_clock::now();
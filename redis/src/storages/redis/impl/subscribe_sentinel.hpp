@@ -65,6 +65,7 @@ class SubscribeSentinel : protected Sentinel {
 
   using Sentinel::Restart;
   using Sentinel::SetConfigDefaultCommandControl;
+  using Sentinel::SetConnectionsPerInstance;
   using Sentinel::ShardsCount;
   using Sentinel::WaitConnectedDebug;
   using Sentinel::WaitConnectedOnce;
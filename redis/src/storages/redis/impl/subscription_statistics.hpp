@@ -7,17 +7,43 @@
 #include <vector>
 
 #include <userver/storages/redis/impl/base.hpp>
+#include <userver/utils/datetime/steady_coarse_clock.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/recentperiod.hpp>
 #include <userver/utils/statistics/writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace redis {
 
+/// Times from receiving messages of a channel to the start of their
+/// processing by the subscribers, in milliseconds
+class PubsubDeliveryTimings {
+ public:
+  using Percentile = utils::statistics::Percentile<2048>;
+
+  void Account(std::chrono::steady_clock::duration delay) {
+    timings_.GetCurrentCounter().Account(
+        std::chrono::duration_cast<std::chrono::milliseconds>(delay).count());
+  }
+
+  Percentile GetStatsForPeriod(bool with_current_epoch = false) const {
+    return timings_.GetStatsForPeriod(
+        std::chrono::steady_clock::duration::min(), with_current_epoch);
+  }
+
+ private:
+  utils::statistics::RecentPeriod<Percentile, Percentile,
+                                  utils::datetime::SteadyClock>
+      timings_;
+};
+
 struct PubsubChannelStatistics {
   std::chrono::steady_clock::time_point subscription_timestamp;
   size_t messages_count{0};
   size_t messages_size{0};
   size_t messages_alien_count{0};
+  PubsubDeliveryTimings::Percentile delivery_timings;
 
   std::optional<ServerId> server_id;
 
@@ -33,6 +59,7 @@ struct PubsubChannelStatistics {
     messages_count += other.messages_count;
     messages_size += other.messages_size;
     messages_alien_count += other.messages_alien_count;
+    delivery_timings.Add(other.delivery_timings);
     return *this;
   }
 };
@@ -404,15 +404,19 @@ void SubscriptionStorageBase::SubscriptionStorageImpl<
   try {
     std::lock_guard<std::mutex> lock(mutex_);
     auto& m = callback_map_.at(channel);
+    auto& info = m.GetInfo(shard_idx);
+    const auto shared_message = std::make_shared<const PubsubMessage>(
+        PubsubMessage{message, std::chrono::steady_clock::now(),
+                      info.delivery_timings});
     for (const auto& it : m.callbacks) {
       try {
-        it.second(channel, message);
+        it.second(channel, shared_message);
       } catch (const std::exception& e) {
         LOG_ERROR() << "Unhandled exception in subscriber: " << e.what();
       }
     }
 
-    m.GetInfo(shard_idx).AccountMessage(server_id, message.size());
+    info.AccountMessage(server_id, message.size());
   } catch (const std::out_of_range& e) {
     LOG_ERROR() << "Got MESSAGE while not subscribed on it, channel="
                 << channel;
@@ -429,15 +433,19 @@ void SubscriptionStorageBase::SubscriptionStorageImpl<
   try {
     std::lock_guard<std::mutex> lock(mutex_);
     auto& m = pattern_callback_map_.at(pattern);
+    auto& info = m.GetInfo(shard_idx);
+    const auto shared_message = std::make_shared<const PubsubMessage>(
+        PubsubMessage{message, std::chrono::steady_clock::now(),
+                      info.delivery_timings});
     for (const auto& it : m.callbacks) {
       try {
-        it.second(pattern, channel, message);
+        it.second(pattern, channel, shared_message);
       } catch (const std::exception& e) {
         LOG_ERROR() << "Unhandled exception in subscriber: " << e.what();
       }
     }
 
-    m.GetInfo(shard_idx).AccountMessage(server_id, message.size());
+    info.AccountMessage(server_id, message.size());
   } catch (const std::out_of_range& e) {
     LOG_ERROR() << "Got PMESSAGE while not subscribed on it, channel="
                 << channel;
@@ -101,10 +101,14 @@ class SubscriptionStorageBase
 
     FsmPtr fsm;
     PubsubChannelStatistics statistics;
+    // Shared with the messages in the queues of the subscribers
+    std::shared_ptr<PubsubDeliveryTimings> delivery_timings =
+        std::make_shared<PubsubDeliveryTimings>();
 
     PubsubChannelStatistics GetStatistics() const {
       if (!fsm) return {};
       PubsubChannelStatistics stats(statistics);
+      stats.delivery_timings = delivery_timings->GetStatsForPeriod();
       stats.server_id = fsm->GetCurrentServerId();
       stats.subscription_timestamp = fsm->GetCurrentServerTimePoint();
       return stats;
@@ -0,0 +1,97 @@
+#include <storages/redis/impl/subscription_storage.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <userver/storages/redis/impl/reply.hpp>
+#include <userver/storages/redis/impl/thread_pools.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+#include <storages/redis/impl/command.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+const std::string kChannel = "channel";
+
+redis::ReplyPtr MakeMessageReply(const std::string& message) {
+  return std::make_shared<redis::Reply>(
+      "SUBSCRIBE", redis::ReplyData{redis::ReplyData::Array{
+                       redis::ReplyData{std::string{"message"}},
+                       redis::ReplyData{kChannel},
+                       redis::ReplyData{message},
+                   }});
+}
+
+}  // namespace
+
+TEST(SubscriptionStorage, SharedMessage) {
+  auto thread_pools = std::make_shared<redis::ThreadPools>(1, 1);
+  auto storage = std::make_shared<redis::SubscriptionStorage>(
+      thread_pools, 1, false,
+      std::make_shared<const std::vector<std::string>>(
+          std::vector<std::string>{"shard"}));
+
+  std::vector<redis::CommandPtr> subscribe_commands;
+  storage->SetSubscribeCallback(
+      [&](size_t /*shard*/, redis::CommandPtr command) {
+        subscribe_commands.push_back(std::move(command));
+      });
+  storage->SetUnsubscribeCallback([](size_t /*shard*/, redis::CommandPtr) {});
+
+  std::vector<redis::PubsubMessagePtr> messages;
+  const auto callback = [&](const std::string& channel,
+                            const redis::PubsubMessagePtr& message) {
+    EXPECT_EQ(channel, kChannel);
+    messages.push_back(message);
+  };
+  auto token1 = storage->Subscribe(kChannel, callback, {});
+  auto token2 = storage->Subscribe(kChannel, callback, {});
+
+  // The channel is subscribed to once for both of the subscribers
+  ASSERT_EQ(subscribe_commands.size(), 1U);
+  const auto& command = subscribe_commands.front();
+  command->callback(command, MakeMessageReply("payload"));
+
+  ASSERT_EQ(messages.size(), 2U);
+  EXPECT_EQ(messages[0], messages[1]);
+  EXPECT_EQ(messages[0]->data, "payload");
+
+  const auto& delivery_timings = messages[0]->delivery_timings;
+  ASSERT_TRUE(delivery_timings);
+  EXPECT_EQ(delivery_timings->GetStatsForPeriod(true).Count(), 0U);
+  for (const auto& message : messages) message->AccountDelivery();
+  EXPECT_EQ(delivery_timings->GetStatsForPeriod(true).Count(), 2U);
+
+  // The next message shares the timings of the channel
+  command->callback(command, MakeMessageReply("next payload"));
+  ASSERT_EQ(messages.size(), 4U);
+  EXPECT_EQ(messages[2], messages[3]);
+  EXPECT_NE(messages[0], messages[2]);
+  EXPECT_EQ(messages[2]->delivery_timings, delivery_timings);
+
+  const auto stats = storage->GetStatistics();
+  ASSERT_EQ(stats.by_shard.size(), 1U);
+  EXPECT_EQ(stats.by_shard[0].by_channel.at(kChannel).messages_count, 2U);
+}
+
+TEST(SubscriptionStorage, DeliveryTimingsMetric) {
+  redis::PubsubChannelStatistics stats;
+  stats.delivery_timings.Account(42);
+
+  utils::statistics::Storage storage;
+  const auto holder = storage.RegisterWriter(
+      "pubsub", [&](utils::statistics::Writer& writer) { writer = stats; });
+  const utils::statistics::Snapshot snapshot{storage, "pubsub"};
+
+  EXPECT_EQ(snapshot.SingleMetric("delivery_timings", {{"percentile", "p100"}})
+                .AsInt(),
+            42);
+}
+
+USERVER_NAMESPACE_END
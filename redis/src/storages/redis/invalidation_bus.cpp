@@ -0,0 +1,143 @@
+#include <userver/storages/redis/invalidation_bus.hpp>
+
+#include <algorithm>
+
+#include <storages/redis/invalidation_message.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/utils/uuid4.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+InvalidationBus::InvalidationBus(ClientPtr client,
+                                 SubscribeClientPtr subscribe_client,
+                                 InvalidationBusSettings settings)
+    : client_(std::move(client)),
+      settings_(std::move(settings)),
+      sender_id_(utils::generators::GenerateUuid()),
+      channel_("redis-invalidation-bus") {
+  UASSERT(client_);
+  UASSERT(subscribe_client);
+  UINVARIANT(settings_.max_batch_size > 0,
+             "Invalidation batches must not be empty");
+
+  subscription_ = subscribe_client->Subscribe(
+      settings_.channel,
+      [this](const std::string&, const std::string& message) {
+        OnMessage(message);
+      });
+  flush_task_.Start("redis-invalidation-bus-flush", settings_.flush_interval,
+                    [this] { Flush(); });
+}
+
+InvalidationBus::~InvalidationBus() {
+  flush_task_.Stop();
+  // Publish the invalidations made right before the shutdown
+  Flush();
+}
+
+void InvalidationBus::Invalidate(const std::string& cache_name,
+                                 std::vector<std::string> keys) {
+  if (keys.empty()) return;
+
+  // Read your writes on this instance
+  channel_.SendEvent(InvalidationBatch{cache_name, keys});
+
+  std::vector<std::string> full_batch;
+  {
+    auto pending = pending_.Lock();
+    auto& pending_keys = (*pending)[cache_name];
+    pending_keys.insert(pending_keys.end(),
+                        std::make_move_iterator(keys.begin()),
+                        std::make_move_iterator(keys.end()));
+    if (pending_keys.size() >= settings_.max_batch_size) {
+      full_batch = std::move(pending_keys);
+      pending->erase(cache_name);
+    }
+  }
+  if (!full_batch.empty()) Publish(cache_name, std::move(full_batch));
+}
+
+void InvalidationBus::Flush() {
+  PendingKeys pending;
+  {
+    auto locked = pending_.Lock();
+    std::swap(pending, *locked);
+  }
+  for (auto& [cache_name, keys] : pending) {
+    Publish(cache_name, std::move(keys));
+  }
+}
+
+concurrent::AsyncEventSource<const InvalidationBatch&>&
+InvalidationBus::GetSource() {
+  return channel_;
+}
+
+InvalidationBusStatistics InvalidationBus::GetStatistics() const {
+  InvalidationBusStatistics stats;
+  stats.published_messages = published_messages_.load();
+  stats.published_keys = published_keys_.load();
+  stats.received_messages = received_messages_.load();
+  stats.received_keys = received_keys_.load();
+  stats.malformed_messages = malformed_messages_.load();
+  stats.lag = lag_.GetStatsForPeriod();
+  return stats;
+}
+
+void InvalidationBus::OnMessage(const std::string& message) {
+  auto parsed = impl::ParseInvalidationMessage(message);
+  if (!parsed) {
+    ++malformed_messages_;
+    LOG_LIMITED_WARNING() << "Malformed message on the invalidation channel '"
+                          << settings_.channel << "'";
+    return;
+  }
+  // The keys were evicted on this instance on Invalidate
+  if (parsed->sender_id == sender_id_) return;
+
+  ++received_messages_;
+  received_keys_ += parsed->batch.keys.size();
+  // Clocks of the instances may differ a bit, a negative lag counts as zero
+  const auto lag = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now() - parsed->publish_time);
+  lag_.GetCurrentCounter().Account(
+      static_cast<std::size_t>(std::max<std::int64_t>(lag.count(), 0)));
+
+  channel_.SendEvent(parsed->batch);
+}
+
+void InvalidationBus::Publish(const std::string& cache_name,
+                              std::vector<std::string> keys) {
+  impl::InvalidationMessage message;
+  message.sender_id = sender_id_;
+  message.batch.cache_name = cache_name;
+  for (std::size_t begin = 0; begin < keys.size();
+       begin += settings_.max_batch_size) {
+    const auto end = std::min(keys.size(), begin + settings_.max_batch_size);
+    message.batch.keys.assign(std::make_move_iterator(keys.begin() + begin),
+                              std::make_move_iterator(keys.begin() + end));
+    message.publish_time = std::chrono::system_clock::now();
+    client_->Publish(settings_.channel,
+                     impl::SerializeInvalidationMessage(message), {});
+    ++published_messages_;
+    published_keys_ += message.batch.keys.size();
+  }
+}
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const InvalidationBusStatistics& stats) {
+  writer["published"]["messages"] = stats.published_messages;
+  writer["published"]["keys"] = stats.published_keys;
+  writer["received"]["messages"] = stats.received_messages;
+  writer["received"]["keys"] = stats.received_keys;
+  writer["received"]["malformed"] = stats.malformed_messages;
+  writer["lag"] = stats.lag;
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
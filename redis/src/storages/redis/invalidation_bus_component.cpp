@@ -0,0 +1,90 @@
+#include <userver/storages/redis/invalidation_bus_component.hpp>
+
+#include <string>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/components/statistics_storage.hpp>
+#include <userver/storages/redis/component.hpp>
+#include <userver/storages/redis/invalidation_bus.hpp>
+#include <userver/utils/statistics/writer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+namespace {
+
+InvalidationBusSettings ParseSettings(
+    const components::ComponentConfig& config) {
+  InvalidationBusSettings settings;
+  settings.channel = config["channel"].As<std::string>(settings.channel);
+  settings.flush_interval =
+      config["flush_interval"].As<std::chrono::milliseconds>(
+          settings.flush_interval);
+  settings.max_batch_size =
+      config["max_batch_size"].As<std::size_t>(settings.max_batch_size);
+  return settings;
+}
+
+}  // namespace
+
+InvalidationBusComponent::InvalidationBusComponent(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : components::LoggableComponentBase{config, context} {
+  auto& redis = context.FindComponent<components::Redis>();
+  const auto redis_name = config["redis_name"].As<std::string>();
+  const auto subscribe_redis_name =
+      config["subscribe_redis_name"].As<std::string>(redis_name);
+  bus_ = std::make_unique<InvalidationBus>(
+      redis.GetClient(redis_name),
+      redis.GetSubscribeClient(subscribe_redis_name), ParseSettings(config));
+
+  auto& storage =
+      context.FindComponent<components::StatisticsStorage>().GetStorage();
+  statistics_holder_ = storage.RegisterWriter(
+      std::string{kName}, [this](utils::statistics::Writer& writer) {
+        writer = bus_->GetStatistics();
+      });
+}
+
+InvalidationBusComponent::~InvalidationBusComponent() {
+  statistics_holder_.Unregister();
+}
+
+InvalidationBus& InvalidationBusComponent::GetBus() { return *bus_; }
+
+yaml_config::Schema InvalidationBusComponent::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
+type: object
+description: Cluster-wide cache invalidations over Redis pub/sub
+additionalProperties: false
+properties:
+    redis_name:
+        type: string
+        description: name of the redis database in components::Redis to publish
+    subscribe_redis_name:
+        type: string
+        description: name of the redis subscribe database in components::Redis
+        defaultDescription: redis_name
+    channel:
+        type: string
+        description: channel of the invalidations
+        defaultDescription: userver-cache-invalidations
+    flush_interval:
+        type: string
+        description: period of publishing the accumulated invalidations
+        defaultDescription: 10ms
+    max_batch_size:
+        type: integer
+        description: max keys of a cache in one message
+        defaultDescription: 1000
+        minimum: 1
+)");
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,86 @@
+#include <storages/redis/invalidation_message.hpp>
+
+#include <charconv>
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis::impl {
+
+namespace {
+
+constexpr std::string_view kFormatVersion = "1";
+
+void AppendField(std::string& message, std::string_view field) {
+  message.append(std::to_string(field.size()));
+  message.push_back(':');
+  message.append(field);
+}
+
+std::optional<std::string_view> ReadField(std::string_view& message) {
+  const auto separator = message.find(':');
+  if (separator == std::string_view::npos || separator == 0) {
+    return std::nullopt;
+  }
+  std::size_t size = 0;
+  const auto* const end = message.data() + separator;
+  const auto [ptr, error] = std::from_chars(message.data(), end, size);
+  if (error != std::errc{} || ptr != end ||
+      size > message.size() - separator - 1) {
+    return std::nullopt;
+  }
+  const auto field = message.substr(separator + 1, size);
+  message.remove_prefix(separator + 1 + size);
+  return field;
+}
+
+}  // namespace
+
+std::string SerializeInvalidationMessage(const InvalidationMessage& message) {
+  const auto publish_time =
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          message.publish_time.time_since_epoch())
+          .count();
+
+  std::string result;
+  AppendField(result, kFormatVersion);
+  AppendField(result, message.sender_id);
+  AppendField(result, std::to_string(publish_time));
+  AppendField(result, message.batch.cache_name);
+  for (const auto& key : message.batch.keys) AppendField(result, key);
+  return result;
+}
+
+std::optional<InvalidationMessage> ParseInvalidationMessage(
+    std::string_view message) {
+  const auto version = ReadField(message);
+  if (!version || *version != kFormatVersion) return std::nullopt;
+
+  InvalidationMessage result;
+  const auto sender_id = ReadField(message);
+  const auto publish_time = ReadField(message);
+  const auto cache_name = ReadField(message);
+  if (!sender_id || !publish_time || !cache_name) return std::nullopt;
+
+  std::int64_t microseconds = 0;
+  const auto* const end = publish_time->data() + publish_time->size();
+  const auto [ptr, error] =
+      std::from_chars(publish_time->data(), end, microseconds);
+  if (error != std::errc{} || ptr != end) return std::nullopt;
+
+  result.sender_id = *sender_id;
+  result.publish_time = std::chrono::system_clock::time_point{
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+          std::chrono::microseconds{microseconds})};
+  result.batch.cache_name = *cache_name;
+  while (!message.empty()) {
+    const auto key = ReadField(message);
+    if (!key) return std::nullopt;
+    result.batch.keys.emplace_back(*key);
+  }
+  return result;
+}
+
+}  // namespace storages::redis::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/storages/redis/invalidation_bus.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis::impl {
+
+/// A message of the storages::redis::InvalidationBus channel
+struct InvalidationMessage {
+  std::string sender_id;
+  std::chrono::system_clock::time_point publish_time;
+  InvalidationBatch batch;
+};
+
+/// The fields are length-prefixed: `<length>:<bytes>`. The fields are the
+/// format version, the sender, the publish time in microseconds since epoch,
+/// the cache name and the keys.
+std::string SerializeInvalidationMessage(const InvalidationMessage& message);
+
+/// @returns std::nullopt if the message is malformed
+std::optional<InvalidationMessage> ParseInvalidationMessage(
+    std::string_view message);
+
+}  // namespace storages::redis::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,59 @@
+#include <userver/utest/utest.hpp>
+
+#include <storages/redis/invalidation_message.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using storages::redis::impl::InvalidationMessage;
+using storages::redis::impl::ParseInvalidationMessage;
+using storages::redis::impl::SerializeInvalidationMessage;
+
+InvalidationMessage MakeMessage() {
+  InvalidationMessage message;
+  message.sender_id = "sender";
+  message.publish_time = std::chrono::system_clock::time_point{
+      std::chrono::microseconds{1'700'000'000'123'456}};
+  message.batch.cache_name = "users";
+  // Keys may contain the separator and be empty
+  message.batch.keys = {"1", "a:b", "", "12:x"};
+  return message;
+}
+
+}  // namespace
+
+TEST(RedisInvalidationMessage, RoundTrip) {
+  const auto message = MakeMessage();
+  const auto parsed =
+      ParseInvalidationMessage(SerializeInvalidationMessage(message));
+  ASSERT_TRUE(parsed);
+  EXPECT_EQ(parsed->sender_id, message.sender_id);
+  EXPECT_EQ(parsed->publish_time, message.publish_time);
+  EXPECT_EQ(parsed->batch.cache_name, message.batch.cache_name);
+  EXPECT_EQ(parsed->batch.keys, message.batch.keys);
+}
+
+TEST(RedisInvalidationMessage, NoKeys) {
+  auto message = MakeMessage();
+  message.batch.keys.clear();
+  const auto parsed =
+      ParseInvalidationMessage(SerializeInvalidationMessage(message));
+  ASSERT_TRUE(parsed);
+  EXPECT_TRUE(parsed->batch.keys.empty());
+}
+
+TEST(RedisInvalidationMessage, Malformed) {
+  const auto serialized = SerializeInvalidationMessage(MakeMessage());
+  EXPECT_FALSE(ParseInvalidationMessage(""));
+  EXPECT_FALSE(ParseInvalidationMessage("garbage"));
+  EXPECT_FALSE(ParseInvalidationMessage(serialized.substr(0, 20)));
+  EXPECT_FALSE(
+      ParseInvalidationMessage(serialized.substr(0, serialized.size() - 1)));
+  // Unknown format version
+  EXPECT_FALSE(ParseInvalidationMessage("1:2" + serialized.substr(3)));
+  EXPECT_FALSE(ParseInvalidationMessage("1:16:s3:abc5:users"));
+  EXPECT_FALSE(ParseInvalidationMessage("1:16:s1:15:users1:"));
+}
+
+USERVER_NAMESPACE_END
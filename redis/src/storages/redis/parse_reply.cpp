@@ -1,5 +1,7 @@
 #include <userver/storages/redis/parse_reply.hpp>
 
+#include <iterator>
+
 #include <userver/storages/redis/reply.hpp>
 #include <userver/utils/from_string.hpp>
 
@@ -37,6 +39,39 @@ ReplyData::MovableKeyValues GetKeyValues(
   }
 }
 
+// [[id, [field, value, ...]], ...], entries deleted from the stream have nil
+// fields
+std::vector<StreamEntry> ParseStreamEntries(
+    ReplyData& entries_data, const std::string& request_description) {
+  entries_data.ExpectArray(request_description);
+  auto& entries = entries_data.GetArray();
+
+  std::vector<StreamEntry> result;
+  result.reserve(entries.size());
+  for (auto& entry : entries) {
+    entry.ExpectArray(request_description);
+    auto& entry_array = entry.GetArray();
+    if (entry_array.size() != 2) {
+      throw USERVER_NAMESPACE::redis::ParseReplyException(
+          "Unexpected stream entry in reply to '" + request_description +
+          "': " + entry.ToDebugString());
+    }
+    if (entry_array[1].IsNil()) continue;
+    entry_array[0].ExpectString(request_description);
+
+    StreamEntry stream_entry;
+    stream_entry.id = std::move(entry_array[0].GetString());
+    auto key_values = GetKeyValues(entry_array[1], request_description);
+    stream_entry.fields.reserve(key_values.size());
+    for (auto elem : key_values) {
+      stream_entry.fields.emplace_back(std::move(elem.Key()),
+                                       std::move(elem.Value()));
+    }
+    result.push_back(std::move(stream_entry));
+  }
+  return result;
+}
+
 Point ParsePointArray(const redis::ReplyData& elem,
                       const std::string& request_description) {
   const auto& array = elem.GetArray();
@@ -174,19 +209,20 @@ std::vector<GeoPoint> ParseReplyDataArray(
     [[maybe_unused]] const std::string& request_description,
     To<std::vector<GeoPoint>>) {
   std::vector<GeoPoint> result;
+  result.reserve(array_data.GetArray().size());
 
   for (auto& elem : array_data.GetArray()) {
     GeoPoint geo_point;
     if (elem.IsString()) {
       geo_point.member = std::move(elem.GetString());
     } else if (elem.IsArray()) {
-      auto additional_infos = elem.GetArray();
+      auto& additional_infos = elem.GetArray();
       if (additional_infos.empty()) {
         throw USERVER_NAMESPACE::redis::ParseReplyException(
             "Can't parse value from reply to '" + request_description +
             ", additional_info item is empty array");
       }
-      geo_point.member = additional_infos[0].GetString();
+      geo_point.member = std::move(additional_infos[0].GetString());
 
       for (size_t i = 1; i < additional_infos.size(); ++i) {
         const auto& sub_elem = additional_infos[i];
@@ -383,6 +419,49 @@ ReplyData Parse(ReplyData&& reply_data, const std::string&, To<ReplyData>) {
   return std::move(reply_data);
 }
 
+std::vector<StreamEntry> Parse(ReplyData&& reply_data,
+                               const std::string& request_description,
+                               To<std::vector<StreamEntry>>) {
+  if (reply_data.IsNil()) return {};
+  reply_data.ExpectArray(request_description);
+
+  // [[stream, entries], ...]
+  std::vector<StreamEntry> result;
+  for (auto& stream : reply_data.GetArray()) {
+    stream.ExpectArray(request_description);
+    auto& stream_array = stream.GetArray();
+    if (stream_array.size() != 2) {
+      throw USERVER_NAMESPACE::redis::ParseReplyException(
+          "Unexpected stream in reply to '" + request_description +
+          "': " + stream.ToDebugString());
+    }
+    auto entries = ParseStreamEntries(stream_array[1], request_description);
+    std::move(entries.begin(), entries.end(), std::back_inserter(result));
+  }
+  return result;
+}
+
+XautoclaimReply Parse(ReplyData&& reply_data,
+                      const std::string& request_description,
+                      To<XautoclaimReply>) {
+  reply_data.ExpectArray(request_description);
+
+  // [next_start_id, entries] or [next_start_id, entries, deleted_ids] since
+  // Redis 7.0
+  auto& array = reply_data.GetArray();
+  if (array.size() < 2) {
+    throw USERVER_NAMESPACE::redis::ParseReplyException(
+        "Unexpected reply to '" + request_description +
+        "': " + reply_data.ToDebugString());
+  }
+  array[0].ExpectString(request_description);
+
+  XautoclaimReply result;
+  result.next_start_id = std::move(array[0].GetString());
+  result.entries = ParseStreamEntries(array[1], request_description);
+  return result;
+}
+
 }  // namespace storages::redis
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include "request_data_impl.hpp"
 
+#include <boost/algorithm/string/predicate.hpp>
+
 #include <userver/logging/log.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -26,6 +28,38 @@ RequestDataImplBase::~RequestDataImplBase() = default;
 
 ReplyPtr RequestDataImplBase::GetReply() { return request_.Get(); }
 
+EvalRequestDataImpl::EvalRequestDataImpl(
+    std::shared_ptr<ClientImpl> client,
+    USERVER_NAMESPACE::redis::Request&& request, Retry&& retry)
+    : RequestDataImplBase(std::move(request)),
+      client_(std::move(client)),
+      retry_(std::move(retry)) {}
+
+void EvalRequestDataImpl::Wait() { impl::Wait(GetRequest()); }
+
+ReplyData EvalRequestDataImpl::Get(const std::string& request_description) {
+  return ParseReply<ReplyData, ReplyData>(GetRaw(), request_description);
+}
+
+ReplyPtr EvalRequestDataImpl::GetRaw() {
+  auto reply = GetReply();
+  if (!reply->IsOk() || !reply->data.IsError() ||
+      !boost::starts_with(reply->data.GetError(), "NOSCRIPT")) {
+    return reply;
+  }
+
+  LOG_INFO() << "Script " << retry_.sha << " is not loaded to shard "
+             << retry_.shard << ", loading it";
+  client_
+      ->ScriptLoad(std::move(retry_.script), retry_.shard,
+                   retry_.command_control)
+      .Get();
+  return client_
+      ->EvalShaCommon(std::move(retry_.sha), std::move(retry_.keys),
+                      std::move(retry_.args), retry_.command_control)
+      .GetRaw();
+}
+
 USERVER_NAMESPACE::redis::Request& RequestDataImplBase::GetRequest() {
   return request_;
 }
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <userver/storages/redis/impl/base.hpp>
 #include <userver/storages/redis/impl/request.hpp>
@@ -73,6 +74,35 @@ class RequestDataImpl final : public RequestDataImplBase,
   ReplyPtr GetRaw() override { return GetReply(); }
 };
 
+/// EVALSHA of a script registered in ScriptCache, on a NOSCRIPT error loads
+/// the script to the shard and retries once
+class EvalRequestDataImpl final : public RequestDataImplBase,
+                                  public RequestDataBase<ReplyData> {
+ public:
+  struct Retry {
+    std::string script;
+    std::string sha;
+    std::vector<std::string> keys;
+    std::vector<std::string> args;
+    size_t shard;
+    CommandControl command_control;
+  };
+
+  EvalRequestDataImpl(std::shared_ptr<ClientImpl> client,
+                      USERVER_NAMESPACE::redis::Request&& request,
+                      Retry&& retry);
+
+  void Wait() override;
+
+  ReplyData Get(const std::string& request_description) override;
+
+  ReplyPtr GetRaw() override;
+
+ private:
+  std::shared_ptr<ClientImpl> client_;
+  Retry retry_;
+};
+
 template <typename Result, typename ReplyType>
 class AggregateRequestDataImpl final : public RequestDataBase<ReplyType> {
   using RequestDataPtr = std::unique_ptr<RequestDataBase<ReplyType>>;
@@ -81,6 +111,14 @@ class AggregateRequestDataImpl final : public RequestDataBase<ReplyType> {
   explicit AggregateRequestDataImpl(std::vector<RequestDataPtr>&& requests)
       : requests_(std::move(requests)) {}
 
+  /// `positions[i]` are the indices in the result of the elements of
+  /// the reply to `requests[i]`
+  AggregateRequestDataImpl(std::vector<RequestDataPtr>&& requests,
+                           std::vector<std::vector<size_t>>&& positions)
+      : requests_(std::move(requests)), positions_(std::move(positions)) {
+    UASSERT(requests_.size() == positions_.size());
+  }
+
   void Wait() override {
     for (auto& request : requests_) {
       request->Wait();
@@ -88,6 +126,8 @@ class AggregateRequestDataImpl final : public RequestDataBase<ReplyType> {
   }
 
   ReplyType Get(const std::string& request_description) override {
+    if (!positions_.empty()) return GetReordered(request_description);
+
     std::vector<typename ReplyType::value_type> result;
     for (auto& request : requests_) {
       auto data = request->Get(request_description);
@@ -102,7 +142,29 @@ class AggregateRequestDataImpl final : public RequestDataBase<ReplyType> {
   }
 
  private:
+  ReplyType GetReordered(const std::string& request_description) {
+    size_t size = 0;
+    for (const auto& positions : positions_) size += positions.size();
+
+    std::vector<typename ReplyType::value_type> result(size);
+    for (size_t i = 0; i < requests_.size(); ++i) {
+      auto data = requests_[i]->Get(request_description);
+      const auto& positions = positions_[i];
+      if (data.size() != positions.size()) {
+        throw USERVER_NAMESPACE::redis::ParseReplyException(
+            "Unexpected number of elements in reply to '" +
+            request_description + "': " + std::to_string(data.size()) +
+            " != " + std::to_string(positions.size()));
+      }
+      for (size_t j = 0; j < data.size(); ++j) {
+        result[positions[j]] = std::move(data[j]);
+      }
+    }
+    return result;
+  }
+
   std::vector<RequestDataPtr> requests_;
+  std::vector<std::vector<size_t>> positions_;
 };
 
 template <typename Result, typename ReplyType>
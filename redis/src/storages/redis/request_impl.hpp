@@ -34,6 +34,22 @@ Request<Result, ReplyType> CreateAggregateRequest(
           std::move(req_data)));
 }
 
+template <typename Result, typename ReplyType = Result>
+Request<Result, ReplyType> CreateAggregateRequest(
+    std::vector<USERVER_NAMESPACE::redis::Request>&& requests,
+    std::vector<std::vector<size_t>>&& positions,
+    Request<Result, ReplyType>* /* for ADL */) {
+  std::vector<std::unique_ptr<RequestDataBase<ReplyType>>> req_data;
+  req_data.reserve(requests.size());
+  for (auto& request : requests) {
+    req_data.push_back(std::make_unique<RequestDataImpl<Result, ReplyType>>(
+        std::move(request)));
+  }
+  return Request<Result, ReplyType>(
+      std::make_unique<AggregateRequestDataImpl<Result, ReplyType>>(
+          std::move(req_data), std::move(positions)));
+}
+
 template <typename Result, typename ReplyType = Result>
 Request<Result, ReplyType> CreateDummyRequest(
     ReplyPtr&& reply, Request<Result, ReplyType>* /* for ADL */) {
@@ -57,6 +73,15 @@ Request CreateAggregateRequest(
   return impl::CreateAggregateRequest(std::move(requests), tmp);
 }
 
+template <typename Request>
+Request CreateAggregateRequest(
+    std::vector<USERVER_NAMESPACE::redis::Request>&& requests,
+    std::vector<std::vector<size_t>>&& positions) {
+  Request* tmp = nullptr;
+  return impl::CreateAggregateRequest(std::move(requests),
+                                      std::move(positions), tmp);
+}
+
 template <typename Request>
 Request CreateDummyRequest(ReplyPtr reply) {
   Request* tmp = nullptr;
@@ -0,0 +1,70 @@
+#include "script_cache.hpp"
+
+#include <userver/crypto/hash.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/storages/redis/reply.hpp>
+
+#include <storages/redis/impl/command.hpp>
+#include <storages/redis/impl/sentinel.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+namespace {
+
+void LoadToShard(USERVER_NAMESPACE::redis::Sentinel& sentinel,
+                 std::string script, size_t shard, const CommandControl& cc) {
+  sentinel.AsyncCommand(
+      USERVER_NAMESPACE::redis::PrepareCommand(
+          USERVER_NAMESPACE::redis::CmdArgs{"script", "load",
+                                            std::move(script)},
+          [shard](const USERVER_NAMESPACE::redis::CommandPtr&,
+                  ReplyPtr reply) {
+            if (!reply->IsOk() || reply->data.IsError()) {
+              LOG_WARNING() << "Failed to preload a script to shard " << shard
+                            << ": " << reply->data.ToDebugString();
+            }
+          },
+          cc),
+      true, shard);
+}
+
+}  // namespace
+
+ScriptCache::Script ScriptCache::Register(const std::string& script) {
+  {
+    auto shas = shas_.UniqueLock();
+    const auto it = shas->find(script);
+    if (it != shas->end()) return {it->second, false};
+  }
+
+  auto sha = crypto::hash::Sha1(script);
+  auto shas = shas_.UniqueLock();
+  const auto [it, inserted] = shas->emplace(script, std::move(sha));
+  return {it->second, inserted};
+}
+
+void ScriptCache::Load(USERVER_NAMESPACE::redis::Sentinel& sentinel,
+                       const std::string& script, const CommandControl& cc) {
+  for (size_t shard = 0; shard < sentinel.ShardsCount(); ++shard) {
+    LoadToShard(sentinel, script, shard, cc);
+  }
+}
+
+void ScriptCache::LoadAll(USERVER_NAMESPACE::redis::Sentinel& sentinel,
+                          size_t shard, const CommandControl& cc) const {
+  std::vector<std::string> scripts;
+  {
+    const auto shas = shas_.UniqueLock();
+    scripts.reserve(shas->size());
+    for (const auto& [script, sha] : *shas) scripts.push_back(script);
+  }
+  for (auto& script : scripts) {
+    LoadToShard(sentinel, std::move(script), shard, cc);
+  }
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/concurrent/variable.hpp>
+#include <userver/storages/redis/command_options.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace redis {
+class Sentinel;
+}  // namespace redis
+
+namespace storages::redis {
+
+/// Lua scripts evaluated by a client, sent as EVALSHA instead of EVAL and
+/// loaded to the shards beforehand
+class ScriptCache final {
+ public:
+  struct Script {
+    std::string sha;
+    bool is_new{false};
+  };
+
+  /// Returns the SHA1 of the script, remembering the script on the first call
+  Script Register(const std::string& script);
+
+  /// Sends SCRIPT LOAD of the script to every shard without waiting
+  static void Load(USERVER_NAMESPACE::redis::Sentinel& sentinel,
+                   const std::string& script, const CommandControl& cc);
+
+  /// Sends SCRIPT LOAD of every registered script to the shard without
+  /// waiting, called when the instances of the shard change
+  void LoadAll(USERVER_NAMESPACE::redis::Sentinel& sentinel, size_t shard,
+               const CommandControl& cc) const;
+
+ private:
+  // The shard instances are changed from the event loop threads
+  concurrent::Variable<std::unordered_map<std::string, std::string>,
+                       std::mutex>
+      shas_;
+};
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
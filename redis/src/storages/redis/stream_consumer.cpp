@@ -0,0 +1,141 @@
+#include <userver/storages/redis/stream_consumer.hpp>
+
+#include <optional>
+
+#include <userver/engine/semaphore.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+namespace {
+
+/// XAUTOCLAIM returns this cursor after the last page of the pending entries
+const std::string kStartId = "0-0";
+
+/// XREADGROUP id for the entries never delivered to the group
+const std::string kNewEntriesId = ">";
+
+}  // namespace
+
+StreamConsumer::StreamConsumer(ClientPtr client,
+                               StreamConsumerSettings settings,
+                               Callback callback,
+                               engine::TaskProcessor& task_processor)
+    : client_(std::move(client)),
+      settings_(std::move(settings)),
+      callback_(std::move(callback)),
+      task_processor_(task_processor) {
+  UASSERT(client_);
+  UASSERT(callback_);
+  UINVARIANT(settings_.batch_size > 0, "batch_size is set to zero");
+  UINVARIANT(settings_.max_in_flight > 0, "max_in_flight is set to zero");
+}
+
+StreamConsumer::~StreamConsumer() { Stop(); }
+
+void StreamConsumer::Start() {
+  if (task_.IsValid()) return;
+  task_ = utils::CriticalAsync(task_processor_, "redis_stream_consumer",
+                               [this] { Run(); });
+}
+
+void StreamConsumer::Stop() noexcept {
+  if (task_.IsValid()) {
+    task_.SyncCancel();
+    task_ = {};
+  }
+}
+
+void StreamConsumer::Run() {
+  auto next_claim = std::chrono::steady_clock::now();
+  while (!engine::current_task::ShouldCancel()) {
+    try {
+      if (std::chrono::steady_clock::now() >= next_claim) {
+        if (Claim()) {
+          next_claim =
+              std::chrono::steady_clock::now() + settings_.claim_interval;
+        }
+        continue;
+      }
+
+      auto entries =
+          client_
+              ->Xreadgroup(settings_.stream, settings_.group,
+                           settings_.consumer, kNewEntriesId,
+                           settings_.batch_size, settings_.command_control)
+              .Get();
+      if (entries.empty()) {
+        engine::InterruptibleSleepFor(settings_.poll_interval);
+        continue;
+      }
+      ProcessBatch(std::move(entries));
+    } catch (const std::exception& ex) {
+      if (engine::current_task::ShouldCancel()) break;
+      LOG_WARNING() << "Failed to consume Redis stream '" << settings_.stream
+                    << "': " << ex;
+      engine::InterruptibleSleepFor(settings_.poll_interval);
+    }
+  }
+}
+
+bool StreamConsumer::Claim() {
+  auto reply =
+      client_
+          ->Xautoclaim(settings_.stream, settings_.group, settings_.consumer,
+                       settings_.min_idle_time, claim_start_,
+                       settings_.batch_size, settings_.command_control)
+          .Get();
+  claim_start_ = std::move(reply.next_start_id);
+  if (!reply.entries.empty()) ProcessBatch(std::move(reply.entries));
+  return claim_start_ == kStartId;
+}
+
+void StreamConsumer::ProcessBatch(std::vector<StreamEntry> entries) {
+  // Entries taken from the server are finished and acknowledged on stop
+  const engine::TaskCancellationBlocker block_cancel;
+
+  engine::Semaphore semaphore{settings_.max_in_flight};
+  std::vector<engine::TaskWithResult<std::optional<std::string>>> tasks;
+  tasks.reserve(entries.size());
+  for (auto& entry : entries) {
+    engine::SemaphoreLock lock{semaphore};
+    tasks.push_back(utils::Async(
+        task_processor_, "redis_stream_process",
+        [this, lock = std::move(lock),
+         entry = std::move(entry)]() mutable -> std::optional<std::string> {
+          auto id = entry.id;
+          try {
+            callback_(std::move(entry));
+          } catch (const std::exception& ex) {
+            LOG_WARNING() << "Failed to process entry '" << id
+                          << "' of Redis stream '" << settings_.stream
+                          << "', it is left pending: " << ex;
+            return std::nullopt;
+          }
+          return id;
+        }));
+  }
+
+  std::vector<std::string> ids;
+  ids.reserve(tasks.size());
+  for (auto& task : tasks) {
+    auto id = task.Get();
+    if (id) ids.push_back(std::move(*id));
+  }
+  if (ids.empty()) return;
+
+  client_
+      ->Xack(settings_.stream, settings_.group, std::move(ids),
+             settings_.command_control)
+      .Get();
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
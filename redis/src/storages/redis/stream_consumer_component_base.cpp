@@ -0,0 +1,121 @@
+#include <userver/storages/redis/stream_consumer_component_base.hpp>
+
+#include <optional>
+#include <string>
+
+#include <userver/components/component_config.hpp>
+#include <userver/components/component_context.hpp>
+#include <userver/engine/task/task_base.hpp>
+#include <userver/storages/redis/component.hpp>
+#include <userver/storages/redis/stream_consumer.hpp>
+#include <userver/yaml_config/merge_schemas.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis {
+
+namespace {
+
+StreamConsumerSettings ParseSettings(
+    const components::ComponentConfig& config) {
+  StreamConsumerSettings settings;
+  settings.stream = config["stream"].As<std::string>();
+  settings.group = config["group"].As<std::string>();
+  settings.consumer = config["consumer"].As<std::string>();
+  settings.batch_size =
+      config["batch_size"].As<std::size_t>(settings.batch_size);
+  settings.max_in_flight =
+      config["max_in_flight"].As<std::size_t>(settings.max_in_flight);
+  settings.poll_interval =
+      config["poll_interval"].As<std::chrono::milliseconds>(
+          settings.poll_interval);
+  settings.min_idle_time =
+      config["min_idle_time"].As<std::chrono::milliseconds>(
+          settings.min_idle_time);
+  settings.claim_interval =
+      config["claim_interval"].As<std::chrono::milliseconds>(
+          settings.claim_interval);
+  return settings;
+}
+
+engine::TaskProcessor& GetTaskProcessor(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context) {
+  const auto name = config["task_processor"].As<std::optional<std::string>>();
+  if (name) return context.GetTaskProcessor(*name);
+  return engine::current_task::GetTaskProcessor();
+}
+
+}  // namespace
+
+StreamConsumerComponentBase::StreamConsumerComponentBase(
+    const components::ComponentConfig& config,
+    const components::ComponentContext& context)
+    : components::LoggableComponentBase{config, context},
+      consumer_{std::make_unique<StreamConsumer>(
+          context.FindComponent<components::Redis>().GetClient(
+              config["redis_name"].As<std::string>()),
+          ParseSettings(config),
+          [this](StreamEntry entry) { Process(std::move(entry)); },
+          GetTaskProcessor(config, context))} {}
+
+StreamConsumerComponentBase::~StreamConsumerComponentBase() = default;
+
+void StreamConsumerComponentBase::OnAllComponentsLoaded() {
+  consumer_->Start();
+}
+
+void StreamConsumerComponentBase::OnAllComponentsAreStopping() {
+  consumer_->Stop();
+}
+
+yaml_config::Schema StreamConsumerComponentBase::GetStaticConfigSchema() {
+  return yaml_config::MergeSchemas<components::LoggableComponentBase>(R"(
+type: object
+description: Redis stream consumer component
+additionalProperties: false
+properties:
+    redis_name:
+        type: string
+        description: name of the redis database in components::Redis
+    stream:
+        type: string
+        description: key of the stream
+    group:
+        type: string
+        description: consumer group, must already exist
+    consumer:
+        type: string
+        description: name of the consumer within the group
+    batch_size:
+        type: integer
+        description: max entries read by one command and acked by one XACK
+        defaultDescription: 100
+        minimum: 1
+    max_in_flight:
+        type: integer
+        description: max entries processed concurrently
+        defaultDescription: 16
+        minimum: 1
+    poll_interval:
+        type: string
+        description: delay before the next read when there are no new entries
+        defaultDescription: 100ms
+    min_idle_time:
+        type: string
+        description: pending entries idle for longer are claimed by the consumer
+        defaultDescription: 30s
+    claim_interval:
+        type: string
+        description: period of the scans of the pending entries
+        defaultDescription: 10s
+    task_processor:
+        type: string
+        description: task processor to process the entries on
+        defaultDescription: the task processor of the component
+)");
+}
+
+}  // namespace storages::redis
+
+USERVER_NAMESPACE_END
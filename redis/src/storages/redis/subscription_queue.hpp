@@ -10,20 +10,24 @@ USERVER_NAMESPACE_BEGIN
 
 namespace storages::redis {
 
+// Messages are shared by the queues of all the subscribers of a channel
+
 struct ChannelSubscriptionQueueItem {
-  std::string message;
+  USERVER_NAMESPACE::redis::PubsubMessagePtr message;
 
   ChannelSubscriptionQueueItem() = default;
-  explicit ChannelSubscriptionQueueItem(std::string message)
+  explicit ChannelSubscriptionQueueItem(
+      USERVER_NAMESPACE::redis::PubsubMessagePtr message)
       : message(std::move(message)) {}
 };
 
 struct PatternSubscriptionQueueItem {
   std::string channel;
-  std::string message;
+  USERVER_NAMESPACE::redis::PubsubMessagePtr message;
 
   PatternSubscriptionQueueItem() = default;
-  PatternSubscriptionQueueItem(std::string channel, std::string message)
+  PatternSubscriptionQueueItem(
+      std::string channel, USERVER_NAMESPACE::redis::PubsubMessagePtr message)
       : channel(std::move(channel)), message(std::move(message)) {}
 };
 
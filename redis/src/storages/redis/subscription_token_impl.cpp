@@ -41,8 +41,9 @@ void SubscriptionTokenImpl::Unsubscribe() {
 void SubscriptionTokenImpl::ProcessMessages() {
   ChannelSubscriptionQueueItem msg;
   while (queue_.PopMessage(msg)) {
+    msg.message->AccountDelivery();
     tracing::Span span(std::string{kProcessRedisSubscriptionMessage});
-    if (on_message_cb_) on_message_cb_(channel_, msg.message);
+    if (on_message_cb_) on_message_cb_(channel_, msg.message->data);
   }
 }
 
@@ -71,8 +72,11 @@ void PsubscriptionTokenImpl::Unsubscribe() {
 void PsubscriptionTokenImpl::ProcessMessages() {
   PatternSubscriptionQueueItem msg;
   while (queue_.PopMessage(msg)) {
+    msg.message->AccountDelivery();
     tracing::Span span(std::string{kProcessRedisSubscriptionMessage});
-    if (on_pmessage_cb_) on_pmessage_cb_(pattern_, msg.channel, msg.message);
+    if (on_pmessage_cb_) {
+      on_pmessage_cb_(pattern_, msg.channel, msg.message->data);
+    }
   }
 }
 
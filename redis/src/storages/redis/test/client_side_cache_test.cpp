@@ -0,0 +1,124 @@
+#include <userver/storages/redis/client_side_cache.hpp>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/storages/redis/mock_client_google.hpp>
+#include <userver/storages/redis/mock_request.hpp>
+#include <userver/storages/redis/mock_subscribe_client.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis::test {
+
+namespace {
+
+using testing::_;
+
+class ClientSideCacheTest : public testing::Test {
+ protected:
+  std::unique_ptr<ClientSideCache> MakeCache(
+      const ClientSideCacheSettings& settings) {
+    EXPECT_CALL(*subscribe_client_, Psubscribe("__keyspace@0__:flags:*", _, _))
+        .WillOnce([this](std::string, SubscriptionToken::OnPmessageCb cb,
+                         const USERVER_NAMESPACE::redis::CommandControl&) {
+          on_pmessage_ = std::move(cb);
+          return SubscriptionToken{};
+        });
+    return std::make_unique<ClientSideCache>(client_, subscribe_client_,
+                                             settings);
+  }
+
+  void ExpectGet(const std::string& key, std::optional<std::string> value) {
+    EXPECT_CALL(*client_, Get(key, _))
+        .WillOnce([value = std::move(value)](std::string,
+                                             const CommandControl&) mutable {
+          return CreateMockRequest<RequestGet>(std::move(value));
+        });
+  }
+
+  void Notify(const std::string& key) {
+    on_pmessage_("__keyspace@0__:flags:*", "__keyspace@0__:" + key, "set");
+  }
+
+  static ClientSideCacheSettings MakeSettings() {
+    ClientSideCacheSettings settings;
+    settings.max_size = 100;
+    settings.prefixes = {"flags:"};
+    return settings;
+  }
+
+  std::shared_ptr<GMockClient> client_ = std::make_shared<GMockClient>();
+  std::shared_ptr<MockSubscribeClient> subscribe_client_ =
+      std::make_shared<MockSubscribeClient>();
+  SubscriptionToken::OnPmessageCb on_pmessage_;
+};
+
+}  // namespace
+
+UTEST_F(ClientSideCacheTest, ServesCachedValues) {
+  auto cache = MakeCache(MakeSettings());
+  ExpectGet("flags:a", "1");
+  ExpectGet("flags:b", std::nullopt);
+
+  EXPECT_EQ(cache->Get("flags:a"), "1");
+  EXPECT_EQ(cache->Get("flags:a"), "1");
+  EXPECT_EQ(cache->Get("flags:b"), std::nullopt);
+  EXPECT_EQ(cache->Get("flags:b"), std::nullopt);
+
+  const auto stats = cache->GetStatistics();
+  EXPECT_EQ(stats.hits, 2);
+  EXPECT_EQ(stats.misses, 2);
+  EXPECT_EQ(stats.size, 2);
+}
+
+UTEST_F(ClientSideCacheTest, Notifications) {
+  auto cache = MakeCache(MakeSettings());
+  ASSERT_TRUE(on_pmessage_);
+
+  ExpectGet("flags:a", "1");
+  EXPECT_EQ(cache->Get("flags:a"), "1");
+  testing::Mock::VerifyAndClearExpectations(client_.get());
+
+  Notify("flags:b");
+  EXPECT_EQ(cache->Get("flags:a"), "1");
+  testing::Mock::VerifyAndClearExpectations(client_.get());
+
+  Notify("flags:a");
+  ExpectGet("flags:a", "2");
+  EXPECT_EQ(cache->Get("flags:a"), "2");
+  EXPECT_EQ(cache->Get("flags:a"), "2");
+
+  EXPECT_EQ(cache->GetStatistics().invalidations, 2);
+}
+
+UTEST_F(ClientSideCacheTest, NotificationDuringGet) {
+  auto cache = MakeCache(MakeSettings());
+  EXPECT_CALL(*client_, Get("flags:a", _))
+      .Times(2)
+      .WillRepeatedly([this](std::string, const CommandControl&) {
+        // The value could be read before the modification
+        Notify("flags:a");
+        return CreateMockRequest<RequestGet>("1");
+      });
+
+  EXPECT_EQ(cache->Get("flags:a"), "1");
+  EXPECT_EQ(cache->Get("flags:a"), "1");
+}
+
+UTEST_F(ClientSideCacheTest, Ttl) {
+  auto settings = MakeSettings();
+  settings.ttl = std::chrono::milliseconds{1};
+  auto cache = MakeCache(settings);
+
+  EXPECT_CALL(*client_, Get("flags:a", _))
+      .Times(2)
+      .WillRepeatedly([](std::string, const CommandControl&) {
+        return CreateMockRequest<RequestGet>("1");
+      });
+  EXPECT_EQ(cache->Get("flags:a"), "1");
+  engine::SleepFor(std::chrono::milliseconds{10});
+  EXPECT_EQ(cache->Get("flags:a"), "1");
+}
+
+}  // namespace storages::redis::test
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,90 @@
+#include <userver/storages/redis/get_batcher.hpp>
+
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/storages/redis/mock_client_google.hpp>
+#include <userver/storages/redis/mock_request.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis::test {
+
+using testing::_;
+
+UTEST(GetBatcher, SingleGet) {
+  auto client = std::make_shared<GMockClient>();
+  EXPECT_CALL(*client, ShardByKey("a")).WillRepeatedly(testing::Return(0));
+  EXPECT_CALL(*client, Get("a", _))
+      .WillOnce([](std::string, const CommandControl&) {
+        return CreateMockRequest<RequestGet>("1");
+      });
+
+  GetBatcher batcher{client, {}};
+  EXPECT_EQ(batcher.Get("a"), "1");
+}
+
+UTEST_MT(GetBatcher, FusesConcurrentGets, 2) {
+  auto client = std::make_shared<GMockClient>();
+  EXPECT_CALL(*client, ShardByKey(_)).WillRepeatedly(testing::Return(0));
+
+  engine::SingleConsumerEvent first_sent;
+  engine::SingleConsumerEvent release;
+  EXPECT_CALL(*client, Get("a", _))
+      .WillOnce([&](std::string, const CommandControl&) {
+        // The other keys are queued while the command is in flight
+        first_sent.Send();
+        EXPECT_TRUE(release.WaitForEvent());
+        return CreateMockRequest<RequestGet>("a");
+      });
+  EXPECT_CALL(*client, Mget(_, _))
+      .WillOnce([](std::vector<std::string> keys, const CommandControl&) {
+        std::vector<std::optional<std::string>> values;
+        for (auto& key : keys) {
+          if (key == "missing") {
+            values.emplace_back();
+          } else {
+            values.emplace_back(std::move(key));
+          }
+        }
+        return CreateMockRequest<RequestMget>(std::move(values));
+      });
+
+  GetBatcher batcher{client, {}};
+  auto first = engine::AsyncNoSpan([&] { return batcher.Get("a"); });
+  ASSERT_TRUE(first_sent.WaitForEvent());
+
+  std::vector<engine::TaskWithResult<std::optional<std::string>>> tasks;
+  for (const auto* key : {"b", "c", "missing"}) {
+    tasks.push_back(
+        engine::AsyncNoSpan([&batcher, key] { return batcher.Get(key); }));
+  }
+  // Let the tasks queue their keys
+  engine::SleepFor(std::chrono::milliseconds{10});
+  release.Send();
+
+  EXPECT_EQ(first.Get(), "a");
+  EXPECT_EQ(tasks[0].Get(), "b");
+  EXPECT_EQ(tasks[1].Get(), "c");
+  EXPECT_EQ(tasks[2].Get(), std::nullopt);
+}
+
+UTEST(GetBatcher, ClusterModeGroupsByHashSlot) {
+  auto client = std::make_shared<GMockClient>();
+  EXPECT_CALL(*client, ShardByKey(_)).Times(0);
+  EXPECT_CALL(*client, Get("{user}:a", _))
+      .WillOnce([](std::string, const CommandControl&) {
+        return CreateMockRequest<RequestGet>(std::nullopt);
+      });
+
+  GetBatcherSettings settings;
+  settings.cluster_mode = true;
+  GetBatcher batcher{client, settings};
+  EXPECT_EQ(batcher.Get("{user}:a"), std::nullopt);
+}
+
+}  // namespace storages::redis::test
+
+USERVER_NAMESPACE_END
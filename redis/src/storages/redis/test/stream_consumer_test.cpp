@@ -0,0 +1,79 @@
+#include <userver/storages/redis/stream_consumer.hpp>
+
+#include <stdexcept>
+
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/task_base.hpp>
+#include <userver/storages/redis/mock_client_google.hpp>
+#include <userver/storages/redis/mock_request.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::redis::test {
+
+namespace {
+
+using testing::_;
+
+StreamEntry MakeEntry(std::string id) {
+  return {std::move(id), {{"field", "value"}}};
+}
+
+StreamConsumerSettings MakeSettings() {
+  StreamConsumerSettings settings;
+  settings.stream = "stream";
+  settings.group = "group";
+  settings.consumer = "consumer";
+  settings.poll_interval = std::chrono::milliseconds{1};
+  settings.claim_interval = std::chrono::hours{1};
+  return settings;
+}
+
+}  // namespace
+
+UTEST_MT(StreamConsumer, AcksProcessedEntries, 2) {
+  auto client = std::make_shared<GMockClient>();
+  EXPECT_CALL(*client,
+              Xautoclaim("stream", "group", "consumer", _, "0-0", _, _))
+      .WillOnce(testing::InvokeWithoutArgs([] {
+        return CreateMockRequest<RequestXautoclaim>(
+            XautoclaimReply{"0-0", {MakeEntry("1-0")}});
+      }));
+  EXPECT_CALL(*client, Xreadgroup("stream", "group", "consumer", ">", _, _))
+      .WillOnce(testing::InvokeWithoutArgs([] {
+        return CreateMockRequest<RequestXreadgroup>(std::vector<StreamEntry>{
+            MakeEntry("2-0"), MakeEntry("3-0"), MakeEntry("4-0")});
+      }))
+      .WillRepeatedly(testing::InvokeWithoutArgs([] {
+        return CreateMockRequest<RequestXreadgroup>(
+            std::vector<StreamEntry>{});
+      }));
+
+  engine::SingleConsumerEvent acked;
+  EXPECT_CALL(*client, Xack("stream", "group",
+                            std::vector<std::string>{"1-0"}, _))
+      .WillOnce(testing::InvokeWithoutArgs(
+          [] { return CreateMockRequest<RequestXack>(1); }));
+  // The failed entry is left pending
+  EXPECT_CALL(*client, Xack("stream", "group",
+                            std::vector<std::string>{"2-0", "4-0"}, _))
+      .WillOnce(testing::InvokeWithoutArgs([&acked] {
+        acked.Send();
+        return CreateMockRequest<RequestXack>(2);
+      }));
+
+  StreamConsumer consumer{
+      client, MakeSettings(),
+      [](StreamEntry entry) {
+        EXPECT_EQ(entry.fields.size(), 1);
+        if (entry.id == "3-0") throw std::runtime_error("processing failed");
+      },
+      engine::current_task::GetTaskProcessor()};
+  consumer.Start();
+  EXPECT_TRUE(acked.WaitForEvent());
+  consumer.Stop();
+}
+
+}  // namespace storages::redis::test
+
+USERVER_NAMESPACE_END
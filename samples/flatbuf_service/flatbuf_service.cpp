@@ -40,6 +40,39 @@ class FbsSumEcho final
 }  // namespace samples::fbs_handle
 /// [Flatbuf service sample - component]
 
+/// [Flatbuf service sample - view component]
+#include <userver/server/handlers/http_handler_flatbuf_view_base.hpp>
+
+namespace samples::fbs_handle {
+
+class FbsSumEchoView final
+    : public server::handlers::HttpHandlerFlatbufViewBase<fbs::SampleRequest,
+                                                          fbs::SampleResponse> {
+ public:
+  static constexpr std::string_view kName = "handler-fbs-view-sample";
+
+  FbsSumEchoView(const components::ComponentConfig& config,
+                 const components::ComponentContext& context)
+      : HttpHandlerFlatbufViewBase(config, context) {}
+
+  flatbuffers::Offset<fbs::SampleResponse> HandleRequestFlatbufThrow(
+      const server::http::HttpRequest& /*request*/,
+      const fbs::SampleRequest& fbs_request,
+      flatbuffers::FlatBufferBuilder& builder,
+      server::request::RequestContext&) const override {
+    // Strings are created before the table that refers to them
+    flatbuffers::Offset<flatbuffers::String> echo;
+    if (fbs_request.data()) echo = builder.CreateString(fbs_request.data());
+    fbs::SampleResponseBuilder res{builder};
+    res.add_sum(fbs_request.arg1() + fbs_request.arg2());
+    res.add_echo(echo);
+    return res.Finish();
+  }
+};
+
+}  // namespace samples::fbs_handle
+/// [Flatbuf service sample - view component]
+
 namespace samples::fbs_request {
 
 /// [Flatbuf service sample - http component]
@@ -106,11 +139,12 @@ void FbsRequest::KeepRequesting() const {
 }  // namespace samples::fbs_request
 
 int main(int argc, char* argv[]) {
-  auto component_list = components::MinimalServerComponentList()        //
-                            .Append<samples::fbs_handle::FbsSumEcho>()  //
+  auto component_list = components::MinimalServerComponentList()            //
+                            .Append<samples::fbs_handle::FbsSumEcho>()      //
+                            .Append<samples::fbs_handle::FbsSumEchoView>()  //
 
-                            .Append<clients::dns::Component>()            //
-                            .Append<components::HttpClient>()             //
-                            .Append<samples::fbs_request::FbsRequest>();  //
+                            .Append<clients::dns::Component>()              //
+                            .Append<components::HttpClient>()               //
+                            .Append<samples::fbs_request::FbsRequest>();    //
   return utils::DaemonMain(argc, argv, component_list);
 }
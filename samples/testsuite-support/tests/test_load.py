@@ -0,0 +1,16 @@
+# /// [load]
+async def test_ping_load(service_client, load_runner):
+    result = await load_runner.run(
+        lambda: service_client.get('/ping', testsuite_skip_prepare=True),
+        rate=200,
+        duration=2,
+        warmup=0.5,
+        metrics_prefix='http.handler.total',
+    )
+    assert result.errors == 0
+    assert result.metrics.value_at(
+        'reply-codes', {'http_code': '200', 'version': '2'},
+    ) >= result.completed
+
+    load_runner.check_baseline('ping', result)
+    # /// [load]
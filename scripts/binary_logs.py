@@ -0,0 +1,143 @@
+#!/usr/bin/env python
+
+"""
+Decodes logs written with `format: binary` into TSKV or JSON lines.
+
+Each record is laid out as follows, all integers are little-endian:
+
+    u32      size of the rest of the record
+    u64      timestamp, microseconds since the Unix epoch
+    u8       level, logging::Level
+    fields until the end of the record:
+        u16      key size
+        bytes    key
+        u8       value type: 0 - string, 1 - int64, 2 - uint64, 3 - double,
+                 4 - bool
+        u32      value size
+        bytes    value
+
+Usage example:
+    ./scripts/binary_logs.py < server.log | ./scripts/human_logs.py
+"""
+
+import argparse
+import datetime
+import json
+import struct
+import sys
+
+LEVELS = ['TRACE', 'DEBUG', 'INFO', 'WARNING', 'ERROR', 'CRITICAL', 'NONE']
+
+TSKV_ESCAPES = {
+    '\t': '\\t',
+    '\n': '\\n',
+    '\r': '\\r',
+    '\0': '\\0',
+    '\\': '\\\\',
+}
+
+
+class DecodeError(Exception):
+    pass
+
+
+def _decode_value(value_type, data):
+    if value_type == 0:
+        return data.decode('utf-8', errors='replace')
+    if value_type == 1:
+        return struct.unpack('<q', data)[0]
+    if value_type == 2:
+        return struct.unpack('<Q', data)[0]
+    if value_type == 3:
+        return struct.unpack('<d', data)[0]
+    if value_type == 4:
+        return data != b'\0'
+    raise DecodeError('unknown value type {}'.format(value_type))
+
+
+def decode_record(record):
+    timestamp_us, level = struct.unpack_from('<QB', record)
+    timestamp = datetime.datetime.fromtimestamp(timestamp_us / 1000000)
+    fields = [
+        ('timestamp', timestamp.strftime('%Y-%m-%dT%H:%M:%S.%f')),
+        ('level', LEVELS[level] if level < len(LEVELS) else str(level)),
+    ]
+
+    position = struct.calcsize('<QB')
+    while position < len(record):
+        (key_size,) = struct.unpack_from('<H', record, position)
+        position += 2
+        key = record[position:position + key_size].decode(
+            'utf-8', errors='replace',
+        )
+        position += key_size
+        value_type, value_size = struct.unpack_from('<BI', record, position)
+        position += 5
+        value = record[position:position + value_size]
+        if len(value) != value_size:
+            raise DecodeError('truncated value of "{}"'.format(key))
+        position += value_size
+        fields.append((key, _decode_value(value_type, value)))
+    return fields
+
+
+def read_records(stream):
+    while True:
+        header = stream.read(4)
+        if not header:
+            return
+        if len(header) != 4:
+            raise DecodeError('truncated record size')
+        (size,) = struct.unpack('<I', header)
+        record = stream.read(size)
+        if len(record) != size:
+            raise DecodeError('truncated record')
+        yield record
+
+
+def _to_tskv_value(value):
+    if isinstance(value, bool):
+        return 'true' if value else 'false'
+    if not isinstance(value, str):
+        return str(value)
+    return ''.join(TSKV_ESCAPES.get(c, c) for c in value)
+
+
+def format_tskv(fields):
+    return 'tskv\t' + '\t'.join(
+        '{}={}'.format(key, _to_tskv_value(value)) for key, value in fields
+    )
+
+
+def format_json(fields):
+    return json.dumps(dict(fields), ensure_ascii=False)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Decode binary userver logs into TSKV or JSON lines.',
+    )
+    parser.add_argument(
+        'input', nargs='?', help='path to the log file, stdin by default',
+    )
+    parser.add_argument(
+        '--format', choices=['tskv', 'json'], default='tskv',
+        help='output format',
+    )
+    args = parser.parse_args()
+
+    formatter = format_json if args.format == 'json' else format_tskv
+    stream = open(args.input, 'rb') if args.input else sys.stdin.buffer
+    try:
+        for record in read_records(stream):
+            sys.stdout.write(formatter(decode_record(record)) + '\n')
+    except DecodeError as exc:
+        sys.stderr.write('Malformed binary log: {}\n'.format(exc))
+        sys.exit(1)
+    finally:
+        if args.input:
+            stream.close()
+
+
+if __name__ == '__main__':
+    main()
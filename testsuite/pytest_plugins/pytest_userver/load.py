@@ -0,0 +1,361 @@
+"""
+Python module that provides helpers for load and latency regression testing
+of services with testsuite; see
+@ref scripts/docs/en/userver/functional_testing.md for an introduction.
+
+@ingroup userver_testsuite
+"""
+
+import asyncio
+import collections
+import dataclasses
+import json
+import math
+import pathlib
+import typing
+
+from pytest_userver import metrics as metric_module
+
+
+_DEFAULT_PERCENTILES = (50, 90, 99, 99.9)
+
+
+class LatencyHistogram:
+    """
+    Histogram of latencies in microseconds with a fixed relative precision,
+    that follows the bucketing scheme of the HdrHistogram. Recording a value
+    and merging histograms do not depend on the number of recorded values.
+
+    @snippet testsuite/tests/test_load.py histogram
+
+    @ingroup userver_testsuite
+    """
+
+    def __init__(self, significant_digits: int = 3):
+        assert 1 <= significant_digits <= 5, 'from 1 to 5 digits are supported'
+        self._significant_digits = significant_digits
+        largest_single_unit = 2 * 10**significant_digits
+        self._sub_bucket_bits = (largest_single_unit - 1).bit_length()
+        self._sub_bucket_count = 1 << self._sub_bucket_bits
+        self._sub_bucket_half = self._sub_bucket_count // 2
+        self._counts: typing.Dict[int, int] = collections.defaultdict(int)
+        self._total = 0
+        self._max = 0
+
+    @property
+    def count(self) -> int:
+        """ Returns the number of recorded values """
+        return self._total
+
+    @property
+    def max(self) -> int:
+        """ Returns the largest recorded value """
+        return self._max
+
+    def record(self, value_us: int, count: int = 1) -> None:
+        """ Records the latency in microseconds """
+        value_us = max(0, int(value_us))
+        self._counts[self._index(value_us)] += count
+        self._total += count
+        self._max = max(self._max, value_us)
+
+    def merge(self, other: 'LatencyHistogram') -> None:
+        """ Adds the values of another histogram of the same precision """
+        assert self._significant_digits == other._significant_digits
+        for index, count in other._counts.items():
+            self._counts[index] += count
+        self._total += other._total
+        self._max = max(self._max, other._max)
+
+    def percentile(self, percentile: float) -> int:
+        """
+        Returns the value that is greater or equal to the `percentile` percent
+        of the recorded values, 0 for an empty histogram
+        """
+        assert 0 <= percentile <= 100
+        if not self._total:
+            return 0
+        needed = max(1, math.ceil(self._total * percentile / 100))
+        seen = 0
+        for index in sorted(self._counts):
+            seen += self._counts[index]
+            if seen >= needed:
+                return min(self._highest_equivalent(index), self._max)
+        return self._max
+
+    def to_dict(self) -> dict:
+        """ Serializes the histogram to a JSON compatible dict """
+        return {
+            'significant-digits': self._significant_digits,
+            'counts': {
+                str(self._lowest_equivalent(index)): count
+                for index, count in sorted(self._counts.items())
+            },
+            'max': self._max,
+        }
+
+    @staticmethod
+    def from_dict(data: dict) -> 'LatencyHistogram':
+        """ Constructs the histogram from the result of to_dict() """
+        histogram = LatencyHistogram(data['significant-digits'])
+        for value, count in data['counts'].items():
+            histogram.record(int(value), count)
+        histogram._max = data['max']  # pylint: disable=protected-access
+        return histogram
+
+    def _index(self, value: int) -> int:
+        bucket = max(0, value.bit_length() - self._sub_bucket_bits)
+        return bucket * self._sub_bucket_half + (value >> bucket)
+
+    def _bucket_of_index(self, index: int) -> typing.Tuple[int, int]:
+        if index < self._sub_bucket_count:
+            return 0, index
+        bucket = (
+            index - self._sub_bucket_count
+        ) // self._sub_bucket_half + 1
+        return bucket, index - bucket * self._sub_bucket_half
+
+    def _lowest_equivalent(self, index: int) -> int:
+        bucket, sub_bucket = self._bucket_of_index(index)
+        return sub_bucket << bucket
+
+    def _highest_equivalent(self, index: int) -> int:
+        bucket, _ = self._bucket_of_index(index)
+        return self._lowest_equivalent(index) + (1 << bucket) - 1
+
+
+@dataclasses.dataclass
+class LoadResult:
+    """
+    Result of a load run: client side latencies and counters plus the server
+    side metrics difference over the run.
+
+    @ingroup userver_testsuite
+    """
+
+    # Number of requests that were scheduled by the open-loop generator
+    scheduled: int = 0
+    # Number of requests that were not sent due to the in-flight limit
+    dropped: int = 0
+    # Requests that failed with an exception or have got `is_error` result
+    errors: int = 0
+    duration: float = 0.0
+    # Latencies from the intended send time to the response, microseconds
+    latencies: LatencyHistogram = dataclasses.field(
+        default_factory=LatencyHistogram,
+    )
+    statuses: typing.Dict[str, int] = dataclasses.field(
+        default_factory=lambda: collections.defaultdict(int),
+    )
+    metrics: typing.Optional[metric_module.MetricsSnapshot] = None
+
+    @property
+    def completed(self) -> int:
+        """ Returns the number of finished requests, including failed ones """
+        return self.latencies.count
+
+    @property
+    def throughput(self) -> float:
+        """ Returns the number of successful requests per second """
+        if not self.duration:
+            return 0.0
+        return (self.completed - self.errors) / self.duration
+
+    @property
+    def error_rate(self) -> float:
+        """ Returns the ratio of failed or dropped requests """
+        if not self.scheduled:
+            return 0.0
+        return (self.errors + self.dropped) / self.scheduled
+
+    def summary(
+            self, percentiles: typing.Iterable[float] = _DEFAULT_PERCENTILES,
+    ) -> typing.Dict[str, float]:
+        """
+        Returns a flat dict with the throughput, error rate and latency
+        percentiles in milliseconds, that is stored in baselines
+        """
+        result = {
+            'throughput': round(self.throughput, 3),
+            'error-rate': round(self.error_rate, 6),
+        }
+        for percentile in percentiles:
+            result[f'p{percentile:g}'] = (
+                self.latencies.percentile(percentile) / 1000
+            )
+        result['max'] = self.latencies.max / 1000
+        return result
+
+
+async def run_open_loop(
+        send: typing.Callable[[], typing.Awaitable[typing.Any]],
+        *,
+        rate: float,
+        duration: float,
+        max_in_flight: int = 1000,
+        is_error: typing.Optional[typing.Callable[[typing.Any], bool]] = None,
+        result: typing.Optional[LoadResult] = None,
+) -> LoadResult:
+    """
+    Runs `send()` `rate` times per second for `duration` seconds, without
+    waiting for the responses of the previous requests (open-loop).
+
+    Latency is measured from the time the request was meant to be sent, so
+    the stalls of the service or of the load generator itself are accounted
+    in percentiles instead of silently lowering the request rate
+    (the coordinated omission problem). If `max_in_flight` requests are
+    already waiting for the responses, the next request is dropped and
+    counted in LoadResult.dropped.
+
+    @param send coroutine function that sends a single request
+    @param rate requests per second
+    @param duration seconds
+    @param max_in_flight limit of concurrent requests
+    @param is_error function that tells whether the result of `send()` is a
+           failure; by default results with a non 2xx `status` attribute
+           are failures
+    @param result LoadResult to accumulate the run into
+    """
+    assert rate > 0, 'rate must be positive'
+    assert duration > 0, 'duration must be positive'
+    if is_error is None:
+        is_error = _is_http_error
+    if result is None:
+        result = LoadResult()
+
+    loop = asyncio.get_running_loop()
+    in_flight: typing.Set[asyncio.Task] = set()
+    interval = 1 / rate
+    total = max(1, int(rate * duration))
+
+    async def do_send(intended_start: float) -> None:
+        try:
+            response = await send()
+        except Exception as exc:  # pylint: disable=broad-except
+            result.errors += 1
+            result.statuses[type(exc).__name__] += 1
+        else:
+            if is_error(response):
+                result.errors += 1
+            status = getattr(response, 'status', None)
+            result.statuses['ok' if status is None else str(status)] += 1
+        result.latencies.record((loop.time() - intended_start) * 1_000_000)
+
+    start = loop.time()
+    for i in range(total):
+        intended_start = start + i * interval
+        delay = intended_start - loop.time()
+        if delay > 0:
+            await asyncio.sleep(delay)
+
+        result.scheduled += 1
+        if len(in_flight) >= max_in_flight:
+            result.dropped += 1
+            continue
+        task = asyncio.create_task(do_send(intended_start))
+        in_flight.add(task)
+        task.add_done_callback(in_flight.discard)
+
+    if in_flight:
+        await asyncio.gather(*in_flight)
+    result.duration += loop.time() - start
+    return result
+
+
+def _is_http_error(response: typing.Any) -> bool:
+    status = getattr(response, 'status', None)
+    return status is not None and not 200 <= status < 300
+
+
+@dataclasses.dataclass(frozen=True)
+class Tolerance:
+    """
+    Allowed degradation of a load run compared with the baseline.
+
+    @ingroup userver_testsuite
+    """
+
+    # Allowed relative drop of the throughput
+    throughput: float = 0.1
+    # Allowed relative growth of the latency percentiles
+    latency: float = 0.2
+    # Allowed absolute growth of the error rate
+    error_rate: float = 0.001
+    # Latency growth below this number of milliseconds is never a regression,
+    # so the sub-millisecond percentiles do not make the comparison flaky
+    latency_floor_ms: float = 1.0
+
+
+def find_regressions(
+        summary: typing.Mapping[str, float],
+        baseline: typing.Mapping[str, float],
+        tolerance: Tolerance = Tolerance(),
+) -> typing.List[str]:
+    """
+    Compares the LoadResult.summary() with the baseline one and returns the
+    human readable descriptions of the regressions.
+    """
+    regressions = []
+    for key, base in baseline.items():
+        if key not in summary:
+            continue
+        current = summary[key]
+        if key == 'throughput':
+            if current < base * (1 - tolerance.throughput):
+                regressions.append(
+                    f'throughput {current:g} rps is lower than the baseline '
+                    f'{base:g} rps by more than {tolerance.throughput:.0%}',
+                )
+        elif key == 'error-rate':
+            if current > base + tolerance.error_rate:
+                regressions.append(
+                    f'error rate {current:g} is higher than the baseline '
+                    f'{base:g}',
+                )
+        elif key != 'max':
+            allowed = max(
+                base * (1 + tolerance.latency),
+                base + tolerance.latency_floor_ms,
+            )
+            if current > allowed:
+                regressions.append(
+                    f'{key} latency {current:g}ms is higher than the '
+                    f'baseline {base:g}ms by more than '
+                    f'{tolerance.latency:.0%}',
+                )
+    return regressions
+
+
+class BaselineStorage:
+    """
+    JSON file with the LoadResult.summary() of the load scenarios by their
+    names.
+
+    @ingroup userver_testsuite
+    """
+
+    def __init__(self, path: typing.Optional[pathlib.Path]):
+        self._path = path
+        self._values: typing.Dict[str, typing.Dict[str, float]] = {}
+        self._changed = False
+        if path and path.exists():
+            self._values = json.loads(path.read_text())
+
+    def get(self, name: str) -> typing.Optional[typing.Dict[str, float]]:
+        """ Returns the baseline of the scenario or None """
+        return self._values.get(name)
+
+    def update(self, name: str, summary: typing.Dict[str, float]) -> None:
+        """ Replaces the baseline of the scenario """
+        self._values[name] = dict(summary)
+        self._changed = True
+
+    def flush(self) -> None:
+        """ Writes the updated baselines to the file """
+        if not self._changed or not self._path:
+            return
+        self._path.parent.mkdir(parents=True, exist_ok=True)
+        self._path.write_text(
+            json.dumps(self._values, indent=2, sort_keys=True) + '\n',
+        )
+        self._changed = False
@@ -13,6 +13,7 @@ pytest_plugins = [
     'pytest_userver.plugins.config',
     'pytest_userver.plugins.dumps',
     'pytest_userver.plugins.dynamic_config',
+    'pytest_userver.plugins.load',
     'pytest_userver.plugins.log_capture',
     'pytest_userver.plugins.service',
     'pytest_userver.plugins.service_client',
@@ -0,0 +1,199 @@
+"""
+Open-loop load runs against the service started by testsuite, with the
+latency percentiles and throughput compared against a stored baseline.
+
+@ingroup userver_testsuite_fixtures
+"""
+
+import logging
+import pathlib
+import typing
+
+import pytest
+
+from pytest_userver import client
+from pytest_userver import load
+
+
+logger = logging.getLogger(__name__)
+
+
+def pytest_addoption(parser) -> None:
+    group = parser.getgroup('userver-load')
+    group.addoption(
+        '--load-baseline',
+        type=pathlib.Path,
+        help='Path to the JSON file with the baseline results of the load '
+        'scenarios.',
+    )
+    group.addoption(
+        '--load-update-baseline',
+        action='store_true',
+        help='Write the results of the load scenarios to the baseline file '
+        'instead of comparing them with it.',
+    )
+    group.addoption(
+        '--load-tolerance',
+        type=float,
+        default=None,
+        help='Allowed relative degradation of the throughput and of the '
+        'latency percentiles compared with the baseline.',
+    )
+    group.addoption(
+        '--load-duration-factor',
+        type=float,
+        default=1.0,
+        help='Multiplier for the duration of the load scenarios, '
+        'e.g. 0.1 for a quick smoke run (default is %(default)s).',
+    )
+
+
+class LoadRunner:
+    """
+    Runs the load scenarios and checks them against the baseline; use the
+    @ref pytest_userver.plugins.load.load_runner "load_runner" fixture to
+    get an instance.
+
+    @ingroup userver_testsuite
+    """
+
+    def __init__(
+            self,
+            *,
+            monitor_client: client.ClientMonitor,
+            baselines: load.BaselineStorage,
+            update_baseline: bool,
+            tolerance: load.Tolerance,
+            duration_factor: float,
+    ):
+        self._monitor_client = monitor_client
+        self._baselines = baselines
+        self._update_baseline = update_baseline
+        self._tolerance = tolerance
+        self._duration_factor = duration_factor
+
+    async def run(
+            self,
+            send: typing.Callable[[], typing.Awaitable[typing.Any]],
+            *,
+            rate: float,
+            duration: float,
+            warmup: float = 0,
+            max_in_flight: int = 1000,
+            is_error: typing.Optional[
+                typing.Callable[[typing.Any], bool]
+            ] = None,
+            metrics_prefix: typing.Optional[str] = None,
+    ) -> load.LoadResult:
+        """
+        Runs `send()` with the open-loop load of a `rate` requests per
+        second, see pytest_userver.load.run_open_loop().
+
+        The requests of the `warmup` seconds are not accounted in the result.
+        The server side metrics difference over the run, optionally filtered
+        by `metrics_prefix`, is stored in LoadResult.metrics.
+        """
+        if warmup:
+            await load.run_open_loop(
+                send,
+                rate=rate,
+                duration=warmup * self._duration_factor,
+                max_in_flight=max_in_flight,
+                is_error=is_error,
+            )
+
+        differ = self._monitor_client.metrics_diff(prefix=metrics_prefix)
+        async with differ:
+            result = await load.run_open_loop(
+                send,
+                rate=rate,
+                duration=duration * self._duration_factor,
+                max_in_flight=max_in_flight,
+                is_error=is_error,
+            )
+        result.metrics = differ.diff
+        logger.info(
+            'Load run at %s rps: %s, statuses %s',
+            rate,
+            result.summary(),
+            dict(result.statuses),
+        )
+        return result
+
+    def check_baseline(self, name: str, result: load.LoadResult) -> None:
+        """
+        Compares the result with the baseline of the `name` scenario and fails
+        the test on regressions. With `--load-update-baseline` stores the
+        result as the new baseline instead.
+        """
+        summary = result.summary()
+        if self._update_baseline:
+            self._baselines.update(name, summary)
+            return
+
+        baseline = self._baselines.get(name)
+        if baseline is None:
+            logger.warning(
+                'No baseline for the load scenario %r, run with '
+                '--load-update-baseline to store one. Result: %s',
+                name,
+                summary,
+            )
+            return
+
+        regressions = load.find_regressions(
+            summary, baseline, self._tolerance,
+        )
+        assert not regressions, (
+            f'Load scenario {name!r} has regressed:\n  '
+            + '\n  '.join(regressions)
+        )
+
+
+@pytest.fixture(scope='session')
+def _load_baselines(pytestconfig):
+    baselines = load.BaselineStorage(pytestconfig.option.load_baseline)
+    yield baselines
+    baselines.flush()
+
+
+@pytest.fixture(scope='session')
+def load_tolerance(pytestconfig) -> load.Tolerance:
+    """
+    Returns the allowed degradation compared with the baseline. The
+    `--load-tolerance` command line option overrides both the throughput and
+    the latency tolerances.
+
+    Override this fixture to change the tolerances for all the scenarios.
+
+    @ingroup userver_testsuite_fixtures
+    """
+    tolerance = pytestconfig.option.load_tolerance
+    if tolerance is None:
+        return load.Tolerance()
+    return load.Tolerance(throughput=tolerance, latency=tolerance)
+
+
+@pytest.fixture
+def load_runner(
+        pytestconfig,
+        service_client,
+        monitor_client,
+        load_tolerance,
+        _load_baselines,
+) -> LoadRunner:
+    """
+    Returns a LoadRunner to drive the open-loop HTTP or gRPC load at the
+    started service and check the results against the baseline.
+
+    @snippet samples/testsuite-support/tests/test_load.py load
+    @anchor load_runner
+    @ingroup userver_testsuite_fixtures
+    """
+    return LoadRunner(
+        monitor_client=monitor_client,
+        baselines=_load_baselines,
+        update_baseline=pytestconfig.option.load_update_baseline,
+        tolerance=load_tolerance,
+        duration_factor=pytestconfig.option.load_duration_factor,
+    )
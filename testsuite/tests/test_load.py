@@ -0,0 +1,156 @@
+import asyncio
+
+from pytest_userver import load  # pylint: disable=import-error
+
+
+def test_histogram_percentiles():
+    # /// [histogram]
+    histogram = load.LatencyHistogram()
+    for value_us in range(1, 10001):
+        histogram.record(value_us)
+
+    assert histogram.count == 10000
+    assert histogram.max == 10000
+    # 3 significant digits
+    assert abs(histogram.percentile(50) - 5000) <= 5
+    assert abs(histogram.percentile(99) - 9900) <= 10
+    assert histogram.percentile(100) == 10000
+    # /// [histogram]
+    assert histogram.percentile(0) == 1
+
+
+def test_histogram_large_values():
+    histogram = load.LatencyHistogram(significant_digits=2)
+    histogram.record(5)
+    histogram.record(123456789)
+
+    assert histogram.percentile(50) == 5
+    top = histogram.percentile(100)
+    assert top == 123456789
+    assert abs(histogram.percentile(99) - 123456789) / 123456789 < 0.01
+
+
+def test_histogram_merge_and_serialize():
+    lhs = load.LatencyHistogram()
+    rhs = load.LatencyHistogram()
+    for value_us in range(1000):
+        lhs.record(value_us)
+        rhs.record(value_us + 1000)
+    lhs.merge(rhs)
+    assert lhs.count == 2000
+    assert lhs.max == 1999
+
+    restored = load.LatencyHistogram.from_dict(lhs.to_dict())
+    assert restored.count == lhs.count
+    assert restored.max == lhs.max
+    for percentile in (1, 50, 90, 99, 99.9, 100):
+        assert restored.percentile(percentile) == lhs.percentile(percentile)
+
+
+def test_empty_histogram():
+    histogram = load.LatencyHistogram()
+    assert histogram.percentile(99) == 0
+    assert load.LoadResult().summary()['throughput'] == 0
+
+
+class _Response:
+    def __init__(self, status):
+        self.status = status
+
+
+async def test_open_loop():
+    sent = 0
+
+    async def send():
+        nonlocal sent
+        sent += 1
+        status = 500 if sent % 10 == 0 else 200
+        await asyncio.sleep(0.01)
+        return _Response(status)
+
+    result = await load.run_open_loop(send, rate=200, duration=0.5)
+    assert result.scheduled == 100
+    assert result.completed == 100
+    assert result.dropped == 0
+    assert result.errors == 10
+    assert result.statuses == {'200': 90, '500': 10}
+    # Latencies are not affected by the open-loop schedule
+    assert result.latencies.percentile(50) >= 10000
+
+
+async def test_open_loop_in_flight_limit():
+    stall = asyncio.Event()
+
+    async def send():
+        await stall.wait()
+
+    async def release():
+        await asyncio.sleep(0.2)
+        stall.set()
+
+    releaser = asyncio.create_task(release())
+    result = await load.run_open_loop(
+        send, rate=100, duration=0.5, max_in_flight=5,
+    )
+    await releaser
+    assert result.scheduled == 50
+    assert result.completed + result.dropped == 50
+    assert result.dropped > 0
+    assert result.errors == 0
+    # Stalled requests are accounted from their intended send time
+    assert result.latencies.max >= 150000
+
+
+async def test_open_loop_exceptions():
+    async def send():
+        raise ConnectionError('refused')
+
+    result = await load.run_open_loop(send, rate=100, duration=0.1)
+    assert result.errors == result.scheduled == 10
+    assert result.statuses == {'ConnectionError': 10}
+    assert result.error_rate == 1
+
+
+def test_find_regressions():
+    baseline = {
+        'throughput': 1000,
+        'error-rate': 0,
+        'p50': 2.0,
+        'p99': 10.0,
+        'max': 50.0,
+    }
+    assert not load.find_regressions(baseline, baseline)
+    assert not load.find_regressions(
+        {**baseline, 'throughput': 950, 'p99': 11.5, 'max': 500}, baseline,
+    )
+    # sub-millisecond growth is below latency_floor_ms
+    assert not load.find_regressions({**baseline, 'p50': 2.9}, baseline)
+
+    regressions = load.find_regressions(
+        {**baseline, 'throughput': 800, 'p99': 15.0, 'error-rate': 0.01},
+        baseline,
+    )
+    assert len(regressions) == 3
+    assert regressions[0].startswith('throughput')
+    assert regressions[1].startswith('error rate')
+    assert regressions[2].startswith('p99')
+
+    assert load.find_regressions(
+        {**baseline, 'throughput': 950},
+        baseline,
+        load.Tolerance(throughput=0.01),
+    )
+
+
+def test_baseline_storage(tmp_path):
+    path = tmp_path / 'baselines' / 'load.json'
+    storage = load.BaselineStorage(path)
+    assert storage.get('ping') is None
+    storage.flush()
+    assert not path.exists()
+
+    storage.update('ping', {'throughput': 100, 'p99': 1.5})
+    storage.flush()
+
+    restored = load.BaselineStorage(path)
+    assert restored.get('ping') == {'throughput': 100, 'p99': 1.5}
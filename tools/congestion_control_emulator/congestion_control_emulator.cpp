@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
+#include <sstream>
 
 #include <boost/program_options.hpp>
 
@@ -12,13 +15,16 @@
 using namespace congestion_control;
 
 struct Config {
+  Controller::Algorithm algorithm{Controller::Algorithm::kLinear};
   Policy policy;
+  GradientPolicy gradient_policy;
   std::string log_level = "none";
 };
 
 Config ParseArgs(int argc, char* argv[]) {
   Config config;
   std::string policy_json;
+  std::string controller = "linear";
 
   namespace po = boost::program_options;
 
@@ -29,9 +35,13 @@ Config ParseArgs(int argc, char* argv[]) {
     ("log-level",
       po::value(&config.log_level)->default_value(config.log_level),
       "log level (trace, debug, info, warning, error)")
+    ("controller,c",
+     po::value(&controller)->default_value(controller),
+     "congestion controller (linear, gradient)")
     ("policy,p",
      po::value(&policy_json)->default_value(std::string{}),
-     "policy in JSON")
+     "policy in JSON, USERVER_RPS_CCONTROL or USERVER_RPS_CCONTROL_GRADIENT "
+     "depending on the controller")
   ;
   // clang-format on
 
@@ -44,8 +54,21 @@ Config ParseArgs(int argc, char* argv[]) {
     exit(0);
   }
 
+  if (controller == "linear") {
+    config.algorithm = Controller::Algorithm::kLinear;
+  } else if (controller == "gradient") {
+    config.algorithm = Controller::Algorithm::kGradient;
+  } else {
+    throw std::runtime_error("Unknown controller: " + controller);
+  }
+
   if (!policy_json.empty()) {
-    config.policy = formats::json::FromString(policy_json).As<Policy>();
+    const auto json = formats::json::FromString(policy_json);
+    if (config.algorithm == Controller::Algorithm::kGradient) {
+      config.gradient_policy = json.As<GradientPolicy>();
+    } else {
+      config.policy = json.As<Policy>();
+    }
   }
 
   return config;
@@ -59,22 +82,45 @@ int main(int argc, char* argv[]) {
                                 logging::LevelFromString(config.log_level))};
 
   dynamic_config::StorageMock dynamic_config{
-      {congestion_control::impl::kRpsCcConfig, {config.policy, true}}};
-  Controller ctrl("cc", dynamic_config.GetSource());
-
-  for (;;) {
+      {congestion_control::impl::kRpsCcConfig,
+       {config.policy, true, 0, config.gradient_policy}}};
+  Controller ctrl("cc", dynamic_config.GetSource(), config.algorithm);
+
+  // Each line of the trace is a second of the sensor data:
+  //   current_load overload_events_count [queue_wait_us [cpu_usage_percent]]
+  // Empty lines and lines starting with '#' are skipped.
+  std::size_t seconds = 0;
+  std::size_t limited_seconds = 0;
+  std::size_t max_shed_level = 0;
+  std::string line;
+  while (std::getline(std::cin, line)) {
+    if (line.empty() || line[0] == '#') continue;
+
+    std::istringstream input{line};
     Sensor::Data data;
-    std::string line;
-    std::cin >> data.current_load >> data.overload_events_count;
-    if (std::cin.eof()) break;
-    if (!std::cin.good()) throw std::runtime_error("Invalid input");
+    std::int64_t queue_wait_us = 0;
+    double cpu_usage_percent = 0;
+    input >> data.current_load >> data.overload_events_count;
+    if (!input) throw std::runtime_error("Invalid input: " + line);
+    if (input >> queue_wait_us) input >> cpu_usage_percent;
+    data.queue_wait = std::chrono::microseconds{queue_wait_us};
+    data.cpu_usage = cpu_usage_percent / 100;
 
     ctrl.Feed(data);
     auto limit = ctrl.GetLimit();
     if (limit.load_limit) {
-      std::cout << *limit.load_limit << std::endl;
+      std::cout << *limit.load_limit;
+      ++limited_seconds;
     } else {
-      std::cout << "(none)" << std::endl;
+      std::cout << "(none)";
     }
+    if (limit.shed_level) std::cout << " shed=" << limit.shed_level;
+    std::cout << std::endl;
+
+    ++seconds;
+    max_shed_level = std::max(max_shed_level, limit.shed_level);
   }
+
+  std::cerr << "seconds=" << seconds << " limited-seconds=" << limited_seconds
+            << " max-shed-level=" << max_shed_level << std::endl;
 }
@@ -0,0 +1,534 @@
+#pragma once
+
+/// @file userver/cache/flat_hash_map.hpp
+/// @brief @copybrief cache::FlatHashMap
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include <userver/utils/hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+namespace impl {
+
+// utils::hash::Hash<std::string> is transparent, which allows lookups by
+// std::string_view without constructing a std::string, and mixes the integers,
+// so that the bits of the hash are good for splitting
+template <typename Key>
+struct FlatHashMapHash : public utils::hash::Hash<Key> {};
+
+template <typename Hash, typename = void>
+inline constexpr bool kIsTransparentHash = false;
+
+template <typename Hash>
+inline constexpr bool
+    kIsTransparentHash<Hash, std::void_t<typename Hash::is_transparent>> = true;
+
+// Control bytes of a group of slots are matched at once
+class FlatHashMapGroup final {
+ public:
+  static constexpr std::size_t kWidth = 16;
+
+  static constexpr std::int8_t kEmpty = -128;
+  static constexpr std::int8_t kDeleted = -2;
+
+  explicit FlatHashMapGroup(const std::int8_t* ctrl) noexcept {
+#ifdef __SSE2__
+    ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+    std::memcpy(ctrl_, ctrl, kWidth);
+#endif
+  }
+
+  /// Bitmask of the slots with the h2 part of the hash
+  std::uint32_t Match(std::int8_t h2) const noexcept {
+#ifdef __SSE2__
+    return static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl_, _mm_set1_epi8(h2))));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      if (ctrl_[i] == h2) mask |= std::uint32_t{1} << i;
+    }
+    return mask;
+#endif
+  }
+
+  std::uint32_t MatchEmpty() const noexcept { return Match(kEmpty); }
+
+  /// Free slots have the sign bit set in the control byte
+  std::uint32_t MatchFree() const noexcept {
+#ifdef __SSE2__
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(ctrl_));
+#else
+    std::uint32_t mask = 0;
+    for (std::size_t i = 0; i < kWidth; ++i) {
+      if (ctrl_[i] < 0) mask |= std::uint32_t{1} << i;
+    }
+    return mask;
+#endif
+  }
+
+ private:
+#ifdef __SSE2__
+  __m128i ctrl_;
+#else
+  std::int8_t ctrl_[kWidth];
+#endif
+};
+
+}  // namespace impl
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief Open addressing hash map optimized for lookups, e.g. in caches that
+/// are built on update and then only read.
+///
+/// The elements are stored in a flat array of slots, a lookup does not chase
+/// pointers. The slots are split into groups of 16 with a control byte per
+/// slot, that holds 7 bits of the hash of the key. A lookup compares all the
+/// control bytes of a group at once (with SSE2, if available) and compares the
+/// keys only for the matching slots.
+///
+/// Usable as a `CacheContainer` of components::PostgreCache:
+///
+/// @code
+/// using CacheContainer = cache::FlatHashMap<KeyType, ValueType>;
+/// @endcode
+///
+/// Maps with std::string keys support lookups by std::string_view without
+/// constructing a std::string. The same is available for custom transparent
+/// hashers and comparators.
+///
+/// Elements are immutable through the iterators, use insert_or_assign() to
+/// change the values. Any modification invalidates the iterators and the
+/// references to the elements. Copying is O(capacity) and does not rehash.
+///
+/// Thread safety matches Standard Library thread safety.
+template <typename Key, typename Value,
+          typename Hash = impl::FlatHashMapHash<Key>,
+          typename Equal = std::equal_to<>>
+class FlatHashMap final {
+  using Group = impl::FlatHashMapGroup;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<Key, Value>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = Equal;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+
+  class const_iterator;
+  using iterator = const_iterator;
+
+  FlatHashMap() = default;
+  explicit FlatHashMap(const Hash& hash, const Equal& equal = Equal())
+      : hash_(hash), equal_(equal) {}
+
+  FlatHashMap(const FlatHashMap& other);
+  FlatHashMap(FlatHashMap&& other) noexcept { swap(other); }
+  ~FlatHashMap() { DestroySlots(); }
+
+  FlatHashMap& operator=(const FlatHashMap& other) {
+    if (this != &other) FlatHashMap{other}.swap(*this);
+    return *this;
+  }
+
+  FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+    if (this != &other) {
+      clear();
+      swap(other);
+    }
+    return *this;
+  }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  const_iterator begin() const noexcept {
+    return const_iterator{ctrl_.get(), slots_.get(), capacity_};
+  }
+  const_iterator end() const noexcept { return {}; }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  const_iterator find(const Key& key) const { return DoFind(key); }
+
+  /// Heterogeneous lookup, e.g. by std::string_view for std::string keys
+  template <typename K, typename H = Hash,
+            typename = std::enable_if_t<impl::kIsTransparentHash<H>>>
+  const_iterator find(const K& key) const {
+    return DoFind(key);
+  }
+
+  size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+  bool contains(const Key& key) const { return FindIndex(key) != kNotFound; }
+
+  template <typename K, typename H = Hash,
+            typename = std::enable_if_t<impl::kIsTransparentHash<H>>>
+  bool contains(const K& key) const {
+    return FindIndex(key) != kNotFound;
+  }
+
+  /// @throws std::out_of_range if there is no such key
+  const Value& at(const Key& key) const { return DoAt(key); }
+
+  /// @throws std::out_of_range if there is no such key
+  template <typename K, typename H = Hash,
+            typename = std::enable_if_t<impl::kIsTransparentHash<H>>>
+  const Value& at(const K& key) const {
+    return DoAt(key);
+  }
+
+  /// Adds the element if there is no such key
+  /// @returns true if the element was added
+  bool insert(value_type value) {
+    const auto hash = Mix(hash_(value.first));
+    if (FindIndex(value.first, hash) != kNotFound) return false;
+    Emplace(hash, std::move(value));
+    return true;
+  }
+
+  /// Adds the element or replaces the value of the existing key
+  /// @returns true if the element was added
+  template <typename V>
+  bool insert_or_assign(Key key, V&& value) {
+    const auto hash = Mix(hash_(key));
+    const auto index = FindIndex(key, hash);
+    if (index != kNotFound) {
+      slots_[index].value.second = std::forward<V>(value);
+      return false;
+    }
+    Emplace(hash, value_type{std::move(key), std::forward<V>(value)});
+    return true;
+  }
+
+  /// @returns the number of erased elements
+  size_type erase(const Key& key);
+
+  /// Allocates the slots for `count` elements
+  void reserve(size_type count) {
+    const auto capacity = CapacityFor(count);
+    if (capacity > capacity_) Rehash(capacity);
+  }
+
+  void clear() noexcept {
+    DestroySlots();
+    ctrl_.reset();
+    slots_.reset();
+    capacity_ = 0;
+    size_ = 0;
+    growth_left_ = 0;
+  }
+
+  void swap(FlatHashMap& other) noexcept {
+    using std::swap;
+    swap(ctrl_, other.ctrl_);
+    swap(slots_, other.slots_);
+    swap(capacity_, other.capacity_);
+    swap(size_, other.size_);
+    swap(growth_left_, other.growth_left_);
+    swap(hash_, other.hash_);
+    swap(equal_, other.equal_);
+  }
+
+ private:
+  static constexpr auto kNotFound = static_cast<std::size_t>(-1);
+
+  union Slot {
+    Slot() noexcept {}
+    ~Slot() {}
+
+    value_type value;
+  };
+
+  // Keeps at least 1/8 of the slots empty to stop the probing
+  static constexpr std::size_t MaxLoad(std::size_t capacity) noexcept {
+    return capacity - capacity / 8;
+  }
+
+  static std::size_t CapacityFor(std::size_t count) noexcept {
+    std::size_t capacity = Group::kWidth;
+    while (MaxLoad(capacity) < count) capacity *= 2;
+    return capacity;
+  }
+
+  // Identity hashes of integers are not good enough to take 7 bits of them
+  static std::size_t Mix(std::size_t hash) noexcept {
+    const auto mixed =
+        static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<std::size_t>(mixed ^ (mixed >> 32));
+  }
+
+  static std::int8_t H2(std::size_t hash) noexcept {
+    return static_cast<std::int8_t>(hash & 0x7F);
+  }
+
+  std::size_t FirstGroup(std::size_t hash) const noexcept {
+    return (hash >> 7) & (capacity_ / Group::kWidth - 1);
+  }
+
+  std::size_t NextGroup(std::size_t group, std::size_t step) const noexcept {
+    // Triangular probing visits all the groups for power of 2 group counts
+    return (group + step) & (capacity_ / Group::kWidth - 1);
+  }
+
+  template <typename K>
+  std::size_t FindIndex(const K& key) const {
+    return FindIndex(key, Mix(hash_(key)));
+  }
+
+  template <typename K>
+  std::size_t FindIndex(const K& key, std::size_t hash) const;
+
+  template <typename K>
+  const_iterator DoFind(const K& key) const {
+    const auto index = FindIndex(key);
+    if (index == kNotFound) return end();
+    return const_iterator{ctrl_.get() + index, slots_.get() + index,
+                          capacity_ - index};
+  }
+
+  template <typename K>
+  const Value& DoAt(const K& key) const {
+    const auto index = FindIndex(key);
+    if (index == kNotFound) throw std::out_of_range("FlatHashMap::at");
+    return slots_[index].value.second;
+  }
+
+  std::size_t FindFreeIndex(std::size_t hash) const noexcept;
+
+  void Emplace(std::size_t hash, value_type&& value);
+
+  void Rehash(std::size_t capacity);
+
+  void DestroySlots() noexcept {
+    if constexpr (!std::is_trivially_destructible_v<value_type>) {
+      for (std::size_t i = 0; i < capacity_; ++i) {
+        if (ctrl_[i] >= 0) slots_[i].value.~value_type();
+      }
+    }
+  }
+
+  std::unique_ptr<std::int8_t[]> ctrl_;
+  std::unique_ptr<Slot[]> slots_;
+  std::size_t capacity_{0};
+  size_type size_{0};
+  std::size_t growth_left_{0};
+  Hash hash_;
+  Equal equal_;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+class FlatHashMap<Key, Value, Hash, Equal>::const_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = FlatHashMap::value_type;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  const_iterator() noexcept = default;
+
+  reference operator*() const noexcept { return slot_->value; }
+  pointer operator->() const noexcept { return &slot_->value; }
+
+  const_iterator& operator++() noexcept {
+    ++ctrl_;
+    ++slot_;
+    --left_;
+    SkipFree();
+    return *this;
+  }
+
+  const_iterator operator++(int) noexcept {
+    auto result = *this;
+    ++*this;
+    return result;
+  }
+
+  bool operator==(const const_iterator& other) const noexcept {
+    return slot_ == other.slot_;
+  }
+  bool operator!=(const const_iterator& other) const noexcept {
+    return slot_ != other.slot_;
+  }
+
+ private:
+  friend class FlatHashMap;
+
+  const_iterator(const std::int8_t* ctrl, const Slot* slot,
+                 std::size_t left) noexcept
+      : ctrl_(ctrl), slot_(slot), left_(left) {
+    SkipFree();
+  }
+
+  void SkipFree() noexcept {
+    while (left_ > 0 && *ctrl_ < 0) {
+      ++ctrl_;
+      ++slot_;
+      --left_;
+    }
+    if (left_ == 0) slot_ = nullptr;
+  }
+
+  const std::int8_t* ctrl_{nullptr};
+  const Slot* slot_{nullptr};
+  std::size_t left_{0};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+FlatHashMap<Key, Value, Hash, Equal>::FlatHashMap(const FlatHashMap& other)
+    : hash_(other.hash_), equal_(other.equal_) {
+  if (other.capacity_ == 0) return;
+
+  auto ctrl = std::make_unique<std::int8_t[]>(other.capacity_);
+  auto slots = std::make_unique<Slot[]>(other.capacity_);
+  std::size_t constructed = 0;
+  try {
+    for (; constructed < other.capacity_; ++constructed) {
+      if (other.ctrl_[constructed] >= 0) {
+        new (&slots[constructed].value)
+            value_type(other.slots_[constructed].value);
+      }
+    }
+  } catch (...) {
+    for (std::size_t i = 0; i < constructed; ++i) {
+      if (other.ctrl_[i] >= 0) slots[i].value.~value_type();
+    }
+    throw;
+  }
+  std::memcpy(ctrl.get(), other.ctrl_.get(), other.capacity_);
+
+  ctrl_ = std::move(ctrl);
+  slots_ = std::move(slots);
+  capacity_ = other.capacity_;
+  size_ = other.size_;
+  growth_left_ = other.growth_left_;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename K>
+std::size_t FlatHashMap<Key, Value, Hash, Equal>::FindIndex(
+    const K& key, std::size_t hash) const {
+  if (size_ == 0) return kNotFound;
+
+  const auto h2 = H2(hash);
+  auto group = FirstGroup(hash);
+  for (std::size_t step = 1;; ++step) {
+    const auto offset = group * Group::kWidth;
+    const Group group_ctrl{ctrl_.get() + offset};
+    for (auto mask = group_ctrl.Match(h2); mask != 0; mask &= mask - 1) {
+      const auto index = offset + __builtin_ctz(mask);
+      if (equal_(slots_[index].value.first, key)) return index;
+    }
+    if (group_ctrl.MatchEmpty() != 0) return kNotFound;
+    group = NextGroup(group, step);
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+std::size_t FlatHashMap<Key, Value, Hash, Equal>::FindFreeIndex(
+    std::size_t hash) const noexcept {
+  auto group = FirstGroup(hash);
+  for (std::size_t step = 1;; ++step) {
+    const auto offset = group * Group::kWidth;
+    const auto mask = Group{ctrl_.get() + offset}.MatchFree();
+    if (mask != 0) return offset + __builtin_ctz(mask);
+    group = NextGroup(group, step);
+  }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void FlatHashMap<Key, Value, Hash, Equal>::Emplace(std::size_t hash,
+                                                   value_type&& value) {
+  if (growth_left_ == 0) {
+    // Many deleted slots are reclaimed without growing
+    Rehash(size_ + 1 > MaxLoad(capacity_) / 2 ? CapacityFor(size_ * 2 + 1)
+                                              : capacity_);
+  }
+
+  const auto index = FindFreeIndex(hash);
+  new (&slots_[index].value) value_type(std::move(value));
+  if (ctrl_[index] == Group::kEmpty) --growth_left_;
+  ctrl_[index] = H2(hash);
+  ++size_;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void FlatHashMap<Key, Value, Hash, Equal>::Rehash(std::size_t capacity) {
+  FlatHashMap rehashed{hash_, equal_};
+  rehashed.ctrl_ = std::make_unique<std::int8_t[]>(capacity);
+  std::memset(rehashed.ctrl_.get(), Group::kEmpty, capacity);
+  rehashed.slots_ = std::make_unique<Slot[]>(capacity);
+  rehashed.capacity_ = capacity;
+  rehashed.growth_left_ = MaxLoad(capacity);
+
+  for (std::size_t i = 0; i < capacity_; ++i) {
+    if (ctrl_[i] < 0) continue;
+    auto& value = slots_[i].value;
+    rehashed.Emplace(Mix(hash_(value.first)), std::move(value));
+  }
+  swap(rehashed);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto FlatHashMap<Key, Value, Hash, Equal>::erase(const Key& key)
+    -> size_type {
+  const auto index = FindIndex(key);
+  if (index == kNotFound) return 0;
+
+  slots_[index].value.~value_type();
+  // The slot may be in the middle of a probe sequence, so it is not empty
+  ctrl_[index] = Group::kDeleted;
+  --size_;
+  return 1;
+}
+
+/// Maps are equal if they have the same keys with equal values
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool operator==(const FlatHashMap<Key, Value, Hash, Equal>& lhs,
+                const FlatHashMap<Key, Value, Hash, Equal>& rhs) {
+  if (lhs.size() != rhs.size()) return false;
+  for (const auto& [key, value] : lhs) {
+    const auto it = rhs.find(key);
+    if (it == rhs.end() || !(it->second == value)) return false;
+  }
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool operator!=(const FlatHashMap<Key, Value, Hash, Equal>& lhs,
+                const FlatHashMap<Key, Value, Hash, Equal>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void swap(FlatHashMap<Key, Value, Hash, Equal>& lhs,
+          FlatHashMap<Key, Value, Hash, Equal>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
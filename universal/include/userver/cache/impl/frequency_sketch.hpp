@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Approximate access frequencies of the keys for TinyLFU admission,
+/// https://arxiv.org/abs/1512.00727
+///
+/// A count-min sketch of 4 rows of counters saturating at 15. A row has at
+/// least `4 * capacity` counters, narrower rows overestimate the frequencies of
+/// the one-hit keys too much. All the counters are halved after
+/// `10 * capacity` increments, so the frequencies reflect the recent accesses.
+///
+/// Thread-safe. Concurrent increments may be lost, which does not matter for
+/// the estimation.
+class FrequencySketch final {
+ public:
+  explicit FrequencySketch(std::size_t capacity)
+      : mask_(GetWidth(capacity) - 1),
+        counters_(new std::atomic<std::uint8_t>[kRows * (mask_ + 1)]),
+        sample_size_(GetSampleSize(capacity)) {
+    for (std::size_t i = 0; i < kRows * (mask_ + 1); ++i) {
+      counters_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  /// Records an access to the key with the `hash`
+  void Increment(std::size_t hash) noexcept {
+    std::array<std::atomic<std::uint8_t>*, kRows> counters{};
+    std::uint8_t min = kMaxCount;
+    for (std::size_t row = 0; row < kRows; ++row) {
+      counters[row] = &GetCounter(hash, row);
+      const auto count = counters[row]->load(std::memory_order_relaxed);
+      if (count < min) min = count;
+    }
+    if (min == kMaxCount) return;
+
+    // Conservative update: only the smallest counters are incremented
+    for (auto* counter : counters) {
+      if (counter->load(std::memory_order_relaxed) == min) {
+        counter->store(min + 1, std::memory_order_relaxed);
+      }
+    }
+
+    const auto size_limit = sample_size_.load(std::memory_order_relaxed);
+    auto additions = additions_.fetch_add(1, std::memory_order_relaxed) + 1;
+    // Only one of the concurrent callers succeeds and ages the counters
+    if (additions >= size_limit &&
+        additions_.compare_exchange_strong(additions, size_limit / 2,
+                                           std::memory_order_relaxed)) {
+      Age();
+    }
+  }
+
+  /// Estimated number of recent accesses to the key with the `hash`
+  std::uint8_t Estimate(std::size_t hash) const noexcept {
+    std::uint8_t min = kMaxCount;
+    for (std::size_t row = 0; row < kRows; ++row) {
+      const auto count = GetCounter(hash, row).load(std::memory_order_relaxed);
+      if (count < min) min = count;
+    }
+    return min;
+  }
+
+  /// Changes the aging period for the new cache capacity. The number of
+  /// counters stays the same, which makes estimations less precise for the
+  /// capacities much larger than the initial one.
+  void SetCapacity(std::size_t capacity) noexcept {
+    sample_size_.store(GetSampleSize(capacity), std::memory_order_relaxed);
+    additions_.store(0, std::memory_order_relaxed);
+  }
+
+  void Clear() noexcept {
+    for (std::size_t i = 0; i < kRows * (mask_ + 1); ++i) {
+      counters_[i].store(0, std::memory_order_relaxed);
+    }
+    additions_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr std::size_t kRows = 4;
+  static constexpr std::uint8_t kMaxCount = 15;
+  static constexpr std::size_t kMinWidth = 64;
+  static constexpr std::size_t kWidthFactor = 4;
+  static constexpr std::array<std::uint64_t, kRows> kSeeds{
+      0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL,
+      0xD6E8FEB86659FD93ULL};
+
+  static std::size_t GetWidth(std::size_t capacity) noexcept {
+    std::size_t width = kMinWidth;
+    while (width < kWidthFactor * capacity) width *= 2;
+    return width;
+  }
+
+  static std::size_t GetSampleSize(std::size_t capacity) noexcept {
+    return 10 * (capacity == 0 ? 1 : capacity);
+  }
+
+  std::atomic<std::uint8_t>& GetCounter(std::size_t hash,
+                                        std::size_t row) const noexcept {
+    auto mixed = (static_cast<std::uint64_t>(hash) + row) * kSeeds[row];
+    mixed ^= mixed >> 32;
+    return counters_[row * (mask_ + 1) + (mixed & mask_)];
+  }
+
+  void Age() noexcept {
+    for (std::size_t i = 0; i < kRows * (mask_ + 1); ++i) {
+      auto& counter = counters_[i];
+      counter.store(counter.load(std::memory_order_relaxed) / 2,
+                    std::memory_order_relaxed);
+    }
+  }
+
+  const std::size_t mask_;
+  const std::unique_ptr<std::atomic<std::uint8_t>[]> counters_;
+  std::atomic<std::size_t> sample_size_;
+  std::atomic<std::size_t> additions_{0};
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
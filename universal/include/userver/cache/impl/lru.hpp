@@ -10,6 +10,7 @@
 #include <boost/intrusive/unordered_set_hook.hpp>
 
 #include <userver/utils/assert.hpp>
+#include <userver/utils/hash.hpp>
 #include <userver/utils/impl/intrusive_link_mode.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -80,7 +81,8 @@ const T& GetKey(const T& key) noexcept {
   return key;
 }
 
-template <typename T, typename U, typename Hash = std::hash<T>,
+template <typename T, typename U,
+          typename Hash = utils::hash::Hash<T>,
           typename Equal = std::equal_to<T>>
 class LruBase final {
  public:
@@ -30,7 +30,8 @@ USERVER_NAMESPACE_BEGIN
 
 namespace cache::impl {
 
-template <typename T, typename U, typename Hash = std::hash<T>,
+template <typename T, typename U,
+          typename Hash = utils::hash::Hash<T>,
           typename Equal = std::equal_to<T>>
 class SlruBase final {
  public:
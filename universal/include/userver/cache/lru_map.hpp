@@ -14,7 +14,8 @@ namespace cache {
 ///
 /// LRU key value storage (LRU cache), thread safety matches Standard Library
 /// thread safety
-template <typename T, typename U, typename Hash = std::hash<T>,
+template <typename T, typename U,
+          typename Hash = utils::hash::Hash<T>,
           typename Equal = std::equal_to<T>>
 class LruMap final {
  public:
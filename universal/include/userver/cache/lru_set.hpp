@@ -12,7 +12,7 @@ namespace cache {
 /// @ingroup userver_universal userver_containers
 ///
 /// LRU set, thread safety matches Standard Library thread safety
-template <typename T, typename Hash = std::hash<T>,
+template <typename T, typename Hash = utils::hash::Hash<T>,
           typename Equal = std::equal_to<T>>
 class LruSet final {
  public:
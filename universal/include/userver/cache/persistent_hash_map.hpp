@@ -0,0 +1,483 @@
+#pragma once
+
+/// @file userver/cache/persistent_hash_map.hpp
+/// @brief @copybrief cache::PersistentHashMap
+
+#include <array>
+#include <bitset>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief Hash map with O(1) copying, copies share the unchanged parts of the
+/// map.
+///
+/// The map is a hash array mapped trie of immutable shared nodes. A copy
+/// shares all the nodes with the original, a modification copies only the
+/// nodes on the path to the changed element (at most
+/// `sizeof(std::size_t) * CHAR_BIT / 5 + 1` nodes of up to 32 pointers each).
+/// Nodes that are not shared with other copies are modified in place.
+///
+/// Intended for large caches with incremental updates, where copying the whole
+/// container on each update is too slow, e.g. as a `CacheContainer` of
+/// components::PostgreCache:
+///
+/// @code
+/// using CacheContainer = cache::PersistentHashMap<KeyType, ValueType>;
+/// @endcode
+///
+/// Lookups are a bit slower than in std::unordered_map. Elements may not be
+/// modified in place, use insert_or_assign() instead. Iteration order is
+/// unspecified, but is the same for equal maps with the same history.
+///
+/// Thread safety matches Standard Library thread safety: different copies may
+/// be used concurrently, even if they share nodes.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class PersistentHashMap final {
+  struct Leaf;
+  struct Node;
+
+ public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const Key, Value>;
+  using size_type = std::size_t;
+  using hasher = Hash;
+  using key_equal = Equal;
+  using reference = const value_type&;
+  using const_reference = const value_type&;
+
+  class const_iterator;
+  using iterator = const_iterator;
+
+  PersistentHashMap() = default;
+  explicit PersistentHashMap(const Hash& hash, const Equal& equal = Equal())
+      : hash_(hash), equal_(equal) {}
+
+  /// O(1), the copy shares all the nodes with `other`
+  PersistentHashMap(const PersistentHashMap& other) = default;
+  PersistentHashMap(PersistentHashMap&& other) noexcept
+      : root_(std::move(other.root_)),
+        size_(std::exchange(other.size_, 0)),
+        hash_(std::move(other.hash_)),
+        equal_(std::move(other.equal_)) {}
+
+  PersistentHashMap& operator=(const PersistentHashMap& other) = default;
+  PersistentHashMap& operator=(PersistentHashMap&& other) noexcept {
+    root_ = std::move(other.root_);
+    size_ = std::exchange(other.size_, 0);
+    hash_ = std::move(other.hash_);
+    equal_ = std::move(other.equal_);
+    return *this;
+  }
+
+  size_type size() const noexcept { return size_; }
+  bool empty() const noexcept { return size_ == 0; }
+
+  const_iterator begin() const { return const_iterator{root_.get()}; }
+  const_iterator end() const noexcept { return {}; }
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+  const_iterator find(const Key& key) const;
+
+  size_type count(const Key& key) const { return FindLeaf(key) ? 1 : 0; }
+  bool contains(const Key& key) const { return FindLeaf(key) != nullptr; }
+
+  /// @throws std::out_of_range if there is no such key
+  const Value& at(const Key& key) const {
+    const auto* leaf = FindLeaf(key);
+    if (!leaf) throw std::out_of_range("PersistentHashMap::at");
+    return leaf->value.second;
+  }
+
+  /// Adds the element if there is no such key
+  /// @returns true if the element was added
+  bool insert(value_type value) {
+    return Assign(std::move(value), /*overwrite=*/false);
+  }
+
+  /// Adds the element or replaces the value of the existing key
+  /// @returns true if the element was added
+  template <typename V>
+  bool insert_or_assign(Key key, V&& value) {
+    return Assign(value_type{std::move(key), std::forward<V>(value)},
+                  /*overwrite=*/true);
+  }
+
+  /// @returns the number of erased elements
+  size_type erase(const Key& key);
+
+  void clear() noexcept {
+    root_.reset();
+    size_ = 0;
+  }
+
+  void swap(PersistentHashMap& other) noexcept {
+    using std::swap;
+    swap(root_, other.root_);
+    swap(size_, other.size_);
+    swap(hash_, other.hash_);
+    swap(equal_, other.equal_);
+  }
+
+ private:
+  static constexpr unsigned kBitsPerLevel = 5;
+  static constexpr unsigned kHashBits = sizeof(std::size_t) * CHAR_BIT;
+  // Leaves with equal hashes are stored in a collision node below the last
+  // level
+  static constexpr std::size_t kMaxDepth = kHashBits / kBitsPerLevel + 2;
+
+  struct Leaf final {
+    Leaf(std::size_t key_hash, value_type&& key_value)
+        : hash(key_hash), value(std::move(key_value)) {}
+
+    const std::size_t hash;
+    const value_type value;
+  };
+
+  // Leaves and children are ordered by their position in the bitmaps. A
+  // collision node keeps the leaves in insertion order and has no bitmaps.
+  struct Node final {
+    std::uint32_t leaf_bitmap{0};
+    std::uint32_t child_bitmap{0};
+    std::vector<std::shared_ptr<const Leaf>> leaves;
+    std::vector<std::shared_ptr<Node>> children;
+  };
+
+  static std::uint32_t GetBit(std::size_t hash, unsigned shift) noexcept {
+    return std::uint32_t{1} << ((hash >> shift) & ((1u << kBitsPerLevel) - 1));
+  }
+
+  static std::size_t GetIndex(std::uint32_t bitmap, std::uint32_t bit) {
+    return std::bitset<32>(bitmap & (bit - 1)).count();
+  }
+
+  // Copies the node if it is shared with other maps
+  static Node& MakeUnique(std::shared_ptr<Node>& node) {
+    if (node.use_count() != 1) node = std::make_shared<Node>(*node);
+    return *node;
+  }
+
+  static void PutLeaf(Node& node, std::shared_ptr<const Leaf>&& leaf,
+                      unsigned shift) {
+    if (shift < kHashBits) node.leaf_bitmap = GetBit(leaf->hash, shift);
+    node.leaves.push_back(std::move(leaf));
+  }
+
+  const Leaf* FindLeaf(const Key& key) const;
+
+  bool Assign(value_type&& value, bool overwrite);
+  bool Assign(std::shared_ptr<Node>& node_ptr, std::size_t hash,
+              unsigned shift, value_type&& value, bool overwrite);
+
+  void Erase(std::shared_ptr<Node>& node_ptr, std::size_t hash, unsigned shift,
+             const Key& key);
+
+  std::shared_ptr<Node> root_;
+  size_type size_{0};
+  Hash hash_;
+  Equal equal_;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+class PersistentHashMap<Key, Value, Hash, Equal>::const_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = PersistentHashMap::value_type;
+  using reference = const value_type&;
+  using pointer = const value_type*;
+
+  const_iterator() noexcept = default;
+
+  reference operator*() const noexcept { return *current_; }
+  pointer operator->() const noexcept { return current_; }
+
+  const_iterator& operator++() {
+    Advance();
+    return *this;
+  }
+
+  const_iterator operator++(int) {
+    auto result = *this;
+    Advance();
+    return result;
+  }
+
+  bool operator==(const const_iterator& other) const noexcept {
+    return current_ == other.current_;
+  }
+  bool operator!=(const const_iterator& other) const noexcept {
+    return current_ != other.current_;
+  }
+
+ private:
+  friend class PersistentHashMap;
+
+  // Next leaf and next child to visit in the node
+  struct Frame final {
+    const Node* node{nullptr};
+    std::size_t leaf_index{0};
+    std::size_t child_index{0};
+  };
+
+  explicit const_iterator(const Node* root) {
+    if (!root) return;
+    Push(root, 0, 0);
+    Advance();
+  }
+
+  void Push(const Node* node, std::size_t leaf_index, std::size_t child_index) {
+    stack_[depth_++] = Frame{node, leaf_index, child_index};
+  }
+
+  void Advance() {
+    while (depth_ > 0) {
+      auto& frame = stack_[depth_ - 1];
+      if (frame.leaf_index < frame.node->leaves.size()) {
+        current_ = &frame.node->leaves[frame.leaf_index++]->value;
+        return;
+      }
+      if (frame.child_index < frame.node->children.size()) {
+        Push(frame.node->children[frame.child_index++].get(), 0, 0);
+        continue;
+      }
+      --depth_;
+    }
+    current_ = nullptr;
+  }
+
+  // No allocations for the iteration, the depth of the trie is bounded
+  std::array<Frame, kMaxDepth> stack_{};
+  std::size_t depth_{0};
+  const value_type* current_{nullptr};
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::find(const Key& key) const
+    -> const_iterator {
+  const auto hash = hash_(key);
+  const_iterator it;
+  const Node* node = root_.get();
+  unsigned shift = 0;
+  while (node) {
+    if (shift >= kHashBits) {
+      for (std::size_t i = 0; i < node->leaves.size(); ++i) {
+        if (equal_(node->leaves[i]->value.first, key)) {
+          it.Push(node, i + 1, 0);
+          it.current_ = &node->leaves[i]->value;
+          return it;
+        }
+      }
+      return end();
+    }
+
+    const auto bit = GetBit(hash, shift);
+    if (node->child_bitmap & bit) {
+      const auto index = GetIndex(node->child_bitmap, bit);
+      it.Push(node, node->leaves.size(), index + 1);
+      node = node->children[index].get();
+      shift += kBitsPerLevel;
+      continue;
+    }
+    if (node->leaf_bitmap & bit) {
+      const auto index = GetIndex(node->leaf_bitmap, bit);
+      const auto& leaf = *node->leaves[index];
+      if (leaf.hash != hash || !equal_(leaf.value.first, key)) return end();
+      it.Push(node, index + 1, 0);
+      it.current_ = &leaf.value;
+      return it;
+    }
+    return end();
+  }
+  return end();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::FindLeaf(const Key& key) const
+    -> const Leaf* {
+  const auto hash = hash_(key);
+  const Node* node = root_.get();
+  unsigned shift = 0;
+  while (node) {
+    if (shift >= kHashBits) {
+      for (const auto& leaf : node->leaves) {
+        if (equal_(leaf->value.first, key)) return leaf.get();
+      }
+      return nullptr;
+    }
+
+    const auto bit = GetBit(hash, shift);
+    if (node->child_bitmap & bit) {
+      node = node->children[GetIndex(node->child_bitmap, bit)].get();
+      shift += kBitsPerLevel;
+      continue;
+    }
+    if (node->leaf_bitmap & bit) {
+      const auto* leaf = node->leaves[GetIndex(node->leaf_bitmap, bit)].get();
+      if (leaf->hash == hash && equal_(leaf->value.first, key)) return leaf;
+    }
+    return nullptr;
+  }
+  return nullptr;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentHashMap<Key, Value, Hash, Equal>::Assign(value_type&& value,
+                                                        bool overwrite) {
+  const auto hash = hash_(value.first);
+  if (!root_) root_ = std::make_shared<Node>();
+  const bool is_added = Assign(root_, hash, 0, std::move(value), overwrite);
+  if (is_added) ++size_;
+  return is_added;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool PersistentHashMap<Key, Value, Hash, Equal>::Assign(
+    std::shared_ptr<Node>& node_ptr, std::size_t hash, unsigned shift,
+    value_type&& value, bool overwrite) {
+  if (shift >= kHashBits) {
+    auto& node = MakeUnique(node_ptr);
+    for (auto& leaf : node.leaves) {
+      if (equal_(leaf->value.first, value.first)) {
+        if (overwrite) {
+          leaf = std::make_shared<const Leaf>(hash, std::move(value));
+        }
+        return false;
+      }
+    }
+    node.leaves.push_back(std::make_shared<const Leaf>(hash, std::move(value)));
+    return true;
+  }
+
+  const auto bit = GetBit(hash, shift);
+  if (node_ptr->child_bitmap & bit) {
+    auto& node = MakeUnique(node_ptr);
+    return Assign(node.children[GetIndex(node.child_bitmap, bit)], hash,
+                  shift + kBitsPerLevel, std::move(value), overwrite);
+  }
+
+  if (node_ptr->leaf_bitmap & bit) {
+    const auto leaf_index = GetIndex(node_ptr->leaf_bitmap, bit);
+    const auto& leaf = *node_ptr->leaves[leaf_index];
+    if (leaf.hash == hash && equal_(leaf.value.first, value.first)) {
+      if (!overwrite) return false;
+      // Does not copy the node for an insert of an existing key
+      MakeUnique(node_ptr).leaves[leaf_index] =
+          std::make_shared<const Leaf>(hash, std::move(value));
+      return false;
+    }
+
+    // Moves the existing leaf down to a new child together with the new one
+    auto& node = MakeUnique(node_ptr);
+    auto child = std::make_shared<Node>();
+    PutLeaf(*child, std::move(node.leaves[leaf_index]), shift + kBitsPerLevel);
+    node.leaves.erase(node.leaves.begin() + leaf_index);
+    node.leaf_bitmap &= ~bit;
+
+    node.child_bitmap |= bit;
+    const auto child_index = GetIndex(node.child_bitmap, bit);
+    auto& child_ptr = *node.children.insert(
+        node.children.begin() + child_index, std::move(child));
+    return Assign(child_ptr, hash, shift + kBitsPerLevel, std::move(value),
+                  overwrite);
+  }
+
+  auto& node = MakeUnique(node_ptr);
+  node.leaf_bitmap |= bit;
+  node.leaves.insert(node.leaves.begin() + GetIndex(node.leaf_bitmap, bit),
+                     std::make_shared<const Leaf>(hash, std::move(value)));
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto PersistentHashMap<Key, Value, Hash, Equal>::erase(const Key& key)
+    -> size_type {
+  // Does not copy the nodes if there is nothing to erase
+  if (!FindLeaf(key)) return 0;
+
+  Erase(root_, hash_(key), 0, key);
+  if (--size_ == 0) root_.reset();
+  return 1;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void PersistentHashMap<Key, Value, Hash, Equal>::Erase(
+    std::shared_ptr<Node>& node_ptr, std::size_t hash, unsigned shift,
+    const Key& key) {
+  auto& node = MakeUnique(node_ptr);
+  if (shift >= kHashBits) {
+    for (auto it = node.leaves.begin(); it != node.leaves.end(); ++it) {
+      if (equal_((*it)->value.first, key)) {
+        node.leaves.erase(it);
+        return;
+      }
+    }
+    return;
+  }
+
+  const auto bit = GetBit(hash, shift);
+  if (node.leaf_bitmap & bit) {
+    node.leaves.erase(node.leaves.begin() + GetIndex(node.leaf_bitmap, bit));
+    node.leaf_bitmap &= ~bit;
+    return;
+  }
+
+  const auto child_index = GetIndex(node.child_bitmap, bit);
+  auto& child_ptr = node.children[child_index];
+  Erase(child_ptr, hash, shift + kBitsPerLevel, key);
+
+  // Keeps the trie compact: a child with a single leaf is replaced by the leaf
+  if (child_ptr->children.empty() && child_ptr->leaves.size() <= 1) {
+    auto child = std::move(child_ptr);
+    node.children.erase(node.children.begin() + child_index);
+    node.child_bitmap &= ~bit;
+    if (!child->leaves.empty()) {
+      node.leaf_bitmap |= bit;
+      node.leaves.insert(node.leaves.begin() + GetIndex(node.leaf_bitmap, bit),
+                         child->leaves.front());
+    }
+  }
+}
+
+/// Maps are equal if they have the same keys with equal values
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool operator==(const PersistentHashMap<Key, Value, Hash, Equal>& lhs,
+                const PersistentHashMap<Key, Value, Hash, Equal>& rhs) {
+  if (lhs.size() != rhs.size()) return false;
+  for (const auto& [key, value] : lhs) {
+    const auto it = rhs.find(key);
+    if (it == rhs.end() || !(it->second == value)) return false;
+  }
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool operator!=(const PersistentHashMap<Key, Value, Hash, Equal>& lhs,
+                const PersistentHashMap<Key, Value, Hash, Equal>& rhs) {
+  return !(lhs == rhs);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void swap(PersistentHashMap<Key, Value, Hash, Equal>& lhs,
+          PersistentHashMap<Key, Value, Hash, Equal>& rhs) noexcept {
+  lhs.swap(rhs);
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,89 @@
+#pragma once
+
+/// @file userver/crypto/caching_verifier.hpp
+/// @brief @copybrief crypto::CachingVerifier
+/// @ingroup userver_universal
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <string_view>
+
+#include <userver/crypto/verifiers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace crypto {
+
+/// Settings of a crypto::CachingVerifier
+struct CachingVerifierSettings final {
+  /// Maximum number of the remembered signatures
+  std::size_t max_size{10000};
+
+  /// Maximum time a signature is remembered for
+  std::chrono::seconds max_ttl{std::chrono::minutes{5}};
+};
+
+/// Statistics of a crypto::CachingVerifier
+struct CachingVerifierStatistics final {
+  /// Number of the verifications answered from the cache
+  std::uint64_t hits{0};
+
+  /// Number of the verifications done by the underlying verifier
+  std::uint64_t misses{0};
+};
+
+/// @brief Verifier that remembers the successfully verified signatures, so
+/// that the same token is verified by the underlying verifier only once.
+///
+/// The services that receive the same bearer tokens over and over spend a
+/// lot of CPU on the asymmetric verifications, e.g. ECDSA verification is
+/// about a hundred times slower than a lookup of the SHA-256 digest of the
+/// message and the signature in a hash map. The failed verifications are not
+/// remembered. The cache is bounded by CachingVerifierSettings::max_size
+/// with the least recently used signatures evicted first, and is split into
+/// shards to reduce the contention of the concurrent verifications.
+///
+/// The verifier is thread-safe and has the same name as the underlying one.
+///
+/// ## Example usage:
+///
+/// @snippet crypto/caching_verifier_test.cpp  Sample crypto::CachingVerifier
+class CachingVerifier final : public Verifier {
+ public:
+  CachingVerifier(std::shared_ptr<const Verifier> verifier,
+                  const CachingVerifierSettings& settings = {});
+  ~CachingVerifier() override;
+
+  /// @brief Verifies a signature against the message, a successful result is
+  /// remembered for CachingVerifierSettings::max_ttl
+  /// @throws crypto::VerificationError
+  void Verify(std::initializer_list<std::string_view> data,
+              std::string_view raw_signature) const override;
+
+  /// @brief Verifies a signature against the message, a successful result is
+  /// remembered until `expires_at`, e.g. the `exp` claim of a JWT, but not
+  /// longer than CachingVerifierSettings::max_ttl
+  /// @throws crypto::VerificationError
+  void Verify(std::initializer_list<std::string_view> data,
+              std::string_view raw_signature,
+              std::chrono::system_clock::time_point expires_at) const;
+
+  /// Forgets all the remembered signatures
+  void Clear();
+
+  /// Returns the statistics of the cache
+  CachingVerifierStatistics GetStatistics() const noexcept;
+
+ private:
+  struct Impl;
+
+  std::shared_ptr<const Verifier> verifier_;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace crypto
+
+USERVER_NAMESPACE_END
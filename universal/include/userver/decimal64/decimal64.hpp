@@ -126,6 +126,20 @@ template <typename RoundPolicy>
 constexpr int64_t MulDiv(int64_t value1, int64_t value2, int64_t divisor) {
   if (divisor == 0) throw DivisionByZeroError();
 
+  // Fast path: the product fits into 64 bits, and the division is a plain
+  // 64-bit one, or even a multiplication if the divisor is a known power of 10
+  int64_t prod64{};
+  if (!__builtin_mul_overflow(value1, value2, &prod64) && divisor != -1) {
+    const int64_t whole64 = prod64 / divisor;
+    const int64_t rem64 = prod64 % divisor;
+    if (whole64 == kMinInt64 || whole64 == kMaxInt64) {
+      throw OutOfBoundsError();
+    }
+    if (rem64 == 0) return whole64;
+    const bool extra_odd_quotient = whole64 % 2 != 0;
+    return whole64 + Div<RoundPolicy>(rem64, divisor, extra_odd_quotient);
+  }
+
 #if __x86_64__ || __ppc64__ || __aarch64__
   using LongInt = __int128_t;
   static_assert(sizeof(void*) == 8);
@@ -1277,6 +1291,30 @@ Decimal<Prec, RoundPolicy>::FromStringPermissive(std::string_view input) {
   return result.decimal;
 }
 
+/// The size of a buffer that fits any Decimal written by ToChars: the sign,
+/// at most kMaxDecimalDigits + 1 digits and the decimal point
+inline constexpr std::size_t kMaxCharsSize = impl::kMaxDecimalDigits + 3;
+
+/// A buffer for ToChars
+using CharsBuffer = std::array<char, kMaxCharsSize>;
+
+/// @brief Writes Decimal to the `buffer` like ToString does, without
+/// allocations
+///
+/// Usage example:
+///
+///     decimal64::CharsBuffer buffer;
+///     ToChars(decimal64::Decimal<4>{"1.5"}, buffer) -> 1.5
+///
+/// @returns the written string, it points into the `buffer`
+/// @see ToString
+template <int Prec, typename RoundPolicy>
+std::string_view ToChars(Decimal<Prec, RoundPolicy> dec, CharsBuffer& buffer) {
+  const auto* end = fmt::format_to(buffer.data(), FMT_COMPILE("{}"), dec);
+  UASSERT(end <= buffer.data() + buffer.size());
+  return {buffer.data(), static_cast<std::size_t>(end - buffer.data())};
+}
+
 /// @brief Converts Decimal to a string
 ///
 /// Usage example:
@@ -1285,9 +1323,11 @@ Decimal<Prec, RoundPolicy>::FromStringPermissive(std::string_view input) {
 ///
 /// @see ToStringTrailingZeros
 /// @see ToStringFixed
+/// @see ToChars
 template <int Prec, typename RoundPolicy>
 std::string ToString(Decimal<Prec, RoundPolicy> dec) {
-  return fmt::to_string(dec);
+  CharsBuffer buffer;
+  return std::string{ToChars(dec, buffer)};
 }
 
 /// @brief Converts Decimal to a string
@@ -1376,7 +1416,8 @@ template <typename CharT, typename Traits, int Prec, typename RoundPolicy>
 std::basic_ostream<CharT, Traits>& operator<<(
     std::basic_ostream<CharT, Traits>& os,
     const Decimal<Prec, RoundPolicy>& d) {
-  os << ToString(d);
+  CharsBuffer buffer;
+  os << ToChars(d, buffer);
   return os;
 }
 
@@ -1385,7 +1426,8 @@ std::basic_ostream<CharT, Traits>& operator<<(
 template <int Prec, typename RoundPolicy>
 logging::LogHelper& operator<<(logging::LogHelper& lh,
                                const Decimal<Prec, RoundPolicy>& d) {
-  lh << ToString(d);
+  CharsBuffer buffer;
+  lh << ToChars(d, buffer);
   return lh;
 }
 
@@ -1421,7 +1463,8 @@ TargetType Serialize(const Decimal<Prec, RoundPolicy>& object,
 template <int Prec, typename RoundPolicy, typename StringBuilder>
 void WriteToStream(const Decimal<Prec, RoundPolicy>& object,
                    StringBuilder& sw) {
-  WriteToStream(ToString(object), sw);
+  CharsBuffer buffer;
+  WriteToStream(ToChars(object, buffer), sw);
 }
 
 }  // namespace decimal64
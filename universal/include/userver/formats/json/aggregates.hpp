@@ -0,0 +1,146 @@
+#pragma once
+
+/// @file userver/formats/json/aggregates.hpp
+/// @brief Generated JSON Parse, Serialize and WriteToStream for aggregates
+///
+/// @ingroup userver_formats_parse userver_formats_serialize
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include <boost/pfr/core.hpp>
+#include <boost/pfr/tuple_size.hpp>
+
+#include <userver/formats/common/meta.hpp>
+#include <userver/formats/common/type.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/parse/to.hpp>
+#include <userver/formats/serialize/to.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+// clang-format off
+
+/// @brief Describes the JSON names of the fields of an aggregate
+///
+/// To enable the generated functions for an aggregate, specialize the struct
+/// in the namespace formats::json with the names listed in the order of the
+/// aggregate fields:
+///
+/// @snippet formats/json/aggregates_test.cpp  Sample formats::json::AggregateFields usage
+///
+/// After that the aggregate has:
+/// - `Parse` from formats::json::Value and formats::json::LazyValue with
+///   `std::optional` fields treated as not required;
+/// - `Serialize` to formats::json::Value and `WriteToStream` to
+///   formats::json::StringBuilder, that skip `std::nullopt` fields;
+/// - formats::json::parser::AggregateParser for the SAX parsing without DOM.
+///
+/// @note Boost.PFR may only deduce the field names in C++20, so the names are
+/// listed explicitly.
+
+// clang-format on
+
+template <typename T>
+struct AggregateFields {};
+
+namespace impl {
+
+template <typename T>
+using AggregateFieldNames = decltype(AggregateFields<T>::kNames);
+
+template <typename T>
+constexpr bool IsJsonAggregate() {
+  if constexpr (meta::kIsDetected<AggregateFieldNames, T>) {
+    static_assert(std::is_aggregate_v<T>,
+                  "formats::json::AggregateFields may only describe "
+                  "aggregates");
+    static_assert(
+        std::size(AggregateFields<T>::kNames) == boost::pfr::tuple_size_v<T>,
+        "formats::json::AggregateFields must list the names of all the "
+        "fields of the aggregate");
+    return true;
+  } else {
+    return false;
+  }
+}
+
+template <typename T>
+inline constexpr bool kIsJsonAggregate = IsJsonAggregate<T>();
+
+template <typename T>
+constexpr std::string_view GetFieldName(std::size_t index) noexcept {
+  return AggregateFields<T>::kNames[index];
+}
+
+template <typename T, typename Value, std::size_t... Indices>
+T ParseAggregate(const Value& value, std::index_sequence<Indices...>) {
+  return T{value[GetFieldName<T>(Indices)]
+               .template As<boost::pfr::tuple_element_t<Indices, T>>()...};
+}
+
+template <typename Field, typename Func>
+void VisitIfPresent(const Field& field, Func&& func) {
+  if constexpr (meta::kIsOptional<Field>) {
+    if (field) func(*field);
+  } else {
+    func(field);
+  }
+}
+
+}  // namespace impl
+
+/// @brief Generated Parse for the aggregates described by
+/// formats::json::AggregateFields
+template <typename Value, typename T>
+std::enable_if_t<common::kIsFormatValue<Value> && impl::kIsJsonAggregate<T>,
+                 T>
+Parse(const Value& value, formats::parse::To<T>) {
+  value.CheckObject();
+  return impl::ParseAggregate<T>(
+      value, std::make_index_sequence<boost::pfr::tuple_size_v<T>>{});
+}
+
+/// @brief Generated Serialize for the aggregates described by
+/// formats::json::AggregateFields
+template <typename T>
+std::enable_if_t<impl::kIsJsonAggregate<T>, Value> Serialize(
+    const T& value, formats::serialize::To<Value>) {
+  ValueBuilder builder{common::Type::kObject};
+  boost::pfr::for_each_field(value, [&builder](const auto& field,
+                                               std::size_t index) {
+    impl::VisitIfPresent(field, [&](const auto& item) {
+      builder[std::string{impl::GetFieldName<T>(index)}] = item;
+    });
+  });
+  return builder.ExtractValue();
+}
+
+/// @brief Generated WriteToStream for the aggregates described by
+/// formats::json::AggregateFields
+template <typename T>
+std::enable_if_t<impl::kIsJsonAggregate<T>> WriteToStream(const T& value,
+                                                          StringBuilder& sw) {
+  const StringBuilder::ObjectGuard guard{sw};
+  boost::pfr::for_each_field(value, [&sw](const auto& field,
+                                          std::size_t index) {
+    impl::VisitIfPresent(field, [&](const auto& item) {
+      sw.Key(impl::GetFieldName<T>(index));
+      WriteToStream(item, sw);
+    });
+  });
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
@@ -28,6 +28,13 @@ class ParseException : public Exception {
   using Exception::Exception;
 };
 
+/// The document does not match the JSON schema,
+/// see formats::json::FromStringValidated
+class SchemaValidationException : public ParseException {
+ public:
+  using ParseException::ParseException;
+};
+
 class BadStreamException : public Exception {
  public:
   explicit BadStreamException(const std::istream& is);
@@ -0,0 +1,304 @@
+#pragma once
+
+/// @file userver/formats/json/lazy_value.hpp
+/// @brief @copybrief formats::json::LazyDocument
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <userver/formats/common/meta.hpp>
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/parse/to.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+namespace impl {
+
+enum class LazyTokenType : std::uint8_t {
+  kNull,
+  kFalse,
+  kTrue,
+  kNumber,
+  kString,
+  kEscapedString,
+  kArray,
+  kObject,
+};
+
+struct LazyToken final {
+  /// Offset of the first character of the value
+  std::uint32_t begin;
+  /// Offset past the last character of the value
+  std::uint32_t end;
+  /// Index of the token that follows the whole subtree of the value
+  std::uint32_t next;
+  /// Number of elements or members for containers
+  std::uint32_t size;
+  LazyTokenType type;
+};
+
+}  // namespace impl
+
+class LazyValue;
+
+/// @ingroup userver_universal userver_formats
+///
+/// @brief Validated structural index of a JSON document for on-demand access.
+///
+/// Unlike formats::json::FromString, the document is not converted into a DOM:
+/// the constructor validates the input and records the positions of all the
+/// values in a flat array, while strings and numbers are decoded only when
+/// they are read via formats::json::LazyValue. That makes reading a few
+/// fields of a big document much cheaper.
+///
+/// The document does not own the input, the input must outlive the document
+/// and all the values obtained from it. Moving the document does not
+/// invalidate the values.
+///
+/// ## Example usage:
+///
+/// @snippet formats/json/lazy_value_test.cpp  Sample formats::json::LazyValue usage
+class LazyDocument final {
+ public:
+  /// @throws formats::json::ParseException if `doc` is not a valid JSON
+  explicit LazyDocument(std::string_view doc);
+
+  LazyDocument(LazyDocument&&) noexcept = default;
+  LazyDocument& operator=(LazyDocument&&) noexcept = default;
+
+  /// @brief Returns the root value of the document
+  LazyValue GetRoot() const;
+
+  /// @brief Returns the indexed input
+  std::string_view GetRawJson() const noexcept { return doc_; }
+
+ private:
+  std::string_view doc_;
+  std::vector<impl::LazyToken> tokens_;
+};
+
+/// @ingroup userver_universal userver_formats
+///
+/// @brief Non-mutable view of a value of a formats::json::LazyDocument.
+///
+/// Mirrors the reading part of the formats::json::Value interface, so the
+/// generic `Parse(const Value&, formats::parse::To<T>)` functions work with it.
+/// Types that only have a `Parse` for formats::json::Value are parsed from a
+/// formats::json::Value built from the raw JSON of the subtree, see ToValue().
+class LazyValue final {
+ public:
+  class const_iterator;
+
+  using Exception = formats::json::Exception;
+  using ParseException = formats::json::ParseException;
+  using DefaultConstructed = Value::DefaultConstructed;
+
+  /// @brief Access member by key for read.
+  /// @throw TypeMismatchException if value is not a missing value, an object
+  /// or null.
+  LazyValue operator[](std::string_view key) const;
+
+  /// @brief Access array member by index for read.
+  /// @throw TypeMismatchException if value is not an array or null.
+  /// @throw OutOfBoundsException if index is greater or equal than size.
+  LazyValue operator[](std::size_t index) const;
+
+  /// @brief Returns an iterator to the beginning of the held array or object.
+  /// @throw TypeMismatchException if value is not an array, an object or null.
+  const_iterator begin() const;
+
+  /// @brief Returns an iterator to the end of the held array or object.
+  /// @throw TypeMismatchException if value is not an array, an object or null.
+  const_iterator end() const;
+
+  /// @brief Returns whether the array or object is empty.
+  /// @throw TypeMismatchException if value is not an array, an object or null.
+  bool IsEmpty() const;
+
+  /// @brief Returns array size or object members count.
+  /// @throw TypeMismatchException if value is not an array, an object or null.
+  std::size_t GetSize() const;
+
+  /// @brief Returns true if *this holds a value that was not found by key
+  bool IsMissing() const noexcept { return tokens_ == nullptr; }
+
+  bool IsNull() const noexcept;
+  bool IsBool() const noexcept;
+  bool IsInt() const noexcept;
+  bool IsInt64() const noexcept;
+  bool IsUInt64() const noexcept;
+  bool IsDouble() const noexcept;
+  bool IsString() const noexcept;
+  bool IsArray() const noexcept;
+  bool IsObject() const noexcept;
+
+  /// @brief Returns value of *this converted to the result type of
+  /// Parse(const LazyValue&, parse::To<T>) or, if there's no such function,
+  /// of Parse(const Value&, parse::To<T>). Throws if the value is missing.
+  template <typename T>
+  auto As() const;
+
+  /// @brief Returns value of *this converted to T or T(args) if
+  /// this->IsMissing() or this->IsNull().
+  template <typename T, typename First, typename... Rest>
+  auto As(First&& default_arg, Rest&&... more_default_args) const;
+
+  /// @brief Returns value of *this converted to T or T() if
+  /// this->IsMissing() or this->IsNull().
+  /// @note Use as `value.As<T>({})`
+  template <typename T>
+  auto As(DefaultConstructed) const;
+
+  /// @brief Returns true if *this holds a `key`.
+  /// @throw TypeMismatchException if `*this` is not a map or null.
+  bool HasMember(std::string_view key) const;
+
+  /// @brief Returns full path to this value.
+  /// @note Unlike formats::json::Value::GetPath(), the path is restored from
+  /// the document structure, which takes time proportional to the size of the
+  /// enclosing containers.
+  std::string GetPath() const;
+
+  /// @brief Returns the JSON text of the value as is in the document.
+  /// @throw MemberMissingException if `this->IsMissing()`.
+  std::string_view GetRawJson() const;
+
+  /// @brief Builds a formats::json::Value out of the subtree of the value.
+  /// @note The paths of the returned value start at its own root.
+  /// @throw MemberMissingException if `this->IsMissing()`.
+  Value ToValue() const;
+
+  /// @throw MemberMissingException if `this->IsMissing()`.
+  void CheckNotMissing() const;
+
+  /// @throw TypeMismatchException if `*this` is not an array or null.
+  void CheckArrayOrNull() const;
+
+  /// @throw TypeMismatchException if `*this` is not a map or null.
+  void CheckObjectOrNull() const;
+
+  /// @throw TypeMismatchException if `*this` is not a map.
+  void CheckObject() const;
+
+  /// @throw TypeMismatchException if `*this` is not a map, array or null.
+  void CheckObjectOrArrayOrNull() const;
+
+ private:
+  friend class LazyDocument;
+  friend class const_iterator;
+
+  LazyValue(std::string_view doc, const impl::LazyToken* tokens,
+            std::uint32_t token) noexcept;
+  explicit LazyValue(std::string missing_path) noexcept;
+
+  const impl::LazyToken& GetToken() const noexcept { return tokens_[token_]; }
+  int GetExtendedType() const;
+  std::optional<std::uint32_t> FindMember(std::string_view key) const;
+  std::string GetMemberName(std::uint32_t key_token) const;
+
+  friend bool Parse(const LazyValue& value, parse::To<bool>);
+  friend std::int64_t Parse(const LazyValue& value, parse::To<std::int64_t>);
+  friend std::uint64_t Parse(const LazyValue& value, parse::To<std::uint64_t>);
+  friend double Parse(const LazyValue& value, parse::To<double>);
+  friend std::string Parse(const LazyValue& value, parse::To<std::string>);
+
+  std::string_view doc_;
+  const impl::LazyToken* tokens_{nullptr};
+  std::uint32_t token_{0};
+  // Only set for missing values
+  std::string missing_path_;
+};
+
+/// @brief Forward iterator over the elements of an array or the members of
+/// an object of formats::json::LazyValue
+class LazyValue::const_iterator final {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using value_type = LazyValue;
+  using reference = LazyValue;
+  using pointer = void;
+
+  const_iterator() = default;
+
+  LazyValue operator*() const;
+
+  const_iterator& operator++();
+  const_iterator operator++(int);
+
+  bool operator==(const const_iterator& other) const noexcept {
+    return index_ == other.index_;
+  }
+  bool operator!=(const const_iterator& other) const noexcept {
+    return !(*this == other);
+  }
+
+  /// @brief Returns the key of the current member of an object
+  /// @throw TypeMismatchException if the iterated value is not an object
+  std::string GetName() const;
+
+  /// @brief Returns the index of the current element
+  std::size_t GetIndex() const noexcept { return index_; }
+
+ private:
+  friend class LazyValue;
+
+  const_iterator(const LazyValue& container, std::uint32_t token,
+                 std::size_t index) noexcept;
+
+  std::string_view doc_;
+  const impl::LazyToken* tokens_{nullptr};
+  std::uint32_t container_token_{0};
+  // Points to the element for arrays and to the key for objects
+  std::uint32_t token_{0};
+  std::size_t index_{0};
+};
+
+bool Parse(const LazyValue& value, parse::To<bool>);
+
+std::int64_t Parse(const LazyValue& value, parse::To<std::int64_t>);
+
+std::uint64_t Parse(const LazyValue& value, parse::To<std::uint64_t>);
+
+double Parse(const LazyValue& value, parse::To<double>);
+
+std::string Parse(const LazyValue& value, parse::To<std::string>);
+
+template <typename T>
+auto LazyValue::As() const {
+  if constexpr (common::impl::kHasParse<LazyValue, T>) {
+    return Parse(*this, parse::To<T>{});
+  } else {
+    CheckNotMissing();
+    return ToValue().As<T>();
+  }
+}
+
+template <typename T, typename First, typename... Rest>
+auto LazyValue::As(First&& default_arg, Rest&&... more_default_args) const {
+  if (IsMissing() || IsNull()) {
+    // intended raw ctor call, sometimes casts
+    // NOLINTNEXTLINE(google-readability-casting)
+    return decltype(As<T>())(std::forward<First>(default_arg),
+                             std::forward<Rest>(more_default_args)...);
+  }
+  return As<T>();
+}
+
+template <typename T>
+auto LazyValue::As(LazyValue::DefaultConstructed) const {
+  return (IsMissing() || IsNull()) ? decltype(As<T>())() : As<T>();
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
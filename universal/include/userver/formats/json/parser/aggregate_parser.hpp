@@ -0,0 +1,387 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+#include <boost/pfr/tuple_size.hpp>
+
+#include <userver/formats/json/aggregates.hpp>
+#include <userver/formats/json/parser/array_parser.hpp>
+#include <userver/formats/json/parser/bool_parser.hpp>
+#include <userver/formats/json/parser/int_parser.hpp>
+#include <userver/formats/json/parser/map_parser.hpp>
+#include <userver/formats/json/parser/number_parser.hpp>
+#include <userver/formats/json/parser/parser_json.hpp>
+#include <userver/formats/json/parser/string_parser.hpp>
+#include <userver/formats/json/parser/typed_parser.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::parser {
+
+template <typename T>
+class AggregateParser;
+
+namespace impl {
+
+template <typename T, typename = void>
+struct ParserFor;
+
+template <typename T>
+using ParserForType = typename ParserFor<T>::Type;
+
+/// Parser for optional values, null is parsed into std::nullopt
+template <typename ValueParser>
+class OptionalParser final
+    : public TypedParser<std::optional<typename ValueParser::ResultType>>,
+      public Subscriber<typename ValueParser::ResultType> {
+ public:
+  using Value = typename ValueParser::ResultType;
+
+  OptionalParser() { value_parser_.Subscribe(*this); }
+
+ protected:
+  void Null() override { this->SetResult(std::nullopt); }
+  void Bool(bool b) override { PushParser().Bool(b); }
+  void Int64(int64_t i) override { PushParser().Int64(i); }
+  void Uint64(uint64_t i) override { PushParser().Uint64(i); }
+  void Double(double d) override { PushParser().Double(d); }
+  void String(std::string_view sw) override { PushParser().String(sw); }
+  void StartObject() override { PushParser().StartObject(); }
+  void StartArray() override { PushParser().StartArray(); }
+
+  std::string Expected() const override { return "null"; }
+
+  std::string GetPathItem() const override { return {}; }
+
+ private:
+  BaseParser& PushParser() {
+    value_parser_.Reset();
+    this->parser_state_->PushParser(value_parser_.GetParser());
+    return value_parser_.GetParser();
+  }
+
+  void OnSend(Value&& value) override {
+    this->SetResult(std::optional<Value>{std::move(value)});
+  }
+
+  ValueParser value_parser_;
+};
+
+/// Proxy parser for arrays that owns the item parser
+template <typename Array>
+class OwningArrayParser final {
+ public:
+  using Item = typename Array::value_type;
+  using ResultType = Array;
+
+  void Reset() { array_parser_.Reset(); }
+
+  void Subscribe(Subscriber<Array>& subscriber) {
+    array_parser_.Subscribe(subscriber);
+  }
+
+  auto& GetParser() { return array_parser_.GetParser(); }
+
+ private:
+  ParserForType<Item> item_parser_;
+  ArrayParser<Item, ParserForType<Item>, Array> array_parser_{item_parser_};
+};
+
+/// Proxy parser for maps that owns the value parser
+template <typename Map>
+class OwningMapParser final {
+ public:
+  using Value = typename Map::mapped_type;
+  using ResultType = Map;
+
+  void Reset() { map_parser_.Reset(); }
+
+  void Subscribe(Subscriber<Map>& subscriber) {
+    map_parser_.Subscribe(subscriber);
+  }
+
+  auto& GetParser() { return map_parser_.GetParser(); }
+
+ private:
+  ParserForType<Value> value_parser_;
+  MapParser<Map, ParserForType<Value>> map_parser_{value_parser_};
+};
+
+/// Proxy parser for the types without SAX parsers, builds a
+/// formats::json::Value and parses it
+template <typename T>
+class ValueParseParser final : public Subscriber<formats::json::Value> {
+ public:
+  using ResultType = T;
+
+  ValueParseParser() { value_parser_.Subscribe(*this); }
+
+  void Reset() { value_parser_.Reset(); }
+
+  void Subscribe(Subscriber<T>& subscriber) { subscriber_ = &subscriber; }
+
+  auto& GetParser() { return value_parser_.GetParser(); }
+
+ private:
+  void OnSend(formats::json::Value&& value) override {
+    if (subscriber_) subscriber_->OnSend(value.As<T>());
+  }
+
+  JsonValueParser value_parser_;
+  Subscriber<T>* subscriber_{nullptr};
+};
+
+/// Skips the value of an unknown field
+class SkipParser final : public BaseParser {
+ public:
+  void Reset() { depth_ = 0; }
+
+ protected:
+  void Null() override { MaybePopSelf(); }
+  void Bool(bool) override { MaybePopSelf(); }
+  void Int64(int64_t) override { MaybePopSelf(); }
+  void Uint64(uint64_t) override { MaybePopSelf(); }
+  void Double(double) override { MaybePopSelf(); }
+  void String(std::string_view) override { MaybePopSelf(); }
+  void StartObject() override { ++depth_; }
+  void Key(std::string_view) override {}
+  void EndObject() override {
+    --depth_;
+    MaybePopSelf();
+  }
+  void StartArray() override { ++depth_; }
+  void EndArray() override {
+    --depth_;
+    MaybePopSelf();
+  }
+
+  std::string Expected() const override { return "value"; }
+
+  std::string GetPathItem() const override { return {}; }
+
+ private:
+  void MaybePopSelf() {
+    if (depth_ == 0) parser_state_->PopMe(*this);
+  }
+
+  std::size_t depth_{0};
+};
+
+template <typename T, typename>
+struct ParserFor {
+  using Type = ValueParseParser<T>;
+};
+
+template <>
+struct ParserFor<bool> {
+  using Type = BoolParser;
+};
+
+template <>
+struct ParserFor<std::int32_t> {
+  using Type = Int32Parser;
+};
+
+template <>
+struct ParserFor<std::int64_t> {
+  using Type = Int64Parser;
+};
+
+template <>
+struct ParserFor<double> {
+  using Type = DoubleParser;
+};
+
+template <>
+struct ParserFor<float> {
+  using Type = FloatParser;
+};
+
+template <>
+struct ParserFor<std::string> {
+  using Type = StringParser;
+};
+
+template <>
+struct ParserFor<formats::json::Value> {
+  using Type = JsonValueParser;
+};
+
+template <typename T>
+struct ParserFor<std::optional<T>> {
+  using Type = OptionalParser<ParserForType<T>>;
+};
+
+template <typename T>
+struct ParserFor<std::vector<T>> {
+  using Type = OwningArrayParser<std::vector<T>>;
+};
+
+template <typename T>
+struct ParserFor<std::map<std::string, T>> {
+  using Type = OwningMapParser<std::map<std::string, T>>;
+};
+
+template <typename T>
+struct ParserFor<std::unordered_map<std::string, T>> {
+  using Type = OwningMapParser<std::unordered_map<std::string, T>>;
+};
+
+template <typename T>
+struct ParserFor<T, std::enable_if_t<json::impl::kIsJsonAggregate<T>>> {
+  using Type = AggregateParser<T>;
+};
+
+template <typename T, typename Indices>
+struct AggregateFieldsParsers;
+
+template <typename T, std::size_t... Indices>
+struct AggregateFieldsParsers<T, std::index_sequence<Indices...>> {
+  using Parsers =
+      std::tuple<ParserForType<boost::pfr::tuple_element_t<Indices, T>>...>;
+  using Sinks =
+      std::tuple<SubscriberSink<boost::pfr::tuple_element_t<Indices, T>>...>;
+};
+
+}  // namespace impl
+
+// clang-format off
+
+/// @brief SAX parser for the aggregates described by
+/// formats::json::AggregateFields that fills the fields right from the
+/// tokens, without building a formats::json::Value.
+///
+/// Members with types that have no SAX parsers are parsed from
+/// formats::json::Value via `Parse`. Unknown fields are skipped, all the
+/// fields except `std::optional` ones are required.
+///
+/// ## Example usage:
+///
+/// @snippet formats/json/aggregates_test.cpp  Sample formats::json::parser::AggregateParser usage
+
+// clang-format on
+
+template <typename T>
+class AggregateParser final : public TypedParser<T> {
+  static_assert(json::impl::kIsJsonAggregate<T>,
+                "AggregateParser may only parse the aggregates described by "
+                "formats::json::AggregateFields");
+
+  static constexpr std::size_t kSize = boost::pfr::tuple_size_v<T>;
+  using Indices = std::make_index_sequence<kSize>;
+  using FieldsParsers = impl::AggregateFieldsParsers<T, Indices>;
+
+ public:
+  AggregateParser() : AggregateParser(Indices{}) {}
+
+  AggregateParser(const AggregateParser&) = delete;
+  AggregateParser& operator=(const AggregateParser&) = delete;
+
+  void Reset() override {
+    state_ = State::kStart;
+    result_ = T{};
+    is_set_.fill(false);
+  }
+
+ protected:
+  void StartObject() override {
+    if (state_ != State::kStart) this->Throw("object");
+    state_ = State::kInside;
+  }
+
+  void Key(std::string_view key) override {
+    if (state_ != State::kInside) {
+      this->Throw("field '" + std::string{key} + "'");
+    }
+
+    key_ = key;
+    for (std::size_t i = 0; i < kSize; ++i) {
+      if (json::impl::GetFieldName<T>(i) == key) {
+        is_set_[i] = true;
+        PushFieldParser(i, Indices{});
+        return;
+      }
+    }
+
+    skip_parser_.Reset();
+    this->parser_state_->PushParser(skip_parser_);
+  }
+
+  void EndObject() override {
+    if (state_ != State::kInside) this->Throw("'}'");
+    // Errors about missing fields are reported for the object itself
+    key_.clear();
+    CheckRequiredFields(Indices{});
+    this->SetResult(std::move(result_));
+  }
+
+  std::string Expected() const override {
+    return state_ == State::kStart ? "object" : "field";
+  }
+
+  std::string GetPathItem() const override { return key_; }
+
+ private:
+  template <std::size_t... I>
+  explicit AggregateParser(std::index_sequence<I...>)
+      : sinks_(boost::pfr::get<I>(result_)...) {}
+
+  template <std::size_t I>
+  void PushFieldParser() {
+    auto& parser = std::get<I>(parsers_);
+    parser.Reset();
+    parser.Subscribe(std::get<I>(sinks_));
+    this->parser_state_->PushParser(parser.GetParser());
+  }
+
+  template <std::size_t... I>
+  void PushFieldParser(std::size_t index, std::index_sequence<I...>) {
+    ((index == I ? PushFieldParser<I>() : void()), ...);
+  }
+
+  template <std::size_t... I>
+  void CheckRequiredFields(std::index_sequence<I...>) const {
+    (CheckRequiredField<I>(), ...);
+  }
+
+  template <std::size_t I>
+  void CheckRequiredField() const {
+    using Field = boost::pfr::tuple_element_t<I, T>;
+    if constexpr (!meta::kIsOptional<Field>) {
+      if (!is_set_[I]) {
+        throw InternalParseError(
+            "Missing required field '" +
+            std::string{json::impl::GetFieldName<T>(I)} + "'");
+      }
+    }
+  }
+
+  enum class State {
+    kStart,
+    kInside,
+  };
+
+  State state_{State::kStart};
+  std::string key_;
+  T result_{};
+  std::array<bool, kSize> is_set_{};
+  typename FieldsParsers::Parsers parsers_;
+  typename FieldsParsers::Sinks sinks_;
+  impl::SkipParser skip_parser_;
+};
+
+}  // namespace formats::json::parser
+
+USERVER_NAMESPACE_END
@@ -25,6 +25,15 @@ namespace formats::json {
 /// Parse JSON from string
 formats::json::Value FromString(std::string_view doc);
 
+/// @brief Parse JSON from string into a document that allocates all of its
+/// nodes from a single arena.
+///
+/// Parsing does not call malloc per node, and the nodes are released at once
+/// with the last formats::json::Value that refers to the document, without
+/// traversing it. Works best for short-living documents, like request bodies.
+/// formats::json::ValueBuilder copies the document on modification.
+formats::json::Value FromStringWithArena(std::string_view doc);
+
 /// Parse JSON from stream
 formats::json::Value FromStream(std::istream& is);
 
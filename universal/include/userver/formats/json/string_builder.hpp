@@ -3,6 +3,8 @@
 /// @file userver/formats/json/string_builder.hpp
 /// @brief @copybrief formats::json::StringBuilder
 
+#include <cstddef>
+#include <functional>
 #include <string>
 #include <string_view>
 
@@ -38,7 +40,20 @@ class StringBuilder final : public serialize::SaxStream {
   // Required by the WriteToStream fallback to Serialize
   using Value = formats::json::Value;
 
+  /// Receives the parts of a streamed JSON, see StringBuilder(ChunkConsumer,
+  /// std::size_t)
+  using ChunkConsumer = std::function<void(std::string&& chunk)>;
+
   StringBuilder();
+
+  /// @brief Constructs a builder that passes the JSON to `consumer` as it is
+  /// written, in chunks of at least `chunk_size` bytes, so that the whole
+  /// JSON is never kept in memory.
+  ///
+  /// GetString() returns only the part that was not passed yet. Flush() must
+  /// be called after the last write to pass the rest of the JSON.
+  /// @note A single WriteValue() or WriteRawString() is passed as a whole.
+  StringBuilder(ChunkConsumer consumer, std::size_t chunk_size);
   ~StringBuilder();
 
   /// Construct this guard on new object start and its destructor will end the
@@ -82,9 +97,14 @@ class StringBuilder final : public serialize::SaxStream {
 
   void WriteValue(const Value& value);
 
+  /// Passes the rest of the JSON to the consumer of a streaming builder
+  void Flush();
+
  private:
+  void FlushIfFull();
+
   struct Impl;
-  utils::FastPimpl<Impl, 112, 8> impl_;
+  utils::FastPimpl<Impl, 152, 8> impl_;
 };
 
 void WriteToStream(bool value, StringBuilder& sw);
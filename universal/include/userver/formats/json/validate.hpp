@@ -10,6 +10,8 @@ USERVER_NAMESPACE_BEGIN
 
 namespace formats::json {
 
+/// @brief JSON schema, that is compiled once and may be used to validate
+/// many documents, possibly from different threads.
 class Schema final {
  public:
   explicit Schema(const formats::json::Value& doc);
@@ -23,11 +25,27 @@ class Schema final {
 
   friend bool Validate(const formats::json::Value&,
                        const formats::json::Schema&);
+  friend formats::json::Value FromStringValidated(std::string_view,
+                                                  const formats::json::Schema&);
 };
 
+/// Checks that an already parsed document matches the schema
 bool Validate(const formats::json::Value& doc,
               const formats::json::Schema& schema);
 
+/// @brief Parses JSON from string and validates it against the schema in
+/// a single pass.
+///
+/// The document is checked by the schema validator while it is being parsed,
+/// without traversing the built DOM once more. Parsing stops at the first
+/// element that does not match the schema.
+///
+/// @throws formats::json::SchemaValidationException if the document does not
+/// match the schema
+/// @throws formats::json::ParseException if the document is not a valid JSON
+formats::json::Value FromStringValidated(std::string_view doc,
+                                         const formats::json::Schema& schema);
+
 }  // namespace formats::json
 
 USERVER_NAMESPACE_END
@@ -23,6 +23,15 @@ namespace logging {
 class LogHelper;
 }  // namespace logging
 
+namespace formats::json {
+class Value;
+}  // namespace formats::json
+
+namespace formats::msgpack {
+formats::json::Value FromString(std::string_view doc);
+std::string ToString(const formats::json::Value& doc);
+}  // namespace formats::msgpack
+
 namespace formats::json {
 namespace impl {
 class InlineObjectBuilder;
@@ -319,6 +328,7 @@ class Value final {
   friend std::string Parse(const Value& value, parse::To<std::string>);
 
   friend formats::json::Value FromString(std::string_view);
+  friend formats::json::Value FromStringWithArena(std::string_view);
   friend formats::json::Value FromStream(std::istream&);
   friend void Serialize(const formats::json::Value&, std::ostream&);
   friend std::string ToString(const formats::json::Value&);
@@ -329,6 +339,11 @@ class Value final {
   friend logging::LogHelper& operator<<(logging::LogHelper&, const Value&);
   friend bool Validate(const formats::json::Value&,
                        const formats::json::Schema&);
+  friend formats::json::Value FromStringValidated(std::string_view,
+                                                  const formats::json::Schema&);
+
+  friend formats::json::Value formats::msgpack::FromString(std::string_view);
+  friend std::string formats::msgpack::ToString(const formats::json::Value&);
 };
 
 template <typename T>
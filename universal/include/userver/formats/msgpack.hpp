@@ -0,0 +1,16 @@
+#pragma once
+
+/// @file userver/formats/msgpack.hpp
+/// @brief Include-all header for MessagePack support
+/// @ingroup userver_universal
+
+#include <userver/formats/msgpack/exception.hpp>
+#include <userver/formats/msgpack/serialize.hpp>
+#include <userver/formats/msgpack/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// MessagePack support
+namespace formats::msgpack {}
+
+USERVER_NAMESPACE_END
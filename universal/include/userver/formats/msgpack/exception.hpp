@@ -0,0 +1,24 @@
+#pragma once
+
+/// @file userver/formats/msgpack/exception.hpp
+/// @brief Exception classes for MessagePack module
+/// @ingroup userver_universal
+
+#include <userver/formats/json/exception.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::msgpack {
+
+/// Exceptions of the JSON module are thrown on values access, catching
+/// formats::json::Exception catches the MessagePack parse errors too
+using Exception = formats::json::Exception;
+
+class ParseException : public formats::json::ParseException {
+ public:
+  using formats::json::ParseException::ParseException;
+};
+
+}  // namespace formats::msgpack
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,27 @@
+#pragma once
+
+/// @file userver/formats/msgpack/serialize.hpp
+/// @brief Parsers and serializers to/from MessagePack binary strings
+
+#include <string>
+#include <string_view>
+
+#include <userver/formats/msgpack/value.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::msgpack {
+
+/// @brief Parse MessagePack from binary string
+/// @throw formats::msgpack::ParseException on malformed or truncated input,
+/// extension types, non-string map keys and duplicate keys
+formats::msgpack::Value FromString(std::string_view doc);
+
+/// @brief Serialize MessagePack to binary string, using the most compact
+/// encoding for every value. Doubles that are exactly representable as
+/// float32 are written as float32.
+std::string ToString(const formats::msgpack::Value& doc);
+
+}  // namespace formats::msgpack
+
+USERVER_NAMESPACE_END
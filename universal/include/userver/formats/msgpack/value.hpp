@@ -0,0 +1,29 @@
+#pragma once
+
+/// @file userver/formats/msgpack/value.hpp
+/// @brief MessagePack values representation
+
+#include <userver/formats/json/value.hpp>
+#include <userver/formats/json/value_builder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::msgpack {
+
+/// @brief Non-mutable MessagePack value representation.
+///
+/// MessagePack documents share the representation with JSON ones, so all the
+/// `Parse`, `Serialize` and `Convert` functions written for
+/// formats::json::Value work for MessagePack out of the box.
+///
+/// The only MessagePack values that have no JSON counterpart are the
+/// extension types and the maps with non-string keys; they are rejected by
+/// formats::msgpack::FromString. Binary strings are parsed as strings.
+using Value = formats::json::Value;
+
+/// Builder for MessagePack values, see formats::msgpack::Value
+using ValueBuilder = formats::json::ValueBuilder;
+
+}  // namespace formats::msgpack
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,38 @@
+#pragma once
+
+/// @file userver/hostinfo/blocking/cgroup_cpu.hpp
+/// @brief @copybrief hostinfo::blocking::ReadCgroupCpuStats
+/// @ingroup userver_universal
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace hostinfo::blocking {
+
+/// @brief CPU quota and throttling of a cgroup v2
+struct CgroupCpuStats {
+  /// CPU quota in cores, std::nullopt if the quota is not set
+  std::optional<double> quota;
+
+  /// Count of the periods in which the cgroup was throttled
+  std::uint64_t nr_throttled{0};
+};
+
+/// @brief Reads `cpu.max` and `cpu.stat` of the cgroup v2 at `cgroup_path`.
+///
+/// The default path is the cgroup of the container if the container runs in
+/// its own cgroup namespace.
+///
+/// @returns std::nullopt if there is no cgroup v2 with the CPU controller at
+/// the path
+/// @throws std::runtime_error if the files have unexpected contents
+/// @warning This is a blocking function.
+std::optional<CgroupCpuStats> ReadCgroupCpuStats(
+    const std::string& cgroup_path = "/sys/fs/cgroup");
+
+}  // namespace hostinfo::blocking
+
+USERVER_NAMESPACE_END
@@ -1,12 +1,14 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <string>
 #include <string_view>
 
 #include <fmt/core.h>
 
 #include <userver/utils/small_string_fwd.hpp>
-#include <userver/utils/trivial_map.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -85,50 +87,93 @@ struct UnsafeConstexprHasher final {
   std::uint64_t seed_{54999};
 };
 
-// Ugly, but TrivialBiMap requires keys to be in lower case.
-inline constexpr utils::TrivialBiMap kKnownHeadersLowercaseMap =
-    [](auto selector) {
-      return selector()
-          .Case("content-type", std::int8_t{1})
-          .Case("content-encoding", 2)
-          .Case("content-length", 3)
-          .Case("transfer-encoding", 4)
-          .Case("host", 5)
-          .Case("accept", 6)
-          .Case("accept-encoding", 7)
-          .Case("accept-language", 8)
-          .Case("x-yataxi-api-key", 9)
-          .Case("user-agent", 10)
-          .Case("x-request-application", 11)
-          .Case("date", 12)
-          .Case("warning", 13)
-          .Case("access-control-allow-headers", 14)
-          .Case("allow", 15)
-          .Case("server", 16)
-          .Case("set-cookie", 17)
-          .Case("connection", 18)
-          .Case("cookie", 19)
-          .Case("x-yarequestid", 20)
-          .Case("x-yatraceid", 21)
-          .Case("x-yaspanid", 22)
-          .Case("x-requestid", 23)
-          .Case("x-backend-server", 24)
-          .Case("x-taxi-envoyproxy-dstvhost", 25)
-          .Case("baggage", 26)
-          .Case("x-yataxi-allow-auth-request", 27)
-          .Case("x-yataxi-allow-auth-response", 28)
-          .Case("x-yataxi-server-hostname", 29)
-          .Case("x-yataxi-client-timeoutms", 30)
-          .Case("x-yataxi-deadline-expired", 31)
-          .Case("x-yataxi-ratelimited-by", 32)
-          .Case("x-yataxi-ratelimit-reason", 33)
-          .Case("x-b3-traceid", 34)
-          .Case("x-b3-spanid", 35)
-          .Case("x-b3-sampled", 36)
-          .Case("x-b3-parentspanid", 37)
-          .Case("traceparent", 38)
-          .Case("tracestate", 39);
-    };
+// The headers that get an index in HeaderMap, in lower case. The index of a
+// header is its position in this array plus one.
+inline constexpr std::string_view kKnownHeadersLowercase[] = {
+    "content-type",
+    "content-encoding",
+    "content-length",
+    "transfer-encoding",
+    "host",
+    "accept",
+    "accept-encoding",
+    "accept-language",
+    "x-yataxi-api-key",
+    "user-agent",
+    "x-request-application",
+    "date",
+    "warning",
+    "access-control-allow-headers",
+    "allow",
+    "server",
+    "set-cookie",
+    "connection",
+    "cookie",
+    "x-yarequestid",
+    "x-yatraceid",
+    "x-yaspanid",
+    "x-requestid",
+    "x-backend-server",
+    "x-taxi-envoyproxy-dstvhost",
+    "baggage",
+    "x-yataxi-allow-auth-request",
+    "x-yataxi-allow-auth-response",
+    "x-yataxi-server-hostname",
+    "x-yataxi-client-timeoutms",
+    "x-yataxi-deadline-expired",
+    "x-yataxi-ratelimited-by",
+    "x-yataxi-ratelimit-reason",
+    "x-b3-traceid",
+    "x-b3-spanid",
+    "x-b3-sampled",
+    "x-b3-parentspanid",
+    "traceparent",
+    "tracestate",
+    "content-language",
+    "content-location",
+    "content-disposition",
+    "content-range",
+    "trailer",
+    "cache-control",
+    "expect",
+    "max-forwards",
+    "pragma",
+    "range",
+    "te",
+    "if-match",
+    "if-none-match",
+    "if-modified-since",
+    "if-unmodified-since",
+    "if-range",
+    "accept-charset",
+    "authorization",
+    "proxy-authorization",
+    "x-yataxi-external-service",
+    "from",
+    "referer",
+    "x-taxi",
+    "x-requested-uri",
+    "age",
+    "expires",
+    "location",
+    "retry-after",
+    "vary",
+    "etag",
+    "last-modified",
+    "www-authenticate",
+    "proxy-authenticate",
+    "accept-ranges",
+    "sec-websocket-key",
+    "sec-websocket-accept",
+    "sec-websocket-version",
+    "upgrade",
+    "x-yandex-uid",
+    "x-remote-ip",
+    "sec-websocket-extensions",
+};
+inline constexpr std::size_t kKnownHeadersCount =
+    std::size(kKnownHeadersLowercase);
+static_assert(kKnownHeadersCount <= 127, "The header indexes must fit int8");
 
 // We use different values for "no index" at compile and run time to simplify
 // comparison - with these values being different we cant just == them.
@@ -137,18 +182,92 @@ inline constexpr std::int8_t kNoHeaderIndexInsertion = -2;
 static_assert(kNoHeaderIndexLookup != kNoHeaderIndexInsertion);
 static_assert(kNoHeaderIndexLookup != 0 && kNoHeaderIndexInsertion != 0);
 
+constexpr bool IsEqualToLowercase(std::string_view lowercase,
+                                  std::string_view str) noexcept {
+  if (lowercase.size() != str.size()) return false;
+  for (std::size_t i = 0; i < str.size(); ++i) {
+    const char c = str[i];
+    const char lower = (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+    if (lower != lowercase[i]) return false;
+  }
+  return true;
+}
+
+// Compile-time perfect hash of the known headers: a multiplier is chosen at
+// compile time so that the UnsafeConstexprHasher hashes of the known headers
+// map to distinct slots. The hasher is case-insensitive for letters, so a
+// lookup is a single slot access and a single case-insensitive comparison.
+class KnownHeadersTable final {
+ public:
+  constexpr KnownHeadersTable() {
+    std::size_t hashes[kKnownHeadersCount]{};
+    for (std::size_t i = 0; i < kKnownHeadersCount; ++i) {
+      hashes[i] = UnsafeConstexprHasher{}(kKnownHeadersLowercase[i]);
+    }
+
+    for (std::uint64_t multiplier = kInitialMultiplier;;
+         multiplier += kMultiplierStep) {
+      multiplier_ = multiplier;
+      if (TryFill(hashes)) return;
+    }
+  }
+
+  constexpr std::int8_t Find(std::string_view key,
+                             std::size_t hash) const noexcept {
+    const auto index = slots_[GetSlot(hash)];
+    if (index == 0 || !IsEqualToLowercase(kKnownHeadersLowercase[index - 1],
+                                          key)) {
+      return 0;
+    }
+    return index;
+  }
+
+ private:
+  static constexpr std::size_t kSlotsBits = 10;
+  static constexpr std::size_t kSlotsCount = 1 << kSlotsBits;
+  static constexpr std::uint64_t kInitialMultiplier = 0x9e3779b97f4a7c15ULL;
+  static constexpr std::uint64_t kMultiplierStep = 0x2ULL << 32;
+
+  constexpr std::size_t GetSlot(std::size_t hash) const noexcept {
+    return (static_cast<std::uint64_t>(hash) * multiplier_) >>
+           (64 - kSlotsBits);
+  }
+
+  constexpr bool TryFill(const std::size_t (&hashes)[kKnownHeadersCount]) {
+    for (auto& slot : slots_) slot = 0;
+    for (std::size_t i = 0; i < kKnownHeadersCount; ++i) {
+      auto& slot = slots_[GetSlot(hashes[i])];
+      if (slot != 0) return false;
+      slot = static_cast<std::int8_t>(i + 1);
+    }
+    return true;
+  }
+
+  std::uint64_t multiplier_{0};
+  std::int8_t slots_[kSlotsCount]{};
+};
+
+inline constexpr KnownHeadersTable kKnownHeadersTable{};
+
 // We use this function when constructing a PredefinedHeader ...
-constexpr std::int8_t GetHeaderIndexForLookup(std::string_view key) {
-  const auto opt = kKnownHeadersLowercaseMap.TryFindICaseByFirst(key);
-  return opt.value_or(kNoHeaderIndexLookup);
+constexpr std::int8_t GetHeaderIndexForLookup(std::string_view key,
+                                              std::size_t hash) {
+  const auto index = kKnownHeadersTable.Find(key, hash);
+  return index != 0 ? index : kNoHeaderIndexLookup;
 }
 
 // And this one when inserting an entry into the HeaderMap.
 // The purpose of having 2 different functions is to be able to
 // == header indexes even if none is present (both headers are unknown).
+// `hash` must be the UnsafeConstexprHasher hash of the `key`.
+inline std::int8_t GetHeaderIndexForInsertion(std::string_view key,
+                                              std::size_t hash) {
+  const auto index = kKnownHeadersTable.Find(key, hash);
+  return index != 0 ? index : kNoHeaderIndexInsertion;
+}
+
 inline std::int8_t GetHeaderIndexForInsertion(std::string_view key) {
-  const auto opt = kKnownHeadersLowercaseMap.TryFindICaseByFirst(key);
-  return opt.value_or(kNoHeaderIndexInsertion);
+  return GetHeaderIndexForInsertion(key, UnsafeConstexprHasher{}(key));
 }
 
 }  // namespace impl
@@ -173,7 +292,7 @@ class PredefinedHeader final {
   explicit constexpr PredefinedHeader(std::string_view name)
       : name{name},
         hash{impl::UnsafeConstexprHasher{}(name)},
-        header_index{impl::GetHeaderIndexForLookup(name)} {}
+        header_index{impl::GetHeaderIndexForLookup(name, hash)} {}
 
   constexpr operator std::string_view() const { return name; }
 
@@ -10,7 +10,14 @@ USERVER_NAMESPACE_BEGIN
 namespace logging {
 
 /// Log formats
-enum class Format { kTskv, kLtsv, kRaw };
+enum class Format {
+  kTskv,
+  kLtsv,
+  kRaw,
+  /// Compact length-prefixed binary records without any escaping, see
+  /// `scripts/binary_logs.py` for the description and the decoder
+  kBinary,
+};
 
 /// Parse Format enum from string
 Format FormatFromString(std::string_view format_str);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 
 #include <userver/logging/format.hpp>
 #include <userver/logging/level.hpp>
@@ -30,6 +31,10 @@ class LoggerBase {
 
   virtual void PrependCommonTags(TagWriter writer) const;
 
+  /// @brief Returns the key of the current request for log sampling, records
+  /// with equal keys are sampled together. 0 means that there is no key.
+  virtual std::uint64_t GetSamplingKey() const noexcept;
+
   Format GetFormat() const noexcept;
 
   virtual void SetLevel(Level level);
@@ -0,0 +1,198 @@
+#pragma once
+
+/// @file userver/utils/arena.hpp
+/// @brief @copybrief utils::Arena
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define USERVER_IMPL_HAS_MEMORY_RESOURCE
+#endif
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// Statistics of a utils::Arena
+struct ArenaStatistics final {
+  /// Bytes requested by the allocations since the last reset
+  std::size_t allocated_bytes{0};
+
+  /// Number of the allocations since the last reset
+  std::size_t allocations{0};
+
+  /// Bytes of the chunks currently held by the arena
+  std::size_t reserved_bytes{0};
+
+  /// Maximum of `reserved_bytes` over the lifetime of the arena
+  std::size_t peak_reserved_bytes{0};
+
+  /// Number of the chunks allocated from the heap over the lifetime of the
+  /// arena
+  std::size_t chunk_allocations{0};
+
+  /// Number of the Arena::Reset calls
+  std::size_t resets{0};
+};
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief Monotonic arena allocator: allocates the memory from large chunks by
+/// bumping a pointer and frees all of it at once.
+///
+/// Deallocation of a single allocation is a no-op, the memory is returned by
+/// Reset() and by the destructor. That suits the short living objects that
+/// are allocated in bursts, e.g. during the handling of a request. The chunks
+/// grow geometrically up to kMaxChunkSize, the allocations larger than a half
+/// of a chunk get a chunk of their own.
+///
+/// The arena does not allocate until the first Allocate(), so an unused arena
+/// costs nothing. It is not thread-safe.
+///
+/// Use utils::ArenaAllocator with the standard containers or
+/// utils::ArenaMemoryResource with the `std::pmr` ones. See also
+/// utils::CurrentArenaScope to bind an arena to the current task.
+///
+/// @snippet utils/arena_test.cpp  Sample utils::Arena usage
+class Arena final {
+ public:
+  static constexpr std::size_t kDefaultInitialChunkSize = 4096;
+  static constexpr std::size_t kMaxChunkSize = 1024 * 1024;
+
+  explicit Arena(
+      std::size_t initial_chunk_size = kDefaultInitialChunkSize) noexcept;
+
+  Arena(Arena&&) = delete;
+  Arena& operator=(Arena&&) = delete;
+
+  ~Arena();
+
+  /// @brief Allocates `size` bytes aligned to `alignment`, which must be a
+  /// power of 2. The pointers are unique for the non-zero sizes only.
+  /// @throws std::bad_alloc
+  void* Allocate(std::size_t size,
+                 std::size_t alignment = alignof(std::max_align_t)) {
+    UASSERT_MSG(alignment != 0 && (alignment & (alignment - 1)) == 0,
+                "alignment must be a power of 2");
+    const std::uintptr_t available = end_ - current_;
+    const std::uintptr_t padding = (0 - current_) & (alignment - 1);
+    if (padding > available || size > available - padding) {
+      return AllocateSlow(size, alignment);
+    }
+
+    current_ += padding;
+    auto* result = reinterpret_cast<void*>(current_);
+    current_ += size;
+    statistics_.allocated_bytes += size;
+    ++statistics_.allocations;
+    return result;
+  }
+
+  /// @brief Allocates the uninitialized storage for `count` objects of type T
+  /// @throws std::bad_alloc
+  template <typename T>
+  T* Allocate(std::size_t count = 1) {
+    if (count > static_cast<std::size_t>(-1) / sizeof(T)) {
+      throw std::bad_alloc();
+    }
+    return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+  }
+
+  /// @brief Frees all the allocations at once. Keeps the last chunk, so the
+  /// next allocations do not go to the heap.
+  void Reset() noexcept;
+
+  /// Returns the statistics of the arena
+  const ArenaStatistics& GetStatistics() const noexcept { return statistics_; }
+
+ private:
+  struct Chunk;
+
+  void* AllocateSlow(std::size_t size, std::size_t alignment);
+  Chunk* NewChunk(std::size_t size);
+  void DeleteChunk(Chunk* chunk) noexcept;
+  void UseChunk(Chunk& chunk) noexcept;
+
+  std::uintptr_t current_{0};
+  std::uintptr_t end_{0};
+  // The current chunk, the previous ones are linked from it
+  Chunk* chunks_{nullptr};
+  std::size_t next_chunk_size_;
+  ArenaStatistics statistics_;
+};
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief Allocator of the standard containers that allocates from a
+/// utils::Arena. The arena should outlive the container.
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(Arena& arena) noexcept : arena_(&arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+      : arena_(&other.GetArena()) {}
+
+  T* allocate(std::size_t count) { return arena_->Allocate<T>(count); }
+
+  void deallocate(T*, std::size_t) noexcept {}
+
+  Arena& GetArena() const noexcept { return *arena_; }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return arena_ == &other.GetArena();
+  }
+
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  Arena* arena_;
+};
+
+#ifdef USERVER_IMPL_HAS_MEMORY_RESOURCE
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief `std::pmr::memory_resource` that allocates from a utils::Arena.
+/// The arena should outlive the resource and the containers that use it.
+class ArenaMemoryResource final : public std::pmr::memory_resource {
+ public:
+  explicit ArenaMemoryResource(Arena& arena) noexcept : arena_(arena) {}
+
+  Arena& GetArena() const noexcept { return arena_; }
+
+ private:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+    // The pointers should be unique
+    return arena_.Allocate(bytes == 0 ? 1 : bytes, alignment);
+  }
+
+  void do_deallocate(void*, std::size_t, std::size_t) override {}
+
+  bool do_is_equal(
+      const std::pmr::memory_resource& other) const noexcept override {
+    const auto* resource = dynamic_cast<const ArenaMemoryResource*>(&other);
+    return resource && &resource->arena_ == &arena_;
+  }
+
+  Arena& arena_;
+};
+
+#endif
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,227 @@
+#pragma once
+
+/// @file userver/utils/blocked_bloom_filter.hpp
+/// @brief @copybrief utils::BlockedBloomFilter
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace impl {
+
+// Split block Bloom filter of Putze et al., with the block layout of Apache
+// Parquet: a block is 8 words of 32 bits, an element sets a bit in each word.
+struct alignas(32) BloomBlock final {
+  static constexpr std::size_t kWords = 8;
+  static constexpr std::size_t kBits = kWords * 32;
+
+  std::uint32_t words[kWords];
+};
+
+inline constexpr std::uint32_t kBloomSalts[BloomBlock::kWords] = {
+    0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+    0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+
+#ifdef __AVX2__
+inline __m256i MakeBloomMask(std::uint32_t key) noexcept {
+  const auto salts =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(kBloomSalts));
+  const auto shifts = _mm256_srli_epi32(
+      _mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(key)), salts), 27);
+  return _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+}
+#endif
+
+inline void BloomBlockInsert(BloomBlock& block, std::uint32_t key) noexcept {
+#ifdef __AVX2__
+  auto* words = reinterpret_cast<__m256i*>(block.words);
+  _mm256_store_si256(words, _mm256_or_si256(_mm256_load_si256(words),
+                                            MakeBloomMask(key)));
+#else
+  for (std::size_t i = 0; i < BloomBlock::kWords; ++i) {
+    block.words[i] |= std::uint32_t{1} << ((key * kBloomSalts[i]) >> 27);
+  }
+#endif
+}
+
+inline bool BloomBlockContains(const BloomBlock& block,
+                               std::uint32_t key) noexcept {
+#ifdef __AVX2__
+  const auto words =
+      _mm256_load_si256(reinterpret_cast<const __m256i*>(block.words));
+  return _mm256_testc_si256(words, MakeBloomMask(key)) != 0;
+#else
+  // No early exit, the loop is vectorized by the compiler
+  std::uint32_t missing = 0;
+  for (std::size_t i = 0; i < BloomBlock::kWords; ++i) {
+    missing |=
+        ~block.words[i] & (std::uint32_t{1} << ((key * kBloomSalts[i]) >> 27));
+  }
+  return missing == 0;
+#endif
+}
+
+// Number of the blocks for `expected_size` elements and the false positive
+// rate of at most `false_positive_rate`
+std::size_t GetBloomBlockCount(std::size_t expected_size,
+                               double false_positive_rate);
+
+// False positive rate of a filter with `elements_per_block` on average
+double GetBloomFalsePositiveRate(double elements_per_block);
+
+std::size_t CountBloomBits(const BloomBlock* blocks,
+                           std::size_t block_count) noexcept;
+
+}  // namespace impl
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief Bloom filter that checks and sets all the bits of an element in a
+/// single 32-byte block, so that a lookup touches a single cache line.
+///
+/// False positives are possible, false negatives are not. The filter is sized
+/// for the expected number of elements and the target false positive rate,
+/// it takes about 10 bits per element for 1% and 16 bits for 0.1%. The
+/// elements can not be erased, use utils::CuckooFilter for that.
+///
+/// A probe of a block is a few vector instructions with AVX2, and a loop that
+/// the compiler vectorizes otherwise.
+///
+/// Unlike utils::FilterBloom, the filter does not count the elements, but is
+/// several times faster and smaller for the same false positive rate.
+///
+/// The filter is not thread-safe. See userver/dump/probabilistic_filters.hpp
+/// to store it in the cache dumps.
+///
+/// @warning Use a hash that does not change between the restarts, e.g. the
+/// default utils::hash::Hash, if the filter is stored in the dumps.
+///
+/// ## Example usage:
+///
+/// @snippet utils/blocked_bloom_filter_test.cpp  Sample utils::BlockedBloomFilter
+template <typename T, typename Hash = utils::hash::Hash<T>>
+class BlockedBloomFilter final {
+ public:
+  /// @brief Makes a filter for `expected_size` elements with the false
+  /// positive rate of at most `false_positive_rate` when it is filled
+  ///
+  /// `false_positive_rate` should be in (0, 1)
+  explicit BlockedBloomFilter(std::size_t expected_size,
+                              double false_positive_rate = 0.01,
+                              Hash hash = Hash{})
+      : BlockedBloomFilter(
+            impl::GetBloomBlockCount(expected_size, false_positive_rate),
+            std::move(hash), BlockCountTag{}) {}
+
+  BlockedBloomFilter(BlockedBloomFilter&&) noexcept = default;
+  BlockedBloomFilter& operator=(BlockedBloomFilter&&) noexcept = default;
+
+  /// Adds the element to the filter
+  void Insert(const T& item) {
+    const auto hash = static_cast<std::uint64_t>(hash_(item));
+    impl::BloomBlockInsert(GetBlock(hash), static_cast<std::uint32_t>(hash));
+    ++size_;
+  }
+
+  /// @brief Checks whether the element may have been added to the filter
+  /// @returns false if the element has surely not been added
+  bool MayContain(const T& item) const {
+    const auto hash = static_cast<std::uint64_t>(hash_(item));
+    return impl::BloomBlockContains(GetBlock(hash),
+                                    static_cast<std::uint32_t>(hash));
+  }
+
+  /// Removes all the elements
+  void Clear() noexcept {
+    std::memset(static_cast<void*>(blocks_.data()), 0,
+                blocks_.size() * sizeof(impl::BloomBlock));
+    size_ = 0;
+  }
+
+  /// Returns the number of the Insert() calls since the last Clear()
+  std::size_t GetSize() const noexcept { return size_; }
+
+  /// Returns the size of the filter in bytes
+  std::size_t GetSizeInBytes() const noexcept {
+    return blocks_.size() * sizeof(impl::BloomBlock);
+  }
+
+  /// Returns the fraction of the bits that are set
+  double GetFillRatio() const noexcept {
+    return static_cast<double>(
+               impl::CountBloomBits(blocks_.data(), blocks_.size())) /
+           static_cast<double>(blocks_.size() * impl::BloomBlock::kBits);
+  }
+
+  /// Estimates the current false positive rate by the number of elements
+  double EstimateFalsePositiveRate() const {
+    return impl::GetBloomFalsePositiveRate(static_cast<double>(size_) /
+                                           static_cast<double>(blocks_.size()));
+  }
+
+  /// @brief Returns the bits of the filter, e.g. to store them
+  std::string_view GetRawData() const noexcept {
+    return {reinterpret_cast<const char*>(blocks_.data()), GetSizeInBytes()};
+  }
+
+  /// @brief Restores the filter from GetRawData() and GetSize() of a filter
+  /// with the same hash
+  /// @throws std::invalid_argument if the data size is not a positive
+  /// multiple of the block size
+  static BlockedBloomFilter FromRawData(std::string_view data, std::size_t size,
+                                        Hash hash = Hash{}) {
+    if (data.empty() || data.size() % sizeof(impl::BloomBlock) != 0) {
+      throw std::invalid_argument("Invalid size of the bloom filter data");
+    }
+    BlockedBloomFilter filter{data.size() / sizeof(impl::BloomBlock),
+                              std::move(hash), BlockCountTag{}};
+    std::memcpy(static_cast<void*>(filter.blocks_.data()), data.data(),
+                data.size());
+    filter.size_ = size;
+    return filter;
+  }
+
+ private:
+  struct BlockCountTag final {};
+
+  BlockedBloomFilter(std::size_t block_count, Hash&& hash, BlockCountTag)
+      : blocks_(block_count), hash_(std::move(hash)) {
+    UASSERT(block_count > 0);
+  }
+
+  // The upper bits of the hash choose a block, the lower ones choose the bits
+  std::size_t GetBlockIndex(std::uint64_t hash) const noexcept {
+    return static_cast<std::size_t>(((hash >> 32) * blocks_.size()) >> 32);
+  }
+
+  impl::BloomBlock& GetBlock(std::uint64_t hash) noexcept {
+    return blocks_[GetBlockIndex(hash)];
+  }
+
+  const impl::BloomBlock& GetBlock(std::uint64_t hash) const noexcept {
+    return blocks_[GetBlockIndex(hash)];
+  }
+
+  utils::FixedArray<impl::BloomBlock> blocks_;
+  std::size_t size_{0};
+  Hash hash_;
+};
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
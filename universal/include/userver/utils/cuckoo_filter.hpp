@@ -0,0 +1,268 @@
+#pragma once
+
+/// @file userver/utils/cuckoo_filter.hpp
+/// @brief @copybrief utils::CuckooFilter
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace impl {
+
+// A bucket of 4 fingerprints of 16 bits, 0 is an empty slot
+using CuckooBucket = std::uint64_t;
+
+inline constexpr std::size_t kCuckooSlots = 4;
+inline constexpr std::uint64_t kCuckooLowBits = 0x0001000100010001ull;
+inline constexpr std::uint64_t kCuckooHighBits = 0x8000800080008000ull;
+
+// Bitmask of the high bits of the slots that hold the `fingerprint`
+inline std::uint64_t CuckooMatch(CuckooBucket bucket,
+                                 std::uint16_t fingerprint) noexcept {
+  const auto diff = bucket ^ (kCuckooLowBits * fingerprint);
+  // The high bits of the slots with zero `diff`, may have false positives in
+  // the slots above a matching one, that do not matter for the checks
+  return (diff - kCuckooLowBits) & ~diff & kCuckooHighBits;
+}
+
+inline std::uint16_t GetCuckooSlot(CuckooBucket bucket,
+                                   std::size_t slot) noexcept {
+  return static_cast<std::uint16_t>(bucket >> (slot * 16));
+}
+
+inline CuckooBucket SetCuckooSlot(CuckooBucket bucket, std::size_t slot,
+                                  std::uint16_t fingerprint) noexcept {
+  const auto shift = slot * 16;
+  return (bucket & ~(std::uint64_t{0xffff} << shift)) |
+         (std::uint64_t{fingerprint} << shift);
+}
+
+// Number of the buckets, a power of 2, for `capacity` elements
+std::size_t GetCuckooBucketCount(std::size_t capacity);
+
+}  // namespace impl
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief Cuckoo filter: a probabilistic set that, unlike the Bloom filters,
+/// supports the erasure of elements.
+///
+/// An element is stored as a 16-bit fingerprint in one of its two buckets of
+/// 4 slots, so a lookup reads two 8-byte buckets and compares all the slots
+/// of a bucket at once. The false positive rate is about 0.012%, the filter
+/// takes about 17 bits per element when filled up to 95%, and Insert() fails
+/// when the filter is too full.
+///
+/// Erase() should be called only for the elements that have been inserted,
+/// or it may erase another element with the same fingerprint and cause a
+/// false negative. The same element may be inserted several times, it then
+/// takes several slots and should be erased the same number of times.
+///
+/// The filter is not thread-safe. See userver/dump/probabilistic_filters.hpp
+/// to store it in the cache dumps.
+///
+/// @warning Use a hash that does not change between the restarts, e.g. the
+/// default utils::hash::Hash, if the filter is stored in the dumps.
+///
+/// ## Example usage:
+///
+/// @snippet utils/cuckoo_filter_test.cpp  Sample utils::CuckooFilter
+template <typename T, typename Hash = utils::hash::Hash<T>>
+class CuckooFilter final {
+ public:
+  /// Makes a filter for up to about `capacity` elements
+  explicit CuckooFilter(std::size_t capacity, Hash hash = Hash{})
+      : CuckooFilter(impl::GetCuckooBucketCount(capacity), std::move(hash),
+                     BucketCountTag{}) {}
+
+  CuckooFilter(CuckooFilter&&) noexcept = default;
+  CuckooFilter& operator=(CuckooFilter&&) noexcept = default;
+
+  /// @brief Adds the element to the filter
+  /// @returns false if the filter is too full, the filter is not changed then
+  bool Insert(const T& item) {
+    const auto [index, fingerprint] = Locate(item);
+    if (TryInsert(index, fingerprint) ||
+        TryInsert(GetAltIndex(index, fingerprint), fingerprint)) {
+      ++size_;
+      return true;
+    }
+    if (!Relocate(index, fingerprint)) return false;
+    ++size_;
+    return true;
+  }
+
+  /// @brief Checks whether the element may be in the filter
+  /// @returns false if the element is surely not in the filter
+  bool MayContain(const T& item) const {
+    const auto [index, fingerprint] = Locate(item);
+    return (impl::CuckooMatch(buckets_[index], fingerprint) |
+            impl::CuckooMatch(buckets_[GetAltIndex(index, fingerprint)],
+                              fingerprint)) != 0;
+  }
+
+  /// @brief Erases an inserted element from the filter
+  /// @returns false if the element is not in the filter
+  bool Erase(const T& item) {
+    const auto [index, fingerprint] = Locate(item);
+    if (TryErase(index, fingerprint) ||
+        TryErase(GetAltIndex(index, fingerprint), fingerprint)) {
+      --size_;
+      return true;
+    }
+    return false;
+  }
+
+  /// Removes all the elements
+  void Clear() noexcept {
+    for (auto& bucket : buckets_) bucket = 0;
+    size_ = 0;
+  }
+
+  /// Returns the number of the elements in the filter
+  std::size_t GetSize() const noexcept { return size_; }
+
+  /// Returns the size of the filter in bytes
+  std::size_t GetSizeInBytes() const noexcept {
+    return buckets_.size() * sizeof(impl::CuckooBucket);
+  }
+
+  /// Returns the fraction of the occupied slots
+  double GetFillRatio() const noexcept {
+    return static_cast<double>(size_) /
+           static_cast<double>(buckets_.size() * impl::kCuckooSlots);
+  }
+
+  /// @brief Returns the fingerprints of the filter, e.g. to store them
+  std::string_view GetRawData() const noexcept {
+    return {reinterpret_cast<const char*>(buckets_.data()), GetSizeInBytes()};
+  }
+
+  /// @brief Restores the filter from GetRawData() of a filter with the same
+  /// hash
+  /// @throws std::invalid_argument if the data size is not a power of 2
+  /// multiple of the bucket size
+  static CuckooFilter FromRawData(std::string_view data, Hash hash = Hash{}) {
+    const auto bucket_count = data.size() / sizeof(impl::CuckooBucket);
+    if (bucket_count == 0 ||
+        data.size() % sizeof(impl::CuckooBucket) != 0 ||
+        (bucket_count & (bucket_count - 1)) != 0) {
+      throw std::invalid_argument("Invalid size of the cuckoo filter data");
+    }
+    CuckooFilter filter{bucket_count, std::move(hash), BucketCountTag{}};
+    std::memcpy(static_cast<void*>(filter.buckets_.data()), data.data(),
+                data.size());
+    for (const auto bucket : filter.buckets_) {
+      for (std::size_t slot = 0; slot < impl::kCuckooSlots; ++slot) {
+        if (impl::GetCuckooSlot(bucket, slot) != 0) ++filter.size_;
+      }
+    }
+    return filter;
+  }
+
+ private:
+  struct BucketCountTag final {};
+
+  // Maximum number of the elements moved to insert an element
+  static constexpr std::size_t kMaxKicks = 500;
+
+  struct Location final {
+    std::size_t index;
+    std::uint16_t fingerprint;
+  };
+
+  CuckooFilter(std::size_t bucket_count, Hash&& hash, BucketCountTag)
+      : buckets_(bucket_count, impl::CuckooBucket{0}),
+        mask_(bucket_count - 1),
+        hash_(std::move(hash)) {
+    UASSERT(bucket_count > 0 && (bucket_count & mask_) == 0);
+  }
+
+  Location Locate(const T& item) const {
+    const auto hash = static_cast<std::uint64_t>(hash_(item));
+    // The upper bits for the fingerprint, the lower ones for the bucket
+    auto fingerprint = static_cast<std::uint16_t>(hash >> 48);
+    if (fingerprint == 0) fingerprint = 1;
+    return {static_cast<std::size_t>(hash) & mask_, fingerprint};
+  }
+
+  // The alternative bucket of the alternative bucket is the original one,
+  // they differ if there are several buckets
+  std::size_t GetAltIndex(std::size_t index,
+                          std::uint16_t fingerprint) const noexcept {
+    return (index ^ (static_cast<std::size_t>(
+                         utils::hash::HashInteger(fingerprint)) |
+                     1)) &
+           mask_;
+  }
+
+  bool TryInsert(std::size_t index, std::uint16_t fingerprint) noexcept {
+    auto& bucket = buckets_[index];
+    const auto empty = impl::CuckooMatch(bucket, 0);
+    if (empty == 0) return false;
+    // The lowest match is always exact
+    const auto slot = static_cast<std::size_t>(__builtin_ctzll(empty)) / 16;
+    bucket = impl::SetCuckooSlot(bucket, slot, fingerprint);
+    return true;
+  }
+
+  bool TryErase(std::size_t index, std::uint16_t fingerprint) noexcept {
+    auto& bucket = buckets_[index];
+    const auto match = impl::CuckooMatch(bucket, fingerprint);
+    if (match == 0) return false;
+    const auto slot = static_cast<std::size_t>(__builtin_ctzll(match)) / 16;
+    bucket = impl::SetCuckooSlot(bucket, slot, 0);
+    return true;
+  }
+
+  std::uint16_t Swap(std::size_t index, std::size_t slot,
+                     std::uint16_t fingerprint) noexcept {
+    auto& bucket = buckets_[index];
+    const auto previous = impl::GetCuckooSlot(bucket, slot);
+    bucket = impl::SetCuckooSlot(bucket, slot, fingerprint);
+    return previous;
+  }
+
+  // Kicks the fingerprints to their alternative buckets to free a slot,
+  // rolls the kicks back on failure
+  bool Relocate(std::size_t index, std::uint16_t fingerprint) {
+    std::size_t indices[kMaxKicks];
+    std::size_t slots[kMaxKicks];
+    for (std::size_t kick = 0; kick < kMaxKicks; ++kick) {
+      const auto slot = static_cast<std::size_t>(utils::hash::HashInteger(
+                            index, kick_seed_++)) %
+                        impl::kCuckooSlots;
+      indices[kick] = index;
+      slots[kick] = slot;
+      fingerprint = Swap(index, slot, fingerprint);
+      index = GetAltIndex(index, fingerprint);
+      if (TryInsert(index, fingerprint)) return true;
+    }
+
+    for (auto kick = kMaxKicks; kick-- > 0;) {
+      fingerprint = Swap(indices[kick], slots[kick], fingerprint);
+    }
+    return false;
+  }
+
+  utils::FixedArray<impl::CuckooBucket> buckets_;
+  std::size_t mask_;
+  std::size_t size_{0};
+  std::uint64_t kick_seed_{0};
+  Hash hash_;
+};
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,46 @@
+#pragma once
+
+/// @file userver/utils/datetime/coarse_clock_ticker.hpp
+/// @brief @copybrief utils::datetime::CoarseClockTicker
+
+#include <chrono>
+#include <memory>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::datetime {
+
+/// @ingroup userver_universal
+///
+/// @brief Runs a thread that caches the time of
+/// utils::datetime::SteadyCoarseClock and utils::datetime::WallCoarseClock
+/// every `interval`, so that their now() becomes a single load instead of a
+/// clock_gettime call.
+///
+/// While the ticker is running, the coarse clocks may lag behind the
+/// clock_gettime ones by an additional `interval` and by the scheduling delays
+/// of the ticker thread, they stay monotonic. When the ticker is destroyed,
+/// the clocks fall back to clock_gettime.
+///
+/// Only one ticker may exist at a time, components::Manager starts one unless
+/// disabled in the static config.
+class CoarseClockTicker final {
+ public:
+  static constexpr std::chrono::microseconds kDefaultInterval{1000};
+
+  explicit CoarseClockTicker(
+      std::chrono::microseconds interval = kDefaultInterval);
+
+  CoarseClockTicker(CoarseClockTicker&&) = delete;
+  CoarseClockTicker& operator=(CoarseClockTicker&&) = delete;
+
+  ~CoarseClockTicker();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+}  // namespace utils::datetime
+
+USERVER_NAMESPACE_END
@@ -18,6 +18,8 @@
 #include <tmmintrin.h>
 #elif defined(__SSE2__)
 #include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
 #endif
 
 #include <userver/utils/assert.hpp>
@@ -289,12 +291,55 @@ struct EncoderAvx2 final {
 };
 #endif
 
+#if defined(__ARM_NEON) && defined(__aarch64__)
+struct EncoderNeon final {
+  using Block = uint8x16_t;
+  static constexpr std::size_t kBlockSize = sizeof(Block);
+
+  // Sanitizers are disabled within the function, because the SIMD loads
+  // may intentionally wander to uninitialized memory. The loads never touch
+  // memory outside "our" cache lines, though.
+  USERVER_IMPL_DISABLE_ASAN inline static Block LoadBlock(
+      const char* block) noexcept {
+    block = AssumeAligned<kBlockSize>(block);
+    return vld1q_u8(reinterpret_cast<const std::uint8_t*>(block));
+  }
+
+  USERVER_IMPL_FORCE_INLINE static void CopyBlock(Block block,
+                                                  std::size_t offset,
+                                                  char* destination) noexcept {
+    alignas(kBlockSize * 2) std::uint8_t storage[kBlockSize * 2]{};
+    vst1q_u8(storage, block);
+    vst1q_u8(reinterpret_cast<std::uint8_t*>(destination),
+             vld1q_u8(&storage[offset]));
+  }
+
+  USERVER_IMPL_FORCE_INLINE static bool MayNeedValueEscaping(
+      Block block, std::size_t offset, std::size_t count) noexcept {
+    // 'char c' may need TSKV value escaping iff c <= '\r' || c == '\\'
+    const auto may_need_escaping = vorrq_u8(vcleq_u8(block, vdupq_n_u8('\r')),
+                                            vceqq_u8(block, vdupq_n_u8('\\')));
+    // NEON has no movemask, 4 bits of the mask per block's char instead
+    const auto mask = vget_lane_u64(
+        vreinterpret_u64_u8(
+            vshrn_n_u16(vreinterpretq_u16_u8(may_need_escaping), 4)),
+        0);
+    const auto count_mask =
+        count == kBlockSize ? ~std::uint64_t{0}
+                            : (std::uint64_t{1} << (count * 4)) - 1;
+    return ((mask >> (offset * 4)) & count_mask) != 0;
+  }
+};
+#endif
+
 #if defined(__AVX2__)
 using SystemEncoder = EncoderAvx2;
 #elif defined(__SSSE3__)
 using SystemEncoder = EncoderSsse3;
 #elif defined(__SSE2__)
 using SystemEncoder = EncoderSse2;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+using SystemEncoder = EncoderNeon;
 #else
 using SystemEncoder = EncoderStd;
 #endif
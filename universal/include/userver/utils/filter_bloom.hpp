@@ -26,6 +26,8 @@ namespace utils {
 /// smaller than a given threshold when a sequence of elements is given.
 /// As a generalized form of Bloom filter,
 /// false positive matches are possible, but false negatives are not.
+/// Use utils::BlockedBloomFilter or utils::CuckooFilter if the counts are not
+/// needed, they are faster and smaller.
 /// @param T the type of element that counts
 /// @param Counter the type of counter
 /// @param Hash1 the first callable hash struct
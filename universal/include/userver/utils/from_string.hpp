@@ -9,6 +9,7 @@
 #include <charconv>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <string>
 #include <string_view>
@@ -28,6 +29,111 @@ namespace impl {
                                            std::string_view input,
                                            std::type_index resultType);
 
+// Fast path for the valid numbers, the errors and the formats that
+// std::from_chars does not accept (hex, leading plus) are handled by
+// std::strtod and friends.
+template <typename T>
+bool TryFromCharsFloating(std::string_view str, T& result) noexcept {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+    const char* const end = str.data() + str.size();
+    const auto [ptr, error_code] = std::from_chars(str.data(), end, result);
+    return error_code == std::errc{} && ptr == end;
+  }
+#endif
+  static_cast<void>(str);
+  static_cast<void>(result);
+  return false;
+}
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+inline constexpr bool kSwarDigits = true;
+#else
+inline constexpr bool kSwarDigits = false;
+#endif
+
+inline std::uint64_t LoadEightChars(const char* str) noexcept {
+  std::uint64_t chunk{};
+  std::memcpy(&chunk, str, sizeof(chunk));
+  return chunk;
+}
+
+// SWAR check that all the 8 bytes are in '0'..'9'
+constexpr bool AreEightDigits(std::uint64_t chunk) noexcept {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+         0x3333333333333333;
+}
+
+// SWAR conversion of 8 digits, the first one is in the lowest byte
+constexpr std::uint32_t ParseEightDigits(std::uint64_t chunk) noexcept {
+  constexpr std::uint64_t kMask = 0x000000FF000000FF;
+  constexpr std::uint64_t kMul1 = 100 + (1000000ULL << 32);
+  constexpr std::uint64_t kMul2 = 1 + (10000ULL << 32);
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  return static_cast<std::uint32_t>(
+      (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >> 32);
+}
+
+// Parses a string of at most 19 decimal digits, that fits into uint64_t
+// without overflow. Returns false if there are other characters.
+inline bool TryParseDigits(std::string_view digits,
+                           std::uint64_t& result) noexcept {
+  constexpr std::size_t kMaxDigits =
+      std::numeric_limits<std::uint64_t>::digits10;
+  if (digits.empty() || digits.size() > kMaxDigits) return false;
+
+  std::uint64_t value = 0;
+  const char* it = digits.data();
+  const char* const end = it + digits.size();
+  if constexpr (kSwarDigits) {
+    for (; end - it >= 8; it += 8) {
+      const auto chunk = LoadEightChars(it);
+      if (!AreEightDigits(chunk)) return false;
+      value = value * 100000000 + ParseEightDigits(chunk);
+    }
+  }
+  for (; it != end; ++it) {
+    const auto digit = static_cast<unsigned char>(*it - '0');
+    if (digit > 9) return false;
+    value = value * 10 + digit;
+  }
+
+  result = value;
+  return true;
+}
+
+// Fast path for long valid integers, everything else is handled by
+// std::from_chars
+template <typename T>
+bool TryParseInteger(std::string_view str, T& result) noexcept {
+  const bool is_negative = !str.empty() && str[0] == '-';
+  if (!str.empty() && (str[0] == '-' || str[0] == '+')) str.remove_prefix(1);
+
+  std::uint64_t magnitude = 0;
+  if (!TryParseDigits(str, magnitude)) return false;
+
+  if constexpr (std::is_unsigned_v<T>) {
+    if (is_negative) {
+      if (magnitude != 0) return false;
+    } else if (magnitude > std::numeric_limits<T>::max()) {
+      return false;
+    }
+    result = static_cast<T>(magnitude);
+  } else {
+    using UnsignedT = std::make_unsigned_t<T>;
+    const auto max_magnitude =
+        static_cast<std::uint64_t>(std::numeric_limits<T>::max()) +
+        (is_negative ? 1 : 0);
+    if (magnitude > max_magnitude) return false;
+    const auto unsigned_value = static_cast<UnsignedT>(magnitude);
+    result = static_cast<T>(is_negative ? UnsignedT{0} - unsigned_value
+                                        : unsigned_value);
+  }
+  return true;
+}
+
 template <typename T>
 std::enable_if_t<std::is_floating_point_v<T>, T> FromString(const char* str) {
   static_assert(!std::is_const_v<T> && !std::is_volatile_v<T>);
@@ -44,6 +150,10 @@ std::enable_if_t<std::is_floating_point_v<T>, T> FromString(const char* str) {
                                    typeid(T));
   }
 
+  if (T result{}; TryFromCharsFloating(std::string_view{str}, result)) {
+    return result;
+  }
+
   errno = 0;
   char* end = nullptr;
 
@@ -89,6 +199,10 @@ std::enable_if_t<std::is_floating_point_v<T>, T> FromString(
     std::string_view str) {
   static constexpr std::size_t kSmallBufferSize = 32;
 
+  if (T result{}; TryFromCharsFloating(str, result)) {
+    return result;
+  }
+
   if (str.size() >= kSmallBufferSize) {
     return FromString<T>(std::string{str});
   }
@@ -113,6 +227,13 @@ std::enable_if_t<meta::kIsInteger<T>, T> FromString(std::string_view str) {
                                    typeid(T));
   }
 
+  // The sign is checked after the leading spaces, '+-' is rejected as a
+  // non-digit character
+  if (T result{}; str.size() > 1 && str[1] != '+' && str[1] != '-' &&
+                  TryParseInteger(str, result)) {
+    return result;
+  }
+
   std::size_t offset = 0;
 
   // to allow leading plus
@@ -0,0 +1,205 @@
+#pragma once
+
+/// @file userver/utils/hash.hpp
+/// @brief Fast non-cryptographic hashing: utils::hash::Hash and
+/// utils::hash::SeededHash
+/// @ingroup userver_universal
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+USERVER_NAMESPACE_BEGIN
+
+/// Fast non-cryptographic hashing
+namespace utils::hash {
+
+namespace impl {
+
+// wyhash by Wang Yi, https://github.com/wangyi-fudan/wyhash (public domain)
+
+inline constexpr std::uint64_t kSecret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull,
+    0x4d5a2da51de1aa47ull};
+
+inline void Multiply(std::uint64_t& a, std::uint64_t& b) noexcept {
+#ifdef __SIZEOF_INT128__
+  const auto r = static_cast<unsigned __int128>(a) * b;
+  a = static_cast<std::uint64_t>(r);
+  b = static_cast<std::uint64_t>(r >> 64);
+#else
+  const std::uint64_t ha = a >> 32, hb = b >> 32;
+  const std::uint64_t la = static_cast<std::uint32_t>(a);
+  const std::uint64_t lb = static_cast<std::uint32_t>(b);
+  const std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  const std::uint64_t t = rl + (rm0 << 32);
+  std::uint64_t carry = t < rl;
+  const std::uint64_t lo = t + (rm1 << 32);
+  carry += lo < t;
+  a = lo;
+  b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+#endif
+}
+
+inline std::uint64_t Mix(std::uint64_t a, std::uint64_t b) noexcept {
+  Multiply(a, b);
+  return a ^ b;
+}
+
+inline std::uint64_t Read8(const unsigned char* p) noexcept {
+  std::uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline std::uint64_t Read4(const unsigned char* p) noexcept {
+  std::uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline std::uint64_t Read3(const unsigned char* p, std::size_t k) noexcept {
+  return (std::uint64_t{p[0]} << 16) | (std::uint64_t{p[k >> 1]} << 8) |
+         p[k - 1];
+}
+
+std::uint64_t HashLongBytes(const unsigned char* p, std::size_t size,
+                            std::uint64_t seed) noexcept;
+
+std::uint64_t GetRandomSeed() noexcept;
+
+std::uint64_t SeededHashBytes(std::string_view data) noexcept;
+
+template <typename T>
+inline constexpr bool kIsStringLike =
+    std::is_convertible_v<const T&, std::string_view> && !std::is_pointer_v<T>;
+
+}  // namespace impl
+
+/// @brief Hashes the bytes, much faster than std::hash for the strings of
+/// libstdc++.
+///
+/// The hash values are not stable across userver versions, do not store them.
+inline std::uint64_t HashBytes(std::string_view data,
+                               std::uint64_t seed = 0) noexcept {
+  const auto* p = reinterpret_cast<const unsigned char*>(data.data());
+  const auto size = data.size();
+  seed ^= impl::Mix(seed ^ impl::kSecret[0], impl::kSecret[1]);
+
+  std::uint64_t a = 0;
+  std::uint64_t b = 0;
+  if (size <= 16) {
+    if (size >= 4) {
+      a = (impl::Read4(p) << 32) | impl::Read4(p + ((size >> 3) << 2));
+      b = (impl::Read4(p + size - 4) << 32) |
+          impl::Read4(p + size - 4 - ((size >> 3) << 2));
+    } else if (size > 0) {
+      a = impl::Read3(p, size);
+    }
+  } else {
+    return impl::HashLongBytes(p, size, seed);
+  }
+
+  a ^= impl::kSecret[1];
+  b ^= seed;
+  impl::Multiply(a, b);
+  return impl::Mix(a ^ impl::kSecret[0] ^ size, b ^ impl::kSecret[1]);
+}
+
+/// @brief Mixes the bits of the integer, so that all the bits of the result
+/// depend on all the bits of the `value`.
+///
+/// Unlike std::hash, that returns the integers as is, the hash values are
+/// good for the power-of-two sized tables.
+constexpr std::uint64_t HashInteger(std::uint64_t value,
+                                    std::uint64_t seed = 0) noexcept {
+  // splitmix64 finalizer
+  value ^= seed;
+  value += 0x9e3779b97f4a7c15ull;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+  return value ^ (value >> 31);
+}
+
+/// @ingroup userver_universal
+///
+/// @brief Default hash of the userver containers.
+///
+/// - strings and the types implicitly convertible to `std::string_view`, e.g.
+///   utils::SmallString, are hashed with utils::hash::HashBytes;
+/// - integers and enums are hashed with utils::hash::HashInteger;
+/// - utils::StrongTypedef is hashed as its underlying type;
+/// - the rest of the types are hashed with std::hash.
+///
+/// Specialize utils::hash::Hash to customize the hashing of your type.
+///
+/// @warning Do not use it for the keys that may be chosen by an attacker, see
+/// utils::hash::SeededHash.
+template <typename T>
+struct Hash {
+  std::size_t operator()(const T& value) const
+      noexcept(impl::kIsStringLike<T> || std::is_integral_v<T> ||
+               std::is_enum_v<T> ||
+               std::is_nothrow_invocable_v<const std::hash<T>&, const T&>) {
+    if constexpr (impl::kIsStringLike<T>) {
+      return HashBytes(value);
+    } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+      return HashInteger(static_cast<std::uint64_t>(value));
+    } else {
+      return std::hash<T>{}(value);
+    }
+  }
+};
+
+/// Allows the lookups by `std::string_view` in the transparent containers
+template <>
+struct Hash<std::string> {
+  using is_transparent [[maybe_unused]] = void;
+
+  std::size_t operator()(std::string_view value) const noexcept {
+    return HashBytes(value);
+  }
+};
+
+/// @ingroup userver_universal
+///
+/// @brief Hash for the keys that may be chosen by an attacker, e.g. come
+/// from the requests.
+///
+/// The strings are hashed with SipHash-1-3 with a random per-process key, so
+/// that the collisions could not be precomputed. The hashing is slower than
+/// the one of utils::hash::Hash but is still faster than std::hash for the
+/// long strings. The rest of the types are hashed as with
+/// utils::hash::Hash, with the integers mixed with a random seed.
+template <typename T>
+struct SeededHash {
+  std::size_t operator()(const T& value) const
+      noexcept(noexcept(Hash<T>{}(value))) {
+    if constexpr (impl::kIsStringLike<T>) {
+      return impl::SeededHashBytes(value);
+    } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+      return HashInteger(static_cast<std::uint64_t>(value),
+                         impl::GetRandomSeed());
+    } else {
+      return Hash<T>{}(value);
+    }
+  }
+};
+
+/// Allows the lookups by `std::string_view` in the transparent containers
+template <>
+struct SeededHash<std::string> {
+  using is_transparent [[maybe_unused]] = void;
+
+  std::size_t operator()(std::string_view value) const noexcept {
+    return impl::SeededHashBytes(value);
+  }
+};
+
+}  // namespace utils::hash
+
+USERVER_NAMESPACE_END
@@ -14,6 +14,7 @@
 #include <boost/functional/hash_fwd.hpp>
 
 #include <userver/formats/common/meta.hpp>
+#include <userver/utils/hash.hpp>
 #include <userver/utils/meta.hpp>
 #include <userver/utils/underlying_value.hpp>
 #include <userver/utils/void_t.hpp>
@@ -409,6 +410,15 @@ std::size_t hash_value(const StrongTypedef<Tag, T, Ops>& v) {
   return boost::hash<T>{}(v.GetUnderlying());
 }
 
+// utils::hash::Hash support
+template <class Tag, class T, StrongTypedefOps Ops>
+struct hash::Hash<StrongTypedef<Tag, T, Ops>> {
+  std::size_t operator()(const StrongTypedef<Tag, T, Ops>& v) const
+      noexcept(noexcept(hash::Hash<T>{}(std::declval<const T&>()))) {
+    return hash::Hash<T>{}(v.GetUnderlying());
+  }
+};
+
 /// A StrongTypedef for data that MUST NOT be logged or outputted in some other
 /// way. Also prevents the data from appearing in backtrace prints of debugger.
 ///
@@ -4,12 +4,14 @@
 /// @brief Bidirectional map|sets over string literals or other trivial types.
 
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -458,6 +460,117 @@ class CaseSecondDescriber final {
   std::string description_{};
 };
 
+// Number of Case's since which the runtime lookups by string use StringIndex
+// instead of the chain of comparisons. Compilers turn the chain into a switch
+// by the string size and a tree of the integral comparisons, that is hard to
+// beat for the exact lookups in the maps up to a few dozens of strings.
+inline constexpr std::size_t kStringIndexMinCases = 64;
+inline constexpr std::size_t kStringIndexMinCasesICase = 16;
+
+constexpr bool IsConstantEvaluated() noexcept {
+  return __builtin_is_constant_evaluated();
+}
+
+// Open addressing hash index of the strings, that hashes the ASCII lowercased
+// head, middle and tail words of a string with a few SWAR operations, so that
+// the same index serves both the exact and the case insensitive lookups.
+// The index is faster than the chain of comparisons if there are many strings
+// of the same size.
+class StringIndex final {
+ public:
+  explicit StringIndex(std::vector<std::string_view> strings);
+
+  // Returns the index of the first string equal to `value` or kInvalidSize
+  std::size_t Find(std::string_view value) const noexcept;
+
+  // Same as Find, but compares the ASCII letters of `value` case
+  // insensitively with the lower case strings
+  std::size_t FindICase(std::string_view value) const noexcept;
+
+ private:
+  struct Slot final {
+    std::uint32_t tag{0};
+    // index of the string + 1, 0 for an empty slot
+    std::uint32_t index{0};
+  };
+
+  template <typename Equal>
+  std::size_t DoFind(std::string_view value, Equal equal) const noexcept;
+
+  std::vector<std::string_view> strings_;
+  std::vector<Slot> slots_;
+  std::size_t mask_{0};
+  int shift_{0};
+};
+
+template <typename Value>
+class StringSearchIndex final {
+ public:
+  StringSearchIndex(std::vector<std::string_view> keys,
+                    std::vector<Value> values)
+      : index_(std::move(keys)), values_(std::move(values)) {}
+
+  std::optional<Value> Find(std::string_view key) const noexcept {
+    return Get(index_.Find(key));
+  }
+
+  std::optional<Value> FindICase(std::string_view key) const noexcept {
+    return Get(index_.FindICase(key));
+  }
+
+ private:
+  std::optional<Value> Get(std::size_t index) const noexcept {
+    if (index == kInvalidSize) return std::nullopt;
+    return values_[index];
+  }
+
+  StringIndex index_;
+  std::vector<Value> values_;
+};
+
+// Collects the string keys of the Case's, the first ones or the second ones
+template <typename Value, bool kBySecond>
+class StringCaseCollector final {
+ public:
+  template <typename First, typename Second>
+  StringCaseCollector& Case(First first, Second second) {
+    if constexpr (kBySecond) {
+      Add(second, first);
+    } else {
+      Add(first, second);
+    }
+    return *this;
+  }
+
+  template <typename First>
+  StringCaseCollector& Case(First first) {
+    Add(first, Found{0});
+    return *this;
+  }
+
+  [[nodiscard]] StringSearchIndex<Value> Extract() && {
+    return StringSearchIndex<Value>{std::move(keys_), std::move(values_)};
+  }
+
+ private:
+  void Add(std::string_view key, Value value) {
+    keys_.push_back(key);
+    values_.push_back(value);
+  }
+
+  std::vector<std::string_view> keys_;
+  std::vector<Value> values_;
+};
+
+// The index is built on the first lookup, the Case's of a BuilderFunc are the
+// same for all of its instances
+template <typename Value, bool kBySecond, typename BuilderFunc>
+const StringSearchIndex<Value>& GetStringSearchIndex(const BuilderFunc& func) {
+  static const auto index =
+      func([] { return StringCaseCollector<Value, kBySecond>{}; }).Extract();
+  return index;
+}
+
 }  // namespace impl
 
 /// @ingroup userver_universal userver_containers
@@ -480,6 +593,12 @@ class CaseSecondDescriber final {
 /// The same story with integral or enum mappings - compiler optimizes them
 /// into a switch and it usually takes O(1) to find the match.
 ///
+/// The runtime lookups by string in the maps and sets with many Case's, and
+/// the case insensitive lookups in the maps and sets with more than a dozen of
+/// Case's, are done in a hash index, that is built once on the first lookup.
+/// So the large mappings of strings, e.g. of the generated enums, are also
+/// O(1) to search.
+///
 /// @snippet universal/src/utils/trivial_map_test.cpp  sample bidir bimap
 ///
 /// For a single value Case statements see @ref utils::TrivialSet.
@@ -498,7 +617,9 @@ class TrivialBiMap final {
   using MappedTypeFor =
       std::conditional_t<std::is_convertible_v<T, First>, Second, First>;
 
-  constexpr TrivialBiMap(BuilderFunc&& func) noexcept : func_(std::move(func)) {
+  constexpr TrivialBiMap(BuilderFunc&& func) noexcept
+      : func_(std::move(func)),
+        size_(func_([]() { return impl::CaseCounter{}; }).Extract()) {
     static_assert(std::is_empty_v<BuilderFunc>,
                   "Mapping function should not capture variables");
     static_assert(std::is_trivially_copyable_v<First>,
@@ -511,12 +632,22 @@ class TrivialBiMap final {
   }
 
   constexpr std::optional<Second> TryFindByFirst(First value) const noexcept {
+    if constexpr (std::is_same_v<First, std::string_view>) {
+      if (UseStringIndex(impl::kStringIndexMinCases)) {
+        return impl::GetStringSearchIndex<Second, false>(func_).Find(value);
+      }
+    }
     return func_(
                [value]() { return impl::SwitchByFirst<First, Second>{value}; })
         .Extract();
   }
 
   constexpr std::optional<First> TryFindBySecond(Second value) const noexcept {
+    if constexpr (std::is_same_v<Second, std::string_view>) {
+      if (UseStringIndex(impl::kStringIndexMinCases)) {
+        return impl::GetStringSearchIndex<First, true>(func_).Find(value);
+      }
+    }
     return func_(
                [value]() { return impl::SwitchBySecond<First, Second>{value}; })
         .Extract();
@@ -541,6 +672,9 @@ class TrivialBiMap final {
   /// string literal.
   constexpr std::optional<Second> TryFindICaseByFirst(
       std::string_view value) const noexcept {
+    if (UseStringIndex(impl::kStringIndexMinCasesICase)) {
+      return impl::GetStringSearchIndex<Second, false>(func_).FindICase(value);
+    }
     return func_([value]() { return impl::SwitchByFirstICase<Second>{value}; })
         .Extract();
   }
@@ -551,6 +685,9 @@ class TrivialBiMap final {
   /// string literal.
   constexpr std::optional<First> TryFindICaseBySecond(
       std::string_view value) const noexcept {
+    if (UseStringIndex(impl::kStringIndexMinCasesICase)) {
+      return impl::GetStringSearchIndex<First, true>(func_).FindICase(value);
+    }
     return func_([value]() { return impl::SwitchBySecondICase<First>{value}; })
         .Extract();
   }
@@ -572,9 +709,7 @@ class TrivialBiMap final {
   }
 
   /// Returns count of Case's in mapping
-  constexpr std::size_t size() const noexcept {
-    return func_([]() { return impl::CaseCounter{}; }).Extract();
-  }
+  constexpr std::size_t size() const noexcept { return size_; }
 
   /// Returns a string of comma separated quoted values of Case parameters.
   ///
@@ -621,7 +756,12 @@ class TrivialBiMap final {
   }
 
  private:
+  constexpr bool UseStringIndex(std::size_t min_cases) const noexcept {
+    return !impl::IsConstantEvaluated() && size_ >= min_cases;
+  }
+
   const BuilderFunc func_;
+  const std::size_t size_;
 };
 
 template <typename BuilderFunc>
@@ -642,7 +782,9 @@ class TrivialSet final {
   using First = typename TypesPair::first_type;
   using Second = typename TypesPair::second_type;
 
-  constexpr TrivialSet(BuilderFunc&& func) noexcept : func_(std::move(func)) {
+  constexpr TrivialSet(BuilderFunc&& func) noexcept
+      : func_(std::move(func)),
+        size_(func_([]() { return impl::CaseCounter{}; }).Extract()) {
     static_assert(std::is_empty_v<BuilderFunc>,
                   "Mapping function should not capture variables");
     static_assert(std::is_trivially_copyable_v<First>,
@@ -652,6 +794,13 @@ class TrivialSet final {
   }
 
   constexpr bool Contains(First value) const noexcept {
+    if constexpr (std::is_same_v<First, std::string_view>) {
+      if (UseStringIndex(impl::kStringIndexMinCases)) {
+        return impl::GetStringSearchIndex<impl::Found, false>(func_)
+            .Find(value)
+            .has_value();
+      }
+    }
     return func_(
                [value]() { return impl::SwitchByFirst<First, Second>{value}; })
         .Extract();
@@ -661,13 +810,16 @@ class TrivialSet final {
     static_assert(std::is_convertible_v<First, std::string_view>,
                   "ContainsICase works only with std::string_view");
 
+    if (UseStringIndex(impl::kStringIndexMinCasesICase)) {
+      return impl::GetStringSearchIndex<impl::Found, false>(func_)
+          .FindICase(value)
+          .has_value();
+    }
     return func_([value]() { return impl::SwitchByFirstICase<void>{value}; })
         .Extract();
   }
 
-  constexpr std::size_t size() const noexcept {
-    return func_([]() { return impl::CaseCounter{}; }).Extract();
-  }
+  constexpr std::size_t size() const noexcept { return size_; }
 
   /// Returns a string of comma separated quoted values of Case parameters.
   ///
@@ -679,7 +831,12 @@ class TrivialSet final {
   }
 
  private:
+  constexpr bool UseStringIndex(std::size_t min_cases) const noexcept {
+    return !impl::IsConstantEvaluated() && size_ >= min_cases;
+  }
+
   const BuilderFunc func_;
+  const std::size_t size_;
 };
 
 template <typename BuilderFunc>
@@ -6,6 +6,8 @@
 
 #include <string>
 
+#include <userver/utils/small_string.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils::generators {
@@ -13,6 +15,10 @@ namespace utils::generators {
 /// @brief Generate a UUIDv4 string
 std::string GenerateUuid();
 
+/// @brief Generate a UUIDv4 string, same as GenerateUuid(), without allocating
+/// memory
+utils::SmallString<32> GenerateUuidSmallString();
+
 }  // namespace utils::generators
 
 USERVER_NAMESPACE_END
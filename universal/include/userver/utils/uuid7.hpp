@@ -6,6 +6,8 @@
 
 #include <string>
 
+#include <userver/utils/small_string.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace utils::generators {
@@ -13,6 +15,10 @@ namespace utils::generators {
 /// @brief Generate a UUIDv7 string
 std::string GenerateUuidV7();
 
+/// @brief Generate a UUIDv7 string, same as GenerateUuidV7(), without allocating
+/// memory
+utils::SmallString<32> GenerateUuidV7SmallString();
+
 }  // namespace utils::generators
 
 USERVER_NAMESPACE_END
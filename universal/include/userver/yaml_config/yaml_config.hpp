@@ -184,10 +184,27 @@ class YamlConfig {
   /// or Null.
   const_iterator end() const;
 
+  /// @brief Returns the config with all the `$variable`, `#env` and
+  /// `#fallback` substitutions resolved in a single pass.
+  ///
+  /// Members of the result are accessed without any substitution lookups,
+  /// which is much cheaper for configs that are read many times, e.g. on
+  /// startup. Object members with unresolved substitutions are dropped,
+  /// array elements with unresolved substitutions become nulls to keep the
+  /// indices. In YamlConfig::Mode::kSecure the `#env` keys without the
+  /// corresponding member are ignored.
+  YamlConfig ResolveSubstitutions() const;
+
+  /// @brief Makes a config from the YAML that already has all the
+  /// substitutions resolved, e.g. from the Yaml() of the ResolveSubstitutions()
+  /// result. No substitution lookups are done for it.
+  static YamlConfig MakeResolved(formats::yaml::Value yaml);
+
  private:
   formats::yaml::Value yaml_;
   formats::yaml::Value config_vars_;
   Mode mode_{Mode::kSecure};
+  bool is_resolved_{false};
 
   friend bool Parse(const YamlConfig& value, formats::parse::To<bool>);
   friend int64_t Parse(const YamlConfig& value, formats::parse::To<int64_t>);
@@ -0,0 +1,91 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/cache/flat_hash_map.hpp>
+#include <userver/utils/impl/transparent_hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr int kStep = 7919;
+
+template <typename Map>
+Map FillIntMap(int size) {
+  Map map;
+  for (int i = 0; i < size; ++i) map.insert_or_assign(i, i);
+  return map;
+}
+
+template <typename Map>
+Map FillStringMap(const std::vector<std::string>& keys) {
+  Map map;
+  for (const auto& key : keys) map.insert_or_assign(key, key.size());
+  return map;
+}
+
+std::vector<std::string> MakeKeys(int size) {
+  std::vector<std::string> keys;
+  keys.reserve(size);
+  for (int i = 0; i < size; ++i) keys.push_back("key-" + std::to_string(i));
+  return keys;
+}
+
+template <typename Map>
+void FindInt(benchmark::State& state) {
+  const auto size = static_cast<int>(state.range(0));
+  const auto map = FillIntMap<Map>(size);
+  int key = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(map.find(key));
+    key = (key + kStep) % size;
+  }
+}
+
+template <typename Map, typename FindFunc>
+void FindString(benchmark::State& state, FindFunc find) {
+  const auto size = static_cast<int>(state.range(0));
+  const auto keys = MakeKeys(size);
+  const auto map = FillStringMap<Map>(keys);
+  std::vector<std::string_view> lookups(keys.begin(), keys.end());
+  int index = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(find(map, lookups[index]));
+    index = (index + kStep) % size;
+  }
+}
+
+}  // namespace
+
+void UnorderedMapFindInt(benchmark::State& state) {
+  FindInt<std::unordered_map<int, int>>(state);
+}
+BENCHMARK(UnorderedMapFindInt)->Range(1'000, 1'000'000);
+
+void FlatHashMapFindInt(benchmark::State& state) {
+  FindInt<cache::FlatHashMap<int, int>>(state);
+}
+BENCHMARK(FlatHashMapFindInt)->Range(1'000, 1'000'000);
+
+void TransparentMapFindStringView(benchmark::State& state) {
+  FindString<utils::impl::TransparentMap<std::string, std::size_t>>(
+      state, [](const auto& map, std::string_view key) {
+        return utils::impl::FindTransparentOrNullptr(map, key);
+      });
+}
+BENCHMARK(TransparentMapFindStringView)->Range(1'000, 1'000'000);
+
+void FlatHashMapFindStringView(benchmark::State& state) {
+  FindString<cache::FlatHashMap<std::string, std::size_t>>(
+      state, [](const auto& map, std::string_view key) {
+        const auto it = map.find(key);
+        return it == map.end() ? nullptr : &it->second;
+      });
+}
+BENCHMARK(FlatHashMapFindStringView)->Range(1'000, 1'000'000);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <userver/cache/flat_hash_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = cache::FlatHashMap<int, std::string>;
+
+// Puts all the keys into the same group
+struct CollidingHash {
+  std::size_t operator()(int) const noexcept { return 42; }
+};
+
+template <typename FlatMap>
+void ExpectSameContents(const FlatMap& map,
+                        const std::unordered_map<int, std::string>& expected) {
+  ASSERT_EQ(map.size(), expected.size());
+  std::size_t iterated = 0;
+  for (const auto& [key, value] : map) {
+    ++iterated;
+    const auto it = expected.find(key);
+    ASSERT_NE(it, expected.end()) << key;
+    EXPECT_EQ(it->second, value) << key;
+  }
+  EXPECT_EQ(iterated, expected.size());
+
+  for (const auto& [key, value] : expected) {
+    const auto it = map.find(key);
+    ASSERT_NE(it, map.end()) << key;
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, value);
+    EXPECT_EQ(map.at(key), value);
+  }
+}
+
+template <typename FlatMap>
+void TestRandomOperations() {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> keys{0, 2000};
+
+  FlatMap map;
+  std::unordered_map<int, std::string> expected;
+  for (int i = 0; i < 20000; ++i) {
+    const auto key = keys(gen);
+    if (i % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key)) << key;
+    } else {
+      const auto value = std::to_string(i);
+      EXPECT_EQ(map.insert_or_assign(key, value),
+                expected.insert_or_assign(key, value).second)
+          << key;
+    }
+  }
+  ExpectSameContents(map, expected);
+
+  const auto copy = map;
+  ExpectSameContents(copy, expected);
+}
+
+}  // namespace
+
+TEST(FlatHashMap, Empty) {
+  const Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(1), map.end());
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_THROW(map.at(1), std::out_of_range);
+}
+
+TEST(FlatHashMap, InsertFindErase) {
+  Map map;
+  EXPECT_TRUE(map.insert_or_assign(1, "a"));
+  EXPECT_TRUE(map.insert({2, "b"}));
+  EXPECT_FALSE(map.insert({2, "c"}));
+  EXPECT_EQ(map.at(2), "b");
+  EXPECT_FALSE(map.insert_or_assign(2, "d"));
+  EXPECT_EQ(map.at(2), "d");
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.count(1), 1);
+
+  EXPECT_EQ(map.erase(3), 0);
+  EXPECT_EQ(map.erase(1), 1);
+  EXPECT_EQ(map.erase(1), 0);
+  EXPECT_FALSE(map.contains(1));
+  ExpectSameContents(map, {{2, "d"}});
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_TRUE(map.insert_or_assign(1, "a"));
+  ExpectSameContents(map, {{1, "a"}});
+}
+
+TEST(FlatHashMap, Growth) {
+  Map map;
+  std::unordered_map<int, std::string> expected;
+  for (int i = 0; i < 10000; ++i) {
+    map.insert_or_assign(i, std::to_string(i));
+    expected.emplace(i, std::to_string(i));
+  }
+  ExpectSameContents(map, expected);
+
+  Map reserved;
+  reserved.reserve(expected.size());
+  for (const auto& [key, value] : expected) reserved.insert({key, value});
+  EXPECT_EQ(map, reserved);
+}
+
+TEST(FlatHashMap, CopyAndMove) {
+  Map map;
+  for (int i = 0; i < 100; ++i) map.insert_or_assign(i, std::to_string(i));
+
+  auto copy = map;
+  EXPECT_EQ(copy, map);
+  copy.insert_or_assign(1, "changed");
+  EXPECT_EQ(map.at(1), "1");
+  EXPECT_NE(copy, map);
+
+  auto moved = std::move(copy);
+  EXPECT_EQ(moved.at(1), "changed");
+  EXPECT_EQ(moved.size(), 100);
+
+  copy = moved;
+  EXPECT_EQ(copy, moved);
+  moved = std::move(map);
+  EXPECT_EQ(moved.at(1), "1");
+}
+
+TEST(FlatHashMap, HeterogeneousLookup) {
+  cache::FlatHashMap<std::string, int> map;
+  map.insert_or_assign("one", 1);
+  map.insert_or_assign(std::string(100, 'x'), 100);
+
+  constexpr std::string_view kOne = "one";
+  EXPECT_EQ(map.at(kOne), 1);
+  EXPECT_TRUE(map.contains(std::string_view{std::string(100, 'x')}));
+  EXPECT_EQ(map.find(std::string_view{"two"}), map.end());
+  EXPECT_EQ(map.find("one")->second, 1);
+}
+
+TEST(FlatHashMap, MoveOnlyValues) {
+  cache::FlatHashMap<int, std::unique_ptr<int>> map;
+  for (int i = 0; i < 100; ++i) {
+    map.insert_or_assign(i, std::make_unique<int>(i));
+  }
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(*map.at(i), i);
+}
+
+TEST(FlatHashMap, Random) {
+  TestRandomOperations<Map>();
+  TestRandomOperations<cache::FlatHashMap<int, std::string, CollidingHash>>();
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(FrequencySketch, Estimate) {
+  cache::impl::FrequencySketch sketch{100};
+  EXPECT_EQ(sketch.Estimate(1), 0);
+
+  for (int i = 0; i < 5; ++i) sketch.Increment(1);
+  sketch.Increment(2);
+  EXPECT_EQ(sketch.Estimate(1), 5);
+  EXPECT_EQ(sketch.Estimate(2), 1);
+  EXPECT_EQ(sketch.Estimate(3), 0);
+
+  sketch.Clear();
+  EXPECT_EQ(sketch.Estimate(1), 0);
+}
+
+TEST(FrequencySketch, Saturation) {
+  cache::impl::FrequencySketch sketch{100};
+  for (int i = 0; i < 100; ++i) sketch.Increment(1);
+  EXPECT_EQ(sketch.Estimate(1), 15);
+}
+
+TEST(FrequencySketch, Aging) {
+  constexpr std::size_t kCapacity = 100;
+  cache::impl::FrequencySketch sketch{kCapacity};
+  for (int i = 0; i < 8; ++i) sketch.Increment(1);
+
+  // Sample size is 10 * capacity, one-hit keys trigger the reset
+  for (std::size_t i = 0; i < 10 * kCapacity; ++i) sketch.Increment(1000 + i);
+  EXPECT_LE(sketch.Estimate(1), 4);
+  EXPECT_GE(sketch.Estimate(1), 2);
+}
+
+TEST(FrequencySketch, HotKeysStandOut) {
+  constexpr std::size_t kCapacity = 1000;
+  cache::impl::FrequencySketch sketch{kCapacity};
+  for (int round = 0; round < 4; ++round) {
+    for (std::size_t key = 0; key < 10; ++key) sketch.Increment(key);
+  }
+  for (std::size_t key = 100; key < 100 + 5 * kCapacity; ++key) {
+    sketch.Increment(key);
+  }
+
+  int overestimated = 0;
+  for (std::size_t key = 100; key < 100 + 5 * kCapacity; ++key) {
+    if (sketch.Estimate(key) >= 4) ++overestimated;
+  }
+  EXPECT_LT(overestimated, 50);
+  for (std::size_t key = 0; key < 10; ++key) {
+    EXPECT_GE(sketch.Estimate(key), 4);
+  }
+}
+
+USERVER_NAMESPACE_END
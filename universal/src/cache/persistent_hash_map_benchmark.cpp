@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <unordered_map>
+
+#include <userver/cache/persistent_hash_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Size of an incremental update of a cache
+constexpr int kChangesCount = 100;
+
+template <typename Map>
+Map FillMap(int size) {
+  Map map;
+  for (int i = 0; i < size; ++i) {
+    map.insert_or_assign(i, std::to_string(i));
+  }
+  return map;
+}
+
+// Copies the previous snapshot and applies the changes, as incremental cache
+// updates do
+template <typename Map>
+void IncrementalUpdate(benchmark::State& state) {
+  const auto size = static_cast<int>(state.range(0));
+  auto snapshot = FillMap<Map>(size);
+  int key = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    auto copy = snapshot;
+    for (int i = 0; i < kChangesCount; ++i) {
+      copy.insert_or_assign(key, "changed");
+      key = (key + 7919) % size;
+    }
+    snapshot = std::move(copy);
+  }
+}
+
+template <typename Map>
+void Find(benchmark::State& state) {
+  const auto size = static_cast<int>(state.range(0));
+  const auto map = FillMap<Map>(size);
+  int key = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(map.find(key));
+    key = (key + 7919) % size;
+  }
+}
+
+}  // namespace
+
+void UnorderedMapIncrementalUpdate(benchmark::State& state) {
+  IncrementalUpdate<std::unordered_map<int, std::string>>(state);
+}
+BENCHMARK(UnorderedMapIncrementalUpdate)->Range(1'000, 1'000'000);
+
+void PersistentHashMapIncrementalUpdate(benchmark::State& state) {
+  IncrementalUpdate<cache::PersistentHashMap<int, std::string>>(state);
+}
+BENCHMARK(PersistentHashMapIncrementalUpdate)->Range(1'000, 1'000'000);
+
+void UnorderedMapFind(benchmark::State& state) {
+  Find<std::unordered_map<int, std::string>>(state);
+}
+BENCHMARK(UnorderedMapFind)->Range(1'000, 1'000'000);
+
+void PersistentHashMapFind(benchmark::State& state) {
+  Find<cache::PersistentHashMap<int, std::string>>(state);
+}
+BENCHMARK(PersistentHashMapFind)->Range(1'000, 1'000'000);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <userver/cache/persistent_hash_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = cache::PersistentHashMap<int, std::string>;
+
+// Puts all the keys into the same bucket
+struct CollidingHash {
+  std::size_t operator()(int) const noexcept { return 42; }
+};
+
+// Keys with the same low bits, to build deep tries
+struct ShiftedHash {
+  std::size_t operator()(int key) const noexcept {
+    return static_cast<std::size_t>(key) << 40;
+  }
+};
+
+template <typename PersistentMap>
+void ExpectSameContents(const PersistentMap& map,
+                        const std::unordered_map<int, std::string>& expected) {
+  ASSERT_EQ(map.size(), expected.size());
+  std::size_t iterated = 0;
+  for (const auto& [key, value] : map) {
+    ++iterated;
+    const auto it = expected.find(key);
+    ASSERT_NE(it, expected.end()) << key;
+    EXPECT_EQ(it->second, value) << key;
+  }
+  EXPECT_EQ(iterated, expected.size());
+
+  for (const auto& [key, value] : expected) {
+    const auto it = map.find(key);
+    ASSERT_NE(it, map.end()) << key;
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, value);
+    EXPECT_EQ(map.at(key), value);
+  }
+}
+
+template <typename PersistentMap>
+void TestRandomOperations() {
+  std::mt19937 gen{42};
+  std::uniform_int_distribution<int> keys{0, 2000};
+
+  PersistentMap map;
+  std::unordered_map<int, std::string> expected;
+  for (int i = 0; i < 20000; ++i) {
+    const auto key = keys(gen);
+    if (i % 3 == 0) {
+      EXPECT_EQ(map.erase(key), expected.erase(key)) << key;
+    } else {
+      const auto value = std::to_string(i);
+      EXPECT_EQ(map.insert_or_assign(key, value),
+                expected.insert_or_assign(key, value).second)
+          << key;
+    }
+  }
+  ExpectSameContents(map, expected);
+}
+
+}  // namespace
+
+TEST(PersistentHashMap, Empty) {
+  const Map map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(map.find(1), map.end());
+  EXPECT_FALSE(map.contains(1));
+  EXPECT_THROW(map.at(1), std::out_of_range);
+}
+
+TEST(PersistentHashMap, InsertFindErase) {
+  Map map;
+  EXPECT_TRUE(map.insert_or_assign(1, "a"));
+  EXPECT_TRUE(map.insert({2, "b"}));
+  EXPECT_FALSE(map.insert({2, "c"}));
+  EXPECT_EQ(map.at(2), "b");
+  EXPECT_FALSE(map.insert_or_assign(2, "d"));
+  EXPECT_EQ(map.at(2), "d");
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.count(1), 1);
+
+  EXPECT_EQ(map.erase(3), 0);
+  EXPECT_EQ(map.erase(1), 1);
+  EXPECT_EQ(map.erase(1), 0);
+  EXPECT_FALSE(map.contains(1));
+  ExpectSameContents(map, {{2, "d"}});
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(PersistentHashMap, CopiesAreIndependent) {
+  Map map;
+  std::unordered_map<int, std::string> expected;
+  for (int i = 0; i < 1000; ++i) {
+    map.insert_or_assign(i, std::to_string(i));
+    expected.emplace(i, std::to_string(i));
+  }
+
+  auto copy = map;
+  for (int i = 0; i < 1000; i += 3) copy.erase(i);
+  for (int i = 1; i < 1000; i += 3) copy.insert_or_assign(i, "changed");
+  copy.insert_or_assign(5000, "new");
+
+  ExpectSameContents(map, expected);
+  EXPECT_EQ(copy.size(), 1000 - 334 + 1);
+  EXPECT_EQ(copy.at(1), "changed");
+  EXPECT_EQ(copy.at(2), "2");
+  EXPECT_FALSE(copy.contains(0));
+  EXPECT_FALSE(map.contains(5000));
+
+  map.insert_or_assign(2, "original");
+  EXPECT_EQ(copy.at(2), "2");
+}
+
+TEST(PersistentHashMap, IteratorAfterFind) {
+  Map map;
+  for (int i = 0; i < 100; ++i) map.insert_or_assign(i, std::to_string(i));
+
+  // find() returns an iterator that continues iteration from the element
+  std::size_t count = 0;
+  for (auto it = map.find(map.begin()->first); it != map.end(); ++it) {
+    ++count;
+  }
+  EXPECT_EQ(count, map.size());
+
+  std::size_t total = 0;
+  for (int i = 0; i < 100; ++i) {
+    auto it = map.find(i);
+    ASSERT_NE(it, map.end());
+    while (it != map.end()) {
+      ++it;
+      ++total;
+    }
+  }
+  // Each element is visited once from every element before it
+  EXPECT_EQ(total, 100 * 101 / 2);
+}
+
+TEST(PersistentHashMap, Collisions) {
+  cache::PersistentHashMap<int, std::string, CollidingHash> map;
+  map.insert_or_assign(1, "a");
+  map.insert_or_assign(2, "b");
+  map.insert_or_assign(3, "c");
+  auto copy = map;
+
+  EXPECT_FALSE(map.insert_or_assign(2, "d"));
+  EXPECT_EQ(map.erase(1), 1);
+  ExpectSameContents(map, {{2, "d"}, {3, "c"}});
+  ExpectSameContents(copy, {{1, "a"}, {2, "b"}, {3, "c"}});
+
+  EXPECT_EQ(map.erase(3), 1);
+  EXPECT_EQ(map.erase(2), 1);
+  EXPECT_TRUE(map.empty());
+}
+
+TEST(PersistentHashMap, Random) {
+  TestRandomOperations<Map>();
+  TestRandomOperations<
+      cache::PersistentHashMap<int, std::string, ShiftedHash>>();
+  TestRandomOperations<
+      cache::PersistentHashMap<int, std::string, CollidingHash>>();
+}
+
+TEST(PersistentHashMap, Equality) {
+  Map map;
+  map.insert_or_assign(1, "a");
+  auto copy = map;
+  EXPECT_EQ(map, copy);
+  copy.insert_or_assign(1, "b");
+  EXPECT_NE(map, copy);
+  copy.insert_or_assign(1, "a");
+  EXPECT_EQ(map, copy);
+}
+
+USERVER_NAMESPACE_END
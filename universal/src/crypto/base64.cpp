@@ -1,9 +1,23 @@
 #include <userver/crypto/base64.hpp>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
 #include <cryptopp/base64.h>
 
 #include <userver/crypto/exception.hpp>
 
+#include <utils/simd.hpp>
+
+#if defined(USERVER_IMPL_SIMD_X86)
+#include <immintrin.h>
+#elif defined(USERVER_IMPL_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
 #ifdef CRYPTOPP_NO_GLOBAL_BYTE
 using CryptoPP::byte;
 #endif
@@ -14,21 +28,411 @@ namespace crypto::base64 {
 
 namespace {
 
-template <typename Base64Encoder>
-std::string Base64Encode(std::string_view data, Pad pad) {
-  std::string response;
-  try {
-    Base64Encoder encoder(new CryptoPP::StringSink(response));
-    CryptoPP::AlgorithmParameters params =
-        CryptoPP::MakeParameters(CryptoPP::Name::Pad(), Pad::kWith == pad)(
-            CryptoPP::Name::InsertLineBreaks(), false);
-    encoder.IsolatedInitialize(params);
-    encoder.PutMessageEnd(reinterpret_cast<const byte*>(data.data()),
-                          data.size());
-  } catch (const CryptoPP::Exception& exc) {
-    throw crypto::CryptoException(exc.what());
+constexpr std::uint8_t kInvalid = 0xff;
+
+struct Alphabet final {
+  constexpr Alphabet(char char62, char char63)
+      : char62(char62), char63(char63) {
+    constexpr std::string_view kCommon =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+    for (std::size_t i = 0; i < kCommon.size(); ++i) chars[i] = kCommon[i];
+    chars[62] = char62;
+    chars[63] = char63;
+
+    for (auto& value : values) value = kInvalid;
+    for (std::size_t i = 0; i < chars.size(); ++i) {
+      values[static_cast<unsigned char>(chars[i])] = i;
+    }
   }
-  return response;
+
+  const char char62;
+  const char char63;
+  std::array<char, 64> chars{};
+  std::array<std::uint8_t, 256> values{};
+};
+
+constexpr Alphabet kStandardAlphabet{'+', '/'};
+constexpr Alphabet kUrlAlphabet{'-', '_'};
+
+// The kernels below return the number of the input characters converted, the
+// encoding ones process the groups of 3 bytes, the decoding ones - the groups
+// of 4 valid characters
+
+#if defined(USERVER_IMPL_SIMD_X86)
+// "Faster Base64 Encoding and Decoding using AVX2 Instructions",
+// W. Mula, D. Lemire, https://arxiv.org/abs/1704.00605
+USERVER_IMPL_SIMD_TARGET_SSSE3
+__m128i EncodeBlockSsse3(__m128i in, const Alphabet& alphabet) noexcept {
+  // 3 bytes of each 4 byte lane are spread into 4 indices of 6 bits
+  in = _mm_shuffle_epi8(
+      in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+  const auto t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+  const auto t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+  const auto t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+  const auto t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+  const auto indices = _mm_or_si128(t1, t3);
+
+  // the ranges of the indices are mapped to the offsets of their characters
+  auto ranges = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  const auto is_upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+  ranges = _mm_or_si128(ranges, _mm_and_si128(is_upper, _mm_set1_epi8(13)));
+  const auto offsets = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, alphabet.char62 - 62,
+      alphabet.char63 - 63, 'A', 0, 0);
+  return _mm_add_epi8(_mm_shuffle_epi8(offsets, ranges), indices);
+}
+
+USERVER_IMPL_SIMD_TARGET_SSSE3
+std::size_t EncodeSsse3(const char* src, std::size_t size, char* dst,
+                        const Alphabet& alphabet) noexcept {
+  std::size_t i = 0;
+  // 12 bytes are encoded, 16 bytes are read
+  for (; size - i >= 16; i += 12, dst += 16) {
+    const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                     EncodeBlockSsse3(in, alphabet));
+  }
+  return i;
+}
+
+USERVER_IMPL_SIMD_TARGET_AVX2
+std::size_t EncodeAvx2(const char* src, std::size_t size, char* dst,
+                       const Alphabet& alphabet) noexcept {
+  const auto offsets = _mm256_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, alphabet.char62 - 62,
+      alphabet.char63 - 63, 'A', 0, 0, 'a' - 26, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      alphabet.char62 - 62, alphabet.char63 - 63, 'A', 0, 0);
+
+  std::size_t i = 0;
+  // Same as EncodeSsse3 in 2 lanes, 24 bytes are encoded, 28 bytes are read
+  for (; size - i >= 28; i += 24, dst += 32) {
+    auto in = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))),
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 12)), 1);
+    in = _mm256_shuffle_epi8(
+        in, _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                             1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11,
+                             10));
+    const auto t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+    const auto t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+    const auto t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+    const auto t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+    const auto indices = _mm256_or_si256(t1, t3);
+
+    auto ranges = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    const auto is_upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    ranges = _mm256_or_si256(ranges,
+                             _mm256_and_si256(is_upper, _mm256_set1_epi8(13)));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i*>(dst),
+        _mm256_add_epi8(_mm256_shuffle_epi8(offsets, ranges), indices));
+  }
+  return i;
+}
+
+// The non-ASCII characters are negative and are never in the range
+USERVER_IMPL_SIMD_TARGET_SSSE3
+__m128i InRangeSsse3(__m128i in, char first, char last) noexcept {
+  return _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8(first - 1)),
+                       _mm_cmpgt_epi8(_mm_set1_epi8(last + 1), in));
+}
+
+// Converts the characters to their 6 bit values, returns false if some of
+// the characters are not in the alphabet
+USERVER_IMPL_SIMD_TARGET_SSSE3
+bool DecodeValuesSsse3(__m128i& in, const Alphabet& alphabet) noexcept {
+  const auto is_upper = InRangeSsse3(in, 'A', 'Z');
+  const auto is_lower = InRangeSsse3(in, 'a', 'z');
+  const auto is_digit = InRangeSsse3(in, '0', '9');
+  const auto is_62 = _mm_cmpeq_epi8(in, _mm_set1_epi8(alphabet.char62));
+  const auto is_63 = _mm_cmpeq_epi8(in, _mm_set1_epi8(alphabet.char63));
+
+  const auto valid = _mm_or_si128(
+      _mm_or_si128(is_upper, is_lower),
+      _mm_or_si128(is_digit, _mm_or_si128(is_62, is_63)));
+  if (_mm_movemask_epi8(valid) != 0xffff) return false;
+
+  auto offsets = _mm_and_si128(is_upper, _mm_set1_epi8(-'A'));
+  offsets = _mm_or_si128(
+      offsets, _mm_and_si128(is_lower, _mm_set1_epi8(26 - 'a')));
+  offsets = _mm_or_si128(
+      offsets, _mm_and_si128(is_digit, _mm_set1_epi8(52 - '0')));
+  offsets = _mm_or_si128(
+      offsets, _mm_and_si128(is_62, _mm_set1_epi8(62 - alphabet.char62)));
+  offsets = _mm_or_si128(
+      offsets, _mm_and_si128(is_63, _mm_set1_epi8(63 - alphabet.char63)));
+  in = _mm_add_epi8(in, offsets);
+  return true;
+}
+
+// Packs the 6 bit values of each 4 byte lane into its first 3 bytes
+USERVER_IMPL_SIMD_TARGET_SSSE3
+__m128i PackValuesSsse3(__m128i values) noexcept {
+  const auto merged_pairs =
+      _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  const auto merged = _mm_madd_epi16(merged_pairs, _mm_set1_epi32(0x00011000));
+  return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14,
+                                                13, 12, -1, -1, -1, -1));
+}
+
+USERVER_IMPL_SIMD_TARGET_SSSE3
+std::size_t DecodeSsse3(const char* src, std::size_t size, char* dst,
+                        const Alphabet& alphabet) noexcept {
+  std::size_t i = 0;
+  // 16 bytes are written for 12 decoded ones, see DecodeSimd
+  for (; size - i >= 16; i += 16, dst += 12) {
+    auto values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (!DecodeValuesSsse3(values, alphabet)) break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), PackValuesSsse3(values));
+  }
+  return i;
+}
+
+USERVER_IMPL_SIMD_TARGET_AVX2
+__m256i InRangeAvx2(__m256i in, char first, char last) noexcept {
+  return _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8(first - 1)),
+                          _mm256_cmpgt_epi8(_mm256_set1_epi8(last + 1), in));
+}
+
+USERVER_IMPL_SIMD_TARGET_AVX2
+std::size_t DecodeAvx2(const char* src, std::size_t size, char* dst,
+                       const Alphabet& alphabet) noexcept {
+  std::size_t i = 0;
+  // Same as DecodeSsse3 in 2 lanes
+  for (; size - i >= 32; i += 32, dst += 24) {
+    const auto in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    const auto is_upper = InRangeAvx2(in, 'A', 'Z');
+    const auto is_lower = InRangeAvx2(in, 'a', 'z');
+    const auto is_digit = InRangeAvx2(in, '0', '9');
+    const auto is_62 = _mm256_cmpeq_epi8(in, _mm256_set1_epi8(alphabet.char62));
+    const auto is_63 = _mm256_cmpeq_epi8(in, _mm256_set1_epi8(alphabet.char63));
+
+    const auto valid = _mm256_or_si256(
+        _mm256_or_si256(is_upper, is_lower),
+        _mm256_or_si256(is_digit, _mm256_or_si256(is_62, is_63)));
+    if (_mm256_movemask_epi8(valid) != -1) break;
+
+    auto offsets = _mm256_and_si256(is_upper, _mm256_set1_epi8(-'A'));
+    offsets = _mm256_or_si256(
+        offsets, _mm256_and_si256(is_lower, _mm256_set1_epi8(26 - 'a')));
+    offsets = _mm256_or_si256(
+        offsets, _mm256_and_si256(is_digit, _mm256_set1_epi8(52 - '0')));
+    offsets = _mm256_or_si256(
+        offsets,
+        _mm256_and_si256(is_62, _mm256_set1_epi8(62 - alphabet.char62)));
+    offsets = _mm256_or_si256(
+        offsets,
+        _mm256_and_si256(is_63, _mm256_set1_epi8(63 - alphabet.char63)));
+    const auto values = _mm256_add_epi8(in, offsets);
+
+    const auto merged_pairs =
+        _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    const auto merged =
+        _mm256_madd_epi16(merged_pairs, _mm256_set1_epi32(0x00011000));
+    const auto packed = _mm256_shuffle_epi8(
+        merged, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1,
+                                 -1, -1, 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12,
+                                 -1, -1, -1, -1));
+    // 16 bytes are written for 12 decoded ones, see DecodeSimd
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
+                     _mm256_castsi256_si128(packed));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 12),
+                     _mm256_extracti128_si256(packed, 1));
+  }
+  return i;
+}
+#elif defined(USERVER_IMPL_SIMD_NEON)
+std::size_t EncodeNeon(const char* src, std::size_t size, char* dst,
+                       const Alphabet& alphabet) noexcept {
+  const auto* chars =
+      reinterpret_cast<const std::uint8_t*>(alphabet.chars.data());
+  const uint8x16x4_t table{{vld1q_u8(chars), vld1q_u8(chars + 16),
+                            vld1q_u8(chars + 32), vld1q_u8(chars + 48)}};
+  const auto mask = vdupq_n_u8(0x3f);
+
+  std::size_t i = 0;
+  for (; size - i >= 48; i += 48, dst += 64) {
+    const auto in = vld3q_u8(reinterpret_cast<const std::uint8_t*>(src + i));
+    uint8x16x4_t out;
+    out.val[0] = vshrq_n_u8(in.val[0], 2);
+    out.val[1] = vandq_u8(
+        vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask);
+    out.val[2] = vandq_u8(
+        vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask);
+    out.val[3] = vandq_u8(in.val[2], mask);
+    for (auto& v : out.val) v = vqtbl4q_u8(table, v);
+    vst4q_u8(reinterpret_cast<std::uint8_t*>(dst), out);
+  }
+  return i;
+}
+
+std::size_t DecodeNeon(const char* src, std::size_t size, char* dst,
+                       const Alphabet& alphabet) noexcept {
+  const auto* values = alphabet.values.data();
+  const uint8x16x4_t low_table{{vld1q_u8(values), vld1q_u8(values + 16),
+                                vld1q_u8(values + 32), vld1q_u8(values + 48)}};
+  const uint8x16x4_t high_table{{vld1q_u8(values + 64), vld1q_u8(values + 80),
+                                 vld1q_u8(values + 96),
+                                 vld1q_u8(values + 112)}};
+
+  std::size_t i = 0;
+  for (; size - i >= 64; i += 64, dst += 48) {
+    auto in = vld4q_u8(reinterpret_cast<const std::uint8_t*>(src + i));
+    // the valid values are below 64, the invalid ones are kInvalid
+    auto invalid = vdupq_n_u8(0);
+    for (auto& v : in.val) {
+      const auto non_ascii = vcgeq_u8(v, vdupq_n_u8(0x80));
+      v = vqtbx4q_u8(vqtbl4q_u8(low_table, v), high_table,
+                     vsubq_u8(v, vdupq_n_u8(64)));
+      invalid = vorrq_u8(invalid, vorrq_u8(v, non_ascii));
+    }
+    if (vmaxvq_u8(invalid) >= 64) break;
+
+    uint8x16x3_t out;
+    out.val[0] = vorrq_u8(vshlq_n_u8(in.val[0], 2), vshrq_n_u8(in.val[1], 4));
+    out.val[1] = vorrq_u8(vshlq_n_u8(in.val[1], 4), vshrq_n_u8(in.val[2], 2));
+    out.val[2] = vorrq_u8(vshlq_n_u8(in.val[2], 6), in.val[3]);
+    vst3q_u8(reinterpret_cast<std::uint8_t*>(dst), out);
+  }
+  return i;
+}
+#endif
+
+std::size_t EncodeSimd(const char* src, std::size_t size, char* dst,
+                       const Alphabet& alphabet) noexcept {
+#if defined(USERVER_IMPL_SIMD_X86)
+  switch (utils::simd::GetInstructionSet()) {
+    case utils::simd::InstructionSet::kAvx2:
+      return EncodeAvx2(src, size, dst, alphabet);
+    case utils::simd::InstructionSet::kSsse3:
+      return EncodeSsse3(src, size, dst, alphabet);
+    default:
+      return 0;
+  }
+#elif defined(USERVER_IMPL_SIMD_NEON)
+  if (utils::simd::IsEnabled(utils::simd::InstructionSet::kNeon)) {
+    return EncodeNeon(src, size, dst, alphabet);
+  }
+  return 0;
+#else
+  (void)src;
+  (void)size;
+  (void)dst;
+  (void)alphabet;
+  return 0;
+#endif
+}
+
+// `dst` must have 4 bytes of extra space after the decoded data, the kernels
+// may write garbage there
+std::size_t DecodeSimd(const char* src, std::size_t size, char* dst,
+                       const Alphabet& alphabet) noexcept {
+#if defined(USERVER_IMPL_SIMD_X86)
+  switch (utils::simd::GetInstructionSet()) {
+    case utils::simd::InstructionSet::kAvx2:
+      return DecodeAvx2(src, size, dst, alphabet);
+    case utils::simd::InstructionSet::kSsse3:
+      return DecodeSsse3(src, size, dst, alphabet);
+    default:
+      return 0;
+  }
+#elif defined(USERVER_IMPL_SIMD_NEON)
+  if (utils::simd::IsEnabled(utils::simd::InstructionSet::kNeon)) {
+    return DecodeNeon(src, size, dst, alphabet);
+  }
+  return 0;
+#else
+  (void)src;
+  (void)size;
+  (void)dst;
+  (void)alphabet;
+  return 0;
+#endif
+}
+
+std::string Encode(std::string_view data, Pad pad, const Alphabet& alphabet) {
+  const auto* src = reinterpret_cast<const std::uint8_t*>(data.data());
+  const auto size = data.size();
+  const auto tail = size % 3;
+
+  std::string result;
+  result.resize(size / 3 * 4 +
+                (tail == 0 ? 0 : (pad == Pad::kWith ? 4 : tail + 1)));
+  auto* dst = result.data();
+
+  std::size_t i = EncodeSimd(data.data(), size, dst, alphabet);
+  dst += i / 3 * 4;
+  const auto& chars = alphabet.chars;
+  for (; size - i >= 3; i += 3, dst += 4) {
+    const std::uint32_t group = (src[i] << 16) | (src[i + 1] << 8) | src[i + 2];
+    dst[0] = chars[group >> 18];
+    dst[1] = chars[(group >> 12) & 0x3f];
+    dst[2] = chars[(group >> 6) & 0x3f];
+    dst[3] = chars[group & 0x3f];
+  }
+
+  if (tail != 0) {
+    const std::uint32_t group =
+        (src[i] << 16) | (tail == 2 ? src[i + 1] << 8 : 0);
+    dst[0] = chars[group >> 18];
+    dst[1] = chars[(group >> 12) & 0x3f];
+    if (tail == 2) dst[2] = chars[(group >> 6) & 0x3f];
+    if (pad == Pad::kWith) {
+      if (tail == 1) dst[2] = '=';
+      dst[3] = '=';
+    }
+  }
+  return result;
+}
+
+// Decodes the canonical encoding: the alphabet characters followed by any
+// padding. Returns nullopt for any other input, that the decoders of
+// CryptoPP process by skipping the unknown characters.
+std::optional<std::string> Decode(std::string_view data,
+                                  const Alphabet& alphabet) {
+  while (!data.empty() && data.back() == '=') data.remove_suffix(1);
+  const auto size = data.size();
+
+  std::string result;
+  // the extra space for DecodeSimd
+  result.resize(size / 4 * 3 + 4);
+  auto* dst = result.data();
+
+  std::size_t i = DecodeSimd(data.data(), size, dst, alphabet);
+  dst += i / 4 * 3;
+  const auto value = [&data, &alphabet](std::size_t pos) -> std::uint32_t {
+    return alphabet.values[static_cast<unsigned char>(data[pos])];
+  };
+  for (; size - i >= 4; i += 4, dst += 3) {
+    const auto v0 = value(i);
+    const auto v1 = value(i + 1);
+    const auto v2 = value(i + 2);
+    const auto v3 = value(i + 3);
+    if ((v0 | v1 | v2 | v3) >= 64) return std::nullopt;
+    const auto group = (v0 << 18) | (v1 << 12) | (v2 << 6) | v3;
+    dst[0] = static_cast<char>(group >> 16);
+    dst[1] = static_cast<char>(group >> 8);
+    dst[2] = static_cast<char>(group);
+  }
+
+  // The incomplete bytes of the last 6 bit values are dropped
+  std::uint32_t group = 0;
+  const auto tail = size - i;
+  for (std::size_t j = 0; j < tail; ++j) {
+    const auto v = value(i + j);
+    if (v == kInvalid) return std::nullopt;
+    group |= v << (18 - 6 * j);
+  }
+  if (tail >= 2) *dst++ = static_cast<char>(group >> 16);
+  if (tail == 3) *dst++ = static_cast<char>(group >> 8);
+
+  result.resize(dst - result.data());
+  return result;
 }
 
 template <typename Base64Decoder>
@@ -47,19 +451,23 @@ std::string Base64Decode(std::string_view data) {
 }  // namespace
 
 std::string Base64Encode(std::string_view data, Pad pad) {
-  return Base64Encode<CryptoPP::Base64Encoder>(data, pad);
+  return Encode(data, pad, kStandardAlphabet);
 }
 
 std::string Base64Decode(std::string_view data) {
+  auto result = Decode(data, kStandardAlphabet);
+  if (result) return std::move(*result);
   return Base64Decode<CryptoPP::Base64Decoder>(data);
 }
 
 #ifndef USERVER_NO_CRYPTOPP_BASE64_URL
 std::string Base64UrlEncode(std::string_view data, Pad pad) {
-  return Base64Encode<CryptoPP::Base64URLEncoder>(data, pad);
+  return Encode(data, pad, kUrlAlphabet);
 }
 
 std::string Base64UrlDecode(std::string_view data) {
+  auto result = Decode(data, kUrlAlphabet);
+  if (result) return std::move(*result);
   return Base64Decode<CryptoPP::Base64URLDecoder>(data);
 }
 #endif
@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+
+#include <userver/crypto/base64.hpp>
+#include <utils/simd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string GenerateSource(std::size_t size) {
+  std::string source;
+  source.reserve(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    source.push_back(static_cast<char>(i * 13));
+  }
+  return source;
+}
+
+void SetInstructionSet(benchmark::State& state) {
+  utils::simd::SetMaxInstructionSet(
+      state.range(1) ? utils::simd::InstructionSet::kNeon
+                     : utils::simd::InstructionSet::kNone);
+}
+
+}  // namespace
+
+void base64_encode(benchmark::State& state) {
+  SetInstructionSet(state);
+  const auto source = GenerateSource(state.range(0));
+
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(crypto::base64::Base64Encode(source));
+  }
+  state.SetBytesProcessed(state.iterations() * source.size());
+  utils::simd::SetMaxInstructionSet(utils::simd::InstructionSet::kNeon);
+}
+BENCHMARK(base64_encode)->RangeMultiplier(8)->Ranges({{16, 64 << 10}, {0, 1}});
+
+void base64_decode(benchmark::State& state) {
+  SetInstructionSet(state);
+  const auto encoded =
+      crypto::base64::Base64Encode(GenerateSource(state.range(0)));
+
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(crypto::base64::Base64Decode(encoded));
+  }
+  state.SetBytesProcessed(state.iterations() * encoded.size());
+  utils::simd::SetMaxInstructionSet(utils::simd::InstructionSet::kNeon);
+}
+BENCHMARK(base64_decode)->RangeMultiplier(8)->Ranges({{16, 64 << 10}, {0, 1}});
+
+USERVER_NAMESPACE_END
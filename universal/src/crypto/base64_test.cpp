@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include <userver/crypto/base64.hpp>
+#include <utils/simd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -17,6 +21,34 @@ TEST(Crypto, Base64) {
   EXPECT_EQ("U/8=", crypto::base64::Base64Encode("S\xff"));
 }
 
+TEST(Crypto, Base64AllInstructionSets) {
+  std::string data;
+  for (int i = 0; i < 200; ++i) data.push_back(static_cast<char>(i * 13));
+
+  utils::simd::SetMaxInstructionSet(utils::simd::InstructionSet::kNone);
+  std::vector<std::string> references;
+  for (std::size_t size = 0; size <= data.size(); ++size) {
+    references.push_back(crypto::base64::Base64Encode(data.substr(0, size)));
+  }
+
+  for (const auto instruction_set : utils::simd::kAllInstructionSets) {
+    utils::simd::SetMaxInstructionSet(instruction_set);
+    for (std::size_t size = 0; size <= data.size(); ++size) {
+      const auto source = data.substr(0, size);
+      const auto& encoded = references[size];
+      EXPECT_EQ(encoded, crypto::base64::Base64Encode(source));
+      EXPECT_EQ(source, crypto::base64::Base64Decode(encoded));
+
+      // the unknown characters are skipped
+      const auto middle = encoded.size() / 2;
+      const auto corrupted =
+          encoded.substr(0, middle) + "$\n" + encoded.substr(middle);
+      EXPECT_EQ(source, crypto::base64::Base64Decode(corrupted));
+    }
+  }
+  utils::simd::SetMaxInstructionSet(utils::simd::InstructionSet::kNeon);
+}
+
 #ifndef USERVER_NO_CRYPTOPP_BASE64_URL
 TEST(Crypto, Base64Url) {
   EXPECT_EQ("U_8=", crypto::base64::Base64UrlEncode("S\xff"));
@@ -0,0 +1,167 @@
+#include <userver/crypto/caching_verifier.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include <openssl/evp.h>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/datetime.hpp>
+
+#include <crypto/helpers.hpp>
+#include <crypto/openssl.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace crypto {
+namespace {
+
+constexpr std::size_t kShards = 16;
+
+// SHA-256 of the signature and the message, a collision means a forgery
+struct Digest final {
+  std::array<unsigned char, 32> bytes;
+
+  bool operator==(const Digest& other) const noexcept {
+    return bytes == other.bytes;
+  }
+};
+
+struct DigestHash {
+  std::size_t operator()(const Digest& digest) const noexcept {
+    // The bytes of the digest are uniformly distributed already
+    std::uint64_t value = 0;
+    std::memcpy(&value, digest.bytes.data(), sizeof(value));
+    return value;
+  }
+};
+
+Digest MakeDigest(std::initializer_list<std::string_view> data,
+                  std::string_view raw_signature) {
+  EvpMdCtx ctx;
+  // The size goes first, so that the border between the signature and the
+  // message is unambiguous
+  const std::uint64_t signature_size = raw_signature.size();
+  bool ok = 1 == EVP_DigestInit_ex(ctx.Get(), EVP_sha256(), nullptr) &&
+            1 == EVP_DigestUpdate(ctx.Get(), &signature_size,
+                                  sizeof(signature_size)) &&
+            1 == EVP_DigestUpdate(ctx.Get(), raw_signature.data(),
+                                  raw_signature.size());
+  for (const auto& part : data) {
+    ok = ok && 1 == EVP_DigestUpdate(ctx.Get(), part.data(), part.size());
+  }
+
+  Digest digest{};
+  unsigned int size = 0;
+  ok = ok && 1 == EVP_DigestFinal_ex(ctx.Get(), digest.bytes.data(), &size);
+  if (!ok || size != digest.bytes.size()) {
+    throw VerificationError(
+        FormatSslError("Failed to verify: failed to compute digest"));
+  }
+  return digest;
+}
+
+using TimePoint = std::chrono::system_clock::time_point;
+
+struct Shard final {
+  explicit Shard(std::size_t max_size) : expirations(max_size) {}
+
+  std::mutex mutex;
+  cache::LruMap<Digest, TimePoint, DigestHash> expirations;
+};
+
+}  // namespace
+
+struct CachingVerifier::Impl final {
+  explicit Impl(const CachingVerifierSettings& settings)
+      : max_ttl(settings.max_ttl) {
+    const auto shard_size =
+        std::max<std::size_t>((settings.max_size + kShards - 1) / kShards, 1);
+    shards.reserve(kShards);
+    for (std::size_t i = 0; i < kShards; ++i) {
+      shards.push_back(std::make_unique<Shard>(shard_size));
+    }
+  }
+
+  Shard& GetShard(const Digest& digest) noexcept {
+    // The bytes that are not used as a hash of the LRU map
+    return *shards[digest.bytes.back() % kShards];
+  }
+
+  const std::chrono::seconds max_ttl;
+  std::vector<std::unique_ptr<Shard>> shards;
+  std::atomic<std::uint64_t> hits{0};
+  std::atomic<std::uint64_t> misses{0};
+};
+
+CachingVerifier::CachingVerifier(std::shared_ptr<const Verifier> verifier,
+                                 const CachingVerifierSettings& settings)
+    : Verifier(verifier ? verifier->Name() : std::string{}),
+      verifier_(std::move(verifier)),
+      impl_(std::make_unique<Impl>(settings)) {
+  UINVARIANT(verifier_, "CachingVerifier requires a verifier");
+  UINVARIANT(settings.max_size > 0, "max_size must be positive");
+  impl::Openssl::Init();
+}
+
+CachingVerifier::~CachingVerifier() = default;
+
+void CachingVerifier::Verify(std::initializer_list<std::string_view> data,
+                             std::string_view raw_signature) const {
+  Verify(data, raw_signature, TimePoint::max());
+}
+
+void CachingVerifier::Verify(std::initializer_list<std::string_view> data,
+                             std::string_view raw_signature,
+                             TimePoint expires_at) const {
+  const auto now = utils::datetime::Now();
+  if (expires_at <= now) {
+    // Nothing to remember
+    ++impl_->misses;
+    verifier_->Verify(data, raw_signature);
+    return;
+  }
+
+  const auto digest = MakeDigest(data, raw_signature);
+  auto& shard = impl_->GetShard(digest);
+  {
+    const std::lock_guard lock{shard.mutex};
+    if (const auto* expiration = shard.expirations.Get(digest)) {
+      if (*expiration > now) {
+        ++impl_->hits;
+        return;
+      }
+      shard.expirations.Erase(digest);
+    }
+  }
+
+  ++impl_->misses;
+  verifier_->Verify(data, raw_signature);
+
+  const auto max_expires_at = now + impl_->max_ttl;
+  const std::lock_guard lock{shard.mutex};
+  shard.expirations.Put(digest, std::min(expires_at, max_expires_at));
+}
+
+void CachingVerifier::Clear() {
+  for (auto& shard : impl_->shards) {
+    const std::lock_guard lock{shard->mutex};
+    shard->expirations.Clear();
+  }
+}
+
+CachingVerifierStatistics CachingVerifier::GetStatistics() const noexcept {
+  CachingVerifierStatistics result;
+  result.hits = impl_->hits.load(std::memory_order_relaxed);
+  result.misses = impl_->misses.load(std::memory_order_relaxed);
+  return result;
+}
+
+}  // namespace crypto
+
+USERVER_NAMESPACE_END
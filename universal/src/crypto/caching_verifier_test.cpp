@@ -0,0 +1,140 @@
+#include <userver/crypto/caching_verifier.hpp>
+
+#include <atomic>
+#include <memory>
+
+#include <gtest/gtest.h>
+
+#include <userver/crypto/signers.hpp>
+#include <userver/utils/mock_now.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr auto kSecret = "secret";
+
+class CountingVerifier final : public crypto::Verifier {
+ public:
+  CountingVerifier() : crypto::Verifier("HS256"), verifier_(kSecret) {}
+
+  void Verify(std::initializer_list<std::string_view> data,
+              std::string_view raw_signature) const override {
+    ++calls;
+    verifier_.Verify(data, raw_signature);
+  }
+
+  mutable std::atomic<int> calls{0};
+
+ private:
+  crypto::VerifierHs256 verifier_;
+};
+
+}  // namespace
+
+TEST(CachingVerifier, Sample) {
+  /// [Sample crypto::CachingVerifier]
+  const crypto::CachingVerifier verifier{
+      std::make_shared<crypto::VerifierHs256>("secret")};
+  const auto signature = crypto::SignerHs256{"secret"}.Sign({"header.payload"});
+
+  // The first verification is done by crypto::VerifierHs256...
+  verifier.Verify({"header.payload"}, signature);
+  // ...the next ones are answered from the cache
+  verifier.Verify({"header.payload"}, signature);
+
+  EXPECT_EQ(verifier.Name(), "HS256");
+  EXPECT_EQ(verifier.GetStatistics().hits, 1);
+  EXPECT_EQ(verifier.GetStatistics().misses, 1);
+  /// [Sample crypto::CachingVerifier]
+}
+
+TEST(CachingVerifier, FailuresAreNotCached) {
+  auto counting = std::make_shared<CountingVerifier>();
+  const crypto::CachingVerifier verifier{counting};
+  const auto signature = crypto::SignerHs256{kSecret}.Sign({"message"});
+
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_THROW(verifier.Verify({"massage"}, signature),
+                 crypto::VerificationError);
+    EXPECT_THROW(verifier.Verify({"message"}, signature + "x"),
+                 crypto::VerificationError);
+  }
+  EXPECT_EQ(counting->calls, 6);
+
+  verifier.Verify({"message"}, signature);
+  verifier.Verify({"mess", "age"}, signature);
+  EXPECT_EQ(counting->calls, 7);
+}
+
+TEST(CachingVerifier, SignatureBorder) {
+  auto counting = std::make_shared<CountingVerifier>();
+  const crypto::CachingVerifier verifier{counting};
+  const auto signature = crypto::SignerHs256{kSecret}.Sign({"message"});
+  verifier.Verify({"message"}, signature);
+
+  // Moving the bytes between the signature and the message is not a hit
+  const auto last = signature.substr(signature.size() - 1);
+  EXPECT_THROW(
+      verifier.Verify({last, "message"},
+                      signature.substr(0, signature.size() - 1)),
+      crypto::VerificationError);
+  EXPECT_EQ(counting->calls, 2);
+}
+
+TEST(CachingVerifier, Expiration) {
+  const auto now = std::chrono::system_clock::now();
+  utils::datetime::MockNowSet(now);
+
+  auto counting = std::make_shared<CountingVerifier>();
+  const crypto::CachingVerifier verifier{counting,
+                                         {10, std::chrono::seconds{60}}};
+  const auto signature = crypto::SignerHs256{kSecret}.Sign({"message"});
+
+  verifier.Verify({"message"}, signature, now + std::chrono::seconds{10});
+  verifier.Verify({"message"}, signature, now + std::chrono::seconds{10});
+  EXPECT_EQ(counting->calls, 1);
+
+  utils::datetime::MockSleep(std::chrono::seconds{10});
+  verifier.Verify({"message"}, signature, now + std::chrono::seconds{10});
+  verifier.Verify({"message"}, signature, now + std::chrono::seconds{10});
+  EXPECT_EQ(counting->calls, 3);
+
+  // Not longer than max_ttl
+  verifier.Verify({"message"}, signature);
+  utils::datetime::MockSleep(std::chrono::seconds{59});
+  verifier.Verify({"message"}, signature);
+  EXPECT_EQ(counting->calls, 4);
+  utils::datetime::MockSleep(std::chrono::seconds{1});
+  verifier.Verify({"message"}, signature);
+  EXPECT_EQ(counting->calls, 5);
+
+  utils::datetime::MockNowUnset();
+}
+
+TEST(CachingVerifier, Bounded) {
+  auto counting = std::make_shared<CountingVerifier>();
+  crypto::CachingVerifier verifier{counting, {1, std::chrono::seconds{60}}};
+  const crypto::SignerHs256 signer{kSecret};
+
+  constexpr int kMessages = 1000;
+  for (int i = 0; i < kMessages; ++i) {
+    const auto message = std::to_string(i);
+    verifier.Verify({message}, signer.Sign({message}));
+  }
+  for (int i = 0; i < kMessages; ++i) {
+    const auto message = std::to_string(i);
+    verifier.Verify({message}, signer.Sign({message}));
+  }
+  // There is an element per shard at most
+  EXPECT_GE(counting->calls, 2 * kMessages - 16);
+
+  const auto signature = signer.Sign({"message"});
+  verifier.Verify({"message"}, signature);
+  verifier.Clear();
+  const auto calls = counting->calls.load();
+  verifier.Verify({"message"}, signature);
+  EXPECT_EQ(counting->calls, calls + 1);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,81 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <string>
+
+#include <userver/decimal64/decimal64.hpp>
+#include <userver/formats/json/string_builder.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Dec4 = decimal64::Decimal<4>;
+
+const std::array<Dec4, 4> kValues{Dec4{"1234.5678"}, Dec4{"-0.0042"},
+                                  Dec4{"99999.9999"}, Dec4{"17"}};
+
+}  // namespace
+
+void DecimalMultiply(benchmark::State& state) {
+  const Dec4 factor{"1.0375"};
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto value : kValues) {
+      benchmark::DoNotOptimize(value * factor);
+    }
+  }
+}
+BENCHMARK(DecimalMultiply);
+
+void DecimalMultiplyLarge(benchmark::State& state) {
+  // The product does not fit into 64 bits
+  const Dec4 value{"123456789.1234"};
+  const Dec4 factor{"1234.5678"};
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(value * factor);
+  }
+}
+BENCHMARK(DecimalMultiplyLarge);
+
+void DecimalDivide(benchmark::State& state) {
+  const Dec4 divisor{"3.3333"};
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto value : kValues) {
+      benchmark::DoNotOptimize(value / divisor);
+    }
+  }
+}
+BENCHMARK(DecimalDivide);
+
+void DecimalToString(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto value : kValues) {
+      benchmark::DoNotOptimize(decimal64::ToString(value));
+    }
+  }
+}
+BENCHMARK(DecimalToString);
+
+void DecimalToChars(benchmark::State& state) {
+  decimal64::CharsBuffer buffer;
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto value : kValues) {
+      benchmark::DoNotOptimize(decimal64::ToChars(value, buffer));
+    }
+  }
+}
+BENCHMARK(DecimalToChars);
+
+void DecimalWriteToJsonStream(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    formats::json::StringBuilder sb;
+    {
+      const formats::json::StringBuilder::ArrayGuard guard{sb};
+      for (const auto value : kValues) WriteToStream(value, sb);
+    }
+    benchmark::DoNotOptimize(sb.GetString());
+  }
+}
+BENCHMARK(DecimalWriteToJsonStream);
+
+USERVER_NAMESPACE_END
@@ -35,6 +35,26 @@ TEST(Decimal64, ToString) {
   EXPECT_EQ(decimal64::ToString(decimal64::Decimal<0>{"1"}), "1");
 }
 
+TEST(Decimal64, ToChars) {
+  decimal64::CharsBuffer buffer;
+  EXPECT_EQ(decimal64::ToChars(Dec4{"-12.34"}, buffer), "-12.34");
+  EXPECT_EQ(decimal64::ToChars(Dec4{"0"}, buffer), "0");
+
+  using Dec18 = decimal64::Decimal<18>;
+  EXPECT_EQ(decimal64::ToChars(Dec18::FromUnbiased(
+                                   std::numeric_limits<int64_t>::min() + 1),
+                               buffer),
+            "-9.223372036854775807");
+  EXPECT_EQ(decimal64::ToChars(Dec18::FromUnbiased(-1), buffer),
+            "-0.000000000000000001");
+
+  using Dec0 = decimal64::Decimal<0>;
+  EXPECT_EQ(decimal64::ToChars(
+                Dec0::FromUnbiased(std::numeric_limits<int64_t>::min() + 1),
+                buffer),
+            "-9223372036854775807");
+}
+
 TEST(Decimal64, ToStringFormatOptions) {
   // clang-format off
   Dec4 dec4{"1034.1234"};
@@ -62,6 +62,30 @@ TYPED_TEST(Decimal64Round, ToDouble) {
   }
 }
 
+TYPED_TEST(Decimal64Round, MulDiv) {
+  using RoundPolicy = typename TestFixture::Dec::RoundPolicy;
+  // The products that fit into 64 bits take the fast path
+  const auto reference = [](int64_t value1, int64_t value2, int64_t divisor) {
+    const auto prod = static_cast<__int128_t>(value1) * value2;
+    const auto whole = static_cast<int64_t>(prod / divisor);
+    const auto rem = static_cast<int64_t>(prod % divisor);
+    return whole +
+           decimal64::impl::Div<RoundPolicy>(rem, divisor, whole % 2 != 0);
+  };
+
+  for (const int64_t value1 : {0L, 1L, -1L, 5L, -5L, 15L, 25L, -35L,
+                               1'234'567L, -987'654'321L, 3'037'000'499L}) {
+    for (const int64_t value2 : {1L, -1L, 3L, 5L, -7L, 10'000L, 3'037'000'499L,
+                                 -3'037'000'500L}) {
+      for (const int64_t divisor : {1L, -1L, 2L, -2L, 3L, 10L, 10'000L}) {
+        EXPECT_EQ(decimal64::impl::MulDiv<RoundPolicy>(value1, value2, divisor),
+                  reference(value1, value2, divisor))
+            << value1 << " * " << value2 << " / " << divisor;
+      }
+    }
+  }
+}
+
 TEST(Decimal64, DefaultValue) { ASSERT_EQ(Dec4{}, Dec4{0}); }
 
 TEST(Decimal64, DefaultRoundingPolicy) {
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/formats/json/aggregates.hpp>
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/lazy_value.hpp>
+#include <userver/formats/json/parser/parser.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+/// [Sample formats::json::AggregateFields usage]
+namespace sample {
+
+struct Point {
+  int x{0};
+  int y{0};
+};
+
+struct Shape {
+  std::string name;
+  std::vector<Point> points;
+  std::optional<double> area;
+  std::map<std::string, std::int64_t> tags;
+};
+
+}  // namespace sample
+
+template <>
+struct formats::json::AggregateFields<sample::Point> {
+  static constexpr std::string_view kNames[] = {"x", "y"};
+};
+
+template <>
+struct formats::json::AggregateFields<sample::Shape> {
+  static constexpr std::string_view kNames[] = {"name", "points", "area",
+                                                "tags"};
+};
+/// [Sample formats::json::AggregateFields usage]
+
+namespace sample {
+
+bool operator==(const Point& lhs, const Point& rhs) {
+  return lhs.x == rhs.x && lhs.y == rhs.y;
+}
+
+bool operator==(const Shape& lhs, const Shape& rhs) {
+  return lhs.name == rhs.name && lhs.points == rhs.points &&
+         lhs.area == rhs.area && lhs.tags == rhs.tags;
+}
+
+// Has no SAX parser and is parsed via formats::json::Value
+struct Color {
+  std::string value;
+};
+
+Color Parse(const formats::json::Value& value, formats::parse::To<Color>) {
+  return {"#" + value.As<std::string>()};
+}
+
+struct Pixel {
+  Point point;
+  Color color;
+  std::optional<Color> background;
+  formats::json::Value extra;
+};
+
+}  // namespace sample
+
+template <>
+struct formats::json::AggregateFields<sample::Pixel> {
+  static constexpr std::string_view kNames[] = {"point", "color",
+                                                "background", "extra"};
+};
+
+namespace {
+
+using sample::Pixel;
+using sample::Point;
+using sample::Shape;
+
+namespace fjp = formats::json::parser;
+
+template <typename T>
+T ParseSax(std::string_view input) {
+  return fjp::ParseToType<T, fjp::AggregateParser<T>>(input);
+}
+
+constexpr std::string_view kShape =
+    R"({"name":"triangle","points":[{"x":0,"y":0},{"x":3,"y":0},)"
+    R"({"x":0,"y":4}],"area":6.0,"tags":{"a":1,"b":-2}})";
+
+const Shape kExpectedShape{
+    "triangle", {{0, 0}, {3, 0}, {0, 4}}, 6.0, {{"a", 1}, {"b", -2}}};
+
+}  // namespace
+
+TEST(FormatsJsonAggregates, Parse) {
+  const auto json = formats::json::FromString(kShape);
+  EXPECT_EQ(json.As<Shape>(), kExpectedShape);
+
+  const formats::json::LazyDocument doc{kShape};
+  EXPECT_EQ(doc.GetRoot().As<Shape>(), kExpectedShape);
+
+  const auto no_area = formats::json::FromString(
+      R"({"name":"","points":[],"tags":{},"unknown":[1]})");
+  EXPECT_EQ(no_area.As<Shape>().area, std::nullopt);
+
+  EXPECT_THROW(formats::json::FromString(R"({"name":"","points":[]})")
+                   .As<Shape>(),
+               formats::json::MemberMissingException);
+  EXPECT_THROW(formats::json::FromString("[]").As<Point>(),
+               formats::json::TypeMismatchException);
+}
+
+TEST(FormatsJsonAggregates, Serialize) {
+  const auto json = formats::json::ValueBuilder{kExpectedShape}.ExtractValue();
+  EXPECT_EQ(json, formats::json::FromString(kShape));
+
+  Shape shape = kExpectedShape;
+  shape.area.reset();
+  const auto no_area = formats::json::ValueBuilder{shape}.ExtractValue();
+  EXPECT_FALSE(no_area.HasMember("area"));
+  EXPECT_EQ(no_area.As<Shape>(), shape);
+}
+
+TEST(FormatsJsonAggregates, WriteToStream) {
+  formats::json::StringBuilder sw;
+  WriteToStream(kExpectedShape, sw);
+  EXPECT_EQ(sw.GetString(), kShape);
+
+  Shape shape = kExpectedShape;
+  shape.area.reset();
+  formats::json::StringBuilder sw_no_area;
+  WriteToStream(shape, sw_no_area);
+  EXPECT_EQ(formats::json::FromString(sw_no_area.GetString()).As<Shape>(),
+            shape);
+}
+
+TEST(FormatsJsonAggregates, SaxParser) {
+  /// [Sample formats::json::parser::AggregateParser usage]
+  namespace fjp = formats::json::parser;
+  const auto shape =
+      fjp::ParseToType<Shape, fjp::AggregateParser<Shape>>(kShape);
+  /// [Sample formats::json::parser::AggregateParser usage]
+  EXPECT_EQ(shape, kExpectedShape);
+
+  const auto skipped = ParseSax<Shape>(
+      R"({"unknown":{"a":[1,{"b":null}]},"name":"","points":[],"area":null,)"
+      R"("tags":{},"other":"x"})");
+  EXPECT_EQ(skipped.area, std::nullopt);
+
+  const auto pixel = ParseSax<Pixel>(
+      R"({"point":{"x":1,"y":2},"color":"fff","background":"000",)"
+      R"("extra":{"a":["b"]}})");
+  EXPECT_EQ(pixel.point, (Point{1, 2}));
+  EXPECT_EQ(pixel.color.value, "#fff");
+  ASSERT_TRUE(pixel.background);
+  EXPECT_EQ(pixel.background->value, "#000");
+  EXPECT_EQ(pixel.extra, formats::json::FromString(R"({"a":["b"]})"));
+}
+
+TEST(FormatsJsonAggregates, SaxParserReuse) {
+  fjp::AggregateParser<Pixel> parser;
+  fjp::ParserState state;
+  Pixel result;
+  fjp::SubscriberSink<Pixel> sink{result};
+  parser.Subscribe(sink);
+
+  for (const auto* color : {"123", "456"}) {
+    parser.Reset();
+    state.PushParser(parser);
+    state.ProcessInput(fmt::format(
+        R"({{"point":{{"x":1,"y":2}},"color":"{}","extra":["{}"]}})", color,
+        color));
+    EXPECT_EQ(result.color.value, std::string{"#"} + color);
+    EXPECT_EQ(result.extra[0].As<std::string>(), color);
+    EXPECT_FALSE(result.background);
+  }
+}
+
+TEST(FormatsJsonAggregates, SaxParserErrors) {
+  EXPECT_THROW(ParseSax<Shape>(R"({"name":"","points":[]})"), fjp::ParseError);
+  EXPECT_THROW(ParseSax<Point>(R"({"x":1,"y":"2"})"), fjp::ParseError);
+  EXPECT_THROW(ParseSax<Point>("[]"), fjp::ParseError);
+
+  try {
+    ParseSax<Shape>(R"({"name":"","points":[{"x":1}],"tags":{}})");
+    FAIL() << "expected exception";
+  } catch (const fjp::ParseError& e) {
+    EXPECT_EQ(std::string{e.what()},
+              "Parse error at pos 27, path 'points.[0]': Missing required "
+              "field 'y'");
+  }
+}
+
+USERVER_NAMESPACE_END
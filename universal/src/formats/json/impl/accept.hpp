@@ -1,13 +1,16 @@
 #pragma once
 
+#include <cstddef>
 #include <string_view>
+#include <utility>
 #include <variant>
 
 #include <rapidjson/document.h>
-#include <rapidjson/writer.h>
 #include <boost/container/small_vector.hpp>
 
 #include <formats/json/impl/types_impl.hpp>
+#include <formats/json/impl/writer.hpp>
+#include <userver/utils/meta_light.hpp>
 #include <userver/utils/overloaded.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -108,6 +111,29 @@ bool WriteEnd(Handler& handler, const Cell& cell) {
 
 void InplaceSortObjectChildren(impl::Value& value);
 
+// Binary formats write the sizes of the containers before their elements
+template <typename Handler>
+using HasSizedStart =
+    decltype(std::declval<Handler&>().StartObject(std::size_t{}));
+
+template <typename Handler>
+bool WriteStartObject(Handler& handler, const impl::Value& value) {
+  if constexpr (meta::kIsDetected<HasSizedStart, Handler>) {
+    return handler.StartObject(value.MemberCount());
+  } else {
+    return handler.StartObject();
+  }
+}
+
+template <typename Handler>
+bool WriteStartArray(Handler& handler, const impl::Value& value) {
+  if constexpr (meta::kIsDetected<HasSizedStart, Handler>) {
+    return handler.StartArray(value.Size());
+  } else {
+    return handler.StartArray();
+  }
+}
+
 template <ObjectProcessing kProcessing>
 void EmplaceObject(Stack<kProcessing>& stack,
                    typename ValueTypes<kProcessing>::Value& value) {
@@ -148,10 +174,10 @@ bool WriteStartAndEnterValue(Stack<kProcessing>& stack, Handler& handler) {
   }
 
   if (value.IsObject()) {
-    was_written = handler.StartObject();
+    was_written = WriteStartObject(handler, value);
     EmplaceObject(stack, value);
   } else if (value.IsArray()) {
-    was_written = handler.StartArray();
+    was_written = WriteStartArray(handler, value);
     EmplaceArray(stack, value);
   } else {
     was_written = value.Accept(handler);
@@ -0,0 +1,112 @@
+#include <formats/json/impl/allocator.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <new>
+
+#include <userver/compiler/thread_local.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+namespace {
+
+// rapidjson requires 8-byte alignment of the nodes (RAPIDJSON_ALIGN)
+constexpr std::size_t kAlignment = 8;
+constexpr std::size_t kMinChunkSize = 4 * 1024;
+constexpr std::size_t kMaxChunkSize = 4 * 1024 * 1024;
+
+// Lets Free() skip the thread-local lookup if no arena documents are being
+// parsed in the process, which is the usual case
+std::atomic<std::size_t> global_arena_parses{0};
+
+compiler::ThreadLocal local_arena_parses = [] { return 0; };
+
+constexpr std::size_t AlignUp(std::size_t size) noexcept {
+  return (size + kAlignment - 1) & ~(kAlignment - 1);
+}
+
+}  // namespace
+
+Arena::Arena(std::size_t size_hint)
+    : next_chunk_size_(std::clamp(size_hint, kMinChunkSize, kMaxChunkSize)) {}
+
+Arena::~Arena() {
+  for (void* chunk : chunks_) std::free(chunk);
+}
+
+void* Arena::Allocate(std::size_t size) {
+  size = AlignUp(size);
+  if (size > left_) {
+    // Big allocations get their own chunks, so that the rest of the current
+    // chunk is not wasted
+    if (size > next_chunk_size_ / 4) return AllocateChunk(size);
+
+    current_ = static_cast<char*>(AllocateChunk(next_chunk_size_));
+    left_ = next_chunk_size_;
+    next_chunk_size_ = std::min(next_chunk_size_ * 2, kMaxChunkSize);
+  }
+
+  void* result = current_;
+  current_ += size;
+  left_ -= size;
+  return result;
+}
+
+std::size_t Arena::GetCapacity() const noexcept { return capacity_; }
+
+void* Arena::AllocateChunk(std::size_t size) {
+  chunks_.reserve(chunks_.size() + 1);
+  void* chunk = std::malloc(size);
+  if (!chunk) throw std::bad_alloc{};
+  chunks_.push_back(chunk);
+  capacity_ += size;
+  return chunk;
+}
+
+void* Allocator::Realloc(void* original_ptr, std::size_t original_size,
+                         std::size_t new_size) {
+  if (!arena_) {
+    UASSERT(!IsArenaParseInProgress());
+    if (new_size == 0) {
+      std::free(original_ptr);
+      return nullptr;
+    }
+    return std::realloc(original_ptr, new_size);
+  }
+
+  if (!original_ptr) return Malloc(new_size);
+  if (new_size <= original_size) return original_ptr;
+
+  void* result = arena_->Allocate(new_size);
+  std::memcpy(result, original_ptr, original_size);
+  return result;
+}
+
+bool Allocator::IsArenaParseInProgress() noexcept {
+  if (global_arena_parses.load(std::memory_order_relaxed) == 0) return false;
+  auto arena_parses = local_arena_parses.Use();
+  return *arena_parses != 0;
+}
+
+ArenaParseScope::ArenaParseScope() noexcept {
+  // The thread-local counter is incremented first, so that a Free() that sees
+  // the global counter also sees the local one on this thread
+  auto arena_parses = local_arena_parses.Use();
+  ++*arena_parses;
+  global_arena_parses.fetch_add(1, std::memory_order_relaxed);
+}
+
+ArenaParseScope::~ArenaParseScope() {
+  global_arena_parses.fetch_sub(1, std::memory_order_relaxed);
+  auto arena_parses = local_arena_parses.Use();
+  UASSERT(*arena_parses > 0);
+  --*arena_parses;
+}
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include <userver/formats/json/impl/types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json::impl {
+
+/// Monotonic buffer for all the nodes of a document. The memory is released
+/// at once on destruction, separate nodes are never freed.
+class Arena final {
+ public:
+  /// @param size_hint expected number of bytes to allocate
+  explicit Arena(std::size_t size_hint);
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  ~Arena();
+
+  void* Allocate(std::size_t size);
+
+  /// Total size of the allocated chunks, for tests and benchmarks
+  std::size_t GetCapacity() const noexcept;
+
+ private:
+  void* AllocateChunk(std::size_t size);
+
+  std::vector<void*> chunks_;
+  std::size_t next_chunk_size_;
+  std::size_t capacity_{0};
+  char* current_{nullptr};
+  std::size_t left_{0};
+};
+
+/// Allocator of the formats::json::Value nodes, rapidjson Allocator concept.
+///
+/// Allocates from the heap by default, or from the arena if it was
+/// constructed with one. GenericValue frees the nodes via the static Free(),
+/// so the nodes of arena documents must never be freed: such documents are
+/// immutable and are destroyed without visiting the nodes, and Free() is
+/// a no-op while an arena document is being parsed (see ArenaParseScope).
+class Allocator final {
+ public:
+  static constexpr bool kNeedFree = true;
+
+  Allocator() noexcept = default;
+  explicit Allocator(Arena& arena) noexcept : arena_(&arena) {}
+
+  void* Malloc(std::size_t size) {
+    if (!size) return nullptr;
+    return arena_ ? arena_->Allocate(size) : std::malloc(size);
+  }
+
+  void* Realloc(void* original_ptr, std::size_t original_size,
+                std::size_t new_size);
+
+  static void Free(void* ptr) noexcept {
+    if (!IsArenaParseInProgress()) std::free(ptr);
+  }
+
+  bool operator==(const Allocator& other) const noexcept {
+    return arena_ == other.arena_;
+  }
+  bool operator!=(const Allocator& other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  static bool IsArenaParseInProgress() noexcept;
+
+  friend class ArenaParseScope;
+
+  Arena* arena_{nullptr};
+};
+
+/// While alive, Allocator::Free() does nothing on the current thread, so
+/// rapidjson may drop the partially parsed arena document on errors. Must not
+/// span coroutine switches.
+class ArenaParseScope final {
+ public:
+  ArenaParseScope() noexcept;
+  ~ArenaParseScope();
+
+  ArenaParseScope(const ArenaParseScope&) = delete;
+  ArenaParseScope& operator=(const ArenaParseScope&) = delete;
+};
+
+}  // namespace formats::json::impl
+
+USERVER_NAMESPACE_END
@@ -1,7 +1,9 @@
 #include "json_tree.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
+#include <string_view>
 
 #include <rapidjson/document.h>
 
@@ -54,6 +56,11 @@ bool ProcessContainer(formats::json::impl::TreeStack& stack,
   }
   return false;
 }
+
+std::string_view AsStringView(const Value& jval) {
+  return {jval.GetString(), jval.GetStringLength()};
+}
+
 }  // namespace
 
 namespace formats::json::impl {
@@ -111,6 +118,52 @@ std::string ExtractPath(const TreeStack& stack) {
 
   return path.empty() ? common::kPathRoot : path;
 }
+
+void CheckKeyUniqueness(const Value* root) {
+  using KeysStack = boost::container::small_vector<std::string_view,
+                                                   kInitialStackDepth>;
+
+  TreeStack stack;
+  const Value* value = root;
+
+  stack.emplace_back();  // fake "top" frame to avoid extra checks for an empty
+                         // stack inside walker loop
+  KeysStack keys;
+  for (;;) {
+    stack.back().Advance();
+    if (value->IsObject()) {
+      const std::size_t count = value->MemberCount();
+      const auto begin = value->MemberBegin();
+      if (count > keys.size()) {
+        keys.resize(count);
+      }
+      for (std::size_t i = 0; i < count; ++i) {
+        keys[i] = AsStringView(begin[i].name);
+      }
+      std::sort(keys.begin(), keys.begin() + count);
+      const auto* cons_eq_element =
+          std::adjacent_find(keys.data(), keys.data() + count);
+      if (cons_eq_element != keys.data() + count) {
+        throw ParseException("Duplicate key: " + std::string(*cons_eq_element) +
+                             " at " + ExtractPath(stack));
+      }
+    }
+
+    if ((value->IsObject() && value->MemberCount() > 0) ||
+        (value->IsArray() && value->Size() > 0)) {
+      // descend
+      stack.emplace_back(value);
+    } else {
+      while (!stack.back().HasMoreElements()) {
+        stack.pop_back();
+        if (stack.empty()) return;
+      }
+    }
+
+    value = stack.back().CurrentValue();
+  }
+}
+
 }  // namespace formats::json::impl
 
 USERVER_NAMESPACE_END
@@ -5,6 +5,7 @@
 #include <rapidjson/document.h>
 #include <boost/container/small_vector.hpp>
 
+#include <formats/json/impl/allocator.hpp>
 #include <userver/formats/json/impl/types.hpp>
 #include <userver/utils/assert.hpp>
 
@@ -74,6 +75,8 @@ using TreeStack =
 std::string MakePath(const Value* root, const Value* node, int node_depth);
 /// Transform nodes onto stack into string
 std::string ExtractPath(const TreeStack& stack);
+/// Throw ParseException if some object of the `root` tree has duplicate keys
+void CheckKeyUniqueness(const Value* root);
 }  // namespace formats::json::impl
 
 USERVER_NAMESPACE_END
@@ -10,9 +10,14 @@ VersionedValuePtr::Data::Data(Document&& doc)
     : Data(static_cast<Value&&>(doc)) {
   static_assert(
       // NOLINTNEXTLINE(misc-redundant-expression)
-      std::is_same_v<::rapidjson::CrtAllocator, Value::AllocatorType> &&
-          std::is_same_v<::rapidjson::CrtAllocator, Document::AllocatorType>,
-      "Both Document and Value must use CrtAllocator for the fast move");
+      std::is_same_v<Allocator, Value::AllocatorType> &&
+          std::is_same_v<Allocator, Document::AllocatorType>,
+      "Both Document and Value must use the same allocator for the fast move");
+}
+
+VersionedValuePtr::Data::Data(Document&& doc, std::unique_ptr<Arena>&& arena)
+    : Data(std::move(doc)) {
+  this->arena = std::move(arena);
 }
 
 VersionedValuePtr::VersionedValuePtr() noexcept = default;
@@ -26,6 +31,10 @@ VersionedValuePtr::operator bool() const { return !!data_; }
 
 bool VersionedValuePtr::IsUnique() const { return data_.use_count() == 1; }
 
+bool VersionedValuePtr::IsArenaAllocated() const {
+  return data_ && data_->arena;
+}
+
 const Value* VersionedValuePtr::Get() const {
   return data_ ? &data_->native : nullptr;
 }
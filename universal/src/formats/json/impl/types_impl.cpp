@@ -1,5 +1,6 @@
 #include <formats/json/impl/types_impl.hpp>
 
+#include <new>
 #include <utility>
 
 #include <userver/utils/assert.hpp>
@@ -99,6 +100,12 @@ void DestroyMembersIteratively(Value&& native) noexcept {
 }  // namespace
 
 VersionedValuePtr::Data::~Data() {
+  if (arena) {
+    // The nodes are released with the arena at once. Overwriting the root
+    // without destroying it skips the traversal of the whole document.
+    ::new (static_cast<void*>(&native)) Value();
+    return;
+  }
   DestroyMembersIteratively(std::move(native));
 }
 
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 
 #include <rapidjson/document.h>
 
+#include <formats/json/impl/allocator.hpp>
 #include <userver/formats/json/impl/types.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -18,11 +20,17 @@ struct VersionedValuePtr::Data {
   // https://github.com/Tencent/rapidjson/issues/387
   explicit Data(Document&&);
 
+  // the nodes of the document are allocated from the arena
+  Data(Document&&, std::unique_ptr<Arena>&& arena);
+
   ~Data();
 
   // native rapidjson value
   Value native;
 
+  // owns the nodes of immutable documents parsed with an arena
+  std::unique_ptr<Arena> arena;
+
   // version of internal rapidjson structures (member arrays)
   // used in ValueBuilder to avoid UAF, ignored in read-only Value
   std::atomic<size_t> version{0};
@@ -0,0 +1,39 @@
+#pragma once
+
+// Must be included instead of <rapidjson/writer.h>, so that every
+// instantiation of rapidjson::Writer<rapidjson::StringBuffer> sees the
+// specialization below.
+
+#include <cstring>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include <utils/impl/byte_scan.hpp>
+
+// rapidjson provides its own SSE/NEON specializations if configured with them
+#if !defined(RAPIDJSON_SSE2) && !defined(RAPIDJSON_SSE42) && \
+    !defined(RAPIDJSON_NEON)
+
+RAPIDJSON_NAMESPACE_BEGIN
+
+// Copies the characters that need no escaping in bulk, the default
+// implementation handles them one by one. Writer::WriteString reserves the
+// space for the whole escaped string in advance, so PushUnsafe is fine.
+template <>
+inline bool Writer<StringBuffer>::ScanWriteUnescapedString(StringStream& is,
+                                                           size_t length) {
+  const char* const end = is.head_ + length;
+  const char* const unescaped_end =
+      USERVER_NAMESPACE::utils::impl::FindJsonEscapeCandidate(is.src_, end);
+
+  const auto count = static_cast<size_t>(unescaped_end - is.src_);
+  if (count != 0) std::memcpy(os_->PushUnsafe(count), is.src_, count);
+
+  is.src_ = unescaped_end;
+  return unescaped_end != end;
+}
+
+RAPIDJSON_NAMESPACE_END
+
+#endif
@@ -0,0 +1,665 @@
+#include <userver/formats/json/lazy_value.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <fmt/format.h>
+#include <rapidjson/document.h>
+
+#include <formats/json/impl/exttypes.hpp>
+#include <userver/formats/common/path.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::json {
+
+namespace {
+
+using impl::LazyToken;
+using impl::LazyTokenType;
+
+constexpr std::uint32_t kMaxDocumentSize =
+    std::numeric_limits<std::uint32_t>::max();
+
+bool IsDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+bool IsHexDigit(char c) noexcept {
+  return IsDigit(c) || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+bool IsHighSurrogate(unsigned codepoint) noexcept {
+  return codepoint >= 0xD800 && codepoint <= 0xDBFF;
+}
+
+bool IsLowSurrogate(unsigned codepoint) noexcept {
+  return codepoint >= 0xDC00 && codepoint <= 0xDFFF;
+}
+
+// Builds the structural index of the document and validates it in a single
+// pass. Unlike rapidjson, it neither decodes the strings nor converts the
+// numbers, that is done by LazyValue on access.
+class Indexer final {
+ public:
+  Indexer(std::string_view doc, std::vector<LazyToken>& tokens)
+      : doc_(doc), tokens_(tokens) {}
+
+  void Run() {
+    SkipWhitespace();
+    if (AtEnd()) Fail("The document is empty.");
+
+    bool expect_value = true;
+    while (true) {
+      if (expect_value) {
+        if (!ParseValue()) continue;
+      }
+      expect_value = false;
+      if (stack_.empty()) break;
+
+      auto& parent = tokens_[stack_.back()];
+      ++parent.size;
+      SkipWhitespace();
+      const char c = Peek();
+      if (parent.type == LazyTokenType::kArray) {
+        if (c == ',') {
+          ++pos_;
+          expect_value = true;
+        } else if (c == ']') {
+          CloseContainer();
+        } else {
+          Fail("Missing a comma or ']' after an array element.");
+        }
+      } else {
+        if (c == ',') {
+          ++pos_;
+          ParseKey();
+          expect_value = true;
+        } else if (c == '}') {
+          CloseContainer();
+        } else {
+          Fail("Missing a comma or '}' after an object member.");
+        }
+      }
+    }
+
+    SkipWhitespace();
+    if (!AtEnd()) {
+      Fail("The document root must not be followed by other values.");
+    }
+  }
+
+ private:
+  bool AtEnd() const noexcept { return pos_ == doc_.size(); }
+
+  char Peek() const noexcept { return AtEnd() ? '\0' : doc_[pos_]; }
+
+  void SkipWhitespace() noexcept {
+    while (!AtEnd()) {
+      const char c = doc_[pos_];
+      if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+      ++pos_;
+    }
+  }
+
+  [[noreturn]] void Fail(std::string_view reason) const {
+    const auto offset = std::min(pos_, doc_.size());
+    const auto line = 1 + std::count(doc_.begin(), doc_.begin() + offset, '\n');
+    const auto from_pos = doc_.substr(0, offset).find_last_of('\n');
+    const auto column = offset > from_pos ? offset - from_pos : offset + 1;
+
+    throw ParseException(
+        fmt::format("JSON parse error at line {} column {}: {}", line, column,
+                    reason));
+  }
+
+  std::uint32_t AddToken(LazyTokenType type, std::size_t begin) {
+    const auto index = static_cast<std::uint32_t>(tokens_.size());
+    tokens_.push_back(LazyToken{static_cast<std::uint32_t>(begin),
+                                static_cast<std::uint32_t>(pos_), index + 1, 0,
+                                type});
+    return index;
+  }
+
+  // Returns false if a container was opened and a value of its first element
+  // or member is expected next
+  bool ParseValue() {
+    SkipWhitespace();
+    const auto begin = pos_;
+    switch (Peek()) {
+      case '{':
+      case '[': {
+        const bool is_object = doc_[pos_] == '{';
+        stack_.push_back(AddToken(
+            is_object ? LazyTokenType::kObject : LazyTokenType::kArray, begin));
+        ++pos_;
+        SkipWhitespace();
+        if (Peek() == (is_object ? '}' : ']')) {
+          CloseContainer();
+          return true;
+        }
+        if (is_object) ParseKey();
+        return false;
+      }
+      case '"':
+        AddToken(ParseString(), begin);
+        return true;
+      case 'n':
+        ParseLiteral("null");
+        AddToken(LazyTokenType::kNull, begin);
+        return true;
+      case 't':
+        ParseLiteral("true");
+        AddToken(LazyTokenType::kTrue, begin);
+        return true;
+      case 'f':
+        ParseLiteral("false");
+        AddToken(LazyTokenType::kFalse, begin);
+        return true;
+      default:
+        ParseNumber();
+        AddToken(LazyTokenType::kNumber, begin);
+        return true;
+    }
+  }
+
+  void CloseContainer() {
+    auto& token = tokens_[stack_.back()];
+    stack_.pop_back();
+    ++pos_;
+    token.end = static_cast<std::uint32_t>(pos_);
+    token.next = static_cast<std::uint32_t>(tokens_.size());
+  }
+
+  void ParseKey() {
+    SkipWhitespace();
+    if (Peek() != '"') Fail("Missing a name for object member.");
+    const auto begin = pos_;
+    AddToken(ParseString(), begin);
+    SkipWhitespace();
+    if (Peek() != ':') Fail("Missing a colon after a name of object member.");
+    ++pos_;
+  }
+
+  void ParseLiteral(std::string_view literal) {
+    if (doc_.substr(pos_, literal.size()) != literal) Fail("Invalid value.");
+    pos_ += literal.size();
+  }
+
+  void ParseDigits() {
+    if (!IsDigit(Peek())) Fail("Missing digits in the number.");
+    while (IsDigit(Peek())) ++pos_;
+  }
+
+  void ParseNumber() {
+    if (Peek() == '-') ++pos_;
+    if (Peek() == '0') {
+      ++pos_;
+    } else if (IsDigit(Peek())) {
+      ParseDigits();
+    } else {
+      Fail("Invalid value.");
+    }
+
+    if (Peek() == '.') {
+      ++pos_;
+      ParseDigits();
+    }
+    if (Peek() == 'e' || Peek() == 'E') {
+      ++pos_;
+      if (Peek() == '+' || Peek() == '-') ++pos_;
+      ParseDigits();
+    }
+  }
+
+  unsigned ParseHex4() {
+    unsigned codepoint = 0;
+    for (int i = 0; i < 4; ++i) {
+      const char c = Peek();
+      if (!IsHexDigit(c)) {
+        Fail("Incorrect hex digit after \\u escape in string.");
+      }
+      codepoint = codepoint * 16 +
+                  (IsDigit(c) ? c - '0' : (c | 0x20) - 'a' + 10);
+      ++pos_;
+    }
+    return codepoint;
+  }
+
+  LazyTokenType ParseString() {
+    ++pos_;  // opening quote
+    bool has_escapes = false;
+    while (true) {
+      if (AtEnd()) Fail("Missing a closing quotation mark in string.");
+      const auto c = static_cast<unsigned char>(doc_[pos_]);
+      if (c == '"') break;
+      if (c < 0x20) Fail("Invalid encoding in string.");
+      if (c != '\\') {
+        ++pos_;
+        continue;
+      }
+
+      has_escapes = true;
+      ++pos_;
+      switch (Peek()) {
+        case '"':
+        case '\\':
+        case '/':
+        case 'b':
+        case 'f':
+        case 'n':
+        case 'r':
+        case 't':
+          ++pos_;
+          break;
+        case 'u': {
+          ++pos_;
+          const auto codepoint = ParseHex4();
+          if (IsHighSurrogate(codepoint)) {
+            if (doc_.substr(pos_, 2) != "\\u") {
+              Fail("The surrogate pair in string is invalid.");
+            }
+            pos_ += 2;
+            if (!IsLowSurrogate(ParseHex4())) {
+              Fail("The surrogate pair in string is invalid.");
+            }
+          } else if (IsLowSurrogate(codepoint)) {
+            Fail("The surrogate pair in string is invalid.");
+          }
+          break;
+        }
+        default:
+          Fail("Invalid escape character in string.");
+      }
+    }
+    ++pos_;  // closing quote
+    return has_escapes ? LazyTokenType::kEscapedString : LazyTokenType::kString;
+  }
+
+  const std::string_view doc_;
+  std::vector<LazyToken>& tokens_;
+  std::vector<std::uint32_t> stack_;
+  std::size_t pos_{0};
+};
+
+std::string_view GetRaw(std::string_view doc, const LazyToken& token) {
+  return doc.substr(token.begin, token.end - token.begin);
+}
+
+// Strings without escapes are copied as is, other scalars are decoded by
+// rapidjson to keep the exact semantics of formats::json::Value
+impl::Document DecodeScalar(std::string_view raw) {
+  impl::Document json;
+  json.Parse<rapidjson::kParseDefaultFlags |
+             rapidjson::kParseFullPrecisionFlag>(raw.data(), raw.size());
+  UASSERT(!json.HasParseError());
+  return json;
+}
+
+// Returns the contents of a string without escapes between the quotes
+std::string_view GetPlainString(std::string_view doc, const LazyToken& token) {
+  UASSERT(token.type == LazyTokenType::kString);
+  return doc.substr(token.begin + 1, token.end - token.begin - 2);
+}
+
+std::string DecodeString(std::string_view doc, const LazyToken& token) {
+  if (token.type == LazyTokenType::kString) {
+    return std::string{GetPlainString(doc, token)};
+  }
+  const auto json = DecodeScalar(GetRaw(doc, token));
+  return {json.GetString(), json.GetStringLength()};
+}
+
+bool IsContainer(const LazyToken& token) noexcept {
+  return token.type == LazyTokenType::kArray ||
+         token.type == LazyTokenType::kObject;
+}
+
+constexpr std::int64_t kMaxIntDouble{std::int64_t{1}
+                                     << std::numeric_limits<double>::digits};
+
+template <typename Int>
+bool IsNonOverflowingIntegral(const double val) {
+  double integral_part = NAN;
+  if (std::modf(val, &integral_part) != 0.0) return false;
+  if constexpr (sizeof(Int) >= sizeof(double)) {
+    return val > -kMaxIntDouble && val < kMaxIntDouble;
+  } else {
+    return val >= std::numeric_limits<Int>::min() &&
+           val <= std::numeric_limits<Int>::max();
+  }
+}
+
+}  // namespace
+
+LazyDocument::LazyDocument(std::string_view doc) : doc_(doc) {
+  if (doc.empty()) {
+    throw ParseException("JSON document is empty");
+  }
+  if (doc.size() >= kMaxDocumentSize) {
+    throw ParseException(fmt::format(
+        "JSON document of {} bytes is too big for lazy parsing", doc.size()));
+  }
+
+  // A rough estimate that avoids most of the reallocations for the typical
+  // documents
+  tokens_.reserve(doc.size() / 8 + 1);
+  Indexer{doc, tokens_}.Run();
+}
+
+LazyValue LazyDocument::GetRoot() const {
+  return LazyValue{doc_, tokens_.data(), 0};
+}
+
+LazyValue::LazyValue(std::string_view doc, const impl::LazyToken* tokens,
+                     std::uint32_t token) noexcept
+    : doc_(doc), tokens_(tokens), token_(token) {}
+
+LazyValue::LazyValue(std::string missing_path) noexcept
+    : missing_path_(std::move(missing_path)) {}
+
+LazyValue LazyValue::operator[](std::string_view key) const {
+  if (IsMissing()) {
+    return LazyValue{common::MakeChildPath(missing_path_, key)};
+  }
+
+  CheckObjectOrNull();
+  if (IsObject()) {
+    if (const auto member = FindMember(key)) {
+      return LazyValue{doc_, tokens_, *member};
+    }
+  }
+  return LazyValue{common::MakeChildPath(GetPath(), key)};
+}
+
+LazyValue LazyValue::operator[](std::size_t index) const {
+  CheckArrayOrNull();
+  const auto size = GetSize();
+  if (index >= size) {
+    throw OutOfBoundsException(index, size, GetPath());
+  }
+
+  auto element = token_ + 1;
+  for (std::size_t i = 0; i < index; ++i) element = tokens_[element].next;
+  return LazyValue{doc_, tokens_, element};
+}
+
+LazyValue::const_iterator LazyValue::begin() const {
+  CheckObjectOrArrayOrNull();
+  return const_iterator{*this, token_ + 1, 0};
+}
+
+LazyValue::const_iterator LazyValue::end() const {
+  CheckObjectOrArrayOrNull();
+  return const_iterator{*this, IsNull() ? token_ + 1 : GetToken().next,
+                        GetSize()};
+}
+
+bool LazyValue::IsEmpty() const { return GetSize() == 0; }
+
+std::size_t LazyValue::GetSize() const {
+  CheckObjectOrArrayOrNull();
+  return IsNull() ? 0 : GetToken().size;
+}
+
+bool LazyValue::IsNull() const noexcept {
+  return !IsMissing() && GetToken().type == LazyTokenType::kNull;
+}
+
+bool LazyValue::IsBool() const noexcept {
+  return !IsMissing() && (GetToken().type == LazyTokenType::kTrue ||
+                          GetToken().type == LazyTokenType::kFalse);
+}
+
+bool LazyValue::IsInt() const noexcept {
+  if (IsMissing() || GetToken().type != LazyTokenType::kNumber) return false;
+  const auto json = DecodeScalar(GetRawJson());
+  if (json.IsInt()) return true;
+  return json.IsDouble() && IsNonOverflowingIntegral<int>(json.GetDouble());
+}
+
+bool LazyValue::IsInt64() const noexcept {
+  if (IsMissing() || GetToken().type != LazyTokenType::kNumber) return false;
+  const auto json = DecodeScalar(GetRawJson());
+  if (json.IsInt64()) return true;
+  return json.IsDouble() &&
+         IsNonOverflowingIntegral<std::int64_t>(json.GetDouble());
+}
+
+bool LazyValue::IsUInt64() const noexcept {
+  if (IsMissing() || GetToken().type != LazyTokenType::kNumber) return false;
+  const auto json = DecodeScalar(GetRawJson());
+  if (json.IsUint64()) return true;
+  return json.IsDouble() &&
+         IsNonOverflowingIntegral<std::uint64_t>(json.GetDouble());
+}
+
+bool LazyValue::IsDouble() const noexcept {
+  return !IsMissing() && GetToken().type == LazyTokenType::kNumber;
+}
+
+bool LazyValue::IsString() const noexcept {
+  return !IsMissing() && (GetToken().type == LazyTokenType::kString ||
+                          GetToken().type == LazyTokenType::kEscapedString);
+}
+
+bool LazyValue::IsArray() const noexcept {
+  return !IsMissing() && GetToken().type == LazyTokenType::kArray;
+}
+
+bool LazyValue::IsObject() const noexcept {
+  return !IsMissing() && GetToken().type == LazyTokenType::kObject;
+}
+
+bool LazyValue::HasMember(std::string_view key) const {
+  CheckObjectOrNull();
+  return IsObject() && FindMember(key).has_value();
+}
+
+std::string LazyValue::GetPath() const {
+  if (IsMissing()) return missing_path_;
+
+  // Descend from the root to the token, the children of a container occupy
+  // the contiguous range of tokens up to its `next`
+  std::string path{common::kPathRoot};
+  std::uint32_t current = 0;
+  while (current != token_) {
+    const auto& container = tokens_[current];
+    UASSERT(IsContainer(container));
+    const bool is_object = container.type == LazyTokenType::kObject;
+
+    auto child = current + 1;
+    for (std::size_t index = 0;; ++index) {
+      const auto value = is_object ? child + 1 : child;
+      if (token_ < tokens_[value].next) {
+        path = is_object
+                   ? common::MakeChildPath(std::move(path),
+                                           GetMemberName(child))
+                   : common::MakeChildPath(std::move(path), index);
+        current = value;
+        break;
+      }
+      child = tokens_[value].next;
+    }
+  }
+  return path;
+}
+
+std::string_view LazyValue::GetRawJson() const {
+  CheckNotMissing();
+  return GetRaw(doc_, GetToken());
+}
+
+Value LazyValue::ToValue() const { return FromString(GetRawJson()); }
+
+void LazyValue::CheckNotMissing() const {
+  if (IsMissing()) {
+    throw MemberMissingException(GetPath());
+  }
+}
+
+void LazyValue::CheckArrayOrNull() const {
+  if (!IsNull() && !IsArray()) {
+    throw TypeMismatchException(GetExtendedType(), impl::arrayValue, GetPath());
+  }
+}
+
+void LazyValue::CheckObjectOrNull() const {
+  if (!IsNull() && !IsObject()) {
+    throw TypeMismatchException(GetExtendedType(), impl::objectValue,
+                                GetPath());
+  }
+}
+
+void LazyValue::CheckObject() const {
+  if (!IsObject()) {
+    throw TypeMismatchException(GetExtendedType(), impl::objectValue,
+                                GetPath());
+  }
+}
+
+void LazyValue::CheckObjectOrArrayOrNull() const {
+  if (!IsNull() && !IsObject() && !IsArray()) {
+    throw TypeMismatchException(GetExtendedType(), impl::objectValue,
+                                GetPath());
+  }
+}
+
+int LazyValue::GetExtendedType() const {
+  CheckNotMissing();
+  switch (GetToken().type) {
+    case LazyTokenType::kNull:
+      return impl::nullValue;
+    case LazyTokenType::kFalse:
+    case LazyTokenType::kTrue:
+      return impl::booleanValue;
+    case LazyTokenType::kNumber:
+      return impl::GetExtendedType(DecodeScalar(GetRawJson()));
+    case LazyTokenType::kString:
+    case LazyTokenType::kEscapedString:
+      return impl::stringValue;
+    case LazyTokenType::kArray:
+      return impl::arrayValue;
+    case LazyTokenType::kObject:
+      return impl::objectValue;
+  }
+  return impl::errorValue;
+}
+
+std::optional<std::uint32_t> LazyValue::FindMember(std::string_view key) const {
+  UASSERT(IsObject());
+  auto member = token_ + 1;
+  for (std::uint32_t i = 0; i < GetToken().size; ++i) {
+    const auto& key_token = tokens_[member];
+    const bool found = key_token.type == LazyTokenType::kString
+                           ? GetPlainString(doc_, key_token) == key
+                           : DecodeString(doc_, key_token) == key;
+    if (found) return member + 1;
+    member = tokens_[member + 1].next;
+  }
+  return std::nullopt;
+}
+
+std::string LazyValue::GetMemberName(std::uint32_t key_token) const {
+  return DecodeString(doc_, tokens_[key_token]);
+}
+
+LazyValue::const_iterator::const_iterator(const LazyValue& container,
+                                          std::uint32_t token,
+                                          std::size_t index) noexcept
+    : doc_(container.doc_),
+      tokens_(container.tokens_),
+      container_token_(container.token_),
+      token_(token),
+      index_(index) {}
+
+LazyValue LazyValue::const_iterator::operator*() const {
+  const bool is_object =
+      tokens_[container_token_].type == LazyTokenType::kObject;
+  return LazyValue{doc_, tokens_, is_object ? token_ + 1 : token_};
+}
+
+LazyValue::const_iterator& LazyValue::const_iterator::operator++() {
+  const bool is_object =
+      tokens_[container_token_].type == LazyTokenType::kObject;
+  token_ = tokens_[is_object ? token_ + 1 : token_].next;
+  ++index_;
+  return *this;
+}
+
+LazyValue::const_iterator LazyValue::const_iterator::operator++(int) {
+  auto copy = *this;
+  ++*this;
+  return copy;
+}
+
+std::string LazyValue::const_iterator::GetName() const {
+  const LazyValue container{doc_, tokens_, container_token_};
+  container.CheckObject();
+  return container.GetMemberName(token_);
+}
+
+bool Parse(const LazyValue& value, parse::To<bool>) {
+  value.CheckNotMissing();
+  const auto type = value.GetToken().type;
+  if (type == LazyTokenType::kTrue) return true;
+  if (type == LazyTokenType::kFalse) return false;
+  throw TypeMismatchException(value.GetExtendedType(), impl::booleanValue,
+                              value.GetPath());
+}
+
+double Parse(const LazyValue& value, parse::To<double>) {
+  value.CheckNotMissing();
+  if (value.GetToken().type == LazyTokenType::kNumber) {
+    const auto json = DecodeScalar(value.GetRawJson());
+    if (json.IsDouble()) return json.GetDouble();
+    if (json.IsInt64()) return static_cast<double>(json.GetInt64());
+    if (json.IsUint64()) return static_cast<double>(json.GetUint64());
+  }
+  throw TypeMismatchException(value.GetExtendedType(), impl::realValue,
+                              value.GetPath());
+}
+
+std::int64_t Parse(const LazyValue& value, parse::To<std::int64_t>) {
+  value.CheckNotMissing();
+  if (value.GetToken().type == LazyTokenType::kNumber) {
+    const auto json = DecodeScalar(value.GetRawJson());
+    if (json.IsInt64()) return json.GetInt64();
+    if (json.IsDouble()) {
+      const double val = json.GetDouble();
+      if (IsNonOverflowingIntegral<std::int64_t>(val)) {
+        return static_cast<std::int64_t>(val);
+      }
+    }
+  }
+  throw TypeMismatchException(value.GetExtendedType(), impl::intValue,
+                              value.GetPath());
+}
+
+std::uint64_t Parse(const LazyValue& value, parse::To<std::uint64_t>) {
+  value.CheckNotMissing();
+  if (value.GetToken().type == LazyTokenType::kNumber) {
+    const auto json = DecodeScalar(value.GetRawJson());
+    if (json.IsUint64()) return json.GetUint64();
+    if (json.IsDouble()) {
+      const double val = json.GetDouble();
+      if (IsNonOverflowingIntegral<std::uint64_t>(val)) {
+        return static_cast<std::uint64_t>(val);
+      }
+    }
+  }
+  throw TypeMismatchException(value.GetExtendedType(), impl::uintValue,
+                              value.GetPath());
+}
+
+std::string Parse(const LazyValue& value, parse::To<std::string>) {
+  value.CheckNotMissing();
+  if (value.IsString()) return DecodeString(value.doc_, value.GetToken());
+  throw TypeMismatchException(value.GetExtendedType(), impl::stringValue,
+                              value.GetPath());
+}
+
+}  // namespace formats::json
+
+USERVER_NAMESPACE_END
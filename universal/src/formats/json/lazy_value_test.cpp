@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <userver/formats/json/exception.hpp>
+#include <userver/formats/json/lazy_value.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Point {
+  int x{0};
+  int y{0};
+};
+
+// Only has a parser for the DOM value
+Point Parse(const formats::json::Value& value, formats::parse::To<Point>) {
+  return {value["x"].As<int>(), value["y"].As<int>()};
+}
+
+struct Named {
+  std::string name;
+};
+
+template <typename Value>
+Named Parse(const Value& value, formats::parse::To<Named>) {
+  return {value["name"].template As<std::string>()};
+}
+
+constexpr std::string_view kDoc = R"({
+  "int": -42,
+  "uint": 18446744073709551615,
+  "double": 1.5,
+  "string": "str",
+  "escaped": "a\"b\\cé😀",
+  "null": null,
+  "bool": true,
+  "array": [1, [], {}, "x"],
+  "object": {"key": {"nested": [10, 20]}},
+  "key": 1,
+  "points": [{"x": 1, "y": 2}, {"x": 3, "y": 4}],
+  "named": {"name": "some"}
+})";
+
+}  // namespace
+
+TEST(FormatsJsonLazy, Sample) {
+  /// [Sample formats::json::LazyValue usage]
+  // #include <userver/formats/json/lazy_value.hpp>
+  const std::string body = R"({"key": {"values": [1, 2, 3]}, "big": [0]})";
+  formats::json::LazyDocument doc{body};
+  const auto json = doc.GetRoot();
+
+  const auto values = json["key"]["values"].As<std::vector<int>>();
+  EXPECT_EQ(values, (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(json["missing"].As<int>(42), 42);
+  /// [Sample formats::json::LazyValue usage]
+}
+
+TEST(FormatsJsonLazy, Scalars) {
+  const formats::json::LazyDocument doc{kDoc};
+  const auto json = doc.GetRoot();
+
+  EXPECT_EQ(json["int"].As<int>(), -42);
+  EXPECT_EQ(json["int"].As<std::int64_t>(), -42);
+  EXPECT_THROW(json["int"].As<std::uint64_t>(),
+               formats::json::TypeMismatchException);
+  EXPECT_EQ(json["uint"].As<std::uint64_t>(),
+            std::numeric_limits<std::uint64_t>::max());
+  EXPECT_FALSE(json["uint"].IsInt64());
+  EXPECT_TRUE(json["uint"].IsUInt64());
+  EXPECT_EQ(json["double"].As<double>(), 1.5);
+  EXPECT_EQ(json["double"].As<float>(), 1.5F);
+  EXPECT_THROW(json["double"].As<int>(), formats::json::TypeMismatchException);
+  EXPECT_EQ(json["string"].As<std::string>(), "str");
+  EXPECT_EQ(json["escaped"].As<std::string>(),
+            "a\"b\\c\xc3\xa9\xf0\x9f\x98\x80");
+  EXPECT_TRUE(json["null"].IsNull());
+  EXPECT_TRUE(json["bool"].As<bool>());
+  EXPECT_THROW(json["string"].As<bool>(),
+               formats::json::TypeMismatchException);
+  EXPECT_EQ(json["null"].As<std::optional<int>>(), std::nullopt);
+  EXPECT_EQ(json["int"].As<std::optional<int>>(), -42);
+}
+
+TEST(FormatsJsonLazy, Access) {
+  const formats::json::LazyDocument doc{kDoc};
+  const auto json = doc.GetRoot();
+
+  EXPECT_TRUE(json.IsObject());
+  EXPECT_EQ(json.GetSize(), 12);
+  EXPECT_TRUE(json.HasMember("key"));
+  EXPECT_FALSE(json.HasMember("nope"));
+
+  const auto nested = json["object"]["key"]["nested"];
+  EXPECT_EQ(nested[1].As<int>(), 20);
+  EXPECT_EQ(nested.GetPath(), "object.key.nested");
+  EXPECT_EQ(nested[1].GetPath(), "object.key.nested[1]");
+  EXPECT_EQ(nested.GetRawJson(), "[10, 20]");
+  EXPECT_THROW(nested[2], formats::json::OutOfBoundsException);
+
+  const auto array = json["array"];
+  EXPECT_EQ(array.GetSize(), 4);
+  EXPECT_TRUE(array[1].IsArray());
+  EXPECT_TRUE(array[1].IsEmpty());
+  EXPECT_TRUE(array[2].IsObject());
+  EXPECT_EQ(array[3].As<std::string>(), "x");
+  EXPECT_THROW(array["key"], formats::json::TypeMismatchException);
+
+  EXPECT_EQ(json["key"].GetPath(), "key");
+  EXPECT_EQ(json.GetPath(), "/");
+}
+
+TEST(FormatsJsonLazy, Missing) {
+  const formats::json::LazyDocument doc{kDoc};
+  const auto json = doc.GetRoot();
+
+  const auto missing = json["object"]["a"]["b"];
+  EXPECT_TRUE(missing.IsMissing());
+  EXPECT_EQ(missing.GetPath(), "object.a.b");
+  EXPECT_THROW(missing.As<int>(), formats::json::MemberMissingException);
+  EXPECT_EQ(missing.As<int>({}), 0);
+  EXPECT_EQ(missing.As<std::string>("default"), "default");
+  EXPECT_EQ(missing.As<std::optional<int>>(), std::nullopt);
+
+  EXPECT_TRUE(json["null"]["field"].IsMissing());
+}
+
+TEST(FormatsJsonLazy, Iteration) {
+  const formats::json::LazyDocument doc{kDoc};
+  const auto json = doc.GetRoot();
+
+  std::vector<std::string> names;
+  for (auto it = json.begin(); it != json.end(); ++it) {
+    names.push_back(it.GetName());
+  }
+  ASSERT_EQ(names.size(), json.GetSize());
+  EXPECT_EQ(names.front(), "int");
+  EXPECT_EQ(names[9], "key");
+
+  const auto map =
+      json["object"]["key"].As<std::map<std::string, std::vector<int>>>();
+  EXPECT_EQ(map.at("nested"), (std::vector<int>{10, 20}));
+
+  EXPECT_THROW(json["int"].begin(), formats::json::TypeMismatchException);
+  EXPECT_EQ(json["null"].begin(), json["null"].end());
+}
+
+TEST(FormatsJsonLazy, ParseCustomTypes) {
+  const formats::json::LazyDocument doc{kDoc};
+  const auto json = doc.GetRoot();
+
+  const auto points = json["points"].As<std::vector<Point>>();
+  ASSERT_EQ(points.size(), 2);
+  EXPECT_EQ(points[1].x, 3);
+  EXPECT_EQ(points[1].y, 4);
+
+  EXPECT_EQ(json["named"].As<Named>().name, "some");
+  EXPECT_EQ(json["named"].ToValue()["name"].As<std::string>(), "some");
+}
+
+TEST(FormatsJsonLazy, Valid) {
+  for (const std::string_view input :
+       {"0", "-0", "1.5", "-1.2e-0123", "1.2E+34", R"("")", R"("\/")", "true",
+        "null", "[]", "{}", "[[[]]]", R"({"a":{"b":[1,{}]}})", " [ 1 , 2 ] ",
+        R"(["\u0000"])"}) {
+    const formats::json::LazyDocument doc{input};
+    EXPECT_EQ(doc.GetRoot().ToValue(), formats::json::FromString(input))
+        << input;
+  }
+}
+
+TEST(FormatsJsonLazy, Invalid) {
+  for (const std::string_view input :
+       {"", " ", "NULL", "True", "00", "01", "-", "1.", "1e", ".5", "inf",
+        "nan", "[1,]", "[1 2]", "{,}", R"({"a"})", R"({"a":})", R"({"a":1,})",
+        R"({a:1})", "{'a':1}", "{}{}", "[", "]", R"(")", R"("\x")",
+        R"("\u12")", R"("\ud800")", R"("\udc00")", "\"\x01\"", "[1]]"}) {
+    EXPECT_THROW(formats::json::LazyDocument{input},
+                 formats::json::ParseException)
+        << input;
+    EXPECT_THROW(formats::json::FromString(input),
+                 formats::json::ParseException)
+        << input;
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -102,6 +102,35 @@ void json_path_long_and_deeply_nested(benchmark::State& state) {
 }
 BENCHMARK(json_path_long_and_deeply_nested);
 
+void json_path_deeply_nested_arena(benchmark::State& state) {
+  auto json = formats::json::FromStringWithArena(bench_json_data);
+
+  for ([[maybe_unused]] auto _ : state) {
+    const auto res = (json["long"]["deeply"]["deeply"]["nested"]["json"]
+                          ["value"]["with"]["some"]["data"]
+                              .As<std::string>() == "3");
+    benchmark::DoNotOptimize(res);
+    if (!res) throw std::runtime_error("unexpected");
+  }
+}
+BENCHMARK(json_path_deeply_nested_arena);
+
+void json_parse_and_access(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    auto json = formats::json::FromString(bench_json_data);
+    benchmark::DoNotOptimize(json["short"].As<std::string>());
+  }
+}
+BENCHMARK(json_parse_and_access);
+
+void json_parse_and_access_arena(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    auto json = formats::json::FromStringWithArena(bench_json_data);
+    benchmark::DoNotOptimize(json["short"].As<std::string>());
+  }
+}
+BENCHMARK(json_parse_and_access_arena);
+
 formats::json::ValueBuilder Build(size_t count) {
   formats::json::ValueBuilder builder;
   for (size_t i = 0; i < count; i++) builder[std::to_string(i)] = i;
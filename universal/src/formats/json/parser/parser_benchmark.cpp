@@ -2,9 +2,12 @@
 
 #include <fmt/format.h>
 
+#include <userver/formats/json/aggregates.hpp>
 #include <userver/formats/json/inline.hpp>
+#include <userver/formats/json/lazy_value.hpp>
 #include <userver/formats/json/parser/parser.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/string_builder.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/formats/parse/common_containers.hpp>
 #include <userver/formats/serialize/common_containers.hpp>
@@ -70,6 +73,16 @@ void JsonParseArraySax(benchmark::State& state) {
 }
 BENCHMARK(JsonParseArraySax)->RangeMultiplier(4)->Range(1, 1024);
 
+void JsonParseArrayLazy(benchmark::State& state) {
+  const auto input = BuildArray(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    const formats::json::LazyDocument doc{input};
+    const auto res = doc.GetRoot().As<std::vector<std::vector<int64_t>>>();
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonParseArrayLazy)->RangeMultiplier(4)->Range(1, 1024);
+
 std::string BuildObject(size_t level) {
   if (level == 0) {
     return R"({"k": 123, "v": 1.11, "s": "some string"})";
@@ -100,6 +113,37 @@ void JsonParseValueSax(benchmark::State& state) {
 }
 BENCHMARK(JsonParseValueSax)->RangeMultiplier(2)->Range(1, 16);
 
+void JsonParseValueLazy(benchmark::State& state) {
+  const auto input = BuildObject(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    const formats::json::LazyDocument doc{input};
+    benchmark::DoNotOptimize(doc);
+  }
+}
+BENCHMARK(JsonParseValueLazy)->RangeMultiplier(2)->Range(1, 16);
+
+// Reads a single field of a big document, the typical case for the lazy
+// parsing
+void JsonReadFieldDom(benchmark::State& state) {
+  const auto input = BuildObject(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    const auto json = formats::json::FromString(input);
+    const auto res = json["three"].As<std::string>();
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonReadFieldDom)->RangeMultiplier(2)->Range(1, 16);
+
+void JsonReadFieldLazy(benchmark::State& state) {
+  const auto input = BuildObject(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    const formats::json::LazyDocument doc{input};
+    const auto res = doc.GetRoot()["three"].As<std::string>();
+    benchmark::DoNotOptimize(res);
+  }
+}
+BENCHMARK(JsonReadFieldLazy)->RangeMultiplier(2)->Range(1, 16);
+
 namespace {
 
 struct SomeValue final {
@@ -218,4 +262,92 @@ BENCHMARK(JsonParseValueDomLotsOfMissingKeys)
 
 }  // namespace
 
+namespace {
+
+struct Order final {
+  std::int64_t id;
+  std::string name;
+  std::vector<std::int64_t> items;
+  std::optional<double> price;
+};
+
+struct Orders final {
+  std::vector<Order> orders;
+};
+
+}  // namespace
+
+template <>
+struct formats::json::AggregateFields<Order> {
+  static constexpr std::string_view kNames[] = {"id", "name", "items",
+                                                "price"};
+};
+
+template <>
+struct formats::json::AggregateFields<Orders> {
+  static constexpr std::string_view kNames[] = {"orders"};
+};
+
+namespace {
+
+Orders GenerateOrders(std::size_t count) {
+  Orders result;
+  for (std::size_t i = 0; i < count; ++i) {
+    std::optional<double> price;
+    if (i % 2) price = 1.5;
+    result.orders.push_back({static_cast<std::int64_t>(i),
+                             fmt::format("order #{}", i),
+                             {1, 2, 3},
+                             price});
+  }
+  return result;
+}
+
+void JsonAggregateParseDom(benchmark::State& state) {
+  const auto input = formats::json::ToString(
+      formats::json::ValueBuilder{GenerateOrders(state.range(0))}
+          .ExtractValue());
+
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(formats::json::FromString(input).As<Orders>());
+  }
+}
+BENCHMARK(JsonAggregateParseDom)->RangeMultiplier(4)->Range(1, 1024);
+
+void JsonAggregateParseSax(benchmark::State& state) {
+  namespace fjp = formats::json::parser;
+  const auto input = formats::json::ToString(
+      formats::json::ValueBuilder{GenerateOrders(state.range(0))}
+          .ExtractValue());
+
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(
+        fjp::ParseToType<Orders, fjp::AggregateParser<Orders>>(input));
+  }
+}
+BENCHMARK(JsonAggregateParseSax)->RangeMultiplier(4)->Range(1, 1024);
+
+void JsonAggregateSerializeDom(benchmark::State& state) {
+  const auto orders = GenerateOrders(state.range(0));
+
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(formats::json::ToString(
+        formats::json::ValueBuilder{orders}.ExtractValue()));
+  }
+}
+BENCHMARK(JsonAggregateSerializeDom)->RangeMultiplier(4)->Range(1, 1024);
+
+void JsonAggregateWriteToStream(benchmark::State& state) {
+  const auto orders = GenerateOrders(state.range(0));
+
+  for ([[maybe_unused]] auto _ : state) {
+    formats::json::StringBuilder sw;
+    WriteToStream(orders, sw);
+    benchmark::DoNotOptimize(sw.GetString());
+  }
+}
+BENCHMARK(JsonAggregateWriteToStream)->RangeMultiplier(4)->Range(1, 1024);
+
+}  // namespace
+
 USERVER_NAMESPACE_END
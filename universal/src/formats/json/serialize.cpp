@@ -13,11 +13,11 @@
 #include <rapidjson/istreamwrapper.h>
 #include <rapidjson/ostreamwrapper.h>
 #include <rapidjson/prettywriter.h>
-#include <rapidjson/writer.h>
 
 #include <formats/json/impl/accept.hpp>
 #include <formats/json/impl/json_tree.hpp>
 #include <formats/json/impl/types_impl.hpp>
+#include <formats/json/impl/writer.hpp>
 #include <userver/formats/json/exception.hpp>
 #include <userver/formats/json/value.hpp>
 #include <userver/logging/log.hpp>
@@ -29,71 +29,19 @@ namespace formats::json {
 
 namespace {
 
-::rapidjson::CrtAllocator g_allocator;
-
-std::string_view AsStringView(const impl::Value& jval) {
-  return {jval.GetString(), jval.GetStringLength()};
-}
-
-void CheckKeyUniqueness(const impl::Value* root) {
-  using KeysStack = boost::container::small_vector<std::string_view,
-                                                   impl::kInitialStackDepth>;
-
-  impl::TreeStack stack;
-  const impl::Value* value = root;
-
-  stack.emplace_back();  // fake "top" frame to avoid extra checks for an empty
-                         // stack inside walker loop
-  KeysStack keys;
-  for (;;) {
-    stack.back().Advance();
-    if (value->IsObject()) {
-      const std::size_t count = value->MemberCount();
-      const auto begin = value->MemberBegin();
-      if (count > keys.size()) {
-        keys.resize(count);
-      }
-      for (std::size_t i = 0; i < count; ++i) {
-        keys[i] = AsStringView(begin[i].name);
-      }
-      std::sort(keys.begin(), keys.begin() + count);
-      const auto* cons_eq_element =
-          std::adjacent_find(keys.data(), keys.data() + count);
-      if (cons_eq_element != keys.data() + count) {
-        throw ParseException("Duplicate key: " + std::string(*cons_eq_element) +
-                             " at " + impl::ExtractPath(stack));
-      }
-    }
-
-    if ((value->IsObject() && value->MemberCount() > 0) ||
-        (value->IsArray() && value->Size() > 0)) {
-      // descend
-      stack.emplace_back(value);
-    } else {
-      while (!stack.back().HasMoreElements()) {
-        stack.pop_back();
-        if (stack.empty()) return;
-      }
-    }
-
-    value = stack.back().CurrentValue();
-  }
-}
+impl::Allocator g_allocator;
 
 impl::VersionedValuePtr EnsureValid(impl::Document&& json) {
-  CheckKeyUniqueness(&json);
+  impl::CheckKeyUniqueness(&json);
 
   return impl::VersionedValuePtr::Create(std::move(json));
 }
 
-}  // namespace
-
-Value FromString(std::string_view doc) {
+void ParseDocument(impl::Document& json, std::string_view doc) {
   if (doc.empty()) {
     throw ParseException("JSON document is empty");
   }
 
-  impl::Document json{&g_allocator};
   rapidjson::ParseResult ok =
       json.Parse<rapidjson::kParseDefaultFlags |
                  rapidjson::kParseIterativeFlag |
@@ -110,10 +58,30 @@ Value FromString(std::string_view doc) {
         fmt::format("JSON parse error at line {} column {}: {}", line, column,
                     rapidjson::GetParseError_En(ok.Code())));
   }
+}
+
+}  // namespace
 
+Value FromString(std::string_view doc) {
+  impl::Document json{&g_allocator};
+  ParseDocument(json, doc);
   return Value{EnsureValid(std::move(json))};
 }
 
+Value FromStringWithArena(std::string_view doc) {
+  auto arena = std::make_unique<impl::Arena>(doc.size());
+  impl::Allocator allocator{*arena};
+
+  // The partially parsed document is dropped on errors, while its nodes may
+  // only be released with the arena
+  const impl::ArenaParseScope arena_parse_scope;
+  impl::Document json{&allocator};
+  ParseDocument(json, doc);
+  impl::CheckKeyUniqueness(&json);
+  return Value{impl::VersionedValuePtr::Create(std::move(json),
+                                               std::move(arena))};
+}
+
 Value FromStream(std::istream& is) {
   if (!is) {
     throw BadStreamException(is);
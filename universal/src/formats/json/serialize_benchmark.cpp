@@ -9,6 +9,7 @@
 #include <userver/formats/json/serialize_variant.hpp>
 #include <userver/formats/json/value.hpp>
 #include <userver/formats/json/value_builder.hpp>
+#include <userver/formats/msgpack/serialize.hpp>
 #include <userver/formats/parse/common_containers.hpp>
 #include <userver/formats/parse/variant.hpp>
 #include <userver/formats/serialize/common_containers.hpp>
@@ -1185,6 +1186,104 @@ BENCHMARK(DeepJson);
 
 BENCHMARK(DeepWidthJson);
 
+// Same documents, parsed with all the nodes allocated from an arena
+void SmallJsonArena(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    auto json = formats::json::FromStringWithArena(str_small_json);
+    benchmark::DoNotOptimize(json);
+  }
+}
+
+void MiddleJsonArena(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    auto json = formats::json::FromStringWithArena(str_middle_json);
+    benchmark::DoNotOptimize(json);
+  }
+}
+
+void WidthJsonArena(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    auto json = formats::json::FromStringWithArena(str_width_json);
+    benchmark::DoNotOptimize(json);
+  }
+}
+
+void DeepJsonArena(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    auto json = formats::json::FromStringWithArena(str_deep_json);
+    benchmark::DoNotOptimize(json);
+  }
+}
+
+void DeepWidthJsonArena(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    auto json = formats::json::FromStringWithArena(str_deep_width_json);
+    benchmark::DoNotOptimize(json);
+  }
+}
+
+BENCHMARK(SmallJsonArena);
+
+BENCHMARK(MiddleJsonArena);
+
+BENCHMARK(WidthJsonArena);
+
+BENCHMARK(DeepJsonArena);
+
+BENCHMARK(DeepWidthJsonArena);
+
+// Same documents, parsed from MessagePack
+void MiddleMsgpack(benchmark::State& state) {
+  const auto doc =
+      formats::msgpack::ToString(formats::json::FromString(str_middle_json));
+  for ([[maybe_unused]] auto _ : state) {
+    auto value = formats::msgpack::FromString(doc);
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+void WidthMsgpack(benchmark::State& state) {
+  const auto doc =
+      formats::msgpack::ToString(formats::json::FromString(str_width_json));
+  for ([[maybe_unused]] auto _ : state) {
+    auto value = formats::msgpack::FromString(doc);
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+void DeepWidthMsgpack(benchmark::State& state) {
+  const auto doc = formats::msgpack::ToString(
+      formats::json::FromString(str_deep_width_json));
+  for ([[maybe_unused]] auto _ : state) {
+    auto value = formats::msgpack::FromString(doc);
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+BENCHMARK(MiddleMsgpack);
+
+BENCHMARK(WidthMsgpack);
+
+BENCHMARK(DeepWidthMsgpack);
+
+void WidthJsonToString(benchmark::State& state) {
+  const auto value = formats::json::FromString(str_width_json);
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(formats::json::ToString(value));
+  }
+}
+
+void WidthMsgpackToString(benchmark::State& state) {
+  const auto value = formats::json::FromString(str_width_json);
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(formats::msgpack::ToString(value));
+  }
+}
+
+BENCHMARK(WidthJsonToString);
+
+BENCHMARK(WidthMsgpackToString);
+
 namespace {
 
 struct InnerObject final {
@@ -327,4 +327,60 @@ TEST(JsonToPrettyStringCycle, DISABLED_SortsObjectKeys) {
   EXPECT_EQ(kPrettyJson, formats::json::ToPrettyString(json));
 }
 
+TEST(FormatsJsonArena, SameAsFromString) {
+  static constexpr std::string_view kJson =
+      R"({"a":[1,-2,3.5,"long enough string to be not inlined"],)"
+      R"("b":{"c":null,"d":true,"e":{}},"f":[]})";
+
+  const auto arena = formats::json::FromStringWithArena(kJson);
+  EXPECT_EQ(arena, formats::json::FromString(kJson));
+  EXPECT_EQ(formats::json::ToString(arena), kJson);
+  EXPECT_EQ(arena["a"][3].As<std::string>(),
+            "long enough string to be not inlined");
+  EXPECT_EQ(arena["b"]["c"].GetPath(), "b.c");
+}
+
+TEST(FormatsJsonArena, ParseErrors) {
+  for (const std::string_view input :
+       {"", "[1, 2", R"({"a": ["long enough string to be not inlined", )",
+        R"({"a":1,"a":2})"}) {
+    EXPECT_THROW(formats::json::FromStringWithArena(input),
+                 formats::json::ParseException)
+        << input;
+  }
+}
+
+TEST(FormatsJsonArena, OutlivesDocument) {
+  formats::json::Value nested;
+  {
+    const auto json = formats::json::FromStringWithArena(
+        R"({"a":{"b":["long enough string to be not inlined"]}})");
+    nested = json["a"];
+  }
+  EXPECT_EQ(nested["b"][0].As<std::string>(),
+            "long enough string to be not inlined");
+  EXPECT_EQ(nested.GetPath(), "a");
+}
+
+TEST(FormatsJsonArena, Modification) {
+  auto json = formats::json::FromStringWithArena(
+      R"({"a":["long enough string to be not inlined"],"b":1})");
+  const auto copy = json;
+
+  formats::json::ValueBuilder builder{std::move(json)};
+  builder["a"].PushBack("second long enough string to be not inlined");
+  builder.Remove("b");
+  builder["c"] = copy["a"];
+  const auto result = builder.ExtractValue();
+
+  EXPECT_EQ(formats::json::ToStableString(result),
+            R"({"a":["long enough string to be not inlined",)"
+            R"("second long enough string to be not inlined"],)"
+            R"("c":["long enough string to be not inlined"]})");
+  EXPECT_EQ(copy["b"].As<int>(), 1);
+  EXPECT_EQ(formats::json::ToStableString(formats::json::FromStringWithArena(
+                R"({"b":1,"a":2})")),
+            R"({"a":2,"b":1})");
+}
+
 USERVER_NAMESPACE_END
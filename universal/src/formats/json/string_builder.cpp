@@ -2,13 +2,13 @@
 
 #include <cmath>
 #include <stdexcept>
+#include <utility>
 
 #include <rapidjson/document.h>
-#include <rapidjson/stringbuffer.h>
-#include <rapidjson/writer.h>
 
 #include <formats/common/validations.hpp>
 #include <formats/json/impl/accept.hpp>
+#include <formats/json/impl/writer.hpp>
 #include <userver/formats/json/impl/types.hpp>
 #include <userver/formats/json/value.hpp>
 #include <userver/utils/datetime.hpp>
@@ -21,12 +21,21 @@ namespace formats::json {
 struct StringBuilder::Impl {
   rapidjson::StringBuffer buffer;
   rapidjson::Writer<rapidjson::StringBuffer> writer{buffer};
+  ChunkConsumer consumer;
+  std::size_t chunk_size{0};
 
   Impl() = default;
+  Impl(ChunkConsumer consumer, std::size_t chunk_size)
+      : consumer(std::move(consumer)), chunk_size(chunk_size) {
+    buffer.Reserve(chunk_size);
+  }
 };
 
 StringBuilder::StringBuilder() = default;
 
+StringBuilder::StringBuilder(ChunkConsumer consumer, std::size_t chunk_size)
+    : impl_(std::move(consumer), chunk_size) {}
+
 StringBuilder::~StringBuilder() = default;
 
 std::string_view StringBuilder::GetStringView() const {
@@ -38,21 +47,35 @@ std::string StringBuilder::GetString() const {
   return std::string{GetStringView()};
 }
 
-void StringBuilder::WriteNull() { impl_->writer.Null(); }
+void StringBuilder::WriteNull() {
+  impl_->writer.Null();
+  FlushIfFull();
+}
 
 void StringBuilder::WriteString(std::string_view value) {
   impl_->writer.String(value.data(), value.size());
+  FlushIfFull();
 }
 
-void StringBuilder::WriteBool(bool value) { impl_->writer.Bool(value); }
+void StringBuilder::WriteBool(bool value) {
+  impl_->writer.Bool(value);
+  FlushIfFull();
+}
 
-void StringBuilder::WriteInt64(int64_t value) { impl_->writer.Int64(value); }
+void StringBuilder::WriteInt64(int64_t value) {
+  impl_->writer.Int64(value);
+  FlushIfFull();
+}
 
-void StringBuilder::WriteUInt64(uint64_t value) { impl_->writer.Uint64(value); }
+void StringBuilder::WriteUInt64(uint64_t value) {
+  impl_->writer.Uint64(value);
+  FlushIfFull();
+}
 
 void StringBuilder::WriteDouble(double value) {
   formats::common::ValidateFloat<std::runtime_error>(value);
   impl_->writer.Double(value);
+  FlushIfFull();
 }
 
 void StringBuilder::Key(std::string_view sw) {
@@ -61,10 +84,24 @@ void StringBuilder::Key(std::string_view sw) {
 
 void StringBuilder::WriteRawString(std::string_view value) {
   impl_->writer.RawValue(value.data(), value.size(), {});
+  FlushIfFull();
 }
 
 void StringBuilder::WriteValue(const formats::json::Value& value) {
   formats::json::AcceptNoRecursion(value.GetNative(), impl_->writer);
+  FlushIfFull();
+}
+
+void StringBuilder::Flush() {
+  auto& buffer = impl_->buffer;
+  if (!impl_->consumer || buffer.GetLength() == 0) return;
+
+  impl_->consumer(std::string{buffer.GetString(), buffer.GetLength()});
+  buffer.Clear();
+}
+
+void StringBuilder::FlushIfFull() {
+  if (impl_->buffer.GetLength() >= impl_->chunk_size) Flush();
 }
 
 void WriteToStream(bool value, StringBuilder& sw) { sw.WriteBool(value); }
@@ -114,13 +151,19 @@ StringBuilder::ObjectGuard::ObjectGuard(StringBuilder& sw) : sw_(sw) {
   sw_.impl_->writer.StartObject();
 }
 
-StringBuilder::ObjectGuard::~ObjectGuard() { sw_.impl_->writer.EndObject(); }
+StringBuilder::ObjectGuard::~ObjectGuard() {
+  sw_.impl_->writer.EndObject();
+  sw_.FlushIfFull();
+}
 
 StringBuilder::ArrayGuard::ArrayGuard(StringBuilder& sw) : sw_(sw) {
   sw_.impl_->writer.StartArray();
 }
 
-StringBuilder::ArrayGuard::~ArrayGuard() { sw_.impl_->writer.EndArray(); }
+StringBuilder::ArrayGuard::~ArrayGuard() {
+  sw_.impl_->writer.EndArray();
+  sw_.FlushIfFull();
+}
 
 }  // namespace formats::json
 
@@ -2,6 +2,8 @@
 
 #include <array>
 #include <cstring>
+#include <string>
+#include <vector>
 
 #include <userver/formats/json/serialize.hpp>
 #include <userver/formats/json/serialize_duration.hpp>
@@ -181,6 +183,49 @@ TEST(JsonStringBuilder, String) {
   EXPECT_EQ(sw.GetString(), "\"some string\"");
 }
 
+TEST(JsonStringBuilder, LongStringEscaping) {
+  const std::string padding(40, 'x');
+  for (std::size_t pos = 0; pos <= padding.size(); ++pos) {
+    for (const std::string_view escaped :
+         {R"(\")", R"(\\)", R"(\n)", R"(\u001F)"}) {
+      std::string expected = padding;
+      expected.insert(pos, escaped);
+
+      StringBuilder sw;
+      WriteToStream(FromString('"' + expected + '"').As<std::string>(), sw);
+      EXPECT_EQ(sw.GetString(), '"' + expected + '"');
+    }
+  }
+}
+
+TEST(JsonStringBuilder, Streaming) {
+  constexpr std::size_t kChunkSize = 16;
+  std::vector<std::string> chunks;
+  StringBuilder sw{[&chunks](std::string&& chunk) {
+                     chunks.push_back(std::move(chunk));
+                   },
+                   kChunkSize};
+
+  const std::vector<std::string> data(10, "some string");
+  WriteToStream(data, sw);
+  ASSERT_FALSE(chunks.empty());
+  for (const auto& chunk : chunks) {
+    EXPECT_GE(chunk.size(), kChunkSize);
+    EXPECT_LT(chunk.size(), kChunkSize + sizeof(R"("some string",)"));
+  }
+
+  const auto chunks_count = chunks.size();
+  sw.Flush();
+  EXPECT_EQ(chunks.size(), chunks_count + 1);
+  EXPECT_TRUE(sw.GetStringView().empty());
+  sw.Flush();
+  EXPECT_EQ(chunks.size(), chunks_count + 1);
+
+  std::string result;
+  for (const auto& chunk : chunks) result += chunk;
+  EXPECT_EQ(FromString(result), ValueBuilder{data}.ExtractValue());
+}
+
 TEST(JsonStringBuilder, VectorBool) {
   std::vector<bool> v = {true, false};
   StringBuilder sw;
@@ -1,9 +1,17 @@
 #include <userver/formats/json/validate.hpp>
 
+#include <fmt/format.h>
+#include <rapidjson/encodedstream.h>
+#include <rapidjson/error/en.h>
+#include <rapidjson/memorystream.h>
 #include <rapidjson/reader.h>
 #include <rapidjson/schema.h>
+#include <rapidjson/stringbuffer.h>
 
 #include <formats/json/impl/accept.hpp>
+#include <formats/json/impl/json_tree.hpp>
+#include <formats/json/impl/types_impl.hpp>
+#include <userver/formats/json/exception.hpp>
 #include <userver/formats/json/impl/types.hpp>
 #include <userver/formats/json/value.hpp>
 
@@ -20,8 +28,29 @@ using SchemaValidator = rapidjson::GenericSchemaValidator<
     impl::SchemaDocument, rapidjson::BaseReaderHandler<impl::UTF8, void>,
     rapidjson::CrtAllocator>;
 
+// Validates the SAX events and forwards them to the document being built
+using ValidatingHandler =
+    rapidjson::GenericSchemaValidator<impl::SchemaDocument, impl::Document,
+                                      rapidjson::CrtAllocator>;
+
 }  // namespace impl
 
+namespace {
+
+impl::Allocator g_allocator;
+
+std::string MakeValidationError(const impl::ValidatingHandler& validator) {
+  rapidjson::StringBuffer path;
+  validator.GetInvalidDocumentPointer().StringifyUriFragment(path);
+  const char* keyword = validator.GetInvalidSchemaKeyword();
+  return fmt::format(
+      "JSON schema validation error at '{}': '{}' keyword failed",
+      std::string_view{path.GetString(), path.GetLength()},
+      keyword ? keyword : "unknown");
+}
+
+}  // namespace
+
 struct Schema::Impl final {
   impl::SchemaDocument schemaDocument;
 };
@@ -37,6 +66,49 @@ bool Validate(const formats::json::Value& doc,
   return AcceptNoRecursion(doc.GetNative(), validator);
 }
 
+Value FromStringValidated(std::string_view doc, const Schema& schema) {
+  if (doc.empty()) {
+    throw ParseException("JSON document is empty");
+  }
+
+  rapidjson::ParseResult parse_result;
+  bool is_valid = true;
+  std::string validation_error;
+
+  const auto parse_validated = [&](impl::Document& json) {
+    impl::ValidatingHandler validator(schema.pimpl_->schemaDocument, json);
+
+    rapidjson::MemoryStream memory_stream(doc.data(), doc.size());
+    rapidjson::EncodedInputStream<impl::UTF8, rapidjson::MemoryStream> stream(
+        memory_stream);
+    rapidjson::GenericReader<impl::UTF8, impl::UTF8, rapidjson::CrtAllocator>
+        reader;
+    parse_result = reader.Parse<rapidjson::kParseDefaultFlags |
+                                rapidjson::kParseIterativeFlag |
+                                rapidjson::kParseFullPrecisionFlag>(stream,
+                                                                    validator);
+
+    is_valid = validator.IsValid();
+    if (!is_valid) validation_error = MakeValidationError(validator);
+    return is_valid && !parse_result.IsError();
+  };
+
+  impl::Document json{&g_allocator};
+  json.Populate(parse_validated);
+
+  if (!is_valid) {
+    throw SchemaValidationException(std::move(validation_error));
+  }
+  if (parse_result.IsError()) {
+    throw ParseException(
+        fmt::format("JSON parse error at offset {}: {}", parse_result.Offset(),
+                    rapidjson::GetParseError_En(parse_result.Code())));
+  }
+
+  impl::CheckKeyUniqueness(&json);
+  return Value{impl::VersionedValuePtr::Create(std::move(json))};
+}
+
 }  // namespace formats::json
 
 USERVER_NAMESPACE_END
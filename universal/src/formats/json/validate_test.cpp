@@ -135,4 +135,39 @@ TEST(FormatsJsonValidate, InvalidInput) {
   EXPECT_FALSE(formats::json::Validate(jsonDocument, schema));
 }
 
+TEST(FormatsJsonValidate, FromStringValidated) {
+  const formats::json::Schema schema(formats::json::FromString(kSchemaJson));
+
+  const auto json = formats::json::FromStringValidated(kValidInputJson, schema);
+  EXPECT_EQ(json, formats::json::FromString(kValidInputJson));
+  EXPECT_EQ(json[1]["name"].As<std::string>(), "A blue mouse");
+
+  EXPECT_THROW(formats::json::FromStringValidated(kInvalidInputJson, schema),
+               formats::json::SchemaValidationException);
+  EXPECT_THROW(formats::json::FromStringValidated(R"({"id": 1})", schema),
+               formats::json::SchemaValidationException);
+
+  EXPECT_THROW(formats::json::FromStringValidated("", schema),
+               formats::json::ParseException);
+  EXPECT_THROW(formats::json::FromStringValidated("[{]", schema),
+               formats::json::ParseException);
+  EXPECT_THROW(formats::json::FromStringValidated(
+                   R"([{"id": 1, "name": "a", "price": 1, "id": 2}])", schema),
+               formats::json::ParseException);
+}
+
+TEST(FormatsJsonValidate, FromStringValidatedError) {
+  const formats::json::Schema schema(formats::json::FromString(kSchemaJson));
+
+  try {
+    formats::json::FromStringValidated(
+        R"([{"id": 1, "name": "a", "price": 0}])", schema);
+    FAIL() << "expected exception";
+  } catch (const formats::json::SchemaValidationException& e) {
+    EXPECT_EQ(std::string{e.what()},
+              "JSON schema validation error at '#/0/price': 'minimum' keyword "
+              "failed");
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -2,8 +2,6 @@
 
 #include <rapidjson/allocators.h>
 #include <rapidjson/document.h>
-#include <rapidjson/stringbuffer.h>
-#include <rapidjson/writer.h>
 
 #include <userver/formats/json/exception.hpp>
 #include <userver/formats/json/value.hpp>
@@ -12,6 +10,7 @@
 
 #include <formats/common/validations.hpp>
 #include <formats/json/impl/types_impl.hpp>
+#include <formats/json/impl/writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -34,7 +33,7 @@ rapidjson::Type ToNativeType(Type type) {
   }
 }
 
-::rapidjson::CrtAllocator g_allocator;
+impl::Allocator g_allocator;
 
 }  // namespace
 
@@ -114,7 +113,8 @@ ValueBuilder::ValueBuilder(const formats::json::Value& other) {
 ValueBuilder::ValueBuilder(formats::json::Value&& other) {
   // As we have new native object created,
   // we fill it with the other's native object.
-  if (other.IsUniqueReference())
+  // Nodes of arena documents can not be freed separately
+  if (other.IsUniqueReference() && !other.holder_.IsArenaAllocated())
     value_->GetNative() = std::move(other.GetNative());
   else
     // rapidjson uses move semantics in assignment
@@ -0,0 +1,420 @@
+#include <userver/formats/msgpack/serialize.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <fmt/format.h>
+#include <rapidjson/document.h>
+#include <boost/container/small_vector.hpp>
+
+#include <formats/json/impl/accept.hpp>
+#include <formats/json/impl/json_tree.hpp>
+#include <formats/json/impl/types_impl.hpp>
+#include <userver/formats/msgpack/exception.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace formats::msgpack {
+
+namespace {
+
+namespace json_impl = formats::json::impl;
+
+// https://github.com/msgpack/msgpack/blob/master/spec.md
+namespace tag {
+
+constexpr std::uint8_t kPositiveFixintMax = 0x7f;
+constexpr std::uint8_t kFixmap = 0x80;
+constexpr std::uint8_t kFixmapMax = 0x8f;
+constexpr std::uint8_t kFixarray = 0x90;
+constexpr std::uint8_t kFixarrayMax = 0x9f;
+constexpr std::uint8_t kFixstr = 0xa0;
+constexpr std::uint8_t kFixstrMax = 0xbf;
+constexpr std::uint8_t kNil = 0xc0;
+constexpr std::uint8_t kFalse = 0xc2;
+constexpr std::uint8_t kTrue = 0xc3;
+constexpr std::uint8_t kBin8 = 0xc4;
+constexpr std::uint8_t kBin16 = 0xc5;
+constexpr std::uint8_t kBin32 = 0xc6;
+constexpr std::uint8_t kFloat32 = 0xca;
+constexpr std::uint8_t kFloat64 = 0xcb;
+constexpr std::uint8_t kUint8 = 0xcc;
+constexpr std::uint8_t kUint16 = 0xcd;
+constexpr std::uint8_t kUint32 = 0xce;
+constexpr std::uint8_t kUint64 = 0xcf;
+constexpr std::uint8_t kInt8 = 0xd0;
+constexpr std::uint8_t kInt16 = 0xd1;
+constexpr std::uint8_t kInt32 = 0xd2;
+constexpr std::uint8_t kInt64 = 0xd3;
+constexpr std::uint8_t kStr8 = 0xd9;
+constexpr std::uint8_t kStr16 = 0xda;
+constexpr std::uint8_t kStr32 = 0xdb;
+constexpr std::uint8_t kArray16 = 0xdc;
+constexpr std::uint8_t kArray32 = 0xdd;
+constexpr std::uint8_t kMap16 = 0xde;
+constexpr std::uint8_t kMap32 = 0xdf;
+constexpr std::uint8_t kNegativeFixint = 0xe0;
+
+}  // namespace tag
+
+constexpr std::size_t kFixContainerMaxSize = 15;
+constexpr std::size_t kFixstrMaxSize = 31;
+
+json_impl::Allocator g_allocator;
+
+/// rapidjson handler that writes the most compact MessagePack encoding of
+/// the values
+class Writer final {
+ public:
+  explicit Writer(std::string& buffer) : buffer_(buffer) {}
+
+  bool Null() { return PutType(tag::kNil); }
+  bool Bool(bool b) { return PutType(b ? tag::kTrue : tag::kFalse); }
+  bool Int(int i) { return Int64(i); }
+  bool Uint(unsigned u) { return Uint64(u); }
+
+  bool Int64(std::int64_t i) {
+    if (i >= 0) return Uint64(static_cast<std::uint64_t>(i));
+
+    if (i >= -32) {
+      return PutType(static_cast<std::uint8_t>(i));
+    } else if (i >= std::numeric_limits<std::int8_t>::min()) {
+      return Put(tag::kInt8, static_cast<std::uint8_t>(i));
+    } else if (i >= std::numeric_limits<std::int16_t>::min()) {
+      return Put(tag::kInt16, static_cast<std::uint16_t>(i));
+    } else if (i >= std::numeric_limits<std::int32_t>::min()) {
+      return Put(tag::kInt32, static_cast<std::uint32_t>(i));
+    }
+    return Put(tag::kInt64, static_cast<std::uint64_t>(i));
+  }
+
+  bool Uint64(std::uint64_t u) {
+    if (u <= tag::kPositiveFixintMax) {
+      return PutType(static_cast<std::uint8_t>(u));
+    } else if (u <= std::numeric_limits<std::uint8_t>::max()) {
+      return Put(tag::kUint8, static_cast<std::uint8_t>(u));
+    } else if (u <= std::numeric_limits<std::uint16_t>::max()) {
+      return Put(tag::kUint16, static_cast<std::uint16_t>(u));
+    } else if (u <= std::numeric_limits<std::uint32_t>::max()) {
+      return Put(tag::kUint32, static_cast<std::uint32_t>(u));
+    }
+    return Put(tag::kUint64, u);
+  }
+
+  bool Double(double d) {
+    // float32 is 4 bytes shorter and is parsed back into the same double
+    const auto f = static_cast<float>(d);
+    if (static_cast<double>(f) == d) {
+      std::uint32_t bits{};
+      static_assert(sizeof(bits) == sizeof(f));
+      std::memcpy(&bits, &f, sizeof(f));
+      return Put(tag::kFloat32, bits);
+    }
+
+    std::uint64_t bits{};
+    static_assert(sizeof(bits) == sizeof(d));
+    std::memcpy(&bits, &d, sizeof(d));
+    return Put(tag::kFloat64, bits);
+  }
+
+  bool String(const char* str, rapidjson::SizeType length, bool /*copy*/) {
+    if (length <= kFixstrMaxSize) {
+      PutType(static_cast<std::uint8_t>(tag::kFixstr | length));
+    } else if (length <= std::numeric_limits<std::uint8_t>::max()) {
+      Put(tag::kStr8, static_cast<std::uint8_t>(length));
+    } else if (length <= std::numeric_limits<std::uint16_t>::max()) {
+      Put(tag::kStr16, static_cast<std::uint16_t>(length));
+    } else {
+      Put(tag::kStr32, static_cast<std::uint32_t>(length));
+    }
+    buffer_.append(str, length);
+    return true;
+  }
+
+  bool Key(const char* str, rapidjson::SizeType length, bool copy) {
+    return String(str, length, copy);
+  }
+
+  bool StartObject(std::size_t size) {
+    return PutContainerHeader(size, tag::kFixmap, tag::kMap16, tag::kMap32);
+  }
+
+  bool EndObject(std::size_t /*size*/) { return true; }
+
+  bool StartArray(std::size_t size) {
+    return PutContainerHeader(size, tag::kFixarray, tag::kArray16,
+                              tag::kArray32);
+  }
+
+  bool EndArray(std::size_t /*size*/) { return true; }
+
+  // Required by impl::Value::Accept, while the containers are always
+  // written by AcceptNoRecursion with the sizes
+  bool StartObject() { return UnsizedContainer(); }
+  bool StartArray() { return UnsizedContainer(); }
+
+ private:
+  static bool UnsizedContainer() {
+    UASSERT_MSG(false, "MessagePack containers must be written with sizes");
+    return false;
+  }
+
+  bool PutType(std::uint8_t type) {
+    buffer_.push_back(static_cast<char>(type));
+    return true;
+  }
+
+  // MessagePack stores the numbers in big-endian byte order
+  template <typename T>
+  bool Put(std::uint8_t type, T value) {
+    char bytes[1 + sizeof(T)];
+    bytes[0] = static_cast<char>(type);
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      bytes[sizeof(T) - i] = static_cast<char>((value >> (i * 8)) & 0xff);
+    }
+    buffer_.append(bytes, sizeof(bytes));
+    return true;
+  }
+
+  bool PutContainerHeader(std::size_t size, std::uint8_t fix_type,
+                          std::uint8_t type16, std::uint8_t type32) {
+    UASSERT(size <= std::numeric_limits<std::uint32_t>::max());
+    if (size <= kFixContainerMaxSize) {
+      return PutType(static_cast<std::uint8_t>(fix_type | size));
+    } else if (size <= std::numeric_limits<std::uint16_t>::max()) {
+      return Put(type16, static_cast<std::uint16_t>(size));
+    }
+    return Put(type32, static_cast<std::uint32_t>(size));
+  }
+
+  std::string& buffer_;
+};
+
+/// Generates the events for json_impl::Document::Populate from MessagePack,
+/// without recursion
+class Reader final {
+ public:
+  explicit Reader(std::string_view doc) : doc_(doc) {}
+
+  bool operator()(json_impl::Document& handler) {
+    do {
+      if (!stack_.empty()) {
+        auto& frame = stack_.back();
+        if (frame.remaining == 0) {
+          if (frame.is_object) {
+            handler.EndObject(frame.size);
+          } else {
+            handler.EndArray(frame.size);
+          }
+          stack_.pop_back();
+          continue;
+        }
+
+        --frame.remaining;
+        if (frame.is_object) ReadKey(handler);
+      }
+
+      ReadValue(handler);
+    } while (!stack_.empty());
+
+    if (pos_ != doc_.size()) Throw("unexpected data after the document");
+    return true;
+  }
+
+ private:
+  struct Frame {
+    bool is_object;
+    std::uint32_t size;
+    std::uint32_t remaining;
+  };
+
+  void ReadKey(json_impl::Document& handler) {
+    const auto type = ReadByte();
+    const auto length = ReadStringLength(type);
+    if (!length) {
+      Throw(fmt::format("map key is not a string, type {:#x}", type));
+    }
+    const auto* key = ReadBytes(*length);
+    handler.Key(key, *length, /*copy=*/true);
+  }
+
+  void ReadValue(json_impl::Document& handler) {
+    const auto type = ReadByte();
+    if (type <= tag::kPositiveFixintMax) {
+      handler.Uint64(type);
+    } else if (type <= tag::kFixmapMax) {
+      StartContainer(handler, /*is_object=*/true, type & 0x0f);
+    } else if (type <= tag::kFixarrayMax) {
+      StartContainer(handler, /*is_object=*/false, type & 0x0f);
+    } else if (type >= tag::kNegativeFixint) {
+      handler.Int64(static_cast<std::int8_t>(type));
+    } else if (const auto length = ReadStringLength(type)) {
+      const auto* str = ReadBytes(*length);
+      handler.String(str, *length, /*copy=*/true);
+    } else {
+      ReadTaggedValue(handler, type);
+    }
+  }
+
+  void ReadTaggedValue(json_impl::Document& handler, std::uint8_t type) {
+    switch (type) {
+      case tag::kNil:
+        handler.Null();
+        return;
+      case tag::kFalse:
+        handler.Bool(false);
+        return;
+      case tag::kTrue:
+        handler.Bool(true);
+        return;
+      case tag::kFloat32: {
+        const auto bits = Read<std::uint32_t>();
+        float f{};
+        static_assert(sizeof(bits) == sizeof(f));
+        std::memcpy(&f, &bits, sizeof(f));
+        handler.Double(f);
+        return;
+      }
+      case tag::kFloat64: {
+        const auto bits = Read<std::uint64_t>();
+        double d{};
+        std::memcpy(&d, &bits, sizeof(d));
+        handler.Double(d);
+        return;
+      }
+      case tag::kUint8:
+        handler.Uint64(Read<std::uint8_t>());
+        return;
+      case tag::kUint16:
+        handler.Uint64(Read<std::uint16_t>());
+        return;
+      case tag::kUint32:
+        handler.Uint64(Read<std::uint32_t>());
+        return;
+      case tag::kUint64:
+        handler.Uint64(Read<std::uint64_t>());
+        return;
+      case tag::kInt8:
+        handler.Int64(static_cast<std::int8_t>(Read<std::uint8_t>()));
+        return;
+      case tag::kInt16:
+        handler.Int64(static_cast<std::int16_t>(Read<std::uint16_t>()));
+        return;
+      case tag::kInt32:
+        handler.Int64(static_cast<std::int32_t>(Read<std::uint32_t>()));
+        return;
+      case tag::kInt64:
+        handler.Int64(static_cast<std::int64_t>(Read<std::uint64_t>()));
+        return;
+      case tag::kArray16:
+        StartContainer(handler, /*is_object=*/false, Read<std::uint16_t>());
+        return;
+      case tag::kArray32:
+        StartContainer(handler, /*is_object=*/false, Read<std::uint32_t>());
+        return;
+      case tag::kMap16:
+        StartContainer(handler, /*is_object=*/true, Read<std::uint16_t>());
+        return;
+      case tag::kMap32:
+        StartContainer(handler, /*is_object=*/true, Read<std::uint32_t>());
+        return;
+      default:
+        // never used 0xc1 and the extension types
+        Throw(fmt::format("unsupported type {:#x}", type));
+    }
+  }
+
+  // Returns the length of str and bin values, std::nullopt for other tags
+  std::optional<std::uint32_t> ReadStringLength(std::uint8_t type) {
+    if (type >= tag::kFixstr && type <= tag::kFixstrMax) return type & 0x1f;
+
+    switch (type) {
+      case tag::kStr8:
+      case tag::kBin8:
+        return Read<std::uint8_t>();
+      case tag::kStr16:
+      case tag::kBin16:
+        return Read<std::uint16_t>();
+      case tag::kStr32:
+      case tag::kBin32:
+        return Read<std::uint32_t>();
+      default:
+        return std::nullopt;
+    }
+  }
+
+  void StartContainer(json_impl::Document& handler, bool is_object,
+                      std::uint32_t size) {
+    if (is_object) {
+      handler.StartObject();
+    } else {
+      handler.StartArray();
+    }
+    stack_.push_back({is_object, size, size});
+  }
+
+  std::uint8_t ReadByte() { return static_cast<std::uint8_t>(*ReadBytes(1)); }
+
+  template <typename T>
+  T Read() {
+    const auto* bytes = ReadBytes(sizeof(T));
+    T value{0};
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+      value = static_cast<T>(value << 8) |
+              static_cast<T>(static_cast<std::uint8_t>(bytes[i]));
+    }
+    return value;
+  }
+
+  const char* ReadBytes(std::size_t count) {
+    if (doc_.size() - pos_ < count) Throw("unexpected end of data");
+    const auto* bytes = doc_.data() + pos_;
+    pos_ += count;
+    return bytes;
+  }
+
+  [[noreturn]] void Throw(std::string_view message) const {
+    throw ParseException(fmt::format("MessagePack parse error at offset {}: {}",
+                                     pos_, message));
+  }
+
+  std::string_view doc_;
+  std::size_t pos_{0};
+  boost::container::small_vector<Frame, json_impl::kInitialStackDepth> stack_;
+};
+
+}  // namespace
+
+formats::msgpack::Value FromString(std::string_view doc) {
+  if (doc.empty()) {
+    throw ParseException("MessagePack document is empty");
+  }
+
+  json_impl::Document json{&g_allocator};
+  Reader reader{doc};
+  json.Populate(reader);
+
+  try {
+    json_impl::CheckKeyUniqueness(&json);
+  } catch (const formats::json::ParseException& e) {
+    throw ParseException(e.what());
+  }
+
+  return Value{json_impl::VersionedValuePtr::Create(std::move(json))};
+}
+
+std::string ToString(const formats::msgpack::Value& doc) {
+  std::string buffer;
+  Writer writer{buffer};
+  formats::json::AcceptNoRecursion(doc.GetNative(), writer);
+  return buffer;
+}
+
+}  // namespace formats::msgpack
+
+USERVER_NAMESPACE_END
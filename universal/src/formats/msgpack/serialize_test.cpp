@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/msgpack.hpp>
+#include <userver/formats/parse/common_containers.hpp>
+#include <userver/formats/serialize/common_containers.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace msgpack = formats::msgpack;
+
+using formats::msgpack::ValueBuilder;
+
+std::string Bytes(std::initializer_list<std::uint8_t> bytes) {
+  return {bytes.begin(), bytes.end()};
+}
+
+template <typename T>
+std::string Pack(const T& value) {
+  return msgpack::ToString(ValueBuilder{value}.ExtractValue());
+}
+
+}  // namespace
+
+TEST(FormatsMsgpack, Scalars) {
+  EXPECT_EQ(msgpack::ToString({}), Bytes({0xc0}));
+  EXPECT_EQ(Pack(true), Bytes({0xc3}));
+  EXPECT_EQ(Pack(false), Bytes({0xc2}));
+
+  EXPECT_EQ(Pack(0), Bytes({0x00}));
+  EXPECT_EQ(Pack(127), Bytes({0x7f}));
+  EXPECT_EQ(Pack(128), Bytes({0xcc, 0x80}));
+  EXPECT_EQ(Pack(70000), Bytes({0xce, 0x00, 0x01, 0x11, 0x70}));
+  EXPECT_EQ(Pack(std::numeric_limits<std::uint64_t>::max()),
+            Bytes({0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff}));
+
+  EXPECT_EQ(Pack(-1), Bytes({0xff}));
+  EXPECT_EQ(Pack(-32), Bytes({0xe0}));
+  EXPECT_EQ(Pack(-33), Bytes({0xd0, 0xdf}));
+  EXPECT_EQ(Pack(-200), Bytes({0xd1, 0xff, 0x38}));
+  EXPECT_EQ(Pack(std::numeric_limits<std::int64_t>::min()),
+            Bytes({0xd3, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}));
+
+  EXPECT_EQ(Pack(1.5), Bytes({0xca, 0x3f, 0xc0, 0x00, 0x00}));
+  EXPECT_EQ(Pack(0.1),
+            Bytes({0xcb, 0x3f, 0xb9, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a}));
+
+  EXPECT_EQ(Pack(std::string{"abc"}), Bytes({0xa3, 'a', 'b', 'c'}));
+  EXPECT_EQ(Pack(std::string(32, 'x')).substr(0, 2), Bytes({0xd9, 32}));
+  EXPECT_EQ(Pack(std::string(256, 'x')).substr(0, 3), Bytes({0xda, 1, 0}));
+}
+
+TEST(FormatsMsgpack, Containers) {
+  EXPECT_EQ(Pack(std::vector<int>{1, 2}), Bytes({0x92, 0x01, 0x02}));
+  EXPECT_EQ(Pack(std::vector<int>{}), Bytes({0x90}));
+  EXPECT_EQ(Pack(std::vector<int>(16, 1)).substr(0, 3),
+            Bytes({0xdc, 0x00, 0x10}));
+
+  EXPECT_EQ(Pack(std::map<std::string, int>{{"a", 1}}),
+            Bytes({0x81, 0xa1, 'a', 0x01}));
+  EXPECT_EQ(msgpack::ToString(formats::json::FromString("{}")), Bytes({0x80}));
+}
+
+TEST(FormatsMsgpack, RoundTrip) {
+  const auto json = formats::json::FromString(R"({
+    "null": null, "bool": true, "int": -123456789012,
+    "uint": 18446744073709551615, "double": 3.25, "string": "строка",
+    "empty": "",
+    "array": [1, [2, [3, {}]], [], {"k": [null]}],
+    "object": {"nested": {"deeply": {"a": 1, "b": "c"}}}
+  })");
+  EXPECT_EQ(msgpack::FromString(msgpack::ToString(json)), json);
+
+  ValueBuilder builder{formats::common::Type::kObject};
+  for (int i = 0; i < 70000; ++i) {
+    builder["arr"].PushBack(i);
+    if (i % 1000 == 0) builder[std::to_string(i)] = std::string(i, 'x');
+  }
+  const auto big = builder.ExtractValue();
+  EXPECT_EQ(msgpack::FromString(msgpack::ToString(big)), big);
+}
+
+TEST(FormatsMsgpack, UserTypes) {
+  using Data = std::map<std::string, std::vector<double>>;
+  const Data data{{"a", {1.5, -2}}, {"b", {}}};
+  const auto packed = Pack(data);
+  EXPECT_EQ(msgpack::FromString(packed).As<Data>(), data);
+  EXPECT_LT(packed.size(),
+            formats::json::ToString(ValueBuilder{data}.ExtractValue()).size());
+}
+
+TEST(FormatsMsgpack, ParseEncodings) {
+  // float32 1.5
+  EXPECT_EQ(
+      msgpack::FromString(Bytes({0xca, 0x3f, 0xc0, 0x00, 0x00})).As<double>(),
+      1.5);
+  // int8 -1, int16 -1, int32 -2
+  EXPECT_EQ(msgpack::FromString(Bytes({0xd0, 0xff})).As<int>(), -1);
+  EXPECT_EQ(msgpack::FromString(Bytes({0xd1, 0xff, 0xff})).As<int>(), -1);
+  EXPECT_EQ(
+      msgpack::FromString(Bytes({0xd2, 0xff, 0xff, 0xff, 0xfe})).As<int>(), -2);
+  // non-compact uint16 5
+  EXPECT_EQ(msgpack::FromString(Bytes({0xcd, 0x00, 0x05})).As<int>(), 5);
+  // bin8 "ab"
+  EXPECT_EQ(
+      msgpack::FromString(Bytes({0xc4, 0x02, 'a', 'b'})).As<std::string>(),
+      "ab");
+  // map16 {"a": [true]}
+  const auto map =
+      msgpack::FromString(Bytes({0xde, 0x00, 0x01, 0xa1, 'a', 0x91, 0xc3}));
+  EXPECT_TRUE(map["a"][0].As<bool>());
+}
+
+TEST(FormatsMsgpack, ParseErrors) {
+  using formats::msgpack::ParseException;
+
+  EXPECT_THROW(msgpack::FromString(""), ParseException);
+  // truncated
+  EXPECT_THROW(msgpack::FromString(Bytes({0xcd, 0x00})), ParseException);
+  EXPECT_THROW(msgpack::FromString(Bytes({0xa3, 'a'})), ParseException);
+  EXPECT_THROW(msgpack::FromString(Bytes({0x92, 0x01})), ParseException);
+  EXPECT_THROW(msgpack::FromString(Bytes({0xdd, 0xff, 0xff, 0xff, 0xff})),
+               ParseException);
+  // trailing data
+  EXPECT_THROW(msgpack::FromString(Bytes({0x01, 0x02})), ParseException);
+  // never used tag and fixext1
+  EXPECT_THROW(msgpack::FromString(Bytes({0xc1})), ParseException);
+  EXPECT_THROW(msgpack::FromString(Bytes({0xd4, 0x01, 0x00})), ParseException);
+  // {1: 2}
+  EXPECT_THROW(msgpack::FromString(Bytes({0x81, 0x01, 0x02})), ParseException);
+  // {"a": 1, "a": 2}
+  EXPECT_THROW(
+      msgpack::FromString(Bytes({0x82, 0xa1, 'a', 0x01, 0xa1, 'a', 0x02})),
+      ParseException);
+
+  try {
+    msgpack::FromString(Bytes({0x92, 0x01}));
+    FAIL() << "expected exception";
+  } catch (const formats::json::ParseException& e) {
+    EXPECT_EQ(std::string{e.what()},
+              "MessagePack parse error at offset 2: unexpected end of data");
+  }
+}
+
+USERVER_NAMESPACE_END
@@ -11,6 +11,7 @@
 #include <boost/filesystem/operations.hpp>
 
 #include <userver/logging/log.hpp>
+#include <fs/blocking/native_open_mode.hpp>
 #include <userver/utils/assert.hpp>
 #include <utils/check_syscall.hpp>
 
@@ -18,7 +19,7 @@ USERVER_NAMESPACE_BEGIN
 
 namespace fs::blocking {
 
-namespace {
+namespace impl {
 
 int ToNative(OpenMode flags) {
   int result = 0;
@@ -66,6 +67,10 @@ int ToNative(OpenMode flags) {
   return result;
 }
 
+}  // namespace impl
+
+namespace {
+
 auto GetFileStats(int fd) {
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
   struct ::stat result;
@@ -83,7 +88,8 @@ FileDescriptor FileDescriptor::Open(const std::string& path, OpenMode flags,
                                     boost::filesystem::perms perms) {
   UASSERT(!path.empty());
   const auto fd = utils::CheckSyscall(
-      ::open(path.c_str(), ToNative(flags), perms), "opening file '{}'", path);
+      ::open(path.c_str(), impl::ToNative(flags), perms), "opening file '{}'",
+      path);
   return FileDescriptor{fd};
 }
 
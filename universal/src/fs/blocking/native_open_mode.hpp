@@ -0,0 +1,14 @@
+#pragma once
+
+#include <userver/fs/blocking/open_mode.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace fs::blocking::impl {
+
+/// Flags for ::open, O_CLOEXEC is always set
+int ToNative(OpenMode flags);
+
+}  // namespace fs::blocking::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,69 @@
+#include <userver/hostinfo/blocking/cgroup_cpu.hpp>
+
+#include <stdexcept>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include <userver/fs/blocking/read.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace hostinfo::blocking {
+
+namespace {
+
+// `cpu.max` contains "$MAX $PERIOD", where $MAX is "max" for no quota
+std::optional<double> ParseCpuMax(const std::string& contents) {
+  const auto fields = utils::text::Split(utils::text::Trim(contents), " ");
+  if (fields.size() != 2) {
+    throw std::runtime_error(
+        fmt::format("Unexpected cpu.max contents: '{}'", contents));
+  }
+  if (fields[0] == "max") return std::nullopt;
+
+  const auto max = utils::FromString<std::uint64_t>(fields[0]);
+  const auto period = utils::FromString<std::uint64_t>(fields[1]);
+  if (period == 0) {
+    throw std::runtime_error(
+        fmt::format("Unexpected cpu.max contents: '{}'", contents));
+  }
+  return static_cast<double>(max) / static_cast<double>(period);
+}
+
+// `cpu.stat` contains "$KEY $VALUE" lines
+std::uint64_t ParseNrThrottled(std::string_view contents) {
+  constexpr std::string_view kKey = "nr_throttled ";
+  for (const auto line :
+       utils::text::SplitIntoStringViewVector(contents, "\n")) {
+    if (utils::text::StartsWith(line, kKey)) {
+      return utils::FromString<std::uint64_t>(line.substr(kKey.size()));
+    }
+  }
+  // The throttling stats are missing while the CPU controller is disabled
+  return 0;
+}
+
+}  // namespace
+
+std::optional<CgroupCpuStats> ReadCgroupCpuStats(
+    const std::string& cgroup_path) {
+  const auto cpu_max_path = cgroup_path + "/cpu.max";
+  const auto cpu_stat_path = cgroup_path + "/cpu.stat";
+  if (!fs::blocking::FileExists(cpu_max_path) ||
+      !fs::blocking::FileExists(cpu_stat_path)) {
+    return std::nullopt;
+  }
+
+  CgroupCpuStats stats;
+  stats.quota = ParseCpuMax(fs::blocking::ReadFileContents(cpu_max_path));
+  stats.nr_throttled =
+      ParseNrThrottled(fs::blocking::ReadFileContents(cpu_stat_path));
+  return stats;
+}
+
+}  // namespace hostinfo::blocking
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,57 @@
+#include <userver/hostinfo/blocking/cgroup_cpu.hpp>
+
+#include <gtest/gtest.h>
+
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kCpuStat = R"(usage_usec 1000
+user_usec 700
+system_usec 300
+nr_periods 50
+nr_throttled 7
+throttled_usec 4000
+)";
+
+}  // namespace
+
+TEST(ReadCgroupCpuStats, Quota) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/cpu.max",
+                                    "250000 100000\n");
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/cpu.stat", kCpuStat);
+
+  const auto stats = hostinfo::blocking::ReadCgroupCpuStats(dir.GetPath());
+  ASSERT_TRUE(stats);
+  ASSERT_TRUE(stats->quota);
+  EXPECT_DOUBLE_EQ(*stats->quota, 2.5);
+  EXPECT_EQ(stats->nr_throttled, 7);
+}
+
+TEST(ReadCgroupCpuStats, NoQuota) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/cpu.max",
+                                    "max 100000\n");
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/cpu.stat",
+                                    "usage_usec 1000\n");
+
+  const auto stats = hostinfo::blocking::ReadCgroupCpuStats(dir.GetPath());
+  ASSERT_TRUE(stats);
+  EXPECT_FALSE(stats->quota);
+  EXPECT_EQ(stats->nr_throttled, 0);
+}
+
+TEST(ReadCgroupCpuStats, Missing) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  EXPECT_FALSE(hostinfo::blocking::ReadCgroupCpuStats(dir.GetPath()));
+
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/cpu.max", "garbage");
+  fs::blocking::RewriteFileContents(dir.GetPath() + "/cpu.stat", kCpuStat);
+  EXPECT_ANY_THROW(hostinfo::blocking::ReadCgroupCpuStats(dir.GetPath()));
+}
+
+USERVER_NAMESPACE_END
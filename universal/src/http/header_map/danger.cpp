@@ -26,6 +26,16 @@ std::size_t Danger::HashKey(const PredefinedHeader& header) const noexcept {
   return SafeHash(header.name);
 }
 
+std::size_t Danger::HashKey(std::string_view key,
+                            std::size_t unsafe_hash) const noexcept {
+  UASSERT(unsafe_hash == UnsafeHash(key));
+  if (!IsRed()) {
+    return unsafe_hash;
+  }
+
+  return SafeHash(key);
+}
+
 bool Danger::IsYellow() const noexcept { return state_ == State::kYellow; }
 bool Danger::IsRed() const noexcept { return state_ == State::kRed; }
 
@@ -12,6 +12,9 @@ class Danger final {
  public:
   std::size_t HashKey(std::string_view key) const noexcept;
   std::size_t HashKey(const PredefinedHeader& header) const noexcept;
+  // `unsafe_hash` must be the impl::UnsafeConstexprHasher hash of the `key`
+  std::size_t HashKey(std::string_view key,
+                      std::size_t unsafe_hash) const noexcept;
 
   bool IsYellow() const noexcept;
   bool IsRed() const noexcept;
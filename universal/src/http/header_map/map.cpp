@@ -363,18 +363,8 @@ Traits::HashValue Map::HashKey(const PredefinedHeader& header) const noexcept {
   return MaskHash(danger_.HashKey(header));
 }
 
-Traits::HeaderIndex Map::InsertEntry(std::string&& key, std::string&& value) {
-  // we could potentially restructure the code a bit, so instead of hashing
-  // and then at some point looking for index here,
-  // we look for index first, and if it's found - that means we already know the
-  // hash (the header name is known upfront, thus the hash is known as well).
-  // Clobbers interface/implementation a bit, and
-  // we're not sure if its worth it, since default hash is decently fast anyway.
-  const auto header_index = impl::GetHeaderIndexForInsertion(key);
-
+void Map::InsertEntry(std::string&& key, std::string&& value) {
   entries_.emplace_back(std::move(key), std::move(value));
-
-  return header_index;
 }
 
 Map::ConstIterator Map::Find(std::string_view key) const noexcept {
@@ -448,21 +438,36 @@ Map::FindResult Map::DoFind(std::string_view key, Traits::HashValue hash,
 Map::Iterator Map::InsertOrModify(
     MaybeOwnedKey key, std::string&& value,
     InsertOrModifyOccupiedAction occupied_action) {
-  return DoInsertOrModify(key, HashKey(key.GetValue()), std::move(value),
+  // Must be done before hashing, it may switch the hasher
+  ReserveOne();
+
+  // The known headers are looked up by the same hash, that the map uses
+  // unless it is under attack, so the key is hashed just once
+  const auto key_value = key.GetValue();
+  const auto unsafe_hash = impl::UnsafeConstexprHasher{}(key_value);
+  const auto header_index =
+      impl::GetHeaderIndexForInsertion(key_value, unsafe_hash);
+  const auto hash = MaskHash(danger_.HashKey(key_value, unsafe_hash));
+  return DoInsertOrModify(key, hash, header_index, std::move(value),
                           occupied_action);
 }
 
 Map::Iterator Map::InsertOrModify(
     const PredefinedHeader& header, std::string&& value,
     InsertOrModifyOccupiedAction occupied_action) {
-  return DoInsertOrModify(MaybeOwnedKey{header}, HashKey(header),
+  // Must be done before hashing, it may switch the hasher
+  ReserveOne();
+
+  const auto header_index = header.header_index == impl::kNoHeaderIndexLookup
+                                ? impl::kNoHeaderIndexInsertion
+                                : header.header_index;
+  return DoInsertOrModify(MaybeOwnedKey{header}, HashKey(header), header_index,
                           std::move(value), occupied_action);
 }
 
 Map::Iterator Map::DoInsertOrModify(
-    MaybeOwnedKey key, Traits::HashValue hash, std::string&& value,
-    InsertOrModifyOccupiedAction occupied_action) {
-  ReserveOne();
+    MaybeOwnedKey key, Traits::HashValue hash, Traits::HeaderIndex header_index,
+    std::string&& value, InsertOrModifyOccupiedAction occupied_action) {
 
   const auto perform_occupied = [this, occupied_action](std::size_t entries_idx,
                                                         std::string&& value) {
@@ -494,10 +499,10 @@ Map::Iterator Map::DoInsertOrModify(
   };
 
   const auto perform_robinhood =
-      [this, hash](std::size_t dist, std::size_t positions_idx,
-                   std::string&& key, std::string&& value) {
+      [this, hash, header_index](std::size_t dist, std::size_t positions_idx,
+                                 std::string&& key, std::string&& value) {
         const auto entries_index = entries_.size();
-        const auto header_index = InsertEntry(std::move(key), std::move(value));
+        InsertEntry(std::move(key), std::move(value));
 
         const auto num_displaced = DoRobinhoodAtPosition(
             positions_idx, Pos{entries_index, hash, header_index});
@@ -508,11 +513,11 @@ Map::Iterator Map::DoInsertOrModify(
         }
       };
 
-  const auto perform_vacant = [this, hash](
+  const auto perform_vacant = [this, hash, header_index](
                                   std::size_t dist, std::size_t positions_idx,
                                   std::string&& key, std::string&& value) {
     const auto index = entries_.size();
-    const auto header_index = InsertEntry(std::move(key), std::move(value));
+    InsertEntry(std::move(key), std::move(value));
     positions_[positions_idx] = Pos{index, hash, header_index};
 
     if (dist >= kForwardShiftThreshold) {
@@ -521,7 +526,8 @@ Map::Iterator Map::DoInsertOrModify(
   };
 
   std::size_t dist = 0;
-  auto inserter = [this, key, hash, &value,  // comment for cleaner formatting
+  auto inserter = [this, key, hash, header_index,
+                   &value,  // comment for cleaner formatting
                    &perform_occupied, &perform_robinhood, &perform_vacant,
                    &dist](std::size_t positions_idx) mutable {
     if (positions_[positions_idx].IsSome()) {
@@ -534,11 +540,15 @@ Map::Iterator Map::DoInsertOrModify(
 
         return ProbingAction::kStop;
       } else if (positions_[positions_idx].GetHash() == hash &&
-                 AreValuesICaseEqual(
-                     entries_[positions_[positions_idx].GetEntriesIndex()]
-                         .Get()
-                         .first,
-                     key.GetValue())) {
+                 // the same known header, no need to compare the names
+                 ((header_index > 0 &&
+                   header_index ==
+                       positions_[positions_idx].GetHeaderIndex()) ||
+                  AreValuesICaseEqual(
+                      entries_[positions_[positions_idx].GetEntriesIndex()]
+                          .Get()
+                          .first,
+                      key.GetValue()))) {
         perform_occupied(positions_[positions_idx].GetEntriesIndex(),
                          std::move(value));
 
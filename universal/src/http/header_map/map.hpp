@@ -116,7 +116,7 @@ class Map final {
   Traits::HashValue HashKey(std::string_view key) const noexcept;
   Traits::HashValue HashKey(const PredefinedHeader& header) const noexcept;
 
-  Traits::HeaderIndex InsertEntry(std::string&& key, std::string&& value);
+  void InsertEntry(std::string&& key, std::string&& value);
   std::size_t DoRobinhoodAtPosition(std::size_t idx, Pos old_pos);
 
   struct FindResult final {
@@ -130,6 +130,7 @@ class Map final {
   FindResult DoFind(std::string_view key, Traits::HashValue hash,
                     int header_index) const noexcept;
   Iterator DoInsertOrModify(MaybeOwnedKey key, Traits::HashValue hash,
+                            Traits::HeaderIndex header_index,
                             std::string&& value,
                             InsertOrModifyOccupiedAction occupied_action);
   Iterator DoErase(std::string_view key, Traits::HashValue hash);
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <cctype>
+#include <string>
+
 #include <fmt/format.h>
 
 #include <userver/http/common_headers.hpp>
@@ -29,6 +32,27 @@ TEST(HeaderMapHasher, SameAtCompileTimeAndRuntime) {
   EXPECT_EQ(compile_time_hash, runtime_hash);
 }
 
+TEST(PredefinedHeader, KnownHeadersHaveIndexes) {
+  for (std::size_t i = 0; i < impl::kKnownHeadersCount; ++i) {
+    std::string name{impl::kKnownHeadersLowercase[i]};
+    EXPECT_EQ(impl::GetHeaderIndexForInsertion(name), static_cast<int>(i + 1))
+        << name;
+
+    for (auto& c : name) c = std::toupper(c);
+    EXPECT_EQ(impl::GetHeaderIndexForInsertion(name), static_cast<int>(i + 1))
+        << name;
+  }
+
+  static_assert(impl::GetHeaderIndexForLookup(
+                    "Content-Type", impl::UnsafeConstexprHasher{}(
+                                        std::string_view{"Content-Type"})) > 0);
+  EXPECT_EQ(impl::GetHeaderIndexForInsertion("X-Unknown-Header"),
+            impl::kNoHeaderIndexInsertion);
+  // Same hash as 'content-type' with the deliberately broken lowercase
+  EXPECT_EQ(impl::GetHeaderIndexForInsertion("[ontent-type"),
+            impl::kNoHeaderIndexInsertion);
+}
+
 TEST(PredefinedHeader, IsFormattable) {
   constexpr auto header = kXRequestApplication;
 
@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -1,8 +1,16 @@
 #include <userver/http/url.hpp>
 
 #include <array>
+#include <cstdint>
 
 #include <utils/impl/internal_tag.hpp>
+#include <utils/simd.hpp>
+
+#if defined(USERVER_IMPL_SIMD_X86)
+#include <immintrin.h>
+#elif defined(USERVER_IMPL_SIMD_NEON)
+#include <arm_neon.h>
+#endif
 
 USERVER_NAMESPACE_BEGIN
 
@@ -12,34 +20,213 @@ namespace {
 
 const std::string_view kSchemaSeparator = "://";
 
-void UrlEncodeTo(std::string_view input_string, std::string& result) {
-  for (char symbol : input_string) {
-    if (isalnum(symbol)) {
-      result.append(1, symbol);
-      continue;
+constexpr bool IsUnreserved(char symbol) noexcept {
+  if ((symbol >= '0' && symbol <= '9') || (symbol >= 'A' && symbol <= 'Z') ||
+      (symbol >= 'a' && symbol <= 'z')) {
+    return true;
+  }
+  switch (symbol) {
+    case '-':
+    case '_':
+    case '.':
+    case '!':
+    case '~':
+    case '*':
+    case '(':
+    case ')':
+    case '\'':
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The kernels below return the position of the first character that is not
+// unreserved, or the position they have stopped at
+
+#if defined(USERVER_IMPL_SIMD_X86)
+// The non-ASCII characters are negative and are never in the range
+USERVER_IMPL_SIMD_TARGET_SSSE3
+__m128i InRangeSsse3(__m128i in, char first, char last) noexcept {
+  return _mm_and_si128(_mm_cmpgt_epi8(in, _mm_set1_epi8(first - 1)),
+                       _mm_cmpgt_epi8(_mm_set1_epi8(last + 1), in));
+}
+
+USERVER_IMPL_SIMD_TARGET_SSSE3
+const char* FindReservedSsse3(const char* begin, const char* end) noexcept {
+  for (; end - begin >= 16; begin += 16) {
+    const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const auto alnum =
+        _mm_or_si128(InRangeSsse3(in, '0', '9'),
+                     _mm_or_si128(InRangeSsse3(in, 'A', 'Z'),
+                                  InRangeSsse3(in, 'a', 'z')));
+    // '\'', '(', ')', '*' and '-', '.' are consecutive
+    const auto marks = _mm_or_si128(
+        _mm_or_si128(InRangeSsse3(in, '\'', '*'), InRangeSsse3(in, '-', '.')),
+        _mm_or_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('_')),
+                     _mm_or_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('!')),
+                                  _mm_cmpeq_epi8(in, _mm_set1_epi8('~')))));
+    const auto mask = static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_or_si128(alnum, marks)));
+    if (mask != 0xffff) return begin + __builtin_ctz(~mask);
+  }
+  return begin;
+}
+
+USERVER_IMPL_SIMD_TARGET_AVX2
+__m256i InRangeAvx2(__m256i in, char first, char last) noexcept {
+  return _mm256_and_si256(_mm256_cmpgt_epi8(in, _mm256_set1_epi8(first - 1)),
+                          _mm256_cmpgt_epi8(_mm256_set1_epi8(last + 1), in));
+}
+
+USERVER_IMPL_SIMD_TARGET_AVX2
+const char* FindReservedAvx2(const char* begin, const char* end) noexcept {
+  for (; end - begin >= 32; begin += 32) {
+    const auto in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    const auto alnum =
+        _mm256_or_si256(InRangeAvx2(in, '0', '9'),
+                        _mm256_or_si256(InRangeAvx2(in, 'A', 'Z'),
+                                        InRangeAvx2(in, 'a', 'z')));
+    const auto marks = _mm256_or_si256(
+        _mm256_or_si256(InRangeAvx2(in, '\'', '*'), InRangeAvx2(in, '-', '.')),
+        _mm256_or_si256(
+            _mm256_cmpeq_epi8(in, _mm256_set1_epi8('_')),
+            _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('!')),
+                            _mm256_cmpeq_epi8(in, _mm256_set1_epi8('~')))));
+    const auto mask = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_or_si256(alnum, marks)));
+    if (mask != 0xffffffff) return begin + __builtin_ctz(~mask);
+  }
+  return begin;
+}
+
+USERVER_IMPL_SIMD_TARGET_SSSE3
+const char* FindDecodeSpecialSsse3(const char* begin,
+                                   const char* end) noexcept {
+  for (; end - begin >= 16; begin += 16) {
+    const auto in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi8(in, _mm_set1_epi8('%')),
+                     _mm_cmpeq_epi8(in, _mm_set1_epi8('+')))));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+  }
+  return begin;
+}
+
+USERVER_IMPL_SIMD_TARGET_AVX2
+const char* FindDecodeSpecialAvx2(const char* begin,
+                                  const char* end) noexcept {
+  for (; end - begin >= 32; begin += 32) {
+    const auto in =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+        _mm256_or_si256(_mm256_cmpeq_epi8(in, _mm256_set1_epi8('%')),
+                        _mm256_cmpeq_epi8(in, _mm256_set1_epi8('+')))));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+  }
+  return begin;
+}
+#elif defined(USERVER_IMPL_SIMD_NEON)
+uint8x16_t InRangeNeon(uint8x16_t in, char first, char last) noexcept {
+  return vandq_u8(vcgeq_u8(in, vdupq_n_u8(first)),
+                  vcleq_u8(in, vdupq_n_u8(last)));
+}
+
+const char* FindReservedNeon(const char* begin, const char* end) noexcept {
+  for (; end - begin >= 16; begin += 16) {
+    const auto in = vld1q_u8(reinterpret_cast<const std::uint8_t*>(begin));
+    const auto alnum = vorrq_u8(
+        InRangeNeon(in, '0', '9'),
+        vorrq_u8(InRangeNeon(in, 'A', 'Z'), InRangeNeon(in, 'a', 'z')));
+    const auto marks = vorrq_u8(
+        vorrq_u8(InRangeNeon(in, '\'', '*'), InRangeNeon(in, '-', '.')),
+        vorrq_u8(vceqq_u8(in, vdupq_n_u8('_')),
+                 vorrq_u8(vceqq_u8(in, vdupq_n_u8('!')),
+                          vceqq_u8(in, vdupq_n_u8('~')))));
+    if (vminvq_u8(vorrq_u8(alnum, marks)) == 0) {
+      while (IsUnreserved(*begin)) ++begin;
+      return begin;
     }
-    switch (symbol) {
-      case '-':
-      case '_':
-      case '.':
-      case '!':
-      case '~':
-      case '*':
-      case '(':
-      case ')':
-      case '\'':
-        result.append(1, symbol);
-        break;
-      default:
-        std::array<char, 3> bytes = {'%', 0, 0};
-        bytes[1] = (symbol & 0xF0) / 16;
-        bytes[1] += (bytes[1] > 9) ? 'A' - 10 : '0';
-        bytes[2] = symbol & 0x0F;
-        bytes[2] += (bytes[2] > 9) ? 'A' - 10 : '0';
-        result.append(bytes.data(), bytes.size());
-        break;
+  }
+  return begin;
+}
+
+const char* FindDecodeSpecialNeon(const char* begin,
+                                  const char* end) noexcept {
+  for (; end - begin >= 16; begin += 16) {
+    const auto in = vld1q_u8(reinterpret_cast<const std::uint8_t*>(begin));
+    const auto special =
+        vorrq_u8(vceqq_u8(in, vdupq_n_u8('%')), vceqq_u8(in, vdupq_n_u8('+')));
+    if (vmaxvq_u8(special) != 0) {
+      while (*begin != '%' && *begin != '+') ++begin;
+      return begin;
     }
   }
+  return begin;
+}
+#endif
+
+const char* FindReserved(const char* begin, const char* end) noexcept {
+#if defined(USERVER_IMPL_SIMD_X86)
+  switch (utils::simd::GetInstructionSet()) {
+    case utils::simd::InstructionSet::kAvx2:
+      begin = FindReservedAvx2(begin, end);
+      break;
+    case utils::simd::InstructionSet::kSsse3:
+      begin = FindReservedSsse3(begin, end);
+      break;
+    default:
+      break;
+  }
+#elif defined(USERVER_IMPL_SIMD_NEON)
+  if (utils::simd::IsEnabled(utils::simd::InstructionSet::kNeon)) {
+    begin = FindReservedNeon(begin, end);
+  }
+#endif
+  while (begin != end && IsUnreserved(*begin)) ++begin;
+  return begin;
+}
+
+const char* FindDecodeSpecial(const char* begin, const char* end) noexcept {
+#if defined(USERVER_IMPL_SIMD_X86)
+  switch (utils::simd::GetInstructionSet()) {
+    case utils::simd::InstructionSet::kAvx2:
+      begin = FindDecodeSpecialAvx2(begin, end);
+      break;
+    case utils::simd::InstructionSet::kSsse3:
+      begin = FindDecodeSpecialSsse3(begin, end);
+      break;
+    default:
+      break;
+  }
+#elif defined(USERVER_IMPL_SIMD_NEON)
+  if (utils::simd::IsEnabled(utils::simd::InstructionSet::kNeon)) {
+    begin = FindDecodeSpecialNeon(begin, end);
+  }
+#endif
+  while (begin != end && *begin != '%' && *begin != '+') ++begin;
+  return begin;
+}
+
+void UrlEncodeTo(std::string_view input_string, std::string& result) {
+  const char* begin = input_string.data();
+  const char* const end = begin + input_string.size();
+  while (begin != end) {
+    // the unreserved characters are appended at once
+    const char* reserved = FindReserved(begin, end);
+    result.append(begin, reserved);
+    if (reserved == end) break;
+
+    const char symbol = *reserved;
+    std::array<char, 3> bytes = {'%', 0, 0};
+    bytes[1] = (symbol & 0xF0) / 16;
+    bytes[1] += (bytes[1] > 9) ? 'A' - 10 : '0';
+    bytes[2] = symbol & 0x0F;
+    bytes[2] += (bytes[2] > 9) ? 'A' - 10 : '0';
+    result.append(bytes.data(), bytes.size());
+    begin = reserved + 1;
+  }
 }
 
 }  // namespace
@@ -204,6 +391,12 @@ std::string UrlDecode(utils::impl::InternalTag, std::string_view range) {
   result.reserve(range.size() / 3);
 
   for (const char *i = range.begin(), *end = range.end(); i != end; ++i) {
+    // the characters that are not decoded are appended at once
+    const char* special = FindDecodeSpecial(i, end);
+    result.append(i, special);
+    i = special;
+    if (i == end) break;
+
     switch (*i) {
       case '+':
         result.append(1, ' ');
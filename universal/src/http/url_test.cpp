@@ -4,6 +4,7 @@
 
 #include <userver/http/url.hpp>
 #include <utils/impl/internal_tag.hpp>
+#include <utils/simd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -29,6 +30,25 @@ TEST(UrlEncode, Special) {
   EXPECT_EQ("Text%20with%20spaces%2C%3F%26%3D", UrlEncode(str));
 }
 
+TEST(UrlEncode, LongAllInstructionSets) {
+  std::string str;
+  std::string reference;
+  for (int i = 0; i < 10; ++i) {
+    str += "SomeLongTextWithoutSpecialSymbols-_.!~*()'";
+    reference += "SomeLongTextWithoutSpecialSymbols-_.!~*()'";
+    str += std::string(i, ' ') + "\xff";
+    for (int j = 0; j < i; ++j) reference += "%20";
+    reference += "%FF";
+  }
+
+  for (const auto instruction_set : utils::simd::kAllInstructionSets) {
+    utils::simd::SetMaxInstructionSet(instruction_set);
+    EXPECT_EQ(reference, UrlEncode(str));
+    EXPECT_EQ(str, UrlDecode(reference));
+  }
+  utils::simd::SetMaxInstructionSet(utils::simd::InstructionSet::kNeon);
+}
+
 TEST(UrlDecode, Empty) { EXPECT_EQ("", UrlDecode("")); }
 
 TEST(UrlDecode, Latin) {
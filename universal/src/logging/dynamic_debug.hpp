@@ -8,6 +8,8 @@
 
 #include <userver/logging/log.hpp>
 
+#include <logging/log_sampling.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace logging {
@@ -33,6 +35,7 @@ struct LogEntryContent {
   const int line;
   const char* const path;
   LogEntryContentHook hook;
+  mutable impl::LogSiteSampling sampling;
 };
 
 bool operator<(const LogEntryContent& x, const LogEntryContent& y) noexcept;
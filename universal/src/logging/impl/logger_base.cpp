@@ -14,6 +14,8 @@ void LoggerBase::Flush() {}
 
 void LoggerBase::PrependCommonTags(TagWriter /*writer*/) const {}
 
+std::uint64_t LoggerBase::GetSamplingKey() const noexcept { return 0; }
+
 Format LoggerBase::GetFormat() const noexcept { return format_; }
 
 void LoggerBase::SetLevel(Level level) { level_ = level; }
@@ -3,10 +3,12 @@
 #include <utility>
 
 #include <logging/dynamic_debug.hpp>
+#include <logging/log_sampling.hpp>
 #include <logging/rate_limit.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/null_logger.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/datetime/steady_coarse_clock.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -108,7 +110,9 @@ RateLimiter::RateLimiter(RateLimitData& data, Level level) noexcept
     }
 
     const auto reset_interval = impl::GetLogLimitedInterval();
-    const auto now = std::chrono::steady_clock::now();
+    // The precision of a few milliseconds is enough for the reset interval
+    const auto now = std::chrono::steady_clock::time_point{
+        utils::datetime::SteadyCoarseClock::now().time_since_epoch()};
 
     if (now - data.last_reset_time >= reset_interval) {
       data.count_since_reset = 0;
@@ -139,6 +143,7 @@ LogHelper& operator<<(LogHelper& lh, const RateLimiter& rl) noexcept {
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
 StaticLogEntry::StaticLogEntry(const char* path, int line) noexcept {
   static_assert(sizeof(LogEntryContent) == sizeof(content_));
+  static_assert(alignof(LogEntryContent) <= alignof(std::int64_t));
   // static_assert(std::is_trivially_destructible_v<LogEntryContent>);
   auto* item = new (&content_) LogEntryContent(path, line);
   RegisterLogLocation(*item);
@@ -148,10 +153,13 @@ bool StaticLogEntry::ShouldNotLog(logging::LoggerRef logger,
                                   logging::Level level) const noexcept {
   const auto& content = reinterpret_cast<const LogEntryContent&>(content_);
   const auto state = content.state.load();
+  if (state == EntryState::kForceEnabled) return false;
+
   const bool force_disabled =
       level < Level::kWarning && state == EntryState::kForceDisabled;
-  const bool force_enabled = state == EntryState::kForceEnabled;
-  return (!LoggerShouldLog(logger, level) || force_disabled) && !force_enabled;
+  if (!LoggerShouldLog(logger, level) || force_disabled) return true;
+
+  return !ShouldKeepSampled(content.sampling, logger, level);
 }
 
 bool StaticLogEntry::ShouldNotLog(const logging::LoggerPtr& logger,
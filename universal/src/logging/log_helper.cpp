@@ -331,6 +331,7 @@ void LogHelper::PutFloatingPoint(float value) {
                  FMT_COMPILE("{}"), value);
 }
 void LogHelper::PutFloatingPoint(double value) {
+  if (pimpl_->TryPutTypedValue(value)) return;
   fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()),
                  FMT_COMPILE("{}"), value);
 }
@@ -339,14 +340,17 @@ void LogHelper::PutFloatingPoint(long double value) {
                  FMT_COMPILE("{}"), value);
 }
 void LogHelper::PutUnsigned(unsigned long long value) {
+  if (pimpl_->TryPutTypedValue(value)) return;
   fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()),
                  FMT_COMPILE("{}"), value);
 }
 void LogHelper::PutSigned(long long value) {
+  if (pimpl_->TryPutTypedValue(value)) return;
   fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()),
                  FMT_COMPILE("{}"), value);
 }
 void LogHelper::PutBoolean(bool value) {
+  if (pimpl_->TryPutTypedValue(value)) return;
   fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()),
                  FMT_COMPILE("{}"), value);
 }
@@ -1,6 +1,8 @@
 #include "log_helper_impl.hpp"
 
 #include <array>
+#include <cstring>
+#include <limits>
 
 #include <fmt/chrono.h>
 #include <fmt/compile.h>
@@ -22,6 +24,7 @@ char GetSeparatorFromLogger(LoggerRef logger) {
   switch (logger.GetFormat()) {
     case Format::kTskv:
     case Format::kRaw:
+    case Format::kBinary:
       return '=';
     case Format::kLtsv:
       return ':';
@@ -71,6 +74,41 @@ TimeString GetCurrentTimeString(TimePoint now) noexcept {
   return cached_time->string;
 }
 
+// Format::kBinary value types, see scripts/binary_logs.py
+constexpr char kBinaryString = 0;
+constexpr char kBinarySigned = 1;
+constexpr char kBinaryUnsigned = 2;
+constexpr char kBinaryDouble = 3;
+constexpr char kBinaryBool = 4;
+
+constexpr std::size_t kBinaryRecordSizeSize = 4;
+constexpr std::size_t kBinaryKeySizeSize = 2;
+// type and size
+constexpr std::size_t kBinaryValueHeaderSize = 1 + 4;
+
+void WriteLittleEndian(char* position, std::uint64_t value,
+                       std::size_t size) noexcept {
+  for (std::size_t i = 0; i < size; ++i) {
+    position[i] = static_cast<char>(value >> (i * 8));
+  }
+}
+
+std::uint64_t ReadLittleEndian(const char* position,
+                               std::size_t size) noexcept {
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < size; ++i) {
+    value |= std::uint64_t{static_cast<unsigned char>(position[i])} << (i * 8);
+  }
+  return value;
+}
+
+void AppendLittleEndian(LogBuffer& buffer, std::uint64_t value,
+                        std::size_t size) {
+  const auto old_size = buffer.size();
+  buffer.resize(old_size + size);
+  WriteLittleEndian(buffer.data() + old_size, value, size);
+}
+
 }  // namespace
 
 auto LogHelper::Impl::BufferStd::overflow(int_type c) -> int_type {
@@ -88,7 +126,8 @@ std::streamsize LogHelper::Impl::BufferStd::xsputn(const char_type* s,
 LogHelper::Impl::Impl(LoggerRef logger, Level level) noexcept
     : logger_(&logger),
       level_(std::max(level, logger_->GetLevel())),
-      key_value_separator_(GetSeparatorFromLogger(*logger_)) {
+      key_value_separator_(GetSeparatorFromLogger(*logger_)),
+      is_binary_(logger_->GetFormat() == Format::kBinary) {
   static_assert(sizeof(LogHelper::Impl) < 4096,
                 "Structures with size more than 4096 would consume at least "
                 "8KB memory in allocator.");
@@ -128,14 +167,30 @@ void LogHelper::Impl::PutMessageBegin() {
       msg_.append(std::string_view{"tskv"});
       return;
     }
+    case Format::kBinary: {
+      const auto now = std::chrono::time_point_cast<std::chrono::microseconds>(
+          TimePoint::clock::now());
+      // the record size is written in PutMessageEnd
+      AppendLittleEndian(msg_, 0, kBinaryRecordSizeSize);
+      AppendLittleEndian(msg_, now.time_since_epoch().count(), 8);
+      msg_.push_back(static_cast<char>(level_));
+      return;
+    }
   }
   UASSERT_MSG(false, "Invalid value of Format enum");
 }
 
-void LogHelper::Impl::PutMessageEnd() { msg_.push_back('\n'); }
+void LogHelper::Impl::PutMessageEnd() {
+  if (is_binary_) {
+    WriteLittleEndian(msg_.data(), msg_.size() - kBinaryRecordSizeSize,
+                      kBinaryRecordSizeSize);
+    return;
+  }
+  msg_.push_back('\n');
+}
 
 void LogHelper::Impl::PutKey(std::string_view key) {
-  if (!utils::encoding::ShouldKeyBeEscaped(key)) {
+  if (is_binary_ || !utils::encoding::ShouldKeyBeEscaped(key)) {
     PutRawKey(key);
   } else {
     UASSERT(!std::exchange(is_within_value_, true));
@@ -150,6 +205,11 @@ void LogHelper::Impl::PutKey(std::string_view key) {
 void LogHelper::Impl::PutRawKey(std::string_view key) {
   UASSERT(!std::exchange(is_within_value_, true));
   CheckRepeatedKeys(key);
+  if (is_binary_) {
+    PutBinaryKey(key);
+    return;
+  }
+
   const auto old_size = msg_.size();
   msg_.resize(old_size + 1 + key.size() + 1);
 
@@ -162,23 +222,59 @@ void LogHelper::Impl::PutRawKey(std::string_view key) {
 
 void LogHelper::Impl::PutValuePart(std::string_view value) {
   UASSERT(is_within_value_);
+  if (is_binary_) {
+    EnsureBinaryStringValue();
+    msg_.append(value);
+    return;
+  }
   utils::encoding::EncodeTskv(msg_, value,
                               utils::encoding::EncodeTskvMode::kValue);
 }
 
 void LogHelper::Impl::PutValuePart(char text_part) {
   UASSERT(is_within_value_);
+  if (is_binary_) {
+    EnsureBinaryStringValue();
+    msg_.push_back(text_part);
+    return;
+  }
   utils::encoding::EncodeTskv(fmt::appender(msg_), text_part,
                               utils::encoding::EncodeTskvMode::kValue);
 }
 
-LogBuffer& LogHelper::Impl::GetBufferForRawValuePart() noexcept {
+LogBuffer& LogHelper::Impl::GetBufferForRawValuePart() {
   UASSERT(is_within_value_);
+  if (is_binary_) EnsureBinaryStringValue();
   return msg_;
 }
 
+bool LogHelper::Impl::TryPutTypedValue(long long value) {
+  return TryPutBinaryValue(kBinarySigned, static_cast<std::uint64_t>(value),
+                           8);
+}
+
+bool LogHelper::Impl::TryPutTypedValue(unsigned long long value) {
+  return TryPutBinaryValue(kBinaryUnsigned, value, 8);
+}
+
+bool LogHelper::Impl::TryPutTypedValue(double value) {
+  static_assert(sizeof(value) == sizeof(std::uint64_t));
+  std::uint64_t bytes{};
+  std::memcpy(&bytes, &value, sizeof(value));
+  return TryPutBinaryValue(kBinaryDouble, bytes, 8);
+}
+
+bool LogHelper::Impl::TryPutTypedValue(bool value) {
+  return TryPutBinaryValue(kBinaryBool, value ? 1 : 0, 1);
+}
+
 void LogHelper::Impl::MarkValueEnd() noexcept {
   UASSERT(std::exchange(is_within_value_, false));
+  if (is_binary_) {
+    const auto value_begin = binary_value_offset_ + kBinaryValueHeaderSize;
+    WriteLittleEndian(msg_.data() + binary_value_offset_ + 1,
+                      msg_.size() - value_begin, kBinaryValueHeaderSize - 1);
+  }
 }
 
 void LogHelper::Impl::StartText() {
@@ -208,6 +304,63 @@ void LogHelper::Impl::MarkAsBroken() noexcept { logger_ = nullptr; }
 
 bool LogHelper::Impl::IsBroken() const noexcept { return !logger_; }
 
+void LogHelper::Impl::PutBinaryKey(std::string_view key) {
+  key = key.substr(0, std::numeric_limits<std::uint16_t>::max());
+  AppendLittleEndian(msg_, key.size(), kBinaryKeySizeSize);
+  msg_.append(key);
+
+  binary_value_offset_ = msg_.size();
+  msg_.push_back(kBinaryString);
+  // the value size is written in MarkValueEnd
+  AppendLittleEndian(msg_, 0, kBinaryValueHeaderSize - 1);
+}
+
+bool LogHelper::Impl::TryPutBinaryValue(char type, std::uint64_t bytes,
+                                        std::size_t size) {
+  UASSERT(is_within_value_);
+  // Only a value that consists of a single part may be typed
+  if (!is_binary_ ||
+      msg_.size() != binary_value_offset_ + kBinaryValueHeaderSize) {
+    return false;
+  }
+
+  msg_[binary_value_offset_] = type;
+  AppendLittleEndian(msg_, bytes, size);
+  return true;
+}
+
+void LogHelper::Impl::EnsureBinaryStringValue() {
+  const char type = msg_[binary_value_offset_];
+  if (type == kBinaryString) return;
+
+  // A text is appended to a typed value, e.g. `LOG_INFO() << 42 << "s"`
+  const auto value_begin = binary_value_offset_ + kBinaryValueHeaderSize;
+  const auto bytes = ReadLittleEndian(msg_.data() + value_begin,
+                                      msg_.size() - value_begin);
+  msg_.resize(value_begin);
+  msg_[binary_value_offset_] = kBinaryString;
+
+  auto out = fmt::appender(msg_);
+  switch (type) {
+    case kBinarySigned:
+      fmt::format_to(out, FMT_COMPILE("{}"), static_cast<long long>(bytes));
+      return;
+    case kBinaryUnsigned:
+      fmt::format_to(out, FMT_COMPILE("{}"), bytes);
+      return;
+    case kBinaryDouble: {
+      double value{};
+      std::memcpy(&value, &bytes, sizeof(value));
+      fmt::format_to(out, FMT_COMPILE("{}"), value);
+      return;
+    }
+    case kBinaryBool:
+      fmt::format_to(out, FMT_COMPILE("{}"), bytes != 0);
+      return;
+  }
+  UASSERT_MSG(false, "Invalid binary log value type");
+}
+
 void LogHelper::Impl::CheckRepeatedKeys(
     [[maybe_unused]] std::string_view raw_key) {
   UASSERT_MSG(debug_tag_keys_->insert(std::string{raw_key}).second,
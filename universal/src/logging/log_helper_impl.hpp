@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <ostream>
 #include <unordered_set>
@@ -35,7 +36,14 @@ class LogHelper::Impl final {
 
   void PutValuePart(std::string_view value);
   void PutValuePart(char text_part);
-  LogBuffer& GetBufferForRawValuePart() noexcept;
+  LogBuffer& GetBufferForRawValuePart();
+
+  // Writes the whole value in a binary form for Format::kBinary. Returns
+  // `false` if the value should be written as text.
+  bool TryPutTypedValue(long long value);
+  bool TryPutTypedValue(unsigned long long value);
+  bool TryPutTypedValue(double value);
+  bool TryPutTypedValue(bool value);
 
   bool IsWithinValue() const noexcept { return is_within_value_; }
   void MarkValueEnd() noexcept;
@@ -78,10 +86,17 @@ class LogHelper::Impl final {
 
   void CheckRepeatedKeys(std::string_view raw_key);
 
+  void PutBinaryKey(std::string_view key);
+  bool TryPutBinaryValue(char type, std::uint64_t bytes, std::size_t size);
+  void EnsureBinaryStringValue();
+
   impl::LoggerBase* logger_;
   const Level level_;
   const char key_value_separator_;
+  const bool is_binary_;
   LogBuffer msg_;
+  // Format::kBinary only, the offset of the current value type
+  std::size_t binary_value_offset_{0};
   std::optional<LazyInitedStream> lazy_stream_;
   LogExtra extra_;
   std::size_t initial_length_{0};
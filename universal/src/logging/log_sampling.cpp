@@ -0,0 +1,115 @@
+#include <logging/log_sampling.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include <userver/logging/impl/logger_base.hpp>
+#include <userver/utils/datetime/steady_coarse_clock.hpp>
+#include <userver/utils/rand.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+// Records are kept if the lower 32 bits of their key are below the threshold
+constexpr std::uint64_t kKeepAll = std::uint64_t{1} << 32;
+
+struct GlobalSampling final {
+  std::atomic<std::int64_t> site_interval_ns{0};
+  std::atomic<std::int64_t> site_burst_ns{0};
+  std::array<std::atomic<std::uint64_t>, kLevelMax + 1> level_thresholds{
+      kKeepAll, kKeepAll, kKeepAll, kKeepAll, kKeepAll, kKeepAll, kKeepAll};
+};
+
+GlobalSampling& GetGlobalSampling() noexcept {
+  static GlobalSampling sampling;
+  return sampling;
+}
+
+// splitmix64 finalizer, spreads trace id hashes evenly
+std::uint64_t Mix(std::uint64_t x) noexcept {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+bool IsSampledIn(const LoggerBase& logger, std::uint64_t threshold) noexcept {
+  auto key = logger.GetSamplingKey();
+  if (key == 0) {
+    key = utils::WithDefaultRandom([](auto& rng) { return rng(); });
+  }
+  return (Mix(key) & (kKeepAll - 1)) < threshold;
+}
+
+bool TryAcquireSiteToken(LogSiteSampling& site, std::int64_t interval_ns,
+                         std::int64_t burst_ns) noexcept {
+  const std::int64_t now =
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          utils::datetime::SteadyCoarseClock::now().time_since_epoch())
+          .count();
+
+  auto next_allowed = site.next_allowed_ns.load(std::memory_order_relaxed);
+  while (true) {
+    const auto base = std::max(next_allowed, now);
+    if (base - now > burst_ns) return false;
+    if (site.next_allowed_ns.compare_exchange_weak(
+            next_allowed, base + interval_ns, std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+}
+
+}  // namespace
+
+void SetLogSampling(const LogSamplingSettings& settings) noexcept {
+  auto& global = GetGlobalSampling();
+
+  std::int64_t interval_ns = 0;
+  if (settings.site_records_per_second > 0) {
+    interval_ns = std::max<std::int64_t>(
+        1, std::llround(1e9 / settings.site_records_per_second));
+  }
+  global.site_burst_ns = interval_ns * settings.site_burst;
+  global.site_interval_ns = interval_ns;
+
+  for (std::size_t i = 0; i < global.level_thresholds.size(); ++i) {
+    const auto probability =
+        std::clamp(settings.level_probability[i], 0.0, 1.0);
+    global.level_thresholds[i] =
+        static_cast<std::uint64_t>(std::ldexp(probability, 32));
+  }
+}
+
+bool ShouldKeepSampled(LogSiteSampling& site, const LoggerBase& logger,
+                       Level level) noexcept {
+  auto& global = GetGlobalSampling();
+
+  const auto threshold = global.level_thresholds[static_cast<int>(level)].load(
+      std::memory_order_relaxed);
+  if (threshold < kKeepAll && !IsSampledIn(logger, threshold)) {
+    site.dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  const auto interval_ns =
+      global.site_interval_ns.load(std::memory_order_relaxed);
+  if (interval_ns != 0 &&
+      !TryAcquireSiteToken(
+          site, interval_ns,
+          global.site_burst_ns.load(std::memory_order_relaxed))) {
+    site.dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  return true;
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
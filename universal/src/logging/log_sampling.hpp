@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include <userver/logging/level.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+class LoggerBase;
+
+struct LogSamplingSettings final {
+  /// Records per second allowed for each log site, 0 disables the limit
+  double site_records_per_second{0};
+
+  /// Records allowed above site_records_per_second in a burst
+  std::uint32_t site_burst{0};
+
+  /// Probability to keep a record of each level. Records of the same trace
+  /// are kept or dropped together.
+  std::array<double, kLevelMax + 1> level_probability{1, 1, 1, 1, 1, 1, 1};
+};
+
+/// Per log site state, lives in the static storage of LOG_* macros
+struct LogSiteSampling final {
+  // Theoretical arrival time of the next record, see GCRA
+  std::atomic<std::int64_t> next_allowed_ns{0};
+  std::atomic<std::uint64_t> dropped{0};
+};
+
+void SetLogSampling(const LogSamplingSettings& settings) noexcept;
+
+/// Returns false and accounts the drop if the record should not be written
+bool ShouldKeepSampled(LogSiteSampling& site, const LoggerBase& logger,
+                       Level level) noexcept;
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
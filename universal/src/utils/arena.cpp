@@ -0,0 +1,89 @@
+#include <userver/utils/arena.hpp>
+
+#include <algorithm>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+// The header of a chunk, the allocations go right after it
+struct alignas(std::max_align_t) Arena::Chunk final {
+  Chunk* previous;
+  std::size_t size;
+};
+
+Arena::Arena(std::size_t initial_chunk_size) noexcept
+    : next_chunk_size_(std::clamp(initial_chunk_size, sizeof(Chunk) * 2,
+                                  kMaxChunkSize)) {}
+
+Arena::~Arena() {
+  while (chunks_) DeleteChunk(std::exchange(chunks_, chunks_->previous));
+}
+
+void Arena::Reset() noexcept {
+  ++statistics_.resets;
+  statistics_.allocated_bytes = 0;
+  statistics_.allocations = 0;
+  if (!chunks_) return;
+
+  while (chunks_->previous) {
+    DeleteChunk(std::exchange(chunks_->previous, chunks_->previous->previous));
+  }
+  UseChunk(*chunks_);
+}
+
+void* Arena::AllocateSlow(std::size_t size, std::size_t alignment) {
+  UASSERT_MSG(alignment != 0 && (alignment & (alignment - 1)) == 0,
+              "alignment must be a power of 2");
+  if (size > static_cast<std::size_t>(-1) / 2 - alignment) {
+    throw std::bad_alloc();
+  }
+  const auto required = sizeof(Chunk) + size + alignment - 1;
+
+  auto* chunk = NewChunk(std::max(required, next_chunk_size_));
+  if (required > next_chunk_size_ / 2 && chunks_) {
+    // A chunk of its own, the current chunk stays for the small allocations
+    chunk->previous = chunks_->previous;
+    chunks_->previous = chunk;
+
+    const auto start = reinterpret_cast<std::uintptr_t>(chunk + 1);
+    statistics_.allocated_bytes += size;
+    ++statistics_.allocations;
+    return reinterpret_cast<void*>((start + alignment - 1) & ~(alignment - 1));
+  }
+
+  chunk->previous = chunks_;
+  chunks_ = chunk;
+  UseChunk(*chunk);
+  next_chunk_size_ = std::min(next_chunk_size_ * 2, kMaxChunkSize);
+
+  return Allocate(size, alignment);
+}
+
+Arena::Chunk* Arena::NewChunk(std::size_t size) {
+  auto* chunk = static_cast<Chunk*>(::operator new(size));
+  chunk->previous = nullptr;
+  chunk->size = size;
+
+  statistics_.reserved_bytes += size;
+  statistics_.peak_reserved_bytes =
+      std::max(statistics_.peak_reserved_bytes, statistics_.reserved_bytes);
+  ++statistics_.chunk_allocations;
+  return chunk;
+}
+
+void Arena::DeleteChunk(Chunk* chunk) noexcept {
+  statistics_.reserved_bytes -= chunk->size;
+  ::operator delete(chunk);
+}
+
+void Arena::UseChunk(Chunk& chunk) noexcept {
+  const auto begin = reinterpret_cast<std::uintptr_t>(&chunk);
+  current_ = begin + sizeof(Chunk);
+  end_ = begin + chunk.size;
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,77 @@
+#include <userver/utils/arena.hpp>
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Builds a request-like bunch of short strings
+template <typename Strings, typename... StringAllocator>
+void FillStrings(Strings& strings, std::size_t count,
+                 const StringAllocator&... string_allocator) {
+  for (std::size_t i = 0; i < count; ++i) {
+    strings.emplace_back(32 + i % 32, 'a', string_allocator...);
+  }
+}
+
+}  // namespace
+
+void Arena_HeapStrings(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    std::vector<std::string> strings;
+    FillStrings(strings, state.range(0));
+    benchmark::DoNotOptimize(strings);
+  }
+}
+BENCHMARK(Arena_HeapStrings)->Range(8, 1024);
+
+void Arena_ArenaStrings(benchmark::State& state) {
+  using String = std::basic_string<char, std::char_traits<char>,
+                                   utils::ArenaAllocator<char>>;
+  for ([[maybe_unused]] auto _ : state) {
+    utils::Arena arena;
+    std::vector<String, utils::ArenaAllocator<String>> strings{
+        utils::ArenaAllocator<String>{arena}};
+    FillStrings(strings, state.range(0), utils::ArenaAllocator<char>{arena});
+    benchmark::DoNotOptimize(strings);
+  }
+}
+BENCHMARK(Arena_ArenaStrings)->Range(8, 1024);
+
+void Arena_ResetArenaStrings(benchmark::State& state) {
+  using String = std::basic_string<char, std::char_traits<char>,
+                                   utils::ArenaAllocator<char>>;
+  utils::Arena arena;
+  for ([[maybe_unused]] auto _ : state) {
+    {
+      std::vector<String, utils::ArenaAllocator<String>> strings{
+          utils::ArenaAllocator<String>{arena}};
+      FillStrings(strings, state.range(0), utils::ArenaAllocator<char>{arena});
+      benchmark::DoNotOptimize(strings);
+    }
+    arena.Reset();
+  }
+}
+BENCHMARK(Arena_ResetArenaStrings)->Range(8, 1024);
+
+#ifdef USERVER_IMPL_HAS_MEMORY_RESOURCE
+void Arena_PmrStrings(benchmark::State& state) {
+  utils::Arena arena;
+  for ([[maybe_unused]] auto _ : state) {
+    {
+      utils::ArenaMemoryResource resource{arena};
+      std::pmr::vector<std::pmr::string> strings{&resource};
+      FillStrings(strings, state.range(0));
+      benchmark::DoNotOptimize(strings);
+    }
+    arena.Reset();
+  }
+}
+BENCHMARK(Arena_PmrStrings)->Range(8, 1024);
+#endif
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,143 @@
+#include <userver/utils/arena.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+bool IsAligned(const void* ptr, std::size_t alignment) {
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+}  // namespace
+
+TEST(Arena, Sample) {
+  /// [Sample utils::Arena usage]
+  utils::Arena arena;
+
+  std::vector<int, utils::ArenaAllocator<int>> values{
+      utils::ArenaAllocator<int>{arena}};
+  for (int i = 0; i < 100; ++i) values.push_back(i);
+  EXPECT_EQ(values[42], 42);
+
+  auto* buffer = arena.Allocate<char>(16);
+  EXPECT_NE(buffer, nullptr);
+  /// [Sample utils::Arena usage]
+}
+
+TEST(Arena, NoAllocationsUntilUsed) {
+  utils::Arena arena;
+  EXPECT_EQ(arena.GetStatistics().reserved_bytes, 0);
+  EXPECT_EQ(arena.GetStatistics().chunk_allocations, 0);
+}
+
+TEST(Arena, Alignment) {
+  utils::Arena arena;
+  for (std::size_t alignment = 1; alignment <= 256; alignment *= 2) {
+    arena.Allocate(1, 1);
+    const auto* ptr = arena.Allocate(3, alignment);
+    EXPECT_TRUE(IsAligned(ptr, alignment)) << alignment;
+  }
+
+  EXPECT_TRUE(IsAligned(arena.Allocate<double>(3), alignof(double)));
+  EXPECT_TRUE(IsAligned(arena.Allocate<std::uint16_t>(), 2));
+}
+
+TEST(Arena, LargeAllocations) {
+  utils::Arena arena{1024};
+  auto* small = static_cast<char*>(arena.Allocate(8));
+  auto* large = static_cast<char*>(arena.Allocate(100'000, 64));
+  EXPECT_TRUE(IsAligned(large, 64));
+  large[0] = 'a';
+  large[99'999] = 'b';
+
+  // The current chunk is still used for the small allocations
+  auto* next_small = static_cast<char*>(arena.Allocate(8));
+  EXPECT_EQ(next_small, small + alignof(std::max_align_t));
+  EXPECT_GE(arena.GetStatistics().reserved_bytes, 101'000);
+}
+
+TEST(Arena, ChunksGrow) {
+  utils::Arena arena{1024};
+  for (int i = 0; i < 10'000; ++i) {
+    auto* ptr = arena.Allocate<std::uint64_t>();
+    *ptr = i;
+  }
+
+  const auto& stats = arena.GetStatistics();
+  EXPECT_EQ(stats.allocations, 10'000);
+  EXPECT_EQ(stats.allocated_bytes, 10'000 * sizeof(std::uint64_t));
+  EXPECT_LT(stats.chunk_allocations, 10);
+  EXPECT_EQ(stats.reserved_bytes, stats.peak_reserved_bytes);
+}
+
+TEST(Arena, ResetReusesTheChunk) {
+  utils::Arena arena;
+  for (int i = 0; i < 10'000; ++i) arena.Allocate(16);
+  const auto peak = arena.GetStatistics().peak_reserved_bytes;
+
+  arena.Reset();
+  auto stats = arena.GetStatistics();
+  EXPECT_EQ(stats.allocations, 0);
+  EXPECT_EQ(stats.allocated_bytes, 0);
+  EXPECT_EQ(stats.resets, 1);
+  EXPECT_LT(stats.reserved_bytes, peak);
+  EXPECT_EQ(stats.peak_reserved_bytes, peak);
+
+  const auto chunk_allocations = stats.chunk_allocations;
+  for (int i = 0; i < 100; ++i) arena.Allocate(16);
+  EXPECT_EQ(arena.GetStatistics().chunk_allocations, chunk_allocations);
+}
+
+TEST(Arena, ZeroSize) {
+  utils::Arena arena;
+  EXPECT_NO_THROW(arena.Allocate(0));
+  EXPECT_EQ(arena.GetStatistics().allocations, 1);
+  EXPECT_THROW(arena.Allocate<std::uint64_t>(static_cast<std::size_t>(-1)),
+               std::bad_alloc);
+  EXPECT_THROW(arena.Allocate(static_cast<std::size_t>(-1)), std::bad_alloc);
+}
+
+TEST(Arena, Allocator) {
+  utils::Arena arena;
+  using Allocator = utils::ArenaAllocator<char>;
+  using String = std::basic_string<char, std::char_traits<char>, Allocator>;
+
+  std::vector<String, utils::ArenaAllocator<String>> strings{
+      utils::ArenaAllocator<String>{arena}};
+  for (int i = 0; i < 100; ++i) {
+    strings.emplace_back(std::string(100, 'a' + i % 26).c_str(),
+                         Allocator{arena});
+  }
+  EXPECT_EQ(strings[27], String(100, 'b', Allocator{arena}));
+  EXPECT_EQ(strings.get_allocator(), Allocator{arena});
+
+  utils::Arena other_arena;
+  EXPECT_NE(Allocator{arena}, Allocator{other_arena});
+}
+
+#ifdef USERVER_IMPL_HAS_MEMORY_RESOURCE
+TEST(Arena, MemoryResource) {
+  utils::Arena arena;
+  utils::ArenaMemoryResource resource{arena};
+
+  std::pmr::vector<std::pmr::string> strings{&resource};
+  for (int i = 0; i < 100; ++i) {
+    strings.emplace_back(100, 'a' + i % 26);
+  }
+  EXPECT_EQ(strings[27], std::pmr::string(100, 'b'));
+  EXPECT_EQ(strings[27].get_allocator().resource(), &resource);
+  EXPECT_GE(arena.GetStatistics().allocated_bytes, 100 * 100);
+
+  utils::ArenaMemoryResource same_arena_resource{arena};
+  EXPECT_TRUE(resource.is_equal(same_arena_resource));
+  EXPECT_FALSE(resource.is_equal(*std::pmr::get_default_resource()));
+}
+#endif
+
+USERVER_NAMESPACE_END
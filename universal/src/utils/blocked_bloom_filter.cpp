@@ -0,0 +1,71 @@
+#include <userver/utils/blocked_bloom_filter.hpp>
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+double GetBloomFalsePositiveRate(double elements_per_block) {
+  if (elements_per_block <= 0) return 0;
+
+  // The number of the elements of a block is Poisson distributed, a false
+  // positive requires all the 8 bits of a probe to be set
+  const auto spread = 10 * std::sqrt(elements_per_block) + 10;
+  const auto first = std::floor(std::max(0.0, elements_per_block - spread));
+  const auto last = elements_per_block + spread;
+
+  auto probability = std::exp(first * std::log(elements_per_block) -
+                              elements_per_block - std::lgamma(first + 1));
+  // Probability that a bit of a word is not set by any of the elements
+  auto bit_unset = std::pow(1.0 - 1.0 / 32, first);
+  double result = 0;
+  for (auto elements = first; elements <= last; ++elements) {
+    static_assert(BloomBlock::kWords == 8);
+    auto probe_set = (1.0 - bit_unset) * (1.0 - bit_unset);
+    probe_set *= probe_set;
+    result += probability * probe_set * probe_set;
+    probability *= elements_per_block / (elements + 1);
+    bit_unset *= 1.0 - 1.0 / 32;
+  }
+  return std::min(result, 1.0);
+}
+
+std::size_t GetBloomBlockCount(std::size_t expected_size,
+                               double false_positive_rate) {
+  UINVARIANT(false_positive_rate > 0 && false_positive_rate < 1,
+             "false_positive_rate should be in (0, 1)");
+
+  // The false positive rate grows with the number of elements per block
+  double low = 0;
+  double high = BloomBlock::kBits;
+  for (int i = 0; i < 30; ++i) {
+    const auto middle = (low + high) / 2;
+    if (GetBloomFalsePositiveRate(middle) <= false_positive_rate) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+
+  const auto block_count = std::ceil(static_cast<double>(expected_size) /
+                                     std::max(low, 1.0 / BloomBlock::kBits));
+  return std::max<std::size_t>(static_cast<std::size_t>(block_count), 1);
+}
+
+std::size_t CountBloomBits(const BloomBlock* blocks,
+                           std::size_t block_count) noexcept {
+  std::size_t result = 0;
+  for (std::size_t i = 0; i < block_count; ++i) {
+    for (const auto word : blocks[i].words) {
+      result += std::bitset<32>{word}.count();
+    }
+  }
+  return result;
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,92 @@
+#include <userver/utils/blocked_bloom_filter.hpp>
+
+#include <cmath>
+#include <string>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(BlockedBloomFilter, Sample) {
+  /// [Sample utils::BlockedBloomFilter]
+  utils::BlockedBloomFilter<std::string> filter{/*expected_size=*/1000,
+                                                /*false_positive_rate=*/0.01};
+  filter.Insert("present");
+
+  EXPECT_TRUE(filter.MayContain("present"));
+  // May rarely be true
+  EXPECT_FALSE(filter.MayContain("absent"));
+  /// [Sample utils::BlockedBloomFilter]
+}
+
+TEST(BlockedBloomFilter, NoFalseNegatives) {
+  utils::BlockedBloomFilter<int> filter{10000};
+  for (int i = 0; i < 20000; i += 2) filter.Insert(i);
+  for (int i = 0; i < 20000; i += 2) EXPECT_TRUE(filter.MayContain(i)) << i;
+  EXPECT_EQ(filter.GetSize(), 10000);
+}
+
+TEST(BlockedBloomFilter, FalsePositiveRate) {
+  for (const double rate : {0.1, 0.01, 0.001}) {
+    constexpr int kSize = 100000;
+    utils::BlockedBloomFilter<int> filter{kSize, rate};
+    for (int i = 0; i < kSize; ++i) filter.Insert(i);
+
+    int false_positives = 0;
+    for (int i = kSize; i < 11 * kSize; ++i) {
+      false_positives += filter.MayContain(i);
+    }
+    const auto actual_rate = false_positives / (10.0 * kSize);
+    EXPECT_LT(actual_rate, rate * 1.2) << rate;
+    EXPECT_GT(actual_rate, rate * 0.5) << rate;
+    EXPECT_NEAR(filter.EstimateFalsePositiveRate(), rate, rate * 0.01);
+
+    // About 10 bits per element for 1%
+    EXPECT_LT(filter.GetSizeInBytes() * 8, kSize * (-std::log2(rate) * 1.7 + 1))
+        << rate;
+  }
+}
+
+TEST(BlockedBloomFilter, FillRatio) {
+  utils::BlockedBloomFilter<int> filter{1000};
+  EXPECT_EQ(filter.GetFillRatio(), 0);
+  EXPECT_EQ(filter.EstimateFalsePositiveRate(), 0);
+
+  for (int i = 0; i < 1000; ++i) filter.Insert(i);
+  // Half of the bits are set in the optimally filled filter
+  EXPECT_GT(filter.GetFillRatio(), 0.3);
+  EXPECT_LT(filter.GetFillRatio(), 0.6);
+
+  filter.Clear();
+  EXPECT_EQ(filter.GetFillRatio(), 0);
+  EXPECT_EQ(filter.GetSize(), 0);
+  EXPECT_FALSE(filter.MayContain(1));
+}
+
+TEST(BlockedBloomFilter, RawData) {
+  utils::BlockedBloomFilter<std::string> filter{100};
+  filter.Insert("a");
+  filter.Insert("b");
+
+  const auto restored = utils::BlockedBloomFilter<std::string>::FromRawData(
+      filter.GetRawData(), filter.GetSize());
+  EXPECT_EQ(restored.GetRawData(), filter.GetRawData());
+  EXPECT_EQ(restored.GetSize(), 2);
+  EXPECT_TRUE(restored.MayContain("a"));
+  EXPECT_TRUE(restored.MayContain("b"));
+
+  EXPECT_THROW(utils::BlockedBloomFilter<std::string>::FromRawData("", 0),
+               std::invalid_argument);
+  EXPECT_THROW(utils::BlockedBloomFilter<std::string>::FromRawData(
+                   filter.GetRawData().substr(1), 2),
+               std::invalid_argument);
+}
+
+TEST(BlockedBloomFilter, Tiny) {
+  utils::BlockedBloomFilter<int> filter{0, 0.5};
+  EXPECT_EQ(filter.GetSizeInBytes(), 32);
+  filter.Insert(42);
+  EXPECT_TRUE(filter.MayContain(42));
+}
+
+USERVER_NAMESPACE_END
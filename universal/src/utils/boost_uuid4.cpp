@@ -2,12 +2,10 @@
 
 #include <array>
 
-#include <boost/uuid/random_generator.hpp>
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
 
-#include <userver/compiler/thread_local.hpp>
-#include <userver/utils/rand.hpp>
+#include <utils/impl/random_pool.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -101,19 +99,18 @@ boost::uuids::uuid FromChars(const char* begin, const char* end) {
   return u;
 }
 
-compiler::ThreadLocal local_uuid_generator = [] {
-  return WithDefaultRandom([](RandomBase& rng) {
-    return boost::uuids::basic_random_generator<RandomBase>(rng);
-  });
-};
-
 }  // namespace
 
 namespace generators {
 
 boost::uuids::uuid GenerateBoostUuid() {
-  auto generator = local_uuid_generator.Use();
-  return (*generator)();
+  boost::uuids::uuid uuid;
+  impl::FillRandomBytes(uuid.data, sizeof(uuid.data));
+
+  // version 4 and the RFC 4122 variant, same as boost::uuids::random_generator
+  uuid.data[6] = (uuid.data[6] & 0x0F) | 0x40;
+  uuid.data[8] = (uuid.data[8] & 0x3F) | 0x80;
+  return uuid;
 }
 
 }  // namespace generators
@@ -14,6 +14,13 @@ TEST(UUID, Boost) {
             utils::generators::GenerateBoostUuid());
 }
 
+TEST(UUID, VersionAndVariant) {
+  const auto uuid = utils::generators::GenerateBoostUuid();
+
+  EXPECT_EQ(uuid.variant(), boost::uuids::uuid::variant_rfc_4122);
+  EXPECT_EQ(uuid.version(), boost::uuids::uuid::version_random_number_based);
+}
+
 TEST(UUID, Format) {
   std::string str("0ad56dfc-bbbf-44af-87e3-37eb98b6452f");
   boost::uuids::string_generator string_gen;
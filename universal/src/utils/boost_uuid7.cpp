@@ -1,16 +1,13 @@
 #include <userver/utils/boost_uuid7.hpp>
 
 #include <chrono>
-#include <limits>
-
-#include <boost/random/uniform_int.hpp>
-#include <boost/random/variate_generator.hpp>
 
 #include <userver/compiler/thread_local.hpp>
 #include <userver/utils/datetime/wall_coarse_clock.hpp>
-#include <userver/utils/rand.hpp>
 #include <userver/utils/span.hpp>
 
+#include <utils/impl/random_pool.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace {
@@ -19,12 +16,6 @@ namespace {
 /// https://commitfest.postgresql.org/43/4388/
 class UuidV7Generator {
  public:
-  UuidV7Generator(utils::RandomBase& rng)
-      : random_generator_(&rng,
-                          boost::uniform_int<std::uint64_t>(
-                              std::numeric_limits<std::uint64_t>::min(),
-                              std::numeric_limits<std::uint64_t>::max())) {}
-
   boost::uuids::uuid operator()() {
     boost::uuids::uuid uuid{};
     auto current_timestamp = CurrentUnixTimestamp();
@@ -95,18 +86,8 @@ class UuidV7Generator {
   }
 
  private:
-  void GenerateRandomBlock(utils::span<std::uint8_t> block) {
-    int i = 0;
-    std::uint64_t random_value = random_generator_();
-
-    for (auto it = block.begin(), end = block.end(); it != end; ++it, ++i) {
-      if (i == sizeof(std::uint64_t)) {
-        random_value = random_generator_();
-        i = 0;
-      }
-
-      *it = static_cast<std::uint8_t>((random_value >> (i * 8)) & 0xFF);
-    }
+  static void GenerateRandomBlock(utils::span<std::uint8_t> block) noexcept {
+    utils::impl::FillRandomBytes(block.data(), block.size());
   }
 
   static std::uint64_t CurrentUnixTimestamp() {
@@ -116,10 +97,6 @@ class UuidV7Generator {
   }
 
  private:
-  boost::random::variate_generator<utils::RandomBase*,
-                                   boost::uniform_int<std::uint64_t>>
-      random_generator_;
-
   std::uint32_t sequence_counter_{0};
   std::uint64_t previous_timestamp_{0};
 
@@ -127,8 +104,7 @@ class UuidV7Generator {
 };
 
 compiler::ThreadLocal local_uuid_v7_generator = [] {
-  return utils::WithDefaultRandom(
-      [](utils::RandomBase& rng) { return UuidV7Generator(rng); });
+  return UuidV7Generator{};
 };
 
 }  // namespace
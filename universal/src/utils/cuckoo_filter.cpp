@@ -0,0 +1,22 @@
+#include <userver/utils/cuckoo_filter.hpp>
+
+#include <cmath>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+std::size_t GetCuckooBucketCount(std::size_t capacity) {
+  // The inserts start failing at about 95% of the slots filled
+  constexpr double kMaxFillRatio = 0.95;
+
+  const auto min_bucket_count = static_cast<std::size_t>(std::ceil(
+      static_cast<double>(capacity) / (kCuckooSlots * kMaxFillRatio)));
+  std::size_t bucket_count = 1;
+  while (bucket_count < min_bucket_count) bucket_count *= 2;
+  return bucket_count;
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
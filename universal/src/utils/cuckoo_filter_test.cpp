@@ -0,0 +1,101 @@
+#include <userver/utils/cuckoo_filter.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(CuckooFilter, Sample) {
+  /// [Sample utils::CuckooFilter]
+  utils::CuckooFilter<std::string> filter{/*capacity=*/1000};
+  EXPECT_TRUE(filter.Insert("present"));
+  EXPECT_TRUE(filter.Insert("erased"));
+  EXPECT_TRUE(filter.Erase("erased"));
+
+  EXPECT_TRUE(filter.MayContain("present"));
+  // May rarely be true
+  EXPECT_FALSE(filter.MayContain("erased"));
+  EXPECT_FALSE(filter.MayContain("absent"));
+  /// [Sample utils::CuckooFilter]
+}
+
+TEST(CuckooFilter, NoFalseNegatives) {
+  constexpr int kSize = 100000;
+  utils::CuckooFilter<int> filter{kSize};
+  for (int i = 0; i < kSize; ++i) ASSERT_TRUE(filter.Insert(i)) << i;
+  for (int i = 0; i < kSize; ++i) EXPECT_TRUE(filter.MayContain(i)) << i;
+  EXPECT_EQ(filter.GetSize(), kSize);
+
+  int false_positives = 0;
+  for (int i = kSize; i < 11 * kSize; ++i) {
+    false_positives += filter.MayContain(i);
+  }
+  EXPECT_LT(false_positives / (10.0 * kSize), 0.0003);
+}
+
+TEST(CuckooFilter, Erase) {
+  constexpr int kSize = 10000;
+  utils::CuckooFilter<int> filter{kSize};
+  for (int i = 0; i < kSize; ++i) ASSERT_TRUE(filter.Insert(i));
+  for (int i = 0; i < kSize; i += 2) EXPECT_TRUE(filter.Erase(i));
+  EXPECT_EQ(filter.GetSize(), kSize / 2);
+  for (int i = 1; i < kSize; i += 2) EXPECT_TRUE(filter.MayContain(i)) << i;
+
+  int erased_found = 0;
+  for (int i = 0; i < kSize; i += 2) erased_found += filter.MayContain(i);
+  EXPECT_LT(erased_found, 10);
+
+  EXPECT_FALSE(filter.Erase(kSize * 2));
+
+  // Duplicates take several slots
+  EXPECT_TRUE(filter.Insert(kSize * 3));
+  EXPECT_TRUE(filter.Insert(kSize * 3));
+  EXPECT_TRUE(filter.Erase(kSize * 3));
+  EXPECT_TRUE(filter.MayContain(kSize * 3));
+  EXPECT_TRUE(filter.Erase(kSize * 3));
+}
+
+TEST(CuckooFilter, Full) {
+  utils::CuckooFilter<int> filter{1000};
+  const auto slots = filter.GetSizeInBytes() / 2;
+
+  int inserted = 0;
+  while (filter.Insert(inserted)) ++inserted;
+  EXPECT_GT(filter.GetFillRatio(), 0.9);
+  EXPECT_EQ(filter.GetSize(), inserted);
+  EXPECT_LE(filter.GetSize(), slots);
+
+  // A failed insert does not lose the elements
+  const auto data = std::string{filter.GetRawData()};
+  EXPECT_FALSE(filter.Insert(inserted));
+  EXPECT_EQ(filter.GetRawData(), data);
+  for (int i = 0; i < inserted; ++i) EXPECT_TRUE(filter.MayContain(i)) << i;
+
+  filter.Clear();
+  EXPECT_EQ(filter.GetSize(), 0);
+  EXPECT_EQ(filter.GetFillRatio(), 0);
+  EXPECT_TRUE(filter.Insert(inserted));
+}
+
+TEST(CuckooFilter, RawData) {
+  utils::CuckooFilter<std::string> filter{100};
+  filter.Insert("a");
+  filter.Insert("b");
+
+  auto restored =
+      utils::CuckooFilter<std::string>::FromRawData(filter.GetRawData());
+  EXPECT_EQ(restored.GetRawData(), filter.GetRawData());
+  EXPECT_EQ(restored.GetSize(), 2);
+  EXPECT_TRUE(restored.MayContain("a"));
+  EXPECT_TRUE(restored.Erase("b"));
+  EXPECT_FALSE(restored.MayContain("b"));
+
+  EXPECT_THROW(utils::CuckooFilter<std::string>::FromRawData(""),
+               std::invalid_argument);
+  EXPECT_THROW(utils::CuckooFilter<std::string>::FromRawData(
+                   std::string(3 * 8, '\0')),
+               std::invalid_argument);
+}
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <userver/utils/datetime/steady_coarse_clock.hpp>
 
+#include <atomic>
+#include <cstdint>
 #include <ctime>
 
 #include <userver/utils/assert.hpp>
@@ -33,6 +35,25 @@ TimePoint CoarseNow() noexcept {
       std::chrono::seconds(tp.tv_sec) + std::chrono::nanoseconds(tp.tv_nsec))};
 }
 
+// Updated by utils::datetime::CoarseClockTicker, zero if it is not running
+struct alignas(64) CachedCoarseTime final {
+  std::atomic<std::int64_t> steady{0};
+  std::atomic<std::int64_t> wall{0};
+};
+
+inline CachedCoarseTime cached_coarse_time;
+
+template <typename TimePoint, int Flag>
+TimePoint CachedCoarseNow() noexcept {
+  static_assert(sizeof(typename TimePoint::rep) == sizeof(std::int64_t));
+  const auto& cached = (Flag == kCoarseSteadyClockNativeFlag)
+                           ? cached_coarse_time.steady
+                           : cached_coarse_time.wall;
+  const auto value = cached.load(std::memory_order_relaxed);
+  if (value != 0) return TimePoint{typename TimePoint::duration{value}};
+  return CoarseNow<TimePoint, Flag>();
+}
+
 template <typename Duration, int Flag>
 Duration CoarseResolution() noexcept {
   static_assert(Flag == kCoarseSteadyClockNativeFlag ||
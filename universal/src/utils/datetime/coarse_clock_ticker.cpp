@@ -0,0 +1,92 @@
+#include <userver/utils/datetime/coarse_clock_ticker.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/datetime/steady_coarse_clock.hpp>
+#include <userver/utils/datetime/wall_coarse_clock.hpp>
+#include <userver/utils/thread_name.hpp>
+#include <utils/datetime/coarse_clock_gettime.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::datetime {
+
+namespace {
+
+std::atomic<bool> is_ticker_running{false};
+
+void UpdateCachedCoarseTime() noexcept {
+  // The coarse clocks are cached rather than the precise ones, so that the
+  // clocks stay monotonic when the ticker starts or stops
+  cached_coarse_time.steady.store(
+      CoarseNow<SteadyCoarseClock::time_point, kCoarseSteadyClockNativeFlag>()
+          .time_since_epoch()
+          .count(),
+      std::memory_order_relaxed);
+  cached_coarse_time.wall.store(
+      CoarseNow<WallCoarseClock::time_point, kCoarseRealtimeClockNativeFlag>()
+          .time_since_epoch()
+          .count(),
+      std::memory_order_relaxed);
+}
+
+}  // namespace
+
+struct CoarseClockTicker::Impl final {
+  explicit Impl(std::chrono::microseconds interval)
+      : interval(interval), thread([this] { Run(); }) {}
+
+  ~Impl() {
+    {
+      const std::lock_guard lock{mutex};
+      is_stopped = true;
+    }
+    cv.notify_one();
+    thread.join();
+  }
+
+  void Run() {
+    utils::SetCurrentThreadName("coarse-clock");
+    std::unique_lock lock{mutex};
+    while (!cv.wait_for(lock, interval, [this] { return is_stopped; })) {
+      UpdateCachedCoarseTime();
+    }
+  }
+
+  const std::chrono::microseconds interval;
+  std::mutex mutex;
+  std::condition_variable cv;
+  bool is_stopped{false};
+  // Must be the last, uses the fields above
+  std::thread thread;
+};
+
+CoarseClockTicker::CoarseClockTicker(std::chrono::microseconds interval) {
+  UINVARIANT(interval.count() > 0, "interval must be positive");
+  UINVARIANT(!is_ticker_running.exchange(true),
+             "Only one CoarseClockTicker may exist at a time");
+  UpdateCachedCoarseTime();
+  try {
+    impl_ = std::make_unique<Impl>(interval);
+  } catch (...) {
+    cached_coarse_time.steady = 0;
+    cached_coarse_time.wall = 0;
+    is_ticker_running = false;
+    throw;
+  }
+}
+
+CoarseClockTicker::~CoarseClockTicker() {
+  impl_.reset();
+  cached_coarse_time.steady = 0;
+  cached_coarse_time.wall = 0;
+  is_ticker_running = false;
+}
+
+}  // namespace utils::datetime
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,76 @@
+#include <userver/utils/datetime/coarse_clock_ticker.hpp>
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <userver/utest/assert_macros.hpp>
+#include <userver/utils/datetime/steady_coarse_clock.hpp>
+#include <userver/utils/datetime/wall_coarse_clock.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using utils::datetime::CoarseClockTicker;
+using utils::datetime::SteadyCoarseClock;
+using utils::datetime::WallCoarseClock;
+
+constexpr std::chrono::seconds kMaxLag{1};
+
+}  // namespace
+
+TEST(CoarseClockTicker, Basic) {
+  const auto steady_before = SteadyCoarseClock::now();
+  const auto wall_before = WallCoarseClock::now();
+  {
+    const CoarseClockTicker ticker{std::chrono::microseconds{100}};
+    const auto steady = SteadyCoarseClock::now();
+    EXPECT_GE(steady, steady_before);
+    EXPECT_LE(steady.time_since_epoch(),
+              std::chrono::steady_clock::now().time_since_epoch());
+    EXPECT_NEAR(
+        std::chrono::duration<double>(
+            WallCoarseClock::now() - std::chrono::system_clock::now())
+            .count(),
+        0, std::chrono::duration<double>(kMaxLag).count());
+    EXPECT_GE(WallCoarseClock::now(), wall_before);
+
+    // The ticker keeps the clocks going
+    const auto start = std::chrono::steady_clock::now();
+    while (SteadyCoarseClock::now() == steady &&
+           std::chrono::steady_clock::now() - start < kMaxLag) {
+      std::this_thread::yield();
+    }
+    EXPECT_GT(SteadyCoarseClock::now(), steady);
+  }
+
+  // The clocks fall back to clock_gettime and stay monotonic
+  const auto steady = SteadyCoarseClock::now();
+  EXPECT_GE(steady, steady_before);
+  EXPECT_NEAR(std::chrono::duration<double>(
+                  steady.time_since_epoch() -
+                  std::chrono::steady_clock::now().time_since_epoch())
+                  .count(),
+              0, std::chrono::duration<double>(kMaxLag).count());
+}
+
+TEST(CoarseClockTicker, Monotonic) {
+  auto previous = SteadyCoarseClock::now();
+  for (int i = 0; i < 10; ++i) {
+    const CoarseClockTicker ticker{std::chrono::microseconds{50}};
+    for (int j = 0; j < 1000; ++j) {
+      const auto now = SteadyCoarseClock::now();
+      ASSERT_GE(now, previous);
+      previous = now;
+    }
+  }
+  EXPECT_GE(SteadyCoarseClock::now(), previous);
+}
+
+TEST(CoarseClockTickerDeathTest, OneAtATime) {
+  const CoarseClockTicker ticker;
+  EXPECT_UINVARIANT_FAILURE_MSG(CoarseClockTicker{}, "Only one");
+}
+
+USERVER_NAMESPACE_END
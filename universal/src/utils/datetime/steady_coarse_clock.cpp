@@ -9,7 +9,7 @@ namespace utils::datetime {
 constexpr auto kClockFlag = kCoarseSteadyClockNativeFlag;
 
 SteadyCoarseClock::time_point SteadyCoarseClock::now() noexcept {
-  return CoarseNow<time_point, kClockFlag>();
+  return CachedCoarseNow<time_point, kClockFlag>();
 }
 
 SteadyCoarseClock::duration SteadyCoarseClock::resolution() noexcept {
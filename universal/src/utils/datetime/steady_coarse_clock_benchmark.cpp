@@ -4,6 +4,8 @@
 
 #include <benchmark/benchmark.h>
 
+#include <userver/utils/datetime/coarse_clock_ticker.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 void steady_clock_benchmark(benchmark::State& state) {
@@ -20,4 +22,12 @@ void steady_coarse_clock_benchmark(benchmark::State& state) {
 }
 BENCHMARK(steady_coarse_clock_benchmark);
 
+void steady_coarse_clock_ticker_benchmark(benchmark::State& state) {
+  const utils::datetime::CoarseClockTicker ticker;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(utils::datetime::SteadyCoarseClock::now());
+  }
+}
+BENCHMARK(steady_coarse_clock_ticker_benchmark);
+
 USERVER_NAMESPACE_END
@@ -9,7 +9,7 @@ namespace utils::datetime {
 constexpr auto kClockFlag = kCoarseRealtimeClockNativeFlag;
 
 WallCoarseClock::time_point WallCoarseClock::now() noexcept {
-  return CoarseNow<time_point, kClockFlag>();
+  return CachedCoarseNow<time_point, kClockFlag>();
 }
 
 WallCoarseClock::duration WallCoarseClock::resolution() noexcept {
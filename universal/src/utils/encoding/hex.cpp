@@ -1,10 +1,15 @@
 #include <userver/utils/encoding/hex.hpp>
 
+#include <cstddef>
 #include <stdexcept>
 #include <string_view>
 
-#ifdef __SSSE3__
-#include <tmmintrin.h>
+#include <utils/simd.hpp>
+
+#if defined(USERVER_IMPL_SIMD_X86)
+#include <immintrin.h>
+#elif defined(USERVER_IMPL_SIMD_NEON)
+#include <arm_neon.h>
 #endif
 
 USERVER_NAMESPACE_BEGIN
@@ -105,11 +110,111 @@ bool IsXDigit(unsigned char x_digit) noexcept {
   return false;
 }
 
-#ifdef __SSSE3__
-const auto kLow4BitsMask = _mm_set1_epi8(0xf);
-const auto kDigitsMask = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
-                                       '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+// The kernels below return the number of the input bytes converted
+
+#if defined(USERVER_IMPL_SIMD_X86)
+USERVER_IMPL_SIMD_TARGET_SSSE3
+std::size_t ToHexSsse3(const char* first, std::size_t size,
+                       char* dst) noexcept {
+  const auto low_4_bits_mask = _mm_set1_epi8(0xf);
+  const auto digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                    '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+
+  std::size_t i = 0;
+  for (; size - i >= 8; i += 8) {
+    // we only take 8 bytes because each byte transforms into 2 bytes
+    // (first digit comes from 4 high bits, second comes from 4 low bits)
+    const auto eight_bytes_of_data = _mm_loadu_si64(first + i);
+
+    // we take the original eight bytes, shift them (as one 64-bits integer)
+    // 4 bits to the right - now we have 4 high bits of each original byte
+    // in the lowest 4 bits, with some garbage in higher bits, - combine
+    // the original 8 bytes interleaved with it and mask out
+    // highest 4 bits of each byte. So we get this in the end:
+    // h4(b0), l4(b0), h4(b1), l4(b1), ... where h4() is the highest 4 bits,
+    // l4() - lowest 4 bits, and b0, b1, ... are the original bytes
+    const auto interleaving_hi_lo =
+        _mm_and_si128(_mm_unpacklo_epi8(_mm_srli_epi64(eight_bytes_of_data, 4),
+                                        eight_bytes_of_data),
+                      low_4_bits_mask);
+
+    // and now we gather kXdigits as specified in interleaving_hi_lo
+    // and store them into the result
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i),
+                     _mm_shuffle_epi8(digits, interleaving_hi_lo));
+  }
+  return i;
+}
+
+USERVER_IMPL_SIMD_TARGET_AVX2
+std::size_t ToHexAvx2(const char* first, std::size_t size,
+                      char* dst) noexcept {
+  const auto low_4_bits_mask = _mm_set1_epi8(0xf);
+  const auto digits = _mm256_setr_epi8(
+      '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e',
+      'f', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd',
+      'e', 'f');
+
+  std::size_t i = 0;
+  for (; size - i >= 16; i += 16) {
+    // Same as ToHexSsse3, but 16 bytes at once
+    const auto data =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+    const auto hi = _mm_and_si128(_mm_srli_epi16(data, 4), low_4_bits_mask);
+    const auto lo = _mm_and_si128(data, low_4_bits_mask);
+    const auto interleaving_hi_lo = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_unpacklo_epi8(hi, lo)),
+        _mm_unpackhi_epi8(hi, lo), 1);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i),
+                        _mm256_shuffle_epi8(digits, interleaving_hi_lo));
+  }
+  return i;
+}
+#elif defined(USERVER_IMPL_SIMD_NEON)
+std::size_t ToHexNeon(const char* first, std::size_t size,
+                      char* dst) noexcept {
+  const auto digits = vld1q_u8(reinterpret_cast<const std::uint8_t*>(
+      kXdigits.data()));
+
+  std::size_t i = 0;
+  for (; size - i >= 16; i += 16) {
+    const auto data =
+        vld1q_u8(reinterpret_cast<const std::uint8_t*>(first + i));
+    const auto hi = vshrq_n_u8(data, 4);
+    const auto lo = vandq_u8(data, vdupq_n_u8(0xf));
+
+    auto* out = reinterpret_cast<std::uint8_t*>(dst + 2 * i);
+    vst1q_u8(out, vqtbl1q_u8(digits, vzip1q_u8(hi, lo)));
+    vst1q_u8(out + 16, vqtbl1q_u8(digits, vzip2q_u8(hi, lo)));
+  }
+  return i;
+}
+#endif
+
+std::size_t ToHexSimd(const char* first, std::size_t size,
+                      char* dst) noexcept {
+#if defined(USERVER_IMPL_SIMD_X86)
+  switch (simd::GetInstructionSet()) {
+    case simd::InstructionSet::kAvx2:
+      return ToHexAvx2(first, size, dst);
+    case simd::InstructionSet::kSsse3:
+      return ToHexSsse3(first, size, dst);
+    default:
+      return 0;
+  }
+#elif defined(USERVER_IMPL_SIMD_NEON)
+  if (simd::IsEnabled(simd::InstructionSet::kNeon)) {
+    return ToHexNeon(first, size, dst);
+  }
+  return 0;
+#else
+  (void)first;
+  (void)size;
+  (void)dst;
+  return 0;
 #endif
+}
 
 }  // namespace detail
 
@@ -134,37 +239,17 @@ std::string_view GetHexPart(std::string_view encoded) noexcept {
 void ToHex(std::string_view input, std::string& out) noexcept {
   out.clear();
   out.resize(input.size() * 2);
+  ToHex(input, out.data());
+}
+
+void ToHex(std::string_view input, char* out) noexcept {
   const auto* first = input.data();
   const auto* last = input.data() + input.size();
-  auto* dst = out.data();
+  auto* dst = out;
 
-#ifdef __SSSE3__
-  while (last - first >= 8) {
-    // we only take 8 bytes because each byte transforms into 2 bytes
-    // (first digit comes from 4 high bits, second comes from 4 low bits)
-    const auto eight_bytes_of_data = _mm_loadu_si64(first);
-
-    // we take the original eight bytes, shift them (as one 64-bits integer)
-    // 4 bits to the right - now we have 4 high bits of each original byte
-    // in the lowest 4 bits, with some garbage in higher bits, - combine
-    // the original 8 bytes interleaved with it and mask out
-    // highest 4 bits of each byte. So we get this in the end:
-    // h4(b0), l4(b0), h4(b1), l4(b1), ... where h4() is the highest 4 bits,
-    // l4() - lowest 4 bits, and b0, b1, ... are the original bytes
-    const auto interleaving_hi_lo =
-        _mm_and_si128(_mm_unpacklo_epi8(_mm_srli_epi64(eight_bytes_of_data, 4),
-                                        eight_bytes_of_data),
-                      detail::kLow4BitsMask);
-
-    // and now we gather kXdigits as specified in interleaving_hi_lo
-    // and store them into the result
-    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst),
-                     _mm_shuffle_epi8(detail::kDigitsMask, interleaving_hi_lo));
-
-    first += 8;
-    dst += 16;
-  }
-#endif
+  const auto converted = detail::ToHexSimd(first, input.size(), dst);
+  first += converted;
+  dst += 2 * converted;
 
   while (first != last) {
     const auto value = *first;
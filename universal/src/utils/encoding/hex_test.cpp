@@ -4,6 +4,7 @@
 #include <string>
 
 #include <userver/utils/encoding/hex.hpp>
+#include <utils/simd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -30,6 +31,26 @@ TEST(Hex, ToHex) {
   constexpr std::string_view reference{"5f2b3d313536"};
   const std::string result = ToHex(data);
   EXPECT_EQ(reference, result);
+
+  char buffer[LengthInHexForm(data) + 1] = {};
+  ToHex(data, buffer);
+  EXPECT_EQ(reference, buffer);
+}
+
+TEST(Hex, ToHexAllInstructionSets) {
+  std::string data;
+  for (int i = 0; i < 300; ++i) data.push_back(static_cast<char>(i * 7));
+  const auto reference = ToHex(data);
+
+  for (const auto instruction_set : simd::kAllInstructionSets) {
+    simd::SetMaxInstructionSet(instruction_set);
+    for (std::size_t size = 0; size <= data.size(); ++size) {
+      EXPECT_EQ(reference.substr(0, size * 2),
+                ToHex(std::string_view{data}.substr(0, size)));
+    }
+  }
+  simd::SetMaxInstructionSet(simd::InstructionSet::kNeon);
+  EXPECT_EQ("00070e15", ToHex(data.substr(0, 4)));
 }
 
 TEST(Hex, ToHexLong) {
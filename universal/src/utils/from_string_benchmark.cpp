@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <string>
+#include <string_view>
 
 #include <userver/utils/from_string.hpp>
 
@@ -28,4 +29,30 @@ BENCHMARK_TEMPLATE(ConstFromString, std::uint32_t)->DenseRange(1, 10, 1);
 BENCHMARK_TEMPLATE(ConstFromString, std::uint16_t)->DenseRange(1, 5, 1);
 BENCHMARK_TEMPLATE(ConstFromString, double)->DenseRange(1, 10, 1);
 
+void FloatingFromStringView(benchmark::State& state) {
+  constexpr std::string_view kNumbers[] = {
+      "3.14159", "-0.001", "1e-5", "123456.789", "2.2250738585072014e-308",
+  };
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto number : kNumbers) {
+      benchmark::DoNotOptimize(utils::FromString<double>(number));
+    }
+  }
+}
+BENCHMARK(FloatingFromStringView);
+
+void IntegerFromStringView(benchmark::State& state) {
+  constexpr std::string_view kNumbers[] = {
+      "42", "-1234567", "+9876543210", "-9223372036854775807",
+  };
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto number : kNumbers) {
+      benchmark::DoNotOptimize(utils::FromString<std::int64_t>(number));
+    }
+  }
+}
+BENCHMARK(IntegerFromStringView);
+
 USERVER_NAMESPACE_END
@@ -215,6 +215,25 @@ TYPED_TEST(FromStringTest, Overflow) {
   }
 }
 
+TYPED_TEST(FromStringTest, LongDigitSequences) {
+  using T = TypeParam;
+
+  TestConverts("0000000000000000042", T{42});
+  TestConverts("+0000000000000000042", T{42});
+  TestConverts("00000000000000000000000042", T{42});
+  TestInvalid<T>("0000000042+");
+  TestInvalid<T>("00000000a0000000042");
+  TestInvalid<T>("0000000000000000042 ");
+  TestInvalid<T>("+-0000000000000000042");
+
+  if constexpr (std::is_signed_v<T>) {
+    TestConverts("-0000000000000000042", T{-42});
+  } else {
+    TestConverts("-0000000000000000000", T{0});
+    TestInvalid<T>("-0000000000000000042");
+  }
+}
+
 TYPED_TEST(FromStringTest, ExceptionDetails) {
   using T = TypeParam;
   std::string what;
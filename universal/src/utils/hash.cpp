@@ -0,0 +1,75 @@
+#include <userver/utils/hash.hpp>
+
+#include <random>
+
+#include <utils/impl/byte_utils.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::hash::impl {
+
+namespace {
+
+struct RandomKeys final {
+  RandomKeys() {
+    std::random_device device;
+    const auto random = [&device] {
+      return (std::uint64_t{device()} << 32) | device();
+    };
+    seed = random();
+    k0 = random();
+    k1 = random();
+  }
+
+  std::uint64_t seed{};
+  std::uint64_t k0{};
+  std::uint64_t k1{};
+};
+
+// A function static, so that the keys do not change if the containers are
+// filled during the static initialization
+const RandomKeys& GetRandomKeys() noexcept {
+  static const RandomKeys keys;
+  return keys;
+}
+
+}  // namespace
+
+std::uint64_t HashLongBytes(const unsigned char* p, std::size_t size,
+                            std::uint64_t seed) noexcept {
+  std::size_t i = size;
+  if (i >= 48) {
+    std::uint64_t see1 = seed;
+    std::uint64_t see2 = seed;
+    do {
+      seed = Mix(Read8(p) ^ kSecret[1], Read8(p + 8) ^ seed);
+      see1 = Mix(Read8(p + 16) ^ kSecret[2], Read8(p + 24) ^ see1);
+      see2 = Mix(Read8(p + 32) ^ kSecret[3], Read8(p + 40) ^ see2);
+      p += 48;
+      i -= 48;
+    } while (i >= 48);
+    seed ^= see1 ^ see2;
+  }
+  while (i > 16) {
+    seed = Mix(Read8(p) ^ kSecret[1], Read8(p + 8) ^ seed);
+    i -= 16;
+    p += 16;
+  }
+
+  // the last 16 bytes may overlap with the already hashed ones
+  std::uint64_t a = Read8(p + i - 16) ^ kSecret[1];
+  std::uint64_t b = Read8(p + i - 8) ^ seed;
+  Multiply(a, b);
+  return Mix(a ^ kSecret[0] ^ size, b ^ kSecret[1]);
+}
+
+std::uint64_t GetRandomSeed() noexcept { return GetRandomKeys().seed; }
+
+std::uint64_t SeededHashBytes(std::string_view data) noexcept {
+  const auto& keys = GetRandomKeys();
+  return utils::impl::SipHasher{keys.k0, keys.k1}(data);
+}
+
+}  // namespace utils::hash::impl
+
+USERVER_NAMESPACE_END
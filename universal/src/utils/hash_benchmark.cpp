@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/utils/hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::vector<std::string> GenerateKeys(std::size_t size) {
+  std::vector<std::string> keys;
+  for (std::size_t i = 0; i < 1000; ++i) {
+    auto key = "key/" + std::to_string(i * 7919);
+    key.resize(std::max(size, key.size()), 'x');
+    keys.push_back(std::move(key));
+  }
+  return keys;
+}
+
+template <typename Hash>
+void StringHash(benchmark::State& state) {
+  const auto keys = GenerateKeys(state.range(0));
+  const Hash hash;
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& key : keys) benchmark::DoNotOptimize(hash(key));
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Hash>
+void UnorderedMapFind(benchmark::State& state) {
+  const auto keys = GenerateKeys(state.range(0));
+  std::unordered_map<std::string, int, Hash> map;
+  for (const auto& key : keys) map.emplace(key, 0);
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& key : keys) benchmark::DoNotOptimize(map.find(key));
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Hash>
+void LruMapGet(benchmark::State& state) {
+  const auto keys = GenerateKeys(state.range(0));
+  cache::LruMap<std::string, int, Hash> map(keys.size());
+  for (const auto& key : keys) map.Put(key, 0);
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& key : keys) benchmark::DoNotOptimize(map.Get(key));
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE(StringHash, std::hash<std::string>)
+    ->RangeMultiplier(4)
+    ->Range(8, 512);
+BENCHMARK_TEMPLATE(StringHash, utils::hash::Hash<std::string>)
+    ->RangeMultiplier(4)
+    ->Range(8, 512);
+BENCHMARK_TEMPLATE(StringHash, utils::hash::SeededHash<std::string>)
+    ->RangeMultiplier(4)
+    ->Range(8, 512);
+
+BENCHMARK_TEMPLATE(UnorderedMapFind, std::hash<std::string>)
+    ->RangeMultiplier(4)
+    ->Range(8, 512);
+BENCHMARK_TEMPLATE(UnorderedMapFind, utils::hash::Hash<std::string>)
+    ->RangeMultiplier(4)
+    ->Range(8, 512);
+
+BENCHMARK_TEMPLATE(LruMapGet, std::hash<std::string>)
+    ->RangeMultiplier(4)
+    ->Range(8, 512);
+BENCHMARK_TEMPLATE(LruMapGet, utils::hash::Hash<std::string>)
+    ->RangeMultiplier(4)
+    ->Range(8, 512);
+
+USERVER_NAMESPACE_END
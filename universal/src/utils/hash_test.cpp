@@ -0,0 +1,84 @@
+#include <userver/utils/hash.hpp>
+
+#include <string>
+#include <unordered_set>
+
+#include <gtest/gtest.h>
+
+#include <userver/utils/small_string.hpp>
+#include <userver/utils/strong_typedef.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using StringTypedef = utils::StrongTypedef<class StringTypedefTag, std::string>;
+using IntTypedef = utils::StrongTypedef<class IntTypedefTag, int>;
+
+enum class Color { kRed, kGreen };
+
+}  // namespace
+
+TEST(Hash, Bytes) {
+  std::unordered_set<std::uint64_t> hashes;
+  std::string data;
+  // covers all the code paths for the short and the long strings
+  for (std::size_t size = 0; size < 200; ++size) {
+    EXPECT_TRUE(hashes.insert(utils::hash::HashBytes(data)).second) << size;
+    data.push_back(static_cast<char>('a' + size % 26));
+  }
+
+  EXPECT_EQ(utils::hash::HashBytes("some string"),
+            utils::hash::HashBytes(std::string{"some string"}));
+  EXPECT_NE(utils::hash::HashBytes("some string"),
+            utils::hash::HashBytes("some strinG"));
+  EXPECT_NE(utils::hash::HashBytes("some string", 1),
+            utils::hash::HashBytes("some string", 2));
+}
+
+TEST(Hash, Integer) {
+  static_assert(utils::hash::HashInteger(42) == utils::hash::HashInteger(42));
+  static_assert(utils::hash::HashInteger(0) != utils::hash::HashInteger(1));
+
+  // the low bits are good for the power-of-two sized tables
+  std::unordered_set<std::uint64_t> low_bits;
+  for (std::uint64_t i = 0; i < 64; ++i) {
+    low_bits.insert(utils::hash::HashInteger(i << 16) & 0xffff);
+  }
+  EXPECT_GT(low_bits.size(), 60);
+}
+
+TEST(Hash, Types) {
+  const utils::hash::Hash<std::string> string_hash;
+  EXPECT_EQ(string_hash("key"), utils::hash::HashBytes("key"));
+  EXPECT_EQ(string_hash("key"), string_hash(std::string_view{"key"}));
+
+  EXPECT_EQ(utils::hash::Hash<std::string_view>{}("key"), string_hash("key"));
+  EXPECT_EQ(utils::hash::Hash<utils::SmallString<8>>{}(
+                utils::SmallString<8>{"key"}),
+            string_hash("key"));
+  EXPECT_EQ(utils::hash::Hash<StringTypedef>{}(StringTypedef{"key"}),
+            string_hash("key"));
+
+  EXPECT_EQ(utils::hash::Hash<int>{}(42), utils::hash::HashInteger(42));
+  EXPECT_EQ(utils::hash::Hash<IntTypedef>{}(IntTypedef{42}),
+            utils::hash::HashInteger(42));
+  EXPECT_EQ(utils::hash::Hash<Color>{}(Color::kGreen),
+            utils::hash::HashInteger(1));
+
+  EXPECT_EQ(utils::hash::Hash<double>{}(1.5), std::hash<double>{}(1.5));
+}
+
+TEST(Hash, Seeded) {
+  const utils::hash::SeededHash<std::string> hash;
+  EXPECT_EQ(hash("key"), hash(std::string_view{"key"}));
+  EXPECT_NE(hash("key"), hash("key2"));
+  EXPECT_NE(hash("key"), utils::hash::Hash<std::string>{}("key"));
+
+  EXPECT_EQ(utils::hash::SeededHash<int>{}(42),
+            utils::hash::SeededHash<int>{}(42));
+  EXPECT_NE(utils::hash::SeededHash<int>{}(42),
+            utils::hash::SeededHash<int>{}(43));
+}
+
+USERVER_NAMESPACE_END
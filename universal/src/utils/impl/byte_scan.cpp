@@ -0,0 +1,271 @@
+#include <utils/impl/byte_scan.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+#include <utils/simd.hpp>
+
+#if defined(USERVER_IMPL_SIMD_X86)
+#include <immintrin.h>
+#elif defined(USERVER_IMPL_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+namespace {
+
+constexpr bool IsJsonEscapeCandidate(char c) noexcept {
+  return static_cast<unsigned char>(c) < 0x20 || c == '"' || c == '\\';
+}
+
+constexpr bool IsNonAscii(char c) noexcept {
+  return static_cast<unsigned char>(c) >= 0x80;
+}
+
+// Checks the candidate position that already matched the first and the last
+// characters of the needle
+bool IsSubstringAt(const char* pos, std::string_view needle) noexcept {
+  return needle.size() <= 2 ||
+         std::memcmp(pos + 1, needle.data() + 1, needle.size() - 2) == 0;
+}
+
+// The kernels below return the position the scalar search continues from:
+// the first match, or the beginning of the block they could not process
+
+#if defined(USERVER_IMPL_SIMD_X86)
+USERVER_IMPL_SIMD_TARGET_SSSE3
+const char* FindJsonEscapeCandidateSsse3(const char* begin,
+                                         const char* end) noexcept {
+  for (; end - begin >= 16; begin += 16) {
+    const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    // v < 0x20 <=> max(v, 0x1f) == 0x1f, unsigned
+    const auto control = _mm_cmpeq_epi8(_mm_max_epu8(v, _mm_set1_epi8(0x1f)),
+                                        _mm_set1_epi8(0x1f));
+    const auto matches = _mm_or_si128(
+        control, _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')),
+                              _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))));
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(matches));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+  }
+  return begin;
+}
+
+USERVER_IMPL_SIMD_TARGET_AVX2
+const char* FindJsonEscapeCandidateAvx2(const char* begin,
+                                        const char* end) noexcept {
+  for (; end - begin >= 32; begin += 32) {
+    const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    const auto control = _mm256_cmpeq_epi8(
+        _mm256_max_epu8(v, _mm256_set1_epi8(0x1f)), _mm256_set1_epi8(0x1f));
+    const auto matches = _mm256_or_si256(
+        control, _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')),
+                                 _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))));
+    const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(matches));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+  }
+  return begin;
+}
+
+USERVER_IMPL_SIMD_TARGET_SSSE3
+const char* FindNonAsciiSsse3(const char* begin, const char* end) noexcept {
+  for (; end - begin >= 16; begin += 16) {
+    const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(v));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+  }
+  return begin;
+}
+
+USERVER_IMPL_SIMD_TARGET_AVX2
+const char* FindNonAsciiAvx2(const char* begin, const char* end) noexcept {
+  for (; end - begin >= 32; begin += 32) {
+    const auto v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(v));
+    if (mask != 0) return begin + __builtin_ctz(mask);
+  }
+  return begin;
+}
+
+// Compares the blocks of the first and the last characters of the needle with
+// the blocks of the text shifted by the needle size, so that only the
+// positions matching both of them are checked with memcmp. `last_start` is
+// the last position the needle may start at.
+USERVER_IMPL_SIMD_TARGET_SSSE3
+const char* FindSubstringSsse3(const char* begin, const char* last_start,
+                               std::string_view needle) noexcept {
+  const auto first = _mm_set1_epi8(needle.front());
+  const auto last = _mm_set1_epi8(needle.back());
+  const auto last_offset = needle.size() - 1;
+  for (; last_start - begin >= 16; begin += 16) {
+    const auto block_first =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+    const auto block_last =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin + last_offset));
+    auto mask = static_cast<std::uint32_t>(
+        _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(block_first, first),
+                                        _mm_cmpeq_epi8(block_last, last))));
+    for (; mask != 0; mask &= mask - 1) {
+      const char* const candidate = begin + __builtin_ctz(mask);
+      if (IsSubstringAt(candidate, needle)) return candidate;
+    }
+  }
+  return begin;
+}
+
+USERVER_IMPL_SIMD_TARGET_AVX2
+const char* FindSubstringAvx2(const char* begin, const char* last_start,
+                              std::string_view needle) noexcept {
+  const auto first = _mm256_set1_epi8(needle.front());
+  const auto last = _mm256_set1_epi8(needle.back());
+  const auto last_offset = needle.size() - 1;
+  for (; last_start - begin >= 32; begin += 32) {
+    const auto block_first =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+    const auto block_last = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(begin + last_offset));
+    auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(block_first, first),
+                         _mm256_cmpeq_epi8(block_last, last))));
+    for (; mask != 0; mask &= mask - 1) {
+      const char* const candidate = begin + __builtin_ctz(mask);
+      if (IsSubstringAt(candidate, needle)) return candidate;
+    }
+  }
+  return begin;
+}
+#elif defined(USERVER_IMPL_SIMD_NEON)
+const char* FindJsonEscapeCandidateNeon(const char* begin,
+                                        const char* end) noexcept {
+  for (; end - begin >= 16; begin += 16) {
+    const auto v = vld1q_u8(reinterpret_cast<const std::uint8_t*>(begin));
+    const auto matches =
+        vorrq_u8(vcltq_u8(v, vdupq_n_u8(0x20)),
+                 vorrq_u8(vceqq_u8(v, vdupq_n_u8('"')),
+                          vceqq_u8(v, vdupq_n_u8('\\'))));
+    // The match is located by the scalar search
+    if (vmaxvq_u8(matches) != 0) break;
+  }
+  return begin;
+}
+
+const char* FindNonAsciiNeon(const char* begin, const char* end) noexcept {
+  for (; end - begin >= 16; begin += 16) {
+    const auto v = vld1q_u8(reinterpret_cast<const std::uint8_t*>(begin));
+    if (vmaxvq_u8(v) >= 0x80) break;
+  }
+  return begin;
+}
+
+const char* FindSubstringNeon(const char* begin, const char* last_start,
+                              std::string_view needle) noexcept {
+  const auto first = vdupq_n_u8(static_cast<std::uint8_t>(needle.front()));
+  const auto last = vdupq_n_u8(static_cast<std::uint8_t>(needle.back()));
+  const auto last_offset = needle.size() - 1;
+  for (; last_start - begin >= 16; begin += 16) {
+    const auto block_first =
+        vld1q_u8(reinterpret_cast<const std::uint8_t*>(begin));
+    const auto block_last =
+        vld1q_u8(reinterpret_cast<const std::uint8_t*>(begin + last_offset));
+    const auto matches =
+        vandq_u8(vceqq_u8(block_first, first), vceqq_u8(block_last, last));
+    // The candidates of the block are checked by the scalar search
+    if (vmaxvq_u8(matches) != 0) break;
+  }
+  return begin;
+}
+#endif
+
+}  // namespace
+
+// The AVX2 kernels leave the tail shorter than 32 bytes to the SSSE3 ones
+
+const char* FindJsonEscapeCandidate(const char* begin,
+                                    const char* end) noexcept {
+#if defined(USERVER_IMPL_SIMD_X86)
+  switch (simd::GetInstructionSet()) {
+    case simd::InstructionSet::kAvx2:
+      begin = FindJsonEscapeCandidateAvx2(begin, end);
+      [[fallthrough]];
+    case simd::InstructionSet::kSsse3:
+      begin = FindJsonEscapeCandidateSsse3(begin, end);
+      break;
+    default:
+      break;
+  }
+#elif defined(USERVER_IMPL_SIMD_NEON)
+  if (simd::IsEnabled(simd::InstructionSet::kNeon)) {
+    begin = FindJsonEscapeCandidateNeon(begin, end);
+  }
+#endif
+  return FindJsonEscapeCandidateNoSimd(begin, end);
+}
+
+const char* FindJsonEscapeCandidateNoSimd(const char* begin,
+                                          const char* end) noexcept {
+  while (begin != end && !IsJsonEscapeCandidate(*begin)) ++begin;
+  return begin;
+}
+
+const char* FindNonAscii(const char* begin, const char* end) noexcept {
+#if defined(USERVER_IMPL_SIMD_X86)
+  switch (simd::GetInstructionSet()) {
+    case simd::InstructionSet::kAvx2:
+      begin = FindNonAsciiAvx2(begin, end);
+      [[fallthrough]];
+    case simd::InstructionSet::kSsse3:
+      begin = FindNonAsciiSsse3(begin, end);
+      break;
+    default:
+      break;
+  }
+#elif defined(USERVER_IMPL_SIMD_NEON)
+  if (simd::IsEnabled(simd::InstructionSet::kNeon)) {
+    begin = FindNonAsciiNeon(begin, end);
+  }
+#endif
+  return FindNonAsciiNoSimd(begin, end);
+}
+
+const char* FindNonAsciiNoSimd(const char* begin, const char* end) noexcept {
+  while (begin != end && !IsNonAscii(*begin)) ++begin;
+  return begin;
+}
+
+const char* FindSubstring(const char* begin, const char* end,
+                          std::string_view needle) noexcept {
+  if (needle.empty()) return begin;
+  if (static_cast<std::size_t>(end - begin) < needle.size()) return end;
+  [[maybe_unused]] const char* const last_start = end - needle.size();
+
+#if defined(USERVER_IMPL_SIMD_X86)
+  switch (simd::GetInstructionSet()) {
+    case simd::InstructionSet::kAvx2:
+      begin = FindSubstringAvx2(begin, last_start, needle);
+      [[fallthrough]];
+    case simd::InstructionSet::kSsse3:
+      begin = FindSubstringSsse3(begin, last_start, needle);
+      break;
+    default:
+      break;
+  }
+#elif defined(USERVER_IMPL_SIMD_NEON)
+  if (simd::IsEnabled(simd::InstructionSet::kNeon)) {
+    begin = FindSubstringNeon(begin, last_start, needle);
+  }
+#endif
+  return FindSubstringNoSimd(begin, end, needle);
+}
+
+const char* FindSubstringNoSimd(const char* begin, const char* end,
+                                std::string_view needle) noexcept {
+  const std::string_view text{begin, static_cast<std::size_t>(end - begin)};
+  const auto pos = text.find(needle);
+  return pos == std::string_view::npos ? end : begin + pos;
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
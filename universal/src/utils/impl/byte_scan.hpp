@@ -0,0 +1,38 @@
+#pragma once
+
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+// Returns the first character of [begin, end) that may not be written into
+// a JSON string as is: '"', '\\' or a control character; or `end`.
+const char* FindJsonEscapeCandidate(const char* begin,
+                                    const char* end) noexcept;
+
+// Same as FindJsonEscapeCandidate, but doesn't explicitly use SIMD even if
+// it's available.
+const char* FindJsonEscapeCandidateNoSimd(const char* begin,
+                                          const char* end) noexcept;
+
+// Returns the first non-ASCII character of [begin, end) or `end`.
+const char* FindNonAscii(const char* begin, const char* end) noexcept;
+
+// Same as FindNonAscii, but doesn't explicitly use SIMD even if it's
+// available.
+const char* FindNonAsciiNoSimd(const char* begin, const char* end) noexcept;
+
+// Returns the beginning of the first occurrence of `needle` in [begin, end) or
+// `end`.
+const char* FindSubstring(const char* begin, const char* end,
+                          std::string_view needle) noexcept;
+
+// Same as FindSubstring, but doesn't explicitly use SIMD even if it's
+// available.
+const char* FindSubstringNoSimd(const char* begin, const char* end,
+                                std::string_view needle) noexcept;
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
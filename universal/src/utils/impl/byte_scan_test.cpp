@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+#include <utils/impl/byte_scan.hpp>
+#include <utils/simd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Runs the check with each of the instruction sets
+template <typename Check>
+void ForEachInstructionSet(Check check) {
+  for (const auto instruction_set : utils::simd::kAllInstructionSets) {
+    utils::simd::SetMaxInstructionSet(instruction_set);
+    check();
+  }
+  utils::simd::SetMaxInstructionSet(utils::simd::InstructionSet::kNeon);
+}
+
+template <typename Func, typename ReferenceFunc>
+void CheckAllPositions(Func func, ReferenceFunc reference_func,
+                       std::string_view needles) {
+  // Covers all the offsets relative to the 16 and 32 bytes blocks
+  std::string buffer(100, 'a');
+  for (std::size_t begin = 0; begin < 33; ++begin) {
+    for (std::size_t end = begin; end < buffer.size(); ++end) {
+      const char* const first = buffer.data() + begin;
+      const char* const last = buffer.data() + end;
+      ASSERT_EQ(func(first, last), last);
+
+      for (const char needle : needles) {
+        for (std::size_t pos = begin; pos < end; ++pos) {
+          buffer[pos] = needle;
+          ASSERT_EQ(func(first, last), reference_func(first, last))
+              << "begin=" << begin << " end=" << end << " pos=" << pos
+              << " needle=" << static_cast<int>(needle);
+          ASSERT_EQ(func(first, last), buffer.data() + pos);
+          buffer[pos] = 'a';
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(FindJsonEscapeCandidate, Correctness) {
+  ForEachInstructionSet([] {
+    CheckAllPositions(utils::impl::FindJsonEscapeCandidate,
+                      utils::impl::FindJsonEscapeCandidateNoSimd,
+                      std::string_view{"\"\\\0\x01\x1f\n", 6});
+  });
+}
+
+TEST(FindJsonEscapeCandidate, NoFalsePositives) {
+  std::string text;
+  for (int c = 0x20; c < 0x100; ++c) {
+    if (c != '"' && c != '\\') text += static_cast<char>(c);
+  }
+  EXPECT_EQ(utils::impl::FindJsonEscapeCandidate(text.data(),
+                                                 text.data() + text.size()),
+            text.data() + text.size());
+}
+
+TEST(FindNonAscii, Correctness) {
+  ForEachInstructionSet([] {
+    CheckAllPositions(utils::impl::FindNonAscii,
+                      utils::impl::FindNonAsciiNoSimd, "\x80\xc3\xff");
+  });
+}
+
+TEST(FindNonAscii, NoFalsePositives) {
+  std::string text;
+  for (int c = 0; c < 0x80; ++c) text += static_cast<char>(c);
+  EXPECT_EQ(utils::impl::FindNonAscii(text.data(), text.data() + text.size()),
+            text.data() + text.size());
+}
+
+TEST(FindSubstring, Correctness) {
+  ForEachInstructionSet([] {
+    for (const std::string_view needle : {"-", "\r\n", "\r\n--boundary"}) {
+      std::string buffer(100, 'a');
+      for (std::size_t begin = 0; begin < 33; ++begin) {
+        for (std::size_t end = begin; end < buffer.size(); ++end) {
+          const char* const first = buffer.data() + begin;
+          const char* const last = buffer.data() + end;
+          ASSERT_EQ(utils::impl::FindSubstring(first, last, needle), last);
+
+          for (std::size_t pos = begin; pos + needle.size() <= end; ++pos) {
+            buffer.replace(pos, needle.size(), needle);
+            ASSERT_EQ(utils::impl::FindSubstring(first, last, needle),
+                      buffer.data() + pos)
+                << "begin=" << begin << " end=" << end << " pos=" << pos
+                << " needle=" << needle;
+            buffer.replace(pos, needle.size(), needle.size(), 'a');
+          }
+        }
+      }
+    }
+  });
+}
+
+TEST(FindSubstring, PartialMatches) {
+  // The first and the last characters of the needle match everywhere
+  const std::string text = std::string(64, 'x') + "xyx";
+  for (const std::string_view needle : {"xyx", "xx", "xxxyx"}) {
+    EXPECT_EQ(utils::impl::FindSubstring(text.data(), text.data() + text.size(),
+                                         needle),
+              utils::impl::FindSubstringNoSimd(
+                  text.data(), text.data() + text.size(), needle))
+        << needle;
+  }
+  EXPECT_EQ(utils::impl::FindSubstring(text.data(), text.data() + text.size(),
+                                       "xyy"),
+            text.data() + text.size());
+  EXPECT_EQ(utils::impl::FindSubstring(text.data(), text.data() + 2, "xyx"),
+            text.data() + 2);
+  EXPECT_EQ(utils::impl::FindSubstring(text.data(), text.data() + 2, ""),
+            text.data());
+}
+
+USERVER_NAMESPACE_END
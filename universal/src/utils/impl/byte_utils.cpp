@@ -4,6 +4,7 @@
 #include <emmintrin.h>
 #endif
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <limits>
@@ -16,6 +17,8 @@ namespace utils::impl {
 
 namespace {
 
+static_assert(ToLowerAscii(0x5a41405b7a61c1daull) == 0x7a61405b7a61c1daull);
+
 inline std::uint64_t RotateLeft(std::uint64_t x, std::uint64_t b) noexcept {
   return (x << b) | (x >> (64UL - b));
 }
@@ -85,10 +88,7 @@ struct CaseInsensitiveSSEFetcher final {
 
   static inline std::uint64_t FetchN(const std::uint8_t* data,
                                      std::size_t n) noexcept {
-    const auto value = CaseFetcher::FetchN(data, n);
-    return LowercaseBytes(
-               _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&value)))
-        .first;
+    return ToLowerAscii(CaseFetcher::FetchN(data, n));
   }
 
   static inline bool FailFastCompare8(const std::uint8_t* lhs,
@@ -181,48 +181,39 @@ struct CaseInsensitiveSSEFetcher final {
 };
 #endif
 
+// Lowercases 8 bytes at once in a general purpose register (SWAR)
 struct CaseInsensitiveFetcher final {
   static inline std::uint64_t Fetch8(const std::uint8_t* data) noexcept {
-    std::array<std::uint8_t, 8> lowercase{};
-    Lowercase(lowercase.data(), data, 8);
-    return CaseFetcher::Fetch8(lowercase.data());
+    return ToLowerAscii(CaseFetcher::Fetch8(data));
   }
 
   static inline std::pair<std::uint64_t, std::uint64_t> Fetch16(
       const std::uint8_t* data) noexcept {
-    std::array<std::uint8_t, 16> lowercase{};
-    Lowercase(lowercase.data(), data, 16);
-    return CaseFetcher::Fetch16(lowercase.data());
+    return {Fetch8(data), Fetch8(data + 8)};
   }
 
   static inline std::uint64_t FetchN(const std::uint8_t* data,
                                      std::size_t n) noexcept {
-    // n should be less than 8 by algorithm construction
-    UASSERT(n < 8);
-
-    std::array<std::uint8_t, 8> lowercase{};
-    Lowercase(lowercase.data(), data, n);
-    return CaseFetcher::FetchN(lowercase.data(), n);
+    return ToLowerAscii(CaseFetcher::FetchN(data, n));
   }
 
   static inline bool FailFastCompare8(const std::uint8_t* lhs,
                                       const std::uint8_t* rhs) noexcept {
-    return Fetch8(lhs) == Fetch8(rhs);
+    return EqualWords(CaseFetcher::Fetch8(lhs), CaseFetcher::Fetch8(rhs));
   }
 
   static inline bool FailFastCompare16(const std::uint8_t* lhs,
                                        const std::uint8_t* rhs) noexcept {
-    return Fetch16(lhs) == Fetch16(rhs);
+    return FailFastCompare8(lhs, rhs) && FailFastCompare8(lhs + 8, rhs + 8);
   }
 
- private:
-  static inline void Lowercase(std::uint8_t* dst, const std::uint8_t* src,
-                               std::size_t len) noexcept {
-    for (std::size_t i = 0; i < len; ++i) {
-      const std::uint8_t c = src[i];
-      const char mask = (c >= 'A' && c <= 'Z') ? 32 : 0;
-      dst[i] = c | mask;
-    }
+  static inline bool EqualWords(std::uint64_t lhs, std::uint64_t rhs) noexcept {
+    // Same as in CaseInsensitiveSSEFetcher::FailFastCompare, the bytes that
+    // differ in anything but the case bit are not equal
+    const auto diff = lhs ^ rhs;
+    if (diff == 0) return true;
+    if ((diff & ~(0x0101010101010101ull * 32)) != 0) return false;
+    return ToLowerAscii(lhs) == ToLowerAscii(rhs);
   }
 };
 
@@ -343,6 +334,12 @@ inline bool CompareAndAdvance(std::string_view& lhs,
   return are_equal;
 }
 
+inline std::uint64_t Fetch4(const void* data) noexcept {
+  std::uint32_t result{};
+  std::memcpy(&result, data, 4);
+  return result;
+}
+
 inline bool CompareNaive(std::string_view lhs, std::string_view rhs) noexcept {
   UASSERT(lhs.size() == rhs.size());
   for (std::size_t i = 0; i < lhs.size(); ++i) {
@@ -367,8 +364,14 @@ inline bool NoCaseEqual(std::string_view lhs, std::string_view rhs) noexcept {
   }
 
   if (lhs.size() < 8) {
-    // we can't do SSE for short strings, so this is actually decently fast.
-    return CompareNaive(lhs, rhs);
+    if (lhs.size() < 4) return CompareNaive(lhs, rhs);
+
+    // two overlapping 4 bytes words, in a single register
+    const auto fetch = [size = lhs.size()](const char* data) {
+      return (Fetch4(data) << 32) | Fetch4(data + size - 4);
+    };
+    return CaseInsensitiveFetcher::EqualWords(fetch(lhs.data()),
+                                              fetch(rhs.data()));
   }
 
   auto lhs_suffix = lhs.substr(lhs.size() - 8, 8);
@@ -436,6 +439,62 @@ bool CaseInsensitiveEqualNoSse::operator()(std::string_view lhs,
   return NoCaseEqual<CaseInsensitiveFetcher>(lhs, rhs);
 }
 
+int CaseInsensitiveCompareThreeWay::operator()(std::string_view lhs,
+                                               std::string_view rhs) const
+    noexcept {
+  const auto min_size = std::min(lhs.size(), rhs.size());
+  const auto* lhs_data = reinterpret_cast<const std::uint8_t*>(lhs.data());
+  const auto* rhs_data = reinterpret_cast<const std::uint8_t*>(rhs.data());
+
+  // The first differing words, lowercased and byte-swapped to compare the
+  // bytes in the string order. NOTE: this implies LE.
+  const auto compare_words = [](std::uint64_t lhs_word,
+                                std::uint64_t rhs_word) {
+    if (lhs_word == rhs_word) return 0;
+    lhs_word = __builtin_bswap64(ToLowerAscii(lhs_word));
+    rhs_word = __builtin_bswap64(ToLowerAscii(rhs_word));
+    if (lhs_word == rhs_word) return 0;
+    return lhs_word < rhs_word ? -1 : 1;
+  };
+
+  int result = 0;
+  if (min_size >= 8) {
+    std::size_t i = 0;
+    for (; i + 8 <= min_size && result == 0; i += 8) {
+      result = compare_words(CaseFetcher::Fetch8(lhs_data + i),
+                             CaseFetcher::Fetch8(rhs_data + i));
+    }
+    // The last 8 bytes overlap with the already compared equal ones
+    if (result == 0 && i != min_size) {
+      result = compare_words(CaseFetcher::Fetch8(lhs_data + min_size - 8),
+                             CaseFetcher::Fetch8(rhs_data + min_size - 8));
+    }
+  } else if (min_size >= 4) {
+    // Two overlapping 4 bytes words, the second one is compared only if the
+    // first ones are equal
+    const auto fetch = [min_size](const std::uint8_t* data) {
+      return (Fetch4(data + min_size - 4) << 32) | Fetch4(data);
+    };
+    result = compare_words(fetch(lhs_data), fetch(rhs_data));
+  } else {
+    for (std::size_t i = 0; i < min_size; ++i) {
+      unsigned char a = lhs_data[i];
+      unsigned char b = rhs_data[i];
+
+      if (a == b) continue;
+      if ('A' <= a && a <= 'Z') a |= 32;
+      if ('A' <= b && b <= 'Z') b |= 32;
+      if (a == b) continue;
+
+      return static_cast<int>(a) - static_cast<int>(b);
+    }
+  }
+
+  if (result != 0) return result;
+  if (lhs.size() != rhs.size()) return lhs.size() < rhs.size() ? -1 : 1;
+  return 0;
+}
+
 }  // namespace utils::impl
 
 USERVER_NAMESPACE_END
@@ -7,6 +7,16 @@ USERVER_NAMESPACE_BEGIN
 
 namespace utils::impl {
 
+// Lowercases the ASCII letters of the 8 bytes at once
+constexpr std::uint64_t ToLowerAscii(std::uint64_t word) noexcept {
+  constexpr std::uint64_t kOnes = 0x0101010101010101ull;
+  const auto heptets = word & (kOnes * 0x7f);
+  const auto ge_a = heptets + kOnes * (0x80 - 'A');
+  const auto gt_z = heptets + kOnes * (0x80 - 'Z' - 1);
+  const auto is_upper = (ge_a ^ gt_z) & ~word & (kOnes * 0x80);
+  return word | (is_upper >> 2);
+}
+
 // SipHash13 implementation.
 class SipHasher final {
  public:
@@ -57,6 +67,12 @@ class CaseInsensitiveEqualNoSse final {
   bool operator()(std::string_view lhs, std::string_view rhs) const noexcept;
 };
 
+// Case insensitive 3-way comparison, compares 8 bytes at once
+class CaseInsensitiveCompareThreeWay final {
+ public:
+  int operator()(std::string_view lhs, std::string_view rhs) const noexcept;
+};
+
 }  // namespace utils::impl
 
 USERVER_NAMESPACE_END
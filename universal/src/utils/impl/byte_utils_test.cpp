@@ -1,9 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
 #include <cctype>
 #include <cstdint>
 #include <cstring>
+#include <string>
+#include <string_view>
 
 #include <utils/impl/byte_utils.hpp>
 
@@ -366,6 +369,21 @@ void TestCaseInsensitiveEqual() {
   }
 }
 
+int ReferenceCompareThreeWay(std::string_view lhs, std::string_view rhs) {
+  const auto to_lower = [](unsigned char c) {
+    return ('A' <= c && c <= 'Z') ? c | 32 : c;
+  };
+  for (std::size_t i = 0; i < std::min(lhs.size(), rhs.size()); ++i) {
+    const int a = to_lower(lhs[i]);
+    const int b = to_lower(rhs[i]);
+    if (a != b) return a - b;
+  }
+  if (lhs.size() == rhs.size()) return 0;
+  return lhs.size() < rhs.size() ? -1 : 1;
+}
+
+int Sign(int value) { return (value > 0) - (value < 0); }
+
 }  // namespace
 
 TEST(SipHashCase, MatchesReferenceImplementation) {
@@ -390,4 +408,34 @@ TEST(CaseInsensitiveEqualNoSse, Correctness) {
   TestCaseInsensitiveEqual<utils::impl::CaseInsensitiveEqualNoSse>();
 }
 
+TEST(CaseInsensitiveCompareThreeWay, MatchesReferenceImplementation) {
+  const utils::impl::CaseInsensitiveCompareThreeWay cmp{};
+  const std::string_view all_bytes = kAllPossibleBytesString;
+
+  for (std::size_t len = 0; len <= 40; ++len) {
+    for (std::size_t start = 0; start + len <= all_bytes.size(); ++start) {
+      const auto lhs = all_bytes.substr(start, len);
+      std::string rhs{lhs};
+      ASSERT_EQ(cmp(lhs, rhs), 0);
+
+      for (std::size_t diff_at = 0; diff_at < len; ++diff_at) {
+        for (const unsigned char flip : {1, 32, 128}) {
+          rhs[diff_at] ^= flip;
+          ASSERT_EQ(Sign(cmp(lhs, rhs)),
+                    Sign(ReferenceCompareThreeWay(lhs, rhs)))
+              << "len=" << len << " start=" << start << " diff_at=" << diff_at;
+          ASSERT_EQ(Sign(cmp(rhs, lhs)), -Sign(cmp(lhs, rhs)));
+          rhs[diff_at] ^= flip;
+        }
+      }
+
+      if (len != 0) {
+        const auto prefix = lhs.substr(0, len - 1);
+        ASSERT_GT(cmp(lhs, prefix), 0);
+        ASSERT_LT(cmp(prefix, lhs), 0);
+      }
+    }
+  }
+}
+
 USERVER_NAMESPACE_END
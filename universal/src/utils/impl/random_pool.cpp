@@ -0,0 +1,112 @@
+#include <utils/impl/random_pool.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+#include <userver/compiler/thread_local.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+namespace {
+
+constexpr std::uint32_t RotateLeft(std::uint32_t x, int bits) noexcept {
+  return (x << bits) | (x >> (32 - bits));
+}
+
+constexpr void QuarterRound(std::uint32_t& a, std::uint32_t& b,
+                            std::uint32_t& c, std::uint32_t& d) noexcept {
+  a += b;
+  d = RotateLeft(d ^ a, 16);
+  c += d;
+  b = RotateLeft(b ^ c, 12);
+  a += b;
+  d = RotateLeft(d ^ a, 8);
+  c += d;
+  b = RotateLeft(b ^ c, 7);
+}
+
+compiler::ThreadLocal local_random_pool = [] { return RandomPool{}; };
+
+}  // namespace
+
+template <int Rounds>
+void ChaChaBlock(const std::array<std::uint32_t, 8>& key, std::uint64_t counter,
+                 std::uint64_t nonce, std::uint8_t* out) noexcept {
+  static_assert(Rounds % 2 == 0);
+
+  const std::uint32_t input[16] = {
+      // "expand 32-byte k"
+      0x61707865, 0x3320646e, 0x79622d32, 0x6b206574,
+      key[0], key[1], key[2], key[3], key[4], key[5], key[6], key[7],
+      static_cast<std::uint32_t>(counter),
+      static_cast<std::uint32_t>(counter >> 32),
+      static_cast<std::uint32_t>(nonce),
+      static_cast<std::uint32_t>(nonce >> 32)};
+
+  std::uint32_t x[16];
+  std::memcpy(x, input, sizeof(x));
+  for (int i = 0; i < Rounds; i += 2) {
+    QuarterRound(x[0], x[4], x[8], x[12]);
+    QuarterRound(x[1], x[5], x[9], x[13]);
+    QuarterRound(x[2], x[6], x[10], x[14]);
+    QuarterRound(x[3], x[7], x[11], x[15]);
+
+    QuarterRound(x[0], x[5], x[10], x[15]);
+    QuarterRound(x[1], x[6], x[11], x[12]);
+    QuarterRound(x[2], x[7], x[8], x[13]);
+    QuarterRound(x[3], x[4], x[9], x[14]);
+  }
+
+  for (int i = 0; i < 16; ++i) {
+    const auto word = x[i] + input[i];
+    // Little endian, as in RFC
+    out[i * 4] = static_cast<std::uint8_t>(word);
+    out[i * 4 + 1] = static_cast<std::uint8_t>(word >> 8);
+    out[i * 4 + 2] = static_cast<std::uint8_t>(word >> 16);
+    out[i * 4 + 3] = static_cast<std::uint8_t>(word >> 24);
+  }
+}
+
+template void ChaChaBlock<8>(const std::array<std::uint32_t, 8>&, std::uint64_t,
+                             std::uint64_t, std::uint8_t*) noexcept;
+template void ChaChaBlock<20>(const std::array<std::uint32_t, 8>&,
+                              std::uint64_t, std::uint64_t,
+                              std::uint8_t*) noexcept;
+
+RandomPool::RandomPool() : position_(sizeof(buffer_)) {
+  std::random_device device;
+  for (auto& word : key_) word = device();
+  nonce_ = (static_cast<std::uint64_t>(device()) << 32) | device();
+}
+
+void RandomPool::Fill(void* data, std::size_t size) noexcept {
+  auto* out = static_cast<std::uint8_t*>(data);
+  while (size != 0) {
+    if (position_ == sizeof(buffer_)) Refill();
+
+    const auto chunk = std::min(size, sizeof(buffer_) - position_);
+    std::memcpy(out, buffer_ + position_, chunk);
+    position_ += chunk;
+    out += chunk;
+    size -= chunk;
+  }
+}
+
+void RandomPool::Refill() noexcept {
+  for (std::size_t i = 0; i < kBlocksPerRefill; ++i) {
+    ChaChaBlock<8>(key_, counter_++, nonce_, buffer_ + i * kBlockSize);
+  }
+  position_ = 0;
+}
+
+void FillRandomBytes(void* data, std::size_t size) noexcept {
+  auto pool = local_random_pool.Use();
+  pool->Fill(data, size);
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
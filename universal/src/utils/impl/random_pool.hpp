@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+// The ChaCha block function, RFC 8439 with a 64-bit block counter and a 64-bit
+// nonce, writes 64 bytes to `out`. `Rounds` is 8 or 20.
+template <int Rounds>
+void ChaChaBlock(const std::array<std::uint32_t, 8>& key, std::uint64_t counter,
+                 std::uint64_t nonce, std::uint8_t* out) noexcept;
+
+// Buffer of random bytes, that is refilled in batches with the ChaCha8
+// keystream of a random key. Much faster than requesting the values from
+// the generators of utils/rand.hpp one by one, and the values are hard to
+// predict.
+class RandomPool final {
+ public:
+  // Seeds the key from std::random_device
+  RandomPool();
+
+  RandomPool(RandomPool&&) = delete;
+  RandomPool& operator=(RandomPool&&) = delete;
+
+  void Fill(void* data, std::size_t size) noexcept;
+
+ private:
+  static constexpr std::size_t kBlockSize = 64;
+  static constexpr std::size_t kBlocksPerRefill = 4;
+
+  void Refill() noexcept;
+
+  std::array<std::uint32_t, 8> key_{};
+  std::uint64_t nonce_{0};
+  std::uint64_t counter_{0};
+  std::size_t position_;
+  std::uint8_t buffer_[kBlockSize * kBlocksPerRefill];
+};
+
+// Fills the `data` from the pool of the current thread
+void FillRandomBytes(void* data, std::size_t size) noexcept;
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,68 @@
+#include <utils/impl/random_pool.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <set>
+#include <string>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(ChaChaBlock, Rfc8439TestVector) {
+  // RFC 8439, 2.3.2. Test Vector for the ChaCha20 Block Function
+  const std::array<std::uint32_t, 8> key = {
+      0x03020100, 0x07060504, 0x0b0a0908, 0x0f0e0d0c,
+      0x13121110, 0x17161514, 0x1b1a1918, 0x1f1e1d1c};
+  // The block counter is 1, the nonce is 00:00:00:09:00:00:00:4a:00:00:00:00
+  const std::uint64_t counter = 1 | (std::uint64_t{0x09000000} << 32);
+  const std::uint64_t nonce = 0x4a000000;
+
+  const std::uint8_t expected[64] = {
+      0x10, 0xf1, 0xe7, 0xe4, 0xd1, 0x3b, 0x59, 0x15, 0x50, 0x0f, 0xdd,
+      0x1f, 0xa3, 0x20, 0x71, 0xc4, 0xc7, 0xd1, 0xf4, 0xc7, 0x33, 0xc0,
+      0x68, 0x03, 0x04, 0x22, 0xaa, 0x9a, 0xc3, 0xd4, 0x6c, 0x4e, 0xd2,
+      0x82, 0x64, 0x46, 0x07, 0x9f, 0xaa, 0x09, 0x14, 0xc2, 0xd7, 0x05,
+      0xd9, 0x8b, 0x02, 0xa2, 0xb5, 0x12, 0x9c, 0xd1, 0xde, 0x16, 0x4e,
+      0xb9, 0xcb, 0xd0, 0x83, 0xe8, 0xa2, 0x50, 0x3c, 0x4e};
+
+  std::uint8_t block[64];
+  utils::impl::ChaChaBlock<20>(key, counter, nonce, block);
+  EXPECT_TRUE(std::equal(std::begin(block), std::end(block),
+                         std::begin(expected)));
+}
+
+TEST(RandomPool, Fill) {
+  utils::impl::RandomPool pool;
+
+  std::set<std::string> values;
+  for (std::size_t size = 1; size <= 1000; size += 7) {
+    std::string value(size, '\0');
+    pool.Fill(value.data(), value.size());
+    EXPECT_TRUE(values.insert(value).second);
+  }
+  // the bytes are not all zeros
+  EXPECT_NE(values.rbegin()->find_first_not_of('\0'), std::string::npos);
+}
+
+TEST(RandomPool, DifferentPools) {
+  utils::impl::RandomPool first;
+  utils::impl::RandomPool second;
+
+  std::array<std::uint64_t, 4> first_values{};
+  std::array<std::uint64_t, 4> second_values{};
+  first.Fill(first_values.data(), sizeof(first_values));
+  second.Fill(second_values.data(), sizeof(second_values));
+  EXPECT_NE(first_values, second_values);
+}
+
+TEST(RandomPool, FillRandomBytes) {
+  std::array<std::uint64_t, 2> first{};
+  std::array<std::uint64_t, 2> second{};
+  utils::impl::FillRandomBytes(first.data(), sizeof(first));
+  utils::impl::FillRandomBytes(second.data(), sizeof(second));
+  EXPECT_NE(first, second);
+}
+
+USERVER_NAMESPACE_END
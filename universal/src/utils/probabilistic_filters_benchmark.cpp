@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include <userver/utils/blocked_bloom_filter.hpp>
+#include <userver/utils/cuckoo_filter.hpp>
+#include <userver/utils/filter_bloom.hpp>
+#include <userver/utils/hash.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// Half of the lookups are for the inserted keys
+constexpr std::uint64_t kLookups = 1024;
+
+template <typename Filter>
+void Fill(Filter& filter, std::int64_t size) {
+  for (std::int64_t i = 0; i < size; ++i) {
+    filter.Insert(static_cast<std::uint64_t>(i) * 2);
+  }
+}
+
+void FilterBloomLookup(benchmark::State& state) {
+  utils::FilterBloom<std::uint64_t, unsigned, utils::hash::Hash<std::uint64_t>>
+      filter(state.range(0) * 16);
+  for (std::int64_t i = 0; i < state.range(0); ++i) {
+    filter.Increment(static_cast<std::uint64_t>(i) * 2);
+  }
+  std::uint64_t key = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    for (std::uint64_t i = 0; i < kLookups; ++i) {
+      benchmark::DoNotOptimize(filter.Has(key++ % (state.range(0) * 4)));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kLookups);
+}
+
+template <typename Filter>
+void FilterLookup(benchmark::State& state) {
+  Filter filter(state.range(0));
+  Fill(filter, state.range(0));
+  std::uint64_t key = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    for (std::uint64_t i = 0; i < kLookups; ++i) {
+      benchmark::DoNotOptimize(filter.MayContain(key++ % (state.range(0) * 4)));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kLookups);
+}
+
+template <typename Filter>
+void FilterInsert(benchmark::State& state) {
+  for ([[maybe_unused]] auto _ : state) {
+    Filter filter(state.range(0));
+    Fill(filter, state.range(0));
+    benchmark::DoNotOptimize(filter.GetSize());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+using BlockedBloomFilter = utils::BlockedBloomFilter<std::uint64_t>;
+using CuckooFilter = utils::CuckooFilter<std::uint64_t>;
+
+}  // namespace
+
+BENCHMARK(FilterBloomLookup)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(FilterLookup, BlockedBloomFilter)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(FilterLookup, CuckooFilter)->Range(1 << 10, 1 << 22);
+BENCHMARK_TEMPLATE(FilterInsert, BlockedBloomFilter)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(FilterInsert, CuckooFilter)->Range(1 << 10, 1 << 18);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,56 @@
+#include <utils/simd.hpp>
+
+#include <atomic>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::simd {
+
+namespace {
+
+InstructionSet DetectInstructionSet() noexcept {
+#if defined(USERVER_IMPL_SIMD_X86)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return InstructionSet::kAvx2;
+  if (__builtin_cpu_supports("ssse3")) return InstructionSet::kSsse3;
+  return InstructionSet::kNone;
+#elif defined(USERVER_IMPL_SIMD_NEON)
+  return InstructionSet::kNeon;
+#else
+  return InstructionSet::kNone;
+#endif
+}
+
+// Zero-initialized to kNone if used before the dynamic initialization
+const InstructionSet kDetectedInstructionSet = DetectInstructionSet();
+
+std::atomic<InstructionSet> max_instruction_set{InstructionSet::kNeon};
+
+}  // namespace
+
+InstructionSet GetInstructionSet() noexcept {
+  const auto max = max_instruction_set.load(std::memory_order_relaxed);
+  if (kDetectedInstructionSet <= max) return kDetectedInstructionSet;
+  // x86 instruction sets are not a subset of NEON
+  return kDetectedInstructionSet == InstructionSet::kNeon
+             ? InstructionSet::kNone
+             : max;
+}
+
+bool IsEnabled(InstructionSet instruction_set) noexcept {
+  const auto current = GetInstructionSet();
+  if (instruction_set == InstructionSet::kNeon ||
+      current == InstructionSet::kNeon) {
+    return instruction_set == current ||
+           instruction_set == InstructionSet::kNone;
+  }
+  return instruction_set <= current;
+}
+
+void SetMaxInstructionSet(InstructionSet instruction_set) noexcept {
+  max_instruction_set.store(instruction_set, std::memory_order_relaxed);
+}
+
+}  // namespace utils::simd
+
+USERVER_NAMESPACE_END
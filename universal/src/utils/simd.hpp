@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+// The kernels of the instruction sets that are not enabled for the whole build
+// are compiled for the specific target and are selected at runtime.
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define USERVER_IMPL_SIMD_X86 1
+#define USERVER_IMPL_SIMD_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define USERVER_IMPL_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+// NEON is a part of the baseline aarch64 instruction set
+#define USERVER_IMPL_SIMD_NEON 1
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::simd {
+
+/// Vector instruction sets, starting from the least capable one
+enum class InstructionSet : std::uint8_t {
+  kNone,
+  kSsse3,
+  kAvx2,
+  kNeon,
+};
+
+/// All the instruction sets, e.g. to run a test with each of them
+inline constexpr InstructionSet kAllInstructionSets[] = {
+    InstructionSet::kNone,
+    InstructionSet::kSsse3,
+    InstructionSet::kAvx2,
+    InstructionSet::kNeon,
+};
+
+/// Returns the best instruction set supported by the current CPU and not
+/// limited by SetMaxInstructionSet. The CPU is detected once.
+InstructionSet GetInstructionSet() noexcept;
+
+/// Checks whether the kernels of the `instruction_set` may be used
+bool IsEnabled(InstructionSet instruction_set) noexcept;
+
+/// @brief Limits the instruction sets used by the kernels, e.g. to compare
+/// the vectorized kernels with the scalar ones in tests and benchmarks.
+///
+/// InstructionSet::kNone disables the vectorized kernels, kNeon allows all.
+void SetMaxInstructionSet(InstructionSet instruction_set) noexcept;
+
+}  // namespace utils::simd
+
+USERVER_NAMESPACE_END
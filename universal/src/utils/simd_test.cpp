@@ -0,0 +1,23 @@
+#include <utils/simd.hpp>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(Simd, MaxInstructionSet) {
+  const auto detected = utils::simd::GetInstructionSet();
+  EXPECT_TRUE(utils::simd::IsEnabled(detected));
+  EXPECT_TRUE(utils::simd::IsEnabled(utils::simd::InstructionSet::kNone));
+
+  utils::simd::SetMaxInstructionSet(utils::simd::InstructionSet::kNone);
+  EXPECT_EQ(utils::simd::GetInstructionSet(),
+            utils::simd::InstructionSet::kNone);
+  EXPECT_TRUE(utils::simd::IsEnabled(utils::simd::InstructionSet::kNone));
+  EXPECT_FALSE(utils::simd::IsEnabled(utils::simd::InstructionSet::kSsse3));
+  EXPECT_FALSE(utils::simd::IsEnabled(utils::simd::InstructionSet::kNeon));
+
+  utils::simd::SetMaxInstructionSet(utils::simd::InstructionSet::kNeon);
+  EXPECT_EQ(utils::simd::GetInstructionSet(), detected);
+}
+
+USERVER_NAMESPACE_END
@@ -116,7 +116,23 @@ void CaseInsensitiveCompareDifferentStrings(benchmark::State& state) {
   }
 }
 
+void CaseInsensitiveCompareThreeWay(benchmark::State& state) {
+  const auto len = state.range(0);
+
+  const auto first = GenerateRandomString(len);
+  auto second = std::string{first};
+  second.back() ^= 1;
+  const auto cmp = utils::StrIcaseCompareThreeWay{};
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (std::size_t i = 0; i < 20; ++i) {
+      benchmark::DoNotOptimize(cmp(first, second));
+    }
+  }
+}
+
 BENCHMARK(CaseInsensitiveCompareEqualStrings)->DenseRange(1, 31, 3);
+BENCHMARK(CaseInsensitiveCompareThreeWay)->DenseRange(1, 64, 7);
 BENCHMARK_TEMPLATE(CaseInsensitiveCompareDifferentStrings, 31)
     ->DenseRange(1, 31, 3);
 BENCHMARK_TEMPLATE(CaseInsensitiveCompareDifferentStrings, 15)
@@ -10,6 +10,7 @@
 
 #include <userver/utils/assert.hpp>
 
+#include <utils/impl/byte_scan.hpp>
 #include <utils/impl/byte_utils.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -238,11 +239,21 @@ bool IsWellFormedCodePoint(const unsigned char* bytes,
 }
 
 bool IsValid(const unsigned char* bytes, std::size_t length) noexcept {
-  for (size_t i = 0; i < length; ++i) {
-    if (!IsWellFormedCodePoint(bytes + i, length - i)) {
-      return false;
-    } else {
-      i += CodePointLengthByFirstByte(bytes[i]) - 1;
+  const auto* const end = bytes + length;
+  const auto* current = bytes;
+
+  while (current != end) {
+    // ASCII runs are skipped in bulk
+    current = reinterpret_cast<const unsigned char*>(utils::impl::FindNonAscii(
+        reinterpret_cast<const char*>(current),
+        reinterpret_cast<const char*>(end)));
+
+    // Non-ASCII texts rarely contain ASCII characters apart from spaces and
+    // punctuation, so the multibyte code points are checked one by one
+    while (current != end && (*current & 0x80)) {
+      const auto available = static_cast<std::size_t>(end - current);
+      if (!IsWellFormedCodePoint(current, available)) return false;
+      current += CodePointLengthByFirstByte(*current);
     }
   }
 
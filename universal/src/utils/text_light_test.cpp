@@ -226,6 +226,23 @@ TEST(TestIsUtf8, IsUtf8) {
   EXPECT_FALSE(utils::text::IsUtf8("\xe0\x9f\x80"));
 }
 
+TEST(TestIsUtf8, LongAsciiRuns) {
+  const std::string ascii(70, 'a');
+  for (std::size_t pos = 0; pos <= ascii.size(); ++pos) {
+    std::string valid = ascii;
+    valid.insert(pos, "\xc3\xa1");
+    EXPECT_TRUE(utils::text::IsUtf8(valid)) << "pos=" << pos;
+
+    std::string truncated = ascii;
+    truncated.insert(pos, "\xc3");
+    EXPECT_FALSE(utils::text::IsUtf8(truncated)) << "pos=" << pos;
+
+    std::string overlong = ascii;
+    overlong.insert(pos, "\xc0\xaf");
+    EXPECT_FALSE(utils::text::IsUtf8(overlong)) << "pos=" << pos;
+  }
+}
+
 TEST(TestTrimUtf8Truncated, TrimTruncatedEnding) {
   auto test_trim = [](std::string test_str, const std::string expected) {
     auto test_str_orig = test_str;
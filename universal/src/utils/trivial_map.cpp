@@ -0,0 +1,148 @@
+#include <userver/utils/trivial_map.hpp>
+
+#include <cstring>
+#include <limits>
+
+#include <userver/utils/assert.hpp>
+
+#include <utils/impl/byte_utils.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::impl {
+
+namespace {
+
+std::uint64_t Read8(const char* p) noexcept {
+  std::uint64_t word;
+  std::memcpy(&word, p, sizeof(word));
+  return word;
+}
+
+std::uint64_t Read4(const char* p) noexcept {
+  std::uint32_t word;
+  std::memcpy(&word, p, sizeof(word));
+  return word;
+}
+
+// Reads the first, the middle and the last byte, the whole string if its
+// size is 3 or less
+std::uint64_t Read3(const char* p, std::size_t size) noexcept {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(p);
+  return std::uint64_t{bytes[0]} | (std::uint64_t{bytes[size / 2]} << 8) |
+         (std::uint64_t{bytes[size - 1]} << 16);
+}
+
+// Compares the words of the strings of the same size without a std::memcmp
+// call, the words of `rhs` are transformed with `transform`
+template <typename Transform>
+bool EqualWords(const char* lhs, const char* rhs, std::size_t size,
+                Transform transform) noexcept {
+  if (size >= 8) {
+    for (std::size_t i = 0; i + 8 < size; i += 8) {
+      if (Read8(lhs + i) != transform(Read8(rhs + i))) return false;
+    }
+    return Read8(lhs + size - 8) == transform(Read8(rhs + size - 8));
+  }
+  if (size >= 4) {
+    return Read4(lhs) == transform(Read4(rhs)) &&
+           Read4(lhs + size - 4) == transform(Read4(rhs + size - 4));
+  }
+  return size == 0 || Read3(lhs, size) == transform(Read3(rhs, size));
+}
+
+// Case insensitive hash of the string that reads at most 3 words of it, the
+// strings that differ only in the middle of the long ones just collide.
+std::uint64_t Fingerprint(std::string_view value) noexcept {
+  const auto* p = value.data();
+  const auto size = value.size();
+
+  std::uint64_t head = 0;
+  std::uint64_t tail = 0;
+  std::uint64_t middle = 0;
+  if (size >= 8) {
+    head = Read8(p);
+    tail = Read8(p + size - 8);
+    if (size > 16) middle = Read8(p + size / 2 - 4);
+  } else if (size >= 4) {
+    head = Read4(p);
+    tail = Read4(p + size - 4);
+  } else if (size > 0) {
+    head = Read3(p, size);
+  }
+
+  auto hash = (ToLowerAscii(head) ^ size) * 0x9e3779b97f4a7c15ull;
+  hash ^= ToLowerAscii(tail) * 0xbf58476d1ce4e5b9ull;
+  hash ^= ToLowerAscii(middle) * 0x94d049bb133111ebull;
+  hash ^= hash >> 32;
+  return hash * 0x9e3779b97f4a7c15ull;
+}
+
+}  // namespace
+
+StringIndex::StringIndex(std::vector<std::string_view> strings)
+    : strings_(std::move(strings)) {
+  UINVARIANT(strings_.size() < std::numeric_limits<std::uint32_t>::max(),
+             "Too many strings for utils::impl::StringIndex");
+
+  // At most a half of the slots are occupied to keep the probe chains short
+  std::size_t slot_count = 2;
+  int shift = 63;
+  while (slot_count < strings_.size() * 2) {
+    slot_count *= 2;
+    --shift;
+  }
+  slots_.resize(slot_count);
+  mask_ = slot_count - 1;
+  shift_ = shift;
+
+  for (std::size_t i = 0; i < strings_.size(); ++i) {
+    const auto& string = strings_[i];
+    // The first of the equal strings is found, as with the chain of Case's
+    if (Find(string) != kInvalidSize) continue;
+
+    const auto hash = Fingerprint(string);
+    auto pos = hash >> shift_;
+    while (slots_[pos].index != 0) pos = (pos + 1) & mask_;
+    slots_[pos] = Slot{static_cast<std::uint32_t>(hash),
+                       static_cast<std::uint32_t>(i + 1)};
+  }
+}
+
+template <typename Equal>
+std::size_t StringIndex::DoFind(std::string_view value,
+                                Equal equal) const noexcept {
+  const auto hash = Fingerprint(value);
+  const auto tag = static_cast<std::uint32_t>(hash);
+  for (auto pos = hash >> shift_; slots_[pos].index != 0;
+       pos = (pos + 1) & mask_) {
+    const auto& slot = slots_[pos];
+    if (slot.tag != tag) continue;
+
+    const auto& string = strings_[slot.index - 1];
+    if (string.size() == value.size() && equal(string, value)) {
+      return slot.index - 1;
+    }
+  }
+  return kInvalidSize;
+}
+
+std::size_t StringIndex::Find(std::string_view value) const noexcept {
+  return DoFind(value, [](std::string_view string, std::string_view value) {
+    return EqualWords(string.data(), value.data(), value.size(),
+                      [](std::uint64_t word) { return word; });
+  });
+}
+
+std::size_t StringIndex::FindICase(std::string_view value) const noexcept {
+  // The strings are in lower case, see utils::TrivialBiMap::TryFindICase
+  return DoFind(value, [](std::string_view string, std::string_view value) {
+    UASSERT(!HasUppercaseAscii(string));
+    return EqualWords(string.data(), value.data(), value.size(),
+                      &ToLowerAscii);
+  });
+}
+
+}  // namespace utils::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,144 @@
+#include <userver/utils/trivial_map.hpp>
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/utils/str_icase.hpp>
+#include <utils/gbench_auxilary.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+// The maps are in a separate translation unit, because their chains of
+// comparisons exhaust the inlining budget of the compiler for the rest of the
+// maps of trivial_map_benchmark.cpp
+
+namespace {
+
+// Many strings of the same size, the runtime lookups use the hash index
+constexpr std::string_view kLargeTrivialBiMapKeys[] = {
+    "user_field_00", "user_field_01", "user_field_02", "user_field_03",
+    "user_field_04", "user_field_05", "user_field_06", "user_field_07",
+    "user_field_08", "user_field_09", "user_field_10", "user_field_11",
+    "user_field_12", "user_field_13", "user_field_14", "user_field_15",
+    "user_field_16", "user_field_17", "user_field_18", "user_field_19",
+    "user_field_20", "user_field_21", "user_field_22", "user_field_23",
+    "user_field_24", "user_field_25", "user_field_26", "user_field_27",
+    "user_field_28", "user_field_29", "user_field_30", "user_field_31",
+    "user_field_32", "user_field_33", "user_field_34", "user_field_35",
+    "user_field_36", "user_field_37", "user_field_38", "user_field_39",
+    "user_field_40", "user_field_41", "user_field_42", "user_field_43",
+    "user_field_44", "user_field_45", "user_field_46", "user_field_47",
+    "user_field_48", "user_field_49", "user_field_50", "user_field_51",
+    "user_field_52", "user_field_53", "user_field_54", "user_field_55",
+    "user_field_56", "user_field_57", "user_field_58", "user_field_59",
+    "user_field_60", "user_field_61", "user_field_62", "user_field_63",
+    "user_field_64", "user_field_65", "user_field_66", "user_field_67",
+    "user_field_68", "user_field_69", "user_field_70", "user_field_71",
+    "user_field_72", "user_field_73", "user_field_74", "user_field_75",
+    "user_field_76", "user_field_77", "user_field_78", "user_field_79",
+    "user_field_80", "user_field_81", "user_field_82", "user_field_83",
+    "user_field_84", "user_field_85", "user_field_86", "user_field_87",
+    "user_field_88", "user_field_89", "user_field_90", "user_field_91",
+    "user_field_92", "user_field_93", "user_field_94", "user_field_95",
+};
+
+constexpr int kLargeTrivialBiMapValues[] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31,
+    32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47,
+    48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, 62, 63,
+    64, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 76, 77, 78, 79,
+    80, 81, 82, 83, 84, 85, 86, 87, 88, 89, 90, 91, 92, 93, 94, 95,
+};
+
+constexpr auto kLargeTrivialBiMap =
+    utils::MakeTrivialBiMap<kLargeTrivialBiMapKeys, kLargeTrivialBiMapValues>();
+
+template <typename Map>
+Map MakeLargeUnorderedMapping() {
+  Map result;
+  for (std::size_t i = 0; i < std::size(kLargeTrivialBiMapKeys); ++i) {
+    result.emplace(kLargeTrivialBiMapKeys[i], kLargeTrivialBiMapValues[i]);
+  }
+  return result;
+}
+
+// The keys in an order that the branch predictor could not learn
+std::vector<std::string> GetInputs(bool uppercase) {
+  std::vector<std::string> result;
+  std::uint32_t state = 1;
+  for (std::size_t i = 0; i < 1024; ++i) {
+    state = state * 1103515245 + 12345;
+    std::string key{
+        kLargeTrivialBiMapKeys[(state >> 16) %
+                               std::size(kLargeTrivialBiMapKeys)]};
+    if (uppercase) {
+      for (auto& c : key) {
+        if ('a' <= c && c <= 'z') c = c - 'a' + 'A';
+      }
+    }
+    result.push_back(std::move(key));
+  }
+  return result;
+}
+
+}  // namespace
+
+void MappingLargeTrivialBiMap(benchmark::State& state) {
+  const auto inputs = GetInputs(false);
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(
+          kLargeTrivialBiMap.TryFind(std::string_view{input}));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+BENCHMARK(MappingLargeTrivialBiMap);
+
+void MappingLargeUnordered(benchmark::State& state) {
+  const auto map =
+      MakeLargeUnorderedMapping<std::unordered_map<std::string_view, int>>();
+  const auto inputs = GetInputs(false);
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(map.find(input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+BENCHMARK(MappingLargeUnordered);
+
+void MappingLargeTrivialBiMapICase(benchmark::State& state) {
+  const auto inputs = GetInputs(true);
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(kLargeTrivialBiMap.TryFindICase(input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+BENCHMARK(MappingLargeTrivialBiMapICase);
+
+void MappingLargeUnorderedICase(benchmark::State& state) {
+  const auto map = MakeLargeUnorderedMapping<std::unordered_map<
+      std::string, int, utils::StrIcaseHash, utils::StrIcaseEqual>>();
+  const auto inputs = GetInputs(true);
+
+  for ([[maybe_unused]] auto _ : state) {
+    for (const auto& input : inputs) {
+      benchmark::DoNotOptimize(map.find(input));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * inputs.size());
+}
+BENCHMARK(MappingLargeUnorderedICase);
+
+USERVER_NAMESPACE_END
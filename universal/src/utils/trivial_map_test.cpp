@@ -1,5 +1,7 @@
 #include <userver/utils/trivial_map.hpp>
 
+#include <array>
+
 #include <gtest/gtest.h>
 
 USERVER_NAMESPACE_BEGIN
@@ -333,4 +335,219 @@ TEST(TrivialBiMap, StringICase) {
       "\xf0\xe1\xf2\xf3\xf4\xf5\xf6\xf7\xf8\xf9\xfa\xfb\xfc\xfd\xfe\xff"));
 }
 
+namespace {
+
+enum class Color {
+  kRed,
+  kOrange,
+  kYellow,
+  kGreen,
+  kCyan,
+  kBlue,
+  kViolet,
+  kBlack,
+  kWhite,
+  kGray,
+  kBrown,
+  kPink,
+  kPurple,
+  kMagenta,
+  kOlive,
+  kNavy,
+  kTeal,
+  kMaroon,
+  kSilver,
+  kGold,
+};
+
+}  // namespace
+
+// Large enough for the case insensitive runtime lookups to use the hash index
+constexpr utils::TrivialBiMap kColors = [](auto selector) {
+  return selector()
+      .Case("red", Color::kRed)
+      .Case("orange", Color::kOrange)
+      .Case("yellow", Color::kYellow)
+      .Case("green", Color::kGreen)
+      .Case("cyan", Color::kCyan)
+      .Case("blue", Color::kBlue)
+      .Case("violet", Color::kViolet)
+      .Case("black", Color::kBlack)
+      .Case("white", Color::kWhite)
+      .Case("gray", Color::kGray)
+      .Case("brown", Color::kBrown)
+      .Case("pink", Color::kPink)
+      .Case("purple", Color::kPurple)
+      .Case("magenta", Color::kMagenta)
+      .Case("olive", Color::kOlive)
+      .Case("navy", Color::kNavy)
+      .Case("teal", Color::kTeal)
+      .Case("maroon", Color::kMaroon)
+      .Case("silver", Color::kSilver)
+      .Case("gold", Color::kGold)
+      .Case("grey", Color::kGray)
+      .Case("red", Color::kMaroon);
+};
+
+TEST(TrivialBiMap, Large) {
+  static_assert(kColors.size() >= utils::impl::kStringIndexMinCasesICase);
+  static_assert(kColors.TryFind("gold") == Color::kGold);
+  static_assert(kColors.TryFind(Color::kGray) == "gray");
+
+  EXPECT_EQ(kColors.TryFind("red"), Color::kRed);
+  EXPECT_EQ(kColors.TryFind("violet"), Color::kViolet);
+  EXPECT_EQ(kColors.TryFind("gold"), Color::kGold);
+  EXPECT_EQ(kColors.TryFind("grey"), Color::kGray);
+  EXPECT_EQ(kColors.TryFind(Color::kGray), "gray");
+  EXPECT_EQ(kColors.TryFind(Color::kMaroon), "maroon");
+
+  EXPECT_EQ(kColors.TryFind(""), std::nullopt);
+  EXPECT_EQ(kColors.TryFind("Red"), std::nullopt);
+  EXPECT_EQ(kColors.TryFind("reds"), std::nullopt);
+  EXPECT_EQ(kColors.TryFind("magentas"), std::nullopt);
+  EXPECT_EQ(kColors.TryFind(std::string_view{"redd", 3}), Color::kRed);
+}
+
+TEST(TrivialBiMap, LargeICase) {
+  EXPECT_EQ(kColors.TryFindICase("RED"), Color::kRed);
+  EXPECT_EQ(kColors.TryFindICase("MaGeNtA"), Color::kMagenta);
+  EXPECT_EQ(kColors.TryFindICase("silver"), Color::kSilver);
+  EXPECT_EQ(kColors.TryFindICase("SILVER!"), std::nullopt);
+  EXPECT_EQ(kColors.TryFindICase("m@genta"), std::nullopt);
+  EXPECT_EQ(kColors.TryFindICase(""), std::nullopt);
+}
+
+TEST(TrivialBiMap, LargeSameAsChain) {
+  static constexpr std::string_view kInputs[] = {
+      "red",  "orange", "yellow", "green", "cyan",    "blue",   "violet",
+      "gray", "grey",   "gold",   "teal",  "MAROON",  "Olive",  "navy ",
+      "",     "r",      "purple", "pink",  "magenta", "silver",
+  };
+  using Results = std::array<std::optional<Color>, std::size(kInputs)>;
+
+  // The constant evaluation goes through the chain of Case's
+  constexpr auto kExpected = [] {
+    Results result{};
+    for (std::size_t i = 0; i < std::size(kInputs); ++i) {
+      result[i] = kColors.TryFind(kInputs[i]);
+    }
+    return result;
+  }();
+  constexpr auto kExpectedICase = [] {
+    Results result{};
+    for (std::size_t i = 0; i < std::size(kInputs); ++i) {
+      result[i] = kColors.TryFindICase(kInputs[i]);
+    }
+    return result;
+  }();
+
+  for (std::size_t i = 0; i < std::size(kInputs); ++i) {
+    EXPECT_EQ(kColors.TryFind(kInputs[i]), kExpected[i]) << kInputs[i];
+    EXPECT_EQ(kColors.TryFindICase(kInputs[i]), kExpectedICase[i])
+        << kInputs[i];
+  }
+}
+
+TEST(TrivialBiMap, LargeStringSet) {
+  constexpr utils::TrivialSet kSet = [](auto selector) {
+    return selector()
+        .Case("a")
+        .Case("bb")
+        .Case("ccc")
+        .Case("dddd")
+        .Case("eeeee")
+        .Case("ffffff")
+        .Case("ggggggg")
+        .Case("hhhhhhhh")
+        .Case("iiiiiiiii")
+        .Case("jjjjjjjjjj")
+        .Case("kkkkkkkkkkk")
+        .Case("llllllllllll")
+        .Case("mmmmmmmmmmmmm")
+        .Case("nnnnnnnnnnnnnn")
+        .Case("ooooooooooooooo")
+        .Case("pppppppppppppppp")
+        .Case("qqqqqqqqqqqqqqqqq");
+  };
+
+  static_assert(kSet.Contains("ccc"));
+  EXPECT_TRUE(kSet.Contains("a"));
+  EXPECT_TRUE(kSet.Contains("qqqqqqqqqqqqqqqqq"));
+  EXPECT_FALSE(kSet.Contains("qqqqqqqqqqqqqqqqQ"));
+  EXPECT_FALSE(kSet.Contains("qqqqqqqqqqqqqqqq"));
+  EXPECT_TRUE(kSet.ContainsICase("PPPPPPPPPPPPPPPP"));
+  EXPECT_TRUE(kSet.ContainsICase("hhhhHhhh"));
+  EXPECT_FALSE(kSet.ContainsICase("hhhhHhh"));
+  EXPECT_FALSE(kSet.ContainsICase("Z"));
+}
+
+constexpr std::string_view kManyKeys[] = {
+    "value_0", "value_1", "value_2", "value_3", "value_4", "value_5", "value_6",
+    "value_7", "value_8", "value_9", "value_10", "value_11", "value_12",
+    "value_13", "value_14", "value_15", "value_16", "value_17", "value_18",
+    "value_19", "value_20", "value_21", "value_22", "value_23", "value_24",
+    "value_25", "value_26", "value_27", "value_28", "value_29", "value_30",
+    "value_31", "value_32", "value_33", "value_34", "value_35", "value_36",
+    "value_37", "value_38", "value_39", "value_40", "value_41", "value_42",
+    "value_43", "value_44", "value_45", "value_46", "value_47", "value_48",
+    "value_49", "value_50", "value_51", "value_52", "value_53", "value_54",
+    "value_55", "value_56", "value_57", "value_58", "value_59", "value_60",
+    "value_61", "value_62", "value_63", "value_64", "value_65", "value_66",
+    "value_67", "value_68", "value_69",
+};
+constexpr int kManyValues[] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20,
+    21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39,
+    40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, 58,
+    59, 60, 61, 62, 63, 64, 65, 66, 67, 68, 69,
+};
+
+TEST(TrivialBiMap, LargeExact) {
+  static constexpr auto kMap =
+      utils::MakeTrivialBiMap<kManyKeys, kManyValues>();
+  static_assert(kMap.size() >= utils::impl::kStringIndexMinCases);
+  static_assert(kMap.TryFind("value_42") == 42);
+
+  for (std::size_t i = 0; i < std::size(kManyKeys); ++i) {
+    EXPECT_EQ(kMap.TryFind(kManyKeys[i]), kManyValues[i]);
+    EXPECT_EQ(kMap.TryFind(kManyValues[i]), kManyKeys[i]);
+  }
+  EXPECT_EQ(kMap.TryFind("value_70"), std::nullopt);
+  EXPECT_EQ(kMap.TryFind("VALUE_7"), std::nullopt);
+  EXPECT_EQ(kMap.TryFind("value_"), std::nullopt);
+  EXPECT_EQ(kMap.TryFindICase("VALUE_7"), 7);
+}
+
+TEST(TrivialBiMap, StringIndex) {
+  const utils::impl::StringIndex index{{
+      "",
+      "a",
+      "ab",
+      "abcd",
+      "abcdefgh",
+      // The same head, middle and tail words
+      "0123456789abcdef_x_0123456789abcdef",
+      "0123456789abcdef_y_0123456789abcdef",
+      "abcd",
+  }};
+
+  EXPECT_EQ(index.Find(""), 0);
+  EXPECT_EQ(index.Find("a"), 1);
+  EXPECT_EQ(index.Find("ab"), 2);
+  EXPECT_EQ(index.Find("abcd"), 3);
+  EXPECT_EQ(index.Find("abcdefgh"), 4);
+  EXPECT_EQ(index.Find("0123456789abcdef_x_0123456789abcdef"), 5);
+  EXPECT_EQ(index.Find("0123456789abcdef_y_0123456789abcdef"), 6);
+  EXPECT_EQ(index.Find("0123456789abcdef_z_0123456789abcdef"),
+            utils::impl::kInvalidSize);
+  EXPECT_EQ(index.Find("abc"), utils::impl::kInvalidSize);
+  EXPECT_EQ(index.Find("b"), utils::impl::kInvalidSize);
+  EXPECT_EQ(index.Find("ABCD"), utils::impl::kInvalidSize);
+
+  EXPECT_EQ(index.FindICase("ABCD"), 3);
+  EXPECT_EQ(index.FindICase("aBcDeFgH"), 4);
+  EXPECT_EQ(index.FindICase("0123456789ABCDEF_Y_0123456789ABCDEF"), 6);
+  EXPECT_EQ(index.FindICase("abcdefg@"), utils::impl::kInvalidSize);
+}
+
 USERVER_NAMESPACE_END
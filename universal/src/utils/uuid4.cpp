@@ -12,6 +12,18 @@ std::string GenerateUuid() {
   return encoding::ToHex(val.begin(), val.size());
 }
 
+utils::SmallString<32> GenerateUuidSmallString() {
+  const auto val = GenerateBoostUuid();
+  utils::SmallString<32> result;
+  result.resize_and_overwrite(32, [&val](char* data, std::size_t size) {
+    encoding::ToHex(
+        std::string_view{reinterpret_cast<const char*>(val.data), val.size()},
+        data);
+    return size;
+  });
+  return result;
+}
+
 }  // namespace utils::generators
 
 USERVER_NAMESPACE_END
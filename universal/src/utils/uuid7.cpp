@@ -12,6 +12,18 @@ std::string GenerateUuidV7() {
   return encoding::ToHex(val.begin(), val.size());
 }
 
+utils::SmallString<32> GenerateUuidV7SmallString() {
+  const auto val = GenerateBoostUuidV7();
+  utils::SmallString<32> result;
+  result.resize_and_overwrite(32, [&val](char* data, std::size_t size) {
+    encoding::ToHex(
+        std::string_view{reinterpret_cast<const char*>(val.data), val.size()},
+        data);
+    return size;
+  });
+  return result;
+}
+
 }  // namespace utils::generators
 
 USERVER_NAMESPACE_END
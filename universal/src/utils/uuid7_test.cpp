@@ -1,5 +1,7 @@
 #include <userver/utils/uuid7.hpp>
 
+#include <string_view>
+
 #include <gtest/gtest.h>
 
 USERVER_NAMESPACE_BEGIN
@@ -14,4 +16,16 @@ TEST(UUIDv7, String) {
             utils::generators::GenerateUuidV7());
 }
 
+TEST(UUIDv7, SmallString) {
+  const auto uuid = utils::generators::GenerateUuidV7SmallString();
+  const std::string_view view = uuid;
+  EXPECT_EQ(view.size(), 32);
+  EXPECT_EQ(view.find_first_not_of("0123456789abcdef"), std::string_view::npos);
+  // version
+  EXPECT_EQ(view[12], '7');
+
+  const auto other_uuid = utils::generators::GenerateUuidV7SmallString();
+  EXPECT_NE(view, std::string_view{other_uuid});
+}
+
 USERVER_NAMESPACE_END
@@ -7,6 +7,7 @@
 #include <userver/formats/json/value.hpp>
 #include <userver/formats/json/value_builder.hpp>
 #include <userver/formats/yaml/serialize.hpp>
+#include <userver/formats/yaml/value_builder.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/utils/string_to_duration.hpp>
 
@@ -72,6 +73,41 @@ std::optional<formats::yaml::Value> GetFromEnvByKey(
   return {};
 }
 
+formats::yaml::Value ResolveValue(const YamlConfig& config,
+                                  YamlConfig::Mode mode) {
+  if (config.IsObject()) {
+    formats::yaml::ValueBuilder builder{formats::common::Type::kObject};
+    const auto& yaml = config.Yaml();
+    for (auto it = yaml.begin(); it != yaml.end(); ++it) {
+      auto name = it.GetName();
+      if (boost::algorithm::ends_with(name, "#fallback")) continue;
+      if (boost::algorithm::ends_with(name, "#env")) {
+        if (mode != YamlConfig::Mode::kEnvAllowed) continue;
+        name.resize(name.size() - std::string_view{"#env"}.size());
+        if (yaml.HasMember(name)) continue;
+      }
+
+      auto child = config[name];
+      if (child.IsMissing()) continue;
+      builder[name] = child.ResolveSubstitutions().Yaml();
+    }
+    return builder.ExtractValue();
+  }
+
+  if (config.IsArray()) {
+    formats::yaml::ValueBuilder builder{formats::common::Type::kArray};
+    for (std::size_t i = 0; i < config.GetSize(); ++i) {
+      auto child = config[i];
+      builder.PushBack(child.IsMissing()
+                           ? formats::yaml::ValueBuilder{}
+                           : child.ResolveSubstitutions().Yaml());
+    }
+    return builder.ExtractValue();
+  }
+
+  return config.Yaml();
+}
+
 }  // namespace
 
 YamlConfig::YamlConfig(formats::yaml::Value yaml,
@@ -83,6 +119,8 @@ YamlConfig::YamlConfig(formats::yaml::Value yaml,
 const formats::yaml::Value& YamlConfig::Yaml() const { return yaml_; }
 
 YamlConfig YamlConfig::operator[](std::string_view key) const {
+  if (is_resolved_) return MakeResolved(yaml_[key]);
+
   if (boost::algorithm::ends_with(key, "#env")) {
     auto env_value = GetFromEnvByKey(key, yaml_, mode_);
     if (env_value) {
@@ -134,6 +172,8 @@ YamlConfig YamlConfig::operator[](std::string_view key) const {
 }
 
 YamlConfig YamlConfig::operator[](size_t index) const {
+  if (is_resolved_) return MakeResolved(yaml_[index]);
+
   auto value = yaml_[index];
 
   if (IsSubstitution(value)) {
@@ -196,6 +236,17 @@ bool YamlConfig::HasMember(std::string_view key) const {
 
 std::string YamlConfig::GetPath() const { return yaml_.GetPath(); }
 
+YamlConfig YamlConfig::ResolveSubstitutions() const {
+  if (is_resolved_) return *this;
+  return MakeResolved(ResolveValue(*this, mode_));
+}
+
+YamlConfig YamlConfig::MakeResolved(formats::yaml::Value yaml) {
+  YamlConfig result{std::move(yaml), {}, Mode::kSecure};
+  result.is_resolved_ = true;
+  return result;
+}
+
 YamlConfig::const_iterator YamlConfig::begin() const {
   return const_iterator{*this, yaml_.begin()};
 }
@@ -572,4 +572,59 @@ TEST(YamlConfig, IteratorArray) {
   EXPECT_NE(cit, it);
 }
 
+TEST(YamlConfig, ResolveSubstitutions) {
+  auto vmap = formats::yaml::FromString(R"(
+    int: 42
+    dollar: $not_a_variable
+    object:
+      member: $int
+      plain: str
+  )");
+
+  auto node = formats::yaml::FromString(R"(
+    int: $int
+    object: $object
+    missing: $missing
+    fallback: $missing
+    fallback#fallback: 5
+    env#env: RESOLVE_TEST_ENV
+    dollar: $dollar
+    array:
+      - $int
+      - $missing
+      - str
+  )");
+
+  // NOLINTNEXTLINE(concurrency-mt-unsafe)
+  ::setenv("RESOLVE_TEST_ENV", "100", 1);
+
+  const yaml_config::YamlConfig conf(
+      node, vmap, yaml_config::YamlConfig::Mode::kEnvAllowed);
+  const auto resolved = conf.ResolveSubstitutions();
+
+  EXPECT_EQ(resolved["int"].As<int>(), 42);
+  EXPECT_EQ(resolved["object"]["plain"].As<std::string>(), "str");
+  EXPECT_TRUE(resolved["object"]["member"].IsMissing());
+  EXPECT_TRUE(resolved["missing"].IsMissing());
+  EXPECT_EQ(resolved["fallback"].As<int>(), 5);
+  EXPECT_FALSE(resolved.HasMember("fallback#fallback"));
+  EXPECT_EQ(resolved["env"].As<int>(), 100);
+  using Array = std::vector<std::optional<std::string>>;
+  EXPECT_EQ(resolved["array"].As<Array>(), conf["array"].As<Array>());
+  EXPECT_EQ(resolved["array"][2].As<std::string>(), "str");
+  EXPECT_EQ(resolved["array"].GetPath(), "array");
+  EXPECT_EQ(resolved.GetSize(), 6);
+
+  // Resolved values are never substituted again
+  EXPECT_EQ(conf["dollar"].As<std::string>(), "$not_a_variable");
+  EXPECT_EQ(resolved["dollar"].As<std::string>(), "$not_a_variable");
+  const auto object = resolved["object"].ResolveSubstitutions();
+  EXPECT_EQ(object["plain"].As<std::string>(), "str");
+
+  // NOLINTNEXTLINE(concurrency-mt-unsafe)
+  ::unsetenv("RESOLVE_TEST_ENV");
+
+  EXPECT_EQ(resolved["env"].As<int>(), 100);
+}
+
 USERVER_NAMESPACE_END